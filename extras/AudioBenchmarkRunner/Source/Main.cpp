@@ -0,0 +1,536 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Renders AudioProcessorGraphs offline, as fast as possible, and reports how they perform.
+
+    The graphs can either come from a .filtergraph file saved by the AudioPluginHost, or
+    from a KnownPluginList file, in which case each plugin in the list is measured on its
+    own between the graph's audio input and output.
+*/
+namespace
+{
+    using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+    struct RenderSettings
+    {
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        int numThreads = 0;
+    };
+
+    struct NodeResult
+    {
+        String name;
+        AudioProcessorGraph::Node::ProcessingStats stats;
+    };
+
+    struct RenderResult
+    {
+        String graphName;
+        RenderSettings settings;
+        double audioSeconds = 0.0, wallSeconds = 0.0, worstBlockMilliseconds = 0.0;
+        int64 numBlocks = 0, numOverruns = 0;
+        int64 numAllocations = -1;
+        std::vector<NodeResult> nodes;
+
+        double getRealtimeFactor() const    { return wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0; }
+    };
+
+    struct Options
+    {
+        Array<double> sampleRates { 48000.0 };
+        Array<int> blockSizes { 512 };
+        Array<int> threadCounts { 0 };
+        int numChannels = 2;
+        double seconds = 10.0, warmUpSeconds = 1.0;
+    };
+
+    //==============================================================================
+    template <typename Type>
+    Array<Type> parseList (const ArgumentList& args, StringRef option, const Array<Type>& defaultValues)
+    {
+        if (! args.containsOption (option))
+            return defaultValues;
+
+        Array<Type> result;
+
+        for (auto& item : StringArray::fromTokens (args.getValueForOption (option), ",", {}))
+        {
+            const auto value = (Type) item.trim().getDoubleValue();
+
+            if (value < 0 || item.trim().isEmpty())
+                ConsoleApplication::fail ("Invalid value for " + String (option) + ": " + item);
+
+            result.add (value);
+        }
+
+        if (result.isEmpty())
+            ConsoleApplication::fail ("Expected a comma-separated list for " + String (option));
+
+        return result;
+    }
+
+    double parseNumber (const ArgumentList& args, StringRef option, double defaultValue)
+    {
+        return args.containsOption (option) ? args.getValueForOption (option).getDoubleValue()
+                                            : defaultValue;
+    }
+
+    Options parseOptions (const ArgumentList& args)
+    {
+        Options options;
+        options.sampleRates  = parseList (args, "--sample-rates", options.sampleRates);
+        options.blockSizes   = parseList (args, "--block-sizes", options.blockSizes);
+        options.threadCounts = parseList (args, "--threads", options.threadCounts);
+        options.numChannels  = (int) parseNumber (args, "--channels", options.numChannels);
+        options.seconds      = parseNumber (args, "--seconds", options.seconds);
+        options.warmUpSeconds = parseNumber (args, "--warm-up", options.warmUpSeconds);
+
+        if (options.numChannels <= 0 || options.seconds <= 0.0 || options.warmUpSeconds < 0.0
+             || options.sampleRates.contains (0.0) || options.blockSizes.contains (0))
+            ConsoleApplication::fail ("Invalid render settings");
+
+        return options;
+    }
+
+    //==============================================================================
+    class GraphLoader
+    {
+    public:
+        GraphLoader()
+        {
+            formatManager.addDefaultFormats();
+        }
+
+        std::unique_ptr<AudioPluginInstance> createPlugin (const PluginDescription& description,
+                                                           double sampleRate, int blockSize) const
+        {
+            if (description.pluginFormatName == "Internal")
+                for (auto type : { IOProcessor::audioInputNode, IOProcessor::audioOutputNode,
+                                   IOProcessor::midiInputNode, IOProcessor::midiOutputNode })
+                    if (auto io = std::make_unique<IOProcessor> (type); io->getName() == description.name)
+                        return io;
+
+            String error;
+            auto instance = formatManager.createPluginInstance (description, sampleRate, blockSize, error);
+
+            if (instance == nullptr)
+                ConsoleApplication::fail ("Couldn't load " + description.name + ": " + error);
+
+            return instance;
+        }
+
+        /*  Restores a graph in the format written by the AudioPluginHost. */
+        void loadFilterGraph (AudioProcessorGraph& graph, const XmlElement& xml, double sampleRate, int blockSize) const
+        {
+            for (auto* e : xml.getChildWithTagNameIterator ("FILTER"))
+            {
+                PluginDescription description;
+
+                for (auto* child : e->getChildIterator())
+                    if (description.loadFromXml (*child))
+                        break;
+
+                auto instance = createPlugin (description, sampleRate, blockSize);
+
+                if (auto* layoutXml = e->getChildByName ("LAYOUT"))
+                {
+                    auto layout = instance->getBusesLayout();
+                    readBusLayout (layout.inputBuses,  *layoutXml, "INPUTS");
+                    readBusLayout (layout.outputBuses, *layoutXml, "OUTPUTS");
+                    instance->setBusesLayout (layout);
+                }
+
+                auto node = graph.addNode (std::move (instance), AudioProcessorGraph::NodeID ((uint32) e->getIntAttribute ("uid")));
+
+                if (node == nullptr)
+                    ConsoleApplication::fail ("Couldn't add " + description.name + " to the graph");
+
+                if (auto* state = e->getChildByName ("STATE"))
+                {
+                    MemoryBlock m;
+                    m.fromBase64Encoding (state->getAllSubText());
+                    node->getProcessor()->setStateInformation (m.getData(), (int) m.getSize());
+                }
+            }
+
+            for (auto* e : xml.getChildWithTagNameIterator ("CONNECTION"))
+                graph.addConnection ({ { AudioProcessorGraph::NodeID ((uint32) e->getIntAttribute ("srcFilter")), e->getIntAttribute ("srcChannel") },
+                                       { AudioProcessorGraph::NodeID ((uint32) e->getIntAttribute ("dstFilter")), e->getIntAttribute ("dstChannel") } });
+
+            graph.removeIllegalConnections();
+        }
+
+        /*  Builds a graph that runs a single plugin between the graph's inputs and outputs. */
+        void loadSinglePlugin (AudioProcessorGraph& graph, const PluginDescription& description,
+                               int numChannels, double sampleRate, int blockSize) const
+        {
+            const auto audioIn  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto midiIn   = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::midiInputNode))->nodeID;
+            const auto audioOut = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+            const auto plugin   = graph.addNode (createPlugin (description, sampleRate, blockSize))->nodeID;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                graph.addConnection ({ { audioIn, channel }, { plugin, channel } });
+                graph.addConnection ({ { plugin, channel }, { audioOut, channel } });
+            }
+
+            graph.addConnection ({ { midiIn, AudioProcessorGraph::midiChannelIndex },
+                                   { plugin, AudioProcessorGraph::midiChannelIndex } });
+
+            graph.removeIllegalConnections();
+        }
+
+    private:
+        static void readBusLayout (Array<AudioChannelSet>& buses, const XmlElement& xml, StringRef tagName)
+        {
+            if (auto* busesXml = xml.getChildByName (tagName))
+            {
+                for (auto* e : busesXml->getChildWithTagNameIterator ("BUS"))
+                {
+                    const auto index = e->getIntAttribute ("index");
+                    const auto layout = e->getStringAttribute ("layout");
+
+                    if (isPositiveAndBelow (index, buses.size()) && layout.isNotEmpty())
+                        buses.getReference (index) = AudioChannelSet::fromAbbreviatedString (layout);
+                }
+            }
+        }
+
+        AudioPluginFormatManager formatManager;
+    };
+
+    //==============================================================================
+    /*  Fills the input buffer with noise and sends a note every second, so that both effects
+        and instruments have something to process.
+    */
+    class TestSignal
+    {
+    public:
+        TestSignal (int numChannels, double sampleRate)
+            : noise (numChannels, (int) sampleRate), noteInterval ((int64) sampleRate)
+        {
+            Random random (0x1234);
+
+            for (int channel = 0; channel < noise.getNumChannels(); ++channel)
+                for (int i = 0; i < noise.getNumSamples(); ++i)
+                    noise.setSample (channel, i, (random.nextFloat() * 2.0f - 1.0f) * 0.25f);
+        }
+
+        void fill (AudioBuffer<float>& audio, MidiBuffer& midi, int64 position) const
+        {
+            const auto numSamples = audio.getNumSamples();
+            const auto offset = (int) (position % noise.getNumSamples());
+            const auto numToCopy = jmin (numSamples, noise.getNumSamples() - offset);
+
+            for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+            {
+                audio.copyFrom (channel, 0, noise, channel % noise.getNumChannels(), offset, numToCopy);
+
+                if (numToCopy < numSamples)
+                    audio.copyFrom (channel, numToCopy, noise, channel % noise.getNumChannels(), 0, numSamples - numToCopy);
+            }
+
+            midi.clear();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto phase = (position + i) % noteInterval;
+
+                if (phase == 0)
+                    midi.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), i);
+                else if (phase == noteInterval / 2)
+                    midi.addEvent (MidiMessage::noteOff (1, 60), i);
+            }
+        }
+
+    private:
+        AudioBuffer<float> noise;
+        int64 noteInterval;
+    };
+
+    //==============================================================================
+    RenderResult render (AudioProcessorGraph& graph, const String& graphName,
+                         const RenderSettings& settings, const Options& options)
+    {
+        graph.releaseResources();
+        graph.setNumParallelRenderThreads (settings.numThreads);
+        graph.setPlayConfigDetails (options.numChannels, options.numChannels, settings.sampleRate, settings.blockSize);
+        graph.setNonRealtime (true);
+        graph.prepareToPlay (settings.sampleRate, settings.blockSize);
+        graph.setNodeTimingEnabled (true);
+
+        TestSignal signal (options.numChannels, settings.sampleRate);
+        AudioBuffer<float> audio (options.numChannels, settings.blockSize);
+        MidiBuffer midi;
+        midi.ensureSize (256);
+
+        int64 position = 0;
+
+        const auto renderBlock = [&]
+        {
+            signal.fill (audio, midi, position);
+            graph.processBlock (audio, midi);
+            position += settings.blockSize;
+        };
+
+        const auto numWarmUpBlocks = (int64) std::ceil (options.warmUpSeconds * settings.sampleRate / settings.blockSize);
+        const auto numBlocks = jmax ((int64) 1, (int64) std::ceil (options.seconds * settings.sampleRate / settings.blockSize));
+
+        for (int64 i = 0; i < numWarmUpBlocks; ++i)
+            renderBlock();
+
+        for (auto* node : graph.getNodes())
+            node->resetProcessingStats();
+
+        RenderResult result;
+        result.graphName = graphName;
+        result.settings = settings;
+        result.numBlocks = numBlocks;
+        result.audioSeconds = (double) (numBlocks * settings.blockSize) / settings.sampleRate;
+
+        const auto blockMilliseconds = 1000.0 * settings.blockSize / settings.sampleRate;
+        const auto start = Time::getHighResolutionTicks();
+
+        {
+           #if JUCE_ENABLE_ALLOCATION_HOOKS
+            ScopedAllocationCounter allocations;
+           #endif
+
+            for (int64 i = 0; i < numBlocks; ++i)
+            {
+                const auto blockStart = Time::getHighResolutionTicks();
+                renderBlock();
+                const auto blockTime = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - blockStart) * 1000.0;
+
+                result.worstBlockMilliseconds = jmax (result.worstBlockMilliseconds, blockTime);
+
+                if (blockTime > blockMilliseconds)
+                    ++result.numOverruns;
+            }
+
+           #if JUCE_ENABLE_ALLOCATION_HOOKS
+            result.numAllocations = (int64) allocations.getNumCalls();
+           #endif
+        }
+
+        result.wallSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+
+        for (auto* node : graph.getNodes())
+            if (dynamic_cast<IOProcessor*> (node->getProcessor()) == nullptr)
+                result.nodes.push_back ({ node->getProcessor()->getName(), node->getProcessingStats() });
+
+        std::sort (result.nodes.begin(), result.nodes.end(), [] (const auto& a, const auto& b)
+        {
+            return a.stats.averageMilliseconds > b.stats.averageMilliseconds;
+        });
+
+        graph.setNodeTimingEnabled (false);
+        graph.releaseResources();
+        return result;
+    }
+
+    //==============================================================================
+    String describe (const RenderResult& r)
+    {
+        String s;
+        s << r.graphName << " @ " << r.settings.sampleRate << " Hz, " << r.settings.blockSize << " samples, "
+          << r.settings.numThreads << " worker threads" << newLine
+          << "  realtime factor: " << String (r.getRealtimeFactor(), 2) << "x"
+          << ", worst block: " << String (r.worstBlockMilliseconds, 3) << " ms"
+          << ", overruns: " << r.numOverruns << "/" << r.numBlocks;
+
+        if (r.numAllocations >= 0)
+            s << ", allocations: " << r.numAllocations;
+
+        for (auto& node : r.nodes)
+            s << newLine << "    " << node.name.paddedRight (' ', 32)
+              << " avg " << String (node.stats.averageMilliseconds, 4)
+              << " ms, p99 " << String (node.stats.p99Milliseconds, 4)
+              << " ms, max " << String (node.stats.maxMilliseconds, 4) << " ms";
+
+        return s;
+    }
+
+    var toVar (const RenderResult& r)
+    {
+        auto* obj = new DynamicObject();
+        obj->setProperty ("graph", r.graphName);
+        obj->setProperty ("sampleRate", r.settings.sampleRate);
+        obj->setProperty ("blockSize", r.settings.blockSize);
+        obj->setProperty ("threads", r.settings.numThreads);
+        obj->setProperty ("audioSeconds", r.audioSeconds);
+        obj->setProperty ("wallSeconds", r.wallSeconds);
+        obj->setProperty ("realtimeFactor", r.getRealtimeFactor());
+        obj->setProperty ("worstBlockMilliseconds", r.worstBlockMilliseconds);
+        obj->setProperty ("numBlocks", r.numBlocks);
+        obj->setProperty ("numOverruns", r.numOverruns);
+
+        if (r.numAllocations >= 0)
+            obj->setProperty ("allocations", r.numAllocations);
+
+        Array<var> nodes;
+
+        for (auto& node : r.nodes)
+        {
+            auto* n = new DynamicObject();
+            n->setProperty ("name", node.name);
+            n->setProperty ("averageMilliseconds", node.stats.averageMilliseconds);
+            n->setProperty ("p99Milliseconds", node.stats.p99Milliseconds);
+            n->setProperty ("maxMilliseconds", node.stats.maxMilliseconds);
+            n->setProperty ("numOverruns", node.stats.numOverruns);
+            nodes.add (var (n));
+        }
+
+        obj->setProperty ("nodes", nodes);
+        return var (obj);
+    }
+
+    //==============================================================================
+    void runBenchmarks (const ArgumentList& args)
+    {
+        const auto options = parseOptions (args);
+        GraphLoader loader;
+
+        struct Job
+        {
+            String name;
+            std::function<void (AudioProcessorGraph&)> load;
+        };
+
+        std::vector<Job> jobs;
+
+        if (args.containsOption ("--graph"))
+        {
+            const auto file = args.getExistingFileForOption ("--graph");
+            auto xml = parseXMLIfTagMatches (file, "FILTERGRAPH");
+
+            if (xml == nullptr)
+                ConsoleApplication::fail ("Couldn't read a filter graph from " + file.getFullPathName());
+
+            jobs.push_back ({ file.getFileNameWithoutExtension(), [&, xml = std::shared_ptr<XmlElement> (std::move (xml))] (auto& graph)
+            {
+                loader.loadFilterGraph (graph, *xml, options.sampleRates.getFirst(), options.blockSizes.getFirst());
+            }});
+        }
+
+        if (args.containsOption ("--plugins"))
+        {
+            const auto file = args.getExistingFileForOption ("--plugins");
+            auto xml = parseXMLIfTagMatches (file, "KNOWNPLUGINS");
+
+            if (xml == nullptr)
+                ConsoleApplication::fail ("Couldn't read a plugin list from " + file.getFullPathName());
+
+            KnownPluginList list;
+            list.recreateFromXml (*xml);
+
+            for (auto& description : list.getTypes())
+            {
+                jobs.push_back ({ description.name, [&, description] (auto& graph)
+                {
+                    loader.loadSinglePlugin (graph, description, options.numChannels,
+                                             options.sampleRates.getFirst(), options.blockSizes.getFirst());
+                }});
+            }
+        }
+
+        if (jobs.empty())
+            ConsoleApplication::fail ("Nothing to render: pass --graph=file and/or --plugins=file");
+
+        std::vector<RenderResult> results;
+
+        for (auto& job : jobs)
+        {
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (options.numChannels, options.numChannels,
+                                        options.sampleRates.getFirst(), options.blockSizes.getFirst());
+            job.load (graph);
+
+            for (auto sampleRate : options.sampleRates)
+                for (auto blockSize : options.blockSizes)
+                    for (auto numThreads : options.threadCounts)
+                    {
+                        results.push_back (render (graph, job.name, { sampleRate, blockSize, numThreads }, options));
+                        std::cout << describe (results.back()) << std::endl;
+                    }
+        }
+
+        if (args.containsOption ("--output"))
+        {
+            Array<var> list;
+
+            for (auto& r : results)
+                list.add (toVar (r));
+
+            auto* root = new DynamicObject();
+            root->setProperty ("operatingSystem", SystemStats::getOperatingSystemName());
+            root->setProperty ("cpu", SystemStats::getCpuModel());
+            root->setProperty ("numCpus", SystemStats::getNumCpus());
+            root->setProperty ("results", list);
+
+            const auto outputFile = args.getFileForOption ("--output");
+
+            if (! outputFile.replaceWithText (JSON::toString (var (root))))
+                ConsoleApplication::fail ("Couldn't write " + outputFile.getFullPathName());
+        }
+
+        if (args.containsOption ("--min-realtime-factor"))
+        {
+            const auto minimum = args.getValueForOption ("--min-realtime-factor").getDoubleValue();
+
+            for (auto& r : results)
+                if (r.getRealtimeFactor() < minimum)
+                    ConsoleApplication::fail (r.graphName + " rendered at " + String (r.getRealtimeFactor(), 2)
+                                                + "x realtime, below the minimum of " + String (minimum, 2) + "x");
+        }
+    }
+}
+
+//==============================================================================
+int main (int argc, char** argv)
+{
+    ScopedJuceInitialiser_GUI libraryInitialiser;
+
+    ConsoleApplication app;
+
+    app.addHelpCommand ("--help|-h", "Renders plugin graphs offline and reports their performance.", false);
+
+    app.addDefaultCommand ({ "--graph|--plugins",
+                             "[--graph=file.filtergraph] [--plugins=pluginlist.xml] [--seconds=10] [--warm-up=1]"
+                             " [--sample-rates=48000,...] [--block-sizes=512,...] [--threads=0,...] [--channels=2]"
+                             " [--output=results.json] [--min-realtime-factor=x]",
+                             "Renders each graph or plugin with every combination of settings",
+                             "Graphs are read from files saved by the AudioPluginHost, and plugin lists from files "
+                             "written by KnownPluginList::createXml(). Each plugin in a list is measured on its own. "
+                             "The command fails if any render is slower than --min-realtime-factor.",
+                             runBenchmarks });
+
+    return app.findAndRunCommand (argc, argv);
+}
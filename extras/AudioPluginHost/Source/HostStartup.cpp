@@ -26,6 +26,7 @@
 #include <JuceHeader.h>
 #include "UI/MainHostWindow.h"
 #include "Plugins/InternalPlugins.h"
+#include "Plugins/SandboxedPlugin.h"
 
 #if ! (JUCE_PLUGINHOST_VST || JUCE_PLUGINHOST_VST3 || JUCE_PLUGINHOST_AU)
  #error "If you're building the audio plugin host, you probably want to enable VST and/or AU support"
@@ -144,6 +145,14 @@ public:
             return;
         }
 
+        auto sandboxWorker = std::make_unique<SandboxedPluginWorker>();
+
+        if (sandboxWorker->initialiseFromCommandLine (commandLine))
+        {
+            storedSandboxWorker = std::move (sandboxWorker);
+            return;
+        }
+
         // initialise our settings file..
 
         PropertiesFile::Options options;
@@ -205,6 +214,7 @@ public:
 
     void shutdown() override
     {
+        storedSandboxWorker = nullptr;
         mainWindow = nullptr;
         appProperties = nullptr;
         LookAndFeel::setDefaultLookAndFeel (nullptr);
@@ -245,6 +255,7 @@ public:
 private:
     std::unique_ptr<MainHostWindow> mainWindow;
     std::unique_ptr<PluginScannerSubprocess> storedScannerSubprocess;
+    std::unique_ptr<SandboxedPluginWorker> storedSandboxWorker;
 };
 
 static PluginHostApp& getApp()                    { return *dynamic_cast<PluginHostApp*> (JUCEApplication::getInstance()); }
@@ -345,6 +356,13 @@ bool shouldAutoScalePlugin (const PluginDescription& description)
                     && getAppProperties().getUserSettings()->getBoolValue ("autoScalePluginWindows")));
 }
 
+bool shouldSandboxPlugin (const PluginDescription& description)
+{
+    // The internal plugins need the graph that they're in, so they can't be moved elsewhere
+    return description.pluginFormatName != InternalPluginFormat::getIdentifier()
+            && getAppProperties().getUserSettings()->getBoolValue ("sandboxPlugins", false);
+}
+
 void addPluginAutoScaleOptionsSubMenu (AudioPluginInstance* pluginInstance,
                                        PopupMenu& menu)
 {
@@ -27,6 +27,7 @@
 #include "../UI/MainHostWindow.h"
 #include "PluginGraph.h"
 #include "InternalPlugins.h"
+#include "SandboxedPlugin.h"
 #include "../UI/GraphEditorPanel.h"
 
 static std::unique_ptr<ScopedDPIAwarenessDisabler> makeDPIAwarenessDisablerForPlugin (const PluginDescription& desc)
@@ -82,6 +83,15 @@ AudioProcessorGraph::Node::Ptr PluginGraph::getNodeForName (const String& name)
 
 void PluginGraph::addPlugin (const PluginDescriptionAndPreference& desc, Point<double> pos)
 {
+    // ARA plugins have to share memory with their host, so they can't be sandboxed
+    if (desc.useARA == PluginDescriptionAndPreference::UseARA::no && shouldSandboxPlugin (desc.pluginDescription))
+    {
+        String error;
+        auto instance = SandboxedPluginInstance::create (desc.pluginDescription, graph.getSampleRate(), graph.getBlockSize(), error);
+        addPluginCallback (std::move (instance), error, pos, desc.useARA, true);
+        return;
+    }
+
     std::shared_ptr<ScopedDPIAwarenessDisabler> dpiDisabler = makeDPIAwarenessDisablerForPlugin (desc.pluginDescription);
 
     formatManager.createPluginInstanceAsync (desc.pluginDescription,
@@ -89,14 +99,15 @@ void PluginGraph::addPlugin (const PluginDescriptionAndPreference& desc, Point<d
                                              graph.getBlockSize(),
                                              [this, pos, dpiDisabler, useARA = desc.useARA] (std::unique_ptr<AudioPluginInstance> instance, const String& error)
                                              {
-                                                 addPluginCallback (std::move (instance), error, pos, useARA);
+                                                 addPluginCallback (std::move (instance), error, pos, useARA, false);
                                              });
 }
 
 void PluginGraph::addPluginCallback (std::unique_ptr<AudioPluginInstance> instance,
                                      const String& error,
                                      Point<double> pos,
-                                     PluginDescriptionAndPreference::UseARA useARA)
+                                     PluginDescriptionAndPreference::UseARA useARA,
+                                     bool sandboxed)
 {
     if (instance == nullptr)
     {
@@ -122,6 +133,7 @@ void PluginGraph::addPluginCallback (std::unique_ptr<AudioPluginInstance> instan
             node->properties.set ("x", pos.x);
             node->properties.set ("y", pos.y);
             node->properties.set ("useARA", useARA == PluginDescriptionAndPreference::UseARA::yes);
+            node->properties.set ("sandboxed", sandboxed);
             changed();
         }
     }
@@ -346,6 +358,9 @@ static XmlElement* createNodeXml (AudioProcessorGraph::Node* const node) noexcep
         e->setAttribute ("y",        node->properties ["y"].toString());
         e->setAttribute ("useARA",   node->properties ["useARA"].toString());
 
+        if (node->properties ["sandboxed"])
+            e->setAttribute ("sandboxed", true);
+
         for (int i = 0; i < (int) PluginWindow::Type::numTypes; ++i)
         {
             auto type = (PluginWindow::Type) i;
@@ -387,6 +402,7 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
 {
     PluginDescriptionAndPreference pd;
     const auto nodeUsesARA = xml.getBoolAttribute ("useARA");
+    const auto nodeIsSandboxed = xml.getBoolAttribute ("sandboxed");
 
     for (auto* e : xml.getChildIterator())
     {
@@ -400,10 +416,16 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
 
     auto createInstanceWithFallback = [&]() -> std::unique_ptr<AudioPluginInstance>
     {
-        auto createInstance = [this] (const PluginDescriptionAndPreference& description) -> std::unique_ptr<AudioPluginInstance>
+        auto createInstance = [this, nodeIsSandboxed] (const PluginDescriptionAndPreference& description) -> std::unique_ptr<AudioPluginInstance>
         {
             String errorMessage;
 
+            if (nodeIsSandboxed)
+                return SandboxedPluginInstance::create (description.pluginDescription,
+                                                        graph.getSampleRate(),
+                                                        graph.getBlockSize(),
+                                                        errorMessage);
+
             auto localDpiDisabler = makeDPIAwarenessDisablerForPlugin (description.pluginDescription);
 
             auto instance = formatManager.createPluginInstance (description.pluginDescription,
@@ -468,6 +490,7 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
             node->properties.set ("x", xml.getDoubleAttribute ("x"));
             node->properties.set ("y", xml.getDoubleAttribute ("y"));
             node->properties.set ("useARA", xml.getBoolAttribute ("useARA"));
+            node->properties.set ("sandboxed", nodeIsSandboxed);
 
             for (int i = 0; i < (int) PluginWindow::Type::numTypes; ++i)
             {
@@ -119,7 +119,8 @@ private:
     void addPluginCallback (std::unique_ptr<AudioPluginInstance>,
                             const String& error,
                             Point<double>,
-                            PluginDescriptionAndPreference::UseARA useARA);
+                            PluginDescriptionAndPreference::UseARA useARA,
+                            bool sandboxed);
     void changeListenerCallback (ChangeBroadcaster*) override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginGraph)
@@ -0,0 +1,735 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+#pragma once
+
+#include <JuceHeader.h>
+
+/*  The command-line ID that the host uses when it launches itself to run a sandboxed plugin. */
+constexpr const char* sandboxProcessUID = "juceaudiopluginhostsandbox";
+
+//==============================================================================
+/*  The protocol shared by SandboxedPluginInstance and SandboxedPluginWorker.
+
+    Loading, preparing and state changes are sent as ValueTrees over the normal child
+    process connection. Once prepared, each block of audio and MIDI goes to the worker
+    through one SharedMemoryRing and comes back through another, so the audio thread never
+    has to wait for a message to be passed between threads on either side.
+
+    A block is a BlockHeader, followed by numChannels * numSamples floats, followed by
+    numMidiBytes of MIDI events, each stored as a sample position, a size and the bytes.
+*/
+namespace SandboxProtocol
+{
+    static const Identifier load         { "LOAD" },
+                            prepare      { "PREPARE" },
+                            release      { "RELEASE" },
+                            getState     { "GET_STATE" },
+                            setState     { "SET_STATE" },
+                            reply        { "REPLY" },
+                            requestId    { "id" },
+                            description  { "description" },
+                            error        { "error" },
+                            sampleRate   { "sampleRate" },
+                            blockSize    { "blockSize" },
+                            numInputs    { "numInputs" },
+                            numOutputs   { "numOutputs" },
+                            latency      { "latency" },
+                            tailLength   { "tailLength" },
+                            midiIn       { "acceptsMidi" },
+                            midiOut      { "producesMidi" },
+                            toWorker     { "toWorker" },
+                            fromWorker   { "fromWorker" },
+                            state        { "state" };
+
+    struct BlockHeader
+    {
+        uint32 sequence;
+        int32 numSamples, numChannels, numMidiBytes;
+    };
+
+    /*  Room for MIDI in each block. Events that don't fit are dropped. */
+    constexpr size_t maxMidiBytesPerBlock = 16384;
+
+    inline size_t getRingCapacity (int numChannels, int samplesPerBlock)
+    {
+        const auto bytesPerBlock = sizeof (BlockHeader)
+                                 + (size_t) (jmax (1, numChannels) * jmax (1, samplesPerBlock)) * sizeof (float)
+                                 + maxMidiBytesPerBlock;
+
+        // Enough for a late reply to a block that timed out to sit alongside the next one
+        return 4 * (bytesPerBlock + 64);
+    }
+
+    inline size_t getBlockSize (int numChannels, int numSamples, size_t numMidiBytes)
+    {
+        return sizeof (BlockHeader) + (size_t) (numChannels * numSamples) * sizeof (float) + numMidiBytes;
+    }
+
+    inline size_t getMidiSize (const MidiBuffer& midi)
+    {
+        size_t size = 0;
+
+        for (const auto metadata : midi)
+        {
+            const auto eventSize = 2 * sizeof (int32) + (size_t) metadata.numBytes;
+
+            if (size + eventSize > maxMidiBytesPerBlock)
+                break;
+
+            size += eventSize;
+        }
+
+        return size;
+    }
+
+    /*  Writes a block into memory obtained from SharedMemoryRing::prepareToWrite(). */
+    inline void writeBlock (void* dest, uint32 sequence, const AudioBuffer<float>& buffer,
+                            int numChannels, int numSamples, const MidiBuffer& midi, size_t numMidiBytes)
+    {
+        auto* d = static_cast<char*> (dest);
+        const BlockHeader header { sequence, numSamples, numChannels, (int32) numMidiBytes };
+        std::memcpy (d, &header, sizeof (header));
+        d += sizeof (header);
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            if (i < buffer.getNumChannels())
+                std::memcpy (d, buffer.getReadPointer (i), (size_t) numSamples * sizeof (float));
+            else
+                zeromem (d, (size_t) numSamples * sizeof (float));
+
+            d += (size_t) numSamples * sizeof (float);
+        }
+
+        auto* const midiEnd = d + numMidiBytes;
+
+        for (const auto metadata : midi)
+        {
+            if (d + 2 * sizeof (int32) + (size_t) metadata.numBytes > midiEnd)
+                break;
+
+            writeUnaligned<int32> (d, metadata.samplePosition);
+            writeUnaligned<int32> (d + sizeof (int32), metadata.numBytes);
+            d += 2 * sizeof (int32);
+            std::memcpy (d, metadata.data, (size_t) metadata.numBytes);
+            d += metadata.numBytes;
+        }
+    }
+
+    /*  Reads a block back out of a ring, returning false if it's malformed. */
+    inline bool readBlock (const void* source, size_t size, BlockHeader& header,
+                           AudioBuffer<float>& buffer, MidiBuffer& midi)
+    {
+        if (size < sizeof (BlockHeader))
+            return false;
+
+        auto* s = static_cast<const char*> (source);
+        std::memcpy (&header, s, sizeof (header));
+        s += sizeof (header);
+
+        if (header.numSamples < 0 || header.numChannels < 0 || header.numMidiBytes < 0
+            || size != getBlockSize (header.numChannels, header.numSamples, (size_t) header.numMidiBytes))
+            return false;
+
+        const auto channelsToCopy = jmin (header.numChannels, buffer.getNumChannels());
+        const auto samplesToCopy = jmin (header.numSamples, buffer.getNumSamples());
+
+        for (int i = 0; i < channelsToCopy; ++i)
+            std::memcpy (buffer.getWritePointer (i), s + (size_t) (i * header.numSamples) * sizeof (float),
+                         (size_t) samplesToCopy * sizeof (float));
+
+        for (int i = channelsToCopy; i < buffer.getNumChannels(); ++i)
+            buffer.clear (i, 0, buffer.getNumSamples());
+
+        s += (size_t) (header.numChannels * header.numSamples) * sizeof (float);
+        auto* const midiEnd = s + header.numMidiBytes;
+
+        midi.clear();
+
+        while (s + 2 * sizeof (int32) <= midiEnd)
+        {
+            const auto samplePosition = readUnaligned<int32> (s);
+            const auto numBytes = readUnaligned<int32> (s + sizeof (int32));
+            s += 2 * sizeof (int32);
+
+            if (numBytes <= 0 || s + numBytes > midiEnd)
+                break;
+
+            midi.addEvent (s, numBytes, jlimit (0, jmax (0, header.numSamples - 1), samplePosition));
+            s += numBytes;
+        }
+
+        return true;
+    }
+
+    inline MemoryBlock toMemoryBlock (const ValueTree& tree)
+    {
+        MemoryOutputStream stream;
+        tree.writeToStream (stream);
+        return stream.getMemoryBlock();
+    }
+}
+
+//==============================================================================
+/**
+    Hosts a plugin in a separate copy of this application.
+
+    If the plugin crashes or hangs, only the worker process is lost: this proxy then
+    carries on producing silence. The plugin's buses are presented as a single input
+    and a single output bus with the same total number of channels. The plugin's editor
+    and parameters aren't bridged, but its state is, so it's saved and restored along
+    with the rest of the graph.
+
+    Each block is processed synchronously by the worker, so no latency is added beyond
+    whatever the plugin reports itself.
+*/
+class SandboxedPluginInstance final : public AudioPluginInstance
+{
+public:
+    /** Launches a worker process and loads the plugin into it, returning nullptr and
+        setting the error message if that fails.
+    */
+    static std::unique_ptr<AudioPluginInstance> create (const PluginDescription& desc,
+                                                        double initialSampleRate,
+                                                        int initialBlockSize,
+                                                        String& errorMessage)
+    {
+        auto worker = std::make_unique<WorkerProcess>();
+
+        if (! worker->launch())
+        {
+            errorMessage = TRANS ("Couldn't start a process to host the plugin in");
+            return {};
+        }
+
+        ValueTree request (SandboxProtocol::load);
+        request.setProperty (SandboxProtocol::description, desc.createXml()->toString(), nullptr)
+               .setProperty (SandboxProtocol::sampleRate, initialSampleRate, nullptr)
+               .setProperty (SandboxProtocol::blockSize, initialBlockSize, nullptr);
+
+        // Loading a plugin can take a while, especially the first time
+        const auto reply = worker->sendRequest (request, 30000);
+
+        if (! reply.isValid())
+        {
+            errorMessage = TRANS ("The plugin's process didn't respond");
+            return {};
+        }
+
+        if (reply.hasProperty (SandboxProtocol::error))
+        {
+            errorMessage = reply[SandboxProtocol::error].toString();
+            return {};
+        }
+
+        return std::unique_ptr<AudioPluginInstance> (new SandboxedPluginInstance (std::move (worker), reply));
+    }
+
+    ~SandboxedPluginInstance() override
+    {
+        releaseRings();
+    }
+
+    //==============================================================================
+    void fillInPluginDescription (PluginDescription& d) const override    { d = description; }
+    const String getName() const override                                 { return description.name; }
+
+    void prepareToPlay (double newSampleRate, int maximumExpectedSamplesPerBlock) override
+    {
+        releaseRings();
+
+        const auto numChannels = jmax (getTotalNumInputChannels(), getTotalNumOutputChannels());
+        const auto capacity = SandboxProtocol::getRingCapacity (numChannels, maximumExpectedSamplesPerBlock);
+        const auto prefix = "jsbx" + String::toHexString (Random::getSystemRandom().nextInt64());
+
+        auto newToWorker = std::make_unique<SharedMemoryRing>();
+        auto newFromWorker = std::make_unique<SharedMemoryRing>();
+
+        if (! (newToWorker->create (prefix + "w", capacity) && newFromWorker->create (prefix + "h", capacity)))
+            return;
+
+        ValueTree request (SandboxProtocol::prepare);
+        request.setProperty (SandboxProtocol::sampleRate, newSampleRate, nullptr)
+               .setProperty (SandboxProtocol::blockSize, maximumExpectedSamplesPerBlock, nullptr)
+               .setProperty (SandboxProtocol::toWorker, prefix + "w", nullptr)
+               .setProperty (SandboxProtocol::fromWorker, prefix + "h", nullptr);
+
+        const auto reply = worker->sendRequest (request, 10000);
+
+        if (! reply.isValid() || reply.hasProperty (SandboxProtocol::error))
+            return;
+
+        setLatencySamples ((int) reply[SandboxProtocol::latency]);
+
+        const ScopedLock sl (ringLock);
+        toWorker = std::move (newToWorker);
+        fromWorker = std::move (newFromWorker);
+        currentSampleRate = newSampleRate;
+    }
+
+    void releaseResources() override
+    {
+        releaseRings();
+    }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+    {
+        const ScopedTryLock sl (ringLock);
+
+        if (! (sl.isLocked() && toWorker != nullptr && exchangeBlock (buffer, midi)))
+        {
+            buffer.clear();
+            midi.clear();
+        }
+    }
+
+    using AudioPluginInstance::processBlock;
+
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override
+    {
+        return layouts == getBusesLayout();
+    }
+
+    //==============================================================================
+    double getTailLengthSeconds() const override    { return tailLengthSeconds; }
+    bool acceptsMidi() const override               { return pluginAcceptsMidi; }
+    bool producesMidi() const override              { return pluginProducesMidi; }
+
+    AudioProcessorEditor* createEditor() override   { return nullptr; }
+    bool hasEditor() const override                 { return false; }
+
+    int getNumPrograms() override                           { return 1; }
+    int getCurrentProgram() override                        { return 0; }
+    void setCurrentProgram (int) override                   {}
+    const String getProgramName (int) override              { return {}; }
+    void changeProgramName (int, const String&) override    {}
+
+    void getStateInformation (MemoryBlock& destData) override
+    {
+        const auto reply = worker->sendRequest (ValueTree (SandboxProtocol::getState), 10000);
+
+        if (auto* block = reply[SandboxProtocol::state].getBinaryData())
+            destData = *block;
+    }
+
+    void setStateInformation (const void* data, int sizeInBytes) override
+    {
+        ValueTree request (SandboxProtocol::setState);
+        request.setProperty (SandboxProtocol::state, var (data, (size_t) sizeInBytes), nullptr);
+        worker->sendRequest (request, 10000);
+    }
+
+private:
+    //==============================================================================
+    /*  The connection to the worker, which passes each request over to it and waits
+        for the matching reply.
+    */
+    class WorkerProcess final : private ChildProcessCoordinator
+    {
+    public:
+        WorkerProcess() = default;
+
+        ~WorkerProcess() override
+        {
+            killWorkerProcess();
+        }
+
+        bool launch()
+        {
+            return launchWorkerProcess (File::getSpecialLocation (File::currentExecutableFile), sandboxProcessUID, 0, 0);
+        }
+
+        ValueTree sendRequest (ValueTree request, int timeoutMs)
+        {
+            const ScopedLock sl (requestLock);
+
+            std::unique_lock<std::mutex> lock { mutex };
+            request.setProperty (SandboxProtocol::requestId, ++lastRequestId, nullptr);
+            reply = {};
+            lock.unlock();
+
+            if (connectionLost || ! sendMessageToWorker (SandboxProtocol::toMemoryBlock (request)))
+                return {};
+
+            lock.lock();
+
+            if (! condvar.wait_for (lock, std::chrono::milliseconds { timeoutMs }, [&] { return reply.isValid() || connectionLost; }))
+                return {};
+
+            return std::exchange (reply, {});
+        }
+
+    private:
+        void handleMessageFromWorker (const MemoryBlock& mb) override
+        {
+            auto tree = ValueTree::readFromData (mb.getData(), mb.getSize());
+
+            const std::lock_guard<std::mutex> lock { mutex };
+
+            // Replies to requests that have already timed out are ignored
+            if (tree.hasType (SandboxProtocol::reply) && (int) tree[SandboxProtocol::requestId] == lastRequestId)
+            {
+                reply = tree;
+                condvar.notify_one();
+            }
+        }
+
+        void handleConnectionLost() override
+        {
+            const std::lock_guard<std::mutex> lock { mutex };
+            connectionLost = true;
+            condvar.notify_one();
+        }
+
+        CriticalSection requestLock;
+        std::mutex mutex;
+        std::condition_variable condvar;
+        ValueTree reply;
+        int lastRequestId = 0;
+        std::atomic<bool> connectionLost { false };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerProcess)
+    };
+
+    //==============================================================================
+    SandboxedPluginInstance (std::unique_ptr<WorkerProcess> w, const ValueTree& loadReply)
+        : AudioPluginInstance (getBusesProperties (loadReply)),
+          worker (std::move (w)),
+          tailLengthSeconds (loadReply[SandboxProtocol::tailLength]),
+          pluginAcceptsMidi (loadReply[SandboxProtocol::midiIn]),
+          pluginProducesMidi (loadReply[SandboxProtocol::midiOut])
+    {
+        if (auto xml = parseXML (loadReply[SandboxProtocol::description].toString()))
+            description.loadFromXml (*xml);
+
+        setLatencySamples ((int) loadReply[SandboxProtocol::latency]);
+    }
+
+    static BusesProperties getBusesProperties (const ValueTree& loadReply)
+    {
+        BusesProperties properties;
+        const auto numInputs = (int) loadReply[SandboxProtocol::numInputs];
+        const auto numOutputs = (int) loadReply[SandboxProtocol::numOutputs];
+
+        if (numInputs > 0)
+            properties = properties.withInput ("Input", AudioChannelSet::canonicalChannelSet (numInputs));
+
+        if (numOutputs > 0)
+            properties = properties.withOutput ("Output", AudioChannelSet::canonicalChannelSet (numOutputs));
+
+        return properties;
+    }
+
+    //==============================================================================
+    bool exchangeBlock (AudioBuffer<float>& buffer, MidiBuffer& midi)
+    {
+        const auto numInputs = getTotalNumInputChannels();
+        const auto numSamples = buffer.getNumSamples();
+        const auto midiSize = SandboxProtocol::getMidiSize (midi);
+        const auto size = SandboxProtocol::getBlockSize (numInputs, numSamples, midiSize);
+
+        // If the worker hasn't replied within the length of the block, we've already missed
+        // the deadline, so there's no point waiting any longer.
+        const auto timeoutMs = jmax (1, (int) std::ceil (1000.0 * numSamples / currentSampleRate));
+
+        auto* dest = toWorker->prepareToWrite (size, timeoutMs);
+
+        if (dest == nullptr)
+            return false;
+
+        const auto sequence = ++nextSequence;
+        SandboxProtocol::writeBlock (dest, sequence, buffer, numInputs, numSamples, midi, midiSize);
+        toWorker->finishedWriting();
+
+        for (;;)
+        {
+            size_t replySize = 0;
+            auto* message = fromWorker->waitForNextMessage (replySize, timeoutMs);
+
+            if (message == nullptr)
+                return false;
+
+            SandboxProtocol::BlockHeader header {};
+
+            if (replySize >= sizeof (header))
+                std::memcpy (&header, message, sizeof (header));
+
+            // Anything else is a late reply to a block that timed out
+            if (header.sequence == sequence)
+            {
+                const auto ok = SandboxProtocol::readBlock (message, replySize, header, buffer, midi);
+                fromWorker->finishedReading();
+                return ok;
+            }
+
+            fromWorker->finishedReading();
+        }
+    }
+
+    void releaseRings()
+    {
+        std::unique_ptr<SharedMemoryRing> oldToWorker, oldFromWorker;
+
+        {
+            const ScopedLock sl (ringLock);
+            std::swap (oldToWorker, toWorker);
+            std::swap (oldFromWorker, fromWorker);
+        }
+
+        if (oldToWorker == nullptr)
+            return;
+
+        oldToWorker->shutdown();
+        worker->sendRequest (ValueTree (SandboxProtocol::release), 5000);
+    }
+
+    //==============================================================================
+    std::unique_ptr<WorkerProcess> worker;
+    PluginDescription description;
+    double tailLengthSeconds = 0.0, currentSampleRate = 44100.0;
+    bool pluginAcceptsMidi = false, pluginProducesMidi = false;
+
+    CriticalSection ringLock;
+    std::unique_ptr<SharedMemoryRing> toWorker, fromWorker;
+    uint32 nextSequence = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SandboxedPluginInstance)
+};
+
+//==============================================================================
+/**
+    The other end of a SandboxedPluginInstance, running in the worker process.
+
+    Requests are handled on the message thread, and blocks of audio are processed on
+    a realtime thread which waits directly on the shared memory ring.
+*/
+class SandboxedPluginWorker final : private ChildProcessWorker,
+                                    private AsyncUpdater,
+                                    private Thread
+{
+public:
+    SandboxedPluginWorker()
+        : Thread ("Sandboxed plugin audio")
+    {
+        formatManager.addDefaultFormats();
+    }
+
+    ~SandboxedPluginWorker() override
+    {
+        cancelPendingUpdate();
+        stopAudio();
+    }
+
+    bool initialiseFromCommandLine (const String& commandLine)
+    {
+        return ChildProcessWorker::initialiseFromCommandLine (commandLine, sandboxProcessUID);
+    }
+
+private:
+    void handleMessageFromCoordinator (const MemoryBlock& mb) override
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        pendingRequests.push (ValueTree::readFromData (mb.getData(), mb.getSize()));
+        triggerAsyncUpdate();
+    }
+
+    void handleConnectionLost() override
+    {
+        JUCEApplicationBase::quit();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        for (;;)
+        {
+            ValueTree request;
+
+            {
+                const std::lock_guard<std::mutex> lock (mutex);
+
+                if (pendingRequests.empty())
+                    return;
+
+                request = pendingRequests.front();
+                pendingRequests.pop();
+            }
+
+            auto reply = handleRequest (request);
+            reply.setProperty (SandboxProtocol::requestId, request[SandboxProtocol::requestId], nullptr);
+            sendMessageToCoordinator (SandboxProtocol::toMemoryBlock (reply));
+        }
+    }
+
+    ValueTree handleRequest (const ValueTree& request)
+    {
+        ValueTree reply (SandboxProtocol::reply);
+
+        if (request.hasType (SandboxProtocol::load))
+        {
+            PluginDescription desc;
+            String error;
+
+            if (auto xml = parseXML (request[SandboxProtocol::description].toString()))
+                desc.loadFromXml (*xml);
+
+            plugin = formatManager.createPluginInstance (desc,
+                                                         request[SandboxProtocol::sampleRate],
+                                                         request[SandboxProtocol::blockSize],
+                                                         error);
+
+            if (plugin == nullptr)
+                return reply.setProperty (SandboxProtocol::error, error.isNotEmpty() ? error : TRANS ("Couldn't load the plugin"), nullptr);
+
+            plugin->fillInPluginDescription (desc);
+
+            return reply.setProperty (SandboxProtocol::description, desc.createXml()->toString(), nullptr)
+                        .setProperty (SandboxProtocol::numInputs, plugin->getTotalNumInputChannels(), nullptr)
+                        .setProperty (SandboxProtocol::numOutputs, plugin->getTotalNumOutputChannels(), nullptr)
+                        .setProperty (SandboxProtocol::latency, plugin->getLatencySamples(), nullptr)
+                        .setProperty (SandboxProtocol::tailLength, plugin->getTailLengthSeconds(), nullptr)
+                        .setProperty (SandboxProtocol::midiIn, plugin->acceptsMidi(), nullptr)
+                        .setProperty (SandboxProtocol::midiOut, plugin->producesMidi(), nullptr);
+        }
+
+        if (plugin == nullptr)
+            return reply.setProperty (SandboxProtocol::error, "No plugin loaded", nullptr);
+
+        if (request.hasType (SandboxProtocol::prepare))
+        {
+            stopAudio();
+
+            const double sampleRate = request[SandboxProtocol::sampleRate];
+            const int blockSize = request[SandboxProtocol::blockSize];
+
+            if (! (toWorker.openExisting (request[SandboxProtocol::toWorker].toString())
+                   && fromWorker.openExisting (request[SandboxProtocol::fromWorker].toString())))
+            {
+                return reply.setProperty (SandboxProtocol::error, "Couldn't open the audio buffers", nullptr);
+            }
+
+            plugin->setRateAndBufferSizeDetails (sampleRate, blockSize);
+            plugin->prepareToPlay (sampleRate, blockSize);
+
+            buffer.setSize (jmax (plugin->getTotalNumInputChannels(), plugin->getTotalNumOutputChannels()), blockSize);
+            midi.ensureSize (SandboxProtocol::maxMidiBytesPerBlock);
+
+            isPrepared = true;
+            startRealtimeThread (RealtimeOptions{}.withApproximateAudioProcessingTime (blockSize, sampleRate));
+
+            return reply.setProperty (SandboxProtocol::latency, plugin->getLatencySamples(), nullptr);
+        }
+
+        if (request.hasType (SandboxProtocol::release))
+        {
+            stopAudio();
+            return reply;
+        }
+
+        if (request.hasType (SandboxProtocol::getState))
+        {
+            MemoryBlock state;
+            plugin->getStateInformation (state);
+            return reply.setProperty (SandboxProtocol::state, state, nullptr);
+        }
+
+        if (request.hasType (SandboxProtocol::setState))
+        {
+            if (auto* state = request[SandboxProtocol::state].getBinaryData())
+                plugin->setStateInformation (state->getData(), (int) state->getSize());
+
+            return reply;
+        }
+
+        return reply.setProperty (SandboxProtocol::error, "Unknown request", nullptr);
+    }
+
+    void stopAudio()
+    {
+        stopThread (2000);
+        toWorker.close();
+        fromWorker.close();
+
+        if (std::exchange (isPrepared, false))
+            plugin->releaseResources();
+    }
+
+    //==============================================================================
+    void run() override
+    {
+        while (! threadShouldExit() && ! toWorker.isShutDown())
+        {
+            size_t size = 0;
+
+            if (auto* message = toWorker.waitForNextMessage (size, 100))
+            {
+                processMessage (message, size);
+                toWorker.finishedReading();
+            }
+        }
+    }
+
+    void processMessage (const void* message, size_t size)
+    {
+        SandboxProtocol::BlockHeader header {};
+
+        if (size >= sizeof (header))
+            std::memcpy (&header, message, sizeof (header));
+
+        // The buffer was allocated when preparing, so this won't reallocate for a block of
+        // the expected size
+        buffer.setSize (buffer.getNumChannels(), jmax (0, header.numSamples), false, false, true);
+
+        if (! SandboxProtocol::readBlock (message, size, header, buffer, midi))
+            return;
+
+        plugin->processBlock (buffer, midi);
+
+        const auto numOutputs = plugin->getTotalNumOutputChannels();
+        const auto midiSize = SandboxProtocol::getMidiSize (midi);
+        const auto replySize = SandboxProtocol::getBlockSize (numOutputs, header.numSamples, midiSize);
+
+        if (auto* dest = fromWorker.prepareToWrite (replySize, 100))
+        {
+            SandboxProtocol::writeBlock (dest, header.sequence, buffer, numOutputs, header.numSamples, midi, midiSize);
+            fromWorker.finishedWriting();
+        }
+    }
+
+    //==============================================================================
+    AudioPluginFormatManager formatManager;
+    std::unique_ptr<AudioPluginInstance> plugin;
+
+    std::mutex mutex;
+    std::queue<ValueTree> pendingRequests;
+
+    SharedMemoryRing toWorker, fromWorker;
+    AudioBuffer<float> buffer;
+    MidiBuffer midi;
+    bool isPrepared = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SandboxedPluginWorker)
+};
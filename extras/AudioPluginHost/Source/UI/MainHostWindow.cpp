@@ -29,6 +29,15 @@
 
 constexpr const char* scanModeKey = "pluginScanMode";
 
+/*  Plugins scanned in-process are checked one at a time on a single thread. When scanning
+    out-of-process, each scanning thread gets its own worker process, so a plugin that crashes
+    or hangs only takes down the worker that was scanning it.
+*/
+static int getNumberOfThreadsForScanMode (int scanMode)
+{
+    return scanMode == 0 ? 1 : jmax (1, SystemStats::getNumCpus() - 1);
+}
+
 //==============================================================================
 class Superprocess final : private ChildProcessCoordinator
 {
@@ -118,12 +127,13 @@ public:
     {
         if (scanInProcess)
         {
-            superprocess = nullptr;
             format.findAllTypesForFile (result, fileOrIdentifier);
             return true;
         }
 
-        if (addPluginDescriptions (format.getName(), fileOrIdentifier, result))
+        auto& superprocess = getSuperprocessForThisThread();
+
+        if (addPluginDescriptions (superprocess, format.getName(), fileOrIdentifier, result))
             return true;
 
         superprocess = nullptr;
@@ -132,7 +142,8 @@ public:
 
     void scanFinished() override
     {
-        superprocess = nullptr;
+        const std::lock_guard<std::mutex> lock { superprocessesMutex };
+        superprocesses.clear();
     }
 
 private:
@@ -141,9 +152,12 @@ private:
 
         Returns true on success.
 
-        Failure indicates that the subprocess is unrecoverable and should be terminated.
+        Failure indicates that the subprocess is unrecoverable and should be terminated. This
+        will also happen if the subprocess takes longer than scanTimeoutMs to respond, as the
+        plugin has probably hung.
     */
-    bool addPluginDescriptions (const String& formatName,
+    bool addPluginDescriptions (std::unique_ptr<Superprocess>& superprocess,
+                                const String& formatName,
                                 const String& fileOrIdentifier,
                                 OwnedArray<PluginDescription>& result)
     {
@@ -158,6 +172,8 @@ private:
         if (! superprocess->sendMessageToWorker (block))
             return false;
 
+        const auto startTime = Time::getMillisecondCounter();
+
         for (;;)
         {
             if (shouldExit())
@@ -166,7 +182,12 @@ private:
             const auto response = superprocess->getResponse();
 
             if (response.state == Superprocess::State::timeout)
+            {
+                if (Time::getMillisecondCounter() - startTime > scanTimeoutMs)
+                    return false;
+
                 continue;
+            }
 
             if (response.xml != nullptr)
             {
@@ -194,7 +215,17 @@ private:
         handleChange();
     }
 
-    std::unique_ptr<Superprocess> superprocess;
+    /*  Each scanning thread has its own subprocess, which is only used by that thread. */
+    std::unique_ptr<Superprocess>& getSuperprocessForThisThread()
+    {
+        const std::lock_guard<std::mutex> lock { superprocessesMutex };
+        return superprocesses[Thread::getCurrentThreadId()];
+    }
+
+    static constexpr uint32 scanTimeoutMs = 60000;
+
+    std::mutex superprocessesMutex;
+    std::map<Thread::ThreadID, std::unique_ptr<Superprocess>> superprocesses;
 
     std::atomic<bool> scanInProcess { true };
 
@@ -224,11 +255,15 @@ public:
         for (const auto mode : { "In-process", "Out-of-process" })
             validationModeBox.addItem (mode, unusedId++);
 
-        validationModeBox.setSelectedItemIndex (getAppProperties().getUserSettings()->getIntValue (scanModeKey));
+        const auto scanMode = getAppProperties().getUserSettings()->getIntValue (scanModeKey);
+        validationModeBox.setSelectedItemIndex (scanMode);
+        setNumberOfThreadsForScanning (getNumberOfThreadsForScanMode (scanMode));
 
         validationModeBox.onChange = [this]
         {
-            getAppProperties().getUserSettings()->setValue (scanModeKey, validationModeBox.getSelectedItemIndex());
+            const auto newScanMode = validationModeBox.getSelectedItemIndex();
+            getAppProperties().getUserSettings()->setValue (scanModeKey, newScanMode);
+            setNumberOfThreadsForScanning (getNumberOfThreadsForScanMode (newScanMode));
         };
 
         handleResize();
@@ -556,6 +591,10 @@ PopupMenu MainHostWindow::getMenuForIndex (int topLevelMenuIndex, const String&
         if (autoScaleOptionAvailable)
             menu.addCommandItem (&getCommandManager(), CommandIDs::autoScalePluginWindows);
 
+       #if ! (JUCE_IOS || JUCE_ANDROID)
+        menu.addCommandItem (&getCommandManager(), CommandIDs::toggleSandboxedPlugins);
+       #endif
+
         menu.addSeparator();
         menu.addCommandItem (&getCommandManager(), CommandIDs::aboutBox);
     }
@@ -744,7 +783,8 @@ void MainHostWindow::getAllCommands (Array<CommandID>& commands)
                               CommandIDs::toggleDoublePrecision,
                               CommandIDs::aboutBox,
                               CommandIDs::allWindowsForward,
-                              CommandIDs::autoScalePluginWindows
+                              CommandIDs::autoScalePluginWindows,
+                              CommandIDs::toggleSandboxedPlugins
                             };
 
     commands.addArray (ids, numElementsInArray (ids));
@@ -807,6 +847,10 @@ void MainHostWindow::getCommandInfo (const CommandID commandID, ApplicationComma
         updateAutoScaleMenuItem (result);
         break;
 
+    case CommandIDs::toggleSandboxedPlugins:
+        updateSandboxMenuItem (result);
+        break;
+
     default:
         break;
     }
@@ -896,6 +940,17 @@ bool MainHostWindow::perform (const InvocationInfo& info)
         }
         break;
 
+    case CommandIDs::toggleSandboxedPlugins:
+        if (auto* props = getAppProperties().getUserSettings())
+        {
+            props->setValue ("sandboxPlugins", var (! isPluginSandboxingEnabled()));
+
+            ApplicationCommandInfo cmdInfo (info.commandID);
+            updateSandboxMenuItem (cmdInfo);
+            menuItemsChanged();
+        }
+        break;
+
     case CommandIDs::aboutBox:
         // TODO
         break;
@@ -1024,6 +1079,14 @@ bool MainHostWindow::isAutoScalePluginWindowsEnabled()
     return false;
 }
 
+bool MainHostWindow::isPluginSandboxingEnabled()
+{
+    if (auto* props = getAppProperties().getUserSettings())
+        return props->getBoolValue ("sandboxPlugins", false);
+
+    return false;
+}
+
 void MainHostWindow::updatePrecisionMenuItem (ApplicationCommandInfo& info)
 {
     info.setInfo ("Double Floating-Point Precision Rendering", {}, "General", 0);
@@ -1035,3 +1098,9 @@ void MainHostWindow::updateAutoScaleMenuItem (ApplicationCommandInfo& info)
     info.setInfo ("Auto-Scale Plug-in Windows", {}, "General", 0);
     info.setTicked (isAutoScalePluginWindowsEnabled());
 }
+
+void MainHostWindow::updateSandboxMenuItem (ApplicationCommandInfo& info)
+{
+    info.setInfo ("Load New Plug-ins in Separate Processes", {}, "General", 0);
+    info.setTicked (isPluginSandboxingEnabled());
+}
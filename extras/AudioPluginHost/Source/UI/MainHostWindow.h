@@ -44,6 +44,7 @@ namespace CommandIDs
     static const int allWindowsForward      = 0x30400;
     static const int toggleDoublePrecision  = 0x30500;
     static const int autoScalePluginWindows = 0x30600;
+    static const int toggleSandboxedPlugins = 0x30700;
 }
 
 //==============================================================================
@@ -69,6 +70,7 @@ constexpr bool autoScaleOptionAvailable =
 AutoScale getAutoScaleValueForPlugin (const String&);
 void setAutoScaleValueForPlugin (const String&, AutoScale);
 bool shouldAutoScalePlugin (const PluginDescription&);
+bool shouldSandboxPlugin (const PluginDescription&);
 void addPluginAutoScaleOptionsSubMenu (AudioPluginInstance*, PopupMenu&);
 
 constexpr const char* processUID = "juceaudiopluginhost";
@@ -118,9 +120,11 @@ private:
     //==============================================================================
     static bool isDoublePrecisionProcessingEnabled();
     static bool isAutoScalePluginWindowsEnabled();
+    static bool isPluginSandboxingEnabled();
 
     static void updatePrecisionMenuItem (ApplicationCommandInfo& info);
     static void updateAutoScaleMenuItem (ApplicationCommandInfo& info);
+    static void updateSandboxMenuItem (ApplicationCommandInfo& info);
 
     void showAudioSettings();
 
@@ -393,7 +393,7 @@ endfunction()
 # ==================================================================================================
 
 function(juce_add_binary_data target)
-    set(one_value_args NAMESPACE HEADER_NAME)
+    set(one_value_args NAMESPACE HEADER_NAME COMPRESSION)
     set(multi_value_args SOURCES)
     cmake_parse_arguments(JUCE_ARG "" "${one_value_args}" "${multi_value_args}" ${ARGN})
 
@@ -427,6 +427,18 @@ function(juce_add_binary_data target)
 
     list(APPEND binary_file_names "${juce_binary_data_folder}/${JUCE_ARG_HEADER_NAME}")
 
+    set(compression_args)
+
+    if(JUCE_ARG_COMPRESSION)
+        string(TOLOWER "${JUCE_ARG_COMPRESSION}" compression)
+
+        if(NOT compression MATCHES "^(lz4|deflate)$")
+            message(FATAL_ERROR "juce_add_binary_data COMPRESSION must be LZ4 or DEFLATE")
+        endif()
+
+        set(compression_args "--compression=${compression}")
+    endif()
+
     set(newline_delimited_input)
 
     foreach(name IN LISTS JUCE_ARG_SOURCES)
@@ -439,7 +451,7 @@ function(juce_add_binary_data target)
 
     add_custom_command(OUTPUT ${binary_file_names}
         COMMAND juce::juceaide binarydata "${JUCE_ARG_NAMESPACE}" "${JUCE_ARG_HEADER_NAME}"
-            ${juce_binary_data_folder} "${input_file_list}"
+            ${juce_binary_data_folder} "${input_file_list}" ${compression_args}
         WORKING_DIRECTORY ${CMAKE_CURRENT_LIST_DIR}
         DEPENDS "${input_file_list}" ${JUCE_ARG_SOURCES}
         VERBATIM)
@@ -78,6 +78,40 @@ namespace juce::build_tools
            << newLine;
     }
 
+    Result ResourceFile::compressResources()
+    {
+        storedResources.clear();
+
+        for (auto& file : files)
+        {
+            MemoryBlock original;
+
+            if (! file.loadFileAsData (original))
+                return Result::fail ("Can't open resource file: " + file.getFullPathName());
+
+            MemoryBlock compressed (compressionCodec->getMaxCompressedSize (original.getSize()));
+            const auto compressedSize = compressionCodec->compressBlock (original.getData(), original.getSize(),
+                                                                         compressed.getData(), compressed.getSize(), -1);
+            StoredResource resource;
+
+            // Anything that doesn't get smaller is stored as it is, so it can be used without decompressing
+            if (compressedSize > 0 && compressedSize < original.getSize())
+            {
+                compressed.setSize (compressedSize);
+                resource.data = std::move (compressed);
+                resource.codecId = compressionCodec->getCodecId();
+            }
+            else
+            {
+                resource.data = std::move (original);
+            }
+
+            storedResources.push_back (std::move (resource));
+        }
+
+        return Result::ok();
+    }
+
     Result ResourceFile::writeHeader (MemoryOutputStream& header)
     {
         header << "/* =========================================================================================";
@@ -87,6 +121,13 @@ namespace juce::build_tools
                << "namespace " << className << newLine
                << "{" << newLine;
 
+        if (compressionCodec != nullptr)
+            header << "    // Some of these resources are compressed. Each Size value is the number of bytes that the"               << newLine
+                   << "    // data variable points to, and a CodecId other than 0 means that the data has to be decompressed"       << newLine
+                   << "    // with the juce::CompressionCodec that has that ID before it can be used, for example by using"         << newLine
+                   << "    // a juce::BinaryResourceCache."                                                                          << newLine
+                   << newLine;
+
         for (int i = 0; i < files.size(); ++i)
         {
             auto& file = files.getReference (i);
@@ -102,8 +143,20 @@ namespace juce::build_tools
 
             if (fileStream.openedOk())
             {
-                header << "    extern const char*   " << variableName << ";" << newLine;
-                header << "    const int            " << variableName << "Size = " << (int) dataSize << ";" << newLine << newLine;
+                if (compressionCodec != nullptr)
+                {
+                    auto& stored = storedResources[(size_t) i];
+
+                    header << "    extern const char*   " << variableName << ";" << newLine;
+                    header << "    const int            " << variableName << "Size = " << (int) stored.data.getSize() << ";" << newLine;
+                    header << "    const int            " << variableName << "OriginalSize = " << (int) dataSize << ";" << newLine;
+                    header << "    const int            " << variableName << "CodecId = " << stored.codecId << ";" << newLine << newLine;
+                }
+                else
+                {
+                    header << "    extern const char*   " << variableName << ";" << newLine;
+                    header << "    const int            " << variableName << "Size = " << (int) dataSize << ";" << newLine << newLine;
+                }
             }
         }
 
@@ -122,8 +175,17 @@ namespace juce::build_tools
                << newLine
                << "    // If you provide the name of one of the binary resource variables above, this function will"             << newLine
                << "    // return the corresponding original, non-mangled filename (or a null pointer if the name isn't found)."  << newLine
-               << "    const char* getNamedResourceOriginalFilename (const char* resourceNameUTF8);"                             << newLine
-               << "}" << newLine;
+               << "    const char* getNamedResourceOriginalFilename (const char* resourceNameUTF8);"                             << newLine;
+
+        if (compressionCodec != nullptr)
+            header << newLine
+                   << "    // If you provide the name of one of the binary resource variables above, this function will"             << newLine
+                   << "    // return the corresponding data, its size, the size it had before it was compressed and the ID"          << newLine
+                   << "    // of the codec that compressed it (or a null pointer if the name isn't found)."                          << newLine
+                   << "    const char* getNamedResourceStorage (const char* resourceNameUTF8, int& dataSizeInBytes,"                 << newLine
+                   << "                                         int& originalSizeInBytes, int& codecId);"                            << newLine;
+
+        header << "}" << newLine;
 
         return Result::ok();
     }
@@ -153,6 +215,11 @@ namespace juce::build_tools
                 cpp  << newLine << "//================== " << file.getFileName() << " ==================" << newLine
                      << "static const unsigned char " << tempVariable << "[] =" << newLine;
 
+                if (compressionCodec != nullptr)
+                {
+                    writeDataAsCppLiteral (storedResources[(size_t) i].data, cpp, true, true);
+                }
+                else
                 {
                     MemoryBlock data;
                     fileStream.readIntoMemoryBlock (data);
@@ -189,10 +256,11 @@ namespace juce::build_tools
                 << "{" << newLine;
 
             StringArray returnCodes;
-            for (auto& file : files)
+            for (int j = 0; j < files.size(); ++j)
             {
-                auto dataSize = file.getSize();
-                returnCodes.add ("numBytes = " + String (dataSize) + "; return " + variableNames[files.indexOf (file)] + ";");
+                auto dataSize = compressionCodec != nullptr ? (int64) storedResources[(size_t) j].data.getSize()
+                                                            : files.getReference (j).getSize();
+                returnCodes.add ("numBytes = " + String (dataSize) + "; return " + variableNames[j] + ";");
             }
 
             createStringMatcher (cpp, "resourceNameUTF8", variableNames, returnCodes, 4);
@@ -228,6 +296,30 @@ namespace juce::build_tools
                 << "    return nullptr;"                                                                                 << newLine
                 << "}"                                                                                                   << newLine
                 <<                                                                                                          newLine;
+
+            if (compressionCodec != nullptr)
+            {
+                cpp << "const char* getNamedResourceStorage (const char* resourceNameUTF8, int& numBytes, int& originalNumBytes, int& codecId);" << newLine
+                    << "const char* getNamedResourceStorage (const char* resourceNameUTF8, int& numBytes, int& originalNumBytes, int& codecId)"  << newLine
+                    << "{" << newLine;
+
+                StringArray storageReturnCodes;
+                for (int j = 0; j < files.size(); ++j)
+                {
+                    const auto& stored = storedResources[(size_t) j];
+                    storageReturnCodes.add ("numBytes = " + String ((int64) stored.data.getSize())
+                                            + "; originalNumBytes = " + String (files.getReference (j).getSize())
+                                            + "; codecId = " + String (stored.codecId)
+                                            + "; return " + variableNames[j] + ";");
+                }
+
+                createStringMatcher (cpp, "resourceNameUTF8", variableNames, storageReturnCodes, 4);
+
+                cpp << "    numBytes = originalNumBytes = codecId = 0;" << newLine
+                    << "    return nullptr;" << newLine
+                    << "}" << newLine
+                    << newLine;
+            }
         }
 
         cpp << "}" << newLine;
@@ -242,6 +334,14 @@ namespace juce::build_tools
     {
         Array<File> filesCreated;
 
+        if (compressionCodec != nullptr)
+        {
+            auto r = compressResources();
+
+            if (r.failed())
+                return { r, {} };
+        }
+
         {
             MemoryOutputStream mo;
             mo.setNewLineString (projectLineFeed);
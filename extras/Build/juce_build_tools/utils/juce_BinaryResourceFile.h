@@ -47,6 +47,11 @@ namespace juce::build_tools
 
         int64 getTotalDataSize() const;
 
+        /** Makes write() compress each file with the given codec, wherever that makes the
+            file smaller. Pass nullptr to store the files as they are, which is the default.
+        */
+        void setCompressionCodec (const CompressionCodec* codec)     { compressionCodec = codec; }
+
         struct WriteResult
         {
             Result result;
@@ -59,9 +64,19 @@ namespace juce::build_tools
                            std::function<File (int)> getCppFile);
 
     private:
+        struct StoredResource
+        {
+            MemoryBlock data;
+            int codecId = CompressionCodec::storedCodecId;
+        };
+
         Array<File> files;
         StringArray variableNames;
         String className { "BinaryData" };
+        const CompressionCodec* compressionCodec = nullptr;
+        std::vector<StoredResource> storedResources;
+
+        Result compressResources();
 
         Result writeHeader (MemoryOutputStream&);
 
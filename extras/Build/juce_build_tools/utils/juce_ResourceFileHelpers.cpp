@@ -64,16 +64,135 @@ namespace juce::build_tools
         return t;
     }
 
+    //==============================================================================
+    // Remembers the size, modification time and content hash of each file that has been
+    // written or found to be up to date, so that saving the same data again doesn't need
+    // to read the file back while nothing else has touched it.
+    //
+    // Modification times may only be stored to the nearest second or two, so a record that
+    // was made too soon after the file changed can't tell a later change of the same size
+    // apart. Those records aren't trusted, and the file gets compared again instead.
+    class WrittenFileRecords
+    {
+    public:
+        struct Record
+        {
+            int64 size = -1;
+            Time lastModified;
+            uint64 hash = 0;
+            Time whenRecorded = Time::getCurrentTime();
+        };
+
+        static WrittenFileRecords& getInstance()
+        {
+            static WrittenFileRecords records;
+            return records;
+        }
+
+        bool matches (const File& file, const Record& current) const
+        {
+            const ScopedLock sl (lock);
+            const auto found = records.find (file.getFullPathName());
+
+            return found != records.end()
+                && found->second.lastModified + RelativeTime::seconds (2.0) < found->second.whenRecorded
+                && found->second.size == current.size
+                && found->second.lastModified == current.lastModified
+                && found->second.hash == current.hash;
+        }
+
+        void set (const File& file, const Record& record)
+        {
+            const ScopedLock sl (lock);
+            records[file.getFullPathName()] = record;
+        }
+
+        void remove (const File& file)
+        {
+            const ScopedLock sl (lock);
+            records.erase (file.getFullPathName());
+        }
+
+    private:
+        CriticalSection lock;
+        std::map<String, Record> records;
+    };
+
+    // A 64-bit FNV-1a variant that consumes eight bytes at a time, which is much quicker
+    // than calculateMemoryHashCode() for the large files that exporters write
+    static uint64 calculateRecordHash (const void* data, size_t numBytes)
+    {
+        constexpr uint64 prime = 0x100000001b3ull;
+        uint64 hash = 0xcbf29ce484222325ull ^ (uint64) numBytes;
+        auto* bytes = static_cast<const uint8*> (data);
+
+        for (; numBytes >= sizeof (uint64); numBytes -= sizeof (uint64), bytes += sizeof (uint64))
+        {
+            uint64 word;
+            memcpy (&word, bytes, sizeof (word));
+            hash = (hash ^ word) * prime;
+            hash ^= hash >> 29;
+        }
+
+        for (; numBytes > 0; --numBytes)
+            hash = (hash ^ *bytes++) * prime;
+
+        return hash;
+    }
+
+    static bool fileContentIsEqual (const File& file, const void* data, size_t numBytes)
+    {
+        FileInputStream in (file);
+
+        if (! in.openedOk() || in.getTotalLength() != (int64) numBytes)
+            return false;
+
+        constexpr size_t bufferSize = 65536;
+        HeapBlock<char> buffer (bufferSize);
+
+        for (size_t pos = 0; pos < numBytes;)
+        {
+            const auto num = jmin (bufferSize, numBytes - pos);
+
+            if (in.read (buffer, (int) num) != (int) num
+                || memcmp (buffer, static_cast<const char*> (data) + pos, num) != 0)
+                return false;
+
+            pos += num;
+        }
+
+        return true;
+    }
+
     bool overwriteFileWithNewDataIfDifferent (const File& file, const void* data, size_t numBytes)
     {
-        if (file.getSize() == (int64) numBytes
-            && calculateMemoryHashCode (data, numBytes) == calculateFileHashCode (file))
-            return true;
+        auto& writtenFiles = WrittenFileRecords::getInstance();
+        const auto hash = calculateRecordHash (data, numBytes);
+        const auto size = file.getSize();
+
+        if (size == (int64) numBytes)
+        {
+            const WrittenFileRecords::Record current { size, file.getLastModificationTime(), hash };
+
+            if (writtenFiles.matches (file, current))
+                return true;
+
+            if (fileContentIsEqual (file, data, numBytes))
+            {
+                writtenFiles.set (file, current);
+                return true;
+            }
+        }
+
+        const auto written = file.exists() ? file.replaceWithData (data, numBytes)
+                                           : (file.getParentDirectory().createDirectory() && file.appendData (data, numBytes));
 
-        if (file.exists())
-            return file.replaceWithData (data, numBytes);
+        if (written)
+            writtenFiles.set (file, { (int64) numBytes, file.getLastModificationTime(), hash });
+        else
+            writtenFiles.remove (file);
 
-        return file.getParentDirectory().createDirectory() && file.appendData (data, numBytes);
+        return written;
     }
 
     bool overwriteFileWithNewDataIfDifferent (const File& file, const MemoryOutputStream& newData)
@@ -80,6 +80,18 @@ int writeBinaryData (juce::ArgumentList&& args)
     resourceFile.setClassName (namespaceName.text);
     const auto lineEndings = args.removeOptionIfFound ("--windows") ? "\r\n" : "\n";
 
+    if (args.containsOption ("--compression"))
+    {
+        const auto compression = args.removeValueForOption ("--compression").toLowerCase();
+
+        if (compression == "lz4")
+            resourceFile.setCompressionCodec (&juce::CompressionCodec::getLZ4Codec());
+        else if (compression == "deflate")
+            resourceFile.setCompressionCodec (&juce::CompressionCodec::getDeflateCodec());
+        else
+            juce::ConsoleApplication::fail ("Unknown compression: " + compression, 1);
+    }
+
     const auto allLines = [&]
     {
         auto lines = juce::StringArray::fromLines (inputFileList.loadFileAsString());
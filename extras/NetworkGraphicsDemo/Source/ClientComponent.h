@@ -116,8 +116,12 @@ private:
             if (packetiser.reassemble (newCanvasData))
             {
                 MemoryInputStream i (newCanvasData.getData(), newCanvasData.getSize(), false);
-                canvas2.load (i);
-                triggerAsyncUpdate();
+
+                if (receivedCanvas.load (i))
+                {
+                    canvas2.copyFrom (receivedCanvas);
+                    triggerAsyncUpdate();
+                }
             }
         }
     }
@@ -220,6 +224,9 @@ private:
     }
 
     SharedCanvasDescription canvas, canvas2;
+
+    // The last frame that was received, which the next set of changes will be applied to
+    SharedCanvasDescription receivedCanvas;
     PropertiesFile& properties;
     String clientName, error;
 
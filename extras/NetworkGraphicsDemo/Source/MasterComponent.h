@@ -87,6 +87,7 @@ struct MasterContentComponent final : public Component,
 
         removeClient (name);
         clients.add ({ name, ipAddress, area.getWidth(), area.getHeight(), {}, 1.0f });
+        framesUntilCompleteFrame = 0;
 
         String lastX = properties.getValue ("lastX_" + name);
         String lastY = properties.getValue ("lastY_" + name);
@@ -329,6 +330,7 @@ private:
     }
 
     //==============================================================================
+    // The state is encoded and split into packets once, and the same packets are sent to every client
     void broadcastNewCanvasState (const MemoryBlock& canvasData)
     {
         BlockPacketiser packetiser;
@@ -354,7 +356,19 @@ private:
                 content->generateCanvas (g, currentCanvas, getActiveCanvasArea());
         }
 
-        broadcastNewCanvasState (currentCanvas.toMemoryBlock());
+        currentCanvas.frameNumber = lastSentCanvas.frameNumber + 1;
+
+        if (--framesUntilCompleteFrame <= 0)
+        {
+            broadcastNewCanvasState (currentCanvas.toMemoryBlock());
+            framesUntilCompleteFrame = framesBetweenCompleteFrames;
+        }
+        else
+        {
+            broadcastNewCanvasState (currentCanvas.toMemoryBlock (lastSentCanvas));
+        }
+
+        lastSentCanvas.copyFrom (currentCanvas);
 
         updateDeviceComponents();
         repaint();
@@ -413,9 +427,13 @@ private:
     AnimatedContent* content = nullptr;
     PropertiesFile& properties;
     OwnedArray<DeviceComponent> devices;
-    SharedCanvasDescription currentCanvas;
+    SharedCanvasDescription currentCanvas, lastSentCanvas;
     String error;
 
+    // Clients that have missed a packet can't apply any changes until they get a complete frame
+    static constexpr int framesBetweenCompleteFrames = 30;
+    int framesUntilCompleteFrame = 0;
+
     OwnedArray<AnimatedContent> demos;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MasterContentComponent)
@@ -33,6 +33,10 @@
 
     All the path coordinates are roughly in units of inches, and devices will convert
     this to pixels based on their screen size and DPI
+
+    To save bandwidth, most frames are sent as a set of changes to the previous frame,
+    where each path is identified by its index in the list. Every so often a complete
+    frame is sent, so that clients which join late or lose a packet can catch up.
 */
 struct SharedCanvasDescription
 {
@@ -57,6 +61,10 @@ struct SharedCanvasDescription
 
     Array<ClientArea> clients;
 
+    // Identifies the frame that this description holds, so that a set of changes is only
+    // applied to the frame it was made from
+    int frameNumber = 0;
+
     //==============================================================================
     void reset()
     {
@@ -67,10 +75,19 @@ struct SharedCanvasDescription
     void swapWith (SharedCanvasDescription& other)
     {
         std::swap (backgroundColour, other.backgroundColour);
+        std::swap (frameNumber, other.frameNumber);
         paths.swapWith (other.paths);
         clients.swapWith (other.clients);
     }
 
+    void copyFrom (const SharedCanvasDescription& other)
+    {
+        backgroundColour = other.backgroundColour;
+        frameNumber = other.frameNumber;
+        paths = other.paths;
+        clients = other.clients;
+    }
+
     // This is a fixed size that represents the overall canvas limits that
     // content should lie within
     Rectangle<float> getLimits() const
@@ -122,33 +139,59 @@ struct SharedCanvasDescription
     //==============================================================================
     // Serialisation...
 
+    // Writes the complete frame, which can be loaded without any previous state
     void save (OutputStream& out) const
     {
-        out.writeInt (magic);
-        out.writeInt ((int) backgroundColour.getARGB());
-
-        out.writeInt (clients.size());
+        writeHeader (out, completeFrame, 0);
 
-        for (const auto& c : clients)
+        for (const auto& p : paths)
         {
-            out.writeString (c.name);
-            writePoint (out, c.centre);
-            out.writeFloat (c.scaleFactor);
+            writeFill (out, p.fill);
+            p.path.writePathToStream (out);
         }
+    }
 
-        out.writeInt (paths.size());
+    // Writes only the paths and fills that differ from the previous frame
+    void saveChanges (OutputStream& out, const SharedCanvasDescription& previous) const
+    {
+        writeHeader (out, changedFrame, previous.frameNumber);
 
-        for (const auto& p : paths)
+        for (int i = 0; i < paths.size(); ++i)
         {
-            writeFill (out, p.fill);
-            p.path.writePathToStream (out);
+            const auto& p = paths.getReference (i);
+            const auto* old = i < previous.paths.size() ? &previous.paths.getReference (i) : nullptr;
+
+            const bool fillChanged = old == nullptr || old->fill != p.fill;
+            const bool pathChanged = old == nullptr || old->path != p.path;
+
+            if (! (fillChanged || pathChanged))
+                continue;
+
+            out.writeCompressedInt (i);
+            out.writeByte ((char) ((fillChanged ? fillFlag : 0) | (pathChanged ? pathFlag : 0)));
+
+            if (fillChanged)
+                writeFill (out, p.fill);
+
+            if (pathChanged)
+                p.path.writePathToStream (out);
         }
+
+        out.writeCompressedInt (-1);
     }
 
-    void load (InputStream& in)
+    // Returns false if the data was a set of changes to a frame that this description
+    // doesn't hold, in which case it stays as it is until the next complete frame arrives
+    bool load (InputStream& in)
     {
         if (in.readInt() != magic)
-            return;
+            return false;
+
+        const auto frameType = in.readByte();
+        const auto newFrameNumber = in.readInt();
+
+        if (frameType == changedFrame && in.readInt() != frameNumber)
+            return false;
 
         backgroundColour = Colour ((uint32) in.readInt());
 
@@ -166,8 +209,37 @@ struct SharedCanvasDescription
             }
         }
 
+        const int numPaths = in.readInt();
+
+        if (frameType == changedFrame)
+        {
+            paths.resize (numPaths);
+
+            for (;;)
+            {
+                const int index = in.readCompressedInt();
+
+                if (index < 0)
+                    break;
+
+                if (index >= numPaths || in.isExhausted())
+                    return false;
+
+                auto& p = paths.getReference (index);
+                const int flags = in.readByte();
+
+                if ((flags & fillFlag) != 0)
+                    p.fill = readFill (in);
+
+                if ((flags & pathFlag) != 0)
+                {
+                    p.path.clear();
+                    p.path.loadPathFromStream (in);
+                }
+            }
+        }
+        else
         {
-            const int numPaths = in.readInt();
             paths.clearQuick();
 
             for (int i = 0; i < numPaths; ++i)
@@ -179,6 +251,9 @@ struct SharedCanvasDescription
                 paths.add (std::move (p));
             }
         }
+
+        frameNumber = newFrameNumber;
+        return true;
     }
 
     MemoryBlock toMemoryBlock() const
@@ -188,8 +263,41 @@ struct SharedCanvasDescription
         return o.getMemoryBlock();
     }
 
+    MemoryBlock toMemoryBlock (const SharedCanvasDescription& previous) const
+    {
+        MemoryOutputStream o;
+        saveChanges (o, previous);
+        return o.getMemoryBlock();
+    }
+
 private:
     //==============================================================================
+    enum { completeFrame = 0, changedFrame = 1 };
+    enum { fillFlag = 1, pathFlag = 2 };
+
+    void writeHeader (OutputStream& out, int frameType, int previousFrameNumber) const
+    {
+        out.writeInt (magic);
+        out.writeByte ((char) frameType);
+        out.writeInt (frameNumber);
+
+        if (frameType == changedFrame)
+            out.writeInt (previousFrameNumber);
+
+        out.writeInt ((int) backgroundColour.getARGB());
+
+        out.writeInt (clients.size());
+
+        for (const auto& c : clients)
+        {
+            out.writeString (c.name);
+            writePoint (out, c.centre);
+            out.writeFloat (c.scaleFactor);
+        }
+
+        out.writeInt (paths.size());
+    }
+
     static void writePoint (OutputStream& out, Point<float> p)
     {
         out.writeFloat (p.x);
@@ -776,10 +776,7 @@ void ProjectSaver::writeProjects (const OwnedArray<LibraryModule>& modules, Proj
                 generatedFilesGroup.sortAlphabetically (true, true);
                 exporter->getAllGroups().add (generatedFilesGroup);
 
-                if (ProjucerApplication::getApp().isRunningCommandLine)
-                    saveExporter (*exporter, modules);
-                else
-                    threadPool.addJob ([this, &exporter, &modules] { saveExporter (*exporter, modules); });
+                threadPool.addJob ([this, &exporter, &modules] { saveExporter (*exporter, modules); });
             }
             else
             {
@@ -845,10 +842,20 @@ void ProjectSaver::saveExporter (ProjectExporter& exporter, const OwnedArray<Lib
 
         auto outputString = "Finished saving: " + exporter.getUniqueName();
 
-        if (MessageManager::getInstance()->isThisTheMessageThread())
+        // The command line doesn't run a message loop, so the exporters report from their own threads
+        if (ProjucerApplication::getApp().isRunningCommandLine)
+        {
+            const ScopedLock sl (errorLock);
+            std::cout <<  outputString << std::endl;
+        }
+        else if (MessageManager::getInstance()->isThisTheMessageThread())
+        {
             std::cout <<  outputString << std::endl;
+        }
         else
+        {
             MessageManager::callAsync ([outputString] { std::cout <<  outputString << std::endl; });
+        }
     }
     catch (build_tools::SaveError& error)
     {
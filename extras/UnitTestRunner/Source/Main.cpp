@@ -55,7 +55,8 @@ int main (int argc, char **argv)
 
     if (args.containsOption ("--help|-h"))
     {
-        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category=category] [--seed=seed]" << std::endl;
+        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category=category] [--seed=seed]"
+                     " [--benchmark] [--benchmark-output=file] [--benchmark-baseline=file] [--benchmark-tolerance=0.1]" << std::endl;
         return 0;
     }
 
@@ -87,11 +88,24 @@ int main (int argc, char **argv)
         return Random::getSystemRandom().nextInt64();
     }();
 
+    runner.setBenchmarksEnabled (args.containsOption ("--benchmark"));
+
+    if (args.containsOption ("--benchmark-baseline"))
+    {
+        const auto baselineFile = args.getFileForOption ("--benchmark-baseline");
+        const auto tolerance = args.containsOption ("--benchmark-tolerance") ? args.getValueForOption ("--benchmark-tolerance").getDoubleValue()
+                                                                             : 0.1;
+        runner.setBenchmarkBaseline (JSON::parse (baselineFile), tolerance);
+    }
+
     if (args.containsOption ("--category"))
         runner.runTestsInCategory (args.getValueForOption ("--category"), seed);
     else
         runner.runAllTests (seed);
 
+    if (args.containsOption ("--benchmark-output"))
+        args.getFileForOption ("--benchmark-output").replaceWithText (JSON::toString (runner.getBenchmarkResultsAsJson()));
+
     std::vector<String> failures;
 
     for (int i = 0; i < runner.getNumResults(); ++i)
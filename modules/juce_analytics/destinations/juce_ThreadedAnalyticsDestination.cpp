@@ -26,6 +26,229 @@
 namespace juce
 {
 
+namespace AnalyticsEventEncoding
+{
+    using AnalyticsEvent = AnalyticsDestination::AnalyticsEvent;
+
+    constexpr char batchMagic[] = { 'J', 'A', 'E' };
+    constexpr char journalMagic[] = { 'J', 'A', 'J', 1 };
+
+    enum : char { uncompressedBatch = 1, compressedBatch = 2 };
+    enum : char { addRecord = 1, removeRecord = 2 };
+
+    // Strings are written as an index into the strings already written, or 0 followed by a new string
+    struct Writer
+    {
+        explicit Writer (OutputStream& o) : out (o) {}
+
+        void writeString (const String& s)
+        {
+            if (strings.contains (s))
+            {
+                out.writeCompressedInt (strings[s] + 1);
+                return;
+            }
+
+            out.writeCompressedInt (0);
+            out.writeString (s);
+            strings.set (s, strings.size());
+        }
+
+        void writePairs (const StringPairArray& pairs)
+        {
+            out.writeCompressedInt (pairs.size());
+
+            for (int i = 0; i < pairs.size(); ++i)
+            {
+                writeString (pairs.getAllKeys()[i]);
+                writeString (pairs.getAllValues()[i]);
+            }
+        }
+
+        void writeEvent (const AnalyticsEvent& event)
+        {
+            writeString (event.name);
+            out.writeCompressedInt (event.eventType);
+            out.writeCompressedInt ((int) (event.timestamp - previousTimestamp));
+            writeString (event.userID);
+            writePairs (event.parameters);
+            writePairs (event.userProperties);
+
+            previousTimestamp = event.timestamp;
+        }
+
+        OutputStream& out;
+        HashMap<String, int> strings;
+        uint32 previousTimestamp = 0;
+    };
+
+    struct Reader
+    {
+        explicit Reader (InputStream& i) : in (i) {}
+
+        bool readString (String& s)
+        {
+            const auto index = in.readCompressedInt();
+
+            if (index == 0)
+            {
+                s = in.readString();
+                strings.add (s);
+                return true;
+            }
+
+            if (! isPositiveAndNotGreaterThan (index, strings.size()))
+                return false;
+
+            s = strings[index - 1];
+            return true;
+        }
+
+        bool readPairs (StringPairArray& pairs)
+        {
+            const auto numPairs = in.readCompressedInt();
+
+            if (numPairs < 0)
+                return false;
+
+            for (int i = 0; i < numPairs; ++i)
+            {
+                String key, value;
+
+                if (! (readString (key) && readString (value)))
+                    return false;
+
+                pairs.set (key, value);
+            }
+
+            return true;
+        }
+
+        bool readEvent (AnalyticsEvent& event)
+        {
+            if (in.isExhausted() || ! readString (event.name))
+                return false;
+
+            event.eventType = in.readCompressedInt();
+            event.timestamp = previousTimestamp + (uint32) in.readCompressedInt();
+            previousTimestamp = event.timestamp;
+
+            return readString (event.userID)
+                && readPairs (event.parameters)
+                && readPairs (event.userProperties);
+        }
+
+        InputStream& in;
+        StringArray strings;
+        uint32 previousTimestamp = 0;
+    };
+
+    static bool readEvents (InputStream& in, Array<AnalyticsEvent>& events)
+    {
+        const auto numEvents = in.readCompressedInt();
+
+        if (numEvents < 0)
+            return false;
+
+        Reader reader (in);
+        events.ensureStorageAllocated (events.size() + numEvents);
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            AnalyticsEvent event {};
+
+            if (! reader.readEvent (event))
+                return false;
+
+            events.add (std::move (event));
+        }
+
+        return true;
+    }
+
+    static size_t getEstimatedSize (const AnalyticsEvent& event)
+    {
+        const auto getSize = [] (const StringPairArray& pairs)
+        {
+            size_t size = 0;
+
+            for (int i = 0; i < pairs.size(); ++i)
+                size += 2 * sizeof (String) + pairs.getAllKeys()[i].getNumBytesAsUTF8() + pairs.getAllValues()[i].getNumBytesAsUTF8();
+
+            return size;
+        };
+
+        return sizeof (AnalyticsEvent)
+                 + event.name.getNumBytesAsUTF8()
+                 + event.userID.getNumBytesAsUTF8()
+                 + getSize (event.parameters)
+                 + getSize (event.userProperties);
+    }
+
+    static void writeRecord (OutputStream& out, char recordType, const MemoryOutputStream& payload)
+    {
+        out.writeByte (recordType);
+        out.writeCompressedInt ((int) payload.getDataSize());
+        out.write (payload.getData(), payload.getDataSize());
+    }
+
+    static void writeAddRecord (OutputStream& out, int sequenceNumber, const AnalyticsEvent& event)
+    {
+        MemoryOutputStream payload;
+        payload.writeCompressedInt (sequenceNumber);
+        Writer (payload).writeEvent (event);
+        writeRecord (out, addRecord, payload);
+    }
+
+    // Replays the records in a journal. A truncated final record, which would be
+    // left by a crash part-way through writing it, is ignored.
+    static void readJournal (const File& file, std::deque<AnalyticsEvent>& events)
+    {
+        MemoryBlock data;
+
+        if (! file.loadFileAsData (data) || data.getSize() < sizeof (journalMagic)
+             || std::memcmp (data.getData(), journalMagic, sizeof (journalMagic)) != 0)
+            return;
+
+        MemoryInputStream in (data, false);
+        in.setPosition ((int64) sizeof (journalMagic));
+
+        std::vector<std::pair<int, AnalyticsEvent>> journalledEvents;
+        std::set<int> removedSequenceNumbers;
+
+        while (! in.isExhausted())
+        {
+            const auto recordType = in.readByte();
+            const auto payloadSize = in.readCompressedInt();
+
+            if (payloadSize < 0 || payloadSize > in.getNumBytesRemaining())
+                break;
+
+            MemoryInputStream payload (static_cast<const char*> (data.getData()) + in.getPosition(), (size_t) payloadSize, false);
+            in.skipNextBytes (payloadSize);
+
+            if (recordType == addRecord)
+            {
+                const auto sequenceNumber = payload.readCompressedInt();
+                AnalyticsEvent event {};
+
+                if (Reader (payload).readEvent (event))
+                    journalledEvents.emplace_back (sequenceNumber, std::move (event));
+            }
+            else if (recordType == removeRecord)
+            {
+                for (auto i = payload.readCompressedInt(); --i >= 0 && ! payload.isExhausted();)
+                    removedSequenceNumbers.insert (payload.readCompressedInt());
+            }
+        }
+
+        for (auto& [sequenceNumber, event] : journalledEvents)
+            if (removedSequenceNumbers.count (sequenceNumber) == 0)
+                events.push_back (std::move (event));
+    }
+}
+
+//==============================================================================
 ThreadedAnalyticsDestination::ThreadedAnalyticsDestination (const String& threadName)
     : dispatcher (threadName, *this)
 {}
@@ -47,6 +270,85 @@ void ThreadedAnalyticsDestination::logEvent (const AnalyticsEvent& event)
     dispatcher.addToQueue (event);
 }
 
+void ThreadedAnalyticsDestination::setMaximumQueueMemory (size_t maxNumBytes)
+{
+    const ScopedLock lock (dispatcher.queueAccess);
+    dispatcher.maxQueueMemory = maxNumBytes;
+    dispatcher.trimQueue();
+}
+
+int64 ThreadedAnalyticsDestination::getNumDroppedEvents() const noexcept
+{
+    return dispatcher.numDroppedEvents;
+}
+
+MemoryBlock ThreadedAnalyticsDestination::encodeEvents (const Array<AnalyticsEvent>& events, bool compress)
+{
+    MemoryOutputStream body;
+    body.writeCompressedInt (events.size());
+
+    AnalyticsEventEncoding::Writer writer (body);
+
+    for (auto& event : events)
+        writer.writeEvent (event);
+
+    MemoryOutputStream result;
+    result.write (AnalyticsEventEncoding::batchMagic, sizeof (AnalyticsEventEncoding::batchMagic));
+
+    if (compress)
+    {
+        result.writeByte (AnalyticsEventEncoding::compressedBatch);
+        GZIPCompressorOutputStream zipper (result, 9);
+        zipper.write (body.getData(), body.getDataSize());
+    }
+    else
+    {
+        result.writeByte (AnalyticsEventEncoding::uncompressedBatch);
+        result.write (body.getData(), body.getDataSize());
+    }
+
+    return result.getMemoryBlock();
+}
+
+bool ThreadedAnalyticsDestination::decodeEvents (const MemoryBlock& data, Array<AnalyticsEvent>& events)
+{
+    constexpr auto headerSize = sizeof (AnalyticsEventEncoding::batchMagic) + 1;
+
+    if (data.getSize() < headerSize
+         || std::memcmp (data.getData(), AnalyticsEventEncoding::batchMagic, sizeof (AnalyticsEventEncoding::batchMagic)) != 0)
+        return false;
+
+    MemoryInputStream in (data, false);
+    in.setPosition ((int64) headerSize);
+
+    switch (data[headerSize - 1])
+    {
+        case AnalyticsEventEncoding::uncompressedBatch:
+            return AnalyticsEventEncoding::readEvents (in, events);
+
+        case AnalyticsEventEncoding::compressedBatch:
+        {
+            GZIPDecompressorInputStream unzipper (in);
+            MemoryBlock body;
+            unzipper.readIntoMemoryBlock (body);
+
+            MemoryInputStream bodyStream (body, false);
+            return AnalyticsEventEncoding::readEvents (bodyStream, events);
+        }
+
+        default:
+            return false;
+    }
+}
+
+void ThreadedAnalyticsDestination::setUnloggedEventJournal (const File& journalFile)
+{
+    // This must be called before the analytics thread is started!
+    jassert (! dispatcher.isThreadRunning());
+
+    dispatcher.journalFile = journalFile;
+}
+
 void ThreadedAnalyticsDestination::startAnalyticsThread (int initialBatchPeriodMilliseconds)
 {
     setBatchPeriod (initialBatchPeriodMilliseconds);
@@ -59,6 +361,9 @@ void ThreadedAnalyticsDestination::stopAnalyticsThread (int timeout)
     stopLoggingEvents();
     dispatcher.stopThread (timeout);
 
+    dispatcher.updateJournal();
+    dispatcher.journal.reset();
+
     if (dispatcher.eventQueue.size() > 0)
         saveUnloggedEvents (dispatcher.eventQueue);
 }
@@ -75,15 +380,30 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
     // before this thread has started, so make sure the old events are at the
     // front of the queue.
     {
-        std::deque<AnalyticsEvent> restoredEventQueue;
-        parent.restoreUnloggedEvents (restoredEventQueue);
+        std::deque<AnalyticsEvent> restoredEventQueue, eventsFromSubclass;
+
+        if (journalFile != File())
+            AnalyticsEventEncoding::readJournal (journalFile, restoredEventQueue);
+
+        parent.restoreUnloggedEvents (eventsFromSubclass);
+        restoredEventQueue.insert (restoredEventQueue.end(), eventsFromSubclass.begin(), eventsFromSubclass.end());
 
         const ScopedLock lock (queueAccess);
 
         for (auto rit = restoredEventQueue.rbegin(); rit != restoredEventQueue.rend(); ++rit)
+        {
+            const auto numBytes = AnalyticsEventEncoding::getEstimatedSize (*rit);
             eventQueue.push_front (*rit);
+            eventInfo.push_front ({ nextSequenceNumber++, numBytes });
+            queueMemory += numBytes;
+        }
+
+        trimQueue();
     }
 
+    if (journalFile != File())
+        openJournal();
+
     const int maxBatchSize = parent.getMaximumBatchSize();
 
     while (! threadShouldExit())
@@ -117,13 +437,13 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
             {
                 const ScopedLock lock (queueAccess);
 
-                for (auto i = 0; i < eventsToSend.size(); ++i)
-                    eventQueue.pop_front();
-
+                removeFromQueue (0, (size_t) eventsToSend.size());
                 eventsToSend.clearQuick();
             }
         }
 
+        updateJournal();
+
         while (Time::getMillisecondCounter() - submissionTime < (uint32) batchPeriodMilliseconds.get())
         {
             if (threadShouldExit())
@@ -136,8 +456,134 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
 
 void ThreadedAnalyticsDestination::EventDispatcher::addToQueue (const AnalyticsEvent& event)
 {
+    const auto numBytes = AnalyticsEventEncoding::getEstimatedSize (event);
+
     const ScopedLock lock (queueAccess);
     eventQueue.push_back (event);
+    eventInfo.push_back ({ nextSequenceNumber++, numBytes });
+    queueMemory += numBytes;
+    trimQueue();
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::removeFromQueue (size_t index, size_t numEvents)
+{
+    for (auto i = index; i < index + numEvents; ++i)
+    {
+        queueMemory -= eventInfo[i].numBytes;
+
+        if (eventInfo[i].sequenceNumber < nextSequenceNumberToJournal)
+            sequenceNumbersToRemoveFromJournal.push_back (eventInfo[i].sequenceNumber);
+    }
+
+    eventQueue.erase (eventQueue.begin() + (ptrdiff_t) index, eventQueue.begin() + (ptrdiff_t) (index + numEvents));
+    eventInfo.erase (eventInfo.begin() + (ptrdiff_t) index, eventInfo.begin() + (ptrdiff_t) (index + numEvents));
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::trimQueue()
+{
+    if (maxQueueMemory == 0)
+        return;
+
+    // The events in the current batch may be in use by logBatchedEvents, so they can't be dropped
+    const auto firstEventToDrop = (size_t) eventsToSend.size();
+    auto numEventsToDrop = (size_t) 0;
+    auto newQueueMemory = queueMemory;
+
+    while (newQueueMemory > maxQueueMemory && firstEventToDrop + numEventsToDrop < eventQueue.size())
+        newQueueMemory -= eventInfo[firstEventToDrop + numEventsToDrop++].numBytes;
+
+    if (numEventsToDrop > 0)
+    {
+        removeFromQueue (firstEventToDrop, numEventsToDrop);
+        numDroppedEvents += (int64) numEventsToDrop;
+    }
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::openJournal()
+{
+    // Start a fresh journal containing just the events that are currently queued
+    std::deque<AnalyticsEvent> eventsToWrite;
+    std::vector<int> sequenceNumbers;
+
+    {
+        const ScopedLock lock (queueAccess);
+        eventsToWrite = eventQueue;
+
+        for (auto& info : eventInfo)
+            sequenceNumbers.push_back (info.sequenceNumber);
+
+        nextSequenceNumberToJournal = nextSequenceNumber;
+        sequenceNumbersToRemoveFromJournal.clear();
+    }
+
+    TemporaryFile temp (journalFile);
+
+    {
+        FileOutputStream out (temp.getFile());
+
+        if (out.openedOk())
+        {
+            out.write (AnalyticsEventEncoding::journalMagic, sizeof (AnalyticsEventEncoding::journalMagic));
+
+            for (size_t i = 0; i < eventsToWrite.size(); ++i)
+                AnalyticsEventEncoding::writeAddRecord (out, sequenceNumbers[i], eventsToWrite[i]);
+        }
+    }
+
+    if (temp.overwriteTargetFileWithTemporary())
+    {
+        journal = std::make_unique<FileOutputStream> (journalFile);
+
+        if (journal->openedOk())
+            return;
+
+        journal.reset();
+    }
+
+    // The journal can't be written, so stop keeping track of changes to it
+    const ScopedLock lock (queueAccess);
+    nextSequenceNumberToJournal = 0;
+    sequenceNumbersToRemoveFromJournal.clear();
+}
+
+void ThreadedAnalyticsDestination::EventDispatcher::updateJournal()
+{
+    if (journal == nullptr)
+        return;
+
+    std::vector<std::pair<int, AnalyticsEvent>> newEvents;
+    std::vector<int> removedSequenceNumbers;
+
+    {
+        const ScopedLock lock (queueAccess);
+
+        // New events are always added at the back of the queue
+        for (auto i = eventQueue.size(); i > 0 && eventInfo[i - 1].sequenceNumber >= nextSequenceNumberToJournal; --i)
+            newEvents.emplace_back (eventInfo[i - 1].sequenceNumber, eventQueue[i - 1]);
+
+        std::reverse (newEvents.begin(), newEvents.end());
+        removedSequenceNumbers.swap (sequenceNumbersToRemoveFromJournal);
+        nextSequenceNumberToJournal = nextSequenceNumber;
+    }
+
+    if (newEvents.empty() && removedSequenceNumbers.empty())
+        return;
+
+    for (auto& [sequenceNumber, event] : newEvents)
+        AnalyticsEventEncoding::writeAddRecord (*journal, sequenceNumber, event);
+
+    if (! removedSequenceNumbers.empty())
+    {
+        MemoryOutputStream payload;
+        payload.writeCompressedInt ((int) removedSequenceNumbers.size());
+
+        for (auto sequenceNumber : removedSequenceNumbers)
+            payload.writeCompressedInt (sequenceNumber);
+
+        AnalyticsEventEncoding::writeRecord (*journal, AnalyticsEventEncoding::removeRecord, payload);
+    }
+
+    journal->flush();
 }
 
 
@@ -151,11 +597,15 @@ namespace DestinationTestHelpers
     struct BasicDestination final : public ThreadedAnalyticsDestination
     {
         BasicDestination (std::deque<AnalyticsEvent>& loggedEvents,
-                          std::deque<AnalyticsEvent>& unloggedEvents)
+                          std::deque<AnalyticsEvent>& unloggedEvents,
+                          const File& journalFile = {})
             : ThreadedAnalyticsDestination ("ThreadedAnalyticsDestinationTest"),
               loggedEventQueue (loggedEvents),
               unloggedEventStore (unloggedEvents)
         {
+            if (journalFile != File())
+                setUnloggedEventJournal (journalFile);
+
             startAnalyticsThread (20);
         }
 
@@ -281,6 +731,112 @@ struct ThreadedAnalyticsDestinationTests final : public UnitTest
 
         compareEventQueues (unloggedEvents, testEvents);
         expect (loggedEvents.size() == 0);
+
+        beginTest ("Event encoding");
+        {
+            Array<AnalyticsDestination::AnalyticsEvent> events;
+
+            for (int i = 0; i < 50; ++i)
+            {
+                StringPairArray parameters, userProperties;
+                parameters.set ("index", String (i));
+                parameters.set ("category", "Test");
+                userProperties.set ("plan", "Free");
+
+                events.add ({ "Event" + String (i % 3), i % 4, 0xfffffff0u + (uint32) i * 7u, parameters, "TestUser", userProperties });
+            }
+
+            for (auto compress : { false, true })
+            {
+                const auto encoded = ThreadedAnalyticsDestination::encodeEvents (events, compress);
+
+                Array<AnalyticsDestination::AnalyticsEvent> decoded;
+                expect (ThreadedAnalyticsDestination::decodeEvents (encoded, decoded));
+                expectEquals (decoded.size(), events.size());
+
+                for (int i = 0; i < jmin (decoded.size(), events.size()); ++i)
+                {
+                    expectEquals (decoded[i].name, events[i].name);
+                    expectEquals (decoded[i].eventType, events[i].eventType);
+                    expect (decoded[i].timestamp == events[i].timestamp);
+                    expect (decoded[i].parameters == events[i].parameters);
+                    expectEquals (decoded[i].userID, events[i].userID);
+                    expect (decoded[i].userProperties == events[i].userProperties);
+                }
+
+                auto truncated = encoded;
+                truncated.setSize (encoded.getSize() / 2);
+                Array<AnalyticsDestination::AnalyticsEvent> ignored;
+                expect (! ThreadedAnalyticsDestination::decodeEvents (truncated, ignored));
+            }
+
+            expect (ThreadedAnalyticsDestination::encodeEvents (events, true).getSize()
+                      < ThreadedAnalyticsDestination::encodeEvents (events, false).getSize());
+        }
+
+        beginTest ("Queue memory limit");
+        {
+            unloggedEvents.clear();
+            int64 numDropped = 0;
+
+            {
+                DestinationTestHelpers::BasicDestination destination (loggedEvents, unloggedEvents);
+                destination.setLoggingEnabled (false);
+                destination.setMaximumQueueMemory (3 * sizeof (AnalyticsDestination::AnalyticsEvent) + 100);
+
+                for (auto& event : testEvents)
+                    destination.logEvent (event);
+
+                numDropped = destination.getNumDroppedEvents();
+            }
+
+            expect (numDropped > 0);
+            expectEquals ((int64) unloggedEvents.size() + numDropped, (int64) testEvents.size());
+        }
+
+        beginTest ("Unlogged event journal");
+        {
+            const TemporaryFile journal (".journal");
+            std::deque<AnalyticsDestination::AnalyticsEvent> logged, unlogged;
+
+            {
+                DestinationTestHelpers::BasicDestination destination (logged, unlogged, journal.getFile());
+                destination.setLoggingEnabled (false);
+
+                for (auto& event : testEvents)
+                    destination.logEvent (event);
+            }
+
+            expect (journal.getFile().existsAsFile());
+
+            // Only use the journal from here on
+            unlogged.clear();
+
+            {
+                DestinationTestHelpers::BasicDestination destination (logged, unlogged, journal.getFile());
+
+                for (int waitTime = 0; waitTime < 4000; waitTime += 40)
+                {
+                    Thread::sleep (40);
+
+                    const ScopedLock lock (destination.eventQueueChanging);
+
+                    if (logged.size() >= testEvents.size())
+                        break;
+                }
+            }
+
+            compareEventQueues (logged, testEvents);
+            unlogged.clear();
+            logged.clear();
+
+            {
+                DestinationTestHelpers::BasicDestination destination (logged, unlogged, journal.getFile());
+                destination.setLoggingEnabled (false);
+            }
+
+            expect (unlogged.empty());
+        }
     }
 };
 
@@ -128,6 +128,47 @@ public:
     */
     void logEvent (const AnalyticsEvent& event) override final;
 
+    /**
+        Limits the amount of memory used by events that are waiting to be logged.
+
+        If adding an event takes the queue over this limit, the oldest events that
+        aren't part of the batch currently being logged are discarded until it fits.
+        The size of each event is estimated from the lengths of its strings.
+
+        A value of zero, which is the default, means that the queue can grow without limit.
+
+        This method is thread safe.
+
+        @see getNumDroppedEvents
+    */
+    void setMaximumQueueMemory (size_t maxNumBytes);
+
+    /** Returns the number of events that have been discarded because of the
+        limit set by setMaximumQueueMemory().
+    */
+    int64 getNumDroppedEvents() const noexcept;
+
+    //==============================================================================
+    /**
+        Encodes some events in a compact binary form, which you can use to send them
+        to a server or to store them.
+
+        Each string that appears more than once (such as a user ID or a parameter name)
+        is only stored the first time, and each timestamp is stored relative to the one
+        before it. If compress is true, the data is also zlib-compressed.
+
+        @see decodeEvents
+    */
+    static MemoryBlock encodeEvents (const Array<AnalyticsEvent>& events, bool compress);
+
+    /**
+        Decodes data created by encodeEvents(), adding the events to the end of the array.
+
+        Returns false if the data isn't in the expected format, in which case the array
+        may contain some of the events.
+    */
+    static bool decodeEvents (const MemoryBlock& data, Array<AnalyticsEvent>& events);
+
 protected:
     //==============================================================================
     /**
@@ -138,6 +179,22 @@ protected:
     */
     void startAnalyticsThread (int initialBatchPeriodMilliseconds);
 
+    /**
+        Keeps an append-only journal of the events that haven't been logged yet.
+
+        New events are appended to the file on the analytics thread, and a record is
+        appended whenever events are logged or dropped, so events will survive if the
+        app crashes. When the analytics thread starts, any unlogged events in the
+        journal are put at the front of the queue, and the file is rewritten to contain
+        only these events.
+
+        This is independent of saveUnloggedEvents and restoreUnloggedEvents, so if you
+        use a journal, those methods should normally do nothing.
+
+        This must be called before startAnalyticsThread.
+    */
+    void setUnloggedEventJournal (const File& journalFile);
+
     //==============================================================================
     /**
         Triggers the shutdown of the analytics thread.
@@ -197,15 +254,37 @@ private:
 
         void run() override;
         void addToQueue (const AnalyticsEvent&);
+        void removeFromQueue (size_t index, size_t numEvents);
+        void trimQueue();
+
+        void openJournal();
+        void updateJournal();
 
         ThreadedAnalyticsDestination& parent;
 
+        struct QueuedEventInfo
+        {
+            int sequenceNumber;
+            size_t numBytes;
+        };
+
+        // eventInfo holds the matching entry for each event in eventQueue
         std::deque<AnalyticsEvent> eventQueue;
+        std::deque<QueuedEventInfo> eventInfo;
         CriticalSection queueAccess;
 
         Atomic<int> batchPeriodMilliseconds { 1000 };
 
         Array<AnalyticsEvent> eventsToSend;
+
+        size_t queueMemory = 0, maxQueueMemory = 0;
+        std::atomic<int64> numDroppedEvents { 0 };
+        int nextSequenceNumber = 0;
+
+        File journalFile;
+        std::unique_ptr<FileOutputStream> journal;
+        int nextSequenceNumberToJournal = 0;
+        std::vector<int> sequenceNumbersToRemoveFromJournal;
     };
 
     const String destinationName;
@@ -450,6 +450,234 @@ void AudioDataConverters::deinterleaveSamples (const float* source, float** dest
                                     numSamples);
 }
 
+//==============================================================================
+namespace AudioDataConversionHelpers
+{
+    constexpr int framesPerBlock = 256;
+
+    template <int bits, bool isBigEndian>
+    struct PackedInt
+    {
+        static constexpr int bytesPerSample = bits / 8, shift = 32 - bits;
+
+        static int32 load (const char* p) noexcept
+        {
+            if constexpr (bits == 16)       return (int16) (isBigEndian ? ByteOrder::bigEndianShort (p) : ByteOrder::littleEndianShort (p));
+            else if constexpr (bits == 24)  return isBigEndian ? ByteOrder::bigEndian24Bit (p) : ByteOrder::littleEndian24Bit (p);
+            else                            return (int32) (isBigEndian ? ByteOrder::bigEndianInt (p) : ByteOrder::littleEndianInt (p));
+        }
+
+        static void store (char* p, int32 value) noexcept
+        {
+            if constexpr (bits == 16)       writeUnaligned (p, isBigEndian ? ByteOrder::swapIfLittleEndian ((uint16) value) : ByteOrder::swapIfBigEndian ((uint16) value));
+            else if constexpr (bits == 24)  isBigEndian ? ByteOrder::bigEndian24BitToChars (value, p) : ByteOrder::littleEndian24BitToChars (value, p);
+            else                            writeUnaligned (p, isBigEndian ? ByteOrder::swapIfLittleEndian ((uint32) value) : ByteOrder::swapIfBigEndian ((uint32) value));
+        }
+    };
+
+    template <bool isBigEndian>
+    struct PackedFloat
+    {
+        static constexpr int bytesPerSample = 4;
+
+        static uint32 load (const char* p) noexcept      { return isBigEndian ? ByteOrder::bigEndianInt (p) : ByteOrder::littleEndianInt (p); }
+        static void store (char* p, uint32 bits) noexcept
+        {
+            writeUnaligned (p, isBigEndian ? ByteOrder::swapIfLittleEndian (bits) : ByteOrder::swapIfBigEndian (bits));
+        }
+    };
+
+    //==============================================================================
+    // Equivalent to AudioData::Float32::getAsInt32(), which all of the integer formats use when
+    // converting from floating point data
+    static void convertFloatToInt32 (const float* src, int32* dest, int num) noexcept
+    {
+        constexpr auto maxValue = (double) 0x7fffffff;
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        const auto mult = _mm_set1_pd (maxValue), hi = _mm_set1_pd (1.0), lo = _mm_set1_pd (-1.0);
+
+        for (; i + 4 <= num; i += 4)
+        {
+            const auto v = _mm_loadu_ps (src + i);
+            const auto a = _mm_cvtpd_epi32 (_mm_mul_pd (mult, _mm_min_pd (hi, _mm_max_pd (lo, _mm_cvtps_pd (v)))));
+            const auto b = _mm_cvtpd_epi32 (_mm_mul_pd (mult, _mm_min_pd (hi, _mm_max_pd (lo, _mm_cvtps_pd (_mm_movehl_ps (v, v))))));
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i), _mm_unpacklo_epi64 (a, b));
+        }
+       #elif JUCE_USE_ARM_NEON && JUCE_64BIT
+        const auto mult = vdupq_n_f64 (maxValue), hi = vdupq_n_f64 (1.0), lo = vdupq_n_f64 (-1.0);
+
+        for (; i + 4 <= num; i += 4)
+        {
+            const auto v = vld1q_f32 (src + i);
+            const auto a = vmovn_s64 (vcvtnq_s64_f64 (vmulq_f64 (mult, vminq_f64 (hi, vmaxq_f64 (lo, vcvt_f64_f32 (vget_low_f32 (v)))))));
+            const auto b = vmovn_s64 (vcvtnq_s64_f64 (vmulq_f64 (mult, vminq_f64 (hi, vmaxq_f64 (lo, vcvt_high_f64_f32 (v))))));
+            vst1q_s32 (dest + i, vcombine_s32 (a, b));
+        }
+       #endif
+
+        for (; i < num; ++i)
+            dest[i] = roundToInt (jlimit (-1.0, 1.0, (double) src[i]) * maxValue);
+    }
+
+    //==============================================================================
+    template <typename Format>
+    static void readChannelBlock (const char* src, int strideBytes, int32* dest, bool toFloat, int num) noexcept
+    {
+        if constexpr (std::is_same_v<Format, PackedFloat<true>> || std::is_same_v<Format, PackedFloat<false>>)
+        {
+            ignoreUnused (toFloat);
+
+            for (int i = 0; i < num; ++i)
+                dest[i] = (int32) Format::load (src + i * strideBytes);
+        }
+        else if (toFloat)
+        {
+            for (int i = 0; i < num; ++i)
+                dest[i] = Format::load (src + i * strideBytes);
+
+            // Converting to float and scaling by a power of two gives the same result as
+            // the double-precision arithmetic in the per-sample conversions
+            FloatVectorOperations::convertFixedToFloat (reinterpret_cast<float*> (dest), dest,
+                                                        1.0f / (float) (1u << (8 * Format::bytesPerSample - 1)), num);
+        }
+        else
+        {
+            for (int i = 0; i < num; ++i)
+                dest[i] = (int32) ((uint32) Format::load (src + i * strideBytes) << Format::shift);
+        }
+    }
+
+    template <typename Format>
+    static void writeChannelBlock (const void* src, bool fromFloat, char* dest, int strideBytes, int num) noexcept
+    {
+        if constexpr (std::is_same_v<Format, PackedFloat<true>> || std::is_same_v<Format, PackedFloat<false>>)
+        {
+            ignoreUnused (fromFloat);
+            auto* s = static_cast<const uint32*> (src);
+
+            for (int i = 0; i < num; ++i)
+                Format::store (dest + i * strideBytes, s[i]);
+        }
+        else if (fromFloat)
+        {
+            int32 temp[framesPerBlock];
+            convertFloatToInt32 (static_cast<const float*> (src), temp, num);
+
+            for (int i = 0; i < num; ++i)
+                Format::store (dest + i * strideBytes, temp[i] >> Format::shift);
+        }
+        else
+        {
+            auto* s = static_cast<const int32*> (src);
+
+            for (int i = 0; i < num; ++i)
+                Format::store (dest + i * strideBytes, s[i] >> Format::shift);
+        }
+    }
+
+    //==============================================================================
+    template <typename Format>
+    static void convertToNonInterleaved (const void* source, int sourceStride, int numSourceChannels,
+                                         void* const* dest, int numDestChannels, bool destIsFloat, int numSamples) noexcept
+    {
+        const auto strideBytes = sourceStride * Format::bytesPerSample;
+
+        for (int start = 0; start < numSamples; start += framesPerBlock)
+        {
+            const auto num = jmin (framesPerBlock, numSamples - start);
+            auto* frames = static_cast<const char*> (source) + start * strideBytes;
+
+            for (int i = 0; i < numDestChannels; ++i)
+            {
+                if (auto* d = static_cast<int32*> (dest[i]))
+                {
+                    if (i < numSourceChannels)
+                        readChannelBlock<Format> (frames + i * Format::bytesPerSample, strideBytes, d + start, destIsFloat, num);
+                    else
+                        zeromem (d + start, (size_t) num * sizeof (int32));
+                }
+            }
+        }
+    }
+
+    template <typename Format>
+    static void convertFromNonInterleaved (const void* const* source, int numSourceChannels, bool sourceIsFloat,
+                                           void* dest, int destStride, int numDestChannels, int numSamples) noexcept
+    {
+        const auto strideBytes = destStride * Format::bytesPerSample;
+
+        // interleaveSamples() stops reading sources at the first null channel, leaving the
+        // corresponding destination channels untouched
+        auto numSourcesToRead = jmin (numSourceChannels, numDestChannels);
+
+        for (int i = 0; i < numSourcesToRead; ++i)
+            if (source[i] == nullptr)
+                numSourcesToRead = i;
+
+        for (int start = 0; start < numSamples; start += framesPerBlock)
+        {
+            const auto num = jmin (framesPerBlock, numSamples - start);
+            auto* frames = static_cast<char*> (dest) + start * strideBytes;
+
+            for (int i = 0; i < numDestChannels; ++i)
+            {
+                auto* d = frames + i * Format::bytesPerSample;
+
+                if (i < numSourcesToRead)
+                {
+                    writeChannelBlock<Format> (static_cast<const int32*> (source[i]) + start, sourceIsFloat, d, strideBytes, num);
+                }
+                else if (i >= numSourceChannels)
+                {
+                    for (int j = 0; j < num; ++j)
+                        zeromem (d + j * strideBytes, (size_t) Format::bytesPerSample);
+                }
+            }
+        }
+    }
+}
+
+template <typename Callback>
+void AudioData::withPackedFormat (PackedFormat format, Callback&& callback)
+{
+    using namespace AudioDataConversionHelpers;
+
+    switch (format)
+    {
+        case PackedFormat::int16LE:    callback (PackedInt<16, false>{}); break;
+        case PackedFormat::int16BE:    callback (PackedInt<16, true>{});  break;
+        case PackedFormat::int24LE:    callback (PackedInt<24, false>{}); break;
+        case PackedFormat::int24BE:    callback (PackedInt<24, true>{});  break;
+        case PackedFormat::int32LE:    callback (PackedInt<32, false>{}); break;
+        case PackedFormat::int32BE:    callback (PackedInt<32, true>{});  break;
+        case PackedFormat::float32LE:  callback (PackedFloat<false>{});   break;
+        case PackedFormat::float32BE:  callback (PackedFloat<true>{});    break;
+        case PackedFormat::none:       jassertfalse; break;
+    }
+}
+
+void AudioData::convertToNonInterleaved (PackedFormat sourceFormat, const void* source, int sourceStride, int numSourceChannels,
+                                         void* const* dest, int numDestChannels, bool destIsFloat, int numSamples) noexcept
+{
+    withPackedFormat (sourceFormat, [&] (auto format)
+    {
+        AudioDataConversionHelpers::convertToNonInterleaved<decltype (format)> (source, sourceStride, numSourceChannels,
+                                                                                  dest, numDestChannels, destIsFloat, numSamples);
+    });
+}
+
+void AudioData::convertFromNonInterleaved (const void* const* source, int numSourceChannels, bool sourceIsFloat,
+                                           PackedFormat destFormat, void* dest, int destStride, int numDestChannels, int numSamples) noexcept
+{
+    withPackedFormat (destFormat, [&] (auto format)
+    {
+        AudioDataConversionHelpers::convertFromNonInterleaved<decltype (format)> (source, numSourceChannels, sourceIsFloat,
+                                                                                    dest, destStride, numDestChannels, numSamples);
+    });
+}
+
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -565,6 +793,92 @@ public:
         }
     };
 
+    template <class F, class E>
+    struct BlockConversionTest
+    {
+        using Packed      = AudioData::Pointer<F, E, AudioData::Interleaved, AudioData::NonConst>;
+        using NativeFloat = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
+        using PackedData  = typename AudioData::InterleavedDest<F, E>::DataType;
+
+        static void test (UnitTest& unitTest, Random& r)
+        {
+            constexpr auto numChannels = 9;
+            constexpr auto numSamples = 1000;
+            const auto numBytes = (size_t) (numChannels * numSamples * Packed::getBytesPerSample());
+
+            HeapBlock<char> packed (numBytes, true), expectedPacked (numBytes, true);
+            AudioBuffer<float> floats (numChannels + 1, numSamples), expectedFloats (numChannels, numSamples);
+            AudioBuffer<float> intStorage (numChannels + 1, numSamples), expectedInts (numChannels, numSamples);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                Packed p (packed + ch * Packed::getBytesPerSample(), numChannels);
+
+                for (int i = 0; i < numSamples; ++i, ++p)
+                {
+                    p.setAsFloat (r.nextFloat() * 2.2f - 1.1f);
+                    expectedFloats.setSample (ch, i, p.getAsFloat());
+                    reinterpret_cast<int32*> (expectedInts.getWritePointer (ch))[i] = p.getAsInt32();
+                }
+            }
+
+            // Reading packed data into all of the channels at once..
+            floats.clear();
+            floats.getWritePointer (numChannels)[0] = 1.0f;
+
+            AudioData::deinterleaveSamples (AudioData::InterleavedSource<F, E>                               { reinterpret_cast<PackedData> (packed.get()), numChannels },
+                                            AudioData::NonInterleavedDest<AudioData::Float32, AudioData::NativeEndian> { floats.getArrayOfWritePointers(), numChannels + 1 },
+                                            numSamples);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                unitTest.expect (std::equal (floats.getReadPointer (ch), floats.getReadPointer (ch) + numSamples, expectedFloats.getReadPointer (ch)));
+
+            unitTest.expect (exactlyEqual (floats.getReadPointer (numChannels)[0], 0.0f));
+
+            if constexpr (! F::isFloat)
+            {
+                auto* const* intChannels = reinterpret_cast<uint32* const*> (intStorage.getArrayOfWritePointers());
+
+                AudioData::deinterleaveSamples (AudioData::InterleavedSource<F, E>                             { reinterpret_cast<PackedData> (packed.get()), numChannels },
+                                                AudioData::NonInterleavedDest<AudioData::Int32, AudioData::NativeEndian> { intChannels, numChannels },
+                                                numSamples);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    unitTest.expect (std::equal (intChannels[ch], intChannels[ch] + numSamples, reinterpret_cast<const uint32*> (expectedInts.getReadPointer (ch))));
+            }
+
+            // ..and a single sub-channel, as the audio device code does
+            AudioData::ConverterInstance<AudioData::Pointer<F, E, AudioData::Interleaved, AudioData::Const>,
+                                         AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>> reader (numChannels, 1);
+            floats.clear();
+            reader.convertSamples (floats.getWritePointer (0), 0, packed, 5, numSamples);
+            unitTest.expect (std::equal (floats.getReadPointer (0), floats.getReadPointer (0) + numSamples, expectedFloats.getReadPointer (5)));
+
+            // Writing floats back to packed data, beyond the clipping range of the integer formats
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    floats.setSample (ch, i, r.nextFloat() * 2.2f - 1.1f);
+
+                Packed p (expectedPacked + ch * Packed::getBytesPerSample(), numChannels);
+
+                for (int i = 0; i < numSamples; ++i, ++p)
+                {
+                    if (F::isFloat)
+                        p.setAsFloat (floats.getSample (ch, i));
+                    else
+                        p.setAsInt32 (NativeFloat (floats.getReadPointer (ch, i)).getAsInt32());
+                }
+            }
+
+            AudioData::interleaveSamples (AudioData::NonInterleavedSource<AudioData::Float32, AudioData::NativeEndian> { floats.getArrayOfReadPointers(), numChannels },
+                                          AudioData::InterleavedDest<F, E>                                             { reinterpret_cast<PackedData> (packed.get()), numChannels },
+                                          numSamples);
+
+            unitTest.expect (memcmp (packed, expectedPacked, numBytes) == 0);
+        }
+    };
+
     void runTest() override
     {
         auto r = getRandom();
@@ -622,6 +936,18 @@ public:
                 for (int i = 0; i < numSamples; ++i)
                     expectEquals (sourceBuffer.getSample (0, ch + (i * numChannels)), destBuffer.getSample (ch, i));
         }
+
+        beginTest ("Block conversions match per-sample conversions");
+        {
+            BlockConversionTest<AudioData::Int16,   AudioData::LittleEndian>::test (*this, r);
+            BlockConversionTest<AudioData::Int16,   AudioData::BigEndian>   ::test (*this, r);
+            BlockConversionTest<AudioData::Int24,   AudioData::LittleEndian>::test (*this, r);
+            BlockConversionTest<AudioData::Int24,   AudioData::BigEndian>   ::test (*this, r);
+            BlockConversionTest<AudioData::Int32,   AudioData::LittleEndian>::test (*this, r);
+            BlockConversionTest<AudioData::Int32,   AudioData::BigEndian>   ::test (*this, r);
+            BlockConversionTest<AudioData::Float32, AudioData::LittleEndian>::test (*this, r);
+            BlockConversionTest<AudioData::Float32, AudioData::BigEndian>   ::test (*this, r);
+        }
     }
 };
 
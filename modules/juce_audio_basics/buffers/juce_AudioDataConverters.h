@@ -457,6 +457,10 @@ public:
 
         /** Writes a stream of samples into this pointer from another pointer.
             This will copy the specified number of samples, converting between formats appropriately.
+
+            Conversions between packed Int16, Int24, Int32 or Float32 data and native-endian,
+            non-interleaved Float32 or Int32 data use vector instructions where they're available,
+            unless the source and destination overlap.
         */
         template <class OtherPointerType>
         void convertSamples (OtherPointerType source, int numSamples) const noexcept
@@ -464,6 +468,10 @@ public:
             // trying to write to a const pointer! For a writeable one, use AudioData::NonConst instead!
             static_assert (Constness::isConst == 0, "Attempt to write to a const pointer");
 
+            if constexpr (canConvertToNonInterleaved<OtherPointerType, Pointer>() || canConvertFromNonInterleaved<OtherPointerType, Pointer>())
+                if (convertSamplesVectorised (source, *this, numSamples))
+                    return;
+
             Pointer dest (*this);
 
             if (source.getRawData() != getRawData() || source.getNumBytesBetweenSamples() >= getNumBytesBetweenSamples())
@@ -657,6 +665,104 @@ public:
     };
 
 private:
+    //==============================================================================
+    enum class PackedFormat { none, int16LE, int16BE, int24LE, int24BE, int32LE, int32BE, float32LE, float32BE };
+
+    template <typename SampleFormat, typename Endianness>
+    static constexpr PackedFormat getPackedFormat() noexcept
+    {
+        constexpr auto isBig = std::is_base_of_v<BigEndian, Endianness>;
+
+        if constexpr (std::is_same_v<SampleFormat, Int16>)        return isBig ? PackedFormat::int16BE   : PackedFormat::int16LE;
+        else if constexpr (std::is_same_v<SampleFormat, Int24>)   return isBig ? PackedFormat::int24BE   : PackedFormat::int24LE;
+        else if constexpr (std::is_same_v<SampleFormat, Int32>)   return isBig ? PackedFormat::int32BE   : PackedFormat::int32LE;
+        else if constexpr (std::is_same_v<SampleFormat, Float32>) return isBig ? PackedFormat::float32BE : PackedFormat::float32LE;
+        else                                                      return PackedFormat::none;
+    }
+
+    template <typename>
+    struct PointerFormat
+    {
+        static constexpr auto format = PackedFormat::none;
+        static constexpr auto isFloat = false, isNativeNonInterleaved = false;
+    };
+
+    template <typename SampleFormat, typename Endianness, typename InterleavingType, typename Constness>
+    struct PointerFormat<Pointer<SampleFormat, Endianness, InterleavingType, Constness>>
+    {
+        static constexpr auto format = getPackedFormat<SampleFormat, Endianness>();
+        static constexpr auto isFloat = std::is_same_v<SampleFormat, Float32>;
+        static constexpr auto isNativeNonInterleaved = InterleavingType::isInterleavedType == 0
+                                                         && (isFloat || std::is_same_v<SampleFormat, Int32>)
+                                                         && format == getPackedFormat<SampleFormat, NativeEndian>();
+    };
+
+    static constexpr bool isIntegerFormat (PackedFormat f) noexcept
+    {
+        return f != PackedFormat::none && f != PackedFormat::float32LE && f != PackedFormat::float32BE;
+    }
+
+    template <typename SourcePointer, typename DestPointer>
+    static constexpr bool canConvertToNonInterleaved() noexcept
+    {
+        using Source = PointerFormat<SourcePointer>;
+        using Dest   = PointerFormat<DestPointer>;
+
+        return Dest::isNativeNonInterleaved && (Dest::isFloat ? Source::format != PackedFormat::none
+                                                              : isIntegerFormat (Source::format));
+    }
+
+    template <typename SourcePointer, typename DestPointer>
+    static constexpr bool canConvertFromNonInterleaved() noexcept
+    {
+        using Source = PointerFormat<SourcePointer>;
+        using Dest   = PointerFormat<DestPointer>;
+
+        return Source::isNativeNonInterleaved && (Source::isFloat ? Dest::format != PackedFormat::none
+                                                                  : isIntegerFormat (Dest::format));
+    }
+
+    /*  These convert between packed, possibly interleaved data and native Int32 or Float32 channels,
+        a block of frames at a time, with the same results as the per-sample conversions.
+        Channels past numSourceChannels are cleared, and null channels are skipped as they are in
+        deinterleaveSamples() and interleaveSamples().
+    */
+    static void convertToNonInterleaved (PackedFormat sourceFormat, const void* source, int sourceStride, int numSourceChannels,
+                                         void* const* dest, int numDestChannels, bool destIsFloat, int numSamples) noexcept;
+
+    static void convertFromNonInterleaved (const void* const* source, int numSourceChannels, bool sourceIsFloat,
+                                           PackedFormat destFormat, void* dest, int destStride, int numDestChannels, int numSamples) noexcept;
+
+    template <typename Callback>
+    static void withPackedFormat (PackedFormat, Callback&&);
+
+    template <typename SourcePointer, typename DestPointer>
+    static bool convertSamplesVectorised (const SourcePointer& source, const DestPointer& dest, int numSamples) noexcept
+    {
+        auto* sourceData = static_cast<const char*> (source.getRawData());
+        auto* destData = const_cast<char*> (static_cast<const char*> (dest.getRawData()));
+
+        if (sourceData < destData + numSamples * dest.getNumBytesBetweenSamples()
+             && destData < sourceData + numSamples * source.getNumBytesBetweenSamples())
+            return false;
+
+        if constexpr (canConvertToNonInterleaved<SourcePointer, DestPointer>())
+        {
+            void* const destChannels[] = { destData };
+            convertToNonInterleaved (PointerFormat<SourcePointer>::format, sourceData, source.getNumInterleavedChannels(), 1,
+                                     destChannels, 1, PointerFormat<DestPointer>::isFloat, numSamples);
+        }
+        else
+        {
+            const void* const sourceChannels[] = { sourceData };
+            convertFromNonInterleaved (sourceChannels, 1, PointerFormat<SourcePointer>::isFloat,
+                                       PointerFormat<DestPointer>::format, destData, dest.getNumInterleavedChannels(), 1, numSamples);
+        }
+
+        return true;
+    }
+
+    //==============================================================================
     template <bool IsInterleaved, bool IsConst, typename...>
     struct ChannelDataSubtypes;
 
@@ -718,6 +824,9 @@ public:
                                       AudioData::InterleavedDest<DestFormat>        { destData,   numDestChannels },
                                       numSamples);
         @endcode
+
+        When the source is native-endian Float32 or Int32 data, all of the channels are written
+        in a single pass over the destination, using vector instructions where they're available.
     */
     template <typename... SourceFormat, typename... DestFormat>
     static void interleaveSamples (NonInterleavedSource<SourceFormat...> source,
@@ -727,6 +836,13 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if constexpr (canConvertFromNonInterleaved<SourceType, DestType>())
+        {
+            convertFromNonInterleaved (reinterpret_cast<const void* const*> (source.data), source.channels, PointerFormat<SourceType>::isFloat,
+                                       PointerFormat<DestType>::format, dest.data, dest.channels, dest.channels, numSamples);
+            return;
+        }
+
         for (int i = 0; i < dest.channels; ++i)
         {
             const DestType destType (addBytesToPointer (dest.data, i * DestType::getBytesPerSample()), dest.channels);
@@ -762,6 +878,9 @@ public:
                                         AudioData::NonInterleavedDest<DestFormat>  { destData,   numDestChannels },
                                         numSamples);
         @endcode
+
+        When the destination is native-endian Float32 or Int32 data, all of the channels are read
+        in a single pass over the source, which is much faster for streams with many channels.
     */
     template <typename... SourceFormat, typename... DestFormat>
     static void deinterleaveSamples (InterleavedSource<SourceFormat...> source,
@@ -771,6 +890,13 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if constexpr (canConvertToNonInterleaved<SourceType, DestType>())
+        {
+            convertToNonInterleaved (PointerFormat<SourceType>::format, source.data, source.channels, source.channels,
+                                     reinterpret_cast<void* const*> (dest.data), dest.channels, PointerFormat<DestType>::isFloat, numSamples);
+            return;
+        }
+
         for (int i = 0; i < dest.channels; ++i)
         {
             if (auto* targetChan = dest.data[i])
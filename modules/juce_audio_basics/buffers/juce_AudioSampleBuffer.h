@@ -33,6 +33,30 @@ template <typename Type>
 class AudioBuffer
 {
 public:
+    //==============================================================================
+    /** Describes how a buffer lays out the sample data that it allocates.
+
+        @see setAllocation
+    */
+    enum class Allocation
+    {
+        /** The channels are packed next to each other. This uses the least memory, and is the default. */
+        packed,
+
+        /** Each channel starts on a simdAlignment-byte boundary, and has room for a whole number
+            of simdAlignment-byte vectors. This lets vectorised code process every channel in whole
+            registers, without scalar loops to handle unaligned samples at the start or end.
+
+            If the channels' length is a multiple of 512 bytes, an extra vector of padding is put
+            between them. Otherwise, every channel would start at one of a few offsets within a 4K
+            page, and the channels would compete for the same cache sets.
+        */
+        aligned
+    };
+
+    /** The alignment in bytes of each channel in a buffer that uses Allocation::aligned. */
+    static constexpr size_t simdAlignment = 64;
+
     //==============================================================================
     /** Creates an empty buffer with 0 channels and 0 length. */
     AudioBuffer() noexcept
@@ -59,6 +83,25 @@ public:
         allocateData();
     }
 
+    /** Creates a buffer with a specified number of channels and samples, laying out
+        its memory as described by the given Allocation.
+
+        The contents of the buffer will initially be undefined, so use clear() to
+        set all the samples to zero.
+
+        @see Allocation
+    */
+    AudioBuffer (int numChannelsToAllocate,
+                 int numSamplesToAllocate,
+                 Allocation allocationToUse)
+       : numChannels (numChannelsToAllocate),
+         size (numSamplesToAllocate),
+         allocation (allocationToUse)
+    {
+        jassert (size >= 0 && numChannels >= 0);
+        allocateData();
+    }
+
     /** Creates a buffer using a pre-allocated block of memory.
 
         Note that if the buffer is resized or its number of channels is changed, it
@@ -117,11 +160,12 @@ public:
 
         This buffer will make its own copy of the other's data, unless the buffer was created
         using an external data buffer, in which case both buffers will just point to the same
-        shared block of data.
+        shared block of data. The copy uses the same Allocation as the other buffer.
     */
     AudioBuffer (const AudioBuffer& other)
        : numChannels (other.numChannels),
          size (other.size),
+         allocation (other.allocation),
          allocatedBytes (other.allocatedBytes)
     {
         if (allocatedBytes == 0)
@@ -146,7 +190,8 @@ public:
 
     /** Copies another buffer onto this one.
 
-        This buffer's size will be changed to that of the other buffer.
+        This buffer's size will be changed to that of the other buffer, but it will keep
+        its own Allocation.
     */
     AudioBuffer& operator= (const AudioBuffer& other)
     {
@@ -180,6 +225,8 @@ public:
     AudioBuffer (AudioBuffer&& other) noexcept
         : numChannels (other.numChannels),
           size (other.size),
+          samplesAllocated (other.samplesAllocated),
+          allocation (other.allocation),
           allocatedBytes (other.allocatedBytes),
           allocatedData (std::move (other.allocatedData)),
           isClear (other.isClear)
@@ -198,6 +245,7 @@ public:
 
         other.numChannels = 0;
         other.size = 0;
+        other.samplesAllocated = 0;
         other.allocatedBytes = 0;
     }
 
@@ -206,6 +254,8 @@ public:
     {
         numChannels = other.numChannels;
         size = other.size;
+        samplesAllocated = other.samplesAllocated;
+        allocation = other.allocation;
         allocatedBytes = other.allocatedBytes;
         allocatedData = std::move (other.allocatedData);
         isClear = other.isClear;
@@ -224,6 +274,7 @@ public:
 
         other.numChannels = 0;
         other.size = 0;
+        other.samplesAllocated = 0;
         other.allocatedBytes = 0;
         return *this;
     }
@@ -241,6 +292,56 @@ public:
     */
     int getNumSamples() const noexcept                              { return size; }
 
+    /** Returns the number of samples that each channel has room for.
+
+        This is never less than getNumSamples(), and the samples beyond that point may be
+        read and written, although their contents are undefined. In a buffer that uses
+        Allocation::aligned, this is always a multiple of simdAlignment / sizeof (Type),
+        so vectorised code can process whole vectors right up to the end of each channel.
+
+        If the buffer refers to external data, this is the same as getNumSamples().
+
+        @see getNumSamples, Allocation
+    */
+    int getNumSamplesAllocated() const noexcept                     { return samplesAllocated; }
+
+    /** Returns the way that this buffer lays out the data that it allocates.
+
+        @see setAllocation
+    */
+    Allocation getAllocation() const noexcept                       { return allocation; }
+
+    /** Changes the way that this buffer lays out the data that it allocates.
+
+        If the buffer owns its data, the data will be moved to a new block of memory with the
+        new layout, keeping its content. If the buffer refers to external data, nothing is
+        reallocated, but the new layout will be used the next time the buffer allocates.
+
+        If the required memory can't be allocated, this will throw a std::bad_alloc exception.
+
+        @see Allocation
+    */
+    void setAllocation (Allocation newAllocation)
+    {
+        if (allocation == newAllocation)
+            return;
+
+        allocation = newAllocation;
+
+        if (allocatedBytes == 0)
+            return;
+
+        AudioBuffer newBuffer (numChannels, size, newAllocation);
+
+        if (isClear)
+            newBuffer.clear();
+        else
+            for (int i = 0; i < numChannels; ++i)
+                FloatVectorOperations::copy (newBuffer.channels[i], channels[i], size);
+
+        *this = std::move (newBuffer);
+    }
+
     /** Returns a pointer to an array of read-only samples in one of the buffer's channels.
 
         For speed, this doesn't check whether the channel number is out of range,
@@ -375,10 +476,11 @@ public:
 
         if (newNumSamples != size || newNumChannels != numChannels)
         {
-            auto allocatedSamplesPerChannel = ((size_t) newNumSamples + 3) & ~3u;
+            auto allocatedSamplesPerChannel = allocation == Allocation::aligned ? getAlignedChannelStride (newNumSamples)
+                                                                                : ((size_t) newNumSamples + 3) & ~3u;
             auto channelListSize = ((static_cast<size_t> (1 + newNumChannels) * sizeof (Type*)) + 15) & ~15u;
             auto newTotalBytes = ((size_t) newNumChannels * (size_t) allocatedSamplesPerChannel * sizeof (Type))
-                                    + channelListSize + 32;
+                                    + channelListSize + getSpaceForAlignment();
 
             if (keepExistingContent)
             {
@@ -394,7 +496,7 @@ public:
                     auto numSamplesToCopy = (size_t) jmin (newNumSamples, size);
 
                     auto newChannels = unalignedPointerCast<Type**> (newData.get());
-                    auto newChan     = unalignedPointerCast<Type*> (newData + channelListSize);
+                    auto newChan     = getFirstChannel (newData, channelListSize);
 
                     for (int j = 0; j < newNumChannels; ++j)
                     {
@@ -413,6 +515,7 @@ public:
                     allocatedData.swapWith (newData);
                     allocatedBytes = newTotalBytes;
                     channels = newChannels;
+                    samplesAllocated = (int) allocatedSamplesPerChannel;
                 }
             }
             else
@@ -429,13 +532,15 @@ public:
                     channels = unalignedPointerCast<Type**> (allocatedData.get());
                 }
 
-                auto* chan = unalignedPointerCast<Type*> (allocatedData + channelListSize);
+                auto* chan = getFirstChannel (allocatedData, channelListSize);
 
                 for (int i = 0; i < newNumChannels; ++i)
                 {
                     channels[i] = chan;
                     chan += allocatedSamplesPerChannel;
                 }
+
+                samplesAllocated = (int) allocatedSamplesPerChannel;
             }
 
             channels[newNumChannels] = nullptr;
@@ -912,14 +1017,7 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / (Type) numSamples;
-                auto* d = channels[destChannel] + destStartSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ += startGain * *source++;
-                    startGain += increment;
-                }
+                FloatVectorOperations::addWithMultiplyRamp (channels[destChannel] + destStartSample, source, startGain, endGain, numSamples);
             }
         }
     }
@@ -1199,17 +1297,22 @@ private:
         if (alignmentOverflow != 0)
             channelListSize += requiredSampleAlignment - alignmentOverflow;
 
-        allocatedBytes = (size_t) numChannels * (size_t) size * sizeof (Type) + channelListSize + 32;
+        const auto samplesPerChannel = allocation == Allocation::aligned ? getAlignedChannelStride (size)
+                                                                         : (size_t) size;
+
+        allocatedBytes = (size_t) numChannels * samplesPerChannel * sizeof (Type) + channelListSize + getSpaceForAlignment();
         allocatedData.malloc (allocatedBytes);
         channels = unalignedPointerCast<Type**> (allocatedData.get());
-        auto chan = unalignedPointerCast<Type*> (allocatedData + channelListSize);
+        auto chan = getFirstChannel (allocatedData, channelListSize);
 
         for (int i = 0; i < numChannels; ++i)
         {
             channels[i] = chan;
-            chan += size;
+            chan += samplesPerChannel;
         }
 
+        samplesAllocated = (int) samplesPerChannel;
+
         channels[numChannels] = nullptr;
         isClear = false;
     }
@@ -1237,9 +1340,38 @@ private:
         }
 
         channels[numChannels] = nullptr;
+        samplesAllocated = size;
         isClear = false;
     }
 
+    /*  Returns the distance in samples between the starts of neighbouring channels in a
+        buffer that uses Allocation::aligned.
+    */
+    static size_t getAlignedChannelStride (int numSamples) noexcept
+    {
+        auto bytes = ((size_t) numSamples * sizeof (Type) + simdAlignment - 1) & ~(simdAlignment - 1);
+
+        if (bytes % 512 == 0)
+            bytes += simdAlignment;
+
+        return bytes / sizeof (Type);
+    }
+
+    size_t getSpaceForAlignment() const noexcept
+    {
+        return allocation == Allocation::aligned ? simdAlignment : 32;
+    }
+
+    Type* getFirstChannel (char* block, size_t channelListSize) const noexcept
+    {
+        auto* start = block + channelListSize;
+
+        if (allocation == Allocation::aligned)
+            start = snapPointerToAlignment (start, simdAlignment);
+
+        return unalignedPointerCast<Type*> (start);
+    }
+
     /*  On iOS/arm7 the alignment of `double` is greater than the alignment of
         `std::max_align_t`, so we can't trust max_align_t. Instead, we query
         lots of primitive types and use the maximum alignment of all of them.
@@ -1269,7 +1401,8 @@ private:
         return max;
     }
 
-    int numChannels = 0, size = 0;
+    int numChannels = 0, size = 0, samplesAllocated = 0;
+    Allocation allocation = Allocation::packed;
     size_t allocatedBytes = 0;
     Type** channels;
     HeapBlock<char, true> allocatedData;
@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct AudioBufferTests final : public UnitTest
+{
+    AudioBufferTests()  : UnitTest ("AudioBuffer", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Buffers are packed by default");
+        {
+            AudioBuffer<float> buffer (3, 100);
+
+            expect (buffer.getAllocation() == AudioBuffer<float>::Allocation::packed);
+            expectEquals (buffer.getNumSamplesAllocated(), 100);
+
+            buffer.setSize (3, 101);
+            expect (buffer.getNumSamplesAllocated() >= 101);
+        }
+
+        beginTest ("Aligned buffers have aligned, padded channels");
+        {
+            checkAlignedLayouts<float>();
+            checkAlignedLayouts<double>();
+        }
+
+        beginTest ("Aligned channels don't all share an offset within a page");
+        {
+            for (auto numSamples : { 512, 1024, 2048 })
+            {
+                AudioBuffer<float> buffer (8, numSamples, AudioBuffer<float>::Allocation::aligned);
+                std::set<size_t> offsets;
+
+                for (int i = 0; i < buffer.getNumChannels(); ++i)
+                    offsets.insert ((size_t) buffer.getReadPointer (i) % 4096);
+
+                expectEquals ((int) offsets.size(), buffer.getNumChannels());
+            }
+        }
+
+        beginTest ("Resizing an aligned buffer keeps it aligned and keeps its content");
+        {
+            AudioBuffer<float> buffer (2, 100, AudioBuffer<float>::Allocation::aligned);
+            fillWithRamp (buffer);
+
+            buffer.setSize (4, 300, true, true);
+            expectAligned (buffer);
+            expectRamp (buffer, 2, 100);
+
+            buffer.setSize (3, 50, false, false, true);
+            expectAligned (buffer);
+        }
+
+        beginTest ("Changing the allocation keeps the content");
+        {
+            AudioBuffer<double> buffer (3, 77);
+            fillWithRamp (buffer);
+
+            buffer.setAllocation (AudioBuffer<double>::Allocation::aligned);
+            expect (buffer.getAllocation() == AudioBuffer<double>::Allocation::aligned);
+            expectAligned (buffer);
+            expectRamp (buffer, 3, 77);
+
+            buffer.setAllocation (AudioBuffer<double>::Allocation::packed);
+            expectEquals (buffer.getNumSamplesAllocated(), 77);
+            expectRamp (buffer, 3, 77);
+        }
+
+        beginTest ("Copies and moves keep the allocation");
+        {
+            AudioBuffer<float> buffer (2, 33, AudioBuffer<float>::Allocation::aligned);
+            fillWithRamp (buffer);
+
+            AudioBuffer<float> copy (buffer);
+            expectAligned (copy);
+            expectRamp (copy, 2, 33);
+
+            AudioBuffer<float> moved (std::move (copy));
+            expectAligned (moved);
+            expectRamp (moved, 2, 33);
+        }
+
+        beginTest ("Buffers that refer to external data report their own length");
+        {
+            float data[2][10] {};
+            float* channels[] { data[0], data[1] };
+
+            AudioBuffer<float> buffer (2, 4, AudioBuffer<float>::Allocation::aligned);
+            buffer.setDataToReferTo (channels, 2, 10);
+
+            expectEquals (buffer.getNumSamplesAllocated(), 10);
+        }
+    }
+
+private:
+    template <typename Type>
+    void checkAlignedLayouts()
+    {
+        for (auto numChannels : { 1, 2, 5, 40 })
+        {
+            for (auto numSamples : { 0, 1, 3, 17, 256, 1000, 1024 })
+            {
+                AudioBuffer<Type> buffer (numChannels, numSamples, AudioBuffer<Type>::Allocation::aligned);
+                expectAligned (buffer);
+
+                // Every sample that a channel has room for must be usable without touching its neighbours
+                for (int i = 0; i < numChannels; ++i)
+                    std::fill_n (buffer.getWritePointer (i), buffer.getNumSamplesAllocated(), (Type) i);
+
+                for (int i = 0; i < numChannels; ++i)
+                    for (int s = 0; s < buffer.getNumSamplesAllocated(); ++s)
+                        expectEquals (buffer.getReadPointer (i)[s], (Type) i);
+            }
+        }
+    }
+
+    template <typename Type>
+    void expectAligned (const AudioBuffer<Type>& buffer)
+    {
+        expect (buffer.getAllocation() == AudioBuffer<Type>::Allocation::aligned);
+        expect (buffer.getNumSamplesAllocated() >= buffer.getNumSamples());
+        expectEquals ((size_t) buffer.getNumSamplesAllocated() * sizeof (Type) % AudioBuffer<Type>::simdAlignment, (size_t) 0);
+
+        for (int i = 0; i < buffer.getNumChannels(); ++i)
+            expectEquals ((size_t) buffer.getReadPointer (i) % AudioBuffer<Type>::simdAlignment, (size_t) 0);
+    }
+
+    template <typename Type>
+    static void fillWithRamp (AudioBuffer<Type>& buffer)
+    {
+        for (int i = 0; i < buffer.getNumChannels(); ++i)
+            for (int s = 0; s < buffer.getNumSamples(); ++s)
+                buffer.setSample (i, s, (Type) (i * 1000 + s));
+    }
+
+    template <typename Type>
+    void expectRamp (const AudioBuffer<Type>& buffer, int numChannels, int numSamples)
+    {
+        for (int i = 0; i < numChannels; ++i)
+            for (int s = 0; s < numSamples; ++s)
+                expectEquals (buffer.getSample (i, s), (Type) (i * 1000 + s));
+    }
+};
+
+static AudioBufferTests audioBufferTests;
+
+} // namespace juce
@@ -25,9 +25,9 @@ namespace juce
 
 namespace FloatVectorHelpers
 {
-    #define JUCE_INCREMENT_SRC_DEST         dest += (16 / sizeof (*dest)); src += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += (16 / sizeof (*dest)); src1 += (16 / sizeof (*dest)); src2 += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_DEST             dest += (16 / sizeof (*dest));
+    #define JUCE_INCREMENT_SRC_DEST         dest += Mode::numParallel; src += Mode::numParallel;
+    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += Mode::numParallel; src1 += Mode::numParallel; src2 += Mode::numParallel;
+    #define JUCE_INCREMENT_DEST             dest += Mode::numParallel;
 
    #if JUCE_USE_SSE_INTRINSICS
     static bool isAligned (const void* p) noexcept
@@ -343,11 +343,17 @@ namespace FloatVectorHelpers
         }
 
     #define JUCE_LOAD_NONE(srcLoad, dstLoad)
-    #define JUCE_LOAD_DEST(srcLoad, dstLoad)                        const Mode::ParallelType d = dstLoad (dest);
-    #define JUCE_LOAD_SRC(srcLoad, dstLoad)                         const Mode::ParallelType s = srcLoad (src);
-    #define JUCE_LOAD_SRC1_SRC2(src1Load, src2Load)                 const Mode::ParallelType s1 = src1Load (src1), s2 = src2Load (src2);
-    #define JUCE_LOAD_SRC1_SRC2_DEST(src1Load, src2Load, dstLoad)   const Mode::ParallelType d = dstLoad (dest), s1 = src1Load (src1), s2 = src2Load (src2);
-    #define JUCE_LOAD_SRC_DEST(srcLoad, dstLoad)                    const Mode::ParallelType d = dstLoad (dest), s = srcLoad (src);
+    #define JUCE_LOAD_DEST(srcLoad, dstLoad)                        const auto d = dstLoad (dest);
+    #define JUCE_LOAD_SRC(srcLoad, dstLoad)                         const auto s = srcLoad (src);
+    #define JUCE_LOAD_SRC1_SRC2(src1Load, src2Load)                 const auto s1 = src1Load (src1), s2 = src2Load (src2);
+    #define JUCE_LOAD_SRC1_SRC2_DEST(src1Load, src2Load, dstLoad)   const auto d = dstLoad (dest), s1 = src1Load (src1), s2 = src2Load (src2);
+    #define JUCE_LOAD_SRC_DEST(srcLoad, dstLoad)                    const auto d = dstLoad (dest), s = srcLoad (src);
+
+    #define JUCE_SETUP_GAIN_RAMP \
+        typename Mode::Type initialGains[Mode::numParallel]; \
+        for (int lane = 0; lane < (int) Mode::numParallel; ++lane) initialGains[lane] = startGain + (typename Mode::Type) lane * increment; \
+        auto gain = Mode::loadU (initialGains); \
+        const auto gainStep = Mode::load1 ((typename Mode::Type) Mode::numParallel * increment);
 
     union signMask32 { float  f; uint32 i; };
     union signMask64 { double d; uint64 i; };
@@ -491,6 +497,394 @@ namespace FloatVectorHelpers
     };
    #endif
 
+    //==============================================================================
+   #if JUCE_USE_SSE_INTRINSICS && ! JUCE_USE_VDSP_FRAMEWORK
+    #define JUCE_USE_AVX2_DISPATCH 1
+
+    #if JUCE_GCC || JUCE_CLANG
+     #define JUCE_AVX2_TARGET __attribute__ ((target ("avx2")))
+    #else
+     #define JUCE_AVX2_TARGET
+    #endif
+
+    /*  These kernels are compiled for AVX2 regardless of the flags used for the rest of the
+        module, and are only called when SystemStats reports that the CPU supports AVX2.
+        They deliberately avoid FMA instructions so that their results match the SSE versions.
+    */
+    namespace AVX2
+    {
+        static bool isAvailable() noexcept
+        {
+            static const bool available = SystemStats::hasAVX2();
+            return available;
+        }
+
+        struct BasicOps32
+        {
+            using Type = float;
+            using ParallelType = __m256;
+            enum { numParallel = 8 };
+
+            JUCE_AVX2_TARGET static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+            JUCE_AVX2_TARGET static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+            JUCE_AVX2_TARGET static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+
+            JUCE_AVX2_TARGET static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+            JUCE_AVX2_TARGET static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_ps (a, b); }
+            JUCE_AVX2_TARGET static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+            JUCE_AVX2_TARGET static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+            JUCE_AVX2_TARGET static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+
+            JUCE_AVX2_TARGET static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm256_andnot_ps (a, b); }
+
+            JUCE_AVX2_TARGET static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (jmax (v[0], v[1], v[2], v[3]), jmax (v[4], v[5], v[6], v[7])); }
+            JUCE_AVX2_TARGET static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (jmin (v[0], v[1], v[2], v[3]), jmin (v[4], v[5], v[6], v[7])); }
+        };
+
+        struct BasicOps64
+        {
+            using Type = double;
+            using ParallelType = __m256d;
+            enum { numParallel = 4 };
+
+            JUCE_AVX2_TARGET static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+            JUCE_AVX2_TARGET static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+            JUCE_AVX2_TARGET static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+            JUCE_AVX2_TARGET static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+            JUCE_AVX2_TARGET static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_pd (a, b); }
+            JUCE_AVX2_TARGET static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+            JUCE_AVX2_TARGET static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+            JUCE_AVX2_TARGET static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+
+            JUCE_AVX2_TARGET static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm256_andnot_pd (a, b); }
+
+            JUCE_AVX2_TARGET static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
+            JUCE_AVX2_TARGET static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+        };
+
+        template <int typeSize> struct ModeType    { using Mode = BasicOps32; };
+        template <>             struct ModeType<8> { using Mode = BasicOps64; };
+
+        // Unaligned AVX loads and stores are as fast as aligned ones when the data happens to
+        // be aligned, so there's no need to branch on the alignment of the pointers here.
+        #define JUCE_BEGIN_AVX2_OP \
+            using Mode = typename FloatVectorHelpers::AVX2::ModeType<sizeof (Type)>::Mode; \
+            { \
+                const auto numLongOps = num / Mode::numParallel;
+
+        #define JUCE_PERFORM_AVX2_OP_DEST(normalOp, vecOp, locals, setupOp) \
+            JUCE_BEGIN_AVX2_OP \
+            setupOp \
+            JUCE_VEC_LOOP (vecOp, dummy, Mode::loadU, Mode::storeU, locals, JUCE_INCREMENT_DEST) \
+            JUCE_FINISH_VEC_OP (normalOp)
+
+        #define JUCE_PERFORM_AVX2_OP_SRC_DEST(normalOp, vecOp, locals, increment, setupOp) \
+            JUCE_BEGIN_AVX2_OP \
+            setupOp \
+            JUCE_VEC_LOOP (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+            JUCE_FINISH_VEC_OP (normalOp)
+
+        #define JUCE_PERFORM_AVX2_OP_SRC1_SRC2_DEST(normalOp, vecOp, locals, increment, setupOp) \
+            JUCE_BEGIN_AVX2_OP \
+            setupOp \
+            JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+            JUCE_FINISH_VEC_OP (normalOp)
+
+        #define JUCE_PERFORM_AVX2_OP_SRC1_SRC2_DEST_DEST(normalOp, vecOp, locals, increment, setupOp) \
+            JUCE_BEGIN_AVX2_OP \
+            setupOp \
+            JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+            JUCE_FINISH_VEC_OP (normalOp)
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void copyWithMultiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] = src[i] * multiplier,
+                                           Mode::mul (mult, s),
+                                           JUCE_LOAD_SRC,
+                                           JUCE_INCREMENT_SRC_DEST,
+                                           const auto mult = Mode::load1 (multiplier);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void add (Type* dest, Type amount, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_DEST (dest[i] += amount,
+                                       Mode::add (d, amountToAdd),
+                                       JUCE_LOAD_DEST,
+                                       const auto amountToAdd = Mode::load1 (amount);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void add (Type* dest, const Type* src, Type amount, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] = src[i] + amount,
+                                           Mode::add (am, s),
+                                           JUCE_LOAD_SRC,
+                                           JUCE_INCREMENT_SRC_DEST,
+                                           const auto am = Mode::load1 (amount);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void add (Type* dest, const Type* src, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] += src[i],
+                                           Mode::add (d, s),
+                                           JUCE_LOAD_SRC_DEST,
+                                           JUCE_INCREMENT_SRC_DEST, )
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void add (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
+                                                 Mode::add (s1, s2),
+                                                 JUCE_LOAD_SRC1_SRC2,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void subtract (Type* dest, const Type* src, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] -= src[i],
+                                           Mode::sub (d, s),
+                                           JUCE_LOAD_SRC_DEST,
+                                           JUCE_INCREMENT_SRC_DEST, )
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void subtract (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i],
+                                                 Mode::sub (s1, s2),
+                                                 JUCE_LOAD_SRC1_SRC2,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void addWithMultiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] += src[i] * multiplier,
+                                           Mode::add (d, Mode::mul (mult, s)),
+                                           JUCE_LOAD_SRC_DEST,
+                                           JUCE_INCREMENT_SRC_DEST,
+                                           const auto mult = Mode::load1 (multiplier);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void addWithMultiply (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
+                                                      Mode::add (d, Mode::mul (s1, s2)),
+                                                      JUCE_LOAD_SRC1_SRC2_DEST,
+                                                      JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void subtractWithMultiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] -= src[i] * multiplier,
+                                           Mode::sub (d, Mode::mul (mult, s)),
+                                           JUCE_LOAD_SRC_DEST,
+                                           JUCE_INCREMENT_SRC_DEST,
+                                           const auto mult = Mode::load1 (multiplier);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void subtractWithMultiply (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i],
+                                                      Mode::sub (d, Mode::mul (s1, s2)),
+                                                      JUCE_LOAD_SRC1_SRC2_DEST,
+                                                      JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void multiply (Type* dest, const Type* src, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] *= src[i],
+                                           Mode::mul (d, s),
+                                           JUCE_LOAD_SRC_DEST,
+                                           JUCE_INCREMENT_SRC_DEST, )
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void multiply (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
+                                                 Mode::mul (s1, s2),
+                                                 JUCE_LOAD_SRC1_SRC2,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void multiply (Type* dest, Type multiplier, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_DEST (dest[i] *= multiplier,
+                                       Mode::mul (d, mult),
+                                       JUCE_LOAD_DEST,
+                                       const auto mult = Mode::load1 (multiplier);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void abs (Type* dest, const Type* src, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] = std::abs (src[i]),
+                                           Mode::bit_not (signBit, s),
+                                           JUCE_LOAD_SRC,
+                                           JUCE_INCREMENT_SRC_DEST,
+                                           const auto signBit = Mode::load1 ((Type) -0.0);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void min (Type* dest, const Type* src, Type comp, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] = jmin (src[i], comp),
+                                           Mode::min (s, cmp),
+                                           JUCE_LOAD_SRC,
+                                           JUCE_INCREMENT_SRC_DEST,
+                                           const auto cmp = Mode::load1 (comp);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void min (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]),
+                                                 Mode::min (s1, s2),
+                                                 JUCE_LOAD_SRC1_SRC2,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void max (Type* dest, const Type* src, Type comp, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] = jmax (src[i], comp),
+                                           Mode::max (s, cmp),
+                                           JUCE_LOAD_SRC,
+                                           JUCE_INCREMENT_SRC_DEST,
+                                           const auto cmp = Mode::load1 (comp);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void max (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]),
+                                                 Mode::max (s1, s2),
+                                                 JUCE_LOAD_SRC1_SRC2,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void clip (Type* dest, const Type* src, Type low, Type high, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
+                                           Mode::max (Mode::min (s, hi), lo),
+                                           JUCE_LOAD_SRC,
+                                           JUCE_INCREMENT_SRC_DEST,
+                                           const auto lo = Mode::load1 (low);
+                                           const auto hi = Mode::load1 (high);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET void addWithMultiplyRamp (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX2_OP_SRC_DEST (dest[i] += src[i] * (startGain + (Type) i * increment),
+                                           Mode::add (d, Mode::mul (s, gain)),
+                                           JUCE_LOAD_SRC_DEST,
+                                           JUCE_INCREMENT_SRC_DEST gain = Mode::add (gain, gainStep); startGain += (Type) Mode::numParallel * increment;,
+                                           JUCE_SETUP_GAIN_RAMP)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET Type findMinOrMax (const Type* src, Size num, const bool isMinimum) noexcept
+        {
+            using Mode = typename ModeType<sizeof (Type)>::Mode;
+            auto numLongOps = num / Mode::numParallel;
+
+            if (numLongOps > 1)
+            {
+                auto val = Mode::loadU (src);
+
+                if (isMinimum)
+                {
+                    while (--numLongOps > 0)
+                    {
+                        src += Mode::numParallel;
+                        val = Mode::min (val, Mode::loadU (src));
+                    }
+                }
+                else
+                {
+                    while (--numLongOps > 0)
+                    {
+                        src += Mode::numParallel;
+                        val = Mode::max (val, Mode::loadU (src));
+                    }
+                }
+
+                Type result = isMinimum ? Mode::min (val)
+                                        : Mode::max (val);
+
+                num &= (Mode::numParallel - 1);
+                src += Mode::numParallel;
+
+                for (auto i = (decltype (num)) 0; i < num; ++i)
+                    result = isMinimum ? jmin (result, src[i])
+                                       : jmax (result, src[i]);
+
+                return result;
+            }
+
+            if (num <= 0)
+                return 0;
+
+            return isMinimum ? *std::min_element (src, src + num)
+                             : *std::max_element (src, src + num);
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET Range<Type> findMinAndMax (const Type* src, Size num) noexcept
+        {
+            using Mode = typename ModeType<sizeof (Type)>::Mode;
+            auto numLongOps = num / Mode::numParallel;
+
+            if (numLongOps > 1)
+            {
+                auto mn = Mode::loadU (src);
+                auto mx = mn;
+
+                while (--numLongOps > 0)
+                {
+                    src += Mode::numParallel;
+                    const auto v = Mode::loadU (src);
+                    mn = Mode::min (mn, v);
+                    mx = Mode::max (mx, v);
+                }
+
+                Range<Type> result (Mode::min (mn),
+                                    Mode::max (mx));
+
+                num &= (Mode::numParallel - 1);
+                src += Mode::numParallel;
+
+                for (auto i = (decltype (num)) 0; i < num; ++i)
+                    result = result.getUnionWith (src[i]);
+
+                return result;
+            }
+
+            return Range<Type>::findMinAndMax (src, num);
+        }
+    }
+
+    #define JUCE_DISPATCH_TO_AVX2(call) \
+        if (FloatVectorHelpers::AVX2::isAvailable()) \
+            return FloatVectorHelpers::AVX2::call;
+   #else
+    #define JUCE_DISPATCH_TO_AVX2(call)
+   #endif
+
 //==============================================================================
 namespace
 {
@@ -546,6 +940,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (copyWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                       Mode::mul (mult, s),
                                       JUCE_LOAD_SRC,
@@ -560,6 +955,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (copyWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                       Mode::mul (mult, s),
                                       JUCE_LOAD_SRC,
@@ -574,6 +970,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsadd (dest, 1, &amount, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, amount, num))
         JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount,
                                   Mode::add (d, amountToAdd),
                                   JUCE_LOAD_DEST,
@@ -584,6 +981,7 @@ namespace
     template <typename Size>
     void add (double* dest, double amount, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (add (dest, amount, num))
         JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount,
                                   Mode::add (d, amountToAdd),
                                   JUCE_LOAD_DEST,
@@ -596,6 +994,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsadd (src, 1, &amount, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, src, amount, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount,
                                       Mode::add (am, s),
                                       JUCE_LOAD_SRC,
@@ -610,6 +1009,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsaddD (src, 1, &amount, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, src, amount, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount,
                                       Mode::add (am, s),
                                       JUCE_LOAD_SRC,
@@ -624,6 +1024,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
                                       Mode::add (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -637,6 +1038,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
                                       Mode::add (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -650,6 +1052,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
                                             Mode::add (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -663,6 +1066,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
                                             Mode::add (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -676,6 +1080,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsub (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (subtract (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i],
                                       Mode::sub (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -689,6 +1094,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsubD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (subtract (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i],
                                       Mode::sub (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -702,6 +1108,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsub (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (subtract (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i],
                                             Mode::sub (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -715,6 +1122,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsubD (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (subtract (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i],
                                             Mode::sub (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -728,6 +1136,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (addWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
                                       Mode::add (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -742,6 +1151,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (addWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
                                       Mode::add (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -756,6 +1166,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (addWithMultiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
                                                  Mode::add (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -769,6 +1180,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (addWithMultiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
                                                  Mode::add (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -779,6 +1191,7 @@ namespace
     template <typename Size>
     void subtractWithMultiply (float* dest, const float* src, float multiplier, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (subtractWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier,
                                       Mode::sub (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -789,6 +1202,7 @@ namespace
     template <typename Size>
     void subtractWithMultiply (double* dest, const double* src, double multiplier, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (subtractWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier,
                                       Mode::sub (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -799,6 +1213,7 @@ namespace
     template <typename Size>
     void subtractWithMultiply (float* dest, const float* src1, const float* src2, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (subtractWithMultiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i],
                                                  Mode::sub (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -808,6 +1223,7 @@ namespace
     template <typename Size>
     void subtractWithMultiply (double* dest, const double* src1, const double* src2, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (subtractWithMultiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i],
                                                  Mode::sub (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -820,6 +1236,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (multiply (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
                                       Mode::mul (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -833,6 +1250,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (multiply (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
                                       Mode::mul (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -846,6 +1264,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (multiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
                                             Mode::mul (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -859,6 +1278,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (multiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
                                             Mode::mul (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -872,6 +1292,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (multiply (dest, multiplier, num))
         JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
                                   Mode::mul (d, mult),
                                   JUCE_LOAD_DEST,
@@ -885,6 +1306,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (multiply (dest, multiplier, num))
         JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
                                   Mode::mul (d, mult),
                                   JUCE_LOAD_DEST,
@@ -895,6 +1317,7 @@ namespace
     template <typename Size>
     void multiply (float* dest, const float* src, float multiplier, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (copyWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                       Mode::mul (mult, s),
                                       JUCE_LOAD_SRC,
@@ -905,6 +1328,7 @@ namespace
     template <typename Size>
     void multiply (double* dest, const double* src, double multiplier, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (copyWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                       Mode::mul (mult, s),
                                       JUCE_LOAD_SRC,
@@ -938,6 +1362,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vabs ((float*) src, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (abs (dest, src, num))
         [[maybe_unused]] FloatVectorHelpers::signMask32 signMask;
         signMask.i = 0x7fffffffUL;
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = std::abs (src[i]),
@@ -954,6 +1379,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vabsD ((double*) src, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (abs (dest, src, num))
         [[maybe_unused]] FloatVectorHelpers::signMask64 signMask;
         signMask.i = 0x7fffffffffffffffULL;
 
@@ -968,6 +1394,7 @@ namespace
     template <typename Size>
     void min (float* dest, const float* src, float comp, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (min (dest, src, comp, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp),
                                       Mode::min (s, cmp),
                                       JUCE_LOAD_SRC,
@@ -978,6 +1405,7 @@ namespace
     template <typename Size>
     void min (double* dest, const double* src, double comp, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (min (dest, src, comp, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp),
                                       Mode::min (s, cmp),
                                       JUCE_LOAD_SRC,
@@ -991,6 +1419,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmin ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (min (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]),
                                             Mode::min (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -1004,6 +1433,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vminD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (min (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]),
                                             Mode::min (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -1014,6 +1444,7 @@ namespace
     template <typename Size>
     void max (float* dest, const float* src, float comp, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (max (dest, src, comp, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp),
                                       Mode::max (s, cmp),
                                       JUCE_LOAD_SRC,
@@ -1024,6 +1455,7 @@ namespace
     template <typename Size>
     void max (double* dest, const double* src, double comp, Size num) noexcept
     {
+        JUCE_DISPATCH_TO_AVX2 (max (dest, src, comp, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp),
                                       Mode::max (s, cmp),
                                       JUCE_LOAD_SRC,
@@ -1037,6 +1469,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmax ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (max (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]),
                                             Mode::max (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -1050,6 +1483,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmaxD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (max (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]),
                                             Mode::max (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -1065,6 +1499,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (clip (dest, src, low, high, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
                                       Mode::max (Mode::min (s, hi), lo),
                                       JUCE_LOAD_SRC,
@@ -1082,6 +1517,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vclipD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (clip (dest, src, low, high, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
                                       Mode::max (Mode::min (s, hi), lo),
                                       JUCE_LOAD_SRC,
@@ -1091,10 +1527,51 @@ namespace
        #endif
     }
 
+    template <typename Size>
+    void addWithMultiplyRamp (float* dest, const float* src, float startGain, float endGain, Size num) noexcept
+    {
+        if (num == 0)
+            return;
+
+        const auto increment = (endGain - startGain) / (float) num;
+
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vrampmuladd (src, 1, &startGain, &increment, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_DISPATCH_TO_AVX2 (addWithMultiplyRamp (dest, src, startGain, increment, num))
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * (startGain + (float) i * increment),
+                                      Mode::add (d, Mode::mul (s, gain)),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST gain = Mode::add (gain, gainStep); startGain += (float) Mode::numParallel * increment;,
+                                      JUCE_SETUP_GAIN_RAMP)
+       #endif
+    }
+
+    template <typename Size>
+    void addWithMultiplyRamp (double* dest, const double* src, double startGain, double endGain, Size num) noexcept
+    {
+        if (num == 0)
+            return;
+
+        const auto increment = (endGain - startGain) / (double) num;
+
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vrampmuladdD (src, 1, &startGain, &increment, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_DISPATCH_TO_AVX2 (addWithMultiplyRamp (dest, src, startGain, increment, num))
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * (startGain + (double) i * increment),
+                                      Mode::add (d, Mode::mul (s, gain)),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST gain = Mode::add (gain, gainStep); startGain += (double) Mode::numParallel * increment;,
+                                      JUCE_SETUP_GAIN_RAMP)
+       #endif
+    }
+
     template <typename Size>
     Range<float> findMinAndMax (const float* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_TO_AVX2 (findMinAndMax (src, num))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
        #else
         return Range<float>::findMinAndMax (src, num);
@@ -1105,6 +1582,7 @@ namespace
     Range<double> findMinAndMax (const double* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_TO_AVX2 (findMinAndMax (src, num))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
        #else
         return Range<double>::findMinAndMax (src, num);
@@ -1115,6 +1593,7 @@ namespace
     float findMinimum (const float* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_TO_AVX2 (findMinOrMax (src, num, true))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, true);
        #else
         return juce::findMinimum (src, num);
@@ -1125,6 +1604,7 @@ namespace
     double findMinimum (const double* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_TO_AVX2 (findMinOrMax (src, num, true))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, true);
        #else
         return juce::findMinimum (src, num);
@@ -1135,6 +1615,7 @@ namespace
     float findMaximum (const float* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_TO_AVX2 (findMinOrMax (src, num, false))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, false);
        #else
         return juce::findMaximum (src, num);
@@ -1145,12 +1626,46 @@ namespace
     double findMaximum (const double* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_TO_AVX2 (findMinOrMax (src, num, false))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, false);
        #else
         return juce::findMaximum (src, num);
        #endif
     }
 
+    // The operations below are made up of several simpler ones, and they work through the data
+    // in chunks of this many values so that each chunk is still in the cache for the later passes.
+    constexpr int chunkSize = 256;
+
+    template <typename Type, typename Size>
+    void addWithMultiply (Type* dest, const Type* const* sources, const Type* gains, int numSources, Size num) noexcept
+    {
+        for (Size start = 0; start < num; start += (Size) chunkSize)
+        {
+            const auto numThisTime = jmin ((Size) chunkSize, num - start);
+
+            for (int i = 0; i < numSources; ++i)
+                addWithMultiply (dest + start, sources[i] + start, gains[i], numThisTime);
+        }
+    }
+
+    template <typename Type, typename Size>
+    Range<Type> clipAndFindMinAndMax (Type* dest, const Type* src, Type low, Type high, Size num) noexcept
+    {
+        Range<Type> result;
+
+        for (Size start = 0; start < num; start += (Size) chunkSize)
+        {
+            const auto numThisTime = jmin ((Size) chunkSize, num - start);
+            const auto chunkRange = findMinAndMax (src + start, numThisTime);
+
+            result = (start == 0 ? chunkRange : result.getUnionWith (chunkRange));
+            clip (dest + start, src + start, low, high, numThisTime);
+        }
+
+        return result;
+    }
+
     template <typename Size>
     void convertFixedToFloat (float* dest, const int* src, float multiplier, Size num) noexcept
     {
@@ -1387,6 +1902,36 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::clip (FloatT
     FloatVectorHelpers::clip (dest, src, low, high, num);
 }
 
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::addWithMultiplyRamp (FloatType* dest,
+                                                                                         const FloatType* src,
+                                                                                         FloatType startGain,
+                                                                                         FloatType endGain,
+                                                                                         CountType num) noexcept
+{
+    FloatVectorHelpers::addWithMultiplyRamp (dest, src, startGain, endGain, num);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::addWithMultiply (FloatType* dest,
+                                                                                     const FloatType* const* sources,
+                                                                                     const FloatType* gains,
+                                                                                     int numSources,
+                                                                                     CountType num) noexcept
+{
+    FloatVectorHelpers::addWithMultiply (dest, sources, gains, numSources, num);
+}
+
+template <typename FloatType, typename CountType>
+Range<FloatType> JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::clipAndFindMinAndMax (FloatType* dest,
+                                                                                                      const FloatType* src,
+                                                                                                      FloatType low,
+                                                                                                      FloatType high,
+                                                                                                      CountType num) noexcept
+{
+    return FloatVectorHelpers::clipAndFindMinAndMax (dest, src, low, high, num);
+}
+
 template <typename FloatType, typename CountType>
 Range<FloatType> JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findMinAndMax (const FloatType* src,
                                                                                                CountType numValues) noexcept
@@ -1644,6 +2189,60 @@ public:
             FloatVectorOperations::fill (data2, (ValueType) 3, num);
             FloatVectorOperations::addWithMultiply (data1, data1, data2, num);
             u.expect (areAllValuesEqual (data1, num, (ValueType) 8));
+
+            fillRandomly (random, data1, num);
+            fillRandomly (random, data2, num);
+            doElementwiseTest (u, data1, data2, num);
+        }
+
+        static void doElementwiseTest (UnitTest& u, const ValueType* data1, const ValueType* data2, int num)
+        {
+            HeapBlock<ValueType> result ((size_t) num), expected ((size_t) num);
+
+            const auto check = [&] (auto&& expectedOp)
+            {
+                for (int i = 0; i < num; ++i)
+                    expected[i] = expectedOp (data1[i], data2[i]);
+
+                u.expect (std::equal (result.get(), result.get() + num, expected.get()));
+            };
+
+            FloatVectorOperations::clip (result, data1, (ValueType) 250, (ValueType) 750, num);
+            check ([] (ValueType a, ValueType) { return jlimit ((ValueType) 250, (ValueType) 750, a); });
+
+            FloatVectorOperations::min (result, data1, data2, num);
+            check ([] (ValueType a, ValueType b) { return jmin (a, b); });
+
+            FloatVectorOperations::max (result, data1, (ValueType) 500, num);
+            check ([] (ValueType a, ValueType) { return jmax (a, (ValueType) 500); });
+
+            FloatVectorOperations::subtract (result, data1, data2, num);
+            check ([] (ValueType a, ValueType b) { return a - b; });
+
+            FloatVectorOperations::copy (result, data1, num);
+            FloatVectorOperations::subtractWithMultiply (result, data2, (ValueType) 0.5, num);
+            check ([] (ValueType a, ValueType b) { return a - b * (ValueType) 0.5; });
+
+            const auto inputRange = FloatVectorOperations::clipAndFindMinAndMax (result, data1, (ValueType) 250, (ValueType) 750, num);
+            check ([] (ValueType a, ValueType) { return jlimit ((ValueType) 250, (ValueType) 750, a); });
+            u.expect (inputRange == Range<ValueType>::findMinAndMax (data1, num));
+
+            const ValueType* sources[] { data1, data2, data1 };
+            const ValueType gains[] { (ValueType) 0.5, (ValueType) 2, (ValueType) -0.25 };
+            FloatVectorOperations::copy (result, data2, num);
+            FloatVectorOperations::addWithMultiply (result, sources, gains, numElementsInArray (sources), num);
+            check ([&] (ValueType a, ValueType b) { return ((b + a * gains[0]) + b * gains[1]) + a * gains[2]; });
+
+            FloatVectorOperations::fill (result, (ValueType) 1, num);
+            FloatVectorOperations::addWithMultiplyRamp (result, data1, (ValueType) 0, (ValueType) 1, num);
+
+            const auto increment = (ValueType) 1 / (ValueType) num;
+            auto rampMatches = true;
+
+            for (int i = 0; i < num; ++i)
+                rampMatches &= std::abs (result[i] - ((ValueType) 1 + data1[i] * (ValueType) i * increment)) < (ValueType) 1.0e-3;
+
+            u.expect (rampMatches);
         }
 
         static void doConversionTest (UnitTest& u, float* data1, float* data2, int* const int1, int num)
@@ -1711,6 +2310,62 @@ public:
 
 static FloatVectorOperationsTests vectorOpTests;
 
+//==============================================================================
+class FloatVectorOperationsBenchmarks final : public Benchmark
+{
+public:
+    FloatVectorOperationsBenchmarks()
+        : Benchmark ("FloatVectorOperations", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        constexpr int size = 512;
+        HeapBlock<float> a (size), b (size), c (size);
+
+        for (int i = 0; i < size; ++i)
+        {
+            a[i] = getRandom().nextFloat() - 0.5f;
+            b[i] = getRandom().nextFloat() - 0.5f;
+        }
+
+        beginTest ("Arithmetic");
+
+        measure ("add 512 floats", [&]
+        {
+            FloatVectorOperations::add (c.get(), a.get(), b.get(), size);
+            doNotOptimise (c[0]);
+        });
+
+        measure ("multiply 512 floats", [&]
+        {
+            FloatVectorOperations::multiply (c.get(), a.get(), b.get(), size);
+            doNotOptimise (c[0]);
+        });
+
+        measure ("addWithMultiply 512 floats", [&]
+        {
+            FloatVectorOperations::addWithMultiply (c.get(), a.get(), b.get(), size);
+            doNotOptimise (c[0]);
+        });
+
+        beginTest ("Ranges");
+
+        measure ("findMinAndMax 512 floats", [&]
+        {
+            doNotOptimise (FloatVectorOperations::findMinAndMax (a.get(), size));
+        });
+
+        measure ("clip 512 floats", [&]
+        {
+            FloatVectorOperations::clip (c.get(), a.get(), -0.25f, 0.25f, size);
+            doNotOptimise (c[0]);
+        });
+    }
+};
+
+static FloatVectorOperationsBenchmarks vectorOpBenchmarks;
+
 #endif
 
 } // namespace juce
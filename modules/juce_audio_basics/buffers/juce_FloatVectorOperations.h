@@ -128,6 +128,25 @@ struct FloatVectorOperationsBase
     /** Each element of dest is calculated by hard clipping the corresponding src element so that it is in the range specified by the arguments low and high. */
     static void JUCE_CALLTYPE clip (FloatType* dest, const FloatType* src, FloatType low, FloatType high, CountType num) noexcept;
 
+    /** Multiplies each source value by a gain that ramps linearly from startGain towards endGain, and adds the result to the destination vector.
+
+        The gain applied to element i is startGain + i * (endGain - startGain) / num, which matches AudioBuffer::addFromWithRamp().
+    */
+    static void JUCE_CALLTYPE addWithMultiplyRamp (FloatType* dest, const FloatType* src, FloatType startGain, FloatType endGain, CountType num) noexcept;
+
+    /** Multiplies each of the numSources source vectors by the corresponding value in gains, and adds the results to the destination vector.
+
+        This gives the same result as calling addWithMultiply() once for each source, but the destination is processed in
+        small chunks so that it stays in the cache while all of the sources are added to it.
+    */
+    static void JUCE_CALLTYPE addWithMultiply (FloatType* dest, const FloatType* const* sources, const FloatType* gains, int numSources, CountType num) noexcept;
+
+    /** Hard clips each src element into dest in the same way as clip(), and returns the range of the src values before they were clipped.
+
+        This is cheaper than calling findMinAndMax() followed by clip(), because it only has to stream the data through memory once.
+    */
+    static Range<FloatType> JUCE_CALLTYPE clipAndFindMinAndMax (FloatType* dest, const FloatType* src, FloatType low, FloatType high, CountType num) noexcept;
+
     /** Finds the minimum and maximum values in the given array. */
     static Range<FloatType> JUCE_CALLTYPE findMinAndMax (const FloatType* src, CountType numValues) noexcept;
 
@@ -159,6 +178,8 @@ struct NameForwarder : public Bases...
           Bases::min...,
           Bases::max...,
           Bases::clip...,
+          Bases::addWithMultiplyRamp...,
+          Bases::clipAndFindMinAndMax...,
           Bases::findMinAndMax...,
           Bases::findMinimum...,
           Bases::findMaximum...;
@@ -37,6 +37,7 @@
 
 #if JUCE_USE_SSE_INTRINSICS
  #include <emmintrin.h>
+ #include <immintrin.h>
 #endif
 
 #if JUCE_MAC || JUCE_IOS
@@ -66,9 +67,12 @@
 #include "utilities/juce_LagrangeInterpolator.cpp"
 #include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_Interpolators.cpp"
+#include "utilities/juce_PolyphaseResampler.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
+#include "midi/juce_FlatMidiFile.cpp"
+#include "midi/juce_FlatMidiSequence.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
 #include "midi/juce_MidiMessage.cpp"
 #include "midi/juce_MidiMessageSequence.cpp"
@@ -82,12 +86,14 @@
 #include "mpe/juce_MPESynthesiserVoice.cpp"
 #include "mpe/juce_MPESynthesiser.cpp"
 #include "mpe/juce_MPEUtils.cpp"
+#include "sources/juce_StreamingReadScheduler.cpp"
 #include "sources/juce_BufferingAudioSource.cpp"
 #include "sources/juce_ChannelRemappingAudioSource.cpp"
 #include "sources/juce_IIRFilterAudioSource.cpp"
 #include "sources/juce_MemoryAudioSource.cpp"
 #include "sources/juce_MixerAudioSource.cpp"
 #include "sources/juce_ResamplingAudioSource.cpp"
+#include "sources/juce_TimeStretchAudioSource.cpp"
 #include "sources/juce_ReverbAudioSource.cpp"
 #include "sources/juce_ToneGeneratorAudioSource.cpp"
 #include "sources/juce_PositionableAudioSource.cpp"
@@ -101,8 +107,19 @@
 #include "midi/ump/juce_UMPMidi1ToMidi2DefaultTranslator.cpp"
 #include "midi/ump/juce_UMPIterator.cpp"
 #include "utilities/juce_AudioWorkgroup.cpp"
+#include "utilities/juce_RealtimeThreadPool.cpp"
+#include "utilities/juce_ParallelVoiceRenderer.cpp"
 
 #if JUCE_UNIT_TESTS
+ #include "buffers/juce_AudioSampleBuffer_test.cpp"
  #include "utilities/juce_ADSR_test.cpp"
+ #include "utilities/juce_Reverb_test.cpp"
+ #include "utilities/juce_RealtimeThreadPool_test.cpp"
+ #include "utilities/juce_PolyphaseResampler_test.cpp"
+ #include "sources/juce_MixerAudioSource_test.cpp"
+ #include "sources/juce_StreamingReadScheduler_test.cpp"
+ #include "sources/juce_TimeStretchAudioSource_test.cpp"
+ #include "synthesisers/juce_Synthesiser_test.cpp"
+ #include "midi/juce_MidiKeyboardState_test.cpp"
  #include "midi/ump/juce_UMP_test.cpp"
 #endif
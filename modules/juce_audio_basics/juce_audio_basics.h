@@ -93,13 +93,19 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "utilities/juce_IIRFilter.h"
 #include "utilities/juce_GenericInterpolator.h"
 #include "utilities/juce_Interpolators.h"
+#include "utilities/juce_PolyphaseResampler.h"
 #include "utilities/juce_SmoothedValue.h"
 #include "utilities/juce_Reverb.h"
 #include "utilities/juce_ADSR.h"
+#include "utilities/juce_AudioWorkgroup.h"
+#include "utilities/juce_RealtimeThreadPool.h"
+#include "utilities/juce_ParallelVoiceRenderer.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
 #include "midi/juce_MidiMessageSequence.h"
 #include "midi/juce_MidiFile.h"
+#include "midi/juce_FlatMidiFile.h"
+#include "midi/juce_FlatMidiSequence.h"
 #include "midi/juce_MidiKeyboardState.h"
 #include "midi/juce_MidiRPN.h"
 #include "mpe/juce_MPEValue.h"
@@ -113,17 +119,18 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "mpe/juce_MPEUtils.h"
 #include "sources/juce_AudioSource.h"
 #include "sources/juce_PositionableAudioSource.h"
+#include "sources/juce_StreamingReadScheduler.h"
 #include "sources/juce_BufferingAudioSource.h"
 #include "sources/juce_ChannelRemappingAudioSource.h"
 #include "sources/juce_IIRFilterAudioSource.h"
 #include "sources/juce_MemoryAudioSource.h"
 #include "sources/juce_MixerAudioSource.h"
 #include "sources/juce_ResamplingAudioSource.h"
+#include "sources/juce_TimeStretchAudioSource.h"
 #include "sources/juce_ReverbAudioSource.h"
 #include "sources/juce_ToneGeneratorAudioSource.h"
 #include "synthesisers/juce_Synthesiser.h"
 #include "audio_play_head/juce_AudioPlayHead.h"
-#include "utilities/juce_AudioWorkgroup.h"
 #include "midi/ump/juce_UMPBytesOnGroup.h"
 #include "midi/ump/juce_UMPDeviceInfo.h"
 
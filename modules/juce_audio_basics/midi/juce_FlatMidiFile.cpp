@@ -0,0 +1,645 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+// Returns the number of bytes that the MidiMessage constructor used by MidiFileHelpers::readTrack()
+// would consume for an event, without creating the message, or -1 if the event isn't valid
+static int getFlatMidiFileEventSize (const uint8* src, int sz, uint8 lastStatusByte, FlatMidiFile::Event& event) noexcept
+{
+    auto byte = (unsigned int) *src;
+    int numBytesUsed = 0;
+
+    if (byte < 0x80)
+    {
+        byte = (unsigned int) lastStatusByte;
+        numBytesUsed = -1;
+    }
+    else
+    {
+        --sz;
+        ++src;
+    }
+
+    if (byte < 0x80)
+        return -1;
+
+    event.statusByte = (uint8) byte;
+    event.data1 = 0;
+    event.data2 = 0;
+
+    if (byte == 0xf0)
+    {
+        auto d = src;
+        bool haveReadAllLengthBytes = false;
+
+        while (d < src + sz)
+        {
+            if (*d >= 0x80)
+            {
+                if (*d == 0xf7)
+                {
+                    ++d;
+                    break;
+                }
+
+                if (haveReadAllLengthBytes)
+                    break;
+            }
+            else
+            {
+                haveReadAllLengthBytes = true;
+            }
+
+            ++d;
+        }
+
+        return numBytesUsed + 1 + (int) (d - src);
+    }
+
+    if (byte == 0xff)
+    {
+        const auto bytesLeft = MidiMessage::readVariableLengthValue (src + 1, sz - 1);
+        return numBytesUsed + jmin (sz + 1, bytesLeft.bytesUsed + 2 + bytesLeft.value);
+    }
+
+    const auto size = MidiMessage::getMessageLengthFromFirstByte ((uint8) byte);
+
+    if (size > 1)  event.data1 = sz > 0 ? src[0] : 0;
+    if (size > 2)  event.data2 = sz > 1 ? src[1] : 0;
+
+    return numBytesUsed + jmin (size, sz + 1);
+}
+
+//==============================================================================
+FlatMidiFile::FlatMidiFile() = default;
+FlatMidiFile::~FlatMidiFile() = default;
+
+void FlatMidiFile::clear()
+{
+    events.clear();
+    trackStarts.assign (1, 0);
+    noteOffIndices.clear();
+    notesMatched = false;
+    source = nullptr;
+    mappedFile.reset();
+    timeFormat = 0;
+    fileType = 0;
+}
+
+bool FlatMidiFile::parse (const void* data, size_t numBytes)
+{
+    clear();
+    return parseData (static_cast<const uint8*> (data), numBytes);
+}
+
+bool FlatMidiFile::loadFrom (const File& file)
+{
+    clear();
+    mappedFile.emplace (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile->getData() == nullptr)
+    {
+        mappedFile.reset();
+        return false;
+    }
+
+    return parseData (static_cast<const uint8*> (mappedFile->getData()), mappedFile->getSize());
+}
+
+bool FlatMidiFile::parseData (const uint8* data, size_t size)
+{
+    // (events store 32-bit offsets into the data)
+    if (size > (size_t) std::numeric_limits<uint32>::max())
+        return false;
+
+    source = data;
+
+    const auto optHeader = MidiFileHelpers::parseMidiHeader (data, size);
+
+    if (! optHeader.hasValue())
+        return false;
+
+    const auto header = *optHeader;
+    timeFormat = header.timeFormat;
+
+    data += header.bytesRead;
+    size -= (size_t) header.bytesRead;
+
+    for (int track = 0; track < header.numberOfTracks; ++track)
+    {
+        const auto optChunkType = MidiFileHelpers::tryRead<uint32> (data, size);
+
+        if (! optChunkType.hasValue())
+            return false;
+
+        const auto optChunkSize = MidiFileHelpers::tryRead<uint32> (data, size);
+
+        if (! optChunkSize.hasValue())
+            return false;
+
+        const auto chunkSize = *optChunkSize;
+
+        if (size < chunkSize)
+            return false;
+
+        if (*optChunkType == ByteOrder::bigEndianInt ("MTrk"))
+            readTrack (data, (int) chunkSize, getNumTracks());
+
+        size -= chunkSize;
+        data += chunkSize;
+    }
+
+    if (size != 0)
+        return false;
+
+    fileType = header.fileType;
+    return true;
+}
+
+void FlatMidiFile::readTrack (const uint8* data, int size, int trackIndex)
+{
+    const auto firstEvent = events.size();
+    double time = 0;
+    uint8 lastStatusByte = 0;
+
+    while (size > 0)
+    {
+        const auto delay = MidiMessage::readVariableLengthValue (data, size);
+
+        if (! delay.isValid())
+            break;
+
+        data += delay.bytesUsed;
+        size -= delay.bytesUsed;
+        time += delay.value;
+
+        if (size <= 0)
+            break;
+
+        Event event;
+        const auto messSize = getFlatMidiFileEventSize (data, size, lastStatusByte, event);
+
+        if (messSize <= 0)
+            break;
+
+        event.timeStamp = time;
+        event.offset = (uint32) (data - source);
+        event.size = (uint32) messSize;
+        event.track = (uint16) trackIndex;
+        events.push_back (event);
+
+        size -= messSize;
+        data += messSize;
+
+        if ((event.statusByte & 0xf0) != 0xf0)
+            lastStatusByte = event.statusByte;
+    }
+
+    // The events are already in time order, so all that's needed is to move each note-off
+    // ahead of any note-ons with the same time. Doing this in place avoids the temporary
+    // storage that std::stable_sort would allocate.
+    auto firstNoteOnAtTime = events.end();
+
+    for (auto e = events.begin() + (ptrdiff_t) firstEvent; e != events.end(); ++e)
+    {
+        if (firstNoteOnAtTime != events.end() && ! exactlyEqual (firstNoteOnAtTime->timeStamp, e->timeStamp))
+            firstNoteOnAtTime = events.end();
+
+        if (e->isNoteOn())
+        {
+            if (firstNoteOnAtTime == events.end())
+                firstNoteOnAtTime = e;
+        }
+        else if (e->isNoteOff() && firstNoteOnAtTime != events.end())
+        {
+            std::rotate (firstNoteOnAtTime, e, e + 1);
+            ++firstNoteOnAtTime;
+        }
+    }
+
+    trackStarts.push_back ((int) events.size());
+}
+
+//==============================================================================
+Range<int> FlatMidiFile::getTrackEventRange (int trackIndex) const noexcept
+{
+    if (! isPositiveAndBelow (trackIndex, getNumTracks()))
+        return {};
+
+    return { trackStarts[(size_t) trackIndex], trackStarts[(size_t) trackIndex + 1] };
+}
+
+const FlatMidiFile::Event& FlatMidiFile::getEvent (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumEvents()));
+    return events[(size_t) index];
+}
+
+const uint8* FlatMidiFile::getEventData (int index) const noexcept
+{
+    return source + getEvent (index).offset;
+}
+
+MidiMessage FlatMidiFile::getMessage (int index) const
+{
+    const auto& event = getEvent (index);
+    int numBytesUsed = 0;
+
+    return MidiMessage (source + event.offset, (int) event.size, numBytesUsed, event.statusByte, event.timeStamp);
+}
+
+int FlatMidiFile::getIndexOfMatchingNoteOff (int noteOnIndex) const
+{
+    if (! getEvent (noteOnIndex).isNoteOn())
+        return -1;
+
+    if (! notesMatched)
+        matchNotes();
+
+    return noteOffIndices[(size_t) noteOnIndex];
+}
+
+void FlatMidiFile::matchNotes() const
+{
+    noteOffIndices.assign (events.size(), -1);
+
+    int lastNoteOn[16][256];
+
+    for (int track = 0; track < getNumTracks(); ++track)
+    {
+        std::fill (&lastNoteOn[0][0], &lastNoteOn[0][0] + 16 * 256, -1);
+
+        const auto range = getTrackEventRange (track);
+
+        for (int i = range.getStart(); i < range.getEnd(); ++i)
+        {
+            const auto& event = events[(size_t) i];
+            const auto isNoteOn = event.isNoteOn();
+
+            if (isNoteOn || event.isNoteOff())
+            {
+                auto& previous = lastNoteOn[event.statusByte & 0x0f][event.data1];
+
+                if (previous >= 0)
+                    noteOffIndices[(size_t) previous] = i;
+
+                previous = isNoteOn ? i : -1;
+            }
+        }
+    }
+
+    notesMatched = true;
+}
+
+//==============================================================================
+double FlatMidiFile::getLastTimestamp() const noexcept
+{
+    double t = 0.0;
+
+    for (int track = 0; track < getNumTracks(); ++track)
+    {
+        const auto range = getTrackEventRange (track);
+
+        if (! range.isEmpty())
+            t = jmax (t, events[(size_t) range.getEnd() - 1].timeStamp);
+    }
+
+    return t;
+}
+
+void FlatMidiFile::convertTimestampTicksToSeconds()
+{
+    if (timeFormat == 0)
+        return;
+
+    if (timeFormat < 0)
+    {
+        const auto ticksPerSecond = (double) (-(timeFormat >> 8) * (timeFormat & 0xff));
+
+        for (auto& event : events)
+            event.timeStamp /= ticksPerSecond;
+
+        return;
+    }
+
+    // Build a list of (tick, seconds per tick) pairs, with the last tempo event winning
+    // when several have the same time
+    struct TempoChange
+    {
+        double tick, secondsPerTick, seconds;
+    };
+
+    const auto tickLength = 1.0 / (timeFormat & 0x7fff);
+    std::vector<TempoChange> tempoChanges;
+
+    for (int i = 0; i < getNumEvents(); ++i)
+    {
+        const auto& event = events[(size_t) i];
+
+        if (event.isMetaEvent() && event.size > 1 && getEventData (i)[1] == 0x51)
+        {
+            const auto message = getMessage (i);
+
+            if (message.isTempoMetaEvent())
+                tempoChanges.push_back ({ event.timeStamp, tickLength * message.getTempoSecondsPerQuarterNote(), 0.0 });
+        }
+    }
+
+    std::stable_sort (tempoChanges.begin(), tempoChanges.end(),
+                      [] (const TempoChange& a, const TempoChange& b) { return a.tick < b.tick; });
+
+    auto lastTick = 0.0, seconds = 0.0, secondsPerTick = 0.5 * tickLength;
+
+    for (auto& change : tempoChanges)
+    {
+        seconds += (change.tick - lastTick) * secondsPerTick;
+        change.seconds = seconds;
+        lastTick = change.tick;
+        secondsPerTick = change.secondsPerTick;
+    }
+
+    for (int track = 0; track < getNumTracks(); ++track)
+    {
+        const auto range = getTrackEventRange (track);
+        size_t nextChange = 0;
+        TempoChange current { 0.0, 0.5 * tickLength, 0.0 };
+
+        for (int i = range.getStart(); i < range.getEnd(); ++i)
+        {
+            auto& event = events[(size_t) i];
+
+            // Tempo changes only apply to events that come strictly after them
+            while (nextChange < tempoChanges.size() && tempoChanges[nextChange].tick < event.timeStamp)
+                current = tempoChanges[nextChange++];
+
+            event.timeStamp = current.seconds + (event.timeStamp - current.tick) * current.secondsPerTick;
+        }
+    }
+}
+
+MidiMessageSequence FlatMidiFile::createSequence (int trackIndex, bool createMatchingNoteOffs) const
+{
+    MidiMessageSequence result;
+    const auto range = getTrackEventRange (trackIndex);
+
+    for (int i = range.getStart(); i < range.getEnd(); ++i)
+        result.addEvent (getMessage (i));
+
+    if (createMatchingNoteOffs)
+        result.updateMatchedPairs();
+
+    return result;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct FlatMidiFileTest final : public UnitTest
+{
+    FlatMidiFileTest()
+        : UnitTest ("FlatMidiFile", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Handwritten track with running status, sysex and meta events");
+        {
+            MemoryOutputStream os;
+            writeBytes (os, { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, 1, 0, 96 });
+
+            MemoryOutputStream track;
+            writeBytes (track, { 0x00, 0xff, 0x51, 0x03, 0x07, 0xa1, 0x20 });
+            writeBytes (track, { 0x00, 0x90, 0x40, 0x40 });
+            writeBytes (track, { 0x10, 0x42, 0x40 });
+            writeBytes (track, { 0x00, 0xf0, 0x03, 0x01, 0x02, 0xf7 });
+            writeBytes (track, { 0x20, 0x40, 0x00 });
+            writeBytes (track, { 0x00, 0x80, 0x42, 0x00 });
+            writeBytes (track, { 0x00, 0xff, 0x2f, 0x00 });
+
+            writeBytes (os, { 'M', 'T', 'r', 'k' });
+            os.writeIntBigEndian ((int) track.getDataSize());
+            os << track.getMemoryBlock();
+
+            FlatMidiFile flat;
+            expect (flat.parse (os.getData(), os.getDataSize()));
+            expectEquals (flat.getNumTracks(), 1);
+            expectEquals (flat.getNumEvents(), 7);
+            expectEquals ((int) flat.getTimeFormat(), 96);
+            expectEquals (flat.getFileType(), 1);
+
+            expect (flat.getEvent (1).isNoteOn());
+            expect (flat.getEvent (2).isNoteOn());
+            expectEquals ((int) flat.getEvent (2).data1, 0x42);
+            expect (flat.getMessage (3).isSysEx());
+            expectEquals (flat.getMessage (3).getSysExDataSize(), 2);
+
+            // The running-status velocity-zero note-on should match the first note
+            expect (flat.getEvent (4).isNoteOff());
+            expectEquals (flat.getIndexOfMatchingNoteOff (1), 4);
+            expectEquals (flat.getIndexOfMatchingNoteOff (2), 5);
+            expectEquals (flat.getIndexOfMatchingNoteOff (0), -1);
+
+            expectSameAsMidiFile (os, flat);
+        }
+
+        beginTest ("Note-offs are moved ahead of note-ons with the same time");
+        {
+            MidiMessageSequence seq;
+            seq.addEvent (MidiMessage::noteOn (1, 60, 0.5f), 0);
+            seq.addEvent (MidiMessage::noteOn (1, 60, 0.5f), 100);
+            seq.addEvent (MidiMessage::noteOff (1, 60), 100);
+            seq.addEvent (MidiMessage::noteOff (1, 60), 200);
+
+            const auto data = writeFile ({ &seq }, 96);
+
+            FlatMidiFile flat;
+            expect (flat.parse (data.getData(), data.getSize()));
+            expect (flat.getEvent (1).isNoteOff());
+            expect (flat.getEvent (2).isNoteOn());
+            expectEquals (flat.getIndexOfMatchingNoteOff (0), 1);
+            expectEquals (flat.getIndexOfMatchingNoteOff (2), 3);
+        }
+
+        beginTest ("Random files match MidiFile");
+        {
+            auto r = getRandom();
+            FlatMidiFile flat;
+
+            for (int i = 0; i < 20; ++i)
+            {
+                OwnedArray<MidiMessageSequence> tracks;
+
+                for (int t = r.nextInt ({ 1, 5 }); --t >= 0;)
+                {
+                    auto* seq = tracks.add (new MidiMessageSequence());
+
+                    for (int e = r.nextInt (200); --e >= 0;)
+                    {
+                        const auto time = (double) r.nextInt (5000);
+                        const auto channel = r.nextInt ({ 1, 17 });
+                        const auto note = r.nextInt (128);
+
+                        switch (r.nextInt (5))
+                        {
+                            case 0:  seq->addEvent (MidiMessage::tempoMetaEvent (r.nextInt ({ 200000, 1000000 })), time); break;
+                            case 1:  seq->addEvent (MidiMessage::controllerEvent (channel, r.nextInt (128), r.nextInt (128)), time); break;
+                            case 2:  seq->addEvent (MidiMessage::noteOff (channel, note), time); break;
+                            default: seq->addEvent (MidiMessage::noteOn (channel, note, (uint8) r.nextInt ({ 1, 128 })), time); break;
+                        }
+                    }
+                }
+
+                Array<const MidiMessageSequence*> trackPointers;
+
+                for (auto* seq : tracks)
+                    trackPointers.add (seq);
+
+                const auto data = writeFile (trackPointers, (short) r.nextInt ({ 24, 960 }));
+                expect (flat.parse (data.getData(), data.getSize()));
+
+                MemoryOutputStream os;
+                os << data;
+                expectSameAsMidiFile (os, flat);
+            }
+        }
+
+        beginTest ("Malformed input is rejected");
+        {
+            FlatMidiFile flat;
+            expect (! flat.parse (nullptr, 0));
+
+            const uint8 truncated[] = { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, 1, 0, 1, 'M', 'T', 'r', 'k', 0, 0, 0, 10 };
+            expect (! flat.parse (truncated, sizeof (truncated)));
+        }
+
+        beginTest ("Load from a memory-mapped file");
+        {
+            MidiMessageSequence seq;
+            seq.addEvent (MidiMessage::noteOn (1, 60, 0.5f), 0);
+            seq.addEvent (MidiMessage::noteOff (1, 60), 96);
+
+            const auto data = writeFile ({ &seq }, 96);
+
+            TemporaryFile temp (".mid");
+            expect (temp.getFile().replaceWithData (data.getData(), data.getSize()));
+
+            FlatMidiFile flat;
+            expect (flat.loadFrom (temp.getFile()));
+            expectEquals (flat.getNumEvents(), 3);
+            expectEquals (flat.getIndexOfMatchingNoteOff (0), 1);
+
+            flat.clear();
+            expectEquals (flat.getNumTracks(), 0);
+            expect (! flat.loadFrom (temp.getFile().getSiblingFile ("doesNotExist.mid")));
+        }
+    }
+
+    void expectSameAsMidiFile (const MemoryOutputStream& os, FlatMidiFile& flat)
+    {
+        // (without matching note-offs, as that would insert extra events for retriggered notes)
+        MidiFile mf;
+        MemoryInputStream is (os.getData(), os.getDataSize(), false);
+        expect (mf.readFrom (is, false));
+
+        expectEquals (flat.getNumTracks(), mf.getNumTracks());
+        expectEquals ((int) flat.getTimeFormat(), (int) mf.getTimeFormat());
+
+        const auto compareTracks = [&] (bool checkNoteOffs)
+        {
+            for (int t = 0; t < mf.getNumTracks(); ++t)
+            {
+                const auto& seq = *mf.getTrack (t);
+                const auto range = flat.getTrackEventRange (t);
+                expectEquals (range.getLength(), seq.getNumEvents());
+
+                for (int i = 0; i < jmin (range.getLength(), seq.getNumEvents()); ++i)
+                {
+                    const auto& expected = seq.getEventPointer (i)->message;
+                    const auto actual = flat.getMessage (range.getStart() + i);
+
+                    expectWithinAbsoluteError (actual.getTimeStamp(), expected.getTimeStamp(), 1.0e-9);
+                    expect (actual.getRawDataSize() == expected.getRawDataSize()
+                            && std::memcmp (actual.getRawData(), expected.getRawData(), (size_t) expected.getRawDataSize()) == 0);
+
+                    if (checkNoteOffs && expected.isNoteOn())
+                    {
+                        const auto actualNoteOff = flat.getIndexOfMatchingNoteOff (range.getStart() + i);
+                        expectEquals (actualNoteOff < 0 ? -1 : actualNoteOff - range.getStart(), findNoteEnd (seq, i));
+                    }
+                }
+            }
+        };
+
+        compareTracks (true);
+
+        mf.convertTimestampTicksToSeconds();
+        flat.convertTimestampTicksToSeconds();
+        expectWithinAbsoluteError (flat.getLastTimestamp(), mf.getLastTimestamp(), 1.0e-9);
+        compareTracks (false);
+    }
+
+    static int findNoteEnd (const MidiMessageSequence& seq, int noteOnIndex)
+    {
+        const auto& noteOn = seq.getEventPointer (noteOnIndex)->message;
+
+        for (int i = noteOnIndex + 1; i < seq.getNumEvents(); ++i)
+        {
+            const auto& m = seq.getEventPointer (i)->message;
+
+            if ((m.isNoteOn() || m.isNoteOff())
+                 && m.getChannel() == noteOn.getChannel()
+                 && m.getNoteNumber() == noteOn.getNoteNumber())
+                return i;
+        }
+
+        return -1;
+    }
+
+    static MemoryBlock writeFile (const Array<const MidiMessageSequence*>& tracks, short timeFormat)
+    {
+        MidiFile mf;
+        mf.setTicksPerQuarterNote (timeFormat);
+
+        for (auto* track : tracks)
+            mf.addTrack (*track);
+
+        MemoryOutputStream os;
+        mf.writeTo (os);
+        return os.getMemoryBlock();
+    }
+
+    static void writeBytes (OutputStream& os, const std::vector<uint8>& bytes)
+    {
+        for (const auto& byte : bytes)
+            os.writeByte ((char) byte);
+    }
+};
+
+static FlatMidiFileTest flatMidiFileTests;
+
+#endif
+
+} // namespace juce
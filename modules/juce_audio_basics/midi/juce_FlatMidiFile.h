@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads a standard midi file into a single flat array of events.
+
+    MidiFile copies the whole file into memory and then creates a separately allocated
+    MidiMessage for every event. This class instead parses the file in place, either
+    from a block of memory or from a memory-mapped file, and stores a small fixed-size
+    Event for each message that refers back to the original bytes. A MidiMessage is only
+    created when you ask for one with getMessage().
+
+    The event array is kept between calls to parse() or loadFrom(), so a single object
+    can be re-used to read a large number of files without allocating any memory once
+    the array has grown to fit the largest of them.
+
+    As with MidiFile::readFrom(), note-offs are moved ahead of any note-ons in the same
+    track that have the same timestamp. The note-offs that match each note-on are only
+    found when getIndexOfMatchingNoteOff() is first called.
+
+    @see MidiFile
+
+    @tags{Audio}
+*/
+class JUCE_API  FlatMidiFile
+{
+public:
+    //==============================================================================
+    /** Creates an empty FlatMidiFile. */
+    FlatMidiFile();
+
+    /** Destructor. */
+    ~FlatMidiFile();
+
+    //==============================================================================
+    /** Parses midi file data from a block of memory.
+
+        The data isn't copied, so it must remain valid and unchanged for as long as this
+        object refers to it, i.e. until clear(), parse() or loadFrom() is next called.
+
+        @returns true if the data was a valid midi file
+    */
+    bool parse (const void* data, size_t numBytes);
+
+    /** Memory-maps a midi file and parses it.
+
+        The file stays mapped until clear(), parse() or loadFrom() is next called.
+
+        @returns true if the file could be opened and was a valid midi file
+    */
+    bool loadFrom (const File& file);
+
+    /** Clears the events and releases any data that's being referred to.
+
+        The memory used for the event array is kept, so that it can be re-used.
+    */
+    void clear();
+
+    //==============================================================================
+    /** A single event in a FlatMidiFile. */
+    struct Event
+    {
+        /** The event's time, in midi ticks, or in seconds after convertTimestampTicksToSeconds(). */
+        double timeStamp;
+
+        /** The position of the event's data in the file, after its delta-time. */
+        uint32 offset;
+
+        /** The number of bytes that the event occupies in the file. */
+        uint32 size;
+
+        /** The event's status byte. If the event uses running status, this is the status
+            byte from an earlier event.
+        */
+        uint8 statusByte;
+
+        /** The first two data bytes of a channel message, or zero. */
+        uint8 data1, data2;
+
+        /** The index of the track that the event belongs to. */
+        uint16 track;
+
+        /** Returns the event's midi channel, from 1 to 16, or 0 if it isn't a channel message. */
+        int getChannel() const noexcept             { return statusByte < 0xf0 ? (statusByte & 0x0f) + 1 : 0; }
+
+        /** Returns true if this is a note-on with a non-zero velocity. */
+        bool isNoteOn() const noexcept              { return (statusByte & 0xf0) == 0x90 && data2 != 0; }
+
+        /** Returns true if this is a note-off, or a note-on with zero velocity. */
+        bool isNoteOff() const noexcept             { return (statusByte & 0xf0) == 0x80 || ((statusByte & 0xf0) == 0x90 && data2 == 0); }
+
+        /** Returns true if this is a meta-event. */
+        bool isMetaEvent() const noexcept           { return statusByte == 0xff; }
+    };
+
+    //==============================================================================
+    /** Returns the number of tracks that were read. */
+    int getNumTracks() const noexcept               { return (int) trackStarts.size() - 1; }
+
+    /** Returns the range of event indices that belong to a track. */
+    Range<int> getTrackEventRange (int trackIndex) const noexcept;
+
+    /** Returns the total number of events in all of the tracks. */
+    int getNumEvents() const noexcept               { return (int) events.size(); }
+
+    /** Returns one of the events. */
+    const Event& getEvent (int index) const noexcept;
+
+    /** Creates a MidiMessage for one of the events. */
+    MidiMessage getMessage (int index) const;
+
+    /** Returns the raw bytes in the file for one of the events.
+
+        For events that use running status, this won't include the status byte.
+    */
+    const uint8* getEventData (int index) const noexcept;
+
+    /** Returns the index of the event that ends the note started by a note-on.
+
+        This is either the next note-off for the same note and channel, or the next
+        note-on for it if that comes first. In the second case
+        MidiMessageSequence::updateMatchedPairs() would insert a note-off just before the
+        second note-on, but as this class can't add events, the note-on's index is returned
+        instead. Returns -1 if the event isn't a note-on or the note is never ended.
+
+        The first call to this method matches up the notes in the whole file, so it isn't
+        safe to call it from more than one thread at once.
+    */
+    int getIndexOfMatchingNoteOff (int noteOnIndex) const;
+
+    //==============================================================================
+    /** Returns the file's time format. @see MidiFile::getTimeFormat */
+    short getTimeFormat() const noexcept            { return timeFormat; }
+
+    /** Returns the file's type: 0, 1 or 2. */
+    int getFileType() const noexcept                { return fileType; }
+
+    /** Returns the latest timestamp of any of the events. */
+    double getLastTimestamp() const noexcept;
+
+    /** Converts the timestamps of all of the events from midi ticks to seconds, in the
+        same way as MidiFile::convertTimestampTicksToSeconds().
+    */
+    void convertTimestampTicksToSeconds();
+
+    /** Creates a MidiMessageSequence containing the events from one of the tracks.
+
+        @param trackIndex               the track to copy
+        @param createMatchingNoteOffs   if true, MidiMessageSequence::updateMatchedPairs()
+                                        is called on the result, as MidiFile::readFrom() does
+    */
+    MidiMessageSequence createSequence (int trackIndex, bool createMatchingNoteOffs = true) const;
+
+private:
+    //==============================================================================
+    std::optional<MemoryMappedFile> mappedFile;
+    const uint8* source = nullptr;
+    std::vector<Event> events;
+    std::vector<int> trackStarts { 0 };
+    mutable std::vector<int> noteOffIndices;
+    mutable bool notesMatched = false;
+    short timeFormat = 0;
+    int fileType = 0;
+
+    bool parseData (const uint8*, size_t);
+    void readTrack (const uint8*, int, int trackIndex);
+    void matchNotes() const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlatMidiFile)
+};
+
+} // namespace juce
@@ -0,0 +1,623 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+FlatMidiSequence::FlatMidiSequence() = default;
+FlatMidiSequence::~FlatMidiSequence() = default;
+
+FlatMidiSequence::FlatMidiSequence (const FlatMidiSequence&) = default;
+FlatMidiSequence& FlatMidiSequence::operator= (const FlatMidiSequence&) = default;
+FlatMidiSequence::FlatMidiSequence (FlatMidiSequence&&) noexcept = default;
+FlatMidiSequence& FlatMidiSequence::operator= (FlatMidiSequence&&) noexcept = default;
+
+FlatMidiSequence::FlatMidiSequence (const MidiMessageSequence& other)
+{
+    const auto numEvents = other.getNumEvents();
+    ensureStorageAllocated (numEvents);
+
+    std::unordered_map<const MidiMessageSequence::MidiEventHolder*, int> indices;
+    indices.reserve ((size_t) numEvents);
+
+    for (int i = 0; i < numEvents; ++i)
+    {
+        const auto* holder = other.getEventPointer (i);
+        addEventWithoutSorting (holder->message);
+        indices[holder] = i;
+    }
+
+    for (int i = 0; i < numEvents; ++i)
+        if (const auto* noteOff = other.getEventPointer (i)->noteOffObject)
+            if (const auto found = indices.find (noteOff); found != indices.end())
+                noteOffIndices[(size_t) i] = found->second;
+}
+
+//==============================================================================
+void FlatMidiSequence::clear()
+{
+    timeStamps.clear();
+    messages.clear();
+    noteOffIndices.clear();
+    longMessageData.clear();
+    numUnusedLongMessageBytes = 0;
+}
+
+void FlatMidiSequence::ensureStorageAllocated (int numEvents, int numLongMessageBytes)
+{
+    timeStamps.reserve ((size_t) numEvents);
+    messages.reserve ((size_t) numEvents);
+    noteOffIndices.reserve ((size_t) numEvents);
+    longMessageData.reserve ((size_t) numLongMessageBytes);
+}
+
+const uint8* FlatMidiSequence::getRawData (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumEvents()));
+    const auto& message = messages[(size_t) index];
+
+    if (message.size <= sizeof (message.data))
+        return reinterpret_cast<const uint8*> (&message.data);
+
+    return longMessageData.data() + message.data;
+}
+
+int FlatMidiSequence::getRawDataSize (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumEvents()));
+    return (int) messages[(size_t) index].size;
+}
+
+MidiMessage FlatMidiSequence::getMessage (int index) const
+{
+    return MidiMessage (getRawData (index), getRawDataSize (index), timeStamps[(size_t) index]);
+}
+
+//==============================================================================
+int FlatMidiSequence::getIndexOfMatchingKeyUp (int index) const noexcept
+{
+    return isPositiveAndBelow (index, getNumEvents()) ? noteOffIndices[(size_t) index] : -1;
+}
+
+double FlatMidiSequence::getTimeOfMatchingKeyUp (int index) const noexcept
+{
+    const auto noteOff = getIndexOfMatchingKeyUp (index);
+    return noteOff >= 0 ? timeStamps[(size_t) noteOff] : 0.0;
+}
+
+int FlatMidiSequence::getNextIndexAtTime (double timeStamp) const noexcept
+{
+    return (int) std::distance (timeStamps.begin(), std::lower_bound (timeStamps.begin(), timeStamps.end(), timeStamp));
+}
+
+double FlatMidiSequence::getStartTime() const noexcept
+{
+    return getEventTime (0);
+}
+
+double FlatMidiSequence::getEndTime() const noexcept
+{
+    return getEventTime (getNumEvents() - 1);
+}
+
+double FlatMidiSequence::getEventTime (int index) const noexcept
+{
+    return isPositiveAndBelow (index, getNumEvents()) ? timeStamps[(size_t) index] : 0.0;
+}
+
+//==============================================================================
+FlatMidiSequence::PackedMessage FlatMidiSequence::pack (const uint8* data, int size)
+{
+    PackedMessage result { 0, (uint32) size };
+
+    if (result.size <= sizeof (result.data))
+    {
+        memcpy (&result.data, data, (size_t) size);
+    }
+    else
+    {
+        result.data = (uint32) longMessageData.size();
+        longMessageData.insert (longMessageData.end(), data, data + size);
+    }
+
+    return result;
+}
+
+void FlatMidiSequence::insertEvent (int index, double time, PackedMessage message, int noteOffIndex)
+{
+    for (auto& i : noteOffIndices)
+        if (i >= index)
+            ++i;
+
+    timeStamps.insert (timeStamps.begin() + index, time);
+    messages.insert (messages.begin() + index, message);
+    noteOffIndices.insert (noteOffIndices.begin() + index, noteOffIndex);
+}
+
+void FlatMidiSequence::removeEvent (int index)
+{
+    const auto size = messages[(size_t) index].size;
+
+    if (size > sizeof (PackedMessage::data))
+        numUnusedLongMessageBytes += size;
+
+    timeStamps.erase (timeStamps.begin() + index);
+    messages.erase (messages.begin() + index);
+    noteOffIndices.erase (noteOffIndices.begin() + index);
+
+    for (auto& i : noteOffIndices)
+    {
+        if (i == index)
+            i = -1;
+        else if (i > index)
+            --i;
+    }
+
+    if (numUnusedLongMessageBytes > 4096 && numUnusedLongMessageBytes > longMessageData.size() / 2)
+        compactLongMessageData();
+}
+
+void FlatMidiSequence::compactLongMessageData()
+{
+    std::vector<uint8> newData;
+    newData.reserve (longMessageData.size() - numUnusedLongMessageBytes);
+
+    for (auto& message : messages)
+    {
+        if (message.size > sizeof (message.data))
+        {
+            const auto* start = longMessageData.data() + message.data;
+            message.data = (uint32) newData.size();
+            newData.insert (newData.end(), start, start + message.size);
+        }
+    }
+
+    longMessageData.swap (newData);
+    numUnusedLongMessageBytes = 0;
+}
+
+int FlatMidiSequence::addEvent (const MidiMessage& newMessage, double timeAdjustment)
+{
+    const auto time = newMessage.getTimeStamp() + timeAdjustment;
+    const auto index = (int) std::distance (timeStamps.begin(), std::upper_bound (timeStamps.begin(), timeStamps.end(), time));
+
+    insertEvent (index, time, pack (newMessage.getRawData(), newMessage.getRawDataSize()), -1);
+    return index;
+}
+
+void FlatMidiSequence::addEventWithoutSorting (const MidiMessage& newMessage, double timeAdjustment)
+{
+    const auto packed = pack (newMessage.getRawData(), newMessage.getRawDataSize());
+
+    timeStamps.push_back (newMessage.getTimeStamp() + timeAdjustment);
+    messages.push_back (packed);
+    noteOffIndices.push_back (-1);
+}
+
+void FlatMidiSequence::addSequence (const MidiMessageSequence& other, double timeAdjustment)
+{
+    ensureStorageAllocated (getNumEvents() + other.getNumEvents());
+
+    for (const auto* holder : other)
+        addEventWithoutSorting (holder->message, timeAdjustment);
+
+    sort();
+}
+
+void FlatMidiSequence::addSequence (const FlatMidiSequence& other, double timeAdjustment)
+{
+    if (&other == this)
+    {
+        const auto copy = other;
+        addSequence (copy, timeAdjustment);
+        return;
+    }
+
+    const auto numOtherEvents = other.getNumEvents();
+    ensureStorageAllocated (getNumEvents() + numOtherEvents,
+                            (int) (longMessageData.size() + other.longMessageData.size()));
+
+    for (int i = 0; i < numOtherEvents; ++i)
+    {
+        const auto packed = pack (other.getRawData (i), other.getRawDataSize (i));
+
+        timeStamps.push_back (other.timeStamps[(size_t) i] + timeAdjustment);
+        messages.push_back (packed);
+        noteOffIndices.push_back (-1);
+    }
+
+    sort();
+}
+
+void FlatMidiSequence::deleteEvent (int index, bool deleteMatchingNoteUp)
+{
+    if (isPositiveAndBelow (index, getNumEvents()))
+    {
+        if (deleteMatchingNoteUp)
+            deleteEvent (getIndexOfMatchingKeyUp (index), false);
+
+        removeEvent (index);
+    }
+}
+
+void FlatMidiSequence::sort()
+{
+    const auto numEvents = timeStamps.size();
+    const auto firstUnsorted = (size_t) std::distance (timeStamps.begin(), std::is_sorted_until (timeStamps.begin(), timeStamps.end()));
+
+    if (firstUnsorted == numEvents)
+        return;
+
+    // Everything before the earliest unsorted event can stay where it is, so only the
+    // events after that need to be sorted and merged
+    const auto earliestUnsortedTime = *std::min_element (timeStamps.begin() + (ptrdiff_t) firstUnsorted, timeStamps.end());
+    const auto start = (size_t) std::distance (timeStamps.begin(),
+                                               std::upper_bound (timeStamps.begin(), timeStamps.begin() + (ptrdiff_t) firstUnsorted,
+                                                                 earliestUnsortedTime));
+
+    std::vector<int> order (numEvents - start);
+    std::iota (order.begin(), order.end(), (int) start);
+
+    const auto compare = [this] (int a, int b) { return timeStamps[(size_t) a] < timeStamps[(size_t) b]; };
+    const auto middle = order.begin() + (ptrdiff_t) (firstUnsorted - start);
+    std::stable_sort (middle, order.end(), compare);
+    std::inplace_merge (order.begin(), middle, order.end(), compare);
+
+    std::vector<int> newIndices (numEvents);
+    std::iota (newIndices.begin(), newIndices.begin() + (ptrdiff_t) start, 0);
+
+    for (size_t i = 0; i < order.size(); ++i)
+        newIndices[(size_t) order[i]] = (int) (start + i);
+
+    const auto applyOrder = [&] (auto& array)
+    {
+        std::vector<typename std::remove_reference_t<decltype (array)>::value_type> sorted;
+        sorted.reserve (order.size());
+
+        for (auto i : order)
+            sorted.push_back (array[(size_t) i]);
+
+        std::copy (sorted.begin(), sorted.end(), array.begin() + (ptrdiff_t) start);
+    };
+
+    applyOrder (timeStamps);
+    applyOrder (messages);
+    applyOrder (noteOffIndices);
+
+    for (auto& i : noteOffIndices)
+        if (i >= 0)
+            i = newIndices[(size_t) i];
+}
+
+void FlatMidiSequence::updateMatchedPairs()
+{
+    const auto isNote = [] (const uint8* data, uint32 size, bool noteOn)
+    {
+        if (size > sizeof (PackedMessage::data))
+            return false;
+
+        const auto type = data[0] & 0xf0;
+        return noteOn ? (type == 0x90 && data[2] != 0)
+                      : (type == 0x80 || (type == 0x90 && data[2] == 0));
+    };
+
+    // Holds the index of the note-on that's currently playing for each channel and note
+    int playing[16][256];
+
+    const auto forEachNote = [&] (auto&& callback)
+    {
+        std::fill (&playing[0][0], &playing[0][0] + 16 * 256, -1);
+
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            const auto& message = messages[i];
+            const auto* data = reinterpret_cast<const uint8*> (&message.data);
+            const auto isNoteOn = isNote (data, message.size, true);
+
+            if (isNoteOn || isNote (data, message.size, false))
+            {
+                auto& previous = playing[data[0] & 0x0f][data[1]];
+                callback ((int) i, previous, isNoteOn);
+                previous = isNoteOn ? (int) i : -1;
+            }
+        }
+    };
+
+    // First, insert a note-off before any note-on that retriggers a note that's still playing
+    std::vector<size_t> retriggers;
+
+    forEachNote ([&] (int index, int previous, bool isNoteOn)
+    {
+        if (isNoteOn && previous >= 0)
+            retriggers.push_back ((size_t) index);
+    });
+
+    if (! retriggers.empty())
+    {
+        const auto numEvents = messages.size();
+        std::vector<double> newTimeStamps;
+        std::vector<PackedMessage> newMessages;
+        newTimeStamps.reserve (numEvents + retriggers.size());
+        newMessages.reserve (numEvents + retriggers.size());
+
+        auto nextRetrigger = retriggers.begin();
+
+        for (size_t i = 0; i < numEvents; ++i)
+        {
+            if (nextRetrigger != retriggers.end() && *nextRetrigger == i)
+            {
+                const auto* data = reinterpret_cast<const uint8*> (&messages[i].data);
+                const auto noteOff = MidiMessage::noteOff ((data[0] & 0x0f) + 1, data[1]);
+
+                newTimeStamps.push_back (timeStamps[i]);
+                newMessages.push_back (pack (noteOff.getRawData(), noteOff.getRawDataSize()));
+                ++nextRetrigger;
+            }
+
+            newTimeStamps.push_back (timeStamps[i]);
+            newMessages.push_back (messages[i]);
+        }
+
+        timeStamps.swap (newTimeStamps);
+        messages.swap (newMessages);
+    }
+
+    noteOffIndices.assign (messages.size(), -1);
+
+    forEachNote ([&] (int index, int previous, bool)
+    {
+        if (previous >= 0)
+            noteOffIndices[(size_t) previous] = index;
+    });
+}
+
+void FlatMidiSequence::addTimeToMessages (double deltaTime) noexcept
+{
+    if (! approximatelyEqual (deltaTime, 0.0))
+        for (auto& t : timeStamps)
+            t += deltaTime;
+}
+
+MidiMessageSequence FlatMidiSequence::createMidiMessageSequence() const
+{
+    MidiMessageSequence result;
+    const auto numEvents = getNumEvents();
+
+    for (int i = 0; i < numEvents; ++i)
+        result.addEvent (getMessage (i));
+
+    for (int i = 0; i < numEvents; ++i)
+        if (const auto noteOff = noteOffIndices[(size_t) i]; noteOff >= 0)
+            result.getEventPointer (i)->noteOffObject = result.getEventPointer (noteOff);
+
+    return result;
+}
+
+void FlatMidiSequence::swapWith (FlatMidiSequence& other) noexcept
+{
+    std::swap (timeStamps, other.timeStamps);
+    std::swap (messages, other.messages);
+    std::swap (noteOffIndices, other.noteOffIndices);
+    std::swap (longMessageData, other.longMessageData);
+    std::swap (numUnusedLongMessageBytes, other.numUnusedLongMessageBytes);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct FlatMidiSequenceTest final : public UnitTest
+{
+    FlatMidiSequenceTest()
+        : UnitTest ("FlatMidiSequence", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Adding and deleting events matches MidiMessageSequence");
+        {
+            MidiMessageSequence expected;
+            FlatMidiSequence actual;
+
+            for (int i = 0; i < 500; ++i)
+            {
+                const auto message = createRandomMessage (r);
+                const auto index = actual.addEvent (message, 1.0);
+                expectEquals (index, expected.getIndexOf (expected.addEvent (message, 1.0)));
+            }
+
+            expectSame (actual, expected);
+
+            for (int i = 0; i < 10; ++i)
+            {
+                const auto time = r.nextDouble() * 110.0;
+                expectEquals (actual.getNextIndexAtTime (time), expected.getNextIndexAtTime (time));
+            }
+
+            expected.updateMatchedPairs();
+            actual.updateMatchedPairs();
+            expectSame (actual, expected);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                const auto index = r.nextInt (expected.getNumEvents());
+                const auto deleteMatchingNoteUp = r.nextBool();
+                expected.deleteEvent (index, deleteMatchingNoteUp);
+                actual.deleteEvent (index, deleteMatchingNoteUp);
+
+                // Deleting can leave a stale note-off link in MidiMessageSequence, which would
+                // trip an assertion the next time a matching note-off is deleted
+                expected.updateMatchedPairs();
+                actual.updateMatchedPairs();
+            }
+
+            expectSame (actual, expected);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                const auto message = createRandomMessage (r);
+                actual.addEvent (message);
+                expected.addEvent (message);
+            }
+
+            // (MidiMessageSequence can leave dangling note-off pointers after deleting
+            // events, which may then alias the new events, so the pairs need updating)
+            expected.updateMatchedPairs();
+            actual.updateMatchedPairs();
+            expectSame (actual, expected);
+        }
+
+        beginTest ("Batch insertion and sorting");
+        {
+            MidiMessageSequence other;
+
+            for (int i = 0; i < 300; ++i)
+                other.addEvent (createRandomMessage (r));
+
+            MidiMessageSequence expected;
+            FlatMidiSequence actual;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto message = createRandomMessage (r);
+                expected.addEvent (message);
+                actual.addEvent (message);
+            }
+
+            expected.addSequence (other, 50.0);
+            actual.addSequence (other, 50.0);
+            expectSame (actual, expected);
+
+            // (MidiMessageSequence can't add itself, so it needs a copy)
+            expected.addSequence (MidiMessageSequence (expected), -20.0);
+            actual.addSequence (actual, -20.0);
+            expectSame (actual, expected);
+
+            FlatMidiSequence unsorted;
+
+            for (int i = 0; i < 200; ++i)
+                unsorted.addEventWithoutSorting (expected.getEventPointer (i)->message);
+
+            for (int i = 400; --i >= 200;)
+                unsorted.addEventWithoutSorting (expected.getEventPointer (i)->message);
+
+            unsorted.sort();
+
+            for (int i = 0; i < 400; ++i)
+                expect (exactlyEqual (unsorted.getEventTime (i), expected.getEventTime (i)));
+        }
+
+        beginTest ("Conversion to and from MidiMessageSequence");
+        {
+            MidiMessageSequence expected;
+
+            for (int i = 0; i < 300; ++i)
+                expected.addEvent (createRandomMessage (r));
+
+            expected.updateMatchedPairs();
+
+            const FlatMidiSequence flat (expected);
+            expectSame (flat, expected);
+
+            const auto copy = flat.createMidiMessageSequence();
+            expectSame (flat, copy);
+        }
+
+        beginTest ("Long messages survive deletion");
+        {
+            FlatMidiSequence seq;
+            std::vector<MidiMessage> sysexes;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                std::vector<uint8> data ((size_t) r.nextInt ({ 10, 100 }));
+
+                for (auto& d : data)
+                    d = (uint8) r.nextInt (128);
+
+                sysexes.push_back (MidiMessage::createSysExMessage (data.data(), (int) data.size()));
+                sysexes.back().setTimeStamp (i);
+                seq.addEvent (sysexes.back());
+            }
+
+            for (int i = 200; --i >= 0;)
+            {
+                if (i % 8 != 0)
+                {
+                    seq.deleteEvent (i, false);
+                    sysexes.erase (sysexes.begin() + i);
+                }
+            }
+
+            expectEquals (seq.getNumEvents(), (int) sysexes.size());
+
+            for (int i = 0; i < seq.getNumEvents(); ++i)
+            {
+                expectEquals (seq.getRawDataSize (i), sysexes[(size_t) i].getRawDataSize());
+                expect (memcmp (seq.getRawData (i), sysexes[(size_t) i].getRawData(), (size_t) seq.getRawDataSize (i)) == 0);
+            }
+        }
+    }
+
+    static MidiMessage createRandomMessage (Random& r)
+    {
+        const auto time = (double) r.nextInt (100);
+        const auto channel = r.nextInt ({ 1, 3 });
+        const auto note = r.nextInt ({ 60, 64 });
+
+        switch (r.nextInt (6))
+        {
+            case 0:  return MidiMessage::controllerEvent (channel, 7, r.nextInt (128)).withTimeStamp (time);
+            case 1:
+            {
+                // (sysex messages of 3 to 5 bytes, so that some are stored inline and some aren't)
+                const uint8 data[] { (uint8) note, (uint8) channel, (uint8) r.nextInt (128) };
+                return MidiMessage::createSysExMessage (data, r.nextInt ({ 1, 4 })).withTimeStamp (time);
+            }
+            case 2:  return MidiMessage::noteOff (channel, note).withTimeStamp (time);
+            default: return MidiMessage::noteOn (channel, note, (uint8) r.nextInt ({ 1, 128 })).withTimeStamp (time);
+        }
+    }
+
+    void expectSame (const FlatMidiSequence& actual, const MidiMessageSequence& expected)
+    {
+        expectEquals (actual.getNumEvents(), expected.getNumEvents());
+
+        for (int i = 0; i < jmin (actual.getNumEvents(), expected.getNumEvents()); ++i)
+        {
+            const auto& message = expected.getEventPointer (i)->message;
+            expect (exactlyEqual (actual.getEventTime (i), message.getTimeStamp()));
+            expectEquals (actual.getRawDataSize (i), message.getRawDataSize());
+            expect (memcmp (actual.getRawData (i), message.getRawData(), (size_t) message.getRawDataSize()) == 0);
+            expectEquals (actual.getIndexOfMatchingKeyUp (i), expected.getIndexOfMatchingKeyUp (i));
+        }
+    }
+};
+
+static FlatMidiSequenceTest flatMidiSequenceTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A sequence of timestamped midi messages, stored as a structure of arrays.
+
+    MidiMessageSequence keeps a separately allocated MidiEventHolder for every event,
+    so sorting, matching notes and searching a large sequence has to follow a pointer
+    for each event it looks at. This class keeps the timestamps in one contiguous array
+    and the message bytes in another, with messages of up to 3 bytes packed inline and
+    longer ones (sysex and meta events) stored in a single shared block of memory. This
+    lets time lookups use a binary search, and makes batch insertion, sorting and note
+    matching cheap even for sequences with millions of events.
+
+    Events are identified by their index, which changes as events are added and removed
+    before them. The pairs found by updateMatchedPairs() are kept up to date as the
+    sequence is edited, in the same way as MidiMessageSequence does.
+
+    @see MidiMessageSequence
+
+    @tags{Audio}
+*/
+class JUCE_API  FlatMidiSequence
+{
+public:
+    //==============================================================================
+    /** Creates an empty sequence. */
+    FlatMidiSequence();
+
+    /** Creates a copy of a MidiMessageSequence, including its matched note pairs. */
+    explicit FlatMidiSequence (const MidiMessageSequence&);
+
+    /** Destructor. */
+    ~FlatMidiSequence();
+
+    FlatMidiSequence (const FlatMidiSequence&);
+    FlatMidiSequence& operator= (const FlatMidiSequence&);
+    FlatMidiSequence (FlatMidiSequence&&) noexcept;
+    FlatMidiSequence& operator= (FlatMidiSequence&&) noexcept;
+
+    //==============================================================================
+    /** Clears the sequence. */
+    void clear();
+
+    /** Pre-allocates space for a number of events, and for a number of bytes of
+        message data longer than 3 bytes.
+    */
+    void ensureStorageAllocated (int numEvents, int numLongMessageBytes = 0);
+
+    /** Returns the number of events in the sequence. */
+    int getNumEvents() const noexcept                   { return (int) timeStamps.size(); }
+
+    /** Returns the raw bytes of the event at a given index. */
+    const uint8* getRawData (int index) const noexcept;
+
+    /** Returns the number of bytes in the event at a given index. */
+    int getRawDataSize (int index) const noexcept;
+
+    /** Creates a MidiMessage for the event at a given index. */
+    MidiMessage getMessage (int index) const;
+
+    //==============================================================================
+    /** Returns the index of the note-up that matches the note-on at this index.
+        If the event at this index isn't a note-on, it'll just return -1.
+        @see updateMatchedPairs
+    */
+    int getIndexOfMatchingKeyUp (int index) const noexcept;
+
+    /** Returns the time of the note-up that matches the note-on at this index.
+        If the event at this index isn't a note-on, it'll just return 0.
+    */
+    double getTimeOfMatchingKeyUp (int index) const noexcept;
+
+    /** Returns the index of the first event on or after the given timestamp.
+        If the time is beyond the end of the sequence, this will return the
+        number of events. Unlike MidiMessageSequence, this is a binary search.
+    */
+    int getNextIndexAtTime (double timeStamp) const noexcept;
+
+    /** Returns the timestamp of the first event in the sequence. */
+    double getStartTime() const noexcept;
+
+    /** Returns the timestamp of the last event in the sequence. */
+    double getEndTime() const noexcept;
+
+    /** Returns the timestamp of the event at a given index.
+        If the index is out-of-range, this will return 0.0
+    */
+    double getEventTime (int index) const noexcept;
+
+    //==============================================================================
+    /** Inserts a midi message into the sequence.
+
+        The message is inserted after any existing events with the same timestamp,
+        and the new event's index is returned. Inserting lots of events one at a time
+        means moving the events that come after each one, so when adding many events,
+        addEventWithoutSorting() followed by sort() will be much quicker.
+    */
+    int addEvent (const MidiMessage& newMessage, double timeAdjustment = 0);
+
+    /** Appends a midi message to the end of the sequence, whatever its timestamp.
+
+        Call sort() once you've finished adding events, before calling any other
+        methods that rely on the events being in time order.
+    */
+    void addEventWithoutSorting (const MidiMessage& newMessage, double timeAdjustment = 0);
+
+    /** Merges the events from a MidiMessageSequence into this one. */
+    void addSequence (const MidiMessageSequence& other, double timeAdjustment = 0);
+
+    /** Merges the events from another FlatMidiSequence into this one. */
+    void addSequence (const FlatMidiSequence& other, double timeAdjustment = 0);
+
+    /** Deletes an event from the sequence.
+
+        If deleteMatchingNoteUp is true and the event is a note-on with a matching
+        note-off, that will be deleted too.
+    */
+    void deleteEvent (int index, bool deleteMatchingNoteUp);
+
+    /** Sorts the events by timestamp, keeping events with equal times in the same order.
+        This only moves the events that are out of order, so it's quick to call after
+        appending a batch of events to an already sorted sequence.
+    */
+    void sort();
+
+    /** Makes sure all the note-on and note-off pairs are matched up, inserting note-offs
+        for any note-ons that are retriggered before they end, in the same way as
+        MidiMessageSequence::updateMatchedPairs() does.
+    */
+    void updateMatchedPairs();
+
+    /** Adds an offset to the timestamps of all the events in the sequence. */
+    void addTimeToMessages (double deltaTime) noexcept;
+
+    /** Creates a MidiMessageSequence containing the same events and matched pairs. */
+    MidiMessageSequence createMidiMessageSequence() const;
+
+    /** Swaps this sequence with another one. */
+    void swapWith (FlatMidiSequence&) noexcept;
+
+private:
+    //==============================================================================
+    struct PackedMessage
+    {
+        uint32 data;    // the bytes of a message up to 3 bytes long, or an offset into longMessageData
+        uint32 size;
+    };
+
+    std::vector<double> timeStamps;
+    std::vector<PackedMessage> messages;
+    std::vector<int> noteOffIndices;
+    std::vector<uint8> longMessageData;
+    size_t numUnusedLongMessageBytes = 0;
+
+    PackedMessage pack (const uint8*, int);
+    void insertEvent (int, double, PackedMessage, int);
+    void removeEvent (int);
+    void compactLongMessageData();
+
+    JUCE_LEAK_DETECTOR (FlatMidiSequence)
+};
+
+} // namespace juce
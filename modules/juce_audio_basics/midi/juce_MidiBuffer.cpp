@@ -106,17 +106,68 @@ MidiBuffer::MidiBuffer (const MidiMessage& message) noexcept
     addEvent (message, 0);
 }
 
-void MidiBuffer::swapWith (MidiBuffer& other) noexcept      { data.swapWith (other.data); }
-void MidiBuffer::clear() noexcept                           { data.clearQuick(); }
+MidiBuffer::MidiBuffer (const MidiBuffer& other)
+    : fixedCapacity (other.fixedCapacity),
+      overflowed (other.overflowed)
+{
+    data.ensureStorageAllocated (jmax (other.data.size(), (int) fixedCapacity));
+    data.addArray (other.data);
+}
+
+MidiBuffer& MidiBuffer::operator= (const MidiBuffer& other)
+{
+    if (this != &other)
+    {
+        if (fixedCapacity == 0)
+        {
+            data = other.data;
+            overflowed = other.overflowed;
+        }
+        else
+        {
+            clear();
+            addEvents (other, 0, -1, 0);
+            overflowed = overflowed || other.overflowed;
+        }
+    }
+
+    return *this;
+}
+
+void MidiBuffer::swapWith (MidiBuffer& other) noexcept
+{
+    data.swapWith (other.data);
+    std::swap (fixedCapacity, other.fixedCapacity);
+    std::swap (overflowed, other.overflowed);
+}
+
+void MidiBuffer::clear() noexcept
+{
+    data.clearQuick();
+    overflowed = false;
+}
+
 void MidiBuffer::ensureSize (size_t minimumNumBytes)        { data.ensureStorageAllocated ((int) minimumNumBytes); }
 bool MidiBuffer::isEmpty() const noexcept                   { return data.size() == 0; }
 
+void MidiBuffer::setFixedCapacity (size_t numBytes)
+{
+    // The buffer already holds more data than this!
+    jassert ((size_t) data.size() <= numBytes || numBytes == 0);
+
+    fixedCapacity = numBytes;
+    ensureSize (numBytes);
+}
+
 void MidiBuffer::clear (int startSample, int numSamples)
 {
     auto start = MidiBufferHelpers::findEventAfter (data.begin(), data.end(), startSample - 1);
     auto end   = MidiBufferHelpers::findEventAfter (start,        data.end(), startSample + numSamples - 1);
 
-    data.removeRange ((int) (start - data.begin()), (int) (end - start));
+    if (fixedCapacity > 0)
+        data.removeRangeQuick ((int) (start - data.begin()), (int) (end - start));
+    else
+        data.removeRange ((int) (start - data.begin()), (int) (end - start));
 }
 
 bool MidiBuffer::addEvent (const MidiMessage& m, int sampleNumber)
@@ -138,6 +189,13 @@ bool MidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber)
     }
 
     auto newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
+
+    if (fixedCapacity > 0 && (size_t) data.size() + newItemSize > fixedCapacity)
+    {
+        overflowed = true;
+        return false;
+    }
+
     auto offset = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
 
     data.insertMultiple (offset, 0, (int) newItemSize);
@@ -310,6 +368,60 @@ struct MidiBufferTest final : public UnitTest
                 expectEquals (buffer.getNumEvents(), 1);
             }
         }
+
+        beginTest ("Fixed capacity");
+        {
+            const auto message = MidiMessage::noteOn (1, 64, 0.5f);
+            const auto eventSize = (size_t) message.getRawDataSize() + 6;
+
+            MidiBuffer buffer;
+            buffer.setFixedCapacity (3 * eventSize);
+            const auto* storage = buffer.data.begin();
+
+            expect (buffer.addEvent (message, 10));
+            expect (buffer.addEvent (message, 0));
+            expect (buffer.addEvent (message, 20));
+            expect (! buffer.hasOverflowed());
+
+            expect (! buffer.addEvent (message, 5));
+            expect (buffer.hasOverflowed());
+            expectEquals (buffer.getNumEvents(), 3);
+            expectEquals (buffer.getFirstEventTime(), 0);
+            expectEquals (buffer.getLastEventTime(), 20);
+
+            // Removing most of the events mustn't shrink the storage
+            buffer.clear (0, 15);
+            expectEquals (buffer.getNumEvents(), 1);
+            expect (buffer.addEvent (message, 1));
+            expect (buffer.addEvent (message, 2));
+            expect (buffer.data.begin() == storage);
+
+            buffer.clear();
+            expect (! buffer.hasOverflowed());
+            expect (buffer.data.begin() == storage);
+
+            MidiBuffer other;
+
+            for (int i = 0; i < 5; ++i)
+                other.addEvent (message, i);
+
+            buffer = other;
+            expect (buffer.data.begin() == storage);
+            expectEquals (buffer.getNumEvents(), 3);
+            expect (buffer.hasOverflowed());
+
+            auto copy = buffer;
+            expect (copy.getFixedCapacity() == buffer.getFixedCapacity());
+            expectEquals (copy.getNumEvents(), 3);
+
+            const auto* copyStorage = copy.data.begin();
+            copy.clear();
+
+            for (int i = 0; i < 3; ++i)
+                expect (copy.addEvent (message, i));
+
+            expect (copy.data.begin() == copyStorage);
+        }
     }
 };
 
@@ -151,6 +151,21 @@ public:
     /** Creates a MidiBuffer containing a single midi message. */
     explicit MidiBuffer (const MidiMessage& message) noexcept;
 
+    /** Creates a copy of another buffer.
+        If the other buffer has a fixed capacity, the copy will have the same capacity.
+    */
+    MidiBuffer (const MidiBuffer&);
+
+    /** Copies the events from another buffer into this one.
+
+        If this buffer has a fixed capacity, the events are copied into its existing
+        storage and any that don't fit are dropped, so this won't allocate.
+    */
+    MidiBuffer& operator= (const MidiBuffer&);
+
+    MidiBuffer (MidiBuffer&&) noexcept = default;
+    MidiBuffer& operator= (MidiBuffer&&) noexcept = default;
+
     //==============================================================================
     /** Removes all events from the buffer. */
     void clear() noexcept;
@@ -186,7 +201,8 @@ public:
 
         To retrieve events, use a MidiBufferIterator object.
 
-        Returns true on success, or false on failure.
+        Returns true on success, or false on failure, which includes the buffer having
+        a fixed capacity that's too full for the event.
     */
     bool addEvent (const MidiMessage& midiMessage, int sampleNumber);
 
@@ -206,7 +222,8 @@ public:
 
         To retrieve events, use a MidiBufferIterator object.
 
-        Returns true on success, or false on failure.
+        Returns true on success, or false on failure, which includes the buffer having
+        a fixed capacity that's too full for the event.
     */
     bool addEvent (const void* rawMidiData,
                    int maxBytesOfMidiData,
@@ -255,6 +272,31 @@ public:
     */
     void ensureSize (size_t minimumNumBytes);
 
+    /** Preallocates a fixed amount of memory and stops the buffer from ever reallocating it.
+
+        Once this has been called, none of the buffer's methods (apart from
+        setFixedCapacity() and ensureSize()) will allocate or free memory, so it's safe to
+        add events on the audio thread however many arrive. If an event won't fit in the
+        remaining space, it's dropped, addEvent() returns false, and hasOverflowed() will
+        return true until the buffer is next cleared.
+
+        The capacity is the total number of bytes of storage, including a 6-byte header
+        for each event. Passing 0 returns the buffer to its normal, growable behaviour.
+
+        @see hasOverflowed, getFixedCapacity
+    */
+    void setFixedCapacity (size_t numBytes);
+
+    /** Returns the capacity set with setFixedCapacity(), or 0 if the buffer can grow. */
+    size_t getFixedCapacity() const noexcept                { return fixedCapacity; }
+
+    /** Returns true if any events have been dropped because the buffer's fixed capacity
+        was full since clear() was last called.
+
+        @see setFixedCapacity
+    */
+    bool hasOverflowed() const noexcept                     { return overflowed; }
+
     /** Get a read-only iterator pointing to the beginning of this buffer. */
     MidiBufferIterator begin()  const noexcept { return cbegin(); }
 
@@ -339,6 +381,9 @@ public:
     Array<uint8> data;
 
 private:
+    size_t fixedCapacity = 0;
+    bool overflowed = false;
+
     JUCE_LEAK_DETECTOR (MidiBuffer)
 };
 
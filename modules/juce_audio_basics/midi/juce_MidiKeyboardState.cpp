@@ -25,15 +25,18 @@ namespace juce
 
 MidiKeyboardState::MidiKeyboardState()
 {
-    zerostruct (noteStates);
+    for (auto& state : noteStates)
+        state.store (0);
 }
 
 //==============================================================================
 void MidiKeyboardState::reset()
 {
-    const ScopedLock sl (lock);
-    zerostruct (noteStates);
-    eventsToAdd.clear();
+    for (auto& state : noteStates)
+        state.store (0);
+
+    // Any events that are still waiting will be skipped by processNextMidiBuffer()
+    ++resetCount;
 }
 
 bool MidiKeyboardState::isNoteOn (const int midiChannel, const int n) const noexcept
@@ -55,14 +58,9 @@ void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber,
     jassert (midiChannel > 0 && midiChannel <= 16);
     jassert (isPositiveAndBelow (midiNoteNumber, 128));
 
-    const ScopedLock sl (lock);
-
     if (isPositiveAndBelow (midiNoteNumber, 128))
     {
-        const int timeNow = (int) Time::getMillisecondCounter();
-        eventsToAdd.addEvent (MidiMessage::noteOn (midiChannel, midiNoteNumber, velocity), timeNow);
-        eventsToAdd.clear (0, timeNow - 500);
-
+        addPendingEvent (MidiMessage::noteOn (midiChannel, midiNoteNumber, velocity));
         noteOnInternal (midiChannel, midiNoteNumber, velocity);
     }
 }
@@ -71,38 +69,37 @@ void MidiKeyboardState::noteOnInternal  (const int midiChannel, const int midiNo
 {
     if (isPositiveAndBelow (midiNoteNumber, 128))
     {
-        noteStates[midiNoteNumber] = static_cast<uint16> (noteStates[midiNoteNumber] | (1 << (midiChannel - 1)));
+        noteStates[midiNoteNumber].fetch_or (static_cast<uint16> (1 << (midiChannel - 1)));
         listeners.call ([&] (Listener& l) { l.handleNoteOn (this, midiChannel, midiNoteNumber, velocity); });
     }
 }
 
 void MidiKeyboardState::noteOff (const int midiChannel, const int midiNoteNumber, const float velocity)
 {
-    const ScopedLock sl (lock);
-
-    if (isNoteOn (midiChannel, midiNoteNumber))
-    {
-        const int timeNow = (int) Time::getMillisecondCounter();
-        eventsToAdd.addEvent (MidiMessage::noteOff (midiChannel, midiNoteNumber), timeNow);
-        eventsToAdd.clear (0, timeNow - 500);
+    jassert (midiChannel > 0 && midiChannel <= 16);
 
-        noteOffInternal (midiChannel, midiNoteNumber, velocity);
-    }
+    if (noteOffInternal (midiChannel, midiNoteNumber, velocity))
+        addPendingEvent (MidiMessage::noteOff (midiChannel, midiNoteNumber));
 }
 
-void MidiKeyboardState::noteOffInternal  (const int midiChannel, const int midiNoteNumber, const float velocity)
+bool MidiKeyboardState::noteOffInternal  (const int midiChannel, const int midiNoteNumber, const float velocity)
 {
-    if (isNoteOn (midiChannel, midiNoteNumber))
-    {
-        noteStates[midiNoteNumber] = static_cast<uint16> (noteStates[midiNoteNumber] & ~(1 << (midiChannel - 1)));
-        listeners.call ([&] (Listener& l) { l.handleNoteOff (this, midiChannel, midiNoteNumber, velocity); });
-    }
+    if (! isPositiveAndBelow (midiNoteNumber, 128))
+        return false;
+
+    // Clearing the bit and checking whether it was set in one step means that only one
+    // thread can turn off a note, even if several try at once
+    const auto bit = static_cast<uint16> (1 << (midiChannel - 1));
+
+    if ((noteStates[midiNoteNumber].fetch_and (static_cast<uint16> (~bit)) & bit) == 0)
+        return false;
+
+    listeners.call ([&] (Listener& l) { l.handleNoteOff (this, midiChannel, midiNoteNumber, velocity); });
+    return true;
 }
 
 void MidiKeyboardState::allNotesOff (const int midiChannel)
 {
-    const ScopedLock sl (lock);
-
     if (midiChannel <= 0)
     {
         for (int i = 1; i <= 16; ++i)
@@ -115,6 +112,21 @@ void MidiKeyboardState::allNotesOff (const int midiChannel)
     }
 }
 
+void MidiKeyboardState::addPendingEvent (const MidiMessage& message)
+{
+    const SpinLock::ScopedLockType sl (pendingEventsWriteLock);
+
+    // If nothing is calling processNextMidiBuffer() the FIFO can fill up, in which case
+    // the new event is dropped, just as it would eventually have been dropped for being
+    // too old
+    const auto scope = pendingEventsFifo.write (1);
+
+    scope.forEach ([&] (int index)
+    {
+        pendingEvents[(size_t) index] = { message, (int) Time::getMillisecondCounter(), resetCount.load() };
+    });
+}
+
 void MidiKeyboardState::processNextMidiEvent (const MidiMessage& message)
 {
     if (message.isNoteOn())
@@ -137,36 +149,67 @@ void MidiKeyboardState::processNextMidiBuffer (MidiBuffer& buffer,
                                                const int numSamples,
                                                const bool injectIndirectEvents)
 {
-    const ScopedLock sl (lock);
-
     for (const auto metadata : buffer)
         processNextMidiEvent (metadata.getMessage());
 
-    if (injectIndirectEvents)
+    const auto scope = pendingEventsFifo.read (pendingEventsFifo.getNumReady());
+
+    if (! injectIndirectEvents || scope.blockSize1 + scope.blockSize2 == 0)
+        return;
+
+    // Events from before the last reset are skipped, as are any that are more than
+    // 500ms older than the newest event
+    const auto currentResetCount = resetCount.load();
+    std::optional<int> lastEventTime;
+
+    scope.forEach ([&] (int index)
+    {
+        const auto& event = pendingEvents[(size_t) index];
+
+        if (event.resetCount == currentResetCount)
+            lastEventTime = event.timeMs;
+    });
+
+    if (! lastEventTime.has_value())
+        return;
+
+    const auto isEventWanted = [&] (const PendingEvent& event)
     {
-        const int firstEventToAdd = eventsToAdd.getFirstEventTime();
-        const double scaleFactor = numSamples / (double) (eventsToAdd.getLastEventTime() + 1 - firstEventToAdd);
+        return event.resetCount == currentResetCount && *lastEventTime - event.timeMs <= 500;
+    };
 
-        for (const auto metadata : eventsToAdd)
+    std::optional<int> firstEventTime;
+
+    scope.forEach ([&] (int index)
+    {
+        const auto& event = pendingEvents[(size_t) index];
+
+        if (! firstEventTime.has_value() && isEventWanted (event))
+            firstEventTime = event.timeMs;
+    });
+
+    const double scaleFactor = numSamples / (double) (*lastEventTime + 1 - *firstEventTime);
+
+    scope.forEach ([&] (int index)
+    {
+        const auto& event = pendingEvents[(size_t) index];
+
+        if (isEventWanted (event))
         {
-            const auto pos = jlimit (0, numSamples - 1, roundToInt ((metadata.samplePosition - firstEventToAdd) * scaleFactor));
-            buffer.addEvent (metadata.getMessage(), startSample + pos);
+            const auto pos = jlimit (0, numSamples - 1, roundToInt ((event.timeMs - *firstEventTime) * scaleFactor));
+            buffer.addEvent (event.message, startSample + pos);
         }
-    }
-
-    eventsToAdd.clear();
+    });
 }
 
 //==============================================================================
 void MidiKeyboardState::addListener (Listener* listener)
 {
-    const ScopedLock sl (lock);
     listeners.add (listener);
 }
 
 void MidiKeyboardState::removeListener (Listener* listener)
 {
-    const ScopedLock sl (lock);
     listeners.remove (listener);
 }
 
@@ -36,6 +36,13 @@ namespace juce
     methods, and midi messages for these events will be merged into the
     midi stream that gets processed by processNextMidiBuffer().
 
+    Notes can be played from any thread: the key states are atomic, and the events from
+    noteOn() and noteOff() are passed to processNextMidiBuffer() through a lock-free FIFO.
+    Each key event does briefly take the listener list's lock to get a snapshot of the
+    listeners, so the audio thread may have to wait while another thread adds or removes
+    a listener, or takes a snapshot of its own. That lock is never held while the
+    listeners are being called.
+
     @tags{Audio}
 */
 class JUCE_API  MidiKeyboardState
@@ -149,7 +156,9 @@ public:
             when a note is being played with its MidiKeyboardState::noteOn() method.
 
             Note that this callback could happen from an audio callback thread, so be
-            careful not to block, and avoid any UI activity in the callback.
+            careful not to block, and avoid any UI activity in the callback. It may also
+            happen on several threads at once, for example if notes are being played on
+            the GUI while the audio thread is processing a buffer.
         */
         virtual void handleNoteOn (MidiKeyboardState* source,
                                    int midiChannel, int midiNoteNumber, float velocity) = 0;
@@ -161,7 +170,9 @@ public:
             when a note is being played with its MidiKeyboardState::noteOff() method.
 
             Note that this callback could happen from an audio callback thread, so be
-            careful not to block, and avoid any UI activity in the callback.
+            careful not to block, and avoid any UI activity in the callback. It may also
+            happen on several threads at once, for example if notes are being played on
+            the GUI while the audio thread is processing a buffer.
         */
         virtual void handleNoteOff (MidiKeyboardState* source,
                                     int midiChannel, int midiNoteNumber, float velocity) = 0;
@@ -179,13 +190,29 @@ public:
 
 private:
     //==============================================================================
-    CriticalSection lock;
+    struct PendingEvent
+    {
+        MidiMessage message;
+        int timeMs = 0;
+        uint32 resetCount = 0;
+    };
+
+    static constexpr int maxPendingEvents = 512;
+
     std::atomic<uint16> noteStates[128];
-    MidiBuffer eventsToAdd;
-    ListenerList<Listener> listeners;
+    std::atomic<uint32> resetCount { 0 };
+
+    // The events from noteOn() and noteOff() wait here until processNextMidiBuffer() reads
+    // them. Only the threads adding events share a lock, so the reader never waits.
+    AbstractFifo pendingEventsFifo { maxPendingEvents };
+    std::array<PendingEvent, maxPendingEvents> pendingEvents;
+    SpinLock pendingEventsWriteLock;
+
+    SnapshotListenerList<Listener> listeners;
 
+    void addPendingEvent (const MidiMessage& message);
     void noteOnInternal  (int midiChannel, int midiNoteNumber, float velocity);
-    void noteOffInternal (int midiChannel, int midiNoteNumber, float velocity);
+    bool noteOffInternal (int midiChannel, int midiNoteNumber, float velocity);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiKeyboardState)
 };
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct MidiKeyboardStateTests final : public UnitTest
+{
+    MidiKeyboardStateTests()  : UnitTest ("MidiKeyboardState", UnitTestCategories::midi)  {}
+
+    struct CountingListener final : public MidiKeyboardState::Listener
+    {
+        void handleNoteOn  (MidiKeyboardState*, int, int, float) override   { ++numNoteOns; }
+        void handleNoteOff (MidiKeyboardState*, int, int, float) override   { ++numNoteOffs; }
+
+        std::atomic<int> numNoteOns { 0 }, numNoteOffs { 0 };
+    };
+
+    static int countNotes (const MidiBuffer& buffer, bool noteOns)
+    {
+        return (int) std::count_if (buffer.begin(), buffer.end(), [&] (const MidiMessageMetadata& m)
+        {
+            return noteOns ? m.getMessage().isNoteOn() : m.getMessage().isNoteOff();
+        });
+    }
+
+    void runTest() override
+    {
+        beginTest ("Played notes are injected into the next buffer");
+        {
+            MidiKeyboardState state;
+            CountingListener listener;
+            state.addListener (&listener);
+
+            state.noteOn (1, 60, 1.0f);
+            state.noteOn (2, 64, 0.5f);
+            state.noteOff (1, 60, 0.0f);
+            state.noteOff (1, 61, 0.0f);  // not playing, so this should be ignored
+
+            expect (! state.isNoteOn (1, 60));
+            expect (state.isNoteOn (2, 64));
+            expectEquals (listener.numNoteOns.load(), 2);
+            expectEquals (listener.numNoteOffs.load(), 1);
+
+            MidiBuffer buffer;
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+
+            expectEquals (countNotes (buffer, true), 2);
+            expectEquals (countNotes (buffer, false), 1);
+
+            for (const auto metadata : buffer)
+                expect (isPositiveAndBelow (metadata.samplePosition, 256));
+
+            buffer.clear();
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+            expect (buffer.isEmpty());
+
+            state.removeListener (&listener);
+        }
+
+        beginTest ("Resetting discards the notes that are waiting");
+        {
+            MidiKeyboardState state;
+            state.noteOn (1, 60, 1.0f);
+            state.reset();
+
+            expect (! state.isNoteOn (1, 60));
+
+            MidiBuffer buffer;
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+            expect (buffer.isEmpty());
+        }
+
+        beginTest ("Notes can be played while buffers are being processed");
+        {
+            MidiKeyboardState state;
+            CountingListener listener;
+            state.addListener (&listener);
+
+            constexpr int numNotes = 2000;
+            std::atomic<bool> finished { false };
+
+            std::thread player ([&]
+            {
+                for (int i = 0; i < numNotes; ++i)
+                {
+                    state.noteOn (1 + i % 16, i % 64, 1.0f);
+                    state.noteOff (1 + i % 16, i % 64, 0.0f);
+                }
+
+                finished = true;
+            });
+
+            MidiBuffer buffer;
+
+            while (! finished)
+            {
+                buffer.clear();
+                buffer.addEvent (MidiMessage::noteOn (1, 100, 1.0f), 0);
+                buffer.addEvent (MidiMessage::noteOff (1, 100), 1);
+                state.processNextMidiBuffer (buffer, 0, 64, true);
+            }
+
+            player.join();
+
+            for (int note = 0; note < 128; ++note)
+                expect (! state.isNoteOnForChannels (0xffff, note));
+
+            // Each note is only turned off once, however the two threads interleave
+            expectEquals (listener.numNoteOns.load(), listener.numNoteOffs.load());
+
+            state.removeListener (&listener);
+        }
+    }
+};
+
+static MidiKeyboardStateTests midiKeyboardStateTests;
+
+} // namespace juce
@@ -32,6 +32,8 @@
 #include "juce_UMPMidi1ToBytestreamTranslator.h"
 #include "juce_UMPMidi1ToMidi2DefaultTranslator.h"
 #include "juce_UMPConverters.h"
+#include "juce_UMPPacketBuffer.h"
+#include "juce_UMPBatchConversion.h"
 #include "juce_UMPDispatcher.h"
 #include "juce_UMPReceiver.h"
 
@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#ifndef DOXYGEN
+
+namespace juce::universal_midi_packets
+{
+
+/**
+    Converts whole blocks of messages between bytestream and Universal MIDI Packet formats.
+
+    The converters in juce_UMPConverters.h handle one message at a time, and
+    GenericUMPConverter checks which protocol to use for every message. These functions
+    choose the conversion once for the whole block, walk the packets in place, and append
+    the results straight to an output container. If the output has been given enough
+    storage up front (or a fixed capacity), none of them allocate, apart from when
+    sysex messages are reassembled.
+
+    @tags{Audio}
+*/
+struct BatchConversion
+{
+    /** Converts the messages in a MidiBuffer to packets using the given protocol, and adds
+        them to a PacketBuffer with the same sample positions.
+
+        The translator is only used for MIDI 2.0 output. Returns false if any packets
+        were dropped because the PacketBuffer's fixed capacity was full.
+    */
+    static bool toPackets (const MidiBuffer& source,
+                           PacketBuffer& dest,
+                           PacketProtocol protocol,
+                           Midi1ToMidi2DefaultTranslator& translator)
+    {
+        auto result = true;
+
+        const auto convertAll = [&] (auto&& convertPacket)
+        {
+            for (const auto metadata : source)
+            {
+                const auto addPacket = [&] (const View& packet)
+                {
+                    result = dest.add (packet, metadata.samplePosition) && result;
+                };
+
+                Conversion::toMidi1 (BytestreamMidiView (metadata), [&] (const View& midi1)
+                {
+                    convertPacket (midi1, addPacket);
+                });
+            }
+        };
+
+        if (protocol == PacketProtocol::MIDI_1_0)
+            convertAll ([] (const View& midi1, auto& addPacket) { addPacket (midi1); });
+        else
+            convertAll ([&] (const View& midi1, auto& addPacket) { translator.dispatch (midi1, addPacket); });
+
+        return result;
+    }
+
+    /** Converts the packets in a PacketBuffer to bytestream messages, and adds them to a
+        MidiBuffer with the same sample positions.
+
+        MIDI 2.0 packets are translated to MIDI 1.0 first.
+    */
+    static void toMidiBuffer (const PacketBuffer& source,
+                              MidiBuffer& dest,
+                              Midi1ToBytestreamTranslator& translator)
+    {
+        for (const auto p : source)
+            toBytestream (p.packet, p.samplePosition, dest, translator);
+    }
+
+    /** Converts a block of packets to bytestream messages, and adds them all to a
+        MidiBuffer at the same sample position.
+
+        The words must contain complete packets.
+    */
+    static void toMidiBuffer (Span<const uint32_t> source,
+                              int samplePosition,
+                              MidiBuffer& dest,
+                              Midi1ToBytestreamTranslator& translator)
+    {
+        forEachPacket (source, [&] (const View& packet)
+        {
+            toBytestream (packet, samplePosition, dest, translator);
+        });
+    }
+
+    /** Translates a block of MIDI 1.0 packets to MIDI 2.0, appending the results to `dest`.
+
+        Packets that aren't MIDI 1.0 channel voice messages are copied unchanged.
+        The words must contain complete packets.
+    */
+    static void toMidi2 (Span<const uint32_t> source,
+                         Packets& dest,
+                         Midi1ToMidi2DefaultTranslator& translator)
+    {
+        forEachPacket (source, [&] (const View& packet)
+        {
+            translator.dispatch (packet, [&] (const View& midi2) { dest.add (midi2); });
+        });
+    }
+
+    /** Translates a block of MIDI 2.0 packets to MIDI 1.0, appending the results to `dest`.
+
+        Packets that have no MIDI 1.0 equivalent are dropped, and packets that aren't
+        MIDI 2.0 channel voice messages are copied unchanged. The words must contain
+        complete packets.
+    */
+    static void toMidi1 (Span<const uint32_t> source, Packets& dest)
+    {
+        forEachPacket (source, [&] (const View& packet)
+        {
+            Conversion::midi2ToMidi1DefaultTranslation (packet, [&] (const View& midi1) { dest.add (midi1); });
+        });
+    }
+
+private:
+    template <typename Fn>
+    static void forEachPacket (Span<const uint32_t> source, Fn&& fn)
+    {
+        const auto* end = source.data() + source.size();
+
+        for (const auto* d = source.data(); d < end;)
+        {
+            const View packet (d);
+
+            // The source must only hold complete packets!
+            jassert (d + packet.size() <= end);
+
+            fn (packet);
+            d += packet.size();
+        }
+    }
+
+    static void toBytestream (const View& packet,
+                              int samplePosition,
+                              MidiBuffer& dest,
+                              Midi1ToBytestreamTranslator& translator)
+    {
+        Conversion::midi2ToMidi1DefaultTranslation (packet, [&] (const View& midi1)
+        {
+            translator.dispatch (midi1, (double) samplePosition, [&] (const BytestreamMidiView& message)
+            {
+                dest.addEvent (message.bytes.data(), (int) message.bytes.size(), samplePosition);
+            });
+        });
+    }
+};
+
+} // namespace juce::universal_midi_packets
+
+#endif
@@ -42,6 +42,9 @@ public:
 
         If the range ends part-way through a packet, the next call to `dispatch` will
         continue from that point in the packet (unless `reset` is called first).
+
+        Complete packets are passed to the callback as Views into the source range, so
+        only packets that are split across calls need to be copied.
     */
     template <typename PacketCallbackFunction>
     void dispatch (const uint32_t* begin,
@@ -49,16 +52,33 @@ public:
                    double timeStamp,
                    PacketCallbackFunction&& callback)
     {
-        std::for_each (begin, end, [&] (uint32_t word)
+        // First, finish any packet that was left incomplete by the previous call
+        while (currentPacketLen != 0 && begin != end)
         {
-            nextPacket[currentPacketLen++] = word;
+            nextPacket[currentPacketLen++] = *begin++;
 
             if (currentPacketLen == Utils::getNumWordsForMessageType (nextPacket.front()))
             {
                 callback (View (nextPacket.data()), timeStamp);
                 currentPacketLen = 0;
             }
-        });
+        }
+
+        while (begin != end)
+        {
+            const auto numWords = (size_t) Utils::getNumWordsForMessageType (*begin);
+            const auto numWordsLeft = (size_t) (end - begin);
+
+            if (numWordsLeft < numWords)
+            {
+                std::copy (begin, end, nextPacket.begin());
+                currentPacketLen = numWordsLeft;
+                return;
+            }
+
+            callback (View (begin), timeStamp);
+            begin += numWords;
+        }
     }
 
 private:
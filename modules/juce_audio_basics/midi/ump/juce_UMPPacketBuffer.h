@@ -0,0 +1,325 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#ifndef DOXYGEN
+
+namespace juce::universal_midi_packets
+{
+
+/**
+    Holds a sequence of Universal MIDI Packets with integer sample-position timestamps.
+
+    This is the UMP equivalent of MidiBuffer, so that MIDI 2.0 packets can be passed
+    through an audio callback without converting them to bytestream messages and back.
+    Each packet is stored as a 32-bit timestamp word followed by the packet's own words,
+    and the packets are kept sorted by timestamp.
+
+    Like MidiBuffer, the buffer can either grow as needed, or be given a fixed capacity,
+    in which case it never allocates, and any packets that don't fit are dropped and
+    reported by hasOverflowed().
+
+    @tags{Audio}
+*/
+class PacketBuffer
+{
+public:
+    /** A packet in the buffer, and its timestamp. */
+    struct TimestampedPacket
+    {
+        View packet;
+        int samplePosition = 0;
+    };
+
+    /** Iterates over the packets in a PacketBuffer. */
+    class ConstIterator
+    {
+    public:
+        ConstIterator() = default;
+
+        explicit ConstIterator (const uint32_t* ptr) noexcept : data (ptr) {}
+
+        using difference_type   = std::iterator_traits<const uint32_t*>::difference_type;
+        using value_type        = TimestampedPacket;
+        using reference         = TimestampedPacket;
+        using pointer           = void;
+        using iterator_category = std::input_iterator_tag;
+
+        ConstIterator& operator++() noexcept
+        {
+            data += 1 + View (data + 1).size();
+            return *this;
+        }
+
+        ConstIterator operator++ (int) noexcept
+        {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        bool operator== (const ConstIterator& other) const noexcept { return data == other.data; }
+        bool operator!= (const ConstIterator& other) const noexcept { return ! operator== (other); }
+
+        TimestampedPacket operator*() const noexcept   { return { View (data + 1), (int) *data }; }
+
+    private:
+        const uint32_t* data = nullptr;
+    };
+
+    //==============================================================================
+    /** Creates an empty, growable buffer. */
+    PacketBuffer() = default;
+
+    /** Creates an empty buffer with a fixed capacity.
+        @see setFixedCapacity
+    */
+    explicit PacketBuffer (size_t fixedCapacityInWords)
+    {
+        setFixedCapacity (fixedCapacityInWords);
+    }
+
+    /** Creates a copy of another buffer, with the same fixed capacity, if it has one. */
+    PacketBuffer (const PacketBuffer& other)
+        : fixedCapacity (other.fixedCapacity),
+          lastSamplePosition (other.lastSamplePosition),
+          overflowed (other.overflowed)
+    {
+        storage.reserve (jmax (fixedCapacity, other.storage.size()));
+        storage.insert (storage.end(), other.storage.begin(), other.storage.end());
+    }
+
+    /** Copies the packets from another buffer into this one.
+
+        If this buffer has a fixed capacity, the packets are copied into its existing
+        storage and any that don't fit are dropped, so this won't allocate.
+    */
+    PacketBuffer& operator= (const PacketBuffer& other)
+    {
+        if (this != &other)
+        {
+            if (fixedCapacity == 0)
+            {
+                storage = other.storage;
+                lastSamplePosition = other.lastSamplePosition;
+                overflowed = other.overflowed;
+            }
+            else
+            {
+                const auto wasOverflowed = other.overflowed;
+                clear();
+
+                for (const auto p : other)
+                    add (p.packet, p.samplePosition);
+
+                overflowed = overflowed || wasOverflowed;
+            }
+        }
+
+        return *this;
+    }
+
+    PacketBuffer (PacketBuffer&&) noexcept = default;
+    PacketBuffer& operator= (PacketBuffer&&) noexcept = default;
+
+    //==============================================================================
+    /** Adds a packet to the buffer.
+
+        The packet is placed after any existing packets with the same sample position.
+        Returns false if the buffer has a fixed capacity and the packet doesn't fit.
+    */
+    bool add (const View& packet, int samplePosition)
+    {
+        const auto numWords = (size_t) packet.size();
+
+        if (fixedCapacity > 0 && storage.size() + 1 + numWords > fixedCapacity)
+        {
+            overflowed = true;
+            return false;
+        }
+
+        auto insertPoint = storage.end();
+
+        if (! storage.empty() && samplePosition < lastSamplePosition)
+            insertPoint = storage.begin() + (findEventAfter (samplePosition) - storage.data());
+        else
+            lastSamplePosition = samplePosition;
+
+        uint32_t words[5] { (uint32_t) samplePosition };
+        std::copy (packet.begin(), packet.end(), words + 1);
+        storage.insert (insertPoint, words, words + 1 + numWords);
+        return true;
+    }
+
+    /** Adds a packet to the buffer.
+        Returns false if the buffer has a fixed capacity and the packet doesn't fit.
+    */
+    template <size_t numWords>
+    bool add (const Packet<numWords>& packet, int samplePosition)
+    {
+        return add (View (packet.data()), samplePosition);
+    }
+
+    /** Removes all the packets from the buffer, without freeing its storage. */
+    void clear() noexcept
+    {
+        storage.clear();
+        overflowed = false;
+    }
+
+    /** Removes all packets for which (start <= sample position < start + numSamples). */
+    void clear (int startSample, int numSamples)
+    {
+        const auto* start = findEventAfter (startSample - 1);
+        const auto* end = findEventAfter (startSample + numSamples - 1);
+        const auto first = storage.begin() + (start - storage.data());
+
+        storage.erase (first, first + (end - start));
+        lastSamplePosition = getLastEventTime();
+    }
+
+    /** Returns true if the buffer is empty. */
+    bool isEmpty() const noexcept                   { return storage.empty(); }
+
+    /** Counts the number of packets in the buffer. */
+    int getNumPackets() const noexcept              { return (int) std::distance (begin(), end()); }
+
+    /** Returns the sample position of the first packet, or 0 if the buffer is empty. */
+    int getFirstEventTime() const noexcept          { return storage.empty() ? 0 : (int) storage.front(); }
+
+    /** Returns the sample position of the last packet, or 0 if the buffer is empty. */
+    int getLastEventTime() const noexcept
+    {
+        auto result = 0;
+
+        for (const auto p : *this)
+            result = p.samplePosition;
+
+        return result;
+    }
+
+    //==============================================================================
+    /** Preallocates a fixed amount of storage, and stops the buffer from ever reallocating it.
+
+        The capacity is a number of 32-bit words, and each packet uses one more word than
+        its own size, for its timestamp. Passing 0 returns the buffer to its normal,
+        growable behaviour.
+
+        @see MidiBuffer::setFixedCapacity, hasOverflowed
+    */
+    void setFixedCapacity (size_t numWords)
+    {
+        // The buffer already holds more data than this!
+        jassert (storage.size() <= numWords || numWords == 0);
+
+        fixedCapacity = numWords;
+        storage.reserve (numWords);
+    }
+
+    /** Returns the capacity set with setFixedCapacity(), or 0 if the buffer can grow. */
+    size_t getFixedCapacity() const noexcept        { return fixedCapacity; }
+
+    /** Returns true if any packets have been dropped because the buffer's fixed capacity
+        was full since clear() was last called.
+    */
+    bool hasOverflowed() const noexcept             { return overflowed; }
+
+    /** Pre-allocates space for at least `numWords` 32-bit words. */
+    void reserve (size_t numWords)                  { storage.reserve (numWords); }
+
+    //==============================================================================
+    ConstIterator begin() const noexcept            { return cbegin(); }
+    ConstIterator end() const noexcept              { return cend(); }
+    ConstIterator cbegin() const noexcept           { return ConstIterator (storage.data()); }
+    ConstIterator cend() const noexcept             { return ConstIterator (storage.data() + storage.size()); }
+
+    /** Returns an iterator pointing to the first packet at or after a sample position. */
+    ConstIterator findNextSamplePosition (int samplePosition) const noexcept
+    {
+        return ConstIterator (findEventAfter (samplePosition - 1));
+    }
+
+    //==============================================================================
+    /** Converts the bytestream messages in a MidiBuffer to packets, and adds them to this buffer.
+
+        The converter determines the protocol of the new packets. Returns false if any
+        packets were dropped because the buffer's fixed capacity was full.
+    */
+    bool addEvents (const MidiBuffer& buffer, GenericUMPConverter& converter)
+    {
+        auto result = true;
+
+        for (const auto metadata : buffer)
+        {
+            converter.convert (BytestreamMidiView (metadata), [&] (const View& packet)
+            {
+                result = add (packet, metadata.samplePosition) && result;
+            });
+        }
+
+        return result;
+    }
+
+    /** Converts the packets in this buffer to bytestream messages, and adds them to a MidiBuffer.
+
+        MIDI 2.0 packets are translated to MIDI 1.0 first, and sysex packets are combined
+        into complete sysex messages, which may allocate.
+    */
+    void addToMidiBuffer (MidiBuffer& dest, ToBytestreamConverter& converter) const
+    {
+        for (const auto p : *this)
+        {
+            converter.convert (p.packet, (double) p.samplePosition, [&] (const BytestreamMidiView& message)
+            {
+                dest.addEvent (message.bytes.data(), (int) message.bytes.size(), p.samplePosition);
+            });
+        }
+    }
+
+    //==============================================================================
+    /** Returns the raw storage, in which each packet is preceded by its timestamp. */
+    const uint32_t* data() const noexcept           { return storage.data(); }
+
+    /** Returns the number of words of raw storage in use. */
+    size_t size() const noexcept                    { return storage.size(); }
+
+private:
+    const uint32_t* findEventAfter (int samplePosition) const noexcept
+    {
+        const auto* d = storage.data();
+        const auto* endData = d + storage.size();
+
+        while (d < endData && (int) *d <= samplePosition)
+            d += 1 + View (d + 1).size();
+
+        return d;
+    }
+
+    std::vector<uint32_t> storage;
+    size_t fixedCapacity = 0;
+    int lastSamplePosition = 0;
+    bool overflowed = false;
+};
+
+} // namespace juce::universal_midi_packets
+
+#endif
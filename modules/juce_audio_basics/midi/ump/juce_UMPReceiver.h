@@ -36,6 +36,18 @@ struct Receiver
 
     /** This will be called each time a new packet is ready for processing. */
     virtual void packetReceived (const View& packet, double time) = 0;
+
+    /** Some inputs deliver all the packets that arrive together in a single call to this
+        method, rather than one call to packetReceived() for each packet.
+
+        The default implementation just calls packetReceived() for each of them, so you
+        only need to override this if you can handle a whole block of packets more
+        efficiently.
+    */
+    virtual void packetsReceived (Iterator begin, Iterator end, double time)
+    {
+        std::for_each (begin, end, [&] (const View& packet) { packetReceived (packet, time); });
+    }
 };
 
 } // namespace juce::universal_midi_packets
@@ -863,6 +863,194 @@ public:
 
             checkMidi1ToMidi2Conversion (midi1, midi2);
         }
+
+        beginTest ("PacketBuffer keeps packets sorted and respects its fixed capacity");
+        {
+            const auto noteOn = Factory::makeNoteOnV2 (0, 0, 60, Factory::NoteAttributeKind::none, 0x8000, 0);
+            const auto clock = Factory::makeTimingClock (0);
+
+            PacketBuffer buffer;
+            expect (buffer.add (noteOn, 10));
+            expect (buffer.add (clock, 0));
+            expect (buffer.add (noteOn, 10));
+            expect (buffer.add (clock, 5));
+            expectEquals (buffer.getNumPackets(), 4);
+            expectEquals (buffer.getFirstEventTime(), 0);
+            expectEquals (buffer.getLastEventTime(), 10);
+
+            std::vector<int> times;
+
+            for (const auto p : buffer)
+                times.push_back (p.samplePosition);
+
+            expect (times == std::vector<int> { 0, 5, 10, 10 });
+            expectEquals ((*buffer.findNextSamplePosition (6)).samplePosition, 10);
+            expect ((*buffer.findNextSamplePosition (6)).packet.size() == 2);
+
+            buffer.clear (1, 5);
+            expectEquals (buffer.getNumPackets(), 3);
+
+            PacketBuffer fixed (7);
+            const auto* storage = fixed.data();
+            expect (fixed.add (noteOn, 0));
+            expect (fixed.add (noteOn, 1));
+            expect (! fixed.add (clock, 2));
+            expect (fixed.hasOverflowed());
+
+            fixed = buffer;
+            expect (fixed.data() == storage);
+            expectEquals (fixed.getNumPackets(), 2);
+            expect (fixed.hasOverflowed());
+
+            fixed.clear();
+            expect (! fixed.hasOverflowed());
+            expect (fixed.add (clock, 3));
+            expect (fixed.data() == storage);
+        }
+
+        beginTest ("PacketBuffer converts to and from MidiBuffer");
+        {
+            MidiBuffer midi;
+
+            forEachNonSysExTestMessage (random, [&] (const MidiMessage& m)
+            {
+                midi.addEvent (m, random.nextInt (1000));
+            });
+
+            const uint8_t sysex[] { 0xf0, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xf7 };
+            midi.addEvent (sysex, (int) std::size (sysex), 500);
+
+            PacketBuffer buffer;
+            GenericUMPConverter toUMP (PacketProtocol::MIDI_1_0);
+            expect (buffer.addEvents (midi, toUMP));
+            expect (buffer.getNumPackets() > midi.getNumEvents());
+
+            MidiBuffer roundTripped;
+            ToBytestreamConverter toBytestream (1024);
+            buffer.addToMidiBuffer (roundTripped, toBytestream);
+
+            expect (equal (midi, roundTripped));
+        }
+
+        beginTest ("Dispatcher produces the same packets however the input is split");
+        {
+            Packets source;
+
+            forEachNonSysExTestMessage (random, [&] (const MidiMessage& m)
+            {
+                Conversion::toMidi1 (BytestreamMidiView (&m), [&] (const View& v)
+                {
+                    Midi1ToMidi2DefaultTranslator translator;
+                    translator.dispatch (v, [&] (const View& midi2) { source.add (midi2); });
+                    source.add (v);
+                });
+            });
+
+            for (int attempt = 0; attempt < 10; ++attempt)
+            {
+                Dispatcher dispatcher;
+                Packets dispatched;
+
+                for (size_t start = 0; start < source.size();)
+                {
+                    const auto num = jmin (source.size() - start, (size_t) random.nextInt ({ 1, 8 }));
+
+                    dispatcher.dispatch (source.data() + start, source.data() + start + num, 0.0, [&] (const View& v, double)
+                    {
+                        dispatched.add (v);
+                    });
+
+                    start += num;
+                }
+
+                expect (dispatched.size() == source.size()
+                        && std::equal (source.data(), source.data() + source.size(), dispatched.data()));
+            }
+        }
+
+        beginTest ("Batch conversions match per-message conversions");
+        {
+            MidiBuffer midi;
+
+            forEachNonSysExTestMessage (random, [&] (const MidiMessage& m)
+            {
+                midi.addEvent (m, random.nextInt (1000));
+            });
+
+            for (const auto protocol : { PacketProtocol::MIDI_1_0, PacketProtocol::MIDI_2_0 })
+            {
+                PacketBuffer expected;
+                GenericUMPConverter genericConverter (protocol);
+                expect (expected.addEvents (midi, genericConverter));
+
+                PacketBuffer actual;
+                Midi1ToMidi2DefaultTranslator translator;
+                expect (BatchConversion::toPackets (midi, actual, protocol, translator));
+
+                expect (actual.size() == expected.size()
+                        && std::equal (actual.data(), actual.data() + actual.size(), expected.data()));
+
+                MidiBuffer roundTripped;
+                Midi1ToBytestreamTranslator toBytestream (1024);
+                BatchConversion::toMidiBuffer (actual, roundTripped, toBytestream);
+
+                MidiBuffer expectedRoundTrip;
+                ToBytestreamConverter converterBack (1024);
+                expected.addToMidiBuffer (expectedRoundTrip, converterBack);
+
+                expect (equal (roundTripped, expectedRoundTrip));
+            }
+
+            Packets midi1, midi2;
+
+            for (const auto metadata : midi)
+                Conversion::toMidi1 (BytestreamMidiView (metadata), [&] (const View& v) { midi1.add (v); });
+
+            Midi1ToMidi2DefaultTranslator translator;
+            BatchConversion::toMidi2 (midi1, midi2, translator);
+
+            Packets expectedMidi2;
+            Midi1ToMidi2DefaultTranslator expectedTranslator;
+
+            for (const auto& v : midi1)
+                expectedTranslator.dispatch (v, [&] (const View& converted) { expectedMidi2.add (converted); });
+
+            expect (midi2.size() == expectedMidi2.size()
+                    && std::equal (midi2.data(), midi2.data() + midi2.size(), expectedMidi2.data()));
+
+            Packets backToMidi1;
+            BatchConversion::toMidi1 (midi2, backToMidi1);
+
+            Packets expectedMidi1;
+
+            for (const auto& v : midi2)
+                Conversion::midi2ToMidi1DefaultTranslation (v, [&] (const View& converted) { expectedMidi1.add (converted); });
+
+            expect (backToMidi1.size() == expectedMidi1.size()
+                    && std::equal (backToMidi1.data(), backToMidi1.data() + backToMidi1.size(), expectedMidi1.data()));
+
+            MidiBuffer fromSpan;
+            Midi1ToBytestreamTranslator toBytestream (1024);
+            BatchConversion::toMidiBuffer (midi1, 10, fromSpan, toBytestream);
+            expectEquals (fromSpan.getNumEvents(), midi.getNumEvents());
+        }
+
+        beginTest ("Receiver delivers blocks of packets to packetReceived by default");
+        {
+            struct CountingReceiver final : public Receiver
+            {
+                void packetReceived (const View&, double) override { ++numPackets; }
+                int numPackets = 0;
+            };
+
+            Packets block;
+            block.add (Factory::makeTimingClock (0));
+            block.add (Factory::makeNoteOnV2 (0, 0, 60, Factory::NoteAttributeKind::none, 0x8000, 0));
+
+            CountingReceiver receiver;
+            static_cast<Receiver&> (receiver).packetsReceived (block.begin(), block.end(), 0.0);
+            expectEquals (receiver.numPackets, 2);
+        }
     }
 
 private:
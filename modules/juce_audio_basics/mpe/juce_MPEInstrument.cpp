@@ -46,6 +46,14 @@ MPEInstrument::MPEInstrument() noexcept
     pressureDimension.value  = &MPENote::pressure;
     timbreDimension.value    = &MPENote::timbre;
 
+    pitchbendDimension.changedCallback = &Listener::notePitchbendChanged;
+    pressureDimension.changedCallback  = &Listener::notePressureChanged;
+    timbreDimension.changedCallback    = &Listener::noteTimbreChanged;
+
+    pitchbendDimension.changeFlag = 1;
+    pressureDimension.changeFlag  = 2;
+    timbreDimension.changeFlag    = 4;
+
     resetLastReceivedValues();
 
     legacyMode.channelRange = allChannels;
@@ -263,6 +271,9 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
     // in MPE mode, "reset all controllers" is per-zone and expected on the master channel;
     // in legacy mode, it is per MIDI channel (within the channel range used).
 
+    const ScopedLock sl (lock);
+    sendPendingDimensionChanges();
+
     if (legacyMode.isEnabled && legacyMode.channelRange.contains (message.getChannel()))
     {
         for (int i = notes.size(); --i >= 0;)
@@ -274,7 +285,7 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
         }
     }
@@ -292,7 +303,7 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
         }
     }
@@ -351,6 +362,7 @@ void MPEInstrument::noteOn (int midiChannel,
                      isMemberChannelSustained[midiChannel - 1] ? MPENote::keyDownAndSustained : MPENote::keyDown);
 
     const ScopedLock sl (lock);
+    sendPendingDimensionChanges();
     updateNoteTotalPitchbend (newNote);
 
     if (auto* alreadyPlayingNote = getNotePtr (midiChannel, midiNoteNumber))
@@ -359,10 +371,10 @@ void MPEInstrument::noteOn (int midiChannel,
         alreadyPlayingNote->keyState = MPENote::off;
         alreadyPlayingNote->noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
         listeners.call ([=] (Listener& l) { l.noteReleased (*alreadyPlayingNote); });
-        notes.remove (alreadyPlayingNote);
+        removeNote ((int) (alreadyPlayingNote - notes.begin()));
     }
 
-    notes.add (newNote);
+    addNote (newNote);
     listeners.call ([&] (Listener& l) { l.noteAdded (newNote); });
 }
 
@@ -372,6 +384,7 @@ void MPEInstrument::noteOff (int midiChannel,
                              MPEValue midiNoteOffVelocity)
 {
     const ScopedLock sl (lock);
+    sendPendingDimensionChanges();
 
     if (notes.isEmpty() || ! isUsingChannel (midiChannel))
         return;
@@ -392,7 +405,7 @@ void MPEInstrument::noteOff (int midiChannel,
         if (note->keyState == MPENote::off)
         {
             listeners.call ([=] (Listener& l) { l.noteReleased (*note); });
-            notes.remove (note);
+            removeNote ((int) (note - notes.begin()));
         }
         else
         {
@@ -424,16 +437,12 @@ void MPEInstrument::polyAftertouch (int midiChannel, int midiNoteNumber, MPEValu
 {
     const ScopedLock sl (lock);
 
-    for (int i = notes.size(); --i >= 0;)
+    if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
     {
-        auto& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel
-            && note.initialNote == midiNoteNumber
-            && pressureDimension.getValue (note) != value)
+        if (pressureDimension.getValue (*note) != value)
         {
-            pressureDimension.getValue (note) = value;
-            callListenersDimensionChanged (note, pressureDimension);
+            pressureDimension.getValue (*note) = value;
+            callListenersDimensionChanged (*note, pressureDimension);
         }
     }
 }
@@ -458,13 +467,8 @@ void MPEInstrument::updateDimension (int midiChannel, MPEDimension& dimension, M
     {
         if (dimension.trackingMode == allNotesOnChannel)
         {
-            for (int i = notes.size(); --i >= 0;)
-            {
-                auto& note = notes.getReference (i);
-
-                if (note.midiChannel == midiChannel)
-                    updateDimensionForNote (note, dimension, value);
-            }
+            for (int i = getNumNotesOnChannel (midiChannel); --i >= 0;)
+                updateDimensionForNote (getNoteOnChannel (midiChannel, i), dimension, value);
         }
         else
         {
@@ -499,7 +503,7 @@ void MPEInstrument::updateDimensionMaster (bool isLowerZone, MPEDimension& dimen
             // master pitchbend is a special case: we don't change the note's own pitchbend,
             // instead we have to update its total (master + note) pitchbend.
             updateNoteTotalPitchbend (note);
-            listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); });
+            callListenersDimensionChanged (note, pitchbendDimension);
         }
         else if (dimension.getValue (note) != value)
         {
@@ -526,9 +530,58 @@ void MPEInstrument::updateDimensionForNote (MPENote& note, MPEDimension& dimensi
 //==============================================================================
 void MPEInstrument::callListenersDimensionChanged (const MPENote& note, const MPEDimension& dimension)
 {
-    if (&dimension == &pressureDimension)  { listeners.call ([&] (Listener& l) { l.notePressureChanged  (note); }); return; }
-    if (&dimension == &timbreDimension)    { listeners.call ([&] (Listener& l) { l.noteTimbreChanged    (note); }); return; }
-    if (&dimension == &pitchbendDimension) { listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); }); return; }
+    if (dimensionUpdateBatchDepth > 0)
+    {
+        if (auto* slot = getNoteSlot (note.midiChannel, note.initialNote))
+        {
+            slot->pendingDimensionChanges |= dimension.changeFlag;
+            hasPendingDimensionChanges = true;
+        }
+
+        return;
+    }
+
+    listeners.call (dimension.changedCallback, note);
+}
+
+void MPEInstrument::sendPendingDimensionChanges()
+{
+    if (! hasPendingDimensionChanges)
+        return;
+
+    hasPendingDimensionChanges = false;
+
+    for (int i = 0; i < notes.size(); ++i)
+    {
+        const auto note = notes.getReference (i);
+        auto* slot = getNoteSlot (note.midiChannel, note.initialNote);
+
+        if (slot == nullptr || slot->pendingDimensionChanges == 0)
+            continue;
+
+        const auto changes = std::exchange (slot->pendingDimensionChanges, (uint8) 0);
+
+        for (auto* dimension : { &pitchbendDimension, &pressureDimension, &timbreDimension })
+            if ((changes & dimension->changeFlag) != 0)
+                listeners.call (dimension->changedCallback, note);
+    }
+}
+
+void MPEInstrument::beginDimensionUpdateBatch()
+{
+    const ScopedLock sl (lock);
+    ++dimensionUpdateBatchDepth;
+}
+
+void MPEInstrument::endDimensionUpdateBatch()
+{
+    const ScopedLock sl (lock);
+
+    // Each call to endDimensionUpdateBatch() must match a call to beginDimensionUpdateBatch()!
+    jassert (dimensionUpdateBatchDepth > 0);
+
+    if (dimensionUpdateBatchDepth > 0 && --dimensionUpdateBatchDepth == 0)
+        sendPendingDimensionChanges();
 }
 
 //==============================================================================
@@ -593,6 +646,8 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
     if (legacyMode.isEnabled ? (! legacyMode.channelRange.contains (midiChannel)) : (! isMasterChannel (midiChannel)))
         return;
 
+    sendPendingDimensionChanges();
+
     auto zone = (midiChannel == 1 ? zoneLayout.getLowerZone()
                                   : zoneLayout.getUpperZone());
 
@@ -612,7 +667,7 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
             if (note.keyState == MPENote::off)
             {
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
             else
             {
@@ -727,13 +782,9 @@ MPENote MPEInstrument::getMostRecentNoteOtherThan (MPENote otherThanThisNote) co
 //==============================================================================
 const MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) const noexcept
 {
-    for (int i = 0; i < notes.size(); ++i)
-    {
-        auto& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel && note.initialNote == midiNoteNumber)
-            return &note;
-    }
+    if (auto* slot = getNoteSlot (midiChannel, midiNoteNumber))
+        if (slot->index >= 0)
+            return &notes.getReference (slot->index);
 
     return nullptr;
 }
@@ -767,12 +818,11 @@ const MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) const noexc
 {
     const ScopedLock sl (lock);
 
-    for (auto i = notes.size(); --i >= 0;)
+    for (auto i = getNumNotesOnChannel (midiChannel); --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = getNoteOnChannel (midiChannel, i);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
+        if (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
             return &note;
     }
 
@@ -790,12 +840,11 @@ const MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) const noexcept
     int initialNoteMax = -1;
     const MPENote* result = nullptr;
 
-    for (auto i = notes.size(); --i >= 0;)
+    for (auto i = getNumNotesOnChannel (midiChannel); --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = getNoteOnChannel (midiChannel, i);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
              && note.initialNote > initialNoteMax)
         {
             result = &note;
@@ -816,12 +865,11 @@ const MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) const noexcept
     int initialNoteMin = 128;
     const MPENote* result = nullptr;
 
-    for (auto i = notes.size(); --i >= 0;)
+    for (auto i = getNumNotesOnChannel (midiChannel); --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = getNoteOnChannel (midiChannel, i);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
              && note.initialNote < initialNoteMin)
         {
             result = &note;
@@ -841,6 +889,7 @@ MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) noexcept
 void MPEInstrument::releaseAllNotes()
 {
     const ScopedLock sl (lock);
+    sendPendingDimensionChanges();
 
     for (auto i = notes.size(); --i >= 0;)
     {
@@ -851,6 +900,80 @@ void MPEInstrument::releaseAllNotes()
     }
 
     notes.clear();
+    updateNoteIndex();
+}
+
+//==============================================================================
+void MPEInstrument::addNote (const MPENote& note)
+{
+    notes.add (note);
+    updateNoteIndex();
+}
+
+void MPEInstrument::removeNote (int index)
+{
+    const auto& note = notes.getReference (index);
+
+    if (auto* slot = getNoteSlot (note.midiChannel, note.initialNote))
+        slot->pendingDimensionChanges = 0;
+
+    notes.remove (index);
+    updateNoteIndex();
+}
+
+void MPEInstrument::updateNoteIndex()
+{
+    for (int channel = 0; channel < 16; ++channel)
+    {
+        for (auto noteNumber : notesOnChannel[channel])
+            noteSlots[channel][noteNumber].index = -1;
+
+        notesOnChannel[channel].clearQuick();
+    }
+
+    for (int i = 0; i < notes.size(); ++i)
+    {
+        const auto& note = notes.getReference (i);
+
+        if (auto* slot = getNoteSlot (note.midiChannel, note.initialNote))
+        {
+            slot->index = (int16) i;
+            notesOnChannel[note.midiChannel - 1].add (note.initialNote);
+        }
+        else
+        {
+            jassertfalse; // the note has an invalid channel or note number!
+        }
+    }
+}
+
+const MPEInstrument::NoteSlot* MPEInstrument::getNoteSlot (int midiChannel, int midiNoteNumber) const noexcept
+{
+    if (isPositiveAndBelow (midiChannel - 1, 16) && isPositiveAndBelow (midiNoteNumber, 128))
+        return &noteSlots[midiChannel - 1][midiNoteNumber];
+
+    return nullptr;
+}
+
+MPEInstrument::NoteSlot* MPEInstrument::getNoteSlot (int midiChannel, int midiNoteNumber) noexcept
+{
+    return const_cast<NoteSlot*> (static_cast<const MPEInstrument&> (*this).getNoteSlot (midiChannel, midiNoteNumber));
+}
+
+int MPEInstrument::getNumNotesOnChannel (int midiChannel) const noexcept
+{
+    return isPositiveAndBelow (midiChannel - 1, 16) ? notesOnChannel[midiChannel - 1].size() : 0;
+}
+
+const MPENote& MPEInstrument::getNoteOnChannel (int midiChannel, int indexOnChannel) const noexcept
+{
+    const auto noteNumber = notesOnChannel[midiChannel - 1].getUnchecked (indexOnChannel);
+    return notes.getReference (noteSlots[midiChannel - 1][noteNumber].index);
+}
+
+MPENote& MPEInstrument::getNoteOnChannel (int midiChannel, int indexOnChannel) noexcept
+{
+    return const_cast<MPENote&> (static_cast<const MPEInstrument&> (*this).getNoteOnChannel (midiChannel, indexOnChannel));
 }
 
 //==============================================================================
@@ -2193,6 +2316,102 @@ public:
                 expectEquals (test.getNumPlayingNotes(), 0);
             }
         }
+
+        beginTest ("Notes are found by channel and note number");
+        {
+            MPEInstrument test;
+            test.enableLegacyMode();
+
+            Random random (0x5eed);
+
+            const auto isSameNote = [] (MPENote a, MPENote b)
+            {
+                return a.isValid() == b.isValid() && (! a.isValid() || a == b);
+            };
+
+            for (int i = 0; i < 500; ++i)
+            {
+                const auto channel = random.nextInt ({ 1, 17 });
+                const auto noteNumber = random.nextInt ({ 50, 60 });
+                const auto action = random.nextInt (10);
+
+                if (action < 5)       test.noteOn (channel, noteNumber, MPEValue::from7BitInt (100));
+                else if (action < 9)  test.noteOff (channel, noteNumber, MPEValue::from7BitInt (64));
+                else                  test.sustainPedal (channel, random.nextBool());
+
+                // compare against a search through all the notes
+                for (int c = 1; c <= 16; ++c)
+                {
+                    MPENote mostRecent;
+
+                    for (int n = 0; n < test.getNumPlayingNotes(); ++n)
+                    {
+                        const auto note = test.getNote (n);
+
+                        if (note.midiChannel == c && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
+                            mostRecent = note;
+                    }
+
+                    expect (isSameNote (test.getMostRecentNote (c), mostRecent));
+
+                    for (int n = 50; n < 60; ++n)
+                    {
+                        MPENote expected;
+
+                        for (int j = 0; j < test.getNumPlayingNotes(); ++j)
+                            if (test.getNote (j).midiChannel == c && test.getNote (j).initialNote == n)
+                                expected = test.getNote (j);
+
+                        expect (isSameNote (test.getNote (c, n), expected));
+                    }
+                }
+            }
+        }
+
+        beginTest ("Batched dimension updates");
+        {
+            UnitTestInstrument test;
+            test.setZoneLayout (testLayout);
+            test.noteOn (3, 60, MPEValue::from7BitInt (100));
+            test.noteOn (4, 62, MPEValue::from7BitInt (100));
+
+            test.beginDimensionUpdateBatch();
+
+            for (int i = 0; i < 10; ++i)
+            {
+                test.pitchbend (3, MPEValue::from14BitInt (1000 + i));
+                test.pressure (4, MPEValue::from7BitInt (10 + i));
+            }
+
+            // the notes change straight away, but the listeners aren't called yet
+            expectEquals (test.notePitchbendChangedCallCounter, 0);
+            expectEquals (test.notePressureChangedCallCounter, 0);
+            expectNote (test.getNote (3, 60), 100, 0, 1009, 64, MPENote::keyDown);
+            expectNote (test.getNote (4, 62), 100, 19, 8192, 64, MPENote::keyDown);
+
+            test.endDimensionUpdateBatch();
+            expectEquals (test.notePitchbendChangedCallCounter, 1);
+            expectEquals (test.notePressureChangedCallCounter, 1);
+
+            // a master pitchbend changes every note in the zone
+            test.beginDimensionUpdateBatch();
+            test.beginDimensionUpdateBatch();
+            test.pitchbend (1, MPEValue::from14BitInt (4000));
+            test.pitchbend (1, MPEValue::from14BitInt (5000));
+            test.endDimensionUpdateBatch();
+            expectEquals (test.notePitchbendChangedCallCounter, 1);
+            test.endDimensionUpdateBatch();
+            expectEquals (test.notePitchbendChangedCallCounter, 3);
+
+            // held-back changes are sent before the note is released
+            test.beginDimensionUpdateBatch();
+            test.timbre (3, MPEValue::from7BitInt (20));
+            test.noteOff (3, 60, MPEValue::from7BitInt (64));
+            expectEquals (test.noteTimbreChangedCallCounter, 1);
+            expectEquals (test.noteReleasedCallCounter, 1);
+            test.endDimensionUpdateBatch();
+            expectEquals (test.noteTimbreChangedCallCounter, 1);
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 
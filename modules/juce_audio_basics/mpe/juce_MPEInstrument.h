@@ -213,6 +213,31 @@ public:
     */
     void releaseAllNotes();
 
+    //==============================================================================
+    /** Starts collecting pressure, pitchbend and timbre changes instead of sending
+        them to the listeners straight away.
+
+        Notes are still updated immediately, but their notePressureChanged,
+        notePitchbendChanged and noteTimbreChanged callbacks are held back until
+        endDimensionUpdateBatch() is called. They're then made at most once per note
+        and dimension, with the latest values. This is useful when a controller sends
+        per-note expression much more often than it's actually used, e.g. when the
+        values are only read once per rendered block.
+
+        Any held-back changes are sent before a note is added or released or has its
+        key state changed, so each note's callbacks still arrive in the right order.
+        Batches can be nested, in which case the changes are sent when the outermost
+        batch ends.
+
+        @see endDimensionUpdateBatch
+    */
+    void beginDimensionUpdateBatch();
+
+    /** Ends a batch that was started with beginDimensionUpdateBatch(), calling the
+        listeners for any notes whose dimensions have changed.
+    */
+    void endDimensionUpdateBatch();
+
     //==============================================================================
     /** Returns the number of MPE notes currently played by the instrument. */
     int getNumPlayingNotes() const noexcept;
@@ -360,8 +385,21 @@ protected:
     CriticalSection lock;
 
 private:
+    //==============================================================================
+    // Finds a note in the notes array from its channel and initial note number, and holds
+    // any of its dimension changes that haven't been sent to the listeners yet
+    struct NoteSlot
+    {
+        int16 index = -1;
+        uint8 pendingDimensionChanges = 0;
+    };
+
     //==============================================================================
     Array<MPENote> notes;
+    NoteSlot noteSlots[16][128];
+    Array<uint8> notesOnChannel[16]; // the initial note numbers, in the same order as notes
+    int dimensionUpdateBatchDepth = 0;
+    bool hasPendingDimensionChanges = false;
     MPEZoneLayout zoneLayout;
     ListenerList<Listener> listeners;
 
@@ -381,6 +419,8 @@ private:
         TrackingMode trackingMode = lastNotePlayedOnChannel;
         MPEValue lastValueReceivedOnChannel[16];
         MPEValue MPENote::* value;
+        void (Listener::* changedCallback) (MPENote);
+        uint8 changeFlag;
         MPEValue& getValue (MPENote& note) noexcept   { return note.*(value); }
     };
 
@@ -393,6 +433,7 @@ private:
     void updateDimensionMaster (bool, MPEDimension&, MPEValue);
     void updateDimensionForNote (MPENote&, MPEDimension&, MPEValue);
     void callListenersDimensionChanged (const MPENote&, const MPEDimension&);
+    void sendPendingDimensionChanges();
     MPEValue getInitialValueForNewNote (int midiChannel, MPEDimension&) const;
 
     void processMidiNoteOnMessage (const MidiMessage&);
@@ -408,6 +449,15 @@ private:
     void handleTimbreLSB (int midiChannel, int value) noexcept;
     void handleSustainOrSostenuto (int midiChannel, bool isDown, bool isSostenuto);
 
+    void addNote (const MPENote&);
+    void removeNote (int index);
+    void updateNoteIndex();
+    const NoteSlot* getNoteSlot (int midiChannel, int midiNoteNumber) const noexcept;
+    NoteSlot* getNoteSlot (int midiChannel, int midiNoteNumber) noexcept;
+    int getNumNotesOnChannel (int midiChannel) const noexcept;
+    const MPENote& getNoteOnChannel (int midiChannel, int indexOnChannel) const noexcept;
+    MPENote& getNoteOnChannel (int midiChannel, int indexOnChannel) noexcept;
+
     const MPENote* getNotePtr (int midiChannel, int midiNoteNumber) const noexcept;
     MPENote* getNotePtr (int midiChannel, int midiNoteNumber) noexcept;
     const MPENote* getNotePtr (int midiChannel, TrackingMode) const noexcept;
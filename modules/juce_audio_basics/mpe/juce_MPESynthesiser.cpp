@@ -144,6 +144,18 @@ void MPESynthesiser::setCurrentPlaybackSampleRate (const double newRate)
         voices.getUnchecked (i)->setCurrentSampleRate (newRate);
 }
 
+void MPESynthesiser::setParallelVoiceRendering (RealtimeThreadPool* pool, int maximumNumChannels, int maximumBlockSize)
+{
+    const ScopedLock sl (voicesLock);
+    parallelRenderer.prepare (pool, maximumNumChannels, maximumBlockSize);
+    activeVoices.ensureStorageAllocated (voices.size());
+}
+
+bool MPESynthesiser::isRenderingVoicesInParallel() const noexcept
+{
+    return parallelRenderer.isPrepared();
+}
+
 void MPESynthesiser::handleMidiEvent (const MidiMessage& m)
 {
     if (m.isController())
@@ -264,6 +276,7 @@ void MPESynthesiser::addVoice (MPESynthesiserVoice* const newVoice)
         const ScopedLock sl (voicesLock);
         newVoice->setCurrentSampleRate (getSampleRate());
         voices.add (newVoice);
+        activeVoices.ensureStorageAllocated (voices.size());
     }
 
     {
@@ -327,10 +340,23 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
 }
 
 //==============================================================================
-void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
+template <typename floatType>
+void MPESynthesiser::renderActiveVoices (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
 {
     const ScopedLock sl (voicesLock);
 
+    if (parallelRenderer.isPrepared())
+    {
+        activeVoices.clearQuick();
+
+        for (auto* voice : voices)
+            if (voice->isActive())
+                activeVoices.add (voice);
+
+        if (parallelRenderer.renderVoices (activeVoices, buffer, startSample, numSamples))
+            return;
+    }
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -338,15 +364,14 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSa
     }
 }
 
-void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
+void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
-    const ScopedLock sl (voicesLock);
+    renderActiveVoices (buffer, startSample, numSamples);
+}
 
-    for (auto* voice : voices)
-    {
-        if (voice->isActive())
-            voice->renderNextBlock (buffer, startSample, numSamples);
-    }
+void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
+{
+    renderActiveVoices (buffer, startSample, numSamples);
 }
 
 } // namespace juce
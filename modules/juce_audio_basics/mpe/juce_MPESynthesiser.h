@@ -135,6 +135,35 @@ public:
     */
     void setCurrentPlaybackSampleRate (double newRate) override;
 
+    //==============================================================================
+    /** Enables rendering the voices in parallel, using the threads of a RealtimeThreadPool.
+
+        When this is enabled, the default implementation of renderNextSubBlock() will share the
+        active voices between the threads of the pool. Each thread renders its voices into a
+        scratch buffer, and the scratch buffers are then added to the output. The audio is still
+        split into sub-blocks at each midi event, so note timing is just as accurate as when
+        rendering serially.
+
+        The result may differ very slightly from serial rendering, because the samples are
+        summed in a different order, but for a given pool it will always be the same. Voices
+        will be asked to render from the start of the scratch buffer rather than at the start
+        sample of the output, and they'll be rendered concurrently, so they mustn't modify any
+        state that they share with other voices.
+
+        Blocks with more than maximumNumChannels channels or maximumBlockSize samples will be
+        rendered serially. Pass a nullptr pool to go back to serial rendering.
+
+        This allocates memory, so it should be called from somewhere like prepareToPlay() rather
+        than from the audio thread. The pool must remain valid until parallel rendering has been
+        disabled, or the synthesiser has been deleted.
+
+        @see ParallelVoiceRenderer
+    */
+    void setParallelVoiceRendering (RealtimeThreadPool* pool, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns true if setParallelVoiceRendering() has been called with a prepared pool. */
+    bool isRenderingVoicesInParallel() const noexcept;
+
     //==============================================================================
     /** Handle incoming MIDI events.
 
@@ -306,6 +335,11 @@ private:
     uint32 lastNoteOnCounter = 0;
     mutable CriticalSection stealLock;
     mutable Array<MPESynthesiserVoice*> usableVoicesToStealArray;
+    ParallelVoiceRenderer parallelRenderer;
+    Array<MPESynthesiserVoice*> activeVoices;
+
+    template <typename floatType>
+    void renderActiveVoices (AudioBuffer<floatType>&, int startSample, int numSamples);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiser)
 };
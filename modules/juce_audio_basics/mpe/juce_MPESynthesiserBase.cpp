@@ -113,6 +113,10 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
 
     auto prevSample = startSample;
     const auto endSample = startSample + numSamples;
+    const auto shouldBatch = batchDimensionUpdates;
+
+    if (shouldBatch)
+        instrument.beginDimensionUpdateBatch();
 
     for (auto it = inputMidi.findNextSamplePosition (startSample); it != inputMidi.cend(); ++it)
     {
@@ -126,6 +130,12 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
 
         if (metadata.samplePosition >= prevSample + thisBlockSize)
         {
+            if (shouldBatch)
+            {
+                instrument.endDimensionUpdateBatch();
+                instrument.beginDimensionUpdateBatch();
+            }
+
             renderNextSubBlock (outputAudio, prevSample, metadata.samplePosition - prevSample);
             prevSample = metadata.samplePosition;
         }
@@ -133,6 +143,9 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
         handleMidiEvent (metadata.getMessage());
     }
 
+    if (shouldBatch)
+        instrument.endDimensionUpdateBatch();
+
     if (prevSample < endSample)
         renderNextSubBlock (outputAudio, prevSample, endSample - prevSample);
 }
@@ -139,6 +139,24 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    /** Enables or disables batching of the pressure, pitchbend and timbre changes that
+        arrive between two rendered sub-blocks.
+
+        When this is enabled, all the MIDI events for a sub-block are handled inside a
+        batch (see MPEInstrument::beginDimensionUpdateBatch()), so each note only gets one
+        notePressureChanged(), notePitchbendChanged() or noteTimbreChanged() callback per
+        sub-block, with its latest value. This saves a lot of work with controllers that
+        send continuous per-note expression, and doesn't change what gets rendered as
+        long as your callbacks only need the note's current values. It's disabled by
+        default.
+    */
+    void setBatchesDimensionUpdates (bool shouldBatch) noexcept     { batchDimensionUpdates = shouldBatch; }
+
+    /** Returns true if dimension updates are being batched.
+        @see setBatchesDimensionUpdates
+    */
+    bool isBatchingDimensionUpdates() const noexcept                { return batchDimensionUpdates; }
+
     //==============================================================================
     /** Puts the synthesiser into legacy mode.
 
@@ -209,6 +227,7 @@ private:
     double sampleRate = 0.0;
     int minimumSubBlockSize = 32;
     bool subBlockSubdivisionIsStrict = false;
+    bool batchDimensionUpdates = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiserBase)
 };
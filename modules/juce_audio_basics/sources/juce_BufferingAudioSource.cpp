@@ -30,7 +30,25 @@ BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
                                             int numChannels,
                                             bool prefillBufferOnPrepareToPlay)
     : source (s, deleteSourceWhenDeleted),
-      backgroundThread (thread),
+      backgroundThread (&thread),
+      numberOfSamplesToBuffer (jmax (1024, bufferSizeSamples)),
+      numberOfChannels (numChannels),
+      prefillBuffer (prefillBufferOnPrepareToPlay)
+{
+    jassert (source != nullptr);
+
+    jassert (numberOfSamplesToBuffer > 1024); // not much point using this class if you're
+                                              //  not using a larger buffer..
+}
+
+BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
+                                            StreamingReadScheduler& schedulerToUse,
+                                            bool deleteSourceWhenDeleted,
+                                            int bufferSizeSamples,
+                                            int numChannels,
+                                            bool prefillBufferOnPrepareToPlay)
+    : source (s, deleteSourceWhenDeleted),
+      scheduler (&schedulerToUse),
       numberOfSamplesToBuffer (jmax (1024, bufferSizeSamples)),
       numberOfChannels (numChannels),
       prefillBuffer (prefillBufferOnPrepareToPlay)
@@ -51,11 +69,22 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
 {
     auto bufferSizeNeeded = jmax (samplesPerBlockExpected * 2, numberOfSamplesToBuffer);
 
+    if (scheduler != nullptr)
+    {
+        // The scheduler may not be able to give us all the memory we'd like
+        const auto bytesPerSample = sizeof (float) * (size_t) numberOfChannels;
+        const auto bytesGranted = scheduler->requestMemory (this,
+                                                            (size_t) bufferSizeNeeded * bytesPerSample,
+                                                            (size_t) jmax (1024, samplesPerBlockExpected * 2) * bytesPerSample);
+
+        bufferSizeNeeded = (int) (bytesGranted / bytesPerSample);
+    }
+
     if (! approximatelyEqual (newSampleRate, sampleRate)
          || bufferSizeNeeded != buffer.getNumSamples()
          || ! isPrepared)
     {
-        backgroundThread.removeTimeSliceClient (this);
+        stopBackgroundReading();
 
         isPrepared = true;
         sampleRate = newSampleRate;
@@ -65,18 +94,24 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
         buffer.setSize (numberOfChannels, bufferSizeNeeded);
         buffer.clear();
 
-        const ScopedLock sl (bufferRangeLock);
+        {
+            const ScopedLock sl (bufferRangeLock);
 
-        bufferValidStart = 0;
-        bufferValidEnd = 0;
+            bufferValidStart = 0;
+            bufferValidEnd = 0;
+        }
 
-        backgroundThread.addTimeSliceClient (this);
+        // A scheduler calls getSecondsUntilUnderrun() with its own lock held, so this mustn't
+        // be called while holding bufferRangeLock
+        startBackgroundReading();
+
+        const ScopedLock sl (bufferRangeLock);
 
         do
         {
             const ScopedUnlock ul (bufferRangeLock);
 
-            backgroundThread.moveToFrontOfQueue (this);
+            moveToFrontOfQueue();
             Thread::sleep (5);
         }
         while (prefillBuffer
@@ -87,7 +122,10 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
 void BufferingAudioSource::releaseResources()
 {
     isPrepared = false;
-    backgroundThread.removeTimeSliceClient (this);
+    stopBackgroundReading();
+
+    if (scheduler != nullptr)
+        scheduler->releaseMemory (this);
 
     buffer.setSize (numberOfChannels, 0);
 
@@ -215,7 +253,31 @@ void BufferingAudioSource::setNextReadPosition (int64 newPosition)
     const ScopedLock sl (bufferRangeLock);
 
     nextPlayPos = newPosition;
-    backgroundThread.moveToFrontOfQueue (this);
+    moveToFrontOfQueue();
+}
+
+void BufferingAudioSource::startBackgroundReading()
+{
+    if (scheduler != nullptr)
+        scheduler->addClient (this);
+    else
+        backgroundThread->addTimeSliceClient (this);
+}
+
+void BufferingAudioSource::stopBackgroundReading()
+{
+    if (scheduler != nullptr)
+        scheduler->removeClient (this);
+    else
+        backgroundThread->removeTimeSliceClient (this);
+}
+
+void BufferingAudioSource::moveToFrontOfQueue()
+{
+    if (scheduler != nullptr)
+        scheduler->notify();
+    else
+        backgroundThread->moveToFrontOfQueue (this);
 }
 
 Range<int> BufferingAudioSource::getValidBufferRange (int numSamples) const
@@ -228,7 +290,7 @@ Range<int> BufferingAudioSource::getValidBufferRange (int numSamples) const
              (int) (jlimit (bufferValidStart, bufferValidEnd, pos + numSamples) - pos) };
 }
 
-bool BufferingAudioSource::readNextBufferChunk()
+bool BufferingAudioSource::readNextBufferChunk (int maxChunkSize)
 {
     int64 newBVS, newBVE, sectionToReadStart, sectionToReadEnd;
 
@@ -247,8 +309,6 @@ bool BufferingAudioSource::readNextBufferChunk()
         sectionToReadStart = 0;
         sectionToReadEnd = 0;
 
-        constexpr int maxChunkSize = 2048;
-
         if (newBVS < bufferValidStart || newBVS >= bufferValidEnd)
         {
             newBVE = jmin (newBVE, newBVS + maxChunkSize);
@@ -321,9 +381,43 @@ void BufferingAudioSource::readBufferSection (int64 start, int length, int buffe
     source->getNextAudioBlock (info);
 }
 
+void BufferingAudioSource::setPlaybackSpeed (double newSpeed) noexcept
+{
+    jassert (newSpeed > 0);
+    playbackSpeed = jmax (0.01, newSpeed);
+}
+
 int BufferingAudioSource::useTimeSlice()
 {
-    return readNextBufferChunk() ? 1 : 100;
+    // Read bigger chunks when playing faster, so that the thread's polling keeps up
+    const auto chunkSize = 2048 * jmax (1, (int) std::ceil (playbackSpeed.load()));
+    return readNextBufferChunk (chunkSize) ? 1 : 100;
+}
+
+std::optional<double> BufferingAudioSource::getSecondsUntilUnderrun()
+{
+    const ScopedLock sl (bufferRangeLock);
+
+    if (buffer.getNumSamples() == 0 || sampleRate <= 0)
+        return {};
+
+    const auto pos = jmax ((int64) 0, nextPlayPos.load());
+
+    if (wasSourceLooping != isLooping() || pos < bufferValidStart || pos >= bufferValidEnd)
+        return 0.0;
+
+    // These are the same conditions that readNextBufferChunk() uses to decide whether to read
+    const auto newEnd = pos + buffer.getNumSamples() - 4;
+
+    if (std::abs ((int) (pos - bufferValidStart)) > 512 || std::abs ((int) (newEnd - bufferValidEnd)) > 512)
+        return (double) (bufferValidEnd - pos) / (sampleRate * playbackSpeed.load());
+
+    return {};
+}
+
+bool BufferingAudioSource::readNextChunk (int maxNumSamples)
+{
+    return readNextBufferChunk (maxNumSamples);
 }
 
 } // namespace juce
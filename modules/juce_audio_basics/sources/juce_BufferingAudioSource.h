@@ -36,7 +36,8 @@ namespace juce
     @tags{Audio}
 */
 class JUCE_API  BufferingAudioSource  : public PositionableAudioSource,
-                                        private TimeSliceClient
+                                        private TimeSliceClient,
+                                        private StreamingReadScheduler::Client
 {
 public:
     //==============================================================================
@@ -61,6 +62,31 @@ public:
                           int numberOfChannels = 2,
                           bool prefillBufferOnPrepareToPlay = true);
 
+    /** Creates a BufferingAudioSource that shares a StreamingReadScheduler with other
+        streaming sources.
+
+        The scheduler will read for whichever of its sources is closest to running out of
+        audio, and the buffer size may be reduced to fit into the scheduler's memory budget.
+
+        @param source                       the input source to read from
+        @param scheduler                    the scheduler that will be used for the background
+                                            read-ahead. This object must not be deleted until after
+                                            any BufferingAudioSources that are using it have been
+                                            deleted!
+        @param deleteSourceWhenDeleted      if true, then the input source object will
+                                            be deleted when this object is deleted
+        @param numberOfSamplesToBuffer      the size of buffer to use for reading ahead
+        @param numberOfChannels             the number of channels that will be played
+        @param prefillBufferOnPrepareToPlay if true, then calling prepareToPlay on this object will
+                                            block until the buffer has been filled
+    */
+    BufferingAudioSource (PositionableAudioSource* source,
+                          StreamingReadScheduler& scheduler,
+                          bool deleteSourceWhenDeleted,
+                          int numberOfSamplesToBuffer,
+                          int numberOfChannels = 2,
+                          bool prefillBufferOnPrepareToPlay = true);
+
     /** Destructor.
 
         The input source may be deleted depending on whether the deleteSourceWhenDeleted
@@ -97,22 +123,44 @@ public:
     */
     bool waitForNextAudioBlockReady (const AudioSourceChannelInfo& info, uint32 timeout);
 
+    /** Tells the source how quickly its output is being consumed.
+
+        If whatever is reading from this source plays it faster or slower than its normal
+        rate (e.g. a ResamplingAudioSource or TimeStretchAudioSource that's changing its
+        speed), call this so that the background reading can keep up. A speed of 2.0 means
+        that samples are being used twice as fast as the sample rate. This can be called
+        from any thread.
+    */
+    void setPlaybackSpeed (double newSpeed) noexcept;
+
+    /** Returns the speed that was set with setPlaybackSpeed(). */
+    double getPlaybackSpeed() const noexcept    { return playbackSpeed.load(); }
+
 private:
     //==============================================================================
     Range<int> getValidBufferRange (int numSamples) const;
-    bool readNextBufferChunk();
+    bool readNextBufferChunk (int maxChunkSize);
     void readBufferSection (int64 start, int length, int bufferOffset);
     int useTimeSlice() override;
 
+    std::optional<double> getSecondsUntilUnderrun() override;
+    bool readNextChunk (int maxNumSamples) override;
+
+    void startBackgroundReading();
+    void stopBackgroundReading();
+    void moveToFrontOfQueue();
+
     //==============================================================================
     OptionalScopedPointer<PositionableAudioSource> source;
-    TimeSliceThread& backgroundThread;
+    TimeSliceThread* backgroundThread = nullptr;
+    StreamingReadScheduler* scheduler = nullptr;
     int numberOfSamplesToBuffer, numberOfChannels;
     AudioBuffer<float> buffer;
     CriticalSection callbackLock, bufferRangeLock;
     WaitableEvent bufferReadyEvent;
     int64 bufferValidStart = 0, bufferValidEnd = 0;
     std::atomic<int64> nextPlayPos { 0 };
+    std::atomic<double> playbackSpeed { 1.0 };
     double sampleRate = 0;
     bool wasSourceLooping = false, isPrepared = false;
     const bool prefillBuffer;
@@ -26,6 +26,7 @@ namespace juce
 MixerAudioSource::MixerAudioSource()
    : currentSampleRate (0.0), bufferSizeExpected (0)
 {
+    publishInputs();
 }
 
 MixerAudioSource::~MixerAudioSource()
@@ -54,6 +55,7 @@ void MixerAudioSource::addInputSource (AudioSource* input, const bool deleteWhen
 
         inputsToDelete.setBit (inputs.size(), deleteWhenRemoved);
         inputs.add (input);
+        publishInputs();
     }
 }
 
@@ -75,6 +77,7 @@ void MixerAudioSource::removeInputSource (AudioSource* const input)
 
             inputsToDelete.shiftBits (-1, index);
             inputs.remove (index);
+            publishInputs();
         }
 
         input->releaseResources();
@@ -93,12 +96,49 @@ void MixerAudioSource::removeAllInputs()
                 toDelete.add (inputs.getUnchecked (i));
 
         inputs.clear();
+        publishInputs();
     }
 
     for (int i = toDelete.size(); --i >= 0;)
         toDelete.getUnchecked (i)->releaseResources();
 }
 
+void MixerAudioSource::publishInputs()
+{
+    auto newInputs = std::make_unique<InputList> (inputs);
+    inputsForAudioThread = newInputs.get();
+
+    // If a block was being rendered when the list was swapped, it might still be using the
+    // old list, so wait for that block to finish. Any block that starts after this point
+    // will see the new list.
+    const auto counter = blockCounter.load();
+
+    if ((counter & 1) != 0)
+        while (blockCounter.load() == counter)
+            Thread::yield();
+
+    publishedInputs = std::move (newInputs);
+}
+
+void MixerAudioSource::setParallelMixing (RealtimeThreadPool* newPool, int maximumNumChannels, int maximumBlockSize)
+{
+    if (newPool == nullptr || ! newPool->isPrepared())
+    {
+        pool = nullptr;
+        maxNumGroups = maxNumChannels = maxBlockSize = 0;
+        parallelScratch.setSize (0, 0);
+        return;
+    }
+
+    pool = newPool;
+    maxNumGroups = jmin (pool->getNumThreads() + 1, pool->getMaxNumJobs());
+    maxNumChannels = jmax (1, maximumNumChannels);
+    maxBlockSize = jmax (1, maximumBlockSize);
+
+    // Each group needs a buffer to mix into, and another to render each input into
+    parallelScratch.setSize (maxNumGroups * maxNumChannels * 2, maxBlockSize);
+}
+
 void MixerAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
 {
     tempBuffer.setSize (2, samplesPerBlockExpected);
@@ -127,22 +167,30 @@ void MixerAudioSource::releaseResources()
 
 void MixerAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
 {
-    const ScopedLock sl (lock);
+    ++blockCounter;
+    mixInputs (*inputsForAudioThread.load(), info);
+    ++blockCounter;
+}
 
-    if (inputs.size() > 0)
+void MixerAudioSource::mixInputs (const InputList& currentInputs, const AudioSourceChannelInfo& info)
+{
+    if (currentInputs.size() > 0)
     {
-        inputs.getUnchecked (0)->getNextAudioBlock (info);
+        if (mixInputsInParallel (currentInputs, info))
+            return;
 
-        if (inputs.size() > 1)
+        currentInputs.getUnchecked (0)->getNextAudioBlock (info);
+
+        if (currentInputs.size() > 1)
         {
             tempBuffer.setSize (jmax (1, info.buffer->getNumChannels()),
                                 info.buffer->getNumSamples());
 
             AudioSourceChannelInfo info2 (&tempBuffer, 0, info.numSamples);
 
-            for (int i = 1; i < inputs.size(); ++i)
+            for (int i = 1; i < currentInputs.size(); ++i)
             {
-                inputs.getUnchecked (i)->getNextAudioBlock (info2);
+                currentInputs.getUnchecked (i)->getNextAudioBlock (info2);
 
                 for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
                     info.buffer->addFrom (chan, info.startSample, tempBuffer, chan, 0, info.numSamples);
@@ -155,4 +203,62 @@ void MixerAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
     }
 }
 
+bool MixerAudioSource::mixInputsInParallel (const InputList& currentInputs, const AudioSourceChannelInfo& info)
+{
+    const auto numChannels = info.buffer->getNumChannels();
+    const auto numSamples = info.numSamples;
+    const auto numInputs = currentInputs.size();
+    const auto numGroups = jmin (maxNumGroups, numInputs);
+
+    if (pool == nullptr || numGroups < 2 || numSamples <= 0
+         || numChannels > maxNumChannels || numSamples > maxBlockSize)
+        return false;
+
+    const auto getScratch = [&] (int index)
+    {
+        return AudioBuffer<float> (parallelScratch.getArrayOfWritePointers() + index * numChannels,
+                                   numChannels,
+                                   numSamples);
+    };
+
+    const auto mixGroup = [&] (int group)
+    {
+        auto groupBuffer = getScratch (group * 2);
+        auto inputBuffer = getScratch (group * 2 + 1);
+
+        const auto begin = (numInputs * group) / numGroups;
+        const auto end   = (numInputs * (group + 1)) / numGroups;
+
+        currentInputs.getUnchecked (begin)->getNextAudioBlock (AudioSourceChannelInfo (&groupBuffer, 0, numSamples));
+
+        for (auto i = begin + 1; i < end; ++i)
+        {
+            currentInputs.getUnchecked (i)->getNextAudioBlock (AudioSourceChannelInfo (&inputBuffer, 0, numSamples));
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                groupBuffer.addFrom (channel, 0, inputBuffer, channel, 0, numSamples);
+        }
+    };
+
+    for (int group = 1; group < numGroups; ++group)
+        pool->addJob ([&mixGroup, group] { mixGroup (group); });
+
+    mixGroup (0);
+    pool->runJobsAndWait();
+
+    // Sum the groups pairwise, so that no group's samples go through more additions than
+    // the others, and the result ends up in the first group
+    for (int stride = 1; stride < numGroups; stride *= 2)
+        for (int group = 0; group + stride < numGroups; group += stride * 2)
+            for (int channel = 0; channel < numChannels; ++channel)
+                FloatVectorOperations::add (parallelScratch.getWritePointer ((group * 2) * numChannels + channel),
+                                            parallelScratch.getReadPointer (((group + stride) * 2) * numChannels + channel),
+                                            numSamples);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        info.buffer->copyFrom (channel, info.startSample, parallelScratch, channel, 0, numSamples);
+
+    return true;
+}
+
 } // namespace juce
@@ -29,7 +29,13 @@ namespace juce
 
     Input sources can be added and removed while the mixer is running as long as their
     prepareToPlay() and releaseResources() methods are called before and after adding
-    them to the mixer.
+    them to the mixer. The audio thread never waits for these changes: instead, removing
+    an input waits until the audio thread has finished any block that might still be
+    using it. For that reason, inputs mustn't be added or removed from inside
+    getNextAudioBlock().
+
+    The inputs can also be rendered in parallel on a RealtimeThreadPool, see
+    setParallelMixing().
 
     @tags{Audio}
 */
@@ -69,6 +75,30 @@ public:
     */
     void removeAllInputs();
 
+    //==============================================================================
+    /** Enables rendering the inputs in parallel, using the threads of a RealtimeThreadPool.
+
+        When this is enabled, the inputs are shared between the threads of the pool in
+        contiguous groups. Each thread renders its inputs one at a time into a scratch buffer
+        and adds them together, and the groups are then summed pairwise into the output. The
+        inputs will be rendered concurrently, so they mustn't share any state that isn't
+        thread-safe.
+
+        The result may differ very slightly from serial mixing, because the samples are summed
+        in a different order, but for a given pool it will always be the same.
+
+        Blocks with more than maximumNumChannels channels or maximumBlockSize samples will be
+        mixed serially. Pass a nullptr pool to go back to serial mixing.
+
+        This allocates memory, and must not be called while getNextAudioBlock() is running,
+        so call it from somewhere like prepareToPlay(). The pool must remain valid until
+        parallel mixing has been disabled, or the mixer has been deleted.
+    */
+    void setParallelMixing (RealtimeThreadPool* pool, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns true if setParallelMixing() has been called with a prepared pool. */
+    bool isMixingInParallel() const noexcept        { return pool != nullptr; }
+
     //==============================================================================
     /** Implementation of the AudioSource method.
         This will call prepareToPlay() on all its input sources.
@@ -86,6 +116,8 @@ public:
 
 private:
     //==============================================================================
+    using InputList = Array<AudioSource*>;
+
     Array<AudioSource*> inputs;
     BigInteger inputsToDelete;
     CriticalSection lock;
@@ -93,6 +125,22 @@ private:
     double currentSampleRate;
     int bufferSizeExpected;
 
+    // The audio thread reads the inputs from an immutable copy of the list. Changing the
+    // inputs publishes a new copy, and the old one is only deleted once the audio thread
+    // is known to have finished with it. The block counter is odd while a block is being
+    // rendered, which is how the other threads can tell.
+    std::unique_ptr<InputList> publishedInputs;
+    std::atomic<InputList*> inputsForAudioThread { nullptr };
+    std::atomic<uint32> blockCounter { 0 };
+
+    RealtimeThreadPool* pool = nullptr;
+    int maxNumGroups = 0, maxNumChannels = 0, maxBlockSize = 0;
+    AudioBuffer<float> parallelScratch;
+
+    void publishInputs();
+    void mixInputs (const InputList&, const AudioSourceChannelInfo&);
+    bool mixInputsInParallel (const InputList&, const AudioSourceChannelInfo&);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MixerAudioSource)
 };
 
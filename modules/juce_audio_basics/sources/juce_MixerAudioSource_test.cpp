@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct MixerAudioSourceTests final : public UnitTest
+{
+    MixerAudioSourceTests()  : UnitTest ("MixerAudioSource", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr auto numChannels = 2;
+        constexpr auto blockSize = 256;
+        constexpr auto sampleRate = 44100.0;
+
+        beginTest ("Parallel mixing matches serial mixing");
+        {
+            RealtimeThreadPool pool (RealtimeThreadPool::Options{}.withNumberOfThreads (3));
+
+            const auto render = [&] (bool parallel)
+            {
+                MixerAudioSource mixer;
+
+                for (int i = 0; i < 10; ++i)
+                {
+                    auto* tone = new ToneGeneratorAudioSource();
+                    tone->setFrequency (100.0 + 50.0 * i);
+                    tone->setAmplitude (0.05f);
+                    mixer.addInputSource (tone, true);
+                }
+
+                mixer.prepareToPlay (blockSize, sampleRate);
+                mixer.setParallelMixing (parallel ? &pool : nullptr, numChannels, blockSize);
+                expect (mixer.isMixingInParallel() == parallel);
+
+                AudioBuffer<float> output (numChannels, blockSize * 8);
+
+                for (int start = 0; start < output.getNumSamples(); start += blockSize)
+                    mixer.getNextAudioBlock (AudioSourceChannelInfo (&output, start, blockSize));
+
+                mixer.releaseResources();
+                return output;
+            };
+
+            const auto serialOutput   = render (false);
+            const auto parallelOutput = render (true);
+
+            expect (serialOutput.getMagnitude (0, serialOutput.getNumSamples()) > 0.1f);
+
+            auto maxDifference = 0.0f;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < serialOutput.getNumSamples(); ++i)
+                    maxDifference = jmax (maxDifference, std::abs (serialOutput.getSample (channel, i) - parallelOutput.getSample (channel, i)));
+
+            expect (maxDifference <= 1.0e-5f, "Maximum difference was " + String (maxDifference));
+        }
+
+        beginTest ("Inputs aren't deleted while they're being rendered");
+        {
+            MixerAudioSource mixer;
+            mixer.prepareToPlay (blockSize, sampleRate);
+
+            std::atomic<bool> deletedWhileRendering { false }, stop { false };
+
+            std::thread audioThread ([&]
+            {
+                AudioBuffer<float> buffer (numChannels, blockSize);
+
+                while (! stop)
+                    mixer.getNextAudioBlock (AudioSourceChannelInfo (buffer));
+            });
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto* source = new CheckedSource (deletedWhileRendering);
+                mixer.addInputSource (source, true);
+
+                while (source->numBlocksRendered == 0)
+                    Thread::yield();
+
+                mixer.removeInputSource (source);
+            }
+
+            stop = true;
+            audioThread.join();
+
+            expect (! deletedWhileRendering);
+        }
+    }
+
+private:
+    struct CheckedSource final : public AudioSource
+    {
+        explicit CheckedSource (std::atomic<bool>& flag)  : deletedWhileRendering (flag) {}
+
+        ~CheckedSource() override
+        {
+            if (isRendering)
+                deletedWhileRendering = true;
+        }
+
+        void prepareToPlay (int, double) override {}
+        void releaseResources() override {}
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            isRendering = true;
+            info.clearActiveBufferRegion();
+            ++numBlocksRendered;
+
+            for (int i = 0; i < 10; ++i)
+                Thread::yield();
+
+            isRendering = false;
+        }
+
+        std::atomic<bool>& deletedWhileRendering;
+        std::atomic<bool> isRendering { false };
+        std::atomic<int> numBlocksRendered { 0 };
+    };
+};
+
+static MixerAudioSourceTests mixerAudioSourceTests;
+
+} // namespace juce
@@ -69,6 +69,24 @@ void ResamplingAudioSource::flushBuffers()
     sampsInBuffer = 0;
     subSampleOffset = 0.0;
     resetFilters();
+
+    if (polyphaseResampler != nullptr)
+        polyphaseResampler->reset();
+}
+
+void ResamplingAudioSource::setUsesPolyphaseResampler (bool shouldUsePolyphaseResampler)
+{
+    std::unique_ptr<PolyphaseResampler> newResampler;
+
+    if (shouldUsePolyphaseResampler)
+        newResampler = std::make_unique<PolyphaseResampler> (numChannels);
+
+    {
+        const ScopedLock sl (callbackLock);
+        std::swap (polyphaseResampler, newResampler);
+    }
+
+    flushBuffers();
 }
 
 void ResamplingAudioSource::releaseResources()
@@ -94,6 +112,12 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
         lastRatio = localRatio;
     }
 
+    if (polyphaseResampler != nullptr)
+    {
+        resampleWithPolyphaseResampler (info, localRatio);
+        return;
+    }
+
     const int sampsNeeded = roundToInt (info.numSamples * localRatio) + 3;
 
     int bufferSize = buffer.getNumSamples();
@@ -195,6 +219,30 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
     jassert (sampsInBuffer >= 0);
 }
 
+void ResamplingAudioSource::resampleWithPolyphaseResampler (const AudioSourceChannelInfo& info, double localRatio)
+{
+    const auto numInputSamples = polyphaseResampler->getNumInputSamplesNeeded (localRatio, info.numSamples);
+
+    if (buffer.getNumSamples() < numInputSamples)
+        buffer.setSize (numChannels, numInputSamples + 32, false, false, true);
+
+    if (numInputSamples > 0)
+    {
+        AudioSourceChannelInfo readInfo (&buffer, 0, numInputSamples);
+        input->getNextAudioBlock (readInfo);
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        srcBuffers[channel] = buffer.getReadPointer (channel);
+        destBuffers[channel] = channel < info.buffer->getNumChannels()
+                                 ? info.buffer->getWritePointer (channel, info.startSample)
+                                 : nullptr;
+    }
+
+    polyphaseResampler->process (localRatio, srcBuffers, destBuffers, info.numSamples);
+}
+
 void ResamplingAudioSource::createLowPass (const double frequencyRatio)
 {
     const double proportionalRate = (frequencyRatio > 1.0) ? 0.5 / frequencyRatio
@@ -27,7 +27,10 @@ namespace juce
 /**
     A type of AudioSource that takes an input source and changes its sample rate.
 
-    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator
+    By default this uses linear interpolation with an IIR anti-aliasing filter, which is
+    cheap but not very accurate. For higher quality, call setUsesPolyphaseResampler().
+
+    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator, PolyphaseResampler
 
     @tags{Audio}
 */
@@ -68,6 +71,17 @@ public:
     /** Clears any buffers and filters that the resampler is using. */
     void flushBuffers();
 
+    /** Chooses whether to resample with a PolyphaseResampler rather than linear interpolation.
+
+        The polyphase resampler has a much flatter frequency response and far less aliasing,
+        but uses more CPU and delays the output by PolyphaseResampler::getBaseLatency()
+        input samples. Changing this setting clears the resampler's buffers.
+    */
+    void setUsesPolyphaseResampler (bool shouldUsePolyphaseResampler);
+
+    /** Returns true if setUsesPolyphaseResampler() has been used to enable the polyphase resampler. */
+    bool isUsingPolyphaseResampler() const noexcept             { return polyphaseResampler != nullptr; }
+
     //==============================================================================
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
     void releaseResources() override;
@@ -86,6 +100,7 @@ private:
     const int numChannels;
     HeapBlock<float*> destBuffers;
     HeapBlock<const float*> srcBuffers;
+    std::unique_ptr<PolyphaseResampler> polyphaseResampler;
 
     void setFilterCoefficients (double c1, double c2, double c3, double c4, double c5, double c6);
     void createLowPass (double proportionalRate);
@@ -99,6 +114,7 @@ private:
     void resetFilters();
 
     void applyFilter (float* samples, int num, FilterState& fs);
+    void resampleWithPolyphaseResampler (const AudioSourceChannelInfo&, double localRatio);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResamplingAudioSource)
 };
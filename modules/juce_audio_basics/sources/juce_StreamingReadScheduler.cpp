@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class StreamingReadScheduler::Worker final : public Thread
+{
+public:
+    Worker (StreamingReadScheduler& schedulerIn, const String& name)
+        : Thread (name), scheduler (schedulerIn)
+    {
+    }
+
+    ~Worker() override
+    {
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            // The clients' needs change as their buffers are played, so if there's nothing to
+            // do, check again periodically even if notify() isn't called
+            if (! scheduler.serviceNextClient())
+                scheduler.workAvailable.wait (idleWaitMs);
+        }
+    }
+
+private:
+    static constexpr int idleWaitMs = 10;
+
+    StreamingReadScheduler& scheduler;
+};
+
+//==============================================================================
+StreamingReadScheduler::StreamingReadScheduler (const Options& optionsIn)
+    : options (optionsIn)
+{
+    for (int i = 0; i < jmax (1, options.numberOfThreads); ++i)
+    {
+        workers.push_back (std::make_unique<Worker> (*this, options.threadName + " " + String (i + 1)));
+        workers.back()->startThread (options.threadPriority);
+    }
+}
+
+StreamingReadScheduler::~StreamingReadScheduler()
+{
+    // All clients must be removed before the scheduler is deleted!
+    jassert (clients.isEmpty());
+
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    for (auto& worker : workers)
+    {
+        workAvailable.signal();
+        worker->stopThread (-1);
+    }
+}
+
+//==============================================================================
+void StreamingReadScheduler::addClient (Client* client)
+{
+    jassert (client != nullptr);
+
+    {
+        const ScopedLock sl (lock);
+        clients.addIfNotAlreadyThere (client);
+    }
+
+    notify();
+}
+
+void StreamingReadScheduler::removeClient (Client* client)
+{
+    {
+        const ScopedLock sl (lock);
+        clients.removeFirstMatchingValue (client);
+    }
+
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (! busyClients.contains (client))
+                return;
+        }
+
+        clientFinished.wait (1);
+    }
+}
+
+int StreamingReadScheduler::getNumClients() const
+{
+    const ScopedLock sl (lock);
+    return clients.size();
+}
+
+void StreamingReadScheduler::notify() noexcept
+{
+    workAvailable.signal();
+}
+
+//==============================================================================
+size_t StreamingReadScheduler::requestMemory (Client* client, size_t bytesWanted, size_t bytesNeeded)
+{
+    const ScopedLock sl (lock);
+
+    auto grant = std::find_if (memoryGrants.begin(), memoryGrants.end(),
+                               [client] (const auto& g) { return g.first == client; });
+
+    if (grant == memoryGrants.end())
+        grant = memoryGrants.insert (memoryGrants.end(), { client, (size_t) 0 });
+
+    auto granted = bytesWanted;
+
+    if (options.memoryBudgetBytes > 0)
+    {
+        const auto grantedToOthers = getTotalMemoryGranted() - grant->second;
+        const auto remaining = options.memoryBudgetBytes > grantedToOthers ? options.memoryBudgetBytes - grantedToOthers
+                                                                           : (size_t) 0;
+
+        granted = jmax (bytesNeeded, jmin (bytesWanted, remaining));
+    }
+
+    grant->second = granted;
+    return granted;
+}
+
+void StreamingReadScheduler::releaseMemory (Client* client)
+{
+    const ScopedLock sl (lock);
+
+    memoryGrants.erase (std::remove_if (memoryGrants.begin(), memoryGrants.end(),
+                                        [client] (const auto& g) { return g.first == client; }),
+                        memoryGrants.end());
+}
+
+size_t StreamingReadScheduler::getTotalMemoryGranted() const
+{
+    const ScopedLock sl (lock);
+
+    size_t total = 0;
+
+    for (const auto& grant : memoryGrants)
+        total += grant.second;
+
+    return total;
+}
+
+//==============================================================================
+bool StreamingReadScheduler::serviceNextClient()
+{
+    Client* chosen = nullptr;
+
+    {
+        const ScopedLock sl (lock);
+
+        auto earliestUnderrun = std::numeric_limits<double>::max();
+
+        for (auto* client : clients)
+        {
+            if (busyClients.contains (client))
+                continue;
+
+            if (const auto secondsUntilUnderrun = client->getSecondsUntilUnderrun())
+            {
+                if (*secondsUntilUnderrun < earliestUnderrun)
+                {
+                    earliestUnderrun = *secondsUntilUnderrun;
+                    chosen = client;
+                }
+            }
+        }
+
+        if (chosen == nullptr)
+            return false;
+
+        busyClients.add (chosen);
+    }
+
+    // Let another thread look for work while this one is reading
+    if (workers.size() > 1)
+        workAvailable.signal();
+
+    const auto didRead = chosen->readNextChunk (jmax (1, options.maxReadSizeSamples));
+
+    {
+        const ScopedLock sl (lock);
+        busyClients.removeFirstMatchingValue (chosen);
+    }
+
+    clientFinished.signal();
+    return didRead;
+}
+
+} // namespace juce
@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A set of options used to configure a StreamingReadScheduler.
+
+    @see StreamingReadScheduler
+
+    @tags{Audio}
+*/
+struct StreamingReadSchedulerOptions
+{
+    /** The name to give each thread in the scheduler. */
+    [[nodiscard]] StreamingReadSchedulerOptions withThreadName (String newThreadName) const
+    {
+        return withMember (*this, &StreamingReadSchedulerOptions::threadName, newThreadName);
+    }
+
+    /** The number of threads that will read from the clients. */
+    [[nodiscard]] StreamingReadSchedulerOptions withNumberOfThreads (int newNumberOfThreads) const
+    {
+        return withMember (*this, &StreamingReadSchedulerOptions::numberOfThreads, newNumberOfThreads);
+    }
+
+    /** The priority of the reading threads. */
+    [[nodiscard]] StreamingReadSchedulerOptions withThreadPriority (Thread::Priority newThreadPriority) const
+    {
+        return withMember (*this, &StreamingReadSchedulerOptions::threadPriority, newThreadPriority);
+    }
+
+    /** The total number of bytes that all of the clients may use for buffering, or 0
+        for no limit.
+
+        @see StreamingReadScheduler::requestMemory
+    */
+    [[nodiscard]] StreamingReadSchedulerOptions withMemoryBudget (size_t newMemoryBudgetBytes) const
+    {
+        return withMember (*this, &StreamingReadSchedulerOptions::memoryBudgetBytes, newMemoryBudgetBytes);
+    }
+
+    /** The maximum number of samples that a client will be asked to read in one go.
+
+        Clients read everything they can up to this size as a single contiguous read, so
+        larger values mean fewer, longer reads from each file.
+    */
+    [[nodiscard]] StreamingReadSchedulerOptions withMaxReadSize (int newMaxReadSizeSamples) const
+    {
+        return withMember (*this, &StreamingReadSchedulerOptions::maxReadSizeSamples, newMaxReadSizeSamples);
+    }
+
+    String threadName { "Streaming Reader" };
+    int numberOfThreads { 2 };
+    Thread::Priority threadPriority { Thread::Priority::high };
+    size_t memoryBudgetBytes { 0 };
+    int maxReadSizeSamples { 65536 };
+};
+
+//==============================================================================
+/**
+    Shares a set of background threads between many streaming readers, such as
+    BufferingAudioSource and BufferingAudioReader objects.
+
+    When each streaming reader uses its own TimeSliceClient, the readers are serviced in
+    turn without any knowledge of how urgently each one needs data, so with many streams
+    some can run dry while others are far ahead. This scheduler instead always services
+    the client that will run out of audio soonest, asks it to read as much as it can in a
+    single contiguous read, and can share a fixed memory budget between the clients.
+
+    @code
+    StreamingReadScheduler scheduler (StreamingReadScheduler::Options{}.withNumberOfThreads (4)
+                                                                       .withMemoryBudget (512 * 1024 * 1024));
+
+    for (auto& track : tracks)
+        track.source = std::make_unique<BufferingAudioSource> (track.reader.get(), scheduler, false, 65536);
+    @endcode
+
+    The scheduler must outlive all of its clients.
+
+    @see BufferingAudioSource, BufferingAudioReader
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingReadScheduler
+{
+public:
+    using Options = StreamingReadSchedulerOptions;
+
+    //==============================================================================
+    /** A streaming reader that can be serviced by a StreamingReadScheduler. */
+    class JUCE_API  Client
+    {
+    public:
+        /** Destructor. */
+        virtual ~Client() = default;
+
+        /** Returns the number of seconds of buffered audio that this client has left before
+            it will run out, or nullopt if it doesn't currently need to read anything.
+
+            This will be called frequently by the scheduler's threads, so it should be quick.
+        */
+        virtual std::optional<double> getSecondsUntilUnderrun() = 0;
+
+        /** Reads up to the given number of samples into the client's buffer.
+
+            This is called on one of the scheduler's threads, and won't be called for the same
+            client by two threads at once. It should return false if there was nothing to read.
+        */
+        virtual bool readNextChunk (int maxNumSamples) = 0;
+    };
+
+    //==============================================================================
+    /** Creates a scheduler and starts its threads. */
+    explicit StreamingReadScheduler (const Options& options = {});
+
+    /** Destructor. Stops the threads. All clients must have been removed before this is called. */
+    ~StreamingReadScheduler();
+
+    //==============================================================================
+    /** Adds a client to the scheduler. */
+    void addClient (Client* client);
+
+    /** Removes a client from the scheduler.
+
+        This doesn't return the client's memory to the budget - call releaseMemory() for that.
+        If one of the threads is currently reading for this client, this will block until
+        it has finished.
+    */
+    void removeClient (Client* client);
+
+    /** Returns the number of clients. */
+    int getNumClients() const;
+
+    /** Wakes the threads so that they re-evaluate which client to service next.
+
+        Clients should call this when their need for data changes suddenly, for example
+        after a seek. This doesn't take any locks, so it's safe to call while holding the
+        client's own locks.
+    */
+    void notify() noexcept;
+
+    //==============================================================================
+    /** Asks for some memory from the scheduler's budget, and returns the number of bytes
+        that the client may use.
+
+        This will be bytesWanted if the budget allows it. Otherwise it will be whatever is left
+        of the budget, but never less than bytesNeeded. Any memory previously granted to the
+        client is replaced by the new amount.
+    */
+    size_t requestMemory (Client* client, size_t bytesWanted, size_t bytesNeeded);
+
+    /** Returns the memory granted to a client to the budget. */
+    void releaseMemory (Client* client);
+
+    /** Returns the total number of bytes that have been granted to clients. */
+    size_t getTotalMemoryGranted() const;
+
+    /** Returns the options that the scheduler was created with. */
+    const Options& getOptions() const noexcept          { return options; }
+
+private:
+    //==============================================================================
+    class Worker;
+
+    bool serviceNextClient();
+
+    const Options options;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    CriticalSection lock;
+    Array<Client*> clients, busyClients;
+    std::vector<std::pair<Client*, size_t>> memoryGrants;
+    WaitableEvent workAvailable, clientFinished;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StreamingReadScheduler)
+};
+
+} // namespace juce
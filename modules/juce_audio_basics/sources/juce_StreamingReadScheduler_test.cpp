@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct StreamingReadSchedulerTests final : public UnitTest
+{
+    StreamingReadSchedulerTests()  : UnitTest ("StreamingReadScheduler", UnitTestCategories::audio)  {}
+
+    struct TestClient final : public StreamingReadScheduler::Client
+    {
+        TestClient (double secondsIn, std::function<void (TestClient&)> onReadIn)
+            : seconds (secondsIn), onRead (std::move (onReadIn)) {}
+
+        std::optional<double> getSecondsUntilUnderrun() override
+        {
+            if (hasRead)
+                return {};
+
+            return seconds;
+        }
+
+        bool readNextChunk (int) override
+        {
+            hasRead = true;
+            onRead (*this);
+            return true;
+        }
+
+        const double seconds;
+        std::function<void (TestClient&)> onRead;
+        std::atomic<bool> hasRead { false };
+    };
+
+    void runTest() override
+    {
+        beginTest ("The client closest to underrunning is serviced first");
+        {
+            StreamingReadScheduler scheduler (StreamingReadScheduler::Options{}.withNumberOfThreads (1));
+
+            WaitableEvent gateReached, openGate;
+            CriticalSection orderLock;
+            Array<double> order;
+
+            const auto recordOrder = [&] (TestClient& c)
+            {
+                const ScopedLock sl (orderLock);
+                order.add (c.seconds);
+            };
+
+            // Keep the only thread busy until all of the other clients have been added
+            TestClient gate (0.0, [&] (TestClient&) { gateReached.signal(); openGate.wait (-1); });
+            scheduler.addClient (&gate);
+            expect (gateReached.wait (5000));
+
+            std::vector<std::unique_ptr<TestClient>> others;
+
+            for (auto seconds : { 3.0, 0.5, 2.0, 0.1, 1.0 })
+            {
+                others.push_back (std::make_unique<TestClient> (seconds, recordOrder));
+                scheduler.addClient (others.back().get());
+            }
+
+            openGate.signal();
+
+            for (int i = 0; i < 500 && ! std::all_of (others.begin(), others.end(), [] (auto& c) { return c->hasRead.load(); }); ++i)
+                Thread::sleep (10);
+
+            {
+                const ScopedLock sl (orderLock);
+                expect (order == Array<double> { 0.1, 0.5, 1.0, 2.0, 3.0 });
+            }
+
+            scheduler.removeClient (&gate);
+
+            for (auto& c : others)
+                scheduler.removeClient (c.get());
+
+            expectEquals (scheduler.getNumClients(), 0);
+        }
+
+        beginTest ("Memory is granted within the budget");
+        {
+            StreamingReadScheduler scheduler (StreamingReadScheduler::Options{}.withNumberOfThreads (1)
+                                                                               .withMemoryBudget (1000));
+            TestClient a (1.0, [] (TestClient&) {}), b (1.0, [] (TestClient&) {}), c (1.0, [] (TestClient&) {});
+
+            expectEquals (scheduler.requestMemory (&a, 600, 100), (size_t) 600);
+            expectEquals (scheduler.requestMemory (&b, 600, 100), (size_t) 400);
+            expectEquals (scheduler.requestMemory (&c, 600, 100), (size_t) 100);
+            expectEquals (scheduler.getTotalMemoryGranted(), (size_t) 1100);
+
+            // Asking again replaces the previous grant
+            expectEquals (scheduler.requestMemory (&a, 300, 100), (size_t) 300);
+            expectEquals (scheduler.getTotalMemoryGranted(), (size_t) 800);
+
+            scheduler.releaseMemory (&b);
+            expectEquals (scheduler.getTotalMemoryGranted(), (size_t) 400);
+            expectEquals (scheduler.requestMemory (&c, 600, 100), (size_t) 600);
+
+            StreamingReadScheduler unlimited (StreamingReadScheduler::Options{}.withNumberOfThreads (1));
+            expectEquals (unlimited.requestMemory (&a, 1 << 30, 100), (size_t) 1 << 30);
+        }
+
+        beginTest ("BufferingAudioSources sharing a scheduler produce the same audio as their sources");
+        {
+            StreamingReadScheduler scheduler (StreamingReadScheduler::Options{}.withNumberOfThreads (2)
+                                                                               .withMaxReadSize (8192));
+            constexpr int numSources = 8, length = 50000, blockSize = 512;
+
+            auto random = getRandom();
+            std::vector<AudioBuffer<float>> sourceData;
+            std::vector<std::unique_ptr<BufferingAudioSource>> sources;
+
+            for (int i = 0; i < numSources; ++i)
+            {
+                sourceData.emplace_back (2, length);
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int s = 0; s < length; ++s)
+                        sourceData.back().setSample (channel, s, random.nextFloat() * 2.0f - 1.0f);
+            }
+
+            for (auto& data : sourceData)
+            {
+                sources.push_back (std::make_unique<BufferingAudioSource> (new MemoryAudioSource (data, false), scheduler, true, 16384));
+                sources.back()->prepareToPlay (blockSize, 44100.0);
+            }
+
+            expectEquals (scheduler.getNumClients(), numSources);
+
+            AudioBuffer<float> block (2, blockSize);
+            auto numMismatches = 0;
+
+            for (int start = 0; start + blockSize <= length; start += blockSize)
+            {
+                for (int i = 0; i < numSources; ++i)
+                {
+                    AudioSourceChannelInfo info (&block, 0, blockSize);
+                    expect (sources[(size_t) i]->waitForNextAudioBlockReady (info, 5000));
+                    sources[(size_t) i]->getNextAudioBlock (info);
+
+                    for (int channel = 0; channel < 2; ++channel)
+                        for (int s = 0; s < blockSize; ++s)
+                            if (! exactlyEqual (block.getSample (channel, s), sourceData[(size_t) i].getSample (channel, start + s)))
+                                ++numMismatches;
+                }
+            }
+
+            expectEquals (numMismatches, 0);
+
+            sources.clear();
+            expectEquals (scheduler.getNumClients(), 0);
+            expectEquals (scheduler.getTotalMemoryGranted(), (size_t) 0);
+        }
+
+        beginTest ("BufferingAudioSource buffers are limited by the scheduler's memory budget");
+        {
+            constexpr size_t bytesPerSample = 2 * sizeof (float);
+            StreamingReadScheduler scheduler (StreamingReadScheduler::Options{}.withNumberOfThreads (1)
+                                                                               .withMemoryBudget (12000 * bytesPerSample));
+            AudioBuffer<float> data (2, 44100);
+            data.clear();
+
+            BufferingAudioSource first  (new MemoryAudioSource (data, false), scheduler, true, 8192, 2, false);
+            BufferingAudioSource second (new MemoryAudioSource (data, false), scheduler, true, 8192, 2, false);
+
+            first.prepareToPlay (512, 44100.0);
+            second.prepareToPlay (512, 44100.0);
+
+            expectEquals (scheduler.getTotalMemoryGranted(), (size_t) 12000 * bytesPerSample);
+
+            first.releaseResources();
+            expectEquals (scheduler.getTotalMemoryGranted(), (size_t) (12000 - 8192) * bytesPerSample);
+        }
+    }
+};
+
+static StreamingReadSchedulerTests streamingReadSchedulerTests;
+
+} // namespace juce
@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+TimeStretchAudioSource::TimeStretchAudioSource (AudioSource* inputSource,
+                                                bool deleteInputWhenDeleted,
+                                                int channels)
+    : input (inputSource, deleteInputWhenDeleted),
+      numChannels (channels)
+{
+    jassert (input != nullptr);
+}
+
+TimeStretchAudioSource::~TimeStretchAudioSource() {}
+
+void TimeStretchAudioSource::setSpeed (double newSpeed) noexcept
+{
+    jassert (newSpeed > 0);
+    speed = jlimit (0.25, 4.0, newSpeed);
+}
+
+void TimeStretchAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    const ScopedLock sl (callbackLock);
+
+    // 40ms frames overlapping by half, searching a quarter of a frame either side
+    frameSize = jmax (64, roundToInt (sampleRate * 0.04) & ~1);
+    hopSize = frameSize / 2;
+    searchRange = frameSize / 4;
+    maxInputBlockSize = jmax (1, samplesPerBlockExpected);
+
+    window.malloc (frameSize);
+
+    for (int i = 0; i < frameSize; ++i)
+        window[i] = (float) (0.5 - 0.5 * std::cos (MathConstants<double>::twoPi * i / frameSize));
+
+    inputBuffer.setSize (numChannels, 4 * frameSize + maxInputBlockSize);
+    overlapBuffer.setSize (numChannels, frameSize);
+    outputBuffer.setSize (numChannels, hopSize);
+
+    input->prepareToPlay (samplesPerBlockExpected, sampleRate);
+
+    flushBuffers();
+}
+
+void TimeStretchAudioSource::flushBuffers()
+{
+    const ScopedLock sl (callbackLock);
+
+    inputBuffer.clear();
+    overlapBuffer.clear();
+    outputBuffer.clear();
+
+    // Starting with a hop's worth of silence means that the first frame fades in from
+    // zero, and makes the output an exact copy of the input, delayed by one hop, when
+    // the speed is 1.
+    inputStart = -hopSize;
+    numInputSamples = hopSize;
+    nextFramePos = (double) inputStart;
+    hasPreviousFrame = false;
+    outputReadPos = numOutputSamples = 0;
+}
+
+void TimeStretchAudioSource::releaseResources()
+{
+    input->releaseResources();
+
+    const ScopedLock sl (callbackLock);
+
+    frameSize = hopSize = searchRange = 0;
+    window.free();
+    inputBuffer.setSize (numChannels, 0);
+    overlapBuffer.setSize (numChannels, 0);
+    outputBuffer.setSize (numChannels, 0);
+}
+
+void TimeStretchAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
+{
+    const ScopedLock sl (callbackLock);
+
+    if (frameSize == 0)
+    {
+        jassertfalse; // prepareToPlay() hasn't been called!
+        info.clearActiveBufferRegion();
+        return;
+    }
+
+    auto& dest = *info.buffer;
+    const auto numChannelsToCopy = jmin (numChannels, dest.getNumChannels());
+    auto startSample = info.startSample;
+    auto numSamples = info.numSamples;
+
+    while (numSamples > 0)
+    {
+        if (outputReadPos >= numOutputSamples)
+            processFrame();
+
+        const auto numToCopy = jmin (numSamples, numOutputSamples - outputReadPos);
+
+        for (int ch = 0; ch < numChannelsToCopy; ++ch)
+            dest.copyFrom (ch, startSample, outputBuffer, ch, outputReadPos, numToCopy);
+
+        outputReadPos += numToCopy;
+        startSample += numToCopy;
+        numSamples -= numToCopy;
+    }
+
+    for (int ch = numChannelsToCopy; ch < dest.getNumChannels(); ++ch)
+        dest.clear (ch, info.startSample, info.numSamples);
+}
+
+//==============================================================================
+void TimeStretchAudioSource::processFrame()
+{
+    const auto analysisHop = hopSize * speed.load();
+    const auto nominalPos = (int64) std::floor (nextFramePos);
+
+    readInput (nominalPos + searchRange + frameSize);
+
+    const auto framePos = hasPreviousFrame ? nominalPos + findBestOffset (nominalPos)
+                                           : jmax (nominalPos, inputStart);
+
+    const auto frameStart = (int) (framePos - inputStart);
+    jassert (frameStart >= 0 && frameStart + frameSize <= numInputSamples);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* overlap = overlapBuffer.getWritePointer (ch);
+        auto* src = inputBuffer.getReadPointer (ch, frameStart);
+
+        for (int i = 0; i < frameSize; ++i)
+            overlap[i] += src[i] * window[i];
+
+        // The first hop of the accumulator has now had all of its frames added
+        outputBuffer.copyFrom (ch, 0, overlap, hopSize);
+        memmove (overlap, overlap + hopSize, (size_t) (frameSize - hopSize) * sizeof (float));
+        FloatVectorOperations::clear (overlap + frameSize - hopSize, hopSize);
+    }
+
+    outputReadPos = 0;
+    numOutputSamples = hopSize;
+
+    lastFramePos = framePos;
+    hasPreviousFrame = true;
+    nextFramePos += analysisHop;
+
+    // Keep whatever the next search and its comparison target might need
+    discardInputBefore (jmin ((int64) std::floor (nextFramePos) - searchRange, lastFramePos + hopSize));
+}
+
+void TimeStretchAudioSource::readInput (int64 endPosition)
+{
+    for (;;)
+    {
+        const auto numNeeded = endPosition - (inputStart + numInputSamples);
+
+        if (numNeeded <= 0)
+            break;
+
+        const auto numToRead = (int) jmin ((int64) maxInputBlockSize, numNeeded,
+                                           (int64) (inputBuffer.getNumSamples() - numInputSamples));
+
+        if (numToRead <= 0)
+        {
+            jassertfalse; // the input buffer should always be big enough
+            break;
+        }
+
+        AudioSourceChannelInfo readInfo (&inputBuffer, numInputSamples, numToRead);
+        input->getNextAudioBlock (readInfo);
+        numInputSamples += numToRead;
+    }
+}
+
+void TimeStretchAudioSource::discardInputBefore (int64 position)
+{
+    const auto numToDiscard = (int) jlimit ((int64) 0, (int64) numInputSamples, position - inputStart);
+
+    if (numToDiscard == 0)
+        return;
+
+    const auto numToKeep = numInputSamples - numToDiscard;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* data = inputBuffer.getWritePointer (ch);
+        memmove (data, data + numToDiscard, (size_t) numToKeep * sizeof (float));
+    }
+
+    inputStart += numToDiscard;
+    numInputSamples = numToKeep;
+}
+
+int TimeStretchAudioSource::findBestOffset (int64 nominalPos) const
+{
+    // The frame that would follow on seamlessly from the previous one
+    const auto targetPos = lastFramePos + hopSize;
+
+    const auto minOffset = (int) jmax ((int64) -searchRange, inputStart - nominalPos);
+    const auto maxOffset = searchRange;
+
+    // Prefer the nominal position unless something else is a better match, so that
+    // silence or a constant signal doesn't make the frames drift around
+    auto bestOffset = jlimit (minOffset, maxOffset, 0);
+    auto bestSimilarity = getSimilarity (nominalPos + bestOffset, targetPos, 2);
+
+    const auto checkOffset = [&] (int offset, int step)
+    {
+        const auto similarity = getSimilarity (nominalPos + offset, targetPos, step);
+
+        if (similarity > bestSimilarity)
+        {
+            bestSimilarity = similarity;
+            bestOffset = offset;
+        }
+    };
+
+    // A coarse search over the whole range, then a fine one around the best match
+    constexpr int coarseStep = 4;
+
+    for (int offset = minOffset; offset <= maxOffset; offset += coarseStep)
+        checkOffset (offset, 2);
+
+    const auto coarseBest = bestOffset;
+    bestSimilarity = getSimilarity (nominalPos + coarseBest, targetPos, 1);
+
+    for (int offset = jmax (minOffset, coarseBest - coarseStep + 1);
+         offset <= jmin (maxOffset, coarseBest + coarseStep - 1); ++offset)
+        if (offset != coarseBest)
+            checkOffset (offset, 1);
+
+    return bestOffset;
+}
+
+float TimeStretchAudioSource::getSimilarity (int64 candidatePos, int64 targetPos, int step) const
+{
+    const auto candidateStart = (int) (candidatePos - inputStart);
+    const auto targetStart = (int) (targetPos - inputStart);
+
+    double product = 0, candidateEnergy = 0, targetEnergy = 0;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* candidate = inputBuffer.getReadPointer (ch, candidateStart);
+        auto* target = inputBuffer.getReadPointer (ch, targetStart);
+
+        // Only the part that overlaps the previous frame matters
+        for (int i = 0; i < hopSize; i += step)
+        {
+            product += (double) candidate[i] * target[i];
+            candidateEnergy += (double) candidate[i] * candidate[i];
+            targetEnergy += (double) target[i] * target[i];
+        }
+    }
+
+    const auto energy = candidateEnergy * targetEnergy;
+    return energy > 0 ? (float) (product / std::sqrt (energy)) : 0.0f;
+}
+
+} // namespace juce
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AudioSource that changes the speed of its input without changing its pitch.
+
+    This uses WSOLA (waveform-similarity overlap-add): the output is built from
+    overlapping windowed frames of the input, taken from positions that advance through
+    the input faster or slower than the output advances. Each frame's position is nudged
+    slightly so that it lines up with the waveform of the frame before it, which avoids the
+    phasing that a plain overlap-add would cause. It's cheap, has no FFT, and works well
+    for speech and for most music at moderate speed changes, although strongly pitched
+    material may sound slightly rough at extreme speeds.
+
+    The output is delayed by getLatencyInSamples() samples.
+
+    @see ResamplingAudioSource, AudioTransportSource
+
+    @tags{Audio}
+*/
+class JUCE_API  TimeStretchAudioSource  : public AudioSource
+{
+public:
+    //==============================================================================
+    /** Creates a TimeStretchAudioSource for a given input source.
+
+        @param inputSource              the input source to read from
+        @param deleteInputWhenDeleted   if true, the input source will be deleted when
+                                        this object is deleted
+        @param numChannels              the number of channels to process
+    */
+    TimeStretchAudioSource (AudioSource* inputSource,
+                            bool deleteInputWhenDeleted,
+                            int numChannels = 2);
+
+    /** Destructor. */
+    ~TimeStretchAudioSource() override;
+
+    //==============================================================================
+    /** Changes the playback speed.
+
+        This can be called at any time from any thread, including while the source is
+        running. The new speed is picked up at the start of the next output frame.
+
+        @param newSpeed     the number of input samples to play per output sample, so 2.0
+                            plays twice as fast and 0.5 half as fast. This is limited to the
+                            range 0.25 to 4.0.
+    */
+    void setSpeed (double newSpeed) noexcept;
+
+    /** Returns the speed that was set with setSpeed(). */
+    double getSpeed() const noexcept                        { return speed.load(); }
+
+    /** Returns the number of samples by which the output lags the input.
+
+        This depends on the sample rate, so it's only valid after prepareToPlay() has been
+        called.
+    */
+    int getLatencyInSamples() const noexcept                { return hopSize; }
+
+    /** Clears any buffered input and output, e.g. after the input has been repositioned. */
+    void flushBuffers();
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const AudioSourceChannelInfo&) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<AudioSource> input;
+    const int numChannels;
+    std::atomic<double> speed { 1.0 };
+    CriticalSection callbackLock;
+
+    int frameSize = 0, hopSize = 0, searchRange = 0, maxInputBlockSize = 0;
+    HeapBlock<float> window;
+
+    // Input samples, where sample 0 is at position inputStart in the input stream
+    AudioBuffer<float> inputBuffer;
+    int64 inputStart = 0;
+    int numInputSamples = 0;
+
+    // Overlap-add accumulator for the frames, and the finished output waiting to be read
+    AudioBuffer<float> overlapBuffer, outputBuffer;
+    int outputReadPos = 0, numOutputSamples = 0;
+
+    double nextFramePos = 0;
+    int64 lastFramePos = 0;
+    bool hasPreviousFrame = false;
+
+    void processFrame();
+    void readInput (int64 endPosition);
+    void discardInputBefore (int64 position);
+    int findBestOffset (int64 nominalPos) const;
+    float getSimilarity (int64 candidatePos, int64 targetPos, int step) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimeStretchAudioSource)
+};
+
+} // namespace juce
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct TimeStretchAudioSourceTests final : public UnitTest
+{
+    TimeStretchAudioSourceTests()  : UnitTest ("TimeStretchAudioSource", UnitTestCategories::audio)  {}
+
+    // Plays a fixed signal and counts how much of it has been read
+    struct TestSource final : public AudioSource
+    {
+        explicit TestSource (std::function<float (int64)> fn)  : generator (std::move (fn)) {}
+
+        void prepareToPlay (int, double) override {}
+        void releaseResources() override {}
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            for (int i = 0; i < info.numSamples; ++i)
+            {
+                const auto sample = generator (position++);
+
+                for (int ch = 0; ch < info.buffer->getNumChannels(); ++ch)
+                    info.buffer->setSample (ch, info.startSample + i, sample);
+            }
+        }
+
+        std::function<float (int64)> generator;
+        int64 position = 0;
+    };
+
+    static AudioBuffer<float> render (TimeStretchAudioSource& stretcher, int numSamples, int blockSize)
+    {
+        AudioBuffer<float> output (2, numSamples);
+
+        for (int start = 0; start < numSamples; start += blockSize)
+            stretcher.getNextAudioBlock (AudioSourceChannelInfo (&output, start, jmin (blockSize, numSamples - start)));
+
+        return output;
+    }
+
+    static int countZeroCrossings (const AudioBuffer<float>& buffer, int start, int end)
+    {
+        int numCrossings = 0;
+
+        for (int i = start + 1; i < end; ++i)
+            if ((buffer.getSample (0, i - 1) < 0.0f) != (buffer.getSample (0, i) < 0.0f))
+                ++numCrossings;
+
+        return numCrossings;
+    }
+
+    void runTest() override
+    {
+        constexpr auto sampleRate = 44100.0;
+        constexpr auto blockSize = 256;
+        constexpr auto numSamples = 44100;
+
+        beginTest ("At normal speed the output is the delayed input");
+        {
+            Random random (0x1234);
+            std::vector<float> noise (numSamples * 2);
+
+            for (auto& sample : noise)
+                sample = random.nextFloat() * 2.0f - 1.0f;
+
+            auto* source = new TestSource ([&noise] (int64 pos) { return noise[(size_t) pos]; });
+            TimeStretchAudioSource stretcher (source, true);
+            stretcher.prepareToPlay (blockSize, sampleRate);
+
+            const auto latency = stretcher.getLatencyInSamples();
+            expect (latency > 0);
+
+            const auto output = render (stretcher, numSamples, blockSize);
+            auto maxDifference = 0.0f;
+
+            for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                for (int i = latency; i < numSamples; ++i)
+                    maxDifference = jmax (maxDifference, std::abs (output.getSample (ch, i) - noise[(size_t) (i - latency)]));
+
+            expect (maxDifference < 1.0e-5f, "Maximum difference was " + String (maxDifference));
+        }
+
+        beginTest ("Changing the speed keeps the pitch and changes the amount of input read");
+        {
+            for (auto speed : { 0.5, 0.8, 1.5, 2.0 })
+            {
+                auto* source = new TestSource ([] (int64 pos)
+                {
+                    return (float) std::sin (MathConstants<double>::twoPi * 441.0 * (double) pos / sampleRate);
+                });
+
+                TimeStretchAudioSource stretcher (source, true);
+                stretcher.setSpeed (speed);
+                expectEquals (stretcher.getSpeed(), speed);
+                stretcher.prepareToPlay (blockSize, sampleRate);
+
+                const auto output = render (stretcher, numSamples, blockSize);
+
+                // 441Hz crosses zero 882 times a second, whatever the speed
+                const auto numCrossings = countZeroCrossings (output, numSamples / 4, numSamples);
+                expectWithinAbsoluteError (numCrossings, 882 * 3 / 4, 10);
+
+                // Badly aligned frames would partially cancel each other out
+                auto minPeak = 1.0f;
+
+                for (int start = numSamples / 4; start + 200 <= numSamples; start += 200)
+                    minPeak = jmin (minPeak, output.getMagnitude (0, start, 200));
+
+                expectGreaterThan (minPeak, 0.9f);
+
+                const auto expectedInput = speed * numSamples;
+                expectWithinAbsoluteError ((double) source->position, expectedInput, (double) stretcher.getLatencyInSamples() * 4.0);
+            }
+        }
+
+        beginTest ("Flushing restarts the output");
+        {
+            auto* source = new TestSource ([] (int64) { return 0.5f; });
+            TimeStretchAudioSource stretcher (source, true);
+            stretcher.prepareToPlay (blockSize, sampleRate);
+
+            auto output = render (stretcher, blockSize * 16, blockSize);
+            expectEquals (output.getSample (0, blockSize * 16 - 1), 0.5f);
+
+            stretcher.flushBuffers();
+            output = render (stretcher, blockSize, blockSize);
+            expectEquals (output.getSample (0, 0), 0.0f);
+        }
+    }
+};
+
+static TimeStretchAudioSourceTests timeStretchAudioSourceTests;
+
+} // namespace juce
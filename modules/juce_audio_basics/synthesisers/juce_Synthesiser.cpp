@@ -50,6 +50,9 @@ void SynthesiserVoice::clearCurrentNote()
     currentlyPlayingNote = -1;
     currentlyPlayingSound = nullptr;
     currentPlayingMidiChannel = 0;
+
+    if (owner != nullptr)
+        owner->setVoiceTableEntry (*this, -1);
 }
 
 void SynthesiserVoice::aftertouchChanged (int) {}
@@ -81,6 +84,8 @@ Synthesiser::Synthesiser()
 
 Synthesiser::~Synthesiser()
 {
+    for (auto* voice : voices)
+        voice->owner = nullptr;
 }
 
 //==============================================================================
@@ -93,7 +98,12 @@ SynthesiserVoice* Synthesiser::getVoice (const int index) const
 void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
+
+    for (auto* voice : voices)
+        voice->owner = nullptr;
+
     voices.clear();
+    updateVoiceTable();
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
@@ -104,6 +114,8 @@ SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
         const ScopedLock sl (lock);
         newVoice->setCurrentPlaybackSampleRate (sampleRate);
         voice = voices.add (newVoice);
+        activeVoices.ensureStorageAllocated (voices.size());
+        updateVoiceTable();
     }
 
     {
@@ -117,7 +129,64 @@ SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
 void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
+
+    if (auto* voice = voices[index])
+        voice->owner = nullptr;
+
     voices.remove (index);
+    updateVoiceTable();
+}
+
+void Synthesiser::updateVoiceTable()
+{
+    voiceNotes.clearQuick();
+    voiceNotes.ensureStorageAllocated (voices.size());
+
+    for (int i = 0; i < voices.size(); ++i)
+    {
+        auto* voice = voices.getUnchecked (i);
+        voice->owner = this;
+        voice->indexInOwner = i;
+        voiceNotes.add (voice->currentlyPlayingNote);
+    }
+}
+
+bool Synthesiser::isVoiceTableValid() const noexcept
+{
+    if (voiceNotes.size() != voices.size())
+        return false;
+
+    // A subclass may have added, removed or reordered voices without resizing the array
+    for (int i = 0; i < voices.size(); ++i)
+    {
+        const auto* voice = voices.getUnchecked (i);
+
+        if (voice->owner != this || voice->indexInOwner != i)
+            return false;
+    }
+
+    return true;
+}
+
+void Synthesiser::setVoiceTableEntry (const SynthesiserVoice& voice, int midiNoteNumber) noexcept
+{
+    const auto index = voice.indexInOwner;
+
+    // If the voice has moved, the table will be rebuilt before it's next used
+    if (isPositiveAndBelow (index, jmin (voiceNotes.size(), voices.size()))
+         && voices.getUnchecked (index) == &voice)
+        voiceNotes.getReference (index) = midiNoteNumber;
+}
+
+template <typename Callback>
+void Synthesiser::forEachVoicePlayingNote (int midiNoteNumber, Callback&& callback)
+{
+    if (! isVoiceTableValid())
+        updateVoiceTable();
+
+    for (int i = 0; i < voiceNotes.size(); ++i)
+        if (voiceNotes.getUnchecked (i) == midiNoteNumber)
+            callback (voices.getUnchecked (i));
 }
 
 void Synthesiser::clearSounds()
@@ -150,6 +219,18 @@ void Synthesiser::setMinimumRenderingSubdivisionSize (int numSamples, bool shoul
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void Synthesiser::setParallelVoiceRendering (RealtimeThreadPool* pool, int maximumNumChannels, int maximumBlockSize)
+{
+    const ScopedLock sl (lock);
+    parallelRenderer.prepare (pool, maximumNumChannels, maximumBlockSize);
+    activeVoices.ensureStorageAllocated (voices.size());
+}
+
+bool Synthesiser::isRenderingVoicesInParallel() const noexcept
+{
+    return parallelRenderer.isPrepared();
+}
+
 //==============================================================================
 void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 {
@@ -239,14 +320,35 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
     processNextBlock (outputAudio, inputMidi, startSample, numSamples);
 }
 
+template <typename floatType>
+bool Synthesiser::renderVoicesInParallel (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
+{
+    if (! parallelRenderer.isPrepared())
+        return false;
+
+    activeVoices.clearQuick();
+
+    for (auto* voice : voices)
+        if (voice->isVoiceActive())
+            activeVoices.add (voice);
+
+    return parallelRenderer.renderVoices (activeVoices, buffer, startSample, numSamples);
+}
+
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
+    if (renderVoicesInParallel (buffer, startSample, numSamples))
+        return;
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    if (renderVoicesInParallel (buffer, startSample, numSamples))
+        return;
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
@@ -304,9 +406,11 @@ void Synthesiser::noteOn (const int midiChannel,
         {
             // If hitting a note that's still ringing, stop it first (it could be
             // still playing because of the sustain or sostenuto pedal).
-            for (auto* voice : voices)
-                if (voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel (midiChannel))
+            forEachVoicePlayingNote (midiNoteNumber, [&] (SynthesiserVoice* voice)
+            {
+                if (voice->isPlayingChannel (midiChannel))
                     stopVoice (voice, 1.0f, true);
+            });
 
             startVoice (findFreeVoice (sound, midiChannel, midiNoteNumber, shouldStealNotes),
                         sound, midiChannel, midiNoteNumber, velocity);
@@ -329,6 +433,10 @@ void Synthesiser::startVoice (SynthesiserVoice* const voice,
         voice->currentPlayingMidiChannel = midiChannel;
         voice->noteOnTime = ++lastNoteOnCounter;
         voice->currentlyPlayingSound = sound;
+
+        if (voice->owner == this)
+            setVoiceTableEntry (*voice, midiNoteNumber);
+
         voice->setKeyDown (true);
         voice->setSostenutoPedalDown (false);
         voice->setSustainPedalDown (sustainPedalsDown[midiChannel]);
@@ -355,10 +463,9 @@ void Synthesiser::noteOff (const int midiChannel,
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (midiNoteNumber, [&] (SynthesiserVoice* voice)
     {
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber
-              && voice->isPlayingChannel (midiChannel))
+        if (voice->isPlayingChannel (midiChannel))
         {
             if (auto sound = voice->getCurrentlyPlayingSound())
             {
@@ -374,7 +481,7 @@ void Synthesiser::noteOff (const int midiChannel,
                 }
             }
         }
-    }
+    });
 }
 
 void Synthesiser::allNotesOff (const int midiChannel, const bool allowTailOff)
@@ -420,10 +527,11 @@ void Synthesiser::handleAftertouch (int midiChannel, int midiNoteNumber, int aft
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber
-              && (midiChannel <= 0 || voice->isPlayingChannel (midiChannel)))
+    forEachVoicePlayingNote (midiNoteNumber, [&] (SynthesiserVoice* voice)
+    {
+        if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
             voice->aftertouchChanged (aftertouchValue);
+    });
 }
 
 void Synthesiser::handleChannelPressure (int midiChannel, int channelPressureValue)
@@ -500,9 +608,32 @@ SynthesiserVoice* Synthesiser::findFreeVoice (SynthesiserSound* soundToPlay,
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
-            return voice;
+    // Voices that aren't playing a note are almost always the free ones, so try those
+    // first. Then give the others a chance, in case a voice's isVoiceActive() override
+    // reports that it has finished without clearing its note.
+    const auto tableSize = isVoiceTableValid() ? voiceNotes.size() : 0;
+
+    for (int i = 0; i < tableSize; ++i)
+    {
+        if (voiceNotes.getUnchecked (i) < 0)
+        {
+            auto* voice = voices.getUnchecked (i);
+
+            if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
+                return voice;
+        }
+    }
+
+    for (int i = 0; i < voices.size(); ++i)
+    {
+        if (i >= tableSize || voiceNotes.getUnchecked (i) >= 0)
+        {
+            auto* voice = voices.getUnchecked (i);
+
+            if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
+                return voice;
+        }
+    }
 
     if (stealIfNoneAvailable)
         return findVoiceToSteal (soundToPlay, midiChannel, midiNoteNumber);
@@ -540,15 +671,6 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
 
             usableVoicesToStealArray.add (voice);
 
-            // NB: Using a functor rather than a lambda here due to scare-stories about
-            // compilers generating code containing heap allocations..
-            struct Sorter
-            {
-                bool operator() (const SynthesiserVoice* a, const SynthesiserVoice* b) const noexcept { return a->wasStartedBefore (*b); }
-            };
-
-            std::sort (usableVoicesToStealArray.begin(), usableVoicesToStealArray.end(), Sorter());
-
             if (! voice->isPlayingButReleased()) // Don't protect released notes
             {
                 auto note = voice->getCurrentlyPlayingNote();
@@ -562,6 +684,15 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
         }
     }
 
+    // NB: Using a functor rather than a lambda here due to scare-stories about
+    // compilers generating code containing heap allocations..
+    struct Sorter
+    {
+        bool operator() (const SynthesiserVoice* a, const SynthesiserVoice* b) const noexcept { return a->wasStartedBefore (*b); }
+    };
+
+    std::sort (usableVoicesToStealArray.begin(), usableVoicesToStealArray.end(), Sorter());
+
     // Eliminate pathological cases (ie: only 1 note playing): we always give precedence to the lowest note(s)
     if (top == low)
         top = nullptr;
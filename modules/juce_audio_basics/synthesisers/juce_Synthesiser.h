@@ -72,6 +72,7 @@ private:
     JUCE_LEAK_DETECTOR (SynthesiserSound)
 };
 
+class Synthesiser;
 
 //==============================================================================
 /**
@@ -266,6 +267,8 @@ private:
     //==============================================================================
     friend class Synthesiser;
 
+    Synthesiser* owner = nullptr;
+    int indexInOwner = -1;
     double currentSampleRate = 44100.0;
     int currentlyPlayingNote = -1, currentPlayingMidiChannel = 0;
     uint32 noteOnTime = 0;
@@ -557,11 +560,44 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    /** Enables rendering the voices in parallel, using the threads of a RealtimeThreadPool.
+
+        When this is enabled, the default implementation of renderVoices() will share the active
+        voices between the threads of the pool. Each thread renders its voices into a scratch
+        buffer, and the scratch buffers are then added to the output. The audio is still split
+        into sub-blocks at each midi event, so note timing is just as accurate as when rendering
+        serially.
+
+        The result may differ very slightly from serial rendering, because the samples are
+        summed in a different order, but for a given pool it will always be the same. In this
+        mode only voices for which isVoiceActive() returns true will be rendered, and they'll
+        be asked to render from the start of the scratch buffer rather than at the start sample
+        of the output. Voices will be rendered concurrently, so they mustn't modify any state
+        that they share with other voices.
+
+        Blocks with more than maximumNumChannels channels or maximumBlockSize samples will be
+        rendered serially. Pass a nullptr pool to go back to serial rendering.
+
+        This allocates memory, so it should be called from somewhere like prepareToPlay() rather
+        than from the audio thread. The pool must remain valid until parallel rendering has been
+        disabled, or the synthesiser has been deleted.
+
+        @see ParallelVoiceRenderer
+    */
+    void setParallelVoiceRendering (RealtimeThreadPool* pool, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns true if setParallelVoiceRendering() has been called with a prepared pool. */
+    bool isRenderingVoicesInParallel() const noexcept;
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
     CriticalSection lock;
 
+    /** The voices. If a subclass modifies this array directly rather than using addVoice(),
+        removeVoice() and clearVoices(), the synth will notice the next time it looks up a
+        note, and will rebuild its table of the notes that each voice is playing.
+    */
     OwnedArray<SynthesiserVoice> voices;
     ReferenceCountedArray<SynthesiserSound> sounds;
 
@@ -621,6 +657,8 @@ protected:
 
 private:
     //==============================================================================
+    friend class SynthesiserVoice;
+
     double sampleRate = 0;
     uint32 lastNoteOnCounter = 0;
     int minimumSubBlockSize = 32;
@@ -629,10 +667,29 @@ private:
     BigInteger sustainPedalsDown;
     mutable CriticalSection stealLock;
     mutable Array<SynthesiserVoice*> usableVoicesToStealArray;
+    ParallelVoiceRenderer parallelRenderer;
+    Array<SynthesiserVoice*> activeVoices;
+
+    // The note each voice is playing, indexed like the voices array, so that finding
+    // voices by note or finding a free voice is a scan through a packed array rather
+    // than a visit to every voice object. Voices update their own entries when they
+    // start and clear their notes, so entries for different voices may be written by
+    // different rendering threads; that's why this isn't a bitset.
+    Array<int> voiceNotes;
+
+    void updateVoiceTable();
+    bool isVoiceTableValid() const noexcept;
+    void setVoiceTableEntry (const SynthesiserVoice&, int midiNoteNumber) noexcept;
+
+    template <typename Callback>
+    void forEachVoicePlayingNote (int midiNoteNumber, Callback&&);
 
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
+    template <typename floatType>
+    bool renderVoicesInParallel (AudioBuffer<floatType>&, int startSample, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Synthesiser)
 };
 
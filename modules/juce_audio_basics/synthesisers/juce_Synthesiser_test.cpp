@@ -0,0 +1,380 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct SynthesiserTests final : public UnitTest
+{
+    SynthesiserTests()  : UnitTest ("Synthesiser", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr auto numChannels = 2;
+        constexpr auto blockSize = 256;
+        constexpr auto numBlocks = 8;
+
+        RealtimeThreadPool pool (RealtimeThreadPool::Options{}.withNumberOfThreads (3));
+
+        MidiBuffer midi;
+
+        for (int note = 0; note < 12; ++note)
+            midi.addEvent (MidiMessage::noteOn (1, 48 + note * 3, 0.1f + (float) note * 0.05f), note * 37);
+
+        for (int note = 0; note < 6; ++note)
+            midi.addEvent (MidiMessage::noteOff (1, 48 + note * 3), 700 + note * 101);
+
+        const auto render = [&] (auto& synth, auto sample, bool parallel)
+        {
+            using FloatType = decltype (sample);
+
+            synth.setCurrentPlaybackSampleRate (44100.0);
+            synth.setParallelVoiceRendering (parallel ? &pool : nullptr, numChannels, blockSize);
+            expect (synth.isRenderingVoicesInParallel() == parallel);
+
+            AudioBuffer<FloatType> output (numChannels, blockSize * numBlocks);
+            output.clear();
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                MidiBuffer blockMidi;
+                blockMidi.addEvents (midi, block * blockSize, blockSize, -block * blockSize);
+
+                AudioBuffer<FloatType> view (output.getArrayOfWritePointers(), numChannels, block * blockSize, blockSize);
+                synth.renderNextBlock (view, blockMidi, 0, blockSize);
+            }
+
+            synth.setParallelVoiceRendering (nullptr, 0, 0);
+            return output;
+        };
+
+        const auto expectMatches = [&] (const auto& a, const auto& b, double tolerance)
+        {
+            auto maxDifference = 0.0;
+
+            for (int channel = 0; channel < a.getNumChannels(); ++channel)
+                for (int i = 0; i < a.getNumSamples(); ++i)
+                    maxDifference = jmax (maxDifference, std::abs ((double) a.getSample (channel, i) - (double) b.getSample (channel, i)));
+
+            expect (maxDifference <= tolerance, "Maximum difference was " + String (maxDifference));
+        };
+
+        beginTest ("Parallel voice rendering matches serial rendering");
+        {
+            Synthesiser serial, parallel, repeat;
+
+            for (auto* synth : { &serial, &parallel, &repeat })
+            {
+                synth->addSound (new TestSound());
+
+                for (int i = 0; i < 16; ++i)
+                    synth->addVoice (new TestVoice());
+            }
+
+            const auto serialOutput   = render (serial,   0.0f, false);
+            const auto parallelOutput = render (parallel, 0.0f, true);
+            const auto repeatOutput   = render (repeat,   0.0f, true);
+
+            expect (serialOutput.getMagnitude (0, serialOutput.getNumSamples()) > 0.1f);
+            expectMatches (serialOutput, parallelOutput, 1.0e-5);
+            expectMatches (parallelOutput, repeatOutput, 0.0);
+        }
+
+        beginTest ("Parallel voice rendering works with double precision");
+        {
+            Synthesiser serial, parallel;
+
+            for (auto* synth : { &serial, &parallel })
+            {
+                synth->addSound (new TestSound());
+
+                for (int i = 0; i < 16; ++i)
+                    synth->addVoice (new TestVoice());
+            }
+
+            expectMatches (render (serial, 0.0, false), render (parallel, 0.0, true), 1.0e-12);
+        }
+
+        beginTest ("ParallelVoiceRenderer renders every group, and matches serial rendering");
+        {
+            for (auto numThreads : { 1, 2, 3, 7 })
+            {
+                RealtimeThreadPool groupPool (RealtimeThreadPool::Options{}.withNumberOfThreads (numThreads));
+
+                ParallelVoiceRenderer renderer;
+                renderer.prepare (&groupPool, numChannels, blockSize);
+                expect (renderer.isPrepared());
+
+                OwnedArray<CountingVoice> voices;
+
+                for (int i = 0; i < 13; ++i)
+                    voices.add (new CountingVoice ((float) (i + 1)));
+
+                AudioBuffer<float> serialOutput (numChannels, blockSize), parallelOutput (numChannels, blockSize);
+                serialOutput.clear();
+                parallelOutput.clear();
+
+                for (auto* voice : voices)
+                    voice->renderNextBlock (serialOutput, 10, blockSize - 10);
+
+                expect (renderer.renderVoices (voices, parallelOutput, 10, blockSize - 10));
+
+                for (auto* voice : voices)
+                    expectEquals (voice->numRenders.load(), 2);
+
+                expectMatches (serialOutput, parallelOutput, 0.0);
+            }
+        }
+
+        beginTest ("Voices are found, freed and stolen by note");
+        {
+            Synthesiser synth;
+            synth.addSound (new TestSound());
+
+            for (int i = 0; i < 4; ++i)
+                synth.addVoice (new TestVoice());
+
+            synth.setCurrentPlaybackSampleRate (44100.0);
+
+            const auto findVoicePlaying = [&synth] (int note) -> SynthesiserVoice*
+            {
+                for (int i = 0; i < synth.getNumVoices(); ++i)
+                    if (synth.getVoice (i)->getCurrentlyPlayingNote() == note)
+                        return synth.getVoice (i);
+
+                return nullptr;
+            };
+
+            for (int note = 60; note < 64; ++note)
+                synth.noteOn (1, note, 1.0f);
+
+            for (int i = 0; i < synth.getNumVoices(); ++i)
+                expectEquals (synth.getVoice (i)->getCurrentlyPlayingNote(), 60 + i);
+
+            // A note stopped without a tail frees its voice for the next note
+            auto* voice = findVoicePlaying (61);
+            synth.noteOff (1, 61, 1.0f, false);
+            expect (! voice->isVoiceActive());
+
+            synth.noteOn (1, 70, 1.0f);
+            expect (findVoicePlaying (70) == voice);
+
+            // Removing a voice shifts the others, which must still be found by note
+            synth.removeVoice (0);
+            expect (findVoicePlaying (60) == nullptr);
+
+            synth.noteOff (1, 62, 1.0f, false);
+            expect (findVoicePlaying (62) == nullptr);
+
+            synth.noteOn (1, 72, 1.0f);
+            expect (findVoicePlaying (72) != nullptr);
+
+            // With every voice busy, the oldest note that isn't the lowest or highest is stolen
+            voice = findVoicePlaying (70);
+            synth.noteOn (1, 65, 1.0f);
+            expect (findVoicePlaying (65) == voice);
+            expect (findVoicePlaying (63) != nullptr);
+            expect (findVoicePlaying (72) != nullptr);
+        }
+
+        beginTest ("Voices are found by note after a subclass reorders them directly");
+        {
+            struct ReorderingSynth final : public Synthesiser
+            {
+                void swapVoices (int a, int b)                      { voices.swap (a, b); }
+                void replaceVoice (int index, SynthesiserVoice* v)  { voices.set (index, v); }
+            };
+
+            ReorderingSynth synth;
+            synth.addSound (new TestSound());
+
+            for (int i = 0; i < 4; ++i)
+                synth.addVoice (new TestVoice());
+
+            synth.setCurrentPlaybackSampleRate (44100.0);
+
+            for (int note = 60; note < 64; ++note)
+                synth.noteOn (1, note, 1.0f);
+
+            // The table is the same size, but every index in it is now wrong
+            synth.swapVoices (0, 3);
+            synth.swapVoices (1, 2);
+
+            for (int note = 60; note < 64; ++note)
+            {
+                synth.noteOff (1, note, 1.0f, false);
+
+                for (int i = 0; i < synth.getNumVoices(); ++i)
+                    expect (synth.getVoice (i)->getCurrentlyPlayingNote() != note);
+            }
+
+            synth.noteOn (1, 70, 1.0f);
+
+            auto* replacement = new TestVoice();
+            replacement->setCurrentPlaybackSampleRate (44100.0);
+            synth.replaceVoice (0, replacement);
+
+            synth.noteOn (1, 71, 1.0f);
+            synth.noteOff (1, 70, 1.0f, false);
+            synth.noteOff (1, 71, 1.0f, false);
+
+            for (int i = 0; i < synth.getNumVoices(); ++i)
+                expect (! synth.getVoice (i)->isVoiceActive());
+        }
+
+        beginTest ("Parallel MPE voice rendering matches serial rendering");
+        {
+            MPESynthesiser serial, parallel;
+
+            for (auto* synth : { &serial, &parallel })
+            {
+                synth->enableLegacyMode();
+
+                for (int i = 0; i < 16; ++i)
+                    synth->addVoice (new TestMPEVoice());
+            }
+
+            const auto serialOutput   = render (serial,   0.0f, false);
+            const auto parallelOutput = render (parallel, 0.0f, true);
+
+            expect (serialOutput.getMagnitude (0, serialOutput.getNumSamples()) > 0.1f);
+            expectMatches (serialOutput, parallelOutput, 1.0e-5);
+        }
+    }
+
+private:
+    struct TestSound final : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    /*  Renders a sine at the note's frequency, and a decaying tail once the note has
+        been released, so that the output depends on exactly where each event lands.
+    */
+    struct TestVoice final : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            phase = 0.0;
+            level = velocity;
+            tail = 1.0;
+            delta = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (note) / getSampleRate();
+        }
+
+        void stopNote (float, bool allowTailOff) override
+        {
+            if (allowTailOff)
+                tail = 0.999;
+            else
+                clearCurrentNote();
+        }
+
+        void pitchWheelMoved (int) override {}
+        void controllerMoved (int, int) override {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override     { render (buffer, startSample, numSamples); }
+        void renderNextBlock (AudioBuffer<double>& buffer, int startSample, int numSamples) override    { render (buffer, startSample, numSamples); }
+
+        template <typename FloatType>
+        void render (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+        {
+            if (! isVoiceActive())
+                return;
+
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                const auto sample = (FloatType) (std::sin (phase) * level);
+                phase += delta;
+                level *= tail;
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.addSample (channel, i, sample);
+            }
+        }
+
+        double phase = 0.0, delta = 0.0, level = 0.0, tail = 1.0;
+    };
+
+    /*  Adds a constant to the buffer, and counts how many times it has been rendered. */
+    struct CountingVoice final : public SynthesiserVoice
+    {
+        explicit CountingVoice (float valueToAdd)  : value (valueToAdd) {}
+
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+        void startNote (int, float, SynthesiserSound*, int) override {}
+        void stopNote (float, bool) override {}
+        void pitchWheelMoved (int) override {}
+        void controllerMoved (int, int) override {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            ++numRenders;
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                FloatVectorOperations::add (buffer.getWritePointer (channel, startSample), value, numSamples);
+        }
+
+        void renderNextBlock (AudioBuffer<double>&, int, int) override {}
+
+        const float value;
+        std::atomic<int> numRenders { 0 };
+    };
+
+    struct TestMPEVoice final : public MPESynthesiserVoice
+    {
+        void noteStarted() override
+        {
+            phase = 0.0;
+            level = currentlyPlayingNote.noteOnVelocity.asUnsignedFloat();
+            delta = MathConstants<double>::twoPi * currentlyPlayingNote.getFrequencyInHertz() / currentSampleRate;
+        }
+
+        void noteStopped (bool) override                { clearCurrentNote(); }
+        void notePressureChanged() override {}
+        void notePitchbendChanged() override {}
+        void noteTimbreChanged() override {}
+        void noteKeyStateChanged() override {}
+
+        using MPESynthesiserVoice::renderNextBlock;
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                const auto sample = (float) (std::sin (phase) * level);
+                phase += delta;
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.addSample (channel, i, sample);
+            }
+        }
+
+        double phase = 0.0, delta = 0.0, level = 0.0;
+    };
+};
+
+static SynthesiserTests synthesiserTests;
+
+} // namespace juce
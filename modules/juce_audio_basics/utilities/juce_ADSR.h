@@ -29,7 +29,8 @@ namespace juce
 
     To use it, call setSampleRate() with the current sample rate and give it some parameters
     with setParameters() then call getNextSample() to get the envelope value to be applied
-    to each audio sample or applyEnvelopeToBuffer() to apply the envelope to a whole buffer.
+    to each audio sample, renderEnvelope() to get a block of envelope values, or
+    applyEnvelopeToBuffer() to apply the envelope to a whole buffer.
 
     Do not change the parameters during playback. If you change the parameters before the
     release stage has completed then you must call reset() before the next call to
@@ -210,10 +211,62 @@ public:
         return envelopeVal;
     }
 
+    /** Writes the next numSamples envelope values into an array.
+
+        This produces the same envelope as calling getNextSample() numSamples times, but
+        works out where each stage ends once per block and fills the stages with ramps
+        that the compiler can vectorise, which is much cheaper when rendering many voices.
+        Because the end of each stage is calculated rather than accumulated, it may land
+        one sample away from where getNextSample() would put it.
+
+        @see getNextSample, applyEnvelopeToBuffer
+    */
+    void renderEnvelope (float* dest, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0);
+
+        while (numSamples > 0)
+        {
+            switch (state)
+            {
+                case State::idle:
+                {
+                    FloatVectorOperations::clear (dest, numSamples);
+                    return;
+                }
+
+                case State::attack:
+                {
+                    renderStage (dest, numSamples, attackRate, 1.0f);
+                    break;
+                }
+
+                case State::decay:
+                {
+                    renderStage (dest, numSamples, -decayRate, parameters.sustain);
+                    break;
+                }
+
+                case State::sustain:
+                {
+                    envelopeVal = parameters.sustain;
+                    FloatVectorOperations::fill (dest, envelopeVal, numSamples);
+                    return;
+                }
+
+                case State::release:
+                {
+                    renderStage (dest, numSamples, -releaseRate, 0.0f);
+                    break;
+                }
+            }
+        }
+    }
+
     /** This method will conveniently apply the next numSamples number of envelope values
         to an AudioBuffer.
 
-        @see getNextSample
+        @see getNextSample, renderEnvelope
     */
     template <typename FloatType>
     void applyEnvelopeToBuffer (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
@@ -232,21 +285,61 @@ public:
             return;
         }
 
-        auto numChannels = buffer.getNumChannels();
+        constexpr int chunkSize = 64;
+        float envelope[chunkSize];
 
-        while (--numSamples >= 0)
+        for (int offset = 0; offset < numSamples; offset += chunkSize)
         {
-            auto env = getNextSample();
+            const auto numInChunk = jmin (chunkSize, numSamples - offset);
+            renderEnvelope (envelope, numInChunk);
 
-            for (int i = 0; i < numChannels; ++i)
-                buffer.getWritePointer (i)[startSample] *= env;
+            for (int i = 0; i < buffer.getNumChannels(); ++i)
+            {
+                auto* samples = buffer.getWritePointer (i, startSample + offset);
 
-            ++startSample;
+                if constexpr (std::is_same_v<FloatType, float>)
+                {
+                    FloatVectorOperations::multiply (samples, envelope, numInChunk);
+                }
+                else
+                {
+                    for (int j = 0; j < numInChunk; ++j)
+                        samples[j] *= (FloatType) envelope[j];
+                }
+            }
         }
     }
 
 private:
     //==============================================================================
+    // Fills as much of the current stage as fits in the block, moving on to the next
+    // stage if this one ends. The value changes by rate per sample until it reaches
+    // endValue, exactly as it would in getNextSample().
+    void renderStage (float*& dest, int& numSamples, float rate, float endValue) noexcept
+    {
+        // A zero rate can only happen when releasing from zero, which ends straight away
+        const auto samplesToEnd = ! exactlyEqual (rate, 0.0f) ? std::ceil ((endValue - envelopeVal) / rate) : 1.0f;
+        const auto reachesEnd = samplesToEnd <= (float) numSamples;
+        const auto numInStage = reachesEnd ? jmax (1, (int) samplesToEnd) : numSamples;
+        const auto startVal = envelopeVal;
+
+        for (int i = 0; i < numInStage; ++i)
+            dest[i] = startVal + rate * (float) (i + 1);
+
+        if (reachesEnd)
+        {
+            dest[numInStage - 1] = envelopeVal = endValue;
+            goToNextState();
+        }
+        else
+        {
+            envelopeVal = dest[numInStage - 1];
+        }
+
+        dest += numInStage;
+        numSamples -= numInStage;
+    }
+
     void recalculateRates() noexcept
     {
         auto getRate = [] (float distance, float timeInSeconds, double sr)
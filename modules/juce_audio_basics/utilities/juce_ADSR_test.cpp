@@ -177,6 +177,44 @@ struct ADSRTests final : public UnitTest
 
             expect (! adsr.isActive());
         }
+
+        beginTest ("Rendering blocks matches rendering single samples");
+        {
+            ADSR blockAdsr, sampleAdsr;
+
+            for (auto* a : { &blockAdsr, &sampleAdsr })
+            {
+                a->setSampleRate (1000.0);
+                a->setParameters ({ 0.05f, 0.1f, 0.3f, 0.2f });
+                a->noteOn();
+            }
+
+            std::vector<float> envelope (500);
+            int start = 0;
+
+            // Use uneven block sizes, and release part way through a block
+            for (auto blockSize : { 1, 17, 64, 3, 115, 10, 250, 40 })
+            {
+                if (start == 200)
+                    blockAdsr.noteOff();
+
+                blockAdsr.renderEnvelope (envelope.data() + start, blockSize);
+                start += blockSize;
+            }
+
+            // The end of a stage may land one sample away from where getNextSample() puts
+            // it, so allow for the largest single step, which is in the attack stage
+            for (size_t i = 0; i < envelope.size(); ++i)
+            {
+                if (i == 200)
+                    sampleAdsr.noteOff();
+
+                expectWithinAbsoluteError (envelope[i], sampleAdsr.getNextSample(), 0.021f);
+            }
+
+            expect (! blockAdsr.isActive());
+            expect (! sampleAdsr.isActive());
+        }
     }
 
     static void advanceADSR (ADSR& adsr, int numSamplesToAdvance)
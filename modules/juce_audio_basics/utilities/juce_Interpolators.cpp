@@ -175,6 +175,7 @@ public:
     void runTest() override
     {
         runInterplatorTests<WindowedSincInterpolator> ("WindowedSincInterpolator");
+        runInterplatorTests<PolyphaseSincInterpolator> ("PolyphaseSincInterpolator");
         runInterplatorTests<LagrangeInterpolator>     ("LagrangeInterpolator");
         runInterplatorTests<CatmullRomInterpolator>   ("CatmullRomInterpolator");
         runInterplatorTests<LinearInterpolator>       ("LinearInterpolator");
@@ -132,6 +132,14 @@ private:
         }
     };
 
+    struct PolyphaseSincTraits
+    {
+        static constexpr int numTaps = 32;
+        static constexpr float algorithmicLatency = (float) (numTaps / 2);
+
+        static float valueAtOffset (const float*, float, int) noexcept;
+    };
+
     struct ZeroOrderHoldTraits
     {
         static constexpr float algorithmicLatency = 0.0f;
@@ -144,6 +152,7 @@ private:
 
 public:
     using WindowedSinc  = GenericInterpolator<WindowedSincTraits,  200>;
+    using PolyphaseSinc = GenericInterpolator<PolyphaseSincTraits, PolyphaseSincTraits::numTaps>;
     using Lagrange      = GenericInterpolator<LagrangeTraits,      5>;
     using CatmullRom    = GenericInterpolator<CatmullRomTraits,    4>;
     using Linear        = GenericInterpolator<LinearTraits,        2>;
@@ -170,6 +179,28 @@ public:
 */
 using WindowedSincInterpolator = Interpolators::WindowedSinc;
 
+/**
+    An interpolator for resampling a stream of floats using a bank of precomputed
+    32-tap windowed sinc filters.
+
+    This gives a similar quality to WindowedSincInterpolator at a fraction of the
+    cost, and with a much lower latency.
+
+    Note that the resampler is stateful, so when there's a break in the continuity
+    of the input stream you're feeding it, you should call reset() before feeding
+    it any new data. And like with any other stateful filter, if you're resampling
+    multiple channels, make sure each one uses its own interpolator object, or use
+    PolyphaseResampler, which handles several channels at once.
+
+    @see GenericInterpolator, PolyphaseResampler
+
+    @see LagrangeInterpolator, CatmullRomInterpolator, LinearInterpolator,
+         ZeroOrderHoldInterpolator
+
+    @tags{Audio}
+*/
+using PolyphaseSincInterpolator = Interpolators::PolyphaseSinc;
+
 /**
     An interpolator for resampling a stream of floats using 4-point lagrange interpolation.
 
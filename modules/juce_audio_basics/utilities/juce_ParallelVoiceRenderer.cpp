@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+void ParallelVoiceRenderer::prepare (RealtimeThreadPool* newPool, int maximumNumChannels, int maximumBlockSize)
+{
+    if (newPool == nullptr || ! newPool->isPrepared())
+    {
+        release();
+        return;
+    }
+
+    pool = newPool;
+    maxNumGroups = pool->getNumThreads() + 1;
+    maxNumChannels = jmax (1, maximumNumChannels);
+    maxBlockSize = jmax (1, maximumBlockSize);
+
+    floatScratch .setSize (maxNumGroups * maxNumChannels, maxBlockSize);
+    doubleScratch.setSize (maxNumGroups * maxNumChannels, maxBlockSize);
+}
+
+void ParallelVoiceRenderer::release()
+{
+    pool = nullptr;
+    maxNumGroups = maxNumChannels = maxBlockSize = 0;
+    floatScratch .setSize (0, 0);
+    doubleScratch.setSize (0, 0);
+}
+
+} // namespace juce
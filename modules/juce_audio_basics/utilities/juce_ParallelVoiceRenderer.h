@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders a set of synthesiser voices in parallel on a RealtimeThreadPool.
+
+    The voices are split into contiguous groups, and each group is rendered by a separate
+    job into its own scratch buffer. Once all the jobs have finished, the scratch buffers are
+    added to the output in group order. The order in which samples are summed only depends on
+    the order of the voices passed to renderVoices() and on the number of threads in the pool,
+    so the output is identical from one run to the next.
+
+    This is used by Synthesiser and MPESynthesiser, but you can also use it to render the
+    voices of a custom synth.
+
+    @see Synthesiser::setParallelVoiceRendering, MPESynthesiser::setParallelVoiceRendering
+
+    @tags{Audio}
+*/
+class JUCE_API  ParallelVoiceRenderer
+{
+public:
+    //==============================================================================
+    /** Creates a renderer that isn't prepared, and so won't render anything. */
+    ParallelVoiceRenderer() = default;
+
+    /** Prepares to render voices using the given pool.
+
+        This allocates scratch buffers that are large enough for each thread in the pool to
+        render maximumNumChannels channels of maximumBlockSize samples, so it shouldn't be
+        called on the audio thread. The pool must not be deleted while the renderer is still
+        using it. Passing a nullptr pool is the same as calling release().
+    */
+    void prepare (RealtimeThreadPool* pool, int maximumNumChannels, int maximumBlockSize);
+
+    /** Stops using the pool, and frees the scratch buffers. */
+    void release();
+
+    /** Returns true if prepare() has been called with a pool, and release() hasn't been called. */
+    bool isPrepared() const noexcept                    { return pool != nullptr; }
+
+    //==============================================================================
+    /** Renders voices into a region of an audio buffer, adding to its existing contents.
+
+        The voices are passed as an Array (or similar container) of pointers.
+
+        Each voice is rendered by calling its renderNextBlock() method with a scratch buffer
+        which has the same number of channels as the output, a start sample of 0 and a length
+        of numSamples. The voices will be rendered concurrently, so they must not modify any
+        state that is shared with other voices.
+
+        If the renderer isn't prepared, if the block is larger than the scratch buffers, or if
+        there are too few voices for parallel rendering to be worthwhile, this does nothing and
+        returns false. In that case the caller should render the voices itself.
+    */
+    template <typename VoiceArray, typename FloatType>
+    bool renderVoices (const VoiceArray& voicesToRender,
+                       AudioBuffer<FloatType>& outputAudio,
+                       int startSample,
+                       int numSamples)
+    {
+        const auto numChannels = outputAudio.getNumChannels();
+        const auto numVoices = (int) voicesToRender.size();
+        const auto numGroups = jmin (maxNumGroups, numVoices);
+
+        if (pool == nullptr || numGroups < 2 || numSamples <= 0
+             || numChannels > maxNumChannels || numSamples > maxBlockSize)
+            return false;
+
+        auto& scratch = getScratchBuffer ((FloatType*) nullptr);
+
+        const auto renderGroup = [&] (int group)
+        {
+            AudioBuffer<FloatType> groupBuffer (scratch.getArrayOfWritePointers() + group * numChannels,
+                                                numChannels,
+                                                numSamples);
+            groupBuffer.clear();
+
+            const auto begin = (numVoices * group) / numGroups;
+            const auto end   = (numVoices * (group + 1)) / numGroups;
+
+            for (auto i = begin; i < end; ++i)
+                voicesToRender[i]->renderNextBlock (groupBuffer, 0, numSamples);
+        };
+
+        // Every group is queued, so that the workers are woken before any rendering starts,
+        // and the calling thread picks up its share of the groups from inside runJobsAndWait()
+        for (int group = 0; group < numGroups; ++group)
+            pool->addJob ([&renderGroup, group] { renderGroup (group); });
+
+        pool->runJobsAndWait();
+
+        for (int group = 0; group < numGroups; ++group)
+            for (int channel = 0; channel < numChannels; ++channel)
+                FloatVectorOperations::add (outputAudio.getWritePointer (channel, startSample),
+                                            scratch.getReadPointer (group * numChannels + channel),
+                                            numSamples);
+
+        return true;
+    }
+
+private:
+    //==============================================================================
+    AudioBuffer<float>&  getScratchBuffer (float*) noexcept     { return floatScratch; }
+    AudioBuffer<double>& getScratchBuffer (double*) noexcept    { return doubleScratch; }
+
+    RealtimeThreadPool* pool = nullptr;
+    int maxNumGroups = 0, maxNumChannels = 0, maxBlockSize = 0;
+    AudioBuffer<float> floatScratch;
+    AudioBuffer<double> doubleScratch;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelVoiceRenderer)
+};
+
+} // namespace juce
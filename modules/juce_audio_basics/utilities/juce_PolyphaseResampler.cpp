@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+static double besselI0 (double x) noexcept
+{
+    const auto halfX = x * 0.5;
+    double sum = 1.0, term = 1.0;
+
+    for (int k = 1; k < 64 && term > sum * 1.0e-12; ++k)
+    {
+        const auto factor = halfX / (double) k;
+        term *= factor * factor;
+        sum += term;
+    }
+
+    return sum;
+}
+
+//==============================================================================
+PolyphaseResampler::FilterBank::FilterBank (int taps, int phases, double newCutoff)
+    : numTaps ((jmax (4, taps) + 3) & ~3),
+      numPhases (jmax (1, phases)),
+      filters ((size_t) ((numPhases + 1) * numTaps)),
+      differences ((size_t) (numPhases * numTaps))
+{
+    setCutoff (newCutoff);
+}
+
+void PolyphaseResampler::FilterBank::setCutoff (double newCutoff) noexcept
+{
+    // A Kaiser window with this beta gives roughly 80dB of stop-band rejection
+    constexpr double beta = 8.0;
+
+    cutoff = jlimit (0.01, 1.0, newCutoff);
+
+    const auto halfLength = numTaps / 2;
+    const auto windowScale = 1.0 / besselI0 (beta);
+
+    for (int phase = 0; phase <= numPhases; ++phase)
+    {
+        auto* filter = filters + phase * numTaps;
+        const auto offset = (double) phase / (double) numPhases;
+        double sum = 0;
+
+        for (int i = 0; i < numTaps; ++i)
+        {
+            const auto x = (double) (i - (halfLength - 1)) - offset;
+            const auto r = x / (double) halfLength;
+            const auto window = r * r < 1.0 ? besselI0 (beta * std::sqrt (1.0 - r * r)) * windowScale : 0.0;
+
+            const auto t = MathConstants<double>::pi * cutoff * x;
+            const auto value = cutoff * (std::abs (t) < 1.0e-9 ? 1.0 : std::sin (t) / t) * window;
+
+            filter[i] = (float) value;
+            sum += value;
+        }
+
+        // Normalising each filter keeps the DC gain the same for every phase
+        FloatVectorOperations::multiply (filter, (float) (1.0 / sum), numTaps);
+    }
+
+    for (int phase = 0; phase < numPhases; ++phase)
+        FloatVectorOperations::subtract (differences + phase * numTaps,
+                                         filters + (phase + 1) * numTaps,
+                                         filters + phase * numTaps,
+                                         numTaps);
+}
+
+void PolyphaseResampler::FilterBank::getFilter (float offset, float* dest) const noexcept
+{
+    const auto position = jlimit (0.0f, (float) numPhases, offset * (float) numPhases);
+    const auto phase = jmin ((int) position, numPhases - 1);
+
+    FloatVectorOperations::copy (dest, filters + phase * numTaps, numTaps);
+    FloatVectorOperations::addWithMultiply (dest, differences + phase * numTaps, position - (float) phase, numTaps);
+}
+
+float PolyphaseResampler::FilterBank::dotProduct (const float* a, const float* b, int num) noexcept
+{
+    float result = 0;
+
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_dotpr (a, 1, b, 1, &result, (vDSP_Length) num);
+   #else
+    int i = 0;
+
+    #if JUCE_USE_SSE_INTRINSICS
+     auto sum = _mm_setzero_ps();
+
+     for (; i + 4 <= num; i += 4)
+         sum = _mm_add_ps (sum, _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+
+     sum = _mm_add_ps (sum, _mm_movehl_ps (sum, sum));
+     result = _mm_cvtss_f32 (_mm_add_ss (sum, _mm_shuffle_ps (sum, sum, 1)));
+    #elif JUCE_USE_ARM_NEON
+     auto sum = vdupq_n_f32 (0);
+
+     for (; i + 4 <= num; i += 4)
+         sum = vmlaq_f32 (sum, vld1q_f32 (a + i), vld1q_f32 (b + i));
+
+     const auto pairs = vadd_f32 (vget_low_f32 (sum), vget_high_f32 (sum));
+     result = vget_lane_f32 (vpadd_f32 (pairs, pairs), 0);
+    #endif
+
+    for (; i < num; ++i)
+        result += a[i] * b[i];
+   #endif
+
+    return result;
+}
+
+//==============================================================================
+// The cutoff is kept a little below the Nyquist frequency of the lower of the two rates,
+// so that the filters' transition band doesn't let through much aliasing
+static double getPolyphaseCutoffForRatio (double speedRatio) noexcept
+{
+    return 0.9 * jmin (1.0, 1.0 / speedRatio);
+}
+
+PolyphaseResampler::PolyphaseResampler (int channels, int numTaps, int numPhases)
+    : numChannels (jmax (1, channels)),
+      bank (numTaps, numPhases, getPolyphaseCutoffForRatio (1.0)),
+      history ((size_t) (numChannels * 2 * bank.getNumTaps()), true),
+      filter ((size_t) bank.getNumTaps())
+{
+}
+
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+void PolyphaseResampler::reset() noexcept
+{
+    history.clear ((size_t) (numChannels * 2 * bank.getNumTaps()));
+    writeIndex = 0;
+    subSamplePos = 1.0;
+}
+
+float* PolyphaseResampler::getHistory (int channel) const noexcept
+{
+    return history + channel * 2 * bank.getNumTaps();
+}
+
+void PolyphaseResampler::updateCutoff (double speedRatio) noexcept
+{
+    const auto newCutoff = getPolyphaseCutoffForRatio (speedRatio);
+
+    if (std::abs (newCutoff - bank.getCutoff()) > 0.01 * newCutoff)
+        bank.setCutoff (newCutoff);
+}
+
+int PolyphaseResampler::getNumInputSamplesNeeded (double speedRatio, int numOutputSamples) const noexcept
+{
+    // This must step through the positions in the same way as processImpl()
+    auto pos = subSamplePos;
+    int numNeeded = 0;
+
+    for (int i = 0; i < numOutputSamples; ++i)
+    {
+        for (; pos >= 1.0; pos -= 1.0)
+            ++numNeeded;
+
+        pos += speedRatio;
+    }
+
+    return numNeeded;
+}
+
+template <typename ReadInput, typename WriteOutput>
+int PolyphaseResampler::processImpl (double speedRatio, int numOutputSamples,
+                                     ReadInput&& readInput, WriteOutput&& writeOutput) noexcept
+{
+    jassert (speedRatio > 0);
+    updateCutoff (speedRatio);
+
+    const auto numTaps = bank.getNumTaps();
+    auto pos = subSamplePos;
+    int numUsed = 0;
+
+    for (int i = 0; i < numOutputSamples; ++i)
+    {
+        for (; pos >= 1.0; pos -= 1.0)
+        {
+            // Each sample is stored twice, so that the most recent numTaps samples are
+            // always contiguous, starting at writeIndex
+            for (int chan = 0; chan < numChannels; ++chan)
+            {
+                auto* h = getHistory (chan);
+                h[writeIndex] = h[writeIndex + numTaps] = readInput (chan, numUsed);
+            }
+
+            if (++writeIndex == numTaps)
+                writeIndex = 0;
+
+            ++numUsed;
+        }
+
+        bank.getFilter ((float) pos, filter);
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            writeOutput (chan, i, filter, getHistory (chan) + writeIndex);
+
+        pos += speedRatio;
+    }
+
+    subSamplePos = pos;
+    return numUsed;
+}
+
+int PolyphaseResampler::process (double speedRatio,
+                                 const float* const* inputs,
+                                 float* const* outputs,
+                                 int numOutputSamples) noexcept
+{
+    const auto numTaps = bank.getNumTaps();
+
+    return processImpl (speedRatio, numOutputSamples,
+                        [inputs] (int chan, int index) { return inputs[chan][index]; },
+                        [outputs, numTaps] (int chan, int index, const float* coeffs, const float* samples)
+                        {
+                            if (auto* dest = outputs[chan])
+                                dest[index] = FilterBank::dotProduct (coeffs, samples, numTaps);
+                        });
+}
+
+int PolyphaseResampler::processInterleaved (double speedRatio,
+                                            const float* input,
+                                            float* output,
+                                            int numOutputSamples) noexcept
+{
+    const auto numTaps = bank.getNumTaps();
+    const auto stride = numChannels;
+
+    return processImpl (speedRatio, numOutputSamples,
+                        [input, stride] (int chan, int index) { return input[index * stride + chan]; },
+                        [output, stride, numTaps] (int chan, int index, const float* coeffs, const float* samples)
+                        {
+                            output[index * stride + chan] = FilterBank::dotProduct (coeffs, samples, numTaps);
+                        });
+}
+
+//==============================================================================
+float Interpolators::PolyphaseSincTraits::valueAtOffset (const float* inputs, float offset, int index) noexcept
+{
+    static const PolyphaseResampler::FilterBank bank (numTaps, 256, 0.85);
+
+    float filter[numTaps];
+    bank.getFilter (offset, filter);
+
+    // The history is a circular buffer whose oldest sample is at index
+    const auto numToEnd = numTaps - index;
+
+    return PolyphaseResampler::FilterBank::dotProduct (filter, inputs + index, numToEnd)
+         + PolyphaseResampler::FilterBank::dotProduct (filter + numToEnd, inputs, index);
+}
+
+} // namespace juce
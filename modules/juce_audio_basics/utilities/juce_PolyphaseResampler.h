@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A multichannel resampler that uses a bank of precomputed windowed-sinc filters.
+
+    Each output sample is made by interpolating between the two filters in the bank
+    whose phases are closest to the output's position between input samples, and then
+    convolving that filter with the most recent input samples. The filters are computed
+    up-front, so the per-sample work is a short dot product for each channel, which is
+    done with SIMD instructions where they're available.
+
+    When the speed ratio is greater than 1 (i.e. when the output has a lower sample rate
+    than the input), the filters' cutoff is lowered to prevent aliasing. The bank is
+    recalculated when the ratio changes enough to need a different cutoff, so avoid
+    continuously sweeping a downsampling ratio from the audio thread.
+
+    Like GenericInterpolator, this class is used in the same way as a stream: it keeps
+    the most recent input samples between calls, and you should call reset() when
+    there's a break in the input.
+
+    @see ResamplingAudioSource, PolyphaseSincInterpolator
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResampler
+{
+public:
+    //==============================================================================
+    /** Creates a resampler.
+
+        @param numChannels  the number of channels that each call to process() will handle
+        @param numTaps      the length of each filter in input samples. Longer filters give a
+                            sharper cutoff and better stop-band rejection but use more CPU. This
+                            is rounded up to a multiple of 4
+        @param numPhases    the number of filters in the bank
+    */
+    explicit PolyphaseResampler (int numChannels = 1, int numTaps = 64, int numPhases = 256);
+
+    /** Destructor. */
+    ~PolyphaseResampler();
+
+    /** Clears the stored input samples.
+
+        Call this when there's a break in the continuity of the input data stream.
+    */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Returns the number of channels that this resampler was created with. */
+    int getNumChannels() const noexcept                 { return numChannels; }
+
+    /** Returns the length of each filter, in input samples. */
+    int getNumTaps() const noexcept                     { return bank.getNumTaps(); }
+
+    /** Returns the latency of the filters, in input samples.
+
+        As with GenericInterpolator::getBaseLatency(), the latency in output samples is this
+        value divided by the speed ratio.
+    */
+    float getBaseLatency() const noexcept               { return (float) (bank.getNumTaps() / 2); }
+
+    /** Returns the number of input samples that a call to process() will read in order to
+        produce the given number of output samples at the given speed ratio.
+    */
+    int getNumInputSamplesNeeded (double speedRatio, int numOutputSamples) const noexcept;
+
+    //==============================================================================
+    /** Resamples a block of non-interleaved channels.
+
+        @param speedRatio           the number of input samples to use for each output sample
+        @param inputs               an array of getNumChannels() channels to read from. Each
+                                    one must contain at least getNumInputSamplesNeeded() samples
+        @param outputs              an array of getNumChannels() channels to write to. A channel
+                                    may be nullptr, in which case its input is still used but no
+                                    output is written for it
+        @param numOutputSamples     the number of samples to write to each channel
+
+        @returns the number of input samples that were used
+    */
+    int process (double speedRatio,
+                 const float* const* inputs,
+                 float* const* outputs,
+                 int numOutputSamples) noexcept;
+
+    /** Resamples a block of interleaved samples.
+
+        The input and output both contain getNumChannels() interleaved channels.
+
+        @returns the number of input frames that were used
+    */
+    int processInterleaved (double speedRatio,
+                            const float* input,
+                            float* output,
+                            int numOutputSamples) noexcept;
+
+    //==============================================================================
+    /**
+        A set of windowed-sinc filters for evenly spaced fractional delays.
+
+        This is used by PolyphaseResampler and PolyphaseSincInterpolator, but can also be
+        used directly.
+    */
+    class JUCE_API  FilterBank
+    {
+    public:
+        /** Creates a bank of filters.
+
+            @param numTaps      the length of each filter. This is rounded up to a multiple of 4
+            @param numPhases    the number of filters. Positions between these are interpolated
+            @param cutoff       the filters' cutoff, as a proportion of the input's Nyquist frequency
+        */
+        FilterBank (int numTaps, int numPhases, double cutoff);
+
+        /** Recalculates the filters for a new cutoff, without reallocating them. */
+        void setCutoff (double newCutoff) noexcept;
+
+        /** Returns the cutoff that was last set. */
+        double getCutoff() const noexcept           { return cutoff; }
+
+        /** Returns the length of each filter. */
+        int getNumTaps() const noexcept             { return numTaps; }
+
+        /** Writes the filter for a fractional position between input samples into dest,
+            which must have space for getNumTaps() values.
+
+            The resulting filter should be applied to the getNumTaps() most recent samples,
+            oldest first, and gives the value at offset samples after the sample at index
+            (getNumTaps() / 2 - 1).
+        */
+        void getFilter (float offset, float* dest) const noexcept;
+
+        /** Returns the sum of the products of two arrays of floats. */
+        static float dotProduct (const float* a, const float* b, int num) noexcept;
+
+    private:
+        int numTaps, numPhases;
+        double cutoff = 0;
+        HeapBlock<float> filters, differences;
+    };
+
+private:
+    //==============================================================================
+    template <typename ReadInput, typename WriteOutput>
+    int processImpl (double speedRatio, int numOutputSamples, ReadInput&&, WriteOutput&&) noexcept;
+
+    void updateCutoff (double speedRatio) noexcept;
+    float* getHistory (int channel) const noexcept;
+
+    const int numChannels;
+    FilterBank bank;
+    HeapBlock<float> history, filter;
+    int writeIndex = 0;
+    double subSamplePos = 1.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+} // namespace juce
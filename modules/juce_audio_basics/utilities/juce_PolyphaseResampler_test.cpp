@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct PolyphaseResamplerTests final : public UnitTest
+{
+    PolyphaseResamplerTests()  : UnitTest ("PolyphaseResampler", UnitTestCategories::audio)  {}
+
+    static std::vector<float> createSine (int numSamples, double cyclesPerSample)
+    {
+        std::vector<float> result ((size_t) numSamples);
+
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] = (float) std::sin (MathConstants<double>::twoPi * cyclesPerSample * (double) i);
+
+        return result;
+    }
+
+    void runTest() override
+    {
+        beginTest ("The number of input samples used matches getNumInputSamplesNeeded");
+        {
+            for (auto ratio : { 0.25, 0.7, 1.0, 1.3, 3.1 })
+            {
+                PolyphaseResampler resampler (2);
+                const auto input = createSine (10000, 0.01);
+                const float* inputs[] = { input.data(), input.data() };
+                std::vector<float> output (512);
+                float* outputs[] = { output.data(), nullptr };
+
+                int totalUsed = 0;
+
+                for (auto blockSize : { 1, 17, 100, 256, 511 })
+                {
+                    const auto needed = resampler.getNumInputSamplesNeeded (ratio, blockSize);
+                    const float* offsetInputs[] = { inputs[0] + totalUsed, inputs[1] + totalUsed };
+
+                    expectEquals (resampler.process (ratio, offsetInputs, outputs, blockSize), needed);
+                    totalUsed += needed;
+                }
+
+                expectWithinAbsoluteError ((double) totalUsed, (1 + 17 + 100 + 256 + 511) * ratio, 1.0 + ratio);
+            }
+        }
+
+        beginTest ("A low frequency sine is delayed by the base latency");
+        {
+            for (auto ratio : { 0.5, 0.9, 1.0, 1.7 })
+            {
+                constexpr auto frequency = 0.02;
+                const auto input = createSine (8000, frequency);
+
+                PolyphaseResampler resampler;
+                const auto numOutputs = (int) (4000.0 / ratio);
+                std::vector<float> output ((size_t) numOutputs);
+
+                const float* inputs[] = { input.data() };
+                float* outputs[] = { output.data() };
+                resampler.process (ratio, inputs, outputs, numOutputs);
+
+                auto maxError = 0.0;
+
+                for (int i = (int) (2.0 * resampler.getNumTaps() / ratio); i < numOutputs; ++i)
+                {
+                    const auto inputTime = (double) i * ratio - resampler.getBaseLatency();
+                    const auto expected = std::sin (MathConstants<double>::twoPi * frequency * inputTime);
+                    maxError = jmax (maxError, std::abs (expected - (double) output[(size_t) i]));
+                }
+
+                expectLessThan (maxError, 1.0e-3);
+            }
+        }
+
+        beginTest ("Frequencies above the output's Nyquist frequency are removed");
+        {
+            const auto input = createSine (8000, 0.4);
+
+            PolyphaseResampler resampler;
+            std::vector<float> output (3000);
+
+            const float* inputs[] = { input.data() };
+            float* outputs[] = { output.data() };
+            resampler.process (2.0, inputs, outputs, (int) output.size());
+
+            const auto range = FloatVectorOperations::findMinAndMax (output.data() + 200, (int) output.size() - 200);
+            expectLessThan (jmax (-range.getStart(), range.getEnd()), 1.0e-3f);
+        }
+
+        beginTest ("Interleaved and non-interleaved processing give the same results");
+        {
+            constexpr int numChannels = 3, numInputs = 4000, numOutputs = 2500;
+
+            auto r = getRandom();
+            AudioBuffer<float> input (numChannels, numInputs), output (numChannels, numOutputs);
+            std::vector<float> interleavedInput (numChannels * numInputs), interleavedOutput (numChannels * numOutputs);
+
+            for (int chan = 0; chan < numChannels; ++chan)
+                for (int i = 0; i < numInputs; ++i)
+                    input.setSample (chan, i, interleavedInput[(size_t) (i * numChannels + chan)] = r.nextFloat() * 2.0f - 1.0f);
+
+            PolyphaseResampler planar (numChannels), interleaved (numChannels);
+            planar.process (1.5, input.getArrayOfReadPointers(), output.getArrayOfWritePointers(), numOutputs);
+            interleaved.processInterleaved (1.5, interleavedInput.data(), interleavedOutput.data(), numOutputs);
+
+            auto numDifferent = 0;
+
+            for (int chan = 0; chan < numChannels; ++chan)
+                for (int i = 0; i < numOutputs; ++i)
+                    if (! exactlyEqual (output.getSample (chan, i), interleavedOutput[(size_t) (i * numChannels + chan)]))
+                        ++numDifferent;
+
+            expectEquals (numDifferent, 0);
+        }
+    }
+};
+
+static PolyphaseResamplerTests polyphaseResamplerTests;
+
+} // namespace juce
@@ -0,0 +1,428 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  A fixed-capacity work-stealing deque, holding indices of job slots.
+
+    The owning thread pushes and pops jobs at the bottom of the deque, and any other thread
+    may steal jobs from the top. This is the algorithm described by Chase and Lev in "Dynamic
+    Circular Work-Stealing Deque", using the memory orderings from Lê et al. in "Correct and
+    Efficient Work-Stealing for Weak Memory Models", but without the ability to grow.
+*/
+class RealtimeThreadPoolJobQueue
+{
+public:
+    explicit RealtimeThreadPoolJobQueue (size_t capacityIn)
+        : capacity (capacityIn), slots (capacity)
+    {
+        jassert (isPowerOfTwo (capacity));
+    }
+
+    /*  Call from the owning thread only. */
+    void push (int slot)
+    {
+        const auto b = bottom->load (std::memory_order_relaxed);
+        slots[(size_t) b & (capacity - 1)].store (slot, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+        bottom->store (b + 1, std::memory_order_relaxed);
+    }
+
+    /*  Call from the owning thread only. Returns -1 if the queue is empty. */
+    int pop()
+    {
+        const auto b = bottom->load (std::memory_order_relaxed) - 1;
+        bottom->store (b, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        auto t = top->load (std::memory_order_relaxed);
+
+        if (b < t)
+        {
+            bottom->store (b + 1, std::memory_order_relaxed);
+            return -1;
+        }
+
+        auto result = slots[(size_t) b & (capacity - 1)].load (std::memory_order_relaxed);
+
+        if (t == b)
+        {
+            // This is the last item in the queue, so we might be racing with a thief
+            if (! top->compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                result = -1;
+
+            bottom->store (b + 1, std::memory_order_relaxed);
+        }
+
+        return result;
+    }
+
+    /*  May be called from any thread. Returns -1 if the queue is empty, or if another thread
+        took the job first.
+    */
+    int steal()
+    {
+        auto t = top->load (std::memory_order_acquire);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        const auto b = bottom->load (std::memory_order_acquire);
+
+        if (b <= t)
+            return -1;
+
+        const auto result = slots[(size_t) t & (capacity - 1)].load (std::memory_order_relaxed);
+
+        if (! top->compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return -1;
+
+        return result;
+    }
+
+    /*  Only call this when no other threads are using the queue. */
+    void reset()
+    {
+        top->store (0, std::memory_order_relaxed);
+        bottom->store (0, std::memory_order_relaxed);
+    }
+
+private:
+    const size_t capacity;
+    std::vector<std::atomic<int>> slots;
+
+    // The owner writes to the bottom and thieves write to the top, so they're kept
+    // on separate cache lines
+    CacheLinePadded<std::atomic<int64>> top, bottom;
+};
+
+//==============================================================================
+class RealtimeThreadPool::Impl
+{
+public:
+    Impl (RealtimeThreadPool& ownerIn, const Options& options)
+        : owner (ownerIn),
+          capacity ((size_t) nextPowerOfTwo (jmax (1, options.maxNumJobs))),
+          jobs (capacity)
+    {
+        const auto numThreads = jmax (0, options.numberOfThreads);
+
+        // Queue 0 belongs to the thread that calls runJobsAndWait, the others belong to the workers
+        for (auto i = 0; i <= numThreads; ++i)
+            queues.push_back (std::make_unique<RealtimeThreadPoolJobQueue> (capacity));
+
+        for (auto i = 1; i <= numThreads; ++i)
+        {
+            auto worker = std::make_unique<Worker> (*this, options.threadName + " " + String (i), (size_t) i);
+            auto realtimeOptions = options.realtimeOptions;
+
+            if (! options.workerCores.isEmpty())
+            {
+                const auto core = options.workerCores[(i - 1) % options.workerCores.size()];
+
+                // Affinity masks can only refer to the first 32 cores
+                jassert (isPositiveAndBelow (core, 32));
+                const auto mask = (uint32) 1 << (core & 31);
+
+                realtimeOptions = realtimeOptions.withAffinityMask (mask);
+                worker->setAffinityMask (mask);
+            }
+
+            if (! worker->startRealtimeThread (realtimeOptions))
+                worker->startThread (Thread::Priority::highest);
+
+            workers.push_back (std::move (worker));
+        }
+    }
+
+    ~Impl()
+    {
+        for (auto& worker : workers)
+            worker->stopThread (-1);
+    }
+
+    int getNumThreads() const noexcept  { return (int) workers.size(); }
+    int getMaxNumJobs() const noexcept  { return (int) capacity; }
+
+    void setWorkgroup (const AudioWorkgroup& newWorkgroup)
+    {
+        // Don't call this while jobs are running!
+        jassert (! batchRunning.load());
+
+        if (workgroup != newWorkgroup)
+            workgroup = newWorkgroup;
+    }
+
+    bool addJob (Job&& job)
+    {
+        const auto slot = nextSlot.fetch_add (1, std::memory_order_relaxed);
+
+        if (slot >= capacity)
+        {
+            // The pool has run out of job storage. Increase the maxNumJobs in the pool Options!
+            jassertfalse;
+            job();
+            return false;
+        }
+
+        jobs[slot] = std::move (job);
+        numPendingJobs.fetch_add (1);
+        queues[getQueueIndexForCurrentThread()]->push ((int) slot);
+        return true;
+    }
+
+    void runJobsAndWait()
+    {
+        // Jobs shouldn't try to wait for other jobs!
+        jassert (getQueueIndexForCurrentThread() == 0 && ! batchRunning.load());
+
+        if (numPendingJobs.load() == 0)
+        {
+            nextSlot.store (0, std::memory_order_relaxed);
+            return;
+        }
+
+        batchRunning.store (true);
+
+        for (auto& worker : workers)
+            worker->notify();
+
+        {
+            const ScopedValueSetter<QueueForThread> queueSetter (currentQueue, { this, 0 });
+
+            while (numPendingJobs.load() > 0)
+                if (! runNextJob (0))
+                    Thread::yield();
+        }
+
+        batchRunning.store (false);
+
+        // Wait for any workers that might still be looking for jobs
+        while (numActiveWorkers.load() != 0)
+            Thread::yield();
+
+        for (auto& queue : queues)
+            queue->reset();
+
+        nextSlot.store (0, std::memory_order_relaxed);
+    }
+
+    void runTasksAndWait (int numTasks, const Task& task)
+    {
+        if (numTasks <= 0)
+            return;
+
+        const auto insideBatch = currentQueue.pool == this && batchRunning.load();
+        const auto numHelpers = jmin (numTasks, getNumThreads() + (insideBatch ? 0 : 1));
+
+        TaskBatch batch { task, numTasks };
+        batch.numHelpersRunning.store (numHelpers);
+
+        for (int i = 0; i < numHelpers; ++i)
+            addJob ([&batch] { batch.runTasks(); batch.numHelpersRunning.fetch_sub (1); });
+
+        if (! insideBatch)
+        {
+            runJobsAndWait();
+            return;
+        }
+
+        // The helpers can only start once they've been stolen, so help out, and keep
+        // running jobs until they've all finished, as they refer to the batch.
+        batch.runTasks();
+
+        const auto queueIndex = getQueueIndexForCurrentThread();
+
+        while (batch.numHelpersRunning.load() > 0)
+            if (! runNextJob (queueIndex))
+                Thread::yield();
+    }
+
+    RealtimeThreadPool& getOwner() const noexcept    { return owner; }
+
+    static const Impl* getPoolForCurrentThread() noexcept  { return currentQueue.pool; }
+
+private:
+    struct TaskBatch
+    {
+        void runTasks()
+        {
+            for (auto i = nextTask.fetch_add (1); i < numTasks; i = nextTask.fetch_add (1))
+                task (i);
+        }
+
+        const Task& task;
+        const int numTasks;
+        std::atomic<int> nextTask { 0 }, numHelpersRunning { 0 };
+    };
+
+    class Worker final : public Thread
+    {
+    public:
+        Worker (Impl& o, const String& name, size_t index)
+            : Thread (name), owner (o), queueIndex (index) {}
+
+        void run() override
+        {
+            currentQueue = { &owner, queueIndex };
+
+            WorkgroupToken token;
+            AudioWorkgroup joinedWorkgroup;
+
+            while (! threadShouldExit())
+            {
+                wait (-1);
+
+                if (threadShouldExit())
+                    break;
+
+                owner.numActiveWorkers.fetch_add (1);
+
+                if (owner.batchRunning.load())
+                {
+                    if (joinedWorkgroup != owner.workgroup)
+                    {
+                        joinedWorkgroup = owner.workgroup;
+                        joinedWorkgroup.join (token);
+                    }
+
+                    const RealtimeSafetyChecker::ScopedRealtimeContext realtimeContext;
+
+                    while (owner.numPendingJobs.load() > 0)
+                        if (! owner.runNextJob (queueIndex))
+                            Thread::yield();
+                }
+
+                owner.numActiveWorkers.fetch_sub (1);
+            }
+
+            currentQueue = {};
+        }
+
+    private:
+        Impl& owner;
+        const size_t queueIndex;
+    };
+
+    struct QueueForThread
+    {
+        const Impl* pool = nullptr;
+        size_t index = 0;
+    };
+
+    size_t getQueueIndexForCurrentThread() const noexcept
+    {
+        return currentQueue.pool == this ? currentQueue.index : 0;
+    }
+
+    bool runNextJob (size_t queueIndex)
+    {
+        auto slot = queues[queueIndex]->pop();
+
+        for (size_t i = 1; slot < 0 && i < queues.size(); ++i)
+            slot = queues[(queueIndex + i) % queues.size()]->steal();
+
+        if (slot < 0)
+            return false;
+
+        auto& job = jobs[(size_t) slot];
+        job();
+        job = nullptr;
+
+        numPendingJobs.fetch_sub (1);
+        return true;
+    }
+
+    static thread_local QueueForThread currentQueue;
+
+    RealtimeThreadPool& owner;
+    const size_t capacity;
+    std::vector<Job> jobs;
+    std::vector<std::unique_ptr<RealtimeThreadPoolJobQueue>> queues;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::atomic<size_t> nextSlot { 0 };
+    std::atomic<int> numPendingJobs { 0 }, numActiveWorkers { 0 };
+    std::atomic<bool> batchRunning { false };
+    AudioWorkgroup workgroup;
+};
+
+thread_local RealtimeThreadPool::Impl::QueueForThread RealtimeThreadPool::Impl::currentQueue;
+
+//==============================================================================
+RealtimeThreadPool::RealtimeThreadPool() = default;
+RealtimeThreadPool::RealtimeThreadPool (const Options& options)  { prepare (options); }
+RealtimeThreadPool::~RealtimeThreadPool() = default;
+
+void RealtimeThreadPool::prepare (const Options& options)
+{
+    impl.reset();
+    impl = std::make_unique<Impl> (*this, options);
+}
+
+void RealtimeThreadPool::release()
+{
+    impl.reset();
+}
+
+int RealtimeThreadPool::getNumThreads() const noexcept  { return impl != nullptr ? impl->getNumThreads() : 0; }
+int RealtimeThreadPool::getMaxNumJobs() const noexcept  { return impl != nullptr ? impl->getMaxNumJobs() : 0; }
+
+void RealtimeThreadPool::setWorkgroup (const AudioWorkgroup& workgroup)
+{
+    if (impl != nullptr)
+        impl->setWorkgroup (workgroup);
+}
+
+bool RealtimeThreadPool::addJob (Job job)
+{
+    if (impl != nullptr)
+        return impl->addJob (std::move (job));
+
+    job();
+    return false;
+}
+
+void RealtimeThreadPool::runJobsAndWait()
+{
+    if (impl != nullptr)
+        impl->runJobsAndWait();
+}
+
+void RealtimeThreadPool::runTasksAndWait (int numTasks, const Task& task)
+{
+    if (impl != nullptr)
+    {
+        impl->runTasksAndWait (numTasks, task);
+        return;
+    }
+
+    for (int i = 0; i < numTasks; ++i)
+        task (i);
+}
+
+RealtimeThreadPool* RealtimeThreadPool::getPoolForCurrentThread() noexcept
+{
+    if (auto* currentImpl = Impl::getPoolForCurrentThread())
+        return &currentImpl->getOwner();
+
+    return nullptr;
+}
+
+} // namespace juce
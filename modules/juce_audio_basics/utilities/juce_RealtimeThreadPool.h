@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A set of options used to configure a RealtimeThreadPool.
+
+    @see RealtimeThreadPool
+
+    @tags{Audio}
+*/
+struct RealtimeThreadPoolOptions
+{
+    /** The name to give each thread in the pool. */
+    [[nodiscard]] RealtimeThreadPoolOptions withThreadName (String newThreadName) const
+    {
+        return withMember (*this, &RealtimeThreadPoolOptions::threadName, newThreadName);
+    }
+
+    /** The number of worker threads to run.
+
+        The thread that calls RealtimeThreadPool::runJobsAndWait() will also process jobs, so a
+        pool with N worker threads can run up to N + 1 jobs at once.
+    */
+    [[nodiscard]] RealtimeThreadPoolOptions withNumberOfThreads (int newNumberOfThreads) const
+    {
+        return withMember (*this, &RealtimeThreadPoolOptions::numberOfThreads, newNumberOfThreads);
+    }
+
+    /** The maximum number of jobs that may be added between calls to
+        RealtimeThreadPool::runJobsAndWait(), including any jobs added by other jobs.
+
+        Storage for this many jobs is allocated up-front by RealtimeThreadPool::prepare().
+    */
+    [[nodiscard]] RealtimeThreadPoolOptions withMaxNumJobs (int newMaxNumJobs) const
+    {
+        return withMember (*this, &RealtimeThreadPoolOptions::maxNumJobs, newMaxNumJobs);
+    }
+
+    /** The options used to start each of the worker threads. */
+    [[nodiscard]] RealtimeThreadPoolOptions withRealtimeOptions (Thread::RealtimeOptions newRealtimeOptions) const
+    {
+        return withMember (*this, &RealtimeThreadPoolOptions::realtimeOptions, newRealtimeOptions);
+    }
+
+    /** The CPU cores that the worker threads should be pinned to, e.g. cores that have been
+        removed from the OS scheduler so that nothing else runs on them.
+
+        Worker n is pinned to the core at index (n % size) of this list, where the first worker
+        is number 0. If the list is empty, the workers use the affinity mask from the realtime
+        options.
+
+        @see Thread::RealtimeOptions::withAffinityMask
+    */
+    [[nodiscard]] RealtimeThreadPoolOptions withWorkerCores (Array<int> newWorkerCores) const
+    {
+        return withMember (*this, &RealtimeThreadPoolOptions::workerCores, newWorkerCores);
+    }
+
+    String threadName { "Realtime Pool" };
+    int numberOfThreads { jmax (1, SystemStats::getNumCpus() - 1) };
+    int maxNumJobs { 256 };
+    Thread::RealtimeOptions realtimeOptions;
+    Array<int> workerCores;
+};
+
+//==============================================================================
+/**
+    A pool of realtime threads that can be used to process several jobs in parallel from
+    inside an audio callback.
+
+    Unlike ThreadPool, this class doesn't take any locks or allocate any memory once it has
+    been prepared, so it's safe to use from the audio thread. Each thread (including the
+    thread that adds the jobs) has its own queue of jobs, and threads that run out of work
+    will steal jobs from the queues of the other threads.
+
+    A typical use might look like this:
+
+    @code
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override
+    {
+        pool.prepare (RealtimeThreadPool::Options{}.withNumberOfThreads (3)
+                                                   .withRealtimeOptions (Thread::RealtimeOptions{}.withApproximateAudioProcessingTime (samplesPerBlock, sampleRate)));
+    }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        for (auto& part : parts)
+            pool.addJob ([&part, &buffer] { part.process (buffer); });
+
+        pool.runJobsAndWait();
+    }
+    @endcode
+
+    Jobs may add further jobs to the pool while they're running. Jobs should not block,
+    and they should not call runJobsAndWait().
+
+    Apart from the pool's own worker threads, only one thread may add jobs to a given pool at
+    any one time. Normally this will be the audio thread.
+
+    @see RealtimeThreadPoolOptions, AudioWorkgroup
+
+    @tags{Audio}
+*/
+class JUCE_API  RealtimeThreadPool
+{
+public:
+    using Options = RealtimeThreadPoolOptions;
+
+    /** The type of callable that can be added to the pool. */
+    using Job = FixedSizeFunction<64, void()>;
+
+    /** The type of callable used by runTasksAndWait(). */
+    using Task = FixedSizeFunction<64, void (int)>;
+
+    //==============================================================================
+    /** Creates an unprepared pool. Call prepare() to start the worker threads. */
+    RealtimeThreadPool();
+
+    /** Creates a pool and prepares it with the given options. */
+    explicit RealtimeThreadPool (const Options& options);
+
+    /** Destructor. Stops all of the worker threads. */
+    ~RealtimeThreadPool();
+
+    //==============================================================================
+    /** Allocates storage for jobs, and starts the worker threads.
+
+        If the pool was already prepared, the old worker threads will be stopped first.
+        This must not be called at the same time as addJob() or runJobsAndWait().
+    */
+    void prepare (const Options& options);
+
+    /** Stops the worker threads and frees all storage. */
+    void release();
+
+    /** Returns true if prepare() has been called and release() hasn't. */
+    bool isPrepared() const noexcept                    { return impl != nullptr; }
+
+    /** Returns the number of worker threads, not including the thread that calls
+        runJobsAndWait().
+    */
+    int getNumThreads() const noexcept;
+
+    /** Returns the maximum number of jobs that may be added between calls to runJobsAndWait(). */
+    int getMaxNumJobs() const noexcept;
+
+    //==============================================================================
+    /** Sets the workgroup that worker threads should join.
+
+        Each worker will join the workgroup the next time it wakes up. Call this from the same
+        thread that calls runJobsAndWait(), but not from inside a job.
+    */
+    void setWorkgroup (const AudioWorkgroup& workgroup);
+
+    /** Adds a job to the calling thread's queue. The job won't start before runJobsAndWait()
+        is called, unless it's added from inside another job.
+
+        If the pool isn't prepared, or if the maximum number of jobs has already been added,
+        the job will be run immediately on the calling thread and this will return false.
+    */
+    bool addJob (Job job);
+
+    /** Wakes the worker threads, and helps them to process jobs until all of the jobs that
+        have been added to the pool are complete.
+
+        This is safe to call from the audio thread.
+    */
+    void runJobsAndWait();
+
+    /** Calls a function once for each index from 0 to numTasks - 1, spreading the calls
+        across the pool's threads, and returns when all of them have finished.
+
+        Unlike runJobsAndWait(), this may also be called from inside a job that's running on
+        this pool, in which case the calling thread keeps processing the pool's jobs until its
+        tasks are complete. This lets code that is itself being run by the pool (for example a
+        hosted plugin that asks its host to run tasks for it) share the same threads rather
+        than starting more of its own.
+
+        If the pool isn't prepared, all of the tasks are run on the calling thread.
+    */
+    void runTasksAndWait (int numTasks, const Task& task);
+
+    /** If the calling thread is currently running jobs for a RealtimeThreadPool, either as
+        one of its workers or from inside runJobsAndWait(), this returns that pool.
+        Otherwise it returns nullptr.
+    */
+    static RealtimeThreadPool* getPoolForCurrentThread() noexcept;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeThreadPool)
+};
+
+} // namespace juce
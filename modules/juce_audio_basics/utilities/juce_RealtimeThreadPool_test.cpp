@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct RealtimeThreadPoolTests final : public UnitTest
+{
+    RealtimeThreadPoolTests()  : UnitTest ("RealtimeThreadPool", UnitTestCategories::threads)  {}
+
+    void runTest() override
+    {
+        beginTest ("An unprepared pool runs jobs immediately");
+        {
+            RealtimeThreadPool pool;
+            auto didRun = false;
+
+            expect (! pool.isPrepared());
+            expect (! pool.addJob ([&] { didRun = true; }));
+            expect (didRun);
+
+            pool.runJobsAndWait();
+        }
+
+        beginTest ("All jobs are complete when runJobsAndWait returns");
+        {
+            RealtimeThreadPool pool (RealtimeThreadPool::Options{}.withNumberOfThreads (3)
+                                                                   .withMaxNumJobs (64));
+            expect (pool.isPrepared());
+            expectEquals (pool.getNumThreads(), 3);
+            expectEquals (pool.getMaxNumJobs(), 64);
+
+            std::array<std::atomic<int>, 64> counts{};
+
+            for (auto batch = 0; batch < 100; ++batch)
+            {
+                for (auto& count : counts)
+                    expect (pool.addJob ([&count] { count.fetch_add (1); }));
+
+                pool.runJobsAndWait();
+
+                expect (std::all_of (counts.begin(), counts.end(), [&] (const auto& c) { return c.load() == batch + 1; }));
+            }
+        }
+
+        beginTest ("Jobs may add more jobs");
+        {
+            RealtimeThreadPool pool (RealtimeThreadPool::Options{}.withNumberOfThreads (2)
+                                                                   .withMaxNumJobs (1024));
+            std::atomic<int> count { 0 };
+
+            for (auto batch = 0; batch < 20; ++batch)
+            {
+                count = 0;
+
+                for (auto i = 0; i < 32; ++i)
+                {
+                    pool.addJob ([&pool, &count]
+                    {
+                        for (auto j = 0; j < 8; ++j)
+                            pool.addJob ([&count] { count.fetch_add (1); });
+                    });
+                }
+
+                pool.runJobsAndWait();
+                expectEquals (count.load(), 32 * 8);
+            }
+        }
+
+        beginTest ("Jobs are shared between threads");
+        {
+            RealtimeThreadPool pool (RealtimeThreadPool::Options{}.withNumberOfThreads (2)
+                                                                   .withMaxNumJobs (16));
+
+            std::mutex mutex;
+            std::set<std::thread::id> threadIds;
+
+            for (auto attempt = 0; attempt < 100 && threadIds.size() < 2; ++attempt)
+            {
+                for (auto i = 0; i < 16; ++i)
+                {
+                    pool.addJob ([&]
+                    {
+                        Thread::sleep (1);
+                        const std::lock_guard<std::mutex> lock (mutex);
+                        threadIds.insert (std::this_thread::get_id());
+                    });
+                }
+
+                pool.runJobsAndWait();
+            }
+
+            expect (threadIds.size() > 1);
+        }
+
+        beginTest ("Workers pinned to cores still run jobs");
+        {
+            RealtimeThreadPool pool (RealtimeThreadPool::Options{}.withNumberOfThreads (2)
+                                                                   .withWorkerCores ({ 0 }));
+            std::atomic<int> count { 0 };
+
+            for (auto i = 0; i < 64; ++i)
+                pool.addJob ([&count] { count.fetch_add (1); });
+
+            pool.runJobsAndWait();
+            expectEquals (count.load(), 64);
+        }
+
+        beginTest ("runTasksAndWait runs every task, with or without a prepared pool");
+        {
+            for (auto numThreads : { -1, 0, 3 })
+            {
+                RealtimeThreadPool pool;
+
+                if (numThreads >= 0)
+                    pool.prepare (RealtimeThreadPool::Options{}.withNumberOfThreads (numThreads));
+
+                std::array<std::atomic<int>, 100> counts{};
+                pool.runTasksAndWait ((int) counts.size(), [&counts] (int i) { counts[(size_t) i].fetch_add (1); });
+
+                expect (std::all_of (counts.begin(), counts.end(), [] (const auto& c) { return c.load() == 1; }));
+            }
+        }
+
+        beginTest ("Jobs may run tasks on the pool that is running them");
+        {
+            RealtimeThreadPool pool (RealtimeThreadPool::Options{}.withNumberOfThreads (3)
+                                                                   .withMaxNumJobs (256));
+            expect (RealtimeThreadPool::getPoolForCurrentThread() == nullptr);
+
+            std::atomic<int> count { 0 }, jobsInPool { 0 };
+
+            for (auto batch = 0; batch < 20; ++batch)
+            {
+                count = 0;
+
+                for (auto i = 0; i < 8; ++i)
+                {
+                    pool.addJob ([&]
+                    {
+                        if (RealtimeThreadPool::getPoolForCurrentThread() == &pool)
+                            jobsInPool.fetch_add (1);
+
+                        pool.runTasksAndWait (16, [&count] (int) { count.fetch_add (1); });
+                    });
+                }
+
+                pool.runJobsAndWait();
+                expectEquals (count.load(), 8 * 16);
+            }
+
+            expectEquals (jobsInPool.load(), 20 * 8);
+            expect (RealtimeThreadPool::getPoolForCurrentThread() == nullptr);
+        }
+    }
+};
+
+static RealtimeThreadPoolTests realtimeThreadPoolTests;
+
+} // namespace juce
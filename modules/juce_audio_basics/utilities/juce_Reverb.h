@@ -31,6 +31,9 @@ namespace juce
     Use setSampleRate() to prepare it, and then call processStereo() or processMono() to
     apply the reverb to your audio data.
 
+    By default the FreeVerb algorithm is used, but setAlgorithm() can switch to a
+    denser feedback delay network, which is controlled by the same parameters.
+
     @see ReverbAudioSource
 
     @tags{Audio}
@@ -58,6 +61,25 @@ public:
                                           put the reverb into a continuous feedback loop. */
     };
 
+    //==============================================================================
+    /** The algorithms that the reverb can use. */
+    enum class Algorithm
+    {
+        freeverb,           /**< Eight parallel comb filters followed by four all-pass filters. */
+        feedbackDelayNetwork /**< Eight delay lines mixed through a Hadamard feedback matrix, which
+                                  gives a denser, smoother tail. */
+    };
+
+    /** Changes the algorithm used by the reverb. This will clear the reverb's buffers. */
+    void setAlgorithm (Algorithm newAlgorithm) noexcept
+    {
+        if (std::exchange (algorithm, newAlgorithm) != newAlgorithm)
+            reset();
+    }
+
+    /** Returns the algorithm being used by the reverb. */
+    Algorithm getAlgorithm() const noexcept             { return algorithm; }
+
     //==============================================================================
     /** Returns the reverb's current parameters. */
     const Parameters& getParameters() const noexcept    { return parameters; }
@@ -91,13 +113,15 @@ public:
 
         static const short combTunings[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 }; // (at 44100Hz)
         static const short allPassTunings[] = { 556, 441, 341, 225 };
+        static const short networkTunings[] = { 1031, 1153, 1277, 1361, 1493, 1601, 1733, 1847 };
         const int stereoSpread = 23;
         const int intSampleRate = (int) sampleRate;
 
         for (int i = 0; i < numCombs; ++i)
         {
-            comb[0][i].setSize ((intSampleRate * combTunings[i]) / 44100);
-            comb[1][i].setSize ((intSampleRate * (combTunings[i] + stereoSpread)) / 44100);
+            comb[0].setSize (i, (intSampleRate * combTunings[i]) / 44100);
+            comb[1].setSize (i, (intSampleRate * (combTunings[i] + stereoSpread)) / 44100);
+            network.setSize (i, (intSampleRate * networkTunings[i]) / 44100);
         }
 
         for (int i = 0; i < numAllPasses; ++i)
@@ -119,12 +143,13 @@ public:
     {
         for (int j = 0; j < numChannels; ++j)
         {
-            for (int i = 0; i < numCombs; ++i)
-                comb[j][i].clear();
+            comb[j].clear();
 
             for (int i = 0; i < numAllPasses; ++i)
                 allPass[j][i].clear();
         }
+
+        network.clear();
     }
 
     //==============================================================================
@@ -143,16 +168,20 @@ public:
             const float damp    = damping.getNextValue();
             const float feedbck = feedback.getNextValue();
 
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
+            if (algorithm == Algorithm::freeverb)
             {
-                outL += comb[0][j].process (input, damp, feedbck);
-                outR += comb[1][j].process (input, damp, feedbck);
+                outL = comb[0].process (input, damp, feedbck);  // the comb filters run in parallel
+                outR = comb[1].process (input, damp, feedbck);
+
+                for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
+                {
+                    outL = allPass[0][j].process (outL);
+                    outR = allPass[1][j].process (outR);
+                }
             }
-
-            for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
+            else
             {
-                outL = allPass[0][j].process (outL);
-                outR = allPass[1][j].process (outR);
+                network.process (input, damp, feedbck, outL, outR);
             }
 
             const float dry  = dryGain.getNextValue();
@@ -179,11 +208,18 @@ public:
             const float damp    = damping.getNextValue();
             const float feedbck = feedback.getNextValue();
 
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-                output += comb[0][j].process (input, damp, feedbck);
+            if (algorithm == Algorithm::freeverb)
+            {
+                output = comb[0].process (input, damp, feedbck);  // the comb filters run in parallel
 
-            for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
-                output = allPass[0][j].process (output);
+                for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
+                    output = allPass[0][j].process (output);
+            }
+            else
+            {
+                float unused;
+                network.process (input, damp, feedbck, output, unused);
+            }
 
             const float dry  = dryGain.getNextValue();
             const float wet1 = wetGain1.getNextValue();
@@ -217,48 +253,138 @@ private:
     }
 
     //==============================================================================
-    class CombFilter
+    /** A set of delay lines that are processed side by side, with their state stored
+        in arrays so that the arithmetic can be vectorised across the lines.
+    */
+    template <int numLines>
+    class DelayLineBank
     {
     public:
-        CombFilter() noexcept {}
+        DelayLineBank() noexcept {}
 
-        void setSize (const int size)
+        void setSize (const int line, const int size)
         {
-            if (size != bufferSize)
+            if (size != bufferSizes[(size_t) line])
             {
-                bufferIndex = 0;
-                buffer.malloc (size);
-                bufferSize = size;
+                bufferIndices[(size_t) line] = 0;
+                buffers[line].malloc (size);
+                bufferSizes[(size_t) line] = size;
             }
 
-            clear();
+            buffers[line].clear ((size_t) size);
+            last[(size_t) line] = 0;
         }
 
         void clear() noexcept
         {
-            last = 0;
-            buffer.clear ((size_t) bufferSize);
+            for (int i = 0; i < numLines; ++i)
+                buffers[i].clear ((size_t) bufferSizes[(size_t) i]);
+
+            last.fill (0.0f);
         }
 
-        float process (const float input, const float damp, const float feedbackLevel) noexcept
+        /** Reads the oldest value from each line, and applies the damping filter to it. */
+        void read (float* outputs, const float damp) noexcept
         {
-            const float output = buffer[bufferIndex];
-            last = (output * (1.0f - damp)) + (last * damp);
-            JUCE_UNDENORMALISE (last);
+            for (size_t i = 0; i < (size_t) numLines; ++i)
+                outputs[i] = buffers[(int) i][bufferIndices[i]];
 
-            float temp = input + (last * feedbackLevel);
-            JUCE_UNDENORMALISE (temp);
-            buffer[bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return output;
+            for (size_t i = 0; i < (size_t) numLines; ++i)
+            {
+                last[i] = (outputs[i] * (1.0f - damp)) + (last[i] * damp);
+                JUCE_UNDENORMALISE (last[i]);
+            }
+        }
+
+        /** Writes a new value into each line and moves on to the next sample. */
+        void write (const float* inputs) noexcept
+        {
+            for (size_t i = 0; i < (size_t) numLines; ++i)
+                buffers[(int) i][bufferIndices[i]] = inputs[i];
+
+            for (size_t i = 0; i < (size_t) numLines; ++i)
+                bufferIndices[i] = bufferIndices[i] + 1 < bufferSizes[i] ? bufferIndices[i] + 1 : 0;
         }
 
+    protected:
+        std::array<float, (size_t) numLines> last {};
+
     private:
-        HeapBlock<float> buffer;
-        int bufferSize = 0, bufferIndex = 0;
-        float last = 0.0f;
+        HeapBlock<float> buffers[(size_t) numLines];
+        std::array<int, (size_t) numLines> bufferSizes {}, bufferIndices {};
+
+        JUCE_DECLARE_NON_COPYABLE (DelayLineBank)
+    };
+
+    //==============================================================================
+    /** The FreeVerb comb filters, which all share the same input. */
+    class CombFilterBank : public DelayLineBank<8>
+    {
+    public:
+        float process (const float input, const float damp, const float feedbackLevel) noexcept
+        {
+            float outputs[8], temps[8];
+            read (outputs, damp);
+
+            for (size_t i = 0; i < 8; ++i)
+            {
+                temps[i] = input + (last[i] * feedbackLevel);
+                JUCE_UNDENORMALISE (temps[i]);
+            }
+
+            write (temps);
+
+            float sum = 0;
+
+            for (auto output : outputs)
+                sum += output;
+
+            return sum;
+        }
+    };
 
-        JUCE_DECLARE_NON_COPYABLE (CombFilter)
+    //==============================================================================
+    /** A feedback delay network, mixing eight damped delay lines through a scaled Hadamard
+        matrix. The matrix is orthogonal, so the network never gains energy when the
+        feedback level is below one.
+    */
+    class FeedbackDelayNetwork : public DelayLineBank<8>
+    {
+    public:
+        void process (const float input, const float damp, const float feedbackLevel,
+                      float& outL, float& outR) noexcept
+        {
+            float outputs[8], mixed[8];
+            read (outputs, damp);
+
+            std::copy (last.begin(), last.end(), mixed);
+
+            for (size_t span = 1; span < 8; span *= 2)
+            {
+                for (size_t i = 0; i < 8; i += 2 * span)
+                {
+                    for (size_t j = i; j < i + span; ++j)
+                    {
+                        const auto a = mixed[j], b = mixed[j + span];
+                        mixed[j] = a + b;
+                        mixed[j + span] = a - b;
+                    }
+                }
+            }
+
+            const auto scale = feedbackLevel * 0.35355339f; // 1 / sqrt (8)
+
+            for (size_t i = 0; i < 8; ++i)
+            {
+                mixed[i] = ((i & 1) != 0 ? -input : input) + mixed[i] * scale;
+                JUCE_UNDENORMALISE (mixed[i]);
+            }
+
+            write (mixed);
+
+            outL = outputs[0] - outputs[1] + outputs[2] - outputs[3] + outputs[4] - outputs[5] + outputs[6] - outputs[7];
+            outR = outputs[0] + outputs[1] - outputs[2] - outputs[3] + outputs[4] + outputs[5] - outputs[6] - outputs[7];
+        }
     };
 
     //==============================================================================
@@ -290,7 +416,7 @@ private:
             float temp = input + (bufferedValue * 0.5f);
             JUCE_UNDENORMALISE (temp);
             buffer [bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
+            bufferIndex = bufferIndex + 1 < bufferSize ? bufferIndex + 1 : 0;
             return bufferedValue - input;
         }
 
@@ -307,8 +433,10 @@ private:
     Parameters parameters;
     float gain;
 
-    CombFilter comb [numChannels][numCombs];
+    CombFilterBank comb [numChannels];
     AllPassFilter allPass [numChannels][numAllPasses];
+    FeedbackDelayNetwork network;
+    Algorithm algorithm = Algorithm::freeverb;
 
     SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
 
@@ -0,0 +1,408 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct ReverbTests final : public UnitTest
+{
+    ReverbTests()  : UnitTest ("Reverb", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        Reverb::Parameters custom;
+        custom.roomSize = 0.8f;
+        custom.damping = 0.2f;
+        custom.wetLevel = 0.5f;
+        custom.dryLevel = 0.1f;
+        custom.width = 0.4f;
+
+        beginTest ("FreeVerb output is identical to the original implementation");
+        {
+            for (auto sampleRate : { 44100.0, 48000.0 })
+            {
+                for (const auto& parameters : { Reverb::Parameters{}, custom })
+                {
+                    Reverb reverb;
+                    ReferenceReverb reference;
+
+                    reverb.setSampleRate (sampleRate);
+                    reverb.setParameters (parameters);
+                    reference.setSampleRate (sampleRate);
+                    reference.setParameters (parameters);
+
+                    auto actual = makeImpulse (2, 20000);
+                    auto expected = makeImpulse (2, 20000);
+
+                    processInBlocks (actual, [&] (auto& block)
+                    {
+                        reverb.processStereo (block.getWritePointer (0), block.getWritePointer (1), block.getNumSamples());
+                    });
+
+                    processInBlocks (expected, [&] (auto& block)
+                    {
+                        reference.processStereo (block.getWritePointer (0), block.getWritePointer (1), block.getNumSamples());
+                    });
+
+                    expect (actual.getMagnitude (0, 1000, 19000) > 0.0f);
+                    expectBitIdentical (actual, expected);
+
+                    reverb.reset();
+                    reference.reset();
+
+                    auto actualMono = makeImpulse (1, 20000);
+                    auto expectedMono = makeImpulse (1, 20000);
+
+                    processInBlocks (actualMono,   [&] (auto& block) { reverb   .processMono (block.getWritePointer (0), block.getNumSamples()); });
+                    processInBlocks (expectedMono, [&] (auto& block) { reference.processMono (block.getWritePointer (0), block.getNumSamples()); });
+
+                    expectBitIdentical (actualMono, expectedMono);
+                }
+            }
+        }
+
+        beginTest ("The feedback delay network decays and stays bounded with the largest room and no damping");
+        {
+            Reverb reverb;
+            reverb.setAlgorithm (Reverb::Algorithm::feedbackDelayNetwork);
+            reverb.setParameters (makeParameters (1.0f, 0.0f, 0.0f));
+
+            const auto oneSecond = 44100;
+            auto buffer = makeImpulse (2, 10 * oneSecond);
+            processInBlocks (buffer, [&] (auto& block)
+            {
+                reverb.processStereo (block.getWritePointer (0), block.getWritePointer (1), block.getNumSamples());
+            });
+
+            const auto firstSecond = buffer.getRMSLevel (0, 0, oneSecond);
+            const auto lastSecond = buffer.getRMSLevel (0, 9 * oneSecond, oneSecond);
+
+            expect (firstSecond > 0.0f);
+            expect (buffer.getMagnitude (0, buffer.getNumSamples()) < 1.0f);
+            expect (lastSecond < firstSecond * 0.05f, "The tail didn't decay: " + String (lastSecond / firstSecond));
+        }
+
+        beginTest ("Freeze mode holds the tail");
+        {
+            for (auto algorithm : { Reverb::Algorithm::freeverb, Reverb::Algorithm::feedbackDelayNetwork })
+            {
+                Reverb reverb;
+                reverb.setAlgorithm (algorithm);
+                reverb.setParameters (makeParameters (0.5f, 0.5f, 0.0f));
+
+                const auto oneSecond = 44100;
+                auto buffer = makeImpulse (2, 4 * oneSecond);
+                int position = 0;
+
+                const auto process = [&] (int numSamples)
+                {
+                    reverb.processStereo (buffer.getWritePointer (0, position), buffer.getWritePointer (1, position), numSamples);
+                    position += numSamples;
+                };
+
+                process (oneSecond / 2);
+                reverb.setParameters (makeParameters (0.5f, 0.5f, 1.0f));
+
+                // Input is ignored while frozen
+                buffer.setSample (0, position + 100, 1.0f);
+                process (buffer.getNumSamples() - position);
+
+                const auto early = buffer.getRMSLevel (0, oneSecond, oneSecond);
+                const auto late  = buffer.getRMSLevel (0, 3 * oneSecond, oneSecond);
+
+                expect (early > 0.0f);
+                expectWithinAbsoluteError (late / early, 1.0f, 0.1f);
+            }
+        }
+
+        beginTest ("reset() clears the reverb's state");
+        {
+            for (auto algorithm : { Reverb::Algorithm::freeverb, Reverb::Algorithm::feedbackDelayNetwork })
+            {
+                Reverb reverb;
+                reverb.setAlgorithm (algorithm);
+                reverb.setParameters (makeParameters (0.9f, 0.1f, 0.0f));
+
+                auto stereo = makeImpulse (2, 10000);
+                reverb.processStereo (stereo.getWritePointer (0), stereo.getWritePointer (1), stereo.getNumSamples());
+                expect (stereo.getMagnitude (0, 5000, 5000) > 0.0f);
+
+                reverb.reset();
+
+                stereo.clear();
+                reverb.processStereo (stereo.getWritePointer (0), stereo.getWritePointer (1), stereo.getNumSamples());
+                expectEquals (stereo.getMagnitude (0, stereo.getNumSamples()), 0.0f);
+
+                auto mono = makeImpulse (1, 10000);
+                reverb.processMono (mono.getWritePointer (0), mono.getNumSamples());
+                expect (mono.getMagnitude (0, 5000, 5000) > 0.0f);
+
+                reverb.reset();
+
+                mono.clear();
+                reverb.processMono (mono.getWritePointer (0), mono.getNumSamples());
+                expectEquals (mono.getMagnitude (0, mono.getNumSamples()), 0.0f);
+            }
+        }
+    }
+
+private:
+    static Reverb::Parameters makeParameters (float roomSize, float damping, float freezeMode)
+    {
+        Reverb::Parameters parameters;
+        parameters.roomSize = roomSize;
+        parameters.damping = damping;
+        parameters.wetLevel = 1.0f / 3.0f;
+        parameters.dryLevel = 0.0f;
+        parameters.freezeMode = freezeMode;
+        return parameters;
+    }
+
+    static AudioBuffer<float> makeImpulse (int numChannels, int numSamples)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+        buffer.clear();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.setSample (channel, 0, 1.0f);
+
+        return buffer;
+    }
+
+    template <typename Callback>
+    static void processInBlocks (AudioBuffer<float>& buffer, Callback&& callback)
+    {
+        // An awkward block size, so that the blocks don't line up with the delay lines
+        constexpr int blockSize = 37;
+
+        for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+        {
+            AudioBuffer<float> block (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start,
+                                      jmin (blockSize, buffer.getNumSamples() - start));
+            callback (block);
+        }
+    }
+
+    void expectBitIdentical (const AudioBuffer<float>& actual, const AudioBuffer<float>& expected)
+    {
+        int numDifferences = 0;
+
+        for (int channel = 0; channel < actual.getNumChannels(); ++channel)
+            numDifferences += (int) std::count_if (actual.getReadPointer (channel),
+                                                   actual.getReadPointer (channel) + actual.getNumSamples(),
+                                                   [&, i = 0] (float sample) mutable
+                                                   {
+                                                       return std::memcmp (&sample, expected.getReadPointer (channel, i++), sizeof (float)) != 0;
+                                                   });
+
+        expectEquals (numDifferences, 0);
+    }
+
+    //==============================================================================
+    /*  The FreeVerb implementation that Reverb used before its comb filters were processed
+        as a bank, which its output must still match exactly.
+    */
+    class ReferenceReverb
+    {
+    public:
+        ReferenceReverb()
+        {
+            setParameters ({});
+            setSampleRate (44100.0);
+        }
+
+        void setParameters (const Reverb::Parameters& newParams)
+        {
+            const float wet = newParams.wetLevel * 3.0f;
+            dryGain.setTargetValue (newParams.dryLevel * 2.0f);
+            wetGain1.setTargetValue (0.5f * wet * (1.0f + newParams.width));
+            wetGain2.setTargetValue (0.5f * wet * (1.0f - newParams.width));
+
+            const auto frozen = newParams.freezeMode >= 0.5f;
+            gain = frozen ? 0.0f : 0.015f;
+            damping.setTargetValue (frozen ? 0.0f : newParams.damping * 0.4f);
+            feedback.setTargetValue (frozen ? 1.0f : newParams.roomSize * 0.28f + 0.7f);
+        }
+
+        void setSampleRate (const double sampleRate)
+        {
+            static const short combTunings[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+            static const short allPassTunings[] = { 556, 441, 341, 225 };
+            const int stereoSpread = 23;
+            const int intSampleRate = (int) sampleRate;
+
+            for (int i = 0; i < numCombs; ++i)
+            {
+                comb[0][i].setSize ((intSampleRate * combTunings[i]) / 44100);
+                comb[1][i].setSize ((intSampleRate * (combTunings[i] + stereoSpread)) / 44100);
+            }
+
+            for (int i = 0; i < numAllPasses; ++i)
+            {
+                allPass[0][i].setSize ((intSampleRate * allPassTunings[i]) / 44100);
+                allPass[1][i].setSize ((intSampleRate * (allPassTunings[i] + stereoSpread)) / 44100);
+            }
+
+            for (auto* value : { &damping, &feedback, &dryGain, &wetGain1, &wetGain2 })
+                value->reset (sampleRate, 0.01);
+        }
+
+        void reset()
+        {
+            for (int j = 0; j < numChannels; ++j)
+            {
+                for (auto& c : comb[j])
+                    c.clear();
+
+                for (auto& a : allPass[j])
+                    a.clear();
+            }
+        }
+
+        void processStereo (float* const left, float* const right, const int numSamples) noexcept
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float input = (left[i] + right[i]) * gain;
+                float outL = 0, outR = 0;
+
+                const float damp    = damping.getNextValue();
+                const float feedbck = feedback.getNextValue();
+
+                for (int j = 0; j < numCombs; ++j)
+                {
+                    outL += comb[0][j].process (input, damp, feedbck);
+                    outR += comb[1][j].process (input, damp, feedbck);
+                }
+
+                for (int j = 0; j < numAllPasses; ++j)
+                {
+                    outL = allPass[0][j].process (outL);
+                    outR = allPass[1][j].process (outR);
+                }
+
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
+                const float wet2 = wetGain2.getNextValue();
+
+                left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
+                right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+            }
+        }
+
+        void processMono (float* const samples, const int numSamples) noexcept
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float input = samples[i] * gain;
+                float output = 0;
+
+                const float damp    = damping.getNextValue();
+                const float feedbck = feedback.getNextValue();
+
+                for (int j = 0; j < numCombs; ++j)
+                    output += comb[0][j].process (input, damp, feedbck);
+
+                for (int j = 0; j < numAllPasses; ++j)
+                    output = allPass[0][j].process (output);
+
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
+
+                samples[i] = output * wet1 + samples[i] * dry;
+            }
+        }
+
+    private:
+        struct CombFilter
+        {
+            void setSize (const int size)
+            {
+                buffer.assign ((size_t) size, 0.0f);
+                bufferIndex = 0;
+                last = 0.0f;
+            }
+
+            void clear()
+            {
+                std::fill (buffer.begin(), buffer.end(), 0.0f);
+                last = 0.0f;
+            }
+
+            float process (const float input, const float damp, const float feedbackLevel) noexcept
+            {
+                const float output = buffer[bufferIndex];
+                last = (output * (1.0f - damp)) + (last * damp);
+                JUCE_UNDENORMALISE (last);
+
+                float temp = input + (last * feedbackLevel);
+                JUCE_UNDENORMALISE (temp);
+                buffer[bufferIndex] = temp;
+                bufferIndex = (bufferIndex + 1) % buffer.size();
+                return output;
+            }
+
+            std::vector<float> buffer;
+            size_t bufferIndex = 0;
+            float last = 0.0f;
+        };
+
+        struct AllPassFilter
+        {
+            void setSize (const int size)
+            {
+                buffer.assign ((size_t) size, 0.0f);
+                bufferIndex = 0;
+            }
+
+            void clear()
+            {
+                std::fill (buffer.begin(), buffer.end(), 0.0f);
+            }
+
+            float process (const float input) noexcept
+            {
+                const float bufferedValue = buffer[bufferIndex];
+                float temp = input + (bufferedValue * 0.5f);
+                JUCE_UNDENORMALISE (temp);
+                buffer[bufferIndex] = temp;
+                bufferIndex = (bufferIndex + 1) % buffer.size();
+                return bufferedValue - input;
+            }
+
+            std::vector<float> buffer;
+            size_t bufferIndex = 0;
+        };
+
+        enum { numCombs = 8, numAllPasses = 4, numChannels = 2 };
+
+        float gain = 0.015f;
+        CombFilter comb[numChannels][numCombs];
+        AllPassFilter allPass[numChannels][numAllPasses];
+        SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
+    };
+};
+
+static ReverbTests reverbTests;
+
+} // namespace juce
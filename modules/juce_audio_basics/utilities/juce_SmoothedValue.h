@@ -78,6 +78,30 @@ public:
         countdown = 0;
     }
 
+    //==============================================================================
+    /** Fills an array with the next values of the smoothed value.
+
+        This gives the same results as calling getNextValue() numSamples times (apart
+        from rounding errors for some smoothing types), but avoids the per-sample
+        bookkeeping, and the resulting array can be applied to many channels with
+        vectorised operations.
+
+        @param dest        Pointer to a raw array to fill
+        @param numSamples  The number of values to generate
+    */
+    void fillRamp (FloatType* dest, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0);
+
+        const auto numToSmooth = jmin (numSamples, countdown);
+
+        if (numToSmooth > 0)
+            static_cast<SmoothedValueType*> (this)->generateRamp (dest, numToSmooth);
+
+        if (numToSmooth < numSamples)
+            FloatVectorOperations::fill (dest + numToSmooth, target, numSamples - numToSmooth);
+    }
+
     //==============================================================================
     /** Applies a smoothed gain to a stream of samples
         S[i] *= gain
@@ -90,8 +114,10 @@ public:
 
         if (isSmoothing())
         {
-            for (int i = 0; i < numSamples; ++i)
-                samples[i] *= getNextSmoothedValue();
+            forEachRampChunk (numSamples, [&] (const FloatType* ramp, int offset, int num)
+            {
+                FloatVectorOperations::multiply (samples + offset, ramp, num);
+            });
         }
         else
         {
@@ -111,8 +137,10 @@ public:
 
         if (isSmoothing())
         {
-            for (int i = 0; i < numSamples; ++i)
-                samplesOut[i] = samplesIn[i] * getNextSmoothedValue();
+            forEachRampChunk (numSamples, [&] (const FloatType* ramp, int offset, int num)
+            {
+                FloatVectorOperations::multiply (samplesOut + offset, samplesIn + offset, ramp, num);
+            });
         }
         else
         {
@@ -127,23 +155,11 @@ public:
 
         if (isSmoothing())
         {
-            if (buffer.getNumChannels() == 1)
-            {
-                auto* samples = buffer.getWritePointer (0);
-
-                for (int i = 0; i < numSamples; ++i)
-                    samples[i] *= getNextSmoothedValue();
-            }
-            else
+            forEachRampChunk (numSamples, [&] (const FloatType* ramp, int offset, int num)
             {
-                for (auto i = 0; i < numSamples; ++i)
-                {
-                    auto gain = getNextSmoothedValue();
-
-                    for (int channel = 0; channel < buffer.getNumChannels(); channel++)
-                        buffer.setSample (channel, i, buffer.getSample (channel, i) * gain);
-                }
-            }
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    FloatVectorOperations::multiply (buffer.getWritePointer (channel, offset), ramp, num);
+            });
         }
         else
         {
@@ -153,9 +169,18 @@ public:
 
 private:
     //==============================================================================
-    FloatType getNextSmoothedValue() noexcept
+    template <typename Callback>
+    void forEachRampChunk (int numSamples, Callback&& callback) noexcept
     {
-        return static_cast <SmoothedValueType*> (this)->getNextValue();
+        constexpr int chunkSize = 64;
+        FloatType ramp[chunkSize];
+
+        for (int offset = 0; offset < numSamples; offset += chunkSize)
+        {
+            const auto num = jmin (chunkSize, numSamples - offset);
+            fillRamp (ramp, num);
+            callback (ramp, offset, num);
+        }
     }
 
 protected:
@@ -353,6 +378,32 @@ public:
    #endif
 
 private:
+    //==============================================================================
+    friend class SmoothedValueBase<SmoothedValue>;
+
+    // Called by fillRamp() with 0 < numSamples <= countdown
+    void generateRamp (FloatType* dest, int numSamples) noexcept
+    {
+        auto value = this->currentValue;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if constexpr (std::is_same_v<SmoothingType, ValueSmoothingTypes::Linear>)
+                value += step;
+            else
+                value *= step;
+
+            dest[i] = value;
+        }
+
+        this->countdown -= numSamples;
+
+        if (this->isSmoothing())
+            this->currentValue = dest[numSamples - 1];
+        else
+            this->currentValue = dest[numSamples - 1] = this->target;
+    }
+
     //==============================================================================
     template <typename T = SmoothingType>
     void setStepSize() noexcept
@@ -619,6 +670,30 @@ public:
                     expectEquals (sv.getNextValue(), -positiveSv.getNextValue());
             }
         }
+
+        beginTest ("Ramp generation");
+        {
+            for (auto rampLength : { 1, 3, 30, 200 })
+            {
+                SmoothedValueType sv (1.0f), reference (1.0f);
+                sv.reset (rampLength);
+                reference.reset (rampLength);
+                sv.setTargetValue (2.0f);
+                reference.setTargetValue (2.0f);
+
+                std::vector<float> ramp ((size_t) rampLength + 50);
+
+                // Generate the ramp in uneven pieces, to check that it carries on correctly
+                for (size_t start = 0, size = 1; start < ramp.size(); start += size, size += 7)
+                    sv.fillRamp (ramp.data() + start, (int) jmin (size, ramp.size() - start));
+
+                for (auto value : ramp)
+                    expectWithinAbsoluteError (value, reference.getNextValue(), 2.0e-6f);
+
+                expectWithinAbsoluteError (sv.getCurrentValue(), reference.getCurrentValue(), 2.0e-6f);
+                expect (! sv.isSmoothing());
+            }
+        }
     }
 };
 
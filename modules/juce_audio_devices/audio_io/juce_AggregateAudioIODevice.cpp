@@ -0,0 +1,903 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  A single-producer, single-consumer FIFO of multichannel audio that resamples on
+    the way out, so that audio produced against one clock can be consumed against
+    another.
+
+    The consumer steers the resampling ratio with a PI controller, driven by how far
+    the FIFO's fill level is from its target. Because the producer delivers whole
+    blocks, the number of samples in the FIFO only changes in steps, and the steps
+    only move relative to the consumer's callbacks as fast as the clocks drift apart.
+    So rather than using the raw count, the consumer estimates the fill level from
+    the time that has passed since the producer's last block, and low-pass filters
+    that to keep the ratio steady.
+*/
+class DriftCompensatedAudioFifo
+{
+public:
+    /*  Must not be called while either side is running.
+
+        Rates are the nominal sample rates of each side, and block sizes are the
+        largest blocks that each side will push or pull.
+    */
+    void prepare (int newNumChannels,
+                  double producerSampleRate, double consumerSampleRate,
+                  int producerBlockSize, int consumerBlockSize)
+    {
+        numChannels = newNumChannels;
+        producerRate = producerSampleRate;
+        consumerRate = consumerSampleRate;
+        maxProducerBlockSize = producerBlockSize;
+        nominalRatio = producerSampleRate / consumerSampleRate;
+        maxConsumerBlockSize = consumerBlockSize;
+
+        targetLevel = producerBlockSize + (int) std::ceil (consumerBlockSize * nominalRatio) + safetyMargin;
+
+        const auto capacity = 4 * targetLevel + 2 * producerBlockSize;
+        buffer.setSize (jmax (1, numChannels), capacity);
+        buffer.clear();
+        fifo.setTotalSize (capacity);
+        fifo.reset();
+
+        scratch.setSize (jmax (1, numChannels), (int) std::ceil (consumerBlockSize * nominalRatio * (1.0 + maxCorrection)) + 4);
+
+        interpolators.clear();
+        interpolators.resize ((size_t) numChannels);
+
+        smoothedError = 0.0;
+        integral = 0.0;
+        correction = 0.0;
+        numXRuns = 0;
+        lastPushTime = -1.0;
+
+        // Start with enough silence that the level will be on target once the producer
+        // has delivered its first block
+        fifo.finishedWrite (targetLevel - producerBlockSize);
+    }
+
+    int getNumChannels() const noexcept         { return numChannels; }
+    int getTargetLevel() const noexcept         { return targetLevel; }
+    int getNumXRuns() const noexcept            { return numXRuns.load(); }
+
+    /*  Returns the estimated ratio between the producer's clock and the consumer's,
+        relative to their nominal rates.
+    */
+    double getClockRatio() const noexcept       { return 1.0 + correction.load(); }
+
+    //==============================================================================
+    /*  The times passed to push() and pull() should come from the same clock, in
+        seconds, e.g. Time::getMillisecondCounterHiRes() * 0.001.
+    */
+    void push (const float* const* channels, int numSamples, double time) noexcept
+    {
+        const auto numToWrite = jmin (numSamples, fifo.getFreeSpace());
+
+        if (numToWrite < numSamples)
+            ++numXRuns;
+
+        const auto scope = fifo.write (numToWrite);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (scope.blockSize1 > 0)  buffer.copyFrom (ch, scope.startIndex1, channels[ch], scope.blockSize1);
+            if (scope.blockSize2 > 0)  buffer.copyFrom (ch, scope.startIndex2, channels[ch] + scope.blockSize1, scope.blockSize2);
+        }
+
+        lastPushTime = time;
+    }
+
+    void pull (float* const* channels, int numSamples, double time) noexcept
+    {
+        jassert (numSamples <= maxConsumerBlockSize);
+
+        const auto ratio = updateRatio (numSamples, getEstimatedLevel (time));
+        const auto numReady = fifo.getNumReady();
+        const auto numNeeded = jmin (scratch.getNumSamples(), (int) std::ceil (numSamples * ratio) + 2);
+
+        if (numReady < numNeeded)
+        {
+            // the producer has stalled or fallen behind, so output silence and let
+            // the FIFO fill up again
+            ++numXRuns;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                FloatVectorOperations::clear (channels[ch], numSamples);
+
+            return;
+        }
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (numNeeded, start1, size1, start2, size2);
+
+        auto numUsed = 0;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (size1 > 0)  scratch.copyFrom (ch, 0, buffer, ch, start1, size1);
+            if (size2 > 0)  scratch.copyFrom (ch, size1, buffer, ch, start2, size2);
+
+            numUsed = interpolators[(size_t) ch].process (ratio, scratch.getReadPointer (ch), channels[ch], numSamples);
+        }
+
+        fifo.finishedRead (jmin (numUsed, numNeeded));
+    }
+
+private:
+    double getEstimatedLevel (double time) const noexcept
+    {
+        // If the producer pushes while this is happening, the time and the count
+        // won't match, so try again
+        for (;;)
+        {
+            const auto pushTime = lastPushTime.load();
+            const auto numReady = fifo.getNumReady();
+
+            if (exactlyEqual (pushTime, lastPushTime.load()))
+            {
+                if (pushTime < 0.0)
+                    return (double) numReady;
+
+                return numReady + jlimit (0.0, (double) maxProducerBlockSize, (time - pushTime) * producerRate);
+            }
+        }
+    }
+
+    double updateRatio (int numSamples, double level) noexcept
+    {
+        // The loop's natural frequency and the smoothing are set in seconds, so that
+        // the behaviour doesn't depend on the block size.
+        const auto blockDuration = numSamples / consumerRate;
+        const auto omega = MathConstants<double>::twoPi * loopBandwidthHz * blockDuration;
+        const auto samplesPerBlock = numSamples * nominalRatio;
+        const auto proportionalGain = 2.0 * dampingRatio * omega / samplesPerBlock;
+        const auto integralGain = omega * omega / samplesPerBlock;
+
+        const auto error = level - targetLevel;
+        smoothedError += jmin (1.0, blockDuration / smoothingTimeSeconds) * (error - smoothedError);
+
+        integral = jlimit (-maxCorrection / integralGain, maxCorrection / integralGain, integral + smoothedError);
+
+        const auto newCorrection = jlimit (-maxCorrection, maxCorrection,
+                                           proportionalGain * smoothedError + integralGain * integral);
+        correction = newCorrection;
+
+        return nominalRatio * (1.0 + newCorrection);
+    }
+
+    static constexpr int safetyMargin = 64;
+    static constexpr double loopBandwidthHz = 0.1, dampingRatio = 0.7, smoothingTimeSeconds = 0.2;
+
+    // real clocks are within a few hundred ppm of each other, so anything
+    // beyond this means something has gone wrong
+    static constexpr double maxCorrection = 0.01;
+
+    AbstractFifo fifo { 1 };
+    AudioBuffer<float> buffer, scratch;
+    std::vector<LagrangeInterpolator> interpolators;
+
+    int numChannels = 0, targetLevel = 0, maxProducerBlockSize = 0, maxConsumerBlockSize = 0;
+    double producerRate = 44100.0, consumerRate = 44100.0, nominalRatio = 1.0;
+    double smoothedError = 0.0, integral = 0.0;
+    std::atomic<double> correction { 0.0 }, lastPushTime { -1.0 };
+    std::atomic<int> numXRuns { 0 };
+};
+
+//==============================================================================
+/*  One of the aggregate's devices other than the master. Its own callback feeds its
+    inputs to the master's callback, and plays the outputs that the master's callback
+    has produced for it.
+*/
+class AggregateAudioIODevice::SecondaryDevice final  : public AudioIODeviceCallback
+{
+public:
+    SecondaryDevice (AudioIODevice& d, int numIns, int numOuts, double masterRate, int maxMasterBlockSize)
+        : device (d)
+    {
+        const auto rate = device.getCurrentSampleRate();
+        const auto blockSize = device.getCurrentBufferSizeSamples();
+
+        inputs.prepare (numIns, rate, masterRate, blockSize, maxMasterBlockSize);
+        outputs.prepare (numOuts, masterRate, rate, maxMasterBlockSize, blockSize);
+
+        inputBuffer.setSize (jmax (1, numIns), maxMasterBlockSize);
+        outputBuffer.setSize (jmax (1, numOuts), maxMasterBlockSize);
+        inputBuffer.clear();
+        outputBuffer.clear();
+    }
+
+    // Called by the master's callback
+    void pullInputs (int numSamples, double time) noexcept
+    {
+        if (inputs.getNumChannels() > 0)
+            inputs.pull (inputBuffer.getArrayOfWritePointers(), numSamples, time);
+    }
+
+    void pushOutputs (int numSamples, double time) noexcept
+    {
+        if (outputs.getNumChannels() > 0)
+            outputs.push (outputBuffer.getArrayOfReadPointers(), numSamples, time);
+    }
+
+    double getClockRatio() const noexcept
+    {
+        if (inputs.getNumChannels() > 0)
+            return inputs.getClockRatio();
+
+        if (outputs.getNumChannels() > 0)
+            return 1.0 / outputs.getClockRatio();
+
+        return 1.0;
+    }
+
+    //==============================================================================
+    void audioDeviceIOCallbackWithContext (const float* const* ins, int numIns,
+                                           float* const* outs, int numOuts, int numSamples,
+                                           const AudioIODeviceCallbackContext&) override
+    {
+        const auto time = Time::getMillisecondCounterHiRes() * 0.001;
+
+        if (numIns > 0)
+        {
+            jassert (numIns == inputs.getNumChannels());
+            inputs.push (ins, numSamples, time);
+        }
+
+        if (numOuts > 0)
+        {
+            jassert (numOuts == outputs.getNumChannels());
+            outputs.pull (outs, numSamples, time);
+        }
+    }
+
+    void audioDeviceAboutToStart (AudioIODevice*) override {}
+    void audioDeviceStopped() override {}
+
+    AudioIODevice& device;
+    DriftCompensatedAudioFifo inputs, outputs;
+    AudioBuffer<float> inputBuffer, outputBuffer;
+};
+
+//==============================================================================
+AggregateAudioIODevice::AggregateAudioIODevice (const String& deviceName,
+                                                std::vector<std::unique_ptr<AudioIODevice>> newDevices)
+    : AudioIODevice (deviceName, "Aggregate"),
+      devices (std::move (newDevices))
+{
+    jassert (! devices.empty() && std::none_of (devices.begin(), devices.end(), [] (auto& d) { return d == nullptr; }));
+}
+
+AggregateAudioIODevice::~AggregateAudioIODevice()
+{
+    close();
+}
+
+AudioIODevice* AggregateAudioIODevice::getDevice (int index) const noexcept
+{
+    return isPositiveAndBelow (index, devices.size()) ? devices[(size_t) index].get() : nullptr;
+}
+
+double AggregateAudioIODevice::getEstimatedClockRatio (int deviceIndex) const noexcept
+{
+    if (auto* d = getDevice (deviceIndex))
+        for (auto& s : secondaries)
+            if (&s->device == d)
+                return s->getClockRatio();
+
+    return 1.0;
+}
+
+//==============================================================================
+static StringArray getAggregateChannelNames (const std::vector<std::unique_ptr<AudioIODevice>>& devices, bool forInput)
+{
+    StringArray names;
+
+    for (auto& d : devices)
+        for (auto& name : forInput ? d->getInputChannelNames() : d->getOutputChannelNames())
+            names.add (d->getName() + ": " + name);
+
+    return names;
+}
+
+StringArray AggregateAudioIODevice::getOutputChannelNames()     { return getAggregateChannelNames (devices, false); }
+StringArray AggregateAudioIODevice::getInputChannelNames()      { return getAggregateChannelNames (devices, true); }
+
+Array<double> AggregateAudioIODevice::getAvailableSampleRates() { return getMaster().getAvailableSampleRates(); }
+Array<int> AggregateAudioIODevice::getAvailableBufferSizes()    { return getMaster().getAvailableBufferSizes(); }
+int AggregateAudioIODevice::getDefaultBufferSize()              { return getMaster().getDefaultBufferSize(); }
+
+String AggregateAudioIODevice::open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                                     double sampleRate, int bufferSizeSamples)
+{
+    close();
+    lastError.clear();
+
+    inputOffsets.clear();
+    outputOffsets.clear();
+
+    auto inputOffset = 0, outputOffset = 0;
+    auto masterRate = sampleRate;
+    auto masterBlockSize = bufferSizeSamples;
+
+    for (auto& d : devices)
+    {
+        const auto numIns  = d->getInputChannelNames().size();
+        const auto numOuts = d->getOutputChannelNames().size();
+        const auto ins  = inputChannels.getBitRange (inputOffset, numIns);
+        const auto outs = outputChannels.getBitRange (outputOffset, numOuts);
+
+        inputOffsets.push_back (inputOffset);
+        outputOffsets.push_back (outputOffset);
+        inputOffset += numIns;
+        outputOffset += numOuts;
+
+        const auto isMaster = d == devices.front();
+
+        // the master always runs, because it drives everything else
+        if (! isMaster && ins.isZero() && outs.isZero())
+            continue;
+
+        auto rate = masterRate;
+        auto blockSize = masterBlockSize;
+
+        if (! isMaster)
+        {
+            // Use the master's rate if possible, otherwise the nearest one, and a
+            // block that lasts about as long as the master's
+            const auto rates = d->getAvailableSampleRates();
+
+            if (! rates.isEmpty() && ! rates.contains (rate))
+                rate = *std::min_element (rates.begin(), rates.end(), [&] (auto a, auto b)
+                {
+                    return std::abs (a - masterRate) < std::abs (b - masterRate);
+                });
+
+            const auto idealBlockSize = roundToInt (masterBlockSize * rate / masterRate);
+            const auto sizes = d->getAvailableBufferSizes();
+
+            blockSize = sizes.isEmpty() ? idealBlockSize
+                                        : *std::min_element (sizes.begin(), sizes.end(), [&] (auto a, auto b)
+                                          {
+                                              return std::abs (a - idealBlockSize) < std::abs (b - idealBlockSize);
+                                          });
+        }
+
+        const auto error = d->open (ins, outs, rate, blockSize);
+
+        if (error.isNotEmpty())
+        {
+            lastError = d->getName() + ": " + error;
+            close();
+            return lastError;
+        }
+
+        if (isMaster)
+        {
+            masterRate = d->getCurrentSampleRate();
+            masterBlockSize = d->getCurrentBufferSizeSamples();
+
+            // The master's block size is only a guide for some devices, so leave room
+            // for a larger block than expected
+            maxBlockSize = masterBlockSize * 2;
+        }
+        else
+        {
+            secondaries.push_back (std::make_unique<SecondaryDevice> (*d,
+                                                                      d->getActiveInputChannels().countNumberOfSetBits(),
+                                                                      d->getActiveOutputChannels().countNumberOfSetBits(),
+                                                                      masterRate,
+                                                                      maxBlockSize));
+        }
+    }
+
+    inputPointers.resize (getActiveInputChannels().countNumberOfSetBits());
+    outputPointers.resize (getActiveOutputChannels().countNumberOfSetBits());
+
+    for (auto& s : secondaries)
+        s->device.start (s.get());
+
+    getMaster().start (this);
+
+    deviceIsOpen = true;
+    return {};
+}
+
+void AggregateAudioIODevice::close()
+{
+    stop();
+
+    getMaster().stop();
+
+    for (auto& s : secondaries)
+        s->device.stop();
+
+    for (auto& d : devices)
+        d->close();
+
+    secondaries.clear();
+    deviceIsOpen = false;
+}
+
+bool AggregateAudioIODevice::isOpen()                       { return deviceIsOpen; }
+
+void AggregateAudioIODevice::start (AudioIODeviceCallback* newCallback)
+{
+    if (deviceIsOpen && newCallback != callback)
+    {
+        if (newCallback != nullptr)
+            newCallback->audioDeviceAboutToStart (this);
+
+        AudioIODeviceCallback* const oldCallback = callback;
+
+        {
+            const ScopedLock sl (callbackLock);
+            callback = newCallback;
+        }
+
+        if (oldCallback != nullptr)
+            oldCallback->audioDeviceStopped();
+    }
+}
+
+void AggregateAudioIODevice::stop()                         { start (nullptr); }
+bool AggregateAudioIODevice::isPlaying()                    { return callback != nullptr; }
+String AggregateAudioIODevice::getLastError()               { return lastError; }
+int AggregateAudioIODevice::getCurrentBufferSizeSamples()   { return getMaster().getCurrentBufferSizeSamples(); }
+double AggregateAudioIODevice::getCurrentSampleRate()       { return getMaster().getCurrentSampleRate(); }
+int AggregateAudioIODevice::getCurrentBitDepth()            { return getMaster().getCurrentBitDepth(); }
+
+static BigInteger getAggregateActiveChannels (const std::vector<std::unique_ptr<AudioIODevice>>& devices,
+                                              const std::vector<int>& offsets,
+                                              bool forInput)
+{
+    BigInteger result;
+
+    for (size_t i = 0; i < offsets.size(); ++i)
+    {
+        const auto active = forInput ? devices[i]->getActiveInputChannels()
+                                     : devices[i]->getActiveOutputChannels();
+
+        for (int bit = active.findNextSetBit (0); bit >= 0; bit = active.findNextSetBit (bit + 1))
+            result.setBit (offsets[i] + bit);
+    }
+
+    return result;
+}
+
+BigInteger AggregateAudioIODevice::getActiveOutputChannels() const
+{
+    return deviceIsOpen ? getAggregateActiveChannels (devices, outputOffsets, false) : BigInteger();
+}
+
+BigInteger AggregateAudioIODevice::getActiveInputChannels() const
+{
+    return deviceIsOpen ? getAggregateActiveChannels (devices, inputOffsets, true) : BigInteger();
+}
+
+int AggregateAudioIODevice::getOutputLatencyInSamples()
+{
+    auto latency = getMaster().getOutputLatencyInSamples();
+
+    for (auto& s : secondaries)
+    {
+        const auto scale = getCurrentSampleRate() / s->device.getCurrentSampleRate();
+        latency = jmax (latency, s->outputs.getTargetLevel() + roundToInt (s->device.getOutputLatencyInSamples() * scale));
+    }
+
+    return latency;
+}
+
+int AggregateAudioIODevice::getInputLatencyInSamples()
+{
+    auto latency = getMaster().getInputLatencyInSamples();
+
+    for (auto& s : secondaries)
+    {
+        const auto scale = getCurrentSampleRate() / s->device.getCurrentSampleRate();
+        latency = jmax (latency, roundToInt ((s->inputs.getTargetLevel() + s->device.getInputLatencyInSamples()) * scale));
+    }
+
+    return latency;
+}
+
+int AggregateAudioIODevice::getXRunCount() const noexcept
+{
+    auto total = jmax (0, getMaster().getXRunCount());
+
+    for (auto& s : secondaries)
+        total += jmax (0, s->device.getXRunCount()) + s->inputs.getNumXRuns() + s->outputs.getNumXRuns();
+
+    return total;
+}
+
+//==============================================================================
+void AggregateAudioIODevice::audioDeviceIOCallbackWithContext (const float* const* ins, int numIns,
+                                                               float* const* outs, int numOuts,
+                                                               int numSamples,
+                                                               const AudioIODeviceCallbackContext& context)
+{
+    if (numSamples > maxBlockSize)
+    {
+        jassertfalse;
+
+        for (int i = 0; i < numOuts; ++i)
+            FloatVectorOperations::clear (outs[i], numSamples);
+
+        return;
+    }
+
+    const auto time = Time::getMillisecondCounterHiRes() * 0.001;
+    auto numInputs = 0, numOutputs = 0;
+
+    for (int i = 0; i < numIns; ++i)
+        inputPointers.set (numInputs++, ins[i]);
+
+    for (int i = 0; i < numOuts; ++i)
+        outputPointers.set (numOutputs++, outs[i]);
+
+    for (auto& s : secondaries)
+    {
+        s->pullInputs (numSamples, time);
+
+        for (int i = 0; i < s->inputs.getNumChannels(); ++i)
+            inputPointers.set (numInputs++, s->inputBuffer.getReadPointer (i));
+
+        for (int i = 0; i < s->outputs.getNumChannels(); ++i)
+            outputPointers.set (numOutputs++, s->outputBuffer.getWritePointer (i));
+    }
+
+    {
+        const ScopedLock sl (callbackLock);
+
+        if (callback != nullptr)
+        {
+            callback->audioDeviceIOCallbackWithContext (inputPointers.getRawDataPointer(), numInputs,
+                                                        outputPointers.getRawDataPointer(), numOutputs,
+                                                        numSamples, context);
+        }
+        else
+        {
+            for (int i = 0; i < numOutputs; ++i)
+                FloatVectorOperations::clear (outputPointers.getUnchecked (i), numSamples);
+        }
+    }
+
+    for (auto& s : secondaries)
+        s->pushOutputs (numSamples, time);
+}
+
+void AggregateAudioIODevice::audioDeviceAboutToStart (AudioIODevice*) {}
+void AggregateAudioIODevice::audioDeviceStopped() {}
+
+void AggregateAudioIODevice::audioDeviceError (const String& errorMessage)
+{
+    const ScopedLock sl (callbackLock);
+
+    if (callback != nullptr)
+        callback->audioDeviceError (errorMessage);
+}
+
+//==============================================================================
+AggregateAudioIODeviceType::AggregateAudioIODeviceType (const String& aggregateDeviceName,
+                                                        std::vector<DeviceFactory> deviceFactories)
+    : AudioIODeviceType ("Aggregate"),
+      deviceName (aggregateDeviceName),
+      factories (std::move (deviceFactories))
+{
+    jassert (! factories.empty());
+}
+
+AggregateAudioIODeviceType::DeviceFactory AggregateAudioIODeviceType::createDeviceFactory (AudioIODeviceType& type,
+                                                                                           const String& outputDeviceName,
+                                                                                           const String& inputDeviceName)
+{
+    return [&type, outputDeviceName, inputDeviceName]
+    {
+        return std::unique_ptr<AudioIODevice> (type.createDevice (outputDeviceName, inputDeviceName));
+    };
+}
+
+void AggregateAudioIODeviceType::scanForDevices() {}
+
+StringArray AggregateAudioIODeviceType::getDeviceNames (bool) const        { return { deviceName }; }
+int AggregateAudioIODeviceType::getDefaultDeviceIndex (bool) const         { return 0; }
+bool AggregateAudioIODeviceType::hasSeparateInputsAndOutputs() const       { return false; }
+
+int AggregateAudioIODeviceType::getIndexOfDevice (AudioIODevice* device, bool) const
+{
+    if (auto* d = dynamic_cast<AggregateAudioIODevice*> (device))
+        if (d->getName() == deviceName)
+            return 0;
+
+    return -1;
+}
+
+AudioIODevice* AggregateAudioIODeviceType::createDevice (const String& outputDeviceName, const String& inputDeviceName)
+{
+    if (outputDeviceName != deviceName && inputDeviceName != deviceName)
+        return nullptr;
+
+    std::vector<std::unique_ptr<AudioIODevice>> devices;
+
+    for (auto& factory : factories)
+    {
+        auto d = factory != nullptr ? factory() : nullptr;
+
+        if (d == nullptr)
+            return nullptr;
+
+        devices.push_back (std::move (d));
+    }
+
+    return new AggregateAudioIODevice (deviceName, std::move (devices));
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AggregateAudioIODeviceTests final : public UnitTest
+{
+public:
+    AggregateAudioIODeviceTests()
+        : UnitTest ("AggregateAudioIODevice", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("The FIFO follows a drifting producer clock without xruns");
+        {
+            for (const auto drift : { 0.0, 300.0e-6, -300.0e-6 })
+            {
+                DriftCompensatedAudioFifo fifo;
+                fifo.prepare (1, 48000.0, 48000.0, 256, 512);
+
+                simulate (fifo, 48000.0 * (1.0 + drift), 256, 48000.0, 512, 60.0);
+
+                expectEquals (fifo.getNumXRuns(), 0);
+                expectWithinAbsoluteError (fifo.getClockRatio(), 1.0 + drift, 20.0e-6);
+            }
+        }
+
+        beginTest ("The FIFO converts between nominal rates");
+        {
+            DriftCompensatedAudioFifo fifo;
+            fifo.prepare (1, 44100.0, 48000.0, 441, 480);
+
+            std::vector<float> received;
+
+            simulate (fifo, 44100.0 * (1.0 + 100.0e-6), 441, 48000.0, 480, 20.0, &received);
+
+            expectEquals (fifo.getNumXRuns(), 0);
+
+            // the producer sends a 1 kHz sine, so after settling there should be 48
+            // samples per cycle at the consumer's rate
+            const auto numCrossings = countRisingZeroCrossings (received, received.size() / 2, received.size());
+            const auto seconds = (double) (received.size() / 2) / 48000.0;
+            expectWithinAbsoluteError (numCrossings / seconds, 1000.0, 2.0);
+        }
+
+        beginTest ("An aggregate combines the channels of its devices");
+        {
+            auto master = std::make_unique<MockDevice> ("A", 2, 2);
+            auto secondary = std::make_unique<MockDevice> ("B", 1, 1);
+            auto& masterRef = *master;
+            auto& secondaryRef = *secondary;
+
+            std::vector<std::unique_ptr<AudioIODevice>> devices;
+            devices.push_back (std::move (master));
+            devices.push_back (std::move (secondary));
+
+            AggregateAudioIODevice aggregate ("Both", std::move (devices));
+
+            expect (aggregate.getInputChannelNames() == StringArray { "A: in 1", "A: in 2", "B: in 1" });
+            expect (aggregate.getOutputChannelNames() == StringArray { "A: out 1", "A: out 2", "B: out 1" });
+
+            expect (aggregate.open (0b101, 0b110, 48000.0, 256).isEmpty());
+            expect (aggregate.getActiveInputChannels() == BigInteger (0b101));
+            expect (aggregate.getActiveOutputChannels() == BigInteger (0b110));
+            expectEquals (masterRef.numIns, 1);
+            expectEquals (masterRef.numOuts, 1);
+            expectEquals (secondaryRef.numIns, 1);
+            expectEquals (secondaryRef.numOuts, 1);
+
+            // route each input to an output
+            struct Callback final : public AudioIODeviceCallback
+            {
+                void audioDeviceIOCallbackWithContext (const float* const* ins, int numIns,
+                                                       float* const* outs, int numOuts, int n,
+                                                       const AudioIODeviceCallbackContext&) override
+                {
+                    numInputs = numIns;
+                    numOutputs = numOuts;
+
+                    for (int i = 0; i < numOuts; ++i)
+                        FloatVectorOperations::copy (outs[i], ins[i], n);
+                }
+
+                void audioDeviceAboutToStart (AudioIODevice*) override {}
+                void audioDeviceStopped() override {}
+
+                int numInputs = 0, numOutputs = 0;
+            } callback;
+
+            aggregate.start (&callback);
+
+            masterRef.inputValue = 0.25f;
+            secondaryRef.inputValue = 0.5f;
+
+            for (int i = 0; i < 400; ++i)
+            {
+                masterRef.process();
+                secondaryRef.process();
+            }
+
+            expectEquals (callback.numInputs, 2);
+            expectEquals (callback.numOutputs, 2);
+
+            // the master's input goes to the master's output directly, and the
+            // secondary's goes through both FIFOs to come back out
+            expectWithinAbsoluteError (masterRef.lastOutput, 0.25f, 1.0e-6f);
+            expectWithinAbsoluteError (secondaryRef.lastOutput, 0.5f, 1.0e-3f);
+            expectEquals (aggregate.getXRunCount(), 0);
+
+            aggregate.close();
+            expect (! masterRef.isOpen() && ! secondaryRef.isOpen());
+        }
+    }
+
+private:
+    //==============================================================================
+    // Runs a producer and consumer against simulated clocks, with the producer sending a 1 kHz sine
+    static void simulate (DriftCompensatedAudioFifo& fifo,
+                          double producerRate, int producerBlock,
+                          double consumerRate, int consumerBlock,
+                          double duration,
+                          std::vector<float>* received = nullptr)
+    {
+        std::vector<float> in ((size_t) producerBlock), out ((size_t) consumerBlock);
+        auto producerTime = 0.0, consumerTime = 0.0, phase = 0.0;
+
+        while (consumerTime < duration)
+        {
+            if (producerTime <= consumerTime)
+            {
+                for (auto& s : in)
+                {
+                    s = (float) std::sin (phase);
+                    phase += MathConstants<double>::twoPi * 1000.0 / producerRate;
+                }
+
+                const float* channels[] { in.data() };
+                fifo.push (channels, producerBlock, producerTime);
+                producerTime += producerBlock / producerRate;
+            }
+            else
+            {
+                float* channels[] { out.data() };
+                fifo.pull (channels, consumerBlock, consumerTime);
+                consumerTime += consumerBlock / consumerRate;
+
+                if (received != nullptr)
+                    received->insert (received->end(), out.begin(), out.end());
+            }
+        }
+    }
+
+    static int countRisingZeroCrossings (const std::vector<float>& samples, size_t start, size_t end)
+    {
+        auto count = 0;
+
+        for (auto i = start + 1; i < end; ++i)
+            if (samples[i - 1] < 0.0f && samples[i] >= 0.0f)
+                ++count;
+
+        return count;
+    }
+
+    //==============================================================================
+    struct MockDevice final : public AudioIODevice
+    {
+        MockDevice (const String& deviceName, int numInputs, int numOutputs)
+            : AudioIODevice (deviceName, "Mock"),
+              totalIns (numInputs),
+              totalOuts (numOutputs)
+        {}
+
+        StringArray getOutputChannelNames() override          { return getNames ("out ", totalOuts); }
+        StringArray getInputChannelNames() override           { return getNames ("in ", totalIns); }
+        Array<double> getAvailableSampleRates() override      { return { 44100.0, 48000.0 }; }
+        Array<int> getAvailableBufferSizes() override         { return { 256 }; }
+        int getDefaultBufferSize() override                   { return 256; }
+
+        String open (const BigInteger& ins, const BigInteger& outs, double rate, int) override
+        {
+            activeIns = ins;
+            activeOuts = outs;
+            numIns = ins.countNumberOfSetBits();
+            numOuts = outs.countNumberOfSetBits();
+            sampleRate = rate;
+            buffer.setSize (jmax (1, numIns + numOuts), 256);
+            deviceIsOpen = true;
+            return {};
+        }
+
+        void close() override                                  { deviceIsOpen = false; }
+        bool isOpen() override                                 { return deviceIsOpen; }
+        void start (AudioIODeviceCallback* cb) override        { callback = cb; }
+        void stop() override                                   { callback = nullptr; }
+        bool isPlaying() override                              { return callback != nullptr; }
+        String getLastError() override                         { return {}; }
+        int getCurrentBufferSizeSamples() override             { return 256; }
+        double getCurrentSampleRate() override                 { return sampleRate; }
+        int getCurrentBitDepth() override                      { return 32; }
+        BigInteger getActiveOutputChannels() const override    { return activeOuts; }
+        BigInteger getActiveInputChannels() const override     { return activeIns; }
+        int getOutputLatencyInSamples() override               { return 0; }
+        int getInputLatencyInSamples() override                { return 0; }
+
+        void process()
+        {
+            if (callback == nullptr)
+                return;
+
+            for (int i = 0; i < numIns; ++i)
+                FloatVectorOperations::fill (buffer.getWritePointer (i), inputValue, 256);
+
+            callback->audioDeviceIOCallbackWithContext (buffer.getArrayOfReadPointers(), numIns,
+                                                        buffer.getArrayOfWritePointers() + numIns, numOuts,
+                                                        256, {});
+
+            if (numOuts > 0)
+                lastOutput = buffer.getSample (numIns, 255);
+        }
+
+        static StringArray getNames (const String& prefix, int num)
+        {
+            StringArray names;
+
+            for (int i = 0; i < num; ++i)
+                names.add (prefix + String (i + 1));
+
+            return names;
+        }
+
+        const int totalIns, totalOuts;
+        int numIns = 0, numOuts = 0;
+        BigInteger activeIns, activeOuts;
+        double sampleRate = 0.0;
+        bool deviceIsOpen = false;
+        AudioIODeviceCallback* callback = nullptr;
+        AudioBuffer<float> buffer;
+        float inputValue = 0.0f, lastOutput = 0.0f;
+    };
+};
+
+static AggregateAudioIODeviceTests aggregateAudioIODeviceTests;
+
+#endif
+
+} // namespace juce
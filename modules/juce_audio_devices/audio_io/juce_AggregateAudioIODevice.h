@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AudioIODevice that combines several other devices, so that a single callback
+    can use the channels of all of them at once.
+
+    The first device is the clock master. Its callback drives the aggregate's callback,
+    and its channels are passed through directly. Audio to and from each of the other
+    devices goes through a FIFO and an adaptive resampler. A control loop watches how
+    full each FIFO is and adjusts the resampling ratio so that it follows the drift
+    between that device's clock and the master's. The FIFOs therefore neither run dry
+    nor grow, and the latency added to the other devices stays at around one block of
+    each device. The other devices may also run at different nominal sample rates.
+
+    The channels appear in the order of the devices, with each channel's name prefixed
+    by the name of its device. A device with none of its channels enabled isn't opened.
+
+    @see AggregateAudioIODeviceType
+
+    @tags{Audio}
+*/
+class JUCE_API  AggregateAudioIODevice final  : public AudioIODevice,
+                                                private AudioIODeviceCallback
+{
+public:
+    //==============================================================================
+    /** Creates an aggregate of some devices, which should not be open.
+
+        The first device in the list is used as the clock master.
+    */
+    AggregateAudioIODevice (const String& deviceName,
+                            std::vector<std::unique_ptr<AudioIODevice>> devices);
+
+    /** Destructor. */
+    ~AggregateAudioIODevice() override;
+
+    //==============================================================================
+    /** Returns the number of devices that make up the aggregate. */
+    int getNumDevices() const noexcept                      { return (int) devices.size(); }
+
+    /** Returns one of the devices that make up the aggregate. */
+    AudioIODevice* getDevice (int index) const noexcept;
+
+    /** Returns the drift compensation's current estimate of how fast one of the devices'
+        clocks is running relative to the master's.
+
+        A value of 1.0 means that they're running at exactly their nominal rates. This
+        will always return 1.0 for the master, or for a device that isn't running.
+    */
+    double getEstimatedClockRatio (int deviceIndex) const noexcept;
+
+    //==============================================================================
+    StringArray getOutputChannelNames() override;
+    StringArray getInputChannelNames() override;
+    Array<double> getAvailableSampleRates() override;
+    Array<int> getAvailableBufferSizes() override;
+    int getDefaultBufferSize() override;
+    String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                 double sampleRate, int bufferSizeSamples) override;
+    void close() override;
+    bool isOpen() override;
+    void start (AudioIODeviceCallback*) override;
+    void stop() override;
+    bool isPlaying() override;
+    String getLastError() override;
+    int getCurrentBufferSizeSamples() override;
+    double getCurrentSampleRate() override;
+    int getCurrentBitDepth() override;
+    BigInteger getActiveOutputChannels() const override;
+    BigInteger getActiveInputChannels() const override;
+    int getOutputLatencyInSamples() override;
+    int getInputLatencyInSamples() override;
+    int getXRunCount() const noexcept override;
+
+private:
+    //==============================================================================
+    class SecondaryDevice;
+
+    void audioDeviceIOCallbackWithContext (const float* const*, int, float* const*, int, int,
+                                           const AudioIODeviceCallbackContext&) override;
+    void audioDeviceAboutToStart (AudioIODevice*) override;
+    void audioDeviceStopped() override;
+    void audioDeviceError (const String&) override;
+
+    AudioIODevice& getMaster() const noexcept               { return *devices.front(); }
+
+    std::vector<std::unique_ptr<AudioIODevice>> devices;
+    std::vector<std::unique_ptr<SecondaryDevice>> secondaries;
+    std::vector<int> inputOffsets, outputOffsets;
+    Array<const float*> inputPointers;
+    Array<float*> outputPointers;
+    int maxBlockSize = 0;
+
+    bool deviceIsOpen = false;
+    String lastError;
+    AudioIODeviceCallback* callback = nullptr;
+    CriticalSection callbackLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateAudioIODevice)
+};
+
+//==============================================================================
+/**
+    An AudioIODeviceType that offers a single AggregateAudioIODevice, made up of
+    devices created by a list of factory functions.
+
+    To use one, create it with the devices you want and add it to an AudioDeviceManager
+    with AudioDeviceManager::addAudioDeviceType(), e.g.
+
+    @code
+    auto& types = deviceManager.getAvailableDeviceTypes();
+    auto* alsa = ... // find the ALSA type in the list, and call scanForDevices() on it
+
+    deviceManager.addAudioDeviceType (std::make_unique<AggregateAudioIODeviceType> ("Studio", std::vector {
+        AggregateAudioIODeviceType::createDeviceFactory (*alsa, "Interface A", "Interface A"),
+        AggregateAudioIODeviceType::createDeviceFactory (*alsa, "Interface B", "Interface B") }));
+    @endcode
+
+    @see AggregateAudioIODevice
+
+    @tags{Audio}
+*/
+class JUCE_API  AggregateAudioIODeviceType final  : public AudioIODeviceType
+{
+public:
+    /** A function that creates one of the devices in the aggregate. */
+    using DeviceFactory = std::function<std::unique_ptr<AudioIODevice>()>;
+
+    /** Creates a type that offers a single aggregate device with the given name.
+
+        The device created by the first factory will be the clock master.
+    */
+    AggregateAudioIODeviceType (const String& aggregateDeviceName,
+                                std::vector<DeviceFactory> deviceFactories);
+
+    /** Returns a factory that creates a device using an existing AudioIODeviceType.
+
+        The type must have been scanned, and must outlive any devices that the factory
+        creates.
+    */
+    static DeviceFactory createDeviceFactory (AudioIODeviceType& type,
+                                              const String& outputDeviceName,
+                                              const String& inputDeviceName);
+
+    //==============================================================================
+    void scanForDevices() override;
+    StringArray getDeviceNames (bool wantInputNames = false) const override;
+    int getDefaultDeviceIndex (bool forInput) const override;
+    int getIndexOfDevice (AudioIODevice* device, bool asInput) const override;
+    bool hasSeparateInputsAndOutputs() const override;
+    AudioIODevice* createDevice (const String& outputDeviceName, const String& inputDeviceName) override;
+
+private:
+    const String deviceName;
+    const std::vector<DeviceFactory> factories;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateAudioIODeviceType)
+};
+
+} // namespace juce
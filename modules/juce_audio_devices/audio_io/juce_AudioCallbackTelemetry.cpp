@@ -0,0 +1,276 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioCallbackTelemetry::AudioCallbackTelemetry (int maxNumXRunEvents)
+    : maxNumUnreadXRunEvents (maxNumXRunEvents),
+      xrunEvents (maxNumXRunEvents)
+{
+    reset (0.0);
+}
+
+AudioCallbackTelemetry::~AudioCallbackTelemetry() = default;
+
+void AudioCallbackTelemetry::reset (double sampleRate)
+{
+    const SpinLock::ScopedLockType lock (mutex);
+
+    msPerSample = sampleRate > 0.0 ? 1000.0 / sampleRate : 0.0;
+    lastStartTime = -1.0;
+    lastBlockDuration = 0.0;
+    lastCallbackDuration = 0.0;
+    lastDeviceXRunCount = -1;
+
+    for (auto& bin : histogram)
+        bin = 0;
+
+    totals = {};
+    publishedTotals.store (totals);
+}
+
+//==============================================================================
+void AudioCallbackTelemetry::registerCallback (double startTime, double endTime, int numSamples)
+{
+    const SpinLock::ScopedTryLockType lock (mutex);
+
+    if (! lock.isLocked() || approximatelyEqual (msPerSample, 0.0) || numSamples <= 0)
+        return;
+
+    const auto duration = endTime - startTime;
+    const auto blockDuration = numSamples * msPerSample;
+    const auto slack = blockDuration - duration;
+
+    const auto bin = jmin (numHistogramBins - 1, (int) (duration / (blockDuration * histogramBinWidth)));
+
+    // Only one thread can hold the mutex, so there's no need for a read-modify-write here
+    histogram[(size_t) jmax (0, bin)].store (histogram[(size_t) jmax (0, bin)].load() + 1);
+
+    totals.minSlack = totals.numCallbacks == 0 ? slack : jmin (totals.minSlack, slack);
+    ++totals.numCallbacks;
+    totals.totalDuration += duration;
+    totals.maxDuration = jmax (totals.maxDuration, duration);
+
+    if (lastStartTime >= 0.0)
+    {
+        const auto lateness = startTime - (lastStartTime + lastBlockDuration);
+        const auto jitter = std::abs (lateness);
+
+        ++totals.numIntervals;
+        totals.totalJitter += jitter;
+        totals.maxJitter = jmax (totals.maxJitter, jitter);
+
+        // A callback that overran will make the next one late too, but that's
+        // already been counted
+        if (lateness > lastBlockDuration && lastCallbackDuration <= lastBlockDuration)
+            addXRun (XRunEvent::Kind::lateWakeUp, startTime, duration, blockDuration);
+    }
+
+    if (duration > blockDuration)
+        addXRun (XRunEvent::Kind::deadlineMissed, startTime, duration, blockDuration);
+
+    lastStartTime = startTime;
+    lastBlockDuration = blockDuration;
+    lastCallbackDuration = duration;
+
+    publishedTotals.store (totals);
+}
+
+void AudioCallbackTelemetry::registerDeviceXRunCount (int totalDeviceXRuns)
+{
+    const SpinLock::ScopedTryLockType lock (mutex);
+
+    if (! lock.isLocked() || totalDeviceXRuns < 0)
+        return;
+
+    if (lastDeviceXRunCount >= 0)
+        for (auto i = lastDeviceXRunCount; i < totalDeviceXRuns; ++i)
+            addXRun (XRunEvent::Kind::reportedByDevice,
+                     lastStartTime >= 0.0 ? lastStartTime : Time::getMillisecondCounterHiRes(),
+                     lastCallbackDuration,
+                     lastBlockDuration);
+
+    lastDeviceXRunCount = totalDeviceXRuns;
+    publishedTotals.store (totals);
+}
+
+void AudioCallbackTelemetry::addXRun (XRunEvent::Kind kind, double time, double callbackDuration, double blockDuration)
+{
+    ++totals.numXRuns;
+
+    // The ring's capacity is rounded up to a power of two, so the limit is checked here
+    if (xrunEvents.getNumReady() < maxNumUnreadXRunEvents)
+        xrunEvents.push ({ kind, time, callbackDuration, blockDuration });
+}
+
+//==============================================================================
+std::array<int64, AudioCallbackTelemetry::numHistogramBins> AudioCallbackTelemetry::getDurationHistogram() const
+{
+    std::array<int64, numHistogramBins> result;
+
+    for (size_t i = 0; i < result.size(); ++i)
+        result[i] = histogram[i].load();
+
+    return result;
+}
+
+AudioCallbackTelemetry::Statistics AudioCallbackTelemetry::getStatistics() const
+{
+    const auto t = publishedTotals.load();
+
+    Statistics stats;
+    stats.numCallbacks = t.numCallbacks;
+
+    if (t.numCallbacks > 0)
+    {
+        stats.meanDuration = t.totalDuration / (double) t.numCallbacks;
+        stats.maxDuration = t.maxDuration;
+        stats.minSlack = t.minSlack;
+    }
+
+    if (t.numIntervals > 0)
+    {
+        stats.meanWakeUpJitter = t.totalJitter / (double) t.numIntervals;
+        stats.maxWakeUpJitter = t.maxJitter;
+    }
+
+    stats.numXRuns = t.numXRuns;
+    return stats;
+}
+
+int AudioCallbackTelemetry::readXRunEvents (Array<XRunEvent>& destination)
+{
+    const auto scope = xrunEvents.read (xrunEvents.getNumReady());
+
+    destination.addArray (scope.block1.data(), (int) scope.block1.size());
+    destination.addArray (scope.block2.data(), (int) scope.block2.size());
+
+    return scope.size();
+}
+
+//==============================================================================
+AudioCallbackTelemetry::ScopedCallback::ScopedCallback (AudioCallbackTelemetry& t, int numSamplesInBlock)
+    : owner (t), startTime (Time::getMillisecondCounterHiRes()), samplesInBlock (numSamplesInBlock)
+{
+}
+
+AudioCallbackTelemetry::ScopedCallback::~ScopedCallback()
+{
+    owner.registerCallback (startTime, Time::getMillisecondCounterHiRes(), samplesInBlock);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioCallbackTelemetryTests final : public UnitTest
+{
+public:
+    AudioCallbackTelemetryTests()
+        : UnitTest ("AudioCallbackTelemetry", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        // At 1 kHz, a 10 sample block lasts 10 ms
+        beginTest ("Durations, slack and jitter are measured");
+        {
+            AudioCallbackTelemetry telemetry;
+            telemetry.reset (1000.0);
+
+            telemetry.registerCallback (0.0, 2.0, 10);
+            telemetry.registerCallback (11.0, 15.0, 10);
+            telemetry.registerCallback (20.0, 23.0, 10);
+
+            const auto stats = telemetry.getStatistics();
+            expectEquals (stats.numCallbacks, (int64) 3);
+            expectWithinAbsoluteError (stats.meanDuration, 3.0, 1.0e-9);
+            expectWithinAbsoluteError (stats.maxDuration, 4.0, 1.0e-9);
+            expectWithinAbsoluteError (stats.minSlack, 6.0, 1.0e-9);
+            expectWithinAbsoluteError (stats.meanWakeUpJitter, 1.0, 1.0e-9);
+            expectWithinAbsoluteError (stats.maxWakeUpJitter, 1.0, 1.0e-9);
+            expectEquals (stats.numXRuns, 0);
+
+            // 2, 4 and 3 ms are 20%, 40% and 30% of the deadline
+            const auto histogram = telemetry.getDurationHistogram();
+            expectEquals (histogram[3], (int64) 1);
+            expectEquals (histogram[4], (int64) 1);
+            expectEquals (histogram[6], (int64) 1);
+            expectEquals (std::accumulate (histogram.begin(), histogram.end(), (int64) 0), (int64) 3);
+        }
+
+        beginTest ("Xruns are added to the timeline");
+        {
+            AudioCallbackTelemetry telemetry;
+            telemetry.reset (1000.0);
+
+            telemetry.registerDeviceXRunCount (5);
+            telemetry.registerCallback (0.0, 2.0, 10);
+            telemetry.registerCallback (10.0, 25.0, 10);    // overruns
+            telemetry.registerCallback (25.0, 27.0, 10);    // late, but because of the overrun
+            telemetry.registerCallback (60.0, 62.0, 10);    // late on its own
+            telemetry.registerDeviceXRunCount (6);
+
+            Array<XRunEvent> events;
+            expectEquals (telemetry.readXRunEvents (events), 3);
+            expect (events[0].kind == XRunEvent::Kind::deadlineMissed);
+            expectWithinAbsoluteError (events[0].callbackDuration, 15.0, 1.0e-9);
+            expectWithinAbsoluteError (events[0].blockDuration, 10.0, 1.0e-9);
+            expect (events[1].kind == XRunEvent::Kind::lateWakeUp);
+            expect (events[2].kind == XRunEvent::Kind::reportedByDevice);
+            expectWithinAbsoluteError (events[2].time, 60.0, 1.0e-9);
+
+            expectEquals (telemetry.getStatistics().numXRuns, 3);
+            expectWithinAbsoluteError (telemetry.getStatistics().minSlack, -5.0, 1.0e-9);
+            expectEquals (telemetry.getDurationHistogram()[numHistogramBins - 1], (int64) 0);
+            expectEquals (telemetry.getDurationHistogram()[24], (int64) 1);
+
+            events.clear();
+            expectEquals (telemetry.readXRunEvents (events), 0);
+        }
+
+        beginTest ("Events beyond the queue's capacity are counted but dropped");
+        {
+            AudioCallbackTelemetry telemetry (4);
+            telemetry.reset (1000.0);
+
+            for (int i = 0; i < 10; ++i)
+                telemetry.registerCallback (i * 100.0, i * 100.0 + 50.0, 10);
+
+            Array<XRunEvent> events;
+            expectEquals (telemetry.readXRunEvents (events), 4);
+            expectEquals (telemetry.getStatistics().numXRuns, 10);
+            expectEquals (telemetry.getDurationHistogram()[numHistogramBins - 1], (int64) 10);
+        }
+    }
+
+private:
+    using XRunEvent = AudioCallbackTelemetry::XRunEvent;
+    static constexpr auto numHistogramBins = AudioCallbackTelemetry::numHistogramBins;
+};
+
+static AudioCallbackTelemetryTests audioCallbackTelemetryTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Collects timing measurements of an audio callback, for diagnosing dropouts.
+
+    The audio thread records the time at which each callback starts and finishes.
+    From these, this class keeps:
+    - a histogram of callback durations, as proportions of the block's deadline,
+    - the slack left before the deadline, and how late the callbacks woke up,
+      relative to the time they were expected,
+    - a timeline of xruns, each stamped with the time it happened and the duration of
+      the callback around it, so that dropouts can be matched up with whatever the
+      callback was doing at the time.
+
+    None of the methods block the audio thread, and all of the getters can be called
+    from any thread while the audio is running. The AudioDeviceManager keeps one of
+    these for its current device, so that the same measurements are available for
+    every type of device.
+
+    @see AudioDeviceManager::getCallbackTelemetry
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioCallbackTelemetry
+{
+public:
+    /** Creates a telemetry object, which will hold up to the given number of unread
+        xrun events.
+    */
+    explicit AudioCallbackTelemetry (int maxNumXRunEvents = 256);
+
+    /** Destructor. */
+    ~AudioCallbackTelemetry();
+
+    //==============================================================================
+    /** Resets all of the measurements, in preparation for use with the given sample
+        rate.
+
+        This should be called before the callbacks start. Any callbacks that happen
+        while it's running will be ignored.
+    */
+    void reset (double sampleRate);
+
+    //==============================================================================
+    /** The number of bins in the duration histogram. */
+    static constexpr int numHistogramBins = 32;
+
+    /** The proportion of the deadline covered by each bin of the duration histogram.
+
+        Bin n counts callbacks whose duration was between n and n + 1 times this
+        proportion of the block's duration. The last bin also counts any longer
+        callbacks.
+    */
+    static constexpr double histogramBinWidth = 1.0 / 16.0;
+
+    /** Returns the duration histogram. */
+    std::array<int64, numHistogramBins> getDurationHistogram() const;
+
+    //==============================================================================
+    /** A summary of the callbacks since the last reset. All of the times are in
+        milliseconds.
+    */
+    struct Statistics
+    {
+        /** The number of callbacks that have been measured. */
+        int64 numCallbacks = 0;
+
+        /** The mean and longest time spent in a callback. */
+        double meanDuration = 0.0, maxDuration = 0.0;
+
+        /** The least time that was left before a callback's deadline. This will be
+            negative if a callback took longer than the duration of its block.
+        */
+        double minSlack = 0.0;
+
+        /** The mean and largest difference between the time a callback started and
+            the time it was expected to start, based on the previous callback and the
+            size of its block.
+        */
+        double meanWakeUpJitter = 0.0, maxWakeUpJitter = 0.0;
+
+        /** The total number of xruns of all kinds. */
+        int numXRuns = 0;
+    };
+
+    /** Returns a summary of the callbacks since the last reset. */
+    Statistics getStatistics() const;
+
+    //==============================================================================
+    /** Describes something that probably caused a glitch in the audio. */
+    struct XRunEvent
+    {
+        enum class Kind
+        {
+            deadlineMissed,   /**< A callback took longer than the duration of its block. */
+            lateWakeUp,       /**< A callback started late enough that the device will probably have run out of data. */
+            reportedByDevice  /**< The device's own xrun count increased. */
+        };
+
+        /** The kind of xrun. */
+        Kind kind;
+
+        /** The time of the start of the callback in which the xrun was detected, from
+            Time::getMillisecondCounterHiRes().
+        */
+        double time;
+
+        /** The duration of that callback, and the duration of its block, in milliseconds. */
+        double callbackDuration, blockDuration;
+    };
+
+    /** Moves any xrun events that have happened since the last call into an array,
+        oldest first, and returns the number that were added.
+
+        Only one thread should call this at a time. If the events aren't read often
+        enough, new ones are dropped once the queue is full, but they're still counted
+        in the statistics.
+    */
+    int readXRunEvents (Array<XRunEvent>& destination);
+
+    //==============================================================================
+    /** Measures the time between its construction and destruction, and adds it to an
+        AudioCallbackTelemetry object.
+
+        e.g.
+        @code
+        {
+            AudioCallbackTelemetry::ScopedCallback measurement (telemetry, numSamples);
+            myCallback->doTheCallback();
+        }
+        @endcode
+
+        @tags{Audio}
+    */
+    struct JUCE_API  ScopedCallback
+    {
+        ScopedCallback (AudioCallbackTelemetry&, int numSamplesInBlock);
+        ~ScopedCallback();
+
+    private:
+        AudioCallbackTelemetry& owner;
+        double startTime;
+        int samplesInBlock;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedCallback)
+    };
+
+    /** Can be called manually to add a callback to the measurements.
+
+        The times are in milliseconds, from Time::getMillisecondCounterHiRes() or a clock
+        that runs at the same rate. Normally you'd use a ScopedCallback instead.
+    */
+    void registerCallback (double startTime, double endTime, int numSamples);
+
+    /** Should be called from the audio thread with a device's own xrun count, if it has
+        one, so that any increase is added to the timeline.
+
+        @see AudioIODevice::getXRunCount
+    */
+    void registerDeviceXRunCount (int totalDeviceXRuns);
+
+private:
+    //==============================================================================
+    struct Totals
+    {
+        int64 numCallbacks = 0, numIntervals = 0;
+        double totalDuration = 0.0, maxDuration = 0.0, minSlack = 0.0, totalJitter = 0.0, maxJitter = 0.0;
+        int numXRuns = 0;
+    };
+
+    void addXRun (XRunEvent::Kind, double time, double callbackDuration, double blockDuration);
+
+    SpinLock mutex;
+    double msPerSample = 0.0;
+    double lastStartTime = -1.0, lastBlockDuration = 0.0, lastCallbackDuration = 0.0;
+    int lastDeviceXRunCount = -1;
+
+    std::array<std::atomic<int64>, numHistogramBins> histogram;
+
+    // The totals are only touched while the mutex is held, and a copy is published
+    // after each change so that getStatistics() sees all of them at the same moment
+    Totals totals;
+    SeqLock<Totals> publishedTotals;
+
+    const int maxNumUnreadXRunEvents;
+    SpscRingBuffer<XRunEvent> xrunEvents;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioCallbackTelemetry)
+};
+
+} // namespace juce
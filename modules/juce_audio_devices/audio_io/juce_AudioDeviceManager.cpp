@@ -245,6 +245,7 @@ void AudioDeviceManager::createAudioDeviceTypes (OwnedArray<AudioIODeviceType>&
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_Bela());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_ALSA());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_JACK());
+    addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_PipeWire());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_Oboe());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_OpenSLES());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_Android());
@@ -997,7 +998,18 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float* const* inputChan
                                                    int numSamples,
                                                    const AudioIODeviceCallbackContext& context)
 {
+    JUCE_TRACE_THREAD_NAME ("Audio Device");
+    JUCE_TRACE_SCOPE ("audio", "audioDeviceIOCallback");
+
+    const AudioCallbackTelemetry::ScopedCallback measurement (callbackTelemetry, numSamples);
     const ScopedLock sl (audioCallbackLock);
+    const RealtimeSafetyChecker::ScopedRealtimeContext realtimeContext;
+
+    if (std::exchange (audioThreadOptionsNeedApplying, false) && audioThreadOptions.has_value())
+        Thread::setCurrentThreadRealtimeOptions (*audioThreadOptions);
+
+    if (currentAudioDevice != nullptr)
+        callbackTelemetry.registerDeviceXRunCount (currentAudioDevice->getXRunCount());
 
     inputLevelGetter->updateLevel (inputChannelData, numInputChannels, numSamples);
 
@@ -1063,12 +1075,15 @@ void AudioDeviceManager::audioDeviceAboutToStartInt (AudioIODevice* const device
 {
     loadMeasurer.reset (device->getCurrentSampleRate(),
                         device->getCurrentBufferSizeSamples());
+    callbackTelemetry.reset (device->getCurrentSampleRate());
 
     updateCurrentSetup();
 
     {
         const ScopedLock sl (audioCallbackLock);
 
+        audioThreadOptionsNeedApplying = true;
+
         for (int i = callbacks.size(); --i >= 0;)
             callbacks.getUnchecked (i)->audioDeviceAboutToStart (device);
     }
@@ -1101,6 +1116,20 @@ double AudioDeviceManager::getCpuUsage() const
     return loadMeasurer.getLoadAsProportion();
 }
 
+void AudioDeviceManager::setAudioThreadOptions (std::optional<Thread::RealtimeOptions> options)
+{
+    const ScopedLock sl (audioCallbackLock);
+
+    audioThreadOptions = std::move (options);
+    audioThreadOptionsNeedApplying = true;
+}
+
+std::optional<Thread::RealtimeOptions> AudioDeviceManager::getAudioThreadOptions() const
+{
+    const ScopedLock sl (audioCallbackLock);
+    return audioThreadOptions;
+}
+
 //==============================================================================
 void AudioDeviceManager::setMidiInputDeviceEnabled (const String& identifier, bool enabled)
 {
@@ -312,6 +312,26 @@ public:
     */
     double getCpuUsage() const;
 
+    //==============================================================================
+    /** Sets the scheduling options for the thread on which the audio device calls the
+        audio callbacks.
+
+        The options are applied from inside the first callback after a device starts, or
+        after this method is called. This works in the same way for every type of device,
+        including those whose callback threads are created by the OS or by another
+        process, such as JACK. Use it to pin the audio thread to an isolated core, or to
+        use SCHED_FIFO on Linux.
+
+        Pass nullopt to leave the thread as the device created it. This won't undo any
+        options that have already been applied to the thread of a running device.
+
+        @see Thread::setCurrentThreadRealtimeOptions, RealtimeThreadPoolOptions::withWorkerCores
+    */
+    void setAudioThreadOptions (std::optional<Thread::RealtimeOptions> options);
+
+    /** Returns the options set by setAudioThreadOptions(). */
+    std::optional<Thread::RealtimeOptions> getAudioThreadOptions() const;
+
     //==============================================================================
     /** Enables or disables a midi input device.
 
@@ -473,6 +493,13 @@ public:
     */
     int getXRunCount() const noexcept;
 
+    /** Returns the timing measurements of the current device's callbacks.
+
+        These are reset whenever a device starts. Unlike getXRunCount(), this works in
+        the same way for every type of device, and also keeps a timeline of the xruns.
+    */
+    AudioCallbackTelemetry& getCallbackTelemetry() noexcept     { return callbackTelemetry; }
+
     //==============================================================================
    #ifndef DOXYGEN
     [[deprecated ("Use setMidiInputDeviceEnabled instead.")]]
@@ -525,6 +552,10 @@ private:
     int testSoundPosition = 0;
 
     AudioProcessLoadMeasurer loadMeasurer;
+    AudioCallbackTelemetry callbackTelemetry;
+
+    std::optional<Thread::RealtimeOptions> audioThreadOptions;
+    bool audioThreadOptionsNeedApplying = false;
 
     LevelMeter::Ptr inputLevelGetter   { new LevelMeter() },
                     outputLevelGetter  { new LevelMeter() };
@@ -158,6 +158,8 @@ public:
     static AudioIODeviceType* createAudioIODeviceType_ALSA();
     /** Creates a JACK device type if it's available on this platform, or returns null. */
     static AudioIODeviceType* createAudioIODeviceType_JACK();
+    /** Creates a PipeWire device type if it's available on this platform, or returns null. */
+    static AudioIODeviceType* createAudioIODeviceType_PipeWire();
     /** Creates an Android device type if it's available on this platform, or returns null. */
     static AudioIODeviceType* createAudioIODeviceType_Android();
     /** Creates an Android OpenSLES device type if it's available on this platform, or returns null. */
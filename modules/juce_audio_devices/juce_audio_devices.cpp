@@ -177,6 +177,22 @@
   #include "native/juce_JackAudio_linux.cpp"
  #endif
 
+ #if JUCE_PIPEWIRE
+  /* Got an include error here? If so, you've either not got PipeWire installed, or
+     you've not got your paths set up correctly to find its header files. The headers
+     live in versioned directories, so add the paths given by
+     "pkg-config --cflags libpipewire-0.3".
+
+     The package you need to install to get PipeWire support is "libpipewire-0.3-dev".
+
+     If you don't want to build JUCE with native PipeWire support, just set the
+     JUCE_PIPEWIRE flag to 0.
+  */
+  #include <pipewire/pipewire.h>
+  #include <pipewire/filter.h>
+  #include "native/juce_PipeWire_linux.cpp"
+ #endif
+
  #if (JUCE_LINUX && JUCE_BELA)
   /* Got an include error here? If so, you've either not got the bela headers
      installed, or you've not got your paths set up correctly to find its header
@@ -260,6 +276,8 @@ namespace juce
 #include "audio_io/juce_AudioDeviceManager.cpp"
 #include "audio_io/juce_AudioIODevice.cpp"
 #include "audio_io/juce_AudioIODeviceType.cpp"
+#include "audio_io/juce_AudioCallbackTelemetry.cpp"
+#include "audio_io/juce_AggregateAudioIODevice.cpp"
 #include "midi_io/juce_MidiMessageCollector.cpp"
 #include "sources/juce_AudioSourcePlayer.cpp"
 #include "sources/juce_AudioTransportSource.cpp"
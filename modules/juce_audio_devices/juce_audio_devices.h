@@ -109,6 +109,23 @@
  #define JUCE_ALSA 1
 #endif
 
+/** Config: JUCE_ALSA_MMAP
+    Makes ALSA audio devices transfer samples directly to and from the device's memory-mapped
+    buffer, if the device supports it, rather than copying them with snd_pcm_readi/writei.
+*/
+#ifndef JUCE_ALSA_MMAP
+ #define JUCE_ALSA_MMAP 0
+#endif
+
+/** Config: JUCE_ALSA_TIMER_SCHEDULING
+    Makes the ALSA audio thread sleep until enough samples are ready, rather than waiting for
+    the device's period interrupts, and disables those interrupts where the device allows it.
+    This avoids taking an interrupt for every period when running with very small buffers.
+*/
+#ifndef JUCE_ALSA_TIMER_SCHEDULING
+ #define JUCE_ALSA_TIMER_SCHEDULING 0
+#endif
+
 /** Config: JUCE_JACK
     Enables JACK audio devices (Linux only).
 */
@@ -116,6 +133,14 @@
  #define JUCE_JACK 0
 #endif
 
+/** Config: JUCE_PIPEWIRE
+    Enables native PipeWire audio devices (Linux only). The PipeWire library is loaded
+    at runtime, so the headers are only needed to build.
+*/
+#ifndef JUCE_PIPEWIRE
+ #define JUCE_PIPEWIRE 0
+#endif
+
 /** Config: JUCE_BELA
     Enables Bela audio devices on Bela boards.
 */
@@ -180,6 +205,8 @@ namespace juce
 
 #include "audio_io/juce_AudioIODevice.h"
 #include "audio_io/juce_AudioIODeviceType.h"
+#include "audio_io/juce_AudioCallbackTelemetry.h"
+#include "audio_io/juce_AggregateAudioIODevice.h"
 #include "audio_io/juce_SystemAudioVolume.h"
 #include "sources/juce_AudioSourcePlayer.h"
 #include "sources/juce_AudioTransportSource.h"
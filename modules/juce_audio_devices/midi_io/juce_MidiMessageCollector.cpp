@@ -25,6 +25,7 @@ namespace juce
 
 MidiMessageCollector::MidiMessageCollector()
 {
+    ensureStorageAllocated (65536);
 }
 
 MidiMessageCollector::~MidiMessageCollector()
@@ -34,7 +35,7 @@ MidiMessageCollector::~MidiMessageCollector()
 //==============================================================================
 void MidiMessageCollector::reset (const double newSampleRate)
 {
-    const ScopedLock sl (midiCallbackLock);
+    const ScopedLock sl (producerLock);
 
     jassert (newSampleRate > 0);
 
@@ -42,14 +43,14 @@ void MidiMessageCollector::reset (const double newSampleRate)
     hasCalledReset = true;
    #endif
     sampleRate = newSampleRate;
+    fifo.reset();
     incomingMessages.clear();
+    numDroppedMessages = 0;
     lastCallbackTime = Time::getMillisecondCounterHiRes();
 }
 
 void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
 {
-    const ScopedLock sl (midiCallbackLock);
-
    #if JUCE_DEBUG
     jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
    #endif
@@ -58,34 +59,65 @@ void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
     // for details of what the number should be.
     jassert (! approximatelyEqual (message.getTimeStamp(), 0.0));
 
-    auto sampleNumber = (int) ((message.getTimeStamp() - 0.001 * lastCallbackTime) * sampleRate);
+    const MessageHeader header { message.getTimeStamp(), message.getRawDataSize() };
+    const auto totalSize = (int) sizeof (header) + header.numBytes;
+
+    // The FIFO only has a single writer, so producers on different threads
+    // (e.g. a midi input and a keyboard component) still need to take turns.
+    const ScopedLock sl (producerLock);
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (totalSize, start1, size1, start2, size2);
 
-    incomingMessages.addEvent (message, sampleNumber);
+    if (size1 + size2 < totalSize)
+    {
+        // if the messages don't get used, the queue fills up and we
+        // have to start throwing away the new ones
+        ++numDroppedMessages;
+        return;
+    }
 
-    // if the messages don't get used for over a second, we'd better
-    // get rid of any old ones to avoid the queue getting too big
-    if (sampleNumber > sampleRate)
-        incomingMessages.clear (0, sampleNumber - (int) sampleRate);
+    writeToFifo (start1, &header, (int) sizeof (header));
+    writeToFifo (start1 + (int) sizeof (header), message.getRawData(), header.numBytes);
+    fifo.finishedWrite (totalSize);
 }
 
 void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
                                                       const int numSamples)
 {
-    const ScopedLock sl (midiCallbackLock);
-
    #if JUCE_DEBUG
     jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
    #endif
 
     jassert (numSamples > 0);
 
+    isReading = true;
+    const ScopeGuard readingGuard { [this] { isReading = false; } };
+
     auto timeNow = Time::getMillisecondCounterHiRes();
     auto msElapsed = timeNow - lastCallbackTime;
+    auto previousCallbackTime = lastCallbackTime;
 
     lastCallbackTime = timeNow;
 
+    incomingMessages.clear();
+
+    for (MessageHeader header; readNextHeader (header);)
+    {
+        const auto sampleNumber = (int) ((header.timeStamp - 0.001 * previousCallbackTime) * sampleRate);
+        incomingMessages.addEvent (readNextMessage (header), header.numBytes, sampleNumber);
+        fifo.finishedRead ((int) sizeof (header) + header.numBytes);
+    }
+
     if (! incomingMessages.isEmpty())
     {
+        // if the messages haven't been used for over a second, we'd better
+        // get rid of any old ones
+        const auto lastSampleNumber = incomingMessages.getLastEventTime();
+
+        if (lastSampleNumber > sampleRate)
+            incomingMessages.clear (0, lastSampleNumber - (int) sampleRate);
+
         int numSourceSamples = jmax (1, roundToInt (msElapsed * 0.001 * sampleRate));
         int startSample = 0;
         int scale = 1 << 16;
@@ -128,9 +160,104 @@ void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
     }
 }
 
+void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
+                                                      const int numSamples,
+                                                      const double blockStartTime)
+{
+   #if JUCE_DEBUG
+    jassert (hasCalledReset); // you need to call reset() to set the correct sample rate before using this object
+   #endif
+
+    jassert (numSamples > 0);
+
+    isReading = true;
+    const ScopeGuard readingGuard { [this] { isReading = false; } };
+
+    lastCallbackTime = Time::getMillisecondCounterHiRes();
+
+    for (MessageHeader header; readNextHeader (header);)
+    {
+        if (header.timeStamp >= blockStartTime)
+            break;
+
+        const auto pos = numSamples + roundToInt ((header.timeStamp - blockStartTime) * sampleRate);
+        destBuffer.addEvent (readNextMessage (header), header.numBytes, jlimit (0, numSamples - 1, pos));
+        fifo.finishedRead ((int) sizeof (header) + header.numBytes);
+    }
+}
+
 void MidiMessageCollector::ensureStorageAllocated (size_t bytes)
 {
-    incomingMessages.ensureSize (bytes);
+    const ScopedLock sl (producerLock);
+
+    jassert (bytes > sizeof (MessageHeader));
+
+    // The FIFO can hold one byte fewer than its total size
+    if (bytes < (size_t) fifo.getTotalSize())
+        return;
+
+    if (isReading)
+    {
+        // The storage can't be changed while the audio thread is reading from it!
+        jassertfalse;
+        return;
+    }
+
+    fifoData.allocate (bytes + 1, false);
+    scratch.allocate (bytes, false);
+    fifo.setTotalSize ((int) bytes + 1);
+    fifo.reset();
+
+    // every message needs fewer bytes in the MidiBuffer than in the FIFO
+    incomingMessages.setFixedCapacity (bytes);
+}
+
+//==============================================================================
+bool MidiMessageCollector::readNextHeader (MessageHeader& header) const noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead ((int) sizeof (header), start1, size1, start2, size2);
+
+    if (size1 + size2 < (int) sizeof (header))
+        return false;
+
+    // a header is only ever published along with its message data
+    readFromFifo (start1, &header, (int) sizeof (header));
+    return true;
+}
+
+const uint8* MidiMessageCollector::readNextMessage (const MessageHeader& header) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead ((int) sizeof (header) + header.numBytes, start1, size1, start2, size2);
+
+    const auto start = (start1 + (int) sizeof (header)) % fifo.getTotalSize();
+
+    if (start + header.numBytes <= fifo.getTotalSize())
+        return fifoData + start;
+
+    readFromFifo (start, scratch, header.numBytes);
+    return scratch;
+}
+
+void MidiMessageCollector::writeToFifo (int offset, const void* source, int numBytes) noexcept
+{
+    const auto totalSize = fifo.getTotalSize();
+    offset %= totalSize;
+
+    const auto numFirst = jmin (numBytes, totalSize - offset);
+    memcpy (fifoData + offset, source, (size_t) numFirst);
+    memcpy (fifoData, addBytesToPointer (source, numFirst), (size_t) (numBytes - numFirst));
+}
+
+void MidiMessageCollector::readFromFifo (int offset, void* dest, int numBytes) const noexcept
+{
+    const auto totalSize = fifo.getTotalSize();
+    offset %= totalSize;
+
+    const auto numFirst = jmin (numBytes, totalSize - offset);
+    memcpy (dest, fifoData + offset, (size_t) numFirst);
+    memcpy (addBytesToPointer (dest, numFirst), fifoData, (size_t) (numBytes - numFirst));
 }
 
 //==============================================================================
@@ -155,4 +282,190 @@ void MidiMessageCollector::handleIncomingMidiMessage (MidiInput*, const MidiMess
     addMessageToQueue (message);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiMessageCollectorTests final : public UnitTest
+{
+public:
+    MidiMessageCollectorTests()
+        : UnitTest ("MidiMessageCollector", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        constexpr auto sampleRate = 48000.0;
+        constexpr auto blockSize = 480;
+        constexpr auto blockLength = blockSize / sampleRate;
+
+        beginTest ("Messages are placed one block late relative to the block start time");
+        {
+            MidiMessageCollector collector;
+            collector.reset (sampleRate);
+
+            const auto blockStart = 1000.0;
+
+            for (auto i = 0; i < 4; ++i)
+                collector.addMessageToQueue (withTime (MidiMessage::noteOn (1, 60 + i, (uint8) 100),
+                                                       blockStart - blockLength + i * 100 / sampleRate));
+
+            // this one belongs in the next block
+            collector.addMessageToQueue (withTime (MidiMessage::noteOff (1, 60), blockStart + 10 / sampleRate));
+
+            MidiBuffer buffer;
+            collector.removeNextBlockOfMessages (buffer, blockSize, blockStart);
+
+            expectEquals (buffer.getNumEvents(), 4);
+
+            auto index = 0;
+
+            for (const auto metadata : buffer)
+            {
+                expectEquals (metadata.samplePosition, index * 100);
+                expectEquals (metadata.getMessage().getNoteNumber(), 60 + index);
+                ++index;
+            }
+
+            buffer.clear();
+            collector.removeNextBlockOfMessages (buffer, blockSize, blockStart + blockLength);
+
+            expectEquals (buffer.getNumEvents(), 1);
+            expectEquals (buffer.getFirstEventTime(), 10);
+            expect ((*buffer.cbegin()).getMessage().isNoteOff());
+        }
+
+        beginTest ("Late messages are placed at the start of the block");
+        {
+            MidiMessageCollector collector;
+            collector.reset (sampleRate);
+
+            collector.addMessageToQueue (withTime (MidiMessage::controllerEvent (1, 7, 64), 10.0));
+
+            MidiBuffer buffer;
+            collector.removeNextBlockOfMessages (buffer, blockSize, 20.0);
+
+            expectEquals (buffer.getNumEvents(), 1);
+            expectEquals (buffer.getFirstEventTime(), 0);
+        }
+
+        beginTest ("Sysex messages that wrap around the FIFO are reassembled");
+        {
+            MidiMessageCollector collector;
+            collector.reset (sampleRate);
+
+            Random random (getRandom());
+            MidiBuffer buffer;
+
+            // Enough data to go round the default 64KB FIFO a couple of times
+            for (auto i = 0; i < 2000; ++i)
+            {
+                std::vector<uint8> data ((size_t) random.nextInt ({ 1, 100 }));
+
+                for (auto& b : data)
+                    b = (uint8) random.nextInt (128);
+
+                const auto message = withTime (MidiMessage::createSysExMessage (data.data(), (int) data.size()), 1.0);
+                collector.addMessageToQueue (message);
+
+                buffer.clear();
+                collector.removeNextBlockOfMessages (buffer, blockSize, 2.0);
+
+                expectEquals (buffer.getNumEvents(), 1);
+
+                const auto received = (*buffer.cbegin()).getMessage();
+                expect (received.getRawDataSize() == message.getRawDataSize()
+                        && std::equal (message.getRawData(), message.getRawData() + message.getRawDataSize(),
+                                       received.getRawData()));
+            }
+
+            expectEquals (collector.getNumDroppedMessages(), 0);
+        }
+
+        beginTest ("Messages are dropped and counted when the FIFO is full");
+        {
+            MidiMessageCollector collector;
+            collector.reset (sampleRate);
+
+            constexpr auto numMessages = 5000;
+
+            for (auto i = 0; i < numMessages; ++i)
+                collector.addMessageToQueue (withTime (MidiMessage::noteOn (1, 60, (uint8) 100), 1.0));
+
+            MidiBuffer buffer;
+            collector.removeNextBlockOfMessages (buffer, blockSize, 2.0);
+
+            expect (buffer.getNumEvents() > 0);
+            expect (collector.getNumDroppedMessages() > 0);
+            expectEquals (buffer.getNumEvents() + collector.getNumDroppedMessages(), numMessages);
+
+            collector.reset (sampleRate);
+            expectEquals (collector.getNumDroppedMessages(), 0);
+        }
+
+        beginTest ("Messages larger than the FIFO are dropped until more storage is allocated");
+        {
+            MidiMessageCollector collector;
+            collector.reset (sampleRate);
+
+            // This is small enough for a MidiBuffer, but doesn't fit in the default 64KB FIFO
+            // along with its header
+            const std::vector<uint8> data (65520, 0x12);
+            const auto message = withTime (MidiMessage::createSysExMessage (data.data(), (int) data.size()), 1.0);
+
+            MidiBuffer buffer;
+            collector.addMessageToQueue (message);
+            collector.removeNextBlockOfMessages (buffer, blockSize, 2.0);
+
+            expect (buffer.isEmpty());
+            expectEquals (collector.getNumDroppedMessages(), 1);
+
+            collector.ensureStorageAllocated (200000);
+
+            // Asking for less storage than there is already doesn't shrink it
+            collector.ensureStorageAllocated (256);
+            collector.reset (sampleRate);
+
+            collector.addMessageToQueue (message);
+            collector.removeNextBlockOfMessages (buffer, blockSize, 2.0);
+
+            expectEquals (buffer.getNumEvents(), 1);
+            expectEquals (collector.getNumDroppedMessages(), 0);
+
+            if (! buffer.isEmpty())
+                expectEquals ((*buffer.cbegin()).numBytes, message.getRawDataSize());
+        }
+
+        beginTest ("Messages received since the last block are all delivered");
+        {
+            MidiMessageCollector collector;
+            collector.reset (sampleRate);
+
+            const auto now = Time::getMillisecondCounterHiRes() * 0.001;
+
+            for (auto i = 0; i < 10; ++i)
+                collector.addMessageToQueue (withTime (MidiMessage::noteOn (1, 60 + i, (uint8) 100), now + i * 0.0001));
+
+            MidiBuffer buffer;
+            collector.removeNextBlockOfMessages (buffer, blockSize);
+
+            expectEquals (buffer.getNumEvents(), 10);
+
+            for (const auto metadata : buffer)
+                expect (isPositiveAndBelow (metadata.samplePosition, blockSize));
+        }
+    }
+
+private:
+    static MidiMessage withTime (MidiMessage message, double time)
+    {
+        message.setTimeStamp (time);
+        return message;
+    }
+};
+
+static MidiMessageCollectorTests midiMessageCollectorTests;
+
+#endif
+
 } // namespace juce
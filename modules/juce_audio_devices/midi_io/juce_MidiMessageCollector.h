@@ -31,6 +31,11 @@ namespace juce
     The class can also be used as either a MidiKeyboardState::Listener or a MidiInputCallback
     so it can easily use a midi input or keyboard component as its source.
 
+    Messages are passed from the producing threads to the audio thread through a lock-free
+    FIFO, so removeNextBlockOfMessages() never blocks or allocates. If the FIFO fills up
+    because the audio callback isn't running, incoming messages are discarded and counted
+    by getNumDroppedMessages().
+
     @see MidiMessage, MidiInput
 
     @tags{Audio}
@@ -51,6 +56,8 @@ public:
 
         You need to call this method before starting to use the collector, so that
         it knows the correct sample rate to use.
+
+        This must not be called while another thread is inside removeNextBlockOfMessages().
     */
     void reset (double sampleRate);
 
@@ -60,7 +67,7 @@ public:
         of the block returned by the next call to removeNextBlockOfMessages().
 
         This method is fully thread-safe when overlapping calls are made with
-        removeNextBlockOfMessages().
+        removeNextBlockOfMessages(), and may be called from more than one thread.
     */
     void addMessageToQueue (const MidiMessage& message);
 
@@ -74,20 +81,47 @@ public:
         midi event positions.
 
         This method is fully thread-safe when overlapping calls are made with
-        addMessageToQueue().
+        addMessageToQueue(), and will never block.
 
         Precondition: numSamples must be greater than 0.
     */
     void removeNextBlockOfMessages (MidiBuffer& destBuffer, int numSamples);
 
+    /** Removes the pending messages that belong in a block, placing each one according
+        to its timestamp.
+
+        Rather than squeezing everything that has arrived since the last call into the
+        block, this maps each message's timestamp directly to a sample position, delaying
+        every message by exactly one block. A message stamped at blockStartTime - x seconds
+        will be placed at sample numSamples - x * sampleRate, so the timing between
+        messages is preserved with no jitter from the callback's scheduling.
+
+        Messages that arrive too late for their slot are placed at sample 0. Messages
+        stamped at or after blockStartTime are left in the queue for the next block.
+
+        @param destBuffer       the buffer to add the messages to
+        @param numSamples       the number of samples in the block; must be greater than 0
+        @param blockStartTime   the time at which this block started, in seconds, on the same
+                                clock as the message timestamps, i.e.
+                                Time::getMillisecondCounterHiRes() * 0.001
+    */
+    void removeNextBlockOfMessages (MidiBuffer& destBuffer, int numSamples, double blockStartTime);
+
     /** Preallocates storage for collected messages.
 
-        This can be called before audio processing begins to ensure that there
-        is sufficient space for the expected MIDI messages, in order to avoid
-        allocations within the audio callback.
+        This makes sure that the FIFO used to pass messages to the audio thread can hold
+        at least the given number of bytes, discarding any messages that are waiting in it
+        if it has to grow. Call it before processing starts: if it's called while the audio
+        thread is inside removeNextBlockOfMessages(), it will assert and leave the storage
+        as it is.
     */
     void ensureStorageAllocated (size_t bytes);
 
+    /** Returns the number of messages that have been discarded because the queue was
+        full since the last call to reset().
+    */
+    int getNumDroppedMessages() const noexcept          { return numDroppedMessages.load(); }
+
 
     //==============================================================================
     /** @internal */
@@ -99,9 +133,24 @@ public:
 
 private:
     //==============================================================================
+    struct MessageHeader
+    {
+        double timeStamp;
+        int numBytes;
+    };
+
+    bool readNextHeader (MessageHeader&) const noexcept;
+    const uint8* readNextMessage (const MessageHeader&) noexcept;
+    void writeToFifo (int offset, const void* source, int numBytes) noexcept;
+    void readFromFifo (int offset, void* dest, int numBytes) const noexcept;
+
     double lastCallbackTime = 0;
-    CriticalSection midiCallbackLock;
+    CriticalSection producerLock;
+    AbstractFifo fifo { 1 };
+    HeapBlock<uint8> fifoData, scratch;
     MidiBuffer incomingMessages;
+    std::atomic<int> numDroppedMessages { 0 };
+    std::atomic<bool> isReading { false };
     double sampleRate = 44100.0;
    #if JUCE_DEBUG
     bool hasCalledReset = false;
@@ -96,7 +96,10 @@ struct BytestreamToBytestreamHandler : public BytestreamInputHandler
 struct BytestreamToUMPHandler : public BytestreamInputHandler
 {
     BytestreamToUMPHandler (PacketProtocol protocol, Receiver& c)
-        : recipient (c), dispatcher (protocol, 2048) {}
+        : recipient (c), dispatcher (protocol, 2048)
+    {
+        pending.reserve (256);
+    }
 
     /**
         Provides an `operator()` which can create an input handler for a given
@@ -125,15 +128,21 @@ struct BytestreamToUMPHandler : public BytestreamInputHandler
 
     void pushMidiData (const void* data, int bytes, double time) override
     {
+        pending.clear();
+
         const auto* ptr = static_cast<const uint8_t*> (data);
         dispatcher.dispatch (ptr, ptr + bytes, time, [&] (const View& v)
         {
-            recipient.packetReceived (v, time);
+            pending.add (v);
         });
+
+        if (pending.size() != 0)
+            recipient.packetsReceived (pending.begin(), pending.end(), time);
     }
 
     Receiver& recipient;
     BytestreamToUMPDispatcher dispatcher;
+    Packets pending;
 };
 
 } // juce::universal_midi_packets
@@ -100,7 +100,10 @@ struct U32ToBytestreamHandler : public U32InputHandler
 struct U32ToUMPHandler : public U32InputHandler
 {
     U32ToUMPHandler (PacketProtocol protocol, Receiver& c)
-        : recipient (c), converter (protocol) {}
+        : recipient (c), converter (protocol)
+    {
+        pending.reserve (256);
+    }
 
     /**
         Provides an `operator()` which can create an input handler for a given
@@ -133,18 +136,24 @@ struct U32ToUMPHandler : public U32InputHandler
 
     void pushMidiData (const uint32_t* begin, const uint32_t* end, double time) override
     {
-        dispatcher.dispatch (begin, end, time, [this] (const View& view, double thisTime)
+        pending.clear();
+
+        dispatcher.dispatch (begin, end, time, [this] (const View& view, double)
         {
             converter.convert (view, [&] (const View& converted)
             {
-                recipient.packetReceived (converted, thisTime);
+                pending.add (converted);
             });
         });
+
+        if (pending.size() != 0)
+            recipient.packetsReceived (pending.begin(), pending.end(), time);
     }
 
     Receiver& recipient;
     Dispatcher dispatcher;
     GenericUMPConverter converter;
+    Packets pending;
 };
 
 } // namespace juce::universal_midi_packets
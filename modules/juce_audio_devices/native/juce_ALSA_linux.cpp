@@ -143,6 +143,13 @@ static void ensureMinimumNumBitsSet (BigInteger& chans, int minNumChans)
 
 static void silentErrorHandler (const char*, int, const char*, int, const char*,...) {}
 
+#if JUCE_ALSA_TIMER_SCHEDULING
+static void sleepForSamples (snd_pcm_sframes_t numSamples, unsigned int sampleRate)
+{
+    std::this_thread::sleep_for (std::chrono::microseconds ((int64) numSamples * 1000000 / jmax (1u, sampleRate)));
+}
+#endif
+
 //==============================================================================
 class ALSADevice
 {
@@ -208,6 +215,21 @@ public:
             return false;
         }
 
+        isMemoryMapped = false;
+
+       #if JUCE_ALSA_MMAP
+        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_INTERLEAVED) >= 0)
+        {
+            isMemoryMapped = true;
+            isInterleaved = true;
+        }
+        else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_NONINTERLEAVED) >= 0)
+        {
+            isMemoryMapped = true;
+            isInterleaved = false;
+        }
+        else
+       #endif
         if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw..
             isInterleaved = true;
         else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
@@ -262,12 +284,21 @@ public:
         if (JUCE_ALSA_FAILED (snd_pcm_hw_params_set_rate_near (handle, hwParams, &sampleRate, nullptr))
             || JUCE_ALSA_FAILED (snd_pcm_hw_params_set_channels (handle, hwParams, (unsigned int ) numChannels))
             || JUCE_ALSA_FAILED (snd_pcm_hw_params_set_periods_near (handle, hwParams, &periods, &dir))
-            || JUCE_ALSA_FAILED (snd_pcm_hw_params_set_period_size_near (handle, hwParams, &samplesPerPeriod, &dir))
-            || JUCE_ALSA_FAILED (snd_pcm_hw_params (handle, hwParams)))
+            || JUCE_ALSA_FAILED (snd_pcm_hw_params_set_period_size_near (handle, hwParams, &samplesPerPeriod, &dir)))
         {
             return false;
         }
 
+       #if JUCE_ALSA_TIMER_SCHEDULING
+        // The audio thread sleeps until there's enough data, so it doesn't need an interrupt
+        // at the end of each period. Not all devices allow these to be turned off.
+        if (snd_pcm_hw_params_can_disable_period_wakeup (hwParams))
+            snd_pcm_hw_params_set_period_wakeup (handle, hwParams, 0);
+       #endif
+
+        if (JUCE_ALSA_FAILED (snd_pcm_hw_params (handle, hwParams)))
+            return false;
+
         snd_pcm_uframes_t frames = 0;
 
         if (JUCE_ALSA_FAILED (snd_pcm_hw_params_get_period_size (hwParams, &frames, &dir))
@@ -303,10 +334,59 @@ public:
        #endif
 
         numChannelsRunning = numChannels;
+        actualSampleRate = sampleRate;
 
         return true;
     }
 
+    //==============================================================================
+    /*  Waits until numSamples can be transferred without blocking, starting the stream first
+        if it's an input that hasn't started yet.
+
+        Returns false if the device reports an error that it can't recover from. If the
+        timeout expires, this returns true and the caller transfers whatever is available.
+    */
+    bool waitForSamples (const int numSamples, const int timeoutMs)
+    {
+        const auto startTime = Time::getMillisecondCounter();
+
+        for (;;)
+        {
+            if (isInput && snd_pcm_state (handle) == SND_PCM_STATE_PREPARED
+                 && JUCE_ALSA_FAILED (snd_pcm_start (handle)))
+                return false;
+
+            const auto avail = snd_pcm_avail_update (handle);
+
+            if (avail < 0)
+            {
+                if (! recoverFromError ((int) avail))
+                    return false;
+
+                continue;
+            }
+
+            const auto msRemaining = timeoutMs - (int) (Time::getMillisecondCounter() - startTime);
+
+            if (avail >= numSamples || msRemaining <= 0)
+                return true;
+
+           #if JUCE_ALSA_TIMER_SCHEDULING
+            sleepForSamples (numSamples - avail, actualSampleRate);
+           #else
+            const auto result = snd_pcm_wait (handle, msRemaining);
+
+            if (result == 0)
+                return true;
+
+            if (result < 0 && ! recoverFromError (result))
+                return false;
+           #endif
+        }
+    }
+
+    //==============================================================================
+
     //==============================================================================
     bool writeToOutputDevice (AudioBuffer<float>& outputChannelBuffer, const int numSamples)
     {
@@ -314,6 +394,9 @@ public:
         float* const* const data = outputChannelBuffer.getArrayOfWritePointers();
         snd_pcm_sframes_t numDone = 0;
 
+        if (isMemoryMapped)
+            return transferMemoryMapped (data, numSamples);
+
         if (isInterleaved)
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
@@ -351,6 +434,9 @@ public:
         jassert (numChannelsRunning <= inputChannelBuffer.getNumChannels());
         float* const* const data = inputChannelBuffer.getArrayOfWritePointers();
 
+        if (isMemoryMapped)
+            return transferMemoryMapped (data, numSamples);
+
         if (isInterleaved)
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
@@ -407,7 +493,8 @@ private:
     //==============================================================================
     String deviceID;
     const bool isInput;
-    bool isInterleaved;
+    bool isInterleaved, isMemoryMapped = false;
+    unsigned int actualSampleRate = 0;
     MemoryBlock scratch;
     std::unique_ptr<AudioData::Converter> converter;
 
@@ -467,6 +554,88 @@ private:
     }
 
     //==============================================================================
+    // Converts samples directly to or from the device's own buffer, avoiding the extra
+    // copy that snd_pcm_readi/writei would make.
+    bool transferMemoryMapped (float* const* const data, const int numSamples)
+    {
+        for (int numDone = 0; numDone < numSamples;)
+        {
+            if (! waitForSamples (numSamples - numDone, 2000))
+                return false;
+
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0;
+            auto frames = (snd_pcm_uframes_t) (numSamples - numDone);
+
+            if (const auto err = snd_pcm_mmap_begin (handle, &areas, &offset, &frames); err < 0)
+            {
+                if (! recoverFromError (err))
+                    return false;
+
+                continue;
+            }
+
+            if (frames == 0)
+            {
+                JUCE_ALSA_LOG ("Did not transfer all samples: numDone: " << numDone << ", numSamples: " << numSamples);
+                return true;
+            }
+
+            const auto getAddress = [&] (int channel)
+            {
+                const auto& area = areas[channel];
+                return addBytesToPointer (area.addr, (area.first + offset * area.step) / 8);
+            };
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+            {
+                auto* const samples = data[i] + numDone;
+
+                if (isInterleaved)
+                {
+                    if (isInput)
+                        converter->convertSamples (samples, 0, getAddress (0), i, (int) frames);
+                    else
+                        converter->convertSamples (getAddress (0), i, samples, 0, (int) frames);
+                }
+                else
+                {
+                    if (isInput)
+                        converter->convertSamples (samples, getAddress (i), (int) frames);
+                    else
+                        converter->convertSamples (getAddress (i), samples, (int) frames);
+                }
+            }
+
+            const auto numCommitted = snd_pcm_mmap_commit (handle, offset, frames);
+
+            if (numCommitted < 0)
+            {
+                if (! recoverFromError ((int) numCommitted))
+                    return false;
+
+                continue;
+            }
+
+            numDone += (int) numCommitted;
+        }
+
+        return true;
+    }
+
+    bool recoverFromError (const int errorNum)
+    {
+        if (errorNum == -(EPIPE))
+        {
+            if (isInput)
+                overrunCount++;
+            else
+                underrunCount++;
+        }
+
+        return ! JUCE_ALSA_FAILED (snd_pcm_recover (handle, errorNum, 1 /* silent */));
+    }
+
     bool failed (const int errorNum)
     {
         if (errorNum >= 0)
@@ -609,8 +778,11 @@ public:
             return;
         }
 
-        if (outputDevice != nullptr && inputDevice != nullptr)
-            snd_pcm_link (outputDevice->handle, inputDevice->handle);
+        // Linking the streams makes them start, stop and recover from xruns together, so that
+        // the input and output stay in step without any drift between them.
+        if (outputDevice != nullptr && inputDevice != nullptr
+             && JUCE_CHECKED_RESULT (snd_pcm_link (outputDevice->handle, inputDevice->handle)) < 0)
+            JUCE_ALSA_LOG ("Couldn't link the input and output streams");
 
         if (inputDevice != nullptr && JUCE_ALSA_FAILED (snd_pcm_prepare (inputDevice->handle)))
             return;
@@ -678,6 +850,16 @@ public:
         {
             if (inputDevice != nullptr && inputDevice->handle != nullptr)
             {
+               #if JUCE_ALSA_TIMER_SCHEDULING
+                if (! inputDevice->waitForSamples (bufferSize, 2000))
+                {
+                    JUCE_ALSA_LOG ("Read failure");
+                    break;
+                }
+
+                if (threadShouldExit())
+                    break;
+               #else
                 if (outputDevice == nullptr || outputDevice->handle == nullptr)
                 {
                     JUCE_ALSA_FAILED (snd_pcm_wait (inputDevice->handle, 2000));
@@ -690,6 +872,7 @@ public:
                     if (avail < 0)
                         JUCE_ALSA_FAILED (snd_pcm_recover (inputDevice->handle, (int) avail, 0));
                 }
+               #endif
 
                 audioIoInProgress = true;
 
@@ -727,6 +910,16 @@ public:
 
             if (outputDevice != nullptr && outputDevice->handle != nullptr)
             {
+               #if JUCE_ALSA_TIMER_SCHEDULING
+                if (! outputDevice->waitForSamples (bufferSize, 2000))
+                {
+                    JUCE_ALSA_LOG ("write failure");
+                    break;
+                }
+
+                if (threadShouldExit())
+                    break;
+               #else
                 JUCE_ALSA_FAILED (snd_pcm_wait (outputDevice->handle, 2000));
 
                 if (threadShouldExit())
@@ -736,6 +929,7 @@ public:
 
                 if (avail < 0)
                     JUCE_ALSA_FAILED (snd_pcm_recover (outputDevice->handle, (int) avail, 0));
+               #endif
 
                 audioIoInProgress = true;
 
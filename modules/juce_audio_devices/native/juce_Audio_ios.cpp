@@ -1182,7 +1182,7 @@ struct iOSAudioIODevice::Pimpl final : public AsyncUpdater
 
     static double getTimestampForMIDI()
     {
-        return Time::getMillisecondCounter() / 1000.0;
+        return Time::getMillisecondCounterHiRes() * 0.001;
     }
 
     static void midiEventCallback (void *client, UInt32 status, UInt32 data1, UInt32 data2, UInt32)
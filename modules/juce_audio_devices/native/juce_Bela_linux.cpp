@@ -91,13 +91,13 @@ public:
 
     void pushMidiMessage (juce::MidiMessage& message)
     {
-        concatenator.pushMidiData (message.getRawData(), message.getRawDataSize(), Time::getMillisecondCounter() * 0.001, midiInput, *midiCallback);
+        concatenator.pushMidiData (message.getRawData(), message.getRawDataSize(), Time::getMillisecondCounterHiRes() * 0.001, midiInput, *midiCallback);
     }
 
 private:
     void pushMidiData (int length)
     {
-        concatenator.pushMidiData (buffer.data(), length, Time::getMillisecondCounter() * 0.001, midiInput, *midiCallback);
+        concatenator.pushMidiData (buffer.data(), length, Time::getMillisecondCounterHiRes() * 0.001, midiInput, *midiCallback);
     }
 
     std::vector<uint8> buffer;
@@ -414,7 +414,7 @@ private:
                                 snd_midi_event_reset_decode (midiParser);
 
                                 concatenator.pushMidiData (buffer.data(), (int) numBytes,
-                                                           Time::getMillisecondCounter() * 0.001,
+                                                           Time::getMillisecondCounterHiRes() * 0.001,
                                                            inputEvent, client);
                             }
                         }
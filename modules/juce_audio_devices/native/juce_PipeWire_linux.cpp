@@ -0,0 +1,441 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+static void* juce_libpipewireHandle = nullptr;
+
+static void* juce_loadPipeWireFunction (const char* const name)
+{
+    if (juce_libpipewireHandle == nullptr)
+        return nullptr;
+
+    return dlsym (juce_libpipewireHandle, name);
+}
+
+#define JUCE_DECL_PIPEWIRE_FUNCTION(return_type, fn_name, argument_types, arguments)  \
+  return_type fn_name argument_types                                                  \
+  {                                                                                   \
+      using ReturnType = return_type;                                                 \
+      typedef return_type (*fn_type) argument_types;                                  \
+      static fn_type fn = (fn_type) juce_loadPipeWireFunction (#fn_name);             \
+      jassert (fn != nullptr);                                                        \
+      return (fn != nullptr) ? ((*fn) arguments) : ReturnType();                      \
+  }
+
+#define JUCE_DECL_VOID_PIPEWIRE_FUNCTION(fn_name, argument_types, arguments)          \
+  void fn_name argument_types                                                         \
+  {                                                                                   \
+      typedef void (*fn_type) argument_types;                                         \
+      static fn_type fn = (fn_type) juce_loadPipeWireFunction (#fn_name);             \
+      jassert (fn != nullptr);                                                        \
+      if (fn != nullptr) (*fn) arguments;                                             \
+  }
+
+//==============================================================================
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_init, (int* argc, char** argv[]), (argc, argv))
+JUCE_DECL_PIPEWIRE_FUNCTION (pw_thread_loop*, pw_thread_loop_new, (const char* name, const spa_dict* props), (name, props))
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_thread_loop_destroy, (pw_thread_loop* loop), (loop))
+JUCE_DECL_PIPEWIRE_FUNCTION (int, pw_thread_loop_start, (pw_thread_loop* loop), (loop))
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_thread_loop_stop, (pw_thread_loop* loop), (loop))
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_thread_loop_lock, (pw_thread_loop* loop), (loop))
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_thread_loop_unlock, (pw_thread_loop* loop), (loop))
+JUCE_DECL_PIPEWIRE_FUNCTION (pw_loop*, pw_thread_loop_get_loop, (pw_thread_loop* loop), (loop))
+JUCE_DECL_PIPEWIRE_FUNCTION (pw_properties*, pw_properties_new_dict, (const spa_dict* dict), (dict))
+JUCE_DECL_PIPEWIRE_FUNCTION (int, pw_properties_set, (pw_properties* properties, const char* key, const char* value), (properties, key, value))
+JUCE_DECL_PIPEWIRE_FUNCTION (pw_filter*, pw_filter_new_simple, (pw_loop* loop, const char* name, pw_properties* props, const pw_filter_events* events, void* data), (loop, name, props, events, data))
+JUCE_DECL_VOID_PIPEWIRE_FUNCTION (pw_filter_destroy, (pw_filter* filter), (filter))
+JUCE_DECL_PIPEWIRE_FUNCTION (void*, pw_filter_add_port, (pw_filter* filter, pw_direction direction, pw_filter_port_flags flags, size_t port_data_size, pw_properties* props, const spa_pod** params, uint32_t n_params), (filter, direction, flags, port_data_size, props, params, n_params))
+JUCE_DECL_PIPEWIRE_FUNCTION (int, pw_filter_connect, (pw_filter* filter, pw_filter_flags flags, const spa_pod** params, uint32_t n_params), (filter, flags, params, n_params))
+JUCE_DECL_PIPEWIRE_FUNCTION (void*, pw_filter_get_dsp_buffer, (void* port_data, uint32_t n_samples), (port_data, n_samples))
+
+#if JUCE_DEBUG
+ #define JUCE_PIPEWIRE_LOG(x)   std::cerr << x << std::endl
+#else
+ #define JUCE_PIPEWIRE_LOG(x)   {}
+#endif
+
+//==============================================================================
+#ifndef JUCE_PIPEWIRE_CLIENT_NAME
+ #ifdef JucePlugin_Name
+  #define JUCE_PIPEWIRE_CLIENT_NAME JucePlugin_Name
+ #else
+  #define JUCE_PIPEWIRE_CLIENT_NAME "JUCE"
+ #endif
+#endif
+
+static pw_properties* createPipeWireProperties (std::initializer_list<std::pair<const char*, String>> items)
+{
+    const spa_dict empty {};
+    auto* props = juce::pw_properties_new_dict (&empty);
+
+    if (props != nullptr)
+        for (const auto& [key, value] : items)
+            juce::pw_properties_set (props, key, value.toRawUTF8());
+
+    return props;
+}
+
+//==============================================================================
+/*  Runs the callback as a PipeWire DSP filter node, with one mono float port per
+    active channel. PipeWire hands each port's buffer straight to the callback as a
+    channel pointer, so there's no copying or format conversion on the audio thread.
+
+    Like a JACK client, the node's ports are connected to hardware or to other nodes
+    by the session manager or a patchbay.
+*/
+class PipeWireAudioIODevice final : public AudioIODevice
+{
+public:
+    explicit PipeWireAudioIODevice (const String& deviceName)
+        : AudioIODevice (deviceName, "PipeWire")
+    {
+        filterEvents.version = PW_VERSION_FILTER_EVENTS;
+        filterEvents.process = processCallback;
+        filterEvents.state_changed = stateChangedCallback;
+
+        spareInput.calloc (maxBlockSize);
+    }
+
+    ~PipeWireAudioIODevice() override
+    {
+        close();
+    }
+
+    StringArray getOutputChannelNames() override        { return getChannelNames ("out_"); }
+    StringArray getInputChannelNames() override         { return getChannelNames ("in_"); }
+
+    Array<double> getAvailableSampleRates() override    { return { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 }; }
+    Array<int> getAvailableBufferSizes() override       { return { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 }; }
+    int getDefaultBufferSize() override                 { return 256; }
+
+    int getCurrentBufferSizeSamples() override          { return currentBufferSize.load(); }
+    double getCurrentSampleRate() override              { return currentSampleRate.load(); }
+    int getCurrentBitDepth() override                   { return 32; }
+
+    BigInteger getActiveOutputChannels() const override { return activeOutputChannels; }
+    BigInteger getActiveInputChannels() const override  { return activeInputChannels; }
+
+    // The graph adds a quantum of latency in each direction
+    int getOutputLatencyInSamples() override            { return getCurrentBufferSizeSamples(); }
+    int getInputLatencyInSamples() override             { return getCurrentBufferSizeSamples(); }
+
+    String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                 double sampleRate, int bufferSizeSamples) override
+    {
+        close();
+        lastError.clear();
+
+        const auto rate = roundToInt (sampleRate > 0 ? sampleRate : 48000.0);
+        const auto quantum = jlimit (16, maxBlockSize, bufferSizeSamples > 0 ? bufferSizeSamples : getDefaultBufferSize());
+
+        currentSampleRate = rate;
+        currentBufferSize = quantum;
+
+        activeInputChannels = inputChannels;
+        activeInputChannels.setRange (maxChannels, jmax (0, activeInputChannels.getHighestBit() + 1 - maxChannels), false);
+        activeOutputChannels = outputChannels;
+        activeOutputChannels.setRange (maxChannels, jmax (0, activeOutputChannels.getHighestBit() + 1 - maxChannels), false);
+
+        threadLoop = juce::pw_thread_loop_new ("JUCE PipeWire", nullptr);
+
+        if (threadLoop == nullptr)
+        {
+            lastError = "Couldn't create a PipeWire thread loop";
+            return lastError;
+        }
+
+        juce::pw_thread_loop_lock (threadLoop);
+
+        auto* props = createPipeWireProperties ({ { PW_KEY_MEDIA_TYPE,     "Audio" },
+                                                  { PW_KEY_MEDIA_CATEGORY, "Duplex" },
+                                                  { PW_KEY_MEDIA_ROLE,     "DSP" },
+                                                  { PW_KEY_NODE_LATENCY,   String (quantum) + "/" + String (rate) },
+                                                  { PW_KEY_NODE_RATE,      "1/" + String (rate) } });
+
+        filter = juce::pw_filter_new_simple (juce::pw_thread_loop_get_loop (threadLoop),
+                                             JUCE_PIPEWIRE_CLIENT_NAME, props, &filterEvents, this);
+
+        if (filter != nullptr)
+        {
+            addPorts (activeInputChannels, PW_DIRECTION_INPUT, "in_", inputPorts);
+            addPorts (activeOutputChannels, PW_DIRECTION_OUTPUT, "out_", outputPorts);
+
+            inChans.calloc (inputPorts.size() + 1);
+            outChans.calloc (outputPorts.size() + 1);
+            spareOutputs.setSize (jmax (1, outputPorts.size()), maxBlockSize);
+
+            if (juce::pw_filter_connect (filter, PW_FILTER_FLAG_RT_PROCESS, nullptr, 0) < 0)
+                lastError = "Couldn't connect the PipeWire filter";
+        }
+        else
+        {
+            lastError = "Couldn't create a PipeWire filter";
+        }
+
+        juce::pw_thread_loop_unlock (threadLoop);
+
+        if (lastError.isEmpty() && juce::pw_thread_loop_start (threadLoop) < 0)
+            lastError = "Couldn't start the PipeWire thread loop";
+
+        if (lastError.isNotEmpty())
+        {
+            close();
+            return lastError;
+        }
+
+        deviceIsOpen = true;
+        return {};
+    }
+
+    void close() override
+    {
+        stop();
+
+        if (threadLoop != nullptr)
+        {
+            juce::pw_thread_loop_lock (threadLoop);
+
+            if (filter != nullptr)
+                juce::pw_filter_destroy (filter);
+
+            juce::pw_thread_loop_unlock (threadLoop);
+            juce::pw_thread_loop_stop (threadLoop);
+            juce::pw_thread_loop_destroy (threadLoop);
+        }
+
+        filter = nullptr;
+        threadLoop = nullptr;
+        inputPorts.clear();
+        outputPorts.clear();
+        deviceIsOpen = false;
+    }
+
+    void start (AudioIODeviceCallback* newCallback) override
+    {
+        if (deviceIsOpen && newCallback != callback)
+        {
+            if (newCallback != nullptr)
+                newCallback->audioDeviceAboutToStart (this);
+
+            AudioIODeviceCallback* const oldCallback = callback;
+
+            {
+                const ScopedLock sl (callbackLock);
+                callback = newCallback;
+            }
+
+            if (oldCallback != nullptr)
+                oldCallback->audioDeviceStopped();
+        }
+    }
+
+    void stop() override
+    {
+        start (nullptr);
+    }
+
+    bool isOpen() override                  { return deviceIsOpen; }
+    bool isPlaying() override               { return callback != nullptr; }
+    String getLastError() override          { return lastError; }
+
+    static constexpr int maxChannels = 64;
+
+private:
+    //==============================================================================
+    static constexpr int maxBlockSize = 8192;
+
+    static StringArray getChannelNames (const String& prefix)
+    {
+        StringArray names;
+
+        for (int i = 0; i < maxChannels; ++i)
+            names.add (prefix + String (i + 1));
+
+        return names;
+    }
+
+    void addPorts (const BigInteger& channels, pw_direction direction, const String& prefix, Array<void*>& ports)
+    {
+        for (int i = channels.findNextSetBit (0); i >= 0; i = channels.findNextSetBit (i + 1))
+        {
+            auto* props = createPipeWireProperties ({ { PW_KEY_FORMAT_DSP, "32 bit float mono audio" },
+                                                      { PW_KEY_PORT_NAME,  prefix + String (i + 1) } });
+
+            if (auto* port = juce::pw_filter_add_port (filter, direction, PW_FILTER_PORT_FLAG_MAP_BUFFERS,
+                                                       0, props, nullptr, 0))
+                ports.add (port);
+        }
+    }
+
+    void process (spa_io_position* position)
+    {
+        const auto numSamples = position != nullptr ? (int) position->clock.duration
+                                                    : currentBufferSize.load();
+
+        if (numSamples <= 0 || numSamples > maxBlockSize)
+            return;
+
+        if (position != nullptr && position->clock.rate.denom > 0)
+            currentSampleRate = (int) position->clock.rate.denom;
+
+        currentBufferSize = numSamples;
+
+        // An unconnected port may not have a buffer, so stand-ins are used to keep
+        // the channel layout the callback was promised.
+        for (int i = 0; i < inputPorts.size(); ++i)
+        {
+            auto* in = static_cast<float*> (juce::pw_filter_get_dsp_buffer (inputPorts.getUnchecked (i), (uint32_t) numSamples));
+            inChans[i] = in != nullptr ? in : spareInput.get();
+        }
+
+        for (int i = 0; i < outputPorts.size(); ++i)
+        {
+            auto* out = static_cast<float*> (juce::pw_filter_get_dsp_buffer (outputPorts.getUnchecked (i), (uint32_t) numSamples));
+            outChans[i] = out != nullptr ? out : spareOutputs.getWritePointer (i);
+        }
+
+        const ScopedLock sl (callbackLock);
+
+        if (callback != nullptr)
+        {
+            callback->audioDeviceIOCallbackWithContext (inChans.getData(),
+                                                        inputPorts.size(),
+                                                        outChans,
+                                                        outputPorts.size(),
+                                                        numSamples,
+                                                        {});
+        }
+        else
+        {
+            for (int i = 0; i < outputPorts.size(); ++i)
+                zeromem (outChans[i], static_cast<size_t> (numSamples) * sizeof (float));
+        }
+    }
+
+    static void processCallback (void* data, spa_io_position* position)
+    {
+        if (data != nullptr)
+            static_cast<PipeWireAudioIODevice*> (data)->process (position);
+    }
+
+    static void stateChangedCallback (void*, pw_filter_state, pw_filter_state state, [[maybe_unused]] const char* error)
+    {
+        if (state == PW_FILTER_STATE_ERROR)
+            JUCE_PIPEWIRE_LOG ("PipeWire filter error: " << (error != nullptr ? error : "unknown"));
+    }
+
+    //==============================================================================
+    pw_thread_loop* threadLoop = nullptr;
+    pw_filter* filter = nullptr;
+    pw_filter_events filterEvents {};
+
+    bool deviceIsOpen = false;
+    String lastError;
+    AudioIODeviceCallback* callback = nullptr;
+    CriticalSection callbackLock;
+
+    Array<void*> inputPorts, outputPorts;
+    HeapBlock<const float*> inChans;
+    HeapBlock<float*> outChans;
+    HeapBlock<float> spareInput;
+    AudioBuffer<float> spareOutputs;
+    BigInteger activeInputChannels, activeOutputChannels;
+
+    std::atomic<int> currentBufferSize { 0 }, currentSampleRate { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PipeWireAudioIODevice)
+};
+
+//==============================================================================
+class PipeWireAudioIODeviceType final : public AudioIODeviceType
+{
+public:
+    PipeWireAudioIODeviceType()
+        : AudioIODeviceType ("PipeWire")
+    {}
+
+    void scanForDevices() override
+    {
+        hasScanned = true;
+        deviceNames.clear();
+
+        if (juce_libpipewireHandle == nullptr)
+        {
+            juce_libpipewireHandle = dlopen ("libpipewire-0.3.so.0", RTLD_LAZY);
+
+            if (juce_libpipewireHandle == nullptr)
+                return;
+
+            juce::pw_init (nullptr, nullptr);
+        }
+
+        deviceNames.add ("PipeWire");
+    }
+
+    StringArray getDeviceNames (bool /* wantInputNames */) const override
+    {
+        jassert (hasScanned); // need to call scanForDevices() before doing this
+        return deviceNames;
+    }
+
+    int getDefaultDeviceIndex (bool /* forInput */) const override
+    {
+        jassert (hasScanned); // need to call scanForDevices() before doing this
+        return 0;
+    }
+
+    bool hasSeparateInputsAndOutputs() const override    { return false; }
+
+    int getIndexOfDevice (AudioIODevice* device, bool /* asInput */) const override
+    {
+        jassert (hasScanned); // need to call scanForDevices() before doing this
+
+        if (auto* d = dynamic_cast<PipeWireAudioIODevice*> (device))
+            return deviceNames.indexOf (d->getName());
+
+        return -1;
+    }
+
+    AudioIODevice* createDevice (const String& outputDeviceName,
+                                 const String& inputDeviceName) override
+    {
+        jassert (hasScanned); // need to call scanForDevices() before doing this
+
+        const auto name = outputDeviceName.isNotEmpty() ? outputDeviceName : inputDeviceName;
+
+        if (deviceNames.contains (name))
+            return new PipeWireAudioIODevice (name);
+
+        return nullptr;
+    }
+
+private:
+    StringArray deviceNames;
+    bool hasScanned = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PipeWireAudioIODeviceType)
+};
+
+} // namespace juce
@@ -222,11 +222,19 @@ enum AUDIO_STREAM_CATEGORY
     AudioCategory_Media
 };
 
+enum AUDCLNT_STREAMOPTIONS
+{
+    AUDCLNT_STREAMOPTIONS_NONE          = 0,
+    AUDCLNT_STREAMOPTIONS_RAW           = 0x1,
+    AUDCLNT_STREAMOPTIONS_MATCH_FORMAT  = 0x2
+};
+
 struct AudioClientProperties
 {
     UINT32                  cbSize;
     BOOL                    bIsOffload;
     AUDIO_STREAM_CATEGORY   eCategory;
+    AUDCLNT_STREAMOPTIONS   Options;
 };
 
 JUCE_IUNKNOWNCLASS (IAudioClient, "1CB9AD4C-DBFA-4c32-B178-C2F568A703B2")
@@ -443,6 +451,7 @@ public:
             if (auto optFormat = findSupportedFormat (tempClient, defaultNumChannels, defaultSampleRate))
                 format = optFormat;
 
+        requestRawStream (tempClient);
         querySupportedBufferSizes (*format, tempClient);
         querySupportedSampleRates (*format, tempClient);
         maxNumChannels = queryMaxNumChannels (tempClient);
@@ -654,6 +663,27 @@ private:
     }
 
     //==============================================================================
+    // In low latency mode, ask for a raw stream, which bypasses the system's effects
+    // processing. Besides removing the latency that processing adds, many drivers only
+    // offer their smallest shared-mode engine periods to raw streams.
+    // This must be called before the client is initialised, and fails harmlessly on
+    // devices or systems that don't support raw mode.
+    void requestRawStream (ComSmartPtr<IAudioClient>& audioClient) const
+    {
+        if (! isLowLatencyMode (deviceMode))
+            return;
+
+        if (auto audioClient2 = audioClient.getInterface<IAudioClient2>())
+        {
+            AudioClientProperties properties{};
+            properties.cbSize = sizeof (properties);
+            properties.eCategory = AudioCategory_Other;
+            properties.Options = AUDCLNT_STREAMOPTIONS_RAW;
+
+            logFailure (audioClient2->SetClientProperties (&properties));
+        }
+    }
+
     void querySupportedBufferSizes (WAVEFORMATEXTENSIBLE format, ComSmartPtr<IAudioClient>& audioClient)
     {
         if (isLowLatencyMode (deviceMode))
@@ -846,6 +876,8 @@ private:
 
     bool initialiseLowLatencyClient (int bufferSizeSamples, WAVEFORMATEXTENSIBLE format)
     {
+        requestRawStream (client);
+
         if (auto audioClient3 = client.getInterface<IAudioClient3>())
             return check (audioClient3->InitializeSharedAudioStream (getStreamFlags(),
                                                                      (UINT32) bufferSizeSamples,
@@ -1493,24 +1525,44 @@ public:
         }
     }
 
-    void setMMThreadPriority()
+    // Registers the calling thread with MMCSS as a "Pro Audio" task for as long as this
+    // object exists, so that the scheduler gives it priority over normal threads.
+    class ScopedMMThreadCharacteristics
     {
-        DynamicLibrary dll ("avrt.dll");
-        JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
-        JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadPriority, avSetMmThreadPriority, HANDLE, (HANDLE, AVRT_PRIORITY))
+    public:
+        ScopedMMThreadCharacteristics()
+        {
+            JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
+            JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadPriority, avSetMmThreadPriority, HANDLE, (HANDLE, AVRT_PRIORITY))
+
+            if (avSetMmThreadCharacteristics != nullptr && avSetMmThreadPriority != nullptr)
+            {
+                DWORD dummy = 0;
+                handle = avSetMmThreadCharacteristics (L"Pro Audio", &dummy);
+
+                if (handle != nullptr)
+                    avSetMmThreadPriority (handle, AVRT_PRIORITY_NORMAL);
+            }
+        }
 
-        if (avSetMmThreadCharacteristics != nullptr && avSetMmThreadPriority != nullptr)
+        ~ScopedMMThreadCharacteristics()
         {
-            DWORD dummy = 0;
+            JUCE_LOAD_WINAPI_FUNCTION (dll, AvRevertMmThreadCharacteristics, avRevertMmThreadCharacteristics, BOOL, (HANDLE))
 
-            if (auto h = avSetMmThreadCharacteristics (L"Pro Audio", &dummy))
-                avSetMmThreadPriority (h, AVRT_PRIORITY_NORMAL);
+            if (handle != nullptr && avRevertMmThreadCharacteristics != nullptr)
+                avRevertMmThreadCharacteristics (handle);
         }
-    }
+
+    private:
+        DynamicLibrary dll { "avrt.dll" };
+        HANDLE handle = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedMMThreadCharacteristics)
+    };
 
     void run() override
     {
-        setMMThreadPriority();
+        const ScopedMMThreadCharacteristics mmThreadCharacteristics;
 
         auto bufferSize        = currentBufferSizeSamples;
         auto numInputBuffers   = getActiveInputChannels().countNumberOfSetBits();
@@ -23,6 +23,16 @@
 namespace juce
 {
 
+static constexpr double minPlaybackSpeed = 0.25, maxPlaybackSpeed = 4.0;
+
+// The number of source samples that get read for each sample that's played
+static double getSourceSamplesPerOutputSample (double sourceSampleRate, double sampleRate,
+                                               AudioTransportSource::SpeedMode speedMode, double speed)
+{
+    const auto rateRatio = (sourceSampleRate > 0 && sampleRate > 0) ? sourceSampleRate / sampleRate : 1.0;
+    return speedMode == AudioTransportSource::SpeedMode::varispeed ? rateRatio * speed : rateRatio;
+}
+
 AudioTransportSource::AudioTransportSource()
 {
 }
@@ -35,7 +45,8 @@ AudioTransportSource::~AudioTransportSource()
 
 void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
                                       int readAheadSize, TimeSliceThread* readAheadThread,
-                                      double sourceSampleRateToCorrectFor, int maxNumChannels)
+                                      double sourceSampleRateToCorrectFor, int maxNumChannels,
+                                      SpeedMode newSpeedMode)
 {
     if (source == newSource)
     {
@@ -46,10 +57,12 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
     }
 
     ResamplingAudioSource* newResamplerSource = nullptr;
+    TimeStretchAudioSource* newStretchSource = nullptr;
     BufferingAudioSource* newBufferingSource = nullptr;
     PositionableAudioSource* newPositionableSource = nullptr;
     AudioSource* newMasterSource = nullptr;
 
+    std::unique_ptr<TimeStretchAudioSource> oldStretchSource (stretchSource);
     std::unique_ptr<ResamplingAudioSource> oldResamplerSource (resamplerSource);
     std::unique_ptr<BufferingAudioSource> oldBufferingSource (bufferingSource);
     AudioSource* oldMasterSource = masterSource;
@@ -71,16 +84,23 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
 
         newPositionableSource->setNextReadPosition (0);
 
-        if (sourceSampleRateToCorrectFor > 0)
+        if (sourceSampleRateToCorrectFor > 0 || newSpeedMode == SpeedMode::varispeed)
             newMasterSource = newResamplerSource
                 = new ResamplingAudioSource (newPositionableSource, false, maxNumChannels);
         else
             newMasterSource = newPositionableSource;
 
+        if (newSpeedMode == SpeedMode::timeStretch)
+            newMasterSource = newStretchSource
+                = new TimeStretchAudioSource (newMasterSource, false, maxNumChannels);
+
         if (isPrepared)
         {
-            if (newResamplerSource != nullptr && sourceSampleRateToCorrectFor > 0 && sampleRate > 0)
-                newResamplerSource->setResamplingRatio (sourceSampleRateToCorrectFor / sampleRate);
+            // The resampler sizes its buffers for the ratio it's prepared with, so preparing it
+            // for the fastest speed means that changing speed later won't need to allocate.
+            if (newResamplerSource != nullptr)
+                newResamplerSource->setResamplingRatio (getSourceSamplesPerOutputSample (sourceSampleRateToCorrectFor, sampleRate,
+                                                                                        newSpeedMode, maxPlaybackSpeed));
 
             newMasterSource->prepareToPlay (blockSize, sampleRate);
         }
@@ -91,11 +111,15 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
 
         source = newSource;
         resamplerSource = newResamplerSource;
+        stretchSource = newStretchSource;
         bufferingSource = newBufferingSource;
         masterSource = newMasterSource;
         positionableSource = newPositionableSource;
         readAheadBufferSize = readAheadSize;
         sourceSampleRate = sourceSampleRateToCorrectFor;
+        speedMode = newSpeedMode;
+
+        applyPlaybackSpeed();
 
         playing = false;
     }
@@ -171,6 +195,9 @@ void AudioTransportSource::setNextReadPosition (int64 newPosition)
 
         if (resamplerSource != nullptr)
             resamplerSource->flushBuffers();
+
+        if (stretchSource != nullptr)
+            stretchSource->flushBuffers();
     }
 }
 
@@ -211,6 +238,28 @@ void AudioTransportSource::setGain (const float newGain) noexcept
     gain = newGain;
 }
 
+void AudioTransportSource::setPlaybackSpeed (double newSpeed) noexcept
+{
+    jassert (newSpeed > 0);
+    playbackSpeed = jlimit (minPlaybackSpeed, maxPlaybackSpeed, newSpeed);
+}
+
+void AudioTransportSource::applyPlaybackSpeed()
+{
+    appliedSpeed = playbackSpeed;
+
+    if (resamplerSource != nullptr)
+        resamplerSource->setResamplingRatio (getSourceSamplesPerOutputSample (sourceSampleRate, sampleRate, speedMode, appliedSpeed));
+
+    if (stretchSource != nullptr)
+        stretchSource->setSpeed (appliedSpeed);
+
+    // Both resampling and time-stretching read the source faster at higher speeds
+    if (bufferingSource != nullptr)
+        bufferingSource->setPlaybackSpeed (getSourceSamplesPerOutputSample (sourceSampleRate, sampleRate, SpeedMode::varispeed,
+                                                                            speedMode == SpeedMode::fixed ? 1.0 : appliedSpeed));
+}
+
 void AudioTransportSource::prepareToPlay (int samplesPerBlockExpected, double newSampleRate)
 {
     const ScopedLock sl (callbackLock);
@@ -218,11 +267,14 @@ void AudioTransportSource::prepareToPlay (int samplesPerBlockExpected, double ne
     sampleRate = newSampleRate;
     blockSize = samplesPerBlockExpected;
 
+    if (resamplerSource != nullptr)
+        resamplerSource->setResamplingRatio (getSourceSamplesPerOutputSample (sourceSampleRate, sampleRate,
+                                                                              speedMode, maxPlaybackSpeed));
+
     if (masterSource != nullptr)
         masterSource->prepareToPlay (samplesPerBlockExpected, sampleRate);
 
-    if (resamplerSource != nullptr && sourceSampleRate > 0)
-        resamplerSource->setResamplingRatio (sourceSampleRate / sampleRate);
+    applyPlaybackSpeed();
 
     isPrepared = true;
 }
@@ -248,6 +300,9 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
 
     if (masterSource != nullptr && ! stopped)
     {
+        if (! approximatelyEqual (appliedSpeed, playbackSpeed.load()))
+            applyPlaybackSpeed();
+
         masterSource->getNextAudioBlock (info);
 
         if (! playing)
@@ -51,6 +51,17 @@ public:
     /** Destructor. */
     ~AudioTransportSource() override;
 
+    //==============================================================================
+    /** The ways in which setPlaybackSpeed() can change the speed of the source.
+        @see setSource, setPlaybackSpeed
+    */
+    enum class SpeedMode
+    {
+        fixed,          /**< The source always plays at its normal speed. */
+        varispeed,      /**< The source is resampled, so that its pitch changes along with its speed. */
+        timeStretch     /**< The source is time-stretched, so that its pitch stays the same. */
+    };
+
     //==============================================================================
     /** Sets the reader that is being used as the input source.
 
@@ -74,12 +85,17 @@ public:
                                                 adjusted to maintain playback at the correct pitch. If
                                                 this is 0, no sample-rate adjustment will be performed
         @param maxNumChannels                   the maximum number of channels that may need to be played
+        @param speedMode                        how setPlaybackSpeed() should change the speed. If this
+                                                is SpeedMode::timeStretch, the output will lag behind
+                                                the reported position by the TimeStretchAudioSource's
+                                                latency.
     */
     void setSource (PositionableAudioSource* newSource,
                     int readAheadBufferSize = 0,
                     TimeSliceThread* readAheadThread = nullptr,
                     double sourceSampleRateToCorrectFor = 0.0,
-                    int maxNumChannels = 2);
+                    int maxNumChannels = 2,
+                    SpeedMode speedMode = SpeedMode::fixed);
 
     //==============================================================================
     /** Changes the current playback position in the source stream.
@@ -134,6 +150,23 @@ public:
     */
     float getGain() const noexcept      { return gain; }
 
+    //==============================================================================
+    /** Changes the playback speed.
+
+        This only has an effect if the source was set with a SpeedMode other than
+        SpeedMode::fixed. It doesn't lock or allocate, so it's safe to call from any
+        thread, including the audio thread, and the new speed will be used from the
+        next block onwards.
+
+        @param newSpeed     the speed relative to normal playback, so 2.0 is twice as
+                            fast. This is limited to the range 0.25 to 4.0.
+        @see setSource
+    */
+    void setPlaybackSpeed (double newSpeed) noexcept;
+
+    /** Returns the speed that was set with setPlaybackSpeed(). */
+    double getPlaybackSpeed() const noexcept    { return playbackSpeed; }
+
     //==============================================================================
     /** Implementation of the AudioSource method. */
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
@@ -161,6 +194,7 @@ private:
     //==============================================================================
     PositionableAudioSource* source = nullptr;
     ResamplingAudioSource* resamplerSource = nullptr;
+    TimeStretchAudioSource* stretchSource = nullptr;
     BufferingAudioSource* bufferingSource = nullptr;
     PositionableAudioSource* positionableSource = nullptr;
     AudioSource* masterSource = nullptr;
@@ -168,11 +202,14 @@ private:
     CriticalSection callbackLock;
     float gain = 1.0f, lastGain = 1.0f;
     std::atomic<bool> playing { false }, stopped { true };
-    double sampleRate = 44100.0, sourceSampleRate = 0;
+    std::atomic<double> playbackSpeed { 1.0 };
+    double sampleRate = 44100.0, sourceSampleRate = 0, appliedSpeed = 1.0;
     int blockSize = 128, readAheadBufferSize = 0;
+    SpeedMode speedMode = SpeedMode::fixed;
     bool isPrepared = false;
 
     void releaseMasterResources();
+    void applyPlaybackSpeed();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioTransportSource)
 };
@@ -34,7 +34,10 @@ namespace juce
 
     To compile this, you'll need to set the JUCE_USE_OGGVORBIS flag.
 
-    @see AudioFormat,
+    Ogg-Vorbis files can't be memory-mapped, so if many readers need the same file, use a
+    DecodedAudioBlockCache to let them share the decoded audio.
+
+    @see AudioFormat, DecodedAudioBlockCache
 
     @tags{Audio}
 */
@@ -0,0 +1,322 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ARAAudioSourceAnalysisScheduler::Task::Task (ARAAudioSource& source,
+                                             ParallelAudioReader::ReaderFactory createReader,
+                                             ThreadPool& threadPool,
+                                             CancellationToken cancellationToken)
+    : audioSource (source),
+      reader (std::move (createReader), threadPool),
+      token (std::move (cancellationToken))
+{
+}
+
+bool ARAAudioSourceAnalysisScheduler::Task::read (AudioBuffer<float>& destination, int destStartSample,
+                                                  int numSamples, int64 sourceStartSample)
+{
+    return ! shouldExit() && reader.read (destination, destStartSample, numSamples, sourceStartSample);
+}
+
+void ARAAudioSourceAnalysisScheduler::Task::setProgress (float progress)
+{
+    progress = jlimit (0.0f, 1.0f, progress);
+
+    if (progress <= lastProgress)
+        return;
+
+    lastProgress = progress;
+    audioSource.notifyAnalysisProgressUpdated (progress);
+}
+
+bool ARAAudioSourceAnalysisScheduler::Task::shouldExit() const noexcept
+{
+    if (token.isCancelled())
+        return true;
+
+    if (auto* job = ThreadPoolJob::getCurrentThreadPoolJob())
+        return job->shouldExit();
+
+    return false;
+}
+
+//==============================================================================
+struct ARAAudioSourceAnalysisScheduler::Analysis
+{
+    Analysis (ARAAudioSource& source, int numReaders)  : audioSource (source)
+    {
+        for (int i = 0; i < numReaders; ++i)
+            readers.push_back (std::make_unique<ARAAudioSourceReader> (&source));
+    }
+
+    /*  ARAAudioSourceReaders have to be created and destroyed on the message thread, so this
+        hands out non-owning wrappers of the ones made in the constructor, and then returns
+        nullptr, which tells the ParallelAudioReader that it can't have any more.
+    */
+    ParallelAudioReader::ReaderFactory createReaderFactory()
+    {
+        return [this, next = std::make_shared<std::atomic<size_t>> (0)]() -> std::unique_ptr<AudioFormatReader>
+        {
+            const auto index = next->fetch_add (1);
+
+            if (index >= readers.size())
+                return nullptr;
+
+            auto* reader = readers[index].get();
+            return std::make_unique<AudioSubsectionReader> (reader, 0, reader->lengthInSamples, false);
+        };
+    }
+
+    ARAAudioSource& audioSource;
+    std::vector<std::unique_ptr<ARAAudioSourceReader>> readers;
+    CancellationToken token;
+    std::unique_ptr<Task> task;
+    WaitableEvent finished { true };
+    bool succeeded = false;
+};
+
+//==============================================================================
+ARAAudioSourceAnalysisScheduler::ARAAudioSourceAnalysisScheduler (ThreadPool& threadPool,
+                                                                  AnalysisFunction analysisFunction,
+                                                                  int numReadersPerSource)
+    : pool (threadPool),
+      analyse (std::move (analysisFunction)),
+      readersPerSource (jmax (1, numReadersPerSource))
+{
+    jassert (analyse != nullptr);
+}
+
+ARAAudioSourceAnalysisScheduler::~ARAAudioSourceAnalysisScheduler()
+{
+    cancelAllAnalyses();
+}
+
+void ARAAudioSourceAnalysisScheduler::requestAnalysis (ARAAudioSource& audioSource)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (isAnalysing (audioSource))
+        return;
+
+    audioSource.addListener (this);
+    queued.push_back (&audioSource);
+    startQueuedAnalyses();
+}
+
+void ARAAudioSourceAnalysisScheduler::cancelAnalysis (ARAAudioSource& audioSource)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (stopAnalysis (audioSource))
+    {
+        audioSource.removeListener (this);
+        startQueuedAnalyses();
+    }
+}
+
+void ARAAudioSourceAnalysisScheduler::cancelAllAnalyses()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    for (auto* source : std::exchange (queued, {}))
+        source->removeListener (this);
+
+    // Cancel everything first, so that the analyses stop in parallel
+    for (auto& analysis : running)
+        analysis->token.cancel();
+
+    for (auto& analysis : std::exchange (running, {}))
+    {
+        analysis->finished.wait (-1);
+        analysis->audioSource.removeListener (this);
+    }
+}
+
+bool ARAAudioSourceAnalysisScheduler::isAnalysing (const ARAAudioSource& audioSource) const
+{
+    return std::find (queued.begin(), queued.end(), &audioSource) != queued.end()
+        || std::any_of (running.begin(), running.end(), [&] (const auto& a) { return &a->audioSource == &audioSource; });
+}
+
+int ARAAudioSourceAnalysisScheduler::getNumAnalyses() const noexcept
+{
+    return (int) (queued.size() + running.size());
+}
+
+//==============================================================================
+void ARAAudioSourceAnalysisScheduler::startQueuedAnalyses()
+{
+    while ((int) running.size() < jmax (1, pool.getNumThreads()))
+    {
+        // Sources that the host won't let us read stay queued until it does
+        const auto next = std::find_if (queued.begin(), queued.end(), [] (auto* s) { return s->isSampleAccessEnabled(); });
+
+        if (next == queued.end())
+            return;
+
+        auto& source = **next;
+        queued.erase (next);
+
+        auto analysis = std::make_unique<Analysis> (source, readersPerSource);
+        analysis->task.reset (new Task (source, analysis->createReaderFactory(), pool, analysis->token));
+
+        pool.addJob ([this, current = analysis.get(), weakThis = WeakReference<ARAAudioSourceAnalysisScheduler> (this)]
+        {
+            auto& task = *current->task;
+
+            if (! task.shouldExit())
+            {
+                current->audioSource.notifyAnalysisProgressStarted();
+                current->succeeded = analyse (task) && ! task.shouldExit();
+                current->audioSource.notifyAnalysisProgressCompleted();
+            }
+
+            // Once this is signalled, the message thread may delete the analysis at any moment
+            current->finished.signal();
+
+            MessageManager::callAsync ([weakThis]
+            {
+                if (auto* scheduler = weakThis.get())
+                    scheduler->collectFinishedAnalyses();
+            });
+        });
+
+        running.push_back (std::move (analysis));
+    }
+}
+
+void ARAAudioSourceAnalysisScheduler::startQueuedAnalysesAsync()
+{
+    MessageManager::callAsync ([weakThis = WeakReference<ARAAudioSourceAnalysisScheduler> (this)]
+    {
+        if (auto* scheduler = weakThis.get())
+            scheduler->startQueuedAnalyses();
+    });
+}
+
+void ARAAudioSourceAnalysisScheduler::collectFinishedAnalyses()
+{
+    std::vector<std::pair<ARAAudioSource*, bool>> results;
+
+    for (auto it = running.begin(); it != running.end();)
+    {
+        if ((*it)->finished.wait (0))
+        {
+            results.emplace_back (&(*it)->audioSource, (*it)->succeeded);
+            it = running.erase (it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (const auto& result : results)
+        stopListeningIfIdle (*result.first);
+
+    startQueuedAnalyses();
+
+    if (onAnalysisFinished != nullptr)
+        for (const auto& result : results)
+            onAnalysisFinished (*result.first, result.second);
+}
+
+bool ARAAudioSourceAnalysisScheduler::stopAnalysis (ARAAudioSource& audioSource)
+{
+    const auto queuedIt = std::find (queued.begin(), queued.end(), &audioSource);
+
+    if (queuedIt != queued.end())
+    {
+        queued.erase (queuedIt);
+        return true;
+    }
+
+    const auto runningIt = std::find_if (running.begin(), running.end(), [&] (const auto& a) { return &a->audioSource == &audioSource; });
+
+    if (runningIt == running.end())
+        return false;
+
+    (*runningIt)->token.cancel();
+    (*runningIt)->finished.wait (-1);
+    running.erase (runningIt);
+    return true;
+}
+
+void ARAAudioSourceAnalysisScheduler::restartAnalysis (ARAAudioSource& audioSource)
+{
+    // The host is in the middle of an edit here, so the new readers are created afterwards
+    if (stopAnalysis (audioSource))
+    {
+        queued.insert (queued.begin(), &audioSource);
+        startQueuedAnalysesAsync();
+    }
+}
+
+void ARAAudioSourceAnalysisScheduler::stopListeningIfIdle (ARAAudioSource& audioSource)
+{
+    if (! isAnalysing (audioSource))
+        audioSource.removeListener (this);
+}
+
+//==============================================================================
+void ARAAudioSourceAnalysisScheduler::willUpdateAudioSourceProperties (ARAAudioSource* audioSource,
+                                                                       ARAAudioSource::PropertiesPtr newProperties)
+{
+    if (audioSource->getSampleCount() != newProperties->sampleCount
+        || ! exactlyEqual (audioSource->getSampleRate(), newProperties->sampleRate)
+        || audioSource->getChannelCount() != newProperties->channelCount)
+    {
+        restartAnalysis (*audioSource);
+    }
+}
+
+void ARAAudioSourceAnalysisScheduler::doUpdateAudioSourceContent (ARAAudioSource* audioSource,
+                                                                  ARAContentUpdateScopes scopeFlags)
+{
+    if (scopeFlags.affectSamples())
+        restartAnalysis (*audioSource);
+}
+
+void ARAAudioSourceAnalysisScheduler::willEnableAudioSourceSamplesAccess (ARAAudioSource* audioSource, bool enable)
+{
+    if (! enable)
+        restartAnalysis (*audioSource);
+}
+
+void ARAAudioSourceAnalysisScheduler::didEnableAudioSourceSamplesAccess (ARAAudioSource*, bool enable)
+{
+    if (enable)
+        startQueuedAnalyses();
+}
+
+void ARAAudioSourceAnalysisScheduler::willDestroyAudioSource (ARAAudioSource* audioSource)
+{
+    stopAnalysis (*audioSource);
+    audioSource->removeListener (this);
+}
+
+} // namespace juce
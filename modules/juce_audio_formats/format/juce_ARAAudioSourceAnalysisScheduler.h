@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Analyses ARA audio sources on a ThreadPool, several sources at a time.
+
+    Hosts often request analysis for many audio sources at once, for example when a lot of
+    clips are imported into a document. An ARADocumentControllerSpecialisation can forward
+    those requests to this class, which queues them and keeps up to one analysis per thread
+    of the pool running. It sends the ARA analysis progress notifications for each source,
+    and cancels or restarts analyses when the host destroys a source, changes its samples
+    or disables access to them.
+
+    @code
+    class MyDocumentController : public ARADocumentControllerSpecialisation
+    {
+        ...
+
+        bool doIsAudioSourceContentAnalysisIncomplete (const ARA::PlugIn::AudioSource* audioSource,
+                                                       ARA::ARAContentType type) override
+        {
+            return type == ARA::kARAContentTypeNotes
+                && scheduler.isAnalysing (*static_cast<const ARAAudioSource*> (audioSource));
+        }
+
+        void doRequestAudioSourceContentAnalysis (ARA::PlugIn::AudioSource* audioSource,
+                                                  const std::vector<ARA::ARAContentType>&) override
+        {
+            scheduler.requestAnalysis (*static_cast<ARAAudioSource*> (audioSource));
+        }
+
+        ThreadPool pool;
+        ARAAudioSourceAnalysisScheduler scheduler { pool, [this] (auto& task) { return analyseNotes (task); } };
+    };
+    @endcode
+
+    The readers for each analysis are created and destroyed on the message thread, as
+    ARAAudioSourceReader requires. When a source is given more than one reader, long reads
+    are split between them and decoded in parallel with a ParallelAudioReader.
+
+    All the member functions must be called on the message thread.
+
+    @see ARAAudioSourceReader, ParallelAudioReader
+
+    @tags{ARA}
+*/
+class JUCE_API  ARAAudioSourceAnalysisScheduler  : private ARAAudioSource::Listener
+{
+public:
+    //==============================================================================
+    /** The analysis of a single audio source, which is passed to the AnalysisFunction. */
+    class JUCE_API  Task
+    {
+    public:
+        /** Returns the audio source being analysed. */
+        ARAAudioSource& getAudioSource() const noexcept     { return audioSource; }
+
+        /** Returns the number of channels in the audio source. */
+        int getNumChannels() const noexcept                 { return (int) reader.getNumChannels(); }
+
+        /** Returns the length of the audio source, in samples. */
+        int64 getLengthInSamples() const noexcept           { return reader.getLengthInSamples(); }
+
+        /** Returns the sample rate of the audio source. */
+        double getSampleRate() const noexcept               { return reader.getSampleRate(); }
+
+        /** Reads a range of the source's samples into a buffer.
+
+            This returns false if the samples couldn't be read, for example because the host
+            has disabled access to them, or if the analysis has been cancelled.
+        */
+        bool read (AudioBuffer<float>& destination, int destStartSample, int numSamples, int64 sourceStartSample);
+
+        /** Reports the progress of the analysis to the host, in the range 0 to 1.
+
+            Values that are lower than the last one reported are ignored, as ARA requires
+            progress to increase.
+        */
+        void setProgress (float progress);
+
+        /** Returns true if the analysis has been cancelled, in which case the analysis function
+            should return as soon as possible.
+        */
+        bool shouldExit() const noexcept;
+
+    private:
+        friend class ARAAudioSourceAnalysisScheduler;
+
+        Task (ARAAudioSource&, ParallelAudioReader::ReaderFactory, ThreadPool&, CancellationToken);
+
+        ARAAudioSource& audioSource;
+        ParallelAudioReader reader;
+        CancellationToken token;
+        float lastProgress = 0.0f;
+
+        JUCE_DECLARE_NON_COPYABLE (Task)
+    };
+
+    /** A function that analyses an audio source, and returns true if it succeeded.
+
+        This is called on one of the pool's threads, and may be called for several sources at
+        the same time.
+    */
+    using AnalysisFunction = std::function<bool (Task&)>;
+
+    //==============================================================================
+    /** Creates a scheduler.
+
+        @param threadPool           the pool to run the analyses on. It must outlive the scheduler
+        @param analysisFunction     the function that analyses each audio source
+        @param readersPerSource     the number of readers that each analysis may use at the same
+                                    time. Hosts that decode audio on the calling thread will read
+                                    a single source faster with more than one reader
+    */
+    ARAAudioSourceAnalysisScheduler (ThreadPool& threadPool,
+                                     AnalysisFunction analysisFunction,
+                                     int readersPerSource = 2);
+
+    /** Destructor. This cancels any analyses that are still running, and waits for them. */
+    ~ARAAudioSourceAnalysisScheduler() override;
+
+    //==============================================================================
+    /** Queues an audio source to be analysed. Requests for sources that are already queued or
+        being analysed are ignored.
+    */
+    void requestAnalysis (ARAAudioSource& audioSource);
+
+    /** Removes a source from the queue, or cancels its analysis and waits for it to stop. */
+    void cancelAnalysis (ARAAudioSource& audioSource);
+
+    /** Cancels all the queued and running analyses. */
+    void cancelAllAnalyses();
+
+    /** Returns true if a source is queued or being analysed. */
+    bool isAnalysing (const ARAAudioSource& audioSource) const;
+
+    /** Returns the number of sources that are queued or being analysed. */
+    int getNumAnalyses() const noexcept;
+
+    //==============================================================================
+    /** Called on the message thread when an analysis has finished, with a flag that is
+        false if the analysis function failed. This isn't called for analyses that are
+        cancelled, including ones that are restarted because their source changed.
+
+        This is where the results of the analysis would usually be published, followed by a
+        call to ARAAudioSource::notifyContentChanged().
+    */
+    std::function<void (ARAAudioSource&, bool succeeded)> onAnalysisFinished;
+
+private:
+    //==============================================================================
+    struct Analysis;
+
+    void startQueuedAnalyses();
+    void startQueuedAnalysesAsync();
+    void collectFinishedAnalyses();
+    bool stopAnalysis (ARAAudioSource&);
+    void restartAnalysis (ARAAudioSource&);
+    void stopListeningIfIdle (ARAAudioSource&);
+
+    void willUpdateAudioSourceProperties (ARAAudioSource*, ARAAudioSource::PropertiesPtr) override;
+    void doUpdateAudioSourceContent (ARAAudioSource*, ARAContentUpdateScopes) override;
+    void willEnableAudioSourceSamplesAccess (ARAAudioSource*, bool) override;
+    void didEnableAudioSourceSamplesAccess (ARAAudioSource*, bool) override;
+    void willDestroyAudioSource (ARAAudioSource*) override;
+
+    ThreadPool& pool;
+    const AnalysisFunction analyse;
+    const int readersPerSource;
+
+    std::vector<ARAAudioSource*> queued;
+    std::vector<std::unique_ptr<Analysis>> running;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (ARAAudioSourceAnalysisScheduler)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ARAAudioSourceAnalysisScheduler)
+};
+
+} // namespace juce
@@ -124,10 +124,18 @@ AudioFormatReader* AudioFormatManager::createReaderFor (const File& file)
     jassert (getNumKnownFormats() > 0);
 
     for (auto* af : knownFormats)
+    {
         if (af->canHandleFile (file))
-            if (auto in = file.createInputStream())
+        {
+            // audio files are mostly read from start to end, so ask for more readahead, and
+            // keep the buffer small because a lot of readers may be open at once
+            auto in = std::make_unique<FileInputStream> (file, FileInputStream::ReadMode::sequential, 64 * 1024);
+
+            if (in->openedOk())
                 if (auto* r = af->createReaderFor (in.release(), true))
                     return r;
+        }
+    }
 
     return nullptr;
 }
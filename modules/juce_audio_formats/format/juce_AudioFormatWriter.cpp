@@ -243,7 +243,10 @@ public:
         fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
 
         if (size1 + size2 < numSamples)
+        {
+            ++numOverruns;
             return false;
+        }
 
         for (int i = buffer.getNumChannels(); --i >= 0;)
         {
@@ -321,6 +324,9 @@ public:
         samplesPerFlush = numSamples;
     }
 
+    int getNumSamplesBuffered() const noexcept  { return fifo.getNumReady(); }
+    int getNumOverruns() const noexcept         { return numOverruns.load(); }
+
 private:
     AbstractFifo fifo;
     AudioBuffer<float> buffer;
@@ -331,6 +337,7 @@ private:
     int64 samplesWritten = 0;
     int samplesPerFlush = 0, flushSampleCounter = 0;
     std::atomic<bool> isRunning { true };
+    std::atomic<int> numOverruns { 0 };
 
     JUCE_DECLARE_NON_COPYABLE (Buffer)
 };
@@ -359,4 +366,14 @@ void AudioFormatWriter::ThreadedWriter::setFlushInterval (int numSamplesPerFlush
     buffer->setFlushInterval (numSamplesPerFlush);
 }
 
+int AudioFormatWriter::ThreadedWriter::getNumSamplesBuffered() const noexcept
+{
+    return buffer->getNumSamplesBuffered();
+}
+
+int AudioFormatWriter::ThreadedWriter::getNumOverruns() const noexcept
+{
+    return buffer->getNumOverruns();
+}
+
 } // namespace juce
@@ -179,6 +179,13 @@ public:
     /**
         Provides a FIFO for an AudioFormatWriter, allowing you to push incoming
         data into a buffer which will be flushed to disk by a background thread.
+
+        When many of these share a thread, a slow disk write for one of them holds up
+        all of the others. Creating each AudioFormatWriter with a ThreadedOutputStream
+        moves the disk writes onto a separate thread, so that the encoding can carry on.
+        getNumSamplesBuffered() and getNumOverruns() show whether the thread is keeping up.
+
+        @see ThreadedOutputStream
     */
     class ThreadedWriter
     {
@@ -237,6 +244,18 @@ public:
         */
         void setFlushInterval (int numSamplesPerFlush) noexcept;
 
+        /** Returns the number of samples that are waiting in the FIFO to be written.
+
+            If this keeps growing, the background thread isn't keeping up with the data that's
+            being pushed into the FIFO, and write() will soon start to fail.
+        */
+        int getNumSamplesBuffered() const noexcept;
+
+        /** Returns the number of times that write() has returned false because the FIFO
+            was too full to accept the data.
+        */
+        int getNumOverruns() const noexcept;
+
     private:
         class Buffer;
         std::unique_ptr<Buffer> buffer;
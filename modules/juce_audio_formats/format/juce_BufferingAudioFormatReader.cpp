@@ -30,7 +30,7 @@ BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
                                             TimeSliceThread& timeSliceThread,
                                             int samplesToBuffer)
     : AudioFormatReader (nullptr, sourceReader->getFormatName()),
-      source (sourceReader), thread (timeSliceThread),
+      source (sourceReader), thread (&timeSliceThread),
       numBlocks (1 + (samplesToBuffer / samplesPerBlock))
 {
     sampleRate            = source->sampleRate;
@@ -43,9 +43,37 @@ BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
     timeSliceThread.addTimeSliceClient (this);
 }
 
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            StreamingReadScheduler& schedulerToUse,
+                                            int samplesToBuffer)
+    : AudioFormatReader (nullptr, sourceReader->getFormatName()),
+      source (sourceReader), scheduler (&schedulerToUse),
+      numBlocks (1 + (samplesToBuffer / samplesPerBlock))
+{
+    sampleRate            = source->sampleRate;
+    lengthInSamples       = source->lengthInSamples;
+    numChannels           = source->numChannels;
+    metadataValues        = source->metadataValues;
+    bitsPerSample         = 32;
+    usesFloatingPointData = true;
+
+    const auto bytesPerBlock = sizeof (float) * (size_t) jmax (1u, numChannels) * (size_t) samplesPerBlock;
+    numBlocks = jmax (1, (int) (schedulerToUse.requestMemory (this, (size_t) numBlocks * bytesPerBlock, bytesPerBlock) / bytesPerBlock));
+
+    schedulerToUse.addClient (this);
+}
+
 BufferingAudioReader::~BufferingAudioReader()
 {
-    thread.removeTimeSliceClient (this);
+    if (scheduler != nullptr)
+    {
+        scheduler->removeClient (this);
+        scheduler->releaseMemory (this);
+    }
+    else
+    {
+        thread->removeTimeSliceClient (this);
+    }
 }
 
 void BufferingAudioReader::setReadTimeout (int timeoutMilliseconds) noexcept
@@ -104,6 +132,9 @@ bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChan
             }
             else
             {
+                if (scheduler != nullptr)
+                    scheduler->notify();
+
                 ScopedUnlock ul (lock);
                 Thread::yield();
             }
@@ -131,34 +162,59 @@ BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (i
 
 int BufferingAudioReader::useTimeSlice()
 {
-    return readNextBufferChunk() ? 1 : 100;
+    return readNextBufferChunk (1) ? 1 : 100;
+}
+
+std::optional<double> BufferingAudioReader::getSecondsUntilUnderrun()
+{
+    const auto readPos = nextReadPosition.load();
+    auto pos = (readPos / samplesPerBlock) * samplesPerBlock;
+    auto endPos = jmin (lengthInSamples, pos + numBlocks * samplesPerBlock);
+
+    auto bufferedEnd = readPos;
+
+    while (auto* block = getBlockContaining (bufferedEnd))
+        bufferedEnd = block->range.getEnd();
+
+    if (bufferedEnd >= endPos)
+        return {};
+
+    return (double) (bufferedEnd - readPos) / sampleRate;
+}
+
+bool BufferingAudioReader::readNextChunk (int maxNumSamples)
+{
+    return readNextBufferChunk (jmax (1, maxNumSamples / samplesPerBlock));
 }
 
-bool BufferingAudioReader::readNextBufferChunk()
+bool BufferingAudioReader::readNextBufferChunk (int maxBlocksToRead)
 {
     auto pos = (nextReadPosition.load() / samplesPerBlock) * samplesPerBlock;
     auto endPos = jmin (lengthInSamples, pos + numBlocks * samplesPerBlock);
 
+    auto firstMissing = pos;
+
+    while (firstMissing < endPos && getBlockContaining (firstMissing) != nullptr)
+        firstMissing += samplesPerBlock;
+
+    if (firstMissing >= endPos)
+        return false;
+
+    // Neighbouring missing blocks are read together, as a single longer read
+    auto numToRead = 1;
+
+    while (numToRead < maxBlocksToRead
+            && firstMissing + numToRead * samplesPerBlock < endPos
+            && getBlockContaining (firstMissing + numToRead * samplesPerBlock) == nullptr)
+        ++numToRead;
+
     OwnedArray<BufferedBlock> newBlocks;
 
     for (int i = blocks.size(); --i >= 0;)
         if (blocks.getUnchecked (i)->range.intersects (Range<int64> (pos, endPos)))
             newBlocks.add (blocks.getUnchecked (i));
 
-    if (newBlocks.size() == numBlocks)
-    {
-        newBlocks.clear (false);
-        return false;
-    }
-
-    for (auto p = pos; p < endPos; p += samplesPerBlock)
-    {
-        if (getBlockContaining (p) == nullptr)
-        {
-            newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
-            break; // just do one block
-        }
-    }
+    newBlocks.add (new BufferedBlock (*source, firstMissing, numToRead * samplesPerBlock));
 
     {
         const ScopedLock sl (lock);
@@ -312,6 +368,40 @@ public:
                 expect (source == destination);
             }
         }
+
+        beginTest ("Readers sharing a scheduler should produce the same samples as their sources");
+        {
+            Random random { getRandom() };
+            StreamingReadScheduler scheduler (StreamingReadScheduler::Options{}.withNumberOfThreads (2));
+
+            // Long enough to need several blocks, including some that are read together
+            constexpr auto bufferSize = 200000;
+
+            std::vector<AudioBuffer<float>> sources;
+            std::vector<std::unique_ptr<BufferingAudioReader>> readers;
+
+            for (auto i = 0; i < 4; ++i)
+                sources.push_back (generateTestBuffer (random, bufferSize));
+
+            for (auto& source : sources)
+            {
+                readers.push_back (std::make_unique<BufferingAudioReader> (new TestAudioFormatReader (&source), scheduler, 100000));
+                readers.back()->setReadTimeout (-1);
+            }
+
+            expectEquals (scheduler.getNumClients(), (int) readers.size());
+
+            for (size_t i = 0; i < readers.size(); ++i)
+            {
+                auto destination = generateTestBuffer (random, bufferSize);
+                read (*readers[i], destination);
+                expect (sources[i] == destination);
+            }
+
+            readers.clear();
+            expectEquals (scheduler.getNumClients(), 0);
+            expectEquals (scheduler.getTotalMemoryGranted(), (size_t) 0);
+        }
     }
 
 private:
@@ -36,7 +36,8 @@ namespace juce
     @tags{Audio}
 */
 class JUCE_API  BufferingAudioReader  : public AudioFormatReader,
-                                        private TimeSliceClient
+                                        private TimeSliceClient,
+                                        private StreamingReadScheduler::Client
 {
 public:
     /** Creates a reader.
@@ -53,6 +54,23 @@ public:
                           TimeSliceThread& timeSliceThread,
                           int samplesToBuffer);
 
+    /** Creates a reader that shares a StreamingReadScheduler with other streaming readers.
+
+        The scheduler will read for whichever of its readers is closest to running out of
+        audio, and the amount buffered may be reduced to fit into the scheduler's memory budget.
+
+        @param sourceReader     the source reader to wrap. This BufferingAudioReader
+                                takes ownership of this object and will delete it later
+                                when no longer needed
+        @param scheduler        the scheduler that should be used to do the background reading.
+                                Make sure that it won't be deleted while the reader object
+                                still exists.
+        @param samplesToBuffer  the total number of samples to buffer ahead.
+    */
+    BufferingAudioReader (AudioFormatReader* sourceReader,
+                          StreamingReadScheduler& scheduler,
+                          int samplesToBuffer);
+
     ~BufferingAudioReader() override;
 
     /** Sets a number of milliseconds that the reader can block for in its readSamples()
@@ -78,14 +96,18 @@ private:
 
     int useTimeSlice() override;
     BufferedBlock* getBlockContaining (int64 pos) const noexcept;
-    bool readNextBufferChunk();
+    bool readNextBufferChunk (int maxBlocksToRead);
+
+    std::optional<double> getSecondsUntilUnderrun() override;
+    bool readNextChunk (int maxNumSamples) override;
 
     static constexpr int samplesPerBlock = 32768;
 
     std::unique_ptr<AudioFormatReader> source;
-    TimeSliceThread& thread;
+    TimeSliceThread* thread = nullptr;
+    StreamingReadScheduler* scheduler = nullptr;
     std::atomic<int64> nextReadPosition { 0 };
-    const int numBlocks;
+    int numBlocks;
     int timeoutMs = 0;
 
     CriticalSection lock;
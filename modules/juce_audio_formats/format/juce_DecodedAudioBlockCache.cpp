@@ -0,0 +1,332 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class DecodedAudioBlockCache::CachingReader final : public AudioFormatReader
+{
+public:
+    CachingReader (DecodedAudioBlockCache& cacheIn, std::unique_ptr<AudioFormatReader> sourceIn, const String& identifier)
+        : AudioFormatReader (nullptr, sourceIn->getFormatName()),
+          cache (cacheIn),
+          source (std::move (sourceIn)),
+          sourceIdentifier (identifier)
+    {
+        sampleRate            = source->sampleRate;
+        lengthInSamples       = source->lengthInSamples;
+        numChannels           = source->numChannels;
+        metadataValues        = source->metadataValues;
+        bitsPerSample         = 32;
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                           startSampleInFile, numSamples, lengthInSamples);
+
+        const auto blockSize = cache.getSamplesPerBlock();
+        bool allSamplesRead = true;
+
+        while (numSamples > 0)
+        {
+            const auto blockIndex = startSampleInFile / blockSize;
+            const auto block = getOrDecodeBlock (blockIndex, allSamplesRead);
+
+            const auto offset = (int) (startSampleInFile - blockIndex * blockSize);
+            const auto numToDo = jmin (numSamples, blockSize - offset);
+
+            for (int j = 0; j < numDestChannels; ++j)
+            {
+                if (auto* dest = reinterpret_cast<float*> (destSamples[j]))
+                {
+                    dest += startOffsetInDestBuffer;
+
+                    if (j < block->getNumChannels())
+                        FloatVectorOperations::copy (dest, block->getReadPointer (j, offset), numToDo);
+                    else
+                        FloatVectorOperations::clear (dest, numToDo);
+                }
+            }
+
+            startOffsetInDestBuffer += numToDo;
+            startSampleInFile += numToDo;
+            numSamples -= numToDo;
+        }
+
+        return allSamplesRead;
+    }
+
+private:
+    Block getOrDecodeBlock (int64 blockIndex, bool& allSamplesRead)
+    {
+        const BlockKey key { sourceIdentifier, blockIndex };
+
+        if (auto block = cache.getBlock (key))
+            return block;
+
+        // Two readers might both decode a block that neither found in the cache, but that's
+        // much cheaper than making one of them wait for the other
+        const auto blockSize = cache.getSamplesPerBlock();
+        auto decoded = std::make_shared<AudioBuffer<float>> ((int) numChannels, blockSize);
+
+        if (! source->read (decoded.get(), 0, blockSize, blockIndex * blockSize, true, true))
+        {
+            allSamplesRead = false;
+            return decoded;
+        }
+
+        cache.addBlock (key, decoded);
+        return decoded;
+    }
+
+    DecodedAudioBlockCache& cache;
+    std::unique_ptr<AudioFormatReader> source;
+    const String sourceIdentifier;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachingReader)
+};
+
+//==============================================================================
+DecodedAudioBlockCache::DecodedAudioBlockCache (size_t maximumSizeBytes, int samplesPerBlockToUse)
+    : samplesPerBlock (jmax (256, samplesPerBlockToUse)),
+      maximumSize (maximumSizeBytes)
+{
+}
+
+DecodedAudioBlockCache::~DecodedAudioBlockCache() = default;
+
+std::unique_ptr<AudioFormatReader> DecodedAudioBlockCache::createReaderFor (AudioFormat& format, const File& file)
+{
+    if (auto stream = file.createInputStream())
+        if (auto* reader = format.createReaderFor (stream.release(), true))
+            return createReaderFor (std::unique_ptr<AudioFormatReader> (reader), file.getFullPathName());
+
+    return {};
+}
+
+std::unique_ptr<AudioFormatReader> DecodedAudioBlockCache::createReaderFor (std::unique_ptr<AudioFormatReader> source,
+                                                                            const String& sourceIdentifier)
+{
+    if (source == nullptr)
+        return {};
+
+    return std::make_unique<CachingReader> (*this, std::move (source), sourceIdentifier);
+}
+
+//==============================================================================
+void DecodedAudioBlockCache::setMaximumSize (size_t newMaximumSizeBytes)
+{
+    const ScopedLock sl (lock);
+    maximumSize = newMaximumSizeBytes;
+    removeLeastRecentlyUsedBlocks();
+}
+
+size_t DecodedAudioBlockCache::getMaximumSize() const
+{
+    const ScopedLock sl (lock);
+    return maximumSize;
+}
+
+size_t DecodedAudioBlockCache::getCurrentSize() const
+{
+    const ScopedLock sl (lock);
+    return currentSize;
+}
+
+void DecodedAudioBlockCache::clear()
+{
+    const ScopedLock sl (lock);
+    index.clear();
+    blocks.clear();
+    currentSize = 0;
+}
+
+DecodedAudioBlockCache::Block DecodedAudioBlockCache::getBlock (const BlockKey& key)
+{
+    const ScopedLock sl (lock);
+
+    const auto found = index.find (key);
+
+    if (found == index.end())
+    {
+        ++numMisses;
+        return {};
+    }
+
+    // Move the block to the front of the list, as it's now the most recently used
+    blocks.splice (blocks.begin(), blocks, found->second);
+    ++numHits;
+    return found->second->second;
+}
+
+void DecodedAudioBlockCache::addBlock (const BlockKey& key, Block block)
+{
+    const ScopedLock sl (lock);
+
+    if (index.find (key) != index.end())
+        return;
+
+    currentSize += getSizeInBytes (*block);
+    blocks.emplace_front (key, std::move (block));
+    index[key] = blocks.begin();
+
+    removeLeastRecentlyUsedBlocks();
+}
+
+void DecodedAudioBlockCache::removeLeastRecentlyUsedBlocks()
+{
+    while (currentSize > maximumSize && ! blocks.empty())
+    {
+        currentSize -= getSizeInBytes (*blocks.back().second);
+        index.erase (blocks.back().first);
+        blocks.pop_back();
+    }
+}
+
+size_t DecodedAudioBlockCache::getSizeInBytes (const AudioBuffer<float>& buffer) noexcept
+{
+    return sizeof (float) * (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class DecodedAudioBlockCacheTests final : public UnitTest
+{
+public:
+    DecodedAudioBlockCacheTests()  : UnitTest ("DecodedAudioBlockCache", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr auto blockSize = 1024;
+
+        beginTest ("Readers sharing a cache produce the same samples as their source");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 10 * blockSize + 100);
+            DecodedAudioBlockCache cache (1 << 24, blockSize);
+
+            auto first  = cache.createReaderFor (std::make_unique<TestAudioFormatReader> (&source), "test");
+            auto second = cache.createReaderFor (std::make_unique<TestAudioFormatReader> (&source), "test");
+
+            expectEquals (first->lengthInSamples, (int64) source.getNumSamples());
+
+            for (auto* reader : { first.get(), second.get() })
+            {
+                AudioBuffer<float> destination (2, source.getNumSamples());
+
+                // Read in chunks that don't line up with the blocks
+                for (int start = 0; start < source.getNumSamples(); start += 700)
+                    reader->read (&destination, start, jmin (700, source.getNumSamples() - start), start, true, true);
+
+                expect (destination == source);
+            }
+
+            expectEquals (cache.getNumMisses(), (int64) 11);
+            expectEquals (cache.getCurrentSize(), (size_t) 11 * 2 * blockSize * sizeof (float));
+            expect (cache.getNumHits() > cache.getNumMisses());
+        }
+
+        beginTest ("The cache doesn't grow beyond its maximum size");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 10 * blockSize);
+            const auto blockBytes = (size_t) 2 * blockSize * sizeof (float);
+            DecodedAudioBlockCache cache (3 * blockBytes, blockSize);
+
+            auto reader = cache.createReaderFor (std::make_unique<TestAudioFormatReader> (&source), "test");
+            AudioBuffer<float> destination (2, source.getNumSamples());
+            reader->read (&destination, 0, source.getNumSamples(), 0, true, true);
+
+            expect (destination == source);
+            expectEquals (cache.getCurrentSize(), 3 * blockBytes);
+
+            // The most recently used blocks should still be there
+            reader->read (&destination, 0, blockSize, 9 * blockSize, true, true);
+            expectEquals (cache.getNumMisses(), (int64) 10);
+
+            cache.setMaximumSize (blockBytes);
+            expectEquals (cache.getCurrentSize(), blockBytes);
+
+            cache.clear();
+            expectEquals (cache.getCurrentSize(), (size_t) 0);
+        }
+
+       #if JUCE_USE_FLAC
+        beginTest ("FLAC readers sharing a cache only decode each block once");
+        {
+            Random random { getRandom() };
+            constexpr auto length = 20000;
+            AudioBuffer<float> source (2, length);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < length; ++i)
+                    source.setSample (channel, i, (float) std::sin (i * 0.01 * (channel + 1)) * 0.5f);
+
+            MemoryBlock encoded;
+            FlacAudioFormat flac;
+
+            {
+                std::unique_ptr<AudioFormatWriter> writer (flac.createWriterFor (new MemoryOutputStream (encoded, false),
+                                                                                 44100.0, 2, 24, {}, 0));
+                expect (writer != nullptr);
+                writer->writeFromAudioSampleBuffer (source, 0, length);
+            }
+
+            DecodedAudioBlockCache cache (1 << 24, blockSize);
+            std::vector<std::unique_ptr<AudioFormatReader>> readers;
+
+            for (int i = 0; i < 4; ++i)
+                readers.push_back (cache.createReaderFor (std::unique_ptr<AudioFormatReader> (flac.createReaderFor (new MemoryInputStream (encoded, false), true)),
+                                                          "encoded"));
+
+            for (auto& reader : readers)
+            {
+                AudioBuffer<float> destination (2, length);
+                reader->read (&destination, 0, length, 0, true, true);
+
+                auto maxError = 0.0f;
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < length; ++i)
+                        maxError = jmax (maxError, std::abs (destination.getSample (channel, i) - source.getSample (channel, i)));
+
+                expect (maxError < 1.0e-6f);
+            }
+
+            expectEquals (cache.getNumMisses(), (int64) ((length + blockSize - 1) / blockSize));
+        }
+       #endif
+    }
+};
+
+static DecodedAudioBlockCacheTests decodedAudioBlockCacheTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A size-bounded cache of decoded audio, which can be shared between many readers
+    of the same files.
+
+    Compressed formats such as FLAC and Ogg-Vorbis can't be memory-mapped, so each
+    reader has to decode the audio for itself. When several readers use the same file,
+    for example when many voices of a sampler play the same zone, this means the same
+    audio gets decoded many times over. Readers created with createReaderFor() store each
+    block of audio that they decode in this cache, keyed by the file and the block index,
+    and readers of the same file will use the cached block instead of decoding it again.
+
+    @code
+    DecodedAudioBlockCache cache (64 * 1024 * 1024);
+    FlacAudioFormat flac;
+
+    auto reader = cache.createReaderFor (flac, file);
+    @endcode
+
+    When the cache grows beyond its maximum size, the blocks that were used least
+    recently are removed. Readers that are still using a removed block will keep it
+    alive until they've finished with it. All the methods of this class are thread-safe.
+
+    @see AudioFormatReader, FlacAudioFormat, OggVorbisAudioFormat
+
+    @tags{Audio}
+*/
+class JUCE_API  DecodedAudioBlockCache
+{
+public:
+    //==============================================================================
+    /** Creates a cache.
+
+        @param maximumSizeBytes     the maximum amount of decoded audio to keep, in bytes
+        @param samplesPerBlock      the number of samples in each block that is decoded
+                                    and stored
+    */
+    explicit DecodedAudioBlockCache (size_t maximumSizeBytes, int samplesPerBlock = 16384);
+
+    /** Destructor. Any readers that are using this cache must be deleted first. */
+    ~DecodedAudioBlockCache();
+
+    //==============================================================================
+    /** Creates a reader for a file that uses this cache.
+
+        This uses the format to create a reader that decodes the file, and wraps it in a
+        reader that fetches blocks from the cache, only decoding the ones that aren't
+        already there. Returns nullptr if the format can't open the file.
+    */
+    std::unique_ptr<AudioFormatReader> createReaderFor (AudioFormat& format, const File& file);
+
+    /** Wraps an existing reader so that it uses this cache.
+
+        The identifier must be unique to the audio that the source reader produces, as any
+        other readers created with the same identifier will share its decoded blocks.
+    */
+    std::unique_ptr<AudioFormatReader> createReaderFor (std::unique_ptr<AudioFormatReader> source,
+                                                        const String& sourceIdentifier);
+
+    //==============================================================================
+    /** Changes the maximum size of the cache, removing blocks if necessary. */
+    void setMaximumSize (size_t newMaximumSizeBytes);
+
+    /** Returns the maximum size of the cache, in bytes. */
+    size_t getMaximumSize() const;
+
+    /** Returns the amount of decoded audio that's currently in the cache, in bytes. */
+    size_t getCurrentSize() const;
+
+    /** Returns the number of samples in each block. */
+    int getSamplesPerBlock() const noexcept                 { return samplesPerBlock; }
+
+    /** Returns the number of times a reader found a block in the cache. */
+    int64 getNumHits() const noexcept                       { return numHits; }
+
+    /** Returns the number of times a reader had to decode a block itself. */
+    int64 getNumMisses() const noexcept                     { return numMisses; }
+
+    /** Removes all the blocks from the cache. */
+    void clear();
+
+private:
+    //==============================================================================
+    class CachingReader;
+
+    struct BlockKey
+    {
+        String sourceIdentifier;
+        int64 blockIndex;
+
+        bool operator< (const BlockKey& other) const
+        {
+            return std::tie (blockIndex, sourceIdentifier) < std::tie (other.blockIndex, other.sourceIdentifier);
+        }
+    };
+
+    using Block = std::shared_ptr<const AudioBuffer<float>>;
+
+    Block getBlock (const BlockKey& key);
+    void addBlock (const BlockKey& key, Block block);
+    void removeLeastRecentlyUsedBlocks();
+
+    static size_t getSizeInBytes (const AudioBuffer<float>&) noexcept;
+
+    const int samplesPerBlock;
+
+    CriticalSection lock;
+    size_t maximumSize, currentSize = 0;
+    std::list<std::pair<BlockKey, Block>> blocks;
+    std::map<BlockKey, decltype (blocks)::iterator> index;
+    std::atomic<int64> numHits { 0 }, numMisses { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DecodedAudioBlockCache)
+};
+
+} // namespace juce
@@ -0,0 +1,365 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ParallelAudioReader::Readers
+{
+    explicit Readers (ReaderFactory f)  : factory (std::move (f)) {}
+
+    /*  If the factory has stopped creating readers, this either waits for one of the existing
+        readers to be released, or returns nullptr straight away if shouldWait is false.
+    */
+    std::unique_ptr<AudioFormatReader> acquire (bool shouldWait)
+    {
+        for (;;)
+        {
+            bool shouldCreate = false;
+
+            {
+                const ScopedLock sl (lock);
+
+                if (! idle.empty())
+                {
+                    auto reader = std::move (idle.back());
+                    idle.pop_back();
+                    return reader;
+                }
+
+                shouldCreate = (numCreated == 0 || ! factoryExhausted);
+            }
+
+            if (shouldCreate)
+            {
+                auto reader = factory != nullptr ? factory() : nullptr;
+
+                const ScopedLock sl (lock);
+
+                if (reader != nullptr)
+                {
+                    ++numCreated;
+                    return reader;
+                }
+
+                factoryExhausted = true;
+
+                if (numCreated == 0)
+                    return nullptr;
+            }
+
+            if (! shouldWait)
+                return nullptr;
+
+            // The factory won't create any more readers, so wait for one of the others to be released
+            readerReleased.wait (10);
+        }
+    }
+
+    bool isLimited() const
+    {
+        const ScopedLock sl (lock);
+        return factoryExhausted && numCreated > 0;
+    }
+
+    void release (std::unique_ptr<AudioFormatReader> reader)
+    {
+        if (reader == nullptr)
+            return;
+
+        {
+            const ScopedLock sl (lock);
+            idle.push_back (std::move (reader));
+        }
+
+        readerReleased.signal();
+    }
+
+    const ReaderFactory factory;
+    CriticalSection lock;
+    std::vector<std::unique_ptr<AudioFormatReader>> idle;
+    int numCreated = 0;
+    bool factoryExhausted = false;
+    WaitableEvent readerReleased;
+};
+
+//==============================================================================
+/*  The state of a single call to read(). Pool jobs keep this alive, so a job that only
+    starts after read() has returned will find no chunks left and exit without touching
+    the destination buffer.
+*/
+struct ParallelAudioReader::ReadState
+{
+    bool claimAndReadChunk (Readers& readers, bool isCallingThread)
+    {
+        if (nextChunk.load() >= numChunks)
+            return false;
+
+        auto reader = readers.acquire (isCallingThread);
+
+        // All the readers are busy, so leave the remaining chunks to the threads that have them
+        if (reader == nullptr && ! isCallingThread && readers.isLimited())
+            return false;
+
+        const auto chunk = nextChunk.fetch_add (1);
+
+        if (chunk >= numChunks)
+        {
+            readers.release (std::move (reader));
+            return false;
+        }
+
+        const auto offset = chunk * samplesPerChunk;
+        const auto numToRead = jmin (samplesPerChunk, numSamples - offset);
+
+        std::vector<int*> channels;
+        channels.reserve (destChannels.size());
+
+        for (auto* d : destChannels)
+            channels.push_back (reinterpret_cast<int*> (d + offset));
+
+        if (reader == nullptr
+             || ! reader->read (channels.data(), (int) channels.size(), sourceStart + offset, numToRead, true))
+        {
+            failed = true;
+        }
+        else if (! reader->usesFloatingPointData)
+        {
+            for (auto* d : channels)
+                FloatVectorOperations::convertFixedToFloat (reinterpret_cast<float*> (d), d,
+                                                            1.0f / static_cast<float> (0x7fffffff), numToRead);
+        }
+
+        readers.release (std::move (reader));
+
+        if (numCompleted.fetch_add (1) + 1 == numChunks)
+            finished.signal();
+
+        return true;
+    }
+
+    std::vector<float*> destChannels;
+    int64 sourceStart = 0;
+    int numSamples = 0, samplesPerChunk = 0, numChunks = 0;
+
+    std::atomic<int> nextChunk { 0 }, numCompleted { 0 };
+    std::atomic<bool> failed { false };
+    WaitableEvent finished;
+};
+
+//==============================================================================
+ParallelAudioReader::ParallelAudioReader (ReaderFactory createReader, ThreadPool& threadPool, int chunkSize)
+    : readers (std::make_shared<Readers> (std::move (createReader))),
+      pool (threadPool),
+      samplesPerChunk (jmax (1024, chunkSize))
+{
+    if (auto reader = readers->acquire (true))
+    {
+        numChannels = reader->numChannels;
+        lengthInSamples = reader->lengthInSamples;
+        sampleRate = reader->sampleRate;
+        readers->release (std::move (reader));
+    }
+}
+
+ParallelAudioReader::~ParallelAudioReader() = default;
+
+ParallelAudioReader::ReaderFactory ParallelAudioReader::createReaderFactory (AudioFormatManager& formatManager, const File& file)
+{
+    return [&formatManager, file]() -> std::unique_ptr<AudioFormatReader>
+    {
+        if (auto* format = formatManager.findFormatForFileExtension (file.getFileExtension()))
+        {
+            if (std::unique_ptr<MemoryMappedAudioFormatReader> mapped { format->createMemoryMappedReader (file) })
+                if (mapped->mapEntireFile())
+                    return mapped;
+        }
+
+        return std::unique_ptr<AudioFormatReader> (formatManager.createReaderFor (file));
+    };
+}
+
+bool ParallelAudioReader::read (AudioBuffer<float>& destination, int destStartSample, int numSamples, int64 sourceStartSample)
+{
+    jassert (destStartSample >= 0 && destStartSample + numSamples <= destination.getNumSamples());
+
+    if (numSamples <= 0 || destination.getNumChannels() == 0)
+        return true;
+
+    if (! isValid())
+        return false;
+
+    auto state = std::make_shared<ReadState>();
+
+    // Taking the pointers here, on the calling thread, means that the jobs don't touch the
+    // buffer object itself
+    for (int i = 0; i < destination.getNumChannels(); ++i)
+        state->destChannels.push_back (destination.getWritePointer (i, destStartSample));
+
+    state->sourceStart = sourceStartSample;
+    state->numSamples = numSamples;
+    state->samplesPerChunk = samplesPerChunk;
+    state->numChunks = (numSamples + samplesPerChunk - 1) / samplesPerChunk;
+
+    const auto numJobs = jmin (state->numChunks - 1, pool.getNumThreads());
+
+    for (int i = 0; i < numJobs; ++i)
+    {
+        pool.addJob ([state, r = readers]
+        {
+            while (state->claimAndReadChunk (*r, false))
+            {}
+        });
+    }
+
+    while (state->claimAndReadChunk (*readers, true))
+    {}
+
+    state->finished.wait (-1);
+    return ! state->failed;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParallelAudioReaderTests final : public UnitTest
+{
+public:
+    ParallelAudioReaderTests()  : UnitTest ("ParallelAudioReader", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        ThreadPool pool (ThreadPoolOptions{}.withNumberOfThreads (3));
+        Random random { getRandom() };
+
+        beginTest ("A parallel read matches the source");
+        {
+            const auto source = generateTestBuffer (random, 20000);
+            std::atomic<int> numReadersCreated { 0 };
+
+            ParallelAudioReader reader ([&]
+                                        {
+                                            ++numReadersCreated;
+                                            return std::make_unique<TestAudioFormatReader> (&source);
+                                        },
+                                        pool, 1024);
+
+            expectEquals (reader.getLengthInSamples(), (int64) source.getNumSamples());
+            expectEquals ((int) reader.getNumChannels(), source.getNumChannels());
+
+            AudioBuffer<float> destination (2, source.getNumSamples());
+            expect (reader.read (destination, 0, destination.getNumSamples(), 0));
+            expect (destination == source);
+
+            // One reader per thread at most, including the calling thread
+            expect (numReadersCreated <= pool.getNumThreads() + 1);
+        }
+
+        beginTest ("Partial reads are offset, padded with silence, and fill extra channels");
+        {
+            const auto source = generateTestBuffer (random, 5000);
+            ParallelAudioReader reader ([&] { return std::make_unique<TestAudioFormatReader> (&source); }, pool, 1024);
+
+            AudioBuffer<float> destination (3, 4000);
+            destination.clear();
+            expect (reader.read (destination, 100, 3900, 3000));
+
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                const auto sourceChannel = jmin (channel, 1);
+
+                expect (destination.findMinMax (channel, 0, 100) == Range<float>{});
+                expect (std::equal (destination.getReadPointer (channel, 100), destination.getReadPointer (channel, 2100),
+                                    source.getReadPointer (sourceChannel, 3000)));
+                expect (destination.findMinMax (channel, 2100, 1900) == Range<float>{});
+            }
+        }
+
+       #if JUCE_USE_FLAC
+        beginTest ("A parallel FLAC read matches a serial read");
+        {
+            constexpr auto numSamples = 100000;
+            const auto source = generateTestBuffer (random, numSamples);
+            MemoryBlock flacData;
+
+            {
+                FlacAudioFormat format;
+                std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (flacData, false),
+                                                                                   44100.0, 2, 16, {}, 0));
+                expect (writer != nullptr);
+                writer->writeFromAudioSampleBuffer (source, 0, numSamples);
+            }
+
+            auto createFlacReader = [&flacData]
+            {
+                return std::unique_ptr<AudioFormatReader> (FlacAudioFormat().createReaderFor (new MemoryInputStream (flacData, false), true));
+            };
+
+            AudioBuffer<float> serial (2, numSamples);
+            createFlacReader()->read (&serial, 0, numSamples, 0, true, true);
+
+            ParallelAudioReader reader (createFlacReader, pool, 4096);
+            AudioBuffer<float> parallel (2, numSamples);
+            expect (reader.read (parallel, 0, numSamples, 0));
+            expect (parallel == serial);
+        }
+       #endif
+
+        beginTest ("A factory can limit the number of readers");
+        {
+            const auto source = generateTestBuffer (random, 20000);
+            std::atomic<int> numReadersCreated { 0 };
+
+            ParallelAudioReader reader ([&]() -> std::unique_ptr<AudioFormatReader>
+                                        {
+                                            if (numReadersCreated.fetch_add (1) >= 2)
+                                                return nullptr;
+
+                                            return std::make_unique<TestAudioFormatReader> (&source);
+                                        },
+                                        pool, 1024);
+
+            AudioBuffer<float> destination (2, source.getNumSamples());
+            expect (reader.read (destination, 0, destination.getNumSamples(), 0));
+            expect (destination == source);
+        }
+
+        beginTest ("Reading fails if no reader can be created");
+        {
+            ParallelAudioReader reader ([] { return std::unique_ptr<AudioFormatReader>(); }, pool);
+            expect (! reader.isValid());
+
+            AudioBuffer<float> destination (2, 100);
+            expect (! reader.read (destination, 0, 100, 0));
+        }
+    }
+};
+
+static ParallelAudioReaderTests parallelAudioReaderTests;
+
+#endif
+
+} // namespace juce
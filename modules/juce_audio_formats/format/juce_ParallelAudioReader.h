@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads long ranges of audio by decoding several chunks at once on a ThreadPool.
+
+    An AudioFormatReader can only be used by one thread at a time, so this class uses
+    a function that creates readers for the same audio, and keeps a reader for each
+    thread that takes part. The range to be read is split into chunks, and each chunk
+    is decoded straight into its part of the destination buffer.
+
+    This is useful for offline tasks such as loudness analysis or format conversion,
+    where decoding a whole file on one thread is the bottleneck. It only gives correct
+    results for formats where reading from any position produces exactly the same
+    samples as reading through from the start, such as WAV, AIFF and FLAC. Formats
+    that need to prime their decoder after a seek, such as MP3, may produce small
+    differences at the chunk boundaries.
+
+    @code
+    ThreadPool pool;
+    ParallelAudioReader reader (ParallelAudioReader::createReaderFactory (formatManager, file), pool);
+
+    AudioBuffer<float> buffer ((int) reader.getNumChannels(), (int) reader.getLengthInSamples());
+    reader.read (buffer, 0, buffer.getNumSamples(), 0);
+    @endcode
+
+    @see AudioFormatReader, ThreadPool
+
+    @tags{Audio}
+*/
+class JUCE_API  ParallelAudioReader
+{
+public:
+    /** A function that creates a new reader of the audio each time it's called, or
+        returns nullptr if it can't.
+
+        If it returns nullptr after it has already created at least one reader, that isn't
+        treated as an error. Instead, the pool's threads stop helping with a read while all
+        the readers are busy, and the thread that called read() waits for one of them, so a
+        factory can use this to limit the number of readers.
+    */
+    using ReaderFactory = std::function<std::unique_ptr<AudioFormatReader>()>;
+
+    //==============================================================================
+    /** Creates a ParallelAudioReader.
+
+        @param createReader     a function that creates readers for the audio. This may be
+                                called from any thread
+        @param threadPool       the pool to decode on. This must outlive this object, and
+                                won't be waited on if it's busy, as the calling thread
+                                decodes chunks too
+        @param samplesPerChunk  the number of samples that each job decodes
+    */
+    ParallelAudioReader (ReaderFactory createReader, ThreadPool& threadPool, int samplesPerChunk = 65536);
+
+    /** Destructor. */
+    ~ParallelAudioReader();
+
+    /** Returns a factory that uses an AudioFormatManager to open a file.
+
+        Memory-mapped readers are created where the format supports them, so each reader
+        shares the operating system's cached pages of the file instead of reading it
+        separately.
+    */
+    static ReaderFactory createReaderFactory (AudioFormatManager& formatManager, const File& file);
+
+    //==============================================================================
+    /** Returns false if the factory couldn't create a reader. */
+    bool isValid() const noexcept                   { return lengthInSamples >= 0; }
+
+    /** Returns the number of channels in the audio. */
+    unsigned int getNumChannels() const noexcept    { return numChannels; }
+
+    /** Returns the length of the audio, in samples. */
+    int64 getLengthInSamples() const noexcept       { return lengthInSamples; }
+
+    /** Returns the sample rate of the audio. */
+    double getSampleRate() const noexcept           { return sampleRate; }
+
+    //==============================================================================
+    /** Reads a range of audio into a buffer, using the thread pool, and returns when all of
+        it has been read.
+
+        As with AudioFormatReader::read(), channels of the buffer that the source doesn't
+        have are filled with copies of the last channel that it does have, and samples beyond
+        the end of the source are set to zero.
+
+        @returns false if any of the chunks couldn't be read
+    */
+    bool read (AudioBuffer<float>& destination, int destStartSample, int numSamples, int64 sourceStartSample);
+
+private:
+    //==============================================================================
+    struct Readers;
+    struct ReadState;
+
+    std::shared_ptr<Readers> readers;
+    ThreadPool& pool;
+    const int samplesPerChunk;
+
+    unsigned int numChannels = 0;
+    int64 lengthInSamples = -1;
+    double sampleRate = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelAudioReader)
+};
+
+} // namespace juce
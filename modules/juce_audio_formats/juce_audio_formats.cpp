@@ -59,6 +59,8 @@
 #include "format/juce_AudioFormatWriter.cpp"
 #include "format/juce_AudioSubsectionReader.cpp"
 #include "format/juce_BufferingAudioFormatReader.cpp"
+#include "format/juce_DecodedAudioBlockCache.cpp"
+#include "format/juce_ParallelAudioReader.cpp"
 #include "sampler/juce_Sampler.cpp"
 #include "codecs/juce_AiffAudioFormat.cpp"
 #include "codecs/juce_CoreAudioFormat.cpp"
@@ -71,6 +73,7 @@
 #if JucePlugin_Enable_ARA
  #include "juce_audio_processors/utilities/ARA/juce_ARADocumentControllerCommon.cpp"
  #include "format/juce_ARAAudioReaders.cpp"
+ #include "format/juce_ARAAudioSourceAnalysisScheduler.cpp"
 #endif
 
 #if JUCE_WINDOWS && JUCE_USE_WINDOWS_MEDIA_FORMAT
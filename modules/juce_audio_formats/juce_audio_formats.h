@@ -119,6 +119,8 @@
 #include "format/juce_AudioFormatReaderSource.h"
 #include "format/juce_AudioSubsectionReader.h"
 #include "format/juce_BufferingAudioFormatReader.h"
+#include "format/juce_DecodedAudioBlockCache.h"
+#include "format/juce_ParallelAudioReader.h"
 #include "codecs/juce_AiffAudioFormat.h"
 #include "codecs/juce_CoreAudioFormat.h"
 #include "codecs/juce_FlacAudioFormat.h"
@@ -133,4 +135,5 @@
  #include <juce_audio_processors/juce_audio_processors.h>
 
  #include "format/juce_ARAAudioReaders.h"
+ #include "format/juce_ARAAudioSourceAnalysisScheduler.h"
 #endif
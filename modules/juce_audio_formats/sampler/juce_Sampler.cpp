@@ -50,6 +50,42 @@ SamplerSound::SamplerSound (const String& soundName,
         params.attack  = static_cast<float> (attackTimeSecs);
         params.release = static_cast<float> (releaseTimeSecs);
     }
+
+    preloadedLength = length;
+}
+
+SamplerSound::SamplerSound (const String& soundName,
+                            std::unique_ptr<AudioFormatReader> source,
+                            const BigInteger& notes,
+                            int midiNoteForNormalPitch,
+                            double attackTimeSecs,
+                            double releaseTimeSecs,
+                            double preloadTimeSecs)
+    : name (soundName),
+      sourceSampleRate (source != nullptr ? source->sampleRate : 0.0),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    jassert (source != nullptr);
+
+    if (source != nullptr && sourceSampleRate > 0 && source->lengthInSamples > 0)
+    {
+        if (auto* memoryMappedReader = dynamic_cast<MemoryMappedAudioFormatReader*> (source.get()))
+            memoryMappedReader->mapEntireFile();
+
+        length = (int) jmin (source->lengthInSamples, (int64) std::numeric_limits<int>::max() - 4);
+        preloadedLength = jlimit (0, length, (int) (preloadTimeSecs * sourceSampleRate));
+
+        data.reset (new AudioBuffer<float> (jmin (2, (int) source->numChannels), preloadedLength + 4));
+
+        source->read (data.get(), 0, preloadedLength + 4, 0, true, true);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+
+        if (preloadedLength < length)
+            reader = std::move (source);
+    }
 }
 
 SamplerSound::~SamplerSound()
@@ -66,13 +102,185 @@ bool SamplerSound::appliesToChannel (int /*midiChannel*/)
     return true;
 }
 
+//==============================================================================
+/*  Reads ahead from a streaming SamplerSound into a ring buffer, on a TimeSliceThread.
+
+    The audio thread tells the streamer which sound to read with start() and stop(), each
+    of which starts a new "generation". The streamer publishes how far it has filled the
+    ring buffer, tagged with the generation that it was filling it for, so that the voice
+    never reads audio that was streamed for a previous note.
+*/
+class SamplerVoice::Streamer final : private TimeSliceClient
+{
+public:
+    Streamer (TimeSliceThread& threadToUse, int ringBufferSize)
+        : thread (threadToUse),
+          ring (2, jmax (ringBufferSize, 256)),
+          scratch (2, jmin (4096, ring.getNumSamples() / 4))
+    {
+        thread.addTimeSliceClient (this);
+    }
+
+    ~Streamer() override
+    {
+        thread.removeTimeSliceClient (this);
+    }
+
+    //==============================================================================
+    // These are called on the audio thread
+    void start (SamplerSound* sound)
+    {
+        readPosition.store (sound->preloadedLength);
+        setPendingSound (sound);
+    }
+
+    void stop()
+    {
+        setPendingSound (nullptr);
+    }
+
+    /** Returns the end of the range of samples that are ready in the ring buffer. */
+    int64 getAvailableEnd (const SamplerSound& sound) const noexcept
+    {
+        const auto packed = state.load (std::memory_order_acquire);
+
+        if ((uint16) (packed >> positionBits) != generation)
+            return sound.preloadedLength;
+
+        return (int64) (packed & positionMask);
+    }
+
+    void setReadPosition (int64 position) noexcept
+    {
+        readPosition.store (position, std::memory_order_release);
+    }
+
+    const float* getRingData (int channel) const noexcept    { return ring.getReadPointer (channel); }
+    int getRingSize() const noexcept                         { return ring.getNumSamples(); }
+
+private:
+    //==============================================================================
+    static constexpr int positionBits = 48;
+    static constexpr uint64 positionMask = (((uint64) 1) << positionBits) - 1;
+
+    void setPendingSound (SamplerSound* sound)
+    {
+        ReferenceCountedObjectPtr<SamplerSound> previous (sound);
+
+        {
+            const SpinLock::ScopedLockType sl (lock);
+            std::swap (previous, pendingSound);
+            pendingGeneration = ++generation;
+        }
+    }
+
+    int useTimeSlice() override
+    {
+        ReferenceCountedObjectPtr<SamplerSound> newSound;
+        bool changed = false;
+
+        {
+            const SpinLock::ScopedLockType sl (lock);
+
+            if (activeGeneration != pendingGeneration)
+            {
+                activeGeneration = pendingGeneration;
+                newSound = pendingSound;
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            std::swap (activeSound, newSound);
+            writePosition = activeSound != nullptr ? activeSound->preloadedLength : 0;
+        }
+
+        if (activeSound == nullptr)
+            return 20;
+
+        // The voice interpolates between neighbouring samples, so it reads slightly past the end
+        const auto endPosition = (int64) activeSound->length + 2;
+        const auto space = readPosition.load (std::memory_order_acquire) + ring.getNumSamples() - writePosition;
+        const auto numToRead = (int) jmin ((int64) scratch.getNumSamples(), space, endPosition - writePosition);
+
+        if (numToRead <= 0)
+            return writePosition >= endPosition ? 20 : 2;
+
+        {
+            const ScopedLock sl (activeSound->readerLock);
+            activeSound->reader->read (&scratch, 0, numToRead, writePosition, true, true);
+        }
+
+        const auto ringSize = ring.getNumSamples();
+        const auto ringStart = (int) (writePosition % ringSize);
+        const auto numBeforeWrap = jmin (numToRead, ringSize - ringStart);
+
+        for (int channel = 0; channel < ring.getNumChannels(); ++channel)
+        {
+            ring.copyFrom (channel, ringStart, scratch, channel, 0, numBeforeWrap);
+
+            if (numBeforeWrap < numToRead)
+                ring.copyFrom (channel, 0, scratch, channel, numBeforeWrap, numToRead - numBeforeWrap);
+        }
+
+        writePosition += numToRead;
+        state.store ((((uint64) activeGeneration) << positionBits) | ((uint64) writePosition & positionMask),
+                     std::memory_order_release);
+
+        return numToRead < scratch.getNumSamples() ? 1 : 0;
+    }
+
+    //==============================================================================
+    TimeSliceThread& thread;
+    AudioBuffer<float> ring, scratch;
+
+    SpinLock lock;
+    ReferenceCountedObjectPtr<SamplerSound> pendingSound;
+    uint16 pendingGeneration = 0;
+
+    // Only used on the audio thread
+    uint16 generation = 0;
+
+    // Only used on the streaming thread
+    ReferenceCountedObjectPtr<SamplerSound> activeSound;
+    uint16 activeGeneration = 0;
+    int64 writePosition = 0;
+
+    std::atomic<int64> readPosition { 0 };
+    std::atomic<uint64> state { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (Streamer)
+};
+
 //==============================================================================
 SamplerVoice::SamplerVoice() {}
+
+SamplerVoice::SamplerVoice (TimeSliceThread& streamingThread, int ringBufferSize)
+    : streamer (std::make_unique<Streamer> (streamingThread, ringBufferSize))
+{
+}
+
 SamplerVoice::~SamplerVoice() {}
 
 bool SamplerVoice::canPlaySound (SynthesiserSound* sound)
 {
-    return dynamic_cast<const SamplerSound*> (sound) != nullptr;
+    if (auto* samplerSound = dynamic_cast<const SamplerSound*> (sound))
+        return streamer != nullptr || ! samplerSound->isStreaming();
+
+    return false;
+}
+
+void SamplerVoice::resetUnderrunCounters() noexcept
+{
+    numUnderruns.store (0, std::memory_order_relaxed);
+    numUnderrunSamples.store (0, std::memory_order_relaxed);
+}
+
+void SamplerVoice::stopStreaming()
+{
+    if (streamer != nullptr)
+        streamer->stop();
 }
 
 void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
@@ -90,6 +298,12 @@ void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSou
         adsr.setParameters (sound->params);
 
         adsr.noteOn();
+
+        // Voices without a streamer can't play streaming sounds - see canPlaySound()
+        jassert (streamer != nullptr || ! sound->isStreaming());
+
+        if (streamer != nullptr && sound->isStreaming())
+            streamer->start (const_cast<SamplerSound*> (sound));
     }
     else
     {
@@ -107,6 +321,7 @@ void SamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
     {
         clearCurrentNote();
         adsr.reset();
+        stopStreaming();
     }
 }
 
@@ -125,16 +340,50 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
         float* outL = outputBuffer.getWritePointer (0, startSample);
         float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
 
+        // Samples from this position onwards have to come from the streamer's ring buffer
+        const auto streamStart = playingSound->isStreaming() ? playingSound->preloadedLength
+                                                             : std::numeric_limits<int>::max();
+
+        const auto isStreaming = streamer != nullptr && playingSound->isStreaming();
+        const auto availableEnd = isStreaming ? streamer->getAvailableEnd (*playingSound) : (int64) 0;
+        const auto ringSize = isStreaming ? streamer->getRingSize() : 1;
+        const float* const ringL = isStreaming ? streamer->getRingData (0) : nullptr;
+        const float* const ringR = isStreaming ? streamer->getRingData (data.getNumChannels() > 1 ? 1 : 0) : nullptr;
+        int numSamplesUnderrun = 0;
+
         while (--numSamples >= 0)
         {
             auto pos = (int) sourceSamplePosition;
             auto alpha = (float) (sourceSamplePosition - pos);
             auto invAlpha = 1.0f - alpha;
+            float l = 0.0f, r = 0.0f;
+
+            if (pos < streamStart)
+            {
+                // just using a very simple linear interpolation here..
+                l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
+                r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
+                                     : l;
+            }
+            else if (! isStreaming)
+            {
+                jassertfalse; // this voice can't stream!
+                stopNote (0.0f, false);
+                break;
+            }
+            else if (pos + 1 < availableEnd)
+            {
+                const auto index0 = pos % ringSize;
+                const auto index1 = (index0 + 1) % ringSize;
 
-            // just using a very simple linear interpolation here..
-            float l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
-            float r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
-                                       : l;
+                l = (ringL[index0] * invAlpha + ringL[index1] * alpha);
+                r = (inR != nullptr) ? (ringR[index0] * invAlpha + ringR[index1] * alpha)
+                                     : l;
+            }
+            else
+            {
+                ++numSamplesUnderrun;
+            }
 
             auto envelopeValue = adsr.getNextSample();
 
@@ -159,7 +408,163 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
                 break;
             }
         }
+
+        if (isStreaming)
+            streamer->setReadPosition ((int64) sourceSamplePosition);
+
+        if (numSamplesUnderrun > 0)
+        {
+            numUnderruns.fetch_add (1, std::memory_order_relaxed);
+            numUnderrunSamples.fetch_add (numSamplesUnderrun, std::memory_order_relaxed);
+        }
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SamplerStreamingTests final : public UnitTest
+{
+public:
+    SamplerStreamingTests()  : UnitTest ("SamplerStreaming", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        TimeSliceThread thread ("TestStreamingThread");
+        thread.startThread (Thread::Priority::normal);
+
+        constexpr auto sampleLength = 20000;
+        constexpr auto blockSize = 256;
+
+        Random random { getRandom() };
+        const auto source = generateTestBuffer (random, sampleLength);
+
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+
+        beginTest ("Voices without a streaming thread can't play streaming sounds");
+        {
+            ReferenceCountedObjectPtr<SamplerSound> inMemory = new SamplerSound ("inMemory", *std::make_unique<TestAudioFormatReader> (&source), notes, 60, 0.0, 0.0, 10.0);
+            ReferenceCountedObjectPtr<SamplerSound> streaming = new SamplerSound ("streaming", std::make_unique<TestAudioFormatReader> (&source), notes, 60, 0.0, 0.0, 0.01);
+
+            expect (! inMemory->isStreaming());
+            expect (streaming->isStreaming());
+            expectEquals (streaming->getLengthInSamples(), sampleLength);
+
+            SamplerVoice plainVoice, streamingVoice (thread);
+
+            expect (plainVoice.canPlaySound (inMemory.get()));
+            expect (! plainVoice.canPlaySound (streaming.get()));
+            expect (streamingVoice.canPlaySound (inMemory.get()));
+            expect (streamingVoice.canPlaySound (streaming.get()));
+        }
+
+        beginTest ("Streamed playback matches in-memory playback");
+        {
+            ReferenceCountedObjectPtr<SamplerSound> inMemory = new SamplerSound ("inMemory", *std::make_unique<TestAudioFormatReader> (&source), notes, 60, 0.0, 0.0, 10.0);
+            ReferenceCountedObjectPtr<SamplerSound> streaming = new SamplerSound ("streaming", std::make_unique<TestAudioFormatReader> (&source), notes, 60, 0.0, 0.0, 0.01);
+
+            for (auto [note, ringBufferSize] : { std::pair { 60, 32768 }, std::pair { 67, 32768 }, std::pair { 67, 2048 } })
+            {
+                Synthesiser reference, streamed;
+                reference.addSound (inMemory.get());
+                reference.addVoice (new SamplerVoice());
+                streamed.addSound (streaming.get());
+                auto* streamingVoice = static_cast<SamplerVoice*> (streamed.addVoice (new SamplerVoice (thread, ringBufferSize)));
+
+                for (auto* synth : { &reference, &streamed })
+                {
+                    synth->setCurrentPlaybackSampleRate (44100.0);
+                    synth->noteOn (1, note, 1.0f);
+                }
+
+                // Give the thread time to fill the ring buffer before and between blocks
+                Thread::sleep (200);
+
+                AudioBuffer<float> expected (2, sampleLength), actual (2, sampleLength);
+                expected.clear();
+                actual.clear();
+                MidiBuffer midi;
+
+                for (int start = 0; start < sampleLength; start += blockSize)
+                {
+                    reference.renderNextBlock (expected, midi, start, jmin (blockSize, sampleLength - start));
+                    streamed.renderNextBlock (actual, midi, start, jmin (blockSize, sampleLength - start));
+                    Thread::sleep (2);
+                }
+
+                expectEquals (streamingVoice->getNumUnderruns(), 0);
+                expect (! isSilent (expected));
+
+                auto numDifferences = 0;
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < sampleLength; ++i)
+                        if (! exactlyEqual (actual.getSample (channel, i), expected.getSample (channel, i)))
+                            ++numDifferences;
+
+                expectEquals (numDifferences, 0);
+            }
+        }
+
+        beginTest ("Reading from a blocked reader is counted as an underrun");
+        {
+            struct BlockingReader final : public TestAudioFormatReader
+            {
+                using TestAudioFormatReader::TestAudioFormatReader;
+
+                bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                                  int64 startSampleInFile, int numSamples) override
+                {
+                    if (startSampleInFile > 0)
+                        unblock.wait();
+
+                    return TestAudioFormatReader::readSamples (destChannels, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+                }
+
+                WaitableEvent unblock;
+            };
+
+            auto blockingReader = std::make_unique<BlockingReader> (&source);
+            auto& unblock = blockingReader->unblock;
+
+            ReferenceCountedObjectPtr<SamplerSound> streaming = new SamplerSound ("streaming", std::move (blockingReader), notes, 60, 0.0, 0.0, 0.01);
+            const auto preloaded = streaming->getAudioData()->getNumSamples() - 4;
+
+            {
+                Synthesiser synth;
+                synth.addSound (streaming.get());
+                auto& voice = *static_cast<SamplerVoice*> (synth.addVoice (new SamplerVoice (thread)));
+                synth.setCurrentPlaybackSampleRate (44100.0);
+                synth.noteOn (1, 60, 1.0f);
+
+                AudioBuffer<float> output (2, preloaded + blockSize);
+                output.clear();
+                MidiBuffer midi;
+
+                synth.renderNextBlock (output, midi, 0, preloaded);
+                expectEquals (voice.getNumUnderruns(), 0);
+                expect (! isSilent (output));
+
+                synth.renderNextBlock (output, midi, preloaded, blockSize);
+                expectEquals (voice.getNumUnderruns(), 1);
+                expectEquals (voice.getNumUnderrunSamples(), (int64) blockSize);
+                expect (voice.isVoiceActive());
+
+                for (int channel = 0; channel < 2; ++channel)
+                    expect (output.findMinMax (channel, preloaded, blockSize) == Range<float>{});
+
+                voice.resetUnderrunCounters();
+                expectEquals (voice.getNumUnderruns(), 0);
+
+                unblock.signal();
+            }
+        }
+    }
+};
+
+static SamplerStreamingTests samplerStreamingTests;
+
+#endif
+
 } // namespace juce
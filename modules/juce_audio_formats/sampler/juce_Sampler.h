@@ -30,8 +30,10 @@ namespace juce
 /**
     A subclass of SynthesiserSound that represents a sampled audio clip.
 
-    This is a pretty basic sampler, and just attempts to load the whole audio stream
-    into memory.
+    This is a pretty basic sampler. By default it attempts to load the whole audio
+    stream into memory, but it can also keep just the start of each sample in memory
+    and stream the rest from disk while it plays - see the constructor that takes a
+    std::unique_ptr<AudioFormatReader>.
 
     To use it, create a Synthesiser, add some SamplerVoice objects to it, then
     give it some SampledSound objects to play.
@@ -70,6 +72,38 @@ public:
                   double releaseTimeSecs,
                   double maxSampleLengthSeconds);
 
+    /** Creates a sampled sound that streams most of its audio from disk.
+
+        Only the first preloadTimeSecs of the audio are loaded into memory. The rest is
+        read from the source while the sound plays, by SamplerVoices that have been
+        created with a TimeSliceThread. Voices that were created without a thread can't
+        play streaming sounds.
+
+        The reader should be cheap to seek, as it will be read from at arbitrary positions
+        by each voice that plays the sound. If it's a MemoryMappedAudioFormatReader, the
+        whole file will be mapped into memory, so that the operating system can page the
+        audio in and out as needed.
+
+        @param name         a name for the sample
+        @param source       the audio to stream from. The sound takes ownership of this
+                            reader, and keeps it for the rest of its lifetime
+        @param midiNotes    the set of midi keys that this sound should be played on
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param preloadTimeSecs  the length of audio to keep in memory, in seconds. This must be
+                                long enough to cover the time that the streaming thread takes
+                                to start reading for a voice, or the voice will run out of audio
+    */
+    SamplerSound (const String& name,
+                  std::unique_ptr<AudioFormatReader> source,
+                  const BigInteger& midiNotes,
+                  int midiNoteForNormalPitch,
+                  double attackTimeSecs,
+                  double releaseTimeSecs,
+                  double preloadTimeSecs);
+
     /** Destructor. */
     ~SamplerSound() override;
 
@@ -79,9 +113,17 @@ public:
 
     /** Returns the audio sample data.
         This could return nullptr if there was a problem loading the data.
+
+        For a streaming sound, this only contains the part of the audio that was preloaded.
     */
     AudioBuffer<float>* getAudioData() const noexcept       { return data.get(); }
 
+    /** Returns true if this sound streams its audio from disk. */
+    bool isStreaming() const noexcept                       { return reader != nullptr; }
+
+    /** Returns the length of the sample, in samples. */
+    int getLengthInSamples() const noexcept                 { return length; }
+
     //==============================================================================
     /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
     void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
@@ -96,9 +138,11 @@ private:
 
     String name;
     std::unique_ptr<AudioBuffer<float>> data;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
     double sourceSampleRate;
     BigInteger midiNotes;
-    int length = 0, midiRootNote = 0;
+    int length = 0, preloadedLength = 0, midiRootNote = 0;
 
     ADSR::Parameters params;
 
@@ -124,6 +168,21 @@ public:
     /** Creates a SamplerVoice. */
     SamplerVoice();
 
+    /** Creates a SamplerVoice that can also play streaming SamplerSounds.
+
+        While the voice is playing a streaming sound, the given thread will read ahead
+        from the sound's reader into a ring buffer belonging to this voice. The thread must
+        be running, and must outlive the voice.
+
+        @param streamingThread  the thread to read the streamed audio on. This can be shared
+                                between all of the voices in a Synthesiser
+        @param ringBufferSize   the number of samples of audio that the voice can read ahead.
+                                This is the memory that each voice needs for streaming, and it
+                                must be big enough to cover the time the thread might take to
+                                service all of the voices that share it
+    */
+    explicit SamplerVoice (TimeSliceThread& streamingThread, int ringBufferSize = 32768);
+
     /** Destructor. */
     ~SamplerVoice() override;
 
@@ -139,14 +198,36 @@ public:
     void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
     using SynthesiserVoice::renderNextBlock;
 
+    //==============================================================================
+    /** Returns the number of blocks in which this voice ran out of streamed audio.
+        This can be called from any thread.
+    */
+    int getNumUnderruns() const noexcept                    { return numUnderruns.load (std::memory_order_relaxed); }
+
+    /** Returns the number of samples that this voice has had to output as silence, because
+        the streamed audio wasn't ready in time. This can be called from any thread.
+    */
+    int64 getNumUnderrunSamples() const noexcept            { return numUnderrunSamples.load (std::memory_order_relaxed); }
+
+    /** Resets the counters returned by getNumUnderruns() and getNumUnderrunSamples(). */
+    void resetUnderrunCounters() noexcept;
+
 private:
     //==============================================================================
+    class Streamer;
+
+    void stopStreaming();
+
     double pitchRatio = 0;
     double sourceSamplePosition = 0;
     float lgain = 0, rgain = 0;
 
     ADSR adsr;
 
+    std::unique_ptr<Streamer> streamer;
+    std::atomic<int> numUnderruns { 0 };
+    std::atomic<int64> numUnderrunSamples { 0 };
+
     JUCE_LEAK_DETECTOR (SamplerVoice)
 };
 
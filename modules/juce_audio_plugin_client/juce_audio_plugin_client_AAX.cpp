@@ -1309,6 +1309,13 @@ namespace AAXClasses
                         syncParameterAttributes (aaxParam, param);
             }
 
+            if (details.parameterValuesChanged)
+            {
+                for (const auto* param : juceParameters)
+                    if (auto paramID = getAAXParamIDFromJuceIndex (param->getParameterIndex()))
+                        SetParameterNormalizedValue (paramID, (double) param->getValue());
+            }
+
             if (details.latencyChanged)
                 check (Controller()->SetSignalLatency (processor->getLatencySamples()));
 
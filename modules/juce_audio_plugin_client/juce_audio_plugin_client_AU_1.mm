@@ -370,6 +370,7 @@ public:
                     return noErr;
 
                 case kAudioUnitProperty_OfflineRender:
+                case kAudioUnitProperty_InPlaceProcessing:
                     outWritable = true;
                     outDataSize = sizeof (UInt32);
                     return noErr;
@@ -530,6 +531,10 @@ public:
                     *(UInt32*) outData = (juceFilter != nullptr && juceFilter->isNonRealtime()) ? 1 : 0;
                     return noErr;
 
+                case kAudioUnitProperty_InPlaceProcessing:
+                    *(UInt32*) outData = processesInPlace ? 1 : 0;
+                    return noErr;
+
                 case kMusicDeviceProperty_InstrumentCount:
                     *(UInt32*) outData = 1;
                     return noErr;
@@ -721,6 +726,13 @@ public:
                     return noErr;
                 }
 
+                case kAudioUnitProperty_InPlaceProcessing:
+                    if (inDataSize != sizeof (UInt32))
+                        return kAudioUnitErr_InvalidPropertyValue;
+
+                    processesInPlace = (*reinterpret_cast<const UInt32*> (inData) != 0);
+                    return noErr;
+
                 case kAudioUnitProperty_OfflineRender:
                 {
                     const auto shouldBeOffline = (*reinterpret_cast<const UInt32*> (inData) != 0);
@@ -1247,12 +1259,17 @@ public:
 
     //==============================================================================
     void sendAUEvent (const AudioUnitEventType type, const int juceParamIndex)
+    {
+        sendAUEventForParameterID (type, getAUParameterIDForIndex (juceParamIndex));
+    }
+
+    void sendAUEventForParameterID (const AudioUnitEventType type, const AudioUnitParameterID auParamID)
     {
         if (restoringState)
             return;
 
         auEvent.mEventType = type;
-        auEvent.mArgument.mParameter.mParameterID = getAUParameterIDForIndex (juceParamIndex);
+        auEvent.mArgument.mParameter.mParameterID = auParamID;
         AUEventListenerNotify (nullptr, nullptr, &auEvent);
     }
 
@@ -1884,6 +1901,9 @@ private:
             if (details.programChanged)
                 flags |= programChangedFlag;
 
+            if (details.parameterValuesChanged)
+                flags |= parameterValuesChangedFlag;
+
             if (flags != 0)
             {
                 callbackFlags.fetch_or (flags);
@@ -1916,13 +1936,17 @@ private:
                 owner.refreshCurrentPreset();
                 owner.PropertyChanged (kAudioUnitProperty_PresentPreset, kAudioUnitScope_Global, 0);
             }
+
+            if ((flags & parameterValuesChangedFlag) != 0)
+                owner.sendAUEventForParameterID (kAudioUnitEvent_ParameterValueChange, kAUParameterListener_AnyParameter);
         }
 
         JuceAU& owner;
 
-        static constexpr int latencyChangedFlag       = 1 << 0,
-                             parameterInfoChangedFlag = 1 << 1,
-                             programChangedFlag       = 1 << 2;
+        static constexpr int latencyChangedFlag         = 1 << 0,
+                             parameterInfoChangedFlag   = 1 << 1,
+                             programChangedFlag         = 1 << 2,
+                             parameterValuesChangedFlag = 1 << 3;
 
         std::atomic<int> callbackFlags { 0 };
     };
@@ -1930,7 +1954,7 @@ private:
     //==============================================================================
     AudioUnitHelpers::CoreAudioBufferList audioBuffer;
     MidiBuffer midiEvents, incomingEvents;
-    bool prepared = false, isBypassed = false, restoringState = false;
+    bool prepared = false, isBypassed = false, restoringState = false, processesInPlace = true;
 
     //==============================================================================
    #if JUCE_FORCE_USE_LEGACY_PARAM_IDS
@@ -2087,13 +2111,47 @@ private:
             auto& output = Output (busIdx);
 
             if (output.WillAllocateBuffer())
-                output.PrepareBuffer (nFrames);
+            {
+                // If the host left the output allocation to us, render straight into the pulled
+                // input buffers so that neither the input nor the output needs to be copied.
+                if (canProcessBusInPlace ((int) busIdx))
+                    output.SetBufferList (Input (busIdx).GetBufferList());
+                else
+                    output.PrepareBuffer (nFrames);
+            }
 
             if (busIdx >= (UInt32) numProcessorBuses)
                 AudioUnitHelpers::clearAudioBuffer (output.GetBufferList());
         }
     }
 
+    bool canProcessBusInPlace (int busIdx) noexcept
+    {
+        if (! processesInPlace
+            || busIdx >= AudioUnitHelpers::getBusCount (*juceFilter, true)
+            || busIdx >= AudioUnitHelpers::getBusCount (*juceFilter, false)
+            || ! pulledSucceeded[busIdx])
+            return false;
+
+        const auto numChannels = juceFilter->getChannelCountOfBus (false, busIdx);
+
+        if (numChannels != juceFilter->getChannelCountOfBus (true, busIdx))
+            return false;
+
+        const auto& outputFormat = Output ((UInt32) busIdx).GetStreamFormat();
+        const auto& inputBuffers = Input ((UInt32) busIdx).GetBufferList();
+
+        if ((outputFormat.mFormatFlags & kAudioFormatFlagIsNonInterleaved) == 0
+            || AudioUnitHelpers::isAudioBufferInterleaved (inputBuffers)
+            || inputBuffers.mNumberBuffers != (UInt32) numChannels)
+            return false;
+
+        const auto* inLayoutMap  = mapper.get (true,  busIdx);
+        const auto* outLayoutMap = mapper.get (false, busIdx);
+
+        return std::equal (inLayoutMap, inLayoutMap + numChannels, outLayoutMap);
+    }
+
     void processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer& midiBuffer) noexcept
     {
         const ScopedLock sl (juceFilter->getCallbackLock());
@@ -138,6 +138,9 @@ public:
         auto& processor = getAudioProcessor();
         processor.removeListener (this);
 
+        if (processor.getParameterAutomation() == &parameterAutomation)
+            processor.setParameterAutomation (nullptr);
+
         if (bypassParam != nullptr)
             bypassParam->removeListener (this);
 
@@ -530,6 +533,13 @@ public:
         }();
 
         processor.setRateAndBufferSizeDetails (sampleRate, static_cast<int> (maxFrames));
+
+        if (processor.supportsSampleAccurateAutomation())
+        {
+            parameterAutomation.prepare (processor.getParameters().size());
+            processor.setParameterAutomation (&parameterAutomation);
+        }
+
         processor.prepareToPlay (sampleRate, static_cast<int> (maxFrames));
 
         midiMessages.ensureSize (2048);
@@ -1415,8 +1425,15 @@ private:
     }
 
     //==============================================================================
-    void processEvents (const AURenderEvent *__nullable realtimeEventListHead, [[maybe_unused]] int numParams, AUEventSampleTime startTime)
+    void processEvents (const AURenderEvent *__nullable realtimeEventListHead,
+                        [[maybe_unused]] int numParams,
+                        AUEventSampleTime startTime,
+                        AUAudioFrameCount frameCount)
     {
+        parameterAutomation.clear();
+
+        const auto recordAutomation = getAudioProcessor().getParameterAutomation() != nullptr;
+
         for (const AURenderEvent* event = realtimeEventListHead; event != nullptr; event = event->head.next)
         {
             switch (event->head.eventType)
@@ -1458,6 +1475,28 @@ private:
                     if (auto* p = getJuceParameterForAUAddress (paramEvent.parameterAddress))
                     {
                         auto normalisedValue = paramEvent.value / getMaximumParameterValue (*p);
+
+                        if (recordAutomation)
+                        {
+                            const auto offset = static_cast<int> (paramEvent.eventSampleTime - startTime);
+
+                            if (event->head.eventType == AURenderEventParameterRamp && paramEvent.rampDurationSampleFrames > 0)
+                            {
+                                // Ramps that continue past the end of this block are shortened so
+                                // that they finish at the end of the block, because the parameter
+                                // will already hold its final value when the next block starts.
+                                const auto lastFrame = jmax (0, static_cast<int> (frameCount) - 1);
+                                const auto rampEnd = jmin (offset + static_cast<int> (paramEvent.rampDurationSampleFrames), lastFrame);
+
+                                parameterAutomation.addPoint (*p, offset, p->getValue());
+                                parameterAutomation.addPoint (*p, rampEnd, normalisedValue);
+                            }
+                            else
+                            {
+                                parameterAutomation.addPoint (*p, offset, normalisedValue);
+                            }
+                        }
+
                         setAudioProcessorParameter (p, normalisedValue);
                     }
                 }
@@ -1485,7 +1524,7 @@ private:
             midiMessages.clear();
 
             const int numParams = juceParameters.getNumParameters();
-            processEvents (realtimeEventListHead, numParams, static_cast<AUEventSampleTime> (timestamp->mSampleTime));
+            processEvents (realtimeEventListHead, numParams, static_cast<AUEventSampleTime> (timestamp->mSampleTime), frameCount);
 
             lastTimeStamp = *timestamp;
 
@@ -1759,6 +1798,7 @@ private:
 
     OwnedArray<BusBuffer> inBusBuffers, outBusBuffers;
     MidiBuffer midiMessages;
+    AudioProcessorParameterAutomation parameterAutomation;
     AUMIDIOutputEventBlock midiOutputEventBlock = nullptr;
 
    #if JUCE_APPLE_MIDI_EVENT_LIST_SUPPORTED
@@ -42,7 +42,6 @@
 #include <juce_audio_plugin_client/detail/juce_PluginUtilities.h>
 #include <juce_audio_plugin_client/detail/juce_LinuxMessageThread.h>
 
-#include <juce_audio_processors/utilities/juce_FlagCache.h>
 #include <juce_audio_processors/format_types/juce_LegacyAudioParameter.cpp>
 
 #include "JuceLV2Defines.h"
@@ -223,7 +222,21 @@ private:
             stateCache.setBits ((size_t) parameterIndex, gestureEnded);
     }
 
-    void audioProcessorChanged (AudioProcessor*, const ChangeDetails&) override {}
+    void audioProcessorChanged (AudioProcessor*, const ChangeDetails& details) override
+    {
+        if (ignoreCallbacks || ! details.parameterValuesChanged)
+            return;
+
+        // Only the parameters that actually changed are sent on to the host
+        for (auto* param : legacyParameters)
+        {
+            const auto index = (size_t) param->getParameterIndex();
+            const auto value = param->getValue();
+
+            if (! approximatelyEqual (stateCache.get (index), value))
+                stateCache.setValueAndBits (index, value, newClientValue);
+        }
+    }
 
     AudioProcessor& processor;
     const LV2_URID_Map mapFeature;
@@ -492,6 +505,7 @@ class LV2PluginInstance final : private AudioProcessorListener
 public:
     LV2PluginInstance (double sampleRate,
                        int64_t maxBlockSize,
+                       int64_t sequenceSize,
                        const char*,
                        LV2_URID_Map mapFeatureIn)
         : mapFeature (mapFeatureIn),
@@ -499,7 +513,7 @@ public:
     {
         processor->addListener (this);
         processor->setPlayHead (&playHead);
-        prepare (sampleRate, (int) maxBlockSize);
+        prepare (sampleRate, (int) maxBlockSize, (int) sequenceSize);
     }
 
     void connect (uint32_t port, void* data)
@@ -692,7 +706,7 @@ public:
     LV2_State_Status retrieve (LV2_State_Retrieve_Function retrieveFn,
                                LV2_State_Handle handle,
                                uint32_t,
-                               const LV2_Feature* const*)
+                               const LV2_Feature* const* features)
     {
         size_t size = 0;
         uint32_t type = 0;
@@ -718,13 +732,42 @@ public:
             return LV2_STATE_ERR_BAD_TYPE;
 
         String text (static_cast<const char*> (data), (size_t) size);
-        MemoryBlock block;
-        block.fromBase64Encoding (text);
-        processor->setStateInformation (block.getData(), (int) block.getSize());
+        auto block = std::make_unique<MemoryBlock>();
+        block->fromBase64Encoding (text);
+
+        // We declare state:threadSafeRestore, so the host may call this while the audio thread is
+        // running and will pass us a work:schedule feature. In that case the actual loading is
+        // handed over to the host's worker thread, and ownership of the block goes with it.
+        if (features != nullptr)
+        {
+            if (const auto* schedule = findMatchingFeatureData<const LV2_Worker_Schedule*> (features, LV2_WORKER__schedule))
+            {
+                auto* pendingState = block.get();
+
+                if (schedule->schedule_work (schedule->handle, sizeof (pendingState), &pendingState) == LV2_WORKER_SUCCESS)
+                {
+                    block.release();
+                    return LV2_STATE_SUCCESS;
+                }
+            }
+        }
+
+        processor->setStateInformation (block->getData(), (int) block->getSize());
 
         return LV2_STATE_SUCCESS;
     }
 
+    LV2_Worker_Status work (uint32_t size, const void* data)
+    {
+        if (size != sizeof (MemoryBlock*))
+            return LV2_WORKER_ERR_UNKNOWN;
+
+        const std::unique_ptr<MemoryBlock> block (readUnaligned<MemoryBlock*> (data));
+        processor->setStateInformation (block->getData(), (int) block->getSize());
+
+        return LV2_WORKER_SUCCESS;
+    }
+
     std::unique_ptr<AudioProcessorEditor> createEditor()
     {
         return std::unique_ptr<AudioProcessorEditor> (processor->createEditorIfNeeded());
@@ -773,7 +816,7 @@ private:
             shouldSendStateChange = true;
     }
 
-    void prepare (double sampleRate, int maxBlockSize)
+    void prepare (double sampleRate, int maxBlockSize, int sequenceSize)
     {
         jassert (processor != nullptr);
         processor->setRateAndBufferSizeDetails (sampleRate, maxBlockSize);
@@ -782,7 +825,10 @@ private:
         const auto numChannels = jmax (processor->getTotalNumInputChannels(),
                                        processor->getTotalNumOutputChannels());
 
-        midi.ensureSize (8192);
+        // Each event in a MidiBuffer takes less space than the corresponding atom in the input
+        // sequence, so reserving the host's sequence size means that converting the incoming
+        // atoms will never allocate on the audio thread.
+        midi.ensureSize ((size_t) jmax (8192, sequenceSize));
         audio.setSize (numChannels, maxBlockSize);
         audio.clear();
     }
@@ -1032,6 +1078,7 @@ private:
               "@prefix ui:    <http://lv2plug.in/ns/extensions/ui#> .\n"
               "@prefix units: <http://lv2plug.in/ns/extensions/units#> .\n"
               "@prefix urid:  <http://lv2plug.in/ns/ext/urid#> .\n"
+              "@prefix work:  <http://lv2plug.in/ns/ext/worker#> .\n"
               "@prefix xsd:   <http://www.w3.org/2001/XMLSchema#> .\n"
               "\n";
 
@@ -1177,9 +1224,11 @@ private:
               "\t\tdoap:revision \"" JucePlugin_VersionString "\" ;\n"
               "\t] ;\n"
               "\tlv2:optionalFeature\n"
-              "\t\tlv2:hardRTCapable ;\n"
+              "\t\tlv2:hardRTCapable ,\n"
+              "\t\tstate:threadSafeRestore ;\n"
               "\tlv2:extensionData\n"
-              "\t\tstate:interface ;\n"
+              "\t\tstate:interface ,\n"
+              "\t\twork:interface ;\n"
               "\tlv2:requiredFeature\n"
               "\t\turid:map ,\n"
               "\t\topts:options ,\n"
@@ -1446,7 +1495,10 @@ LV2_SYMBOL_EXPORT const LV2_Descriptor* lv2_descriptor (uint32_t index)
                 return nullptr;
             }
 
-            return new LV2PluginInstance { sampleRate, *blockSize, pathToBundle, *mapFeature };
+            const auto sequenceSizeUrid = mapFeature->map (mapFeature->handle, LV2_BUF_SIZE__sequenceSize);
+            const auto sequenceSize = parser.parseNumericOption<int64_t> (findMatchingOption (options, sequenceSizeUrid));
+
+            return new LV2PluginInstance { sampleRate, *blockSize, sequenceSize.orFallback (0), pathToBundle, *mapFeature };
         },
         [] (LV2_Handle instance, uint32_t port, void* data)
         {
@@ -1491,8 +1543,23 @@ LV2_SYMBOL_EXPORT const LV2_Descriptor* lv2_descriptor (uint32_t index)
                 }
             };
 
+            static LV2_Worker_Interface workerInterface
+            {
+                [] (LV2_Handle instance,
+                    LV2_Worker_Respond_Function,
+                    LV2_Worker_Respond_Handle,
+                    uint32_t size,
+                    const void* data) -> LV2_Worker_Status
+                {
+                    return static_cast<LV2PluginInstance*> (instance)->work (size, data);
+                },
+                [] (LV2_Handle, uint32_t, const void*) -> LV2_Worker_Status { return LV2_WORKER_SUCCESS; },
+                nullptr
+            };
+
             static const LV2_Feature features[] { { JUCE_TURTLE_RECALL_URI, &recallFeature },
-                                                  { LV2_STATE__interface,   &stateInterface } };
+                                                  { LV2_STATE__interface,   &stateInterface },
+                                                  { LV2_WORKER__interface,  &workerInterface } };
 
             const auto it = std::find_if (std::begin (features), std::end (features), uriMatches);
             return it != std::end (features) ? it->data : nullptr;
@@ -1285,7 +1285,7 @@ private:
                 callbackBits |= audioMasterIOChangedBit;
             }
 
-            if (details.parameterInfoChanged || details.programChanged)
+            if (details.parameterInfoChanged || details.programChanged || details.parameterValuesChanged)
                 callbackBits |= audioMasterUpdateDisplayBit;
 
             triggerAsyncUpdate();
@@ -52,7 +52,6 @@ JUCE_BEGIN_NO_SANITIZE ("vptr")
 #include <juce_gui_basics/native/juce_WindowsHooks_windows.h>
 
 #include <juce_audio_processors/format_types/juce_LegacyAudioParameter.cpp>
-#include <juce_audio_processors/utilities/juce_FlagCache.h>
 #include <juce_audio_processors/format_types/juce_VST3Common.h>
 
 #ifndef JUCE_VST3_CAN_REPLACE_VST2
@@ -1283,6 +1282,28 @@ public:
             endEdit (vstParamId);
     }
 
+    /*  Called when the processor has changed many parameters without notifying us of each one */
+    void syncAllParameterValues()
+    {
+        const auto onMessageThread = MessageManager::getInstance()->isThisTheMessageThread();
+        const auto& paramIDs = audioProcessor->getParamIDs();
+
+        for (int i = 0; i < paramIDs.size(); ++i)
+        {
+            const auto vstParamId = paramIDs.getReference (i);
+
+            if (vstParamId == audioProcessor->getProgramParamID())
+                continue;
+
+            const auto value = audioProcessor->getParamForVSTParamID (vstParamId)->getValue();
+
+            if (onMessageThread)
+                EditController::setParamNormalized (vstParamId, value);
+            else
+                audioProcessor->setParameterValue (i, value);
+        }
+    }
+
     void paramChanged (Steinberg::int32 parameterIndex, Vst::ParamID vstParamId, double newValue)
     {
         if (inParameterChangedCallback || inSetState)
@@ -1369,6 +1390,12 @@ public:
         if (details.nonParameterStateChanged)
             flags |= pluginShouldBeMarkedDirtyFlag;
 
+        if (details.parameterValuesChanged && ! inSetState)
+        {
+            syncAllParameterValues();
+            flags |= Vst::kParamValuesChanged;
+        }
+
         if (inSetupProcessing)
             flags &= Vst::kLatencyChanged;
 
@@ -2474,8 +2501,13 @@ public:
             juceVST3EditController->vst3IsPlaying = false;
 
         if (pluginInstance != nullptr)
+        {
             if (pluginInstance->getPlayHead() == this)
                 pluginInstance->setPlayHead (nullptr);
+
+            if (pluginInstance->getParameterAutomation() == &parameterAutomation)
+                pluginInstance->setParameterAutomation (nullptr);
+        }
     }
 
     //==============================================================================
@@ -3502,9 +3534,18 @@ public:
                 }
                 else
                #endif
-                if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
+                if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
                 {
-                    if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+                    if (pluginInstance->getParameterAutomation() != nullptr)
+                    {
+                        for (Steinberg::int32 point = 0; point < numPoints; ++point)
+                        {
+                            if (const auto change = getPointFromQueue (paramQueue, point))
+                                parameterAutomation.addPoint (*param, change->offsetSamples, (float) change->value);
+                        }
+                    }
+
+                    if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
                         setValueAndNotifyIfChanged (*param, (float) change->value);
                 }
             }
@@ -3557,6 +3598,7 @@ public:
         }
 
         midiBuffer.clear();
+        parameterAutomation.clear();
 
         if (data.inputParameterChanges != nullptr)
             processParameterChanges (*data.inputParameterChanges);
@@ -3746,6 +3788,12 @@ private:
 
         p.setRateAndBufferSizeDetails (sampleRate, bufferSize);
 
+        if (p.supportsSampleAccurateAutomation())
+        {
+            parameterAutomation.prepare (p.getParameters().size());
+            p.setParameterAutomation (&parameterAutomation);
+        }
+
         if (callPrepareToPlay == CallPrepareToPlay::yes)
             p.prepareToPlay (sampleRate, bufferSize);
 
@@ -3830,6 +3878,7 @@ private:
     Vst::ProcessSetup processSetup;
 
     MidiBuffer midiBuffer;
+    AudioProcessorParameterAutomation parameterAutomation;
     ClientBufferMapper bufferMapper;
 
     bool active = false;
@@ -62,6 +62,12 @@ void AudioPluginFormatManager::addDefaultFormats()
     #define HAS_LV2 0
    #endif
 
+   #if JUCE_PLUGINHOST_CLAP && (JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX || JUCE_BSD)
+    #define HAS_CLAP 1
+   #else
+    #define HAS_CLAP 0
+   #endif
+
    #if JUCE_DEBUG
     // you should only call this method once!
     for (auto* format [[maybe_unused]] : formats)
@@ -85,6 +91,10 @@ void AudioPluginFormatManager::addDefaultFormats()
        #if HAS_LV2
         jassert (dynamic_cast<LV2PluginFormat*> (format) == nullptr);
        #endif
+
+       #if HAS_CLAP
+        jassert (dynamic_cast<CLAPPluginFormat*> (format) == nullptr);
+       #endif
     }
    #endif
 
@@ -107,6 +117,10 @@ void AudioPluginFormatManager::addDefaultFormats()
    #if HAS_LV2
     formats.add (new LV2PluginFormat());
    #endif
+
+   #if HAS_CLAP
+    formats.add (new CLAPPluginFormat());
+   #endif
 }
 
 int AudioPluginFormatManager::getNumFormats() const                         { return formats.size(); }
@@ -176,6 +190,55 @@ void AudioPluginFormatManager::createPluginInstanceAsync (const PluginDescriptio
     new DeliverError (std::move (callback), error);
 }
 
+//==============================================================================
+struct AudioPluginFormatManager::InstanceBatch
+{
+    static void startNextRequest (AudioPluginFormatManager& manager, const std::shared_ptr<InstanceBatch>& batch)
+    {
+        if (batch->nextRequest >= batch->requests.size())
+            return;
+
+        auto& request = batch->requests[batch->nextRequest++];
+
+        manager.createPluginInstanceAsync (request.description,
+                                           batch->sampleRate,
+                                           batch->blockSize,
+                                           [&manager, batch, callback = std::move (request.callback)] (std::unique_ptr<AudioPluginInstance> instance,
+                                                                                                      const String& error)
+                                           {
+                                               if (callback != nullptr)
+                                                   callback (std::move (instance), error);
+
+                                               startNextRequest (manager, batch);
+                                           });
+    }
+
+    std::vector<InstanceRequest> requests;
+    size_t nextRequest = 0;
+    double sampleRate = 0.0;
+    int blockSize = 0;
+};
+
+void AudioPluginFormatManager::createPluginInstancesAsync (std::vector<InstanceRequest> requests,
+                                                           double initialSampleRate, int initialBufferSize,
+                                                           int maxConcurrentRequests)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    std::stable_sort (requests.begin(), requests.end(), [] (const auto& a, const auto& b)
+    {
+        return a.priority > b.priority;
+    });
+
+    auto batch = std::make_shared<InstanceBatch>();
+    batch->requests = std::move (requests);
+    batch->sampleRate = initialSampleRate;
+    batch->blockSize = initialBufferSize;
+
+    for (auto i = jmax (1, maxConcurrentRequests); --i >= 0;)
+        InstanceBatch::startNextRequest (*this, batch);
+}
+
 AudioPluginFormat* AudioPluginFormatManager::findFormatForDescription (const PluginDescription& description,
                                                                        String& errorMessage) const
 {
@@ -109,6 +109,44 @@ public:
                                     double initialSampleRate, int initialBufferSize,
                                     AudioPluginFormat::PluginCreationCallback callback);
 
+    /** Describes one of the plug-ins to be loaded by createPluginInstancesAsync(). */
+    struct InstanceRequest
+    {
+        /** The plug-in to load. */
+        PluginDescription description;
+
+        /** Requests with a higher priority are started before requests with a lower
+            priority. For example, a host loading a session might give the plug-ins on the
+            main signal path a higher priority than those on hidden tracks, so that playback
+            can start as soon as possible. Requests with equal priorities are started in the
+            order in which they were supplied.
+        */
+        int priority = 0;
+
+        /** Called on the message thread once the instance has been created, or has failed
+            to load.
+        */
+        AudioPluginFormat::PluginCreationCallback callback;
+    };
+
+    /** Asynchronously loads a batch of plug-ins, in order of priority.
+
+        At most maxConcurrentRequests instances will be in the process of being created at
+        any one time, and each new request is started as soon as a previous one completes.
+        Formats that must create their instances on the message thread will create one
+        instance per message callback, so the message thread stays responsive while a large
+        batch is loaded. Formats that support asynchronous instantiation, such as AudioUnit
+        v3 plug-ins, will load several instances concurrently.
+
+        This must be called from the message thread, and the AudioPluginFormatManager must
+        outlive all of the requests.
+
+        @see createPluginInstanceAsync
+    */
+    void createPluginInstancesAsync (std::vector<InstanceRequest> requests,
+                                     double initialSampleRate, int initialBufferSize,
+                                     int maxConcurrentRequests = 4);
+
     /** Tries to create an ::ARAFactoryWrapper for this description.
 
         The result of the operation will be wrapped into an ARAFactoryResult,
@@ -132,6 +170,8 @@ public:
 
 private:
     //==============================================================================
+    struct InstanceBatch;
+
     AudioPluginFormat* findFormatForDescription (const PluginDescription&, String& errorMessage) const;
 
     OwnedArray<AudioPluginFormat> formats;
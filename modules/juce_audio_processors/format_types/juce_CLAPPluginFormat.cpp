@@ -0,0 +1,1331 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_PLUGINHOST_CLAP && (JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX || JUCE_BSD)
+
+#include <clap/clap.h>
+
+namespace juce
+{
+
+#define JUCE_CLAP_LOGGING 1
+
+#if JUCE_CLAP_LOGGING
+ #define JUCE_CLAP_LOG(x) Logger::writeToLog (x);
+#else
+ #define JUCE_CLAP_LOG(x)
+#endif
+
+//==============================================================================
+namespace CLAPHelpers
+{
+    static String toString (const char* text)
+    {
+        return text != nullptr ? String::fromUTF8 (text) : String();
+    }
+
+    static StringArray getFeatures (const clap_plugin_descriptor_t& descriptor)
+    {
+        StringArray result;
+
+        if (descriptor.features != nullptr)
+            for (auto* feature = descriptor.features; *feature != nullptr; ++feature)
+                result.add (toString (*feature));
+
+        return result;
+    }
+
+    template <typename Extension>
+    static const Extension* getExtension (const clap_plugin_t* plugin, const char* id)
+    {
+        if (plugin == nullptr || plugin->get_extension == nullptr)
+            return nullptr;
+
+        return static_cast<const Extension*> (plugin->get_extension (plugin, id));
+    }
+
+    static AudioChannelSet getChannelSet (const clap_audio_port_info_t& info)
+    {
+        if (info.channel_count == 1)
+            return AudioChannelSet::mono();
+
+        if (info.channel_count == 2)
+            return AudioChannelSet::stereo();
+
+        return AudioChannelSet::discreteChannels ((int) info.channel_count);
+    }
+
+    static clap_beattime toBeatTime (double ppq)    { return (clap_beattime) std::round (ppq * (double) CLAP_BEATTIME_FACTOR); }
+    static clap_sectime toSecTime (double seconds)  { return (clap_sectime) std::round (seconds * (double) CLAP_SECTIME_FACTOR); }
+
+    static clap_event_header_t makeHeader (uint32_t size, uint16_t type, int time)
+    {
+        clap_event_header_t header{};
+        header.size = size;
+        header.time = (uint32_t) time;
+        header.space_id = CLAP_CORE_EVENT_SPACE_ID;
+        header.type = type;
+        header.flags = 0;
+        return header;
+    }
+}
+
+//==============================================================================
+class CLAPModule final : public ReferenceCountedObject
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<CLAPModule>;
+
+    ~CLAPModule() override
+    {
+        getActiveModules().removeFirstMatchingValue (this);
+
+        if (entry != nullptr && entry->deinit != nullptr)
+            entry->deinit();
+
+        library.close();
+    }
+
+    static CLAPModule* findOrCreateModule (const File& file)
+    {
+        for (auto* module : getActiveModules())
+            if (module->file == file)
+                return module;
+
+        JUCE_CLAP_LOG ("Loading CLAP module: " + file.getFullPathName());
+
+        std::unique_ptr<CLAPModule> m (new CLAPModule (file));
+
+        if (! m->open())
+            m = nullptr;
+
+        return m.release();
+    }
+
+    const clap_plugin_factory_t* getFactory() const noexcept    { return factory; }
+
+    uint32_t getNumDescriptors() const
+    {
+        return factory->get_plugin_count != nullptr ? factory->get_plugin_count (factory) : 0;
+    }
+
+    const clap_plugin_descriptor_t* getDescriptor (uint32_t index) const
+    {
+        return factory->get_plugin_descriptor != nullptr ? factory->get_plugin_descriptor (factory, index) : nullptr;
+    }
+
+    const clap_plugin_descriptor_t* findDescriptor (int uniqueId) const
+    {
+        for (uint32_t i = 0; i < getNumDescriptors(); ++i)
+            if (auto* descriptor = getDescriptor (i))
+                if (CLAPHelpers::toString (descriptor->id).hashCode() == uniqueId)
+                    return descriptor;
+
+        return nullptr;
+    }
+
+    const File file;
+
+private:
+    explicit CLAPModule (const File& f)
+        : file (f)
+    {
+        getActiveModules().add (this);
+    }
+
+    static Array<CLAPModule*>& getActiveModules()
+    {
+        static Array<CLAPModule*> activeModules;
+        return activeModules;
+    }
+
+    static File getBinaryFile (const File& file)
+    {
+       #if JUCE_MAC
+        // A CLAP on macOS is a bundle, with the library in its usual place
+        if (file.isDirectory())
+            return file.getChildFile ("Contents/MacOS").getChildFile (file.getFileNameWithoutExtension());
+       #endif
+
+        return file;
+    }
+
+    bool open()
+    {
+        if (! library.open (getBinaryFile (file).getFullPathName()))
+            return false;
+
+        entry = static_cast<const clap_plugin_entry_t*> (library.getFunction ("clap_entry"));
+
+        if (entry == nullptr || ! clap_version_is_compatible (entry->clap_version)
+             || entry->init == nullptr || ! entry->init (file.getFullPathName().toRawUTF8()))
+        {
+            entry = nullptr;
+            return false;
+        }
+
+        if (entry->get_factory != nullptr)
+            factory = static_cast<const clap_plugin_factory_t*> (entry->get_factory (CLAP_PLUGIN_FACTORY_ID));
+
+        return factory != nullptr;
+    }
+
+    DynamicLibrary library;
+    const clap_plugin_entry_t* entry = nullptr;
+    const clap_plugin_factory_t* factory = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CLAPModule)
+};
+
+//==============================================================================
+/*  A clap_input_events list whose storage is allocated up-front, so that it can
+    be refilled on the audio thread. Events must be added in time order.
+*/
+class CLAPInputEventList
+{
+public:
+    CLAPInputEventList()
+    {
+        list.ctx = this;
+        list.size = [] (const clap_input_events_t* l) -> uint32_t
+        {
+            return (uint32_t) static_cast<const CLAPInputEventList*> (l->ctx)->offsets.size();
+        };
+
+        list.get = [] (const clap_input_events_t* l, uint32_t index) -> const clap_event_header_t*
+        {
+            auto* self = static_cast<const CLAPInputEventList*> (l->ctx);
+
+            if (index >= self->offsets.size())
+                return nullptr;
+
+            return reinterpret_cast<const clap_event_header_t*> (self->storage.data() + self->offsets[index]);
+        };
+    }
+
+    void reserve (size_t maxNumEvents)
+    {
+        storage.resize (maxNumEvents * maxEventSize / sizeof (uint64_t));
+        offsets.reserve (maxNumEvents);
+    }
+
+    void clear() noexcept
+    {
+        offsets.clear();
+        numWordsUsed = 0;
+    }
+
+    /*  Returns false if the list is full, in which case the event is dropped. */
+    template <typename Event>
+    bool add (const Event& event) noexcept
+    {
+        static_assert (sizeof (Event) <= maxEventSize);
+        constexpr auto numWords = (sizeof (Event) + sizeof (uint64_t) - 1) / sizeof (uint64_t);
+
+        if (offsets.size() == offsets.capacity() || numWordsUsed + numWords > storage.size())
+            return false;
+
+        std::memcpy (storage.data() + numWordsUsed, &event, sizeof (Event));
+        offsets.push_back (numWordsUsed);
+        numWordsUsed += numWords;
+        return true;
+    }
+
+    const clap_input_events_t* get() const noexcept     { return &list; }
+
+private:
+    static constexpr size_t maxEventSize = 64;
+
+    clap_input_events_t list{};
+    std::vector<uint64_t> storage;
+    std::vector<size_t> offsets;
+    size_t numWordsUsed = 0;
+};
+
+//==============================================================================
+class CLAPPluginInstance final : public AudioPluginInstance,
+                                 private AsyncUpdater
+{
+public:
+    static std::unique_ptr<CLAPPluginInstance> create (CLAPModule::Ptr module,
+                                                       const clap_plugin_descriptor_t& descriptor)
+    {
+        auto context = std::make_unique<HostContext>();
+        auto* factory = module->getFactory();
+
+        if (factory->create_plugin == nullptr)
+            return {};
+
+        auto* plugin = factory->create_plugin (factory, &context->host, descriptor.id);
+
+        if (plugin == nullptr)
+            return {};
+
+        if (! plugin->init (plugin))
+        {
+            plugin->destroy (plugin);
+            return {};
+        }
+
+        BusesProperties buses;
+
+        if (auto* audioPorts = CLAPHelpers::getExtension<clap_plugin_audio_ports_t> (plugin, CLAP_EXT_AUDIO_PORTS))
+        {
+            for (const auto isInput : { true, false })
+            {
+                for (uint32_t i = 0; i < audioPorts->count (plugin, isInput); ++i)
+                {
+                    clap_audio_port_info_t info{};
+
+                    if (audioPorts->get (plugin, i, isInput, &info))
+                        buses.addBus (isInput, CLAPHelpers::toString (info.name), CLAPHelpers::getChannelSet (info), true);
+                }
+            }
+        }
+
+        return std::unique_ptr<CLAPPluginInstance> (new CLAPPluginInstance (std::move (module), std::move (context), plugin, buses));
+    }
+
+    ~CLAPPluginInstance() override
+    {
+        cancelPendingUpdate();
+        deactivate();
+        context->owner = nullptr;
+        plugin->destroy (plugin);
+    }
+
+    //==============================================================================
+    void fillInPluginDescription (PluginDescription& desc) const override
+    {
+        fillInDescription (desc, module->file, *plugin->desc);
+        desc.numInputChannels = getTotalNumInputChannels();
+        desc.numOutputChannels = getTotalNumOutputChannels();
+    }
+
+    static void fillInDescription (PluginDescription& desc, const File& file, const clap_plugin_descriptor_t& descriptor)
+    {
+        const auto features = CLAPHelpers::getFeatures (descriptor);
+
+        desc.name = CLAPHelpers::toString (descriptor.name);
+        desc.descriptiveName = CLAPHelpers::toString (descriptor.description);
+        desc.fileOrIdentifier = file.getFullPathName();
+        desc.uniqueId = desc.deprecatedUid = CLAPHelpers::toString (descriptor.id).hashCode();
+        desc.lastFileModTime = file.getLastModificationTime();
+        desc.lastInfoUpdateTime = Time::getCurrentTime();
+        desc.pluginFormatName = "CLAP";
+        desc.category = features.joinIntoString ("|");
+        desc.manufacturerName = CLAPHelpers::toString (descriptor.vendor);
+        desc.version = CLAPHelpers::toString (descriptor.version);
+        desc.isInstrument = features.contains (CLAP_PLUGIN_FEATURE_INSTRUMENT);
+    }
+
+    //==============================================================================
+    const String getName() const override                   { return CLAPHelpers::toString (plugin->desc->name); }
+    bool acceptsMidi() const override                       { return numNoteInputPorts > 0; }
+    bool producesMidi() const override                      { return numNoteOutputPorts > 0; }
+    bool isMidiEffect() const override                      { return getBusCount (true) == 0 && getBusCount (false) == 0 && (acceptsMidi() || producesMidi()); }
+    bool supportsDoublePrecisionProcessing() const override { return false; }
+
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override
+    {
+        // The ports are fixed until the plugin asks for a rescan, which isn't supported yet
+        return layouts == pluginLayout;
+    }
+
+    double getTailLengthSeconds() const override
+    {
+        if (tailExtension == nullptr || ! isActive || getSampleRate() <= 0.0)
+            return 0.0;
+
+        const auto tail = tailExtension->get (plugin);
+
+        if (tail == std::numeric_limits<uint32_t>::max())
+            return std::numeric_limits<double>::infinity();
+
+        return (double) tail / getSampleRate();
+    }
+
+    //==============================================================================
+    void prepareToPlay (double newSampleRate, int estimatedSamplesPerBlock) override
+    {
+        deactivate();
+
+        maxFramesCount = jmax (1, estimatedSamplesPerBlock);
+        inputScratch.setSize (jmax (1, getTotalNumInputChannels()), maxFramesCount);
+        inputChannels.assign ((size_t) getTotalNumInputChannels(), nullptr);
+        outputChannels.assign ((size_t) getTotalNumOutputChannels(), nullptr);
+        inputBuffers.assign ((size_t) getBusCount (true), {});
+        outputBuffers.assign ((size_t) getBusCount (false), {});
+        inputEvents.reserve ((size_t) jmax (1024, (int) paramCache.size() + 512));
+        outputMidi.ensureSize (4096);
+
+        isActive = plugin->activate (plugin, newSampleRate, 1, (uint32_t) maxFramesCount);
+
+        if (! isActive)
+            JUCE_CLAP_LOG ("CLAP plugin failed to activate: " + getName())
+
+        updateLatency();
+    }
+
+    void releaseResources() override
+    {
+        deactivate();
+    }
+
+    void reset() override
+    {
+        if (isActive && plugin->reset != nullptr)
+            plugin->reset (plugin);
+    }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+    {
+        const ScopedNoDenormals noDenormals;
+        const auto numSamples = buffer.getNumSamples();
+
+        for (auto i = getTotalNumInputChannels(); i < buffer.getNumChannels(); ++i)
+            buffer.clear (i, 0, numSamples);
+
+        if (! isActive || (! processingStarted && ! startProcessing()))
+        {
+            buffer.clear();
+            midi.clear();
+            return;
+        }
+
+        const ScopedValueSetter<bool> insideProcess (isInsideProcess, true);
+        audioThreadId = Thread::getCurrentThreadId();
+        outputMidi.clear();
+
+        for (auto i = 0; i < getTotalNumInputChannels(); ++i)
+            inputScratch.copyFrom (i, 0, buffer, i, 0, jmin (numSamples, maxFramesCount));
+
+        clap_event_transport_t transport{};
+        const auto hasTransport = updateTransport (transport);
+
+        // Host blocks are normally no larger than the prepared size, but if one is, it's split
+        // into chunks that the plugin can handle, with each event sent in the chunk it falls in.
+        for (int start = 0; start < numSamples; start += maxFramesCount)
+        {
+            const auto numFrames = jmin (maxFramesCount, numSamples - start);
+
+            if (start != 0)
+            {
+                for (auto i = 0; i < getTotalNumInputChannels(); ++i)
+                    inputScratch.copyFrom (i, 0, buffer, i, start, numFrames);
+
+                advanceTransport (transport, maxFramesCount);
+            }
+
+            inputEvents.clear();
+
+            if (start == 0)
+                addParameterEvents (0);
+
+            addMidiEvents (midi, start, numFrames);
+            setUpAudioBuffers (buffer, start);
+
+            clap_process_t process{};
+            process.steady_time = steadyTime;
+            process.frames_count = (uint32_t) numFrames;
+            process.transport = hasTransport ? &transport : nullptr;
+            process.audio_inputs = inputBuffers.data();
+            process.audio_outputs = outputBuffers.data();
+            process.audio_inputs_count = (uint32_t) inputBuffers.size();
+            process.audio_outputs_count = (uint32_t) outputBuffers.size();
+            process.in_events = inputEvents.get();
+            process.out_events = &outputEvents;
+
+            outputEventOffset = start;
+
+            if (plugin->process (plugin, &process) == CLAP_PROCESS_ERROR)
+                buffer.clear (start, numFrames);
+
+            steadyTime += numFrames;
+        }
+
+        midi.swapWith (outputMidi);
+    }
+
+    using AudioPluginInstance::processBlock;
+
+    //==============================================================================
+    bool hasEditor() const override                         { return false; }
+    AudioProcessorEditor* createEditor() override           { return nullptr; }
+
+    //==============================================================================
+    int getNumPrograms() override                           { return 1; }
+    int getCurrentProgram() override                        { return 0; }
+    void setCurrentProgram (int) override                   {}
+    const String getProgramName (int) override              { return {}; }
+    void changeProgramName (int, const String&) override    {}
+
+    //==============================================================================
+    void getStateInformation (MemoryBlock& destData) override
+    {
+        destData.reset();
+
+        if (stateExtension == nullptr)
+            return;
+
+        flushParametersIfInactive();
+
+        MemoryOutputStream out (destData, false);
+
+        clap_ostream_t stream{};
+        stream.ctx = &out;
+        stream.write = [] (const clap_ostream_t* s, const void* data, uint64_t size) -> int64_t
+        {
+            return static_cast<MemoryOutputStream*> (s->ctx)->write (data, (size_t) size) ? (int64_t) size : -1;
+        };
+
+        if (! stateExtension->save (plugin, &stream))
+            destData.reset();
+    }
+
+    void setStateInformation (const void* data, int sizeInBytes) override
+    {
+        if (stateExtension == nullptr || data == nullptr || sizeInBytes <= 0)
+            return;
+
+        MemoryInputStream in (data, (size_t) sizeInBytes, false);
+
+        clap_istream_t stream{};
+        stream.ctx = &in;
+        stream.read = [] (const clap_istream_t* s, void* buffer, uint64_t size) -> int64_t
+        {
+            return static_cast<MemoryInputStream*> (s->ctx)->read (buffer, (int) jmin (size, (uint64_t) std::numeric_limits<int>::max()));
+        };
+
+        if (stateExtension->load (plugin, &stream))
+            refreshParameterValues();
+    }
+
+private:
+    //==============================================================================
+    struct HostContext
+    {
+        HostContext()
+        {
+            host.clap_version = CLAP_VERSION;
+            host.host_data = this;
+            host.name = "JUCE";
+            host.vendor = "JUCE";
+            host.url = "https://juce.com";
+            host.version = versionString.toRawUTF8();
+            host.get_extension = getHostExtension;
+            host.request_restart = [] (const clap_host_t* h) { getContext (h).request (HostContext::restart); };
+            host.request_process = [] (const clap_host_t*) {};
+            host.request_callback = [] (const clap_host_t* h) { getContext (h).request (HostContext::callback); };
+        }
+
+        enum Request : uint32_t
+        {
+            restart         = 1 << 0,
+            callback        = 1 << 1,
+            flush           = 1 << 2,
+            latencyChanged  = 1 << 3,
+            rescanValues    = 1 << 4,
+            markDirty       = 1 << 5
+        };
+
+        void request (Request r)
+        {
+            requests.fetch_or (r);
+
+            if (auto* instance = owner.load())
+                instance->triggerAsyncUpdate();
+        }
+
+        const String versionString { SystemStats::getJUCEVersion().fromFirstOccurrenceOf ("v", false, false) };
+        clap_host_t host{};
+        std::atomic<CLAPPluginInstance*> owner { nullptr };
+        std::atomic<uint32_t> requests { 0 };
+    };
+
+    static HostContext& getContext (const clap_host_t* host)
+    {
+        return *static_cast<HostContext*> (host->host_data);
+    }
+
+    static CLAPPluginInstance* getOwner (const clap_host_t* host)
+    {
+        return getContext (host).owner.load();
+    }
+
+    static const void* getHostExtension (const clap_host_t*, const char* id)
+    {
+        static const clap_host_log_t log
+        {
+            [] (const clap_host_t*, clap_log_severity severity, const char* message)
+            {
+                if (severity >= CLAP_LOG_WARNING)
+                    JUCE_CLAP_LOG ("CLAP: " + CLAPHelpers::toString (message))
+            }
+        };
+
+        static const clap_host_thread_check_t threadCheck
+        {
+            [] (const clap_host_t*) { return MessageManager::existsAndIsCurrentThread(); },
+            [] (const clap_host_t* h)
+            {
+                auto* owner = getOwner (h);
+                return owner != nullptr && owner->audioThreadId.load() == Thread::getCurrentThreadId();
+            }
+        };
+
+        static const clap_host_params_t params
+        {
+            [] (const clap_host_t* h, clap_param_rescan_flags flags)
+            {
+                if ((flags & (CLAP_PARAM_RESCAN_VALUES | CLAP_PARAM_RESCAN_ALL)) != 0)
+                    getContext (h).request (HostContext::rescanValues);
+            },
+            [] (const clap_host_t*, clap_id, clap_param_clear_flags) {},
+            [] (const clap_host_t* h) { getContext (h).request (HostContext::flush); }
+        };
+
+        static const clap_host_latency_t latency
+        {
+            [] (const clap_host_t* h) { getContext (h).request (HostContext::latencyChanged); }
+        };
+
+        static const clap_host_tail_t tail
+        {
+            [] (const clap_host_t*) {}
+        };
+
+        static const clap_host_state_t state
+        {
+            [] (const clap_host_t* h) { getContext (h).request (HostContext::markDirty); }
+        };
+
+        static const clap_host_note_ports_t notePorts
+        {
+            [] (const clap_host_t*) -> uint32_t { return CLAP_NOTE_DIALECT_CLAP | CLAP_NOTE_DIALECT_MIDI; },
+            [] (const clap_host_t*, uint32_t) {}
+        };
+
+        static const clap_host_audio_ports_t audioPorts
+        {
+            [] (const clap_host_t*, uint32_t) { return false; },
+            [] (const clap_host_t*, uint32_t) {}
+        };
+
+        static const clap_host_thread_pool_t threadPool
+        {
+            [] (const clap_host_t* h, uint32_t numTasks)
+            {
+                auto* owner = getOwner (h);
+
+                if (owner == nullptr || owner->threadPoolExtension == nullptr || ! owner->isInsideProcess)
+                    return false;
+
+                auto* pool = RealtimeThreadPool::getPoolForCurrentThread();
+
+                if (pool == nullptr)
+                    return false;
+
+                pool->runTasksAndWait ((int) numTasks, [owner] (int task)
+                {
+                    owner->threadPoolExtension->exec (owner->plugin, (uint32_t) task);
+                });
+
+                return true;
+            }
+        };
+
+        const auto is = [id] (const char* name) { return std::strcmp (id, name) == 0; };
+
+        if (is (CLAP_EXT_LOG))          return &log;
+        if (is (CLAP_EXT_THREAD_CHECK)) return &threadCheck;
+        if (is (CLAP_EXT_PARAMS))       return &params;
+        if (is (CLAP_EXT_LATENCY))      return &latency;
+        if (is (CLAP_EXT_TAIL))         return &tail;
+        if (is (CLAP_EXT_STATE))        return &state;
+        if (is (CLAP_EXT_NOTE_PORTS))   return &notePorts;
+        if (is (CLAP_EXT_AUDIO_PORTS))  return &audioPorts;
+        if (is (CLAP_EXT_THREAD_POOL))  return &threadPool;
+
+        return nullptr;
+    }
+
+    //==============================================================================
+    class CLAPParameter final : public Parameter
+    {
+    public:
+        CLAPParameter (CLAPPluginInstance& ownerIn, size_t indexIn, const clap_param_info_t& infoIn)
+            : owner (ownerIn),
+              index (indexIn),
+              info (infoIn),
+              name (CLAPHelpers::toString (infoIn.name))
+        {
+        }
+
+        float getValue() const override
+        {
+            return owner.paramCache.get (index);
+        }
+
+        void setValue (float newValue) override
+        {
+            owner.paramCache.setValueAndBits (index, newValue, 1);
+
+            if (! owner.isActive)
+                owner.context->request (HostContext::flush);
+        }
+
+        /*  Called when the plugin itself changes the value. */
+        void setValueWithoutUpdatingProcessor (float newValue)
+        {
+            if (! exactlyEqual (owner.paramCache.exchangeValue (index, newValue), newValue))
+                sendValueChangedMessageToListeners (newValue);
+        }
+
+        float getDefaultValue() const override          { return toNormalised (info.default_value); }
+        String getName (int maximumLength) const override { return name.substring (0, maximumLength); }
+        String getLabel() const override                { return {}; }
+        String getParameterID() const override          { return String (info.id); }
+        bool isAutomatable() const override             { return (info.flags & CLAP_PARAM_IS_AUTOMATABLE) != 0; }
+        bool isDiscrete() const override                { return isStepped(); }
+        bool isBoolean() const override                 { return isStepped() && exactlyEqual (info.max_value - info.min_value, 1.0); }
+
+        int getNumSteps() const override
+        {
+            return isStepped() ? (int) (info.max_value - info.min_value) + 1
+                               : AudioProcessor::getDefaultNumParameterSteps();
+        }
+
+        String getText (float value, int maximumLength) const override
+        {
+            // value_to_text may only be called from the main thread
+            if (owner.paramsExtension->value_to_text != nullptr && MessageManager::existsAndIsCurrentThread())
+            {
+                char text[CLAP_NAME_SIZE] {};
+
+                if (owner.paramsExtension->value_to_text (owner.plugin, info.id, toPlain (value), text, (uint32_t) sizeof (text)))
+                    return CLAPHelpers::toString (text).substring (0, maximumLength);
+            }
+
+            return String (toPlain (value), isStepped() ? 0 : 2).substring (0, maximumLength);
+        }
+
+        float getValueForText (const String& text) const override
+        {
+            if (owner.paramsExtension->text_to_value != nullptr && MessageManager::existsAndIsCurrentThread())
+            {
+                double plain = 0.0;
+
+                if (owner.paramsExtension->text_to_value (owner.plugin, info.id, text.toRawUTF8(), &plain))
+                    return toNormalised (plain);
+            }
+
+            return toNormalised (text.getDoubleValue());
+        }
+
+        double toPlain (float normalised) const
+        {
+            const auto plain = jmap ((double) normalised, info.min_value, info.max_value);
+            return isStepped() ? std::round (plain) : plain;
+        }
+
+        float toNormalised (double plain) const
+        {
+            const auto range = info.max_value - info.min_value;
+            return range > 0.0 ? (float) jlimit (0.0, 1.0, (plain - info.min_value) / range) : 0.0f;
+        }
+
+        const clap_param_info_t& getInfo() const noexcept  { return info; }
+
+    private:
+        bool isStepped() const noexcept                 { return (info.flags & CLAP_PARAM_IS_STEPPED) != 0; }
+
+        CLAPPluginInstance& owner;
+        const size_t index;
+        const clap_param_info_t info;
+        const String name;
+    };
+
+    //==============================================================================
+    CLAPPluginInstance (CLAPModule::Ptr moduleIn, std::unique_ptr<HostContext> contextIn,
+                        const clap_plugin_t* pluginIn, const BusesProperties& buses)
+        : AudioPluginInstance (buses),
+          module (std::move (moduleIn)),
+          context (std::move (contextIn)),
+          plugin (pluginIn),
+          paramsExtension (CLAPHelpers::getExtension<clap_plugin_params_t> (plugin, CLAP_EXT_PARAMS)),
+          stateExtension (CLAPHelpers::getExtension<clap_plugin_state_t> (plugin, CLAP_EXT_STATE)),
+          latencyExtension (CLAPHelpers::getExtension<clap_plugin_latency_t> (plugin, CLAP_EXT_LATENCY)),
+          tailExtension (CLAPHelpers::getExtension<clap_plugin_tail_t> (plugin, CLAP_EXT_TAIL)),
+          threadPoolExtension (CLAPHelpers::getExtension<clap_plugin_thread_pool_t> (plugin, CLAP_EXT_THREAD_POOL)),
+          pluginLayout (getBusesLayout())
+    {
+        if (auto* notePorts = CLAPHelpers::getExtension<clap_plugin_note_ports_t> (plugin, CLAP_EXT_NOTE_PORTS))
+        {
+            numNoteInputPorts = notePorts->count (plugin, true);
+            numNoteOutputPorts = notePorts->count (plugin, false);
+
+            clap_note_port_info_t info{};
+
+            if (numNoteInputPorts > 0 && notePorts->get (plugin, 0, true, &info))
+                sendNotesAsMidi = (info.supported_dialects & CLAP_NOTE_DIALECT_MIDI) != 0
+                                  && info.preferred_dialect != CLAP_NOTE_DIALECT_CLAP;
+        }
+
+        createParameters();
+
+        outputEvents.ctx = this;
+        outputEvents.try_push = [] (const clap_output_events_t* list, const clap_event_header_t* event)
+        {
+            static_cast<CLAPPluginInstance*> (list->ctx)->handleOutputEvent (*event);
+            return true;
+        };
+
+        context->owner = this;
+
+        if (context->requests.load() != 0)
+            triggerAsyncUpdate();
+    }
+
+    void createParameters()
+    {
+        if (paramsExtension == nullptr)
+            return;
+
+        const auto numParams = (size_t) paramsExtension->count (plugin);
+        paramCache = FlaggedFloatCache<1> (numParams);
+
+        for (size_t i = 0; i < numParams; ++i)
+        {
+            clap_param_info_t info{};
+
+            if (! paramsExtension->get_info (plugin, (uint32_t) i, &info))
+                info.id = CLAP_INVALID_ID;
+
+            auto param = std::make_unique<CLAPParameter> (*this, i, info);
+            clapParameters.push_back (param.get());
+            parameterIndices[info.id] = i;
+
+            double value = info.default_value;
+            paramsExtension->get_value (plugin, info.id, &value);
+            paramCache.exchangeValue (i, param->toNormalised (value));
+
+            addHostedParameter (std::move (param));
+        }
+    }
+
+    void refreshParameterValues()
+    {
+        if (paramsExtension == nullptr)
+            return;
+
+        for (auto* param : clapParameters)
+        {
+            double value = 0.0;
+
+            if (paramsExtension->get_value (plugin, param->getInfo().id, &value))
+                param->setValueWithoutUpdatingProcessor (param->toNormalised (value));
+        }
+    }
+
+    //==============================================================================
+    bool startProcessing()
+    {
+        processingStarted = plugin->start_processing == nullptr || plugin->start_processing (plugin);
+        return processingStarted;
+    }
+
+    void deactivate()
+    {
+        if (! isActive)
+            return;
+
+        if (processingStarted && plugin->stop_processing != nullptr)
+            plugin->stop_processing (plugin);
+
+        plugin->deactivate (plugin);
+        processingStarted = false;
+        isActive = false;
+    }
+
+    void updateLatency()
+    {
+        if (latencyExtension != nullptr && isActive)
+            setLatencySamples ((int) latencyExtension->get (plugin));
+    }
+
+    void flushParametersIfInactive()
+    {
+        if (isActive || paramsExtension == nullptr || paramsExtension->flush == nullptr)
+            return;
+
+        inputEvents.reserve (paramCache.size());
+        inputEvents.clear();
+        addParameterEvents (0);
+        outputEventOffset = 0;
+        outputMidi.clear();
+        paramsExtension->flush (plugin, inputEvents.get(), &outputEvents);
+    }
+
+    void handleAsyncUpdate() override
+    {
+        const auto requests = context->requests.exchange (0);
+
+        if ((requests & HostContext::restart) != 0 && isActive)
+        {
+            const ScopedLock sl (getCallbackLock());
+            prepareToPlay (getSampleRate(), getBlockSize());
+        }
+
+        if ((requests & HostContext::callback) != 0 && plugin->on_main_thread != nullptr)
+            plugin->on_main_thread (plugin);
+
+        if ((requests & HostContext::flush) != 0)
+            flushParametersIfInactive();
+
+        if ((requests & HostContext::latencyChanged) != 0)
+            updateLatency();
+
+        if ((requests & HostContext::rescanValues) != 0)
+            refreshParameterValues();
+
+        if ((requests & HostContext::markDirty) != 0)
+            updateHostDisplay (ChangeDetails{}.withNonParameterStateChanged (true));
+    }
+
+    //==============================================================================
+    void addParameterEvents (int time)
+    {
+        paramCache.ifSet ([this, time] (size_t index, float value, uint32_t)
+        {
+            const auto* param = clapParameters[index];
+
+            clap_event_param_value_t event{};
+            event.header = CLAPHelpers::makeHeader (sizeof (event), CLAP_EVENT_PARAM_VALUE, time);
+            event.param_id = param->getInfo().id;
+            event.cookie = param->getInfo().cookie;
+            event.note_id = -1;
+            event.port_index = -1;
+            event.channel = -1;
+            event.key = -1;
+            event.value = param->toPlain (value);
+            inputEvents.add (event);
+        });
+    }
+
+    void addMidiEvents (const MidiBuffer& midi, int start, int numFrames)
+    {
+        if (numNoteInputPorts == 0)
+            return;
+
+        const auto end = midi.findNextSamplePosition (start + numFrames);
+
+        for (auto iter = midi.findNextSamplePosition (start); iter != end; ++iter)
+        {
+            const auto metadata = *iter;
+            const auto time = metadata.samplePosition - start;
+            const auto message = metadata.getMessage();
+
+            if (message.isSysEx())
+            {
+                clap_event_midi_sysex_t event{};
+                event.header = CLAPHelpers::makeHeader (sizeof (event), CLAP_EVENT_MIDI_SYSEX, time);
+                event.port_index = 0;
+                event.buffer = metadata.data;
+                event.size = (uint32_t) metadata.numBytes;
+                inputEvents.add (event);
+            }
+            else if (! sendNotesAsMidi && (message.isNoteOn() || message.isNoteOff()))
+            {
+                clap_event_note_t event{};
+                event.header = CLAPHelpers::makeHeader (sizeof (event),
+                                                        message.isNoteOn() ? CLAP_EVENT_NOTE_ON : CLAP_EVENT_NOTE_OFF,
+                                                        time);
+                event.note_id = -1;
+                event.port_index = 0;
+                event.channel = (int16_t) (message.getChannel() - 1);
+                event.key = (int16_t) message.getNoteNumber();
+                event.velocity = (double) message.getFloatVelocity();
+                inputEvents.add (event);
+            }
+            else if (metadata.numBytes <= 3)
+            {
+                clap_event_midi_t event{};
+                event.header = CLAPHelpers::makeHeader (sizeof (event), CLAP_EVENT_MIDI, time);
+                event.port_index = 0;
+                std::copy (metadata.data, metadata.data + metadata.numBytes, event.data);
+                inputEvents.add (event);
+            }
+        }
+    }
+
+    void handleOutputEvent (const clap_event_header_t& header)
+    {
+        if (header.space_id != CLAP_CORE_EVENT_SPACE_ID)
+            return;
+
+        const auto time = (int) header.time + outputEventOffset;
+
+        switch (header.type)
+        {
+            case CLAP_EVENT_NOTE_ON:
+            case CLAP_EVENT_NOTE_OFF:
+            {
+                const auto& event = reinterpret_cast<const clap_event_note_t&> (header);
+
+                if (event.key < 0 || event.channel < 0)
+                    break;
+
+                const auto channel = jlimit (1, 16, event.channel + 1);
+                const auto message = header.type == CLAP_EVENT_NOTE_ON
+                                   ? MidiMessage::noteOn (channel, event.key, (float) event.velocity)
+                                   : MidiMessage::noteOff (channel, event.key, (float) event.velocity);
+                outputMidi.addEvent (message, time);
+                break;
+            }
+
+            case CLAP_EVENT_MIDI:
+            {
+                const auto& event = reinterpret_cast<const clap_event_midi_t&> (header);
+                outputMidi.addEvent (event.data, MidiMessage::getMessageLengthFromFirstByte (event.data[0]), time);
+                break;
+            }
+
+            case CLAP_EVENT_MIDI_SYSEX:
+            {
+                const auto& event = reinterpret_cast<const clap_event_midi_sysex_t&> (header);
+                outputMidi.addEvent (event.buffer, (int) event.size, time);
+                break;
+            }
+
+            case CLAP_EVENT_PARAM_VALUE:
+            {
+                const auto& event = reinterpret_cast<const clap_event_param_value_t&> (header);
+
+                if (auto* param = findParameter (event.param_id))
+                    param->setValueWithoutUpdatingProcessor (param->toNormalised (event.value));
+
+                break;
+            }
+
+            case CLAP_EVENT_PARAM_GESTURE_BEGIN:
+            case CLAP_EVENT_PARAM_GESTURE_END:
+            {
+                const auto& event = reinterpret_cast<const clap_event_param_gesture_t&> (header);
+
+                if (auto* param = findParameter (event.param_id))
+                {
+                    if (header.type == CLAP_EVENT_PARAM_GESTURE_BEGIN)
+                        param->beginChangeGesture();
+                    else
+                        param->endChangeGesture();
+                }
+
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    CLAPParameter* findParameter (clap_id id) const
+    {
+        const auto iter = parameterIndices.find (id);
+        return iter != parameterIndices.end() ? clapParameters[iter->second] : nullptr;
+    }
+
+    //==============================================================================
+    void setUpAudioBuffers (AudioBuffer<float>& buffer, int start)
+    {
+        auto** inputs = inputChannels.data();
+        auto** outputs = outputChannels.data();
+
+        for (auto bus = 0; bus < getBusCount (true); ++bus)
+        {
+            auto& clapBuffer = inputBuffers[(size_t) bus];
+            clapBuffer = {};
+            clapBuffer.data32 = inputs;
+            clapBuffer.channel_count = (uint32_t) getChannelCountOfBus (true, bus);
+
+            for (uint32_t i = 0; i < clapBuffer.channel_count; ++i)
+                *inputs++ = inputScratch.getWritePointer (getChannelIndexInProcessBlockBuffer (true, bus, (int) i));
+        }
+
+        for (auto bus = 0; bus < getBusCount (false); ++bus)
+        {
+            auto& clapBuffer = outputBuffers[(size_t) bus];
+            clapBuffer = {};
+            clapBuffer.data32 = outputs;
+            clapBuffer.channel_count = (uint32_t) getChannelCountOfBus (false, bus);
+
+            for (uint32_t i = 0; i < clapBuffer.channel_count; ++i)
+                *outputs++ = buffer.getWritePointer (getChannelIndexInProcessBlockBuffer (false, bus, (int) i), start);
+        }
+    }
+
+    bool updateTransport (clap_event_transport_t& transport) const
+    {
+        auto* currentPlayHead = getPlayHead();
+
+        if (currentPlayHead == nullptr)
+            return false;
+
+        const auto position = currentPlayHead->getPosition();
+
+        if (! position.hasValue())
+            return false;
+
+        transport.header = CLAPHelpers::makeHeader (sizeof (transport), CLAP_EVENT_TRANSPORT, 0);
+
+        if (const auto bpm = position->getBpm())
+        {
+            transport.flags |= CLAP_TRANSPORT_HAS_TEMPO;
+            transport.tempo = *bpm;
+        }
+
+        if (const auto ppq = position->getPpqPosition())
+        {
+            transport.flags |= CLAP_TRANSPORT_HAS_BEATS_TIMELINE;
+            transport.song_pos_beats = CLAPHelpers::toBeatTime (*ppq);
+            transport.bar_start = CLAPHelpers::toBeatTime (position->getPpqPositionOfLastBarStart().orFallback (0.0));
+            transport.bar_number = (int32_t) position->getBarCount().orFallback (0);
+
+            if (const auto loop = position->getLoopPoints())
+            {
+                transport.loop_start_beats = CLAPHelpers::toBeatTime (loop->ppqStart);
+                transport.loop_end_beats = CLAPHelpers::toBeatTime (loop->ppqEnd);
+            }
+        }
+
+        if (const auto seconds = position->getTimeInSeconds())
+        {
+            transport.flags |= CLAP_TRANSPORT_HAS_SECONDS_TIMELINE;
+            transport.song_pos_seconds = CLAPHelpers::toSecTime (*seconds);
+        }
+
+        if (const auto timeSignature = position->getTimeSignature())
+        {
+            transport.flags |= CLAP_TRANSPORT_HAS_TIME_SIGNATURE;
+            transport.tsig_num = (uint16_t) timeSignature->numerator;
+            transport.tsig_denom = (uint16_t) timeSignature->denominator;
+        }
+
+        if (position->getIsPlaying())    transport.flags |= CLAP_TRANSPORT_IS_PLAYING;
+        if (position->getIsRecording())  transport.flags |= CLAP_TRANSPORT_IS_RECORDING;
+        if (position->getIsLooping())    transport.flags |= CLAP_TRANSPORT_IS_LOOP_ACTIVE;
+
+        return true;
+    }
+
+    void advanceTransport (clap_event_transport_t& transport, int numSamples) const
+    {
+        if ((transport.flags & CLAP_TRANSPORT_IS_PLAYING) == 0)
+            return;
+
+        const auto seconds = numSamples / getSampleRate();
+
+        if ((transport.flags & CLAP_TRANSPORT_HAS_SECONDS_TIMELINE) != 0)
+            transport.song_pos_seconds += CLAPHelpers::toSecTime (seconds);
+
+        if ((transport.flags & (CLAP_TRANSPORT_HAS_BEATS_TIMELINE | CLAP_TRANSPORT_HAS_TEMPO))
+                == (CLAP_TRANSPORT_HAS_BEATS_TIMELINE | CLAP_TRANSPORT_HAS_TEMPO))
+            transport.song_pos_beats += CLAPHelpers::toBeatTime (seconds * transport.tempo / 60.0);
+    }
+
+    //==============================================================================
+    const CLAPModule::Ptr module;
+    const std::unique_ptr<HostContext> context;
+    const clap_plugin_t* const plugin;
+
+    const clap_plugin_params_t* const paramsExtension;
+    const clap_plugin_state_t* const stateExtension;
+    const clap_plugin_latency_t* const latencyExtension;
+    const clap_plugin_tail_t* const tailExtension;
+    const clap_plugin_thread_pool_t* const threadPoolExtension;
+
+    const BusesLayout pluginLayout;
+    uint32_t numNoteInputPorts = 0, numNoteOutputPorts = 0;
+    bool sendNotesAsMidi = false;
+
+    FlaggedFloatCache<1> paramCache;
+    std::vector<CLAPParameter*> clapParameters;
+    std::unordered_map<clap_id, size_t> parameterIndices;
+
+    CLAPInputEventList inputEvents;
+    clap_output_events_t outputEvents{};
+    MidiBuffer outputMidi;
+    int outputEventOffset = 0;
+
+    AudioBuffer<float> inputScratch;
+    std::vector<float*> inputChannels, outputChannels;
+    std::vector<clap_audio_buffer_t> inputBuffers, outputBuffers;
+
+    int maxFramesCount = 0;
+    int64_t steadyTime = 0;
+    std::atomic<bool> isActive { false };
+    bool processingStarted = false, isInsideProcess = false;
+    std::atomic<Thread::ThreadID> audioThreadId { nullptr };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CLAPPluginInstance)
+};
+
+//==============================================================================
+CLAPPluginFormat::CLAPPluginFormat() {}
+CLAPPluginFormat::~CLAPPluginFormat() {}
+
+void CLAPPluginFormat::findAllTypesForFile (OwnedArray<PluginDescription>& results, const String& fileOrIdentifier)
+{
+    if (! fileMightContainThisPluginType (fileOrIdentifier))
+        return;
+
+    const auto file = File (fileOrIdentifier);
+    const CLAPModule::Ptr module (CLAPModule::findOrCreateModule (file));
+
+    if (module == nullptr)
+        return;
+
+    for (uint32_t i = 0; i < module->getNumDescriptors(); ++i)
+    {
+        if (auto* descriptor = module->getDescriptor (i))
+        {
+            PluginDescription desc;
+            CLAPPluginInstance::fillInDescription (desc, file, *descriptor);
+
+            if (! arrayContainsPlugin (results, desc))
+                results.add (new PluginDescription (desc));
+        }
+    }
+}
+
+void CLAPPluginFormat::createPluginInstance (const PluginDescription& desc,
+                                             double sampleRate, int blockSize,
+                                             PluginCreationCallback callback)
+{
+    std::unique_ptr<CLAPPluginInstance> result;
+
+    if (fileMightContainThisPluginType (desc.fileOrIdentifier))
+    {
+        const CLAPModule::Ptr module (CLAPModule::findOrCreateModule (File (desc.fileOrIdentifier)));
+
+        if (module != nullptr)
+        {
+            if (auto* descriptor = module->findDescriptor (desc.uniqueId != 0 ? desc.uniqueId : desc.deprecatedUid))
+            {
+                result = CLAPPluginInstance::create (module, *descriptor);
+
+                if (result != nullptr)
+                    result->setRateAndBufferSizeDetails (sampleRate, blockSize);
+            }
+        }
+    }
+
+    String errorMsg;
+
+    if (result == nullptr)
+        errorMsg = TRANS ("Unable to load XXX plug-in file").replace ("XXX", "CLAP");
+
+    callback (std::move (result), errorMsg);
+}
+
+bool CLAPPluginFormat::requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const
+{
+    return false;
+}
+
+bool CLAPPluginFormat::fileMightContainThisPluginType (const String& fileOrIdentifier)
+{
+    auto f = File::createFileWithoutCheckingPath (fileOrIdentifier);
+
+   #if JUCE_MAC
+    return f.isDirectory() && f.hasFileExtension (".clap");
+   #else
+    return f.existsAsFile() && f.hasFileExtension (".clap");
+   #endif
+}
+
+String CLAPPluginFormat::getNameOfPluginFromIdentifier (const String& fileOrIdentifier)
+{
+    return fileOrIdentifier;
+}
+
+bool CLAPPluginFormat::pluginNeedsRescanning (const PluginDescription& desc)
+{
+    return File (desc.fileOrIdentifier).getLastModificationTime() != desc.lastFileModTime;
+}
+
+bool CLAPPluginFormat::doesPluginStillExist (const PluginDescription& desc)
+{
+    return File::createFileWithoutCheckingPath (desc.fileOrIdentifier).exists();
+}
+
+StringArray CLAPPluginFormat::searchPathsForPlugins (const FileSearchPath& directoriesToSearch, const bool recursive, bool)
+{
+    StringArray results;
+
+    for (int j = 0; j < directoriesToSearch.getNumPaths(); ++j)
+        recursiveFileSearch (results, directoriesToSearch[j], recursive);
+
+    return results;
+}
+
+void CLAPPluginFormat::recursiveFileSearch (StringArray& results, const File& dir, const bool recursive)
+{
+    for (const auto& iter : RangedDirectoryIterator (dir, false, "*", File::findFilesAndDirectories))
+    {
+        auto f = iter.getFile();
+        bool isPlugin = false;
+
+        if (fileMightContainThisPluginType (f.getFullPathName()))
+        {
+            isPlugin = true;
+            results.add (f.getFullPathName());
+        }
+
+        if (recursive && (! isPlugin) && f.isDirectory())
+            recursiveFileSearch (results, f, true);
+    }
+}
+
+FileSearchPath CLAPPluginFormat::getDefaultLocationsToSearch()
+{
+   #if JUCE_MAC
+    return { "~/Library/Audio/Plug-Ins/CLAP;/Library/Audio/Plug-Ins/CLAP" };
+   #elif JUCE_WINDOWS
+    const auto commonFiles = SystemStats::getEnvironmentVariable ("COMMONPROGRAMFILES", "C:\\Program Files\\Common Files");
+    const auto localPrograms = File::getSpecialLocation (File::windowsLocalAppData).getChildFile ("Programs\\Common");
+
+    return { SystemStats::getEnvironmentVariable ("CLAP_PATH", {})
+               + ";" + File (commonFiles).getChildFile ("CLAP").getFullPathName()
+               + ";" + localPrograms.getChildFile ("CLAP").getFullPathName() };
+   #else
+    return { SystemStats::getEnvironmentVariable ("CLAP_PATH", "").replace (":", ";")
+               + ";~/.clap;/usr/lib/clap" };
+   #endif
+}
+
+} // namespace juce
+
+#endif
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if (JUCE_PLUGINHOST_CLAP && (JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX || JUCE_BSD)) || DOXYGEN
+
+//==============================================================================
+/**
+    Implements a plugin format for CLAP plugins.
+
+    The CLAP SDK headers aren't shipped with JUCE; when JUCE_PLUGINHOST_CLAP is
+    enabled, the folder containing clap/clap.h must be on your include path.
+
+    Parameter changes and MIDI are passed to the plugin as sample-accurate CLAP
+    event lists. Plugins which use the clap.thread-pool extension will have their
+    tasks spread across the RealtimeThreadPool of the AudioProcessorGraph that is
+    rendering them, if any, and will otherwise run them on their own thread.
+
+    Plugin editors aren't hosted yet, so hasEditor() always returns false.
+
+    @tags{Audio}
+*/
+class JUCE_API  CLAPPluginFormat   : public AudioPluginFormat
+{
+public:
+    CLAPPluginFormat();
+    ~CLAPPluginFormat() override;
+
+    //==============================================================================
+    static String getFormatName()                   { return "CLAP"; }
+    String getName() const override                 { return getFormatName(); }
+    bool canScanForPlugins() const override         { return true; }
+    bool isTrivialToScan() const override           { return false; }
+
+    void findAllTypesForFile (OwnedArray<PluginDescription>&, const String& fileOrIdentifier) override;
+    bool fileMightContainThisPluginType (const String& fileOrIdentifier) override;
+    String getNameOfPluginFromIdentifier (const String& fileOrIdentifier) override;
+    bool pluginNeedsRescanning (const PluginDescription&) override;
+    StringArray searchPathsForPlugins (const FileSearchPath&, bool recursive, bool) override;
+    bool doesPluginStillExist (const PluginDescription&) override;
+    FileSearchPath getDefaultLocationsToSearch() override;
+
+private:
+    //==============================================================================
+    void createPluginInstance (const PluginDescription&, double initialSampleRate,
+                               int initialBufferSize, PluginCreationCallback) override;
+    bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const override;
+    void recursiveFileSearch (StringArray&, const File&, bool recursive);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CLAPPluginFormat)
+};
+
+#endif
+
+} // namespace juce
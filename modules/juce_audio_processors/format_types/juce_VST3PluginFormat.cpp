@@ -188,9 +188,80 @@ static void fillDescriptionWith (PluginDescription& description, ObjectType& obj
         description.manufacturerName = toString (object.vendor).trim();
 }
 
+/*  Returns a string that changes whenever the files that make up a plugin change, without
+    loading the plugin. The modification time of a bundle directory doesn't always change when
+    the plugin inside it is updated, so this looks at the module binaries and moduleinfo.json
+    inside the bundle instead. Each file contributes its size, modification time, and a hash of
+    the start and end of its contents, which catches updates that preserve timestamps without
+    reading the whole of a large binary.
+*/
+static String getFileFingerprint (const File& pluginFile)
+{
+    Array<File> files;
+
+    if (pluginFile.isDirectory())
+    {
+        const auto contents = pluginFile.getChildFile ("Contents");
+
+        for (const auto& entry : RangedDirectoryIterator (contents, false, "*", File::findFilesAndDirectories))
+        {
+            const auto& file = entry.getFile();
+
+            // Resources may contain a large number of files that don't affect the plugin descriptions
+            if (! entry.isDirectory())
+                files.add (file);
+            else if (file.getFileName() != "Resources")
+                files.addArray (file.findChildFiles (File::findFiles, false));
+        }
+
+        files.add (contents.getChildFile ("Resources").getChildFile ("moduleinfo.json"));
+    }
+    else
+    {
+        files.add (pluginFile);
+    }
+
+    files.sort();
+
+    // 64-bit FNV-1a
+    uint64 hash = 0xcbf29ce484222325;
+
+    const auto addToHash = [&hash] (const void* data, size_t numBytes)
+    {
+        for (size_t i = 0; i < numBytes; ++i)
+            hash = (hash ^ static_cast<const uint8*> (data)[i]) * 0x100000001b3;
+    };
+
+    constexpr int sampleSize = 1 << 16;
+    HeapBlock<char> sample (sampleSize);
+
+    for (const auto& file : files)
+    {
+        FileInputStream stream (file);
+
+        if (! stream.openedOk())
+            continue;
+
+        const auto path = file.getRelativePathFrom (pluginFile);
+        addToHash (path.toRawUTF8(), path.getNumBytesAsUTF8());
+
+        const int64 details[] { stream.getTotalLength(), file.getLastModificationTime().toMilliseconds() };
+        addToHash (details, sizeof (details));
+
+        for (const auto position : { (int64) 0, jmax ((int64) 0, stream.getTotalLength() - sampleSize) })
+        {
+            stream.setPosition (position);
+            addToHash (sample, (size_t) jmax (0, stream.read (sample, sampleSize)));
+        }
+    }
+
+    return String::toHexString ((int64) hash);
+}
+
 static std::vector<PluginDescription> createPluginDescriptions (const File& pluginFile, const Steinberg::ModuleInfo& info)
 {
     std::vector<PluginDescription> result;
+    const auto fingerprint = getFileFingerprint (pluginFile);
 
     const auto araMainFactoryClassNames = [&]
     {
@@ -214,6 +285,7 @@ static std::vector<PluginDescription> createPluginDescriptions (const File& plug
 
         description.fileOrIdentifier    = pluginFile.getFullPathName();
         description.lastFileModTime     = pluginFile.getLastModificationTime();
+        description.fileFingerprint     = fingerprint;
         description.lastInfoUpdateTime  = Time::getCurrentTime();
         description.manufacturerName    = CharPointer_UTF8 (info.factoryInfo.vendor.c_str());
         description.name                = CharPointer_UTF8 (c.name.c_str());
@@ -256,6 +328,7 @@ static void createPluginDescription (PluginDescription& description,
 {
     description.fileOrIdentifier    = pluginFile.getFullPathName();
     description.lastFileModTime     = pluginFile.getLastModificationTime();
+    description.fileFingerprint     = getFileFingerprint (pluginFile);
     description.lastInfoUpdateTime  = Time::getCurrentTime();
     description.manufacturerName    = company;
     description.name                = name;
@@ -3994,7 +4067,12 @@ String VST3PluginFormat::getNameOfPluginFromIdentifier (const String& fileOrIden
 
 bool VST3PluginFormat::pluginNeedsRescanning (const PluginDescription& description)
 {
-    return File (description.fileOrIdentifier).getLastModificationTime() != description.lastFileModTime;
+    const File file (description.fileOrIdentifier);
+
+    if (description.fileFingerprint.isNotEmpty())
+        return getFileFingerprint (file) != description.fileFingerprint;
+
+    return file.getLastModificationTime() != description.lastFileModTime;
 }
 
 bool VST3PluginFormat::doesPluginStillExist (const PluginDescription& description)
@@ -567,6 +567,39 @@ public:
                 expect (channelSet == getChannelSetForSpeakerArrangement (arr));
             }
         }
+
+       #if JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX || JUCE_BSD
+        beginTest ("File fingerprints change when a bundle's binary changes, even if its timestamps don't");
+        {
+            const TemporaryFile temp;
+            const auto bundle = temp.getFile().withFileExtension ("vst3");
+            const auto contents = bundle.getChildFile ("Contents");
+            const auto binary = contents.getChildFile ("x86_64-linux").getChildFile ("Plugin.so");
+            const auto resource = contents.getChildFile ("Resources").getChildFile ("Preset.vstpreset");
+
+            expect (binary.create().wasOk());
+            expect (resource.create().wasOk());
+            expect (binary.replaceWithText ("version one"));
+
+            const auto original = getFileFingerprint (bundle);
+            expect (original.isNotEmpty());
+            expectEquals (getFileFingerprint (bundle), original);
+
+            // Resources other than moduleinfo.json don't affect the plugin descriptions
+            expect (resource.replaceWithText ("new preset"));
+            expectEquals (getFileFingerprint (bundle), original);
+
+            const auto modificationTime = binary.getLastModificationTime();
+            expect (binary.replaceWithText ("version two"));
+            expect (binary.setLastModificationTime (modificationTime));
+            expect (getFileFingerprint (bundle) != original);
+
+            expect (contents.getChildFile ("Resources").getChildFile ("moduleinfo.json").replaceWithText ("{}"));
+            expect (getFileFingerprint (bundle) != original);
+
+            bundle.deleteRecursively();
+        }
+       #endif
     }
 
 private:
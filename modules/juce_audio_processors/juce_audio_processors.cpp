@@ -63,7 +63,8 @@
 namespace juce
 {
 
-#if JUCE_PLUGINHOST_VST || (JUCE_PLUGINHOST_LADSPA && (JUCE_LINUX || JUCE_BSD))
+#if JUCE_PLUGINHOST_VST || (JUCE_PLUGINHOST_LADSPA && (JUCE_LINUX || JUCE_BSD)) \
+    || (JUCE_PLUGINHOST_CLAP && (JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX || JUCE_BSD))
 
 static bool arrayContainsPlugin (const OwnedArray<PluginDescription>& list,
                                  const PluginDescription& desc)
@@ -191,7 +192,6 @@ private:
 
 } // namespace juce
 
-#include "utilities/juce_FlagCache.h"
 #include "format/juce_AudioPluginFormat.cpp"
 #include "format/juce_AudioPluginFormatManager.cpp"
 #include "format_types/juce_LegacyAudioParameter.cpp"
@@ -211,6 +211,7 @@ private:
 #include "scanning/juce_PluginDirectoryScanner.cpp"
 #include "scanning/juce_PluginListComponent.cpp"
 #include "processors/juce_AudioProcessorParameterGroup.cpp"
+#include "processors/juce_AudioProcessorParameterAutomation.cpp"
 #include "utilities/juce_AudioProcessorParameterWithID.cpp"
 #include "utilities/juce_RangedAudioParameter.cpp"
 #include "utilities/juce_AudioParameterFloat.cpp"
@@ -218,15 +219,20 @@ private:
 #include "utilities/juce_AudioParameterBool.cpp"
 #include "utilities/juce_AudioParameterChoice.cpp"
 #include "utilities/juce_ParameterAttachments.cpp"
+#include "utilities/juce_AudioProcessorParameterChangeQueue.cpp"
 #include "utilities/juce_AudioProcessorValueTreeState.cpp"
+#include "utilities/juce_FixedBlockSizeProcessor.cpp"
 #include "utilities/juce_PluginHostType.cpp"
 #include "utilities/juce_AAXClientExtensions.cpp"
 #include "utilities/juce_VST2ClientExtensions.cpp"
 #include "utilities/ARA/juce_ARA_utils.cpp"
 
 #include "format_types/juce_LV2PluginFormat.cpp"
+#include "format_types/juce_CLAPPluginFormat.cpp"
 
 #if JUCE_UNIT_TESTS
+ #include "utilities/juce_FlagCache_test.cpp"
+
  #if JUCE_PLUGINHOST_VST3
   #include "format_types/juce_VST3PluginFormat_test.cpp"
  #endif
@@ -101,6 +101,15 @@
  #define JUCE_PLUGINHOST_LV2 0
 #endif
 
+/** Config: JUCE_PLUGINHOST_CLAP
+    Enables the CLAP plugin hosting classes. You will need to have the CLAP SDK headers in your header search paths.
+
+    @see CLAPPluginFormat, AudioPluginFormat, AudioPluginFormatManager, JUCE_PLUGINHOST_VST3, JUCE_PLUGINHOST_LV2
+ */
+#ifndef JUCE_PLUGINHOST_CLAP
+ #define JUCE_PLUGINHOST_CLAP 0
+#endif
+
 /** Config: JUCE_PLUGINHOST_ARA
     Enables the ARA plugin extension hosting classes. You will need to download the ARA SDK and specify the
     path to it either in the Projucer, using juce_set_ara_sdk_path() in your CMake project file.
@@ -141,6 +150,7 @@
 #include "processors/juce_AudioProcessorEditor.h"
 #include "processors/juce_AudioProcessorListener.h"
 #include "processors/juce_AudioProcessorParameterGroup.h"
+#include "processors/juce_AudioProcessorParameterAutomation.h"
 #include "processors/juce_AudioProcessor.h"
 #include "processors/juce_PluginDescription.h"
 #include "processors/juce_AudioPluginInstance.h"
@@ -152,6 +162,7 @@
 #include "format_types/juce_AudioUnitPluginFormat.h"
 #include "format_types/juce_LADSPAPluginFormat.h"
 #include "format_types/juce_LV2PluginFormat.h"
+#include "format_types/juce_CLAPPluginFormat.h"
 #include "format_types/juce_VST3PluginFormat.h"
 #include "format_types/juce_VSTMidiEventList.h"
 #include "format_types/juce_VSTPluginFormat.h"
@@ -164,8 +175,11 @@
 #include "utilities/juce_AudioParameterInt.h"
 #include "utilities/juce_AudioParameterBool.h"
 #include "utilities/juce_AudioParameterChoice.h"
+#include "utilities/juce_FlagCache.h"
 #include "utilities/juce_ParameterAttachments.h"
+#include "utilities/juce_AudioProcessorParameterChangeQueue.h"
 #include "utilities/juce_AudioProcessorValueTreeState.h"
+#include "utilities/juce_FixedBlockSizeProcessor.h"
 #include "utilities/juce_PluginHostType.h"
 #include "utilities/ARA/juce_ARADebug.h"
 #include "utilities/ARA/juce_ARA_utils.h"
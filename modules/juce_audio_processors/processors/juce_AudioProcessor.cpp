@@ -1586,9 +1586,7 @@ void AudioProcessorParameter::sendValueChangedMessageToListeners (float newValue
 {
     ScopedLock lock (listenerLock);
 
-    for (int i = listeners.size(); --i >= 0;)
-        if (auto* l = listeners [i])
-            l->parameterValueChanged (getParameterIndex(), newValue);
+    sendValueChangedMessageToParameterListeners (newValue);
 
     if (processor != nullptr && parameterIndex >= 0)
     {
@@ -1600,6 +1598,15 @@ void AudioProcessorParameter::sendValueChangedMessageToListeners (float newValue
     }
 }
 
+void AudioProcessorParameter::sendValueChangedMessageToParameterListeners (float newValue)
+{
+    ScopedLock lock (listenerLock);
+
+    for (int i = listeners.size(); --i >= 0;)
+        if (auto* l = listeners [i])
+            l->parameterValueChanged (getParameterIndex(), newValue);
+}
+
 bool AudioProcessorParameter::isOrientationInverted() const                      { return false; }
 bool AudioProcessorParameter::isAutomatable() const                              { return true; }
 bool AudioProcessorParameter::isMetaParameter() const                            { return false; }
@@ -1067,6 +1067,33 @@ public:
     /** Returns a flat list of the parameters in the current tree. */
     const Array<AudioProcessorParameter*>& getParameters() const;
 
+    //==============================================================================
+    /** Override this to return true if your processor would like to receive all of
+        the automation points that the host sends for each block, rather than just
+        the last value of each parameter.
+
+        The value returned must be valid as soon as this object is created, and
+        must not change over its lifetime.
+
+        @see getParameterAutomation
+    */
+    virtual bool supportsSampleAccurateAutomation() const          { return false; }
+
+    /** Returns the automation points for the block that is currently being processed.
+
+        This will return nullptr unless supportsSampleAccurateAutomation() returns true
+        and the plugin wrapper is able to supply the points, so you should always
+        check the result. It's only valid to use the returned object from inside
+        processBlock(). By the time processBlock() is called, each parameter will
+        already hold the value of its last point.
+
+        @see AudioProcessorParameterAutomation
+    */
+    const AudioProcessorParameterAutomation* getParameterAutomation() const noexcept    { return parameterAutomation; }
+
+    /** @internal */
+    void setParameterAutomation (AudioProcessorParameterAutomation* newAutomation) noexcept    { parameterAutomation = newAutomation; }
+
     //==============================================================================
     /** Returns the number of preset programs the processor supports.
 
@@ -1098,7 +1125,10 @@ public:
         Note that there's also a getCurrentProgramStateInformation() method, which only
         stores the current program, not the state of the entire processor.
 
-        See also the helper function copyXmlToBinary() for storing settings as XML.
+        See also the helper function copyXmlToBinary() for storing settings as XML. If your
+        state lives in an AudioProcessorValueTreeState, its writeStateSnapshot() method is
+        a cheaper alternative which never waits on your other threads, which matters when
+        a host autosaves many plugins from a background thread.
 
         @see getCurrentProgramStateInformation
     */
@@ -1538,6 +1568,7 @@ private:
 
     AudioProcessorParameterGroup parameterTree;
     Array<AudioProcessorParameter*> flatParameterList;
+    AudioProcessorParameterAutomation* parameterAutomation = nullptr;
 
     AudioProcessorParameter* getParamChecked (int) const;
 
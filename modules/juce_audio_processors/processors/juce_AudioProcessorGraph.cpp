@@ -140,13 +140,19 @@ public:
     using NodeAndChannel = AudioProcessorGraph::NodeAndChannel;
 
 private:
-    static auto equalRange (const std::set<NodeAndChannel>& pins, const NodeID node)
+    using Map = std::map<NodeAndChannel, std::set<NodeAndChannel>>;
+
+    /*  Finds all of the pins belonging to a node. This uses the container's own lower_bound
+        and upper_bound, because std::equal_range has to step through the container one
+        element at a time when given the bidirectional iterators of a set or map.
+    */
+    template <typename Container>
+    static auto equalRange (const Container& pins, const NodeID node)
     {
-        return std::equal_range (pins.cbegin(), pins.cend(), node, ImplicitNode::compare);
+        return std::make_pair (pins.lower_bound ({ node, std::numeric_limits<int>::lowest() }),
+                               pins.upper_bound ({ node, std::numeric_limits<int>::max() }));
     }
 
-    using Map = std::map<NodeAndChannel, std::set<NodeAndChannel>>;
-
 public:
     static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
 
@@ -362,7 +368,7 @@ private:
 
     std::pair<Map::const_iterator, Map::const_iterator> getMatchingDestinations (NodeID destID) const
     {
-        return std::equal_range (sourcesForDestination.cbegin(), sourcesForDestination.cend(), destID, ImplicitNode::compare);
+        return equalRange (sourcesForDestination, destID);
     }
 
     Map sourcesForDestination;
@@ -499,6 +505,7 @@ template <typename FloatType>
 struct GraphRenderSequence
 {
     using Node = AudioProcessorGraph::Node;
+    using OtherFloatType = std::conditional_t<std::is_same_v<FloatType, float>, double, float>;
 
     struct GlobalIO
     {
@@ -513,13 +520,22 @@ struct GraphRenderSequence
         GlobalIO globalIO;
         AudioPlayHead* audioPlayHead;
         int numSamples;
+        bool measureNodes;
     };
 
-    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead)
+    void perform (AudioBuffer<FloatType>& buffer,
+                  MidiBuffer& midiMessages,
+                  AudioPlayHead* audioPlayHead,
+                  RealtimeThreadPool* workers,
+                  double sampleRate,
+                  bool measureNodes)
     {
         auto numSamples = buffer.getNumSamples();
         auto maxSamples = renderingBuffer.getNumSamples();
 
+        if (! delayOps.empty())
+            installPendingDelayLines();
+
         if (numSamples > maxSamples)
         {
             // Being asked to render more samples than our buffers have, so divide the buffer into chunks
@@ -534,7 +550,7 @@ struct GraphRenderSequence
 
                 // Splitting up the buffer like this will cause the play head and host time to be
                 // invalid for all but the first chunk...
-                perform (audioChunk, midiChunk, audioPlayHead);
+                perform (audioChunk, midiChunk, audioPlayHead, workers, sampleRate, measureNodes);
 
                 chunkStartSample += maxSamples;
             }
@@ -552,10 +568,24 @@ struct GraphRenderSequence
                                       midiMessages,
                                       currentMidiOutputBuffer },
                                     audioPlayHead,
-                                    numSamples };
+                                    numSamples,
+                                    measureNodes };
 
-            for (const auto& op : renderOps)
-                op->process (context);
+            const auto startTicks = measureNodes ? Time::getHighResolutionTicks() : 0;
+
+            if (workers != nullptr && schedule != nullptr)
+            {
+                schedule->perform (context, *workers);
+            }
+            else
+            {
+                for (const auto& op : renderOps)
+                    op->process (context);
+            }
+
+            if (measureNodes && sampleRate > 0.0)
+                attributeOverrun (Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks),
+                                  numSamples / sampleRate);
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
@@ -587,7 +617,7 @@ struct GraphRenderSequence
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addOp (std::make_unique<ClearOp> (index), { BufferAccess::writeAudio (index) });
     }
 
     void addCopyChannelOp (int srcIndex, int dstIndex)
@@ -612,7 +642,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<CopyOp> (srcIndex, dstIndex), { BufferAccess::readAudio (srcIndex), BufferAccess::writeAudio (dstIndex) });
     }
 
     void addAddChannelOp (int srcIndex, int dstIndex)
@@ -637,7 +667,35 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<AddOp> (srcIndex, dstIndex), { BufferAccess::readAudio (srcIndex), BufferAccess::writeAudio (dstIndex) });
+    }
+
+    void addSumChannelsOp (int srcIndex1, int srcIndex2, int dstIndex)
+    {
+        struct SumOp final : public RenderOp
+        {
+            SumOp (int from1In, int from2In, int toIn) : from1 (from1In), from2 (from2In), to (toIn) {}
+
+            void prepare (FloatType* const* renderBuffer, MidiBuffer*) override
+            {
+                fromBuffer1 = renderBuffer[from1];
+                fromBuffer2 = renderBuffer[from2];
+                toBuffer = renderBuffer[to];
+            }
+
+            void process (const Context& c) override
+            {
+                FloatVectorOperations::add (toBuffer, fromBuffer1, fromBuffer2, c.numSamples);
+            }
+
+            FloatType* fromBuffer1 = nullptr;
+            FloatType* fromBuffer2 = nullptr;
+            FloatType* toBuffer = nullptr;
+            int from1 = 0, from2 = 0, to = 0;
+        };
+
+        addOp (std::make_unique<SumOp> (srcIndex1, srcIndex2, dstIndex),
+               { BufferAccess::readAudio (srcIndex1), BufferAccess::readAudio (srcIndex2), BufferAccess::writeAudio (dstIndex) });
     }
 
     JUCE_END_IGNORE_WARNINGS_MSVC
@@ -662,7 +720,7 @@ struct GraphRenderSequence
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addOp (std::make_unique<ClearOp> (index), { BufferAccess::writeMidi (index) });
     }
 
     void addCopyMidiBufferOp (int srcIndex, int dstIndex)
@@ -687,7 +745,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<CopyOp> (srcIndex, dstIndex), { BufferAccess::readMidi (srcIndex), BufferAccess::writeMidi (dstIndex) });
     }
 
     void addAddMidiBufferOp (int srcIndex, int dstIndex)
@@ -712,46 +770,15 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<AddOp> (srcIndex, dstIndex), { BufferAccess::readMidi (srcIndex), BufferAccess::writeMidi (dstIndex) });
     }
 
     void addDelayChannelOp (int chan, int delaySize)
     {
-        struct DelayChannelOp final : public RenderOp
-        {
-            DelayChannelOp (int chan, int delaySize)
-                : buffer ((size_t) (delaySize + 1), (FloatType) 0),
-                  channel (chan),
-                  writeIndex (delaySize)
-            {
-            }
-
-            void prepare (FloatType* const* renderBuffer, MidiBuffer*) override
-            {
-                channelBuffer = renderBuffer[channel];
-            }
-
-            void process (const Context& c) override
-            {
-                auto* data = channelBuffer;
-
-                for (int i = c.numSamples; --i >= 0;)
-                {
-                    buffer[(size_t) writeIndex] = *data;
-                    *data++ = buffer[(size_t) readIndex];
-
-                    if (++readIndex  >= (int) buffer.size()) readIndex = 0;
-                    if (++writeIndex >= (int) buffer.size()) writeIndex = 0;
-                }
-            }
-
-            std::vector<FloatType> buffer;
-            FloatType* channelBuffer = nullptr;
-            const int channel;
-            int readIndex = 0, writeIndex;
-        };
-
-        renderOps.push_back (std::make_unique<DelayChannelOp> (chan, delaySize));
+        auto op = std::make_unique<DelayChannelOp> (chan, delaySize);
+        delayOps.push_back (op.get());
+        addOp (std::move (op), { BufferAccess::writeAudio (chan) });
+        numDelayLineSamples += (size_t) (delaySize + 1);
     }
 
     void addProcessOp (const Node::Ptr& node,
@@ -759,6 +786,13 @@ struct GraphRenderSequence
                        int totalNumChans,
                        int midiBuffer)
     {
+        std::vector<BufferAccess> accesses;
+
+        for (const auto channel : audioChannelsUsed)
+            accesses.push_back (BufferAccess::writeAudio (channel));
+
+        accesses.push_back (BufferAccess::writeMidi (midiBuffer));
+
         auto op = [&]() -> std::unique_ptr<NodeOp>
         {
             if (auto* ioNode = dynamic_cast<const AudioProcessorGraph::AudioGraphIOProcessor*> (node->getProcessor()))
@@ -769,23 +803,35 @@ struct GraphRenderSequence
                         return std::make_unique<AudioInOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode:
+                        accesses.push_back (BufferAccess::writeGlobalAudioOut());
                         return std::make_unique<AudioOutOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::midiInputNode:
                         return std::make_unique<MidiInOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::midiOutputNode:
+                        accesses.push_back (BufferAccess::writeGlobalMidiOut());
                         return std::make_unique<MidiOutOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
                 }
             }
 
-            return std::make_unique<ProcessOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
+            return std::make_unique<ProcessOp> (node, audioChannelsUsed, totalNumChans, midiBuffer, usesOtherPrecision (*node));
         }();
 
-        renderOps.push_back (std::move (op));
+        // The node processes its channels in place, so each input must be made available in the
+        // node's precision, and each output will then only be valid in that precision
+        const auto precision = usesOtherPrecision (*node) ? ChannelPrecision::other : ChannelPrecision::native;
+        const auto numIns  = node->getProcessor()->getTotalNumInputChannels();
+        const auto numOuts = node->getProcessor()->getTotalNumOutputChannels();
+
+        for (int i = 0; i < audioChannelsUsed.size(); ++i)
+            useChannel (audioChannelsUsed.getUnchecked (i), precision, i < numIns, i < numOuts);
+
+        nodeOps.push_back (op.get());
+        pushOp (std::move (op), std::move (accesses));
     }
 
-    void prepareBuffers (int blockSize)
+    void prepareBuffers (int blockSize, bool buildParallelSchedule)
     {
         renderingBuffer.setSize (numBuffersNeeded + 1, blockSize);
         renderingBuffer.clear();
@@ -806,247 +852,764 @@ struct GraphRenderSequence
 
         for (const auto& op : renderOps)
             op->prepare (renderingBuffer.getArrayOfWritePointers(), midiBuffers.data());
-    }
 
-    int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
+        if (needsOtherPrecision)
+        {
+            otherPrecisionBuffer.setSize (numBuffersNeeded + 1, blockSize);
+            otherPrecisionBuffer.clear();
 
-    AudioBuffer<FloatType> renderingBuffer, currentAudioOutputBuffer;
+            for (const auto& op : renderOps)
+                op->prepareOtherPrecision (otherPrecisionBuffer.getArrayOfWritePointers());
+        }
 
-    MidiBuffer currentMidiOutputBuffer;
+        schedule = buildParallelSchedule ? std::make_unique<ParallelSchedule> (renderOps) : nullptr;
+    }
 
-    Array<MidiBuffer> midiBuffers;
-    MidiBuffer midiChunk;
+    size_t getAudioBufferBytes() const
+    {
+        return (size_t) renderingBuffer.getNumChannels() * (size_t) renderingBuffer.getNumSamples() * sizeof (FloatType)
+             + (size_t) otherPrecisionBuffer.getNumChannels() * (size_t) otherPrecisionBuffer.getNumSamples() * sizeof (OtherFloatType);
+    }
 
-private:
-    //==============================================================================
-    struct RenderOp
+    size_t getDelayLineBytes() const
     {
-        virtual ~RenderOp() = default;
-        virtual void prepare (FloatType* const*, MidiBuffer*) = 0;
-        virtual void process (const Context&) = 0;
-    };
+        return numDelayLineSamples * sizeof (FloatType);
+    }
 
-    struct NodeOp : public RenderOp
+    /*  Call on the main thread only.
+
+        If the other sequence has exactly the same ops as this one, and only differs in the lengths
+        of its delay lines, this takes the delay lines that have changed. They will be installed
+        at the start of the next block that this sequence renders, without disturbing any other
+        part of the graph. Returns false if the sequences differ in any other way.
+    */
+    bool takeDelayLinesFrom (GraphRenderSequence& other)
     {
-        NodeOp (const Node::Ptr& n,
-                const Array<int>& audioChannelsUsed,
-                int totalNumChans,
-                int midiBufferIndex)
-            : node (n),
-              processor (*n->getProcessor()),
-              audioChannelsToUse (audioChannelsUsed),
-              audioChannels ((size_t) jmax (1, totalNumChans), nullptr),
-              midiBufferToUse (midiBufferIndex)
+        if (numBuffersNeeded != other.numBuffersNeeded
+            || numMidiBuffersNeeded != other.numMidiBuffersNeeded
+            || renderOps.size() != other.renderOps.size()
+            || nodeOps.size() != other.nodeOps.size()
+            || delayOps.size() != other.delayOps.size())
         {
-            while (audioChannelsToUse.size() < (int) audioChannels.size())
-                audioChannelsToUse.add (0);
+            return false;
         }
 
-        void prepare (FloatType* const* renderBuffer, MidiBuffer* buffers) final
+        for (size_t i = 0; i < renderOps.size(); ++i)
         {
-            for (size_t i = 0; i < audioChannels.size(); ++i)
-                audioChannels[i] = renderBuffer[audioChannelsToUse.getUnchecked ((int) i)];
+            const auto& op = *renderOps[i];
+            const auto& otherOp = *other.renderOps[i];
 
-            midiBuffer = buffers + midiBufferToUse;
+            if (typeid (op) != typeid (otherOp) || op.accesses != otherOp.accesses)
+                return false;
         }
 
-        void process (const Context& c) final
-        {
-            processor.setPlayHead (c.audioPlayHead);
+        for (size_t i = 0; i < nodeOps.size(); ++i)
+            if (nodeOps[i]->node != other.nodeOps[i]->node)
+                return false;
 
-            auto numAudioChannels = [this]
-            {
-                if (const auto* proc = node->getProcessor())
-                    if (proc->getTotalNumInputChannels() == 0 && proc->getTotalNumOutputChannels() == 0)
-                        return 0;
+        auto& exchange = *delayLineExchange;
+        const SpinLock::ScopedLockType lock (exchange.mutex);
 
-                return (int) audioChannels.size();
-            }();
+        // Once the audio thread has installed the last batch, this releases the lines it replaced
+        if (! exchange.isNew)
+            exchange.lines.assign (delayOps.size(), {});
 
-            AudioBuffer<FloatType> buffer { audioChannels.data(), numAudioChannels, c.numSamples };
+        if (exchange.delays.empty())
+            for (const auto* op : delayOps)
+                exchange.delays.push_back (op->getDelay());
 
-            if (processor.isSuspended())
-            {
-                buffer.clear();
-            }
-            else
+        for (size_t i = 0; i < delayOps.size(); ++i)
+        {
+            const auto newDelay = other.delayOps[i]->getDelay();
+
+            if (exchange.delays[i] != newDelay)
             {
-                const auto bypass = node->isBypassed() && processor.getBypassParameter() == nullptr;
-                processWithBuffer (c.globalIO, bypass, buffer, *midiBuffer);
+                exchange.lines[i] = std::move (other.delayOps[i]->buffer);
+                exchange.delays[i] = newDelay;
+                exchange.isNew = true;
             }
         }
 
-        virtual void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) = 0;
+        numDelayLineSamples = other.numDelayLineSamples;
+        return true;
+    }
 
-        const Node::Ptr node;
-        AudioProcessor& processor;
-        MidiBuffer* midiBuffer = nullptr;
+    int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
+    size_t numDelayLineSamples = 0;
 
-        Array<int> audioChannelsToUse;
-        std::vector<FloatType*> audioChannels;
-        const int midiBufferToUse;
-    };
+    // The nodes' channels are laid out so that vectorised code can work on whole registers
+    AudioBuffer<FloatType> renderingBuffer { 0, 0, AudioBuffer<FloatType>::Allocation::aligned }, currentAudioOutputBuffer;
 
-    struct ProcessOp final : public NodeOp
+    // Holds channels for nodes that process at the other precision to the rest of the graph
+    AudioBuffer<OtherFloatType> otherPrecisionBuffer { 0, 0, AudioBuffer<OtherFloatType>::Allocation::aligned };
+
+    MidiBuffer currentMidiOutputBuffer;
+
+    Array<MidiBuffer> midiBuffers;
+    MidiBuffer midiChunk;
+
+private:
+    //==============================================================================
+    /*  Describes a buffer that is used by a RenderOp.
+
+        When rendering in parallel, two ops may only run at the same time if neither of them
+        writes to a buffer that is used by the other.
+    */
+    struct BufferAccess
     {
-        using NodeOp::NodeOp;
+        enum class Kind { audio, midi, globalAudioOut, globalMidiOut };
 
-        void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
-        {
-            callProcess (bypass, audio, midi);
-        }
+        static BufferAccess readAudio  (int index)  { return { Kind::audio, index, false }; }
+        static BufferAccess writeAudio (int index)  { return { Kind::audio, index, true }; }
+        static BufferAccess readMidi   (int index)  { return { Kind::midi,  index, false }; }
+        static BufferAccess writeMidi  (int index)  { return { Kind::midi,  index, true }; }
+        static BufferAccess writeGlobalAudioOut()   { return { Kind::globalAudioOut, 0, true }; }
+        static BufferAccess writeGlobalMidiOut()    { return { Kind::globalMidiOut,  0, true }; }
 
-        void callProcess (bool bypass, AudioBuffer<float>& buffer, MidiBuffer& midi)
+        /*  The first audio and midi buffers are always empty, and are never written. */
+        bool isReadOnlyEmpty() const noexcept
         {
-            if (this->processor.isUsingDoublePrecision())
-            {
-                tempBufferDouble.makeCopyOf (buffer, true);
-                processImpl (bypass, this->processor, tempBufferDouble, midi);
-                buffer.makeCopyOf (tempBufferDouble, true);
-            }
-            else
-            {
-                processImpl (bypass, this->processor, buffer, midi);
-            }
+            return (kind == Kind::audio || kind == Kind::midi) && index == 0;
         }
 
-        void callProcess (bool bypass, AudioBuffer<double>& buffer, MidiBuffer& midi)
-        {
-            if (this->processor.isUsingDoublePrecision())
-            {
-                processImpl (bypass, this->processor, buffer, midi);
-            }
-            else
-            {
-                tempBufferFloat.makeCopyOf (buffer, true);
-                processImpl (bypass, this->processor, tempBufferFloat, midi);
-                buffer.makeCopyOf (tempBufferFloat, true);
-            }
-        }
+        auto getKey() const noexcept { return std::make_tuple (kind, index); }
 
-        template <typename Value>
-        static void processImpl (bool bypass, AudioProcessor& p, AudioBuffer<Value>& audio, MidiBuffer& midi)
+        bool operator== (const BufferAccess& other) const noexcept
         {
-            if (bypass)
-                p.processBlockBypassed (audio, midi);
-            else
-                p.processBlock (audio, midi);
+            return std::tie (kind, index, writes) == std::tie (other.kind, other.index, other.writes);
         }
 
-        AudioBuffer<float> tempBufferFloat, tempBufferDouble;
+        bool operator!= (const BufferAccess& other) const noexcept { return ! operator== (other); }
+
+        Kind kind;
+        int index;
+        bool writes;
     };
 
-    struct MidiInOp final : public NodeOp
+    struct RenderOp
     {
-        using NodeOp::NodeOp;
+        virtual ~RenderOp() = default;
+        virtual void prepare (FloatType* const*, MidiBuffer*) = 0;
+        virtual void prepareOtherPrecision (OtherFloatType* const*) {}
+        virtual void process (const Context&) = 0;
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
-        {
-            if (! bypass)
-                midi.addEvents (g.midiIn, 0, audio.getNumSamples(), 0);
-        }
+        std::vector<BufferAccess> accesses;
     };
 
-    struct MidiOutOp final : public NodeOp
+    struct DelayChannelOp final : public RenderOp
     {
-        using NodeOp::NodeOp;
-
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        DelayChannelOp (int chan, int delaySize)
+            : buffer ((size_t) (delaySize + 1), (FloatType) 0),
+              channel (chan),
+              writeIndex (delaySize)
         {
-            if (! bypass)
-                g.midiOut.addEvents (midi, 0, audio.getNumSamples(), 0);
         }
-    };
 
-    struct AudioInOp final : public NodeOp
-    {
-        using NodeOp::NodeOp;
+        void prepare (FloatType* const* renderBuffer, MidiBuffer*) override
+        {
+            channelBuffer = renderBuffer[channel];
+        }
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
+        void process (const Context& c) override
         {
-            if (bypass)
-                return;
+            auto* data = channelBuffer;
 
-            for (int i = jmin (g.audioIn.getNumChannels(), audio.getNumChannels()); --i >= 0;)
-                audio.copyFrom (i, 0, g.audioIn, i, 0, audio.getNumSamples());
+            for (int i = c.numSamples; --i >= 0;)
+            {
+                buffer[(size_t) writeIndex] = *data;
+                *data++ = buffer[(size_t) readIndex];
+
+                if (++readIndex  >= (int) buffer.size()) readIndex = 0;
+                if (++writeIndex >= (int) buffer.size()) writeIndex = 0;
+            }
         }
-    };
 
-    struct AudioOutOp final : public NodeOp
-    {
-        using NodeOp::NodeOp;
+        int getDelay() const noexcept { return (int) buffer.size() - 1; }
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
+        /*  Swaps in a delay line of a different length. The most recent input is carried over to
+            the new line, so that the output continues smoothly if the delay gets shorter.
+            On return, replacement holds the old delay line.
+        */
+        void swapDelayLine (std::vector<FloatType>& replacement) noexcept
         {
-            if (bypass)
-                return;
+            const auto oldSize = (int) buffer.size();
+            const auto newDelay = (int) replacement.size() - 1;
+            const auto numToKeep = jmin (oldSize - 1, newDelay);
 
-            for (int i = jmin (g.audioOut.getNumChannels(), audio.getNumChannels()); --i >= 0;)
-                g.audioOut.addFrom (i, 0, audio, i, 0, audio.getNumSamples());
+            for (int i = 0; i < numToKeep; ++i)
+                replacement[(size_t) (newDelay - numToKeep + i)] = buffer[(size_t) ((writeIndex - numToKeep + i + oldSize) % oldSize)];
+
+            std::swap (buffer, replacement);
+            readIndex = 0;
+            writeIndex = newDelay;
         }
+
+        std::vector<FloatType> buffer;
+        FloatType* channelBuffer = nullptr;
+        const int channel;
+        int readIndex = 0, writeIndex;
     };
 
-    std::vector<std::unique_ptr<RenderOp>> renderOps;
-};
+    /*  Holds delay lines that have been resized on the main thread, waiting to be picked up by
+        the audio thread.
+    */
+    struct DelayLineExchange
+    {
+        SpinLock mutex;
+        std::vector<std::vector<FloatType>> lines;
+        std::vector<int> delays;
+        bool isNew = false;
+    };
 
-//==============================================================================
-struct SequenceAndLatency
-{
-    using RenderSequenceVariant = std::variant<GraphRenderSequence<float>,
-                                               GraphRenderSequence<double>>;
+    /*  Call from the audio thread only. */
+    void installPendingDelayLines() noexcept
+    {
+        auto& exchange = *delayLineExchange;
+        const SpinLock::ScopedTryLockType lock (exchange.mutex);
 
-    RenderSequenceVariant sequence;
-    int latencySamples = 0;
-};
+        if (! lock.isLocked() || ! exchange.isNew)
+            return;
 
-//==============================================================================
-class RenderSequenceBuilder
-{
-public:
-    using Node           = AudioProcessorGraph::Node;
-    using NodeID         = AudioProcessorGraph::NodeID;
-    using Connection     = AudioProcessorGraph::Connection;
-    using NodeAndChannel = AudioProcessorGraph::NodeAndChannel;
+        for (size_t i = 0; i < delayOps.size(); ++i)
+            if (! exchange.lines[i].empty())
+                delayOps[i]->swapDelayLine (exchange.lines[i]);
 
-    static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
+        exchange.isNew = false;
+    }
 
-    template <typename FloatType>
-    static SequenceAndLatency build (const Nodes& n, const Connections& c)
+    /*  Adds an op that works on audio channels at the graph's own precision. */
+    void addOp (std::unique_ptr<RenderOp> op, std::vector<BufferAccess> accesses)
     {
-        GraphRenderSequence<FloatType> sequence;
-        const RenderSequenceBuilder builder (n, c, sequence);
-        return { std::move (sequence), builder.totalLatency };
+        for (const auto& access : accesses)
+            if (access.kind == BufferAccess::Kind::audio)
+                useChannel (access.index, ChannelPrecision::native, true, access.writes);
+
+        pushOp (std::move (op), std::move (accesses));
+    }
+
+    void pushOp (std::unique_ptr<RenderOp> op, std::vector<BufferAccess> accesses)
+    {
+        op->accesses = std::move (accesses);
+        renderOps.push_back (std::move (op));
     }
 
-private:
     //==============================================================================
-    const Array<Node*> orderedNodes;
+    /*  When some nodes can't process at the graph's precision, each channel may hold valid data
+        at the graph's precision, at the other precision, or both. A conversion is only added
+        when an op needs to read a channel at a precision that isn't already valid, so a chain
+        of nodes that share a precision will only be converted at either end.
+    */
+    enum class ChannelPrecision { native = 1, other = 2, both = native | other };
 
-    struct AssignedBuffer
+    static bool usesOtherPrecision (const Node& node)
     {
-        NodeAndChannel channel;
+        return node.getProcessor()->isUsingDoublePrecision() != std::is_same_v<FloatType, double>;
+    }
 
-        static AssignedBuffer createReadOnlyEmpty() noexcept    { return { { zeroNodeID(), 0 } }; }
-        static AssignedBuffer createFree() noexcept             { return { { freeNodeID(), 0 } }; }
+    void useChannel (int index, ChannelPrecision precision, bool reads, bool writes)
+    {
+        // The first buffer is always empty at both precisions
+        if (index <= 0)
+            return;
 
-        bool isReadOnlyEmpty() const noexcept                   { return channel.nodeID == zeroNodeID(); }
-        bool isFree() const noexcept                            { return channel.nodeID == freeNodeID(); }
-        bool isAssigned() const noexcept                        { return ! (isReadOnlyEmpty() || isFree()); }
+        if ((size_t) index >= channelPrecisions.size())
+            channelPrecisions.resize ((size_t) index + 1, ChannelPrecision::native);
 
-        void setFree() noexcept                                 { channel = { freeNodeID(), 0 }; }
-        void setAssignedToNonExistentNode() noexcept            { channel = { anonNodeID(), 0 }; }
+        auto& current = channelPrecisions[(size_t) index];
 
-    private:
-        static NodeID anonNodeID() { return NodeID (0x7ffffffd); }
-        static NodeID zeroNodeID() { return NodeID (0x7ffffffe); }
-        static NodeID freeNodeID() { return NodeID (0x7fffffff); }
-    };
+        if (reads && ((int) current & (int) precision) == 0)
+        {
+            addConvertChannelOp (index, precision == ChannelPrecision::other);
+            current = ChannelPrecision::both;
+        }
 
-    Array<AssignedBuffer> audioBuffers, midiBuffers;
+        if (writes)
+            current = precision;
+    }
+
+    void addConvertChannelOp (int index, bool toOtherPrecision)
+    {
+        struct ConvertOp final : public RenderOp
+        {
+            ConvertOp (int indexIn, bool toOtherIn) : index (indexIn), toOther (toOtherIn) {}
+
+            void prepare (FloatType* const* renderBuffer, MidiBuffer*) override
+            {
+                nativeBuffer = renderBuffer[index];
+            }
+
+            void prepareOtherPrecision (OtherFloatType* const* renderBuffer) override
+            {
+                otherBuffer = renderBuffer[index];
+            }
+
+            void process (const Context& c) override
+            {
+                if (toOther)
+                {
+                    for (int i = 0; i < c.numSamples; ++i)
+                        otherBuffer[i] = static_cast<OtherFloatType> (nativeBuffer[i]);
+                }
+                else
+                {
+                    for (int i = 0; i < c.numSamples; ++i)
+                        nativeBuffer[i] = static_cast<FloatType> (otherBuffer[i]);
+                }
+            }
+
+            FloatType* nativeBuffer = nullptr;
+            OtherFloatType* otherBuffer = nullptr;
+            int index = 0;
+            bool toOther = false;
+        };
+
+        needsOtherPrecision = true;
+        pushOp (std::make_unique<ConvertOp> (index, toOtherPrecision), { BufferAccess::writeAudio (index) });
+    }
+
+    //==============================================================================
+    /*  Works out which ops must be complete before each op may start, and then hands out
+        ops to the audio thread and the threads of a RealtimeThreadPool as soon as their inputs
+        are ready.
+
+        Ops that don't share any buffers (e.g. separate chains of processors that only meet at
+        the graph output) will be processed concurrently.
+    */
+    class ParallelSchedule
+    {
+    public:
+        explicit ParallelSchedule (const std::vector<std::unique_ptr<RenderOp>>& renderOpsIn)
+            : numOps (renderOpsIn.size()),
+              ops (numOps),
+              successors (numOps),
+              numDependencies (numOps, 0),
+              remainingDependencies (numOps),
+              readyOps (numOps)
+        {
+            struct AccessHistory
+            {
+                std::optional<size_t> lastWriter;
+                std::vector<size_t> readersSinceLastWrite;
+            };
+
+            std::map<decltype (std::declval<BufferAccess>().getKey()), AccessHistory> histories;
+
+            for (size_t i = 0; i < numOps; ++i)
+            {
+                ops[i] = renderOpsIn[i].get();
+
+                std::set<size_t> dependencies;
+
+                for (const auto& access : ops[i]->accesses)
+                {
+                    if (access.isReadOnlyEmpty())
+                        continue;
+
+                    auto& history = histories[access.getKey()];
+
+                    if (history.lastWriter.has_value())
+                        dependencies.insert (*history.lastWriter);
+
+                    if (access.writes)
+                    {
+                        dependencies.insert (history.readersSinceLastWrite.begin(), history.readersSinceLastWrite.end());
+                        history.readersSinceLastWrite.clear();
+                        history.lastWriter = i;
+                    }
+                    else
+                    {
+                        history.readersSinceLastWrite.push_back (i);
+                    }
+                }
+
+                dependencies.erase (i);
+
+                for (const auto dependency : dependencies)
+                    successors[dependency].push_back (i);
+
+                numDependencies[i] = (int) dependencies.size();
+            }
+        }
+
+        /*  Call from the audio thread only. Returns once all ops have been processed. */
+        void perform (const Context& c, RealtimeThreadPool& workers)
+        {
+            context = &c;
+            numComplete.store (0, std::memory_order_relaxed);
+            readPosition.store (0, std::memory_order_relaxed);
+            writePosition.store (0, std::memory_order_relaxed);
+
+            for (auto& slot : readyOps)
+                slot.store (-1, std::memory_order_relaxed);
+
+            for (size_t i = 0; i < numOps; ++i)
+            {
+                remainingDependencies[i].store (numDependencies[i], std::memory_order_relaxed);
+
+                if (numDependencies[i] == 0)
+                    pushReadyOp (i);
+            }
+
+            // Each thread in the pool keeps taking ready ops until the whole sequence is done
+            for (auto i = 0; i <= workers.getNumThreads(); ++i)
+                workers.addJob ([this] { run(); });
+
+            workers.runJobsAndWait();
+            context = nullptr;
+        }
+
+    private:
+        void run()
+        {
+            while (numComplete.load (std::memory_order_acquire) < numOps)
+            {
+                const auto index = popReadyOp();
+
+                if (index < 0)
+                {
+                    Thread::yield();
+                    continue;
+                }
+
+                ops[(size_t) index]->process (*context);
+
+                for (const auto successor : successors[(size_t) index])
+                    if (remainingDependencies[successor].fetch_sub (1, std::memory_order_acq_rel) == 1)
+                        pushReadyOp (successor);
+
+                numComplete.fetch_add (1, std::memory_order_acq_rel);
+            }
+        }
+
+        void pushReadyOp (size_t index)
+        {
+            const auto position = writePosition.fetch_add (1, std::memory_order_relaxed);
+            jassert (position < numOps);
+            readyOps[position].store ((int) index, std::memory_order_release);
+        }
+
+        int popReadyOp()
+        {
+            auto position = readPosition.load (std::memory_order_acquire);
+
+            while (position < numOps)
+            {
+                const auto index = readyOps[position].load (std::memory_order_acquire);
+
+                // The op in this slot hasn't been published yet
+                if (index < 0)
+                    return -1;
+
+                if (readPosition.compare_exchange_weak (position, position + 1, std::memory_order_acq_rel))
+                    return index;
+            }
+
+            return -1;
+        }
+
+        const size_t numOps;
+        std::vector<RenderOp*> ops;
+        std::vector<std::vector<size_t>> successors;
+        std::vector<int> numDependencies;
+
+        std::vector<std::atomic<int>> remainingDependencies;
+        std::vector<std::atomic<int>> readyOps;
+        std::atomic<size_t> readPosition { 0 }, writePosition { 0 }, numComplete { 0 };
+        const Context* context = nullptr;
+    };
+
+    struct NodeOp : public RenderOp
+    {
+        NodeOp (const Node::Ptr& n,
+                const Array<int>& audioChannelsUsed,
+                int totalNumChans,
+                int midiBufferIndex)
+            : node (n),
+              processor (*n->getProcessor()),
+              audioChannelsToUse (audioChannelsUsed),
+              audioChannels ((size_t) jmax (1, totalNumChans), nullptr),
+              midiBufferToUse (midiBufferIndex)
+        {
+            while (audioChannelsToUse.size() < (int) audioChannels.size())
+                audioChannelsToUse.add (0);
+        }
+
+        void prepare (FloatType* const* renderBuffer, MidiBuffer* buffers) final
+        {
+            for (size_t i = 0; i < audioChannels.size(); ++i)
+                audioChannels[i] = renderBuffer[audioChannelsToUse.getUnchecked ((int) i)];
+
+            midiBuffer = buffers + midiBufferToUse;
+        }
+
+        void process (const Context& c) final
+        {
+            JUCE_TRACE_SCOPE ("audio", "AudioProcessorGraph::processNode");
+
+            if (! c.measureNodes)
+            {
+                processNode (c);
+                return;
+            }
+
+            const auto startTicks = Time::getHighResolutionTicks();
+            processNode (c);
+            lastMilliseconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks) * 1000.0;
+            node->addProcessingTime (lastMilliseconds);
+        }
+
+        void processNode (const Context& c)
+        {
+            processor.setPlayHead (c.audioPlayHead);
+
+            auto numAudioChannels = [this]
+            {
+                if (const auto* proc = node->getProcessor())
+                    if (proc->getTotalNumInputChannels() == 0 && proc->getTotalNumOutputChannels() == 0)
+                        return 0;
+
+                return (int) audioChannels.size();
+            }();
+
+            AudioBuffer<FloatType> buffer { audioChannels.data(), numAudioChannels, c.numSamples };
+
+            if (processor.isSuspended())
+            {
+                clearBuffer (buffer);
+            }
+            else
+            {
+                const auto bypass = node->isBypassed() && processor.getBypassParameter() == nullptr;
+                processWithBuffer (c.globalIO, bypass, buffer, *midiBuffer);
+            }
+        }
+
+        virtual void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) = 0;
+        virtual void clearBuffer (AudioBuffer<FloatType>& audio)  { audio.clear(); }
+
+        const Node::Ptr node;
+        AudioProcessor& processor;
+        MidiBuffer* midiBuffer = nullptr;
+        double lastMilliseconds = 0.0;
+
+        Array<int> audioChannelsToUse;
+        std::vector<FloatType*> audioChannels;
+        const int midiBufferToUse;
+    };
+
+    struct ProcessOp final : public NodeOp
+    {
+        ProcessOp (const Node::Ptr& n,
+                   const Array<int>& audioChannelsUsed,
+                   int totalNumChans,
+                   int midiBufferIndex,
+                   bool usesOtherPrecisionIn)
+            : NodeOp (n, audioChannelsUsed, totalNumChans, midiBufferIndex),
+              usesOtherPrecision (usesOtherPrecisionIn),
+              otherPrecisionChannels (usesOtherPrecision ? this->audioChannels.size() : 0, nullptr)
+        {
+        }
+
+        void prepareOtherPrecision (OtherFloatType* const* renderBuffer) override
+        {
+            for (size_t i = 0; i < otherPrecisionChannels.size(); ++i)
+                otherPrecisionChannels[i] = renderBuffer[this->audioChannelsToUse.getUnchecked ((int) i)];
+        }
+
+        void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        {
+            if (usesOtherPrecision)
+            {
+                auto other = getOtherPrecisionBuffer (audio);
+                processImpl (bypass, this->processor, other, midi);
+            }
+            else
+            {
+                processImpl (bypass, this->processor, audio, midi);
+            }
+        }
+
+        void clearBuffer (AudioBuffer<FloatType>& audio) final
+        {
+            if (usesOtherPrecision)
+                getOtherPrecisionBuffer (audio).clear();
+            else
+                audio.clear();
+        }
+
+        AudioBuffer<OtherFloatType> getOtherPrecisionBuffer (const AudioBuffer<FloatType>& audio)
+        {
+            return { otherPrecisionChannels.data(), audio.getNumChannels(), audio.getNumSamples() };
+        }
+
+        template <typename Value>
+        static void processImpl (bool bypass, AudioProcessor& p, AudioBuffer<Value>& audio, MidiBuffer& midi)
+        {
+            if (bypass)
+                p.processBlockBypassed (audio, midi);
+            else
+                p.processBlock (audio, midi);
+        }
+
+        const bool usesOtherPrecision;
+        std::vector<OtherFloatType*> otherPrecisionChannels;
+    };
+
+    struct MidiInOp final : public NodeOp
+    {
+        using NodeOp::NodeOp;
+
+        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        {
+            if (! bypass)
+                midi.addEvents (g.midiIn, 0, audio.getNumSamples(), 0);
+        }
+    };
+
+    struct MidiOutOp final : public NodeOp
+    {
+        using NodeOp::NodeOp;
+
+        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        {
+            if (! bypass)
+                g.midiOut.addEvents (midi, 0, audio.getNumSamples(), 0);
+        }
+    };
+
+    struct AudioInOp final : public NodeOp
+    {
+        using NodeOp::NodeOp;
+
+        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
+        {
+            if (bypass)
+                return;
+
+            for (int i = jmin (g.audioIn.getNumChannels(), audio.getNumChannels()); --i >= 0;)
+                audio.copyFrom (i, 0, g.audioIn, i, 0, audio.getNumSamples());
+        }
+    };
+
+    struct AudioOutOp final : public NodeOp
+    {
+        using NodeOp::NodeOp;
+
+        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
+        {
+            if (bypass)
+                return;
+
+            for (int i = jmin (g.audioOut.getNumChannels(), audio.getNumChannels()); --i >= 0;)
+                g.audioOut.addFrom (i, 0, audio, i, 0, audio.getNumSamples());
+        }
+    };
+
+    /*  If the whole sequence took longer than the block it was rendering, the slowest node
+        gets the blame.
+    */
+    void attributeOverrun (double elapsedSeconds, double blockSeconds) const
+    {
+        if (elapsedSeconds <= blockSeconds || nodeOps.empty())
+            return;
+
+        const auto slowest = std::max_element (nodeOps.begin(), nodeOps.end(), [] (const auto* a, const auto* b)
+        {
+            return a->lastMilliseconds < b->lastMilliseconds;
+        });
+
+        (*slowest)->node->addOverrun();
+    }
+
+    std::vector<std::unique_ptr<RenderOp>> renderOps;
+    std::vector<NodeOp*> nodeOps;
+    std::vector<DelayChannelOp*> delayOps;
+    std::unique_ptr<DelayLineExchange> delayLineExchange = std::make_unique<DelayLineExchange>();
+    std::vector<ChannelPrecision> channelPrecisions;
+    bool needsOtherPrecision = false;
+    std::unique_ptr<ParallelSchedule> schedule;
+};
+
+//==============================================================================
+struct SequenceAndLatency
+{
+    using RenderSequenceVariant = std::variant<GraphRenderSequence<float>,
+                                               GraphRenderSequence<double>>;
+
+    RenderSequenceVariant sequence;
+    int latencySamples = 0;
+    AudioProcessorGraph::BufferUsage bufferUsage;
+};
+
+//==============================================================================
+class RenderSequenceBuilder
+{
+public:
+    using Node           = AudioProcessorGraph::Node;
+    using NodeID         = AudioProcessorGraph::NodeID;
+    using Connection     = AudioProcessorGraph::Connection;
+    using NodeAndChannel = AudioProcessorGraph::NodeAndChannel;
+
+    static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
+
+    /*  If recycleBuffers is false, each intermediate result will be given its own buffer, rather
+        than reusing buffers that are no longer needed by later nodes. This uses more memory, but
+        removes false dependencies between nodes when rendering in parallel.
+    */
+    template <typename FloatType>
+    static SequenceAndLatency build (const Nodes& n, const Connections& c, bool recycleBuffers)
+    {
+        GraphRenderSequence<FloatType> sequence;
+        RenderSequenceBuilder builder (n, c, sequence, recycleBuffers);
+        return { std::move (sequence), builder.totalLatency, std::move (builder.bufferUsage) };
+    }
+
+private:
+    //==============================================================================
+    const Array<Node*> orderedNodes;
+    const bool recycleBuffers;
+
+    struct AssignedBuffer
+    {
+        NodeAndChannel channel;
+
+        static AssignedBuffer createReadOnlyEmpty() noexcept    { return { { zeroNodeID(), 0 } }; }
+        static AssignedBuffer createFree() noexcept             { return { { freeNodeID(), 0 } }; }
+
+        bool isReadOnlyEmpty() const noexcept                   { return channel.nodeID == zeroNodeID(); }
+        bool isFree() const noexcept                            { return channel.nodeID == freeNodeID(); }
+        bool isAssigned() const noexcept                        { return ! (isReadOnlyEmpty() || isFree()); }
+        bool holdsSharedDelayLine() const noexcept              { return channel.nodeID == sharedDelayNodeID(); }
+
+        void setFree() noexcept                                 { channel = { freeNodeID(), 0 }; }
+        void setAssignedToNonExistentNode() noexcept            { channel = { anonNodeID(), 0 }; }
+        void setHoldsSharedDelayLine() noexcept                 { channel = { sharedDelayNodeID(), 0 }; }
+
+    private:
+        static NodeID sharedDelayNodeID() { return NodeID (0x7ffffffc); }
+        static NodeID anonNodeID() { return NodeID (0x7ffffffd); }
+        static NodeID zeroNodeID() { return NodeID (0x7ffffffe); }
+        static NodeID freeNodeID() { return NodeID (0x7fffffff); }
+    };
+
+    Array<AssignedBuffer> audioBuffers, midiBuffers;
 
     enum { readOnlyEmptyBufferIndex = 0 };
 
     std::unordered_map<uint32, int> delays;
+    std::map<NodeAndChannel, int> lastStepReadingOutput;
+
+    /*  A delayed copy of a node output, which is read by several inputs that all need the
+        same delay.
+    */
+    struct SharedDelayLine
+    {
+        int numReadersLeft = 0;
+        int bufferIndex = -1;
+    };
+
+    std::map<std::pair<NodeAndChannel, int>, SharedDelayLine> sharedDelayLines;
+    AudioProcessorGraph::BufferUsage bufferUsage;
     int totalLatency = 0;
 
     int getNodeDelay (NodeID nodeID) const noexcept
@@ -1065,52 +1628,70 @@ private:
     }
 
     //==============================================================================
-    void getAllParentsOfNode (const NodeID& child,
-                              std::set<NodeID>& parents,
-                              const std::map<NodeID, std::set<NodeID>>& otherParents,
-                              const Connections& c)
+    /*  Adds all the nodes that feed into the child node to the parents set.
+
+        Nodes are referred to by their index in the graph's list of nodes. The full set of
+        parents is already known for any node with an index lower than the 'current' index,
+        so there's no need to search further back from those nodes.
+    */
+    static void getAllParentsOfNode (int child,
+                                     int current,
+                                     BigInteger& parents,
+                                     const std::vector<std::vector<int>>& directParents,
+                                     const std::vector<BigInteger>& allParents)
     {
-        for (const auto& parentNode : c.getSourceNodesForDestination (child))
+        for (const auto parent : directParents[(size_t) child])
         {
-            if (parentNode == child)
+            if (parents[parent])
                 continue;
 
-            if (parents.insert (parentNode).second)
-            {
-                const auto parentParents = otherParents.find (parentNode);
-
-                if (parentParents != otherParents.end())
-                {
-                    parents.insert (parentParents->second.begin(), parentParents->second.end());
-                    continue;
-                }
+            parents.setBit (parent);
 
-                getAllParentsOfNode (parentNode, parents, otherParents, c);
-            }
+            if (parent < current)
+                parents |= allParents[(size_t) parent];
+            else if (parent != current)
+                getAllParentsOfNode (parent, current, parents, directParents, allParents);
         }
     }
 
-    Array<Node*> createOrderedNodeList (const Nodes& n, const Connections& c)
+    static Array<Node*> createOrderedNodeList (const Nodes& n, const Connections& c)
     {
-        Array<Node*> result;
+        const auto& nodes = n.getNodes();
+        const auto numNodes = nodes.size();
 
-        std::map<NodeID, std::set<NodeID>> nodeParents;
+        std::unordered_map<uint32, int> indexForNode;
 
-        for (auto& node : n.getNodes())
-        {
-            const auto nodeID = node->nodeID;
-            int insertionIndex = 0;
+        for (int i = 0; i < numNodes; ++i)
+            indexForNode[nodes.getUnchecked (i)->nodeID.uid] = i;
+
+        std::vector<std::vector<int>> directParents ((size_t) numNodes);
 
-            for (; insertionIndex < result.size(); ++insertionIndex)
+        for (int i = 0; i < numNodes; ++i)
+        {
+            for (const auto& source : c.getSourceNodesForDestination (nodes.getUnchecked (i)->nodeID))
             {
-                auto& parents = nodeParents[result.getUnchecked (insertionIndex)->nodeID];
+                const auto iter = indexForNode.find (source.uid);
 
-                if (parents.find (nodeID) != parents.end())
-                    break;
+                if (iter != indexForNode.end() && iter->second != i)
+                    directParents[(size_t) i].push_back (iter->second);
             }
+        }
 
-            result.insert (insertionIndex, node);
-            getAllParentsOfNode (nodeID, nodeParents[node->nodeID], nodeParents, c);
+        // Each node is inserted just before the first node that depends on it
+        Array<Node*> result;
+        std::vector<int> resultIndices;
+        std::vector<BigInteger> allParents ((size_t) numNodes);
+
+        for (int i = 0; i < numNodes; ++i)
+        {
+            const auto insertionIndex = std::find_if (resultIndices.begin(), resultIndices.end(), [&] (int other)
+            {
+                return allParents[(size_t) other][i];
+            }) - resultIndices.begin();
+
+            result.insert ((int) insertionIndex, nodes.getUnchecked (i));
+            resultIndices.insert (resultIndices.begin() + insertionIndex, i);
+            getAllParentsOfNode (i, i, allParents[(size_t) i], directParents, allParents);
         }
 
         return result;
@@ -1148,6 +1729,9 @@ private:
             // channel with a straightforward single input..
             auto src = *sources.begin();
 
+            if (const auto shared = getSharedDelayLine (sequence, src, maxLatency - getNodeDelay (src.nodeID), inputChan < numOuts); shared >= 0)
+                return shared;
+
             int bufIndex = getBufferContaining (src);
 
             if (bufIndex < 0)
@@ -1177,6 +1761,7 @@ private:
         // Handle a mix of several outputs coming into this input..
         int reusableInputIndex = -1;
         int bufIndex = -1;
+        int alreadyMixedIndex = -1;
 
         {
             auto i = 0;
@@ -1184,7 +1769,9 @@ private:
             {
                 auto sourceBufIndex = getBufferContaining (src);
 
-                if (sourceBufIndex >= 0 && ! isBufferNeededLater (reversed, ourRenderingIndex, inputChan, src))
+                if (sourceBufIndex >= 0
+                    && ! isBufferNeededLater (reversed, ourRenderingIndex, inputChan, src)
+                    && ! hasSharedDelayLine (src, maxLatency - getNodeDelay (src.nodeID)))
                 {
                     // we've found one of our input chans that can be re-used..
                     reusableInputIndex = i;
@@ -1210,25 +1797,46 @@ private:
 
             audioBuffers.getReference (bufIndex).setAssignedToNonExistentNode();
 
-            auto srcIndex = getBufferContaining (*sources.begin());
+            const auto firstSource = *sources.begin();
+            const auto secondSource = *std::next (sources.begin());
+            auto srcIndex = getBufferContaining (firstSource);
+            const auto secondSrcIndex = getBufferContaining (secondSource);
+
+            const auto needsDelay = [&] (NodeAndChannel src) { return getNodeDelay (src.nodeID) < maxLatency; };
+            const auto sharedIndex = srcIndex >= 0 ? getSharedDelayLine (sequence, firstSource, maxLatency - getNodeDelay (firstSource.nodeID), false)
+                                                   : -1;
 
-            if (srcIndex < 0)
+            if (sharedIndex >= 0)
+            {
+                sequence.addCopyChannelOp (sharedIndex, bufIndex);
+            }
+            else if (srcIndex >= 0 && secondSrcIndex >= 0 && ! needsDelay (firstSource) && ! needsDelay (secondSource))
+            {
+                // Writing the sum of the first two inputs straight into the new buffer saves
+                // copying the first input before adding the second one
+                sequence.addSumChannelsOp (srcIndex, secondSrcIndex, bufIndex);
+                alreadyMixedIndex = 1;
+            }
+            else if (srcIndex < 0)
+            {
                 sequence.addClearChannelOp (bufIndex);  // if not found, this is probably a feedback loop
+            }
             else
+            {
                 sequence.addCopyChannelOp (srcIndex, bufIndex);
+            }
 
             reusableInputIndex = 0;
-            auto nodeDelay = getNodeDelay (sources.begin()->nodeID);
 
-            if (nodeDelay < maxLatency)
-                sequence.addDelayChannelOp (bufIndex, maxLatency - nodeDelay);
+            if (sharedIndex < 0 && needsDelay (firstSource))
+                sequence.addDelayChannelOp (bufIndex, maxLatency - getNodeDelay (firstSource.nodeID));
         }
 
         {
             auto i = 0;
             for (const auto& src : sources)
             {
-                if (i != reusableInputIndex)
+                if (i != reusableInputIndex && i != alreadyMixedIndex)
                 {
                     int srcIndex = getBufferContaining (src);
 
@@ -1238,7 +1846,11 @@ private:
 
                         if (nodeDelay < maxLatency)
                         {
-                            if (! isBufferNeededLater (reversed, ourRenderingIndex, inputChan, src))
+                            if (const auto shared = getSharedDelayLine (sequence, src, maxLatency - nodeDelay, false); shared >= 0)
+                            {
+                                srcIndex = shared;
+                            }
+                            else if (! isBufferNeededLater (reversed, ourRenderingIndex, inputChan, src))
                             {
                                 sequence.addDelayChannelOp (srcIndex, maxLatency - nodeDelay);
                             }
@@ -1421,14 +2033,139 @@ private:
             totalLatency = jmax (totalLatency, thisNodeLatency);
 
         sequence.addProcessOp (node, audioChannelsToUse, totalChans, midiBufferToUse);
+
+        auto lastStep = ourRenderingIndex;
+
+        for (int outputChan = 0; outputChan < numOuts; ++outputChan)
+            if (const auto iter = lastStepReadingOutput.find ({ node.nodeID, outputChan }); iter != lastStepReadingOutput.end())
+                lastStep = jmax (lastStep, iter->second);
+
+        if (const auto iter = lastStepReadingOutput.find ({ node.nodeID, midiChannelIndex }); iter != lastStepReadingOutput.end())
+            lastStep = jmax (lastStep, iter->second);
+
+        bufferUsage.nodes.push_back ({ node.nodeID,
+                                       ourRenderingIndex,
+                                       lastStep,
+                                       { audioChannelsToUse.begin(), audioChannelsToUse.end() },
+                                       midiBufferToUse });
     }
 
     //==============================================================================
-    static int getFreeBuffer (Array<AssignedBuffer>& buffers)
+    /*  Finds the node outputs that more than one input needs to read with the same delay, so that
+        those inputs can share a single delay line rather than each delaying their own copy.
+        This works through the nodes in rendering order, in the same way as the main pass, but
+        without creating any ops.
+    */
+    void findSharedDelayLines (const Connections& c)
     {
-        for (int i = 1; i < buffers.size(); ++i)
-            if (buffers.getReference (i).isFree())
-                return i;
+        std::unordered_map<uint32, int> nodeDelays;
+        std::map<std::pair<NodeAndChannel, int>, int> numReaders;
+
+        for (auto* node : orderedNodes)
+        {
+            const auto sources = c.getSourceNodesForDestination (node->nodeID);
+            const auto maxLatency = std::accumulate (sources.cbegin(), sources.cend(), 0, [&] (auto acc, auto source)
+            {
+                const auto iter = nodeDelays.find (source.uid);
+                return jmax (acc, iter != nodeDelays.end() ? iter->second : 0);
+            });
+
+            auto& processor = *node->getProcessor();
+
+            for (int inputChan = 0; inputChan < processor.getTotalNumInputChannels(); ++inputChan)
+            {
+                for (const auto& src : c.getSourcesForDestination ({ node->nodeID, inputChan }))
+                {
+                    // Sources that haven't been rendered yet are part of a feedback loop
+                    const auto iter = nodeDelays.find (src.nodeID.uid);
+
+                    if (iter != nodeDelays.end() && iter->second < maxLatency)
+                        ++numReaders[{ src, maxLatency - iter->second }];
+                }
+            }
+
+            nodeDelays[node->nodeID.uid] = maxLatency + processor.getLatencySamples();
+        }
+
+        for (const auto& [key, count] : numReaders)
+            if (count > 1)
+                sharedDelayLines.emplace (key, SharedDelayLine { count, -1 });
+    }
+
+    bool hasSharedDelayLine (NodeAndChannel src, int delay) const
+    {
+        const auto iter = sharedDelayLines.find ({ src, delay });
+        return iter != sharedDelayLines.end() && iter->second.numReadersLeft > 0;
+    }
+
+    /*  Returns the index of a buffer holding the source's output delayed by the given amount, or
+        -1 if this delay isn't shared with any other inputs.
+
+        The first reader adds the ops that fill the shared buffer. A longer delay can continue
+        from a shorter delay of the same output that's still in use, so that the shorter part of
+        the signal isn't stored twice. Readers other than the last one mustn't modify the shared
+        buffer, so if needsWritableCopy is true they'll be given a copy of it instead.
+    */
+    template <typename RenderSequence>
+    int getSharedDelayLine (RenderSequence& sequence, NodeAndChannel src, int delay, bool needsWritableCopy)
+    {
+        const auto iter = sharedDelayLines.find ({ src, delay });
+
+        if (iter == sharedDelayLines.end() || iter->second.numReadersLeft <= 0)
+            return -1;
+
+        auto& line = iter->second;
+
+        if (line.bufferIndex < 0)
+        {
+            auto fromIndex = getBufferContaining (src);
+            auto remainingDelay = delay;
+
+            if (fromIndex < 0)
+                return -1;
+
+            for (auto shorter = std::make_reverse_iterator (iter); shorter != sharedDelayLines.rend() && shorter->first.first == src; ++shorter)
+            {
+                if (shorter->second.bufferIndex >= 0)
+                {
+                    fromIndex = shorter->second.bufferIndex;
+                    remainingDelay = delay - shorter->first.second;
+                    break;
+                }
+            }
+
+            line.bufferIndex = getFreeBuffer (audioBuffers);
+            audioBuffers.getReference (line.bufferIndex).setHoldsSharedDelayLine();
+            sequence.addCopyChannelOp (fromIndex, line.bufferIndex);
+            sequence.addDelayChannelOp (line.bufferIndex, remainingDelay);
+        }
+
+        const auto index = line.bufferIndex;
+
+        if (--line.numReadersLeft > 0)
+        {
+            if (! needsWritableCopy)
+                return index;
+
+            const auto copy = getFreeBuffer (audioBuffers);
+            sequence.addCopyChannelOp (index, copy);
+            return copy;
+        }
+
+        // The last reader takes over the buffer, which will be freed after this step unless the
+        // node keeps it as one of its outputs
+        line.bufferIndex = -1;
+        audioBuffers.getReference (index).setAssignedToNonExistentNode();
+        return index;
+    }
+
+    //==============================================================================
+    int getFreeBuffer (Array<AssignedBuffer>& buffers) const
+    {
+        if (recycleBuffers)
+            for (int i = 1; i < buffers.size(); ++i)
+                if (buffers.getReference (i).isFree())
+                    return i;
 
         buffers.add (AssignedBuffer::createFree());
         return buffers.size() - 1;
@@ -1454,7 +2191,7 @@ private:
                                      const int stepIndex)
     {
         for (auto& b : buffers)
-            if (b.isAssigned() && ! isBufferNeededLater (c, stepIndex, -1, b.channel))
+            if (b.isAssigned() && ! b.holdsSharedDelayLine() && ! isBufferNeededLater (c, stepIndex, -1, b.channel))
                 b.setFree();
     }
 
@@ -1473,20 +2210,43 @@ private:
             return true;
         }
 
-        return std::any_of (orderedNodes.begin() + stepIndexToSearchFrom + 1, orderedNodes.end(), [&] (const auto* node)
+        const auto iter = lastStepReadingOutput.find (output);
+        return iter != lastStepReadingOutput.end() && iter->second > stepIndexToSearchFrom;
+    }
+
+    /*  Finds the last step that reads from each node output, so that isBufferNeededLater doesn't
+        need to search through all of the following steps.
+    */
+    void findLastStepReadingEachOutput (const Connections& c)
+    {
+        std::unordered_map<uint32, int> stepForNode;
+
+        for (int i = 0; i < orderedNodes.size(); ++i)
+            stepForNode[orderedNodes.getUnchecked (i)->nodeID.uid] = i;
+
+        for (const auto& connection : c.getConnections())
         {
-            return c.isSourceConnectedToDestinationNodeIgnoringChannel (output, node->nodeID, -1);
-        });
+            const auto iter = stepForNode.find (connection.destination.nodeID.uid);
+
+            if (iter == stepForNode.end())
+                continue;
+
+            auto& lastStep = lastStepReadingOutput.emplace (connection.source, -1).first->second;
+            lastStep = jmax (lastStep, iter->second);
+        }
     }
 
     template <typename RenderSequence>
-    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence)
-        : orderedNodes (createOrderedNodeList (n, c))
+    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence, bool recycle)
+        : orderedNodes (createOrderedNodeList (n, c)),
+          recycleBuffers (recycle)
     {
         audioBuffers.add (AssignedBuffer::createReadOnlyEmpty()); // first buffer is read-only zeros
         midiBuffers .add (AssignedBuffer::createReadOnlyEmpty());
 
         const auto reversed = c.getDestinationsForSources();
+        findLastStepReadingEachOutput (c);
+        findSharedDelayLines (c);
 
         for (int i = 0; i < orderedNodes.size(); ++i)
         {
@@ -1497,6 +2257,9 @@ private:
 
         sequence.numBuffersNeeded = audioBuffers.size();
         sequence.numMidiBuffersNeeded = midiBuffers.size();
+
+        bufferUsage.numAudioBuffers = audioBuffers.size();
+        bufferUsage.numMidiBuffers = midiBuffers.size();
     }
 };
 
@@ -1512,24 +2275,69 @@ class RenderSequence
 public:
     using AudioGraphIOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
 
-    RenderSequence (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : RenderSequence (s, s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
-                                ? RenderSequenceBuilder::build<float>  (n, c)
-                                : RenderSequenceBuilder::build<double> (n, c))
+    RenderSequence (const PrepareSettings s,
+                    const Nodes& n,
+                    const Connections& c,
+                    std::shared_ptr<RealtimeThreadPool> w)
+        : RenderSequence (s,
+                          s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
+                              ? RenderSequenceBuilder::build<float>  (n, c, w == nullptr)
+                              : RenderSequenceBuilder::build<double> (n, c, w == nullptr),
+                          std::move (w))
     {
     }
 
     template <typename FloatType>
-    void process (AudioBuffer<FloatType>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
+    void process (AudioBuffer<FloatType>& audio, MidiBuffer& midi, AudioPlayHead* playHead, bool measureNodes)
     {
+        JUCE_TRACE_SCOPE ("audio", "AudioProcessorGraph::process");
+
         if (auto* s = std::get_if<GraphRenderSequence<FloatType>> (&sequence.sequence))
-            s->perform (audio, midi, playHead);
+            s->perform (audio, midi, playHead, workers.get(), settings.sampleRate, measureNodes);
         else
             jassertfalse; // Not prepared for this audio format!
     }
 
+    /*  Call on the main thread only.
+
+        If the only difference between this sequence and one built from the given nodes and
+        connections is the amount by which some paths are delayed, the new delays are applied to
+        this sequence and this returns true. Otherwise, this sequence is left unchanged and a new
+        one must be built.
+    */
+    bool updateLatencies (const Nodes& n, const Connections& c)
+    {
+        auto built = settings.precision == AudioProcessor::ProcessingPrecision::singlePrecision
+                   ? RenderSequenceBuilder::build<float>  (n, c, workers == nullptr)
+                   : RenderSequenceBuilder::build<double> (n, c, workers == nullptr);
+
+        auto updated = false;
+
+        visitRenderSequence (*this, [&] (auto& seq)
+        {
+            using Sequence = std::decay_t<decltype (seq)>;
+
+            if (auto* other = std::get_if<Sequence> (&built.sequence))
+                updated = seq.takeDelayLinesFrom (*other);
+        });
+
+        if (! updated)
+            return false;
+
+        sequence.latencySamples = built.latencySamples;
+
+        visitRenderSequence (*this, [&] (auto& seq)
+        {
+            sequence.bufferUsage.delayLineBytes = seq.getDelayLineBytes();
+        });
+
+        return true;
+    }
+
     int getLatencySamples() const { return sequence.latencySamples; }
+    const AudioProcessorGraph::BufferUsage& getBufferUsage() const { return sequence.bufferUsage; }
     PrepareSettings getSettings() const { return settings; }
+    RealtimeThreadPool* getWorkers() const { return workers.get(); }
 
 private:
     template <typename This, typename Callback>
@@ -1540,14 +2348,22 @@ private:
         jassertfalse;
     }
 
-    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built)
-        : settings (s), sequence (std::move (built))
+    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built, std::shared_ptr<RealtimeThreadPool> w)
+        : settings (s), sequence (std::move (built)), workers (std::move (w))
     {
-        visitRenderSequence (*this, [&] (auto& seq) { seq.prepareBuffers (settings.blockSize); });
+        visitRenderSequence (*this, [&] (auto& seq)
+        {
+            seq.prepareBuffers (settings.blockSize, workers != nullptr);
+            sequence.bufferUsage.audioBufferBytes = seq.getAudioBufferBytes();
+            sequence.bufferUsage.delayLineBytes = seq.getDelayLineBytes();
+        });
     }
 
     PrepareSettings settings;
     SequenceAndLatency sequence;
+
+    // Shared with the graph, so that the worker threads outlive any sequence that might use them
+    std::shared_ptr<RealtimeThreadPool> workers;
 };
 
 //==============================================================================
@@ -1576,15 +2392,27 @@ public:
 */
 class RenderSequenceSignature
 {
-    auto tie() const { return std::tie (settings, connections, nodes); }
+    auto tie() const { return std::tie (settings, connections, nodes, numRenderThreads); }
 
 public:
-    RenderSequenceSignature (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : settings (s), connections (c), nodes (getNodeMap (n)) {}
+    RenderSequenceSignature (const PrepareSettings s, const Nodes& n, const Connections& c, int threads)
+        : settings (s), connections (c), nodes (getNodeMap (n)), numRenderThreads (threads) {}
 
     bool operator== (const RenderSequenceSignature& other) const { return tie() == other.tie(); }
     bool operator!= (const RenderSequenceSignature& other) const { return tie() != other.tie(); }
 
+    /*  Returns true if the two configurations have the same nodes, connections and layouts, and
+        so can only differ in the latencies of their nodes.
+    */
+    bool differsOnlyInLatencyFrom (const RenderSequenceSignature& other) const
+    {
+        return std::tie (settings, connections, numRenderThreads) == std::tie (other.settings, other.connections, other.numRenderThreads)
+            && std::equal (nodes.begin(), nodes.end(), other.nodes.begin(), other.nodes.end(), [] (const auto& a, const auto& b)
+               {
+                   return a.first == b.first && a.second.layout == b.second.layout;
+               });
+    }
+
 private:
     using NodeMap = std::map<AudioProcessorGraph::NodeID, NodeAttributes>;
 
@@ -1607,6 +2435,7 @@ private:
     PrepareSettings settings;
     Connections connections;
     NodeMap nodes;
+    int numRenderThreads = 0;
 };
 
 //==============================================================================
@@ -1653,6 +2482,15 @@ public:
     /*  Call from the audio thread only. */
     RenderSequence* getAudioThreadState() const { return audioThreadState.get(); }
 
+    /*  Call from the main thread only. Returns the sequence that the audio thread will use for
+        its next block. This stays valid until the next call to set().
+    */
+    RenderSequence* getLatestState()
+    {
+        const SpinLock::ScopedLockType lock (mutex);
+        return isNew ? mainThreadState.get() : audioThreadState.get();
+    }
+
 private:
     void timerCallback() override
     {
@@ -1696,11 +2534,17 @@ bool AudioProcessorGraph::Connection::operator< (const Connection& other) const
 }
 
 //==============================================================================
-class AudioProcessorGraph::Pimpl
+class AudioProcessorGraph::Pimpl : private AudioProcessorListener
 {
 public:
     explicit Pimpl (AudioProcessorGraph& o) : owner (&o) {}
 
+    ~Pimpl() override
+    {
+        for (auto* node : nodes.getNodes())
+            node->getProcessor()->removeListener (this);
+    }
+
     const auto& getNodes() const { return nodes.getNodes(); }
 
     void clear (UpdateKind updateKind)
@@ -1708,6 +2552,9 @@ public:
         if (getNodes().isEmpty())
             return;
 
+        for (auto* node : getNodes())
+            node->getProcessor()->removeListener (this);
+
         nodes = Nodes{};
         connections = Connections{};
         nodeStates.clear();
@@ -1740,6 +2587,7 @@ public:
             lastNodeID = idToUse;
 
         setParentGraph (added->getProcessor());
+        added->getProcessor()->addListener (this);
 
         topologyChanged (updateKind);
         return added;
@@ -1749,6 +2597,10 @@ public:
     {
         connections.disconnectNode (nodeID);
         auto result = nodes.removeNode (nodeID);
+
+        if (result != nullptr)
+            result->getProcessor()->removeListener (this);
+
         nodeStates.removeNode (nodeID);
         topologyChanged (updateKind);
         return result;
@@ -1868,6 +2720,48 @@ public:
             n->getProcessor()->setNonRealtime (isProcessingNonRealtime);
     }
 
+    void setNumParallelRenderThreads (int numThreads)
+    {
+        if (jmax (0, numThreads) != getNumParallelRenderThreads())
+            setNumParallelRenderThreads (numThreads, RealtimeThreadPool::Options{}.withThreadName ("Graph Render Worker"));
+    }
+
+    void setNumParallelRenderThreads (int numThreads, const RealtimeThreadPool::Options& workerOptions)
+    {
+        numThreads = jmax (0, numThreads);
+
+        renderWorkers = numThreads > 0 ? std::make_shared<RealtimeThreadPool> (workerOptions.withNumberOfThreads (numThreads)
+                                                                                            .withMaxNumJobs (numThreads + 1))
+                                       : nullptr;
+        rebuild (UpdateKind::sync);
+    }
+
+    int getNumParallelRenderThreads() const
+    {
+        return renderWorkers != nullptr ? renderWorkers->getNumThreads() : 0;
+    }
+
+    void setNodeTimingEnabled (bool shouldBeEnabled) noexcept
+    {
+        nodeTimingEnabled.store (shouldBeEnabled, std::memory_order_relaxed);
+    }
+
+    bool isNodeTimingEnabled() const noexcept
+    {
+        return nodeTimingEnabled.load (std::memory_order_relaxed);
+    }
+
+    BufferUsage getBufferUsage() const
+    {
+        return bufferUsage;
+    }
+
+    /*  Call from the audio thread only. */
+    void setWorkgroup (const AudioWorkgroup& newWorkgroup)
+    {
+        workgroup = newWorkgroup;
+    }
+
     template <typename Value>
     void processBlock (AudioBuffer<Value>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
     {
@@ -1890,7 +2784,10 @@ public:
         // Only process if the graph has the correct blockSize, sampleRate etc.
         if (state != nullptr && state->getSettings() == nodeStates.getLastRequestedSettings())
         {
-            state->process (audio, midi, playHead);
+            if (auto* workers = state->getWorkers())
+                workers->setWorkgroup (workgroup);
+
+            state->process (audio, midi, playHead, nodeTimingEnabled.load (std::memory_order_relaxed));
         }
         else
         {
@@ -1922,22 +2819,71 @@ private:
             for (const auto node : nodes.getNodes())
                 setParentGraph (node->getProcessor());
 
-            const RenderSequenceSignature newSignature (*newSettings, nodes, connections);
+            const RenderSequenceSignature newSignature (*newSettings, nodes, connections, getNumParallelRenderThreads());
+
+            const auto previousSignature = std::exchange (lastBuiltSequence, newSignature);
+
+            if (previousSignature != newSignature && ! updateLatenciesInPlace (previousSignature, newSignature))
+            {
+                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections, renderWorkers);
+                owner->setLatencySamples (sequence->getLatencySamples());
+                bufferUsage = sequence->getBufferUsage();
+                renderSequenceExchange.set (std::move (sequence));
+            }
+        }
+        else
+        {
+            lastBuiltSequence.reset();
+            bufferUsage = {};
+            renderSequenceExchange.set (nullptr);
+        }
+    }
+
+    /*  When nothing but the latencies of some nodes has changed, the sequence that's already
+        running can keep its buffers and ops, and only the delay lines that compensate for those
+        latencies need to be replaced.
+    */
+    bool updateLatenciesInPlace (const std::optional<RenderSequenceSignature>& previousSignature,
+                                 const RenderSequenceSignature& newSignature)
+    {
+        if (! previousSignature.has_value() || ! previousSignature->differsOnlyInLatencyFrom (newSignature))
+            return false;
+
+        auto* sequence = renderSequenceExchange.getLatestState();
+
+        if (sequence == nullptr || ! sequence->updateLatencies (nodes, connections))
+            return false;
+
+        owner->setLatencySamples (sequence->getLatencySamples());
+        bufferUsage = sequence->getBufferUsage();
+        return true;
+    }
+
+    /*  Changing the latency of a node only updates the delay lines of the current sequence.
+        Any other changes are left for the next rebuild, which may have been deferred on purpose.
+    */
+    void handleLatencyChange()
+    {
+        if (! lastBuiltSequence.has_value())
+            return;
 
-            if (std::exchange (lastBuiltSequence, newSignature) != newSignature)
-            {
-                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections);
-                owner->setLatencySamples (sequence->getLatencySamples());
-                renderSequenceExchange.set (std::move (sequence));
-            }
-        }
-        else
+        if (const auto settings = nodeStates.getLastRequestedSettings())
         {
-            lastBuiltSequence.reset();
-            renderSequenceExchange.set (nullptr);
+            const RenderSequenceSignature newSignature (*settings, nodes, connections, getNumParallelRenderThreads());
+
+            if (*lastBuiltSequence != newSignature && updateLatenciesInPlace (lastBuiltSequence, newSignature))
+                lastBuiltSequence = newSignature;
         }
     }
 
+    void audioProcessorParameterChanged (AudioProcessor*, int, float) override {}
+
+    void audioProcessorChanged (AudioProcessor*, const ChangeDetails& details) override
+    {
+        if (details.latencyChanged)
+            latencyUpdater.triggerAsyncUpdate();
+    }
+
     AudioProcessorGraph* owner = nullptr;
     Nodes nodes;
     Connections connections;
@@ -1945,7 +2891,12 @@ private:
     RenderSequenceExchange renderSequenceExchange;
     NodeID lastNodeID;
     std::optional<RenderSequenceSignature> lastBuiltSequence;
+    BufferUsage bufferUsage;
+    std::shared_ptr<RealtimeThreadPool> renderWorkers;
+    std::atomic<bool> nodeTimingEnabled { false };
+    AudioWorkgroup workgroup;
     LockingAsyncUpdater updater { [this] { handleAsyncUpdate(); } };
+    LockingAsyncUpdater latencyUpdater { [this] { handleLatencyChange(); } };
 };
 
 //==============================================================================
@@ -1994,6 +2945,66 @@ void AudioProcessorGraph::setNonRealtime (bool isProcessingNonRealtime) noexcept
     pimpl->setNonRealtime (isProcessingNonRealtime);
 }
 
+void AudioProcessorGraph::audioWorkgroupContextChanged (const AudioWorkgroup& workgroup)
+{
+    pimpl->setWorkgroup (workgroup);
+}
+
+void AudioProcessorGraph::setNumParallelRenderThreads (int numThreads)  { pimpl->setNumParallelRenderThreads (numThreads); }
+void AudioProcessorGraph::setNumParallelRenderThreads (int numThreads, const RealtimeThreadPool::Options& o) { pimpl->setNumParallelRenderThreads (numThreads, o); }
+int AudioProcessorGraph::getNumParallelRenderThreads() const            { return pimpl->getNumParallelRenderThreads(); }
+AudioProcessorGraph::BufferUsage AudioProcessorGraph::getBufferUsage() const { return pimpl->getBufferUsage(); }
+void AudioProcessorGraph::setNodeTimingEnabled (bool shouldBeEnabled) noexcept { pimpl->setNodeTimingEnabled (shouldBeEnabled); }
+bool AudioProcessorGraph::isNodeTimingEnabled() const noexcept           { return pimpl->isNodeTimingEnabled(); }
+
+//==============================================================================
+void AudioProcessorGraph::Node::addProcessingTime (double milliseconds) noexcept
+{
+    // Only one thread processes a given node at a time, so there's only ever one writer here
+    const auto index = timings.resetRequested.exchange (false, std::memory_order_relaxed)
+                     ? 0
+                     : timings.numWritten.load (std::memory_order_relaxed);
+    timings.milliseconds[index % Timings::historySize].store ((float) milliseconds, std::memory_order_relaxed);
+    timings.numWritten.store (index + 1, std::memory_order_release);
+}
+
+AudioProcessorGraph::Node::ProcessingStats AudioProcessorGraph::Node::getProcessingStats() const
+{
+    ProcessingStats stats;
+    stats.numOverruns = (int) timings.numOverruns.load (std::memory_order_relaxed);
+
+    if (timings.resetRequested.load (std::memory_order_relaxed))
+        return stats;
+
+    const auto numWritten = timings.numWritten.load (std::memory_order_acquire);
+    const auto numBlocks = jmin (numWritten, Timings::historySize);
+
+    if (numBlocks == 0)
+        return stats;
+
+    std::array<float, Timings::historySize> sorted;
+
+    for (uint32 i = 0; i < numBlocks; ++i)
+        sorted[i] = timings.milliseconds[i].load (std::memory_order_relaxed);
+
+    const auto end = sorted.begin() + numBlocks;
+    std::sort (sorted.begin(), end);
+
+    stats.numBlocks = (int) numBlocks;
+    stats.minMilliseconds = sorted.front();
+    stats.maxMilliseconds = *(end - 1);
+    stats.averageMilliseconds = std::accumulate (sorted.begin(), end, 0.0) / numBlocks;
+    stats.p99Milliseconds = sorted[(size_t) jmax (0, roundToInt (std::ceil (0.99 * numBlocks)) - 1)];
+    return stats;
+}
+
+void AudioProcessorGraph::Node::resetProcessingStats() noexcept
+{
+    // The history is discarded by the thread that writes it, the next time this node is measured
+    timings.resetRequested.store (true, std::memory_order_relaxed);
+    timings.numOverruns.store (0, std::memory_order_relaxed);
+}
+
 AudioProcessorGraph::Node::Ptr AudioProcessorGraph::removeNode (NodeID nodeID, UpdateKind updateKind)
 {
     return pimpl->removeNode (nodeID, updateKind);
@@ -2294,12 +3305,434 @@ public:
             // this graph, so we just want to make sure that we finish the test without timing out.
             logMessage ("render sequence built in " + String (duration) + " ms");
         }
+
+        beginTest ("parallel rendering produces the same output as serial rendering");
+        {
+            constexpr auto numChains = 16;
+            constexpr auto chainLength = 4;
+            constexpr auto blockSize = 256;
+
+            const auto render = [&] (int numThreads, std::optional<RealtimeThreadPool::Options> workerOptions = {})
+            {
+                AudioProcessorGraph graph;
+
+                if (workerOptions.has_value())
+                    graph.setNumParallelRenderThreads (numThreads, *workerOptions);
+                else
+                    graph.setNumParallelRenderThreads (numThreads);
+
+                expect (graph.getNumParallelRenderThreads() == numThreads);
+
+                graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+                using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+                const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+                const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+                for (auto chain = 0; chain < numChains; ++chain)
+                {
+                    auto previous = input;
+
+                    for (auto i = 0; i < chainLength; ++i)
+                    {
+                        const auto node = graph.addNode (std::make_unique<GainProcessor> ((float) (chain + 1) * 0.01f + (float) i * 0.1f))->nodeID;
+
+                        for (auto channel = 0; channel < 2; ++channel)
+                            expect (graph.addConnection ({ { previous, channel }, { node, channel } }));
+
+                        previous = node;
+                    }
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                        expect (graph.addConnection ({ { previous, channel }, { output, channel } }));
+                }
+
+                graph.prepareToPlay (44100.0, blockSize);
+
+                AudioBuffer<float> buffer (2, blockSize);
+                MidiBuffer midi;
+
+                for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    for (auto sample = 0; sample < buffer.getNumSamples(); ++sample)
+                        buffer.setSample (channel, sample, std::sin ((float) (sample + channel) * 0.1f));
+
+                for (auto block = 0; block < 8; ++block)
+                {
+                    AudioBuffer<float> copy (buffer);
+                    graph.processBlock (copy, midi);
+
+                    if (block == 7)
+                        return copy;
+                }
+
+                return buffer;
+            };
+
+            const auto serial = render (0);
+            const auto parallel = render (3);
+
+            // The thread count in the options is overridden by the graph
+            const auto pinned = render (2, RealtimeThreadPool::Options{}.withThreadName ("Pinned Graph Worker")
+                                                                        .withNumberOfThreads (5)
+                                                                        .withWorkerCores ({ 0 }));
+
+            for (auto channel = 0; channel < serial.getNumChannels(); ++channel)
+            {
+                for (auto sample = 0; sample < serial.getNumSamples(); ++sample)
+                {
+                    expectWithinAbsoluteError (parallel.getSample (channel, sample), serial.getSample (channel, sample), 1.0e-6f);
+                    expectWithinAbsoluteError (pinned.getSample (channel, sample), serial.getSample (channel, sample), 1.0e-6f);
+                }
+            }
+
+            expect (serial.getMagnitude (0, blockSize) > 0.0f);
+        }
+
+        beginTest ("buffer usage describes the render sequence");
+        {
+            constexpr auto blockSize = 128;
+
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+            const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+            const auto first  = graph.addNode (std::make_unique<GainProcessor> (0.5f))->nodeID;
+            const auto second = graph.addNode (std::make_unique<GainProcessor> (0.5f))->nodeID;
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                expect (graph.addConnection ({ { input,  channel }, { first,  channel } }));
+                expect (graph.addConnection ({ { first,  channel }, { second, channel } }));
+                expect (graph.addConnection ({ { second, channel }, { output, channel } }));
+            }
+
+            expect (graph.getBufferUsage().nodes.empty());
+
+            graph.prepareToPlay (44100.0, blockSize);
+
+            const auto usage = graph.getBufferUsage();
+            expectEquals ((int) usage.nodes.size(), 4);
+            expectEquals (usage.audioBufferBytes, (size_t) (usage.numAudioBuffers + 1) * blockSize * sizeof (float));
+            expectEquals (usage.delayLineBytes, (size_t) 0);
+
+            // A simple chain can be processed in-place, using one buffer per channel
+            expectEquals (usage.numAudioBuffers, 3);
+
+            const auto findNode = [&] (AudioProcessorGraph::NodeID id)
+            {
+                return *std::find_if (usage.nodes.begin(), usage.nodes.end(), [&] (const auto& n) { return n.nodeID == id; });
+            };
+
+            const auto inputInfo  = findNode (input);
+            const auto firstInfo  = findNode (first);
+            const auto secondInfo = findNode (second);
+            const auto outputInfo = findNode (output);
+
+            expect (inputInfo.renderStep < firstInfo.renderStep);
+            expect (firstInfo.renderStep < secondInfo.renderStep);
+            expect (secondInfo.renderStep < outputInfo.renderStep);
+
+            expectEquals (inputInfo.lastStepReadingOutputs, firstInfo.renderStep);
+            expectEquals (secondInfo.lastStepReadingOutputs, outputInfo.renderStep);
+            expectEquals (outputInfo.lastStepReadingOutputs, outputInfo.renderStep);
+            expect (firstInfo.audioBuffers == secondInfo.audioBuffers);
+
+            graph.releaseResources();
+            graph.rebuild();
+            expect (graph.getBufferUsage().nodes.empty());
+        }
+
+        beginTest ("mixing inputs that are also used by other nodes produces the correct sum");
+        {
+            constexpr auto blockSize = 32;
+
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+            const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+            const auto a      = graph.addNode (std::make_unique<GainProcessor> (0.5f))->nodeID;
+            const auto b      = graph.addNode (std::make_unique<GainProcessor> (0.25f))->nodeID;
+            const auto mixA   = graph.addNode (std::make_unique<GainProcessor> (1.0f))->nodeID;
+            const auto mixB   = graph.addNode (std::make_unique<GainProcessor> (2.0f))->nodeID;
+
+            // Both mixers read both sources, so the first mixer can't reuse either source buffer
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                for (const auto source : { a, b })
+                {
+                    expect (graph.addConnection ({ { input,  channel }, { source, channel } }));
+                    expect (graph.addConnection ({ { source, channel }, { mixA,   channel } }));
+                    expect (graph.addConnection ({ { source, channel }, { mixB,   channel } }));
+                }
+
+                expect (graph.addConnection ({ { mixA, channel }, { output, channel } }));
+                expect (graph.addConnection ({ { mixB, channel }, { output, channel } }));
+            }
+
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> audio (2, blockSize);
+            MidiBuffer midi;
+
+            for (auto channel = 0; channel < 2; ++channel)
+                for (auto i = 0; i < blockSize; ++i)
+                    audio.setSample (channel, i, (float) (i + 1));
+
+            graph.processBlock (audio, midi);
+
+            // (0.5 + 0.25) * 1 + (0.5 + 0.25) * 2
+            for (auto channel = 0; channel < 2; ++channel)
+                for (auto i = 0; i < blockSize; ++i)
+                    expectEquals (audio.getSample (channel, i), 2.25f * (float) (i + 1));
+        }
+
+        beginTest ("inputs that need the same delay share a delay line");
+        {
+            constexpr auto blockSize = 64;
+            constexpr auto latency = 100;
+
+            AudioProcessorGraph graph;
+            addBussesWithLatency (graph, blockSize, latency);
+            graph.prepareToPlay (44100.0, blockSize);
+
+            // Every bus needs the direct path delayed by the same amount, so one delay line per
+            // channel is enough
+            expectEquals (graph.getLatencySamples(), latency);
+            expectEquals (graph.getBufferUsage().delayLineBytes, (size_t) (2 * (latency + 1)) * sizeof (float));
+
+            for (auto block = 0; block < 6; ++block)
+                expectBussesAreAligned (graph, blockSize, block, latency);
+        }
+
+        beginTest ("changing a node's latency updates the delays without rebuilding the graph");
+        {
+            constexpr auto blockSize = 64;
+            constexpr auto latency = 100;
+            constexpr auto newLatency = 60;
+
+            AudioProcessorGraph graph;
+            const auto delayed = addBussesWithLatency (graph, blockSize, latency);
+            graph.prepareToPlay (44100.0, blockSize);
+
+            const auto numAudioBuffers = graph.getBufferUsage().numAudioBuffers;
+
+            for (auto block = 0; block < 3; ++block)
+                expectBussesAreAligned (graph, blockSize, block, latency);
+
+            graph.getNodeForId (delayed)->getProcessor()->setLatencySamples (newLatency);
+            graph.rebuild();
+
+            expectEquals (graph.getLatencySamples(), newLatency);
+            expectEquals (graph.getBufferUsage().numAudioBuffers, numAudioBuffers);
+            expectEquals (graph.getBufferUsage().delayLineBytes, (size_t) (2 * (newLatency + 1)) * sizeof (float));
+
+            // The shorter delay lines start with the most recent input, so there's no gap in the
+            // output, which there would be if the graph had been rebuilt with empty delay lines
+            for (auto block = 3; block < 6; ++block)
+                expectBussesAreAligned (graph, blockSize, block, newLatency);
+        }
+
+        beginTest ("double precision graphs only convert channels for nodes that need single precision");
+        {
+            constexpr auto blockSize = 16;
+
+            const auto process = [&] (std::initializer_list<bool> nodesSupportDouble, double inputValue)
+            {
+                AudioProcessorGraph graph;
+                graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+                graph.setProcessingPrecision (AudioProcessor::doublePrecision);
+
+                using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+                auto previous = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+
+                for (const auto supportsDouble : nodesSupportDouble)
+                {
+                    const auto node = graph.addNode (std::make_unique<GainProcessor> (1.0f, supportsDouble))->nodeID;
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                        expect (graph.addConnection ({ { previous, channel }, { node, channel } }));
+
+                    previous = node;
+                }
+
+                const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+                for (auto channel = 0; channel < 2; ++channel)
+                    expect (graph.addConnection ({ { previous, channel }, { output, channel } }));
+
+                graph.prepareToPlay (44100.0, blockSize);
+
+                AudioBuffer<double> audio (2, blockSize);
+                MidiBuffer midi;
+
+                for (auto channel = 0; channel < 2; ++channel)
+                    FloatVectorOperations::fill (audio.getWritePointer (channel), inputValue, blockSize);
+
+                graph.processBlock (audio, midi);
+
+                const auto usage = graph.getBufferUsage();
+                return std::make_tuple (audio.getSample (1, blockSize - 1),
+                                        usage.audioBufferBytes > (size_t) (usage.numAudioBuffers + 1) * blockSize * sizeof (double));
+            };
+
+            // Can't be represented exactly as a float
+            const auto value = 1.0 + 1.0e-12;
+
+            const auto [doubleResult, doubleUsesOtherBuffer] = process ({ true, true, true }, value);
+            expectEquals (doubleResult, value);
+            expect (! doubleUsesOtherBuffer);
+
+            const auto [mixedResult, mixedUsesOtherBuffer] = process ({ true, false, false, true }, value);
+            expectEquals (mixedResult, (double) (float) value);
+            expect (mixedUsesOtherBuffer);
+        }
+
+        beginTest ("node timing measures each node and blames the slowest node for overruns");
+        {
+            constexpr auto blockSize = 64;
+            constexpr auto numBlocks = 10;
+
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+            const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode));
+            const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode));
+            const auto slow   = graph.addNode (std::make_unique<GainProcessor> (0.5f));
+            const auto fast   = graph.addNode (std::make_unique<GainProcessor> (0.5f));
+
+            // Much longer than the 1.5ms duration of each block
+            dynamic_cast<GainProcessor*> (slow->getProcessor())->setSleepMilliseconds (5);
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                expect (graph.addConnection ({ { input->nodeID, channel }, { slow->nodeID,   channel } }));
+                expect (graph.addConnection ({ { slow->nodeID,  channel }, { fast->nodeID,   channel } }));
+                expect (graph.addConnection ({ { fast->nodeID,  channel }, { output->nodeID, channel } }));
+            }
+
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> audio (2, blockSize);
+            MidiBuffer midi;
+
+            const auto processBlocks = [&] (int num)
+            {
+                for (auto i = 0; i < num; ++i)
+                {
+                    audio.clear();
+                    graph.processBlock (audio, midi);
+                }
+            };
+
+            expect (! graph.isNodeTimingEnabled());
+            processBlocks (1);
+            expectEquals (slow->getProcessingStats().numBlocks, 0);
+
+            graph.setNodeTimingEnabled (true);
+            expect (graph.isNodeTimingEnabled());
+            processBlocks (numBlocks);
+
+            const auto slowStats = slow->getProcessingStats();
+            const auto fastStats = fast->getProcessingStats();
+
+            expectEquals (slowStats.numBlocks, numBlocks);
+            expectEquals (fastStats.numBlocks, numBlocks);
+            expect (slowStats.minMilliseconds >= 4.0);
+            expect (slowStats.minMilliseconds <= slowStats.averageMilliseconds);
+            expect (slowStats.averageMilliseconds <= slowStats.p99Milliseconds);
+            expect (slowStats.p99Milliseconds <= slowStats.maxMilliseconds);
+            expect (fastStats.averageMilliseconds < slowStats.averageMilliseconds);
+
+            expectEquals (slowStats.numOverruns, numBlocks);
+            expectEquals (fastStats.numOverruns, 0);
+
+            slow->resetProcessingStats();
+            expectEquals (slow->getProcessingStats().numBlocks, 0);
+            expectEquals (slow->getProcessingStats().numOverruns, 0);
+
+            processBlocks (1);
+            expectEquals (slow->getProcessingStats().numBlocks, 1);
+            expectEquals (fast->getProcessingStats().numBlocks, numBlocks + 1);
+
+            graph.setNodeTimingEnabled (false);
+            processBlocks (1);
+            expectEquals (slow->getProcessingStats().numBlocks, 1);
+        }
     }
 
 private:
+    friend class AudioProcessorGraphBenchmark;
+
     enum class MidiIn  { no, yes };
     enum class MidiOut { no, yes };
 
+    /*  Adds three busses that each mix a direct path with a path through a node that reports
+        some latency, and returns the ID of the node with latency.
+    */
+    AudioProcessorGraph::NodeID addBussesWithLatency (AudioProcessorGraph& graph, int blockSize, int latency)
+    {
+        graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+        const auto input   = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+        const auto output  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+        const auto direct  = graph.addNode (std::make_unique<GainProcessor> (1.0f))->nodeID;
+        const auto delayed = graph.addNode (std::make_unique<GainProcessor> (1.0f))->nodeID;
+        graph.getNodeForId (delayed)->getProcessor()->setLatencySamples (latency);
+
+        for (const auto gain : { 1.0f, 2.0f, 4.0f })
+        {
+            const auto bus = graph.addNode (std::make_unique<GainProcessor> (gain))->nodeID;
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                expect (graph.addConnection ({ { direct,  channel }, { bus,    channel } }));
+                expect (graph.addConnection ({ { delayed, channel }, { bus,    channel } }));
+                expect (graph.addConnection ({ { bus,     channel }, { output, channel } }));
+            }
+        }
+
+        for (auto channel = 0; channel < 2; ++channel)
+        {
+            expect (graph.addConnection ({ { input, channel }, { direct,  channel } }));
+            expect (graph.addConnection ({ { input, channel }, { delayed, channel } }));
+        }
+
+        return delayed;
+    }
+
+    /*  Renders a block of a ramp through the graph made by addBussesWithLatency. The node with
+        latency doesn't really delay its input, so each bus should hear the ramp plus a copy of
+        the ramp that's been delayed by the graph.
+    */
+    void expectBussesAreAligned (AudioProcessorGraph& graph, int blockSize, int blockIndex, int latency)
+    {
+        const auto ramp = [] (int sample) { return sample >= 0 ? (float) (sample + 1) : 0.0f; };
+
+        AudioBuffer<float> audio (2, blockSize);
+        MidiBuffer midi;
+
+        for (auto channel = 0; channel < 2; ++channel)
+            for (auto i = 0; i < blockSize; ++i)
+                audio.setSample (channel, i, ramp (blockIndex * blockSize + i));
+
+        graph.processBlock (audio, midi);
+
+        for (auto channel = 0; channel < 2; ++channel)
+        {
+            for (auto i = 0; i < blockSize; ++i)
+            {
+                const auto sample = blockIndex * blockSize + i;
+                expectEquals (audio.getSample (channel, i), 7.0f * (ramp (sample) + ramp (sample - latency)));
+            }
+        }
+    }
+
     class BasicProcessor final : public AudioProcessor
     {
     public:
@@ -2357,10 +3790,116 @@ private:
         MidiIn midiIn;
         MidiOut midiOut;
     };
+
+    class GainProcessor final : public AudioProcessor
+    {
+    public:
+        explicit GainProcessor (float g, bool supportsDouble = false)
+            : AudioProcessor (BasicProcessor::getStereoProperties()), gain (g), supportsDoublePrecision (supportsDouble) {}
+
+        bool supportsDoublePrecisionProcessing() const override       { return supportsDoublePrecision; }
+
+        const String getName() const override                         { return "Gain Processor"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            if (sleepMilliseconds > 0)
+                Thread::sleep (sleepMilliseconds);
+
+            buffer.applyGain (gain);
+        }
+
+        void processBlock (AudioBuffer<double>& buffer, MidiBuffer&) override
+        {
+            jassert (supportsDoublePrecision);
+            buffer.applyGain (gain);
+        }
+
+        void setSleepMilliseconds (int ms)                            { sleepMilliseconds = ms; }
+
+    private:
+        float gain = 1.0f;
+        bool supportsDoublePrecision = false;
+        int sleepMilliseconds = 0;
+    };
 };
 
 static AudioProcessorGraphTests audioProcessorGraphTests;
 
+//==============================================================================
+class AudioProcessorGraphBenchmark final : public Benchmark
+{
+public:
+    AudioProcessorGraphBenchmark()
+        : Benchmark ("AudioProcessorGraph", UnitTestCategories::benchmarks) {}
+
+    void runTest() override
+    {
+        constexpr auto blockSize = 256;
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+        using GainProcessor = AudioProcessorGraphTests::GainProcessor;
+
+        beginTest ("Rendering");
+
+        for (auto [numChains, chainLength] : { std::pair { 1, 8 }, std::pair { 16, 4 }, std::pair { 64, 2 } })
+        {
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+            const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+            for (auto chain = 0; chain < numChains; ++chain)
+            {
+                auto previous = input;
+
+                for (auto i = 0; i < chainLength; ++i)
+                {
+                    const auto node = graph.addNode (std::make_unique<GainProcessor> (0.5f))->nodeID;
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                        graph.addConnection ({ { previous, channel }, { node, channel } });
+
+                    previous = node;
+                }
+
+                for (auto channel = 0; channel < 2; ++channel)
+                    graph.addConnection ({ { previous, channel }, { output, channel } });
+            }
+
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> audio (2, blockSize);
+            audio.clear();
+            MidiBuffer midi;
+
+            measure (String (numChains) + " chains of " + String (chainLength) + " nodes", [&]
+            {
+                graph.processBlock (audio, midi);
+                doNotOptimise (audio.getSample (0, 0));
+            });
+
+            graph.releaseResources();
+        }
+    }
+};
+
+static AudioProcessorGraphBenchmark audioProcessorGraphBenchmark;
+
 #endif
 
 } // namespace juce
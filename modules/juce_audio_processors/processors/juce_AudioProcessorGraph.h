@@ -40,6 +40,12 @@ namespace juce
     To play back a graph through an audio device, you might want to use an
     AudioProcessorPlayer object.
 
+    The graph delays the shorter paths into each node so that all of its inputs line up,
+    and reports the latency of the longest path through the graph. When a node calls
+    setLatencySamples(), the graph updates these delays asynchronously. If nothing else
+    about the graph has changed, the new delays are swapped into the running graph
+    without rebuilding it.
+
     @tags{Audio}
 */
 class JUCE_API  AudioProcessorGraph   : public AudioProcessor,
@@ -145,6 +151,39 @@ public:
             bypassed = shouldBeBypassed;
         }
 
+        //==============================================================================
+        /** Describes how long this node has taken to process recent blocks.
+
+            @see getProcessingStats, AudioProcessorGraph::setNodeTimingEnabled
+        */
+        struct ProcessingStats
+        {
+            /** The number of blocks that these statistics are based on. This is limited
+                to the most recent blocks, so it won't grow indefinitely.
+            */
+            int numBlocks = 0;
+
+            /** The shortest, average, 99th percentile, and longest processing times of
+                the measured blocks, in milliseconds.
+            */
+            double minMilliseconds = 0.0, averageMilliseconds = 0.0, p99Milliseconds = 0.0, maxMilliseconds = 0.0;
+
+            /** The number of blocks in which the whole graph took longer to process than
+                the duration of the block, and this node was the slowest node in the graph.
+            */
+            int numOverruns = 0;
+        };
+
+        /** Returns statistics about the time this node has taken to process recent blocks.
+
+            The graph only measures its nodes while timing is enabled with
+            AudioProcessorGraph::setNodeTimingEnabled().
+        */
+        ProcessingStats getProcessingStats() const;
+
+        /** Discards all of the timing measurements made so far. */
+        void resetProcessingStats() noexcept;
+
         //==============================================================================
         /** A convenient typedef for referring to a pointer to a node object. */
         using Ptr = ReferenceCountedObjectPtr<Node>;
@@ -157,6 +196,18 @@ public:
         */
         bool userRequestedBypass() const { return bypassed; }
 
+        /** @internal
+
+            Called by the graph after processing this node, if timing is enabled.
+        */
+        void addProcessingTime (double milliseconds) noexcept;
+
+        /** @internal
+
+            Called by the graph when this node was the slowest node in a block that overran.
+        */
+        void addOverrun() noexcept              { timings.numOverruns.fetch_add (1, std::memory_order_relaxed); }
+
         /** @internal
 
             To create a new node, use AudioProcessorGraph::addNode.
@@ -172,6 +223,17 @@ public:
         std::unique_ptr<AudioProcessor> processor;
         std::atomic<bool> bypassed { false };
 
+        struct Timings
+        {
+            static constexpr uint32 historySize = 256;
+
+            std::array<std::atomic<float>, historySize> milliseconds{};
+            std::atomic<uint32> numWritten { 0 }, numOverruns { 0 };
+            std::atomic<bool> resetRequested { false };
+        };
+
+        Timings timings;
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Node)
     };
 
@@ -323,6 +385,134 @@ public:
     */
     void rebuild();
 
+    /** Sets the number of additional threads that will be used to render independent parts of
+        the graph in parallel.
+
+        By default, all of the graph's nodes are processed one after another on the thread that
+        calls processBlock(). When parallel rendering is enabled, nodes that don't depend on one
+        another (for example, separate chains of processors that only meet at the graph's output)
+        may be processed at the same time on a set of realtime worker threads. The thread that
+        calls processBlock() will help with the work, and processBlock() will only return once
+        every node has been processed.
+
+        In this mode, the processBlock() functions of processors in different branches of the
+        graph may be called concurrently, so processors in the graph must not share mutable state
+        without proper synchronisation. Intermediate buffers are not shared between nodes in this
+        mode, so the graph will use a little more memory.
+
+        If the graph receives an AudioWorkgroup through audioWorkgroupContextChanged(), the worker
+        threads will join it.
+
+        Passing 0 (the default) disables parallel rendering. This function must be called from the
+        main thread, and will cause the graph to be rebuilt.
+
+        @see getNumParallelRenderThreads
+    */
+    void setNumParallelRenderThreads (int numThreads);
+
+    /** Enables parallel rendering, using the given options to start the worker threads.
+
+        This lets the workers be given realtime priority, or pinned to particular CPU cores
+        with RealtimeThreadPoolOptions::withWorkerCores(). The number of threads is always
+        numThreads, and the graph chooses the maximum number of jobs, so those settings in
+        the options are ignored.
+
+        Unlike the other overload, this always restarts the worker threads, even if the
+        number of threads hasn't changed. It must be called from the main thread, and will
+        cause the graph to be rebuilt.
+
+        @see setNumParallelRenderThreads, RealtimeThreadPoolOptions
+    */
+    void setNumParallelRenderThreads (int numThreads, const RealtimeThreadPool::Options& workerOptions);
+
+    /** Returns the number of worker threads used for parallel rendering, or 0 if parallel
+        rendering is disabled.
+
+        @see setNumParallelRenderThreads
+    */
+    int getNumParallelRenderThreads() const;
+
+    /** Enables or disables measuring the time that each node takes to process.
+
+        When enabled, the graph times every node in every block, and also keeps track of
+        which node was the slowest whenever the whole graph takes longer to process than
+        the duration of the block. The measurements can be retrieved with
+        Node::getProcessingStats(). Timing is disabled by default, and costs a pair of
+        calls to Time::getHighResolutionTicks() per node while it's enabled.
+
+        This may be called from any thread.
+
+        @see isNodeTimingEnabled, Node::getProcessingStats
+    */
+    void setNodeTimingEnabled (bool shouldBeEnabled) noexcept;
+
+    /** Returns true if node timing is enabled.
+
+        @see setNodeTimingEnabled
+    */
+    bool isNodeTimingEnabled() const noexcept;
+
+    //==============================================================================
+    /** Describes the intermediate buffers that the graph uses while rendering.
+
+        @see getBufferUsage
+    */
+    struct BufferUsage
+    {
+        /** Describes the buffers used by a single node. */
+        struct NodeBuffers
+        {
+            /** The node that these buffers belong to. */
+            NodeID nodeID;
+
+            /** The position of this node in the rendering order. */
+            int renderStep = 0;
+
+            /** The last position in the rendering order at which a node reads this node's
+                outputs. If nothing reads the outputs, this will be the same as renderStep.
+
+                The buffers holding this node's outputs can't be reused by other nodes
+                until this step has been processed.
+            */
+            int lastStepReadingOutputs = 0;
+
+            /** The indices of the intermediate audio buffers that this node processes. */
+            std::vector<int> audioBuffers;
+
+            /** The index of the intermediate MIDI buffer that this node processes. */
+            int midiBuffer = 0;
+        };
+
+        /** The number of intermediate audio channels. This includes a channel of
+            silence that's shared by all unconnected inputs.
+        */
+        int numAudioBuffers = 0;
+
+        /** The number of intermediate MIDI buffers. */
+        int numMidiBuffers = 0;
+
+        /** The size of the intermediate audio channels, in bytes. */
+        size_t audioBufferBytes = 0;
+
+        /** The size of the delay lines used to compensate for node latencies, in bytes. */
+        size_t delayLineBytes = 0;
+
+        /** The buffers used by each node, in rendering order. */
+        std::vector<NodeBuffers> nodes;
+    };
+
+    /** Returns information about the intermediate buffers used by the most recently
+        built render sequence.
+
+        Buffers are reused once every node that reads them has been processed, so the
+        number of buffers is normally much smaller than the total number of channels in
+        the graph. When parallel rendering is enabled, buffers are never reused.
+
+        The result will be empty if the graph hasn't been prepared and built. This
+        function must be called from the main thread.
+    */
+    BufferUsage getBufferUsage() const;
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -419,6 +609,7 @@ public:
 
     void reset() override;
     void setNonRealtime (bool) noexcept override;
+    void audioWorkgroupContextChanged (const AudioWorkgroup&) override;
 
     double getTailLengthSeconds() const override;
     bool acceptsMidi() const override;
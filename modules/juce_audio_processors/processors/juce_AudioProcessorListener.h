@@ -69,6 +69,8 @@ public:
         bool programChanged           = false;
         /** @see withNonParameterStateChanged */
         bool nonParameterStateChanged = false;
+        /** @see withParameterValuesChanged */
+        bool parameterValuesChanged   = false;
 
         /** Indicates that the AudioProcessor's latency has changed.
 
@@ -112,6 +114,18 @@ public:
         */
         [[nodiscard]] ChangeDetails withNonParameterStateChanged (bool b) const noexcept { return with (&ChangeDetails::nonParameterStateChanged, b); }
 
+        /** Indicates that the values of some or all of the AudioProcessor's parameters have
+            changed together, without a separate audioProcessorParameterChanged callback for
+            each one.
+
+            When this flag is set, the host should re-read the values of all the parameters.
+            This is much cheaper for large plugins than one notification per parameter, e.g.
+            when a preset is loaded.
+
+            @see parameterValuesChanged, AudioProcessorParameter::sendValueChangedMessageToParameterListeners
+        */
+        [[nodiscard]] ChangeDetails withParameterValuesChanged   (bool b) const noexcept { return with (&ChangeDetails::parameterValuesChanged,   b); }
+
         /** Returns the default set of flags that will be used when
             AudioProcessor::updateHostDisplay() is called with no arguments.
         */
@@ -340,6 +340,19 @@ public:
     /** @internal */
     void sendValueChangedMessageToListeners (float newValue);
 
+    /** Tells this parameter's Listeners that its value has changed, but doesn't call
+        AudioProcessorListener::audioProcessorParameterChanged on the owning processor.
+
+        The plugin wrappers pass each audioProcessorParameterChanged call on to the host,
+        so when many parameters change together (e.g. when loading a preset), use this
+        instead and then call AudioProcessor::updateHostDisplay() once with
+        ChangeDetails::withParameterValuesChanged() set, so that the host can fetch all
+        the new values in one go.
+
+        @see AudioProcessorValueTreeState::applyState
+    */
+    void sendValueChangedMessageToParameterListeners (float newValue);
+
 private:
     //==============================================================================
     friend class AudioProcessor;
@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+void AudioProcessorParameterAutomation::prepare (int numParameters, int maxPointsPerParameter)
+{
+    jassert (numParameters >= 0 && maxPointsPerParameter > 0);
+
+    maxPoints = jmax (1, maxPointsPerParameter);
+    points.assign ((size_t) (numParameters * maxPoints), Point{});
+    numPoints.assign ((size_t) numParameters, 0);
+    startValues.assign ((size_t) numParameters, 0.0f);
+
+    changedParameters.clear();
+    changedParameters.reserve ((size_t) numParameters);
+}
+
+void AudioProcessorParameterAutomation::clear() noexcept
+{
+    for (auto index : changedParameters)
+        numPoints[(size_t) index] = 0;
+
+    changedParameters.clear();
+}
+
+bool AudioProcessorParameterAutomation::addPoint (const AudioProcessorParameter& parameter, int sampleOffset, float newValue) noexcept
+{
+    const auto index = parameter.getParameterIndex();
+
+    if (! isPositiveAndBelow (index, getNumParameters()))
+        return false;
+
+    auto& count = numPoints[(size_t) index];
+    auto* lane = points.data() + index * maxPoints;
+
+    if (count == 0)
+    {
+        startValues[(size_t) index] = parameter.getValue();
+        changedParameters.push_back (index);
+    }
+    else
+    {
+        auto& last = lane[count - 1];
+
+        // Points must be added in time order!
+        jassert (sampleOffset >= last.sampleOffset);
+        sampleOffset = jmax (sampleOffset, last.sampleOffset);
+
+        if (sampleOffset == last.sampleOffset)
+        {
+            last.value = newValue;
+            return true;
+        }
+
+        if (count == maxPoints)
+        {
+            last = { sampleOffset, newValue };
+            return false;
+        }
+    }
+
+    lane[count++] = { jmax (0, sampleOffset), newValue };
+    return true;
+}
+
+Span<const AudioProcessorParameterAutomation::Point> AudioProcessorParameterAutomation::getPoints (int parameterIndex) const noexcept
+{
+    if (! isPositiveAndBelow (parameterIndex, getNumParameters()))
+        return { points.data(), 0 };
+
+    return { points.data() + parameterIndex * maxPoints, (size_t) numPoints[(size_t) parameterIndex] };
+}
+
+float AudioProcessorParameterAutomation::getStartValue (int parameterIndex) const noexcept
+{
+    return isPositiveAndBelow (parameterIndex, getNumParameters()) ? startValues[(size_t) parameterIndex] : 0.0f;
+}
+
+void AudioProcessorParameterAutomation::fillRamp (const AudioProcessorParameter& parameter,
+                                                  float* destination,
+                                                  int numSamples) const noexcept
+{
+    const auto index = parameter.getParameterIndex();
+    const auto lane = getPoints (index);
+
+    if (lane.empty())
+    {
+        FloatVectorOperations::fill (destination, parameter.getValue(), numSamples);
+        return;
+    }
+
+    auto previousOffset = 0;
+    auto previousValue = getStartValue (index);
+    auto pos = 0;
+
+    for (const auto& point : lane)
+    {
+        const auto length = point.sampleOffset - previousOffset;
+
+        if (length > 0)
+        {
+            const auto end = jmin (point.sampleOffset, numSamples);
+            const auto step = (point.value - previousValue) / (float) length;
+
+            for (; pos < end; ++pos)
+                destination[pos] = previousValue + step * (float) (pos - previousOffset);
+        }
+
+        previousOffset = point.sampleOffset;
+        previousValue = point.value;
+    }
+
+    if (pos < numSamples)
+        FloatVectorOperations::fill (destination + pos, previousValue, numSamples - pos);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorParameterAutomationTests final : public UnitTest
+{
+public:
+    AudioProcessorParameterAutomationTests()
+        : UnitTest ("AudioProcessorParameterAutomation", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        TestProcessor processor;
+        auto& first  = *processor.getParameters()[0];
+        auto& second = *processor.getParameters()[1];
+
+        AudioProcessorParameterAutomation automation;
+        automation.prepare (processor.getParameters().size(), 4);
+
+        beginTest ("Untouched parameters have no points, and ramps use the current value");
+        {
+            expect (automation.getPoints (0).empty());
+            expect (automation.getChangedParameters().empty());
+
+            first.setValue (0.25f);
+            std::array<float, 8> ramp{};
+            automation.fillRamp (first, ramp.data(), (int) ramp.size());
+
+            for (auto v : ramp)
+                expectEquals (v, 0.25f);
+        }
+
+        beginTest ("The first point records the start value");
+        {
+            expect (automation.addPoint (second, 4, 1.0f));
+            second.setValue (1.0f);
+
+            expectEquals (automation.getStartValue (1), 0.0f);
+            expectEquals ((int) automation.getPoints (1).size(), 1);
+            expectEquals ((int) automation.getChangedParameters().size(), 1);
+            expectEquals (automation.getChangedParameters()[0], 1);
+        }
+
+        beginTest ("Ramps interpolate linearly between points");
+        {
+            expect (automation.addPoint (second, 6, 0.0f));
+
+            std::array<float, 8> ramp{};
+            automation.fillRamp (second, ramp.data(), (int) ramp.size());
+
+            const std::array<float, 8> expected { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f, 0.5f, 0.0f, 0.0f };
+
+            for (size_t i = 0; i < ramp.size(); ++i)
+                expectWithinAbsoluteError (ramp[i], expected[i], 1.0e-6f);
+        }
+
+        beginTest ("Full lanes replace their last point");
+        {
+            expect (automation.addPoint (second, 7, 0.5f));
+            expect (automation.addPoint (second, 8, 0.6f));
+            expect (! automation.addPoint (second, 9, 0.7f));
+
+            const auto lane = automation.getPoints (1);
+            expectEquals ((int) lane.size(), 4);
+            expectEquals (lane.back().sampleOffset, 9);
+            expectEquals (lane.back().value, 0.7f);
+        }
+
+        beginTest ("Clearing removes all points");
+        {
+            automation.clear();
+
+            expect (automation.getPoints (1).empty());
+            expect (automation.getChangedParameters().empty());
+        }
+    }
+
+private:
+    class TestProcessor final : public AudioProcessor
+    {
+    public:
+        TestProcessor()
+        {
+            for (auto* id : { "first", "second" })
+                addParameter (new AudioParameterFloat (ParameterID { id, 1 }, id, 0.0f, 1.0f, 0.0f));
+        }
+
+        const String getName() const override                         { return "Test Processor"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return {}; }
+        bool producesMidi() const override                            { return {}; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override {}
+
+        using AudioProcessor::processBlock;
+    };
+};
+
+static AudioProcessorParameterAutomationTests audioProcessorParameterAutomationTests;
+
+#endif
+
+} // namespace juce
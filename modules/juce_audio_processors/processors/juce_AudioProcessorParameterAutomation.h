@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds the parameter automation points that a host sent for the block that is
+    currently being processed.
+
+    Most plugin formats can send several parameter changes during a single block,
+    each with its own sample offset. Normally the plugin wrappers just apply the
+    last of these before calling processBlock(), so the processor only sees the
+    value that the parameter will have at the end of the block. If your processor
+    returns true from AudioProcessor::supportsSampleAccurateAutomation(), the
+    wrappers will also record every point in one of these objects, which you can
+    get hold of with AudioProcessor::getParameterAutomation().
+
+    All point values are normalised to the range 0 to 1, just like
+    AudioProcessorParameter::getValue(). Between points, the value should be
+    interpolated linearly, starting from the value the parameter had at the
+    start of the block. fillRamp() will do this for you.
+
+    @code
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        if (auto* automation = getParameterAutomation())
+            automation->fillRamp (*gainParam, gainRamp.data(), buffer.getNumSamples());
+        else
+            std::fill_n (gainRamp.data(), buffer.getNumSamples(), gainParam->getValue());
+
+        ...
+    }
+    @endcode
+
+    All of the storage is allocated by prepare(), so none of the other methods
+    will allocate.
+
+    @see AudioProcessor::getParameterAutomation
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorParameterAutomation
+{
+public:
+    //==============================================================================
+    /** A single automation point. */
+    struct Point
+    {
+        /** The position of this point, in samples from the start of the block. */
+        int sampleOffset = 0;
+
+        /** The normalised value that the parameter should reach at this point. */
+        float value = 0.0f;
+    };
+
+    //==============================================================================
+    /** Creates an empty object. Call prepare() before adding any points. */
+    AudioProcessorParameterAutomation() = default;
+
+    /** Allocates storage for the given number of parameters, and removes any
+        existing points.
+
+        Each parameter can hold up to maxPointsPerParameter points per block.
+    */
+    void prepare (int numParameters, int maxPointsPerParameter = 64);
+
+    /** Removes all of the points from the previous block. */
+    void clear() noexcept;
+
+    /** Adds a point to the lane for the given parameter.
+
+        This must be called before the new value is applied to the parameter,
+        because the first point added to each lane during a block records the
+        parameter's current value as the lane's starting value.
+
+        Points must be added in time order. A point with the same offset as the
+        previous one replaces it. If there's no room left in this lane, the last
+        point is replaced and this will return false.
+    */
+    bool addPoint (const AudioProcessorParameter& parameter, int sampleOffset, float newValue) noexcept;
+
+    //==============================================================================
+    /** Returns the number of parameters that storage was allocated for. */
+    int getNumParameters() const noexcept                       { return (int) numPoints.size(); }
+
+    /** Returns the points that were added for the parameter at this index
+        during the current block. The span will be empty if the host didn't
+        automate this parameter.
+    */
+    Span<const Point> getPoints (int parameterIndex) const noexcept;
+
+    /** Returns the value the parameter at this index had at the start of the block.
+        This is only meaningful if getPoints() isn't empty.
+    */
+    float getStartValue (int parameterIndex) const noexcept;
+
+    /** Returns the indices of the parameters that have points in the current block,
+        in the order that they were first changed.
+    */
+    Span<const int> getChangedParameters() const noexcept    { return { changedParameters.data(), changedParameters.size() }; }
+
+    /** Writes the value of a parameter at each sample of the block into destination,
+        interpolating linearly between the points.
+
+        If the parameter has no points, the destination is filled with its current value.
+    */
+    void fillRamp (const AudioProcessorParameter& parameter, float* destination, int numSamples) const noexcept;
+
+private:
+    //==============================================================================
+    std::vector<Point> points;
+    std::vector<int> numPoints, changedParameters;
+    std::vector<float> startValues;
+    int maxPoints = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorParameterAutomation)
+};
+
+} // namespace juce
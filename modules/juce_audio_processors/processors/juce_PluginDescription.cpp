@@ -83,6 +83,9 @@ std::unique_ptr<XmlElement> PluginDescription::createXml() const
 
     e->setAttribute ("uid", String::toHexString (deprecatedUid));
 
+    if (fileFingerprint.isNotEmpty())
+        e->setAttribute ("fileFingerprint", fileFingerprint);
+
     return e;
 }
 
@@ -99,6 +102,7 @@ bool PluginDescription::loadFromXml (const XmlElement& xml)
         fileOrIdentifier    = xml.getStringAttribute ("file");
         isInstrument        = xml.getBoolAttribute ("isInstrument", false);
         lastFileModTime     = Time (xml.getStringAttribute ("fileTime").getHexValue64());
+        fileFingerprint     = xml.getStringAttribute ("fileFingerprint");
         lastInfoUpdateTime  = Time (xml.getStringAttribute ("infoUpdateTime").getHexValue64());
         numInputChannels    = xml.getIntAttribute ("numInputs");
         numOutputChannels   = xml.getIntAttribute ("numOutputs");
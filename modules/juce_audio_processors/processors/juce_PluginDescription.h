@@ -86,6 +86,14 @@ public:
     */
     Time lastFileModTime;
 
+    /** Identifies the contents of the plug-in's files at the point they were scanned.
+
+        Formats that fill this in will compare it against the current files when deciding
+        whether the plug-in needs rescanning, which catches updates that don't change the
+        lastFileModTime. This will be empty for formats that don't support it.
+    */
+    String fileFingerprint;
+
     /** The last time that this information was updated. This would typically have
         been during a scan when this plugin was first tested or found to have changed.
     */
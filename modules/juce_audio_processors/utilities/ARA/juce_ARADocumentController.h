@@ -306,6 +306,9 @@ protected:
 
         This function's called from
         ARA::PlugIn::DocumentControllerDelegate::doRequestAudioSourceContentAnalysis.
+
+        The ARAAudioSourceAnalysisScheduler class in the juce_audio_formats module can be used
+        to run the requested analyses on a ThreadPool and report their progress.
     */
     virtual void                        doRequestAudioSourceContentAnalysis        (ARA::PlugIn::AudioSource*  audioSource,
                                                                                     std::vector<ARA::ARAContentType> const& contentTypes);
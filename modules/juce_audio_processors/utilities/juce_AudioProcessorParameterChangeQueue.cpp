@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+void AudioProcessorParameterChangeQueue::Listener::parameterGestureChanged (AudioProcessorParameter&, bool) {}
+void AudioProcessorParameterChangeQueue::Listener::parameterChangeBatchFinished() {}
+
+//==============================================================================
+AudioProcessorParameterChangeQueue::AudioProcessorParameterChangeQueue (AudioProcessor& processor, int updateRateHz)
+    : parameters (processor.getParameters()),
+      changes ((size_t) parameters.size())
+{
+    for (auto* parameter : parameters)
+        parameter->addListener (this);
+
+    setUpdateRate (updateRateHz);
+}
+
+AudioProcessorParameterChangeQueue::~AudioProcessorParameterChangeQueue()
+{
+    stopTimer();
+
+    for (auto* parameter : parameters)
+        parameter->removeListener (this);
+}
+
+//==============================================================================
+void AudioProcessorParameterChangeQueue::addListener (Listener* listener)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    listeners.add (listener);
+}
+
+void AudioProcessorParameterChangeQueue::removeListener (Listener* listener)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    listeners.remove (listener);
+}
+
+void AudioProcessorParameterChangeQueue::setUpdateRate (int updateRateHz)
+{
+    jassert (updateRateHz > 0);
+    startTimerHz (jmax (1, updateRateHz));
+}
+
+void AudioProcessorParameterChangeQueue::dispatchPendingChanges()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto anythingChanged = false;
+
+    changes.ifSet ([this, &anythingChanged] (size_t index, float value, uint32_t bits)
+    {
+        auto& parameter = *parameters.getUnchecked ((int) index);
+        anythingChanged = true;
+
+        if ((bits & gestureStarted) != 0)
+            listeners.call ([&] (Listener& l) { l.parameterGestureChanged (parameter, true); });
+
+        if ((bits & valueChanged) != 0)
+            listeners.call ([&] (Listener& l) { l.parameterChanged (parameter, value); });
+
+        if ((bits & gestureEnded) != 0)
+            listeners.call ([&] (Listener& l) { l.parameterGestureChanged (parameter, false); });
+    });
+
+    if (anythingChanged)
+        listeners.call ([] (Listener& l) { l.parameterChangeBatchFinished(); });
+}
+
+//==============================================================================
+void AudioProcessorParameterChangeQueue::parameterValueChanged (int parameterIndex, float newValue)
+{
+    if (isPositiveAndBelow (parameterIndex, parameters.size()))
+        changes.setValueAndBits ((size_t) parameterIndex, newValue, valueChanged);
+}
+
+void AudioProcessorParameterChangeQueue::parameterGestureChanged (int parameterIndex, bool gestureIsStarting)
+{
+    if (isPositiveAndBelow (parameterIndex, parameters.size()))
+        changes.setBits ((size_t) parameterIndex, gestureIsStarting ? gestureStarted : gestureEnded);
+}
+
+void AudioProcessorParameterChangeQueue::timerCallback()
+{
+    dispatchPendingChanges();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorParameterChangeQueueTests final : public UnitTest
+{
+public:
+    AudioProcessorParameterChangeQueueTests()
+        : UnitTest ("AudioProcessorParameterChangeQueue", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        TestProcessor processor;
+        auto& first  = *processor.getParameters()[0];
+        auto& second = *processor.getParameters()[1];
+
+        AudioProcessorParameterChangeQueue queue (processor);
+        TestListener listener;
+        queue.addListener (&listener);
+
+        beginTest ("Nothing is sent if nothing has changed");
+        {
+            queue.dispatchPendingChanges();
+            expect (listener.events.isEmpty());
+            expectEquals (listener.numBatches, 0);
+        }
+
+        beginTest ("Several changes to one parameter are coalesced");
+        {
+            first.setValueNotifyingHost (0.1f);
+            first.setValueNotifyingHost (0.2f);
+            first.setValueNotifyingHost (0.3f);
+
+            expect (listener.events.isEmpty());
+
+            queue.dispatchPendingChanges();
+            expect (listener.events == StringArray { "first 0.3" });
+            expectEquals (listener.numBatches, 1);
+        }
+
+        beginTest ("Gestures surround the value change");
+        {
+            listener.reset();
+
+            second.beginChangeGesture();
+            second.setValueNotifyingHost (0.5f);
+            second.endChangeGesture();
+
+            queue.dispatchPendingChanges();
+            expect (listener.events == StringArray { "second begin", "second 0.5", "second end" });
+            expectEquals (listener.numBatches, 1);
+        }
+
+        beginTest ("Changes made on another thread are delivered on the message thread");
+        {
+            listener.reset();
+
+            Thread::launch ([&] { first.setValueNotifyingHost (0.7f); second.setValueNotifyingHost (0.8f); });
+
+            for (auto i = 0; i < 100 && listener.events.size() < 2; ++i)
+            {
+                Thread::sleep (5);
+                queue.dispatchPendingChanges();
+            }
+
+            expect (listener.events == StringArray { "first 0.7", "second 0.8" });
+        }
+
+        queue.removeListener (&listener);
+    }
+
+private:
+    struct TestListener final : public AudioProcessorParameterChangeQueue::Listener
+    {
+        void parameterChanged (AudioProcessorParameter& parameter, float newValue) override
+        {
+            events.add (parameter.getName (100) + " " + String (newValue));
+        }
+
+        void parameterGestureChanged (AudioProcessorParameter& parameter, bool gestureIsStarting) override
+        {
+            events.add (parameter.getName (100) + (gestureIsStarting ? " begin" : " end"));
+        }
+
+        void parameterChangeBatchFinished() override
+        {
+            ++numBatches;
+        }
+
+        void reset()
+        {
+            events.clear();
+            numBatches = 0;
+        }
+
+        StringArray events;
+        int numBatches = 0;
+    };
+
+    class TestProcessor final : public AudioProcessor
+    {
+    public:
+        TestProcessor()
+        {
+            for (auto* id : { "first", "second" })
+                addParameter (new AudioParameterFloat (ParameterID { id, 1 }, id, 0.0f, 1.0f, 0.0f));
+        }
+
+        const String getName() const override                         { return "Test Processor"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return {}; }
+        bool producesMidi() const override                            { return {}; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override {}
+
+        using AudioProcessor::processBlock;
+    };
+};
+
+static AudioProcessorParameterChangeQueueTests audioProcessorParameterChangeQueueTests;
+
+#endif
+
+} // namespace juce
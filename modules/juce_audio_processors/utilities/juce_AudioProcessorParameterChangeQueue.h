@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Collects the changes made to an AudioProcessor's parameters, and delivers them
+    to listeners on the message thread in batches.
+
+    Listening to each AudioProcessorParameter directly means that your callbacks
+    may be called on the audio thread, and using an AsyncUpdater for each parameter
+    can flood the message thread when lots of parameters are being automated. This
+    class instead registers itself with every parameter of a processor, and when a
+    parameter changes it just stores the new value and sets a flag, without taking
+    any locks or allocating. A timer on the message thread then checks the flags at
+    a fixed rate, and calls the listeners once for each parameter that has changed,
+    with its most recent value.
+
+    Because the changes are coalesced, listeners won't see every intermediate value
+    of a parameter, and the order in which different parameters changed isn't kept.
+
+    The queue only tracks the parameters that the processor has when the queue is
+    created, so if the processor's parameter list changes you should create a new
+    queue.
+
+    @see AudioProcessorParameter::Listener, ParameterAttachment
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorParameterChangeQueue  : private AudioProcessorParameter::Listener,
+                                                      private Timer
+{
+public:
+    //==============================================================================
+    /** Receives callbacks from an AudioProcessorParameterChangeQueue.
+
+        All of these callbacks are made on the message thread.
+    */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener() = default;
+
+        /** Called with the latest value of a parameter that has changed since the
+            previous batch.
+        */
+        virtual void parameterChanged (AudioProcessorParameter& parameter, float newValue) = 0;
+
+        /** Called when a parameter has started or finished a change gesture since
+            the previous batch.
+
+            If a gesture both started and finished during the same batch, this will
+            be called once with gestureIsStarting set to true before the parameter's
+            parameterChanged() callback, and once with it set to false afterwards.
+        */
+        virtual void parameterGestureChanged (AudioProcessorParameter& parameter, bool gestureIsStarting);
+
+        /** Called after all of the callbacks for a batch of changes have been made. */
+        virtual void parameterChangeBatchFinished();
+    };
+
+    //==============================================================================
+    /** Creates a queue that tracks all of the parameters that the processor
+        currently has, and delivers changes at the given rate.
+
+        The processor must outlive the queue.
+    */
+    explicit AudioProcessorParameterChangeQueue (AudioProcessor& processor, int updateRateHz = 30);
+
+    /** Destructor. */
+    ~AudioProcessorParameterChangeQueue() override;
+
+    //==============================================================================
+    /** Registers a listener to receive batches of changes. */
+    void addListener (Listener* listener);
+
+    /** Removes a previously registered listener. */
+    void removeListener (Listener* listener);
+
+    /** Changes the rate at which batches of changes are delivered. */
+    void setUpdateRate (int updateRateHz);
+
+    /** Immediately delivers any changes that are waiting to be sent to the listeners.
+
+        This must be called on the message thread.
+    */
+    void dispatchPendingChanges();
+
+private:
+    //==============================================================================
+    enum ChangeBits : uint32_t
+    {
+        valueChanged   = 1 << 0,
+        gestureStarted = 1 << 1,
+        gestureEnded   = 1 << 2
+    };
+
+    void parameterValueChanged (int parameterIndex, float newValue) override;
+    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override;
+    void timerCallback() override;
+
+    Array<AudioProcessorParameter*> parameters;
+    FlaggedFloatCache<3> changes;
+    ListenerList<Listener> listeners;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorParameterChangeQueue)
+};
+
+} // namespace juce
@@ -95,6 +95,20 @@ public:
             setNormalisedValue (normalise (value));
     }
 
+    /*  Sets the value as part of a batch of changes. The parameter's listeners are
+        called, but the host isn't told about this particular change.
+    */
+    bool setDenormalisedValueWithoutNotifyingHost (float value)
+    {
+        if (approximatelyEqual (value, (float) unnormalisedValue))
+            return false;
+
+        const auto normalised = normalise (value);
+        parameter.setValue (normalised);
+        parameter.sendValueChangedMessageToParameterListeners (normalised);
+        return true;
+    }
+
     float getDenormalisedValueForText (const String& text) const
     {
         return denormalise (parameter.getValueForText (text));
@@ -394,6 +408,132 @@ void AudioProcessorValueTreeState::replaceState (const ValueTree& newState)
         undoManager->clearUndoHistory();
 }
 
+void AudioProcessorValueTreeState::applyState (const ValueTree& newState)
+{
+    ScopedLock lock (valueTreeChanging);
+
+    state.copyPropertiesFrom (newState, nullptr);
+
+    for (auto i = state.getNumChildren(); --i >= 0;)
+        if (! state.getChild (i).hasType (valueType))
+            state.removeChild (i, nullptr);
+
+    auto anyParameterChanged = false;
+
+    for (const auto& child : newState)
+    {
+        if (! child.hasType (valueType))
+        {
+            state.appendChild (child.createCopy(), nullptr);
+        }
+        else if (auto* adapter = getParameterAdapter (child.getProperty (idPropertyID).toString()))
+        {
+            const auto value = (float) child.getProperty (valuePropertyID, adapter->getDenormalisedDefaultValue());
+            anyParameterChanged |= adapter->setDenormalisedValueWithoutNotifyingHost (value);
+        }
+    }
+
+    if (undoManager != nullptr)
+        undoManager->clearUndoHistory();
+
+    if (anyParameterChanged)
+        processor.updateHostDisplay (AudioProcessorListener::ChangeDetails{}.withParameterValuesChanged (true));
+}
+
+//==============================================================================
+static constexpr int stateSnapshotMagic = 0x53565041; // "APVS"
+
+void AudioProcessorValueTreeState::writeStateSnapshot (MemoryBlock& destData)
+{
+    if (MessageManager::existsAndIsCurrentThread())
+        updateNonParameterStateSnapshot();
+
+    const auto nonParameterState = [this]
+    {
+        const SpinLock::ScopedLockType lock (snapshotLock);
+        return nonParameterSnapshot;
+    }();
+
+    MemoryOutputStream out (destData, false);
+    out.writeInt (stateSnapshotMagic);
+    out.writeInt (nonParameterState != nullptr ? (int) nonParameterState->getSize() : 0);
+
+    if (nonParameterState != nullptr)
+        out.write (nonParameterState->getData(), nonParameterState->getSize());
+
+    out.writeCompressedInt ((int) adapterTable.size());
+
+    for (const auto& item : adapterTable)
+    {
+        out.writeString (item.second->getParameter().paramID);
+        out.writeFloat (item.second->getDenormalisedValue());
+    }
+}
+
+bool AudioProcessorValueTreeState::applyStateSnapshot (const void* data, size_t sizeInBytes)
+{
+    MemoryInputStream in (data, sizeInBytes, false);
+
+    if (sizeInBytes < 8 || in.readInt() != stateSnapshotMagic)
+        return false;
+
+    const auto treeSize = in.readInt();
+
+    if (treeSize < 0 || treeSize > in.getNumBytesRemaining())
+        return false;
+
+    auto newState = treeSize > 0 ? ValueTree::readFromData (addBytesToPointer (data, in.getPosition()), (size_t) treeSize)
+                                 : ValueTree (state.getType());
+
+    if (! newState.isValid())
+        return false;
+
+    in.skipNextBytes (treeSize);
+
+    for (auto i = in.readCompressedInt(); --i >= 0;)
+    {
+        if (in.isExhausted())
+            return false;
+
+        const auto paramID = in.readString();
+
+        if (in.getNumBytesRemaining() < (int64) sizeof (float))
+            return false;
+
+        const auto value = in.readFloat();
+        newState.appendChild (ValueTree (valueType, { { idPropertyID, paramID }, { valuePropertyID, value } }), nullptr);
+    }
+
+    applyState (newState);
+    return true;
+}
+
+void AudioProcessorValueTreeState::updateNonParameterStateSnapshot()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (! nonParameterStateChanged.exchange (false))
+        return;
+
+    auto block = std::make_shared<MemoryBlock>();
+
+    if (state.isValid())
+    {
+        ValueTree nonParameterState (state.getType());
+        nonParameterState.copyPropertiesFrom (state, nullptr);
+
+        for (const auto& child : state)
+            if (! child.hasType (valueType))
+                nonParameterState.appendChild (child.createCopy(), nullptr);
+
+        MemoryOutputStream out (*block, false);
+        nonParameterState.writeToStream (out);
+    }
+
+    const SpinLock::ScopedLockType lock (snapshotLock);
+    nonParameterSnapshot = std::move (block);
+}
+
 void AudioProcessorValueTreeState::setNewState (ValueTree vt)
 {
     jassert (vt.getParent() == state);
@@ -434,18 +574,36 @@ void AudioProcessorValueTreeState::valueTreePropertyChanged (ValueTree& tree, co
 {
     if (tree.hasType (valueType) && tree.getParent() == state)
         setNewState (tree);
+    else
+        nonParameterStateChanged = true;
 }
 
 void AudioProcessorValueTreeState::valueTreeChildAdded (ValueTree& parent, ValueTree& tree)
 {
     if (parent == state && tree.hasType (valueType))
         setNewState (tree);
+    else
+        nonParameterStateChanged = true;
+}
+
+void AudioProcessorValueTreeState::valueTreeChildRemoved (ValueTree& parent, ValueTree& tree, int)
+{
+    if (! (parent == state && tree.hasType (valueType)))
+        nonParameterStateChanged = true;
+}
+
+void AudioProcessorValueTreeState::valueTreeChildOrderChanged (ValueTree&, int, int)
+{
+    nonParameterStateChanged = true;
 }
 
 void AudioProcessorValueTreeState::valueTreeRedirected (ValueTree& v)
 {
     if (v == state)
+    {
+        nonParameterStateChanged = true;
         updateParameterConnectionsToChildTrees();
+    }
 }
 
 bool AudioProcessorValueTreeState::flushParameterValuesToValueTree()
@@ -463,6 +621,7 @@ bool AudioProcessorValueTreeState::flushParameterValuesToValueTree()
 void AudioProcessorValueTreeState::timerCallback()
 {
     auto anythingUpdated = flushParameterValuesToValueTree();
+    updateNonParameterStateSnapshot();
 
     startTimer (anythingUpdated ? 1000 / 50
                                 : jlimit (50, 500, getTimerInterval() + 20));
@@ -977,6 +1136,85 @@ public:
             expectEquals (listener.value, newValue);
             expectEquals (listener.id, String (key));
         }
+
+        beginTest ("applyState updates changed parameters and notifies the host once");
+        {
+            struct HostListener final : public AudioProcessorListener
+            {
+                void audioProcessorParameterChanged (AudioProcessor*, int, float) override { ++numParameterChanges; }
+                void audioProcessorChanged (AudioProcessor*, const ChangeDetails& details) override
+                {
+                    numValueBatches += details.parameterValuesChanged ? 1 : 0;
+                }
+
+                int numParameterChanges = 0, numValueBatches = 0;
+            };
+
+            TestAudioProcessor proc ({ std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float> { 0.0f, 10.0f }, 1.0f),
+                                       std::make_unique<AudioParameterFloat> ("b", "", NormalisableRange<float> { 0.0f, 10.0f }, 2.0f),
+                                       std::make_unique<AudioParameterInt> ("c", "", 0, 10, 3) });
+
+            auto preset = proc.state.copyState();
+            preset.getChildWithProperty ("id", "a").setProperty ("value", 5.0f, nullptr);
+            preset.getChildWithProperty ("id", "c").setProperty ("value", 7, nullptr);
+            preset.setProperty ("presetName", "Preset", nullptr);
+            preset.appendChild (ValueTree { "CustomData" }, nullptr);
+
+            Listener listener;
+            proc.state.addParameterListener ("c", &listener);
+
+            HostListener hostListener;
+            proc.addListener (&hostListener);
+
+            proc.state.applyState (preset);
+
+            expectEquals (proc.state.getRawParameterValue ("a")->load(), 5.0f);
+            expectEquals (proc.state.getRawParameterValue ("b")->load(), 2.0f);
+            expectEquals (proc.state.getRawParameterValue ("c")->load(), 7.0f);
+            expectEquals (listener.value, 7.0f);
+            expectEquals (hostListener.numParameterChanges, 0);
+            expectEquals (hostListener.numValueBatches, 1);
+
+            const auto applied = proc.state.copyState();
+            expectEquals ((float) applied.getChildWithProperty ("id", "a").getProperty ("value"), 5.0f);
+            expect (applied.getProperty ("presetName") == var ("Preset"));
+            expect (applied.getChildWithName ("CustomData").isValid());
+
+            proc.state.applyState (applied);
+            expectEquals (hostListener.numValueBatches, 1);
+            expectEquals (applied.getNumChildren(), proc.state.state.getNumChildren());
+
+            proc.removeListener (&hostListener);
+        }
+
+        beginTest ("State snapshots round-trip parameter values and non-parameter state");
+        {
+            TestAudioProcessor proc ({ std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float> { 0.0f, 10.0f }, 1.0f),
+                                       std::make_unique<AudioParameterInt> ("b", "", 0, 10, 3) });
+
+            proc.state.state.setProperty ("presetName", "Snapshot", nullptr);
+            proc.state.state.appendChild (ValueTree { "CustomData", { { "size", 42 } } }, nullptr);
+            proc.state.getParameter ("a")->setValueNotifyingHost (0.5f);
+
+            MemoryBlock snapshot;
+            proc.state.writeStateSnapshot (snapshot);
+
+            proc.state.getParameter ("a")->setValueNotifyingHost (0.0f);
+            proc.state.getParameter ("b")->setValueNotifyingHost (1.0f);
+            proc.state.state.setProperty ("presetName", "Changed", nullptr);
+            proc.state.state.removeChild (proc.state.state.getChildWithName ("CustomData"), nullptr);
+
+            expect (proc.state.applyStateSnapshot (snapshot.getData(), snapshot.getSize()));
+
+            expectEquals (proc.state.getRawParameterValue ("a")->load(), 5.0f);
+            expectEquals (proc.state.getRawParameterValue ("b")->load(), 3.0f);
+            expect (proc.state.state.getProperty ("presetName") == var ("Snapshot"));
+            expectEquals ((int) proc.state.state.getChildWithName ("CustomData").getProperty ("size"), 42);
+
+            expect (! proc.state.applyStateSnapshot (snapshot.getData(), snapshot.getSize() / 2));
+            expect (! proc.state.applyStateSnapshot ("junk", 4));
+            expectEquals (proc.state.getRawParameterValue ("a")->load(), 5.0f);
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 };
@@ -394,6 +394,48 @@ public:
     */
     void replaceState (const ValueTree& newState);
 
+    /** Loads the parameter values and other contents of a state tree, e.g. a preset,
+        into the current state.
+
+        Unlike replaceState(), this only touches the parameters whose values differ
+        from the new state. Instead of one host notification per changed parameter,
+        the host gets a single AudioProcessor::updateHostDisplay() call with
+        ChangeDetails::withParameterValuesChanged() set. The parameters' own listeners
+        and any AudioProcessorValueTreeState::Listeners are still called for each
+        changed parameter, and the parameter entries in the state tree are updated
+        lazily, in the same way as after any other parameter change.
+
+        Properties and non-parameter children of the new state replace those of the
+        current state. Parameters which aren't mentioned in the new state keep their
+        current values.
+
+        Like replaceState(), this clears the UndoManager's history and mustn't be called
+        from your audio processing code.
+    */
+    void applyState (const ValueTree& newState);
+
+    /** Writes a compact binary snapshot of the state, suitable for returning from
+        AudioProcessor::getStateInformation().
+
+        This may be called from any thread, and never waits for the message thread or
+        your audio processing code. The parameter values are read directly from their
+        atomic values, and the rest of the state tree is serialised in the background
+        whenever it changes, so the cost of a snapshot doesn't depend on how large the
+        tree is. When called from a thread other than the message thread, changes to the
+        non-parameter parts of the tree that were made in the last few hundred
+        milliseconds may not be included yet.
+
+        Use applyStateSnapshot() to restore the data.
+    */
+    void writeStateSnapshot (MemoryBlock& destData);
+
+    /** Restores a snapshot that was created with writeStateSnapshot(), using applyState().
+
+        Call this from the message thread. Returns false, and leaves the state alone,
+        if the data isn't a valid snapshot.
+    */
+    bool applyStateSnapshot (const void* data, size_t sizeInBytes);
+
     //==============================================================================
     /** A reference to the processor with which this state is associated. */
     AudioProcessor& processor;
@@ -637,9 +679,12 @@ private:
     bool flushParameterValuesToValueTree();
     void setNewState (ValueTree);
     void timerCallback() override;
+    void updateNonParameterStateSnapshot();
 
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
+    void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
+    void valueTreeChildOrderChanged (ValueTree&, int, int) override;
     void valueTreeRedirected (ValueTree&) override;
     void updateParameterConnectionsToChildTrees();
 
@@ -654,6 +699,10 @@ private:
 
     CriticalSection valueTreeChanging;
 
+    SpinLock snapshotLock;
+    std::shared_ptr<const MemoryBlock> nonParameterSnapshot;
+    std::atomic<bool> nonParameterStateChanged { true };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorValueTreeState)
 };
 
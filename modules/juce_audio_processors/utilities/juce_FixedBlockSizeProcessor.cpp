@@ -0,0 +1,577 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+template <typename FloatType>
+void FixedBlockSizeProcessor::Blocks<FloatType>::prepare (int numChannels, int numSamples)
+{
+    input .setSize (numChannels, numSamples);
+    output.setSize (numChannels, numSamples);
+
+    const int defaultMidiBufferSize = 512;
+    midiInput .ensureSize (defaultMidiBufferSize);
+    midiOutput.ensureSize (defaultMidiBufferSize);
+
+    clear();
+}
+
+template <typename FloatType>
+void FixedBlockSizeProcessor::Blocks<FloatType>::release()
+{
+    input .setSize (0, 0);
+    output.setSize (0, 0);
+    clear();
+}
+
+template <typename FloatType>
+void FixedBlockSizeProcessor::Blocks<FloatType>::clear()
+{
+    input .clear();
+    output.clear();
+    midiInput .clear();
+    midiOutput.clear();
+}
+
+//==============================================================================
+void FixedBlockSizeProcessor::OffsetPlayHead::set (AudioPlayHead* newHostPlayHead, int newOffset, double newSampleRate) noexcept
+{
+    host = newHostPlayHead;
+    offset = newOffset;
+    sampleRate = newSampleRate;
+}
+
+Optional<AudioPlayHead::PositionInfo> FixedBlockSizeProcessor::OffsetPlayHead::getPosition() const
+{
+    if (host == nullptr)
+        return {};
+
+    auto position = host->getPosition();
+
+    if (! position.hasValue() || offset == 0 || sampleRate <= 0.0)
+        return position;
+
+    const auto offsetSeconds = offset / sampleRate;
+
+    if (const auto timeInSamples = position->getTimeInSamples())
+        position->setTimeInSamples (*timeInSamples + offset);
+
+    if (const auto timeInSeconds = position->getTimeInSeconds())
+        position->setTimeInSeconds (*timeInSeconds + offsetSeconds);
+
+    if (const auto ppqPosition = position->getPpqPosition())
+        if (const auto bpm = position->getBpm())
+            position->setPpqPosition (*ppqPosition + offsetSeconds * *bpm / 60.0);
+
+    return position;
+}
+
+bool FixedBlockSizeProcessor::OffsetPlayHead::canControlTransport()     { return host != nullptr && host->canControlTransport(); }
+
+void FixedBlockSizeProcessor::OffsetPlayHead::transportPlay (bool shouldStartPlaying)
+{
+    if (host != nullptr)
+        host->transportPlay (shouldStartPlaying);
+}
+
+void FixedBlockSizeProcessor::OffsetPlayHead::transportRecord (bool shouldStartRecording)
+{
+    if (host != nullptr)
+        host->transportRecord (shouldStartRecording);
+}
+
+void FixedBlockSizeProcessor::OffsetPlayHead::transportRewind()
+{
+    if (host != nullptr)
+        host->transportRewind();
+}
+
+//==============================================================================
+FixedBlockSizeProcessor::FixedBlockSizeProcessor (std::unique_ptr<AudioProcessor> processorToWrap,
+                                                  int internalBlockSize,
+                                                  Strategy strategyToUse)
+    : AudioProcessor (getBusesPropertiesOf (*processorToWrap)),
+      wrapped (std::move (processorToWrap)),
+      blockSize (internalBlockSize),
+      strategy (strategyToUse)
+{
+    // The internal blocks must contain at least one sample!
+    jassert (blockSize > 0);
+
+    wrapped->addListener (this);
+    updateLatency();
+}
+
+FixedBlockSizeProcessor::~FixedBlockSizeProcessor()
+{
+    wrapped->removeListener (this);
+}
+
+AudioProcessor::BusesProperties FixedBlockSizeProcessor::getBusesPropertiesOf (const AudioProcessor& processor)
+{
+    BusesProperties result;
+
+    for (const auto isInput : { true, false })
+        for (int i = 0; i < processor.getBusCount (isInput); ++i)
+            if (const auto* bus = processor.getBus (isInput, i))
+                result.addBus (isInput, bus->getName(), bus->getLastEnabledLayout(), bus->isEnabled());
+
+    return result;
+}
+
+//==============================================================================
+const String FixedBlockSizeProcessor::getName() const                       { return wrapped->getName(); }
+
+void FixedBlockSizeProcessor::prepareToPlay (double sampleRate, int)
+{
+    [[maybe_unused]] const auto layoutApplied = wrapped->setBusesLayout (getBusesLayout());
+    jassert (layoutApplied);
+
+    wrapped->setProcessingPrecision (getProcessingPrecision());
+    wrapped->setRateAndBufferSizeDetails (sampleRate, blockSize);
+    wrapped->setNonRealtime (isNonRealtime());
+    wrapped->prepareToPlay (sampleRate, blockSize);
+
+    // The zero-latency strategy processes the host's buffer in place, so only needs space for MIDI
+    const auto numChannels = jmax (getTotalNumInputChannels(), getTotalNumOutputChannels());
+    const auto numSamples = strategy == Strategy::fixedBlocks ? blockSize : 0;
+
+    if (isUsingDoublePrecision())
+    {
+        getBlocks<double>().prepare (numChannels, numSamples);
+        getBlocks<float>().release();
+    }
+    else
+    {
+        getBlocks<float>().prepare (numChannels, numSamples);
+        getBlocks<double>().release();
+    }
+
+    midiToHost.ensureSize (512);
+    midiToHost.clear();
+    positionInBlock = 0;
+
+    updateLatency();
+}
+
+void FixedBlockSizeProcessor::releaseResources()
+{
+    wrapped->releaseResources();
+    getBlocks<float>().release();
+    getBlocks<double>().release();
+}
+
+void FixedBlockSizeProcessor::reset()
+{
+    wrapped->reset();
+    getBlocks<float>().clear();
+    getBlocks<double>().clear();
+    midiToHost.clear();
+    positionInBlock = 0;
+}
+
+void FixedBlockSizeProcessor::setNonRealtime (bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime (isNonRealtime);
+    wrapped->setNonRealtime (isNonRealtime);
+}
+
+void FixedBlockSizeProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi)           { process (buffer, midi, false); }
+void FixedBlockSizeProcessor::processBlock (AudioBuffer<double>& buffer, MidiBuffer& midi)          { process (buffer, midi, false); }
+void FixedBlockSizeProcessor::processBlockBypassed (AudioBuffer<float>& buffer, MidiBuffer& midi)   { process (buffer, midi, true); }
+void FixedBlockSizeProcessor::processBlockBypassed (AudioBuffer<double>& buffer, MidiBuffer& midi)  { process (buffer, midi, true); }
+
+bool FixedBlockSizeProcessor::supportsDoublePrecisionProcessing() const     { return wrapped->supportsDoublePrecisionProcessing(); }
+double FixedBlockSizeProcessor::getTailLengthSeconds() const                { return wrapped->getTailLengthSeconds(); }
+bool FixedBlockSizeProcessor::acceptsMidi() const                           { return wrapped->acceptsMidi(); }
+bool FixedBlockSizeProcessor::producesMidi() const                          { return wrapped->producesMidi(); }
+bool FixedBlockSizeProcessor::isMidiEffect() const                          { return wrapped->isMidiEffect(); }
+bool FixedBlockSizeProcessor::hasEditor() const                             { return false; }
+AudioProcessorEditor* FixedBlockSizeProcessor::createEditor()               { return nullptr; }
+
+int FixedBlockSizeProcessor::getNumPrograms()                               { return wrapped->getNumPrograms(); }
+int FixedBlockSizeProcessor::getCurrentProgram()                            { return wrapped->getCurrentProgram(); }
+void FixedBlockSizeProcessor::setCurrentProgram (int index)                 { wrapped->setCurrentProgram (index); }
+const String FixedBlockSizeProcessor::getProgramName (int index)            { return wrapped->getProgramName (index); }
+void FixedBlockSizeProcessor::changeProgramName (int index, const String& newName)  { wrapped->changeProgramName (index, newName); }
+
+void FixedBlockSizeProcessor::getStateInformation (MemoryBlock& destData)               { wrapped->getStateInformation (destData); }
+void FixedBlockSizeProcessor::setStateInformation (const void* data, int sizeInBytes)   { wrapped->setStateInformation (data, sizeInBytes); }
+
+bool FixedBlockSizeProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+    return wrapped->checkBusesLayoutSupported (layouts);
+}
+
+//==============================================================================
+template <typename FloatType>
+void FixedBlockSizeProcessor::process (AudioBuffer<FloatType>& buffer, MidiBuffer& midi, bool bypassed)
+{
+    if (strategy == Strategy::fixedBlocks)
+        processFixedBlocks (buffer, midi, bypassed);
+    else
+        processWithoutLatency (buffer, midi, bypassed);
+
+    midi.swapWith (midiToHost);
+    midiToHost.clear();
+}
+
+/*  Each host block is written into the input block and read from the output block at the same
+    position, so everything comes out exactly one internal block later than it went in.
+*/
+template <typename FloatType>
+void FixedBlockSizeProcessor::processFixedBlocks (AudioBuffer<FloatType>& buffer, MidiBuffer& midi, bool bypassed)
+{
+    auto& b = getBlocks<FloatType>();
+
+    // Make sure prepareToPlay() has been called at this precision
+    jassert (b.input.getNumSamples() == blockSize);
+
+    const auto numChannels = jmin (buffer.getNumChannels(), b.input.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+
+    for (int start = 0; start < numSamples;)
+    {
+        const auto num = jmin (blockSize - positionInBlock, numSamples - start);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            b.input.copyFrom (ch, positionInBlock, buffer, ch, start, num);
+            buffer.copyFrom (ch, start, b.output, ch, positionInBlock, num);
+        }
+
+        b.midiInput.addEvents (midi, start, num, positionInBlock - start);
+        midiToHost.addEvents (b.midiOutput, positionInBlock, num, start - positionInBlock);
+
+        positionInBlock += num;
+        start += num;
+
+        if (positionInBlock == blockSize)
+        {
+            // The block that has just been filled began one block before this point in the host's block
+            processWrapped (b.input, b.midiInput, start - blockSize, bypassed);
+
+            std::swap (b.input, b.output);
+            b.midiInput.swapWith (b.midiOutput);
+            b.midiInput.clear();
+            positionInBlock = 0;
+        }
+    }
+}
+
+/*  Host blocks are split wherever they cross the edge of an internal block, so that long host
+    blocks are processed in whole internal blocks.
+*/
+template <typename FloatType>
+void FixedBlockSizeProcessor::processWithoutLatency (AudioBuffer<FloatType>& buffer, MidiBuffer& midi, bool bypassed)
+{
+    auto& midiForBlock = getBlocks<FloatType>().midiInput;
+    const auto numSamples = buffer.getNumSamples();
+
+    for (int start = 0; start < numSamples;)
+    {
+        const auto num = jmin (blockSize - positionInBlock, numSamples - start);
+
+        AudioBuffer<FloatType> chunk (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, num);
+        midiForBlock.clear();
+        midiForBlock.addEvents (midi, start, num, -start);
+
+        processWrapped (chunk, midiForBlock, start, bypassed);
+
+        midiToHost.addEvents (midiForBlock, 0, num, start);
+
+        positionInBlock = (positionInBlock + num) % blockSize;
+        start += num;
+    }
+}
+
+template <typename FloatType>
+void FixedBlockSizeProcessor::processWrapped (AudioBuffer<FloatType>& buffer, MidiBuffer& midi, int offsetInHostBlock, bool bypassed)
+{
+    const ScopedLock sl (wrapped->getCallbackLock());
+
+    auto* hostPlayHead = getPlayHead();
+    wrappedPlayHead.set (hostPlayHead, offsetInHostBlock, getSampleRate());
+    wrapped->setPlayHead (hostPlayHead != nullptr ? &wrappedPlayHead : nullptr);
+
+    if (wrapped->isSuspended())
+    {
+        buffer.clear();
+        midi.clear();
+    }
+    else if (bypassed)
+    {
+        wrapped->processBlockBypassed (buffer, midi);
+    }
+    else
+    {
+        wrapped->processBlock (buffer, midi);
+    }
+}
+
+//==============================================================================
+void FixedBlockSizeProcessor::updateLatency()
+{
+    setLatencySamples (wrapped->getLatencySamples() + (strategy == Strategy::fixedBlocks ? blockSize : 0));
+}
+
+void FixedBlockSizeProcessor::audioProcessorChanged (AudioProcessor*, const AudioProcessorListener::ChangeDetails& details)
+{
+    if (details.latencyChanged)
+        updateLatency();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class FixedBlockSizeProcessorTests final : public UnitTest
+{
+public:
+    FixedBlockSizeProcessorTests()
+        : UnitTest ("FixedBlockSizeProcessor", UnitTestCategories::audioProcessors) {}
+
+    void runTest() override
+    {
+        beginTest ("fixed blocks are always whole, and are delayed by one block");
+        {
+            constexpr auto blockSize = 16;
+
+            auto recorder = std::make_unique<RecordingProcessor>();
+            auto& record = *recorder;
+
+            FixedBlockSizeProcessor wrapper (std::move (recorder), blockSize);
+            wrapper.prepareToPlay (44100.0, 512);
+
+            expectEquals (wrapper.getLatencySamples(), blockSize);
+
+            const auto output = renderRamp (wrapper, { 1, 7, 16, 3, 40, 2, 1, 100, 5 }, { 0, 9, 30, 31, 64, 150 });
+
+            expect (! record.blockSizes.empty());
+
+            for (const auto size : record.blockSizes)
+                expectEquals (size, blockSize);
+
+            expect (record.allBlocksAligned);
+
+            for (size_t i = 0; i < output.samples.size(); ++i)
+                expectEquals (output.samples[i], 2.0f * ramp ((int) i - blockSize));
+
+            // The wrapped processor sees each event at the same position in the stream
+            expect (record.eventPositions == std::vector<int> { 0, 9, 30, 31, 64, 150 });
+            expect (output.eventPositions == std::vector<int> { 0 + blockSize, 9 + blockSize, 30 + blockSize,
+                                                                31 + blockSize, 64 + blockSize, 150 + blockSize });
+        }
+
+        beginTest ("zero latency blocks are split at the edges of internal blocks");
+        {
+            constexpr auto blockSize = 32;
+
+            auto recorder = std::make_unique<RecordingProcessor>();
+            auto& record = *recorder;
+
+            FixedBlockSizeProcessor wrapper (std::move (recorder), blockSize, FixedBlockSizeProcessor::Strategy::zeroLatency);
+            wrapper.prepareToPlay (44100.0, 512);
+
+            expectEquals (wrapper.getLatencySamples(), 0);
+
+            const auto output = renderRamp (wrapper, { 5, 100, 59, 1, 64 }, { 3, 40, 100, 163, 200 });
+
+            expect (record.blockSizes == std::vector<int> { 5, 27, 32, 32, 9, 23, 32, 4, 1, 27, 32, 5 });
+
+            for (size_t i = 0; i < output.samples.size(); ++i)
+                expectEquals (output.samples[i], 2.0f * ramp ((int) i));
+
+            expect (record.eventPositions == std::vector<int> { 3, 40, 100, 163, 200 });
+            expect (output.eventPositions == std::vector<int> { 3, 40, 100, 163, 200 });
+        }
+
+        beginTest ("the wrapped processor sees the position of each internal block");
+        {
+            for (const auto strategy : { FixedBlockSizeProcessor::Strategy::fixedBlocks,
+                                         FixedBlockSizeProcessor::Strategy::zeroLatency })
+            {
+                auto recorder = std::make_unique<RecordingProcessor>();
+                auto& record = *recorder;
+
+                FixedBlockSizeProcessor wrapper (std::move (recorder), 32, strategy);
+                wrapper.setRateAndBufferSizeDetails (sampleRate, 512);
+                wrapper.prepareToPlay (sampleRate, 512);
+
+                renderRamp (wrapper, { 5, 100, 59, 1, 64 }, {});
+
+                expectEquals (record.positions.size(), record.blockStarts.size());
+
+                for (size_t i = 0; i < record.positions.size(); ++i)
+                {
+                    const auto& position = record.positions[i];
+                    const auto start = record.blockStarts[i];
+
+                    expect (position.getTimeInSamples() == makeOptional ((int64) start));
+                    expectWithinAbsoluteError (*position.getTimeInSeconds(), start / sampleRate, 1.0e-9);
+                    expectWithinAbsoluteError (*position.getPpqPosition(), start / sampleRate * bpm / 60.0, 1.0e-9);
+                }
+            }
+        }
+
+        beginTest ("changes to the wrapped processor's latency are reported");
+        {
+            auto recorder = std::make_unique<RecordingProcessor>();
+            auto& record = *recorder;
+
+            FixedBlockSizeProcessor wrapper (std::move (recorder), 64);
+            record.setLatencySamples (10);
+            expectEquals (wrapper.getLatencySamples(), 74);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0, bpm = 120.0;
+
+    static float ramp (int sample)  { return sample >= 0 ? (float) (sample + 1) : 0.0f; }
+
+    struct Rendered
+    {
+        std::vector<float> samples;
+        std::vector<int> eventPositions;
+    };
+
+    /*  Sends a ramp through the processor using the given host block sizes, with a MIDI note
+        at each of the given positions.
+    */
+    static Rendered renderRamp (AudioProcessor& processor, const std::vector<int>& hostBlockSizes, const std::vector<int>& notePositions)
+    {
+        Rendered result;
+        int position = 0;
+
+        HostPlayHead playHead;
+        processor.setPlayHead (&playHead);
+
+        for (const auto size : hostBlockSizes)
+        {
+            AudioBuffer<float> audio (1, size);
+            MidiBuffer midi;
+
+            for (int i = 0; i < size; ++i)
+                audio.setSample (0, i, ramp (position + i));
+
+            for (const auto note : notePositions)
+                if (position <= note && note < position + size)
+                    midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), note - position);
+
+            playHead.timeInSamples = position;
+            processor.processBlock (audio, midi);
+
+            for (int i = 0; i < size; ++i)
+                result.samples.push_back (audio.getSample (0, i));
+
+            for (const auto metadata : midi)
+                result.eventPositions.push_back (position + metadata.samplePosition);
+
+            position += size;
+        }
+
+        processor.setPlayHead (nullptr);
+        return result;
+    }
+
+    /*  A play head for a host that is playing at a constant tempo. */
+    struct HostPlayHead final : public AudioPlayHead
+    {
+        Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo info;
+            info.setIsPlaying (true);
+            info.setBpm (bpm);
+            info.setTimeInSamples (timeInSamples);
+            info.setTimeInSeconds ((double) timeInSamples / sampleRate);
+            info.setPpqPosition ((double) timeInSamples / sampleRate * bpm / 60.0);
+            return info;
+        }
+
+        int64 timeInSamples = 0;
+    };
+
+    /*  Doubles its input, passes MIDI through, and records the blocks and events it receives. */
+    class RecordingProcessor final : public AudioProcessor
+    {
+    public:
+        RecordingProcessor()
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::mono())
+                                               .withOutput ("out", AudioChannelSet::mono())) {}
+
+        const String getName() const override                             { return "Recorder"; }
+        void prepareToPlay (double, int) override                         {}
+        void releaseResources() override                                  {}
+        double getTailLengthSeconds() const override                      { return 0.0; }
+        bool acceptsMidi() const override                                 { return true; }
+        bool producesMidi() const override                                { return true; }
+        AudioProcessorEditor* createEditor() override                     { return nullptr; }
+        bool hasEditor() const override                                   { return false; }
+        int getNumPrograms() override                                     { return 1; }
+        int getCurrentProgram() override                                  { return 0; }
+        void setCurrentProgram (int) override                             {}
+        const String getProgramName (int) override                        { return {}; }
+        void changeProgramName (int, const String&) override              {}
+        void getStateInformation (MemoryBlock&) override                  {}
+        void setStateInformation (const void*, int) override              {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+        {
+            for (const auto metadata : midi)
+                eventPositions.push_back (samplesProcessed + metadata.samplePosition);
+
+            if (auto* currentPlayHead = getPlayHead())
+            {
+                if (const auto position = currentPlayHead->getPosition())
+                {
+                    positions.push_back (*position);
+                    blockStarts.push_back (samplesProcessed);
+                }
+            }
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                allBlocksAligned = allBlocksAligned && (size_t) buffer.getReadPointer (ch) % AudioBuffer<float>::simdAlignment == 0;
+
+            blockSizes.push_back (buffer.getNumSamples());
+            samplesProcessed += buffer.getNumSamples();
+            buffer.applyGain (2.0f);
+        }
+
+        using AudioProcessor::processBlock;
+
+        std::vector<int> blockSizes, eventPositions, blockStarts;
+        std::vector<AudioPlayHead::PositionInfo> positions;
+        int samplesProcessed = 0;
+        bool allBlocksAligned = true;
+    };
+};
+
+static FixedBlockSizeProcessorTests fixedBlockSizeProcessorTests;
+
+#endif
+
+} // namespace juce
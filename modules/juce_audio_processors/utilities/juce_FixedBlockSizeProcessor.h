@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AudioProcessor that wraps another processor, and feeds it blocks of a fixed size
+    whatever size of blocks the host uses.
+
+    Some hosts send very short blocks, sometimes only a few samples long (e.g. either side
+    of an automation point). In a chain of processors, the cost of each processBlock() call
+    can then outweigh the processing itself. Processors that use block-based or vectorised
+    algorithms may also prefer to work on whole blocks of a known size.
+
+    There are two strategies:
+
+    - Strategy::fixedBlocks collects the audio and MIDI from the host, and processes them
+      once a whole internal block has been collected. The wrapped processor always
+      receives exactly the internal block size. These blocks are held in buffers owned by
+      this wrapper, so each channel starts at an aligned address. The wrapper adds the
+      internal block size to the wrapped processor's latency.
+    - Strategy::zeroLatency processes the host's audio straight away, without adding any
+      latency. Each host block is split where it crosses the edge of an internal block, so
+      the wrapped processor never receives more than the internal block size. Long host
+      blocks are processed as whole internal blocks, but short host blocks stay short.
+
+    MIDI events are moved to the matching positions in the internal blocks. The wrapped
+    processor's MIDI output is moved back to the host's block in the same way, so events
+    keep their timing relative to the audio.
+
+    The wrapper starts with the same buses as the wrapped processor, and asks the wrapped
+    processor which layouts it supports. Programs and state are passed through. The wrapped
+    processor's parameters and editor aren't forwarded; use getWrappedProcessor() to reach
+    them. The wrapped processor is given a play head that reports the position of the start
+    of each internal block. With Strategy::fixedBlocks, this is one internal block behind
+    the host's position, because of the added latency.
+
+    @tags{Audio}
+*/
+class JUCE_API  FixedBlockSizeProcessor  : public AudioProcessor,
+                                           private AudioProcessorListener
+{
+public:
+    //==============================================================================
+    /** How the host's blocks are turned into internal blocks. */
+    enum class Strategy
+    {
+        fixedBlocks,    /**< Always process whole internal blocks, adding one block of latency. */
+        zeroLatency     /**< Process straight away, splitting host blocks at the edges of internal blocks. */
+    };
+
+    /** Creates a wrapper that owns the given processor.
+
+        @param processorToWrap      the processor to feed with fixed-size blocks
+        @param internalBlockSize    the number of samples in each internal block
+        @param strategy             whether to add latency so that all blocks are whole
+    */
+    FixedBlockSizeProcessor (std::unique_ptr<AudioProcessor> processorToWrap,
+                             int internalBlockSize,
+                             Strategy strategy = Strategy::fixedBlocks);
+
+    /** Destructor. */
+    ~FixedBlockSizeProcessor() override;
+
+    //==============================================================================
+    /** Returns the processor that this wrapper owns. */
+    AudioProcessor& getWrappedProcessor() const noexcept        { return *wrapped; }
+
+    /** Returns the number of samples in each internal block. */
+    int getInternalBlockSize() const noexcept                   { return blockSize; }
+
+    /** Returns the strategy that was passed to the constructor. */
+    Strategy getStrategy() const noexcept                       { return strategy; }
+
+    //==============================================================================
+    /** @internal */
+    const String getName() const override;
+    /** @internal */
+    void prepareToPlay (double sampleRate, int maximumExpectedSamplesPerBlock) override;
+    /** @internal */
+    void releaseResources() override;
+    /** @internal */
+    void reset() override;
+    /** @internal */
+    void setNonRealtime (bool isNonRealtime) noexcept override;
+    /** @internal */
+    void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
+    /** @internal */
+    void processBlock (AudioBuffer<double>&, MidiBuffer&) override;
+    /** @internal */
+    void processBlockBypassed (AudioBuffer<float>&, MidiBuffer&) override;
+    /** @internal */
+    void processBlockBypassed (AudioBuffer<double>&, MidiBuffer&) override;
+    /** @internal */
+    bool supportsDoublePrecisionProcessing() const override;
+    /** @internal */
+    double getTailLengthSeconds() const override;
+    /** @internal */
+    bool acceptsMidi() const override;
+    /** @internal */
+    bool producesMidi() const override;
+    /** @internal */
+    bool isMidiEffect() const override;
+    /** @internal */
+    bool hasEditor() const override;
+    /** @internal */
+    AudioProcessorEditor* createEditor() override;
+    /** @internal */
+    int getNumPrograms() override;
+    /** @internal */
+    int getCurrentProgram() override;
+    /** @internal */
+    void setCurrentProgram (int index) override;
+    /** @internal */
+    const String getProgramName (int index) override;
+    /** @internal */
+    void changeProgramName (int index, const String& newName) override;
+    /** @internal */
+    void getStateInformation (MemoryBlock& destData) override;
+    /** @internal */
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+protected:
+    /** @internal */
+    bool isBusesLayoutSupported (const BusesLayout&) const override;
+
+private:
+    //==============================================================================
+    template <typename FloatType>
+    struct Blocks
+    {
+        void prepare (int numChannels, int numSamples);
+        void release();
+        void clear();
+
+        AudioBuffer<FloatType> input  { 0, 0, AudioBuffer<FloatType>::Allocation::aligned },
+                               output { 0, 0, AudioBuffer<FloatType>::Allocation::aligned };
+        MidiBuffer midiInput, midiOutput;
+    };
+
+    /*  Reports the host's position, moved by a number of samples. */
+    class OffsetPlayHead final : public AudioPlayHead
+    {
+    public:
+        void set (AudioPlayHead* newHostPlayHead, int newOffset, double newSampleRate) noexcept;
+
+        Optional<PositionInfo> getPosition() const override;
+        bool canControlTransport() override;
+        void transportPlay (bool shouldStartPlaying) override;
+        void transportRecord (bool shouldStartRecording) override;
+        void transportRewind() override;
+
+    private:
+        AudioPlayHead* host = nullptr;
+        int offset = 0;
+        double sampleRate = 0.0;
+    };
+
+    template <typename FloatType>
+    void process (AudioBuffer<FloatType>&, MidiBuffer&, bool bypassed);
+
+    template <typename FloatType>
+    void processFixedBlocks (AudioBuffer<FloatType>&, MidiBuffer&, bool bypassed);
+
+    template <typename FloatType>
+    void processWithoutLatency (AudioBuffer<FloatType>&, MidiBuffer&, bool bypassed);
+
+    template <typename FloatType>
+    void processWrapped (AudioBuffer<FloatType>&, MidiBuffer&, int offsetInHostBlock, bool bypassed);
+
+    template <typename FloatType>
+    Blocks<FloatType>& getBlocks() noexcept     { return std::get<Blocks<FloatType>> (blocks); }
+
+    void updateLatency();
+
+    void audioProcessorParameterChanged (AudioProcessor*, int, float) override {}
+    void audioProcessorChanged (AudioProcessor*, const AudioProcessorListener::ChangeDetails&) override;
+
+    static BusesProperties getBusesPropertiesOf (const AudioProcessor&);
+
+    std::unique_ptr<AudioProcessor> wrapped;
+    const int blockSize;
+    const Strategy strategy;
+
+    std::tuple<Blocks<float>, Blocks<double>> blocks;
+    MidiBuffer midiToHost;
+    OffsetPlayHead wrappedPlayHead;
+    int positionInBlock = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FixedBlockSizeProcessor)
+};
+
+} // namespace juce
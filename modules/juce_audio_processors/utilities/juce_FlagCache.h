@@ -28,6 +28,14 @@
 namespace juce
 {
 
+/*  Holds a few flag bits for each of a large number of items, e.g. the parameters
+    of a plugin, which may be set from any thread and collected from another.
+
+    The flag words are summarised by a second bitmap holding one bit per word, so
+    collecting the set flags only visits the words that have changed. This keeps
+    the cost of ifSet() proportional to the number of changed items rather than to
+    the total number of items.
+*/
 template <size_t requiredFlagBitsPerItem>
 class FlagCache
 {
@@ -37,9 +45,10 @@ public:
     FlagCache() = default;
 
     explicit FlagCache (size_t items)
-        : flags (divCeil (items, groupsPerWord))
+        : flags (divCeil (items, groupsPerWord)),
+          summary (divCeil (flags.size(), bitsPerWord))
     {
-        std::fill (flags.begin(), flags.end(), 0);
+        clear();
     }
 
     void set (size_t index, FlagType bits)
@@ -48,6 +57,11 @@ public:
         jassert (flagIndex < flags.size());
         const auto groupIndex = index - (flagIndex * groupsPerWord);
         flags[flagIndex].fetch_or (moveToGroupPosition (bits, groupIndex), std::memory_order_acq_rel);
+
+        // The summary bit must be set after the flags, so that a reader which sees
+        // the summary bit is guaranteed to also see the flags it refers to
+        const auto summaryIndex = flagIndex / bitsPerWord;
+        summary[summaryIndex].fetch_or ((FlagType) 1 << (flagIndex - (summaryIndex * bitsPerWord)), std::memory_order_acq_rel);
     }
 
     /*  Calls the supplied callback for any entries with non-zero flags, and
@@ -56,16 +70,21 @@ public:
     template <typename Callback>
     void ifSet (Callback&& callback)
     {
-        for (size_t flagIndex = 0; flagIndex < flags.size(); ++flagIndex)
+        for (size_t summaryIndex = 0; summaryIndex < summary.size(); ++summaryIndex)
         {
-            const auto prevFlags = flags[flagIndex].exchange (0, std::memory_order_acq_rel);
-
-            for (size_t group = 0; group < groupsPerWord; ++group)
+            for (auto changedWords = summary[summaryIndex].exchange (0, std::memory_order_acq_rel);
+                 changedWords != 0;
+                 changedWords &= changedWords - 1)
             {
-                const auto masked = moveFromGroupPosition (prevFlags, group);
-
-                if (masked != 0)
-                    callback ((flagIndex * groupsPerWord) + group, masked);
+                const auto flagIndex = (summaryIndex * bitsPerWord) + (size_t) findLowestSetBit (changedWords);
+                const auto prevFlags = flags[flagIndex].exchange (0, std::memory_order_acq_rel);
+
+                for (auto remaining = prevFlags; remaining != 0;)
+                {
+                    const auto group = (size_t) findLowestSetBit (remaining) / bitsPerFlagGroup;
+                    callback ((flagIndex * groupsPerWord) + group, moveFromGroupPosition (prevFlags, group));
+                    remaining &= ~moveToGroupPosition (groupMask, group);
+                }
             }
         }
     }
@@ -73,6 +92,7 @@ public:
     void clear()
     {
         std::fill (flags.begin(), flags.end(), 0);
+        std::fill (summary.begin(), summary.end(), 0);
     }
 
 private:
@@ -103,6 +123,11 @@ private:
         return (grouped >> (groupIndex * bitsPerFlagGroup)) & groupMask;
     }
 
+    static constexpr int findLowestSetBit (FlagType value)
+    {
+        return countNumberOfBits ((uint32) (value ^ (value - 1))) - 1;
+    }
+
     static constexpr size_t findNextPowerOfTwoImpl (size_t n, size_t shift)
     {
         return shift == 32 ? n : findNextPowerOfTwoImpl (n | (n >> shift), shift * 2);
@@ -119,10 +144,12 @@ private:
     }
 
     static constexpr size_t bitsPerFlagGroup = findNextPowerOfTwo (requiredFlagBitsPerItem);
-    static constexpr size_t groupsPerWord = (8 * sizeof (FlagType)) / bitsPerFlagGroup;
+    static constexpr size_t bitsPerWord = 8 * sizeof (FlagType);
+    static constexpr size_t groupsPerWord = bitsPerWord / bitsPerFlagGroup;
     static constexpr FlagType groupMask = ((FlagType) 1 << requiredFlagBitsPerItem) - 1;
 
     std::vector<std::atomic<FlagType>> flags;
+    std::vector<std::atomic<FlagType>> summary;
 };
 
 template <size_t requiredFlagBitsPerItem>
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class FlagCacheTests final : public UnitTest
+{
+public:
+    FlagCacheTests()
+        : UnitTest ("FlagCache", UnitTestCategories::audioProcessorParameters)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("ifSet does nothing when no flags are set");
+        {
+            FlagCache<1> cache (5000);
+            expect (collect (cache).empty());
+        }
+
+        beginTest ("ifSet reports each set item once, in index order");
+        {
+            FlagCache<1> cache (5000);
+            const std::vector<size_t> indices { 0, 31, 32, 1023, 1024, 1025, 4999 };
+
+            for (auto it = indices.rbegin(); it != indices.rend(); ++it)
+                cache.set (*it, 1);
+
+            cache.set (1024, 1);
+
+            std::vector<size_t> expected;
+
+            for (const auto index : indices)
+                expected.push_back (index);
+
+            expect (collect (cache) == expected);
+            expect (collect (cache).empty());
+        }
+
+        beginTest ("Bits for neighbouring items are kept apart");
+        {
+            FlagCache<2> cache (100);
+            cache.set (15, 2);
+            cache.set (16, 1);
+            cache.set (16, 2);
+            cache.set (99, 1);
+
+            std::vector<std::pair<size_t, uint32_t>> results;
+            cache.ifSet ([&] (size_t index, uint32_t bits) { results.emplace_back (index, bits); });
+
+            expect (results == std::vector<std::pair<size_t, uint32_t>> { { 15, 2 }, { 16, 3 }, { 99, 1 } });
+        }
+
+        beginTest ("clear removes all set flags");
+        {
+            FlagCache<1> cache (300);
+            cache.set (7, 1);
+            cache.set (299, 1);
+            cache.clear();
+            expect (collect (cache).empty());
+        }
+
+        beginTest ("Flags set concurrently with ifSet are never lost");
+        {
+            constexpr size_t numItems = 4096;
+            FlagCache<1> cache (numItems);
+            std::vector<int> seen (numItems, 0);
+            std::atomic<bool> done { false };
+
+            std::thread writer ([&]
+            {
+                for (size_t i = 0; i < numItems; ++i)
+                    cache.set ((i * 97) % numItems, 1);
+
+                done = true;
+            });
+
+            const auto read = [&] { cache.ifSet ([&] (size_t index, uint32_t) { ++seen[index]; }); };
+
+            while (! done)
+                read();
+
+            writer.join();
+            read();
+
+            expect (std::all_of (seen.begin(), seen.end(), [] (int count) { return count == 1; }));
+        }
+    }
+
+private:
+    template <size_t bits>
+    static std::vector<size_t> collect (FlagCache<bits>& cache)
+    {
+        std::vector<size_t> result;
+        cache.ifSet ([&] (size_t index, uint32_t) { result.push_back (index); });
+        return result;
+    }
+};
+
+static FlagCacheTests flagCacheTests;
+
+} // namespace juce
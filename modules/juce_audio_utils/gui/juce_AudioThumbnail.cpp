@@ -159,7 +159,10 @@ public:
 
     ~LevelDataSource() override
     {
-        owner.cache.getTimeSliceThread().removeTimeSliceClient (this);
+        setHighPriority (false);
+
+        if (thread != nullptr)
+            thread->removeTimeSliceClient (this);
     }
 
     enum { timeBeforeDeletingReader = 3000 };
@@ -181,8 +184,23 @@ public:
             if (lengthInSamples <= 0 || isFullyLoaded())
                 reader.reset();
             else
-                owner.cache.getTimeSliceThread().addTimeSliceClient (this);
+                addToThread();
+        }
+    }
+
+    void setHighPriority (bool shouldBeHighPriority)
+    {
+        const ScopedLock sl (readerLock);
+        shouldBeHighPriority = shouldBeHighPriority && ! isFullyLoaded();
+
+        if (isHighPriority != shouldBeHighPriority)
+        {
+            isHighPriority = shouldBeHighPriority;
+            owner.cache.numHighPriorityScans += isHighPriority ? 1 : -1;
         }
+
+        if (isHighPriority && thread != nullptr)
+            thread->moveToFrontOfQueue (this);
     }
 
     void getLevels (int64 startSample, int numSamples, Array<Range<float>>& levels)
@@ -196,7 +214,7 @@ public:
             if (reader != nullptr)
             {
                 lastReaderUseTime = Time::getMillisecondCounter();
-                owner.cache.getTimeSliceThread().addTimeSliceClient (this);
+                addToThread();
             }
         }
 
@@ -232,6 +250,10 @@ public:
             return -1;
         }
 
+        // Let any high-priority thumbnails that share the cache finish first
+        if (! isHighPriority && owner.cache.numHighPriorityScans > 0)
+            return 50;
+
         bool justFinished = false;
 
         {
@@ -248,7 +270,10 @@ public:
         }
 
         if (justFinished)
+        {
+            setHighPriority (false);
             owner.cache.storeThumb (owner, hashCode);
+        }
 
         return 200;
     }
@@ -274,6 +299,18 @@ private:
     std::unique_ptr<AudioFormatReader> reader;
     CriticalSection readerLock;
     std::atomic<uint32> lastReaderUseTime { 0 };
+    TimeSliceThread* thread = nullptr;
+    std::atomic<bool> isHighPriority { false };
+
+    void addToThread()
+    {
+        // Each source stays on the same thread while it's a client, but picks the least
+        // busy of the cache's threads whenever it has to be added again
+        if (thread == nullptr || ! thread->contains (this))
+            thread = &owner.cache.getLeastBusyThread();
+
+        thread->addTimeSliceClient (this);
+    }
 
     void createReader()
     {
@@ -360,12 +397,10 @@ public:
 
             while (startSample <= endSample)
             {
-                auto& v = data.getReference (startSample);
+                auto& v = getWidestValueAt (startSample, endSample);
 
                 if (v.getMinValue() < mn)  mn = v.getMinValue();
                 if (v.getMaxValue() > mx)  mx = v.getMaxValue();
-
-                ++startSample;
             }
 
             if (mn <= mx)
@@ -389,6 +424,15 @@ public:
 
         for (int i = 0; i < numValues; ++i)
             dest[i] = values[i];
+
+        updateSummaries (startIndex, startIndex + numValues);
+    }
+
+    /** Rebuilds the summary levels after the data has been modified via getData(). */
+    void refreshSummaries()
+    {
+        resetPeak();
+        updateSummaries (0, data.size());
     }
 
     void resetPeak() noexcept
@@ -413,7 +457,12 @@ public:
     }
 
 private:
+    // Each summary level holds the combined range of summaryFactor values from the level
+    // below, so a zoomed-out view of a long file only has to look at a few values per pixel.
+    static constexpr int summaryFactor = 16;
+
     Array<MinMaxValue> data;
+    Array<Array<MinMaxValue>> summaries;
     int peakLevel = -1;
 
     void ensureSize (int thumbSamples)
@@ -423,6 +472,70 @@ private:
         if (extraNeeded > 0)
             data.insertMultiple (-1, MinMaxValue(), extraNeeded);
     }
+
+    static MinMaxValue combine (const MinMaxValue* values, int numValues) noexcept
+    {
+        int8 mn = values[0].getMinValue();
+        int8 mx = values[0].getMaxValue();
+
+        for (int i = 1; i < numValues; ++i)
+        {
+            mn = jmin (mn, values[i].getMinValue());
+            mx = jmax (mx, values[i].getMaxValue());
+        }
+
+        MinMaxValue result;
+        result.set (mn, mx);
+        return result;
+    }
+
+    void updateSummaries (int startIndex, int endIndex)
+    {
+        const auto* level = &data;
+
+        for (int i = 0; level->size() > summaryFactor; ++i)
+        {
+            if (i == summaries.size())
+                summaries.add ({});
+
+            auto& summary = summaries.getReference (i);
+            auto requiredSize = (level->size() + summaryFactor - 1) / summaryFactor;
+
+            if (summary.size() < requiredSize)
+                summary.insertMultiple (-1, MinMaxValue(), requiredSize - summary.size());
+
+            startIndex /= summaryFactor;
+            endIndex = (endIndex + summaryFactor - 1) / summaryFactor;
+
+            for (int j = startIndex; j < endIndex; ++j)
+            {
+                auto first = j * summaryFactor;
+                summary.getReference (j) = combine (level->begin() + first, jmin (summaryFactor, level->size() - first));
+            }
+
+            level = &summary;
+        }
+    }
+
+    // Returns the value from the coarsest level that starts at index without extending
+    // beyond lastIndex, and moves index on past the samples that it covers.
+    const MinMaxValue& getWidestValueAt (int& index, int lastIndex) const noexcept
+    {
+        int level = 0, span = 1;
+
+        while (level < summaries.size()
+                && index % (span * summaryFactor) == 0
+                && index + span * summaryFactor - 1 <= lastIndex)
+        {
+            span *= summaryFactor;
+            ++level;
+        }
+
+        auto& result = level == 0 ? data.getReference (index)
+                                  : summaries.getReference (level - 1).getReference (index / span);
+        index += span;
+        return result;
+    }
 };
 
 //==============================================================================
@@ -501,11 +614,25 @@ private:
 
         if (numSamples == numSamplesCached
              && numChannelsCached == numChans
-             && approximatelyEqual (startTime, cachedStart)
              && approximatelyEqual (timePerPixel, cachedTimePerPixel)
              && ! cacheNeedsRefilling)
         {
-            return ! cacheNeedsRefilling;
+            if (approximatelyEqual (startTime, cachedStart))
+                return true;
+
+            // When the view scrolls by less than its width, the columns that are still visible
+            // are kept and only the newly exposed ones are calculated. The start is kept on the
+            // same grid of columns, so the waveform may be drawn up to half a pixel from its
+            // exact position.
+            const auto pixelShift = roundToInt ((startTime - cachedStart) / timePerPixel);
+
+            if (std::abs (pixelShift) < numSamples)
+            {
+                if (pixelShift != 0)
+                    scrollCache (pixelShift, rate, sampsPerThumbSample, levelData, chans);
+
+                return true;
+            }
         }
 
         numSamplesCached = numSamples;
@@ -515,69 +642,90 @@ private:
         cacheNeedsRefilling = false;
 
         ensureSize (numSamples);
+        fillColumns (0, numSamples, rate, sampsPerThumbSample, levelData, chans);
+
+        return true;
+    }
+
+    void scrollCache (int pixelShift, double rate, int sampsPerThumbSample,
+                      LevelDataSource* levelData, const OwnedArray<ThumbData>& chans)
+    {
+        const auto numToKeep = numSamplesCached - std::abs (pixelShift);
+
+        for (int chan = 0; chan < numChannelsCached; ++chan)
+        {
+            auto* row = getData (chan, 0);
+
+            if (pixelShift > 0)
+                std::copy (row + pixelShift, row + numSamplesCached, row);
+            else
+                std::copy_backward (row, row + numToKeep, row + numSamplesCached);
+        }
+
+        cachedStart += pixelShift * cachedTimePerPixel;
+
+        if (pixelShift > 0)
+            fillColumns (numToKeep, numSamplesCached, rate, sampsPerThumbSample, levelData, chans);
+        else
+            fillColumns (0, -pixelShift, rate, sampsPerThumbSample, levelData, chans);
+    }
+
+    void fillColumns (int startColumn, int endColumn, double rate, int sampsPerThumbSample,
+                      LevelDataSource* levelData, const OwnedArray<ThumbData>& chans)
+    {
+        // Each column's time is calculated from the start rather than accumulated, so that
+        // columns filled after scrolling line up with the ones that were already there
+        const auto getColumnTime = [this] (int column) { return cachedStart + column * cachedTimePerPixel; };
 
-        if (timePerPixel * rate <= sampsPerThumbSample && levelData != nullptr)
+        if (cachedTimePerPixel * rate <= sampsPerThumbSample && levelData != nullptr)
         {
-            auto sample = roundToInt (startTime * rate);
             Array<Range<float>> levels;
 
-            int i;
-            for (i = 0; i < numSamples; ++i)
+            for (int i = startColumn; i < endColumn; ++i)
             {
-                auto nextSample = roundToInt ((startTime + timePerPixel) * rate);
+                auto sample = roundToInt (getColumnTime (i) * rate);
+                auto nextSample = roundToInt (getColumnTime (i + 1) * rate);
 
-                if (sample >= 0)
+                if (sample < 0 || sample >= levelData->lengthInSamples)
                 {
-                    if (sample >= levelData->lengthInSamples)
-                    {
-                        for (int chan = 0; chan < numChannelsCached; ++chan)
-                            *getData (chan, i) = MinMaxValue();
-                    }
-                    else
-                    {
-                        levelData->getLevels (sample, jmax (1, nextSample - sample), levels);
+                    for (int chan = 0; chan < numChannelsCached; ++chan)
+                        *getData (chan, i) = MinMaxValue();
+                }
+                else
+                {
+                    levelData->getLevels (sample, jmax (1, nextSample - sample), levels);
 
-                        auto totalChans = jmin (levels.size(), numChannelsCached);
+                    auto totalChans = jmin (levels.size(), numChannelsCached);
 
-                        for (int chan = 0; chan < totalChans; ++chan)
-                            getData (chan, i)->setFloat (levels.getReference (chan));
-                    }
+                    for (int chan = 0; chan < totalChans; ++chan)
+                        getData (chan, i)->setFloat (levels.getReference (chan));
                 }
-
-                startTime += timePerPixel;
-                sample = nextSample;
             }
-
-            numSamplesCached = i;
         }
         else
         {
             jassert (chans.size() == numChannelsCached);
 
+            auto timeToThumbSampleFactor = rate / (double) sampsPerThumbSample;
+
             for (int channelNum = 0; channelNum < numChannelsCached; ++channelNum)
             {
                 ThumbData* channelData = chans.getUnchecked (channelNum);
-                MinMaxValue* cacheData = getData (channelNum, 0);
-
-                auto timeToThumbSampleFactor = rate / (double) sampsPerThumbSample;
+                MinMaxValue* cacheData = getData (channelNum, startColumn);
 
-                startTime = cachedStart;
-                auto sample = roundToInt (startTime * timeToThumbSampleFactor);
+                auto sample = roundToInt (getColumnTime (startColumn) * timeToThumbSampleFactor);
 
-                for (int i = numSamples; --i >= 0;)
+                for (int i = startColumn; i < endColumn; ++i)
                 {
-                    auto nextSample = roundToInt ((startTime + timePerPixel) * timeToThumbSampleFactor);
+                    auto nextSample = roundToInt (getColumnTime (i + 1) * timeToThumbSampleFactor);
 
                     channelData->getMinMax (sample, nextSample, *cacheData);
 
                     ++cacheData;
-                    startTime += timePerPixel;
                     sample = nextSample;
                 }
             }
         }
-
-        return true;
     }
 
     MinMaxValue* getData (const int channelNum, const int cacheIndex) noexcept
@@ -674,6 +822,9 @@ bool AudioThumbnail::loadFrom (InputStream& rawInput)
         for (int chan = 0; chan < numChannels; ++chan)
             channels.getUnchecked (chan)->getData (i)->read (input);
 
+    for (auto* c : channels)
+        c->refreshSummaries();
+
     return true;
 }
 
@@ -728,6 +879,7 @@ bool AudioThumbnail::setDataSource (LevelDataSource* newSource)
     numChannels = (int32) source->numChannels;
 
     createChannels (1 + (int) (totalSamples / samplesPerThumbSample));
+    source->setHighPriority (highPriority);
 
     return wasSuccessful();
 }
@@ -762,6 +914,14 @@ int64 AudioThumbnail::getHashCode() const
     return source == nullptr ? 0 : source->hashCode;
 }
 
+void AudioThumbnail::setHighPriority (bool shouldBeHighPriority)
+{
+    highPriority = shouldBeHighPriority;
+
+    if (source != nullptr)
+        source->setHighPriority (shouldBeHighPriority);
+}
+
 void AudioThumbnail::addBlock (int64 startSample, const AudioBuffer<float>& incoming,
                                int startOffsetInBuffer, int numSamples)
 {
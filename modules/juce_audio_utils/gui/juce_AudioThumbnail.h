@@ -202,6 +202,19 @@ public:
     /** Returns the hash code that was set by setSource() or setReader(). */
     int64 getHashCode() const override;
 
+    //==============================================================================
+    /** Sets whether this thumbnail should be generated ahead of the others that share
+        its AudioThumbnailCache.
+
+        While any high-priority thumbnail is still being generated, the cache's threads
+        will hold off scanning the low-priority ones. A typical use is to make the
+        thumbnails that are currently on screen high-priority.
+    */
+    void setHighPriority (bool shouldBeHighPriority);
+
+    /** Returns true if setHighPriority() has been used to make this thumbnail high-priority. */
+    bool isHighPriority() const noexcept            { return highPriority; }
+
 private:
     //==============================================================================
     AudioFormatManager& formatManagerToUse;
@@ -221,6 +234,7 @@ private:
     int64 numSamplesFinished = 0;
     int32 numChannels = 0;
     double sampleRate = 0;
+    bool highPriority = false;
     CriticalSection lock;
 
     void clearChannelData();
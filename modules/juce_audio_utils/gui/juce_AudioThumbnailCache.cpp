@@ -59,18 +59,31 @@ private:
 };
 
 //==============================================================================
-AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs)
-    : thread ("thumb cache"),
-      maxNumThumbsToStore (maxNumThumbs)
+AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs, const int numThreads)
+    : maxNumThumbsToStore (maxNumThumbs)
 {
     jassert (maxNumThumbsToStore > 0);
-    thread.startThread (Thread::Priority::low);
+    jassert (numThreads > 0);
+
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+        threads.add (new TimeSliceThread ("thumb cache"))->startThread (Thread::Priority::low);
 }
 
 AudioThumbnailCache::~AudioThumbnailCache()
 {
 }
 
+TimeSliceThread& AudioThumbnailCache::getLeastBusyThread()
+{
+    auto* best = threads.getUnchecked (0);
+
+    for (auto* t : threads)
+        if (t->getNumClients() < best->getNumClients())
+            best = t;
+
+    return *best;
+}
+
 AudioThumbnailCache::ThumbnailCacheEntry* AudioThumbnailCache::findThumbFor (const int64 hash) const
 {
     for (int i = thumbs.size(); --i >= 0;)
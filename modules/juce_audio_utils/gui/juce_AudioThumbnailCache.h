@@ -46,8 +46,12 @@ public:
 
         The maxNumThumbsToStore parameter lets you specify how many previews should
         be kept in memory at once.
+
+        The numThreads parameter sets how many background threads are used to generate
+        thumbnails. With more than one, several files can be scanned at the same time,
+        which helps when a large number of files are opened at once.
     */
-    explicit AudioThumbnailCache (int maxNumThumbsToStore);
+    explicit AudioThumbnailCache (int maxNumThumbsToStore, int numThreads = 1);
 
     /** Destructor. */
     virtual ~AudioThumbnailCache();
@@ -86,8 +90,18 @@ public:
     */
     void writeToStream (OutputStream& stream);
 
-    /** Returns the thread that client thumbnails can use. */
-    TimeSliceThread& getTimeSliceThread() noexcept      { return thread; }
+    /** Returns the thread that client thumbnails can use.
+        If the cache has more than one thread, this returns the first one.
+    */
+    TimeSliceThread& getTimeSliceThread() noexcept      { return *threads.getUnchecked (0); }
+
+    /** Returns the number of background threads that this cache was created with. */
+    int getNumThreads() const noexcept                  { return threads.size(); }
+
+    /** Returns whichever of the cache's threads currently has the fewest clients.
+        AudioThumbnail uses this to spread the files that it's scanning across the threads.
+    */
+    TimeSliceThread& getLeastBusyThread();
 
 protected:
     /** This can be overridden to provide a custom callback for saving thumbnails
@@ -102,13 +116,17 @@ protected:
 
 private:
     //==============================================================================
-    TimeSliceThread thread;
+    OwnedArray<TimeSliceThread> threads;
 
     class ThumbnailCacheEntry;
     OwnedArray<ThumbnailCacheEntry> thumbs;
     CriticalSection lock;
     int maxNumThumbsToStore;
 
+    // The number of high-priority thumbnails that are still being generated
+    std::atomic<int> numHighPriorityScans { 0 };
+    friend class AudioThumbnail;
+
     ThumbnailCacheEntry* findThumbFor (int64 hash) const;
     int findOldestThumb() const;
 
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+static const char* const thumbnailFileSuffix = ".jatm";
+
+AudioThumbnailDiskCache::AudioThumbnailDiskCache (const File& dir, int maxNumThumbs, int numThreads)
+    : AudioThumbnailCache (maxNumThumbs, numThreads),
+      directory (dir)
+{
+    directory.createDirectory();
+}
+
+File AudioThumbnailDiskCache::getFileForHash (int64 hashCode) const
+{
+    return directory.getChildFile (String::toHexString (hashCode) + thumbnailFileSuffix);
+}
+
+void AudioThumbnailDiskCache::deleteStoredThumbs()
+{
+    for (const auto& entry : RangedDirectoryIterator (directory, false, String ("*") + thumbnailFileSuffix))
+        entry.getFile().deleteFile();
+}
+
+void AudioThumbnailDiskCache::saveNewlyFinishedThumbnail (const AudioThumbnailBase& thumb, int64 hashCode)
+{
+    if (! thumb.isFullyLoaded())
+        return;
+
+    const auto file = getFileForHash (hashCode);
+    TemporaryFile temp (file);
+
+    {
+        FileOutputStream out (temp.getFile());
+
+        if (! out.openedOk())
+            return;
+
+        thumb.saveTo (out);
+        out.flush();
+
+        if (out.getStatus().failed())
+            return;
+    }
+
+    temp.overwriteTargetFileWithTemporary();
+}
+
+bool AudioThumbnailDiskCache::loadNewThumb (AudioThumbnailBase& thumb, int64 hashCode)
+{
+    const MemoryMappedFile mappedFile (getFileForHash (hashCode), MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() == nullptr || mappedFile.getSize() == 0)
+        return false;
+
+    MemoryInputStream in (mappedFile.getData(), mappedFile.getSize(), false);
+    return thumb.loadFrom (in);
+}
+
+} // namespace juce
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AudioThumbnailCache that also keeps a copy of each finished thumbnail in a
+    directory on disk.
+
+    When a thumbnail isn't in memory, the cache looks for a file in the directory
+    whose name is made from the thumbnail's hash code, and maps it into memory to load
+    it, so re-opening a project doesn't need to rescan any of its audio files.
+
+    Files are written to a temporary file and then moved into place, so several
+    processes can safely share the same directory.
+
+    @see AudioThumbnailCache, AudioThumbnail
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioThumbnailDiskCache  : public AudioThumbnailCache
+{
+public:
+    //==============================================================================
+    /** Creates a cache that stores its thumbnails in the given directory.
+
+        The directory will be created if it doesn't already exist. The maxNumThumbsToStore
+        and numThreads parameters are passed on to the AudioThumbnailCache constructor.
+    */
+    AudioThumbnailDiskCache (const File& directory, int maxNumThumbsToStore, int numThreads = 1);
+
+    //==============================================================================
+    /** Returns the directory that the thumbnails are stored in. */
+    const File& getDirectory() const noexcept       { return directory; }
+
+    /** Returns the file that's used to store the thumbnail with the given hash code. */
+    File getFileForHash (int64 hashCode) const;
+
+    /** Deletes all of the thumbnail files in the directory. */
+    void deleteStoredThumbs();
+
+protected:
+    /** Writes the thumbnail to its file, if it has finished loading. */
+    void saveNewlyFinishedThumbnail (const AudioThumbnailBase&, int64 hashCode) override;
+
+    /** Maps the thumbnail's file into memory, if there is one, and loads it. */
+    bool loadNewThumb (AudioThumbnailBase&, int64 hashCode) override;
+
+private:
+    //==============================================================================
+    File directory;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThumbnailDiskCache)
+};
+
+} // namespace juce
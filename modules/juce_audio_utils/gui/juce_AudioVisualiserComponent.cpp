@@ -34,11 +34,11 @@ struct AudioVisualiserComponent::ChannelInfo
         clear();
     }
 
+    // Called on the message thread
     void clear() noexcept
     {
         levels.fill ({});
-        value = {};
-        subSample = 0;
+        pendingLevels.finishedRead (pendingLevels.prepareToRead (pendingLevels.getCapacity()).size());
     }
 
     void pushSamples (const float* inputSamples, int num) noexcept
@@ -47,14 +47,13 @@ struct AudioVisualiserComponent::ChannelInfo
             pushSample (inputSamples[i]);
     }
 
+    // Called on the audio thread. Each finished block is handed over to the message
+    // thread through the ring, and if the ring is full the block is dropped.
     void pushSample (float newSample) noexcept
     {
         if (--subSample <= 0)
         {
-            if (++nextSample == levels.size())
-                nextSample = 0;
-
-            levels.getReference (nextSample) = value;
+            pendingLevels.push (value);
             subSample = owner.getSamplesPerBlock();
             value = Range<float> (newSample, newSample);
         }
@@ -64,6 +63,26 @@ struct AudioVisualiserComponent::ChannelInfo
         }
     }
 
+    // Called on the message thread. Returns true if any new blocks arrived.
+    bool updateLevels() noexcept
+    {
+        auto newLevels = pendingLevels.prepareToRead (pendingLevels.getCapacity());
+
+        if (! levels.isEmpty())
+        {
+            newLevels.forEach ([this] (const Range<float>& level)
+            {
+                if (++nextSample == levels.size())
+                    nextSample = 0;
+
+                levels.getReference (nextSample) = level;
+            });
+        }
+
+        pendingLevels.finishedRead (newLevels.size());
+        return newLevels.size() > 0;
+    }
+
     void setBufferSize (int newSize)
     {
         levels.removeRange (newSize, levels.size());
@@ -74,9 +93,16 @@ struct AudioVisualiserComponent::ChannelInfo
     }
 
     AudioVisualiserComponent& owner;
-    Array<Range<float>> levels;
+
+    // Only used by the audio thread
     Range<float> value;
-    std::atomic<int> nextSample { 0 }, subSample { 0 };
+    int subSample = 0;
+
+    SpscRingBuffer<Range<float>> pendingLevels { 8192 };
+
+    // Only used by the message thread
+    Array<Range<float>> levels;
+    int nextSample = 0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelInfo)
 };
@@ -163,7 +189,13 @@ void AudioVisualiserComponent::setRepaintRate (int frequencyInHz)
 
 void AudioVisualiserComponent::timerCallback()
 {
-    repaint();
+    bool anyNewLevels = false;
+
+    for (auto* c : channels)
+        anyNewLevels = c->updateLevels() || anyNewLevels;
+
+    if (anyNewLevels)
+        repaint();
 }
 
 void AudioVisualiserComponent::setColours (Colour bk, Colour fg) noexcept
@@ -34,6 +34,11 @@ namespace juce
     one of these, set its size and oversampling rate, and then feed it with incoming
     data by calling one of its pushBuffer() or pushSample() methods.
 
+    The push methods can be called from a single audio thread while the component is
+    being painted. They take no locks and don't allocate: each channel's data is reduced
+    to min/max blocks which are handed to the message thread through a lock-free ring,
+    and the component only repaints when new blocks have arrived.
+
     You can override its paint method for more customised views, but it's only designed
     as a quick-and-dirty class for simple tasks, so please don't send us feature requests
     for fancy additional features that you'd like it to support! If you're building a
@@ -68,7 +73,9 @@ public:
     /** */
     int getSamplesPerBlock() const noexcept                         { return inputSamplesPerBlock; }
 
-    /** Clears the contents of the buffers. */
+    /** Clears the contents of the buffers.
+        This must be called on the message thread.
+    */
     void clear();
 
     /** Pushes a buffer of channels data.
@@ -122,7 +129,8 @@ private:
     struct ChannelInfo;
 
     OwnedArray<ChannelInfo> channels;
-    int numSamples, inputSamplesPerBlock;
+    int numSamples;
+    std::atomic<int> inputSamplesPerBlock;
     Colour backgroundColour, waveformColour;
 
     void timerCallback() override;
@@ -74,7 +74,7 @@ void MidiKeyboardComponent::setMidiChannel (int midiChannelNumber)
 void MidiKeyboardComponent::setMidiChannelsToDisplay (int midiChannelMask)
 {
     midiInChannelMask = midiChannelMask;
-    noPendingUpdates.store (false);
+    markAllNotesForUpdate();
 }
 
 //==============================================================================
@@ -236,21 +236,35 @@ void MidiKeyboardComponent::mouseExit (const MouseEvent& e)
 
 void MidiKeyboardComponent::timerCallback()
 {
-    if (noPendingUpdates.exchange (true))
-        return;
-
-    for (auto i = getRangeStart(); i <= getRangeEnd(); ++i)
+    // Only the keys whose notes have changed need to be checked and repainted
+    for (int word = 0; word < 2; ++word)
     {
-        const auto isOn = state.isNoteOnForChannels (midiInChannelMask, i);
-
-        if (keysCurrentlyDrawnDown[i] != isOn)
+        for (auto bits = notesToUpdate[word].exchange (0); bits != 0; bits &= bits - 1)
         {
-            keysCurrentlyDrawnDown.setBit (i, isOn);
-            repaintNote (i);
+            const auto note = word * 64 + countNumberOfBits (bits ^ (bits - 1)) - 1;
+            const auto isOn = state.isNoteOnForChannels (midiInChannelMask, note);
+
+            if (keysCurrentlyDrawnDown[note] != isOn)
+            {
+                keysCurrentlyDrawnDown.setBit (note, isOn);
+                repaintNote (note);
+            }
         }
     }
 }
 
+void MidiKeyboardComponent::markNoteForUpdate (int midiNoteNumber) noexcept
+{
+    if (isPositiveAndBelow (midiNoteNumber, 128))
+        notesToUpdate[midiNoteNumber / 64].fetch_or ((uint64) 1 << (midiNoteNumber % 64));
+}
+
+void MidiKeyboardComponent::markAllNotesForUpdate() noexcept
+{
+    for (auto& bits : notesToUpdate)
+        bits.store (~(uint64) 0);
+}
+
 bool MidiKeyboardComponent::keyStateChanged (bool /*isKeyDown*/)
 {
     bool keyPressUsed = false;
@@ -468,14 +482,14 @@ void MidiKeyboardComponent::drawBlackKey (int midiNoteNumber, Graphics& g, Recta
 }
 
 //==============================================================================
-void MidiKeyboardComponent::handleNoteOn (MidiKeyboardState*, int /*midiChannel*/, int /*midiNoteNumber*/, float /*velocity*/)
+void MidiKeyboardComponent::handleNoteOn (MidiKeyboardState*, int /*midiChannel*/, int midiNoteNumber, float /*velocity*/)
 {
-    noPendingUpdates.store (false);
+    markNoteForUpdate (midiNoteNumber);
 }
 
-void MidiKeyboardComponent::handleNoteOff (MidiKeyboardState*, int /*midiChannel*/, int /*midiNoteNumber*/, float /*velocity*/)
+void MidiKeyboardComponent::handleNoteOff (MidiKeyboardState*, int /*midiChannel*/, int midiNoteNumber, float /*velocity*/)
 {
-    noPendingUpdates.store (false);
+    markNoteForUpdate (midiNoteNumber);
 }
 
 //==============================================================================
@@ -270,7 +270,11 @@ private:
     Array<int> keyPressNotes;
     BigInteger keysPressed, keysCurrentlyDrawnDown;
 
-    std::atomic<bool> noPendingUpdates { true };
+    // One bit for each note whose state has changed since the keys were last repainted
+    std::atomic<uint64> notesToUpdate[2] { 0, 0 };
+
+    void markNoteForUpdate (int midiNoteNumber) noexcept;
+    void markAllNotesForUpdate() noexcept;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiKeyboardComponent)
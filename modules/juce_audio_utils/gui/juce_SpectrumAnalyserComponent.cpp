@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+SpectrumAnalyserComponent::SpectrumAnalyserComponent (int fftOrder)
+    : fft (fftOrder),
+      fftSize (1 << fftOrder),
+      hopSize (jmax (1, fftSize / 4)),
+      feed (jmax (4 * fftSize, 32768)),
+      window ((size_t) fftSize),
+      input ((size_t) ((maxFramesPerBatch + 1) * fftSize)),
+      frames ((size_t) (maxFramesPerBatch * 2 * fftSize)),
+      levels ((size_t) (fftSize / 2 + 1))
+{
+    dsp::WindowingFunction<float>::fillWindowingTables (window.data(), window.size(),
+                                                        dsp::WindowingFunction<float>::hann, true);
+    std::fill (levels.begin(), levels.end(), minDecibels);
+
+    setOpaque (true);
+    setRepaintRate (30);
+}
+
+SpectrumAnalyserComponent::~SpectrumAnalyserComponent()
+{
+}
+
+//==============================================================================
+void SpectrumAnalyserComponent::setSampleRate (double newSampleRate)
+{
+    jassert (newSampleRate > 0);
+    sampleRate = newSampleRate;
+    repaint();
+}
+
+void SpectrumAnalyserComponent::setFrequencyRange (float minimumFrequencyHz, float maximumFrequencyHz)
+{
+    jassert (minimumFrequencyHz > 0 && maximumFrequencyHz > minimumFrequencyHz);
+    minFrequency = minimumFrequencyHz;
+    maxFrequency = maximumFrequencyHz;
+    repaint();
+}
+
+void SpectrumAnalyserComponent::setDecibelRange (float minimumDecibels, float maximumDecibels)
+{
+    jassert (maximumDecibels > minimumDecibels);
+    minDecibels = minimumDecibels;
+    maxDecibels = maximumDecibels;
+
+    for (auto& level : levels)
+        level = jmax (level, minDecibels);
+
+    repaint();
+}
+
+void SpectrumAnalyserComponent::setOverlap (int framesPerFFTSize)
+{
+    hopSize = fftSize / jlimit (1, fftSize, framesPerFFTSize);
+}
+
+void SpectrumAnalyserComponent::setDecayRate (float decibelsPerSecond) noexcept
+{
+    jassert (decibelsPerSecond >= 0);
+    decayRate = decibelsPerSecond;
+}
+
+void SpectrumAnalyserComponent::setColours (Colour bk, Colour fg) noexcept
+{
+    backgroundColour = bk;
+    spectrumColour = fg;
+    repaint();
+}
+
+void SpectrumAnalyserComponent::setRepaintRate (int frequencyInHz)
+{
+    startTimerHz (frequencyInHz);
+}
+
+void SpectrumAnalyserComponent::clear()
+{
+    feed.finishedRead (feed.prepareToRead (feed.getCapacity()).size());
+    numBufferedSamples = 0;
+    std::fill (levels.begin(), levels.end(), minDecibels);
+    repaint();
+}
+
+//==============================================================================
+void SpectrumAnalyserComponent::pushSamples (const float* samples, int numSamples) noexcept
+{
+    feed.push (samples, numSamples);
+}
+
+void SpectrumAnalyserComponent::pushBuffer (const float* const* channelData, int numChannels, int numSamples) noexcept
+{
+    pushMixedDown (channelData, numChannels, 0, numSamples);
+}
+
+void SpectrumAnalyserComponent::pushBuffer (const AudioBuffer<float>& buffer) noexcept
+{
+    pushMixedDown (buffer.getArrayOfReadPointers(), buffer.getNumChannels(), 0, buffer.getNumSamples());
+}
+
+void SpectrumAnalyserComponent::pushBuffer (const AudioSourceChannelInfo& info) noexcept
+{
+    pushMixedDown (info.buffer->getArrayOfReadPointers(), info.buffer->getNumChannels(),
+                   info.startSample, info.numSamples);
+}
+
+void SpectrumAnalyserComponent::pushMixedDown (const float* const* channelData, int numChannels,
+                                               int startSample, int numSamples) noexcept
+{
+    if (numChannels <= 0)
+        return;
+
+    if (numChannels == 1)
+    {
+        pushSamples (channelData[0] + startSample, numSamples);
+        return;
+    }
+
+    float mix[256];
+    const auto gain = 1.0f / (float) numChannels;
+
+    for (int done = 0; done < numSamples;)
+    {
+        const auto num = jmin (numSamples - done, (int) numElementsInArray (mix));
+        const auto offset = startSample + done;
+
+        FloatVectorOperations::copyWithMultiply (mix, channelData[0] + offset, gain, num);
+
+        for (int i = 1; i < numChannels; ++i)
+            FloatVectorOperations::addWithMultiply (mix, channelData[i] + offset, gain, num);
+
+        if (feed.push (mix, num) < num)
+            return;
+
+        done += num;
+    }
+}
+
+//==============================================================================
+void SpectrumAnalyserComponent::timerCallback()
+{
+    const auto now = Time::getMillisecondCounterHiRes();
+    const auto fall = decayRate * (float) ((now - lastUpdateTime) * 0.001);
+    lastUpdateTime = now;
+
+    bool needsRepaint = false;
+
+    for (auto& level : levels)
+    {
+        if (level > minDecibels)
+        {
+            level = jmax (minDecibels, level - fall);
+            needsRepaint = true;
+        }
+    }
+
+    for (;;)
+    {
+        numBufferedSamples += feed.pop (input.data() + numBufferedSamples,
+                                        (int) input.size() - numBufferedSamples);
+
+        if (numBufferedSamples < fftSize)
+            break;
+
+        const auto numFrames = jmin (maxFramesPerBatch, (numBufferedSamples - fftSize) / hopSize + 1);
+        analyseFrames (numFrames);
+        needsRepaint = true;
+
+        const auto numUsed = numFrames * hopSize;
+        std::copy (input.begin() + numUsed, input.begin() + numBufferedSamples, input.begin());
+        numBufferedSamples -= numUsed;
+    }
+
+    if (needsRepaint)
+        repaint();
+}
+
+void SpectrumAnalyserComponent::analyseFrames (int numFrames)
+{
+    const auto stride = 2 * fftSize;
+
+    for (int i = 0; i < numFrames; ++i)
+        FloatVectorOperations::multiply (frames.data() + i * stride, input.data() + i * hopSize,
+                                         window.data(), fftSize);
+
+    fft.performFrequencyOnlyForwardTransformBatch (frames.data(), numFrames, stride, true);
+
+    // With a normalised window, a sine wave's magnitude is its amplitude * fftSize / 2
+    const auto scale = 2.0f / (float) fftSize;
+    const auto numBins = getNumBins();
+
+    for (int i = 0; i < numFrames; ++i)
+    {
+        const auto* magnitudes = frames.data() + i * stride;
+
+        for (int bin = 0; bin < numBins; ++bin)
+            levels[(size_t) bin] = jmax (levels[(size_t) bin],
+                                         Decibels::gainToDecibels (magnitudes[bin] * scale, minDecibels));
+    }
+}
+
+//==============================================================================
+void SpectrumAnalyserComponent::paint (Graphics& g)
+{
+    g.fillAll (backgroundColour);
+    g.setColour (spectrumColour);
+
+    paintSpectrum (g, getLocalBounds().toFloat(), levels.data(), getNumBins());
+}
+
+void SpectrumAnalyserComponent::paintSpectrum (Graphics& g, Rectangle<float> area,
+                                               const float* levelsInDecibels, int numBins)
+{
+    const auto numColumns = roundToInt (area.getWidth());
+
+    if (numColumns <= 0 || numBins <= 1)
+        return;
+
+    const auto binsPerHz = (float) ((numBins - 1) * 2 / sampleRate);
+    const auto frequencyRatio = maxFrequency / minFrequency;
+
+    auto getLevel = [&] (float bin)
+    {
+        const auto index = jlimit (0, numBins - 2, (int) bin);
+        const auto alpha = jlimit (0.0f, 1.0f, bin - (float) index);
+        return jmap (alpha, levelsInDecibels[index], levelsInDecibels[index + 1]);
+    };
+
+    Path p;
+    p.preallocateSpace (3 * numColumns + 12);
+    p.startNewSubPath (area.getBottomLeft());
+
+    auto binStart = minFrequency * binsPerHz;
+
+    for (int x = 0; x < numColumns; ++x)
+    {
+        const auto binEnd = minFrequency * std::pow (frequencyRatio, (float) (x + 1) / (float) numColumns) * binsPerHz;
+
+        // Where a column covers several bins, show the loudest one
+        auto level = getLevel (binStart);
+
+        for (auto bin = (int) binStart + 1; bin < jmin ((float) numBins, binEnd); ++bin)
+            level = jmax (level, levelsInDecibels[bin]);
+
+        const auto proportion = jlimit (0.0f, 1.0f, (level - minDecibels) / (maxDecibels - minDecibels));
+        p.lineTo (area.getX() + (float) x, area.getBottom() - proportion * area.getHeight());
+
+        binStart = binEnd;
+    }
+
+    p.lineTo (area.getBottomRight());
+    p.closeSubPath();
+
+    g.fillPath (p);
+}
+
+} // namespace juce
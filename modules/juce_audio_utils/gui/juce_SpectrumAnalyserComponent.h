@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A component that shows the magnitude spectrum of some incoming audio data.
+
+    Create one of these and then feed it with data from the audio thread by calling
+    one of its pushBuffer() or pushSamples() methods. The samples are passed to the
+    message thread through a lock-free ring, so the push methods never block and
+    never allocate. If the ring fills up because the message thread has stalled,
+    the newest samples are dropped.
+
+    On each timer callback, the component cuts all the samples that have arrived into
+    overlapping windowed frames and analyses them together with
+    dsp::FFT::performFrequencyOnlyForwardTransformBatch(). The displayed level of each
+    bin follows the loudest of these frames, and falls back at the decay rate when the
+    signal gets quieter. The component only repaints when the spectrum has changed.
+
+    This class is only available if the juce_dsp module is part of the project.
+
+    @tags{Audio}
+*/
+class JUCE_API SpectrumAnalyserComponent  : public Component,
+                                            private Timer
+{
+public:
+    /** Creates an analyser that uses an FFT of size 2^fftOrder. */
+    explicit SpectrumAnalyserComponent (int fftOrder = 11);
+
+    /** Destructor. */
+    ~SpectrumAnalyserComponent() override;
+
+    //==============================================================================
+    /** Tells the analyser the sample rate of the incoming data.
+        This is only used to map the bins to frequencies when drawing.
+    */
+    void setSampleRate (double newSampleRate);
+
+    /** Sets the range of frequencies shown, which are drawn on a logarithmic scale. */
+    void setFrequencyRange (float minimumFrequencyHz, float maximumFrequencyHz);
+
+    /** Sets the range of levels shown, in decibels relative to a full-scale sine wave. */
+    void setDecibelRange (float minimumDecibels, float maximumDecibels);
+
+    /** Sets how many frames are analysed for each FFT-sized stretch of input.
+        Higher values make the display respond faster, at the cost of more FFTs.
+        The default is 4.
+    */
+    void setOverlap (int framesPerFFTSize);
+
+    /** Sets the rate at which levels fall when the signal gets quieter. */
+    void setDecayRate (float decibelsPerSecond) noexcept;
+
+    /** Sets the colours used to paint the background and the spectrum. */
+    void setColours (Colour backgroundColour, Colour spectrumColour) noexcept;
+
+    /** Sets the frequency at which the component checks for new data and repaints itself. */
+    void setRepaintRate (int frequencyInHz);
+
+    /** Clears the displayed spectrum and any samples that are waiting to be analysed.
+        This must be called on the message thread.
+    */
+    void clear();
+
+    //==============================================================================
+    /** Pushes some mono samples.
+        Only one thread at a time may push data into the analyser.
+    */
+    void pushSamples (const float* samples, int numSamples) noexcept;
+
+    /** Pushes a buffer of channels, which are mixed down to mono before analysis.
+        Only one thread at a time may push data into the analyser.
+    */
+    void pushBuffer (const float* const* channelData, int numChannels, int numSamples) noexcept;
+
+    /** Pushes a buffer of channels, which are mixed down to mono before analysis.
+        Only one thread at a time may push data into the analyser.
+    */
+    void pushBuffer (const AudioBuffer<float>& bufferToPush) noexcept;
+
+    /** Pushes a buffer of channels, which are mixed down to mono before analysis.
+        Only one thread at a time may push data into the analyser.
+    */
+    void pushBuffer (const AudioSourceChannelInfo& bufferToPush) noexcept;
+
+    //==============================================================================
+    /** Returns the number of bins in the spectrum, which is half the FFT size plus one. */
+    int getNumBins() const noexcept                         { return (int) levels.size(); }
+
+    /** Returns the current level of each bin in decibels.
+        This must only be used on the message thread.
+    */
+    const float* getLevels() const noexcept                 { return levels.data(); }
+
+    /** Draws the spectrum in the given bounds.
+        The default implementation fills the area under a curve that follows the loudest
+        bin in each column of pixels. You may want to override this to draw things differently.
+    */
+    virtual void paintSpectrum (Graphics&, Rectangle<float> bounds,
+                                const float* levelsInDecibels, int numBins);
+
+    //==============================================================================
+    /** @internal */
+    void paint (Graphics&) override;
+
+private:
+    //==============================================================================
+    void timerCallback() override;
+    void pushMixedDown (const float* const*, int numChannels, int startSample, int numSamples) noexcept;
+    void analyseFrames (int numFrames);
+
+    dsp::FFT fft;
+    const int fftSize;
+    int hopSize;
+
+    SpscRingBuffer<float> feed;
+
+    std::vector<float> window, input, frames, levels;
+    int numBufferedSamples = 0;
+
+    double sampleRate = 44100.0, lastUpdateTime = 0.0;
+    float minFrequency = 20.0f, maxFrequency = 20000.0f;
+    float minDecibels = -100.0f, maxDecibels = 0.0f;
+    float decayRate = 60.0f;
+    Colour backgroundColour { Colours::black }, spectrumColour { Colours::white };
+
+    static constexpr int maxFramesPerBatch = 16;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyserComponent)
+};
+
+} // namespace juce
@@ -59,13 +59,20 @@
 #include "gui/juce_AudioDeviceSelectorComponent.cpp"
 #include "gui/juce_AudioThumbnail.cpp"
 #include "gui/juce_AudioThumbnailCache.cpp"
+#include "gui/juce_AudioThumbnailDiskCache.cpp"
 #include "gui/juce_AudioVisualiserComponent.cpp"
+
+#if JUCE_MODULE_AVAILABLE_juce_dsp
+ #include "gui/juce_SpectrumAnalyserComponent.cpp"
+#endif
+
 #include "gui/juce_KeyboardComponentBase.cpp"
 #include "gui/juce_MidiKeyboardComponent.cpp"
 #include "gui/juce_MPEKeyboardComponent.cpp"
 #include "gui/juce_AudioAppComponent.cpp"
 #include "players/juce_SoundPlayer.cpp"
 #include "players/juce_AudioProcessorPlayer.cpp"
+#include "players/juce_OfflineAudioRenderer.cpp"
 #include "audio_cd/juce_AudioCDReader.cpp"
 
 #if JUCE_MAC
@@ -59,6 +59,10 @@
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_audio_processors/juce_audio_processors.h>
 
+#if JUCE_MODULE_AVAILABLE_juce_dsp
+ #include <juce_dsp/juce_dsp.h>
+#endif
+
 //==============================================================================
 /** Config: JUCE_USE_CDREADER
     Enables the AudioCDReader class (on supported platforms).
@@ -79,7 +83,13 @@
 #include "gui/juce_AudioThumbnailBase.h"
 #include "gui/juce_AudioThumbnail.h"
 #include "gui/juce_AudioThumbnailCache.h"
+#include "gui/juce_AudioThumbnailDiskCache.h"
 #include "gui/juce_AudioVisualiserComponent.h"
+
+#if JUCE_MODULE_AVAILABLE_juce_dsp
+ #include "gui/juce_SpectrumAnalyserComponent.h"
+#endif
+
 #include "gui/juce_KeyboardComponentBase.h"
 #include "gui/juce_MidiKeyboardComponent.h"
 #include "gui/juce_MPEKeyboardComponent.h"
@@ -87,5 +97,6 @@
 #include "gui/juce_BluetoothMidiDevicePairingDialogue.h"
 #include "players/juce_SoundPlayer.h"
 #include "players/juce_AudioProcessorPlayer.h"
+#include "players/juce_OfflineAudioRenderer.h"
 #include "audio_cd/juce_AudioCDBurner.h"
 #include "audio_cd/juce_AudioCDReader.h"
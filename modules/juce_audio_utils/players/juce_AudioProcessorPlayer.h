@@ -37,7 +37,9 @@ namespace juce
     input to send both streams through the processor. To set a MidiOutput for the processor,
     use the setMidiOutput() method.
 
-    @see AudioProcessor, AudioProcessorGraph
+    To render a processor to a file faster than realtime, use an OfflineAudioRenderer instead.
+
+    @see AudioProcessor, AudioProcessorGraph, OfflineAudioRenderer
 
     @tags{Audio}
 */
@@ -0,0 +1,391 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+class OfflineAudioRenderer::StemPlayHead final : public AudioPlayHead
+{
+public:
+    explicit StemPlayHead (const Settings& s) : settings (s) {}
+
+    void setPosition (int64 newPosition) noexcept   { position = newPosition; }
+
+    Optional<PositionInfo> getPosition() const override
+    {
+        const auto seconds = (double) position / settings.sampleRate;
+        const auto ppq = seconds * settings.bpm / 60.0;
+        const auto quarterNotesPerBar = settings.timeSignature.numerator * 4.0 / settings.timeSignature.denominator;
+        const auto bar = (int64) std::floor (ppq / quarterNotesPerBar);
+
+        PositionInfo info;
+        info.setTimeInSamples (position);
+        info.setTimeInSeconds (seconds);
+        info.setBpm (settings.bpm);
+        info.setTimeSignature (settings.timeSignature);
+        info.setPpqPosition (ppq);
+        info.setBarCount (bar);
+        info.setPpqPositionOfLastBarStart ((double) bar * quarterNotesPerBar);
+        info.setIsPlaying (true);
+        return info;
+    }
+
+private:
+    const Settings& settings;
+    int64 position = 0;
+};
+
+//==============================================================================
+struct OfflineAudioRenderer::Stem
+{
+    Stem (AudioProcessor& p, std::unique_ptr<AudioFormatWriter> w, const MidiMessageSequence& m, const Settings& s)
+        : processor (p), writer (std::move (w)), midi (m), playHead (s)
+    {
+    }
+
+    AudioProcessor& processor;
+    std::unique_ptr<AudioFormatWriter> writer;
+    MidiMessageSequence midi;
+    StemPlayHead playHead;
+    int64 length = 0;
+
+    // The processor's state before the render, which is put back afterwards
+    AudioPlayHead* previousPlayHead = nullptr;
+    bool wasNonRealtime = false;
+    int previousNumGraphRenderThreads = -1;
+};
+
+//==============================================================================
+OfflineAudioRenderer::OfflineAudioRenderer (const Settings& s)  : settings (s)
+{
+    jassert (settings.sampleRate > 0 && settings.blockSize > 0);
+}
+
+OfflineAudioRenderer::~OfflineAudioRenderer() = default;
+
+void OfflineAudioRenderer::addStem (AudioProcessor& processor,
+                                    std::unique_ptr<AudioFormatWriter> writer,
+                                    const MidiMessageSequence& midi)
+{
+    jassert (writer != nullptr);
+    stems.push_back (std::make_unique<Stem> (processor, std::move (writer), midi, settings));
+}
+
+double OfflineAudioRenderer::getProgress() const noexcept
+{
+    const auto total = totalNumSamples.load();
+    return total > 0 ? jlimit (0.0, 1.0, (double) numSamplesRendered.load() / (double) total) : 0.0;
+}
+
+//==============================================================================
+Result OfflineAudioRenderer::renderAll()
+{
+    // The writers are deleted at the end of a render, so a renderer can only be used once!
+    if (std::any_of (stems.begin(), stems.end(), [] (const auto& stem) { return stem->writer == nullptr; }))
+    {
+        jassertfalse;
+        return Result::fail ("The renderer has already been used");
+    }
+
+    int64 total = 0;
+
+    for (auto& stem : stems)
+    {
+        auto& processor = stem->processor;
+        stem->previousPlayHead = processor.getPlayHead();
+        stem->wasNonRealtime = processor.isNonRealtime();
+
+        if (settings.numGraphRenderThreads > 0)
+        {
+            if (auto* graph = dynamic_cast<AudioProcessorGraph*> (&processor))
+            {
+                stem->previousNumGraphRenderThreads = graph->getNumParallelRenderThreads();
+                graph->setNumParallelRenderThreads (settings.numGraphRenderThreads);
+            }
+        }
+
+        processor.setNonRealtime (true);
+        processor.setRateAndBufferSizeDetails (settings.sampleRate, settings.blockSize);
+        processor.prepareToPlay (settings.sampleRate, settings.blockSize);
+        processor.setPlayHead (&stem->playHead);
+
+        const auto tailSeconds = settings.includeTail ? processor.getTailLengthSeconds() : 0.0;
+
+        stem->length = settings.lengthInSamples
+                         + (std::isfinite (tailSeconds) && tailSeconds > 0 ? (int64) std::ceil (tailSeconds * settings.sampleRate) : 0);
+        total += stem->length;
+    }
+
+    numSamplesRendered = 0;
+    totalNumSamples = total;
+
+    {
+        TimeSliceThread writerThread ("Offline render writer");
+        writerThread.startThread();
+
+        const auto numStems = (int) stems.size();
+        const auto maxConcurrentStems = jmin (numStems, settings.maxConcurrentStems > 0 ? settings.maxConcurrentStems
+                                                                                          : SystemStats::getNumCpus());
+
+        if (maxConcurrentStems > 1)
+        {
+            // The calling thread renders stems too, so the pool needs one thread fewer
+            ThreadPool pool { ThreadPoolOptions{}.withThreadName ("Offline render")
+                                                 .withNumberOfThreads (maxConcurrentStems - 1) };
+
+            parallelFor (0, numStems, [this, &writerThread] (int i) { renderStem (*stems[(size_t) i], writerThread); }, 1, pool);
+        }
+        else
+        {
+            for (auto& stem : stems)
+                renderStem (*stem, writerThread);
+        }
+
+        writerThread.stopThread (10000);
+    }
+
+    for (auto& stem : stems)
+    {
+        auto& processor = stem->processor;
+        processor.releaseResources();
+        processor.setPlayHead (stem->previousPlayHead);
+        processor.setNonRealtime (stem->wasNonRealtime);
+
+        if (stem->previousNumGraphRenderThreads >= 0)
+            if (auto* graph = dynamic_cast<AudioProcessorGraph*> (&processor))
+                graph->setNumParallelRenderThreads (stem->previousNumGraphRenderThreads);
+    }
+
+    if (shouldCancel)
+        return Result::fail ("The render was cancelled");
+
+    return Result::ok();
+}
+
+void OfflineAudioRenderer::renderStem (Stem& stem, TimeSliceThread& writerThread)
+{
+    auto& processor = stem.processor;
+    const auto blockSize = settings.blockSize;
+    const auto numOutputChannels = processor.getTotalNumOutputChannels();
+
+    AudioBuffer<float> buffer (jmax (1, processor.getTotalNumInputChannels(), numOutputChannels), blockSize);
+    AudioBuffer<float> silence (1, blockSize);
+    silence.clear();
+
+    // The writer's channels are pointed at the processor's outputs, or at silence if the writer has more
+    std::vector<const float*> writerChannels ((size_t) stem.writer->getNumChannels());
+
+    MidiBuffer midiBuffer;
+    int nextMidiEvent = 0;
+
+    {
+        // Deleting this waits for the background thread to write the rest of the data
+        AudioFormatWriter::ThreadedWriter threadedWriter (stem.writer.release(), writerThread,
+                                                          jmax (settings.writeBufferSize, blockSize * 2));
+
+        for (int64 position = 0; position < stem.length && ! shouldCancel;)
+        {
+            const auto numSamples = (int) jmin ((int64) blockSize, stem.length - position);
+            AudioBuffer<float> block (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+            block.clear();
+
+            midiBuffer.clear();
+
+            while (nextMidiEvent < stem.midi.getNumEvents())
+            {
+                const auto& message = stem.midi.getEventPointer (nextMidiEvent)->message;
+                const auto samplePosition = (int64) std::llround (message.getTimeStamp() * settings.sampleRate);
+
+                if (samplePosition >= position + numSamples)
+                    break;
+
+                midiBuffer.addEvent (message, (int) jmax ((int64) 0, samplePosition - position));
+                ++nextMidiEvent;
+            }
+
+            stem.playHead.setPosition (position);
+
+            {
+                const ScopedLock sl (processor.getCallbackLock());
+                processor.processBlock (block, midiBuffer);
+            }
+
+            for (size_t i = 0; i < writerChannels.size(); ++i)
+                writerChannels[i] = (int) i < numOutputChannels ? block.getReadPointer ((int) i)
+                                                                : silence.getReadPointer (0);
+
+            while (! threadedWriter.write (writerChannels.data(), numSamples))
+            {
+                if (shouldCancel)
+                    break;
+
+                Thread::sleep (1);
+            }
+
+            position += numSamples;
+            numSamplesRendered += numSamples;
+        }
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct OfflineAudioRendererTests final : public UnitTest
+{
+    OfflineAudioRendererTests()
+        : UnitTest ("OfflineAudioRenderer", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        beginTest ("Stems are rendered with their tails, and see the timeline position");
+        {
+            OfflineAudioRenderer::Settings settings;
+            settings.sampleRate = 44100.0;
+            settings.blockSize = 500;
+            settings.lengthInSamples = 3000;
+            settings.bpm = 90.0;
+
+            // The tail of 10ms adds 441 samples, so the last block is a partial one
+            constexpr int64 expectedLength = 3441;
+
+            TestProcessor first (0.25f), second (-0.5f);
+            MemoryBlock firstData, secondData;
+
+            OfflineAudioRenderer renderer (settings);
+            renderer.addStem (first,  createWriter (firstData,  settings.sampleRate));
+            renderer.addStem (second, createWriter (secondData, settings.sampleRate));
+
+            expect (renderer.renderAll().wasOk());
+            expectEquals (renderer.getProgress(), 1.0);
+
+            for (auto* processor : { &first, &second })
+            {
+                expect (processor->wasNonRealtimeWhenProcessing);
+                expect (! processor->isNonRealtime());
+                expect (processor->getPlayHead() == nullptr);
+
+                expectEquals ((int) processor->positions.size(), 7);
+
+                for (size_t i = 0; i < processor->positions.size(); ++i)
+                {
+                    const auto& position = processor->positions[i];
+                    const auto expectedTime = (int64) i * settings.blockSize;
+
+                    expect (position.getIsPlaying());
+                    expectEquals ((int64) *position.getTimeInSamples(), expectedTime);
+                    expectWithinAbsoluteError (*position.getPpqPosition(),
+                                               (double) expectedTime / settings.sampleRate * settings.bpm / 60.0,
+                                               1.0e-9);
+                }
+
+                expectEquals (processor->blockSizes.back(), (int) (expectedLength - 6 * settings.blockSize));
+            }
+
+            for (const auto& [data, value] : { std::make_tuple (&firstData, 0.25f), std::make_tuple (&secondData, -0.5f) })
+            {
+                const std::unique_ptr<AudioFormatReader> reader (WavAudioFormat().createReaderFor (new MemoryInputStream (*data, false), true));
+
+                expect (reader != nullptr);
+
+                if (reader == nullptr)
+                    continue;
+
+                expectEquals (reader->lengthInSamples, expectedLength);
+                expectEquals ((int) reader->numChannels, 2);
+
+                AudioBuffer<float> audio ((int) reader->numChannels, (int) reader->lengthInSamples);
+                reader->read (&audio, 0, audio.getNumSamples(), 0, true, true);
+
+                expect (audio.findMinMax (0, 0, audio.getNumSamples()) == Range<float> (value, value));
+                expect (audio.findMinMax (1, 0, audio.getNumSamples()) == Range<float> (-value, -value));
+            }
+        }
+    }
+
+private:
+    static std::unique_ptr<AudioFormatWriter> createWriter (MemoryBlock& data, double sampleRate)
+    {
+        return std::unique_ptr<AudioFormatWriter> (WavAudioFormat().createWriterFor (new MemoryOutputStream (data, false),
+                                                                                     sampleRate, 2, 16, {}, 0));
+    }
+
+    /*  Writes a constant to its first output and its negation to the second, and records
+        the play head positions and block sizes that it's given.
+    */
+    class TestProcessor final : public AudioProcessor
+    {
+    public:
+        explicit TestProcessor (float valueToWrite)
+            : AudioProcessor (BusesProperties().withOutput ("out", AudioChannelSet::stereo())),
+              value (valueToWrite) {}
+
+        const String getName() const override                             { return "Test"; }
+        void prepareToPlay (double, int) override                         {}
+        void releaseResources() override                                  {}
+        double getTailLengthSeconds() const override                      { return 0.01; }
+        bool acceptsMidi() const override                                 { return false; }
+        bool producesMidi() const override                                { return false; }
+        AudioProcessorEditor* createEditor() override                     { return nullptr; }
+        bool hasEditor() const override                                   { return false; }
+        int getNumPrograms() override                                     { return 1; }
+        int getCurrentProgram() override                                  { return 0; }
+        void setCurrentProgram (int) override                             {}
+        const String getProgramName (int) override                        { return {}; }
+        void changeProgramName (int, const String&) override              {}
+        void getStateInformation (MemoryBlock&) override                  {}
+        void setStateInformation (const void*, int) override              {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            wasNonRealtimeWhenProcessing = wasNonRealtimeWhenProcessing && isNonRealtime();
+
+            if (auto* currentPlayHead = getPlayHead())
+                if (const auto position = currentPlayHead->getPosition())
+                    positions.push_back (*position);
+
+            blockSizes.push_back (buffer.getNumSamples());
+
+            FloatVectorOperations::fill (buffer.getWritePointer (0),  value, buffer.getNumSamples());
+            FloatVectorOperations::fill (buffer.getWritePointer (1), -value, buffer.getNumSamples());
+        }
+
+        using AudioProcessor::processBlock;
+
+        const float value;
+        std::vector<AudioPlayHead::PositionInfo> positions;
+        std::vector<int> blockSizes;
+        bool wasNonRealtimeWhenProcessing = true;
+    };
+};
+
+static OfflineAudioRendererTests offlineAudioRendererTests;
+
+#endif
+
+} // namespace juce
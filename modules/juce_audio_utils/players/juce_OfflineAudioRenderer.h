@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders AudioProcessors to AudioFormatWriters faster than realtime, for bouncing
+    a mix or exporting stems.
+
+    Each processor that is added with addStem() is rendered from the start of the
+    timeline for a given length, with its output written to its own writer. During a
+    render, every processor is put into non-realtime mode, and is given an AudioPlayHead
+    that reports the position on the timeline, using the tempo and time signature in
+    the Settings. Processors with audio inputs receive silence.
+
+    Stems are independent of one another, so several of them are rendered at the same
+    time on different threads. The rendered audio is handed to a background thread to
+    be written, so rendering doesn't have to wait for the disk.
+
+    @code
+    OfflineAudioRenderer::Settings settings;
+    settings.sampleRate = 48000.0;
+    settings.lengthInSamples = (int64) (180 * settings.sampleRate);
+
+    OfflineAudioRenderer renderer (settings);
+
+    for (auto& track : tracks)
+        renderer.addStem (*track.processor, createWriterFor (track.file), track.midi);
+
+    auto result = renderer.renderAll();
+    @endcode
+
+    @see AudioProcessorPlayer, AudioFormatWriter
+
+    @tags{Audio}
+*/
+class JUCE_API  OfflineAudioRenderer
+{
+public:
+    //==============================================================================
+    /** The settings that are used to render all of the stems. */
+    struct Settings
+    {
+        /** The sample rate at which the processors are run. */
+        double sampleRate = 44100.0;
+
+        /** The number of samples that are passed to each processBlock() call. */
+        int blockSize = 512;
+
+        /** The number of samples to render, not counting any tail. */
+        int64 lengthInSamples = 0;
+
+        /** If true, each stem is extended by its processor's getTailLengthSeconds(),
+            so that reverb or delay tails aren't cut off.
+        */
+        bool includeTail = true;
+
+        /** The tempo reported by the play head. */
+        double bpm = 120.0;
+
+        /** The time signature reported by the play head. */
+        AudioPlayHead::TimeSignature timeSignature;
+
+        /** The most stems that will be rendered at once. A value of 0 allows one stem
+            per CPU core.
+        */
+        int maxConcurrentStems = 0;
+
+        /** If this is greater than 0, any AudioProcessorGraph that is rendered is given this
+            number of parallel render threads, so that a single large graph can also use
+            several cores. See AudioProcessorGraph::setNumParallelRenderThreads().
+        */
+        int numGraphRenderThreads = 0;
+
+        /** The number of samples per channel that can wait to be written for each stem. */
+        int writeBufferSize = 1 << 17;
+    };
+
+    /** Creates a renderer that will use the given settings. */
+    explicit OfflineAudioRenderer (const Settings& settings);
+
+    /** Destructor. */
+    ~OfflineAudioRenderer();
+
+    //==============================================================================
+    /** Adds a processor to be rendered.
+
+        The processor must stay alive until the render has finished, and can't be used for
+        anything else in the meantime - in particular, it mustn't be playing through an
+        AudioProcessorPlayer. Its bus layout isn't changed.
+
+        @param processor    the processor to render
+        @param writer       the writer to write the processor's output to. If this has fewer
+                            channels than the processor, the extra outputs are ignored, and if
+                            it has more, the extra channels are silent
+        @param midi         MIDI to send to the processor, with timestamps in seconds from the
+                            start of the timeline
+    */
+    void addStem (AudioProcessor& processor,
+                  std::unique_ptr<AudioFormatWriter> writer,
+                  const MidiMessageSequence& midi = {});
+
+    /** Returns the number of stems that have been added. */
+    int getNumStems() const noexcept                    { return (int) stems.size(); }
+
+    //==============================================================================
+    /** Renders all of the stems, and returns when they've been written.
+
+        The processors are prepared and released on the calling thread, and if any of them
+        are AudioProcessorGraphs that are given parallel render threads, it must be called
+        on the message thread. The writers are deleted once all of their data has been
+        written, which closes their output files. A renderer can only be used once.
+
+        @returns an error if the render was cancelled
+    */
+    Result renderAll();
+
+    /** Stops a render that is in progress. This can be called from any thread. */
+    void cancel() noexcept                              { shouldCancel = true; }
+
+    /** Returns the proportion of the total number of samples that has been rendered so far,
+        from 0 to 1. This can be called from any thread.
+    */
+    double getProgress() const noexcept;
+
+private:
+    //==============================================================================
+    struct Stem;
+    class StemPlayHead;
+
+    void renderStem (Stem&, TimeSliceThread&);
+
+    const Settings settings;
+    std::vector<std::unique_ptr<Stem>> stems;
+    std::atomic<int64> numSamplesRendered { 0 }, totalNumSamples { 0 };
+    std::atomic<bool> shouldCancel { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineAudioRenderer)
+};
+
+} // namespace juce
@@ -103,6 +103,7 @@ using uint32 = juce::uint32;
 #include "box2d/Rope/b2Rope.cpp"
 
 #include "utils/juce_Box2DRenderer.cpp"
+#include "utils/juce_Box2DSimulationThread.cpp"
 
 JUCE_END_IGNORE_WARNINGS_GCC_LIKE
 JUCE_END_IGNORE_WARNINGS_MSVC
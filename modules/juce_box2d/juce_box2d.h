@@ -71,6 +71,8 @@ JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wconversion",
 
 JUCE_END_IGNORE_WARNINGS_GCC_LIKE
 
+#include "utils/juce_Box2DSimulationThread.h"
+
 #ifndef DOXYGEN // for some reason, Doxygen sees this as a re-definition of Box2DRenderer
  #include "utils/juce_Box2DRenderer.h"
 #endif // DOXYGEN
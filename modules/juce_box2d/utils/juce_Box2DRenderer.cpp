@@ -31,18 +31,116 @@ Box2DRenderer::Box2DRenderer() noexcept   : graphics (nullptr)
     SetFlags (e_shapeBit);
 }
 
-void Box2DRenderer::render (Graphics& g, b2World& world,
-                            float left, float top, float right, float bottom,
-                            const Rectangle<float>& target)
+void Box2DRenderer::setTransform (Graphics& g, float left, float top, float right, float bottom,
+                                  const Rectangle<float>& target)
 {
     graphics = &g;
 
     g.addTransform (AffineTransform::fromTargetPoints (left,  top,    target.getX(),     target.getY(),
                                                        right, top,    target.getRight(), target.getY(),
                                                        left,  bottom, target.getX(),     target.getBottom()));
+}
+
+void Box2DRenderer::render (Graphics& g, b2World& world,
+                            float left, float top, float right, float bottom,
+                            const Rectangle<float>& target)
+{
+    setTransform (g, left, top, right, bottom, target);
 
     world.SetDebugDraw (this);
     world.DrawDebugData();
+
+    drawBatches();
+}
+
+void Box2DRenderer::render (Graphics& g, const Box2DWorldSnapshot& snapshot,
+                            float left, float top, float right, float bottom,
+                            const Rectangle<float>& target)
+{
+    setTransform (g, left, top, right, bottom, target);
+
+    const auto proportion = snapshot.getInterpolationProportion (Time::getMillisecondCounterHiRes());
+
+    bodyTransforms.clear();
+
+    for (auto& body : snapshot.bodies)
+        bodyTransforms.push_back (body.getTransform (proportion));
+
+    for (auto& shape : snapshot.shapes)
+    {
+        const auto& xf = bodyTransforms[(size_t) shape.body];
+        const auto* localVertices = snapshot.vertices.data() + shape.firstVertex;
+
+        transformedVertices.clear();
+
+        for (int i = 0; i < shape.numVertices; ++i)
+            transformedVertices.push_back (b2Mul (xf, localVertices[i]));
+
+        const auto* vertices = transformedVertices.data();
+
+        // Drawn in the same way as b2World::DrawShape()
+        switch (shape.type)
+        {
+            case b2Shape::e_circle:
+                DrawSolidCircle (vertices[0], shape.radius, b2Mul (xf.q, b2Vec2 (1.0f, 0.0f)), shape.colour);
+                break;
+
+            case b2Shape::e_edge:
+                DrawSegment (vertices[0], vertices[1], shape.colour);
+                break;
+
+            case b2Shape::e_chain:
+                for (int i = 1; i < shape.numVertices; ++i)
+                {
+                    DrawSegment (vertices[i - 1], vertices[i], shape.colour);
+                    DrawCircle (vertices[i - 1], 0.05f, shape.colour);
+                }
+                break;
+
+            case b2Shape::e_polygon:
+                DrawSolidPolygon (vertices, shape.numVertices, shape.colour);
+                break;
+
+            case b2Shape::e_typeCount:
+            default:
+                break;
+        }
+    }
+
+    drawBatches();
+}
+
+Box2DRenderer::Batch& Box2DRenderer::getBatch (const b2Color& c)
+{
+    const auto colour = getColour (c);
+
+    for (auto& batch : batches)
+        if (batch.colour == colour)
+            return batch;
+
+    batches.push_back ({ colour, {}, {}, {} });
+    return batches.back();
+}
+
+void Box2DRenderer::drawBatches()
+{
+    // Polygons and circles are filled separately, because their outlines may wind in
+    // opposite directions, which would leave holes where they overlap
+    for (auto& batch : batches)
+    {
+        graphics->setColour (batch.colour);
+
+        if (! batch.polygons.isEmpty())
+            graphics->fillPath (batch.polygons);
+
+        if (! batch.circles.isEmpty())
+            graphics->fillPath (batch.circles);
+
+        if (! batch.outlines.isEmpty())
+            graphics->strokePath (batch.outlines, PathStrokeType (getLineThickness()));
+    }
+
+    batches.clear();
 }
 
 Colour Box2DRenderer::getColour (const b2Color& c) const
@@ -67,6 +165,12 @@ static void createPath (Path& p, const b2Vec2* vertices, int32 vertexCount)
 
 void Box2DRenderer::DrawPolygon (const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
 {
+    if (batchingEnabled)
+    {
+        createPath (getBatch (color).outlines, vertices, vertexCount);
+        return;
+    }
+
     graphics->setColour (getColour (color));
 
     Path p;
@@ -76,6 +180,12 @@ void Box2DRenderer::DrawPolygon (const b2Vec2* vertices, int32 vertexCount, cons
 
 void Box2DRenderer::DrawSolidPolygon (const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
 {
+    if (batchingEnabled)
+    {
+        createPath (getBatch (color).polygons, vertices, vertexCount);
+        return;
+    }
+
     graphics->setColour (getColour (color));
 
     Path p;
@@ -85,6 +195,13 @@ void Box2DRenderer::DrawSolidPolygon (const b2Vec2* vertices, int32 vertexCount,
 
 void Box2DRenderer::DrawCircle (const b2Vec2& center, float32 radius, const b2Color& color)
 {
+    if (batchingEnabled)
+    {
+        getBatch (color).outlines.addEllipse (center.x - radius, center.y - radius,
+                                              radius * 2.0f, radius * 2.0f);
+        return;
+    }
+
     graphics->setColour (getColour (color));
     graphics->drawEllipse (center.x - radius, center.y - radius,
                            radius * 2.0f, radius * 2.0f,
@@ -93,6 +210,13 @@ void Box2DRenderer::DrawCircle (const b2Vec2& center, float32 radius, const b2Co
 
 void Box2DRenderer::DrawSolidCircle (const b2Vec2& center, float32 radius, const b2Vec2& /*axis*/, const b2Color& colour)
 {
+    if (batchingEnabled)
+    {
+        getBatch (colour).circles.addEllipse (center.x - radius, center.y - radius,
+                                              radius * 2.0f, radius * 2.0f);
+        return;
+    }
+
     graphics->setColour (getColour (colour));
     graphics->fillEllipse (center.x - radius, center.y - radius,
                            radius * 2.0f, radius * 2.0f);
@@ -100,6 +224,14 @@ void Box2DRenderer::DrawSolidCircle (const b2Vec2& center, float32 radius, const
 
 void Box2DRenderer::DrawSegment (const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
 {
+    if (batchingEnabled)
+    {
+        auto& outlines = getBatch (color).outlines;
+        outlines.startNewSubPath (p1.x, p1.y);
+        outlines.lineTo (p2.x, p2.y);
+        return;
+    }
+
     graphics->setColour (getColour (color));
     graphics->drawLine (p1.x, p1.y, p2.x, p2.y, getLineThickness());
 }
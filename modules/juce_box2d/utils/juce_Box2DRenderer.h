@@ -32,6 +32,11 @@ namespace juce
     To use it, simply create an instance of this class in your paint() method,
     and call its render() method.
 
+    It can draw a b2World directly, or a Box2DWorldSnapshot from a world that a
+    Box2DSimulationThread is stepping in the background. With batching turned on,
+    the shapes are gathered into one path per colour and drawn with a few calls at
+    the end, rather than each one being drawn separately.
+
     @tags{Box2D}
 */
 class Box2DRenderer   : public b2Draw
@@ -57,6 +62,37 @@ public:
                  float box2DWorldRight, float box2DWorldBottom,
                  const Rectangle<float>& targetArea);
 
+    /** Renders a snapshot of a world.
+
+        The bodies are drawn at the position that Box2DWorldSnapshot::getInterpolationProportion()
+        returns for the current time, in between their positions before and after the step.
+
+        @param g        the context to render into
+        @param snapshot the snapshot to render
+        @param box2DWorldLeft   the left coordinate of the area of the world to be drawn
+        @param box2DWorldTop    the top coordinate of the area of the world to be drawn
+        @param box2DWorldRight  the right coordinate of the area of the world to be drawn
+        @param box2DWorldBottom the bottom coordinate of the area of the world to be drawn
+        @param targetArea   the area within the target context onto which the source
+                            world rectangle should be mapped
+    */
+    void render (Graphics& g,
+                 const Box2DWorldSnapshot& snapshot,
+                 float box2DWorldLeft, float box2DWorldTop,
+                 float box2DWorldRight, float box2DWorldBottom,
+                 const Rectangle<float>& targetArea);
+
+    /** Enables or disables batching, which is off by default.
+
+        When it's on, the shapes are collected into one path for each colour and
+        drawn when render() finishes. Overlapping shapes of different colours may
+        then be drawn in a different order.
+    */
+    void setBatchingEnabled (bool shouldBatch) noexcept    { batchingEnabled = shouldBatch; }
+
+    /** Returns true if batching is enabled. */
+    bool isBatchingEnabled() const noexcept                { return batchingEnabled; }
+
     // b2Draw methods:
     void DrawPolygon (const b2Vec2*, int32, const b2Color&) override;
     void DrawSolidPolygon (const b2Vec2*, int32, const b2Color&) override;
@@ -73,6 +109,22 @@ public:
 protected:
     Graphics* graphics;
 
+private:
+    struct Batch
+    {
+        Colour colour;
+        Path polygons, circles, outlines;
+    };
+
+    bool batchingEnabled = false;
+    std::vector<Batch> batches;
+    std::vector<b2Transform> bodyTransforms;
+    std::vector<b2Vec2> transformedVertices;
+
+    void setTransform (Graphics&, float, float, float, float, const Rectangle<float>&);
+    Batch& getBatch (const b2Color&);
+    void drawBatches();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Box2DRenderer)
 };
 
@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+b2Transform Box2DWorldSnapshot::Body::getTransform (float proportion) const noexcept
+{
+    const auto p = previousPosition + proportion * (position - previousPosition);
+    return { p, b2Rot (previousAngle + proportion * (angle - previousAngle)) };
+}
+
+float Box2DWorldSnapshot::getInterpolationProportion (double timeMs) const noexcept
+{
+    if (stepSeconds <= 0.0)
+        return 1.0f;
+
+    return (float) jlimit (0.0, 1.0, (timeMs - stepTime) / (stepSeconds * 1000.0));
+}
+
+//==============================================================================
+Box2DSimulationThread::Box2DSimulationThread (b2World& worldToStep, double secondsPerStep,
+                                              int32 numVelocityIterations, int32 numPositionIterations)
+    : Thread ("Box2D simulation"),
+      world (worldToStep),
+      stepSeconds (secondsPerStep),
+      velocityIterations (numVelocityIterations),
+      positionIterations (numPositionIterations)
+{
+    jassert (stepSeconds > 0.0);
+
+    // Makes the first snapshot available straight away, with everything at rest
+    const ScopedLock sl (lock);
+
+    for (auto* b = world.GetBodyList(); b != nullptr; b = b->GetNext())
+        bodiesBeforeStep.push_back ({ b->GetPosition(), b->GetPosition(), b->GetAngle(), b->GetAngle() });
+
+    publishSnapshot();
+}
+
+Box2DSimulationThread::~Box2DSimulationThread()
+{
+    stop();
+}
+
+void Box2DSimulationThread::start()
+{
+    startThread();
+}
+
+void Box2DSimulationThread::stop()
+{
+    stopThread (-1);
+}
+
+const Box2DWorldSnapshot& Box2DSimulationThread::getLatestSnapshot()
+{
+    return snapshots.get();
+}
+
+void Box2DSimulationThread::run()
+{
+    // If the steps fall this far behind, the simulation slows down rather than
+    // trying to catch up all at once
+    constexpr int maxStepsBehind = 5;
+
+    const auto stepMs = stepSeconds * 1000.0;
+    auto nextStepTime = Time::getMillisecondCounterHiRes();
+
+    while (! threadShouldExit())
+    {
+        step();
+
+        nextStepTime += stepMs;
+        const auto now = Time::getMillisecondCounterHiRes();
+
+        if (nextStepTime < now - stepMs * maxStepsBehind)
+            nextStepTime = now;
+
+        if (nextStepTime > now)
+            wait ((int) (nextStepTime - now));
+    }
+}
+
+void Box2DSimulationThread::step()
+{
+    const ScopedLock sl (lock);
+
+    bodiesBeforeStep.clear();
+
+    for (auto* b = world.GetBodyList(); b != nullptr; b = b->GetNext())
+        bodiesBeforeStep.push_back ({ b->GetPosition(), b->GetPosition(), b->GetAngle(), b->GetAngle() });
+
+    world.Step ((float32) stepSeconds, velocityIterations, positionIterations);
+    publishSnapshot();
+}
+
+static b2Color getShapeColour (const b2Body& b)
+{
+    // The same colours as b2World::DrawDebugData() uses
+    if (! b.IsActive())                     return { 0.5f, 0.5f, 0.3f };
+    if (b.GetType() == b2_staticBody)       return { 0.5f, 0.9f, 0.5f };
+    if (b.GetType() == b2_kinematicBody)    return { 0.5f, 0.5f, 0.9f };
+    if (! b.IsAwake())                      return { 0.6f, 0.6f, 0.6f };
+
+    return { 0.9f, 0.7f, 0.7f };
+}
+
+void Box2DSimulationThread::publishSnapshot()
+{
+    auto& snapshot = snapshots.getWriteBuffer();
+    snapshot.bodies.clear();
+    snapshot.shapes.clear();
+    snapshot.vertices.clear();
+
+    // Steps never add or remove bodies, so the list is in the same order as before the step
+    size_t bodyIndex = 0;
+
+    for (auto* b = world.GetBodyList(); b != nullptr; b = b->GetNext(), ++bodyIndex)
+    {
+        jassert (bodyIndex < bodiesBeforeStep.size());
+
+        auto body = bodiesBeforeStep[bodyIndex];
+        body.position = b->GetPosition();
+        body.angle = b->GetAngle();
+        snapshot.bodies.push_back (body);
+
+        const auto colour = getShapeColour (*b);
+
+        for (auto* f = b->GetFixtureList(); f != nullptr; f = f->GetNext())
+        {
+            Box2DWorldSnapshot::Shape shape;
+            shape.type = f->GetType();
+            shape.colour = colour;
+            shape.body = (int) bodyIndex;
+            shape.firstVertex = (int) snapshot.vertices.size();
+
+            switch (shape.type)
+            {
+                case b2Shape::e_circle:
+                {
+                    auto* circle = static_cast<const b2CircleShape*> (f->GetShape());
+                    snapshot.vertices.push_back (circle->m_p);
+                    shape.radius = circle->m_radius;
+                    break;
+                }
+
+                case b2Shape::e_edge:
+                {
+                    auto* edge = static_cast<const b2EdgeShape*> (f->GetShape());
+                    snapshot.vertices.push_back (edge->m_vertex1);
+                    snapshot.vertices.push_back (edge->m_vertex2);
+                    break;
+                }
+
+                case b2Shape::e_chain:
+                {
+                    auto* chain = static_cast<const b2ChainShape*> (f->GetShape());
+                    snapshot.vertices.insert (snapshot.vertices.end(), chain->m_vertices, chain->m_vertices + chain->m_count);
+                    break;
+                }
+
+                case b2Shape::e_polygon:
+                {
+                    auto* poly = static_cast<const b2PolygonShape*> (f->GetShape());
+                    snapshot.vertices.insert (snapshot.vertices.end(), poly->m_vertices, poly->m_vertices + poly->m_vertexCount);
+                    break;
+                }
+
+                case b2Shape::e_typeCount:
+                default:
+                    continue;
+            }
+
+            shape.numVertices = (int) snapshot.vertices.size() - shape.firstVertex;
+            snapshot.shapes.push_back (shape);
+        }
+    }
+
+    snapshot.stepSeconds = stepSeconds;
+    snapshot.stepTime = Time::getMillisecondCounterHiRes();
+    snapshots.publish();
+}
+
+} // namespace juce
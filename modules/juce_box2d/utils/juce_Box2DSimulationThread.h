@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A copy of the shapes in a Box2D world, as a Box2DSimulationThread publishes
+    them after each step.
+
+    The shapes' vertices are stored relative to their bodies, and each body holds
+    its position and angle both before and after the step, so that a renderer can
+    draw the world at any point in between.
+
+    Only the shapes are copied, so joints, AABBs and the other things that b2World
+    can draw for debugging aren't included.
+
+    @see Box2DSimulationThread, Box2DRenderer
+
+    @tags{Box2D}
+*/
+struct Box2DWorldSnapshot
+{
+    /** The position and angle of a body before and after the step. */
+    struct Body
+    {
+        b2Vec2 previousPosition { 0.0f, 0.0f }, position { 0.0f, 0.0f };
+        float32 previousAngle = 0.0f, angle = 0.0f;
+
+        /** Returns the body's transform at a proportion of the way through the step. */
+        b2Transform getTransform (float proportion) const noexcept;
+    };
+
+    /** One fixture's shape. */
+    struct Shape
+    {
+        b2Shape::Type type = b2Shape::e_polygon;
+        b2Color colour;
+        int body = 0, firstVertex = 0, numVertices = 0;
+        float32 radius = 0.0f;
+    };
+
+    std::vector<Body> bodies;
+    std::vector<Shape> shapes;
+
+    /** The vertices of all the shapes, relative to their bodies. A circle has a single vertex at its centre. */
+    std::vector<b2Vec2> vertices;
+
+    /** The length of a step, in seconds. */
+    double stepSeconds = 0.0;
+
+    /** The time at which the step finished, as returned by Time::getMillisecondCounterHiRes(). */
+    double stepTime = 0.0;
+
+    /** Returns how far through the next step the given time is, from 0 to 1.
+        Drawing the world at this point, one step behind the simulation, means
+        that its motion stays smooth however the frames and steps line up.
+    */
+    float getInterpolationProportion (double timeMs) const noexcept;
+};
+
+//==============================================================================
+/**
+    Steps a Box2D world on a background thread, at a fixed rate.
+
+    Each step advances the world by the same fixed time, and the thread waits
+    between steps to keep up with real time, so the simulation doesn't depend on
+    how often the world is drawn. After every step the shapes are copied into a
+    Box2DWorldSnapshot, which the message thread can pick up without ever waiting
+    for the physics.
+
+    @code
+    void timerCallback() override      { repaint(); }
+
+    void paint (Graphics& g) override
+    {
+        Box2DRenderer renderer;
+        renderer.render (g, simulation.getLatestSnapshot(), -16.0f, 30.0f, 16.0f, -1.0f,
+                         getLocalBounds().toFloat());
+    }
+    @endcode
+
+    Anything else that touches the world while the thread is running must hold
+    the lock returned by getLock().
+
+    @see Box2DWorldSnapshot, Box2DRenderer
+
+    @tags{Box2D}
+*/
+class Box2DSimulationThread   : private Thread
+{
+public:
+    /** Creates a thread to step the given world, which must outlive it.
+        The thread doesn't start until you call start().
+    */
+    Box2DSimulationThread (b2World& worldToStep,
+                           double stepSeconds = 1.0 / 60.0,
+                           int32 velocityIterations = 8,
+                           int32 positionIterations = 3);
+
+    /** Destructor. Stops the thread. */
+    ~Box2DSimulationThread() override;
+
+    //==============================================================================
+    /** Starts stepping the world. */
+    void start();
+
+    /** Stops stepping the world, waiting for the current step to finish. */
+    void stop();
+
+    /** Returns true if the world is being stepped. */
+    bool isRunning() const          { return isThreadRunning(); }
+
+    /** Returns the lock that is held while the world is stepped.
+        Hold it while you create or destroy bodies, apply forces or make any
+        other changes to the world from another thread.
+    */
+    const CriticalSection& getLock() const noexcept     { return lock; }
+
+    /** Returns the length of each step, in seconds. */
+    double getStepSeconds() const noexcept              { return stepSeconds; }
+
+    //==============================================================================
+    /** Returns a snapshot of the world after the most recent step.
+
+        This may only be called from one thread, usually the message thread. The
+        reference stays valid until the next call.
+    */
+    const Box2DWorldSnapshot& getLatestSnapshot();
+
+    /** Returns true if a step has finished since getLatestSnapshot() was last called. */
+    bool hasNewSnapshot() const noexcept                { return snapshots.hasNewValue(); }
+
+private:
+    //==============================================================================
+    b2World& world;
+    const double stepSeconds;
+    const int32 velocityIterations, positionIterations;
+
+    CriticalSection lock;
+    LatestValue<Box2DWorldSnapshot> snapshots;
+    std::vector<Box2DWorldSnapshot::Body> bodiesBeforeStep;
+
+    void run() override;
+    void step();
+    void publishSnapshot();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Box2DSimulationThread)
+};
+
+} // namespace juce
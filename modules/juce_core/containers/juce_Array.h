@@ -906,6 +906,26 @@ public:
         }
     }
 
+    /** Removes a range of elements from the array without freeing any of the array's
+        allocated storage.
+
+        This behaves like removeRange(), but never reallocates the array, in the same
+        way that clearQuick() doesn't.
+
+        @see removeRange, clearQuick
+    */
+    void removeRangeQuick (int startIndex, int numberToRemove)
+    {
+        const ScopedLockType lock (getLock());
+
+        auto endIndex = jlimit (0, values.size(), startIndex + numberToRemove);
+        startIndex    = jlimit (0, values.size(), startIndex);
+        numberToRemove = endIndex - startIndex;
+
+        if (numberToRemove > 0)
+            values.removeElements (startIndex, numberToRemove);
+    }
+
     /** Removes the last n elements from the array.
 
         @param howManyToRemove   how many elements to remove from the end of the array
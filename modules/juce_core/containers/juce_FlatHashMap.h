@@ -0,0 +1,433 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A hash map which keeps all of its items in a single flat array.
+
+    Unlike HashMap, which allocates every item separately and chains together the
+    items in each slot, this uses open addressing with Robin Hood probing, so a lookup
+    usually touches just one or two neighbouring slots. That makes it much quicker
+    for lookup-heavy code, at the cost of the items moving around in memory whenever
+    the map grows or an item is removed - so don't hang on to pointers or references
+    to values across calls that modify the map.
+
+    The hash function class works in the same way as HashMap's, and the default one
+    can hash Strings, ints, pointers, etc. Lookups are templated so that you can search
+    using any type that the hash function accepts and that can be compared with the
+    key type, e.g. a StringRef or string literal for a map with String keys, which
+    avoids creating a temporary String.
+
+    @code
+    FlatHashMap<String, int> map;
+    map.set ("one", 1);
+    map.set ("two", 2);
+
+    if (auto* value = map.find (StringRef ("two")))
+        DBG (*value); // prints "2"
+
+    for (auto& item : map)
+        DBG (item.key << " -> " << item.value);
+    @endcode
+
+    @tparam HashFunctionType  The class of hash function, as used by HashMap
+    @tparam Allocator         An allocator, which is rebound to the map's internal types
+    @see HashMap, DefaultHashFunctions
+
+    @tags{Core}
+*/
+template <typename KeyType,
+          typename ValueType,
+          class HashFunctionType = DefaultHashFunctions,
+          class Allocator = std::allocator<std::pair<KeyType, ValueType>>>
+class FlatHashMap
+{
+public:
+    //==============================================================================
+    /** A key and value stored in the map. Don't change the key of an item in the map! */
+    struct Item
+    {
+        KeyType key;
+        ValueType value;
+    };
+
+    //==============================================================================
+    /** Creates an empty map. No memory is allocated until the first item is added. */
+    explicit FlatHashMap (HashFunctionType hashFunctionToUse = HashFunctionType(),
+                          const Allocator& allocatorToUse = Allocator())
+        : hashFunction (std::move (hashFunctionToUse)),
+          itemAllocator (allocatorToUse),
+          distanceAllocator (allocatorToUse)
+    {
+    }
+
+    /** Creates a copy of another map. */
+    FlatHashMap (const FlatHashMap& other)
+        : hashFunction (other.hashFunction),
+          itemAllocator (std::allocator_traits<ItemAllocator>::select_on_container_copy_construction (other.itemAllocator)),
+          distanceAllocator (std::allocator_traits<DistanceAllocator>::select_on_container_copy_construction (other.distanceAllocator))
+    {
+        reserve (other.numItems);
+
+        for (auto& item : other)
+            insertNewItem (Item { item.key, item.value });
+    }
+
+    /** Moves the contents of another map into a new one. */
+    FlatHashMap (FlatHashMap&& other) noexcept
+        : hashFunction (std::move (other.hashFunction)),
+          itemAllocator (std::move (other.itemAllocator)),
+          distanceAllocator (std::move (other.distanceAllocator)),
+          items (std::exchange (other.items, nullptr)),
+          distances (std::exchange (other.distances, nullptr)),
+          numSlots (std::exchange (other.numSlots, 0)),
+          numItems (std::exchange (other.numItems, 0)),
+          shift (std::exchange (other.shift, 32))
+    {
+    }
+
+    /** Replaces the contents of this map with a copy of another one. */
+    FlatHashMap& operator= (const FlatHashMap& other)
+    {
+        if (this != &other)
+        {
+            auto copy (other);
+            swapWith (copy);
+        }
+
+        return *this;
+    }
+
+    /** Replaces the contents of this map with those of another one. */
+    FlatHashMap& operator= (FlatHashMap&& other) noexcept
+    {
+        auto moved (std::move (other));
+        swapWith (moved);
+        return *this;
+    }
+
+    /** Destructor. */
+    ~FlatHashMap()
+    {
+        clear();
+        releaseStorage (items, distances, numSlots);
+    }
+
+    //==============================================================================
+    /** Returns the number of items in the map. */
+    int size() const noexcept                       { return numItems; }
+
+    /** Returns true if the map is empty. */
+    bool isEmpty() const noexcept                   { return numItems == 0; }
+
+    /** Returns the number of slots, which is always a power of two, or zero before anything is added. */
+    int getNumSlots() const noexcept                { return numSlots; }
+
+    /** Removes all the items, but keeps the memory that was allocated for them. */
+    void clear() noexcept
+    {
+        for (int i = 0; i < numSlots; ++i)
+        {
+            if (distances[i] != 0)
+            {
+                std::allocator_traits<ItemAllocator>::destroy (itemAllocator, items + i);
+                distances[i] = 0;
+            }
+        }
+
+        numItems = 0;
+    }
+
+    /** Makes sure that the map can hold at least this many items without having to grow. */
+    void reserve (int numItemsNeeded)
+    {
+        auto slotsNeeded = minimumNumSlots;
+
+        while (! hasSpaceFor (numItemsNeeded, slotsNeeded))
+            slotsNeeded *= 2;
+
+        if (slotsNeeded > numSlots)
+            rehash (slotsNeeded);
+    }
+
+    //==============================================================================
+    /** Returns a pointer to the value for a key, or nullptr if it isn't in the map.
+        The key can be any type that the hash function accepts and that can be compared with KeyType.
+    */
+    template <typename KeyToLookFor>
+    ValueType* find (const KeyToLookFor& key) noexcept
+    {
+        auto slot = findSlot (key);
+        return slot >= 0 ? &(items[slot].value) : nullptr;
+    }
+
+    /** Returns a pointer to the value for a key, or nullptr if it isn't in the map.
+        The key can be any type that the hash function accepts and that can be compared with KeyType.
+    */
+    template <typename KeyToLookFor>
+    const ValueType* find (const KeyToLookFor& key) const noexcept
+    {
+        auto slot = findSlot (key);
+        return slot >= 0 ? &(items[slot].value) : nullptr;
+    }
+
+    /** Returns true if the map contains the given key. */
+    template <typename KeyToLookFor>
+    bool contains (const KeyToLookFor& key) const noexcept
+    {
+        return findSlot (key) >= 0;
+    }
+
+    /** Returns a copy of the value for a key, or a default-constructed value if it isn't in the map. */
+    template <typename KeyToLookFor>
+    ValueType operator[] (const KeyToLookFor& key) const
+    {
+        if (auto* value = find (key))
+            return *value;
+
+        return ValueType();
+    }
+
+    /** Returns a reference to the value for a key, adding a default-constructed value if it isn't already there. */
+    ValueType& getReference (const KeyType& key)
+    {
+        if (auto* value = find (key))
+            return *value;
+
+        auto slot = insertNewItem (Item { key, ValueType() });
+        return items[slot].value;
+    }
+
+    /** Adds or replaces the value for a key, and returns a reference to it in the map. */
+    ValueType& set (const KeyType& key, ValueType value)
+    {
+        if (auto* existing = find (key))
+            return *existing = std::move (value);
+
+        auto slot = insertNewItem (Item { key, std::move (value) });
+        return items[slot].value;
+    }
+
+    /** Removes the item with the given key, returning false if there wasn't one. */
+    template <typename KeyToLookFor>
+    bool remove (const KeyToLookFor& key)
+    {
+        auto slot = findSlot (key);
+
+        if (slot < 0)
+            return false;
+
+        // shifting the following items back by one keeps every probe sequence unbroken,
+        // so there's no need for tombstones
+        for (auto next = (slot + 1) & (numSlots - 1); distances[next] > 1; next = (next + 1) & (numSlots - 1))
+        {
+            items[slot] = std::move (items[next]);
+            distances[slot] = (uint16) (distances[next] - 1);
+            slot = next;
+        }
+
+        std::allocator_traits<ItemAllocator>::destroy (itemAllocator, items + slot);
+        distances[slot] = 0;
+        --numItems;
+        return true;
+    }
+
+    /** Swaps the contents of this map with another one. */
+    void swapWith (FlatHashMap& other) noexcept
+    {
+        std::swap (hashFunction, other.hashFunction);
+        std::swap (itemAllocator, other.itemAllocator);
+        std::swap (distanceAllocator, other.distanceAllocator);
+        std::swap (items, other.items);
+        std::swap (distances, other.distances);
+        std::swap (numSlots, other.numSlots);
+        std::swap (numItems, other.numItems);
+        std::swap (shift, other.shift);
+    }
+
+    //==============================================================================
+    /** Iterates the items in the map, in no particular order. */
+    template <class MapType, class ItemType>
+    class IteratorBase
+    {
+    public:
+        IteratorBase (MapType& m, int startSlot) noexcept  : map (&m), slot (startSlot)   { skipEmptySlots(); }
+
+        ItemType& operator*() const noexcept        { return map->items[slot]; }
+        ItemType* operator->() const noexcept       { return map->items + slot; }
+
+        IteratorBase& operator++() noexcept         { ++slot; skipEmptySlots(); return *this; }
+
+        bool operator== (const IteratorBase& other) const noexcept  { return slot == other.slot; }
+        bool operator!= (const IteratorBase& other) const noexcept  { return slot != other.slot; }
+
+    private:
+        void skipEmptySlots() noexcept
+        {
+            while (slot < map->numSlots && map->distances[slot] == 0)
+                ++slot;
+        }
+
+        MapType* map;
+        int slot;
+    };
+
+    using Iterator      = IteratorBase<FlatHashMap, Item>;
+    using ConstIterator = IteratorBase<const FlatHashMap, const Item>;
+
+    Iterator begin() noexcept                   { return { *this, 0 }; }
+    Iterator end() noexcept                     { return { *this, numSlots }; }
+    ConstIterator begin() const noexcept        { return { *this, 0 }; }
+    ConstIterator end() const noexcept          { return { *this, numSlots }; }
+
+private:
+    //==============================================================================
+    using ItemAllocator     = typename std::allocator_traits<Allocator>::template rebind_alloc<Item>;
+    using DistanceAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<uint16>;
+
+    static constexpr int minimumNumSlots = 8;
+
+    HashFunctionType hashFunction;
+    ItemAllocator itemAllocator;
+    DistanceAllocator distanceAllocator;
+
+    // Each slot's distance is one more than how far its item is from the slot its hash
+    // points to, or zero if the slot is empty.
+    Item* items = nullptr;
+    uint16* distances = nullptr;
+    int numSlots = 0, numItems = 0, shift = 32;
+
+    static bool hasSpaceFor (int numItemsNeeded, int slots) noexcept
+    {
+        return (int64) numItemsNeeded * 8 <= (int64) slots * 7;
+    }
+
+    template <typename KeyToLookFor>
+    int getHomeSlot (const KeyToLookFor& key) const noexcept
+    {
+        // the hash is spread over the whole table with a Fibonacci multiplier, so that hash
+        // functions which leave the low bits unused (e.g. for pointers) still work well
+        auto hash = (uint32) hashFunction.generateHash (key, std::numeric_limits<int>::max());
+        return (int) ((hash * 0x9e3779b9u) >> shift);
+    }
+
+    template <typename KeyToLookFor>
+    int findSlot (const KeyToLookFor& key) const noexcept
+    {
+        // a string literal would otherwise be hashed as a pointer
+        if constexpr (std::is_same_v<KeyType, String> && ! std::is_class_v<KeyToLookFor> && std::is_convertible_v<const KeyToLookFor&, const char*>)
+            return findSlot (StringRef (key));
+
+        if (numItems == 0)
+            return -1;
+
+        auto slot = getHomeSlot (key);
+
+        for (uint32 distance = 1;; ++distance)
+        {
+            // an item that is closer to its home slot than we are to ours means the key
+            // would have been placed here if it was in the map
+            if (distances[slot] < distance)
+                return -1;
+
+            if (items[slot].key == key)
+                return slot;
+
+            slot = (slot + 1) & (numSlots - 1);
+        }
+    }
+
+    int insertNewItem (Item newItem)
+    {
+        if (! hasSpaceFor (numItems + 1, numSlots))
+            rehash (jmax (minimumNumSlots, numSlots * 2));
+
+        auto slot = getHomeSlot (newItem.key);
+        int newItemSlot = -1;
+
+        for (uint32 distance = 1;; ++distance)
+        {
+            jassert (distance <= std::numeric_limits<uint16>::max()); // your hash function is giving too many keys the same hash!
+
+            if (distances[slot] == 0)
+            {
+                std::allocator_traits<ItemAllocator>::construct (itemAllocator, items + slot, std::move (newItem));
+                distances[slot] = (uint16) distance;
+                ++numItems;
+                return newItemSlot >= 0 ? newItemSlot : slot;
+            }
+
+            // Robin Hood: take the place of an item that is closer to its home slot, and
+            // carry on looking for somewhere to put that one instead
+            if (distances[slot] < distance)
+            {
+                std::swap (newItem, items[slot]);
+                distance = std::exchange (distances[slot], (uint16) distance);
+
+                if (newItemSlot < 0)
+                    newItemSlot = slot;
+            }
+
+            slot = (slot + 1) & (numSlots - 1);
+        }
+    }
+
+    void rehash (int newNumSlots)
+    {
+        jassert (isPowerOfTwo (newNumSlots) && hasSpaceFor (numItems, newNumSlots));
+
+        auto* oldItems = std::exchange (items, std::allocator_traits<ItemAllocator>::allocate (itemAllocator, (size_t) newNumSlots));
+        auto* oldDistances = std::exchange (distances, std::allocator_traits<DistanceAllocator>::allocate (distanceAllocator, (size_t) newNumSlots));
+        auto oldNumSlots = std::exchange (numSlots, newNumSlots);
+
+        std::fill (distances, distances + numSlots, (uint16) 0);
+        shift = 32 - countNumberOfBits ((uint32) (numSlots - 1));
+        numItems = 0;
+
+        for (int i = 0; i < oldNumSlots; ++i)
+        {
+            if (oldDistances[i] != 0)
+            {
+                insertNewItem (std::move (oldItems[i]));
+                std::allocator_traits<ItemAllocator>::destroy (itemAllocator, oldItems + i);
+            }
+        }
+
+        releaseStorage (oldItems, oldDistances, oldNumSlots);
+    }
+
+    void releaseStorage (Item* itemsToRelease, uint16* distancesToRelease, int slots) noexcept
+    {
+        if (slots > 0)
+        {
+            std::allocator_traits<ItemAllocator>::deallocate (itemAllocator, itemsToRelease, (size_t) slots);
+            std::allocator_traits<DistanceAllocator>::deallocate (distanceAllocator, distancesToRelease, (size_t) slots);
+        }
+    }
+
+    JUCE_LEAK_DETECTOR (FlatHashMap)
+};
+
+} // namespace juce
@@ -0,0 +1,192 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class FlatHashMapTests final : public UnitTest
+{
+public:
+    FlatHashMapTests()
+        : UnitTest ("FlatHashMap", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Random insertions and removals match std::map");
+        {
+            auto random = getRandom();
+            FlatHashMap<int, int> map;
+            std::map<int, int> groundTruth;
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                const auto key = random.nextInt (500);
+
+                if (random.nextInt (3) == 0)
+                {
+                    expect (map.remove (key) == (groundTruth.erase (key) != 0));
+                }
+                else
+                {
+                    const auto value = random.nextInt();
+                    map.set (key, value);
+                    groundTruth[key] = value;
+                }
+
+                expectEquals (map.size(), (int) groundTruth.size());
+            }
+
+            for (int key = 0; key < 500; ++key)
+            {
+                const auto iter = groundTruth.find (key);
+                const auto* value = map.find (key);
+
+                expect ((value != nullptr) == (iter != groundTruth.end()));
+
+                if (value != nullptr && iter != groundTruth.end())
+                    expectEquals (*value, iter->second);
+            }
+
+            int numIterated = 0;
+
+            for (auto& item : map)
+            {
+                expectEquals (item.value, groundTruth[item.key]);
+                ++numIterated;
+            }
+
+            expectEquals (numIterated, (int) groundTruth.size());
+        }
+
+        beginTest ("String keys can be looked up without creating a String");
+        {
+            FlatHashMap<String, int> map;
+
+            for (int i = 0; i < 100; ++i)
+                map.set ("key" + String (i), i);
+
+            expectEquals (map["key42"], 42);
+            expectEquals (map[StringRef ("key7")], 7);
+            expect (map.contains (String ("key99")));
+            expect (! map.contains ("key100"));
+            expect (map.remove (StringRef ("key0")));
+            expect (map.find ("key0") == nullptr);
+            expectEquals (map.size(), 99);
+
+            expectEquals (DefaultHashFunctions::generateHash (StringRef ("abc"), 1000),
+                          DefaultHashFunctions::generateHash (String ("abc"), 1000));
+        }
+
+        beginTest ("getReference adds default values");
+        {
+            FlatHashMap<int, String> map;
+            expect (map.getReference (3).isEmpty());
+            map.getReference (3) << "abc";
+            expectEquals (map[3], String ("abc"));
+            expectEquals (map.size(), 1);
+        }
+
+        beginTest ("Copies and moves");
+        {
+            FlatHashMap<String, String> map;
+
+            for (int i = 0; i < 50; ++i)
+                map.set (String (i), String (i * 2));
+
+            auto copy = map;
+            map.clear();
+            expect (map.isEmpty());
+            expectEquals (copy.size(), 50);
+            expectEquals (copy["25"], String ("50"));
+
+            auto moved = std::move (copy);
+            expectEquals (moved.size(), 50);
+            expectEquals (copy.size(), 0);
+            expect (copy.find ("1") == nullptr);
+
+            map = moved;
+            expectEquals (map["49"], String ("98"));
+        }
+
+        beginTest ("Reserving space avoids rehashing");
+        {
+            FlatHashMap<int, int> map;
+            map.reserve (1000);
+            const auto numSlots = map.getNumSlots();
+
+            for (int i = 0; i < 1000; ++i)
+                map.set (i * 4096, i);
+
+            expectEquals (map.getNumSlots(), numSlots);
+
+            for (int i = 0; i < 1000; ++i)
+                expectEquals (map[i * 4096], i);
+        }
+
+        beginTest ("Custom allocators are used");
+        {
+            int numAllocations = 0;
+            FlatHashMap<int, int, DefaultHashFunctions, CountingAllocator<std::pair<int, int>>> map ({}, CountingAllocator<std::pair<int, int>> (numAllocations));
+
+            for (int i = 0; i < 100; ++i)
+                map.set (i, i);
+
+            expect (numAllocations > 0);
+        }
+    }
+
+private:
+    template <typename Type>
+    struct CountingAllocator
+    {
+        using value_type = Type;
+
+        explicit CountingAllocator (int& counter) noexcept  : numAllocations (&counter) {}
+
+        template <typename Other>
+        CountingAllocator (const CountingAllocator<Other>& other) noexcept  : numAllocations (other.numAllocations) {}
+
+        Type* allocate (size_t n)
+        {
+            ++*numAllocations;
+            return std::allocator<Type>().allocate (n);
+        }
+
+        void deallocate (Type* p, size_t n) noexcept
+        {
+            std::allocator<Type>().deallocate (p, n);
+        }
+
+        template <typename Other>
+        bool operator== (const CountingAllocator<Other>& other) const noexcept  { return numAllocations == other.numAllocations; }
+
+        template <typename Other>
+        bool operator!= (const CountingAllocator<Other>& other) const noexcept  { return numAllocations != other.numAllocations; }
+
+        int* numAllocations;
+    };
+};
+
+static FlatHashMapTests flatHashMapTests;
+
+} // namespace juce
@@ -58,32 +58,63 @@ bool NamedValueSet::NamedValue::operator!= (const NamedValue& other) const noexc
 NamedValueSet::NamedValueSet() noexcept {}
 NamedValueSet::~NamedValueSet() noexcept {}
 
-NamedValueSet::NamedValueSet (const NamedValueSet& other)  : values (other.values) {}
+NamedValueSet::NamedValueSet (const NamedValueSet& other)
+   : values (other.values),
+     nameIndex (other.nameIndex != nullptr ? std::make_unique<Index> (*other.nameIndex) : nullptr)
+{
+}
 
 NamedValueSet::NamedValueSet (NamedValueSet&& other) noexcept
-   : values (std::move (other.values)) {}
+   : values (std::move (other.values)),
+     nameIndex (std::move (other.nameIndex))
+{
+}
 
 NamedValueSet::NamedValueSet (std::initializer_list<NamedValue> list)
    : values (std::move (list))
 {
+    updateIndex();
 }
 
 NamedValueSet& NamedValueSet::operator= (const NamedValueSet& other)
 {
     clear();
     values = other.values;
+    updateIndex();
     return *this;
 }
 
 NamedValueSet& NamedValueSet::operator= (NamedValueSet&& other) noexcept
 {
     other.values.swapWith (values);
+    std::swap (other.nameIndex, nameIndex);
     return *this;
 }
 
 void NamedValueSet::clear()
 {
     values.clear();
+    nameIndex.reset();
+}
+
+void NamedValueSet::updateIndex()
+{
+    if (values.size() < minNumValuesToIndex)
+    {
+        nameIndex.reset();
+        return;
+    }
+
+    if (nameIndex == nullptr)
+        nameIndex = std::make_unique<Index>();
+
+    nameIndex->clear();
+    nameIndex->reserve (values.size());
+
+    // if a name appears more than once, the index has to find the first one, as a linear search would
+    for (int i = 0; i < values.size(); ++i)
+        if (auto key = getIndexKey (values.getReference (i).name); ! nameIndex->contains (key))
+            nameIndex->set (key, i);
 }
 
 bool NamedValueSet::operator== (const NamedValueSet& other) const noexcept
@@ -149,6 +180,14 @@ var NamedValueSet::getWithDefault (const Identifier& name, const var& defaultRet
 
 var* NamedValueSet::getVarPointer (const Identifier& name) noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        if (auto* i = nameIndex->find (getIndexKey (name)))
+            return &(values.getReference (*i).value);
+
+        return {};
+    }
+
     for (auto& i : values)
         if (i.name == name)
             return &(i.value);
@@ -158,6 +197,14 @@ var* NamedValueSet::getVarPointer (const Identifier& name) noexcept
 
 const var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        if (auto* i = nameIndex->find (getIndexKey (name)))
+            return &(values.getReference (*i).value);
+
+        return {};
+    }
+
     for (auto& i : values)
         if (i.name == name)
             return &(i.value);
@@ -177,6 +224,12 @@ bool NamedValueSet::set (const Identifier& name, var&& newValue)
     }
 
     values.add ({ name, std::move (newValue) });
+
+    if (nameIndex != nullptr)
+        nameIndex->set (getIndexKey (name), values.size() - 1);
+    else if (values.size() >= minNumValuesToIndex)
+        updateIndex();
+
     return true;
 }
 
@@ -192,6 +245,12 @@ bool NamedValueSet::set (const Identifier& name, const var& newValue)
     }
 
     values.add ({ name, newValue });
+
+    if (nameIndex != nullptr)
+        nameIndex->set (getIndexKey (name), values.size() - 1);
+    else if (values.size() >= minNumValuesToIndex)
+        updateIndex();
+
     return true;
 }
 
@@ -202,6 +261,14 @@ bool NamedValueSet::contains (const Identifier& name) const noexcept
 
 int NamedValueSet::indexOf (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        if (auto* i = nameIndex->find (getIndexKey (name)))
+            return *i;
+
+        return -1;
+    }
+
     auto numValues = values.size();
 
     for (int i = 0; i < numValues; ++i)
@@ -220,6 +287,10 @@ bool NamedValueSet::remove (const Identifier& name)
         if (values.getReference (i).name == name)
         {
             values.remove (i);
+
+            if (nameIndex != nullptr)
+                updateIndex();
+
             return true;
         }
     }
@@ -280,6 +351,8 @@ void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 
         values.add ({ att->name, var (att->value) });
     }
+
+    updateIndex();
 }
 
 void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
@@ -303,4 +376,91 @@ void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
     }
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class NamedValueSetTests final : public UnitTest
+{
+public:
+    NamedValueSetTests()
+        : UnitTest ("NamedValueSet", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Large sets find the same values as small ones");
+        {
+            NamedValueSet set;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                expect (set.set (getName (i), i));
+                expect (! set.set (getName (i), i));
+
+                for (int j = 0; j <= i; ++j)
+                {
+                    expectEquals ((int) set[getName (j)], j);
+                    expectEquals (set.indexOf (getName (j)), j);
+                }
+
+                expect (! set.contains (getName (i + 1)));
+                expectEquals (set.indexOf (getName (i + 1)), -1);
+            }
+
+            for (int i = 0; i < 100; i += 2)
+                expect (set.remove (getName (i)));
+
+            expectEquals (set.size(), 50);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                expect (set.contains (getName (i)) == ((i & 1) != 0));
+
+                if ((i & 1) != 0)
+                {
+                    expectEquals ((int) set[getName (i)], i);
+                    expectEquals (set.indexOf (getName (i)), i / 2);
+                    expect (set.getName (i / 2) == getName (i));
+                }
+            }
+
+            NamedValueSet copy (set);
+            NamedValueSet moved (std::move (copy));
+            expect (moved == set);
+
+            set.clear();
+            expect (! set.contains (getName (1)));
+            expectEquals ((int) moved[getName (99)], 99);
+
+            set = moved;
+            expectEquals (set.indexOf (getName (99)), 49);
+        }
+
+        beginTest ("The first of several values with the same name is found");
+        {
+            const NamedValueSet set { { "a", 0 }, { "b", 1 }, { "c", 2 }, { "d", 3 }, { "e", 4 }, { "f", 5 },
+                                      { "g", 6 }, { "h", 7 }, { "i", 8 }, { "j", 9 }, { "k", 10 }, { "l", 11 },
+                                      { "a", 12 }, { "b", 13 }, { "c", 14 }, { "d", 15 }, { "e", 16 }, { "f", 17 } };
+
+            for (int i = 0; i < set.size(); ++i)
+            {
+                expectEquals ((int) set[set.getName (i)], i % 12);
+                expectEquals (set.indexOf (set.getName (i)), i % 12);
+            }
+        }
+    }
+
+private:
+    static Identifier getName (int i)
+    {
+        return "name" + String (i);
+    }
+};
+
+static NamedValueSetTests namedValueSetTests;
+
+#endif
+
 } // namespace juce
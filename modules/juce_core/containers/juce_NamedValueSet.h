@@ -29,6 +29,10 @@ namespace juce
     This can be used as a basic structure to hold a set of var object, which can
     be retrieved by using their identifier.
 
+    Small sets are searched linearly, but once a set holds more than a handful of
+    values it also keeps a hash index of their names, so that lookups in large sets
+    don't get slower as more values are added. The order of the values is unaffected.
+
     @tags{Core}
 */
 class JUCE_API  NamedValueSet
@@ -179,7 +183,16 @@ public:
 
 private:
     //==============================================================================
+    static constexpr int minNumValuesToIndex = 16;
+
+    using Index = FlatHashMap<const void*, int>;
+
+    static const void* getIndexKey (const Identifier& name) noexcept   { return name.getCharPointer().getAddress(); }
+
+    void updateIndex();
+
     Array<NamedValue> values;
+    std::unique_ptr<Index> nameIndex;
 };
 
 } // namespace juce
@@ -0,0 +1,462 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A lock-free, single-producer, single-consumer queue of objects.
+
+    This holds its items in a ring buffer whose capacity is rounded up to a power
+    of two. One thread may add items and one other thread may remove them, without
+    any locking, so it's suitable for passing data to or from a realtime thread.
+
+    Unlike AbstractFifo, which only manages the indices into a buffer that you
+    provide, this owns its storage. It also keeps the reader's and writer's positions
+    on separate cache lines, and each side caches the other side's position, so the
+    two threads rarely have to touch the same memory.
+
+    Items can be added and removed one at a time with push() and pop(), copied in
+    bulk, or written and read in place by asking for the blocks of contiguous storage
+    that are available:
+    @code
+    SpscRingBuffer<float> ring (4096);
+
+    // On the producer thread..
+    {
+        auto scope = ring.write (numSamples);
+
+        scope.forEach ([&] (float& f) { f = nextSample(); });
+    } // the items are published here
+
+    // On the consumer thread..
+    {
+        auto scope = ring.read (ring.getNumReady());
+        consume (scope.block1);
+        consume (scope.block2);
+    } // the space is handed back to the producer here
+    @endcode
+
+    The getNumReady() and getFreeSpace() methods are wait-free, and can be called
+    from any thread, although the answers may be out of date by the time they return
+    if the other thread is active.
+
+    @see MpmcRingBuffer, AbstractFifo
+
+    @tags{Core}
+*/
+template <typename Type>
+class SpscRingBuffer
+{
+public:
+    //==============================================================================
+    /** Creates a ring buffer that can hold at least the given number of items.
+        The items are default-constructed, so Type must be default-constructible.
+    */
+    explicit SpscRingBuffer (int minimumCapacity)
+        : capacity ((uint32) nextPowerOfTwo (jmax (1, minimumCapacity))),
+          mask (capacity - 1),
+          items (std::make_unique<Type[]> (capacity))
+    {
+    }
+
+    /** Returns the number of items that the buffer can hold. */
+    int getCapacity() const noexcept                { return (int) capacity; }
+
+    /** Returns the number of items that are currently waiting to be read. */
+    int getNumReady() const noexcept
+    {
+        auto readPosition = consumer.position.load (std::memory_order_acquire);
+        auto writePosition = producer.position.load (std::memory_order_acquire);
+        return (int) jmin (capacity, writePosition - readPosition);
+    }
+
+    /** Returns the number of items that could currently be added. */
+    int getFreeSpace() const noexcept               { return (int) capacity - getNumReady(); }
+
+    //==============================================================================
+    /** Adds an item, returning false if the buffer is full. Call this only from the producer thread. */
+    bool push (const Type& item)                    { return pushImpl (item); }
+
+    /** Adds an item, returning false if the buffer is full. Call this only from the producer thread. */
+    bool push (Type&& item)                         { return pushImpl (std::move (item)); }
+
+    /** Removes the next item, returning false if the buffer is empty. Call this only from the consumer thread. */
+    bool pop (Type& result)
+    {
+        auto position = consumer.position.load (std::memory_order_relaxed);
+
+        if (position == consumer.otherPosition)
+        {
+            consumer.otherPosition = producer.position.load (std::memory_order_acquire);
+
+            if (position == consumer.otherPosition)
+                return false;
+        }
+
+        result = std::move (items[position & mask]);
+        consumer.position.store (position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Copies as many items as will fit from an array, returning the number that were added.
+        Call this only from the producer thread.
+    */
+    int push (const Type* source, int numItems)
+    {
+        auto blocks = prepareToWrite (numItems);
+        std::copy (source, source + blocks.block1.size(), blocks.block1.begin());
+        std::copy (source + blocks.block1.size(), source + blocks.size(), blocks.block2.begin());
+        finishedWrite (blocks.size());
+        return blocks.size();
+    }
+
+    /** Moves up to the given number of items into an array, returning the number that were removed.
+        Call this only from the consumer thread.
+    */
+    int pop (Type* destination, int maxNumItems)
+    {
+        auto blocks = prepareToRead (maxNumItems);
+        destination = std::move (blocks.block1.begin(), blocks.block1.end(), destination);
+        std::move (blocks.block2.begin(), blocks.block2.end(), destination);
+        finishedRead (blocks.size());
+        return blocks.size();
+    }
+
+    //==============================================================================
+    /** A pair of contiguous regions of the buffer's storage.
+        Because a region can wrap around the end of the buffer, the items may be split
+        across two blocks, in which case block1 comes first.
+    */
+    struct Blocks
+    {
+        Span<Type> block1, block2;
+
+        /** Returns the total number of items in the two blocks. */
+        int size() const noexcept       { return (int) (block1.size() + block2.size()); }
+
+        /** Calls a function with a reference to each item in the blocks, in order. */
+        template <typename FunctionToApply>
+        void forEach (FunctionToApply&& func) const
+        {
+            for (auto& item : block1)  func (item);
+            for (auto& item : block2)  func (item);
+        }
+    };
+
+    /** Returns the storage into which up to the given number of items can be written.
+        The blocks may be smaller than the number of items asked for, if there isn't
+        enough space. After filling some or all of them, call finishedWrite() to publish
+        the new items. Call this only from the producer thread.
+    */
+    Blocks prepareToWrite (int numWanted) noexcept
+    {
+        auto position = producer.position.load (std::memory_order_relaxed);
+        auto numFree = capacity - (position - producer.otherPosition);
+
+        if (numFree < (uint32) numWanted)
+        {
+            producer.otherPosition = consumer.position.load (std::memory_order_acquire);
+            numFree = capacity - (position - producer.otherPosition);
+        }
+
+        return getBlocks (position, jmin (numFree, (uint32) jmax (0, numWanted)));
+    }
+
+    /** Publishes items that were written into the blocks returned by prepareToWrite(). */
+    void finishedWrite (int numWritten) noexcept
+    {
+        auto position = producer.position.load (std::memory_order_relaxed);
+        jassert (numWritten >= 0 && (uint32) numWritten <= capacity - (position - producer.otherPosition));
+        producer.position.store (position + (uint32) numWritten, std::memory_order_release);
+    }
+
+    /** Returns the storage holding up to the given number of items that are ready to be read.
+        After using some or all of them, call finishedRead() to give the space back to the
+        producer. Call this only from the consumer thread.
+    */
+    Blocks prepareToRead (int numWanted) noexcept
+    {
+        auto position = consumer.position.load (std::memory_order_relaxed);
+        auto numReady = consumer.otherPosition - position;
+
+        if (numReady < (uint32) numWanted)
+        {
+            consumer.otherPosition = producer.position.load (std::memory_order_acquire);
+            numReady = consumer.otherPosition - position;
+        }
+
+        return getBlocks (position, jmin (numReady, (uint32) jmax (0, numWanted)));
+    }
+
+    /** Frees the space used by items that were read from the blocks returned by prepareToRead(). */
+    void finishedRead (int numRead) noexcept
+    {
+        auto position = consumer.position.load (std::memory_order_relaxed);
+        jassert (numRead >= 0 && (uint32) numRead <= consumer.otherPosition - position);
+        consumer.position.store (position + (uint32) numRead, std::memory_order_release);
+    }
+
+    //==============================================================================
+    /** A set of blocks which calls finishedRead() or finishedWrite() for all of its items
+        when it goes out of scope.
+        @see read, write
+    */
+    template <bool isWrite>
+    class ScopedBlocks  : public Blocks
+    {
+    public:
+        ScopedBlocks (SpscRingBuffer& r, Blocks b) noexcept  : Blocks (b), ring (&r) {}
+
+        ScopedBlocks (ScopedBlocks&& other) noexcept  : Blocks (other), ring (std::exchange (other.ring, nullptr)) {}
+
+        ~ScopedBlocks()
+        {
+            if (ring != nullptr)
+            {
+                if constexpr (isWrite)
+                    ring->finishedWrite (this->size());
+                else
+                    ring->finishedRead (this->size());
+            }
+        }
+
+    private:
+        SpscRingBuffer* ring;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedBlocks)
+    };
+
+    using ScopedRead  = ScopedBlocks<false>;
+    using ScopedWrite = ScopedBlocks<true>;
+
+    /** Returns the blocks into which up to the given number of items can be written.
+        They're published automatically when the returned object is deleted.
+    */
+    ScopedWrite write (int numToWrite) noexcept     { return { *this, prepareToWrite (numToWrite) }; }
+
+    /** Returns the blocks holding up to the given number of items that are ready to be read.
+        Their space is freed automatically when the returned object is deleted.
+    */
+    ScopedRead read (int numToRead) noexcept        { return { *this, prepareToRead (numToRead) }; }
+
+private:
+    //==============================================================================
+    // Each side's position, along with the last position that it saw for the other side
+    struct alignas (hardwareDestructiveInterferenceSize) Side
+    {
+        std::atomic<uint32> position { 0 };
+        uint32 otherPosition = 0;
+    };
+
+    const uint32 capacity, mask;
+    std::unique_ptr<Type[]> items;
+    Side producer, consumer;
+
+    Blocks getBlocks (uint32 position, uint32 num) const noexcept
+    {
+        auto start = position & mask;
+        auto size1 = jmin (num, capacity - start);
+        return { { items.get() + start, (size_t) size1 }, { items.get(), (size_t) (num - size1) } };
+    }
+
+    template <typename ItemType>
+    bool pushImpl (ItemType&& item)
+    {
+        auto position = producer.position.load (std::memory_order_relaxed);
+
+        if (position - producer.otherPosition == capacity)
+        {
+            producer.otherPosition = consumer.position.load (std::memory_order_acquire);
+
+            if (position - producer.otherPosition == capacity)
+                return false;
+        }
+
+        items[position & mask] = std::forward<ItemType> (item);
+        producer.position.store (position + 1, std::memory_order_release);
+        return true;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (SpscRingBuffer)
+};
+
+//==============================================================================
+/**
+    A lock-free, bounded queue that any number of threads can add items to and
+    remove items from.
+
+    Each slot in the queue has its own sequence number, which tells producers and
+    consumers whether the slot is ready for them, so that threads only contend with
+    each other when they're trying to claim the same slot. The positions used by the
+    producers and consumers are kept on separate cache lines.
+
+    Because another thread may claim any slot at any time, there's no way of handing
+    out contiguous blocks of storage without making other threads wait, so unlike
+    SpscRingBuffer, this class only moves items one at a time, or copies them in bulk.
+
+    @see SpscRingBuffer
+
+    @tags{Core}
+*/
+template <typename Type>
+class MpmcRingBuffer
+{
+public:
+    //==============================================================================
+    /** Creates a queue that can hold at least the given number of items.
+        The items are default-constructed, so Type must be default-constructible.
+    */
+    explicit MpmcRingBuffer (int minimumCapacity)
+        : capacity ((uint32) nextPowerOfTwo (jmax (2, minimumCapacity))),
+          mask (capacity - 1),
+          cells (std::make_unique<Cell[]> (capacity))
+    {
+        for (uint32 i = 0; i < capacity; ++i)
+            cells[i].sequence.store (i, std::memory_order_relaxed);
+    }
+
+    /** Returns the number of items that the queue can hold. */
+    int getCapacity() const noexcept                { return (int) capacity; }
+
+    /** Returns the approximate number of items in the queue.
+        This is wait-free, but if other threads are active, the answer may be out of
+        date by the time it returns.
+    */
+    int getNumReady() const noexcept
+    {
+        auto readPosition = dequeuePosition->load (std::memory_order_acquire);
+        auto writePosition = enqueuePosition->load (std::memory_order_acquire);
+        return (int) jmin (capacity, (uint32) jmax (0, (int32) (writePosition - readPosition)));
+    }
+
+    /** Returns the approximate number of items that could be added. */
+    int getFreeSpace() const noexcept               { return (int) capacity - getNumReady(); }
+
+    //==============================================================================
+    /** Adds an item, returning false if the queue is full. */
+    bool push (const Type& item)                    { return pushImpl (item); }
+
+    /** Adds an item, returning false if the queue is full. */
+    bool push (Type&& item)                         { return pushImpl (std::move (item)); }
+
+    /** Removes the oldest item, returning false if the queue is empty. */
+    bool pop (Type& result)
+    {
+        auto position = dequeuePosition->load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& cell = cells[position & mask];
+            auto difference = (int32) (cell.sequence.load (std::memory_order_acquire) - (position + 1));
+
+            if (difference == 0)
+            {
+                if (dequeuePosition->compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                {
+                    result = std::move (cell.item);
+                    cell.sequence.store (position + capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = dequeuePosition->load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Copies as many items as will fit from an array, returning the number that were added.
+        Other threads' items may be interleaved with these ones.
+    */
+    int push (const Type* source, int numItems)
+    {
+        int numPushed = 0;
+
+        while (numPushed < numItems && push (source[numPushed]))
+            ++numPushed;
+
+        return numPushed;
+    }
+
+    /** Moves up to the given number of items into an array, returning the number that were removed. */
+    int pop (Type* destination, int maxNumItems)
+    {
+        int numPopped = 0;
+
+        while (numPopped < maxNumItems && pop (destination[numPopped]))
+            ++numPopped;
+
+        return numPopped;
+    }
+
+private:
+    //==============================================================================
+    struct Cell
+    {
+        std::atomic<uint32> sequence { 0 };
+        Type item {};
+    };
+
+    const uint32 capacity, mask;
+    std::unique_ptr<Cell[]> cells;
+    CacheLinePadded<std::atomic<uint32>> enqueuePosition { 0u }, dequeuePosition { 0u };
+
+    template <typename ItemType>
+    bool pushImpl (ItemType&& item)
+    {
+        auto position = enqueuePosition->load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& cell = cells[position & mask];
+            auto difference = (int32) (cell.sequence.load (std::memory_order_acquire) - position);
+
+            if (difference == 0)
+            {
+                if (enqueuePosition->compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.item = std::forward<ItemType> (item);
+                    cell.sequence.store (position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = enqueuePosition->load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (MpmcRingBuffer)
+};
+
+} // namespace juce
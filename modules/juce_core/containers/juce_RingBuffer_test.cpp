@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class RingBufferTests  : public UnitTest
+{
+public:
+    RingBufferTests()
+        : UnitTest ("RingBuffer", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("SpscRingBuffer single items");
+        {
+            SpscRingBuffer<String> ring (3);
+            expectEquals (ring.getCapacity(), 4);
+
+            for (int i = 0; i < 4; ++i)
+                expect (ring.push (String (i)));
+
+            expect (! ring.push ("x"));
+            expectEquals (ring.getNumReady(), 4);
+            expectEquals (ring.getFreeSpace(), 0);
+
+            String s;
+            expect (ring.pop (s) && s == "0");
+            expect (ring.push ("4"));
+
+            for (int i = 1; i < 5; ++i)
+                expect (ring.pop (s) && s == String (i));
+
+            expect (! ring.pop (s));
+        }
+
+        beginTest ("SpscRingBuffer blocks wrap around");
+        {
+            SpscRingBuffer<int> ring (8);
+            int source[] = { 1, 2, 3, 4, 5, 6 };
+            int dest[8] = {};
+
+            expectEquals (ring.push (source, 6), 6);
+            expectEquals (ring.pop (dest, 5), 5);
+
+            {
+                auto scope = ring.write (6);
+                expectEquals ((int) scope.block1.size(), 2);
+                expectEquals ((int) scope.block2.size(), 4);
+
+                int n = 10;
+                scope.forEach ([&] (int& i) { i = n++; });
+            }
+
+            expectEquals (ring.getNumReady(), 7);
+            expectEquals (ring.push (source, 6), 1);
+
+            {
+                auto blocks = ring.prepareToRead (8);
+                expectEquals (blocks.size(), 8);
+                expectEquals (blocks.block1[0], 6);
+                expectEquals (blocks.block2[0], 12);
+                ring.finishedRead (2);
+            }
+
+            expectEquals (ring.pop (dest, 8), 6);
+            expect (dest[0] == 11 && dest[4] == 15 && dest[5] == 1);
+        }
+
+        beginTest ("SpscRingBuffer between threads");
+        {
+            SpscRingBuffer<int> ring (64);
+            constexpr int numItems = 100000;
+
+            std::thread producer ([&]
+            {
+                for (int next = 0; next < numItems;)
+                {
+                    auto scope = ring.write (jmin (7, numItems - next));
+                    scope.forEach ([&] (int& i) { i = next++; });
+                }
+            });
+
+            int expected = 0;
+            auto allInOrder = true;
+
+            while (expected < numItems)
+            {
+                int item;
+
+                if (ring.pop (item))
+                    allInOrder = allInOrder && item == expected++;
+            }
+
+            producer.join();
+            expect (allInOrder);
+        }
+
+        beginTest ("MpmcRingBuffer");
+        {
+            MpmcRingBuffer<int> ring (5);
+            expectEquals (ring.getCapacity(), 8);
+
+            int source[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+            expectEquals (ring.push (source, 9), 8);
+            expectEquals (ring.getNumReady(), 8);
+
+            int dest[4] = {};
+            expectEquals (ring.pop (dest, 4), 4);
+            expect (dest[0] == 1 && dest[3] == 4);
+            expectEquals (ring.getFreeSpace(), 4);
+        }
+
+        beginTest ("MpmcRingBuffer between threads");
+        {
+            MpmcRingBuffer<int> ring (128);
+            constexpr int numThreads = 3, numItemsPerThread = 20000;
+            std::atomic<int64> total { 0 };
+            std::atomic<int> numPopped { 0 };
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < numThreads; ++t)
+            {
+                threads.emplace_back ([&ring, t]
+                {
+                    for (int i = 0; i < numItemsPerThread;)
+                        if (ring.push (t * numItemsPerThread + i))
+                            ++i;
+                });
+
+                threads.emplace_back ([&]
+                {
+                    while (numPopped.load() < numThreads * numItemsPerThread)
+                    {
+                        int item;
+
+                        if (ring.pop (item))
+                        {
+                            total += item;
+                            ++numPopped;
+                        }
+                    }
+                });
+            }
+
+            for (auto& t : threads)
+                t.join();
+
+            const auto n = (int64) numThreads * numItemsPerThread;
+            expectEquals (numPopped.load(), (int) n);
+            expectEquals (total.load(), n * (n - 1) / 2);
+        }
+    }
+};
+
+static RingBufferTests ringBufferTests;
+
+} // namespace juce
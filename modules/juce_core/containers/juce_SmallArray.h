@@ -0,0 +1,513 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An array that keeps its first few elements inside the object itself.
+
+    This works like Array, but the first inlineCapacity elements are stored in a
+    buffer inside the SmallArray object, so that small arrays don't need any heap
+    allocation at all. If more elements are added, they're all moved to a heap block,
+    which grows in the same way as Array's does.
+
+    This is a good choice for things like lists of channels or rectangles, which
+    usually only hold a handful of items, but are created and destroyed very often.
+    Bear in mind that the object itself is bigger than an Array, and that moving or
+    swapping a SmallArray which is using its inline storage has to move the elements
+    themselves, rather than just a pointer.
+
+    Unlike Array, this class doesn't have any locking options, and it doesn't provide
+    the sorting and searching helpers - if you need those, use an Array.
+
+    @see Array
+
+    @tags{Core}
+*/
+template <typename ElementType, int inlineCapacity>
+class SmallArray
+{
+public:
+    //==============================================================================
+    /** Creates an empty array. */
+    SmallArray() noexcept = default;
+
+    /** Creates a copy of another array. */
+    SmallArray (const SmallArray& other)                    { addArray (other); }
+
+    /** Moves the contents of another array into this one. */
+    SmallArray (SmallArray&& other) noexcept                { takeContentsOf (other); }
+
+    /** Creates an array from a list of items. */
+    SmallArray (std::initializer_list<ElementType> items)   { addArray (items); }
+
+    /** Destructor. */
+    ~SmallArray()                                           { clear(); }
+
+    /** Copies another array. */
+    SmallArray& operator= (const SmallArray& other)
+    {
+        if (this != &other)
+        {
+            clearQuick();
+            addArray (other);
+        }
+
+        return *this;
+    }
+
+    /** Moves the contents of another array into this one. */
+    SmallArray& operator= (SmallArray&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            takeContentsOf (other);
+        }
+
+        return *this;
+    }
+
+    //==============================================================================
+    /** Compares this array to another one.
+        Two arrays are considered equal if they both contain the same set of elements,
+        in the same order.
+    */
+    template <class OtherArrayType>
+    bool operator== (const OtherArrayType& other) const
+    {
+        if (size() != (int) other.size())
+            return false;
+
+        auto* e = begin();
+
+        for (auto& o : other)
+            if (! (*e++ == o))
+                return false;
+
+        return true;
+    }
+
+    /** Compares this array to another one. */
+    template <class OtherArrayType>
+    bool operator!= (const OtherArrayType& other) const     { return ! operator== (other); }
+
+    //==============================================================================
+    /** Returns the current number of elements in the array. */
+    int size() const noexcept                               { return numUsed; }
+
+    /** Returns true if the array is empty. */
+    bool isEmpty() const noexcept                           { return numUsed == 0; }
+
+    /** Returns true if the elements are being kept in the object's inline buffer,
+        rather than on the heap.
+    */
+    bool isUsingInlineStorage() const noexcept              { return elements == getInlineStorage(); }
+
+    /** Returns one of the elements in the array, or a default-constructed element
+        if the index is out of range.
+    */
+    ElementType operator[] (int index) const
+    {
+        return isPositiveAndBelow (index, numUsed) ? elements[index] : ElementType();
+    }
+
+    /** Returns one of the elements in the array, without checking the index passed in. */
+    ElementType getUnchecked (int index) const
+    {
+        jassert (isPositiveAndBelow (index, numUsed));
+        return elements[index];
+    }
+
+    /** Returns a direct reference to one of the elements in the array, without checking the index passed in. */
+    ElementType& getReference (int index) noexcept
+    {
+        jassert (isPositiveAndBelow (index, numUsed));
+        return elements[index];
+    }
+
+    /** Returns a direct reference to one of the elements in the array, without checking the index passed in. */
+    const ElementType& getReference (int index) const noexcept
+    {
+        jassert (isPositiveAndBelow (index, numUsed));
+        return elements[index];
+    }
+
+    /** Returns the first element in the array, or a default value if the array is empty. */
+    ElementType getFirst() const        { return operator[] (0); }
+
+    /** Returns the last element in the array, or a default value if the array is empty. */
+    ElementType getLast() const         { return operator[] (numUsed - 1); }
+
+    /** Returns a pointer to the actual array data. */
+    ElementType* data() noexcept                        { return elements; }
+
+    /** Returns a pointer to the actual array data. */
+    const ElementType* data() const noexcept            { return elements; }
+
+    /** Returns a pointer to the first element in the array. */
+    ElementType* begin() noexcept                       { return elements; }
+
+    /** Returns a pointer to the first element in the array. */
+    const ElementType* begin() const noexcept           { return elements; }
+
+    /** Returns a pointer to the element which follows the last element in the array. */
+    ElementType* end() noexcept                         { return elements + numUsed; }
+
+    /** Returns a pointer to the element which follows the last element in the array. */
+    const ElementType* end() const noexcept             { return elements + numUsed; }
+
+    //==============================================================================
+    /** Finds the index of the first element which matches the value passed in,
+        or returns -1 if there isn't one.
+    */
+    int indexOf (const ElementType& elementToLookFor) const
+    {
+        for (int i = 0; i < numUsed; ++i)
+            if (elementToLookFor == elements[i])
+                return i;
+
+        return -1;
+    }
+
+    /** Returns true if the array contains at least one occurrence of an object. */
+    bool contains (const ElementType& elementToLookFor) const   { return indexOf (elementToLookFor) >= 0; }
+
+    //==============================================================================
+    /** Appends a new element at the end of the array. */
+    void add (const ElementType& newElement)            { addImpl (newElement); }
+
+    /** Appends a new element at the end of the array. */
+    void add (ElementType&& newElement)                 { addImpl (std::move (newElement)); }
+
+    /** Inserts a new element into the array at a given position.
+        If the index is less than 0 or greater than the size of the array, the
+        element will be added to the end of the array.
+    */
+    void insert (int indexToInsertAt, const ElementType& newElement)
+    {
+        if (! isPositiveAndBelow (indexToInsertAt, numUsed))
+        {
+            add (newElement);
+            return;
+        }
+
+        ElementType copy (newElement);
+        ensureStorageAllocated (numUsed + 1);
+
+        if constexpr (isTriviallyCopyable)
+        {
+            memmove (elements + indexToInsertAt + 1, elements + indexToInsertAt,
+                     (size_t) (numUsed - indexToInsertAt) * sizeof (ElementType));
+            new (elements + indexToInsertAt) ElementType (std::move (copy));
+        }
+        else
+        {
+            new (elements + numUsed) ElementType (std::move (elements[numUsed - 1]));
+
+            for (int i = numUsed - 1; i > indexToInsertAt; --i)
+                elements[i] = std::move (elements[i - 1]);
+
+            elements[indexToInsertAt] = std::move (copy);
+        }
+
+        ++numUsed;
+    }
+
+    /** Replaces an element with a new value.
+        If the index is less than zero, this does nothing. If it's beyond the end of
+        the array, the new value is added to the end of the array.
+    */
+    void set (int indexToChange, const ElementType& newValue)
+    {
+        if (indexToChange >= numUsed)
+            add (newValue);
+        else if (indexToChange >= 0)
+            elements[indexToChange] = newValue;
+    }
+
+    /** Adds all the elements from a container, such as another array, to the end of this one. */
+    template <class OtherArrayType>
+    void addArray (const OtherArrayType& arrayToAddFrom)
+    {
+        if (static_cast<const void*> (&arrayToAddFrom) == static_cast<const void*> (this))
+        {
+            const SmallArray copy (*this);
+            addArray (copy);
+            return;
+        }
+
+        ensureStorageAllocated (numUsed + (int) arrayToAddFrom.size());
+
+        for (auto& e : arrayToAddFrom)
+            new (elements + numUsed++) ElementType (e);
+    }
+
+    /** Adds all the elements from an initialiser list to the end of this array. */
+    void addArray (std::initializer_list<ElementType> items)
+    {
+        ensureStorageAllocated (numUsed + (int) items.size());
+
+        for (auto& e : items)
+            new (elements + numUsed++) ElementType (e);
+    }
+
+    /** Changes the number of elements in the array, adding default-constructed elements
+        or removing them from the end as necessary.
+    */
+    void resize (int targetNumItems)
+    {
+        jassert (targetNumItems >= 0);
+
+        if (targetNumItems > numUsed)
+        {
+            ensureStorageAllocated (targetNumItems);
+
+            while (numUsed < targetNumItems)
+                new (elements + numUsed++) ElementType();
+        }
+        else
+        {
+            removeLast (numUsed - targetNumItems);
+        }
+    }
+
+    //==============================================================================
+    /** Removes the element at the given index, moving the later elements down to fill the gap.
+        If the index is out of range, this does nothing.
+    */
+    void remove (int indexToRemove)
+    {
+        if (isPositiveAndBelow (indexToRemove, numUsed))
+            removeElements (indexToRemove, 1);
+    }
+
+    /** Removes a range of elements from the array.
+        The range is clipped to the size of the array.
+    */
+    void removeRange (int startIndex, int numberToRemove)
+    {
+        auto endIndex = jlimit (0, numUsed, startIndex + numberToRemove);
+        startIndex = jlimit (0, numUsed, startIndex);
+
+        if (endIndex > startIndex)
+            removeElements (startIndex, endIndex - startIndex);
+    }
+
+    /** Removes the last n elements from the array. */
+    void removeLast (int howManyToRemove = 1)
+    {
+        removeRange (numUsed - jmin (numUsed, howManyToRemove), howManyToRemove);
+    }
+
+    /** Removes the first element which matches the value passed in. */
+    void removeFirstMatchingValue (const ElementType& valueToRemove)
+    {
+        remove (indexOf (valueToRemove));
+    }
+
+    /** Removes all the elements which match the value passed in, and returns how many were removed. */
+    int removeAllInstancesOf (const ElementType& valueToRemove)
+    {
+        int numRemoved = 0;
+
+        for (int i = numUsed; --i >= 0;)
+        {
+            if (valueToRemove == elements[i])
+            {
+                remove (i);
+                ++numRemoved;
+            }
+        }
+
+        return numRemoved;
+    }
+
+    /** Removes all the elements, and frees any heap storage that was being used. */
+    void clear()
+    {
+        clearQuick();
+        freeHeapStorage();
+        elements = getInlineStorage();
+        numAllocated = inlineCapacity;
+    }
+
+    /** Removes all the elements, but keeps any storage that was allocated. */
+    void clearQuick()
+    {
+        if constexpr (! std::is_trivially_destructible_v<ElementType>)
+            for (int i = 0; i < numUsed; ++i)
+                elements[i].~ElementType();
+
+        numUsed = 0;
+    }
+
+    //==============================================================================
+    /** Increases the array's storage so that it can hold at least the given number of elements. */
+    void ensureStorageAllocated (int minNumElements)
+    {
+        if (minNumElements > numAllocated)
+            setAllocatedSize ((minNumElements + minNumElements / 2 + 8) & ~7);
+    }
+
+    /** Reduces the storage to the minimum needed for the current contents, moving them
+        back into the inline buffer if they fit.
+    */
+    void minimiseStorageOverheads()
+    {
+        if (numUsed < numAllocated)
+            setAllocatedSize (numUsed);
+    }
+
+    /** Swaps the contents of this array with another one. */
+    void swapWith (SmallArray& other)
+    {
+        if (! isUsingInlineStorage() && ! other.isUsingInlineStorage())
+        {
+            std::swap (elements, other.elements);
+            std::swap (numUsed, other.numUsed);
+            std::swap (numAllocated, other.numAllocated);
+        }
+        else
+        {
+            SmallArray temp (std::move (other));
+            other = std::move (*this);
+            *this = std::move (temp);
+        }
+    }
+
+private:
+    //==============================================================================
+    static constexpr auto isTriviallyCopyable = std::is_trivially_copyable_v<ElementType>;
+
+    static_assert (inlineCapacity > 0, "The inline capacity must be at least one element");
+
+    alignas (ElementType) char inlineStorage[sizeof (ElementType) * (size_t) inlineCapacity];
+    ElementType* elements = getInlineStorage();
+    int numUsed = 0, numAllocated = inlineCapacity;
+
+    ElementType* getInlineStorage() noexcept                { return reinterpret_cast<ElementType*> (inlineStorage); }
+    const ElementType* getInlineStorage() const noexcept    { return reinterpret_cast<const ElementType*> (inlineStorage); }
+
+    void freeHeapStorage() noexcept
+    {
+        if (! isUsingInlineStorage())
+            std::free (elements);
+    }
+
+    static void relocate (ElementType* destination, ElementType* source, int numElements) noexcept
+    {
+        if constexpr (isTriviallyCopyable)
+        {
+            if (numElements > 0)
+                memcpy (destination, source, (size_t) numElements * sizeof (ElementType));
+        }
+        else
+        {
+            for (int i = 0; i < numElements; ++i)
+            {
+                new (destination + i) ElementType (std::move (source[i]));
+                source[i].~ElementType();
+            }
+        }
+    }
+
+    void setAllocatedSize (int numElements)
+    {
+        jassert (numElements >= numUsed);
+
+        auto* newElements = numElements <= inlineCapacity
+                              ? getInlineStorage()
+                              : static_cast<ElementType*> (std::malloc ((size_t) numElements * sizeof (ElementType)));
+
+        jassert (newElements != nullptr);
+
+        if (newElements != elements)
+        {
+            relocate (newElements, elements, numUsed);
+            freeHeapStorage();
+            elements = newElements;
+        }
+
+        numAllocated = jmax (numElements, inlineCapacity);
+    }
+
+    void takeContentsOf (SmallArray& other) noexcept
+    {
+        if (other.isUsingInlineStorage())
+        {
+            relocate (elements, other.elements, other.numUsed);
+        }
+        else
+        {
+            elements = other.elements;
+            numAllocated = other.numAllocated;
+            other.elements = other.getInlineStorage();
+            other.numAllocated = inlineCapacity;
+        }
+
+        numUsed = other.numUsed;
+        other.numUsed = 0;
+    }
+
+    template <typename Type>
+    void addImpl (Type&& newElement)
+    {
+        if (numUsed < numAllocated)
+        {
+            new (elements + numUsed) ElementType (std::forward<Type> (newElement));
+        }
+        else
+        {
+            // The new element might be a reference to one that's already in the array,
+            // so it has to be copied before the storage moves.
+            ElementType copy (std::forward<Type> (newElement));
+            ensureStorageAllocated (numUsed + 1);
+            new (elements + numUsed) ElementType (std::move (copy));
+        }
+
+        ++numUsed;
+    }
+
+    void removeElements (int startIndex, int numToRemove)
+    {
+        if constexpr (isTriviallyCopyable)
+        {
+            memmove (elements + startIndex, elements + startIndex + numToRemove,
+                     (size_t) (numUsed - (startIndex + numToRemove)) * sizeof (ElementType));
+        }
+        else
+        {
+            for (int i = startIndex; i + numToRemove < numUsed; ++i)
+                elements[i] = std::move (elements[i + numToRemove]);
+
+            for (int i = numUsed - numToRemove; i < numUsed; ++i)
+                elements[i].~ElementType();
+        }
+
+        numUsed -= numToRemove;
+    }
+};
+
+} // namespace juce
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class SmallArrayTests  : public UnitTest
+{
+public:
+    SmallArrayTests()
+        : UnitTest ("SmallArray", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Small arrays stay inline");
+        {
+            SmallArray<int, 4> a { 1, 2, 3 };
+            a.add (4);
+
+            expect (a.isUsingInlineStorage());
+            expect (a == Array<int> { 1, 2, 3, 4 });
+
+            a.add (5);
+            expect (! a.isUsingInlineStorage());
+            expect (a == Array<int> { 1, 2, 3, 4, 5 });
+
+            a.removeRange (1, 3);
+            a.minimiseStorageOverheads();
+            expect (a.isUsingInlineStorage());
+            expect (a == Array<int> { 1, 5 });
+
+            a.clear();
+            expect (a.isEmpty() && a.isUsingInlineStorage());
+            expectEquals (a[3], 0);
+        }
+
+        beginTest ("Insert, set and remove");
+        {
+            SmallArray<int, 2> a;
+
+            for (int i = 0; i < 10; ++i)
+                a.insert (0, i);
+
+            expect (a == Array<int> { 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 });
+
+            a.set (0, 100);
+            a.set (20, 200);
+            a.set (-1, 300);
+            a.insert (3, a.getReference (0));
+            a.remove (1);
+            a.removeFirstMatchingValue (5);
+            a.removeLast (2);
+
+            expect (a == Array<int> { 100, 7, 100, 6, 4, 3, 2, 1 });
+            expectEquals (a.removeAllInstancesOf (100), 2);
+            expectEquals (a.indexOf (4), 2);
+            expect (! a.contains (100));
+        }
+
+        beginTest ("Non-trivial elements");
+        {
+            SmallArray<String, 3> a;
+
+            for (int i = 0; i < 6; ++i)
+                a.add (String (i));
+
+            a.add (a.getReference (0));
+            a.insert (1, "x");
+            a.remove (2);
+            expect (a == StringArray ("0", "x", "2", "3", "4", "5", "0"));
+
+            SmallArray<String, 3> b { "a", "b" };
+            a.swapWith (b);
+            expect (a == StringArray ("a", "b") && a.isUsingInlineStorage());
+            expectEquals (b.size(), 7);
+
+            auto c = std::move (b);
+            expectEquals (c.getLast(), String ("0"));
+            expect (b.isEmpty());
+
+            SmallArray<String, 3> d (a);
+            d.addArray (d);
+            expect (d == StringArray ("a", "b", "a", "b"));
+
+            d = std::move (a);
+            expect (d == StringArray ("a", "b") && d.isUsingInlineStorage());
+
+            d.resize (5);
+            expectEquals (d[4], String());
+            d.resize (1);
+            expect (d == StringArray ("a"));
+        }
+    }
+};
+
+static SmallArrayTests smallArrayTests;
+
+} // namespace juce
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_UNIT_TESTS
+
+class SnapshotListenerListTests final : public UnitTest
+{
+public:
+    struct TestListener
+    {
+        std::function<void()> callback;
+        int numCalls = 0;
+
+        void doCallback()
+        {
+            ++numCalls;
+
+            if (callback != nullptr)
+                callback();
+        }
+    };
+
+    SnapshotListenerListTests() : UnitTest ("SnapshotListenerList", UnitTestCategories::containers) {}
+
+    void runTest() override
+    {
+        beginTest ("Listeners are called in the order they were added");
+        {
+            SnapshotListenerList<TestListener> list;
+            TestListener a, b, c, d;
+            std::vector<TestListener*> order;
+
+            list.add (&a);
+            list.add (&b);
+            list.add (&c);
+            list.add (&a);
+            expectEquals (list.size(), 3);
+
+            list.remove (&b);
+            list.call ([&] (TestListener& l) { order.push_back (&l); });
+            expect (order == std::vector<TestListener*> { &a, &c });
+
+            // b's storage can be reused now, but d still has to come last
+            list.add (&d);
+            list.add (&b);
+            order.clear();
+            list.call ([&] (TestListener& l) { order.push_back (&l); });
+            expect (order == std::vector<TestListener*> { &a, &c, &d, &b });
+
+            expect (list.contains (&d));
+            list.clear();
+            expect (list.isEmpty() && ! list.contains (&d));
+        }
+
+        beginTest ("A listener removed during a callback isn't called");
+        {
+            SnapshotListenerList<TestListener> list;
+            std::vector<TestListener> listeners (10);
+
+            for (auto& l : listeners)
+                list.add (&l);
+
+            listeners[2].callback = [&] { list.remove (&listeners[5]); };
+            list.call ([] (TestListener& l) { l.doCallback(); });
+
+            for (size_t i = 0; i < listeners.size(); ++i)
+                expectEquals (listeners[i].numCalls, i == 5 ? 0 : 1);
+        }
+
+        beginTest ("A listener added during a callback isn't called until the next iteration");
+        {
+            SnapshotListenerList<TestListener> list;
+            TestListener a, b, c;
+
+            list.add (&a);
+            list.add (&b);
+
+            // Removing and re-adding b must not make it get called twice
+            a.callback = [&] { list.add (&c); list.remove (&b); list.add (&b); };
+            list.call ([] (TestListener& l) { l.doCallback(); });
+
+            expectEquals (a.numCalls, 1);
+            expectEquals (b.numCalls, 0);
+            expectEquals (c.numCalls, 0);
+
+            a.callback = nullptr;
+            list.call ([] (TestListener& l) { l.doCallback(); });
+
+            expectEquals (b.numCalls, 1);
+            expectEquals (c.numCalls, 1);
+        }
+
+        beginTest ("Clearing or deleting the list during a callback stops the iteration");
+        {
+            std::vector<TestListener> listeners (5);
+
+            SnapshotListenerList<TestListener> list;
+
+            for (auto& l : listeners)
+                list.add (&l);
+
+            listeners[1].callback = [&] { list.clear(); };
+            list.call ([] (TestListener& l) { l.doCallback(); });
+            expectEquals (listeners[1].numCalls, 1);
+            expectEquals (listeners[2].numCalls, 0);
+
+            auto ownedList = std::make_unique<SnapshotListenerList<TestListener>>();
+
+            for (auto& l : listeners)
+                ownedList->add (&l);
+
+            listeners[1].callback = [&] { ownedList.reset(); };
+            ownedList->call ([] (TestListener& l) { l.doCallback(); });
+            expectEquals (listeners[1].numCalls, 2);
+            expectEquals (listeners[2].numCalls, 0);
+        }
+
+        beginTest ("Listeners can be added and removed while other threads are calling them");
+        {
+            SnapshotListenerList<TestListener> list;
+            std::vector<TestListener> listeners (100);
+            std::atomic<bool> finished { false };
+            std::atomic<int> numCalls { 0 };
+
+            std::vector<std::thread> callers;
+
+            for (int i = 0; i < 3; ++i)
+                callers.emplace_back ([&]
+                {
+                    while (! finished)
+                        list.call ([&] (TestListener&) { ++numCalls; });
+                });
+
+            Random r = getRandom();
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                auto& l = listeners[(size_t) r.nextInt ((int) listeners.size())];
+
+                if (r.nextBool())
+                    list.add (&l);
+                else
+                    list.remove (&l);
+            }
+
+            finished = true;
+
+            for (auto& t : callers)
+                t.join();
+
+            int numExpected = 0;
+
+            for (auto& l : listeners)
+                numExpected += list.contains (&l) ? 1 : 0;
+
+            expectEquals (list.size(), numExpected);
+        }
+    }
+};
+
+static SnapshotListenerListTests snapshotListenerListTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,315 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A list of listeners that is built for broadcasting to large numbers of listeners.
+
+    This is a drop-in alternative to ListenerList for the common operations, with the
+    same guarantees about changes made during a callback:
+
+    - A listener that is added during a callback won't be called in the same iteration.
+    - A listener that is removed during a callback won't be called if it hasn't been
+      called already.
+    - If the list is cleared or deleted during a callback, no more listeners are called.
+
+    Adding, removing and checking for a listener take constant time, rather than being
+    proportional to the number of listeners. Each call iterates over a snapshot of the
+    list that is only rebuilt after the list has changed, so a batch of changes costs one
+    rebuild. The list's lock is only held while adding, removing and taking the snapshot,
+    never while listeners are being called, so listener callbacks may safely modify the
+    list from any thread.
+
+    Storage for removed listeners is reused once no iterations are in progress.
+
+    @see ListenerList
+
+    @tags{Core}
+*/
+template <class ListenerClass>
+class SnapshotListenerList
+{
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    SnapshotListenerList() = default;
+
+    /** Destructor. */
+    ~SnapshotListenerList()     { clear(); }
+
+    //==============================================================================
+    /** Adds a listener to the list.
+        A listener can only be added once, so if the listener is already in the list,
+        this method has no effect.
+    */
+    void add (ListenerClass* listenerToAdd)
+    {
+        if (listenerToAdd == nullptr)
+        {
+            jassertfalse; // Listeners can't be null pointers!
+            return;
+        }
+
+        const ScopedLock sl (state->lock);
+        state->add (listenerToAdd);
+    }
+
+    /** Removes a listener from the list.
+        If the listener wasn't in the list, this has no effect.
+    */
+    void remove (ListenerClass* listenerToRemove)
+    {
+        jassert (listenerToRemove != nullptr); // Listeners can't be null pointers!
+
+        const ScopedLock sl (state->lock);
+        state->remove (listenerToRemove);
+    }
+
+    /** Adds a listener that will be automatically removed again when the Guard is destroyed.
+
+        Be very careful to ensure that the ErasedScopeGuard is destroyed or released before the
+        list is destroyed, otherwise the ErasedScopeGuard may attempt to dereference a
+        dangling pointer when it is destroyed, which will result in a crash.
+    */
+    ErasedScopeGuard addScoped (ListenerClass& listenerToAdd)
+    {
+        add (&listenerToAdd);
+        return ErasedScopeGuard { [this, &listenerToAdd] { remove (&listenerToAdd); } };
+    }
+
+    /** Removes all the listeners. */
+    void clear()
+    {
+        const ScopedLock sl (state->lock);
+        state->clear();
+    }
+
+    /** Returns the number of registered listeners. */
+    int size() const
+    {
+        const ScopedLock sl (state->lock);
+        return (int) state->slotIndices.size();
+    }
+
+    /** Returns true if no listeners are registered, false otherwise. */
+    bool isEmpty() const                            { return size() == 0; }
+
+    /** Returns true if the specified listener has been added to the list. */
+    bool contains (ListenerClass* listener) const
+    {
+        const ScopedLock sl (state->lock);
+        return state->slotIndices.count (listener) != 0;
+    }
+
+    //==============================================================================
+    /** Calls an invokable object for each listener in the list. */
+    template <typename Callback>
+    void call (Callback&& callback)
+    {
+        callCheckedExcluding (nullptr, DummyBailOutChecker{}, std::forward<Callback> (callback));
+    }
+
+    /** Calls an invokable object for each listener in the list, except for the
+        listener specified by listenerToExclude.
+    */
+    template <typename Callback>
+    void callExcluding (ListenerClass* listenerToExclude, Callback&& callback)
+    {
+        callCheckedExcluding (listenerToExclude, DummyBailOutChecker{}, std::forward<Callback> (callback));
+    }
+
+    /** Calls an invokable object for each listener in the list, additionally
+        checking the bail-out checker before each call.
+
+        See the ListenerList class description for info about writing a bail-out checker.
+    */
+    template <typename Callback, typename BailOutCheckerType>
+    void callChecked (const BailOutCheckerType& bailOutChecker, Callback&& callback)
+    {
+        callCheckedExcluding (nullptr, bailOutChecker, std::forward<Callback> (callback));
+    }
+
+    /** Calls an invokable object for each listener in the list, except for the
+        listener specified by listenerToExclude, additionally checking the
+        bail-out checker before each call.
+    */
+    template <typename Callback, typename BailOutCheckerType>
+    void callCheckedExcluding (ListenerClass* listenerToExclude,
+                               const BailOutCheckerType& bailOutChecker,
+                               Callback&& callback)
+    {
+        // Holding the state keeps it alive if the list is deleted by a callback
+        const auto localState = state;
+        const auto snapshot = localState->beginIteration();
+
+        const ScopeGuard endIteration { [&] { --localState->numIterations; } };
+
+        for (auto* slot : *snapshot)
+        {
+            if (bailOutChecker.shouldBailOut())
+                return;
+
+            // A listener that has been removed since the snapshot was taken will be null here
+            if (auto* listener = slot->listener.load (std::memory_order_acquire))
+                if (listener != listenerToExclude)
+                    callback (*listener);
+        }
+    }
+
+    //==============================================================================
+    /** A dummy bail-out checker that always returns false. */
+    struct DummyBailOutChecker
+    {
+        constexpr bool shouldBailOut() const noexcept { return false; }
+    };
+
+    //==============================================================================
+    using ThisType      = SnapshotListenerList<ListenerClass>;
+    using ListenerType  = ListenerClass;
+
+private:
+    //==============================================================================
+    struct Slot
+    {
+        std::atomic<ListenerClass*> listener { nullptr };
+
+        // The neighbouring slots in the order the listeners were added
+        size_t previous = 0, next = 0;
+    };
+
+    using Snapshot = std::vector<Slot*>;
+
+    struct State
+    {
+        // The first slot is the head of the list of listeners, and never holds a listener.
+        // A deque is used because adding slots doesn't move the existing ones, which
+        // snapshots may point to.
+        State()     { slots.emplace_back(); }
+
+        void add (ListenerClass* listener)
+        {
+            if (slotIndices.count (listener) != 0)
+                return;
+
+            size_t index;
+
+            if (freeSlots.empty())
+            {
+                index = slots.size();
+                slots.emplace_back();
+            }
+            else
+            {
+                index = freeSlots.back();
+                freeSlots.pop_back();
+            }
+
+            auto& head = slots.front();
+            auto& slot = slots[index];
+            slot.previous = head.previous;
+            slot.next = 0;
+            slots[head.previous].next = index;
+            head.previous = index;
+            slot.listener.store (listener, std::memory_order_release);
+
+            slotIndices[listener] = index;
+            snapshot.reset();
+        }
+
+        void remove (ListenerClass* listener)
+        {
+            const auto iter = slotIndices.find (listener);
+
+            if (iter == slotIndices.end())
+                return;
+
+            const auto index = iter->second;
+            slotIndices.erase (iter);
+
+            auto& slot = slots[index];
+            slot.listener.store (nullptr, std::memory_order_release);
+            slots[slot.previous].next = slot.next;
+            slots[slot.next].previous = slot.previous;
+
+            // Snapshots that are in use may still refer to this slot, so it can't be reused yet
+            slotsAwaitingReuse.push_back (index);
+            snapshot.reset();
+        }
+
+        void clear()
+        {
+            for (const auto& pair : slotIndices)
+            {
+                slots[pair.second].listener.store (nullptr, std::memory_order_release);
+                slotsAwaitingReuse.push_back (pair.second);
+            }
+
+            slotIndices.clear();
+            slots.front().previous = slots.front().next = 0;
+            snapshot.reset();
+        }
+
+        std::shared_ptr<const Snapshot> beginIteration()
+        {
+            const ScopedLock sl (lock);
+
+            if (snapshot == nullptr)
+            {
+                // Nothing can be iterating over an older snapshot at this point,
+                // so the removed slots are free to be used again
+                if (numIterations == 0)
+                {
+                    freeSlots.insert (freeSlots.end(), slotsAwaitingReuse.begin(), slotsAwaitingReuse.end());
+                    slotsAwaitingReuse.clear();
+                }
+
+                auto newSnapshot = std::make_shared<Snapshot>();
+                newSnapshot->reserve (slotIndices.size());
+
+                for (auto index = slots.front().next; index != 0; index = slots[index].next)
+                    newSnapshot->push_back (&slots[index]);
+
+                snapshot = std::move (newSnapshot);
+            }
+
+            ++numIterations;
+            return snapshot;
+        }
+
+        CriticalSection lock;
+        std::deque<Slot> slots;
+        std::unordered_map<ListenerClass*, size_t> slotIndices;
+        std::vector<size_t> freeSlots, slotsAwaitingReuse;
+        std::shared_ptr<const Snapshot> snapshot;
+        std::atomic<int> numIterations { 0 };
+    };
+
+    const std::shared_ptr<State> state = std::make_shared<State>();
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE (SnapshotListenerList)
+};
+
+} // namespace juce
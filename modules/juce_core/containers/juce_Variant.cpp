@@ -65,6 +65,10 @@ struct var::VariantType
     bool isMethod       = false;
     bool isComparable   = false;
 
+    // True for types whose value is held entirely in the ValueUnion, which can be copied
+    // and destroyed without calling createCopy or cleanUp
+    bool isTrivial      = false;
+
     int                     (*toInt)         (const ValueUnion&)                 = defaultToInt;
     int64                   (*toInt64)       (const ValueUnion&)                 = defaultToInt64;
     double                  (*toDouble)      (const ValueUnion&)                 = defaultToDouble;
@@ -107,6 +111,7 @@ struct var::VariantType
     constexpr explicit VariantType (VoidTag) noexcept
         : isVoid            (true),
           isComparable      (true),
+          isTrivial         (true),
           equals            (voidEquals),
           writeToStream     (voidWriteToStream) {}
 
@@ -126,6 +131,7 @@ struct var::VariantType
 
     constexpr explicit VariantType (UndefinedTag) noexcept
         : isUndefined   (true),
+          isTrivial     (true),
           toString      (undefinedToString),
           equals        (undefinedEquals),
           writeToStream (undefinedWriteToStream) {}
@@ -155,6 +161,7 @@ struct var::VariantType
     constexpr explicit VariantType (IntTag) noexcept
         : isInt         (true),
           isComparable  (true),
+          isTrivial     (true),
           toInt         (intToInt),
           toInt64       (intToInt64),
           toDouble      (intToDouble),
@@ -188,6 +195,7 @@ struct var::VariantType
     constexpr explicit VariantType (Int64Tag) noexcept
         : isInt64       (true),
           isComparable  (true),
+          isTrivial     (true),
           toInt         (int64ToInt),
           toInt64       (int64ToInt64),
           toDouble      (int64ToDouble),
@@ -218,6 +226,7 @@ struct var::VariantType
     constexpr explicit VariantType (DoubleTag) noexcept
         : isDouble      (true),
           isComparable  (true),
+          isTrivial     (true),
           toInt         (doubleToInt),
           toInt64       (doubleToInt64),
           toDouble      (doubleToDouble),
@@ -247,6 +256,7 @@ struct var::VariantType
     constexpr explicit VariantType (BoolTag) noexcept
         : isBool        (true),
           isComparable  (true),
+          isTrivial     (true),
           toInt         (boolToInt),
           toInt64       (boolToInt64),
           toDouble      (boolToDouble),
@@ -494,14 +504,17 @@ struct var::Instance
 };
 
 //==============================================================================
-var::var() noexcept : type (&Instance::attributesVoid) {}
-var::var (const VariantType& t) noexcept  : type (&t) {}
-var::~var() noexcept  { type->cleanUp (value); }
+var::var() noexcept : type (&Instance::attributesVoid), value() {}
+var::var (const VariantType& t) noexcept  : type (&t), value() {}
+var::~var() noexcept  { cleanUp(); }
 
 //==============================================================================
 var::var (const var& valueToCopy)  : type (valueToCopy.type)
 {
-    type->createCopy (value, valueToCopy.value);
+    if (type->isTrivial)
+        value = valueToCopy.value;
+    else
+        type->createCopy (value, valueToCopy.value);
 }
 
 var::var (const int v) noexcept       : type (&Instance::attributesInt)    { value.intValue = v; }
@@ -569,15 +582,42 @@ void var::swapWith (var& other) noexcept
     std::swap (value, other.value);
 }
 
-var& var::operator= (const var& v)               { type->cleanUp (value); type = v.type; type->createCopy (value, v.value); return *this; }
-var& var::operator= (const int v)                { type->cleanUp (value); type = &Instance::attributesInt; value.intValue = v; return *this; }
-var& var::operator= (const int64 v)              { type->cleanUp (value); type = &Instance::attributesInt64; value.int64Value = v; return *this; }
-var& var::operator= (const bool v)               { type->cleanUp (value); type = &Instance::attributesBool; value.boolValue = v; return *this; }
-var& var::operator= (const double v)             { type->cleanUp (value); type = &Instance::attributesDouble; value.doubleValue = v; return *this; }
-var& var::operator= (const char* const v)        { type->cleanUp (value); type = &Instance::attributesString; new (value.stringValue) String (v); return *this; }
-var& var::operator= (const wchar_t* const v)     { type->cleanUp (value); type = &Instance::attributesString; new (value.stringValue) String (v); return *this; }
-var& var::operator= (const String& v)            { type->cleanUp (value); type = &Instance::attributesString; new (value.stringValue) String (v); return *this; }
-var& var::operator= (const MemoryBlock& v)       { type->cleanUp (value); type = &Instance::attributesBinary; value.binaryValue = new MemoryBlock (v); return *this; }
+void var::cleanUp() noexcept
+{
+    if (! type->isTrivial)
+        type->cleanUp (value);
+}
+
+var& var::operator= (const var& v)
+{
+    if (v.type->isTrivial)
+    {
+        // v may be owned by this var (e.g. an element of an array that it holds), so it
+        // must be read before cleanUp() releases it
+        const auto* newType = v.type;
+        const auto newValue = v.value;
+
+        cleanUp();
+        type = newType;
+        value = newValue;
+    }
+    else if (this != &v)
+    {
+        var v2 (v);
+        swapWith (v2);
+    }
+
+    return *this;
+}
+
+var& var::operator= (const int v)                { cleanUp(); type = &Instance::attributesInt; value.intValue = v; return *this; }
+var& var::operator= (const int64 v)              { cleanUp(); type = &Instance::attributesInt64; value.int64Value = v; return *this; }
+var& var::operator= (const bool v)               { cleanUp(); type = &Instance::attributesBool; value.boolValue = v; return *this; }
+var& var::operator= (const double v)             { cleanUp(); type = &Instance::attributesDouble; value.doubleValue = v; return *this; }
+var& var::operator= (const char* const v)        { cleanUp(); type = &Instance::attributesString; new (value.stringValue) String (v); return *this; }
+var& var::operator= (const wchar_t* const v)     { cleanUp(); type = &Instance::attributesString; new (value.stringValue) String (v); return *this; }
+var& var::operator= (const String& v)            { cleanUp(); type = &Instance::attributesString; new (value.stringValue) String (v); return *this; }
+var& var::operator= (const MemoryBlock& v)       { cleanUp(); type = &Instance::attributesBinary; value.binaryValue = new MemoryBlock (v); return *this; }
 var& var::operator= (const Array<var>& v)        { var v2 (v); swapWith (v2); return *this; }
 var& var::operator= (ReferenceCountedObject* v)  { var v2 (v); swapWith (v2); return *this; }
 var& var::operator= (NativeFunction v)           { var v2 (v); swapWith (v2); return *this; }
@@ -612,12 +652,15 @@ var::var (Array<var>&& v)  : type (&Instance::attributesArray)
 
 var& var::operator= (String&& v)
 {
-    type->cleanUp (value);
+    cleanUp();
     type = &Instance::attributesString;
     new (value.stringValue) String (std::move (v));
     return *this;
 }
 
+var& var::operator= (MemoryBlock&& v)            { var v2 (std::move (v)); swapWith (v2); return *this; }
+var& var::operator= (Array<var>&& v)             { var v2 (std::move (v)); swapWith (v2); return *this; }
+
 //==============================================================================
 bool var::equals (const var& other) const noexcept
 {
@@ -793,6 +836,11 @@ void var::append (const var& n)
     convertToArray()->add (n);
 }
 
+void var::append (var&& n)
+{
+    convertToArray()->add (std::move (n));
+}
+
 void var::remove (const int index)
 {
     if (auto array = getArray())
@@ -894,4 +942,93 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 
 #endif
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class VariantTests final : public UnitTest
+{
+public:
+    VariantTests()
+        : UnitTest ("var", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Copies keep their values and types");
+        {
+            const var values[] { var(), var::undefined(), 3, (int64) 1 << 40, true, 2.5, "text",
+                                 Array<var> { 1, 2 }, var (new DynamicObject()), MemoryBlock (4, true) };
+
+            for (auto& v : values)
+            {
+                var copy (v);
+                expect (copy.equalsWithSameType (v));
+
+                var assigned (12);
+                assigned = v;
+                expect (assigned.equalsWithSameType (v));
+            }
+        }
+
+        beginTest ("Self-assignment leaves the value intact");
+        {
+            DynamicObject::Ptr object (new DynamicObject());
+            var v (object.get());
+            auto& ref = v;
+            v = ref;
+            expect (v.getObject() == object.get());
+            expectEquals (object->getReferenceCount(), 2);
+        }
+
+        beginTest ("Assigning a value that is owned by the target keeps the value");
+        {
+            var numbers (Array<var> { 42 });
+            numbers = numbers[0];
+            expect (numbers.isInt());
+            expectEquals ((int) numbers, 42);
+
+            var strings (Array<var> { "text" });
+            strings = strings[0];
+            expect (strings.isString());
+            expectEquals (strings.toString(), String ("text"));
+        }
+
+        beginTest ("Objects are released when overwritten");
+        {
+            DynamicObject::Ptr object (new DynamicObject());
+            var v (object.get());
+            var copy (v);
+            expectEquals (object->getReferenceCount(), 3);
+
+            copy = 1.5;
+            v = copy;
+            expectEquals (object->getReferenceCount(), 1);
+            expect (v.isDouble());
+        }
+
+        beginTest ("Moved values are appended without copying");
+        {
+            Array<var> items { 1, 2, 3 };
+            var element (std::move (items));
+            const auto* storage = element.getArray()->begin();
+
+            var list;
+            list.append (std::move (element));
+            expect (list[0].getArray()->begin() == storage);
+            expect (element.isVoid());
+
+            MemoryBlock block (16, true);
+            var binary (1);
+            binary = std::move (block);
+            expect (binary.isBinaryData());
+            expectEquals ((int) binary.getBinaryData()->getSize(), 16);
+        }
+    }
+};
+
+static VariantTests variantTests;
+
+#endif
+
 } // namespace juce
@@ -97,6 +97,8 @@ public:
     var (Array<var>&&);
     var& operator= (var&&) noexcept;
     var& operator= (String&&);
+    var& operator= (MemoryBlock&&);
+    var& operator= (Array<var>&&);
 
     void swapWith (var& other) noexcept;
 
@@ -210,6 +212,12 @@ public:
     */
     void append (const var& valueToAppend);
 
+    /** Appends an element to the var, converting it to an array if it isn't already one.
+        This moves the value into the array rather than copying it.
+        @see append
+    */
+    void append (var&& valueToAppend);
+
     /** Inserts an element to the var, converting it to an array if it isn't already one.
         If the var isn't an array, it will be converted to one, and if its value was non-void,
         this value will be kept as the first element of the new array. The parameter value
@@ -314,6 +322,7 @@ private:
     ValueUnion value;
 
     Array<var>* convertToArray();
+    void cleanUp() noexcept;
     var (const VariantType&) noexcept;
 
     // This is needed to prevent the wrong constructor/operator being called
@@ -24,6 +24,10 @@ namespace juce
 {
 
 int64 juce_fileSetPosition (void* handle, int64 pos);
+void juce_adviseSequentialMemoryAccess (const void* data, size_t numBytes) noexcept;
+
+// the alignment needed for reads that bypass the cache, which is the page size on most systems
+static constexpr size_t fileInputStreamBlockAlignment = 4096;
 
 
 //==============================================================================
@@ -32,27 +36,158 @@ FileInputStream::FileInputStream (const File& f)  : file (f)
     openHandle();
 }
 
+FileInputStream::FileInputStream (const File& f, ReadMode mode, size_t size)
+    : file (f), readMode (mode)
+{
+    if (readMode == ReadMode::memoryMapped)
+    {
+        mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+
+        if (mappedFile->getData() != nullptr)
+        {
+            juce_adviseSequentialMemoryAccess (mappedFile->getData(), mappedFile->getSize());
+            return;
+        }
+
+        // an empty file, or one on a file system that can't be mapped, will be read normally
+        mappedFile.reset();
+        readMode = ReadMode::sequential;
+    }
+
+    openHandle();
+
+    if (readMode != ReadMode::normal)
+        allocateBuffer (size);
+}
+
+void FileInputStream::allocateBuffer (size_t size)
+{
+    const auto alignment = fileInputStreamBlockAlignment;
+    bufferSize = (jmax (size, alignment) + alignment - 1) & ~(alignment - 1);
+
+    bufferStorage.malloc (bufferSize + alignment);
+    auto address = (pointer_sized_uint) bufferStorage.get();
+    alignedBuffer = bufferStorage + ((alignment - (address & (alignment - 1))) & (alignment - 1));
+    numBuffered = 0;
+}
+
+bool FileInputStream::fillBuffer()
+{
+    // reads always start on a block boundary, so that they're aligned for uncached access
+    auto blockStart = currentPosition & ~(int64) (fileInputStreamBlockAlignment - 1);
+
+    if (handlePosition != blockStart)
+        handlePosition = juce_fileSetPosition (fileHandle, blockStart);
+
+    numBuffered = 0;
+    bufferStart = blockStart;
+
+    if (handlePosition != blockStart)
+        return false;
+
+    numBuffered = readInternal (alignedBuffer, bufferSize);
+    handlePosition += (int64) numBuffered;
+
+    return currentPosition < bufferStart + (int64) numBuffered;
+}
+
 int64 FileInputStream::getTotalLength()
 {
     // You should always check that a stream opened successfully before using it!
     jassert (openedOk());
 
+    if (mappedFile != nullptr)
+        return (int64) mappedFile->getSize();
+
     return file.getSize();
 }
 
-int FileInputStream::read (void* buffer, int bytesToRead)
+int FileInputStream::read (void* destBuffer, int bytesToRead)
 {
     // You should always check that a stream opened successfully before using it!
     jassert (openedOk());
 
     // The buffer should never be null, and a negative size is probably a
     // sign that something is broken!
-    jassert (buffer != nullptr && bytesToRead >= 0);
+    jassert (destBuffer != nullptr && bytesToRead >= 0);
+
+    if (mappedFile == nullptr && alignedBuffer == nullptr)
+    {
+        auto num = readInternal (destBuffer, (size_t) bytesToRead);
+        currentPosition += (int64) num;
+        handlePosition = currentPosition;
+
+        return (int) num;
+    }
+
+    auto* dest = static_cast<char*> (destBuffer);
+    auto numRead = 0;
+
+    while (numRead < bytesToRead)
+    {
+        auto numLeft = (size_t) (bytesToRead - numRead);
+
+        // a read that's bigger than the buffer can skip it, unless it has to be aligned
+        if (mappedFile == nullptr && readMode != ReadMode::uncached && numLeft >= bufferSize
+             && (currentPosition < bufferStart || currentPosition >= bufferStart + (int64) numBuffered))
+        {
+            if (handlePosition != currentPosition)
+                handlePosition = juce_fileSetPosition (fileHandle, currentPosition);
+
+            if (handlePosition != currentPosition)
+                break;
 
-    auto num = readInternal (buffer, (size_t) bytesToRead);
+            auto num = readInternal (dest + numRead, numLeft);
+
+            if (num == 0)
+                break;
+
+            currentPosition += (int64) num;
+            handlePosition = currentPosition;
+            numRead += (int) num;
+            continue;
+        }
+
+        auto block = readInPlace (numLeft);
+
+        if (block.empty())
+            break;
+
+        memcpy (dest + numRead, block.data(), block.size());
+        numRead += (int) block.size();
+    }
+
+    return numRead;
+}
+
+Span<const std::byte> FileInputStream::readInPlace (size_t maxNumBytes)
+{
+    // You should always check that a stream opened successfully before using it!
+    jassert (openedOk());
+
+    if (mappedFile != nullptr)
+    {
+        auto* data = static_cast<const std::byte*> (mappedFile->getData()) + currentPosition;
+        auto num = (size_t) jmin ((int64) maxNumBytes, (int64) mappedFile->getSize() - currentPosition);
+        currentPosition += (int64) num;
+        return { data, num };
+    }
+
+    if (alignedBuffer == nullptr)
+    {
+        handlePosition = currentPosition;
+        allocateBuffer (64 * 1024);
+    }
+
+    if (currentPosition < bufferStart || currentPosition >= bufferStart + (int64) numBuffered)
+        if (! fillBuffer())
+            return {};
+
+    auto offset = (size_t) (currentPosition - bufferStart);
+    auto num = jmin (maxNumBytes, numBuffered - offset);
     currentPosition += (int64) num;
 
-    return (int) num;
+    return { reinterpret_cast<const std::byte*> (alignedBuffer + offset), num };
 }
 
 bool FileInputStream::isExhausted()
@@ -70,8 +205,20 @@ bool FileInputStream::setPosition (int64 pos)
     // You should always check that a stream opened successfully before using it!
     jassert (openedOk());
 
-    if (pos != currentPosition)
-        currentPosition = juce_fileSetPosition (fileHandle, pos);
+    if (mappedFile != nullptr)
+    {
+        currentPosition = jlimit ((int64) 0, (int64) mappedFile->getSize(), pos);
+    }
+    else if (alignedBuffer != nullptr)
+    {
+        // the buffered modes only move the file handle when they next need to read
+        if (pos >= 0)
+            currentPosition = pos;
+    }
+    else if (pos != currentPosition)
+    {
+        currentPosition = handlePosition = juce_fileSetPosition (fileHandle, pos);
+    }
 
     return currentPosition == pos;
 }
@@ -167,6 +314,54 @@ struct FileInputStreamTests final : public UnitTest
 
             f.deleteFile();
         }
+
+        beginTest ("Read modes");
+        {
+            auto rng = getRandom();
+            MemoryBlock bigData (300000);
+
+            for (size_t i = 0; i < bigData.getSize(); ++i)
+                bigData[i] = (char) rng.nextInt (256);
+
+            auto bigFile = File::createTempFile (".bin");
+            bigFile.replaceWithData (bigData.getData(), bigData.getSize());
+
+            for (auto mode : { FileInputStream::ReadMode::normal, FileInputStream::ReadMode::sequential,
+                               FileInputStream::ReadMode::memoryMapped, FileInputStream::ReadMode::uncached })
+            {
+                FileInputStream in (bigFile, mode, 10000);
+                expect (in.openedOk());
+                expectEquals (in.getTotalLength(), (int64) bigData.getSize());
+
+                MemoryBlock result (bigData.getSize());
+
+                for (size_t pos = 0; pos < result.getSize();)
+                {
+                    auto numRead = in.read (static_cast<char*> (result.getData()) + pos, rng.nextInt (30000));
+                    pos += (size_t) numRead;
+                    expectEquals (in.getPosition(), (int64) pos);
+                }
+
+                expect (result == bigData);
+                expect (in.isExhausted());
+
+                for (int i = 0; i < 50; ++i)
+                {
+                    auto pos = rng.nextInt ((int) bigData.getSize());
+                    expect (in.setPosition (pos));
+
+                    auto block = in.readInPlace ((size_t) rng.nextInt (20000));
+                    expect (! block.empty());
+                    expect (memcmp (block.data(), static_cast<const char*> (bigData.getData()) + pos, block.size()) == 0);
+                    expectEquals (in.getPosition(), (int64) pos + (int64) block.size());
+                }
+
+                expect (in.setPosition ((int64) bigData.getSize()));
+                expect (in.readInPlace (100).empty());
+            }
+
+            bigFile.deleteFile();
+        }
     }
 };
 
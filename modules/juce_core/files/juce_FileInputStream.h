@@ -23,6 +23,8 @@
 namespace juce
 {
 
+class MemoryMappedFile;
+
 //==============================================================================
 /**
     An input stream that reads from a local file.
@@ -43,6 +45,44 @@ public:
     */
     explicit FileInputStream (const File& fileToRead);
 
+    //==============================================================================
+    /** The ways in which a FileInputStream can read its file. */
+    enum class ReadMode
+    {
+        /** Each call to read() goes straight to the operating system. */
+        normal,
+
+        /** Tells the operating system that the file will be read from start to end, so that
+            it reads further ahead, and reads it in large aligned blocks through a alignedBuffer. This
+            is the best choice for scanning through a large file with lots of small reads.
+        */
+        sequential,
+
+        /** Maps the whole file into memory, so that reads are simple copies and readInPlace()
+            can return the data without copying it at all. If the file can't be mapped, the
+            stream falls back to sequential mode.
+        */
+        memoryMapped,
+
+        /** Reads the file in large aligned blocks while bypassing the operating system's cache
+            where possible (O_DIRECT on Linux, F_NOCACHE on macOS and FILE_FLAG_NO_BUFFERING on
+            Windows). Use this for streaming through huge files that will only be read once,
+            so that they don't push everything else out of the cache. If the file system doesn't
+            support it, the stream falls back to sequential mode.
+        */
+        uncached
+    };
+
+    /** Creates a FileInputStream that reads the given file in a particular way.
+
+        @param fileToRead   the file to open
+        @param mode         how the file should be read
+        @param bufferSize   for the buffered modes, the number of bytes to read at a time. This is
+                            rounded up to a multiple of the file system's block size
+        @see ReadMode
+    */
+    FileInputStream (const File& fileToRead, ReadMode mode, size_t bufferSize = defaultBufferSize);
+
     /** Destructor. */
     ~FileInputStream() override;
 
@@ -66,6 +106,24 @@ public:
     */
     bool openedOk() const noexcept                      { return status.wasOk(); }
 
+    /** Returns the mode that the stream is actually using.
+        This may differ from the one that was asked for if the file couldn't be read that way.
+    */
+    ReadMode getReadMode() const noexcept               { return readMode; }
+
+    /** Returns the next block of data without copying it, and moves the stream's position past it.
+
+        In memoryMapped mode, this points straight into the mapped file, and will return as much
+        of the file as asked for. In the other modes, it points into the stream's alignedBuffer, and may
+        return fewer bytes than asked for, but it'll always return some data until the end of the
+        file is reached. A normal stream allocates a alignedBuffer the first time this is called.
+
+        The data stays valid until the next call to a method of this stream.
+    */
+    Span<const std::byte> readInPlace (size_t maxNumBytes);
+
+    /** The alignedBuffer size used if none is given to the constructor. */
+    static constexpr size_t defaultBufferSize = 1024 * 1024;
 
     //==============================================================================
     int64 getTotalLength() override;
@@ -78,11 +136,20 @@ private:
     //==============================================================================
     const File file;
     void* fileHandle = nullptr;
-    int64 currentPosition = 0;
+    int64 currentPosition = 0, handlePosition = 0;
     Result status { Result::ok() };
 
+    ReadMode readMode = ReadMode::normal;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    HeapBlock<char> bufferStorage;
+    char* alignedBuffer = nullptr;
+    size_t bufferSize = 0, numBuffered = 0;
+    int64 bufferStart = 0;
+
     void openHandle();
     size_t readInternal (void*, size_t);
+    void allocateBuffer (size_t);
+    bool fillBuffer();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileInputStream)
 };
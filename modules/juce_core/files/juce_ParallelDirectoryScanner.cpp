@@ -0,0 +1,371 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wdeprecated-declarations")
+JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4996)
+
+// Directories waiting to be listed are kept in a shared queue. Each thread takes one, lists
+// it, and adds any subdirectories it finds back to the queue, and the search is finished
+// when the queue is empty and no thread is still listing a directory.
+struct ParallelDirectoryScanner::State
+{
+    using BatchCallback = std::function<void (const std::vector<DirectoryEntry>&)>;
+
+    State (const Options& o, BatchCallback c)
+        : options (o),
+          callback (std::move (c))
+    {
+        wildCards.addTokens (o.getWildCard(), ";,", "\"'");
+        wildCards.trim();
+        wildCards.removeEmptyStrings();
+        matchAll = wildCards.isEmpty() || wildCards.contains ("*");
+    }
+
+    bool shouldStop() const noexcept
+    {
+        auto* flag = options.getAbortFlag();
+        return flag != nullptr && flag->load (std::memory_order_relaxed);
+    }
+
+    bool nameMatches (const String& filename) const
+    {
+        if (matchAll)
+            return true;
+
+        for (auto& w : wildCards)
+            if (filename.matchesWildcard (w, ! File::areFileNamesCaseSensitive()))
+                return true;
+
+        return false;
+    }
+
+    // Returns false if the directory has been entered already, when cycles are being avoided
+    bool mayRecurseInto (const File& dir, bool isHidden)
+    {
+        if (! options.getRecursion())
+            return false;
+
+        if (isHidden && (options.getTypesToFind() & File::ignoreHiddenFiles) != 0)
+            return false;
+
+        switch (options.getFollowSymlinks())
+        {
+            case File::FollowSymlinks::yes:
+                return true;
+
+            case File::FollowSymlinks::no:
+                return ! dir.isSymbolicLink();
+
+            case File::FollowSymlinks::noCycles:
+            {
+                const std::lock_guard<std::mutex> sl (lock);
+
+                if (dir.isSymbolicLink() && knownPaths.find (dir.getLinkedTarget()) != knownPaths.end())
+                    return false;
+
+                knownPaths.insert (dir);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void scanDirectory (const File& dir, Array<File>& subdirectories, std::vector<DirectoryEntry>& found)
+    {
+        const auto typesToFind = options.getTypesToFind();
+        const auto withMetadata = options.getMetadata();
+        DirectoryIterator it (dir, false, "*", File::findFilesAndDirectories);
+
+        DirectoryEntry entry;
+
+        // Without the metadata, most systems can tell what each entry is from the directory
+        // listing alone, without any extra system calls
+        while (it.next (&entry.directory, &entry.hidden,
+                        withMetadata ? &entry.fileSize : nullptr,
+                        withMetadata ? &entry.modTime : nullptr,
+                        withMetadata ? &entry.creationTime : nullptr,
+                        withMetadata ? &entry.readOnly : nullptr))
+        {
+            if (shouldStop())
+                return;
+
+            const auto& file = it.getFile();
+
+            if (entry.directory && mayRecurseInto (file, entry.hidden))
+                subdirectories.add (file);
+
+            if ((typesToFind & (entry.directory ? File::findDirectories : File::findFiles)) == 0
+                 || (entry.hidden && (typesToFind & File::ignoreHiddenFiles) != 0)
+                 || ! nameMatches (file.getFileName()))
+                continue;
+
+            entry.file = file;
+            found.push_back (entry);
+        }
+    }
+
+    void run()
+    {
+        Array<File> subdirectories;
+        std::vector<DirectoryEntry> found;
+
+        for (;;)
+        {
+            File dir;
+
+            {
+                std::unique_lock<std::mutex> sl (lock);
+                queueChanged.wait (sl, [this] { return ! pending.empty() || numBusy == 0; });
+
+                if (pending.empty())
+                {
+                    queueChanged.notify_all();
+                    return;
+                }
+
+                dir = std::move (pending.back());
+                pending.pop_back();
+                ++numBusy;
+            }
+
+            subdirectories.clearQuick();
+            found.clear();
+
+            if (! shouldStop())
+                scanDirectory (dir, subdirectories, found);
+
+            if (! found.empty())
+                callback (found);
+
+            {
+                const std::lock_guard<std::mutex> sl (lock);
+
+                if (! shouldStop())
+                    for (auto& d : subdirectories)
+                        pending.push_back (d);
+                else
+                    pending.clear();
+
+                --numBusy;
+            }
+
+            queueChanged.notify_all();
+        }
+    }
+
+    const Options options;
+    const BatchCallback callback;
+    StringArray wildCards;
+    bool matchAll = false;
+
+    std::mutex lock;
+    std::condition_variable queueChanged;
+    std::vector<File> pending;
+    std::set<File> knownPaths;
+    int numBusy = 0;
+};
+
+void ParallelDirectoryScanner::forEachEntry (const File& directory, const Options& options,
+                                             const std::function<void (const DirectoryEntry&)>& callback)
+{
+    scan (directory, options, [&callback] (const std::vector<DirectoryEntry>& entries)
+    {
+        for (auto& entry : entries)
+            callback (entry);
+    });
+}
+
+std::vector<DirectoryEntry> ParallelDirectoryScanner::findEntries (const File& directory, const Options& options)
+{
+    std::mutex resultsLock;
+    std::vector<DirectoryEntry> results;
+
+    scan (directory, options, [&] (const std::vector<DirectoryEntry>& entries)
+    {
+        const std::lock_guard<std::mutex> sl (resultsLock);
+        results.insert (results.end(), entries.begin(), entries.end());
+    });
+
+    return results;
+}
+
+void ParallelDirectoryScanner::scan (const File& directory, const Options& options,
+                                     std::function<void (const std::vector<DirectoryEntry>&)> callback)
+{
+    // you have to specify the type of files you're looking for!
+    jassert ((options.getTypesToFind() & (File::findFiles | File::findDirectories)) != 0);
+
+    if (! directory.isDirectory())
+        return;
+
+    // Helper jobs may not start until after this function has returned, so they share
+    // ownership of the state, and will find an empty queue if they start too late
+    auto state = std::make_shared<State> (options, std::move (callback));
+    state->pending.push_back (directory);
+    state->knownPaths.insert (directory);
+
+    auto& pool = options.getThreadPool() != nullptr ? *options.getThreadPool()
+                                                    : getDefaultParallelThreadPool();
+
+    if (options.getRecursion())
+        for (auto i = pool.getNumThreads(); --i >= 0;)
+            pool.addJob ([state] { state->run(); });
+
+    state->run();
+}
+
+JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+JUCE_END_IGNORE_WARNINGS_MSVC
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ParallelDirectoryScannerTests final : public UnitTest
+{
+    ParallelDirectoryScannerTests()
+        : UnitTest ("ParallelDirectoryScanner", UnitTestCategories::files)
+    {}
+
+    static StringArray getSortedPaths (const std::vector<DirectoryEntry>& entries)
+    {
+        StringArray paths;
+
+        for (auto& e : entries)
+            paths.add (e.getFile().getFullPathName());
+
+        paths.sort (false);
+        return paths;
+    }
+
+    static StringArray getSortedPaths (const File& root, bool recursive, const String& wildCard, int types)
+    {
+        StringArray paths;
+
+        for (auto& e : RangedDirectoryIterator (root, recursive, wildCard, types))
+            paths.add (e.getFile().getFullPathName());
+
+        paths.sort (false);
+        return paths;
+    }
+
+    void runTest() override
+    {
+        const TemporaryFile tempFolder;
+        const auto root = tempFolder.getFile();
+        root.createDirectory();
+
+        for (int i = 0; i < 6; ++i)
+        {
+            auto dir = root.getChildFile ("dir" + String (i));
+
+            for (int j = 0; j < 5; ++j)
+            {
+                auto sub = dir.getChildFile ("sub" + String (j));
+                sub.createDirectory();
+
+                for (int k = 0; k < 8; ++k)
+                    sub.getChildFile ("file" + String (k) + (k % 2 == 0 ? ".wav" : ".txt")).replaceWithText (String::repeatedString ("x", k * 100));
+            }
+
+            dir.getChildFile ("top.wav").replaceWithText ("abc");
+        }
+
+        root.getChildFile (".hidden").getChildFile ("secret.wav").create();
+
+        ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (3) };
+        const auto options = ParallelDirectoryScanner::Options{}.withThreadPool (&pool);
+
+        beginTest ("Finds the same entries as RangedDirectoryIterator");
+        {
+            for (auto types : { (int) File::findFiles, (int) File::findDirectories, (int) File::findFilesAndDirectories,
+                                File::findFiles | File::ignoreHiddenFiles })
+            {
+                for (auto recursive : { false, true })
+                {
+                    for (auto wildCard : { "*", "*.wav", "*.wav;file1.*", "sub3" })
+                    {
+                        auto found = ParallelDirectoryScanner::findEntries (root, options.withRecursion (recursive)
+                                                                                         .withWildCard (wildCard)
+                                                                                         .withTypesToFind (types));
+                        expect (getSortedPaths (found) == getSortedPaths (root, recursive, wildCard, types));
+                    }
+                }
+            }
+        }
+
+        beginTest ("Entries");
+        {
+            auto found = ParallelDirectoryScanner::findEntries (root, options.withWildCard ("file4.wav")
+                                                                             .withTypesToFind (File::findFilesAndDirectories)
+                                                                             .withMetadata (true));
+            expectEquals ((int) found.size(), 30);
+
+            for (auto& e : found)
+            {
+                expect (! e.isDirectory());
+                expect (! e.isHidden());
+                expectEquals (e.getFileSize(), (int64) 400);
+                expect (e.getModificationTime() == e.getFile().getLastModificationTime());
+            }
+
+            auto dirs = ParallelDirectoryScanner::findEntries (root, options.withTypesToFind (File::findDirectories));
+            expectEquals ((int) dirs.size(), 6 + 30 + 1);
+
+            for (auto& e : dirs)
+                expect (e.isDirectory() && e.isHidden() == e.getFile().getFileName().startsWith ("."));
+
+            std::atomic<int> numCalls { 0 };
+            ParallelDirectoryScanner::forEachEntry (root, options, [&] (const DirectoryEntry&) { ++numCalls; });
+            expectEquals (numCalls.load(), 6 * 5 * 8 + 6 + 1);
+        }
+
+        beginTest ("Abort");
+        {
+            std::atomic<bool> abort { false };
+            std::atomic<int> numCalls { 0 };
+
+            ParallelDirectoryScanner::forEachEntry (root, options.withAbortFlag (&abort), [&] (const DirectoryEntry&)
+            {
+                ++numCalls;
+                abort = true;
+            });
+
+            expect (numCalls.load() < 6 * 5 * 8);
+
+            expect (ParallelDirectoryScanner::findEntries (root.getChildFile ("nonexistent"), options).empty());
+        }
+
+        root.deleteRecursively();
+    }
+};
+
+static ParallelDirectoryScannerTests parallelDirectoryScannerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class ThreadPool;
+
+//==============================================================================
+/**
+    Searches a directory tree using several threads at once.
+
+    RangedDirectoryIterator visits one directory at a time, which is slow for a big
+    tree, especially on a network drive where each directory listing has to wait for
+    the server. This class lists many directories at the same time instead, on the
+    calling thread and the threads of a ThreadPool. Wildcards are matched as each
+    directory is read, and the file size, times and read-only flag are only looked up
+    if they're asked for.
+
+    The entries are found in no particular order.
+
+    @code
+    auto samples = ParallelDirectoryScanner::findEntries (libraryFolder,
+                                                          ParallelDirectoryScanner::Options{}.withWildCard ("*.wav;*.aif")
+                                                                                             .withMetadata (true));
+    @endcode
+
+    @see RangedDirectoryIterator
+
+    @tags{Core}
+*/
+class JUCE_API  ParallelDirectoryScanner
+{
+public:
+    //==============================================================================
+    /** Describes what to search for. */
+    class JUCE_API  Options
+    {
+    public:
+        /** Whether subdirectories should be searched. The default is true. */
+        [[nodiscard]] Options withRecursion (bool shouldRecurse) const                { return withMember (*this, &Options::recursive, shouldRecurse); }
+
+        /** The file pattern to match, which may contain several patterns separated by a
+            semicolon or comma, e.g. "*.jpg;*.png". The default is "*".
+        */
+        [[nodiscard]] Options withWildCard (const String& pattern) const              { return withMember (*this, &Options::wildCard, pattern); }
+
+        /** A combination of flags from File::TypesOfFileToFind. The default is File::findFiles. */
+        [[nodiscard]] Options withTypesToFind (int whatToLookFor) const               { return withMember (*this, &Options::typesToFind, whatToLookFor); }
+
+        /** The policy to use when symlinks to directories are found. The default is to follow them. */
+        [[nodiscard]] Options withFollowSymlinks (File::FollowSymlinks policy) const  { return withMember (*this, &Options::followSymlinks, policy); }
+
+        /** Whether to fill in the size, times and read-only flag of each entry. These cost
+            extra system calls for each entry on some systems, so the default is false, in which
+            case only the file, and whether it's a directory or hidden, are known.
+        */
+        [[nodiscard]] Options withMetadata (bool shouldFetch) const                   { return withMember (*this, &Options::metadata, shouldFetch); }
+
+        /** The pool whose threads will help with the search. If this is nullptr, which is the
+            default, the pool returned by getDefaultParallelThreadPool() is used.
+        */
+        [[nodiscard]] Options withThreadPool (ThreadPool* pool) const                 { return withMember (*this, &Options::threadPool, pool); }
+
+        /** A flag which can be set from another thread to stop the search early. */
+        [[nodiscard]] Options withAbortFlag (const std::atomic<bool>* flag) const     { return withMember (*this, &Options::abortFlag, flag); }
+
+        bool getRecursion() const noexcept                              { return recursive; }
+        const String& getWildCard() const noexcept                      { return wildCard; }
+        int getTypesToFind() const noexcept                             { return typesToFind; }
+        File::FollowSymlinks getFollowSymlinks() const noexcept         { return followSymlinks; }
+        bool getMetadata() const noexcept                               { return metadata; }
+        ThreadPool* getThreadPool() const noexcept                      { return threadPool; }
+        const std::atomic<bool>* getAbortFlag() const noexcept          { return abortFlag; }
+
+    private:
+        bool recursive = true;
+        String wildCard = "*";
+        int typesToFind = File::findFiles;
+        File::FollowSymlinks followSymlinks = File::FollowSymlinks::yes;
+        bool metadata = false;
+        ThreadPool* threadPool = nullptr;
+        const std::atomic<bool>* abortFlag = nullptr;
+    };
+
+    //==============================================================================
+    /** Calls a function for each entry in a directory tree that matches the options.
+
+        The function is called concurrently from several threads, so it must be
+        thread-safe. This returns when the whole tree has been searched, or when the
+        abort flag has been set.
+    */
+    static void forEachEntry (const File& directory, const Options& options,
+                              const std::function<void (const DirectoryEntry&)>& callback);
+
+    /** Returns all of the entries in a directory tree that match the options, in no
+        particular order.
+    */
+    static std::vector<DirectoryEntry> findEntries (const File& directory, const Options& options);
+
+private:
+    struct State;
+
+    static void scan (const File&, const Options&, std::function<void (const std::vector<DirectoryEntry>&)>);
+};
+
+} // namespace juce
@@ -23,11 +23,217 @@
 namespace juce
 {
 
+//==============================================================================
+struct JSONScanning
+{
+    static bool isPlainStringChar (char c, char quote) noexcept
+    {
+        return c != quote && c != '\\' && (uint8) c >= 0x20;
+    }
+
+    static bool isJSONWhitespace (char c) noexcept
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    // Returns the position of the first quote, backslash or control character at or after p, or
+    // end if there isn't one. If end is nullptr, the text must be null-terminated, and it's only
+    // read one character at a time.
+    static const char* findEndOfPlainText (const char* p, const char* end, char quote) noexcept
+    {
+       #if JUCE_JSON_SCAN_SSE2
+        const auto quotes = _mm_set1_epi8 (quote);
+        const auto backslashes = _mm_set1_epi8 ('\\');
+        const auto highestControlChar = _mm_set1_epi8 (0x1f);
+
+        for (; end != nullptr && end - p >= 16; p += 16)
+        {
+            const auto chars = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (p));
+            const auto isControlChar = _mm_cmpeq_epi8 (_mm_max_epu8 (chars, highestControlChar), highestControlChar);
+            const auto isSpecial = _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (chars, quotes),
+                                                               _mm_cmpeq_epi8 (chars, backslashes)),
+                                                 isControlChar);
+
+            if (const auto mask = (uint32) _mm_movemask_epi8 (isSpecial))
+                return p + getIndexOfLowestBit (mask);
+        }
+       #elif JUCE_JSON_SCAN_NEON
+        const auto quotes = vdupq_n_u8 ((uint8) quote);
+        const auto backslashes = vdupq_n_u8 ('\\');
+        const auto firstPrintableChar = vdupq_n_u8 (0x20);
+
+        for (; end != nullptr && end - p >= 16; p += 16)
+        {
+            const auto chars = vld1q_u8 (reinterpret_cast<const uint8*> (p));
+            const auto isSpecial = vorrq_u8 (vorrq_u8 (vceqq_u8 (chars, quotes), vceqq_u8 (chars, backslashes)),
+                                             vcltq_u8 (chars, firstPrintableChar));
+
+            if (vmaxvq_u8 (isSpecial) != 0)
+                break;
+        }
+       #endif
+
+        while ((end == nullptr || p < end) && isPlainStringChar (*p, quote))
+            ++p;
+
+        return p;
+    }
+
+    // Skips spaces, tabs and line breaks in some null-terminated text, returning the first other
+    // character at or after p. As above, the text is only read in blocks if its end is known.
+    static const char* skipWhitespace (const char* p, const char* end) noexcept
+    {
+       #if JUCE_JSON_SCAN_SSE2
+        // whitespace usually comes in short runs, so check the first few characters before loading a block
+        if (! isJSONWhitespace (p[0]))  return p;
+        if (! isJSONWhitespace (p[1]))  return p + 1;
+
+        for (; end != nullptr && end - p >= 16; p += 16)
+        {
+            const auto chars = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (p));
+            const auto isWhitespace = _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (chars, _mm_set1_epi8 (' ')),
+                                                                  _mm_cmpeq_epi8 (chars, _mm_set1_epi8 ('\n'))),
+                                                    _mm_or_si128 (_mm_cmpeq_epi8 (chars, _mm_set1_epi8 ('\r')),
+                                                                  _mm_cmpeq_epi8 (chars, _mm_set1_epi8 ('\t'))));
+
+            if (const auto mask = (uint32) _mm_movemask_epi8 (isWhitespace) ^ 0xffffu)
+                return p + getIndexOfLowestBit (mask);
+        }
+       #else
+        ignoreUnused (end);
+       #endif
+
+        while (isJSONWhitespace (*p))
+            ++p;
+
+        return p;
+    }
+
+    static bool isAscii (const char* p, size_t numBytes) noexcept
+    {
+        auto* end = p + numBytes;
+
+       #if JUCE_JSON_SCAN_SSE2
+        for (; end - p >= 16; p += 16)
+            if (_mm_movemask_epi8 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (p))) != 0)
+                return false;
+       #endif
+
+        for (; p < end; ++p)
+            if ((uint8) *p >= 0x80)
+                return false;
+
+        return true;
+    }
+
+    static int getIndexOfLowestBit (uint32 mask) noexcept
+    {
+        return countNumberOfBits (mask ^ (mask - 1)) - 1;
+    }
+
+    //==============================================================================
+    /*  Converts the digits of a number without a sign, using Clinger's fast path: when the digits
+        fit exactly into a double's mantissa and the power of ten is exactly representable too, a
+        single multiplication or division gives the correctly rounded result. This covers most of
+        the numbers found in real JSON. If it returns false, the text is left untouched and the
+        number must be converted by CharacterFunctions::readDoubleValue() instead.
+    */
+    static bool readDoubleFast (const char*& text, double& result) noexcept
+    {
+       #if defined (FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+        // with extended-precision arithmetic the result could be rounded twice
+        ignoreUnused (text, result);
+        return false;
+       #else
+        constexpr double exactPowersOfTen[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        constexpr int maxExactPower = (int) numElementsInArray (exactPowersOfTen) - 1;
+        constexpr uint64 maxExactMantissa = (uint64) 1 << 53;
+
+        auto* p = text;
+        uint64 mantissa = 0;
+        int numSignificantDigits = 0, exponent = 0;
+
+        auto readDigits = [&] (int exponentChangePerDigit)
+        {
+            for (; CharacterFunctions::isDigit (*p); ++p)
+            {
+                auto digit = (uint64) (*p - '0');
+
+                if (mantissa != 0 || digit != 0)
+                    ++numSignificantDigits;
+
+                mantissa = mantissa * 10 + digit;
+                exponent += exponentChangePerDigit;
+            }
+        };
+
+        readDigits (0);
+
+        if (*p == '.')
+        {
+            ++p;
+
+            if (! CharacterFunctions::isDigit (*p))
+                return false;
+
+            readDigits (-1);
+        }
+
+        if (numSignificantDigits > 19 || mantissa > maxExactMantissa)
+            return false;
+
+        if (*p == 'e' || *p == 'E')
+        {
+            ++p;
+            const bool isNegativeExponent = (*p == '-');
+
+            if (*p == '-' || *p == '+')
+                ++p;
+
+            if (! CharacterFunctions::isDigit (*p))
+                return false;
+
+            int explicitExponent = 0;
+
+            for (; CharacterFunctions::isDigit (*p); ++p)
+                explicitExponent = jmin (10000, explicitExponent * 10 + (*p - '0'));
+
+            exponent += isNegativeExponent ? -explicitExponent : explicitExponent;
+        }
+
+        if (exponent < -maxExactPower)
+            return false;
+
+        if (exponent > maxExactPower)
+        {
+            // a small mantissa can absorb some of a large exponent and still be exact
+            for (; exponent > maxExactPower && mantissa <= maxExactMantissa / 10; --exponent)
+                mantissa *= 10;
+
+            if (exponent > maxExactPower)
+                return false;
+        }
+
+        result = exponent < 0 ? (double) mantissa / exactPowersOfTen[-exponent]
+                              : (double) mantissa * exactPowersOfTen[exponent];
+        text = p;
+        return true;
+       #endif
+    }
+};
+
+//==============================================================================
 struct JSONParser
 {
-    JSONParser (String::CharPointerType text) : startLocation (text), currentLocation (text) {}
+    JSONParser (String::CharPointerType text) : JSONParser (text, nullptr) {}
+
+    // If the end of the text is known, the parser can scan it in blocks
+    JSONParser (String::CharPointerType text, const char* end)
+        : startLocation (text), currentLocation (text), endOfText (end) {}
 
     String::CharPointerType startLocation, currentLocation;
+    const char* endOfText;
 
     struct ErrorException
     {
@@ -52,7 +258,12 @@ struct JSONParser
         throw e;
     }
 
-    void skipWhitespace()             { currentLocation = currentLocation.findEndOfWhitespace(); }
+    void skipWhitespace()
+    {
+        currentLocation = String::CharPointerType (JSONScanning::skipWhitespace (currentLocation.getAddress(), endOfText))
+                              .findEndOfWhitespace();
+    }
+
     juce_wchar readChar()             { return currentLocation.getAndAdvance(); }
     juce_wchar peekChar() const       { return *currentLocation; }
     bool matchIf (char c)             { if (peekChar() == (juce_wchar) c) { ++currentLocation; return true; } return false; }
@@ -82,10 +293,23 @@ struct JSONParser
 
     String parseString (const juce_wchar quoteChar)
     {
+        auto* start = currentLocation.getAddress();
+        auto* endOfRun = JSONScanning::findEndOfPlainText (start, endOfText, (char) quoteChar);
+
+        // most strings have no escape sequences, so can be copied straight out of the source text
+        if (*endOfRun == (char) quoteChar)
+        {
+            currentLocation = String::CharPointerType (endOfRun + 1);
+            return String (String::CharPointerType (start), String::CharPointerType (endOfRun));
+        }
+
         MemoryOutputStream buffer (256);
 
         for (;;)
         {
+            buffer.write (start, (size_t) (endOfRun - start));
+            currentLocation = String::CharPointerType (endOfRun);
+
             auto c = readChar();
 
             if (c == quoteChar)
@@ -135,6 +359,9 @@ struct JSONParser
                 throwError ("Unexpected EOF in string constant", currentLocation);
 
             buffer.appendUTF8Char (c);
+
+            start = currentLocation.getAddress();
+            endOfRun = JSONScanning::findEndOfPlainText (start, endOfText, (char) quoteChar);
         }
 
         return buffer.toUTF8();
@@ -207,8 +434,19 @@ struct JSONParser
 
             if (c == 'e' || c == 'E' || c == '.')
             {
-                currentLocation = originalPos;
-                auto asDouble = CharacterFunctions::readDoubleValue (currentLocation);
+                double asDouble = 0;
+                const char* text = originalPos.getAddress();
+
+                if (JSONScanning::readDoubleFast (text, asDouble))
+                {
+                    currentLocation = String::CharPointerType (text);
+                }
+                else
+                {
+                    currentLocation = originalPos;
+                    asDouble = CharacterFunctions::readDoubleValue (currentLocation);
+                }
+
                 return var (isNegative ? -asDouble : asDouble);
             }
 
@@ -357,6 +595,102 @@ struct JSONFormatter
         }
     }
 
+    // Writes the shortest decimal text that reads back as exactly the same double, using the
+    // layout of serialiseDouble(), i.e. scientific notation for very large and small values.
+    static void writeDouble (OutputStream& out, double value)
+    {
+        if (! juce_isfinite (value))
+        {
+            out << "null";
+            return;
+        }
+
+        if (std::signbit (value))
+            out << '-';
+
+        const auto absValue = std::abs (value);
+
+        if (exactlyEqual (absValue, 0.0))
+        {
+            out << "0.0";
+            return;
+        }
+
+        char digits[20];
+        int exponent = 0;
+        const auto numDigits = getShortestDigits (absValue, digits, exponent);
+
+        auto writeDigits = [&] (int start, int end)
+        {
+            for (int i = start; i < end; ++i)
+                out << (i < numDigits ? digits[i] : '0');
+        };
+
+        if (absValue >= 1.0e6 || absValue <= 1.0e-5)
+        {
+            writeDigits (0, 1);
+            out << '.';
+            writeDigits (1, jmax (2, numDigits));
+            out << 'e' << exponent;
+        }
+        else if (exponent >= 0)
+        {
+            writeDigits (0, exponent + 1);
+            out << '.';
+            writeDigits (exponent + 1, jmax (exponent + 2, numDigits));
+        }
+        else
+        {
+            out << "0.";
+            out.writeRepeatedByte ('0', (size_t) (-1 - exponent));
+            writeDigits (0, numDigits);
+        }
+    }
+
+    // Fills the buffer with the fewest significant digits that identify the value, returning the
+    // number of digits. The exponent is that of the first digit, as in scientific notation.
+    static int getShortestDigits (double absValue, char* digits, int& exponent)
+    {
+        for (int precision = 15;; ++precision)
+        {
+            char text[40];
+            std::snprintf (text, sizeof (text), "%.*e", precision - 1, absValue);
+
+            // the decimal point depends on the C locale, so only the digits and exponent are used
+            int numDigits = 0;
+            auto* p = text;
+
+            for (; *p != 0 && *p != 'e'; ++p)
+                if (CharacterFunctions::isDigit (*p))
+                    digits[numDigits++] = *p;
+
+            exponent = *p == 'e' ? CharacterFunctions::getIntValue<int> (CharPointer_ASCII (p[1] == '+' ? p + 2 : p + 1)) : 0;
+
+            while (numDigits > 1 && digits[numDigits - 1] == '0')
+                --numDigits;
+
+            if (precision >= 17 || readsBackAs (digits, numDigits, exponent, absValue))
+                return numDigits;
+        }
+    }
+
+    static bool readsBackAs (const char* digits, int numDigits, int exponent, double expected)
+    {
+        char text[48];
+        std::memcpy (text, digits, (size_t) numDigits);
+        std::snprintf (text + numDigits, sizeof (text) - (size_t) numDigits, "e%d", exponent - (numDigits - 1));
+
+        double result = 0;
+
+        if (const char* fastText = text; ! JSONScanning::readDoubleFast (fastText, result))
+        {
+            CharPointer_ASCII t (text);
+            result = CharacterFunctions::readDoubleValue (t);
+        }
+
+        return exactlyEqual (result, expected);
+    }
+
     static void writeSpaces (OutputStream& out, int numSpaces)
     {
         out.writeRepeatedByte (' ', (size_t) numSpaces);
@@ -426,16 +760,7 @@ void JSON::writeToStream (OutputStream& out, const var& v, const FormatOptions&
     }
     else if (v.isDouble())
     {
-        auto d = static_cast<double> (v);
-
-        if (juce_isfinite (d))
-        {
-            out << serialiseDouble (d);
-        }
-        else
-        {
-            out << "null";
-        }
+        JSONFormatter::writeDouble (out, static_cast<double> (v));
     }
     else if (v.isArray())
     {
@@ -479,7 +804,7 @@ var JSON::fromString (StringRef text)
 {
     try
     {
-        return JSONParser (text.text).parseAny();
+        return JSONParser (text.text, text.text.getAddress() + text.text.sizeInBytes() - 1).parseAny();
     }
     catch (const JSONParser::ErrorException&) {}
 
@@ -500,7 +825,8 @@ Result JSON::parse (const String& text, var& result)
 {
     try
     {
-        result = JSONParser (text.getCharPointer()).parseObjectOrArray();
+        auto start = text.getCharPointer();
+        result = JSONParser (start, start.getAddress() + text.getNumBytesAsUTF8()).parseObjectOrArray();
     }
     catch (const JSONParser::ErrorException& error)
     {
@@ -684,7 +1010,7 @@ public:
             tests[0.0123] = "0.0123";
             tests[-3.7e-27] = "-3.7e-27";
             tests[1e+40] = "1.0e40";
-            tests[-12345678901234567.0] = "-1.234567890123457e16";
+            tests[-12345678901234567.0] = "-1.2345678901234568e16";
             tests[192000] = "192000.0";
             tests[1234567] = "1.234567e6";
             tests[0.00006] = "0.00006";
@@ -692,6 +1018,77 @@ public:
 
             for (auto& test : tests)
                 expectEquals (JSON::toString (test.first), test.second);
+
+            expectEquals (JSON::toString (0.1 + 0.2), String ("0.30000000000000004"));
+            expectEquals (JSON::toString (-0.0), String ("-0.0"));
+        }
+
+        {
+            beginTest ("Doubles survive a round trip");
+
+            auto r = getRandom();
+
+            for (int i = 0; i < 10000; ++i)
+            {
+                double value = 0;
+
+                do
+                {
+                    const auto bits = (uint64) r.nextInt64();
+                    std::memcpy (&value, &bits, sizeof (value));
+                }
+                while (! juce_isfinite (value));
+
+                const auto parsed = (double) JSON::parse ("[" + JSON::toString (value) + "]")[0];
+                expect (exactlyEqual (parsed, value) || (exactlyEqual (value, 0.0) && exactlyEqual (parsed, 0.0)));
+            }
+        }
+
+        {
+            beginTest ("Fast number parsing matches the general conversion");
+
+            auto r = getRandom();
+
+            for (int i = 0; i < 10000; ++i)
+            {
+                String text (r.nextInt64() & 0xffffffffffffLL);
+                text = text.replaceSection (1 + r.nextInt (text.length()), 0, ".");
+
+                if (text.endsWithChar ('.'))
+                    text << "0";
+
+                if (r.nextBool())
+                    text = "-" + text;
+
+                if (r.nextBool())
+                    text << "e" << (r.nextInt (80) - 40);
+
+                auto t = text.getCharPointer();
+                const auto expected = CharacterFunctions::readDoubleValue (t);
+                const auto parsed = (double) JSON::parse ("[" + text + "]")[0];
+
+                expect (exactlyEqual (parsed, expected), text);
+            }
+        }
+
+        {
+            beginTest ("Strings with escape sequences at every position");
+
+            for (int length = 0; length < 40; ++length)
+            {
+                for (auto special : { "\\\"", "\\n", "\\u00e9", "\\\\" })
+                {
+                    for (int position = 0; position <= length; ++position)
+                    {
+                        const auto text = String::repeatedString ("a", position) + special + String::repeatedString ("b", length - position);
+                        const auto expected = String::repeatedString ("a", position) + JSON::fromString (String ("\"") + special + "\"").toString()
+                                                + String::repeatedString ("b", length - position);
+
+                        expectEquals (JSON::parse ("[\"" + text + "\"]")[0].toString(), expected);
+                        expectEquals (JSON::parse ("['" + text + "']")[0].toString(), expected);
+                    }
+                }
+            }
         }
     }
 };
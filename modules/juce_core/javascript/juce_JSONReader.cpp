@@ -0,0 +1,745 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+JSONReader::JSONReader (InputStream& source, size_t bufferSizeToUse)
+    : stream (&source),
+      buffer (jmax ((size_t) 16, bufferSizeToUse)),
+      bufferSize (jmax ((size_t) 16, bufferSizeToUse))
+{
+    bufferStart = position = bufferEnd = buffer.get();
+}
+
+JSONReader::JSONReader (const void* data, size_t numBytes)
+{
+    bufferStart = position = static_cast<const char*> (data);
+    bufferEnd = position + numBytes;
+}
+
+JSONReader::~JSONReader() = default;
+
+//==============================================================================
+bool JSONReader::refill()
+{
+    if (stream == nullptr)
+        return false;
+
+    bytesBeforeBuffer += bufferEnd - bufferStart;
+    auto numRead = stream->read (buffer.get(), bufferSize);
+
+    bufferStart = position = buffer.get();
+    bufferEnd = bufferStart + jmax ((ssize_t) 0, numRead);
+    return numRead > 0;
+}
+
+int JSONReader::peekByte()
+{
+    if (position == bufferEnd && ! refill())
+        return -1;
+
+    return (uint8) *position;
+}
+
+void JSONReader::startNewLine()
+{
+    ++line;
+    startOfLine = getLocation().offset;
+}
+
+void JSONReader::skipWhitespace()
+{
+    for (;;)
+    {
+        if (position == bufferEnd && ! refill())
+            return;
+
+        auto c = *position;
+
+        if (c != ' ' && (c < 9 || c > 13))
+            return;
+
+        ++position;
+
+        if (c == '\n')
+            startNewLine();
+    }
+}
+
+bool JSONReader::matchLiteral (const char* text)
+{
+    for (; *text != 0; ++text)
+    {
+        if (peekByte() != (uint8) *text)
+            return false;
+
+        ++position;
+    }
+
+    return true;
+}
+
+JSONReader::Token JSONReader::setError (const String& message, Location location)
+{
+    errorMessage = String (location.line) + ":" + String (location.offset - location.startOfLine + 1)
+                     + ": error: " + message;
+    return token = Token::error;
+}
+
+Result JSONReader::getResult() const
+{
+    return errorMessage.isEmpty() ? Result::ok() : Result::fail (errorMessage);
+}
+
+//==============================================================================
+JSONReader::Token JSONReader::next()
+{
+    if (token == Token::error)
+        return token;
+
+    if (token == Token::none && peekByte() == 0xef && ! matchLiteral ("\xef\xbb\xbf"))
+        return setError ("Syntax error");
+
+    for (;;)
+    {
+        skipWhitespace();
+        auto c = peekByte();
+
+        switch (expecting)
+        {
+            case Expecting::value:
+                if (c < 0)
+                {
+                    if (token != Token::none)
+                        return setError ("Unexpected EOF in object declaration");
+
+                    expecting = Expecting::endOfInput;
+                    return token = Token::endOfInput;
+                }
+
+                return readValueToken (c);
+
+            case Expecting::valueOrEndOfArray:
+                if (c == ']')
+                {
+                    ++position;
+                    return closeContainer (false);
+                }
+
+                if (c < 0)
+                    return setError ("Unexpected EOF in array declaration");
+
+                return readValueToken (c);
+
+            case Expecting::nameOrEndOfObject:
+            {
+                if (c == '}')
+                {
+                    ++position;
+                    return closeContainer (true);
+                }
+
+                if (c < 0)
+                    return setError ("Unexpected EOF in object declaration");
+
+                if (c != '"')
+                    return setError ("Expected a property name in double-quotes");
+
+                ++position;
+                auto nameLocation = getLocation();
+
+                if (! readString ('"'))
+                    return token;
+
+                if (stringData.getDataSize() <= 1)
+                    return setError ("Invalid property name", nameLocation);
+
+                skipWhitespace();
+
+                if (peekByte() != ':')
+                    return setError ("Expected ':'");
+
+                ++position;
+                expecting = Expecting::value;
+                return token = Token::propertyName;
+            }
+
+            case Expecting::separatorOrEnd:
+            {
+                const bool isObject = containers.back();
+
+                if (c == ',')
+                {
+                    ++position;
+                    expecting = isObject ? Expecting::nameOrEndOfObject : Expecting::valueOrEndOfArray;
+                    continue;
+                }
+
+                if (c == (isObject ? '}' : ']'))
+                {
+                    ++position;
+                    return closeContainer (isObject);
+                }
+
+                if (c < 0)
+                    return setError (isObject ? "Unexpected EOF in object declaration" : "Unexpected EOF in array declaration");
+
+                return setError (isObject ? "Expected ',' or '}'" : "Expected ',' or ']'");
+            }
+
+            case Expecting::endOfInput:
+                if (c >= 0)
+                    return setError ("Expected end of input");
+
+                return token = Token::endOfInput;
+        }
+    }
+}
+
+JSONReader::Token JSONReader::readValueToken (int firstByte)
+{
+    auto startLocation = getLocation();
+
+    switch (firstByte)
+    {
+        case '{':
+            ++position;
+            containers.push_back (true);
+            expecting = Expecting::nameOrEndOfObject;
+            return token = Token::beginObject;
+
+        case '[':
+            ++position;
+            containers.push_back (false);
+            expecting = Expecting::valueOrEndOfArray;
+            return token = Token::beginArray;
+
+        case '"':
+        case '\'':
+            ++position;
+            return readString ((char) firstByte) ? endOfValue (Token::string) : token;
+
+        case '-':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            return readNumber();
+
+        case 't':
+            boolValue = true;
+            return matchLiteral ("true") ? endOfValue (Token::boolean) : setError ("Syntax error", startLocation);
+
+        case 'f':
+            boolValue = false;
+            return matchLiteral ("false") ? endOfValue (Token::boolean) : setError ("Syntax error", startLocation);
+
+        case 'n':
+            return matchLiteral ("null") ? endOfValue (Token::null) : setError ("Syntax error", startLocation);
+
+        default:
+            return setError ("Syntax error", startLocation);
+    }
+}
+
+JSONReader::Token JSONReader::endOfValue (Token type)
+{
+    expecting = containers.empty() ? Expecting::endOfInput : Expecting::separatorOrEnd;
+    return token = type;
+}
+
+JSONReader::Token JSONReader::closeContainer (bool isObject)
+{
+    containers.pop_back();
+    return endOfValue (isObject ? Token::endObject : Token::endArray);
+}
+
+//==============================================================================
+int JSONReader::readHexDigits()
+{
+    int result = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        auto c = peekByte();
+        auto digitValue = c < 0 ? -1 : CharacterFunctions::getHexDigitValue ((juce_wchar) c);
+
+        if (digitValue < 0)
+            return -1;
+
+        ++position;
+        result = (result << 4) + digitValue;
+    }
+
+    return result;
+}
+
+bool JSONReader::readString (char quote)
+{
+    auto startLocation = getLocation();
+    stringData.reset();
+    juce_wchar highSurrogate = 0;
+
+    // a surrogate that isn't followed by its other half can't be represented in UTF-8
+    auto flushHighSurrogate = [&]
+    {
+        if (std::exchange (highSurrogate, 0) != 0)
+            stringData.appendUTF8Char (0xfffd);
+    };
+
+    for (;;)
+    {
+        if (position == bufferEnd && ! refill())
+        {
+            setError ("Unexpected EOF in string constant");
+            return false;
+        }
+
+        // copy runs of ordinary characters straight out of the buffer
+        auto* runStart = position;
+        position = JSONScanning::findEndOfPlainText (position, bufferEnd, quote);
+
+        if (position != runStart)
+        {
+            flushHighSurrogate();
+            stringData.write (runStart, (size_t) (position - runStart));
+        }
+
+        if (position == bufferEnd)
+            continue;
+
+        auto c = *position++;
+
+        if (c == quote)
+            break;
+
+        if (c == 0)
+        {
+            setError ("Unexpected EOF in string constant");
+            return false;
+        }
+
+        if (c != '\\')
+        {
+            if (c == '\n')
+                startNewLine();
+
+            flushHighSurrogate();
+            stringData.writeByte (c);
+            continue;
+        }
+
+        auto escapeLocation = getLocation();
+        auto escaped = peekByte();
+
+        if (escaped < 0)
+        {
+            setError ("Unexpected EOF in string constant");
+            return false;
+        }
+
+        ++position;
+
+        if (escaped == 'u')
+        {
+            auto value = readHexDigits();
+
+            if (value < 0)
+            {
+                setError ("Syntax error in unicode escape sequence", escapeLocation);
+                return false;
+            }
+
+            if (value >= 0xdc00 && value < 0xe000 && highSurrogate != 0)
+            {
+                stringData.appendUTF8Char (0x10000 + ((std::exchange (highSurrogate, 0) - 0xd800) << 10) + (juce_wchar) (value - 0xdc00));
+                continue;
+            }
+
+            flushHighSurrogate();
+
+            if (value >= 0xd800 && value < 0xdc00)
+                highSurrogate = (juce_wchar) value;
+            else if (value >= 0xdc00 && value < 0xe000)
+                stringData.appendUTF8Char (0xfffd);
+            else
+                stringData.appendUTF8Char ((juce_wchar) value);
+
+            continue;
+        }
+
+        flushHighSurrogate();
+
+        switch (escaped)
+        {
+            case 'a':  stringData.writeByte ('\a'); break;
+            case 'b':  stringData.writeByte ('\b'); break;
+            case 'f':  stringData.writeByte ('\f'); break;
+            case 'n':  stringData.writeByte ('\n'); break;
+            case 'r':  stringData.writeByte ('\r'); break;
+            case 't':  stringData.writeByte ('\t'); break;
+
+            default:
+                stringData.writeByte ((char) escaped);
+                break;
+        }
+    }
+
+    flushHighSurrogate();
+    stringData.writeByte (0);
+
+    if (! JSONScanning::isAscii (static_cast<const char*> (stringData.getData()), stringData.getDataSize())
+         && ! CharPointer_UTF8::isValidString (static_cast<const char*> (stringData.getData()),
+                                               (int) stringData.getDataSize()))
+    {
+        setError ("Invalid UTF-8 in string constant", startLocation);
+        return false;
+    }
+
+    return true;
+}
+
+JSONReader::Token JSONReader::readNumber()
+{
+    auto startLocation = getLocation();
+    char text[64];
+    size_t length = 0;
+
+    for (;;)
+    {
+        auto c = peekByte();
+
+        if (! (CharacterFunctions::isDigit ((char) c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'))
+            break;
+
+        if (length == sizeof (text) - 1)
+            return setError ("Syntax error in number", startLocation);
+
+        text[length++] = (char) c;
+        ++position;
+    }
+
+    text[length] = 0;
+
+    auto isNegative = text[0] == '-';
+    auto* p = text + (isNegative ? 1 : 0);
+    auto* digits = p;
+    uint64 magnitude = 0;
+    bool isInteger = true;
+
+    if (! CharacterFunctions::isDigit (*p))
+        return setError ("Syntax error in number", startLocation);
+
+    for (; CharacterFunctions::isDigit (*p); ++p)
+    {
+        if (magnitude > (std::numeric_limits<uint64>::max() - 9) / 10)
+            isInteger = false;
+
+        magnitude = magnitude * 10 + (uint64) (*p - '0');
+    }
+
+    if (*p == '.')
+    {
+        isInteger = false;
+
+        if (! CharacterFunctions::isDigit (*++p))
+            return setError ("Syntax error in number", startLocation);
+
+        while (CharacterFunctions::isDigit (*p))
+            ++p;
+    }
+
+    if (*p == 'e' || *p == 'E')
+    {
+        isInteger = false;
+
+        if (*++p == '+' || *p == '-')
+            ++p;
+
+        if (! CharacterFunctions::isDigit (*p))
+            return setError ("Syntax error in number", startLocation);
+
+        while (CharacterFunctions::isDigit (*p))
+            ++p;
+    }
+
+    if (*p != 0)
+        return setError ("Syntax error in number", startLocation);
+
+    if (isInteger && magnitude <= (uint64) std::numeric_limits<int64>::max())
+    {
+        intValue = isNegative ? -(int64) magnitude : (int64) magnitude;
+        return endOfValue (Token::integer);
+    }
+
+    if (const char* fastText = digits; ! JSONScanning::readDoubleFast (fastText, doubleValue))
+    {
+        CharPointer_ASCII number (digits);
+        doubleValue = CharacterFunctions::readDoubleValue (number);
+    }
+
+    if (isNegative)
+        doubleValue = -doubleValue;
+
+    return endOfValue (Token::floatingPoint);
+}
+
+//==============================================================================
+StringRef JSONReader::getString() const noexcept
+{
+    if (token != Token::string && token != Token::propertyName)
+        return {};
+
+    return CharPointer_UTF8 (static_cast<const char*> (stringData.getData()));
+}
+
+int64 JSONReader::getInt64() const noexcept
+{
+    if (token == Token::integer)        return intValue;
+    if (token == Token::floatingPoint)  return (int64) doubleValue;
+
+    return 0;
+}
+
+double JSONReader::getDouble() const noexcept
+{
+    if (token == Token::integer)        return (double) intValue;
+    if (token == Token::floatingPoint)  return doubleValue;
+
+    return 0;
+}
+
+bool JSONReader::skipValue()
+{
+    if (token == Token::propertyName)
+        next();
+
+    if (token == Token::beginObject || token == Token::beginArray)
+        for (auto depth = getDepth(); getDepth() >= depth;)
+            if (next() == Token::error)
+                return false;
+
+    return token != Token::error;
+}
+
+var JSONReader::readValue()
+{
+    if (token == Token::propertyName)
+        next();
+
+    switch (token)
+    {
+        case Token::beginObject:
+        {
+            auto* object = new DynamicObject();
+            var result (object);
+
+            while (next() == Token::propertyName)
+            {
+                auto* name = static_cast<const char*> (stringData.getData());
+                const Identifier identifier (CharPointer_UTF8 (name), CharPointer_UTF8 (name + stringData.getDataSize() - 1));
+                object->setProperty (identifier, readValue());
+            }
+
+            return token == Token::endObject ? result : var();
+        }
+
+        case Token::beginArray:
+        {
+            Array<var> array;
+
+            while (next() != Token::endArray && token != Token::error)
+                array.add (readValue());
+
+            return token == Token::endArray ? var (std::move (array)) : var();
+        }
+
+        case Token::string:
+        {
+            auto* text = static_cast<const char*> (stringData.getData());
+            return String (CharPointer_UTF8 (text), CharPointer_UTF8 (text + stringData.getDataSize() - 1));
+        }
+
+        case Token::integer:
+            return (intValue >= std::numeric_limits<int>::min() && intValue <= std::numeric_limits<int>::max())
+                       ? var ((int) intValue) : var (intValue);
+
+        case Token::floatingPoint:  return doubleValue;
+        case Token::boolean:        return boolValue;
+
+        case Token::none:
+        case Token::endObject:
+        case Token::endArray:
+        case Token::propertyName:
+        case Token::null:
+        case Token::endOfInput:
+        case Token::error:
+            break;
+    }
+
+    return {};
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JSONReaderTests final : public UnitTest
+{
+public:
+    JSONReaderTests()
+        : UnitTest ("JSONReader", UnitTestCategories::json)
+    {}
+
+    void runTest() override
+    {
+        using Token = JSONReader::Token;
+
+        beginTest ("Tokens");
+        {
+            const String text ("{ \"a\": [1, -2.5e1, \"x\\u00e9\\ud83d\\ude00\", true, false, null], \"b\": {}, }");
+            JSONReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+
+            expect (reader.next() == Token::beginObject);
+            expect (reader.next() == Token::propertyName);
+            expect (reader.getString() == StringRef ("a"));
+            expect (reader.next() == Token::beginArray);
+            expectEquals (reader.getDepth(), 2);
+            expect (reader.next() == Token::integer);
+            expectEquals (reader.getInt64(), (int64) 1);
+            expect (reader.next() == Token::floatingPoint);
+            expectEquals (reader.getDouble(), -25.0);
+            expect (reader.next() == Token::string);
+            expectEquals (String (reader.getString()), String (CharPointer_UTF8 ("x\xc3\xa9\xf0\x9f\x98\x80")));
+            expect (reader.next() == Token::boolean);
+            expect (reader.getBool());
+            expect (reader.next() == Token::boolean);
+            expect (! reader.getBool());
+            expect (reader.next() == Token::null);
+            expect (reader.next() == Token::endArray);
+            expect (reader.next() == Token::propertyName);
+            expect (reader.next() == Token::beginObject);
+            expect (reader.next() == Token::endObject);
+            expect (reader.next() == Token::endObject);
+            expectEquals (reader.getDepth(), 0);
+            expect (reader.next() == Token::endOfInput);
+            expect (reader.next() == Token::endOfInput);
+            expect (reader.getResult().wasOk());
+        }
+
+        beginTest ("Numbers");
+        {
+            expect (readAll ("1234").isInt());
+            expect (readAll ("-2147483648").isInt());
+            expect (readAll ("12345678901234").isInt64());
+            expectEquals ((int64) readAll ("-9223372036854775807"), (int64) -9223372036854775807LL);
+            expect (readAll ("123456789012345678901234").isDouble());
+            expectEquals ((double) readAll ("1.123e3"), 1123.0);
+            expectEquals ((double) readAll ("-0.5"), -0.5);
+        }
+
+        beginTest ("Values match JSON::parse");
+        {
+            auto r = getRandom();
+
+            for (int i = 100; --i >= 0;)
+            {
+                var v;
+
+                if (i > 0)
+                    v = JSONTests::createRandomVar (r, 0);
+
+                const auto spacing = (JSON::Spacing) r.nextInt (3);
+                const auto text = JSON::toString (v, JSON::FormatOptions{}.withSpacing (spacing));
+
+                MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+                JSONReader reader (stream, (size_t) (16 + r.nextInt (64)));
+
+                expect (reader.next() != Token::error);
+                const auto parsed = reader.readValue();
+                expect (reader.next() == Token::endOfInput);
+                expect (reader.getResult().wasOk());
+                expectEquals (JSON::toString (parsed, JSON::FormatOptions{}.withSpacing (spacing)), text);
+            }
+        }
+
+        beginTest ("Skipping values");
+        {
+            const String text ("[ { \"a\": [[1], { \"b\": \"]}\" }], \"c\": 3 }, 4 ]");
+            JSONReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+
+            expect (reader.next() == Token::beginArray);
+            expect (reader.next() == Token::beginObject);
+            expect (reader.next() == Token::propertyName);
+            expect (reader.skipValue());
+            expect (reader.getToken() == Token::endArray);
+            expect (reader.next() == Token::propertyName);
+            expect (reader.getString() == StringRef ("c"));
+            expect (reader.skipValue());
+            expectEquals (reader.getInt64(), (int64) 3);
+            expect (reader.next() == Token::endObject);
+            expect (reader.next() == Token::integer);
+            expectEquals (reader.getInt64(), (int64) 4);
+        }
+
+        beginTest ("Errors");
+        {
+            expectError ("[1, 2", "1:6: error: Unexpected EOF in array declaration");
+            expectError ("{\"a\" 1}", "1:6: error: Expected ':'");
+            expectError ("[1 2]", "1:4: error: Expected ',' or ']'");
+            expectError ("{\"a\": 1 ]", "1:9: error: Expected ',' or '}'");
+            expectError ("{1: 2}", "1:2: error: Expected a property name in double-quotes");
+            expectError ("[\n\"abc", "2:5: error: Unexpected EOF in string constant");
+            expectError ("[tru]", "1:2: error: Syntax error");
+            expectError ("[1.e5]", "1:2: error: Syntax error in number");
+            expectError ("[\"\\u12x4\"]", "1:4: error: Syntax error in unicode escape sequence");
+            expectError ("[\"\xff\"]", "1:3: error: Invalid UTF-8 in string constant");
+            expectError ("[1] 2", "1:5: error: Expected end of input");
+            expectError ("", {});
+        }
+    }
+
+private:
+    static var readAll (const String& text)
+    {
+        JSONReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+        reader.next();
+        return reader.readValue();
+    }
+
+    void expectError (const char* text, const String& expectedError)
+    {
+        JSONReader reader (text, strlen (text));
+
+        while (reader.next() != JSONReader::Token::endOfInput && reader.getToken() != JSONReader::Token::error)
+        {}
+
+        expectEquals (reader.getResult().getErrorMessage(), expectedError);
+        expect (reader.next() == (expectedError.isEmpty() ? JSONReader::Token::endOfInput : JSONReader::Token::error));
+    }
+};
+
+static JSONReaderTests jsonReaderTests;
+
+#endif
+
+} // namespace juce
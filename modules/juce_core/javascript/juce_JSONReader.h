@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads JSON-formatted text one token at a time, without building a tree of vars.
+
+    JSON::parse() always creates a complete var structure for the whole document, which
+    is wasteful when the document is very large, or when its contents are only going to
+    be copied into some other data structure. A JSONReader instead reports each part of
+    the document in turn, so only the token that is currently being looked at needs to
+    be held in memory.
+
+    The text can be read either from an InputStream, in which case it's pulled into a
+    fixed-size buffer as needed, or from a block of memory (e.g. a MemoryMappedFile),
+    which is read in place.
+
+    @code
+    JSONReader reader (stream);
+
+    while (reader.next() != JSONReader::Token::endOfInput)
+    {
+        if (reader.getToken() == JSONReader::Token::error)
+        {
+            DBG (reader.getResult().getErrorMessage());
+            break;
+        }
+
+        if (reader.getToken() == JSONReader::Token::propertyName && reader.getString() == StringRef ("samples"))
+            loadSamples (reader.readValue());
+    }
+    @endcode
+
+    Unlike JSON::parse(), the top-level item doesn't have to be an object or an array.
+    The reader accepts the same relaxed syntax as JSON::parse(), i.e. single-quoted strings
+    and trailing commas, and the input text must be encoded as UTF-8.
+
+    @see JSONWriter, JSON
+
+    @tags{Core}
+*/
+class JUCE_API  JSONReader
+{
+public:
+    //==============================================================================
+    /** Creates a reader that pulls its text from a stream.
+
+        The stream must remain valid for the lifetime of the reader, and is read in
+        chunks of the given size.
+    */
+    explicit JSONReader (InputStream& source, size_t bufferSizeToUse = 65536);
+
+    /** Creates a reader that parses a block of UTF-8 text in memory.
+
+        The data isn't copied, so it must remain valid for the lifetime of the reader.
+    */
+    JSONReader (const void* data, size_t numBytes);
+
+    /** Destructor. */
+    ~JSONReader();
+
+    //==============================================================================
+    /** The kinds of token that the reader can produce. */
+    enum class Token
+    {
+        none,           ///< next() hasn't been called yet
+        beginObject,    ///< A '{' character
+        endObject,      ///< A '}' character
+        beginArray,     ///< A '[' character
+        endArray,       ///< A ']' character
+        propertyName,   ///< The name of an object's property, which is available from getString()
+        string,         ///< A string value, which is available from getString()
+        integer,        ///< A number with no fractional part or exponent, which is available from getInt64()
+        floatingPoint,  ///< Any other number, which is available from getDouble()
+        boolean,        ///< A true or false value, which is available from getBool()
+        null,           ///< A null value
+        endOfInput,     ///< The complete top-level item has been read
+        error           ///< The text was malformed; getResult() describes the problem
+    };
+
+    /** Moves on to the next token, and returns its type.
+
+        Once an error has been encountered, this will keep returning Token::error.
+    */
+    Token next();
+
+    /** Returns the type of the current token. */
+    Token getToken() const noexcept                 { return token; }
+
+    /** Returns the text of the current propertyName or string token.
+
+        The text is only valid until next() is called again.
+    */
+    StringRef getString() const noexcept;
+
+    /** Returns the value of the current integer token.
+        If the token is a floatingPoint, the value will be truncated.
+    */
+    int64 getInt64() const noexcept;
+
+    /** Returns the value of the current integer or floatingPoint token. */
+    double getDouble() const noexcept;
+
+    /** Returns the value of the current boolean token. */
+    bool getBool() const noexcept                   { return boolValue; }
+
+    /** Returns the number of objects and arrays that enclose the current position.
+        After a beginObject or beginArray token, this includes the new item.
+    */
+    int getDepth() const noexcept                   { return (int) containers.size(); }
+
+    /** Returns an error describing the problem if the text was malformed, or
+        Result::ok() if everything read so far was valid.
+    */
+    Result getResult() const;
+
+    //==============================================================================
+    /** Skips over the current value.
+
+        If the current token is a propertyName, this skips the value of that property. If
+        it's a beginObject or beginArray, the reader will move on to the matching endObject
+        or endArray. For any other token, this does nothing.
+
+        Returns false if an error was encountered.
+    */
+    bool skipValue();
+
+    /** Reads the current value into a var.
+
+        This is handy for pulling out small parts of a large document. The current token
+        is treated in the same way as for skipValue(), so after this call the reader is
+        positioned at the last token of the value that was read. If an error is encountered,
+        this returns a void var and getResult() describes the problem.
+    */
+    var readValue();
+
+private:
+    //==============================================================================
+    enum class Expecting : uint8
+    {
+        value,
+        valueOrEndOfArray,
+        nameOrEndOfObject,
+        separatorOrEnd,
+        endOfInput
+    };
+
+    InputStream* stream = nullptr;
+    HeapBlock<char> buffer;
+    size_t bufferSize = 0;
+    const char* bufferStart = nullptr;
+    const char* position = nullptr;
+    const char* bufferEnd = nullptr;
+    int64 bytesBeforeBuffer = 0, startOfLine = 0;
+    int line = 1;
+
+    std::vector<bool> containers;   // true for objects, false for arrays
+    Expecting expecting = Expecting::value;
+    Token token = Token::none;
+
+    MemoryOutputStream stringData;
+    int64 intValue = 0;
+    double doubleValue = 0;
+    bool boolValue = false;
+    String errorMessage;
+
+    bool refill();
+    int peekByte();
+    struct Location
+    {
+        int64 offset, startOfLine;
+        int line;
+    };
+
+    Location getLocation() const noexcept   { return { bytesBeforeBuffer + (position - bufferStart), startOfLine, line }; }
+    Token setError (const String& message, Location);
+    Token setError (const String& message)  { return setError (message, getLocation()); }
+
+    void skipWhitespace();
+    void startNewLine();
+    bool matchLiteral (const char* text);
+    Token readValueToken (int firstByte);
+    bool readString (char quote);
+    Token readNumber();
+    Token endOfValue (Token type);
+    Token closeContainer (bool isObject);
+    int readHexDigits();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JSONReader)
+};
+
+} // namespace juce
@@ -0,0 +1,291 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+JSONWriter::JSONWriter (OutputStream& destination, const JSON::FormatOptions& formatToUse)
+    : out (destination), format (formatToUse)
+{
+}
+
+JSONWriter::~JSONWriter()
+{
+    // All the objects and arrays should have been ended!
+    jassert (containers.empty());
+}
+
+int JSONWriter::getIndentLevel() const noexcept
+{
+    return format.getIndentLevel() + JSONFormatter::indentSize * getDepth();
+}
+
+//==============================================================================
+void JSONWriter::startItem()
+{
+    auto& container = containers.back();
+
+    if (! container.isEmpty)
+    {
+        out << ',';
+
+        switch (format.getSpacing())
+        {
+            case JSON::Spacing::none: break;
+            case JSON::Spacing::singleLine: out << ' '; break;
+            case JSON::Spacing::multiLine: out << newLine; break;
+        }
+    }
+    else if (! container.isObject && format.getSpacing() == JSON::Spacing::multiLine)
+    {
+        out << newLine;
+    }
+
+    container.isEmpty = false;
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+        JSONFormatter::writeSpaces (out, getIndentLevel());
+}
+
+void JSONWriter::startValue()
+{
+    // Only one top-level item can be written!
+    jassert (! complete);
+
+    if (containers.empty())
+        return;
+
+    if (containers.back().isObject)
+    {
+        // Each value in an object must be preceded by a call to writeName()!
+        jassert (nameWritten);
+        nameWritten = false;
+        return;
+    }
+
+    startItem();
+}
+
+void JSONWriter::endValue()
+{
+    complete = containers.empty();
+}
+
+void JSONWriter::beginContainer (bool isObject, char openingBracket)
+{
+    startValue();
+    out << openingBracket;
+    containers.push_back ({ isObject, true });
+
+    if (isObject && format.getSpacing() == JSON::Spacing::multiLine)
+        out << newLine;
+}
+
+void JSONWriter::endContainer (bool isObject, char closingBracket)
+{
+    // The item being ended must be the one that was most recently begun, and an
+    // object's last name must be followed by a value!
+    jassert (! containers.empty() && containers.back().isObject == isObject && ! nameWritten);
+
+    if (containers.empty())
+        return;
+
+    auto container = containers.back();
+    containers.pop_back();
+
+    if (format.getSpacing() == JSON::Spacing::multiLine && (isObject || ! container.isEmpty))
+    {
+        if (! container.isEmpty)
+            out << newLine;
+
+        JSONFormatter::writeSpaces (out, getIndentLevel());
+    }
+
+    out << closingBracket;
+    endValue();
+}
+
+void JSONWriter::beginObject()  { beginContainer (true, '{'); }
+void JSONWriter::endObject()    { endContainer (true, '}'); }
+void JSONWriter::beginArray()   { beginContainer (false, '['); }
+void JSONWriter::endArray()     { endContainer (false, ']'); }
+
+void JSONWriter::writeName (StringRef name)
+{
+    // Names can only be written inside an object, and each one must be followed by a value!
+    jassert (! containers.empty() && containers.back().isObject && ! nameWritten);
+
+    startItem();
+    out << '"';
+    JSONFormatter::writeString (out, name.text);
+    out << "\":";
+
+    if (format.getSpacing() != JSON::Spacing::none)
+        out << ' ';
+
+    nameWritten = true;
+}
+
+//==============================================================================
+void JSONWriter::writeString (StringRef value)
+{
+    startValue();
+    out << '"';
+    JSONFormatter::writeString (out, value.text);
+    out << '"';
+    endValue();
+}
+
+void JSONWriter::writeInt64 (int64 value)
+{
+    startValue();
+    out << value;
+    endValue();
+}
+
+void JSONWriter::writeDouble (double value)
+{
+    startValue();
+    JSONFormatter::writeDouble (out, value);
+    endValue();
+}
+
+void JSONWriter::writeBool (bool value)
+{
+    startValue();
+    out << (value ? "true" : "false");
+    endValue();
+}
+
+void JSONWriter::writeNull()
+{
+    startValue();
+    out << "null";
+    endValue();
+}
+
+void JSONWriter::writeValue (const var& value)
+{
+    startValue();
+    JSON::writeToStream (out, value, format.withIndentLevel (getIndentLevel()));
+    endValue();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JSONWriterTests final : public UnitTest
+{
+public:
+    JSONWriterTests()
+        : UnitTest ("JSONWriter", UnitTestCategories::json)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Output matches JSON::writeToStream");
+        {
+            auto r = getRandom();
+
+            for (int i = 100; --i >= 0;)
+            {
+                const auto v = JSONTests::createRandomVar (r, 0);
+                const auto format = JSON::FormatOptions{}.withSpacing ((JSON::Spacing) r.nextInt (3))
+                                                         .withIndentLevel (r.nextBool() ? 0 : 4);
+
+                MemoryOutputStream stream;
+
+                {
+                    JSONWriter writer (stream, format);
+                    write (writer, v, r);
+                    expect (writer.isComplete());
+                }
+
+                expectEquals (stream.toString(), JSON::toString (v, format));
+            }
+        }
+
+        beginTest ("Empty containers");
+        {
+            for (auto spacing : { JSON::Spacing::none, JSON::Spacing::singleLine, JSON::Spacing::multiLine })
+            {
+                const auto format = JSON::FormatOptions{}.withSpacing (spacing);
+                MemoryOutputStream stream;
+                JSONWriter writer (stream, format);
+
+                writer.beginArray();
+                writer.beginObject();
+                writer.endObject();
+                writer.beginArray();
+                writer.endArray();
+                writer.endArray();
+
+                expectEquals (stream.toString(), JSON::toString (JSON::parse ("[{}, []]"), format));
+            }
+        }
+    }
+
+private:
+    // Writes items using the most specific method, but sometimes passes a whole var
+    // to check that the two are interchangeable.
+    static void write (JSONWriter& writer, const var& v, Random& r)
+    {
+        if (r.nextInt (4) == 0)
+        {
+            writer.writeValue (v);
+        }
+        else if (auto* object = v.getDynamicObject())
+        {
+            writer.beginObject();
+
+            for (auto& property : object->getProperties())
+            {
+                writer.writeName (property.name);
+                write (writer, property.value, r);
+            }
+
+            writer.endObject();
+        }
+        else if (auto* array = v.getArray())
+        {
+            writer.beginArray();
+
+            for (auto& item : *array)
+                write (writer, item, r);
+
+            writer.endArray();
+        }
+        else if (v.isString())      writer.writeString (v.toString());
+        else if (v.isBool())        writer.writeBool (v);
+        else if (v.isDouble())      writer.writeDouble (v);
+        else if (v.isVoid())        writer.writeNull();
+        else                        writer.writeInt64 (v);
+    }
+};
+
+static JSONWriterTests jsonWriterTests;
+
+#endif
+
+} // namespace juce
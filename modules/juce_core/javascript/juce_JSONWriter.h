@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Writes JSON-formatted text to a stream one item at a time, without needing a
+    var that holds the whole document.
+
+    The output is laid out in exactly the same way as JSON::writeToStream() would lay out
+    the equivalent var, using the spacing from the FormatOptions that are supplied.
+
+    @code
+    JSONWriter writer (stream);
+    writer.beginObject();
+    writer.writeName ("samples");
+    writer.beginArray();
+
+    for (auto sample : samples)
+        writer.writeDouble (sample);
+
+    writer.endArray();
+    writer.endObject();
+    @endcode
+
+    Inside an object, each value must be preceded by a call to writeName(). Only a single
+    top-level item can be written.
+
+    @see JSONReader, JSON
+
+    @tags{Core}
+*/
+class JUCE_API  JSONWriter
+{
+public:
+    //==============================================================================
+    /** Creates a writer that sends its output to the given stream, which must remain
+        valid for the lifetime of the writer.
+    */
+    explicit JSONWriter (OutputStream& destination,
+                         const JSON::FormatOptions& format = JSON::FormatOptions{});
+
+    /** Destructor.
+        All the objects and arrays that were begun should have been ended by the time
+        the writer is deleted.
+    */
+    ~JSONWriter();
+
+    //==============================================================================
+    /** Starts writing an object. */
+    void beginObject();
+
+    /** Finishes the object that was most recently begun. */
+    void endObject();
+
+    /** Starts writing an array. */
+    void beginArray();
+
+    /** Finishes the array that was most recently begun. */
+    void endArray();
+
+    /** Writes the name of the next property in the current object. */
+    void writeName (StringRef name);
+
+    //==============================================================================
+    /** Writes a string value. */
+    void writeString (StringRef value);
+
+    /** Writes an integer value. */
+    void writeInt64 (int64 value);
+
+    /** Writes a floating point value. Values that aren't finite are written as null. */
+    void writeDouble (double value);
+
+    /** Writes a boolean value. */
+    void writeBool (bool value);
+
+    /** Writes a null value. */
+    void writeNull();
+
+    /** Writes a var, in the same format as JSON::writeToStream(). */
+    void writeValue (const var& value);
+
+    //==============================================================================
+    /** Returns the number of objects and arrays that have been begun but not yet ended. */
+    int getDepth() const noexcept           { return (int) containers.size(); }
+
+    /** Returns true once a complete top-level item has been written. */
+    bool isComplete() const noexcept        { return complete; }
+
+private:
+    //==============================================================================
+    struct Container
+    {
+        bool isObject = false, isEmpty = true;
+    };
+
+    OutputStream& out;
+    const JSON::FormatOptions format;
+    std::vector<Container> containers;
+    bool nameWritten = false, complete = false;
+
+    int getIndentLevel() const noexcept;
+    void startItem();
+    void startValue();
+    void endValue();
+    void beginContainer (bool isObject, char openingBracket);
+    void endContainer (bool isObject, char closingBracket);
+
+    JUCE_DECLARE_NON_COPYABLE (JSONWriter)
+};
+
+} // namespace juce
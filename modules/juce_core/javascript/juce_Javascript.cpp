@@ -102,6 +102,25 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     static Identifier getPrototypeIdentifier()                { static const Identifier i ("prototype"); return i; }
     static var* getPropertyPointer (DynamicObject& o, const Identifier& i) noexcept   { return o.getProperties().getVarPointer (i); }
 
+    // Each expression that looks up a name keeps the index at which it last found it, and
+    // tries that slot first. As the same code usually runs against objects and scopes with
+    // the same layout, this acts like an inline cache, and mostly avoids searching.
+    static var* getPropertyPointer (DynamicObject& o, const Identifier& i, int& cachedIndex) noexcept
+    {
+        auto& props = o.getProperties();
+
+        if (isPositiveAndBelow (cachedIndex, props.size()) && props.begin()[cachedIndex].name == i)
+            return props.getVarPointerAt (cachedIndex);
+
+        auto index = props.indexOf (i);
+
+        if (index < 0)
+            return nullptr;
+
+        cachedIndex = index;
+        return props.getVarPointerAt (index);
+    }
+
     //==============================================================================
     struct CodeLocation
     {
@@ -128,12 +147,14 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     //==============================================================================
     struct Scope
     {
-        Scope (const Scope* p, ReferenceCountedObjectPtr<RootObject> rt, DynamicObject::Ptr scp) noexcept
-            : parent (p), root (std::move (rt)),
+        // The root object isn't reference-counted here, as it's kept alive by the engine (or by
+        // the var that an eval() call was made on) for as long as any scope refers to it
+        Scope (const Scope* p, RootObject& rt, DynamicObject::Ptr scp) noexcept
+            : parent (p), root (rt),
               scope (std::move (scp)) {}
 
         const Scope* const parent;
-        ReferenceCountedObjectPtr<RootObject> root;
+        RootObject& root;
         DynamicObject::Ptr scope;
 
         var findFunctionCall (const CodeLocation& location, const var& targetObject, const Identifier& functionName) const
@@ -172,7 +193,7 @@ struct JavascriptEngine::RootObject final : public DynamicObject
 
         var* findRootClassProperty (const Identifier& className, const Identifier& propName) const
         {
-            if (auto* cls = root->getProperty (className).getDynamicObject())
+            if (auto* cls = root.getProperty (className).getDynamicObject())
                 return getPropertyPointer (*cls, propName);
 
             return nullptr;
@@ -187,6 +208,23 @@ struct JavascriptEngine::RootObject final : public DynamicObject
                                      : var::undefined();
         }
 
+        var findSymbolInParentScopes (const Identifier& name, int& cachedIndex) const
+        {
+            if (auto* v = findSymbolPointer (name, cachedIndex))
+                return *v;
+
+            return var::undefined();
+        }
+
+        const var* findSymbolPointer (const Identifier& name, int& cachedIndex) const
+        {
+            for (auto* s = this; s != nullptr; s = s->parent)
+                if (auto v = getPropertyPointer (*s->scope, name, cachedIndex))
+                    return v;
+
+            return nullptr;
+        }
+
         bool findAndInvokeMethod (const Identifier& function, const var::NativeFunctionArgs& args, var& result) const
         {
             auto* target = args.thisObject.getDynamicObject();
@@ -207,7 +245,7 @@ struct JavascriptEngine::RootObject final : public DynamicObject
 
             for (int i = 0; i < props.size(); ++i)
                 if (auto* o = props.getValueAt (i).getDynamicObject())
-                    if (Scope (this, *root, *o).findAndInvokeMethod (function, args, result))
+                    if (Scope (this, root, *o).findAndInvokeMethod (function, args, result))
                         return true;
 
             return false;
@@ -234,8 +272,8 @@ struct JavascriptEngine::RootObject final : public DynamicObject
 
         void checkTimeOut (const CodeLocation& location) const
         {
-            if (Time::getCurrentTime() > root->timeout)
-                location.throwError (root->timeout == Time() ? "Interrupted" : "Execution timed-out");
+            if (Time::getCurrentTime() > root.timeout)
+                location.throwError (root.timeout == Time() ? "Interrupted" : "Execution timed-out");
         }
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Scope)
@@ -261,6 +299,11 @@ struct JavascriptEngine::RootObject final : public DynamicObject
         virtual var getResult (const Scope&) const            { return var::undefined(); }
         virtual void assign (const Scope&, const var&) const  { location.throwError ("Cannot assign to this expression!"); }
 
+        // If the expression's value can be found without running any code, this returns a pointer
+        // to where it's stored, so that it can be read without copying it. The pointer is only
+        // valid until the next expression is evaluated.
+        virtual const var* getResultPointer (const Scope&) const  { return nullptr; }
+
         ResultCode perform (const Scope& s, var*) const override  { getResult (s); return ok; }
     };
 
@@ -367,7 +410,8 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     struct LiteralValue final : public Expression
     {
         LiteralValue (const CodeLocation& l, const var& v) noexcept : Expression (l), value (v) {}
-        var getResult (const Scope&) const override   { return value; }
+        var getResult (const Scope&) const override                 { return value; }
+        const var* getResultPointer (const Scope&) const override   { return &value; }
         var value;
     };
 
@@ -375,17 +419,19 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         UnqualifiedName (const CodeLocation& l, const Identifier& n) noexcept : Expression (l), name (n) {}
 
-        var getResult (const Scope& s) const override  { return s.findSymbolInParentScopes (name); }
+        var getResult (const Scope& s) const override                 { return s.findSymbolInParentScopes (name, cachedIndex); }
+        const var* getResultPointer (const Scope& s) const override   { return s.findSymbolPointer (name, cachedIndex); }
 
         void assign (const Scope& s, const var& newValue) const override
         {
-            if (auto* v = getPropertyPointer (*s.scope, name))
+            if (auto* v = getPropertyPointer (*s.scope, name, cachedIndex))
                 *v = newValue;
             else
-                s.root->setProperty (name, newValue);
+                s.root.setProperty (name, newValue);
         }
 
         Identifier name;
+        mutable int cachedIndex = -1;
     };
 
     struct DotOperator final : public Expression
@@ -394,7 +440,14 @@ struct JavascriptEngine::RootObject final : public DynamicObject
 
         var getResult (const Scope& s) const override
         {
-            auto p = parent->getResult (s);
+            if (auto* p = parent->getResultPointer (s))
+                return getChild (*p);
+
+            return getChild (parent->getResult (s));
+        }
+
+        var getChild (const var& p) const
+        {
             static const Identifier lengthID ("length");
 
             if (child == lengthID)
@@ -404,7 +457,7 @@ struct JavascriptEngine::RootObject final : public DynamicObject
             }
 
             if (auto* o = p.getDynamicObject())
-                if (auto* v = getPropertyPointer (*o, child))
+                if (auto* v = getPropertyPointer (*o, child, cachedIndex))
                     return *v;
 
             return var::undefined();
@@ -412,7 +465,16 @@ struct JavascriptEngine::RootObject final : public DynamicObject
 
         void assign (const Scope& s, const var& newValue) const override
         {
-            if (auto* o = parent->getResult (s).getDynamicObject())
+            auto* p = parent->getResultPointer (s);
+            var temp;
+
+            if (p == nullptr)
+            {
+                temp = parent->getResult (s);
+                p = &temp;
+            }
+
+            if (DynamicObject::Ptr o = p->getDynamicObject())
                 o->setProperty (child, newValue);
             else
                 Expression::assign (s, newValue);
@@ -420,6 +482,7 @@ struct JavascriptEngine::RootObject final : public DynamicObject
 
         ExpPtr parent;
         Identifier child;
+        mutable int cachedIndex = -1;
     };
 
     struct ArraySubscript final : public Expression
@@ -428,9 +491,19 @@ struct JavascriptEngine::RootObject final : public DynamicObject
 
         var getResult (const Scope& s) const override
         {
+            // Looking up a name or literal has no side-effects, so if both terms are simple, they
+            // can be read in place without copying the array or object
+            if (auto* key = index->getResultPointer (s))
+                if (auto* arrayVar = object->getResultPointer (s))
+                    return getElement (*arrayVar, *key);
+
             auto arrayVar = object->getResult (s); // must stay alive for the scope of this method
             auto key = index->getResult (s);
+            return getElement (arrayVar, key);
+        }
 
+        static var getElement (const var& arrayVar, const var& key)
+        {
             if (const auto* array = arrayVar.getArray())
                 if (key.isInt() || key.isInt64() || key.isDouble())
                     return (*array) [static_cast<int> (key)];
@@ -736,12 +809,23 @@ struct JavascriptEngine::RootObject final : public DynamicObject
         var invokeFunction (const Scope& s, const var& function, const var& thisObject) const
         {
             s.checkTimeOut (location);
-            Array<var> argVars;
 
-            for (auto* a : arguments)
-                argVars.add (a->getResult (s));
+            // most calls only have a few arguments, so this avoids allocating space for them
+            var localArgs[4];
+            Array<var> allocatedArgs;
+            auto* argVars = localArgs;
+            auto numArgs = arguments.size();
+
+            if (numArgs > numElementsInArray (localArgs))
+            {
+                allocatedArgs.resize (numArgs);
+                argVars = allocatedArgs.begin();
+            }
+
+            for (int i = 0; i < numArgs; ++i)
+                argVars[i] = arguments.getUnchecked (i)->getResult (s);
 
-            const var::NativeFunctionArgs args (thisObject, argVars.begin(), argVars.size());
+            const var::NativeFunctionArgs args (thisObject, argVars, numArgs);
 
             if (var::NativeFunction nativeFunction = function.getNativeFunction())
                 return nativeFunction (args);
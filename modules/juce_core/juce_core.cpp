@@ -37,6 +37,7 @@
 #include "juce_core.h"
 
 #include <cctype>
+#include <cfloat>
 #include <cstdarg>
 #include <locale>
 #include <thread>
@@ -117,6 +118,14 @@
  #include <android/log.h>
 #endif
 
+#if JUCE_INTEL && ! (JUCE_MINGW && ! defined (__SSE2__))
+ #define JUCE_JSON_SCAN_SSE2 1
+ #include <emmintrin.h>
+#elif JUCE_ARM && JUCE_64BIT && (defined (__ARM_NEON__) || defined (__ARM_NEON))
+ #define JUCE_JSON_SCAN_NEON 1
+ #include <arm_neon.h>
+#endif
+
 #undef check
 
 //==============================================================================
@@ -127,9 +136,11 @@
 #include "containers/juce_OwnedArray.cpp"
 #include "containers/juce_PropertySet.cpp"
 #include "containers/juce_ReferenceCountedArray.cpp"
+#include "containers/juce_SnapshotListenerList.cpp"
 #include "containers/juce_SparseSet.cpp"
 #include "files/juce_DirectoryIterator.cpp"
 #include "files/juce_RangedDirectoryIterator.cpp"
+#include "files/juce_ParallelDirectoryScanner.cpp"
 #include "files/juce_File.cpp"
 #include "files/juce_FileInputStream.cpp"
 #include "files/juce_FileOutputStream.cpp"
@@ -137,11 +148,15 @@
 #include "files/juce_TemporaryFile.cpp"
 #include "logging/juce_FileLogger.cpp"
 #include "logging/juce_Logger.cpp"
+#include "logging/juce_AsyncFileLogger.cpp"
 #include "maths/juce_BigInteger.cpp"
 #include "maths/juce_Expression.cpp"
 #include "maths/juce_Random.cpp"
 #include "memory/juce_MemoryBlock.cpp"
 #include "memory/juce_AllocationHooks.cpp"
+#include "memory/juce_MonotonicArena.cpp"
+#include "memory/juce_ShardedCounter.cpp"
+#include "memory/juce_RealtimeMemoryPool.cpp"
 #include "misc/juce_RuntimePermissions.cpp"
 #include "misc/juce_Result.cpp"
 #include "misc/juce_Uuid.cpp"
@@ -150,6 +165,8 @@
 #include "network/juce_MACAddress.cpp"
 #include "network/juce_NamedPipe.cpp"
 #include "network/juce_Socket.cpp"
+#include "network/juce_SocketReactor.cpp"
+#include "network/juce_SharedMemoryRing.cpp"
 #include "network/juce_IPAddress.cpp"
 #include "streams/juce_BufferedInputStream.cpp"
 #include "streams/juce_FileInputSource.cpp"
@@ -157,6 +174,7 @@
 #include "streams/juce_MemoryInputStream.cpp"
 #include "streams/juce_MemoryOutputStream.cpp"
 #include "streams/juce_SubregionStream.cpp"
+#include "streams/juce_ThreadedOutputStream.cpp"
 #include "system/juce_SystemStats.cpp"
 #include "text/juce_CharacterFunctions.cpp"
 #include "text/juce_Identifier.cpp"
@@ -170,22 +188,32 @@
 #include "text/juce_Base64.cpp"
 #include "threads/juce_ReadWriteLock.cpp"
 #include "threads/juce_Thread.cpp"
+#include "threads/juce_RealtimeSafetyChecker.cpp"
 #include "threads/juce_ThreadPool.cpp"
+#include "threads/juce_ParallelAlgorithms.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
 #include "time/juce_PerformanceCounter.cpp"
 #include "time/juce_RelativeTime.cpp"
 #include "time/juce_Time.cpp"
+#include "time/juce_Tracing.cpp"
 #include "unit_tests/juce_UnitTest.cpp"
+#include "unit_tests/juce_Benchmark.cpp"
 #include "containers/juce_Variant.cpp"
 #include "javascript/juce_JSON.cpp"
 #include "javascript/juce_JSONUtils.cpp"
+#include "javascript/juce_JSONReader.cpp"
+#include "javascript/juce_JSONWriter.cpp"
 #include "javascript/juce_Javascript.cpp"
 #include "containers/juce_DynamicObject.cpp"
 #include "xml/juce_XmlDocument.cpp"
 #include "xml/juce_XmlElement.cpp"
+#include "xml/juce_XmlReader.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
 #include "zip/juce_GZIPCompressorOutputStream.cpp"
 #include "zip/juce_ZipFile.cpp"
+#include "zip/juce_CompressionCodec.cpp"
+#include "zip/juce_CompressedStreams.cpp"
+#include "zip/juce_BinaryResourceCache.cpp"
 #include "files/juce_FileFilter.cpp"
 #include "files/juce_WildcardFileFilter.cpp"
 #include "native/juce_ThreadPriorities_native.h"
@@ -279,6 +307,9 @@
 //==============================================================================
 #if JUCE_UNIT_TESTS
  #include "containers/juce_HashMap_test.cpp"
+ #include "containers/juce_FlatHashMap_test.cpp"
+ #include "containers/juce_SmallArray_test.cpp"
+ #include "containers/juce_RingBuffer_test.cpp"
  #include "containers/juce_Optional_test.cpp"
  #include "containers/juce_Enumerate_test.cpp"
  #include "maths/juce_MathsFunctions_test.cpp"
@@ -286,6 +317,11 @@
  #include "containers/juce_FixedSizeFunction_test.cpp"
  #include "javascript/juce_JSONSerialisation_test.cpp"
  #include "memory/juce_SharedResourcePointer_test.cpp"
+ #include "memory/juce_MonotonicArena_test.cpp"
+ #include "memory/juce_ShardedCounter_test.cpp"
+ #include "memory/juce_RealtimeMemoryPool_test.cpp"
+ #include "threads/juce_SeqLock_test.cpp"
+ #include "threads/juce_Task_test.cpp"
  #if JUCE_MAC || JUCE_IOS
   #include "native/juce_ObjCHelpers_mac_test.mm"
  #endif
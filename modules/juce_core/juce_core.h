@@ -186,6 +186,24 @@
  #define JUCE_ENABLE_ALLOCATION_HOOKS 0
 #endif
 
+/** Config: JUCE_ENABLE_TRACING
+    If enabled, the JUCE_TRACE_SCOPE macros and the trace points built into JUCE will record
+    events while Tracing::start() is in effect. When recording is stopped, each trace point
+    just checks a flag. Disable this to remove them from the build completely.
+*/
+#ifndef JUCE_ENABLE_TRACING
+ #define JUCE_ENABLE_TRACING 1
+#endif
+
+/** Config: JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+    If enabled, the RealtimeSafetyChecker can record allocations, locks and blocking calls made
+    on realtime threads. This replaces the global operator new and delete, and adds a check to
+    CriticalSection::enter() and other blocking functions, so it's disabled by default.
+*/
+#ifndef JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+ #define JUCE_ENABLE_REALTIME_SAFETY_CHECKS 0
+#endif
+
 #ifndef JUCE_STRING_UTF_TYPE
  #define JUCE_STRING_UTF_TYPE 8
 #endif
@@ -224,6 +242,7 @@ namespace juce
 #include "maths/juce_MathsFunctions.h"
 #include "memory/juce_ByteOrder.h"
 #include "memory/juce_Atomic.h"
+#include "memory/juce_CacheLinePadded.h"
 #include "text/juce_CharacterFunctions.h"
 
 JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4514 4996)
@@ -259,9 +278,11 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "containers/juce_ArrayAllocationBase.h"
 #include "containers/juce_ArrayBase.h"
 #include "containers/juce_Array.h"
+#include "containers/juce_SmallArray.h"
 #include "containers/juce_LinkedListPointer.h"
 #include "misc/juce_ScopeGuard.h"
 #include "containers/juce_ListenerList.h"
+#include "containers/juce_SnapshotListenerList.h"
 #include "containers/juce_OwnedArray.h"
 #include "containers/juce_ReferenceCountedArray.h"
 #include "containers/juce_SortedSet.h"
@@ -280,14 +301,16 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "text/juce_Base64.h"
 #include "misc/juce_Functional.h"
 #include "containers/juce_Span.h"
+#include "containers/juce_RingBuffer.h"
 #include "misc/juce_Result.h"
 #include "misc/juce_Uuid.h"
 #include "misc/juce_ConsoleApplication.h"
 #include "containers/juce_Variant.h"
+#include "containers/juce_HashMap.h"
+#include "containers/juce_FlatHashMap.h"
 #include "containers/juce_NamedValueSet.h"
 #include "javascript/juce_JSON.h"
 #include "containers/juce_DynamicObject.h"
-#include "containers/juce_HashMap.h"
 #include "containers/juce_FixedSizeFunction.h"
 #include "time/juce_RelativeTime.h"
 #include "time/juce_Time.h"
@@ -301,6 +324,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "files/juce_File.h"
 #include "files/juce_DirectoryIterator.h"
 #include "files/juce_RangedDirectoryIterator.h"
+#include "files/juce_ParallelDirectoryScanner.h"
 #include "files/juce_FileInputStream.h"
 #include "files/juce_FileOutputStream.h"
 #include "files/juce_FileSearchPath.h"
@@ -310,7 +334,10 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "files/juce_WildcardFileFilter.h"
 #include "streams/juce_FileInputSource.h"
 #include "logging/juce_FileLogger.h"
+#include "logging/juce_AsyncFileLogger.h"
 #include "javascript/juce_JSONUtils.h"
+#include "javascript/juce_JSONReader.h"
+#include "javascript/juce_JSONWriter.h"
 #include "serialisation/juce_Serialisation.h"
 #include "javascript/juce_JSONSerialisation.h"
 #include "javascript/juce_Javascript.h"
@@ -324,11 +351,15 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "threads/juce_InterProcessLock.h"
 #include "threads/juce_Process.h"
 #include "threads/juce_SpinLock.h"
+#include "threads/juce_SeqLock.h"
+#include "threads/juce_LatestValue.h"
 #include "threads/juce_WaitableEvent.h"
 #include "threads/juce_Thread.h"
+#include "threads/juce_RealtimeSafetyChecker.h"
 #include "threads/juce_HighResolutionTimer.h"
 #include "threads/juce_ThreadLocalValue.h"
 #include "threads/juce_ThreadPool.h"
+#include "threads/juce_ParallelAlgorithms.h"
 #include "threads/juce_TimeSliceThread.h"
 #include "threads/juce_ReadWriteLock.h"
 #include "threads/juce_ScopedReadLock.h"
@@ -337,20 +368,34 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "network/juce_MACAddress.h"
 #include "network/juce_NamedPipe.h"
 #include "network/juce_Socket.h"
+#include "network/juce_SocketReactor.h"
+#include "network/juce_SharedMemoryRing.h"
 #include "network/juce_URL.h"
 #include "network/juce_WebInputStream.h"
 #include "streams/juce_URLInputSource.h"
+#include "streams/juce_ThreadedOutputStream.h"
 #include "time/juce_PerformanceCounter.h"
+#include "time/juce_Tracing.h"
 #include "unit_tests/juce_UnitTest.h"
+#include "unit_tests/juce_Benchmark.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
+#include "xml/juce_XmlReader.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
 #include "zip/juce_GZIPDecompressorInputStream.h"
 #include "zip/juce_ZipFile.h"
+#include "zip/juce_CompressionCodec.h"
+#include "zip/juce_CompressedStreams.h"
+#include "zip/juce_BinaryResourceCache.h"
 #include "containers/juce_PropertySet.h"
 #include "memory/juce_SharedResourcePointer.h"
 #include "memory/juce_AllocationHooks.h"
 #include "memory/juce_Reservoir.h"
+#include "memory/juce_MonotonicArena.h"
+#include "memory/juce_PoolAllocator.h"
+#include "memory/juce_ShardedCounter.h"
+#include "memory/juce_RealtimeMemoryPool.h"
+#include "threads/juce_Task.h"
 #include "files/juce_AndroidDocument.h"
 #include "streams/juce_AndroidDocumentInputSource.h"
 
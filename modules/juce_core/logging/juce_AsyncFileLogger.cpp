@@ -0,0 +1,511 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AsyncFileLogger::Queue
+{
+    struct Entry
+    {
+        int64 time = 0;
+        String message;
+        const char* format = nullptr;
+        Argument arguments[maxNumArguments];
+        int numArguments = 0;
+    };
+
+    enum class PushResult  { pushed, full, notOwner };
+
+    explicit Queue (int size)  : ring (size) {}
+
+    template <typename FillEntry>
+    PushResult push (Thread::ThreadID thread, FillEntry&& fill) noexcept
+    {
+        inUse.store (true);
+
+        if (owner.load() != thread)
+        {
+            inUse.store (false);
+            return PushResult::notOwner;
+        }
+
+        auto blocks = ring.prepareToWrite (1);
+        auto result = PushResult::full;
+
+        if (blocks.size() > 0)
+        {
+            auto& entry = blocks.block1.size() > 0 ? blocks.block1[0] : blocks.block2[0];
+            entry.time = Time::getHighResolutionTicks();
+            fill (entry);
+            ring.finishedWrite (1);
+            result = PushResult::pushed;
+        }
+
+        lastUsedTime.store (Time::getMillisecondCounter(), std::memory_order_relaxed);
+        inUse.store (false, std::memory_order_release);
+        return result;
+    }
+
+    // Called on the writer thread. A queue whose thread has gone quiet is handed back so
+    // that a new thread (e.g. after an audio device restart) can use it without allocating.
+    // The owner is swapped for a marker first, so that a thread which is just starting a
+    // push either sees the marker and looks for a different queue, or is seen as in use.
+    void releaseIfIdle (uint32 now) noexcept
+    {
+        auto thread = owner.load();
+
+        if (thread == nullptr || inUse.load() || ring.getNumReady() > 0
+             || now - lastUsedTime.load (std::memory_order_relaxed) < idleTimeBeforeReleaseMs)
+            return;
+
+        auto* marker = (Thread::ThreadID) this;
+
+        if (! owner.compare_exchange_strong (thread, marker))
+            return;
+
+        owner.store (inUse.load() ? thread : nullptr);
+    }
+
+    static constexpr uint32 idleTimeBeforeReleaseMs = 2000;
+
+    SpscRingBuffer<Entry> ring;
+    std::atomic<Thread::ThreadID> owner { nullptr };
+    std::atomic<bool> inUse { false };
+    std::atomic<uint32> lastUsedTime { 0 };
+    Queue* next = nullptr;
+};
+
+//==============================================================================
+struct AsyncFileLogger::Writer  : public Thread
+{
+    explicit Writer (AsyncFileLogger& l)  : Thread ("AsyncFileLogger"), owner (l) {}
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (owner.options.getWriteIntervalMs());
+            writePendingMessages();
+        }
+
+        writePendingMessages();
+    }
+
+    void writePendingMessages()
+    {
+        auto flushRequest = numFlushesRequested.load();
+        auto now = Time::getMillisecondCounter();
+
+        for (auto* queue = owner.queues.load (std::memory_order_acquire); queue != nullptr; queue = queue->next)
+        {
+            auto blocks = queue->ring.prepareToRead (queue->ring.getCapacity());
+
+            blocks.forEach ([this] (Queue::Entry& entry)
+            {
+                pending.push_back ({ entry.time, entry.format != nullptr ? formatMessage (entry)
+                                                                         : std::exchange (entry.message, {}) });
+            });
+
+            queue->ring.finishedRead (blocks.size());
+            queue->releaseIfIdle (now);
+        }
+
+        spaceAvailable.signal();
+
+        auto dropped = owner.numDropped.load();
+
+        if (dropped != numDroppedReported)
+        {
+            pending.push_back ({ Time::getHighResolutionTicks(),
+                                 "AsyncFileLogger: " + String (dropped - numDroppedReported) + " messages were dropped" });
+            numDroppedReported = dropped;
+        }
+
+        std::stable_sort (pending.begin(), pending.end(),
+                          [] (const Message& a, const Message& b) { return a.time < b.time; });
+
+        for (auto& m : pending)
+            write (m.text);
+
+        pending.clear();
+
+        if (stream != nullptr)
+            stream->flush();
+
+        numFlushesCompleted = flushRequest;
+        flushed.signal();
+    }
+
+    void write (const String& text)
+    {
+        auto numBytes = (int64) text.getNumBytesAsUTF8() + (int64) strlen (newLine.getDefault());
+        auto maxSize = owner.options.getMaxFileSize();
+
+        if (stream != nullptr && maxSize > 0 && stream->getPosition() > 0
+             && stream->getPosition() + numBytes > maxSize)
+            rotate();
+
+        if (stream == nullptr)
+        {
+            stream = std::make_unique<FileOutputStream> (owner.logFile, 65536);
+
+            if (! stream->openedOk())
+            {
+                stream.reset();
+                return;
+            }
+        }
+
+        *stream << text << newLine;
+    }
+
+    void rotate()
+    {
+        stream.reset();
+
+        auto& file = owner.logFile;
+        auto getBackupFile = [&file] (int index)
+        {
+            return file.getSiblingFile (file.getFileNameWithoutExtension() + "." + String (index) + file.getFileExtension());
+        };
+
+        auto numBackups = owner.options.getMaxNumBackupFiles();
+
+        if (numBackups <= 0)
+        {
+            file.deleteFile();
+            return;
+        }
+
+        getBackupFile (numBackups).deleteFile();
+
+        for (int i = numBackups; --i > 0;)
+            getBackupFile (i).moveFileTo (getBackupFile (i + 1));
+
+        file.moveFileTo (getBackupFile (1));
+    }
+
+    static String formatMessage (const Queue::Entry& entry)
+    {
+        String result;
+        auto* format = entry.format;
+        int argumentIndex = 0;
+
+        while (*format != 0)
+        {
+            auto* placeholder = strstr (format, "{}");
+
+            if (placeholder == nullptr || argumentIndex >= entry.numArguments)
+                break;
+
+            result += String (CharPointer_UTF8 (format), CharPointer_UTF8 (placeholder));
+            result += toString (entry.arguments[argumentIndex++]);
+            format = placeholder + 2;
+        }
+
+        return result + String (CharPointer_UTF8 (format));
+    }
+
+    static String toString (const Argument& a)
+    {
+        switch (a.type)
+        {
+            case Argument::Type::integer:           return String (a.integer);
+            case Argument::Type::unsignedInteger:   return String (a.unsignedInteger);
+            case Argument::Type::floatingPoint:     return String (a.floatingPoint);
+            case Argument::Type::boolean:           return a.integer != 0 ? "true" : "false";
+            case Argument::Type::text:              return a.text != nullptr ? String (CharPointer_UTF8 (a.text)) : String ("(null)");
+            case Argument::Type::none:              break;
+        }
+
+        return {};
+    }
+
+    struct Message
+    {
+        int64 time;
+        String text;
+    };
+
+    AsyncFileLogger& owner;
+    std::unique_ptr<FileOutputStream> stream;
+    std::vector<Message> pending;
+    int64 numDroppedReported = 0;
+    std::atomic<uint64> numFlushesRequested { 0 }, numFlushesCompleted { 0 };
+    WaitableEvent flushed, spaceAvailable;
+
+    JUCE_DECLARE_NON_COPYABLE (Writer)
+};
+
+//==============================================================================
+AsyncFileLogger::AsyncFileLogger (const File& file)
+    : AsyncFileLogger (file, Options{})
+{
+}
+
+AsyncFileLogger::AsyncFileLogger (const File& file, const Options& o)
+    : logFile (file), options (o)
+{
+    if (! file.exists())
+        file.create();  // (to create the parent directories)
+
+    for (int i = 0; i < options.getNumPreallocatedQueues(); ++i)
+    {
+        auto* queue = new Queue (options.getQueueSizePerThread());
+        queue->next = queues.load();
+        queues = queue;
+    }
+
+    writer = std::make_unique<Writer> (*this);
+
+    if (options.getWelcomeMessage().isNotEmpty())
+    {
+        String welcome;
+        welcome << newLine
+                << "**********************************************************" << newLine
+                << options.getWelcomeMessage() << newLine
+                << "Log started: " << Time::getCurrentTime().toString (true, true) << newLine;
+
+        writer->write (welcome);
+    }
+
+    writer->startThread (Thread::Priority::low);
+}
+
+AsyncFileLogger::~AsyncFileLogger()
+{
+    writer->signalThreadShouldExit();
+    writer->notify();
+    writer->stopThread (-1);
+    writer.reset();
+
+    for (auto* queue = queues.load(); queue != nullptr;)
+        delete std::exchange (queue, queue->next);
+}
+
+//==============================================================================
+AsyncFileLogger::Queue* AsyncFileLogger::findQueueForThisThread (bool canAllocate)
+{
+    auto thread = Thread::getCurrentThreadId();
+    auto* first = queues.load (std::memory_order_acquire);
+
+    for (auto* queue = first; queue != nullptr; queue = queue->next)
+        if (queue->owner.load() == thread)
+            return queue;
+
+    for (auto* queue = first; queue != nullptr; queue = queue->next)
+    {
+        Thread::ThreadID unowned = nullptr;
+
+        if (queue->owner.compare_exchange_strong (unowned, thread))
+            return queue;
+    }
+
+    if (! canAllocate)
+        return nullptr;
+
+    auto* queue = new Queue (options.getQueueSizePerThread());
+    queue->owner = thread;
+    queue->next = first;
+
+    while (! queues.compare_exchange_weak (queue->next, queue))
+    {}
+
+    return queue;
+}
+
+void AsyncFileLogger::logMessage (const String& message)
+{
+    auto thread = Thread::getCurrentThreadId();
+
+    if (thread == writer->getThreadId())
+    {
+        writer->write (message);
+        return;
+    }
+
+    for (;;)
+    {
+        auto result = findQueueForThisThread (true)->push (thread, [&message] (Queue::Entry& e)
+        {
+            e.message = message;
+            e.format = nullptr;
+        });
+
+        if (result == Queue::PushResult::pushed)
+            return;
+
+        if (result == Queue::PushResult::full)
+        {
+            writer->notify();
+            writer->spaceAvailable.wait (10);
+        }
+    }
+}
+
+void AsyncFileLogger::addRealtimeMessage (const char* format, const Argument* arguments, int numArguments) noexcept
+{
+    auto thread = Thread::getCurrentThreadId();
+
+    for (;;)
+    {
+        auto* queue = findQueueForThisThread (false);
+
+        if (queue == nullptr)
+            break;
+
+        auto result = queue->push (thread, [=] (Queue::Entry& e)
+        {
+            e.format = format;
+            e.numArguments = numArguments;
+            std::copy (arguments, arguments + numArguments, e.arguments);
+        });
+
+        if (result == Queue::PushResult::pushed)
+            return;
+
+        if (result == Queue::PushResult::full)
+            break;
+    }
+
+    ++numDropped;
+}
+
+void AsyncFileLogger::flush()
+{
+    auto target = ++writer->numFlushesRequested;
+    writer->notify();
+
+    while (writer->numFlushesCompleted.load() < target && writer->isThreadRunning())
+        writer->flushed.wait (100);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AsyncFileLoggerTests  : public UnitTest
+{
+public:
+    AsyncFileLoggerTests()  : UnitTest ("AsyncFileLogger", UnitTestCategories::files) {}
+
+    void runTest() override
+    {
+        const TemporaryFile temp (".log");
+        const auto& file = temp.getFile();
+
+        beginTest ("Messages from several threads are all written, in order");
+        {
+            {
+                AsyncFileLogger logger (file);
+                std::vector<std::thread> threads;
+
+                for (int t = 0; t < 4; ++t)
+                    threads.emplace_back ([&logger, t]
+                    {
+                        for (int i = 0; i < 2000; ++i)
+                            logger.logMessage (String (t) + " " + String (i));
+                    });
+
+                for (auto& t : threads)
+                    t.join();
+
+                logger.flush();
+                expectEquals (StringArray::fromLines (file.loadFileAsString().trim()).size(), 8000);
+            }
+
+            int nextExpected[4] = {};
+
+            for (auto& line : StringArray::fromLines (file.loadFileAsString().trim()))
+            {
+                auto t = line.upToFirstOccurrenceOf (" ", false, false).getIntValue();
+                expectEquals (line.fromFirstOccurrenceOf (" ", false, false).getIntValue(), nextExpected[t]++);
+            }
+
+            for (auto n : nextExpected)
+                expectEquals (n, 2000);
+        }
+
+        beginTest ("Realtime messages are formatted on the writer thread");
+        {
+            file.deleteFile();
+
+            {
+                AsyncFileLogger logger (file);
+                logger.logFromAudioThread ("a {} b {} c {} {}", -3, 2.5, true, "text");
+                logger.logFromAudioThread ("{} {} {}", (uint8) 200);
+                logger.logFromAudioThread ("no arguments");
+            }
+
+            expectEquals (file.loadFileAsString(), "a -3 b 2.5 c true text" + String (newLine)
+                                                     + "200 {} {}" + newLine
+                                                     + "no arguments" + newLine);
+        }
+
+        beginTest ("Realtime messages are dropped when the queue is full");
+        {
+            file.deleteFile();
+
+            AsyncFileLogger logger (file, AsyncFileLogger::Options{}.withQueueSizePerThread (4)
+                                                                    .withWriteIntervalMs (100000));
+            for (int i = 0; i < 10; ++i)
+                logger.logFromAudioThread ("{}", i);
+
+            expectEquals (logger.getNumDroppedMessages(), (int64) 6);
+            logger.flush();
+            expect (file.loadFileAsString().contains ("6 messages were dropped"));
+        }
+
+        beginTest ("Files are rotated");
+        {
+            file.deleteFile();
+
+            auto getBackup = [&file] (int i)
+            {
+                return file.getSiblingFile (file.getFileNameWithoutExtension() + "." + String (i) + file.getFileExtension());
+            };
+
+            {
+                AsyncFileLogger logger (file, AsyncFileLogger::Options{}.withMaxFileSize (1000)
+                                                                        .withMaxNumBackupFiles (2));
+                for (int i = 0; i < 100; ++i)
+                    logger.logMessage (String::repeatedString ("x", 40) + String (i).paddedLeft ('0', 3));
+            }
+
+            expect (file.getSize() <= 1000);
+            expect (getBackup (1).getSize() <= 1000 && getBackup (1).getSize() > 900);
+            expect (getBackup (2).existsAsFile());
+            expect (! getBackup (3).exists());
+            expect (file.loadFileAsString().trim().endsWith ("099"));
+
+            getBackup (1).deleteFile();
+            getBackup (2).deleteFile();
+        }
+    }
+};
+
+static AsyncFileLoggerTests asyncFileLoggerTests;
+
+#endif
+
+} // namespace juce
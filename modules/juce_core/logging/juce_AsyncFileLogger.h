@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A Logger that writes to a file on a background thread.
+
+    FileLogger holds a lock and opens, writes and closes the file for every message,
+    so threads that log a lot end up waiting for each other and for the disk. This
+    class just adds each message to a queue that belongs to the calling thread, and
+    a background thread collects the messages from all the queues, puts them back into
+    the order in which they were logged, and writes them to the file in batches.
+
+    When the file grows past a given size it's renamed to "name.1.ext" (moving any
+    older ones along to "name.2.ext" etc.) and a new file is started.
+
+    Messages can also be logged from a realtime thread with logFromAudioThread(),
+    which doesn't allocate or lock. This takes a format string containing "{}"
+    placeholders and some numbers, and the text is only put together on the writer
+    thread:
+
+    @code
+    logger.logFromAudioThread ("Buffer underrun at sample {}, load {}", samplePosition, cpuLoad);
+    @endcode
+
+    @see FileLogger
+
+    @tags{Core}
+*/
+class JUCE_API  AsyncFileLogger  : public Logger
+{
+public:
+    //==============================================================================
+    /** Settings for an AsyncFileLogger. */
+    class JUCE_API  Options
+    {
+    public:
+        /** When the file would grow past this size, it's moved aside and a new one is
+            started. If this is zero or less, the file is never rotated. The default is 10MB.
+        */
+        [[nodiscard]] Options withMaxFileSize (int64 numBytes) const            { return withMember (*this, &Options::maxFileSize, numBytes); }
+
+        /** The number of rotated files to keep. The default is 5. */
+        [[nodiscard]] Options withMaxNumBackupFiles (int numFiles) const        { return withMember (*this, &Options::maxNumBackupFiles, numFiles); }
+
+        /** The number of messages that each thread can have waiting to be written. If a
+            thread fills its queue, logMessage() waits for the writer to catch up, but
+            logFromAudioThread() drops the message and the number of dropped messages is
+            written to the file later. The default is 1024.
+        */
+        [[nodiscard]] Options withQueueSizePerThread (int numMessages) const    { return withMember (*this, &Options::queueSizePerThread, numMessages); }
+
+        /** The number of queues to create up-front. Threads calling logFromAudioThread()
+            can only use these, because creating a new queue would allocate. The default is 4.
+        */
+        [[nodiscard]] Options withNumPreallocatedQueues (int numQueues) const   { return withMember (*this, &Options::numPreallocatedQueues, numQueues); }
+
+        /** How often the writer thread collects new messages. The default is 100ms. */
+        [[nodiscard]] Options withWriteIntervalMs (int milliseconds) const      { return withMember (*this, &Options::writeIntervalMs, milliseconds); }
+
+        /** A message to write, along with the date and time, when the log is opened. */
+        [[nodiscard]] Options withWelcomeMessage (const String& message) const  { return withMember (*this, &Options::welcomeMessage, message); }
+
+        int64 getMaxFileSize() const noexcept                   { return maxFileSize; }
+        int getMaxNumBackupFiles() const noexcept               { return maxNumBackupFiles; }
+        int getQueueSizePerThread() const noexcept              { return queueSizePerThread; }
+        int getNumPreallocatedQueues() const noexcept           { return numPreallocatedQueues; }
+        int getWriteIntervalMs() const noexcept                 { return writeIntervalMs; }
+        const String& getWelcomeMessage() const noexcept        { return welcomeMessage; }
+
+    private:
+        int64 maxFileSize = 10 * 1024 * 1024;
+        int maxNumBackupFiles = 5;
+        int queueSizePerThread = 1024;
+        int numPreallocatedQueues = 4;
+        int writeIntervalMs = 100;
+        String welcomeMessage;
+    };
+
+    //==============================================================================
+    /** Creates a logger that appends to the given file, using the default options.
+        The file and any parent directories are created if needed.
+    */
+    explicit AsyncFileLogger (const File& fileToWriteTo);
+
+    /** Creates a logger that appends to the given file.
+        The file and any parent directories are created if needed.
+    */
+    AsyncFileLogger (const File& fileToWriteTo, const Options& options);
+
+    /** Destructor. Any messages that are still waiting are written before this returns. */
+    ~AsyncFileLogger() override;
+
+    //==============================================================================
+    /** Returns the file that this logger is writing to. */
+    const File& getLogFile() const noexcept               { return logFile; }
+
+    /** Adds a message to the calling thread's queue.
+
+        This only waits if the queue is full, or the first time it's called on a thread
+        when all of the preallocated queues are in use.
+    */
+    void logMessage (const String&) override;
+
+    /** Adds a message to the calling thread's queue without allocating, locking or waiting.
+
+        The format string must stay valid for the lifetime of the logger, so it should
+        normally be a string literal. Each "{}" in it is replaced by the next argument,
+        which can be a number, a bool, or a string literal. At most maxNumArguments can
+        be given.
+
+        If the queue is full, or there's no free preallocated queue for this thread, the
+        message is dropped and counted.
+    */
+    template <typename... Args>
+    void logFromAudioThread (const char* format, Args... args) noexcept
+    {
+        static_assert (sizeof... (args) <= maxNumArguments, "Too many arguments");
+        const Argument arguments[] = { Argument::create (args)..., Argument{} };
+        addRealtimeMessage (format, arguments, (int) sizeof... (args));
+    }
+
+    /** Waits until all the messages that were logged before this call have been written
+        and the file has been flushed.
+    */
+    void flush();
+
+    /** Returns the number of messages that have been dropped because a queue was full. */
+    int64 getNumDroppedMessages() const noexcept          { return numDropped.load(); }
+
+    /** The most arguments that logFromAudioThread() can take. */
+    static constexpr int maxNumArguments = 4;
+
+private:
+    //==============================================================================
+    struct Argument
+    {
+        enum class Type  { none, integer, unsignedInteger, floatingPoint, boolean, text };
+
+        template <typename T>
+        static Argument create (T value) noexcept
+        {
+            Argument a;
+
+            if constexpr (std::is_same_v<T, bool>)                  { a.type = Type::boolean;         a.integer = value ? 1 : 0; }
+            else if constexpr (std::is_floating_point_v<T>)         { a.type = Type::floatingPoint;   a.floatingPoint = (double) value; }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)   { a.type = Type::integer;  a.integer = (int64) value; }
+            else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)     { a.type = Type::unsignedInteger;  a.unsignedInteger = (uint64) value; }
+            else
+            {
+                static_assert (std::is_convertible_v<T, const char*>, "Unsupported argument type");
+                a.type = Type::text;
+                a.text = value;
+            }
+
+            return a;
+        }
+
+        Type type = Type::none;
+
+        union
+        {
+            int64 integer = 0;
+            uint64 unsignedInteger;
+            double floatingPoint;
+            const char* text;
+        };
+    };
+
+    struct Queue;
+    struct Writer;
+
+    File logFile;
+    Options options;
+    std::atomic<Queue*> queues { nullptr };
+    std::atomic<int64> numDropped { 0 };
+    std::unique_ptr<Writer> writer;
+
+    Queue* findQueueForThisThread (bool canAllocate);
+    void addRealtimeMessage (const char*, const Argument*, int) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncFileLogger)
+};
+
+} // namespace juce
@@ -28,6 +28,319 @@ namespace
     inline uint32 bitToMask  (const int bit) noexcept           { return (uint32) 1 << (bit & 31); }
     inline size_t bitToIndex (const int bit) noexcept           { return (size_t) (bit >> 5); }
     inline size_t sizeNeededToHold (int highestBit) noexcept    { return (size_t) (highestBit >> 5) + 1; }
+
+    //==============================================================================
+    // These work on arrays of 32-bit limbs, stored least-significant first.
+
+    int compareLimbs (const uint32* a, const uint32* b, size_t size) noexcept
+    {
+        while (size > 0)
+        {
+            --size;
+
+            if (a[size] != b[size])
+                return a[size] > b[size] ? 1 : -1;
+        }
+
+        return 0;
+    }
+
+    // Adds src to dest, returning the carry out of the top of dest
+    uint32 addLimbs (uint32* dest, size_t destSize, const uint32* src, size_t srcSize) noexcept
+    {
+        jassert (destSize >= srcSize);
+        uint64 carry = 0;
+        size_t i = 0;
+
+        for (; i < srcSize; ++i)
+        {
+            carry += (uint64) dest[i] + src[i];
+            dest[i] = (uint32) carry;
+            carry >>= 32;
+        }
+
+        for (; carry != 0 && i < destSize; ++i)
+        {
+            carry += dest[i];
+            dest[i] = (uint32) carry;
+            carry >>= 32;
+        }
+
+        return (uint32) carry;
+    }
+
+    // Subtracts src from dest, returning the borrow out of the top of dest
+    uint32 subtractLimbs (uint32* dest, size_t destSize, const uint32* src, size_t srcSize) noexcept
+    {
+        jassert (destSize >= srcSize);
+        uint64 borrow = 0;
+        size_t i = 0;
+
+        for (; i < srcSize; ++i)
+        {
+            const auto difference = (uint64) dest[i] - src[i] - borrow;
+            dest[i] = (uint32) difference;
+            borrow = (difference >> 32) & 1;
+        }
+
+        for (; borrow != 0 && i < destSize; ++i)
+        {
+            const auto difference = (uint64) dest[i] - borrow;
+            dest[i] = (uint32) difference;
+            borrow = (difference >> 32) & 1;
+        }
+
+        return (uint32) borrow;
+    }
+
+    size_t getNumUsedLimbs (const uint32* values, size_t size) noexcept
+    {
+        while (size > 0 && values[size - 1] == 0)
+            --size;
+
+        return size;
+    }
+
+    // result must have room for aSize + bSize limbs, and mustn't overlap either input
+    void multiplyLimbsSimple (uint32* result, const uint32* a, size_t aSize, const uint32* b, size_t bSize) noexcept
+    {
+        std::fill (result, result + aSize + bSize, 0u);
+
+        for (size_t i = 0; i < bSize; ++i)
+        {
+            const uint64 multiplier = b[i];
+            uint64 carry = 0;
+
+            if (multiplier == 0)
+                continue;
+
+            for (size_t j = 0; j < aSize; ++j)
+            {
+                carry += (uint64) result[i + j] + (uint64) a[j] * multiplier;
+                result[i + j] = (uint32) carry;
+                carry >>= 32;
+            }
+
+            result[i + aSize] = (uint32) carry;
+        }
+    }
+
+    // Below this many limbs in the shorter value, Karatsuba's extra additions cost more than they save
+    constexpr size_t karatsubaThreshold = 40;
+
+    // result must have room for aSize + bSize limbs, and mustn't overlap either input
+    void multiplyLimbs (uint32* result, const uint32* a, size_t aSize, const uint32* b, size_t bSize)
+    {
+        if (aSize < bSize)
+        {
+            std::swap (a, b);
+            std::swap (aSize, bSize);
+        }
+
+        if (bSize < karatsubaThreshold)
+        {
+            multiplyLimbsSimple (result, a, aSize, b, bSize);
+            return;
+        }
+
+        std::fill (result, result + aSize + bSize, 0u);
+
+        if (bSize * 2 <= aSize)
+        {
+            // The values are very different in size, so multiply b by one slice of a at a time
+            std::vector<uint32> partial (bSize * 2);
+
+            for (size_t offset = 0; offset < aSize; offset += bSize)
+            {
+                const auto sliceSize = jmin (bSize, aSize - offset);
+                multiplyLimbs (partial.data(), a + offset, sliceSize, b, bSize);
+                addLimbs (result + offset, aSize + bSize - offset, partial.data(), sliceSize + bSize);
+            }
+
+            return;
+        }
+
+        // With a = a1.B + a0 and b = b1.B + b0, the middle term a1.b0 + a0.b1 is found as
+        // (a0 + a1)(b0 + b1) - a0.b0 - a1.b1, which takes three multiplications instead of four.
+        const auto half = aSize / 2;
+        const auto a1Size = aSize - half;
+        const auto b1Size = bSize - half;
+
+        std::vector<uint32> low (half * 2), high (a1Size + b1Size);
+        multiplyLimbs (low.data(), a, half, b, half);
+        multiplyLimbs (high.data(), a + half, a1Size, b + half, b1Size);
+
+        std::vector<uint32> aSum (a1Size + 1), bSum (jmax (half, b1Size) + 1);
+        std::copy (a + half, a + aSize, aSum.begin());
+        addLimbs (aSum.data(), aSum.size(), a, half);
+        std::copy (b, b + half, bSum.begin());
+        addLimbs (bSum.data(), bSum.size(), b + half, b1Size);
+
+        std::vector<uint32> middle (aSum.size() + bSum.size());
+        multiplyLimbs (middle.data(), aSum.data(), aSum.size(), bSum.data(), bSum.size());
+        subtractLimbs (middle.data(), middle.size(), low.data(), low.size());
+        subtractLimbs (middle.data(), middle.size(), high.data(), high.size());
+
+        std::copy (low.begin(), low.end(), result);
+        std::copy (high.begin(), high.end(), result + half * 2);
+        addLimbs (result + half, aSize + bSize - half, middle.data(), getNumUsedLimbs (middle.data(), middle.size()));
+    }
+
+    // Shifts src left by 0-31 bits into dest, returning the bits shifted out of the top
+    uint32 shiftLimbsLeft (uint32* dest, const uint32* src, size_t size, int shift) noexcept
+    {
+        if (shift == 0)
+        {
+            std::copy (src, src + size, dest);
+            return 0;
+        }
+
+        uint32 carry = 0;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const auto value = src[i];
+            dest[i] = (value << shift) | carry;
+            carry = value >> (32 - shift);
+        }
+
+        return carry;
+    }
+
+    /*  Knuth's algorithm D, which produces the quotient a whole limb at a time.
+        The divisor must have at least two limbs and a non-zero top limb, and the dividend must
+        be at least as long as the divisor. The quotient needs room for uSize - vSize + 1 limbs,
+        and the remainder needs room for vSize limbs.
+    */
+    void divideLimbs (const uint32* u, size_t uSize, const uint32* v, size_t vSize, uint32* quotient, uint32* remainder)
+    {
+        jassert (vSize >= 2 && v[vSize - 1] != 0 && uSize >= vSize);
+
+        // Normalise so that the top bit of the divisor is set, which keeps the estimates accurate
+        const auto shift = 31 - findHighestSetBit (v[vSize - 1]);
+        std::vector<uint32> vn (vSize), un (uSize + 1);
+        shiftLimbsLeft (vn.data(), v, vSize, shift);
+        un[uSize] = shiftLimbsLeft (un.data(), u, uSize, shift);
+
+        const auto vTop = (uint64) vn[vSize - 1];
+        const auto vNext = (uint64) vn[vSize - 2];
+        constexpr uint64 base = (uint64) 1 << 32;
+
+        for (auto j = (ptrdiff_t) (uSize - vSize); j >= 0; --j)
+        {
+            const auto top = ((uint64) un[(size_t) j + vSize] << 32) | un[(size_t) j + vSize - 1];
+            auto estimate = top / vTop;
+            auto estimateRemainder = top % vTop;
+
+            while (estimate >= base || estimate * vNext > ((estimateRemainder << 32) | un[(size_t) j + vSize - 2]))
+            {
+                --estimate;
+                estimateRemainder += vTop;
+
+                if (estimateRemainder >= base)
+                    break;
+            }
+
+            int64 borrow = 0;
+
+            for (size_t i = 0; i < vSize; ++i)
+            {
+                const auto product = estimate * vn[i];
+                const auto difference = (int64) un[i + (size_t) j] - borrow - (int64) (product & 0xffffffff);
+                un[i + (size_t) j] = (uint32) difference;
+                borrow = (int64) (product >> 32) - (difference >> 32);
+            }
+
+            const auto difference = (int64) un[(size_t) j + vSize] - borrow;
+            un[(size_t) j + vSize] = (uint32) difference;
+
+            if (difference < 0)
+            {
+                // The estimate was one too large, so add one divisor back on
+                --estimate;
+                un[(size_t) j + vSize] += addLimbs (un.data() + j, vSize, vn.data(), vSize);
+            }
+
+            quotient[j] = (uint32) estimate;
+        }
+
+        for (size_t i = 0; i < vSize; ++i)
+            remainder[i] = shift == 0 ? un[i] : ((un[i] >> shift) | (un[i + 1] << (32 - shift)));
+    }
+
+    //==============================================================================
+    /*  Montgomery multiplication for an odd modulus, working a limb at a time so that the
+        reduction never needs a division. Values are represented as x.R mod modulus, where
+        R = 2^(32 * size).
+    */
+    struct MontgomeryReducer
+    {
+        MontgomeryReducer (const uint32* modulusIn, size_t sizeIn)
+            : modulus (modulusIn, modulusIn + sizeIn),
+              size (sizeIn),
+              workspace (sizeIn + 2)
+        {
+            jassert ((modulus[0] & 1) != 0);
+
+            // Newton's method doubles the number of correct bits in the inverse at each step
+            uint32 inverse = 1;
+
+            for (int i = 0; i < 5; ++i)
+                inverse *= 2 - modulus[0] * inverse;
+
+            negativeInverse = 0 - inverse;
+        }
+
+        // Sets result to a.b / R mod modulus. The result may be the same array as either input.
+        void multiply (uint32* result, const uint32* a, const uint32* b) noexcept
+        {
+            auto* t = workspace.data();
+            std::fill (t, t + size + 2, 0u);
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                const uint64 multiplier = b[i];
+                uint64 carry = 0;
+
+                for (size_t j = 0; j < size; ++j)
+                {
+                    carry += (uint64) t[j] + (uint64) a[j] * multiplier;
+                    t[j] = (uint32) carry;
+                    carry >>= 32;
+                }
+
+                carry += t[size];
+                t[size] = (uint32) carry;
+                t[size + 1] = (uint32) (carry >> 32);
+
+                // Adding this multiple of the modulus clears the lowest limb, which is then shifted away
+                const uint64 reduction = (uint32) (t[0] * negativeInverse);
+                carry = ((uint64) t[0] + reduction * modulus[0]) >> 32;
+
+                for (size_t j = 1; j < size; ++j)
+                {
+                    carry += (uint64) t[j] + reduction * modulus[j];
+                    t[j - 1] = (uint32) carry;
+                    carry >>= 32;
+                }
+
+                carry += t[size];
+                t[size - 1] = (uint32) carry;
+                t[size] = t[size + 1] + (uint32) (carry >> 32);
+            }
+
+            // The result is less than twice the modulus, so one subtraction is enough
+            if (t[size] != 0 || compareLimbs (t, modulus.data(), size) >= 0)
+                subtractLimbs (t, size + 1, modulus.data(), size);
+
+            std::copy (t, t + size, result);
+        }
+
+        std::vector<uint32> modulus;
+        size_t size;
+        std::vector<uint32> workspace;
+        uint32 negativeInverse = 0;
+    };
 }
 
 int findHighestSetBit (uint32 n) noexcept
@@ -535,41 +848,17 @@ BigInteger& BigInteger::operator*= (const BigInteger& other)
     if (this == &other)
         return operator*= (BigInteger (other));
 
-    auto n = getHighestBit();
-    auto t = other.getHighestBit();
-
-    auto wasNegative = isNegative();
-    setNegative (false);
+    const auto numInts = sizeNeededToHold (getHighestBit());
+    const auto numOtherInts = sizeNeededToHold (other.getHighestBit());
 
     BigInteger total;
-    total.highestBit = n + t + 1;
-    auto* totalValues = total.ensureSize (sizeNeededToHold (total.highestBit) + 1);
-
-    n >>= 5;
-    t >>= 5;
+    total.highestBit = (int) (numInts + numOtherInts) * 32 - 1;
+    auto* totalValues = total.ensureSize (numInts + numOtherInts);
 
-    auto m = other;
-    m.setNegative (false);
-
-    auto* mValues = m.getValues();
-    auto* values = getValues();
-
-    for (int i = 0; i <= t; ++i)
-    {
-        uint32 c = 0;
-
-        for (int j = 0; j <= n; ++j)
-        {
-            auto uv = (uint64) totalValues[i + j] + (uint64) values[j] * (uint64) mValues[i] + (uint64) c;
-            totalValues[i + j] = (uint32) uv;
-            c = static_cast<uint32> (uv >> 32);
-        }
-
-        totalValues[i + n + 1] = c;
-    }
+    multiplyLimbs (totalValues, getValues(), numInts, other.getValues(), numOtherInts);
 
     total.highestBit = total.getHighestBit();
-    total.setNegative (wasNegative ^ other.isNegative());
+    total.setNegative (total.highestBit >= 0 && (isNegative() ^ other.isNegative()));
     swapWith (total);
 
     return *this;
@@ -590,36 +879,58 @@ void BigInteger::divideBy (const BigInteger& divisor, BigInteger& remainder)
         // division by zero
         remainder.clear();
         clear();
+        return;
     }
-    else
-    {
-        auto wasNegative = isNegative();
 
+    const auto wasNegative = isNegative();
+    const auto quotientNegative = wasNegative ^ divisor.isNegative();
+
+    if (compareAbsolute (divisor) < 0)
+    {
         swapWith (remainder);
-        remainder.setNegative (false);
         clear();
+        remainder.setNegative (wasNegative);
+        return;
+    }
 
-        BigInteger temp (divisor);
-        temp.setNegative (false);
+    const auto numInts = sizeNeededToHold (ourHB);
+    const auto numDivisorInts = sizeNeededToHold (divHB);
+    const auto numQuotientInts = numInts - numDivisorInts + 1;
 
-        auto leftShift = ourHB - divHB;
-        temp <<= leftShift;
+    BigInteger quotient, newRemainder;
+    quotient.highestBit = (int) numQuotientInts * 32 - 1;
+    newRemainder.highestBit = (int) numDivisorInts * 32 - 1;
+    auto* quotientValues = quotient.ensureSize (numQuotientInts);
+    auto* remainderValues = newRemainder.ensureSize (numDivisorInts);
+    auto* values = getValues();
 
-        while (leftShift >= 0)
-        {
-            if (remainder.compareAbsolute (temp) >= 0)
-            {
-                remainder -= temp;
-                setBit (leftShift);
-            }
+    if (numDivisorInts == 1)
+    {
+        const auto d = (uint64) divisor.getValues()[0];
+        uint64 r = 0;
 
-            if (--leftShift >= 0)
-                temp >>= 1;
+        for (auto i = numInts; i > 0;)
+        {
+            --i;
+            const auto n = (r << 32) | values[i];
+            quotientValues[i] = (uint32) (n / d);
+            r = n % d;
         }
 
-        negative = wasNegative ^ divisor.isNegative();
-        remainder.setNegative (wasNegative);
+        remainderValues[0] = (uint32) r;
     }
+    else
+    {
+        divideLimbs (values, numInts, divisor.getValues(), numDivisorInts, quotientValues, remainderValues);
+    }
+
+    quotient.highestBit = quotient.getHighestBit();
+    quotient.negative = quotientNegative;
+    newRemainder.highestBit = newRemainder.getHighestBit();
+    newRemainder.negative = wasNegative && newRemainder.highestBit >= 0;
+
+    swapWith (quotient);
+    remainder.swapWith (newRemainder);
 }
 
 BigInteger& BigInteger::operator/= (const BigInteger& other)
@@ -918,68 +1229,83 @@ BigInteger BigInteger::findGreatestCommonDivisor (BigInteger n) const
 
 void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& modulus)
 {
-    *this %= modulus;
-    auto exp = exponent;
-    exp %= modulus;
+    auto absModulus = modulus;
+    absModulus.setNegative (false);
+
+    *this %= absModulus;
+
+    if (isNegative())
+        *this += absModulus;
+
+    if (absModulus.isZero())
+        return;
+
+    const auto numExponentBits = exponent.getHighestBit() + 1;
 
-    if (modulus.getHighestBit() <= 32 || modulus % 2 == 0)
+    if (absModulus[0] == 0)
     {
         auto a = *this;
-        auto n = exp.getHighestBit();
+        *this = BigInteger (1) % absModulus;
 
-        for (int i = n; --i >= 0;)
+        for (int i = numExponentBits; --i >= 0;)
         {
             *this *= *this;
 
-            if (exp[i])
+            if (exponent[i])
                 *this *= a;
 
-            if (compareAbsolute (modulus) >= 0)
-                *this %= modulus;
+            if (compareAbsolute (absModulus) >= 0)
+                *this %= absModulus;
         }
+
+        return;
     }
-    else
-    {
-        auto Rfactor = modulus.getHighestBit() + 1;
-        BigInteger R (1);
-        R.shiftLeft (Rfactor, 0);
 
-        BigInteger R1, m1, g;
-        g.extendedEuclidean (modulus, R, m1, R1);
+    // For an odd modulus, use Montgomery multiplication, taking the exponent a few bits at a time
+    const auto size = sizeNeededToHold (absModulus.getHighestBit());
+    const auto numRBits = (int) size * 32;
+    MontgomeryReducer reducer (absModulus.getValues(), size);
 
-        if (! g.isOne())
-        {
-            BigInteger a (*this);
+    const auto copyLimbs = [size] (const BigInteger& source, uint32* dest)
+    {
+        const auto* values = source.getValues();
+        std::fill (dest, dest + size, 0u);
+        std::copy (values, values + jmin (size, sizeNeededToHold (source.getHighestBit())), dest);
+    };
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
-            {
-                *this *= *this;
+    const auto windowBits = numExponentBits > 512 ? 5 : (numExponentBits > 128 ? 4 : (numExponentBits > 24 ? 3 : 1));
+    const auto numWindows = (numExponentBits + windowBits - 1) / windowBits;
 
-                if (exp[i])
-                    *this *= a;
+    // powers[i] holds this^i in Montgomery form
+    std::vector<uint32> powers (((size_t) 1 << windowBits) * size);
+    copyLimbs ((BigInteger (1) << numRBits) % absModulus, powers.data());
+    copyLimbs ((*this << numRBits) % absModulus, powers.data() + size);
 
-                if (compareAbsolute (modulus) >= 0)
-                    *this %= modulus;
-            }
-        }
-        else
-        {
-            auto am  = (*this * R) % modulus;
-            auto xm = am;
-            auto um = R % modulus;
+    for (size_t i = 2; i < ((size_t) 1 << windowBits); ++i)
+        reducer.multiply (powers.data() + i * size, powers.data() + (i - 1) * size, powers.data() + size);
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
-            {
-                xm.montgomeryMultiplication (xm, modulus, m1, Rfactor);
+    std::vector<uint32> result (powers.begin(), powers.begin() + (ptrdiff_t) size);
 
-                if (exp[i])
-                    xm.montgomeryMultiplication (am, modulus, m1, Rfactor);
-            }
+    for (int window = numWindows; --window >= 0;)
+    {
+        if (window != numWindows - 1)
+            for (int i = 0; i < windowBits; ++i)
+                reducer.multiply (result.data(), result.data(), result.data());
 
-            xm.montgomeryMultiplication (1, modulus, m1, Rfactor);
-            swapWith (xm);
-        }
+        if (const auto digit = exponent.getBitRangeAsInt (window * windowBits, windowBits))
+            reducer.multiply (result.data(), result.data(), powers.data() + digit * size);
     }
+
+    // Multiplying by 1 takes the value back out of Montgomery form
+    std::vector<uint32> one (size);
+    one[0] = 1;
+    reducer.multiply (result.data(), result.data(), one.data());
+
+    BigInteger r;
+    r.highestBit = numRBits - 1;
+    std::copy (result.begin(), result.end(), r.ensureSize (size));
+    r.highestBit = r.getHighestBit();
+    swapWith (r);
 }
 
 void BigInteger::montgomeryMultiplication (const BigInteger& other, const BigInteger& modulus,
@@ -1082,10 +1408,12 @@ void BigInteger::inverseModulo (const BigInteger& modulus)
         b2 = temp2;
     }
 
-    while (b2.isNegative())
+    // b2 can be many multiples of the modulus away from zero, so reduce it before correcting the sign
+    b2 %= modulus;
+
+    if (b2.isNegative())
         b2 += modulus;
 
-    b2 %= modulus;
     swapWith (b2);
 }
 
@@ -1349,6 +1677,127 @@ public:
             }
         }
 
+        {
+            beginTest ("Large multiplication and division");
+
+            Random r = getRandom();
+
+            for (int j = 40; --j >= 0;)
+            {
+                BigInteger b1, b2;
+                r.fillBitsRandomly (b1, 0, r.nextInt (6000) + 1000);
+                r.fillBitsRandomly (b2, 0, r.nextInt (6000) + 1000);
+                b1.setBit (0);
+                b2.setBit (0);
+
+                // Build the product from shifts and additions, so it doesn't depend on operator*
+                BigInteger expected;
+
+                for (int bit = b2.findNextSetBit (0); bit >= 0; bit = b2.findNextSetBit (bit + 1))
+                    expected += b1 << bit;
+
+                const auto product = b1 * b2;
+                expect (product == expected);
+
+                auto quotient = product + b2 - 1;
+                BigInteger remainder;
+                quotient.divideBy (b1, remainder);
+                expect (quotient * b1 + remainder == product + b2 - 1);
+                expect (remainder.compareAbsolute (b1) < 0);
+
+                auto negativeQuotient = -product;
+                negativeQuotient.divideBy (b2, remainder);
+                expect (negativeQuotient == -b1);
+                expect (remainder.isZero());
+            }
+
+            // A case where the first estimate of a quotient digit is too large and has to be corrected
+            BigInteger dividend, divisor, remainder;
+            dividend.parseString ("7fffffff800000000000000000000000", 16);
+            divisor.parseString ("800000000000000000000001", 16);
+
+            auto quotient = dividend;
+            quotient.divideBy (divisor, remainder);
+            expect (quotient * divisor + remainder == dividend);
+            expect (remainder.compareAbsolute (divisor) < 0);
+        }
+
+        {
+            beginTest ("Exponent modulo");
+
+            Random r = getRandom();
+
+            const auto slowExponentModulo = [] (BigInteger base, const BigInteger& exponent, const BigInteger& modulus)
+            {
+                BigInteger result (1);
+                base %= modulus;
+
+                for (int i = exponent.getHighestBit(); i >= 0; --i)
+                {
+                    result = (result * result) % modulus;
+
+                    if (exponent[i])
+                        result = (result * base) % modulus;
+                }
+
+                return result % modulus;
+            };
+
+            for (int j = 200; --j >= 0;)
+            {
+                BigInteger base, exponent, modulus;
+                r.fillBitsRandomly (base, 0, r.nextInt (1200) + 1);
+                r.fillBitsRandomly (exponent, 0, r.nextInt (700) + 1);
+
+                while (modulus < 2)
+                    r.fillBitsRandomly (modulus, 0, r.nextInt (1100) + 2);
+
+                auto result = base;
+                result.exponentModulo (exponent, modulus);
+                expect (result == slowExponentModulo (base, exponent, modulus));
+            }
+
+            // Fermat's little theorem, with the Mersenne prime 2^521 - 1
+            const auto prime = (BigInteger (1) << 521) - 1;
+
+            for (int j = 10; --j >= 0;)
+            {
+                BigInteger base;
+                r.fillBitsRandomly (base, 0, 520);
+                base.setBit (0);
+
+                auto result = base;
+                result.exponentModulo (prime - 1, prime);
+                expect (result.isOne());
+            }
+
+            auto negativeBase = BigInteger (-3);
+            negativeBase.exponentModulo (3, 1000001);
+            expect (negativeBase == BigInteger (1000001 - 27));
+        }
+
+        {
+            beginTest ("Inverse modulo");
+
+            Random r = getRandom();
+
+            for (int j = 100; --j >= 0;)
+            {
+                BigInteger value, modulus;
+                r.fillBitsRandomly (value, 0, r.nextInt (400) + 2);
+                r.fillBitsRandomly (modulus, 0, r.nextInt (400) + 2);
+                modulus.setBit (0);
+
+                if (modulus.isOne() || ! value.findGreatestCommonDivisor (modulus).isOne())
+                    continue;
+
+                auto inverse = value;
+                inverse.inverseModulo (modulus);
+                expect (! inverse.isNegative() && inverse < modulus);
+                expect (((inverse * value) % modulus).isOne());
+            }
+        }
+
         {
             beginTest ("Bit setting");
 
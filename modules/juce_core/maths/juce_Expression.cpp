@@ -648,6 +648,128 @@ struct Expression::Helpers
         JUCE_DECLARE_NON_COPYABLE (SymbolListVisitor)
     };
 
+    //==============================================================================
+    class Compiler
+    {
+    public:
+        Compiler (Program& p, const StringArray& names, const Scope& s)
+            : program (p), inputNames (names), scope (s) {}
+
+        // Appends the instructions for a term, and returns true if it was reduced to a constant
+        bool compile (Term& t, int recursionDepth)
+        {
+            checkRecursionDepth (recursionDepth);
+
+            if (auto* symbol = dynamic_cast<SymbolTerm*> (&t))
+            {
+                auto index = inputNames.indexOf (symbol->symbol);
+
+                if (index < 0)
+                    return compile (*scope.getSymbolValue (symbol->symbol).term, recursionDepth + 1);
+
+                program.instructions.add ({ Program::Op::input, index, 0, 0.0 });
+                return false;
+            }
+
+            if (dynamic_cast<DotOperator*> (&t) != nullptr)
+            {
+                // Symbols in other scopes can't be inputs, so these are always constant
+                addConstant (t.resolve (scope, recursionDepth)->toDouble());
+                return true;
+            }
+
+            if (auto* function = dynamic_cast<Function*> (&t))
+            {
+                auto numParams = function->getNumInputs();
+                auto firstParam = program.instructions.size();
+
+                if (! compileInputs (t, recursionDepth))
+                {
+                    program.instructions.add ({ Program::Op::function, program.functionNames.size(), numParams, 0.0 });
+                    program.functionNames.add (function->functionName);
+                    program.scope = &scope;
+                    return false;
+                }
+
+                auto params = getConstants (firstParam, numParams);
+                addConstant (scope.evaluateFunction (function->functionName, params.begin(), numParams));
+                return true;
+            }
+
+            auto op = getOperator (t);
+            auto firstInput = program.instructions.size();
+
+            if (! compileInputs (t, recursionDepth))
+            {
+                program.instructions.add ({ op, 0, 0, 0.0 });
+                return false;
+            }
+
+            auto inputs = getConstants (firstInput, t.getNumInputs());
+
+            switch (op)
+            {
+                case Program::Op::constant:  addConstant (t.toDouble()); break;
+                case Program::Op::negate:    addConstant (-inputs[0]); break;
+                case Program::Op::add:       addConstant (inputs[0] + inputs[1]); break;
+                case Program::Op::subtract:  addConstant (inputs[0] - inputs[1]); break;
+                case Program::Op::multiply:  addConstant (inputs[0] * inputs[1]); break;
+                case Program::Op::divide:    addConstant (inputs[0] / inputs[1]); break;
+                case Program::Op::input:
+                case Program::Op::function:
+                default:                     jassertfalse; break;
+            }
+
+            return true;
+        }
+
+    private:
+        Program& program;
+        const StringArray& inputNames;
+        const Scope& scope;
+
+        bool compileInputs (const Term& t, int recursionDepth)
+        {
+            bool allConstant = true;
+
+            for (int i = 0; i < t.getNumInputs(); ++i)
+                allConstant = compile (*t.getInput (i), recursionDepth + 1) && allConstant;
+
+            return allConstant;
+        }
+
+        void addConstant (double value)
+        {
+            program.instructions.add ({ Program::Op::constant, 0, 0, value });
+        }
+
+        // Removes the given number of constants from the end of the program, and returns their values
+        Array<double> getConstants (int start, int num)
+        {
+            Array<double> values;
+
+            for (int i = 0; i < num; ++i)
+                values.add (program.instructions.getReference (start + i).value);
+
+            program.instructions.removeRange (start, num);
+            return values;
+        }
+
+        static Program::Op getOperator (const Term& t)
+        {
+            if (dynamic_cast<const Add*>      (&t) != nullptr)  return Program::Op::add;
+            if (dynamic_cast<const Subtract*> (&t) != nullptr)  return Program::Op::subtract;
+            if (dynamic_cast<const Multiply*> (&t) != nullptr)  return Program::Op::multiply;
+            if (dynamic_cast<const Divide*>   (&t) != nullptr)  return Program::Op::divide;
+            if (dynamic_cast<const Negate*>   (&t) != nullptr)  return Program::Op::negate;
+
+            jassert (t.getType() == constantType);
+            return Program::Op::constant;
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (Compiler)
+    };
+
     //==============================================================================
     class Parser
     {
@@ -1005,6 +1127,163 @@ double Expression::evaluate (const Scope& scope, String& evaluationError) const
     return 0;
 }
 
+Expression::Program Expression::compile (const StringArray& inputNames, const Scope& scope, String& compilationError) const
+{
+    Program program;
+
+    try
+    {
+        Helpers::Compiler (program, inputNames, scope).compile (*term, 0);
+    }
+    catch (Helpers::EvaluationError& e)
+    {
+        compilationError = e.description;
+        return {};
+    }
+
+    program.numInputs = inputNames.size();
+    int stackSize = 0;
+
+    for (auto& i : program.instructions)
+    {
+        switch (i.op)
+        {
+            case Program::Op::constant:
+            case Program::Op::input:     ++stackSize; break;
+            case Program::Op::function:  stackSize += 1 - i.numParameters; break;
+            case Program::Op::negate:    break;
+            case Program::Op::add:
+            case Program::Op::subtract:
+            case Program::Op::multiply:
+            case Program::Op::divide:
+            default:                     --stackSize; break;
+        }
+
+        program.maxStackSize = jmax (program.maxStackSize, stackSize);
+    }
+
+    return program;
+}
+
+//==============================================================================
+double Expression::Program::callFunction (const Instruction& i, const double* parameters) const
+{
+    try
+    {
+        return scope->evaluateFunction (functionNames[i.index], parameters, i.numParameters);
+    }
+    catch (Helpers::EvaluationError&)
+    {
+        return 0;
+    }
+}
+
+double Expression::Program::evaluate (const double* inputs) const
+{
+    if (instructions.isEmpty())
+        return 0;
+
+    double localStack[32];
+    HeapBlock<double> allocatedStack;
+    auto* stack = localStack;
+
+    if (maxStackSize > numElementsInArray (localStack))
+    {
+        allocatedStack.malloc (maxStackSize);
+        stack = allocatedStack;
+    }
+
+    auto* top = stack - 1;
+
+    for (auto& i : instructions)
+    {
+        switch (i.op)
+        {
+            case Op::constant:  *++top = i.value; break;
+            case Op::input:     *++top = inputs[i.index]; break;
+            case Op::add:       --top; top[0] += top[1]; break;
+            case Op::subtract:  --top; top[0] -= top[1]; break;
+            case Op::multiply:  --top; top[0] *= top[1]; break;
+            case Op::divide:    --top; top[0] /= top[1]; break;
+            case Op::negate:    top[0] = -top[0]; break;
+
+            case Op::function:
+            {
+                auto* params = top + 1 - i.numParameters;
+                *params = callFunction (i, params);
+                top = params;
+                break;
+            }
+
+            default:            jassertfalse; break;
+        }
+    }
+
+    return *top;
+}
+
+void Expression::Program::evaluate (const double* const* inputs, double* results, int numValues) const
+{
+    if (instructions.isEmpty())
+    {
+        std::fill (results, results + numValues, 0.0);
+        return;
+    }
+
+    // Each instruction runs over a block of values at a time, so that the loops can be vectorised
+    constexpr int blockSize = 64;
+    int maxNumParameters = 0;
+
+    for (auto& i : instructions)
+        maxNumParameters = jmax (maxNumParameters, i.numParameters);
+
+    HeapBlock<double> stack ((size_t) (maxStackSize * blockSize));
+    HeapBlock<double> parameters ((size_t) jmax (1, maxNumParameters));
+
+    for (int start = 0; start < numValues; start += blockSize)
+    {
+        auto num = jmin (blockSize, numValues - start);
+        auto* top = stack.get() - blockSize;
+
+        for (auto& i : instructions)
+        {
+            auto* a = top - blockSize;
+
+            switch (i.op)
+            {
+                case Op::constant:  top += blockSize; std::fill (top, top + num, i.value); break;
+                case Op::input:     top += blockSize; std::copy (inputs[i.index] + start, inputs[i.index] + start + num, top); break;
+                case Op::add:       for (int j = 0; j < num; ++j)  a[j] += top[j];  top = a; break;
+                case Op::subtract:  for (int j = 0; j < num; ++j)  a[j] -= top[j];  top = a; break;
+                case Op::multiply:  for (int j = 0; j < num; ++j)  a[j] *= top[j];  top = a; break;
+                case Op::divide:    for (int j = 0; j < num; ++j)  a[j] /= top[j];  top = a; break;
+                case Op::negate:    for (int j = 0; j < num; ++j)  top[j] = -top[j]; break;
+
+                case Op::function:
+                {
+                    auto* firstParam = top - (i.numParameters - 1) * blockSize;
+
+                    for (int j = 0; j < num; ++j)
+                    {
+                        for (int p = 0; p < i.numParameters; ++p)
+                            parameters[p] = firstParam[p * blockSize + j];
+
+                        firstParam[j] = callFunction (i, parameters);
+                    }
+
+                    top = firstParam;
+                    break;
+                }
+
+                default:            jassertfalse; break;
+            }
+        }
+
+        std::copy (top, top + num, results + start);
+    }
+}
+
+//==============================================================================
 Expression Expression::operator+ (const Expression& other) const  { return Expression (new Helpers::Add (term, other.term)); }
 Expression Expression::operator- (const Expression& other) const  { return Expression (new Helpers::Subtract (term, other.term)); }
 Expression Expression::operator* (const Expression& other) const  { return Expression (new Helpers::Multiply (term, other.term)); }
@@ -1171,4 +1450,114 @@ String Expression::Scope::getScopeUID() const
     return {};
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ExpressionTests final : public UnitTest
+{
+public:
+    ExpressionTests()
+        : UnitTest ("Expression", UnitTestCategories::maths)
+    {}
+
+    struct TestScope final : public Expression::Scope
+    {
+        Expression getSymbolValue (const String& symbol) const override
+        {
+            if (symbol == "depth")   return Expression (0.5);
+            if (symbol == "offset")  return Expression ("depth * 4", error);
+
+            return Expression::Scope::getSymbolValue (symbol);
+        }
+
+        double evaluateFunction (const String& functionName, const double* parameters, int numParameters) const override
+        {
+            if (functionName == "clip" && numParameters == 1)
+                return jlimit (-1.0, 1.0, parameters[0]);
+
+            return Expression::Scope::evaluateFunction (functionName, parameters, numParameters);
+        }
+
+        mutable String error;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Compiled programs");
+        {
+            TestScope scope;
+            String error;
+            Expression e ("clip (x * depth + offset - y) + max (x, -y, sin (0)) / -2", error);
+            expect (error.isEmpty());
+
+            auto program = e.compile ({ "x", "y" }, scope, error);
+            expect (error.isEmpty());
+            expectEquals (program.getNumInputs(), 2);
+
+            struct XYScope final : public Expression::Scope
+            {
+                explicit XYScope (const TestScope& s) : scope (s) {}
+
+                Expression getSymbolValue (const String& symbol) const override
+                {
+                    if (symbol == "x")  return Expression (x);
+                    if (symbol == "y")  return Expression (y);
+                    return scope.getSymbolValue (symbol);
+                }
+
+                double evaluateFunction (const String& name, const double* params, int numParams) const override
+                {
+                    return scope.evaluateFunction (name, params, numParams);
+                }
+
+                const TestScope& scope;
+                double x = 0, y = 0;
+            };
+
+            XYScope xyScope (scope);
+            double xs[100], ys[100], results[100];
+
+            for (int i = 0; i < 100; ++i)
+            {
+                xs[i] = xyScope.x = i * 0.1 - 5.0;
+                ys[i] = xyScope.y = i * 0.37 - 20.0;
+
+                const double inputs[] = { xs[i], ys[i] };
+                expectWithinAbsoluteError (program.evaluate (inputs), e.evaluate (xyScope), 1.0e-12);
+            }
+
+            const double* inputArrays[] = { xs, ys };
+            program.evaluate (inputArrays, results, 100);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                const double inputs[] = { xs[i], ys[i] };
+                expectEquals (results[i], program.evaluate (inputs));
+            }
+        }
+
+        beginTest ("Constant folding and errors");
+        {
+            TestScope scope;
+            String error;
+
+            auto program = Expression ("offset * 3 + abs (-2)", error).compile ({}, scope, error);
+            expect (error.isEmpty());
+            expectEquals (program.evaluate (nullptr), 8.0);
+
+            auto failed = Expression ("x + unknown", error).compile ({ "x" }, scope, error);
+            expect (error.isNotEmpty());
+
+            const double input = 1.0;
+            expectEquals (failed.evaluate (&input), 0.0);
+            expectEquals (Expression::Program().evaluate (nullptr), 0.0);
+        }
+    }
+};
+
+static ExpressionTests expressionTests;
+
+#endif
+
 } // namespace juce
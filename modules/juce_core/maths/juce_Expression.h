@@ -170,6 +170,25 @@ public:
     */
     double evaluate (const Scope& scope, String& evaluationError) const;
 
+    //==============================================================================
+    class Program;
+
+    /** Compiles this expression into a Program, which can evaluate it much more quickly.
+
+        Each symbol whose name is in the inputNames list becomes an input of the program,
+        whose value is supplied each time it's evaluated. All the other symbols are looked
+        up in the scope now, and any parts of the expression that don't depend on the inputs
+        are evaluated straight away.
+
+        If the expression calls a function with arguments that depend on the inputs, the
+        program will call Scope::evaluateFunction() on the scope you pass in here, so the scope
+        must stay valid for as long as the program is used.
+
+        If there's an error, it's returned in the compilationError parameter, and the program
+        that's returned will just evaluate to 0.
+    */
+    Program compile (const StringArray& inputNames, const Scope& scope, String& compilationError) const;
+
     /** Attempts to return an expression which is a copy of this one, but with a constant adjusted
         to make the expression resolve to a target value.
 
@@ -248,4 +267,77 @@ private:
     explicit Expression (Term*);
 };
 
+//==============================================================================
+/**
+    A compiled form of an Expression, created by Expression::compile().
+
+    Evaluating an Expression walks its tree of terms and looks up all its symbols by name
+    each time. A Program instead holds a flat list of instructions, with the symbols that
+    are inputs reduced to indexes and everything else already resolved, so it's suitable
+    for evaluating a formula for every block or sample of audio.
+
+    @tags{Core}
+*/
+class JUCE_API  Expression::Program
+{
+public:
+    /** Creates an empty program, which evaluates to 0. */
+    Program() = default;
+
+    /** Returns the number of input values that the program needs.
+        This is the number of names that were passed to Expression::compile().
+    */
+    int getNumInputs() const noexcept                { return numInputs; }
+
+    /** Evaluates the program.
+
+        The inputs array must contain a value for each of the input names that were passed to
+        Expression::compile(), in the same order. If a function call fails, its result is
+        treated as 0.
+    */
+    double evaluate (const double* inputs) const;
+
+    /** Evaluates the program for a whole set of input values at once.
+
+        This is much quicker than calling evaluate() for each set of values in turn.
+
+        @param inputs      an array of pointers, one for each of the input names that were passed
+                           to Expression::compile(). Each one must point to numValues values.
+        @param results     the array to write the results into, which must have space for numValues
+        @param numValues   the number of values to evaluate
+    */
+    void evaluate (const double* const* inputs, double* results, int numValues) const;
+
+private:
+    //==============================================================================
+    friend class Expression;
+
+    enum class Op : uint8
+    {
+        constant,
+        input,
+        add,
+        subtract,
+        multiply,
+        divide,
+        negate,
+        function
+    };
+
+    struct Instruction
+    {
+        Op op;
+        int index;          // the input index, or the index in functionNames
+        int numParameters;  // for a function call
+        double value;       // for a constant
+    };
+
+    Array<Instruction> instructions;
+    StringArray functionNames;
+    const Scope* scope = nullptr;
+    int numInputs = 0, maxStackSize = 0;
+
+    double callFunction (const Instruction&, const double* parameters) const;
+};
+
 } // namespace juce
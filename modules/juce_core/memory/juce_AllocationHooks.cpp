@@ -41,42 +41,64 @@ void notifyAllocationHooksForThread()
 
 }
 
+#endif
+
+#if JUCE_ENABLE_ALLOCATION_HOOKS || JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+
+namespace juce
+{
+
+static void allocationFunctionCalled ([[maybe_unused]] const char* functionName) noexcept
+{
+   #if JUCE_ENABLE_ALLOCATION_HOOKS
+    notifyAllocationHooksForThread();
+   #endif
+
+    JUCE_CHECK_REALTIME_SAFETY (allocation, functionName);
+}
+
+}
+
 void* operator new (size_t s)
 {
-    juce::notifyAllocationHooksForThread();
+    juce::allocationFunctionCalled ("operator new");
     return std::malloc (s);
 }
 
 void* operator new[] (size_t s)
 {
-    juce::notifyAllocationHooksForThread();
+    juce::allocationFunctionCalled ("operator new[]");
     return std::malloc (s);
 }
 
 void operator delete (void* p) noexcept
 {
-    juce::notifyAllocationHooksForThread();
+    juce::allocationFunctionCalled ("operator delete");
     std::free (p);
 }
 
 void operator delete[] (void* p) noexcept
 {
-    juce::notifyAllocationHooksForThread();
+    juce::allocationFunctionCalled ("operator delete[]");
     std::free (p);
 }
 
 void operator delete (void* p, size_t) noexcept
 {
-    juce::notifyAllocationHooksForThread();
+    juce::allocationFunctionCalled ("operator delete");
     std::free (p);
 }
 
 void operator delete[] (void* p, size_t) noexcept
 {
-    juce::notifyAllocationHooksForThread();
+    juce::allocationFunctionCalled ("operator delete[]");
     std::free (p);
 }
 
+#endif
+
+#if JUCE_ENABLE_ALLOCATION_HOOKS
+
 namespace juce
 {
 
@@ -95,6 +117,19 @@ UnitTestAllocationChecker::~UnitTestAllocationChecker() noexcept
 
 void UnitTestAllocationChecker::newOrDeleteCalled() noexcept { ++calls; }
 
+//==============================================================================
+ScopedAllocationCounter::ScopedAllocationCounter()
+{
+    getAllocationHooksForThread().addListener (this);
+}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() noexcept
+{
+    getAllocationHooksForThread().removeListener (this);
+}
+
+void ScopedAllocationCounter::newOrDeleteCalled() noexcept { ++calls; }
+
 }
 
 #endif
@@ -68,6 +68,32 @@ private:
     size_t calls = 0;
 };
 
+//==============================================================================
+/** Counts the calls to new and delete that are made on the calling thread during
+    the lifetime of the ScopedAllocationCounter.
+
+    Allocations made by other threads are not counted.
+*/
+class ScopedAllocationCounter  : private AllocationHooks::Listener
+{
+public:
+    /** Starts counting the calls to new and delete made on the calling thread. */
+    ScopedAllocationCounter();
+
+    /** Stops counting. This must be destroyed on the thread that created it. */
+    ~ScopedAllocationCounter() noexcept override;
+
+    /** Returns the number of calls to new and delete that have been made so far. */
+    size_t getNumCalls() const noexcept     { return calls; }
+
+private:
+    void newOrDeleteCalled() noexcept override;
+
+    size_t calls = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedAllocationCounter)
+};
+
 }
 
 #endif
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/** The minimum distance in bytes between two objects that are written by different
+    threads, if they're to avoid false sharing, i.e. the size of a cache line.
+
+    Apple's ARM chips use 128-byte cache lines, and everything else that JUCE runs
+    on uses 64 bytes. This is the same value that std::hardware_destructive_interference_size
+    has where it's available, but that isn't provided by all the standard libraries
+    that JUCE supports.
+
+    @see CacheLinePadded
+*/
+#if (JUCE_MAC || JUCE_IOS) && JUCE_ARM
+ inline constexpr size_t hardwareDestructiveInterferenceSize = 128;
+#else
+ inline constexpr size_t hardwareDestructiveInterferenceSize = 64;
+#endif
+
+/** The maximum size in bytes of a block of memory that's guaranteed to sit in a
+    single cache line, if it's suitably aligned. Objects that are used together by
+    the same thread will be fastest if they fit in this much space.
+*/
+inline constexpr size_t hardwareConstructiveInterferenceSize = 64;
+
+//==============================================================================
+/**
+    Holds an object on a cache line of its own.
+
+    Whenever a thread writes to some memory, any other cores that have the same cache
+    line in their caches have to reload it. If two threads are busily writing to
+    different objects that happen to share a cache line - a pair of counters, say, or
+    the read and write positions of a FIFO - the line will bounce between the cores, and
+    both threads will slow down, even though they never touch each other's data. This
+    is known as false sharing.
+
+    Wrapping each object in a CacheLinePadded aligns it to the start of a cache line,
+    and pads it out to fill the whole line, so that nothing else can share it.
+    @code
+    struct Queue
+    {
+        CacheLinePadded<std::atomic<int>> readPosition { 0 }, writePosition { 0 };
+    };
+
+    queue.readPosition->store (1);
+    @endcode
+
+    @see hardwareDestructiveInterferenceSize, ShardedCounter
+
+    @tags{Core}
+*/
+template <typename Type>
+struct alignas (hardwareDestructiveInterferenceSize) CacheLinePadded
+{
+    /** Creates a default-constructed object. */
+    CacheLinePadded() = default;
+
+    /** Creates the object, passing the given arguments to its constructor. */
+    template <typename... Args, std::enable_if_t<(sizeof... (Args) > 0) && std::is_constructible_v<Type, Args...>, int> = 0>
+    explicit CacheLinePadded (Args&&... args)  : value (std::forward<Args> (args)...) {}
+
+    /** Returns a reference to the object. */
+    Type& get() noexcept                            { return value; }
+
+    /** Returns a reference to the object. */
+    const Type& get() const noexcept                { return value; }
+
+    /** Returns a reference to the object. */
+    Type& operator*() noexcept                      { return value; }
+
+    /** Returns a reference to the object. */
+    const Type& operator*() const noexcept          { return value; }
+
+    /** Allows the object's members to be accessed directly. */
+    Type* operator->() noexcept                     { return &value; }
+
+    /** Allows the object's members to be accessed directly. */
+    const Type* operator->() const noexcept         { return &value; }
+
+    /** The object. */
+    Type value {};
+};
+
+} // namespace juce
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+MonotonicArena::MonotonicArena (size_t initialBlockSize) noexcept
+    : nextBlockSize (jmax ((size_t) 256, initialBlockSize))
+{
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    while (currentBlock != nullptr)
+        std::free (std::exchange (currentBlock, currentBlock->previous));
+}
+
+// The block header is padded so that the data starts with the maximum alignment
+static constexpr size_t arenaBlockHeaderSize = 2 * sizeof (std::max_align_t);
+
+char* MonotonicArena::getStartOfData (Block* block) noexcept
+{
+    static_assert (sizeof (Block) <= arenaBlockHeaderSize, "Block header must fit in the space reserved for it");
+    return reinterpret_cast<char*> (block) + arenaBlockHeaderSize;
+}
+
+void MonotonicArena::addBlock (size_t minimumSize)
+{
+    auto size = jmax (nextBlockSize, minimumSize);
+    auto* block = static_cast<Block*> (std::malloc (arenaBlockHeaderSize + size));
+
+    if (block == nullptr)
+        throw std::bad_alloc();
+
+    block->previous = currentBlock;
+    block->size = size;
+    currentBlock = block;
+    position = 0;
+    numBytesReserved += size;
+    nextBlockSize = size * 2;
+}
+
+void* MonotonicArena::allocate (size_t numBytes, size_t alignment)
+{
+    jassert (isPowerOfTwo (alignment));
+
+    auto padding = [&]
+    {
+        auto address = (pointer_sized_uint) (getStartOfData (currentBlock) + position);
+        return (size_t) ((alignment - (address & (alignment - 1))) & (alignment - 1));
+    };
+
+    if (currentBlock == nullptr || position + padding() + numBytes > currentBlock->size)
+        addBlock (numBytes + alignment);
+
+    auto offset = padding();
+    auto* result = getStartOfData (currentBlock) + position + offset;
+    position += offset + numBytes;
+    numBytesUsed += offset + numBytes;
+    return result;
+}
+
+void MonotonicArena::reset() noexcept
+{
+    if (currentBlock == nullptr)
+        return;
+
+    // The current block is always the largest, so that's the one to keep
+    while (auto* previous = currentBlock->previous)
+    {
+        currentBlock->previous = previous->previous;
+        numBytesReserved -= previous->size;
+        std::free (previous);
+    }
+
+    position = 0;
+    numBytesUsed = 0;
+}
+
+} // namespace juce
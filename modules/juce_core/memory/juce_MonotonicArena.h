@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Hands out memory from a few large blocks, and frees it all at once.
+
+    Allocating from an arena is just a matter of bumping a pointer, and there's no
+    per-allocation bookkeeping. Individual allocations are never freed - instead, all of
+    them are released together by reset() or when the arena is deleted. That makes it a
+    good fit for things like parsers or graph builders, which create lots of small
+    temporary objects and then throw them all away when they've finished.
+
+    The arena doesn't call any destructors, so anything that's created in its memory
+    must either be trivially destructible, or be destroyed by the caller before the
+    memory is released.
+
+    To use an arena for a container, pass it an ArenaAllocator, e.g.
+    @code
+    MonotonicArena arena;
+    std::vector<int, ArenaAllocator<int>> numbers { ArenaAllocator<int> (arena) };
+    FlatHashMap<int, float, DefaultHashFunctions, ArenaAllocator<int>> map ({}, ArenaAllocator<int> (arena));
+    @endcode
+
+    This class isn't thread-safe.
+
+    @see ArenaAllocator, PoolAllocator
+
+    @tags{Core}
+*/
+class JUCE_API  MonotonicArena
+{
+public:
+    /** Creates an arena.
+        No memory is allocated until it's needed. The first block will be at least the
+        given size, and each block after that will be twice as big as the one before.
+    */
+    explicit MonotonicArena (size_t initialBlockSize = 4096) noexcept;
+
+    /** Destructor. This releases all the memory that was allocated from the arena. */
+    ~MonotonicArena();
+
+    /** Returns a block of uninitialised memory with the given size and alignment.
+        The alignment must be a power of two.
+    */
+    void* allocate (size_t numBytes, size_t alignment = alignof (std::max_align_t));
+
+    /** Releases all the memory that has been allocated.
+
+        The largest block is kept, so that the arena can be reused without having to
+        allocate any more memory from the system, as long as it doesn't need more than
+        it did last time.
+    */
+    void reset() noexcept;
+
+    /** Returns the number of bytes that have been handed out since the arena was created
+        or last reset, including any padding that was needed for alignment.
+    */
+    size_t getNumBytesUsed() const noexcept         { return numBytesUsed; }
+
+    /** Returns the total size of the blocks that the arena has allocated from the system. */
+    size_t getNumBytesReserved() const noexcept     { return numBytesReserved; }
+
+private:
+    //==============================================================================
+    struct Block
+    {
+        Block* previous;
+        size_t size;
+    };
+
+    Block* currentBlock = nullptr;
+    size_t nextBlockSize, position = 0, numBytesUsed = 0, numBytesReserved = 0;
+
+    static char* getStartOfData (Block*) noexcept;
+    void addBlock (size_t minimumSize);
+
+    JUCE_DECLARE_NON_COPYABLE (MonotonicArena)
+};
+
+//==============================================================================
+/**
+    A standard-library-compatible allocator that takes its memory from a MonotonicArena.
+
+    This can be used with any container that accepts a std::allocator-style allocator,
+    such as the std containers and FlatHashMap. Deallocating does nothing - the memory
+    is only released when the arena is reset or deleted - so the arena must outlive any
+    containers that use it.
+
+    @see MonotonicArena
+
+    @tags{Core}
+*/
+template <typename Type>
+class ArenaAllocator
+{
+public:
+    using value_type = Type;
+
+    /** Creates an allocator that uses the given arena. */
+    ArenaAllocator (MonotonicArena& arenaToUse) noexcept  : arena (&arenaToUse) {}
+
+    /** Creates a copy of an allocator for a different type, which will use the same arena. */
+    template <typename OtherType>
+    ArenaAllocator (const ArenaAllocator<OtherType>& other) noexcept  : arena (other.getArena()) {}
+
+    /** Allocates space for the given number of objects. */
+    Type* allocate (size_t numObjects)
+    {
+        return static_cast<Type*> (arena->allocate (numObjects * sizeof (Type), alignof (Type)));
+    }
+
+    /** Does nothing, as the memory is only released when the arena is reset or deleted. */
+    void deallocate (Type*, size_t) noexcept {}
+
+    /** Returns the arena that this allocator uses. */
+    MonotonicArena* getArena() const noexcept    { return arena; }
+
+    template <typename OtherType>
+    bool operator== (const ArenaAllocator<OtherType>& other) const noexcept   { return arena == other.getArena(); }
+
+    template <typename OtherType>
+    bool operator!= (const ArenaAllocator<OtherType>& other) const noexcept   { return arena != other.getArena(); }
+
+private:
+    MonotonicArena* arena;
+};
+
+} // namespace juce
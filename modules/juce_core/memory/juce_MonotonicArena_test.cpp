@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class MonotonicArenaTests  : public UnitTest
+{
+public:
+    MonotonicArenaTests()
+        : UnitTest ("MonotonicArena", UnitTestCategories::memory)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Allocations are aligned and don't overlap");
+        {
+            MonotonicArena arena (256);
+            Array<std::pair<char*, size_t>> blocks;
+
+            for (size_t i = 0; i < 200; ++i)
+            {
+                auto size = 1 + (i * 7) % 50;
+                auto alignment = (size_t) 1 << (i % 7);
+                auto* p = static_cast<char*> (arena.allocate (size, alignment));
+
+                expect (((pointer_sized_uint) p & (alignment - 1)) == 0);
+                std::fill (p, p + size, (char) i);
+                blocks.add ({ p, size });
+            }
+
+            auto allIntact = true;
+
+            for (int i = 0; i < blocks.size(); ++i)
+                for (size_t j = 0; j < blocks[i].second; ++j)
+                    allIntact = allIntact && blocks[i].first[j] == (char) i;
+
+            expect (allIntact);
+            expect (arena.getNumBytesReserved() >= arena.getNumBytesUsed());
+        }
+
+        beginTest ("Large allocations get their own block");
+        {
+            MonotonicArena arena (256);
+            auto* p = static_cast<char*> (arena.allocate (100000));
+            std::fill (p, p + 100000, 'x');
+            expect (arena.getNumBytesReserved() >= 100000);
+        }
+
+        beginTest ("Reset keeps the largest block");
+        {
+            MonotonicArena arena (256);
+
+            for (int i = 0; i < 100; ++i)
+                arena.allocate (100);
+
+            auto reserved = arena.getNumBytesReserved();
+            arena.reset();
+
+            expectEquals ((int) arena.getNumBytesUsed(), 0);
+            expect (arena.getNumBytesReserved() < reserved);
+
+            auto keptBlock = arena.getNumBytesReserved();
+            arena.allocate (keptBlock / 2);
+            expectEquals (arena.getNumBytesReserved(), keptBlock);
+        }
+
+        beginTest ("ArenaAllocator works with std containers");
+        {
+            MonotonicArena arena;
+            std::vector<int, ArenaAllocator<int>> numbers { ArenaAllocator<int> (arena) };
+
+            for (int i = 0; i < 1000; ++i)
+                numbers.push_back (i);
+
+            expectEquals (std::accumulate (numbers.begin(), numbers.end(), 0), 499500);
+            expect (arena.getNumBytesUsed() >= 1000 * sizeof (int));
+        }
+
+        beginTest ("ArenaAllocator works with FlatHashMap");
+        {
+            MonotonicArena arena;
+            FlatHashMap<int, String, DefaultHashFunctions, ArenaAllocator<int>> map ({}, ArenaAllocator<int> (arena));
+
+            for (int i = 0; i < 500; ++i)
+                map.set (i, String (i));
+
+            expectEquals (map.size(), 500);
+            expectEquals (map[123], String ("123"));
+            expect (arena.getNumBytesUsed() > 0);
+        }
+
+        beginTest ("PoolAllocator recycles slots");
+        {
+            PoolAllocator<String, 8> pool;
+            Array<String*> strings;
+
+            for (int i = 0; i < 20; ++i)
+                strings.add (pool.create (String (i)));
+
+            expectEquals (pool.getNumAllocated(), 20);
+            expectEquals (pool.getCapacity(), 24);
+            expectEquals (*strings[17], String ("17"));
+
+            auto* freed = strings.removeAndReturn (5);
+            pool.destroy (freed);
+            auto* reused = pool.create ("reused");
+
+            expect (reused == freed);
+            expectEquals (pool.getCapacity(), 24);
+            strings.add (reused);
+
+            for (auto* s : strings)
+                pool.destroy (s);
+
+            expectEquals (pool.getNumAllocated(), 0);
+        }
+    }
+};
+
+static MonotonicArenaTests monotonicArenaTests;
+
+} // namespace juce
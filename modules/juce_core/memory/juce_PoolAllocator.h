@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Allocates and recycles storage for single objects of one type.
+
+    The pool takes memory from the system in chunks big enough for a number of objects,
+    and keeps a list of the slots that have been freed, so allocating and deallocating
+    objects is very cheap and doesn't touch the system allocator once the pool has grown
+    big enough. This makes it useful for things like graph nodes or list items that are
+    created and deleted frequently.
+
+    All the chunks are released when the pool is deleted, so any objects that are still
+    alive at that point must have been destroyed first.
+
+    This class isn't thread-safe.
+
+    @see MonotonicArena
+
+    @tags{Core}
+*/
+template <typename Type, int itemsPerChunk = 64>
+class PoolAllocator
+{
+public:
+    /** Creates an empty pool. */
+    PoolAllocator() = default;
+
+    /** Destructor. This releases all the memory that the pool has allocated. */
+    ~PoolAllocator()
+    {
+        // All the objects should have been returned to the pool before it's deleted!
+        jassert (numAllocated == 0);
+    }
+
+    /** Returns uninitialised storage for one object. */
+    Type* allocate()
+    {
+        if (freeList == nullptr)
+            addChunk();
+
+        auto* slot = freeList;
+        freeList = slot->next;
+        ++numAllocated;
+        return reinterpret_cast<Type*> (slot);
+    }
+
+    /** Returns some storage that was previously obtained from allocate() to the pool. */
+    void deallocate (Type* object) noexcept
+    {
+        if (object == nullptr)
+            return;
+
+        jassert (numAllocated > 0);
+        auto* slot = reinterpret_cast<Slot*> (object);
+        slot->next = freeList;
+        freeList = slot;
+        --numAllocated;
+    }
+
+    /** Creates an object in the pool, passing the given arguments to its constructor. */
+    template <typename... Args>
+    Type* create (Args&&... args)
+    {
+        auto* storage = allocate();
+
+        try
+        {
+            return new (storage) Type (std::forward<Args> (args)...);
+        }
+        catch (...)
+        {
+            deallocate (storage);
+            throw;
+        }
+    }
+
+    /** Destroys an object that was made with create(), and returns its storage to the pool. */
+    void destroy (Type* object) noexcept
+    {
+        if (object != nullptr)
+        {
+            object->~Type();
+            deallocate (object);
+        }
+    }
+
+    /** Returns the number of objects that are currently allocated from the pool. */
+    int getNumAllocated() const noexcept     { return numAllocated; }
+
+    /** Returns the number of objects that the pool could hold without allocating more memory. */
+    int getCapacity() const noexcept         { return chunks.size() * itemsPerChunk; }
+
+private:
+    //==============================================================================
+    static_assert (itemsPerChunk > 0, "A pool needs at least one item per chunk");
+
+    union Slot
+    {
+        Slot* next;
+        alignas (Type) char storage[sizeof (Type)];
+    };
+
+    void addChunk()
+    {
+        auto* chunk = chunks.add (new Chunk());
+
+        for (int i = itemsPerChunk; --i >= 0;)
+        {
+            chunk->slots[i].next = freeList;
+            freeList = chunk->slots + i;
+        }
+    }
+
+    struct Chunk
+    {
+        Slot slots[(size_t) itemsPerChunk];
+    };
+
+    OwnedArray<Chunk> chunks;
+    Slot* freeList = nullptr;
+    int numAllocated = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (PoolAllocator)
+};
+
+} // namespace juce
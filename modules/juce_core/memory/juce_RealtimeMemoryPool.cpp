@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+// Each size class keeps its free blocks in a lock-free stack of indices. The head holds
+// the index of the top block plus one (so that zero can mean "empty") in its low 32 bits,
+// and a counter in the high bits which changes on every update, to avoid the ABA problem.
+struct RealtimeMemoryPool::SizeClass
+{
+    SizeClass (char* startOfBlocks, size_t sizeOfEachBlock, uint32 numberOfBlocks)
+        : start (startOfBlocks),
+          blockSize (sizeOfEachBlock),
+          numBlocks (numberOfBlocks),
+          nextIndices (new std::atomic<uint32>[numberOfBlocks])
+    {
+        for (uint32 i = 0; i < numBlocks; ++i)
+            nextIndices[i].store (i + 1 < numBlocks ? i + 2 : 0, std::memory_order_relaxed);
+
+        head->store (numBlocks > 0 ? 1 : 0, std::memory_order_release);
+    }
+
+    bool contains (const void* block) const noexcept
+    {
+        auto* p = static_cast<const char*> (block);
+        return p >= start && p < start + blockSize * numBlocks;
+    }
+
+    uint32 getIndexOf (const void* block) const noexcept
+    {
+        auto offset = (size_t) (static_cast<const char*> (block) - start);
+        jassert (offset % blockSize == 0); // this isn't the start of a block!
+        return (uint32) (offset / blockSize);
+    }
+
+    void* getBlock (uint32 index) const noexcept    { return start + blockSize * index; }
+
+    bool pop (uint32& index) noexcept
+    {
+        auto oldHead = head->load (std::memory_order_acquire);
+
+        for (;;)
+        {
+            auto top = (uint32) oldHead;
+
+            if (top == 0)
+                return false;
+
+            auto newHead = (((oldHead >> 32) + 1) << 32) | nextIndices[top - 1].load (std::memory_order_relaxed);
+
+            if (head->compare_exchange_weak (oldHead, newHead, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                index = top - 1;
+                return true;
+            }
+        }
+    }
+
+    void push (uint32 index) noexcept
+    {
+        auto oldHead = head->load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            nextIndices[index].store ((uint32) oldHead, std::memory_order_relaxed);
+            auto newHead = (((oldHead >> 32) + 1) << 32) | (uint64) (index + 1);
+
+            if (head->compare_exchange_weak (oldHead, newHead, std::memory_order_release, std::memory_order_relaxed))
+                return;
+        }
+    }
+
+    char* const start;
+    const size_t blockSize;
+    const uint32 numBlocks;
+    std::unique_ptr<std::atomic<uint32>[]> nextIndices;
+    CacheLinePadded<std::atomic<uint64>> head;
+
+    JUCE_DECLARE_NON_COPYABLE (SizeClass)
+};
+
+//==============================================================================
+static constexpr size_t smallestPoolBlockSize = 16;
+
+RealtimeMemoryPool::RealtimeMemoryPool (size_t largestBlockSize, int numBlocksPerSizeClass)
+{
+    jassert (numBlocksPerSizeClass > 0);
+    auto numBlocks = (uint32) jmax (0, numBlocksPerSizeClass);
+
+    for (auto size = smallestPoolBlockSize;; size *= 2)
+    {
+        storageSize += size * numBlocks;
+
+        if (size >= largestBlockSize)
+            break;
+    }
+
+    storage.malloc (storageSize);
+    auto* start = storage.get();
+
+    for (auto size = smallestPoolBlockSize; start < storage.get() + storageSize; size *= 2)
+    {
+        sizeClasses.add (new SizeClass (start, size, numBlocks));
+        start += size * numBlocks;
+    }
+}
+
+RealtimeMemoryPool::~RealtimeMemoryPool()
+{
+    // Everything that was allocated from the pool should have been given back before it's deleted!
+    jassert (usage->numBytesInUse.load() == 0);
+}
+
+int RealtimeMemoryPool::getSizeClassIndexForSize (size_t numBytes) const noexcept
+{
+    int index = 0;
+
+    for (auto size = smallestPoolBlockSize; size < numBytes; size *= 2)
+        ++index;
+
+    return index < sizeClasses.size() ? index : -1;
+}
+
+int RealtimeMemoryPool::getSizeClassIndexForBlock (const void* block) const noexcept
+{
+    for (int i = 0; i < sizeClasses.size(); ++i)
+        if (sizeClasses.getUnchecked (i)->contains (block))
+            return i;
+
+    return -1;
+}
+
+void* RealtimeMemoryPool::allocateFromSizeClass (int index) noexcept
+{
+    if (index >= 0)
+    {
+        auto& sizeClass = *sizeClasses.getUnchecked (index);
+        uint32 blockIndex;
+
+        if (sizeClass.pop (blockIndex))
+        {
+            recordAllocation (sizeClass.blockSize);
+            return sizeClass.getBlock (blockIndex);
+        }
+    }
+
+    recordFailure();
+    return nullptr;
+}
+
+void* RealtimeMemoryPool::allocate (size_t numBytes) noexcept
+{
+    return allocateFromSizeClass (getSizeClassIndexForSize (numBytes));
+}
+
+void RealtimeMemoryPool::deallocate (void* block) noexcept
+{
+    if (block == nullptr)
+        return;
+
+    auto index = getSizeClassIndexForBlock (block);
+
+    // This block didn't come from this pool!
+    jassert (index >= 0);
+
+    if (index >= 0)
+    {
+        auto& sizeClass = *sizeClasses.getUnchecked (index);
+        sizeClass.push (sizeClass.getIndexOf (block));
+        recordDeallocation (sizeClass.blockSize);
+    }
+}
+
+bool RealtimeMemoryPool::owns (const void* block) const noexcept
+{
+    auto* p = static_cast<const char*> (block);
+    return p >= storage.get() && p < storage.get() + storageSize;
+}
+
+size_t RealtimeMemoryPool::getLargestBlockSize() const noexcept
+{
+    return sizeClasses.getLast()->blockSize;
+}
+
+//==============================================================================
+void RealtimeMemoryPool::recordAllocation (size_t numBytes) noexcept
+{
+    auto newTotal = usage->numBytesInUse.fetch_add (numBytes, std::memory_order_relaxed) + numBytes;
+    auto peak = usage->peakNumBytesInUse.load (std::memory_order_relaxed);
+
+    while (newTotal > peak && ! usage->peakNumBytesInUse.compare_exchange_weak (peak, newTotal, std::memory_order_relaxed))
+    {}
+}
+
+void RealtimeMemoryPool::recordFailure() noexcept
+{
+    numFailedAllocations.increment();
+}
+
+void RealtimeMemoryPool::recordDeallocation (size_t numBytes) noexcept
+{
+    usage->numBytesInUse.fetch_sub (numBytes, std::memory_order_relaxed);
+}
+
+RealtimeMemoryPool::Statistics RealtimeMemoryPool::getStatistics() const noexcept
+{
+    Statistics s;
+    s.numBytesInUse = usage->numBytesInUse.load (std::memory_order_relaxed);
+    s.peakNumBytesInUse = usage->peakNumBytesInUse.load (std::memory_order_relaxed);
+    s.numBytesReserved = storageSize;
+    s.numFailedAllocations = (int) numFailedAllocations.get();
+    return s;
+}
+
+void RealtimeMemoryPool::resetStatistics() noexcept
+{
+    usage->peakNumBytesInUse.store (usage->numBytesInUse.load (std::memory_order_relaxed), std::memory_order_relaxed);
+    numFailedAllocations.reset();
+}
+
+//==============================================================================
+RealtimeMemoryPool::ThreadCache::ThreadCache (RealtimeMemoryPool& p)
+    : pool (p), bins ((size_t) p.sizeClasses.size())
+{
+}
+
+RealtimeMemoryPool::ThreadCache::~ThreadCache()
+{
+    for (size_t i = 0; i < bins.size(); ++i)
+        for (int j = 0; j < bins[i].numIndices; ++j)
+            pool.sizeClasses.getUnchecked ((int) i)->push (bins[i].indices[j]);
+}
+
+void* RealtimeMemoryPool::ThreadCache::allocate (size_t numBytes) noexcept
+{
+    auto index = pool.getSizeClassIndexForSize (numBytes);
+
+    if (index < 0)
+        return pool.allocateFromSizeClass (index);
+
+    auto& bin = bins[(size_t) index];
+    auto& sizeClass = *pool.sizeClasses.getUnchecked (index);
+
+    if (bin.numIndices == 0)
+    {
+        while (bin.numIndices < batchSize && sizeClass.pop (bin.indices[bin.numIndices]))
+            ++bin.numIndices;
+
+        if (bin.numIndices == 0)
+        {
+            pool.recordFailure();
+            return nullptr;
+        }
+    }
+
+    pool.recordAllocation (sizeClass.blockSize);
+    return sizeClass.getBlock (bin.indices[--bin.numIndices]);
+}
+
+void RealtimeMemoryPool::ThreadCache::deallocate (void* block) noexcept
+{
+    if (block == nullptr)
+        return;
+
+    auto index = pool.getSizeClassIndexForBlock (block);
+
+    // This block didn't come from this cache's pool!
+    jassert (index >= 0);
+
+    if (index < 0)
+        return;
+
+    auto& bin = bins[(size_t) index];
+    auto& sizeClass = *pool.sizeClasses.getUnchecked (index);
+
+    if (bin.numIndices == capacity)
+        while (bin.numIndices > capacity - batchSize)
+            sizeClass.push (bin.indices[--bin.numIndices]);
+
+    bin.indices[bin.numIndices++] = sizeClass.getIndexOf (block);
+    pool.recordDeallocation (sizeClass.blockSize);
+}
+
+} // namespace juce
@@ -0,0 +1,296 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A preallocated, lock-free memory pool that can be used safely on a realtime thread.
+
+    All the pool's memory is allocated up-front by the constructor, and is divided into
+    a set of size classes, each of which holds a fixed number of blocks. The smallest
+    class holds 16-byte blocks, and each class after that holds blocks twice as big as
+    the one before, up to the largest block size you ask for.
+
+    allocate() and deallocate() never lock, never call the system allocator, and can be
+    called from any number of threads at once, so they're safe to use in places like
+    AudioProcessor::processBlock() for things like voice objects, sysex data or events,
+    which genuinely need some dynamic memory. If a request can't be satisfied, allocate()
+    just returns nullptr, and the failure is counted in the pool's statistics, so you can
+    see whether the pool needs to be made bigger.
+
+    A thread that makes lots of allocations can also use a ThreadCache, which keeps a
+    few blocks of each size to itself, so that most of its allocations don't have to
+    touch the shared free lists at all.
+
+    @see RealtimePoolAllocator, PooledHeapBlock
+
+    @tags{Core}
+*/
+class JUCE_API  RealtimeMemoryPool
+{
+public:
+    //==============================================================================
+    /** Creates a pool, and allocates all of its memory.
+
+        @param largestBlockSize         the largest allocation that the pool will be able
+                                        to satisfy. This is rounded up to a power of two.
+        @param numBlocksPerSizeClass    the number of blocks of each size to create
+    */
+    RealtimeMemoryPool (size_t largestBlockSize, int numBlocksPerSizeClass);
+
+    /** Destructor.
+        Everything that was allocated from the pool must have been returned to it first.
+    */
+    ~RealtimeMemoryPool();
+
+    //==============================================================================
+    /** Returns a block of memory that's at least the given size, or nullptr if the
+        size is too big for the pool, or all the suitable blocks are in use.
+
+        The memory is aligned to at least 16 bytes. This is lock-free and wait-free
+        in the absence of contention.
+    */
+    void* allocate (size_t numBytes) noexcept;
+
+    /** Returns a block that was obtained from allocate() to the pool.
+        Passing nullptr is harmless.
+    */
+    void deallocate (void* block) noexcept;
+
+    /** Returns true if the given pointer is inside the memory that this pool manages. */
+    bool owns (const void* block) const noexcept;
+
+    /** Returns the size of the largest block that the pool can hand out. */
+    size_t getLargestBlockSize() const noexcept;
+
+    //==============================================================================
+    /** Some usage figures for a pool. */
+    struct Statistics
+    {
+        size_t numBytesInUse = 0;       /**< The total size of the blocks that are currently allocated. */
+        size_t peakNumBytesInUse = 0;   /**< The highest value that numBytesInUse has reached. */
+        size_t numBytesReserved = 0;    /**< The total size of all the blocks in the pool. */
+        int numFailedAllocations = 0;   /**< The number of calls to allocate() that returned nullptr. */
+    };
+
+    /** Returns the pool's current usage statistics. */
+    Statistics getStatistics() const noexcept;
+
+    /** Resets the peak usage to the current usage, and clears the failure count. */
+    void resetStatistics() noexcept;
+
+    //==============================================================================
+    /**
+        A cache of blocks that belongs to a single thread.
+
+        Create one of these for a thread that allocates a lot (e.g. in your audio
+        callback's prepareToPlay()), and use its allocate() and deallocate() methods
+        from that thread instead of the pool's. Blocks are moved between the cache and
+        the pool in batches, which means far fewer operations on the shared free lists.
+
+        Blocks may be freed through a different cache, or directly to the pool, to the
+        one that allocated them. When the cache is deleted, any blocks that it's holding
+        are returned to the pool.
+
+        A ThreadCache must only be used by one thread at a time, and must be deleted
+        before its pool.
+    */
+    class JUCE_API  ThreadCache
+    {
+    public:
+        /** Creates a cache for a pool. This allocates, so don't do it on a realtime thread. */
+        explicit ThreadCache (RealtimeMemoryPool& pool);
+
+        /** Destructor. Returns all the cached blocks to the pool. */
+        ~ThreadCache();
+
+        /** Like RealtimeMemoryPool::allocate(), but uses the cache first. */
+        void* allocate (size_t numBytes) noexcept;
+
+        /** Like RealtimeMemoryPool::deallocate(), but returns the block to the cache. */
+        void deallocate (void* block) noexcept;
+
+    private:
+        static constexpr int capacity = 16, batchSize = capacity / 2;
+
+        struct Bin
+        {
+            uint32 indices[capacity];
+            int numIndices = 0;
+        };
+
+        RealtimeMemoryPool& pool;
+        std::vector<Bin> bins;
+
+        JUCE_DECLARE_NON_COPYABLE (ThreadCache)
+    };
+
+private:
+    //==============================================================================
+    struct SizeClass;
+    OwnedArray<SizeClass> sizeClasses;
+    HeapBlock<char> storage;
+    size_t storageSize = 0;
+
+    // These are written by every thread that uses the pool, so they're kept
+    // off the cache lines that hold the members above
+    struct Usage
+    {
+        std::atomic<size_t> numBytesInUse { 0 }, peakNumBytesInUse { 0 };
+    };
+
+    CacheLinePadded<Usage> usage;
+    ShardedCounter numFailedAllocations;
+
+    int getSizeClassIndexForSize (size_t) const noexcept;
+    int getSizeClassIndexForBlock (const void*) const noexcept;
+    void* allocateFromSizeClass (int) noexcept;
+    void recordAllocation (size_t) noexcept;
+    void recordFailure() noexcept;
+    void recordDeallocation (size_t) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (RealtimeMemoryPool)
+};
+
+//==============================================================================
+/**
+    A standard-library-compatible allocator that takes its memory from a RealtimeMemoryPool.
+
+    This lets you use std containers on a realtime thread, as long as their allocations
+    fit in the pool. Because a std allocator isn't allowed to return nullptr, allocate()
+    throws std::bad_alloc if the pool is exhausted, so make sure the pool is big enough,
+    e.g. by keeping an eye on its statistics while testing.
+
+    @see RealtimeMemoryPool
+
+    @tags{Core}
+*/
+template <typename Type>
+class RealtimePoolAllocator
+{
+public:
+    using value_type = Type;
+
+    /** Creates an allocator that uses the given pool. */
+    RealtimePoolAllocator (RealtimeMemoryPool& poolToUse) noexcept  : pool (&poolToUse) {}
+
+    /** Creates a copy of an allocator for a different type, which will use the same pool. */
+    template <typename OtherType>
+    RealtimePoolAllocator (const RealtimePoolAllocator<OtherType>& other) noexcept  : pool (other.getPool()) {}
+
+    /** Allocates space for the given number of objects. */
+    Type* allocate (size_t numObjects)
+    {
+        static_assert (alignof (Type) <= 16, "The pool's blocks are only guaranteed to be 16-byte aligned");
+
+        if (auto* block = pool->allocate (numObjects * sizeof (Type)))
+            return static_cast<Type*> (block);
+
+        throw std::bad_alloc();
+    }
+
+    /** Returns some space to the pool. */
+    void deallocate (Type* objects, size_t) noexcept    { pool->deallocate (objects); }
+
+    /** Returns the pool that this allocator uses. */
+    RealtimeMemoryPool* getPool() const noexcept        { return pool; }
+
+    template <typename OtherType>
+    bool operator== (const RealtimePoolAllocator<OtherType>& other) const noexcept   { return pool == other.getPool(); }
+
+    template <typename OtherType>
+    bool operator!= (const RealtimePoolAllocator<OtherType>& other) const noexcept   { return pool != other.getPool(); }
+
+private:
+    RealtimeMemoryPool* pool;
+};
+
+//==============================================================================
+/**
+    A HeapBlock-style holder for some memory that comes from a RealtimeMemoryPool.
+
+    This works in the same way as HeapBlock, except that its memory comes from a pool,
+    so it can be allocated and freed on a realtime thread. Because the pool can run out,
+    the allocation methods return false if they fail, leaving the block empty.
+
+    @see RealtimeMemoryPool, HeapBlock
+
+    @tags{Core}
+*/
+template <typename ElementType>
+class PooledHeapBlock
+{
+public:
+    /** Creates an empty block, which will take its memory from the given pool. */
+    explicit PooledHeapBlock (RealtimeMemoryPool& poolToUse) noexcept  : pool (poolToUse) {}
+
+    /** Destructor. Returns the memory to the pool. */
+    ~PooledHeapBlock()                                  { free(); }
+
+    /** Allocates space for some elements, freeing any previous data.
+        The contents of the new block are undefined. Returns false if the pool couldn't
+        provide the memory.
+    */
+    bool malloc (size_t numElements) noexcept
+    {
+        free();
+        data = static_cast<ElementType*> (pool.allocate (numElements * sizeof (ElementType)));
+        return data != nullptr || numElements == 0;
+    }
+
+    /** Like malloc(), but clears the memory that it allocates. */
+    bool calloc (size_t numElements) noexcept
+    {
+        if (! malloc (numElements))
+            return false;
+
+        zeromem (data, numElements * sizeof (ElementType));
+        return true;
+    }
+
+    /** Returns the memory to the pool, and resets this object to a null pointer. */
+    void free() noexcept
+    {
+        pool.deallocate (data);
+        data = nullptr;
+    }
+
+    /** Returns a raw pointer to the allocated data. */
+    ElementType* get() const noexcept                   { return data; }
+
+    /** Returns a raw pointer to the allocated data. */
+    operator ElementType*() const noexcept              { return data; }
+
+    /** Returns a reference to one of the data elements. */
+    template <typename IndexType>
+    ElementType& operator[] (IndexType index) const noexcept    { return data[index]; }
+
+private:
+    RealtimeMemoryPool& pool;
+    ElementType* data = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (PooledHeapBlock)
+};
+
+} // namespace juce
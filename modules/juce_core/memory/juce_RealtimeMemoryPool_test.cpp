@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class RealtimeMemoryPoolTests  : public UnitTest
+{
+public:
+    RealtimeMemoryPoolTests()
+        : UnitTest ("RealtimeMemoryPool", UnitTestCategories::memory)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Allocations use the smallest suitable size class");
+        {
+            RealtimeMemoryPool pool (1000, 4);
+            expectEquals ((int) pool.getLargestBlockSize(), 1024);
+
+            auto* a = pool.allocate (1);
+            auto* b = pool.allocate (17);
+            auto* c = pool.allocate (1024);
+
+            expect (a != nullptr && b != nullptr && c != nullptr);
+            expect (pool.owns (a) && pool.owns (b) && pool.owns (c));
+            expect (((pointer_sized_uint) a & 15) == 0 && ((pointer_sized_uint) b & 15) == 0);
+            expectEquals ((int) pool.getStatistics().numBytesInUse, 16 + 32 + 1024);
+
+            expect (pool.allocate (1025) == nullptr);
+            expectEquals (pool.getStatistics().numFailedAllocations, 1);
+
+            pool.deallocate (a);
+            pool.deallocate (b);
+            pool.deallocate (c);
+            pool.deallocate (nullptr);
+
+            auto stats = pool.getStatistics();
+            expectEquals ((int) stats.numBytesInUse, 0);
+            expectEquals ((int) stats.peakNumBytesInUse, 16 + 32 + 1024);
+
+            pool.resetStatistics();
+            expectEquals ((int) pool.getStatistics().peakNumBytesInUse, 0);
+            expectEquals (pool.getStatistics().numFailedAllocations, 0);
+        }
+
+        beginTest ("Exhausted size classes fail, and recover when blocks are freed");
+        {
+            RealtimeMemoryPool pool (64, 3);
+            std::vector<void*> blocks;
+
+            for (int i = 0; i < 3; ++i)
+                blocks.push_back (pool.allocate (64));
+
+            expect (std::set<void*> (blocks.begin(), blocks.end()).size() == 3);
+            expect (pool.allocate (64) == nullptr);
+
+            auto* small = pool.allocate (16);
+            expect (small != nullptr);
+            pool.deallocate (small);
+            pool.deallocate (blocks[1]);
+            blocks[1] = pool.allocate (50);
+            expect (blocks[1] != nullptr);
+
+            for (auto* b : blocks)
+                pool.deallocate (b);
+        }
+
+        beginTest ("ThreadCache");
+        {
+            RealtimeMemoryPool pool (256, 40);
+
+            {
+                RealtimeMemoryPool::ThreadCache cache (pool);
+                std::vector<void*> blocks;
+
+                for (int i = 0; i < 40; ++i)
+                    blocks.push_back (cache.allocate (200));
+
+                expect (std::find (blocks.begin(), blocks.end(), nullptr) == blocks.end());
+                expect (cache.allocate (200) == nullptr);
+
+                for (auto* b : blocks)
+                    cache.deallocate (b);
+
+                expectEquals ((int) pool.getStatistics().numBytesInUse, 0);
+            }
+
+            std::vector<void*> blocks;
+
+            for (int i = 0; i < 40; ++i)
+                blocks.push_back (pool.allocate (200));
+
+            expect (std::find (blocks.begin(), blocks.end(), nullptr) == blocks.end());
+
+            for (auto* b : blocks)
+                pool.deallocate (b);
+        }
+
+        beginTest ("Concurrent use");
+        {
+            RealtimeMemoryPool pool (128, 256);
+            std::atomic<int> numErrors { 0 };
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < 4; ++t)
+            {
+                threads.emplace_back ([&pool, &numErrors, t]
+                {
+                    RealtimeMemoryPool::ThreadCache cache (pool);
+                    Random r (t);
+
+                    for (int i = 0; i < 2000; ++i)
+                    {
+                        uint8* blocks[16];
+
+                        for (auto*& b : blocks)
+                        {
+                            auto size = (size_t) r.nextInt ({ 1, 129 });
+                            b = static_cast<uint8*> (t % 2 == 0 ? cache.allocate (size) : pool.allocate (size));
+
+                            if (b == nullptr)
+                                ++numErrors;
+                            else
+                                *b = (uint8) t;
+                        }
+
+                        for (auto* b : blocks)
+                        {
+                            if (b == nullptr)
+                                continue;
+
+                            if (*b != (uint8) t)
+                                ++numErrors;
+
+                            if (t % 2 == 0)
+                                cache.deallocate (b);
+                            else
+                                pool.deallocate (b);
+                        }
+                    }
+                });
+            }
+
+            for (auto& t : threads)
+                t.join();
+
+            expectEquals (numErrors.load(), 0);
+            expectEquals ((int) pool.getStatistics().numBytesInUse, 0);
+        }
+
+        beginTest ("Adapters");
+        {
+            RealtimeMemoryPool pool (4096, 8);
+
+            {
+                std::vector<float, RealtimePoolAllocator<float>> v { RealtimePoolAllocator<float> (pool) };
+
+                for (int i = 0; i < 500; ++i)
+                    v.push_back ((float) i);
+
+                expectEquals (v[499], 499.0f);
+                expect (pool.getStatistics().numBytesInUse > 0);
+            }
+
+            {
+                PooledHeapBlock<int> block (pool);
+                expect (block.calloc (100));
+                expectEquals (block[99], 0);
+                expect (pool.owns (block.get()));
+                expect (! block.malloc (100000));
+                expect (block.get() == nullptr);
+            }
+
+            expectEquals ((int) pool.getStatistics().numBytesInUse, 0);
+        }
+    }
+};
+
+static RealtimeMemoryPoolTests realtimeMemoryPoolTests;
+
+} // namespace juce
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ShardedCounter::ShardedCounter()  : ShardedCounter (SystemStats::getNumCpus()) {}
+
+ShardedCounter::ShardedCounter (int numShards)
+    : mask ((uint32) nextPowerOfTwo (jmax (1, numShards)) - 1)
+{
+    shards = std::make_unique<CacheLinePadded<std::atomic<int64>>[]> (mask + 1);
+}
+
+int64 ShardedCounter::get() const noexcept
+{
+    int64 total = 0;
+
+    for (uint32 i = 0; i <= mask; ++i)
+        total += shards[i]->load (std::memory_order_relaxed);
+
+    return total;
+}
+
+void ShardedCounter::reset() noexcept
+{
+    for (uint32 i = 0; i <= mask; ++i)
+        shards[i]->store (0, std::memory_order_relaxed);
+}
+
+} // namespace juce
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A counter that can be incremented very cheaply from many threads at once.
+
+    An ordinary std::atomic counter which is updated from several threads forces its
+    cache line to move between all of their cores on every update. This class splits
+    the count into several shards, each on its own cache line, and each thread adds to
+    a different shard, so the threads don't interfere with each other. Reading the
+    total means adding up all the shards, which makes get() slower than it would be
+    for a single atomic, so this is a good fit for statistics such as event or error
+    counts, which are written often but only read occasionally, e.g. by a UI timer.
+
+    add() is lock-free and wait-free, so it's safe to call on a realtime thread.
+
+    @see CacheLinePadded
+
+    @tags{Core}
+*/
+class JUCE_API  ShardedCounter
+{
+public:
+    /** Creates a counter with one shard for each CPU, rounded up to a power of two. */
+    ShardedCounter();
+
+    /** Creates a counter with a given number of shards, rounded up to a power of two. */
+    explicit ShardedCounter (int numShards);
+
+    /** Adds a value to the counter. */
+    void add (int64 delta) noexcept
+    {
+        shards[getIndexForCurrentThread() & mask]->fetch_add (delta, std::memory_order_relaxed);
+    }
+
+    /** Adds one to the counter. */
+    void increment() noexcept                   { add (1); }
+
+    /** Returns the counter's total value.
+        If other threads are adding to the counter at the same time, this may or may
+        not include their latest updates.
+    */
+    int64 get() const noexcept;
+
+    /** Sets the counter back to zero.
+        Any updates that other threads make while this is happening may be lost.
+    */
+    void reset() noexcept;
+
+    /** Returns the number of shards the counter uses. */
+    int getNumShards() const noexcept           { return (int) mask + 1; }
+
+private:
+    //==============================================================================
+    std::unique_ptr<CacheLinePadded<std::atomic<int64>>[]> shards;
+    uint32 mask;
+
+    static uint32 getIndexForCurrentThread() noexcept
+    {
+        // Threads are given consecutive indices as they first use a counter, so that
+        // the first few threads are guaranteed to use different shards
+        static std::atomic<uint32> nextIndex { 0 };
+        static thread_local const uint32 index = nextIndex.fetch_add (1, std::memory_order_relaxed);
+        return index;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ShardedCounter)
+};
+
+} // namespace juce
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ShardedCounterTests  : public UnitTest
+{
+public:
+    ShardedCounterTests()
+        : UnitTest ("ShardedCounter", UnitTestCategories::memory)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("CacheLinePadded objects don't share cache lines");
+        {
+            CacheLinePadded<std::atomic<int>> counters[2] { CacheLinePadded<std::atomic<int>> (1), CacheLinePadded<std::atomic<int>> (2) };
+
+            expect (sizeof (counters[0]) == hardwareDestructiveInterferenceSize);
+            expect (((pointer_sized_uint) &counters[1].get() & (hardwareDestructiveInterferenceSize - 1)) == 0);
+            expectEquals (counters[0]->load() + counters[1]->load(), 3);
+        }
+
+        beginTest ("Counts are summed across shards");
+        {
+            ShardedCounter counter (3);
+            expectEquals (counter.getNumShards(), 4);
+
+            counter.add (10);
+            counter.increment();
+            expectEquals (counter.get(), (int64) 11);
+
+            counter.reset();
+            expectEquals (counter.get(), (int64) 0);
+        }
+
+        beginTest ("Concurrent increments aren't lost");
+        {
+            ShardedCounter counter;
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < 4; ++t)
+                threads.emplace_back ([&counter]
+                {
+                    for (int i = 0; i < 100000; ++i)
+                        counter.increment();
+                });
+
+            for (auto& t : threads)
+                t.join();
+
+            expectEquals (counter.get(), (int64) 400000);
+        }
+    }
+};
+
+static ShardedCounterTests shardedCounterTests;
+
+} // namespace juce
@@ -68,6 +68,7 @@
  #include <objc/objc.h>
  #include <objc/message.h>
  #include <poll.h>
+ #include <sys/event.h>
 
 //==============================================================================
 #elif JUCE_WINDOWS
@@ -211,6 +212,8 @@
  #include <sys/wait.h>
  #include <sys/timerfd.h>
  #include <sys/eventfd.h>
+ #include <sys/epoll.h>
+ #include <linux/futex.h>
  #include <utime.h>
  #include <poll.h>
 
@@ -245,6 +248,7 @@
  #include <sys/types.h>
  #include <sys/user.h>
  #include <sys/wait.h>
+ #include <sys/event.h>
  #include <utime.h>
  #include <poll.h>
 
@@ -269,6 +273,7 @@
  #include <sys/wait.h>
  #include <sys/timerfd.h>
  #include <sys/eventfd.h>
+ #include <sys/epoll.h>
  #include <android/api-level.h>
  #include <poll.h>
 
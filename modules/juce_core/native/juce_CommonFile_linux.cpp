@@ -73,8 +73,7 @@ class DirectoryIterator::NativeIterator::Pimpl
 {
 public:
     Pimpl (const File& directory, const String& wc)
-        : parentDir (File::addTrailingSeparator (directory.getFullPathName())),
-          wildCard (wc), dir (opendir (directory.getFullPathName().toUTF8()))
+        : wildCard (wc), dir (opendir (directory.getFullPathName().toUTF8()))
     {
     }
 
@@ -105,8 +104,7 @@ public:
                 if (fnmatch (wildcardUTF8, de->d_name, FNM_CASEFOLD) == 0)
                 {
                     filenameFound = CharPointer_UTF8 (de->d_name);
-
-                    updateStatInfoForFile (parentDir + filenameFound, isDir, fileSize, modTime, creationTime, isReadOnly);
+                    getInfo (*de, isDir, fileSize, modTime, creationTime, isReadOnly);
 
                     if (isHidden != nullptr)
                         *isHidden = filenameFound.startsWithChar ('.');
@@ -120,9 +118,39 @@ public:
     }
 
 private:
-    String parentDir, wildCard;
+    String wildCard;
     DIR* dir;
 
+    // The entry's type usually comes with its name, so it's only stat'ed if something else is
+    // needed, and then relative to the directory, which saves looking up the whole path again
+    void getInfo (const struct dirent& de, bool* isDir, int64* fileSize,
+                  Time* modTime, Time* creationTime, bool* isReadOnly) const
+    {
+        const auto typeIsKnown = de.d_type != DT_UNKNOWN && de.d_type != DT_LNK;
+
+        if (fileSize != nullptr || modTime != nullptr || creationTime != nullptr || (isDir != nullptr && ! typeIsKnown))
+        {
+            juce_statStruct info;
+           #if JUCE_LINUX
+            const auto statOk = fstatat64 (dirfd (dir), de.d_name, &info, 0) == 0;
+           #else
+            const auto statOk = fstatat (dirfd (dir), de.d_name, &info, 0) == 0;
+           #endif
+
+            if (isDir != nullptr)         *isDir        = statOk && ((info.st_mode & S_IFDIR) != 0);
+            if (fileSize != nullptr)      *fileSize     = statOk ? (int64) info.st_size : 0;
+            if (modTime != nullptr)       *modTime      = Time (statOk ? (int64) info.st_mtime  * 1000 : 0);
+            if (creationTime != nullptr)  *creationTime = Time (statOk ? getCreationTime (info) * 1000 : 0);
+        }
+        else if (isDir != nullptr)
+        {
+            *isDir = de.d_type == DT_DIR;
+        }
+
+        if (isReadOnly != nullptr)
+            *isReadOnly = faccessat (dirfd (dir), de.d_name, W_OK, 0) != 0;
+    }
+
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
 
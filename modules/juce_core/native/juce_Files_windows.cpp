@@ -381,11 +381,31 @@ int64 juce_fileSetPosition (void* handle, int64 pos)
     return li.QuadPart;
 }
 
+void juce_adviseSequentialMemoryAccess (const void*, size_t) noexcept {}
+
 void FileInputStream::openHandle()
 {
-    auto h = CreateFile (file.getFullPathName().toWideCharPointer(),
-                         GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
-                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "FileInputStream::openHandle");
+
+    auto openWithFlags = [this] (DWORD flags)
+    {
+        return CreateFile (file.getFullPathName().toWideCharPointer(),
+                           GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN | flags, nullptr);
+    };
+
+    auto h = INVALID_HANDLE_VALUE;
+
+    if (readMode == ReadMode::uncached)
+    {
+        h = openWithFlags (FILE_FLAG_NO_BUFFERING);
+
+        if (h == INVALID_HANDLE_VALUE)
+            readMode = ReadMode::sequential;
+    }
+
+    if (h == INVALID_HANDLE_VALUE)
+        h = openWithFlags (0);
 
     if (h != INVALID_HANDLE_VALUE)
         fileHandle = (void*) h;
@@ -395,11 +415,14 @@ void FileInputStream::openHandle()
 
 FileInputStream::~FileInputStream()
 {
-    CloseHandle ((HANDLE) fileHandle);
+    if (fileHandle != nullptr)
+        CloseHandle ((HANDLE) fileHandle);
 }
 
 size_t FileInputStream::readInternal (void* buffer, size_t numBytes)
 {
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "FileInputStream::read");
+
     if (fileHandle != nullptr)
     {
         DWORD actualNum = 0;
@@ -416,6 +439,8 @@ size_t FileInputStream::readInternal (void* buffer, size_t numBytes)
 //==============================================================================
 void FileOutputStream::openHandle()
 {
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "FileOutputStream::openHandle");
+
     auto h = CreateFile (file.getFullPathName().toWideCharPointer(),
                          GENERIC_WRITE, FILE_SHARE_READ, nullptr,
                          OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
@@ -444,6 +469,8 @@ void FileOutputStream::closeHandle()
 
 ssize_t FileOutputStream::writeInternal (const void* bufferToWrite, size_t numBytes)
 {
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "FileOutputStream::write");
+
     DWORD actualNum = 0;
 
     if (fileHandle != nullptr)
@@ -455,6 +482,8 @@ ssize_t FileOutputStream::writeInternal (const void* bufferToWrite, size_t numBy
 
 void FileOutputStream::flushInternal()
 {
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "FileOutputStream::flush");
+
     if (fileHandle != nullptr)
         if (! FlushFileBuffers ((HANDLE) fileHandle))
             status = WindowsFileHelpers::getResultForLastError();
@@ -994,7 +1023,10 @@ public:
 
         if (handle == INVALID_HANDLE_VALUE)
         {
-            handle = FindFirstFile (directoryWithWildCard.toWideCharPointer(), &findData);
+            // the basic info level skips the short 8.3 names, and a large fetch asks for bigger
+            // batches of entries at a time, which makes a big difference on network drives
+            handle = FindFirstFileEx (directoryWithWildCard.toWideCharPointer(), FindExInfoBasic, &findData,
+                                      FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
 
             if (handle == INVALID_HANDLE_VALUE)
                 return false;
@@ -28,6 +28,7 @@ struct CURLSymbols
     CURL* (*curl_easy_init) (void);
     CURLcode (*curl_easy_setopt) (CURL *curl, CURLoption option, ...);
     void (*curl_easy_cleanup) (CURL *curl);
+    void (*curl_easy_reset) (CURL *curl);
     CURLcode (*curl_easy_getinfo) (CURL *curl, CURLINFO info, ...);
     CURLMcode (*curl_multi_add_handle) (CURLM *multi_handle, CURL *curl_handle);
     CURLMcode (*curl_multi_cleanup) (CURLM *multi_handle);
@@ -55,6 +56,7 @@ struct CURLSymbols
         JUCE_INIT_CURL_SYMBOL (curl_easy_init)
         JUCE_INIT_CURL_SYMBOL (curl_easy_setopt)
         JUCE_INIT_CURL_SYMBOL (curl_easy_cleanup)
+        JUCE_INIT_CURL_SYMBOL (curl_easy_reset)
         JUCE_INIT_CURL_SYMBOL (curl_easy_getinfo)
         JUCE_INIT_CURL_SYMBOL (curl_multi_add_handle)
         JUCE_INIT_CURL_SYMBOL (curl_multi_cleanup)
@@ -107,6 +109,103 @@ private:
    #endif
 };
 
+//==============================================================================
+/*  Each stream drives its own multi handle, and the multi handle owns the connection
+    cache. Rather than throwing that away when a request has finished, the handles are
+    kept here so that the next request to the same server can pick up the connection
+    (and TLS session) that is still open, instead of setting up a new one.
+*/
+class CURLConnectionPool
+{
+public:
+    struct Handles
+    {
+        CURLM* multi = nullptr;
+        CURL* curl = nullptr;
+        String origin;
+    };
+
+    static CURLConnectionPool& getInstance()
+    {
+        static CURLConnectionPool pool;
+        return pool;
+    }
+
+    ~CURLConnectionPool()
+    {
+        for (auto& h : idle)
+            destroy (h);
+    }
+
+    /** Returns a pair of handles that was last used to talk to the given origin,
+        or empty handles if there aren't any.
+    */
+    Handles take (const String& origin)
+    {
+        const ScopedLock sl (lock);
+
+        const auto iter = std::find_if (idle.rbegin(), idle.rend(), [&] (const Handles& h) { return h.origin == origin; });
+
+        if (iter == idle.rend())
+            return {};
+
+        auto result = *iter;
+        idle.erase (std::next (iter).base());
+        symbols->curl_easy_reset (result.curl);
+        return result;
+    }
+
+    /** Keeps hold of some handles that have finished a request, which must no longer
+        be attached to their multi handle. Returns false if the caller should clean
+        them up instead.
+    */
+    bool give (Handles h)
+    {
+        if (symbols == nullptr)
+            return false;
+
+        Handles evicted;
+
+        {
+            const ScopedLock sl (lock);
+            idle.push_back (h);
+
+            if (idle.size() > maxIdleHandles)
+            {
+                evicted = idle.front();
+                idle.erase (idle.begin());
+            }
+        }
+
+        destroy (evicted);
+        return true;
+    }
+
+private:
+    CURLConnectionPool() = default;
+
+    void destroy (Handles& h)
+    {
+        if (symbols == nullptr)
+            return;
+
+        const ScopedLock sl (CURLSymbols::getLibcurlLock());
+
+        if (h.curl != nullptr)
+            symbols->curl_easy_cleanup (h.curl);
+
+        if (h.multi != nullptr)
+            symbols->curl_multi_cleanup (h.multi);
+    }
+
+    static constexpr size_t maxIdleHandles = 8;
+
+    std::unique_ptr<CURLSymbols> symbols { CURLSymbols::create() };
+    CriticalSection lock;
+    std::vector<Handles> idle;
+
+    JUCE_DECLARE_NON_COPYABLE (CURLConnectionPool)
+};
 
 //==============================================================================
 class WebInputStream::Pimpl
@@ -121,6 +220,14 @@ public:
     {
         jassert (symbols); // Unable to load libcurl!
 
+        const auto pooled = CURLConnectionPool::getInstance().take (getOrigin());
+
+        if (pooled.multi != nullptr)
+        {
+            multi = pooled.multi;
+            curl = pooled.curl;
+        }
+        else
         {
             const ScopedLock sl (CURLSymbols::getLibcurlLock());
             multi = symbols->curl_multi_init();
@@ -128,7 +235,8 @@ public:
 
         if (multi != nullptr)
         {
-            curl = symbols->curl_easy_init();
+            if (curl == nullptr)
+                curl = symbols->curl_easy_init();
 
             if (curl != nullptr)
                 if (symbols->curl_multi_add_handle (multi, curl) == CURLM_OK)
@@ -191,9 +299,34 @@ public:
     int getStatusCode() const                                             { return statusCode; }
 
     //==============================================================================
+    String getOrigin() const
+    {
+        return url.getScheme() + "://" + url.getDomain() + ":" + String (url.getPort());
+    }
+
     void cleanup()
     {
         const ScopedLock lock (cleanupLock);
+
+        // A request that completed leaves its connection in a state that can be reused
+        if (finished && lastError == CURLE_OK && curl != nullptr && multi != nullptr)
+        {
+            symbols->curl_multi_remove_handle (multi, curl);
+
+            if (headerList != nullptr)
+            {
+                symbols->curl_slist_free_all (headerList);
+                headerList = nullptr;
+            }
+
+            if (CURLConnectionPool::getInstance().give ({ multi, curl, getOrigin() }))
+            {
+                curl = nullptr;
+                multi = nullptr;
+                return;
+            }
+        }
+
         const ScopedLock sl (CURLSymbols::getLibcurlLock());
 
         if (curl != nullptr)
@@ -250,8 +383,16 @@ public:
             && symbols->curl_easy_setopt (curl, CURLOPT_NOSIGNAL, 1) == CURLE_OK
             && symbols->curl_easy_setopt (curl, CURLOPT_MAXREDIRS, static_cast<long> (maxRedirects)) == CURLE_OK
             && symbols->curl_easy_setopt (curl, CURLOPT_USERAGENT, userAgent.toRawUTF8()) == CURLE_OK
-            && symbols->curl_easy_setopt (curl, CURLOPT_FOLLOWLOCATION, (maxRedirects > 0 ? 1 : 0)) == CURLE_OK)
+            && symbols->curl_easy_setopt (curl, CURLOPT_FOLLOWLOCATION, (maxRedirects > 0 ? 1 : 0)) == CURLE_OK
+            && symbols->curl_easy_setopt (curl, CURLOPT_TCP_KEEPALIVE, 1L) == CURLE_OK)
         {
+           #if LIBCURL_VERSION_NUM >= 0x072f00
+            // Use HTTP/2 for https URLs when both libcurl and the server support it.
+            // Failing to set this isn't a problem, we'll just carry on with HTTP/1.1
+            if ((data->features & CURL_VERSION_HTTP2) != 0)
+                symbols->curl_easy_setopt (curl, CURLOPT_HTTP_VERSION, (long) CURL_HTTP_VERSION_2TLS);
+           #endif
+
             if (hasBodyDataToSend)
             {
                 if (symbols->curl_easy_setopt (curl, CURLOPT_READDATA, this) != CURLE_OK
@@ -469,8 +610,10 @@ public:
         }
         else
         {
-            // if curl does not return any sockets for to wait on, then the doc says to wait 100 ms
-            Thread::sleep (100);
+            // if curl does not return any sockets for to wait on, then the doc says to wait 100 ms,
+            // unless curl_multi_timeout asked for less (e.g. a new request that hasn't started yet)
+            if (curl_timeo > 0)
+                Thread::sleep (jmin (100, (int) curl_timeo));
         }
 
         int still_running = 0;
@@ -31,6 +31,14 @@ namespace juce
  #define INTERNET_OPTION_DISABLE_AUTODIAL 70
 #endif
 
+#ifndef INTERNET_OPTION_ENABLE_HTTP_PROTOCOL
+ #define INTERNET_OPTION_ENABLE_HTTP_PROTOCOL 148
+#endif
+
+#ifndef HTTP_PROTOCOL_FLAG_HTTP2
+ #define HTTP_PROTOCOL_FLAG_HTTP2 0x2
+#endif
+
 //==============================================================================
 class WebInputStream::Pimpl
 {
@@ -274,7 +282,20 @@ private:
 
     void createConnection (const String& address, WebInputStream::Listener* listener)
     {
-        static HINTERNET sessionHandle = InternetOpen (_T ("juce"), INTERNET_OPEN_TYPE_PRECONFIG, nullptr, nullptr, 0);
+        // All requests share one session, which keeps connections alive between them
+        static HINTERNET sessionHandle = []
+        {
+            auto handle = InternetOpen (_T ("juce"), INTERNET_OPEN_TYPE_PRECONFIG, nullptr, nullptr, 0);
+
+            // Older versions of Windows don't support HTTP/2, and will just ignore this
+            if (handle != nullptr)
+            {
+                DWORD protocols = HTTP_PROTOCOL_FLAG_HTTP2;
+                InternetSetOption (handle, INTERNET_OPTION_ENABLE_HTTP_PROTOCOL, &protocols, sizeof (protocols));
+            }
+
+            return handle;
+        }();
 
         closeConnection();
 
@@ -391,7 +412,7 @@ private:
         const TCHAR* mimeTypes[] = { _T ("*/*"), nullptr };
 
         DWORD flags = INTERNET_FLAG_RELOAD | INTERNET_FLAG_NO_CACHE_WRITE | INTERNET_FLAG_NO_COOKIES
-                        | INTERNET_FLAG_NO_AUTO_REDIRECT;
+                        | INTERNET_FLAG_NO_AUTO_REDIRECT | INTERNET_FLAG_KEEP_CONNECTION;
 
         if (address.startsWithIgnoreCase ("https:"))
             flags |= INTERNET_FLAG_SECURE;  // (this flag only seems necessary if the OS is running IE6 -
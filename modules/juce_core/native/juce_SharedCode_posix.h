@@ -36,13 +36,15 @@ CriticalSection::CriticalSection() noexcept
 }
 
 CriticalSection::~CriticalSection() noexcept        { pthread_mutex_destroy (&lock); }
-void CriticalSection::enter() const noexcept        { pthread_mutex_lock (&lock); }
+void CriticalSection::enter() const noexcept        { JUCE_CHECK_REALTIME_SAFETY (lock, "CriticalSection::enter"); pthread_mutex_lock (&lock); }
 bool CriticalSection::tryEnter() const noexcept     { return pthread_mutex_trylock (&lock) == 0; }
 void CriticalSection::exit() const noexcept         { pthread_mutex_unlock (&lock); }
 
 //==============================================================================
 void JUCE_CALLTYPE Thread::sleep (int millisecs)
 {
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "Thread::sleep");
+
     struct timespec time;
     time.tv_sec = millisecs / 1000;
     time.tv_nsec = (millisecs % 1000) * 1000000;
@@ -201,6 +203,7 @@ namespace
     static int64 getCreationTime (const juce_statStruct& s) noexcept     { return (int64) s.st_ctime; }
    #endif
 
+   #if JUCE_MAC || JUCE_IOS
     void updateStatInfoForFile (const String& path, bool* isDir, int64* fileSize,
                                 Time* modTime, Time* creationTime, bool* isReadOnly)
     {
@@ -218,6 +221,7 @@ namespace
         if (isReadOnly != nullptr)
             *isReadOnly = access (path.toUTF8(), W_OK) != 0;
     }
+   #endif
    #endif
 
     Result getResultForErrno()
@@ -438,14 +442,60 @@ int64 juce_fileSetPosition (void* handle, int64 pos)
     return -1;
 }
 
+void juce_adviseSequentialMemoryAccess (const void* data, size_t numBytes) noexcept
+{
+   #ifdef MADV_SEQUENTIAL
+    madvise (const_cast<void*> (data), numBytes, MADV_SEQUENTIAL);
+   #else
+    ignoreUnused (data, numBytes);
+   #endif
+}
+
 void FileInputStream::openHandle()
 {
-    auto f = open (file.getFullPathName().toUTF8(), O_RDONLY);
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "FileInputStream::openHandle");
 
-    if (f != -1)
-        fileHandle = fdToVoidPointer (f);
-    else
+    auto filename = file.getFullPathName().toUTF8();
+    auto f = -1;
+
+   #if defined (O_DIRECT)
+    if (readMode == ReadMode::uncached)
+    {
+        f = open (filename, O_RDONLY | O_DIRECT);
+
+        // some file systems (e.g. tmpfs) don't support direct access
+        if (f == -1 && errno == EINVAL)
+            readMode = ReadMode::sequential;
+    }
+   #elif ! defined (F_NOCACHE)
+    if (readMode == ReadMode::uncached)
+        readMode = ReadMode::sequential;
+   #endif
+
+    if (f == -1)
+        f = open (filename, O_RDONLY);
+
+    if (f == -1)
+    {
         status = getResultForErrno();
+        return;
+    }
+
+    fileHandle = fdToVoidPointer (f);
+
+   #if defined (F_NOCACHE)
+    if (readMode == ReadMode::uncached)
+        fcntl (f, F_NOCACHE, 1);
+   #endif
+
+    if (readMode == ReadMode::sequential)
+    {
+       #if defined (POSIX_FADV_SEQUENTIAL)
+        posix_fadvise (f, 0, 0, POSIX_FADV_SEQUENTIAL);
+       #elif defined (F_RDAHEAD)
+        fcntl (f, F_RDAHEAD, 1);
+       #endif
+    }
 }
 
 FileInputStream::~FileInputStream()
@@ -456,6 +506,8 @@ FileInputStream::~FileInputStream()
 
 size_t FileInputStream::readInternal (void* buffer, size_t numBytes)
 {
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "FileInputStream::read");
+
     ssize_t result = 0;
 
     if (fileHandle != nullptr)
@@ -475,6 +527,8 @@ size_t FileInputStream::readInternal (void* buffer, size_t numBytes)
 //==============================================================================
 void FileOutputStream::openHandle()
 {
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "FileOutputStream::openHandle");
+
     if (file.exists())
     {
         auto f = open (file.getFullPathName().toUTF8(), O_RDWR);
@@ -520,6 +574,8 @@ void FileOutputStream::closeHandle()
 
 ssize_t FileOutputStream::writeInternal (const void* data, size_t numBytes)
 {
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "FileOutputStream::write");
+
     if (fileHandle == nullptr)
         return 0;
 
@@ -534,6 +590,8 @@ ssize_t FileOutputStream::writeInternal (const void* data, size_t numBytes)
 #ifndef JUCE_ANDROID
 void FileOutputStream::flushInternal()
 {
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "FileOutputStream::flush");
+
     if (fileHandle != nullptr && fsync (getFD (fileHandle)) == -1)
         status = getResultForErrno();
 }
@@ -932,7 +990,10 @@ public:
         #elif JUCE_LINUX
          const auto backgroundSched = prio == Thread::Priority::background ? SCHED_IDLE
                                                                            : SCHED_OTHER;
-         const auto scheduler = isRealtime ? SCHED_RR : backgroundSched;
+         const auto realtimeSched = isRealtime && rt->getSchedulingPolicy() == Thread::RealtimeOptions::SchedulingPolicy::firstInFirstOut
+                                  ? SCHED_FIFO
+                                  : SCHED_RR;
+         const auto scheduler = isRealtime ? realtimeSched : backgroundSched;
         #else
          const auto scheduler = 0;
         #endif
@@ -430,6 +430,14 @@ bool Thread::setPriority (Priority priorityIn)
     return setPriorityOfThisThread (priorityToUse) == 0;
 }
 
+bool JUCE_CALLTYPE Thread::setCurrentThreadRealtimeOptions (const RealtimeOptions& options)
+{
+    if (options.getAffinityMask() != 0)
+        setCurrentThreadAffinityMask (options.getAffinityMask());
+
+    return setPriorityOfThisThread (Priority::highest);
+}
+
 //==============================================================================
 JUCE_API void JUCE_CALLTYPE Process::setPriority (ProcessPriority) {}
 
@@ -68,6 +68,17 @@ bool Thread::setPriority (Priority newPriority)
     return true;
 }
 
+bool JUCE_CALLTYPE Thread::setCurrentThreadRealtimeOptions (const RealtimeOptions& options)
+{
+    if (options.getAffinityMask() != 0)
+        setCurrentThreadAffinityMask (options.getAffinityMask());
+
+    const auto native = PosixSchedulerPriority::getNativeSchedulerAndPriority (options, {});
+    const struct sched_param param { native.getPriority() };
+
+    return pthread_setschedparam (pthread_self(), native.getScheduler(), &param) == 0;
+}
+
 //==============================================================================
 JUCE_API void JUCE_CALLTYPE Process::setPriority (ProcessPriority) {}
 
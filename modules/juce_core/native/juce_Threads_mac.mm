@@ -165,6 +165,12 @@ void Thread::killThread()
         pthread_cancel ((pthread_t) threadHandle.load());
 }
 
+bool JUCE_CALLTYPE Thread::setCurrentThreadRealtimeOptions (const RealtimeOptions& options)
+{
+    // Affinity masks aren't supported here
+    return tryToUpgradeCurrentThreadToRealtime (options);
+}
+
 Thread::Priority Thread::getPriority() const
 {
     jassert (Thread::getCurrentThreadId() == getThreadId());
@@ -47,7 +47,7 @@ CriticalSection::CriticalSection() noexcept
 }
 
 CriticalSection::~CriticalSection() noexcept        { DeleteCriticalSection ((CRITICAL_SECTION*) &lock); }
-void CriticalSection::enter() const noexcept        { EnterCriticalSection ((CRITICAL_SECTION*) &lock); }
+void CriticalSection::enter() const noexcept        { JUCE_CHECK_REALTIME_SAFETY (lock, "CriticalSection::enter"); EnterCriticalSection ((CRITICAL_SECTION*) &lock); }
 bool CriticalSection::tryEnter() const noexcept     { return TryEnterCriticalSection ((CRITICAL_SECTION*) &lock) != FALSE; }
 void CriticalSection::exit() const noexcept         { LeaveCriticalSection ((CRITICAL_SECTION*) &lock); }
 
@@ -113,6 +113,14 @@ bool Thread::setPriority (Priority priority)
     return setPriorityInternal (isRealtime(), this, priority);
 }
 
+bool JUCE_CALLTYPE Thread::setCurrentThreadRealtimeOptions (const RealtimeOptions& options)
+{
+    if (options.getAffinityMask() != 0)
+        setCurrentThreadAffinityMask (options.getAffinityMask());
+
+    return setPriorityInternal (true, GetCurrentThread(), Priority::highest);
+}
+
 void Thread::closeThreadHandle()
 {
     CloseHandle (threadHandle);
@@ -198,6 +206,7 @@ static SleepEvent sleepEvent;
 void JUCE_CALLTYPE Thread::sleep (const int millisecs)
 {
     jassert (millisecs >= 0);
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "Thread::sleep");
 
     if (millisecs >= 10 || sleepEvent.handle == nullptr)
         Sleep ((DWORD) millisecs);
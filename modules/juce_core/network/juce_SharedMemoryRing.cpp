@@ -0,0 +1,700 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if ! (JUCE_ANDROID || JUCE_WASM)
+
+namespace SharedMemoryRingHelpers
+{
+    static constexpr uint32 magicNumber = 0x4a534d52;
+
+    // This lives at the start of the shared memory, followed by the message data
+    struct Header
+    {
+        std::atomic<uint32> magic;
+        uint32 capacity;
+
+        alignas (64) std::atomic<uint64> writePosition;
+        std::atomic<uint32> dataSignal, readerIsWaiting;
+
+        alignas (64) std::atomic<uint64> readPosition;
+        std::atomic<uint32> spaceSignal, writerIsWaiting;
+
+        alignas (64) std::atomic<uint32> shutDown;
+    };
+
+    static_assert (std::atomic<uint64>::is_always_lock_free && std::atomic<uint32>::is_always_lock_free,
+                   "The shared memory header needs lock-free atomics");
+
+    static constexpr size_t headerSize = (sizeof (Header) + 63) & ~(size_t) 63;
+
+    // Each message is preceded by one of these. A padding record fills the space at
+    // the end of the ring when a message won't fit there.
+    struct RecordHeader
+    {
+        uint32 size, isPadding;
+    };
+
+    static constexpr size_t roundUp (size_t n) noexcept    { return (n + 7) & ~(size_t) 7; }
+}
+
+//==============================================================================
+class SharedMemoryRing::Pimpl
+{
+public:
+    using Header = SharedMemoryRingHelpers::Header;
+
+    Pimpl() = default;
+
+    ~Pimpl()
+    {
+        unmap();
+    }
+
+    bool create (const String& ringName, size_t capacityInBytes)
+    {
+        name = ringName;
+        isCreator = true;
+
+        const auto capacity = (uint32) SharedMemoryRingHelpers::roundUp (jlimit ((size_t) 64, (size_t) 0x40000000, capacityInBytes));
+
+        if (! map ((size_t) capacity + SharedMemoryRingHelpers::headerSize))
+            return false;
+
+        header = new (base) Header();
+        header->capacity = capacity;
+        header->magic.store (SharedMemoryRingHelpers::magicNumber, std::memory_order_release);
+        return true;
+    }
+
+    bool openExisting (const String& ringName)
+    {
+        name = ringName;
+        isCreator = false;
+
+        if (! map (0))
+            return false;
+
+        header = static_cast<Header*> (base);
+
+        if (header->magic.load (std::memory_order_acquire) != SharedMemoryRingHelpers::magicNumber)
+        {
+            unmap();
+            return false;
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    void shutdown()
+    {
+        header->shutDown = 1;
+        ++header->dataSignal;
+        ++header->spaceSignal;
+        wake (header->dataSignal, dataEvent);
+        wake (header->spaceSignal, spaceEvent);
+    }
+
+    bool isShutDown() const noexcept            { return header->shutDown.load() != 0; }
+    size_t getCapacity() const noexcept         { return header->capacity; }
+
+    size_t getMaximumMessageSize() const noexcept
+    {
+        return header->capacity - sizeof (SharedMemoryRingHelpers::RecordHeader);
+    }
+
+    //==============================================================================
+    void* prepareToWrite (size_t numBytes, int timeoutMs)
+    {
+        using namespace SharedMemoryRingHelpers;
+
+        const auto recordSize = sizeof (RecordHeader) + roundUp (numBytes);
+        const auto capacity = (uint64) header->capacity;
+
+        // This message is too big for the ring!
+        jassert (recordSize <= capacity);
+
+        if (recordSize > capacity || isShutDown())
+            return nullptr;
+
+        const auto startTime = Time::getMillisecondCounter();
+        auto position = header->writePosition.load (std::memory_order_relaxed);
+        auto offset = (size_t) (position % capacity);
+
+        if (capacity - offset < recordSize)
+        {
+            const auto paddingSize = (size_t) (capacity - offset);
+
+            if (! waitForSpace (position, paddingSize, startTime, timeoutMs))
+                return nullptr;
+
+            writeRecordHeader (offset, { (uint32) (paddingSize - sizeof (RecordHeader)), 1 });
+            publishWritePosition (position += paddingSize);
+            offset = 0;
+        }
+
+        if (! waitForSpace (position, recordSize, startTime, timeoutMs))
+            return nullptr;
+
+        writeRecordHeader (offset, { (uint32) numBytes, 0 });
+        pendingWriteSize = recordSize;
+        return getData() + offset + sizeof (RecordHeader);
+    }
+
+    void finishedWriting()
+    {
+        // You need to call prepareToWrite() first!
+        jassert (pendingWriteSize != 0);
+
+        publishWritePosition (header->writePosition.load (std::memory_order_relaxed) + pendingWriteSize);
+        pendingWriteSize = 0;
+    }
+
+    //==============================================================================
+    const void* waitForNextMessage (size_t& numBytes, int timeoutMs)
+    {
+        using namespace SharedMemoryRingHelpers;
+
+        // You need to call finishedReading() before reading the next message!
+        jassert (pendingReadSize == 0);
+
+        const auto startTime = Time::getMillisecondCounter();
+        const auto capacity = (uint64) header->capacity;
+
+        for (;;)
+        {
+            const auto position = header->readPosition.load (std::memory_order_relaxed);
+
+            auto hasData = [this, position] { return header->writePosition.load() != position; };
+
+            if (! waitFor (header->dataSignal, header->readerIsWaiting, dataEvent, hasData, startTime, timeoutMs))
+                return nullptr;
+
+            const auto offset = (size_t) (position % capacity);
+            RecordHeader record;
+            std::memcpy (&record, getData() + offset, sizeof (record));
+
+            const auto recordSize = sizeof (RecordHeader) + roundUp (record.size);
+
+            if (record.isPadding != 0)
+            {
+                publishReadPosition (position + recordSize);
+                continue;
+            }
+
+            numBytes = record.size;
+            pendingReadSize = recordSize;
+            return getData() + offset + sizeof (RecordHeader);
+        }
+    }
+
+    void finishedReading()
+    {
+        // You need to call waitForNextMessage() first!
+        jassert (pendingReadSize != 0);
+
+        publishReadPosition (header->readPosition.load (std::memory_order_relaxed) + pendingReadSize);
+        pendingReadSize = 0;
+    }
+
+private:
+    //==============================================================================
+    String name;
+    bool isCreator = false;
+    void* base = nullptr;
+    Header* header = nullptr;
+    size_t mappedSize = 0, pendingWriteSize = 0, pendingReadSize = 0;
+
+   #if JUCE_WINDOWS
+    HANDLE mapping = nullptr;
+    HANDLE dataEvent = nullptr, spaceEvent = nullptr;
+   #else
+    static constexpr void* dataEvent = nullptr;
+    static constexpr void* spaceEvent = nullptr;
+   #endif
+
+    char* getData() const noexcept      { return static_cast<char*> (base) + SharedMemoryRingHelpers::headerSize; }
+
+    void writeRecordHeader (size_t offset, SharedMemoryRingHelpers::RecordHeader record) noexcept
+    {
+        std::memcpy (getData() + offset, &record, sizeof (record));
+    }
+
+    void publishWritePosition (uint64 newPosition)
+    {
+        header->writePosition.store (newPosition);
+        ++header->dataSignal;
+
+        if (header->readerIsWaiting.load() != 0)
+            wake (header->dataSignal, dataEvent);
+    }
+
+    void publishReadPosition (uint64 newPosition)
+    {
+        header->readPosition.store (newPosition);
+        ++header->spaceSignal;
+
+        if (header->writerIsWaiting.load() != 0)
+            wake (header->spaceSignal, spaceEvent);
+    }
+
+    bool waitForSpace (uint64 writePosition, size_t numBytes, uint32 startTime, int timeoutMs)
+    {
+        auto hasSpace = [this, writePosition, numBytes]
+        {
+            return isShutDown() || header->capacity - (writePosition - header->readPosition.load()) >= numBytes;
+        };
+
+        return waitFor (header->spaceSignal, header->writerIsWaiting, spaceEvent, hasSpace, startTime, timeoutMs)
+                 && ! isShutDown();
+    }
+
+    // Spins for a moment, then sleeps until the other end changes the signal value. The
+    // waiting flag tells the other end that it needs to make a system call to wake us.
+    template <typename Condition>
+    bool waitFor (std::atomic<uint32>& signal, std::atomic<uint32>& waitingFlag, [[maybe_unused]] void* event,
+                  Condition&& condition, uint32 startTime, int timeoutMs)
+    {
+        for (int i = 0; i < 2000; ++i)
+            if (condition())
+                return true;
+
+        for (;;)
+        {
+            const auto signalValue = signal.load();
+            waitingFlag.store (1);
+
+            if (condition())
+            {
+                waitingFlag.store (0);
+                return true;
+            }
+
+            if (isShutDown())
+            {
+                waitingFlag.store (0);
+                return false;
+            }
+
+            auto remaining = -1;
+
+            if (timeoutMs >= 0)
+            {
+                remaining = timeoutMs - (int) (Time::getMillisecondCounter() - startTime);
+
+                if (remaining <= 0)
+                {
+                    waitingFlag.store (0);
+                    return false;
+                }
+            }
+
+           #if JUCE_LINUX
+            timespec timeout { remaining / 1000, (remaining % 1000) * 1000000 };
+            syscall (SYS_futex, reinterpret_cast<uint32*> (&signal), FUTEX_WAIT, signalValue,
+                     remaining >= 0 ? &timeout : nullptr, nullptr, 0);
+           #elif JUCE_WINDOWS
+            ignoreUnused (signalValue);
+            WaitForSingleObject ((HANDLE) event, remaining >= 0 ? (DWORD) remaining : INFINITE);
+           #else
+            ignoreUnused (signalValue);
+            Thread::sleep (1);
+           #endif
+
+            waitingFlag.store (0);
+        }
+    }
+
+    static void wake ([[maybe_unused]] std::atomic<uint32>& signal, [[maybe_unused]] void* event)
+    {
+       #if JUCE_LINUX
+        static_assert (sizeof (signal) == sizeof (uint32));
+        syscall (SYS_futex, reinterpret_cast<uint32*> (&signal), FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+       #elif JUCE_WINDOWS
+        SetEvent ((HANDLE) event);
+       #endif
+    }
+
+    //==============================================================================
+   #if JUCE_WINDOWS
+    bool map (size_t sizeToCreate)
+    {
+        const auto mappingName = "Local\\juce_ring_" + name;
+
+        if (sizeToCreate > 0)
+        {
+            mapping = CreateFileMappingW (INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, (DWORD) sizeToCreate,
+                                          mappingName.toWideCharPointer());
+
+            if (mapping != nullptr && GetLastError() == ERROR_ALREADY_EXISTS)
+            {
+                CloseHandle (mapping);
+                mapping = nullptr;
+            }
+        }
+        else
+        {
+            mapping = OpenFileMappingW (FILE_MAP_ALL_ACCESS, FALSE, mappingName.toWideCharPointer());
+        }
+
+        if (mapping == nullptr)
+            return false;
+
+        base = MapViewOfFile (mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeToCreate);
+
+        if (base == nullptr)
+        {
+            unmap();
+            return false;
+        }
+
+        dataEvent  = CreateEventW (nullptr, FALSE, FALSE, (mappingName + "_data").toWideCharPointer());
+        spaceEvent = CreateEventW (nullptr, FALSE, FALSE, (mappingName + "_space").toWideCharPointer());
+
+        if (dataEvent == nullptr || spaceEvent == nullptr)
+        {
+            unmap();
+            return false;
+        }
+
+        return true;
+    }
+
+    void unmap()
+    {
+        if (base != nullptr)        UnmapViewOfFile (base);
+        if (mapping != nullptr)     CloseHandle (mapping);
+        if (dataEvent != nullptr)   CloseHandle (dataEvent);
+        if (spaceEvent != nullptr)  CloseHandle (spaceEvent);
+
+        base = nullptr;
+        header = nullptr;
+        mapping = dataEvent = spaceEvent = nullptr;
+    }
+   #else
+    bool map (size_t sizeToCreate)
+    {
+        const auto objectName = getObjectName();
+        const auto fd = sizeToCreate > 0 ? shm_open (objectName.toRawUTF8(), O_RDWR | O_CREAT | O_EXCL, 0600)
+                                         : shm_open (objectName.toRawUTF8(), O_RDWR, 0);
+
+        if (fd < 0)
+            return false;
+
+        if (sizeToCreate > 0)
+        {
+            if (ftruncate (fd, (off_t) sizeToCreate) != 0)
+            {
+                ::close (fd);
+                shm_unlink (objectName.toRawUTF8());
+                return false;
+            }
+
+            mappedSize = sizeToCreate;
+        }
+        else
+        {
+            struct stat info;
+            mappedSize = fstat (fd, &info) == 0 ? (size_t) info.st_size : 0;
+        }
+
+        if (mappedSize >= SharedMemoryRingHelpers::headerSize)
+        {
+            base = mmap (nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+            if (base == MAP_FAILED)
+                base = nullptr;
+        }
+
+        ::close (fd);
+
+        if (base == nullptr)
+        {
+            if (isCreator)
+                shm_unlink (objectName.toRawUTF8());
+
+            return false;
+        }
+
+        return true;
+    }
+
+    void unmap()
+    {
+        if (base != nullptr)
+        {
+            munmap (base, mappedSize);
+
+            if (isCreator)
+                shm_unlink (getObjectName().toRawUTF8());
+        }
+
+        base = nullptr;
+        header = nullptr;
+    }
+
+    String getObjectName() const
+    {
+        // macOS only allows short names
+        return "/jr_" + name.substring (0, 24);
+    }
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
+};
+
+//==============================================================================
+SharedMemoryRing::SharedMemoryRing() = default;
+SharedMemoryRing::~SharedMemoryRing() = default;
+
+bool SharedMemoryRing::create (const String& name, size_t capacityInBytes)
+{
+    close();
+    pimpl = std::make_unique<Pimpl>();
+
+    if (! pimpl->create (name, capacityInBytes))
+        pimpl.reset();
+
+    return pimpl != nullptr;
+}
+
+bool SharedMemoryRing::openExisting (const String& name)
+{
+    close();
+    pimpl = std::make_unique<Pimpl>();
+
+    if (! pimpl->openExisting (name))
+        pimpl.reset();
+
+    return pimpl != nullptr;
+}
+
+void SharedMemoryRing::close()                              { pimpl.reset(); }
+bool SharedMemoryRing::isOpen() const noexcept              { return pimpl != nullptr; }
+void SharedMemoryRing::shutdown()                           { if (pimpl != nullptr) pimpl->shutdown(); }
+bool SharedMemoryRing::isShutDown() const noexcept          { return pimpl == nullptr || pimpl->isShutDown(); }
+size_t SharedMemoryRing::getCapacity() const noexcept       { return pimpl != nullptr ? pimpl->getCapacity() : 0; }
+size_t SharedMemoryRing::getMaximumMessageSize() const noexcept  { return pimpl != nullptr ? pimpl->getMaximumMessageSize() : 0; }
+
+void* SharedMemoryRing::prepareToWrite (size_t numBytes, int timeoutMilliseconds)
+{
+    return pimpl != nullptr ? pimpl->prepareToWrite (numBytes, timeoutMilliseconds) : nullptr;
+}
+
+void SharedMemoryRing::finishedWriting()
+{
+    if (pimpl != nullptr)
+        pimpl->finishedWriting();
+}
+
+bool SharedMemoryRing::write (const void* sourceData, size_t numBytes, int timeoutMilliseconds)
+{
+    if (auto* dest = prepareToWrite (numBytes, timeoutMilliseconds))
+    {
+        if (numBytes > 0)
+            std::memcpy (dest, sourceData, numBytes);
+
+        finishedWriting();
+        return true;
+    }
+
+    return false;
+}
+
+const void* SharedMemoryRing::waitForNextMessage (size_t& numBytes, int timeoutMilliseconds)
+{
+    return pimpl != nullptr ? pimpl->waitForNextMessage (numBytes, timeoutMilliseconds) : nullptr;
+}
+
+void SharedMemoryRing::finishedReading()
+{
+    if (pimpl != nullptr)
+        pimpl->finishedReading();
+}
+
+#else
+
+// Android doesn't have POSIX shared memory objects, so rings can't be created there
+class SharedMemoryRing::Pimpl {};
+
+SharedMemoryRing::SharedMemoryRing() = default;
+SharedMemoryRing::~SharedMemoryRing() = default;
+
+bool SharedMemoryRing::create (const String&, size_t)                   { return false; }
+bool SharedMemoryRing::openExisting (const String&)                     { return false; }
+void SharedMemoryRing::close()                                          {}
+bool SharedMemoryRing::isOpen() const noexcept                          { return false; }
+void SharedMemoryRing::shutdown()                                       {}
+bool SharedMemoryRing::isShutDown() const noexcept                      { return true; }
+size_t SharedMemoryRing::getCapacity() const noexcept                   { return 0; }
+size_t SharedMemoryRing::getMaximumMessageSize() const noexcept         { return 0; }
+void* SharedMemoryRing::prepareToWrite (size_t, int)                    { return nullptr; }
+void SharedMemoryRing::finishedWriting()                                {}
+bool SharedMemoryRing::write (const void*, size_t, int)                 { return false; }
+const void* SharedMemoryRing::waitForNextMessage (size_t&, int)         { return nullptr; }
+void SharedMemoryRing::finishedReading()                                {}
+
+#endif
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && ! (JUCE_ANDROID || JUCE_WASM)
+
+class SharedMemoryRingTests final : public UnitTest
+{
+public:
+    SharedMemoryRingTests()
+        : UnitTest ("SharedMemoryRing", UnitTestCategories::networking)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        const auto ringName = "test" + String::toHexString (random.nextInt64());
+
+        beginTest ("Rings can be created and opened by name");
+        {
+            SharedMemoryRing writer, reader;
+
+            expect (! reader.openExisting (ringName));
+            expect (writer.create (ringName, 1000));
+            expect (! SharedMemoryRing().create (ringName, 1000));
+            expect (reader.openExisting (ringName));
+
+            expectEquals ((int) reader.getCapacity(), 1000);
+            expect (writer.getMaximumMessageSize() < writer.getCapacity());
+
+            size_t size = 0;
+            expect (reader.waitForNextMessage (size, 0) == nullptr);
+
+            expect (writer.write ("hello", 5, 0));
+            auto* message = reader.waitForNextMessage (size, 0);
+            expect (message != nullptr);
+            expectEquals ((int) size, 5);
+            expect (std::memcmp (message, "hello", 5) == 0);
+            reader.finishedReading();
+
+            writer.close();
+            expect (! writer.isOpen());
+        }
+
+        beginTest ("Writes time out when the ring is full");
+        {
+            SharedMemoryRing writer, reader;
+            expect (writer.create (ringName, 256));
+            expect (reader.openExisting (ringName));
+
+            int numWritten = 0;
+
+            while (writer.write (&numWritten, sizeof (numWritten), 0))
+                ++numWritten;
+
+            expect (numWritten > 0);
+            expect (! writer.write (&numWritten, sizeof (numWritten), 10));
+
+            size_t size = 0;
+            expect (reader.waitForNextMessage (size, 0) != nullptr);
+            reader.finishedReading();
+            expect (writer.write (&numWritten, sizeof (numWritten), 0));
+        }
+
+        beginTest ("Messages arrive intact and in order between threads");
+        {
+            SharedMemoryRing writer, reader;
+            expect (writer.create (ringName, 4096));
+            expect (reader.openExisting (ringName));
+
+            constexpr int numMessages = 20000;
+            std::atomic<bool> allCorrect { true };
+
+            std::thread readerThread ([&]
+            {
+                for (int i = 0; i < numMessages; ++i)
+                {
+                    size_t size = 0;
+                    auto* message = static_cast<const uint8*> (reader.waitForNextMessage (size, 5000));
+
+                    if (message == nullptr || size != (size_t) (i % 1000) + 1)
+                    {
+                        allCorrect = false;
+                        return;
+                    }
+
+                    for (size_t j = 0; j < size; ++j)
+                        if (message[j] != (uint8) (i + (int) j))
+                            allCorrect = false;
+
+                    reader.finishedReading();
+                }
+            });
+
+            for (int i = 0; i < numMessages; ++i)
+            {
+                const auto size = (size_t) (i % 1000) + 1;
+                auto* dest = static_cast<uint8*> (writer.prepareToWrite (size, 5000));
+
+                if (dest == nullptr)
+                {
+                    allCorrect = false;
+                    break;
+                }
+
+                for (size_t j = 0; j < size; ++j)
+                    dest[j] = (uint8) (i + (int) j);
+
+                writer.finishedWriting();
+            }
+
+            readerThread.join();
+            expect (allCorrect);
+        }
+
+        beginTest ("Shutting down wakes a waiting reader after the last message");
+        {
+            SharedMemoryRing writer, reader;
+            expect (writer.create (ringName, 1024));
+            expect (reader.openExisting (ringName));
+
+            expect (writer.write ("last", 4, 0));
+            writer.shutdown();
+            expect (reader.isShutDown());
+            expect (! writer.write ("more", 4, 0));
+
+            size_t size = 0;
+            expect (reader.waitForNextMessage (size, 1000) != nullptr);
+            reader.finishedReading();
+
+            const auto startTime = Time::getMillisecondCounter();
+            expect (reader.waitForNextMessage (size, 5000) == nullptr);
+            expect (Time::getMillisecondCounter() - startTime < 1000);
+        }
+    }
+};
+
+static SharedMemoryRingTests sharedMemoryRingTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A one-way queue of messages between two processes, held in a block of shared
+    memory.
+
+    One process creates the ring with create(), and another opens it by name with
+    openExisting(). One thread at a time may write messages into it, and one thread
+    at a time may read them out. Messages don't go through the kernel, and a waiting
+    reader is woken with a futex on Linux or a named event on Windows. Other platforms
+    poll while they're waiting, after spinning briefly.
+
+    To avoid copying, a writer can build a message in place using prepareToWrite() and
+    finishedWriting(), and a reader can use a message where it lies in the ring before
+    calling finishedReading().
+
+    @code
+    // writer
+    if (auto* dest = ring.prepareToWrite (numBytes, 100))
+    {
+        fillBuffer (dest, numBytes);
+        ring.finishedWriting();
+    }
+
+    // reader
+    size_t numBytes;
+
+    if (auto* message = ring.waitForNextMessage (numBytes, 100))
+    {
+        useMessage (message, numBytes);
+        ring.finishedReading();
+    }
+    @endcode
+
+    For a two-way connection, use a pair of rings, or let InterprocessConnection manage
+    them with InterprocessConnection::createSharedMemory().
+
+    @see NamedPipe, InterprocessConnection
+
+    @tags{Core}
+*/
+class JUCE_API  SharedMemoryRing  final
+{
+public:
+    //==============================================================================
+    /** Creates a SharedMemoryRing that isn't open yet. */
+    SharedMemoryRing();
+
+    /** Destructor.
+        If this object created the ring, the name is removed, but the memory stays
+        valid for the other process until it closes its end.
+    */
+    ~SharedMemoryRing();
+
+    //==============================================================================
+    /** Creates a new ring with the given name, able to hold the given number of bytes.
+
+        Returns false if it fails, or if a ring with this name already exists.
+    */
+    bool create (const String& name, size_t capacityInBytes);
+
+    /** Opens a ring that another process has created.
+        Returns true if it succeeds.
+    */
+    bool openExisting (const String& name);
+
+    /** Closes this end of the ring, if it's open. */
+    void close();
+
+    /** True if the ring is currently open. */
+    bool isOpen() const noexcept;
+
+    /** Tells both ends that the ring is finished with.
+
+        Any threads waiting to read or write are woken up, further writes will fail, and
+        readers will get any messages that are left, after which waitForNextMessage()
+        returns nullptr. Unlike close(), this leaves the memory mapped, so it's safe to
+        call while another thread is using the ring.
+    */
+    void shutdown();
+
+    /** True if either end has called shutdown(). */
+    bool isShutDown() const noexcept;
+
+    /** Returns the number of bytes of message data that the ring can hold. */
+    size_t getCapacity() const noexcept;
+
+    /** Returns the size of the largest message that can be written. */
+    size_t getMaximumMessageSize() const noexcept;
+
+    //==============================================================================
+    /** Waits for space for a message, and returns the address at which to write it.
+
+        Once you've filled in the message, call finishedWriting() to send it. If there
+        still isn't enough space after timeoutMilliseconds (or never, if it's negative),
+        or the ring has been shut down, this returns nullptr.
+    */
+    void* prepareToWrite (size_t numBytes, int timeoutMilliseconds);
+
+    /** Sends the message that was set up by the last call to prepareToWrite(). */
+    void finishedWriting();
+
+    /** Copies a message into the ring.
+        Returns false if it times out, or if the ring has been shut down.
+    */
+    bool write (const void* sourceData, size_t numBytes, int timeoutMilliseconds);
+
+    //==============================================================================
+    /** Waits for a message to arrive, and returns its address.
+
+        The message stays valid until you call finishedReading(), which you must do
+        before asking for the next one. If nothing arrives within timeoutMilliseconds
+        (or never, if it's negative), or the ring is shut down and empty, this returns
+        nullptr.
+    */
+    const void* waitForNextMessage (size_t& numBytes, int timeoutMilliseconds);
+
+    /** Frees the space used by the message returned by waitForNextMessage(). */
+    void finishedReading();
+
+private:
+    //==============================================================================
+    class Pimpl;
+    std::unique_ptr<Pimpl> pimpl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemoryRing)
+};
+
+} // namespace juce
@@ -299,6 +299,30 @@ namespace SocketHelpers
         return (int) bytesRead;
     }
 
+    static int sendWithoutBlocking (SocketHandle handle, const void* sourceBuffer, int numBytesToWrite) noexcept
+    {
+       #if JUCE_WINDOWS
+        setSocketBlockingState (handle, false);
+        auto bytesWritten = ::send (handle, (const char*) sourceBuffer, (juce_recvsend_size_t) numBytesToWrite, 0);
+
+        if (bytesWritten < 0 && WSAGetLastError() == WSAEWOULDBLOCK)
+            return 0;
+       #else
+        #if JUCE_LINUX || JUCE_ANDROID || JUCE_BSD
+         constexpr int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+        #else
+         constexpr int flags = MSG_DONTWAIT;
+        #endif
+
+        auto bytesWritten = ::send (handle, sourceBuffer, (juce_recvsend_size_t) numBytesToWrite, flags);
+
+        if (bytesWritten < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+            return 0;
+       #endif
+
+        return (int) bytesWritten;
+    }
+
     static int waitForReadiness (std::atomic<int>& handle, CriticalSection& readLock,
                                  bool forReading, int timeoutMsecs) noexcept
     {
@@ -520,6 +544,14 @@ int StreamingSocket::write (const void* sourceBuffer, int numBytesToWrite)
     return (int) ::send ((SocketHandle) handle.load(), (const char*) sourceBuffer, (juce_recvsend_size_t) numBytesToWrite, 0);
 }
 
+int StreamingSocket::writeWithoutBlocking (const void* sourceBuffer, int numBytesToWrite)
+{
+    if (isListener || ! connected)
+        return -1;
+
+    return SocketHelpers::sendWithoutBlocking ((SocketHandle) handle.load(), sourceBuffer, numBytesToWrite);
+}
+
 //==============================================================================
 int StreamingSocket::waitUntilReady (bool readyForReading, int timeoutMsecs)
 {
@@ -209,6 +209,17 @@ public:
     */
     int write (const void* sourceBuffer, int numBytesToWrite);
 
+    /** Writes as many bytes as the socket can accept right now, without blocking.
+
+        This is for use with a SocketReactor: if it can't send everything, ask the reactor
+        for write events and send the rest when the socket becomes writable.
+
+        @returns  the number of bytes written, which will be 0 if the socket's send buffer
+                  is full, or -1 if there was an error
+        @see SocketReactor
+    */
+    int writeWithoutBlocking (const void* sourceBuffer, int numBytesToWrite);
+
     //==============================================================================
     /** Puts this socket into "listener" mode.
 
@@ -0,0 +1,610 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if ! JUCE_WASM
+
+struct SocketReactor::Registration
+{
+    int handle;
+    uint32 id;
+    Callback callback;
+    IOThread* thread;
+    CriticalSection callbackLock;
+    bool removed = false;
+};
+
+//==============================================================================
+namespace SocketReactorHelpers
+{
+    struct Event
+    {
+        int handle;
+        uint32 id;
+        int flags;
+    };
+
+    static constexpr int maxEventsPerWait = 64;
+
+   #if JUCE_LINUX || JUCE_ANDROID
+    class Poller
+    {
+    public:
+        Poller()
+        {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = 0;
+            epoll_ctl (epollHandle, EPOLL_CTL_ADD, wakeHandle, &event);
+        }
+
+        ~Poller()
+        {
+            ::close (wakeHandle);
+            ::close (epollHandle);
+        }
+
+        bool add (int handle, uint32 id, bool wantsWrite)
+        {
+            auto event = makeEvent (handle, id, wantsWrite);
+            return epoll_ctl (epollHandle, EPOLL_CTL_ADD, handle, &event) == 0;
+        }
+
+        void modify (int handle, uint32 id, bool wantsWrite)
+        {
+            auto event = makeEvent (handle, id, wantsWrite);
+            epoll_ctl (epollHandle, EPOLL_CTL_MOD, handle, &event);
+        }
+
+        void remove (int handle)
+        {
+            epoll_event event{};
+            epoll_ctl (epollHandle, EPOLL_CTL_DEL, handle, &event);
+        }
+
+        void wake()
+        {
+            const uint64_t value = 1;
+            [[maybe_unused]] auto result = ::write (wakeHandle, &value, sizeof (value));
+        }
+
+        bool wait (std::vector<Event>& results)
+        {
+            epoll_event events[maxEventsPerWait];
+            const auto numEvents = epoll_wait (epollHandle, events, maxEventsPerWait, -1);
+
+            if (numEvents < 0)
+                return errno == EINTR;
+
+            for (int i = 0; i < numEvents; ++i)
+            {
+                const auto data = events[i].data.u64;
+
+                if (data == 0)
+                {
+                    uint64_t value;
+                    [[maybe_unused]] auto result = ::read (wakeHandle, &value, sizeof (value));
+                    continue;
+                }
+
+                const auto flags = events[i].events;
+                int eventFlags = 0;
+
+                if ((flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0)  eventFlags |= SocketReactor::readable;
+                if ((flags & EPOLLOUT) != 0)                                    eventFlags |= SocketReactor::writable;
+                if ((flags & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0)          eventFlags |= SocketReactor::hungUp;
+
+                results.push_back ({ (int) (uint32) data, (uint32) (data >> 32), eventFlags });
+            }
+
+            return true;
+        }
+
+    private:
+        static epoll_event makeEvent (int handle, uint32 id, bool wantsWrite)
+        {
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP | (wantsWrite ? EPOLLOUT : 0u);
+            event.data.u64 = ((uint64) id << 32) | (uint32) handle;
+            return event;
+        }
+
+        int epollHandle = epoll_create1 (EPOLL_CLOEXEC);
+        int wakeHandle = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+    };
+
+   #elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+    class Poller
+    {
+    public:
+        Poller()
+        {
+            struct kevent change;
+            EV_SET (&change, 0, EVFILT_USER, EV_ADD | EV_CLEAR, 0, 0, nullptr);
+            kevent (queueHandle, &change, 1, nullptr, 0, nullptr);
+        }
+
+        ~Poller()
+        {
+            ::close (queueHandle);
+        }
+
+        bool add (int handle, uint32 id, bool wantsWrite)
+        {
+            if (! change (handle, id, EVFILT_READ, EV_ADD))
+                return false;
+
+            if (wantsWrite)
+                change (handle, id, EVFILT_WRITE, EV_ADD);
+
+            return true;
+        }
+
+        void modify (int handle, uint32 id, bool wantsWrite)
+        {
+            change (handle, id, EVFILT_WRITE, wantsWrite ? EV_ADD : EV_DELETE);
+        }
+
+        void remove (int handle)
+        {
+            change (handle, 0, EVFILT_READ, EV_DELETE);
+            change (handle, 0, EVFILT_WRITE, EV_DELETE);
+        }
+
+        void wake()
+        {
+            struct kevent trigger;
+            EV_SET (&trigger, 0, EVFILT_USER, 0, NOTE_TRIGGER, 0, nullptr);
+            kevent (queueHandle, &trigger, 1, nullptr, 0, nullptr);
+        }
+
+        bool wait (std::vector<Event>& results)
+        {
+            struct kevent events[maxEventsPerWait];
+            const auto numEvents = kevent (queueHandle, nullptr, 0, events, maxEventsPerWait, nullptr);
+
+            if (numEvents < 0)
+                return errno == EINTR;
+
+            for (int i = 0; i < numEvents; ++i)
+            {
+                const auto& event = events[i];
+
+                if (event.filter == EVFILT_USER)
+                    continue;
+
+                auto eventFlags = event.filter == EVFILT_WRITE ? (int) SocketReactor::writable
+                                                               : (int) SocketReactor::readable;
+
+                if ((event.flags & (EV_EOF | EV_ERROR)) != 0)
+                    eventFlags |= SocketReactor::hungUp;
+
+                results.push_back ({ (int) event.ident, (uint32) (pointer_sized_uint) event.udata, eventFlags });
+            }
+
+            return true;
+        }
+
+    private:
+        bool change (int handle, uint32 id, int16_t filter, uint16_t flags)
+        {
+            struct kevent change;
+            EV_SET (&change, (uintptr_t) handle, filter, flags, 0, 0, (void*) (pointer_sized_uint) id);
+            return kevent (queueHandle, &change, 1, nullptr, 0, nullptr) == 0;
+        }
+
+        int queueHandle = kqueue();
+    };
+
+   #else
+    // IOCP completes operations rather than reporting readiness, which doesn't fit the
+    // read/write model of the socket classes, so Windows uses WSAPoll
+    class Poller
+    {
+    public:
+        Poller()
+        {
+            SocketHelpers::initSockets();
+
+            // WSAPoll can only wait on sockets, so a loopback datagram socket that sends
+            // to itself is used to wake it up
+            wakeSocket = socket (AF_INET, SOCK_DGRAM, 0);
+
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+            int addressLength = sizeof (address);
+
+            bind (wakeSocket, (sockaddr*) &address, addressLength);
+            getsockname (wakeSocket, (sockaddr*) &address, &addressLength);
+            connect (wakeSocket, (sockaddr*) &address, addressLength);
+            SocketHelpers::setSocketBlockingState (wakeSocket, false);
+        }
+
+        ~Poller()
+        {
+            closesocket (wakeSocket);
+        }
+
+        bool add (int handle, uint32 id, bool wantsWrite)
+        {
+            {
+                const ScopedLock sl (lock);
+                sockets.push_back ({ handle, id, wantsWrite });
+            }
+
+            wake();
+            return true;
+        }
+
+        void modify (int handle, uint32, bool wantsWrite)
+        {
+            {
+                const ScopedLock sl (lock);
+
+                for (auto& s : sockets)
+                    if (s.handle == handle)
+                        s.wantsWrite = wantsWrite;
+            }
+
+            wake();
+        }
+
+        void remove (int handle)
+        {
+            {
+                const ScopedLock sl (lock);
+                sockets.erase (std::remove_if (sockets.begin(), sockets.end(), [handle] (const auto& s) { return s.handle == handle; }),
+                               sockets.end());
+            }
+
+            wake();
+        }
+
+        void wake()
+        {
+            const char byte = 0;
+            ::send (wakeSocket, &byte, 1, 0);
+        }
+
+        bool wait (std::vector<Event>& results)
+        {
+            {
+                const ScopedLock sl (lock);
+                waitingSockets = sockets;
+            }
+
+            pollHandles.clear();
+            pollHandles.push_back ({ wakeSocket, POLLRDNORM, 0 });
+
+            for (auto& s : waitingSockets)
+                pollHandles.push_back ({ (SocketHandle) s.handle, (SHORT) (POLLRDNORM | (s.wantsWrite ? POLLWRNORM : 0)), 0 });
+
+            if (WSAPoll (pollHandles.data(), (ULONG) pollHandles.size(), -1) == SOCKET_ERROR)
+                return false;
+
+            if (pollHandles[0].revents != 0)
+            {
+                char buffer[64];
+
+                while (::recv (wakeSocket, buffer, (int) sizeof (buffer), 0) > 0)
+                {}
+            }
+
+            for (size_t i = 1; i < pollHandles.size(); ++i)
+            {
+                const auto flags = pollHandles[i].revents;
+                int eventFlags = 0;
+
+                if ((flags & (POLLRDNORM | POLLHUP | POLLERR)) != 0)   eventFlags |= SocketReactor::readable;
+                if ((flags & POLLWRNORM) != 0)                         eventFlags |= SocketReactor::writable;
+                if ((flags & (POLLHUP | POLLERR)) != 0)                eventFlags |= SocketReactor::hungUp;
+
+                if (eventFlags != 0)
+                    results.push_back ({ waitingSockets[i - 1].handle, waitingSockets[i - 1].id, eventFlags });
+            }
+
+            return true;
+        }
+
+    private:
+        struct WatchedSocket
+        {
+            int handle;
+            uint32 id;
+            bool wantsWrite;
+        };
+
+        CriticalSection lock;
+        std::vector<WatchedSocket> sockets, waitingSockets;
+        std::vector<WSAPOLLFD> pollHandles;
+        SocketHandle wakeSocket;
+    };
+   #endif
+}
+
+//==============================================================================
+class SocketReactor::IOThread final : public Thread
+{
+public:
+    explicit IOThread (SocketReactor& r)
+        : Thread ("JUCE Socket Reactor"), owner (r)
+    {
+        startThread();
+    }
+
+    ~IOThread() override
+    {
+        signalThreadShouldExit();
+        poller.wake();
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        std::vector<SocketReactorHelpers::Event> events;
+        events.reserve (SocketReactorHelpers::maxEventsPerWait);
+
+        while (! threadShouldExit())
+        {
+            events.clear();
+
+            if (! poller.wait (events))
+                break;
+
+            for (auto& event : events)
+                if (auto registration = owner.findRegistration (event.handle, event.id))
+                    dispatch (*registration, event.flags);
+        }
+    }
+
+    SocketReactor& owner;
+    SocketReactorHelpers::Poller poller;
+    int numSockets = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IOThread)
+};
+
+//==============================================================================
+SocketReactor::SocketReactor (int numThreads)
+{
+    for (int i = jmax (1, numThreads); --i >= 0;)
+        threads.push_back (std::make_unique<IOThread> (*this));
+}
+
+SocketReactor::~SocketReactor()
+{
+    threads.clear();
+    registrations.clear();
+}
+
+bool SocketReactor::addSocket (int socketHandle, Callback callback, bool wantsWriteEvents)
+{
+    if (socketHandle < 0 || callback == nullptr)
+        return false;
+
+    const ScopedLock sl (lock);
+
+    if (registrations.find (socketHandle) != registrations.end())
+        return false;
+
+    auto* thread = std::min_element (threads.begin(), threads.end(),
+                                     [] (const auto& a, const auto& b) { return a->numSockets < b->numSockets; })->get();
+
+    auto registration = std::make_shared<Registration>();
+    registration->handle = socketHandle;
+    registration->id = nextID++;
+
+    if (nextID == 0)
+        nextID = 1;
+    registration->callback = std::move (callback);
+    registration->thread = thread;
+
+    if (! thread->poller.add (socketHandle, registration->id, wantsWriteEvents))
+        return false;
+
+    ++thread->numSockets;
+    registrations[socketHandle] = std::move (registration);
+    return true;
+}
+
+void SocketReactor::setWantsWriteEvents (int socketHandle, bool wantsWriteEvents)
+{
+    const ScopedLock sl (lock);
+    auto found = registrations.find (socketHandle);
+
+    if (found != registrations.end())
+        found->second->thread->poller.modify (socketHandle, found->second->id, wantsWriteEvents);
+}
+
+void SocketReactor::removeSocket (int socketHandle)
+{
+    std::shared_ptr<Registration> registration;
+
+    {
+        const ScopedLock sl (lock);
+        auto found = registrations.find (socketHandle);
+
+        if (found == registrations.end())
+            return;
+
+        registration = found->second;
+        registrations.erase (found);
+        registration->thread->poller.remove (socketHandle);
+        --registration->thread->numSockets;
+    }
+
+    // Waits for the callback to finish if it's running on another thread
+    const ScopedLock sl (registration->callbackLock);
+    registration->removed = true;
+}
+
+int SocketReactor::getNumSockets() const
+{
+    const ScopedLock sl (lock);
+    return (int) registrations.size();
+}
+
+int SocketReactor::getNumThreads() const noexcept
+{
+    return (int) threads.size();
+}
+
+std::shared_ptr<SocketReactor::Registration> SocketReactor::findRegistration (int socketHandle, uint32 id) const
+{
+    const ScopedLock sl (lock);
+    auto found = registrations.find (socketHandle);
+
+    if (found != registrations.end() && found->second->id == id)
+        return found->second;
+
+    return {};
+}
+
+void SocketReactor::dispatch (Registration& registration, int eventFlags)
+{
+    const ScopedLock sl (registration.callbackLock);
+
+    if (! registration.removed)
+        registration.callback (eventFlags);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SocketReactorTests final : public UnitTest
+{
+public:
+    SocketReactorTests()
+        : UnitTest ("SocketReactor", UnitTestCategories::networking)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Many connections are served by a few threads");
+        {
+            SocketReactor reactor (2);
+            expectEquals (reactor.getNumThreads(), 2);
+
+            StreamingSocket listener;
+            expect (listener.createListener (0, "127.0.0.1"));
+
+            constexpr int numClients = 20;
+            OwnedArray<StreamingSocket> clients, serverSides;
+            std::atomic<int> numBytesReceived { 0 }, numHangUps { 0 };
+            WaitableEvent allReceived, allHungUp;
+
+            for (int i = 0; i < numClients; ++i)
+            {
+                auto* client = clients.add (new StreamingSocket());
+                expect (client->connect ("127.0.0.1", listener.getBoundPort()));
+
+                auto* serverSide = serverSides.add (listener.waitForNextConnection());
+                expect (serverSide != nullptr);
+
+                expect (reactor.addSocket (serverSide->getRawSocketHandle(), [&, serverSide] (int events)
+                {
+                    char buffer[64];
+                    auto numRead = serverSide->read (buffer, (int) sizeof (buffer), false);
+
+                    if (numRead > 0 && (numBytesReceived += numRead) == numClients * 3)
+                        allReceived.signal();
+
+                    if (numRead <= 0 && (events & SocketReactor::readable) != 0)
+                    {
+                        reactor.removeSocket (serverSide->getRawSocketHandle());
+
+                        if (++numHangUps == numClients)
+                            allHungUp.signal();
+                    }
+                }));
+            }
+
+            expect (! reactor.addSocket (serverSides[0]->getRawSocketHandle(), [] (int) {}));
+            expectEquals (reactor.getNumSockets(), numClients);
+
+            for (auto* client : clients)
+                expectEquals (client->write ("abc", 3), 3);
+
+            expect (allReceived.wait (5000));
+            expectEquals (numBytesReceived.load(), numClients * 3);
+
+            for (auto* client : clients)
+                client->close();
+
+            expect (allHungUp.wait (5000));
+            expectEquals (reactor.getNumSockets(), 0);
+        }
+
+        beginTest ("Write events are only reported when asked for");
+        {
+            SocketReactor reactor (1);
+
+            StreamingSocket listener;
+            expect (listener.createListener (0, "127.0.0.1"));
+
+            StreamingSocket client;
+            expect (client.connect ("127.0.0.1", listener.getBoundPort()));
+            std::unique_ptr<StreamingSocket> serverSide (listener.waitForNextConnection());
+            expect (serverSide != nullptr);
+
+            std::atomic<int> numWriteEvents { 0 };
+            WaitableEvent writable;
+
+            expect (reactor.addSocket (client.getRawSocketHandle(), [&] (int events)
+            {
+                if ((events & SocketReactor::writable) != 0)
+                {
+                    ++numWriteEvents;
+                    reactor.setWantsWriteEvents (client.getRawSocketHandle(), false);
+                    writable.signal();
+                }
+            }));
+
+            Thread::sleep (20);
+            expectEquals (numWriteEvents.load(), 0);
+
+            reactor.setWantsWriteEvents (client.getRawSocketHandle(), true);
+            expect (writable.wait (5000));
+            Thread::sleep (20);
+            expectEquals (numWriteEvents.load(), 1);
+
+            expectEquals (client.writeWithoutBlocking ("hello", 5), 5);
+
+            char buffer[5];
+            expectEquals (serverSide->read (buffer, 5, true), 5);
+
+            reactor.removeSocket (client.getRawSocketHandle());
+            expectEquals (reactor.getNumSockets(), 0);
+        }
+    }
+};
+
+static SocketReactorTests socketReactorTests;
+
+#endif
+#endif
+
+} // namespace juce
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Watches a set of sockets on a few shared I/O threads, and calls you back when
+    they're ready to be read or written.
+
+    This lets a server look after hundreds of connections without needing a thread
+    for each one. It uses epoll on Linux and Android, kqueue on macOS, iOS and BSD,
+    and WSAPoll on Windows.
+
+    Each socket is looked after by one of the reactor's threads, so the callbacks for
+    a particular socket are never made concurrently, but callbacks for different
+    sockets may be. The callbacks are level-triggered: if a socket still has unread
+    data after its callback returns, the callback will be made again.
+
+    Callbacks should do their work without blocking, e.g. using
+    StreamingSocket::read() with blockUntilSpecifiedAmountHasArrived set to false, and
+    StreamingSocket::writeWithoutBlocking(). A listening StreamingSocket can also be
+    added, in which case it becomes readable when a client is waiting to be accepted
+    with waitForNextConnection().
+
+    @code
+    SocketReactor reactor;
+
+    reactor.addSocket (socket.getRawSocketHandle(), [&] (int events)
+    {
+        char buffer[4096];
+
+        if ((events & SocketReactor::readable) != 0)
+        {
+            auto numRead = socket.read (buffer, sizeof (buffer), false);
+
+            if (numRead > 0)
+                handleData (buffer, numRead);
+            else if ((events & SocketReactor::hungUp) != 0)
+                reactor.removeSocket (socket.getRawSocketHandle());
+        }
+    });
+    @endcode
+
+    @see StreamingSocket, DatagramSocket, InterprocessConnection::setSocketReactor
+
+    @tags{Core}
+*/
+class JUCE_API  SocketReactor
+{
+public:
+    //==============================================================================
+    /** Creates a reactor that uses the given number of I/O threads. */
+    explicit SocketReactor (int numThreads = 2);
+
+    /** Destructor.
+        Any sockets that are still registered are removed, but not closed.
+    */
+    ~SocketReactor();
+
+    //==============================================================================
+    /** The flags that are passed to a Callback. */
+    enum EventFlags
+    {
+        readable    = 1,    /**< There's data to read, a client to accept, or the socket has been closed. */
+        writable    = 2,    /**< The socket can accept more data. Only reported if it was asked for. */
+        hungUp      = 4     /**< The other end has closed the connection, or an error occurred. */
+    };
+
+    /** The function that's called when a socket is ready. It's given a combination of EventFlags. */
+    using Callback = std::function<void (int eventFlags)>;
+
+    /** Starts watching a socket.
+
+        The socket handle is the one returned by StreamingSocket::getRawSocketHandle() or
+        DatagramSocket::getRawSocketHandle(). The callback will be made on one of the
+        reactor's threads whenever the socket is readable, and also when it's writable if
+        wantsWriteEvents is true.
+
+        @returns false if the handle is invalid or is already registered
+    */
+    bool addSocket (int socketHandle, Callback callback, bool wantsWriteEvents = false);
+
+    /** Changes whether the callback for a socket will be told when it's writable.
+
+        Typically you'd turn this on when a non-blocking write couldn't send everything,
+        and off again once the pending data has gone.
+    */
+    void setWantsWriteEvents (int socketHandle, bool wantsWriteEvents);
+
+    /** Stops watching a socket.
+
+        When this returns, the socket's callback isn't running and won't be called again,
+        unless this is called from inside that callback, in which case that call is the
+        last one. Remove a socket before closing it, because the OS may reuse the handle.
+
+        Don't call this from one socket's callback to remove a different socket, as two
+        callbacks doing that to each other at the same time would deadlock.
+    */
+    void removeSocket (int socketHandle);
+
+    /** Returns the number of sockets that are currently registered. */
+    int getNumSockets() const;
+
+    /** Returns the number of I/O threads this reactor is using. */
+    int getNumThreads() const noexcept;
+
+private:
+    //==============================================================================
+    struct Registration;
+    class IOThread;
+
+    std::shared_ptr<Registration> findRegistration (int socketHandle, uint32 id) const;
+    static void dispatch (Registration&, int eventFlags);
+
+    mutable CriticalSection lock;
+    std::map<int, std::shared_ptr<Registration>> registrations;
+    std::vector<std::unique_ptr<IOThread>> threads;
+    uint32 nextID = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SocketReactor)
+};
+
+} // namespace juce
@@ -29,13 +29,17 @@ struct FallbackDownloadTask final : public URL::DownloadTask,
     FallbackDownloadTask (std::unique_ptr<FileOutputStream> outputStreamToUse,
                           size_t bufferSizeToUse,
                           std::unique_ptr<WebInputStream> streamToUse,
-                          URL::DownloadTask::Listener* listenerToUse)
+                          const URL& urlToUse,
+                          const URL::DownloadTaskOptions& optionsToUse)
         : Thread ("DownloadTask thread"),
           fileStream (std::move (outputStreamToUse)),
           stream (std::move (streamToUse)),
+          url (urlToUse),
+          extraHeaders (optionsToUse.extraHeaders),
           bufferSize (bufferSizeToUse),
           buffer (bufferSize),
-          listener (listenerToUse)
+          listener (optionsToUse.listener),
+          numRanges (getNumRangesToUse (*stream, optionsToUse))
     {
         jassert (fileStream != nullptr);
         jassert (stream != nullptr);
@@ -57,51 +61,217 @@ struct FallbackDownloadTask final : public URL::DownloadTask,
     //==============================================================================
     void run() override
     {
+        if (numRanges > 1)
+            downloadRanges();
+        else
+            downloadStream (contentLength);
+
+        fileStream.reset();
+
+        // When downloading ranges, the main stream is cancelled once it has read the first one
+        if (threadShouldExit() || (numRanges <= 1 && stream->isError()))
+            error = true;
+
+        if (contentLength > 0 && downloaded < contentLength)
+            error = true;
+
+        finished = true;
+
+        if (listener != nullptr && ! threadShouldExit())
+            listener->finished (this, ! error);
+    }
+
+private:
+    // Reads up to the given number of bytes from the main stream into the start of the file
+    void downloadStream (int64 numBytesWanted)
+    {
+        int64 numRead = 0;
+
         while (! (stream->isExhausted() || stream->isError() || threadShouldExit()))
         {
             if (listener != nullptr)
                 listener->progress (this, downloaded, contentLength);
 
-            auto max = (int) jmin ((int64) bufferSize, contentLength < 0 ? std::numeric_limits<int64>::max()
-                                                                         : static_cast<int64> (contentLength - downloaded));
+            auto max = (int) jmin ((int64) bufferSize, numBytesWanted < 0 ? std::numeric_limits<int64>::max()
+                                                                          : static_cast<int64> (numBytesWanted - numRead));
 
             auto actual = stream->read (buffer.get(), max);
 
             if (actual < 0 || threadShouldExit() || stream->isError())
                 break;
 
-            if (! fileStream->write (buffer.get(), static_cast<size_t> (actual)))
+            if (! writeToFile (numRead, buffer.get(), static_cast<size_t> (actual)))
             {
                 error = true;
                 break;
             }
 
-            downloaded += actual;
+            numRead += actual;
+            updateDownloadedCount (numRead);
 
-            if (downloaded == contentLength)
+            if (numRead == numBytesWanted)
                 break;
         }
+    }
 
-        fileStream.reset();
+    //==============================================================================
+    /*  Fetches one part of the file with a request for a range of bytes. */
+    struct RangeDownload final : public Thread
+    {
+        RangeDownload (FallbackDownloadTask& ownerToUse, int64 startToUse, int64 endToUse)
+            : Thread ("DownloadTask range thread"),
+              owner (ownerToUse), start (startToUse), end (endToUse)
+        {
+            startThread();
+        }
 
-        if (threadShouldExit() || stream->isError())
-            error = true;
+        ~RangeDownload() override
+        {
+            signalThreadShouldExit();
 
-        if (contentLength > 0 && downloaded < contentLength)
+            {
+                const ScopedLock sl (streamLock);
+
+                if (rangeStream != nullptr)
+                    rangeStream->cancel();
+            }
+
+            waitForThreadToExit (-1);
+        }
+
+        void run() override
+        {
+            auto newStream = std::make_unique<WebInputStream> (owner.url, false);
+            newStream->withExtraHeaders (owner.extraHeaders);
+            newStream->withExtraHeaders ("Range: bytes=" + String (start) + "-" + String (end - 1));
+
+            {
+                const ScopedLock sl (streamLock);
+
+                if (threadShouldExit())
+                    return;
+
+                rangeStream = std::move (newStream);
+            }
+
+            // A server that ignores the range will send the whole file, with a code of 200
+            if (! rangeStream->connect (nullptr) || rangeStream->getStatusCode() != 206)
+            {
+                failed = true;
+                return;
+            }
+
+            HeapBlock<char> rangeBuffer (owner.bufferSize);
+            auto position = start;
+
+            while (position < end && ! threadShouldExit())
+            {
+                const auto actual = rangeStream->read (rangeBuffer.get(), (int) jmin ((int64) owner.bufferSize, end - position));
+
+                if (actual <= 0 || rangeStream->isError()
+                     || ! owner.writeToFile (position, rangeBuffer.get(), (size_t) actual))
+                    break;
+
+                position += actual;
+                received = position - start;
+            }
+
+            failed = (position != end);
+        }
+
+        FallbackDownloadTask& owner;
+        const int64 start, end;
+        CriticalSection streamLock;
+        std::unique_ptr<WebInputStream> rangeStream;
+        std::atomic<int64> received { 0 };
+        std::atomic<bool> failed { false };
+    };
+
+    void downloadRanges()
+    {
+        const auto rangeSize = contentLength / numRanges;
+
+        // The stream that's already open fetches the first part, and the rest are requested
+        // separately, each on its own thread
+        for (int i = 1; i < numRanges; ++i)
+            ranges.push_back (std::make_unique<RangeDownload> (*this,
+                                                               rangeSize * i,
+                                                               i == numRanges - 1 ? contentLength : rangeSize * (i + 1)));
+
+        downloadStream (rangeSize);
+        const auto firstRangeComplete = (firstRangeReceived == rangeSize);
+        stream->cancel();
+
+        for (;;)
+        {
+            const auto allDone = std::none_of (ranges.begin(), ranges.end(),
+                                               [] (const auto& r) { return r->isThreadRunning(); });
+
+            updateDownloadedCount (firstRangeReceived);
+
+            if (listener != nullptr)
+                listener->progress (this, downloaded, contentLength);
+
+            if (allDone || threadShouldExit())
+                break;
+
+            wait (20);
+        }
+
+        const auto anyFailed = std::any_of (ranges.begin(), ranges.end(),
+                                            [] (const auto& r) { return r->failed.load(); });
+
+        ranges.clear();
+
+        if (anyFailed || ! firstRangeComplete)
             error = true;
+    }
 
-        finished = true;
+    void updateDownloadedCount (int64 firstRangeBytes)
+    {
+        firstRangeReceived = firstRangeBytes;
+        auto total = firstRangeBytes;
 
-        if (listener != nullptr && ! threadShouldExit())
-            listener->finished (this, ! error);
+        for (auto& r : ranges)
+            total += r->received;
+
+        downloaded = total;
+    }
+
+    bool writeToFile (int64 position, const void* data, size_t numBytes)
+    {
+        const ScopedLock sl (fileLock);
+        return fileStream->setPosition (position) && fileStream->write (data, numBytes);
+    }
+
+    static int getNumRangesToUse (WebInputStream& s, const URL::DownloadTaskOptions& options)
+    {
+        // Below this size, the time taken to set up the extra connections isn't worth it
+        constexpr int64 minimumRangeSize = 1024 * 1024;
+
+        const auto length = s.getTotalLength();
+
+        if (options.numParallelRanges <= 1 || options.usePost || length < 2 * minimumRangeSize
+             || s.getStatusCode() != 200
+             || ! s.getResponseHeaders()["Accept-Ranges"].containsIgnoreCase ("bytes"))
+            return 1;
+
+        return (int) jmin ((int64) options.numParallelRanges, length / minimumRangeSize);
     }
 
     //==============================================================================
     std::unique_ptr<FileOutputStream> fileStream;
     const std::unique_ptr<WebInputStream> stream;
+    const URL url;
+    const String extraHeaders;
     const size_t bufferSize;
     HeapBlock<char> buffer;
     URL::DownloadTask::Listener* const listener;
+    const int numRanges;
+
+    CriticalSection fileLock;
+    std::vector<std::unique_ptr<RangeDownload>> ranges;
+    int64 firstRangeReceived = 0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FallbackDownloadTask)
 };
@@ -125,7 +295,8 @@ std::unique_ptr<URL::DownloadTask> URL::DownloadTask::createFallbackDownloader (
             return std::make_unique<FallbackDownloadTask> (std::move (outputStream),
                                                            bufferSize,
                                                            std::move (stream),
-                                                           options.listener);
+                                                           urlToUse,
+                                                           options);
     }
 
     return nullptr;
@@ -463,6 +463,7 @@ public:
         String sharedContainer;
         DownloadTaskListener* listener = nullptr;
         bool usePost = false;
+        int numParallelRanges = 1;
 
         /** Specifies headers to add to the request. */
         [[nodiscard]] auto withExtraHeaders (String value) const            { return with (&DownloadTaskOptions::extraHeaders, std::move (value)); }
@@ -482,6 +483,15 @@ public:
         /** Specifies whether a post command should be used. */
         [[nodiscard]] auto withUsePost (bool value) const                   { return with (&DownloadTaskOptions::usePost, value); }
 
+        /** Allows a large file to be fetched as several ranges of bytes at once, each
+            over its own connection.
+
+            This is only done if the server says that it accepts range requests, and the
+            file is at least a couple of megabytes long. Otherwise, or on iOS, the file is
+            downloaded in one piece.
+        */
+        [[nodiscard]] auto withNumParallelRanges (int value) const          { return with (&DownloadTaskOptions::numParallelRanges, value); }
+
     private:
         template <typename Member, typename Value>
         [[nodiscard]] DownloadTaskOptions with (Member&& member, Value&& value) const
@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+ThreadedOutputStream::ThreadedOutputStream (OutputStream* destinationStream,
+                                            bool deleteDestinationWhenDestroyed,
+                                            TimeSliceThread& backgroundThread,
+                                            int blockSizeBytes,
+                                            int numBlocksToUse)
+    : destination (destinationStream, deleteDestinationWhenDestroyed),
+      thread (backgroundThread),
+      blockSize ((size_t) (jmax (1, blockSizeBytes) + 4095) & ~(size_t) 4095),
+      numBlocks (jmax (2, numBlocksToUse)),
+      storage (blockSize * (size_t) numBlocks + 4095),
+      blockBytesUsed ((size_t) numBlocks)
+{
+    jassert (destination != nullptr);
+    jassert (thread.isThreadRunning()); // the thread needs to be running before data is written
+
+    firstBlock = snapPointerToAlignment (storage.get(), (size_t) 4096);
+    position = destination->getPosition();
+
+    pendingBlocks.reserve ((size_t) numBlocks);
+    freeBlocks.reserve ((size_t) numBlocks);
+
+    for (int i = numBlocks; --i >= 0;)
+        freeBlocks.push_back (i);
+
+    thread.addTimeSliceClient (this);
+}
+
+ThreadedOutputStream::~ThreadedOutputStream()
+{
+    thread.removeTimeSliceClient (this);
+    writeAllPendingBlocks();
+}
+
+//==============================================================================
+void ThreadedOutputStream::flush()
+{
+    writeAllPendingBlocks();
+
+    const ScopedLock sl (destinationLock);
+    destination->flush();
+}
+
+bool ThreadedOutputStream::setPosition (int64 newPosition)
+{
+    if (newPosition == position)
+        return true;
+
+    writeAllPendingBlocks();
+
+    const ScopedLock sl (destinationLock);
+    const auto ok = destination->setPosition (newPosition);
+    position = destination->getPosition();
+    return ok;
+}
+
+int64 ThreadedOutputStream::getPosition()
+{
+    return position;
+}
+
+bool ThreadedOutputStream::write (const void* dataToWrite, size_t numberOfBytes)
+{
+    jassert (dataToWrite != nullptr || numberOfBytes == 0);
+
+    auto* source = static_cast<const char*> (dataToWrite);
+
+    while (numberOfBytes > 0)
+    {
+        if (currentBlock < 0)
+        {
+            currentBlock = getFreeBlock();
+            currentBlockUsed = 0;
+        }
+
+        const auto numToCopy = jmin (numberOfBytes, blockSize - currentBlockUsed);
+        memcpy (firstBlock + (size_t) currentBlock * blockSize + currentBlockUsed, source, numToCopy);
+
+        currentBlockUsed += numToCopy;
+        source += numToCopy;
+        numberOfBytes -= numToCopy;
+        position += (int64) numToCopy;
+
+        if (currentBlockUsed == blockSize)
+            queueCurrentBlock();
+    }
+
+    return ! failed;
+}
+
+//==============================================================================
+int ThreadedOutputStream::useTimeSlice()
+{
+    return writeNextPendingBlock() ? 0 : 100;
+}
+
+int ThreadedOutputStream::getFreeBlock()
+{
+    for (bool hasStalled = false;; hasStalled = true)
+    {
+        {
+            const ScopedLock sl (queueLock);
+
+            if (! freeBlocks.empty())
+            {
+                const auto block = freeBlocks.back();
+                freeBlocks.pop_back();
+                return block;
+            }
+        }
+
+        if (! hasStalled)
+            ++numStalls;
+
+        // Every block is waiting for the destination, so rather than waiting for the
+        // background thread, write the oldest one from this thread
+        writeNextPendingBlock();
+    }
+}
+
+void ThreadedOutputStream::queueCurrentBlock()
+{
+    if (currentBlock < 0 || currentBlockUsed == 0)
+        return;
+
+    {
+        const ScopedLock sl (queueLock);
+        blockBytesUsed[(size_t) currentBlock] = currentBlockUsed;
+        pendingBlocks.push_back (currentBlock);
+    }
+
+    ++numPendingBlocks;
+    currentBlock = -1;
+    thread.notify();
+}
+
+bool ThreadedOutputStream::writeNextPendingBlock()
+{
+    // Holding this lock for the whole write keeps the blocks in order if the background
+    // thread and the thread calling write() both try to write one
+    const ScopedLock dl (destinationLock);
+    int block = -1;
+
+    {
+        const ScopedLock sl (queueLock);
+
+        if (pendingBlocks.empty())
+            return false;
+
+        block = pendingBlocks.front();
+    }
+
+    if (! destination->write (firstBlock + (size_t) block * blockSize, blockBytesUsed[(size_t) block]))
+        failed = true;
+
+    {
+        const ScopedLock sl (queueLock);
+        pendingBlocks.erase (pendingBlocks.begin());
+        freeBlocks.push_back (block);
+    }
+
+    --numPendingBlocks;
+    return true;
+}
+
+bool ThreadedOutputStream::writeAllPendingBlocks()
+{
+    queueCurrentBlock();
+
+    while (writeNextPendingBlock())
+    {}
+
+    return ! failed;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ThreadedOutputStreamTests final : public UnitTest
+{
+    ThreadedOutputStreamTests()
+        : UnitTest ("ThreadedOutputStream", UnitTestCategories::streams)
+    {}
+
+    void runTest() override
+    {
+        TimeSliceThread thread ("ThreadedOutputStream test");
+        thread.startThread();
+
+        auto r = getRandom();
+
+        beginTest ("Writes reach the destination in order");
+        {
+            MemoryBlock source (100000);
+            r.fillBitsRandomly (source.getData(), source.getSize());
+
+            MemoryOutputStream destination;
+
+            {
+                ThreadedOutputStream stream (&destination, false, thread, 4096, 3);
+
+                for (size_t pos = 0; pos < source.getSize();)
+                {
+                    const auto num = jmin ((size_t) r.nextInt (9000), source.getSize() - pos);
+                    expect (stream.write (addBytesToPointer (source.getData(), pos), num));
+                    pos += num;
+                    expectEquals (stream.getPosition(), (int64) pos);
+                }
+
+                // Overwrite the start, as a file format writer does when it updates its header
+                expect (stream.setPosition (0));
+                expect (stream.writeInt (0x12345678));
+                source.copyFrom ("\x78\x56\x34\x12", 0, 4);
+            }
+
+            expect (destination.getMemoryBlock() == source);
+        }
+
+        beginTest ("Full blocks are counted until they've been written");
+        {
+            struct BlockingStream final : public MemoryOutputStream
+            {
+                bool write (const void* data, size_t numBytes) override
+                {
+                    unblock.wait();
+                    return MemoryOutputStream::write (data, numBytes);
+                }
+
+                WaitableEvent unblock { true };
+            };
+
+            BlockingStream destination;
+            ThreadedOutputStream stream (&destination, false, thread, 4096, 2);
+
+            HeapBlock<char> block (4096, true);
+            stream.write (block, 4096);
+            stream.write (block, 4096);
+
+            expectEquals (stream.getNumPendingBlocks(), 2);
+            expectEquals (stream.getNumStalls(), 0);
+            expectEquals ((int) destination.getDataSize(), 0);
+
+            destination.unblock.signal();
+            stream.write (block, 4096);
+            stream.flush();
+
+            expectEquals (stream.getNumPendingBlocks(), 0);
+            expectEquals ((int) destination.getDataSize(), 3 * 4096);
+        }
+
+        beginTest ("Failed writes are reported");
+        {
+            struct FailingStream final : public MemoryOutputStream
+            {
+                bool write (const void*, size_t) override  { return false; }
+            };
+
+            FailingStream destination;
+            ThreadedOutputStream stream (&destination, false, thread, 4096, 2);
+
+            HeapBlock<char> block (4096, true);
+            stream.write (block, 4096);
+            stream.flush();
+
+            expect (stream.hasFailed());
+            expect (! stream.write (block, 10));
+        }
+    }
+};
+
+static ThreadedOutputStreamTests threadedOutputStreamTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Wraps another output stream, and writes to it from a background thread.
+
+    Data passed to write() is copied into one of a set of large, page-aligned
+    blocks. Each time a block fills up it's queued, and a TimeSliceThread writes it
+    to the destination stream while the caller carries on filling the next block.
+    This means that the thread producing the data isn't held up by the disk unless
+    every block is waiting to be written.
+
+    That situation is backpressure from the disk, and the caller can watch for it
+    with getNumPendingBlocks() and getNumStalls(). When it happens, write() writes
+    the oldest pending block itself before continuing, so no data is ever dropped.
+
+    This is intended for recording, where a single FileOutputStream that's written
+    directly by an AudioFormatWriter can block the thread that's also servicing other
+    tracks. Several streams can share the same TimeSliceThread.
+
+    Because the destination is written later, a failed write is only reported by a
+    subsequent call to write(), flush() or setPosition(), or by hasFailed().
+
+    @see AudioFormatWriter::ThreadedWriter, TimeSliceThread
+
+    @tags{Core}
+*/
+class JUCE_API  ThreadedOutputStream  : public OutputStream,
+                                        private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates a ThreadedOutputStream.
+
+        @param destinationStream            the stream to write to
+        @param deleteDestinationWhenDestroyed  whether the destination should be deleted
+                                            by this object when it is itself deleted
+        @param backgroundThread             the thread that should write the blocks. This
+                                            must be running, and must outlive this object
+        @param blockSizeBytes               the size of each block. This is rounded up to a
+                                            multiple of 4096 bytes
+        @param numBlocks                    the number of blocks, which is the number of writes
+                                            that can be waiting for the destination at once
+    */
+    ThreadedOutputStream (OutputStream* destinationStream,
+                          bool deleteDestinationWhenDestroyed,
+                          TimeSliceThread& backgroundThread,
+                          int blockSizeBytes = 1 << 20,
+                          int numBlocks = 4);
+
+    /** Destructor.
+
+        This writes any data that's still pending, and may also delete the destination
+        stream, if that option was chosen when this stream was created.
+    */
+    ~ThreadedOutputStream() override;
+
+    //==============================================================================
+    /** Waits until all of the data that has been written so far has been passed to the
+        destination stream, and then flushes the destination.
+    */
+    void flush() override;
+
+    /** Waits until all of the pending data has been written, and then moves the
+        destination stream's position.
+    */
+    bool setPosition (int64 newPosition) override;
+
+    int64 getPosition() override;
+    bool write (const void* dataToWrite, size_t numberOfBytes) override;
+
+    //==============================================================================
+    /** Returns the number of full blocks that are waiting to be written, including any
+        block that's being written at the moment.
+    */
+    int getNumPendingBlocks() const noexcept        { return numPendingBlocks.load(); }
+
+    /** Returns the number of blocks that this stream was created with. */
+    int getNumBlocks() const noexcept               { return numBlocks; }
+
+    /** Returns the number of times that write() has found all of the blocks waiting
+        to be written, and had to write one itself.
+    */
+    int getNumStalls() const noexcept               { return numStalls.load(); }
+
+    /** Returns true if writing to the destination stream has failed. */
+    bool hasFailed() const noexcept                 { return failed.load(); }
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destination;
+    TimeSliceThread& thread;
+    const size_t blockSize;
+    const int numBlocks;
+
+    HeapBlock<char> storage;
+    char* firstBlock = nullptr;
+
+    CriticalSection queueLock, destinationLock;
+    std::vector<int> pendingBlocks, freeBlocks;
+    std::vector<size_t> blockBytesUsed;
+
+    int currentBlock = -1;
+    size_t currentBlockUsed = 0;
+    int64 position = 0;
+
+    std::atomic<int> numPendingBlocks { 0 }, numStalls { 0 };
+    std::atomic<bool> failed { false };
+
+    int useTimeSlice() override;
+    int getFreeBlock();
+    void queueCurrentBlock();
+    bool writeNextPendingBlock();
+    bool writeAllPendingBlocks();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThreadedOutputStream)
+};
+
+} // namespace juce
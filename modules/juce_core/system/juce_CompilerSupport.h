@@ -100,6 +100,13 @@
  #error "JUCE requires C++17 or later"
 #endif
 
+//==============================================================================
+#if defined (__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include (<coroutine>)
+ #define JUCE_COROUTINES_AVAILABLE 1
+#else
+ #define JUCE_COROUTINES_AVAILABLE 0
+#endif
+
 //==============================================================================
 #ifndef DOXYGEN
  // These are old flags that are now supported on all compatible build targets
@@ -81,6 +81,10 @@
 #include "juce_CompilerWarnings.h"
 #include "juce_PlatformDefs.h"
 
+#if JUCE_COROUTINES_AVAILABLE
+ #include <coroutine>
+#endif
+
 //==============================================================================
 // Now we'll include some common OS headers..
 JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4514 4245 4100)
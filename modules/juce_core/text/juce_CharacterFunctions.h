@@ -328,6 +328,15 @@ public:
                 {
                     if (numSigFigs >= maxSignificantDigits)
                         continue;
+
+                    // zeros between the decimal point and the first significant digit
+                    // only change the exponent
+                    if (numSigFigs == 0 && digit == 0)
+                    {
+                        leadingZeros = true;
+                        --extraExponent;
+                        continue;
+                    }
                 }
                 else
                 {
@@ -381,11 +390,11 @@ public:
         };
 
         c = *text;
+        auto exponent = extraExponent;
 
         if (c == 'e' || c == 'E')
         {
             const auto startOfExponent = text;
-            *writePtr++ = 'e';
             bool parsedExponentIsPositive = true;
 
             switch (*++text)
@@ -400,42 +409,38 @@ public:
                     break;
             }
 
-            int exponent = 0;
+            int parsedExponent = 0;
             const auto startOfExponentDigits = text;
 
             while (text.isDigit())
-            {
-                auto digit = (int) text.getAndAdvance() - '0';
-
-                if (digit != 0 || exponent != 0)
-                    exponent = (exponent * 10) + digit;
-            }
+                parsedExponent = jmin (100000, (parsedExponent * 10) + ((int) text.getAndAdvance() - '0'));
 
             if (text == startOfExponentDigits)
                 text = startOfExponent;
 
-            exponent = extraExponent + (parsedExponentIsPositive ? exponent : -exponent);
+            exponent += parsedExponentIsPositive ? parsedExponent : -parsedExponent;
+        }
+
+        if (exponent != 0)
+        {
+            // The digits in the buffer are somewhere between 0.1 and 1e18, so these limits leave room
+            // for denormalised values without the exponent needing more than three digits
+            if (exponent < -400)
+                return isNegative ? -0.0 : 0.0;
+
+            if (exponent > 400)
+                return isNegative ? -inf : inf;
+
+            *writePtr++ = 'e';
 
             if (exponent < 0)
             {
-                if (exponent < std::numeric_limits<double>::min_exponent10 - 1)
-                    return isNegative ? -0.0 : 0.0;
-
                 *writePtr++ = '-';
                 exponent = -exponent;
             }
-            else if (exponent > std::numeric_limits<double>::max_exponent10 + 1)
-            {
-                return isNegative ? -inf : inf;
-            }
 
             writeExponentDigits (exponent, writePtr);
         }
-        else if (extraExponent > 0)
-        {
-            *writePtr++ = 'e';
-            writeExponentDigits (extraExponent, writePtr);
-        }
 
        #if JUCE_WINDOWS
         static _locale_t locale = _create_locale (LC_ALL, "C");
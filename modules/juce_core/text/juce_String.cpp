@@ -57,6 +57,92 @@ struct StringHolder
 
 constexpr StringHolder emptyString;
 
+//==============================================================================
+/*  Most strings are short, so rather than going back to the allocator every time one is
+    created or destroyed, the holders for short strings all have the same capacity and are
+    recycled through a small cache of blocks on each thread.
+
+    (An inline buffer inside the String object itself would change its size, and would break
+    code such as Identifier which relies on copies of a String sharing the same text pointer.)
+*/
+class SmallStringBlocks
+{
+public:
+    static constexpr size_t numTextBytes = 24;
+    static constexpr size_t blockSize = offsetof (StringHolder, text) + numTextBytes;
+    static constexpr int maxCachedBlocks = 256;
+
+    static char* allocate()
+    {
+        auto& list = freeList;
+
+        if (auto* block = list.head)
+        {
+            list.head = block->next;
+            --list.numBlocks;
+            return reinterpret_cast<char*> (block);
+        }
+
+        return new char [blockSize];
+    }
+
+    static void free (char* bytes) noexcept
+    {
+        auto& list = freeList;
+
+        if (list.isShutDown || list.numBlocks >= maxCachedBlocks)
+        {
+            delete[] bytes;
+            return;
+        }
+
+        // this makes sure the blocks are freed when the thread exits
+        static thread_local Cleanup cleanup;
+        ignoreUnused (cleanup);
+
+        auto* block = reinterpret_cast<FreeBlock*> (bytes);
+        block->next = list.head;
+        list.head = block;
+        ++list.numBlocks;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    // This has a trivial destructor, so it remains usable for strings that are
+    // released after the cleanup has run, e.g. by static destructors.
+    struct FreeList
+    {
+        FreeBlock* head = nullptr;
+        int numBlocks = 0;
+        bool isShutDown = false;
+    };
+
+    struct Cleanup
+    {
+        ~Cleanup()
+        {
+            auto& list = freeList;
+            list.isShutDown = true;
+
+            while (auto* block = list.head)
+            {
+                list.head = block->next;
+                delete[] reinterpret_cast<char*> (block);
+            }
+
+            list.numBlocks = 0;
+        }
+    };
+
+    static thread_local FreeList freeList;
+};
+
+thread_local SmallStringBlocks::FreeList SmallStringBlocks::freeList;
+
 //==============================================================================
 class StringHolderUtils
 {
@@ -67,7 +153,12 @@ public:
     static CharPointerType createUninitialisedBytes (size_t numBytes)
     {
         numBytes = (numBytes + 3) & ~(size_t) 3;
-        auto* bytes = new char [sizeof (StringHolder) - sizeof (CharType) + numBytes];
+
+        if (numBytes <= SmallStringBlocks::numTextBytes)
+            numBytes = SmallStringBlocks::numTextBytes;
+
+        auto* bytes = numBytes == SmallStringBlocks::numTextBytes ? SmallStringBlocks::allocate()
+                                                                   : new char [offsetof (StringHolder, text) + numBytes];
         auto s = unalignedPointerCast<StringHolder*> (bytes);
         s->refCount = 0;
         s->allocatedNumBytes = numBytes;
@@ -160,8 +251,15 @@ public:
     static void release (StringHolder* const b) noexcept
     {
         if (! isEmptyString (b))
+        {
             if (--(b->refCount) == -1)
-                delete[] reinterpret_cast<char*> (b);
+            {
+                if (b->allocatedNumBytes == SmallStringBlocks::numTextBytes)
+                    SmallStringBlocks::free (reinterpret_cast<char*> (b));
+                else
+                    delete[] reinterpret_cast<char*> (b);
+            }
+        }
     }
 
     static void release (const CharPointerType text) noexcept
@@ -2185,6 +2283,8 @@ StringRef::StringRef (String::CharPointerType stringLiteral) noexcept  : text (s
 StringRef::StringRef (const String& string) noexcept   : text (string.getCharPointer()) {}
 StringRef::StringRef (const std::string& string)       : StringRef (string.c_str()) {}
 
+int StringRef::hashCode() const noexcept               { return (int) HashGenerator<uint32>::calculate (text); }
+
 //==============================================================================
 static String reduceLengthOfFloatString (const String& input)
 {
@@ -2957,6 +3057,41 @@ public:
             for (auto c : str)
                 expectEquals (c, parts[index++]);
         }
+
+        {
+            beginTest ("Short strings released on other threads");
+
+            // the holders of short strings are recycled per-thread, so make sure that
+            // ones created on one thread can be released and reused on another
+            std::vector<String> strings;
+
+            for (int i = 0; i < 1000; ++i)
+                strings.push_back ("s" + String (i));
+
+            std::thread other ([&strings]
+            {
+                for (auto& str : strings)
+                    str = str + "!";
+
+                strings.clear();
+
+                for (int i = 0; i < 1000; ++i)
+                    strings.push_back (String (i) + "?");
+            });
+
+            other.join();
+
+            for (int i = 0; i < 1000; ++i)
+                expectEquals (strings[(size_t) i], String (i) + "?");
+
+            String grown ("short");
+
+            for (int i = 0; i < 20; ++i)
+                grown << "abc";
+
+            expectEquals (grown.length(), 65);
+            expect (grown.endsWith ("abcabc") && grown.startsWith ("shortabc"));
+        }
     }
 };
 
@@ -26,8 +26,11 @@ namespace juce
 static const int minNumberOfStringsForGarbageCollection = 300;
 static const uint32 garbageCollectionInterval = 30000;
 
-
-StringPool::StringPool() noexcept  : lastGarbageCollectionTime (0) {}
+// Spreading the strings across shards means that threads adding different strings
+// rarely need the same lock
+static constexpr int numShards = 64;
+static constexpr int shardBits = 6;
+static_assert ((1 << shardBits) == numShards, "numShards must match shardBits");
 
 struct StartEndString
 {
@@ -57,44 +60,152 @@ static int compareStrings (const StartEndString& string1, const String& string2)
     return 0;
 }
 
-template <typename NewStringType>
-static String addPooledString (Array<String>& strings, const NewStringType& newString)
+// The strings are hashed by character rather than by byte, so that every type of
+// string gives the same result for the same text
+template <typename CharPointer>
+static uint32 hashCharacters (CharPointer text, CharPointer end) noexcept
 {
-    int start = 0;
-    int end = strings.size();
+    uint32 hash = 2166136261u;
 
-    while (start < end)
+    while (text != end)
     {
-        const String& startString = strings.getReference (start);
-        const int startComp = compareStrings (newString, startString);
+        const auto c = text.getAndAdvance();
 
-        if (startComp == 0)
-            return startString;
+        if (c == 0)
+            break;
 
-        const int halfway = (start + end) / 2;
+        hash = (hash ^ (uint32) c) * 16777619u;
+    }
 
-        if (halfway == start)
-        {
-            if (startComp > 0)
-                ++start;
+    return hash;
+}
 
-            break;
-        }
+static uint32 hashString (const String& s) noexcept             { return hashCharacters (s.getCharPointer(), String::CharPointerType (nullptr)); }
+static uint32 hashString (CharPointer_UTF8 s) noexcept          { return hashCharacters (s, CharPointer_UTF8 (nullptr)); }
+static uint32 hashString (const StartEndString& s) noexcept     { return hashCharacters (s.start, s.end); }
+
+//==============================================================================
+// An open-addressed hash set of strings, holding each string's hash alongside it
+// so that most mismatches are rejected without comparing any characters.
+struct StringPool::Shard
+{
+    SpinLock lock;
+    std::vector<String> strings;
+    std::vector<uint32> hashes;
+    int numStrings = 0;
+    uint32 lastGarbageCollectionTime = 0;
+
+    template <typename NewStringType>
+    const String* find (const NewStringType& s, uint32 hash) const noexcept
+    {
+        if (numStrings == 0)
+            return nullptr;
+
+        const auto mask = strings.size() - 1;
 
-        const String& halfwayString = strings.getReference (halfway);
-        const int halfwayComp = compareStrings (newString, halfwayString);
+        for (auto i = (size_t) hash & mask; strings[i].isNotEmpty(); i = (i + 1) & mask)
+            if (hashes[i] == hash && compareStrings (s, strings[i]) == 0)
+                return &strings[i];
 
-        if (halfwayComp == 0)
-            return halfwayString;
+        return nullptr;
+    }
+
+    const String& add (String&& newString, uint32 hash)
+    {
+        if ((size_t) (numStrings + 1) * 2 > strings.size())
+            resize (jmax ((size_t) 16, strings.size() * 2));
 
-        if (halfwayComp > 0)
-            start = halfway;
-        else
-            end = halfway;
+        ++numStrings;
+        return insert (std::move (newString), hash);
     }
 
-    strings.insert (start, newString);
-    return strings.getReference (start);
+    void garbageCollect()
+    {
+        // A string that is only referenced by the pool can't be copied by anyone else,
+        // so it's safe to check the count while holding the lock
+        std::vector<String> oldStrings;
+        std::vector<uint32> oldHashes;
+        oldStrings.swap (strings);
+        oldHashes.swap (hashes);
+
+        numStrings = 0;
+
+        for (auto& s : oldStrings)
+            if (s.isNotEmpty() && s.getReferenceCount() > 1)
+                ++numStrings;
+
+        strings.resize (numStrings > 0 ? (size_t) nextPowerOfTwo (numStrings * 2) : 0);
+        hashes.resize (strings.size());
+
+        for (size_t i = 0; i < oldStrings.size(); ++i)
+            if (oldStrings[i].isNotEmpty() && oldStrings[i].getReferenceCount() > 1)
+                insert (std::move (oldStrings[i]), oldHashes[i]);
+
+        lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+    }
+
+    void garbageCollectIfNeeded()
+    {
+        if (numStrings > minNumberOfStringsForGarbageCollection / numShards
+             && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
+            garbageCollect();
+    }
+
+private:
+    const String& insert (String&& newString, uint32 hash)
+    {
+        const auto mask = strings.size() - 1;
+        auto i = (size_t) hash & mask;
+
+        while (strings[i].isNotEmpty())
+            i = (i + 1) & mask;
+
+        strings[i] = std::move (newString);
+        hashes[i] = hash;
+        return strings[i];
+    }
+
+    void resize (size_t newSize)
+    {
+        std::vector<String> oldStrings (newSize);
+        std::vector<uint32> oldHashes (newSize);
+        oldStrings.swap (strings);
+        oldHashes.swap (hashes);
+
+        for (size_t i = 0; i < oldStrings.size(); ++i)
+            if (oldStrings[i].isNotEmpty())
+                insert (std::move (oldStrings[i]), oldHashes[i]);
+    }
+};
+
+//==============================================================================
+StringPool::StringPool() noexcept  : shards (new Shard[numShards]) {}
+StringPool::~StringPool() = default;
+
+template <typename NewStringType>
+String StringPool::addPooledString (const NewStringType& newString)
+{
+    const auto hash = hashString (newString);
+    auto& shard = shards[(hash * 0x9e3779b9u) >> (32 - shardBits)];
+
+    {
+        const SpinLock::ScopedLockType sl (shard.lock);
+
+        if (auto* existing = shard.find (newString, hash))
+            return *existing;
+    }
+
+    // The new string is created outside the lock, so another thread may have added
+    // the same one in the meantime
+    String created (newString);
+
+    const SpinLock::ScopedLockType sl (shard.lock);
+
+    if (auto* existing = shard.find (newString, hash))
+        return *existing;
+
+    shard.garbageCollectIfNeeded();
+    return shard.add (std::move (created), hash);
 }
 
 String StringPool::getPooledString (const char* const newString)
@@ -102,9 +213,7 @@ String StringPool::getPooledString (const char* const newString)
     if (newString == nullptr || *newString == 0)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, CharPointer_UTF8 (newString));
+    return addPooledString (CharPointer_UTF8 (newString));
 }
 
 String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
@@ -112,9 +221,7 @@ String StringPool::getPooledString (String::CharPointerType start, String::CharP
     if (start.isEmpty() || start == end)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, StartEndString (start, end));
+    return addPooledString (StartEndString (start, end));
 }
 
 String StringPool::getPooledString (StringRef newString)
@@ -122,9 +229,7 @@ String StringPool::getPooledString (StringRef newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString.text);
+    return addPooledString (newString.text);
 }
 
 String StringPool::getPooledString (const String& newString)
@@ -132,27 +237,16 @@ String StringPool::getPooledString (const String& newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString);
-}
-
-void StringPool::garbageCollectIfNeeded()
-{
-    if (strings.size() > minNumberOfStringsForGarbageCollection
-         && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
-        garbageCollect();
+    return addPooledString (newString);
 }
 
 void StringPool::garbageCollect()
 {
-    const ScopedLock sl (lock);
-
-    for (int i = strings.size(); --i >= 0;)
-        if (strings.getReference (i).getReferenceCount() == 1)
-            strings.remove (i);
-
-    lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+    for (size_t i = 0; i < (size_t) numShards; ++i)
+    {
+        const SpinLock::ScopedLockType sl (shards[i].lock);
+        shards[i].garbageCollect();
+    }
 }
 
 StringPool& StringPool::getGlobalPool() noexcept
@@ -161,4 +255,81 @@ StringPool& StringPool::getGlobalPool() noexcept
     return pool;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StringPoolTests final : public UnitTest
+{
+public:
+    StringPoolTests()
+        : UnitTest ("StringPool", UnitTestCategories::text)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Matching strings share the same storage");
+        {
+            StringPool pool;
+            const String text ("pooled");
+            const char* utf8 = "pooled";
+            const auto a = pool.getPooledString (text);
+
+            expect (a.getCharPointer() == pool.getPooledString (utf8).getCharPointer());
+            expect (a.getCharPointer() == pool.getPooledString (StringRef (utf8)).getCharPointer());
+
+            const String longer ("pooled string");
+            auto start = longer.getCharPointer();
+            expect (a.getCharPointer() == pool.getPooledString (start, start + 6).getCharPointer());
+
+            expect (pool.getPooledString (String()).isEmpty());
+        }
+
+        beginTest ("Unreferenced strings are garbage collected");
+        {
+            StringPool pool;
+            const auto kept = pool.getPooledString ("kept");
+
+            for (int i = 0; i < 1000; ++i)
+                pool.getPooledString ("temp" + String (i));
+
+            pool.garbageCollect();
+
+            expect (pool.getPooledString ("kept").getCharPointer() == kept.getCharPointer());
+
+            for (int i = 0; i < 1000; ++i)
+                expectEquals (pool.getPooledString ("temp" + String (i)), "temp" + String (i));
+        }
+
+        beginTest ("Strings can be pooled from several threads at once");
+        {
+            StringPool pool;
+            constexpr int numThreads = 4, numStrings = 2000;
+            std::vector<std::vector<String>> results ((size_t) numThreads);
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < numThreads; ++t)
+            {
+                threads.emplace_back ([&pool, &results, t]
+                {
+                    for (int i = 0; i < numStrings; ++i)
+                        results[(size_t) t].push_back (pool.getPooledString ("id" + String ((i * 7 + t) % numStrings)));
+                });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+
+            for (int t = 1; t < numThreads; ++t)
+                for (int i = 0; i < numStrings; ++i)
+                    expect (pool.getPooledString ("id" + String ((i * 7 + t) % numStrings)).getCharPointer()
+                              == results[(size_t) t][(size_t) i].getCharPointer());
+        }
+    }
+};
+
+static StringPoolTests stringPoolTests;
+
+#endif
+
 } // namespace juce
@@ -34,6 +34,10 @@ namespace juce
     compare two pooled strings for equality, as you can simply compare their pointers. It
     also cuts down on storage if you're using many copies of the same string.
 
+    All the methods are thread-safe. The strings are spread across a number of
+    separately-locked hash tables, so threads that are adding different strings
+    rarely have to wait for each other.
+
     @tags{Core}
 */
 class JUCE_API  StringPool
@@ -43,6 +47,9 @@ public:
     /** Creates an empty pool. */
     StringPool() noexcept;
 
+    /** Destructor. */
+    ~StringPool();
+
     //==============================================================================
     /** Returns a pointer to a shared copy of the string that is passed in.
         The pool will always return the same String object when asked for a string that matches it.
@@ -66,8 +73,8 @@ public:
 
     //==============================================================================
     /** Scans the pool, and removes any strings that are unreferenced.
-        You don't generally need to call this - it'll be called automatically when the pool grows
-        large enough to warrant it.
+        You don't generally need to call this - each part of the pool is scanned automatically
+        when it grows large enough to warrant it.
     */
     void garbageCollect();
 
@@ -75,11 +82,11 @@ public:
     static StringPool& getGlobalPool() noexcept;
 
 private:
-    Array<String> strings;
-    CriticalSection lock;
-    uint32 lastGarbageCollectionTime;
+    struct Shard;
+    std::unique_ptr<Shard[]> shards;
 
-    void garbageCollectIfNeeded();
+    template <typename NewStringType>
+    String addPooledString (const NewStringType&);
 
     JUCE_DECLARE_NON_COPYABLE (StringPool)
 };
@@ -107,6 +107,9 @@ public:
     /** Retrieves a character by index. */
     juce_wchar operator[] (int index) const noexcept                    { return text[index]; }
 
+    /** Returns the same hash code that String::hashCode() returns for an equal string. */
+    int hashCode() const noexcept;
+
     /** Compares this StringRef with a String. */
     bool operator== (const String& s) const noexcept                    { return text.compare (s.getCharPointer()) == 0; }
     /** Compares this StringRef with a String. */
@@ -196,9 +196,291 @@ struct TextDiffHelpers
     }
 };
 
-TextDiff::TextDiff (const String& original, const String& target)
+//==============================================================================
+struct LineDiffHelpers
 {
-    TextDiffHelpers::diffSkippingCommonStart (*this, original, target);
+    struct Line
+    {
+        String::CharPointerType text;
+        int numChars;
+        size_t numBytes;
+        uint32 hash;
+    };
+
+    // Splits a string after each newline, so that the lines joined together are the original string
+    static std::vector<Line> splitLines (const String& s)
+    {
+        std::vector<Line> lines;
+        auto t = s.getCharPointer();
+
+        while (! t.isEmpty())
+        {
+            Line line { t, 0, 0, 2166136261u };
+
+            for (;;)
+            {
+                auto c = t.getAndAdvance();
+                ++line.numChars;
+                line.hash = (line.hash ^ (uint32) c) * 16777619u;
+
+                if (c == '\n' || t.isEmpty())
+                    break;
+            }
+
+            line.numBytes = (size_t) (reinterpret_cast<const char*> (t.getAddress())
+                                        - reinterpret_cast<const char*> (line.text.getAddress()));
+            lines.push_back (line);
+        }
+
+        return lines;
+    }
+
+    struct LineHash
+    {
+        size_t operator() (const Line* l) const noexcept   { return l->hash; }
+    };
+
+    struct LinesEqual
+    {
+        bool operator() (const Line* a, const Line* b) const noexcept
+        {
+            return a->hash == b->hash
+                && a->numBytes == b->numBytes
+                && memcmp (a->text.getAddress(), b->text.getAddress(), a->numBytes) == 0;
+        }
+    };
+
+    // Gives every distinct line a number, so that the diff only has to compare integers
+    static void numberLines (const std::vector<Line>& a, std::vector<int>& idsA,
+                             const std::vector<Line>& b, std::vector<int>& idsB)
+    {
+        std::unordered_map<const Line*, int, LineHash, LinesEqual> ids;
+        ids.reserve (a.size() + b.size());
+
+        auto getIds = [&ids] (const std::vector<Line>& lines, std::vector<int>& result)
+        {
+            result.reserve (lines.size());
+
+            for (auto& l : lines)
+                result.push_back (ids.emplace (&l, (int) ids.size()).first->second);
+        };
+
+        getIds (a, idsA);
+        getIds (b, idsB);
+    }
+
+    //==============================================================================
+    struct Myers
+    {
+        Myers (const std::vector<int>& lineIdsA, const std::vector<int>& lineIdsB)
+            : a (lineIdsA.data()), b (lineIdsB.data()),
+              removed (lineIdsA.size()), added (lineIdsB.size())
+        {
+            auto maxD = (lineIdsA.size() + lineIdsB.size() + 1) / 2;
+            forward.resize (2 * maxD + 3);
+            backward.resize (2 * maxD + 3);
+            maxCost = jmax (4096, (int) std::sqrt ((double) (lineIdsA.size() + lineIdsB.size())) * 16);
+
+            compare (0, (int) lineIdsA.size(), 0, (int) lineIdsB.size());
+        }
+
+        void compare (int aStart, int aEnd, int bStart, int bEnd)
+        {
+            while (aStart < aEnd && bStart < bEnd && a[aStart] == b[bStart])
+            {
+                ++aStart;
+                ++bStart;
+            }
+
+            while (aStart < aEnd && bStart < bEnd && a[aEnd - 1] == b[bEnd - 1])
+            {
+                --aEnd;
+                --bEnd;
+            }
+
+            if (aStart == aEnd)
+            {
+                std::fill (added.begin() + bStart, added.begin() + bEnd, true);
+            }
+            else if (bStart == bEnd)
+            {
+                std::fill (removed.begin() + aStart, removed.begin() + aEnd, true);
+            }
+            else
+            {
+                // The ends now differ, so at least one line must be removed and one added,
+                // and both halves of the split are smaller than the whole
+                auto split = findSplit (aStart, aEnd, bStart, bEnd);
+                compare (aStart, split.x, bStart, split.y);
+                compare (split.u, aEnd, split.v, bEnd);
+            }
+        }
+
+        // Returns a snake from (x, y) to (u, v) that lies on a shortest path through the middle of the
+        // edit graph. If this is taking too long, it gives up and returns the point that the forward
+        // search has got furthest towards.
+        struct Split { int x, y, u, v; };
+
+        Split findSplit (int aStart, int aEnd, int bStart, int bEnd)
+        {
+            const auto n = aEnd - aStart, m = bEnd - bStart, delta = n - m;
+            const auto deltaIsOdd = (delta & 1) != 0;
+            const auto maxD = (n + m + 1) / 2;
+            const auto offset = maxD + 1;
+
+            auto* vf = forward.data() + offset;
+            auto* vb = backward.data() + offset;
+            vf[1] = 0;
+            vb[1] = 0;
+
+            for (int d = 0; d <= maxD; ++d)
+            {
+                for (int k = -d; k <= d; k += 2)
+                {
+                    auto x = (k == -d || (k != d && vf[k - 1] < vf[k + 1])) ? vf[k + 1] : vf[k - 1] + 1;
+                    auto y = x - k;
+                    const auto startX = x, startY = y;
+
+                    while (x < n && y < m && a[aStart + x] == b[bStart + y])
+                    {
+                        ++x;
+                        ++y;
+                    }
+
+                    vf[k] = x;
+                    const auto reverseK = delta - k;
+
+                    if (deltaIsOdd && reverseK >= -(d - 1) && reverseK <= d - 1 && x + vb[reverseK] >= n)
+                        return { aStart + startX, bStart + startY, aStart + x, bStart + y };
+                }
+
+                for (int k = -d; k <= d; k += 2)
+                {
+                    auto x = (k == -d || (k != d && vb[k - 1] < vb[k + 1])) ? vb[k + 1] : vb[k - 1] + 1;
+                    auto y = x - k;
+                    const auto startX = x, startY = y;
+
+                    while (x < n && y < m && a[aEnd - 1 - x] == b[bEnd - 1 - y])
+                    {
+                        ++x;
+                        ++y;
+                    }
+
+                    vb[k] = x;
+                    const auto forwardK = delta - k;
+
+                    if (! deltaIsOdd && forwardK >= -d && forwardK <= d && x + vf[forwardK] >= n)
+                        return { aEnd - x, bEnd - y, aEnd - startX, bEnd - startY };
+                }
+
+                if (d >= maxCost)
+                {
+                    int bestX = 0, bestY = 0;
+
+                    for (int k = -d; k <= d; k += 2)
+                    {
+                        auto x = vf[k];
+                        auto y = x - k;
+
+                        if (x <= n && y >= 0 && y <= m && x + y > bestX + bestY && x + y < n + m)
+                        {
+                            bestX = x;
+                            bestY = y;
+                        }
+                    }
+
+                    if (bestX + bestY > 0)
+                        return { aStart + bestX, bStart + bestY, aStart + bestX, bStart + bestY };
+                }
+            }
+
+            jassertfalse; // the searches should always meet before this point
+            return { aStart, bStart, aStart, bStart };
+        }
+
+        const int* a;
+        const int* b;
+        std::vector<bool> removed, added;
+        std::vector<int> forward, backward;
+        int maxCost;
+    };
+
+    template <typename Callback>
+    static void findChanges (const std::vector<Line>& linesA, const std::vector<Line>& linesB, Callback&& callback)
+    {
+        std::vector<int> idsA, idsB;
+        numberLines (linesA, idsA, linesB, idsB);
+
+        const Myers myers (idsA, idsB);
+        const auto numA = (int) idsA.size(), numB = (int) idsB.size();
+
+        for (int i = 0, j = 0; i < numA || j < numB;)
+        {
+            if (i < numA && j < numB && ! myers.removed[(size_t) i] && ! myers.added[(size_t) j])
+            {
+                ++i;
+                ++j;
+                continue;
+            }
+
+            const TextDiff::LineChange change { i, 0, j, 0 };
+
+            while (i < numA && myers.removed[(size_t) i])  ++i;
+            while (j < numB && myers.added[(size_t) j])    ++j;
+
+            callback (TextDiff::LineChange { change.originalStart, i - change.originalStart,
+                                             change.targetStart, j - change.targetStart });
+        }
+    }
+
+    static void diff (TextDiff& td, const String& original, const String& target)
+    {
+        const auto linesA = splitLines (original);
+        const auto linesB = splitLines (target);
+
+        std::vector<int> charIndexesB;
+        charIndexesB.reserve (linesB.size() + 1);
+        charIndexesB.push_back (0);
+
+        for (auto& l : linesB)
+            charIndexesB.push_back (charIndexesB.back() + l.numChars);
+
+        findChanges (linesA, linesB, [&] (const TextDiff::LineChange& change)
+        {
+            // All the text before this change already matches the target
+            auto start = charIndexesB[(size_t) change.targetStart];
+
+            if (change.numOriginalLines > 0)
+            {
+                int length = 0;
+
+                for (int i = 0; i < change.numOriginalLines; ++i)
+                    length += linesA[(size_t) (change.originalStart + i)].numChars;
+
+                TextDiffHelpers::addDeletion (td, start, length);
+            }
+
+            if (change.numTargetLines > 0)
+                TextDiffHelpers::addInsertion (td, linesB[(size_t) change.targetStart].text, start,
+                                               charIndexesB[(size_t) (change.targetStart + change.numTargetLines)] - start);
+        });
+    }
+};
+
+TextDiff::TextDiff (const String& original, const String& target, Mode mode)
+{
+    if (mode == Mode::lines)
+        LineDiffHelpers::diff (*this, original, target);
+    else
+        TextDiffHelpers::diffSkippingCommonStart (*this, original, target);
+}
+
+void TextDiff::findLineChanges (const String& original, const String& target,
+                                const std::function<void (const LineChange&)>& callback)
+{
+    LineDiffHelpers::findChanges (LineDiffHelpers::splitLines (original),
+                                  LineDiffHelpers::splitLines (target),
+                                  callback);
 }
 
 String TextDiff::appliedTo (String text) const
@@ -252,11 +534,74 @@ public:
         return CharPointer_UTF32 (buffer);
     }
 
+    static String createLines (Random& r, int numLines)
+    {
+        String s;
+
+        for (int i = 0; i < numLines; ++i)
+            s << "line " << r.nextInt (8) << (r.nextInt (10) == 0 ? "\r\n" : "\n");
+
+        return r.nextBool() ? s : s + "last";
+    }
+
     void testDiff (const String& a, const String& b)
     {
         TextDiff diff (a, b);
         auto result = diff.appliedTo (a);
         expectEquals (result, b);
+
+        TextDiff lineDiff (a, b, TextDiff::Mode::lines);
+        expectEquals (lineDiff.appliedTo (a), b);
+    }
+
+    static StringArray splitAfterNewlines (String s)
+    {
+        StringArray lines;
+
+        while (s.isNotEmpty())
+        {
+            auto end = s.indexOfChar ('\n') + 1;
+
+            if (end == 0)
+                end = s.length();
+
+            lines.add (s.substring (0, end));
+            s = s.substring (end);
+        }
+
+        return lines;
+    }
+
+    void testLineChanges (const String& a, const String& b, int expectedNumChangedLines)
+    {
+        auto linesA = splitAfterNewlines (a);
+        auto linesB = splitAfterNewlines (b);
+        StringArray rebuilt;
+
+        int lastA = 0, numChangedLines = 0;
+
+        TextDiff::findLineChanges (a, b, [&] (const TextDiff::LineChange& c)
+        {
+            expect (c.originalStart >= lastA);
+            expect (c.numOriginalLines + c.numTargetLines > 0);
+
+            for (int i = lastA; i < c.originalStart; ++i)
+                rebuilt.add (linesA[i]);
+
+            for (int i = 0; i < c.numTargetLines; ++i)
+                rebuilt.add (linesB[c.targetStart + i]);
+
+            lastA = c.originalStart + c.numOriginalLines;
+            numChangedLines += c.numOriginalLines + c.numTargetLines;
+        });
+
+        for (int i = lastA; i < linesA.size(); ++i)
+            rebuilt.add (linesA[i]);
+
+        expect (rebuilt == linesB);
+
+        if (expectedNumChangedLines >= 0)
+            expectEquals (numChangedLines, expectedNumChangedLines);
     }
 
     void runTest() override
@@ -279,6 +624,41 @@ public:
             testDiff (s, createString (r));
             testDiff (s + createString (r), s + createString (r));
         }
+
+        beginTest ("TextDiff lines");
+
+        testLineChanges ("a\nb\nc\n", "a\nb\nc\n", 0);
+        testLineChanges ("a\nb\nc\n", "a\nc\n", 1);
+        testLineChanges ("a\nb\nc\n", "x\na\nb\nc\ny\n", 2);
+        testLineChanges ("a\nb\nc\nd\n", "b\nx\nd\ne\n", 4);
+        testLineChanges ("a\nb\nc\na\nb\nb\na\n", "c\nb\na\nb\na\nc\n", 5);
+        testLineChanges ({}, "a\nb\n", 2);
+        testLineChanges ("a\nb\n", {}, 2);
+
+        for (int i = 300; --i >= 0;)
+        {
+            auto a = createLines (r, r.nextInt (60));
+            auto b = createLines (r, r.nextInt (60));
+            testDiff (a, b);
+            testLineChanges (a, b, -1);
+        }
+
+        {
+            StringArray original;
+
+            for (int i = 0; i < 20000; ++i)
+                original.add ("value " + String (i));
+
+            auto target = original;
+
+            for (int i = 0; i < 100; ++i)
+                target.set (r.nextInt (target.size()), "changed " + String (i));
+
+            auto a = original.joinIntoString ("\n");
+            auto b = target.joinIntoString ("\n");
+            expectEquals (TextDiff (a, b, TextDiff::Mode::lines).appliedTo (a), b);
+            testLineChanges (a, b, -1);
+        }
     }
 };
 
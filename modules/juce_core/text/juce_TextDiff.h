@@ -31,14 +31,28 @@ namespace juce
     each change can be either an insertion or a deletion. When applied in order
     to the original string, these changes will convert it to the target string.
 
+    By default the strings are compared character by character, which gives the
+    smallest changes but becomes slow for long strings. For large texts such as XML
+    or source code, Mode::lines compares whole lines instead, which is fast enough
+    for files of many thousands of lines. To avoid storing the changes at all, use
+    findLineChanges().
+
     @tags{Core}
 */
 class JUCE_API TextDiff
 {
 public:
+    /** The ways in which the two strings can be compared. */
+    enum class Mode
+    {
+        characters,   /**< Finds changes to individual characters. */
+        lines         /**< Finds which whole lines have been inserted or deleted. */
+    };
+
     /** Creates a set of diffs for converting the original string into the target. */
     TextDiff (const String& original,
-              const String& target);
+              const String& target,
+              Mode mode = Mode::characters);
 
     /** Applies this sequence of changes to the original string, producing the
         target string that was specified when generating them.
@@ -69,6 +83,37 @@ public:
         Applying each of these, in order, to the original string will produce the target.
     */
     Array<Change> changes;
+
+    //==============================================================================
+    /** Describes a block of lines in the original text that is replaced by a block
+        of lines in the target text.
+
+        Either of the blocks may be empty, when lines have only been deleted or only
+        been inserted. Line indexes start at zero.
+    */
+    struct LineChange
+    {
+        int originalStart;      /**< The index of the first line in the original text that is replaced. */
+        int numOriginalLines;   /**< The number of lines in the original text that are replaced. */
+        int targetStart;        /**< The index of the first line in the target text that replaces them. */
+        int numTargetLines;     /**< The number of lines in the target text that replace them. */
+    };
+
+    /** Compares two texts line by line, and calls a function for each block of lines
+        that differs, in order from the start of the texts.
+
+        The changes aren't stored, so this is a cheap way to produce a patch or to
+        display the differences between two large texts. Lines are split after each
+        newline character, and must match exactly, including any trailing whitespace.
+
+        This uses Myers' O(ND) algorithm in linear space, so its speed depends mostly
+        on the number of differences rather than on the length of the texts. For texts
+        with a very large number of differences, it stops searching for the shortest
+        possible set of changes, and returns a slightly longer one instead.
+    */
+    static void findLineChanges (const String& original,
+                                 const String& target,
+                                 const std::function<void (const LineChange&)>& callback);
 };
 
 } // namespace juce
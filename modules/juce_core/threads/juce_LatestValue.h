@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Passes the most recent version of an object from one thread to another, without
+    either of them ever having to wait.
+
+    This is a triple buffer: the writer fills one copy of the object, the reader uses
+    another, and the third holds the most recently published value. Publishing a new
+    value and picking it up are both just an atomic exchange of buffer indices, so
+    neither thread ever blocks or retries, and the object can be any copyable type,
+    of any size - e.g. a frame of analysis data being sent from the audio thread to
+    an editor.
+
+    Values that are published faster than the reader picks them up are simply
+    replaced, so the reader always sees the latest complete value, but may miss
+    some of the intermediate ones. If every value matters, use a FIFO such as
+    SpscRingBuffer instead.
+
+    Only one thread may write, and only one thread may read.
+    @code
+    // Audio thread
+    auto& frame = latestFrame.getWriteBuffer();
+    analyser.fillFrame (frame);
+    latestFrame.publish();
+
+    // Message thread
+    if (latestFrame.hasNewValue())
+        display (latestFrame.get());
+    @endcode
+
+    @see SeqLock, SpscRingBuffer
+
+    @tags{Core}
+*/
+template <typename Type>
+class LatestValue
+{
+public:
+    //==============================================================================
+    /** Creates a LatestValue whose buffers all hold default-constructed objects. */
+    LatestValue() = default;
+
+    /** Creates a LatestValue whose buffers all hold copies of the given value.
+        Any memory that the objects need should be allocated here, so that copying a new
+        value into the write buffer later on doesn't have to allocate.
+    */
+    explicit LatestValue (const Type& initialValue)
+        : buffers { initialValue, initialValue, initialValue }
+    {
+    }
+
+    //==============================================================================
+    /** Copies a new value into the write buffer and publishes it. Call this only from the writer thread. */
+    void set (const Type& newValue)
+    {
+        getWriteBuffer() = newValue;
+        publish();
+    }
+
+    /** Returns the buffer that the writer should fill in before calling publish().
+        This will hold an old value, which may be out of date. Call this only from the writer thread.
+    */
+    Type& getWriteBuffer() noexcept             { return buffers[(size_t) writeIndex]; }
+
+    /** Makes the contents of the write buffer available to the reader, and gives the
+        writer a new buffer. Call this only from the writer thread.
+    */
+    void publish() noexcept
+    {
+        writeIndex = middle.exchange (writeIndex | newValueFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    //==============================================================================
+    /** Returns true if a value has been published since the reader last called get(). */
+    bool hasNewValue() const noexcept
+    {
+        return (middle.load (std::memory_order_relaxed) & newValueFlag) != 0;
+    }
+
+    /** Returns the most recently published value. Call this only from the reader thread.
+        The reference remains valid until the next call to get().
+    */
+    const Type& get() noexcept
+    {
+        if (hasNewValue())
+            readIndex = middle.exchange (readIndex, std::memory_order_acq_rel) & indexMask;
+
+        return buffers[(size_t) readIndex];
+    }
+
+private:
+    //==============================================================================
+    static constexpr int indexMask = 3, newValueFlag = 4;
+
+    std::array<Type, 3> buffers;
+    int writeIndex = 0;
+    std::atomic<int> middle { 1 };
+    int readIndex = 2;
+
+    JUCE_DECLARE_NON_COPYABLE (LatestValue)
+};
+
+} // namespace juce
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ThreadPool& JUCE_CALLTYPE getDefaultParallelThreadPool()
+{
+    static ThreadPool pool { ThreadPoolOptions{}.withThreadName ("Parallel Algorithms")
+                                                .withNumberOfThreads (jmax (1, SystemStats::getNumCpus() - 1)) };
+    return pool;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParallelAlgorithmsTests final : public UnitTest
+{
+public:
+    ParallelAlgorithmsTests()
+        : UnitTest ("ParallelAlgorithms", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("parallelFor visits every index exactly once");
+        {
+            for (auto numItems : { 0, 1, 7, 1000, 100000 })
+            {
+                std::vector<std::atomic<int>> counts ((size_t) numItems);
+
+                parallelFor (0, numItems, [&] (int i) { ++counts[(size_t) i]; }, 16);
+
+                expect (std::all_of (counts.begin(), counts.end(), [] (const auto& c) { return c.load() == 1; }));
+            }
+
+            std::atomic<int64> total { 0 };
+            parallelFor ((int64) -50, (int64) 50, [&] (int64 i) { total += i; });
+            expectEquals (total.load(), (int64) -50);
+        }
+
+        beginTest ("parallelForEach works on containers");
+        {
+            Array<int> array;
+
+            for (int i = 0; i < 5000; ++i)
+                array.add (i);
+
+            parallelForEach (array, [] (int& i) { i *= 2; });
+
+            for (int i = 0; i < array.size(); ++i)
+                expectEquals (array[i], i * 2);
+
+            std::vector<float> values (3000, 1.0f);
+            parallelForEach (Span<float> (values), [] (float& f) { f += 1.0f; });
+            expect (std::all_of (values.begin(), values.end(), [] (float f) { return exactlyEqual (f, 2.0f); }));
+        }
+
+        beginTest ("parallelReduce combines the chunks in order");
+        {
+            const auto sum = parallelReduce (0, 100000, (int64) 0, [] (int i) { return (int64) i; }, std::plus<>());
+            expectEquals (sum, (int64) 100000 * 99999 / 2);
+
+            const auto text = parallelReduce (0, 500, String(),
+                                              [] (int i) { return String::charToString ((juce_wchar) ('a' + i % 26)); },
+                                              [] (String a, const String& b) { return a + b; });
+            String expected;
+
+            for (int i = 0; i < 500; ++i)
+                expected << String::charToString ((juce_wchar) ('a' + i % 26));
+
+            expectEquals (text, expected);
+            expectEquals (parallelReduce (3, 3, 42, [] (int) { return 1; }, std::plus<>()), 42);
+        }
+
+        beginTest ("parallelSort sorts");
+        {
+            for (auto numItems : { 0, 10, 5000, 200000 })
+            {
+                std::vector<int> values ((size_t) numItems);
+
+                for (auto& v : values)
+                    v = random.nextInt();
+
+                auto expected = values;
+                std::sort (expected.begin(), expected.end());
+
+                parallelSort (values.begin(), values.end());
+                expect (values == expected);
+
+                parallelSort (values.begin(), values.end(), std::greater<>());
+                expect (std::is_sorted (values.begin(), values.end(), std::greater<>()));
+            }
+        }
+
+        beginTest ("Algorithms can be nested inside pool jobs");
+        {
+            ThreadPool pool (1);
+            std::atomic<int> total { 0 };
+
+            parallelFor (0, 8, [&] (int)
+            {
+                parallelFor (0, 100, [&] (int) { ++total; }, 1, pool);
+            }, 1, pool);
+
+            expectEquals (total.load(), 800);
+        }
+    }
+};
+
+static ParallelAlgorithmsTests parallelAlgorithmsTests;
+
+#endif
+
+} // namespace juce
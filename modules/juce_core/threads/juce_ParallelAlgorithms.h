@@ -0,0 +1,256 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/** Returns a ThreadPool that's shared by the parallel algorithms when they aren't
+    given a pool to use.
+
+    It's created the first time it's needed, with one thread fewer than the number of
+    CPUs, because the thread that calls an algorithm also does some of the work.
+
+    @see parallelFor, parallelReduce, parallelSort
+*/
+JUCE_API ThreadPool& JUCE_CALLTYPE getDefaultParallelThreadPool();
+
+#ifndef DOXYGEN
+namespace detail
+{
+    // Splits a range into chunks, and runs them on the calling thread and the pool's threads
+    template <typename ChunkCallback>
+    void runChunksInParallel (int64 numItems, int64 minimumChunkSize, ThreadPool& pool, ChunkCallback&& processChunk)
+    {
+        if (numItems <= 0)
+            return;
+
+        const auto numThreads = (int64) pool.getNumThreads() + 1;
+        const auto chunkSize = jmax (jmax ((int64) 1, minimumChunkSize), (numItems + numThreads * 4 - 1) / (numThreads * 4));
+        const auto numChunks = (numItems + chunkSize - 1) / chunkSize;
+
+        if (numChunks == 1)
+        {
+            processChunk ((int64) 0, numItems);
+            return;
+        }
+
+        // Helper jobs may not start until after this function has returned, so they share
+        // ownership of this, and only touch the callback if they manage to claim a chunk
+        struct State
+        {
+            std::atomic<int64> nextChunk { 0 }, numChunksDone { 0 };
+            WaitableEvent finished;
+        };
+
+        auto state = std::make_shared<State>();
+
+        auto runChunks = [state, numItems, chunkSize, numChunks, callback = &processChunk]
+        {
+            for (;;)
+            {
+                const auto chunk = state->nextChunk.fetch_add (1);
+
+                if (chunk >= numChunks)
+                    return;
+
+                const auto start = chunk * chunkSize;
+                (*callback) (start, jmin (numItems, start + chunkSize));
+
+                if (state->numChunksDone.fetch_add (1) + 1 == numChunks)
+                    state->finished.signal();
+            }
+        };
+
+        for (auto i = jmin ((int64) pool.getNumThreads(), numChunks - 1); --i >= 0;)
+            pool.addJob (runChunks);
+
+        runChunks();
+        state->finished.wait();
+    }
+}
+#endif
+
+//==============================================================================
+/** Calls a function for each index in the range [begin, end), using several threads.
+
+    The range is split into chunks, which are shared between the calling thread and the
+    pool's threads, and this returns when they've all been processed. Each chunk will
+    contain at least minimumChunkSize indices, so for cheap per-item work, use a larger
+    chunk size to keep the overhead down.
+
+    The function is called concurrently from different threads, so it must be
+    thread-safe, and it mustn't throw. It's safe to call this from inside a pool job,
+    because the calling thread always does some of the work.
+
+    This works with anything that can be indexed - e.g.
+    @code
+    parallelFor (0, array.size(), [&] (int i) { array.getReference (i) = process (array[i]); });
+
+    parallelFor (0, (int) block.getNumChannels(), [&] (int channel)
+    {
+        analyse (block.getChannelPointer ((size_t) channel), block.getNumSamples());
+    });
+    @endcode
+
+    @see parallelReduce, parallelSort, getDefaultParallelThreadPool
+*/
+template <typename IndexType, typename Callback>
+void parallelFor (IndexType begin, IndexType end, Callback&& callback,
+                  IndexType minimumChunkSize = 1, ThreadPool& pool = getDefaultParallelThreadPool())
+{
+    static_assert (std::is_integral_v<IndexType>, "parallelFor needs an integer index type");
+
+    detail::runChunksInParallel ((int64) end - (int64) begin, (int64) minimumChunkSize, pool, [&] (int64 start, int64 chunkEnd)
+    {
+        for (auto i = start; i < chunkEnd; ++i)
+            callback ((IndexType) (begin + (IndexType) i));
+    });
+}
+
+/** Calls a function for each element of a container, using several threads.
+
+    The container must provide random-access iterators - e.g. Array, Span, std::vector
+    or a plain C array. The function is given a reference to each element.
+
+    @see parallelFor
+*/
+template <typename Container, typename Callback>
+void parallelForEach (Container&& container, Callback&& callback,
+                      int minimumChunkSize = 1, ThreadPool& pool = getDefaultParallelThreadPool())
+{
+    auto first = std::begin (container);
+    const auto numItems = (int64) std::distance (first, std::end (container));
+
+    detail::runChunksInParallel (numItems, (int64) minimumChunkSize, pool, [&] (int64 start, int64 chunkEnd)
+    {
+        for (auto i = start; i < chunkEnd; ++i)
+            callback (first[(std::ptrdiff_t) i]);
+    });
+}
+
+/** Combines a value computed for each index in the range [begin, end), using several
+    threads.
+
+    Each chunk of the range is reduced separately, starting from the identity value, by
+    combining it with map (index) for each index. The chunks' results are then combined
+    in order, so if combine is associative, the result is the same as doing it all on
+    one thread, e.g.
+    @code
+    auto sumOfSquares = parallelReduce (0, numSamples, 0.0,
+                                        [&] (int i) { return (double) data[i] * data[i]; },
+                                        std::plus<>());
+    @endcode
+
+    The functions are called concurrently from different threads, so they must be
+    thread-safe, and they mustn't throw.
+
+    @see parallelFor
+*/
+template <typename IndexType, typename ValueType, typename MapFunction, typename CombineFunction>
+ValueType parallelReduce (IndexType begin, IndexType end, ValueType identity,
+                          MapFunction&& map, CombineFunction&& combine,
+                          IndexType minimumChunkSize = 1, ThreadPool& pool = getDefaultParallelThreadPool())
+{
+    static_assert (std::is_integral_v<IndexType>, "parallelReduce needs an integer index type");
+
+    const auto numItems = (int64) end - (int64) begin;
+    const auto chunkSize = jmax ((int64) 1, (int64) minimumChunkSize);
+
+    if (numItems <= 0)
+        return identity;
+
+    // The chunks can finish in any order, so their results are sorted by position before being combined
+    std::mutex resultsLock;
+    std::vector<std::pair<int64, ValueType>> chunkResults;
+    chunkResults.reserve ((size_t) jmin ((int64) 1024, (numItems + chunkSize - 1) / chunkSize));
+
+    detail::runChunksInParallel (numItems, chunkSize, pool, [&] (int64 start, int64 chunkEnd)
+    {
+        auto value = identity;
+
+        for (auto i = start; i < chunkEnd; ++i)
+            value = combine (std::move (value), map ((IndexType) (begin + (IndexType) i)));
+
+        const std::lock_guard<std::mutex> sl (resultsLock);
+        chunkResults.emplace_back (start, std::move (value));
+    });
+
+    std::sort (chunkResults.begin(), chunkResults.end(), [] (const auto& a, const auto& b) { return a.first < b.first; });
+
+    auto result = std::move (identity);
+
+    for (auto& chunk : chunkResults)
+        result = combine (std::move (result), std::move (chunk.second));
+
+    return result;
+}
+
+/** Sorts a range of elements, using several threads.
+
+    Separate chunks of the range are sorted at the same time, and then merged together
+    in parallel. Like std::sort, this isn't a stable sort. The iterators must be
+    random-access, e.g.
+    @code
+    parallelSort (array.begin(), array.end(), [] (const auto& a, const auto& b) { return a.name < b.name; });
+    @endcode
+
+    Small ranges are just sorted on the calling thread.
+
+    @see parallelFor
+*/
+template <typename RandomAccessIterator, typename Comparator = std::less<>>
+void parallelSort (RandomAccessIterator first, RandomAccessIterator last, Comparator comparator = {},
+                   ThreadPool& pool = getDefaultParallelThreadPool())
+{
+    const auto numItems = (int64) std::distance (first, last);
+    constexpr int64 minimumChunkSize = 4096;
+
+    auto numChunks = (int64) 1;
+
+    while (numChunks < (int64) pool.getNumThreads() + 1 && numItems / (numChunks * 2) >= minimumChunkSize)
+        numChunks *= 2;
+
+    if (numChunks == 1)
+    {
+        std::sort (first, last, comparator);
+        return;
+    }
+
+    auto getChunkStart = [&] (int64 chunk) { return first + (std::ptrdiff_t) (numItems * chunk / numChunks); };
+
+    parallelFor ((int64) 0, numChunks, [&] (int64 chunk)
+    {
+        std::sort (getChunkStart (chunk), getChunkStart (chunk + 1), comparator);
+    }, (int64) 1, pool);
+
+    for (auto width = (int64) 1; width < numChunks; width *= 2)
+    {
+        parallelFor ((int64) 0, numChunks / (width * 2), [&] (int64 pair)
+        {
+            const auto start = pair * width * 2;
+            std::inplace_merge (getChunkStart (start), getChunkStart (start + width), getChunkStart (start + width * 2), comparator);
+        }, (int64) 1, pool);
+    }
+}
+
+} // namespace juce
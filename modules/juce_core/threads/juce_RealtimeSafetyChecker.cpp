@@ -0,0 +1,444 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+
+namespace RealtimeSafetyHelpers
+{
+    // Everything here is zero-initialised before any constructors run, because
+    // operator new may report violations during static initialisation.
+    static thread_local int realtimeDepth = 0;
+    static thread_local bool isReporting = false;
+
+    static std::atomic<bool> enabled { false };
+    static std::atomic<int> numDropped { 0 };
+
+    static int captureStack (void** frames, int maxFrames) noexcept
+    {
+       #if JUCE_WINDOWS && ! JUCE_MINGW
+        return (int) CaptureStackBackTrace (2, (DWORD) maxFrames, frames, nullptr);
+       #elif JUCE_ANDROID || JUCE_MINGW || JUCE_WASM
+        ignoreUnused (frames, maxFrames);
+        return 0;
+       #else
+        return backtrace (frames, maxFrames);
+       #endif
+    }
+
+    static uint64 hashStack (RealtimeSafetyChecker::ViolationType type, void* const* frames, int numFrames) noexcept
+    {
+        auto hash = (uint64) 14695981039346656037ull ^ (uint64) type;
+
+        for (int i = 0; i < numFrames; ++i)
+            hash = (hash ^ (uint64) (pointer_sized_uint) frames[i]) * 1099511628211ull;
+
+        return hash == 0 ? 1 : hash;
+    }
+
+    //==============================================================================
+    // An open-addressed set of the stacks that have already been recorded.
+    class SeenStacks
+    {
+    public:
+        bool insert (uint64 hash) noexcept
+        {
+            for (size_t i = 0; i < maxProbes; ++i)
+            {
+                auto& entry = entries[(hash + i) & (numEntries - 1)];
+                auto existing = entry.load (std::memory_order_relaxed);
+
+                if (existing == hash)
+                    return false;
+
+                if (existing == 0 && entry.compare_exchange_strong (existing, hash, std::memory_order_relaxed))
+                    return true;
+
+                if (existing == hash)
+                    return false;
+            }
+
+            return true;
+        }
+
+        void clear() noexcept
+        {
+            for (auto& entry : entries)
+                entry.store (0, std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t numEntries = 4096, maxProbes = 16;
+        std::atomic<uint64> entries[numEntries];
+    };
+
+    //==============================================================================
+    // A bounded multi-producer queue, in which each slot carries a sequence number
+    // saying whether it's ready to be written or read.
+    class ViolationQueue
+    {
+    public:
+        void initialise() noexcept
+        {
+            for (size_t i = 0; i < numSlots; ++i)
+                slots[i].sequence.store (i, std::memory_order_relaxed);
+
+            std::atomic_thread_fence (std::memory_order_release);
+        }
+
+        template <typename FillFn>
+        bool push (FillFn&& fill) noexcept
+        {
+            auto position = writePosition.load (std::memory_order_relaxed);
+
+            for (;;)
+            {
+                auto& slot = slots[position & (numSlots - 1)];
+                const auto difference = (int64) slot.sequence.load (std::memory_order_acquire) - (int64) position;
+
+                if (difference == 0)
+                {
+                    if (writePosition.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                    {
+                        fill (slot.violation);
+                        slot.sequence.store (position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = writePosition.load (std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool pop (RealtimeSafetyChecker::Violation& result) noexcept
+        {
+            auto& slot = slots[readPosition & (numSlots - 1)];
+
+            if (slot.sequence.load (std::memory_order_acquire) != readPosition + 1)
+                return false;
+
+            result = slot.violation;
+            slot.sequence.store (readPosition + numSlots, std::memory_order_release);
+            ++readPosition;
+            return true;
+        }
+
+    private:
+        static constexpr size_t numSlots = 256;
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            RealtimeSafetyChecker::Violation violation;
+        };
+
+        Slot slots[numSlots];
+        std::atomic<size_t> writePosition { 0 };
+        size_t readPosition = 0;
+    };
+
+    struct State
+    {
+        SeenStacks seen;
+        ViolationQueue queue;
+        CriticalSection readLock;
+    };
+
+    static std::atomic<State*> state { nullptr };
+}
+
+//==============================================================================
+void RealtimeSafetyChecker::enable()
+{
+    using namespace RealtimeSafetyHelpers;
+
+    if (state.load() == nullptr)
+    {
+        static CriticalSection creationLock;
+        const ScopedLock sl (creationLock);
+
+        if (state.load() == nullptr)
+        {
+            auto* newState = new State();
+            newState->queue.initialise();
+
+            // The first call to backtrace() may load a library and allocate, so make it here.
+            void* frames[4];
+            captureStack (frames, numElementsInArray (frames));
+
+            // Never freed, as realtime threads might still be reporting violations into it.
+            state.store (newState);
+        }
+    }
+
+    enabled.store (true);
+}
+
+void RealtimeSafetyChecker::disable()               { RealtimeSafetyHelpers::enabled.store (false); }
+bool RealtimeSafetyChecker::isEnabled() noexcept    { return RealtimeSafetyHelpers::enabled.load (std::memory_order_relaxed); }
+
+std::vector<RealtimeSafetyChecker::Violation> RealtimeSafetyChecker::getViolations()
+{
+    std::vector<Violation> result;
+
+    if (auto* s = RealtimeSafetyHelpers::state.load())
+    {
+        const ScopedLock sl (s->readLock);
+
+        for (Violation v; s->queue.pop (v);)
+            result.push_back (v);
+    }
+
+    return result;
+}
+
+int RealtimeSafetyChecker::getNumDroppedViolations() noexcept
+{
+    return RealtimeSafetyHelpers::numDropped.load (std::memory_order_relaxed);
+}
+
+void RealtimeSafetyChecker::resetSeenViolations() noexcept
+{
+    if (auto* s = RealtimeSafetyHelpers::state.load())
+        s->seen.clear();
+}
+
+bool RealtimeSafetyChecker::isRealtimeContext() noexcept
+{
+    return RealtimeSafetyHelpers::realtimeDepth > 0;
+}
+
+RealtimeSafetyChecker::ScopedRealtimeContext::ScopedRealtimeContext() noexcept   { ++RealtimeSafetyHelpers::realtimeDepth; }
+RealtimeSafetyChecker::ScopedRealtimeContext::~ScopedRealtimeContext() noexcept  { --RealtimeSafetyHelpers::realtimeDepth; }
+
+void RealtimeSafetyChecker::reportViolation (ViolationType type, const char* functionName) noexcept
+{
+    using namespace RealtimeSafetyHelpers;
+
+    if (realtimeDepth <= 0 || isReporting || ! enabled.load (std::memory_order_relaxed))
+        return;
+
+    auto* s = state.load (std::memory_order_acquire);
+
+    if (s == nullptr)
+        return;
+
+    isReporting = true;
+
+    void* frames[maxStackFrames];
+    const auto numFrames = captureStack (frames, maxStackFrames);
+
+    if (s->seen.insert (hashStack (type, frames, numFrames)))
+    {
+        const auto pushed = s->queue.push ([&] (Violation& v)
+        {
+            v.type = type;
+            v.functionName = functionName;
+            v.threadId = Thread::getCurrentThreadId();
+            v.timeTicks = Time::getHighResolutionTicks();
+            v.numStackFrames = numFrames;
+            std::copy (frames, frames + numFrames, v.stackFrames);
+        });
+
+        if (! pushed)
+            numDropped.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    isReporting = false;
+}
+
+#else
+
+void RealtimeSafetyChecker::enable()                                    {}
+void RealtimeSafetyChecker::disable()                                   {}
+bool RealtimeSafetyChecker::isEnabled() noexcept                        { return false; }
+std::vector<RealtimeSafetyChecker::Violation> RealtimeSafetyChecker::getViolations()   { return {}; }
+int RealtimeSafetyChecker::getNumDroppedViolations() noexcept           { return 0; }
+void RealtimeSafetyChecker::resetSeenViolations() noexcept              {}
+bool RealtimeSafetyChecker::isRealtimeContext() noexcept                { return false; }
+void RealtimeSafetyChecker::reportViolation (ViolationType, const char*) noexcept {}
+
+#endif
+
+//==============================================================================
+String RealtimeSafetyChecker::Violation::toString() const
+{
+    String result;
+
+    switch (type)
+    {
+        case ViolationType::allocation:     result << "Allocation"; break;
+        case ViolationType::lock:           result << "Lock"; break;
+        case ViolationType::blockingCall:   result << "Blocking call"; break;
+    }
+
+    result << " in " << functionName << " on thread 0x"
+           << String::toHexString ((pointer_sized_int) threadId) << newLine;
+
+   #if JUCE_WINDOWS && ! JUCE_MINGW
+    HANDLE process = GetCurrentProcess();
+    SymInitialize (process, nullptr, TRUE);
+
+    HeapBlock<SYMBOL_INFO> symbol;
+    symbol.calloc (sizeof (SYMBOL_INFO) + 256, 1);
+    symbol->MaxNameLen = 255;
+    symbol->SizeOfStruct = sizeof (SYMBOL_INFO);
+
+    for (int i = 0; i < numStackFrames; ++i)
+    {
+        DWORD64 displacement = 0;
+        result << i << ": ";
+
+        if (SymFromAddr (process, (DWORD64) stackFrames[i], &displacement, symbol))
+            result << symbol->Name << " + 0x" << String::toHexString ((int64) displacement);
+        else
+            result << "0x" << String::toHexString ((pointer_sized_int) stackFrames[i]);
+
+        result << newLine;
+    }
+   #elif ! (JUCE_ANDROID || JUCE_MINGW || JUCE_WASM)
+    if (numStackFrames > 0)
+    {
+        char** frameStrings = backtrace_symbols (stackFrames, numStackFrames);
+
+        for (int i = 0; i < numStackFrames; ++i)
+            result << i << ": " << frameStrings[i] << newLine;
+
+        ::free (frameStrings);
+    }
+   #endif
+
+    return result;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+
+class RealtimeSafetyCheckerTests final : public UnitTest
+{
+public:
+    RealtimeSafetyCheckerTests()
+        : UnitTest ("RealtimeSafetyChecker", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        RealtimeSafetyChecker::enable();
+        RealtimeSafetyChecker::getViolations();
+        RealtimeSafetyChecker::resetSeenViolations();
+
+        beginTest ("Nothing is recorded outside a realtime context");
+        {
+            CriticalSection lock;
+            const ScopedLock sl (lock);
+            std::make_unique<int> (1).reset();
+
+            expect (RealtimeSafetyChecker::getViolations().empty());
+        }
+
+        beginTest ("Locks, allocations and blocking calls are recorded");
+        {
+            CriticalSection lock;
+
+            {
+                const RealtimeSafetyChecker::ScopedRealtimeContext realtimeContext;
+                expect (RealtimeSafetyChecker::isRealtimeContext());
+
+                lock.enter();
+                lock.exit();
+                std::make_unique<int> (1).reset();
+                Thread::sleep (0);
+            }
+
+            expect (! RealtimeSafetyChecker::isRealtimeContext());
+
+            const auto violations = RealtimeSafetyChecker::getViolations();
+
+            expect (contains (violations, RealtimeSafetyChecker::ViolationType::lock));
+            expect (contains (violations, RealtimeSafetyChecker::ViolationType::allocation));
+            expect (contains (violations, RealtimeSafetyChecker::ViolationType::blockingCall));
+
+            for (auto& v : violations)
+                expect (v.threadId == Thread::getCurrentThreadId());
+        }
+
+        beginTest ("Each call stack is only recorded once");
+        {
+            CriticalSection lock;
+
+            for (int i = 0; i < 10; ++i)
+            {
+                const RealtimeSafetyChecker::ScopedRealtimeContext realtimeContext;
+                lock.enter();
+                lock.exit();
+            }
+
+            expectEquals ((int) RealtimeSafetyChecker::getViolations().size(), 1);
+
+            RealtimeSafetyChecker::resetSeenViolations();
+
+            {
+                const RealtimeSafetyChecker::ScopedRealtimeContext realtimeContext;
+                lock.enter();
+                lock.exit();
+            }
+
+            expectEquals ((int) RealtimeSafetyChecker::getViolations().size(), 1);
+        }
+
+        beginTest ("Nothing is recorded while disabled");
+        {
+            RealtimeSafetyChecker::disable();
+            RealtimeSafetyChecker::resetSeenViolations();
+
+            {
+                const RealtimeSafetyChecker::ScopedRealtimeContext realtimeContext;
+                std::make_unique<int> (1).reset();
+            }
+
+            expect (RealtimeSafetyChecker::getViolations().empty());
+        }
+    }
+
+private:
+    static bool contains (const std::vector<RealtimeSafetyChecker::Violation>& violations,
+                          RealtimeSafetyChecker::ViolationType type)
+    {
+        return std::any_of (violations.begin(), violations.end(), [type] (const auto& v) { return v.type == type; });
+    }
+};
+
+static RealtimeSafetyCheckerTests realtimeSafetyCheckerTests;
+
+#endif
+
+} // namespace juce
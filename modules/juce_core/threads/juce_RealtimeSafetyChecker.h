@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Finds operations on realtime threads that could cause audio dropouts.
+
+    When JUCE_ENABLE_REALTIME_SAFETY_CHECKS is enabled and the checker has been
+    started with enable(), every call to operator new or delete, every
+    CriticalSection::enter(), and every potentially blocking call (sleeping,
+    waiting on a WaitableEvent, and file I/O through FileInputStream and
+    FileOutputStream) made on a thread that's inside a ScopedRealtimeContext is
+    recorded along with a stack trace.
+
+    Violations are written into a fixed-size lock-free buffer without allocating
+    or locking, so the realtime thread carries on as normal, and each distinct
+    call stack is only recorded once. Call getViolations() from another thread to
+    collect them.
+
+    The audio callbacks of AudioDeviceManager and the workers of RealtimeThreadPool
+    are marked as realtime contexts. In a plugin, or in any other realtime code,
+    add a ScopedRealtimeContext yourself:
+    @code
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+    {
+        const RealtimeSafetyChecker::ScopedRealtimeContext realtimeContext;
+        ...
+    }
+    @endcode
+
+    Allocations are only seen when they go through the global operator new and
+    delete. Calls made directly to malloc, or to system APIs that lock or block
+    internally, aren't detected.
+
+    If JUCE_ENABLE_REALTIME_SAFETY_CHECKS is 0, all of this compiles to nothing.
+
+    @tags{Core}
+*/
+class JUCE_API  RealtimeSafetyChecker
+{
+public:
+    //==============================================================================
+    /** The kinds of operation that the checker records. */
+    enum class ViolationType
+    {
+        allocation,     /**< operator new or delete was called. */
+        lock,           /**< A CriticalSection was locked. */
+        blockingCall    /**< A call that may block, such as a sleep, wait or file access. */
+    };
+
+    /** The largest number of stack frames stored for each violation. */
+    static constexpr int maxStackFrames = 32;
+
+    /** Describes an operation that was performed on a realtime thread. */
+    struct Violation
+    {
+        /** The kind of operation. */
+        ViolationType type = ViolationType::allocation;
+
+        /** The function that was called, e.g. "CriticalSection::enter". */
+        const char* functionName = "";
+
+        /** The thread that made the call. */
+        Thread::ThreadID threadId = {};
+
+        /** When the call was first made, in Time::getHighResolutionTicks() units. */
+        int64 timeTicks = 0;
+
+        /** The number of valid entries in stackFrames. This is 0 on platforms where
+            stack traces can't be captured.
+        */
+        int numStackFrames = 0;
+
+        /** The return addresses on the stack when the call was made. */
+        void* stackFrames[maxStackFrames] = {};
+
+        /** Returns a readable description of the violation, including its stack trace
+            with symbol names where they're available.
+        */
+        String toString() const;
+    };
+
+    //==============================================================================
+    /** Starts recording violations. Only the first call allocates anything. */
+    static void enable();
+
+    /** Stops recording violations. Any that have been recorded can still be collected. */
+    static void disable();
+
+    /** Returns true if violations are being recorded. */
+    static bool isEnabled() noexcept;
+
+    /** Removes the recorded violations from the buffer and returns them, oldest first. */
+    static std::vector<Violation> getViolations();
+
+    /** Returns the number of violations that couldn't be stored because the buffer was full. */
+    static int getNumDroppedViolations() noexcept;
+
+    /** Forgets which call stacks have already been recorded, so that they'll be
+        recorded again the next time they happen.
+    */
+    static void resetSeenViolations() noexcept;
+
+    //==============================================================================
+    /** Marks the calling thread as a realtime thread for the lifetime of this object.
+
+        These can be nested.
+    */
+    class JUCE_API  ScopedRealtimeContext
+    {
+    public:
+       #if JUCE_ENABLE_REALTIME_SAFETY_CHECKS
+        ScopedRealtimeContext() noexcept;
+        ~ScopedRealtimeContext() noexcept;
+       #else
+        ScopedRealtimeContext() noexcept {}
+        ~ScopedRealtimeContext() noexcept {}
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeContext)
+        JUCE_DECLARE_NON_MOVEABLE (ScopedRealtimeContext)
+    };
+
+    /** Returns true if the calling thread is inside a ScopedRealtimeContext. */
+    static bool isRealtimeContext() noexcept;
+
+    //==============================================================================
+    /** Records a violation if the checker is enabled and the calling thread is inside
+        a ScopedRealtimeContext.
+
+        This is called by the checks built into JUCE, and may also be called by your
+        own wrappers around operations that aren't realtime-safe. The function name
+        isn't copied, so it should be a string literal.
+    */
+    static void reportViolation (ViolationType type, const char* functionName) noexcept;
+
+private:
+    RealtimeSafetyChecker() = delete;
+};
+
+#if JUCE_ENABLE_REALTIME_SAFETY_CHECKS || DOXYGEN
+ /** Reports a call to a function that isn't realtime-safe, if it was made inside a
+     RealtimeSafetyChecker::ScopedRealtimeContext.
+
+     This compiles to nothing if JUCE_ENABLE_REALTIME_SAFETY_CHECKS is 0.
+ */
+ #define JUCE_CHECK_REALTIME_SAFETY(type, functionName) \
+    juce::RealtimeSafetyChecker::reportViolation (juce::RealtimeSafetyChecker::ViolationType::type, functionName)
+#else
+ #define JUCE_CHECK_REALTIME_SAFETY(type, functionName)
+#endif
+
+} // namespace juce
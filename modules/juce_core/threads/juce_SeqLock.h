@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds a value that one thread can update while others read consistent copies of
+    it, without any locking.
+
+    This is useful for passing a small group of related values - e.g. meter levels,
+    a transport position, or some statistics - from the audio thread to the UI, where
+    using separate atomics for each value would let readers see a mixture of old and
+    new ones, and using a lock could block the audio thread.
+
+    The value is protected by a sequence number, which the writer makes odd while
+    it's changing the value, and even again when it's finished. Readers copy the value,
+    and then check that the sequence number was even and didn't change while they
+    were copying it, trying again if it did. So store() is wait-free, and load() only
+    ever has to retry if a write happened at the same time.
+
+    Only one thread may call store() at a time. Any number of threads may read.
+
+    The type must be trivially copyable, because readers may copy it while it's being
+    written, and throw the result away. To hand over larger or more complex objects,
+    use a LatestValue instead.
+
+    @see LatestValue
+
+    @tags{Core}
+*/
+template <typename Type>
+class SeqLock
+{
+public:
+    //==============================================================================
+    /** Creates a SeqLock holding a default-constructed value. */
+    SeqLock() noexcept                                  { storeWords (Type()); }
+
+    /** Creates a SeqLock holding the given value. */
+    explicit SeqLock (const Type& initialValue) noexcept    { storeWords (initialValue); }
+
+    //==============================================================================
+    /** Replaces the value. This is wait-free.
+        Only one thread may call this at a time.
+    */
+    void store (const Type& newValue) noexcept
+    {
+        const auto seq = sequence.load (std::memory_order_relaxed);
+        sequence.store (seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        storeWords (newValue);
+
+        sequence.store (seq + 2, std::memory_order_release);
+    }
+
+    /** Returns a consistent copy of the value, retrying if it's being written at the same time. */
+    Type load() const noexcept
+    {
+        Type result;
+
+        while (! tryLoad (result))
+        {}
+
+        return result;
+    }
+
+    /** Tries once to copy the value, returning false if it was being written at the same
+        time. This never waits, so it's suitable for use on a realtime thread.
+    */
+    bool tryLoad (Type& result) const noexcept
+    {
+        const auto seq = sequence.load (std::memory_order_acquire);
+
+        if ((seq & 1) != 0)
+            return false;
+
+        Word words[numWords];
+
+        for (size_t i = 0; i < numWords; ++i)
+            words[i] = storage[i].load (std::memory_order_relaxed);
+
+        std::atomic_thread_fence (std::memory_order_acquire);
+
+        if (sequence.load (std::memory_order_relaxed) != seq)
+            return false;
+
+        std::memcpy (&result, words, sizeof (Type));
+        return true;
+    }
+
+private:
+    //==============================================================================
+    // The value is kept in atomic words, so that reading it while it's being written
+    // isn't a data race
+    using Word = pointer_sized_uint;
+    static constexpr size_t numWords = (sizeof (Type) + sizeof (Word) - 1) / sizeof (Word);
+
+    std::atomic<uint32> sequence { 0 };
+    std::atomic<Word> storage[numWords];
+
+    void storeWords (const Type& newValue) noexcept
+    {
+        // These are checked here rather than at class scope, so that a SeqLock can hold
+        // a nested struct of the class that owns it
+        static_assert (std::is_trivially_copyable_v<Type>, "SeqLock can only be used with trivially copyable types");
+        static_assert (std::is_default_constructible_v<Type>, "SeqLock can only be used with default-constructible types");
+
+        Word words[numWords] {};
+        std::memcpy (words, &newValue, sizeof (Type));
+
+        for (size_t i = 0; i < numWords; ++i)
+            storage[i].store (words[i], std::memory_order_relaxed);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (SeqLock)
+};
+
+} // namespace juce
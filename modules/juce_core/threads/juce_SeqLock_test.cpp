@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class SeqLockTests  : public UnitTest
+{
+public:
+    SeqLockTests()
+        : UnitTest ("SeqLock", UnitTestCategories::threads)
+    {}
+
+    struct State
+    {
+        int64 a = 0, b = 0, c = 0;
+        float d = 0.0f;
+    };
+
+    void runTest() override
+    {
+        beginTest ("SeqLock returns the last stored value");
+        {
+            SeqLock<State> lock;
+            expectEquals (lock.load().a, (int64) 0);
+
+            lock.store ({ 1, 2, 3, 4.0f });
+            const auto s = lock.load();
+            expect (s.a == 1 && s.b == 2 && s.c == 3 && exactlyEqual (s.d, 4.0f));
+
+            State result;
+            expect (lock.tryLoad (result));
+            expectEquals (result.c, (int64) 3);
+        }
+
+        beginTest ("SeqLock readers never see a partially-written value");
+        {
+            SeqLock<State> lock;
+            std::atomic<bool> finished { false };
+            int numTornReads = 0;
+
+            std::thread writer ([&]
+            {
+                for (int64 i = 1; i <= 200000; ++i)
+                    lock.store ({ i, i * 2, i * 3, (float) (i & 0xffff) });
+
+                finished = true;
+            });
+
+            while (! finished)
+            {
+                const auto s = lock.load();
+
+                if (s.b != s.a * 2 || s.c != s.a * 3 || ! exactlyEqual (s.d, (float) (s.a & 0xffff)))
+                    ++numTornReads;
+            }
+
+            writer.join();
+
+            expectEquals (numTornReads, 0);
+            expectEquals (lock.load().a, (int64) 200000);
+        }
+
+        beginTest ("LatestValue hands over published values");
+        {
+            LatestValue<std::vector<int>> latest (std::vector<int> (4));
+            expect (! latest.hasNewValue());
+
+            latest.set ({ 1, 2, 3 });
+            expect (latest.hasNewValue());
+            expect (latest.get() == std::vector<int> { 1, 2, 3 });
+            expect (! latest.hasNewValue());
+
+            latest.getWriteBuffer() = { 4 };
+            latest.publish();
+            latest.set ({ 5 });
+            expect (latest.get() == std::vector<int> { 5 });
+            expect (latest.get() == std::vector<int> { 5 });
+        }
+
+        beginTest ("LatestValue readers always see complete values");
+        {
+            LatestValue<State> latest;
+            std::atomic<bool> finished { false };
+            int numTornReads = 0;
+            int64 lastSeen = 0;
+            bool wentBackwards = false;
+
+            std::thread writer ([&]
+            {
+                for (int64 i = 1; i <= 200000; ++i)
+                {
+                    auto& s = latest.getWriteBuffer();
+                    s = { i, i * 2, i * 3, (float) (i & 0xffff) };
+                    latest.publish();
+                }
+
+                finished = true;
+            });
+
+            while (! finished)
+            {
+                const auto& s = latest.get();
+
+                if (s.b != s.a * 2 || s.c != s.a * 3 || ! exactlyEqual (s.d, (float) (s.a & 0xffff)))
+                    ++numTornReads;
+
+                wentBackwards |= s.a < lastSeen;
+                lastSeen = s.a;
+            }
+
+            writer.join();
+
+            expectEquals (numTornReads, 0);
+            expect (! wentBackwards);
+            expectEquals (latest.get().a, (int64) 200000);
+        }
+    }
+};
+
+static SeqLockTests seqLockTests;
+
+} // namespace juce
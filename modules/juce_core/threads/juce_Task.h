@@ -0,0 +1,392 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_COROUTINES_AVAILABLE || DOXYGEN
+
+//==============================================================================
+/**
+    A C++20 coroutine that produces a value of the given type.
+
+    Write a function that returns a Task and uses co_await or co_return, and it
+    becomes a coroutine that another coroutine can co_await. A Task doesn't start
+    running until it's awaited or started, and when it finishes, whatever was awaiting
+    it carries on straight away, on the same thread, without any extra messages or
+    allocations.
+
+    Use the resumeOn() functions to move a coroutine between threads, so that the
+    stages of a job can each run in the right place without a chain of callbacks:
+    @code
+    Task<AnalysisResult> analyseFile (File file, ThreadPool& pool)
+    {
+        auto data = co_await readFileAsync (file, pool);   // now on a pool thread
+
+        if (! data.has_value())
+            co_return {};
+
+        co_return analyse (*data);
+    }
+
+    Task<> updateDisplay (File file, ThreadPool& pool)
+    {
+        auto result = co_await analyseFile (file, pool);
+        co_await resumeOnMessageThread();
+        display (result);
+    }
+
+    updateDisplay (file, pool).start();
+    @endcode
+
+    If the coroutine throws an exception, it's rethrown by co_await.
+
+    This is only available when compiling with C++20 coroutine support, which is
+    indicated by JUCE_COROUTINES_AVAILABLE.
+
+    @see resumeOn, TimeSliceExecutor
+
+    @tags{Core}
+*/
+template <typename Type = void>
+class [[nodiscard]] Task
+{
+public:
+    struct promise_type;
+
+    //==============================================================================
+    /** Creates an empty Task. */
+    Task() noexcept = default;
+
+    /** Move constructor. */
+    Task (Task&& other) noexcept  : handle (std::exchange (other.handle, {})) {}
+
+    /** Move assignment. */
+    Task& operator= (Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            handle = std::exchange (other.handle, {});
+        }
+
+        return *this;
+    }
+
+    /** Destructor. This destroys the coroutine, so a Task must not be deleted while it's running. */
+    ~Task()     { destroy(); }
+
+    /** Returns true if this object holds a coroutine. */
+    bool isValid() const noexcept           { return static_cast<bool> (handle); }
+
+    //==============================================================================
+    /** Starts running the coroutine on the calling thread, without anything waiting for it.
+
+        The Task object is consumed, and the coroutine deletes itself when it finishes,
+        after calling onCompletion (if provided) with its result. Any exception thrown by
+        the coroutine will terminate the program, so handle them inside it.
+    */
+    void start() &&
+    {
+        runDetached (std::move (*this), [] (auto&&...) {});
+    }
+
+    /** Starts running the coroutine on the calling thread, and calls a function with the
+        result when it finishes. The function is called on whichever thread the coroutine
+        finished on.
+    */
+    template <typename Callback>
+    void start (Callback&& onCompletion) &&
+    {
+        runDetached (std::move (*this), std::forward<Callback> (onCompletion));
+    }
+
+    //==============================================================================
+   #ifndef DOXYGEN
+    struct Awaiter
+    {
+        std::coroutine_handle<promise_type> awaited;
+
+        bool await_ready() const noexcept               { return ! awaited || awaited.done(); }
+
+        std::coroutine_handle<> await_suspend (std::coroutine_handle<> awaiting) noexcept
+        {
+            awaited.promise().continuation = awaiting;
+            return awaited;
+        }
+
+        Type await_resume()                             { return awaited.promise().getResult(); }
+    };
+
+    Awaiter operator co_await() && noexcept             { return { handle }; }
+
+    //==============================================================================
+    struct PromiseBase
+    {
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept           { return false; }
+            void await_resume() const noexcept          {}
+
+            std::coroutine_handle<> await_suspend (std::coroutine_handle<promise_type> finished) noexcept
+            {
+                if (auto next = finished.promise().continuation)
+                    return next;
+
+                return std::noop_coroutine();
+            }
+        };
+
+        std::suspend_always initial_suspend() const noexcept    { return {}; }
+        FinalAwaiter final_suspend() const noexcept             { return {}; }
+        void unhandled_exception() noexcept                     { exception = std::current_exception(); }
+
+        void rethrowIfFailed() const
+        {
+            if (exception != nullptr)
+                std::rethrow_exception (exception);
+        }
+
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+    };
+
+    struct ValuePromise : public PromiseBase
+    {
+        template <typename ValueType>
+        void return_value (ValueType&& v)               { value.emplace (std::forward<ValueType> (v)); }
+
+        Type getResult()
+        {
+            this->rethrowIfFailed();
+            jassert (value.has_value());
+            return std::move (*value);
+        }
+
+        std::optional<Type> value;
+    };
+
+    struct VoidPromise : public PromiseBase
+    {
+        void return_void() const noexcept               {}
+        void getResult() const                          { this->rethrowIfFailed(); }
+    };
+
+    struct promise_type : public std::conditional_t<std::is_void_v<Type>, VoidPromise, ValuePromise>
+    {
+        Task get_return_object() noexcept               { return Task (std::coroutine_handle<promise_type>::from_promise (*this)); }
+    };
+   #endif
+
+private:
+    //==============================================================================
+    explicit Task (std::coroutine_handle<promise_type> h) noexcept  : handle (h) {}
+
+    void destroy() noexcept
+    {
+        if (handle)
+            std::exchange (handle, {}).destroy();
+    }
+
+    // A coroutine that runs until it finishes and then deletes itself
+    struct Detached
+    {
+        struct promise_type
+        {
+            Detached get_return_object() const noexcept         { return {}; }
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept   { return {}; }
+            void return_void() const noexcept                   {}
+            void unhandled_exception() const noexcept           { std::terminate(); }
+        };
+    };
+
+    template <typename Callback>
+    static Detached runDetached (Task task, Callback onCompletion)
+    {
+        if constexpr (std::is_void_v<Type>)
+        {
+            co_await std::move (task);
+            onCompletion();
+        }
+        else
+        {
+            onCompletion (co_await std::move (task));
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle;
+
+    JUCE_DECLARE_NON_COPYABLE (Task)
+};
+
+//==============================================================================
+/** Returns an object that can be awaited in a coroutine to make the rest of the
+    coroutine run on one of a ThreadPool's threads.
+
+    e.g. @code co_await resumeOn (pool); @endcode
+
+    @see Task
+*/
+inline auto resumeOn (ThreadPool& pool) noexcept
+{
+    struct Awaiter
+    {
+        ThreadPool& threadPool;
+
+        bool await_ready() const noexcept                       { return false; }
+        void await_suspend (std::coroutine_handle<> h) const    { threadPool.addJob ([h] { h.resume(); }); }
+        void await_resume() const noexcept                      {}
+    };
+
+    return Awaiter { pool };
+}
+
+//==============================================================================
+/**
+    Runs coroutines on a TimeSliceThread.
+
+    Create one of these for a TimeSliceThread, and use resumeOn() to move a coroutine
+    onto the thread, where it will run in between the thread's other clients. The
+    executor must outlive any coroutines that are scheduled on it.
+
+    @see Task, resumeOn
+
+    @tags{Core}
+*/
+class JUCE_API  TimeSliceExecutor  : private TimeSliceClient
+{
+public:
+    /** Creates an executor, and adds it to the given thread as a client. */
+    explicit TimeSliceExecutor (TimeSliceThread& threadToUse)
+        : thread (threadToUse)
+    {
+        thread.addTimeSliceClient (this);
+    }
+
+    /** Destructor. */
+    ~TimeSliceExecutor() override
+    {
+        thread.removeTimeSliceClient (this);
+
+        // Deleting the executor would leave these coroutines suspended forever!
+        jassert (pending.empty());
+    }
+
+    /** Arranges for a suspended coroutine to be resumed on the thread. */
+    void schedule (std::coroutine_handle<> coroutine)
+    {
+        {
+            const ScopedLock sl (lock);
+            pending.push_back (coroutine);
+        }
+
+        thread.moveToFrontOfQueue (this);
+    }
+
+private:
+    int useTimeSlice() override
+    {
+        {
+            const ScopedLock sl (lock);
+            resuming.swap (pending);
+        }
+
+        for (auto h : resuming)
+            h.resume();
+
+        resuming.clear();
+        return 500;
+    }
+
+    TimeSliceThread& thread;
+    CriticalSection lock;
+    std::vector<std::coroutine_handle<>> pending, resuming;
+
+    JUCE_DECLARE_NON_COPYABLE (TimeSliceExecutor)
+};
+
+/** Returns an object that can be awaited in a coroutine to make the rest of the
+    coroutine run on a TimeSliceExecutor's thread.
+
+    e.g. @code co_await resumeOn (executor); @endcode
+
+    @see Task
+*/
+inline auto resumeOn (TimeSliceExecutor& executor) noexcept
+{
+    struct Awaiter
+    {
+        TimeSliceExecutor& target;
+
+        bool await_ready() const noexcept                       { return false; }
+        void await_suspend (std::coroutine_handle<> h) const    { target.schedule (h); }
+        void await_resume() const noexcept                      {}
+    };
+
+    return Awaiter { executor };
+}
+
+//==============================================================================
+/** Reads the whole of a file on one of a ThreadPool's threads.
+
+    The coroutine that awaits the result carries on running on that thread, so it
+    can go on to process the data there.
+
+    @returns the file's contents, or an empty optional if it couldn't be read
+    @see Task
+*/
+inline Task<std::optional<MemoryBlock>> readFileAsync (File file, ThreadPool& pool)
+{
+    co_await resumeOn (pool);
+
+    MemoryBlock data;
+
+    if (! file.loadFileAsData (data))
+        co_return std::nullopt;
+
+    co_return data;
+}
+
+/** Downloads the contents of a URL on one of a ThreadPool's threads.
+
+    The coroutine that awaits the result carries on running on that thread, so it
+    can go on to process the data there.
+
+    @returns the data, or an empty optional if it couldn't be read
+    @see Task
+*/
+inline Task<std::optional<MemoryBlock>> readURLAsync (URL url, ThreadPool& pool)
+{
+    co_await resumeOn (pool);
+
+    MemoryBlock data;
+
+    if (! url.readEntireBinaryStream (data))
+        co_return std::nullopt;
+
+    co_return data;
+}
+
+#endif
+
+} // namespace juce
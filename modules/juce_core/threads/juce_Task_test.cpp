@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_COROUTINES_AVAILABLE
+
+class TaskTests  : public UnitTest
+{
+public:
+    TaskTests()
+        : UnitTest ("Task", UnitTestCategories::threads)
+    {}
+
+    static Task<int> add (int a, int b)
+    {
+        co_return a + b;
+    }
+
+    static Task<int> addTwice (int a, int b)
+    {
+        auto first = co_await add (a, b);
+        co_return first + co_await add (a, b);
+    }
+
+    static Task<> fail()
+    {
+        throw std::runtime_error ("failed");
+        co_return;
+    }
+
+    static Task<Thread::ThreadID> getThreadIDOn (ThreadPool& pool)
+    {
+        co_await resumeOn (pool);
+        co_return Thread::getCurrentThreadId();
+    }
+
+    static Task<Thread::ThreadID> getThreadIDOn (TimeSliceExecutor& executor)
+    {
+        co_await resumeOn (executor);
+        co_return Thread::getCurrentThreadId();
+    }
+
+    void runTest() override
+    {
+        beginTest ("Tasks don't start until they're started or awaited");
+        {
+            bool hasRun = false;
+            auto task = [&]() -> Task<>
+            {
+                hasRun = true;
+                co_return;
+            }();
+
+            expect (! hasRun);
+            std::move (task).start();
+            expect (hasRun);
+        }
+
+        beginTest ("Awaited tasks produce their results");
+        {
+            int result = 0;
+            addTwice (2, 3).start ([&] (int r) { result = r; });
+            expectEquals (result, 10);
+        }
+
+        beginTest ("Exceptions are rethrown by co_await");
+        {
+            bool caught = false;
+
+            [&]() -> Task<>
+            {
+                try
+                {
+                    co_await fail();
+                }
+                catch (const std::runtime_error&)
+                {
+                    caught = true;
+                }
+            }().start();
+
+            expect (caught);
+        }
+
+        beginTest ("Coroutines can move onto other threads");
+        {
+            ThreadPool pool (2);
+            TimeSliceThread timeSliceThread ("Task test");
+            timeSliceThread.startThread();
+
+            {
+                TimeSliceExecutor executor (timeSliceThread);
+                WaitableEvent finished;
+                Thread::ThreadID poolThread = nullptr, timeSliceThreadID = nullptr;
+
+                [&]() -> Task<>
+                {
+                    poolThread = co_await getThreadIDOn (pool);
+                    timeSliceThreadID = co_await getThreadIDOn (executor);
+                }().start ([&] { finished.signal(); });
+
+                expect (finished.wait (5000));
+                expect (poolThread != nullptr && poolThread != Thread::getCurrentThreadId());
+                expect (timeSliceThreadID != nullptr && timeSliceThreadID != poolThread);
+            }
+
+            timeSliceThread.stopThread (1000);
+        }
+
+        beginTest ("Files can be read asynchronously");
+        {
+            ThreadPool pool (1);
+            TemporaryFile temp;
+            temp.getFile().replaceWithText ("coroutine");
+
+            WaitableEvent finished;
+            std::optional<MemoryBlock> contents, missing;
+
+            [&]() -> Task<>
+            {
+                contents = co_await readFileAsync (temp.getFile(), pool);
+                missing = co_await readFileAsync (temp.getFile().getSiblingFile ("doesn't exist"), pool);
+            }().start ([&] { finished.signal(); });
+
+            expect (finished.wait (5000));
+            expect (contents.has_value() && contents->toString() == "coroutine");
+            expect (! missing.has_value());
+        }
+    }
+};
+
+static TaskTests taskTests;
+
+#endif
+
+} // namespace juce
@@ -90,8 +90,12 @@ void Thread::threadEntryPoint()
     {
         jassert (getCurrentThreadId() == threadId);
 
-        if (affinityMask != 0)
-            setCurrentThreadAffinityMask (affinityMask);
+        const auto mask = realtimeOptions.has_value() && realtimeOptions->getAffinityMask() != 0
+                        ? realtimeOptions->getAffinityMask()
+                        : affinityMask;
+
+        if (mask != 0)
+            setCurrentThreadAffinityMask (mask);
 
         try
         {
@@ -158,6 +158,40 @@ public:
             return withPeriodMs (1'000.0 / newPeriodHz);
         }
 
+        /** Specify the CPU cores that the thread may run on, as a bitmask in which bit n
+            represents core n. The default of zero lets the thread run on any core.
+
+            If this is non-zero, it's used instead of any mask passed to setAffinityMask().
+            To keep other work away from an audio thread, pin it to cores that have been
+            removed from the OS scheduler, e.g. with the isolcpus kernel parameter on Linux.
+
+            Not supported on macOS/iOS.
+
+            @see getAffinityMask
+        */
+        [[nodiscard]] RealtimeOptions withAffinityMask (uint32 newAffinityMask) const
+        {
+            return withMember (*this, &RealtimeOptions::affinityMask, newAffinityMask);
+        }
+
+        /** The scheduling policies that a realtime thread can use. */
+        enum class SchedulingPolicy
+        {
+            roundRobin,         /**< Threads with the same priority take turns to run (SCHED_RR). */
+            firstInFirstOut     /**< The thread runs until it blocks, or until a thread with a higher priority is ready (SCHED_FIFO). */
+        };
+
+        /** Specify the scheduling policy to use.
+
+            Only used by Linux/BSD.
+
+            @see getSchedulingPolicy
+        */
+        [[nodiscard]] RealtimeOptions withSchedulingPolicy (SchedulingPolicy newSchedulingPolicy) const
+        {
+            return withMember (*this, &RealtimeOptions::schedulingPolicy, newSchedulingPolicy);
+        }
+
         /** Returns a value with a range of 0-10, where 10 is the highest priority.
 
             @see withPriority
@@ -197,11 +231,32 @@ public:
             return periodMs;
         }
 
+        /** Returns the mask of CPU cores that the thread may run on, or zero if it may
+            run on any core.
+
+            @see withAffinityMask
+        */
+        [[nodiscard]] uint32 getAffinityMask() const
+        {
+            return affinityMask;
+        }
+
+        /** Returns the scheduling policy to use.
+
+            @see withSchedulingPolicy
+        */
+        [[nodiscard]] SchedulingPolicy getSchedulingPolicy() const
+        {
+            return schedulingPolicy;
+        }
+
     private:
         int priority { 5 };
         std::optional<double> processingTimeMs;
         std::optional<double> maximumProcessingTimeMs;
         std::optional<double> periodMs{};
+        uint32 affinityMask { 0 };
+        SchedulingPolicy schedulingPolicy { SchedulingPolicy::roundRobin };
     };
 
     //==============================================================================
@@ -434,6 +489,18 @@ public:
     */
     static void JUCE_CALLTYPE setCurrentThreadAffinityMask (uint32 affinityMask);
 
+    /** Tries to give the caller thread realtime scheduling, using the given options.
+
+        This is useful for threads that weren't started by a Thread object, such as the
+        threads on which some audio devices call their callbacks. It returns false if
+        the scheduling couldn't be changed, e.g. because the process doesn't have
+        permission to use realtime scheduling. Any affinity mask in the options is
+        applied either way.
+
+        @see startRealtimeThread, setCurrentThreadAffinityMask
+    */
+    static bool JUCE_CALLTYPE setCurrentThreadRealtimeOptions (const RealtimeOptions& options);
+
     //==============================================================================
     /** Suspends the execution of the current thread until the specified timeout period
         has elapsed (note that this may not be exact).
@@ -69,6 +69,13 @@ void ThreadPoolJob::setJobName (const String& newName)
     jobName = newName;
 }
 
+void ThreadPoolJob::setJobOptions (const ThreadPoolJobOptions& newOptions)
+{
+    // The options can't be changed while the job's in a pool - use ThreadPool::setJobPriority() instead
+    jassert (pool == nullptr);
+    options = newOptions;
+}
+
 void ThreadPoolJob::signalJobShouldExit()
 {
     shouldStop = true;
@@ -144,7 +151,7 @@ void ThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished)
 
         {
             const ScopedLock sl (lock);
-            jobs.add (job);
+            insertJobInQueue (job);
         }
 
         for (auto* t : threads)
@@ -178,6 +185,60 @@ void ThreadPool::addJob (std::function<void()> jobToRun)
     addJob (new LambdaJobWrapper (std::move (jobToRun)), true);
 }
 
+void ThreadPool::addJob (std::function<void()> jobToRun, const ThreadPoolJobOptions& options)
+{
+    struct LambdaJobWrapper final : public ThreadPoolJob
+    {
+        LambdaJobWrapper (std::function<void()> j) : ThreadPoolJob ("lambda"), job (std::move (j)) {}
+        JobStatus runJob() override      { job(); return ThreadPoolJob::jobHasFinished; }
+
+        std::function<void()> job;
+    };
+
+    auto* job = new LambdaJobWrapper (std::move (jobToRun));
+    job->setJobOptions (options);
+    addJob (job, true);
+}
+
+// Returns true if job a should be run before job b
+static bool shouldRunBefore (const ThreadPoolJob& a, const ThreadPoolJob& b) noexcept
+{
+    auto& optionsA = a.getJobOptions();
+    auto& optionsB = b.getJobOptions();
+
+    if (optionsA.priority != optionsB.priority)
+        return optionsA.priority > optionsB.priority;
+
+    if (optionsA.deadline.has_value() != optionsB.deadline.has_value())
+        return optionsA.deadline.has_value();
+
+    return optionsA.deadline.has_value() && *optionsA.deadline < *optionsB.deadline;
+}
+
+void ThreadPool::insertJobInQueue (ThreadPoolJob* job)
+{
+    // Usually every job has the same priority, so this is normally just an append
+    auto index = jobs.size();
+
+    while (index > 0 && shouldRunBefore (*job, *jobs.getUnchecked (index - 1)))
+        --index;
+
+    jobs.insert (index, job);
+}
+
+void ThreadPool::setJobPriority (ThreadPoolJob* job, int newPriority) noexcept
+{
+    const ScopedLock sl (lock);
+
+    if (job->options.priority != newPriority)
+    {
+        job->options.priority = newPriority;
+
+        if (! job->isActive && jobs.removeFirstMatchingValue (job) >= 0)
+            insertJobInQueue (job);
+    }
+}
+
 int ThreadPool::getNumJobs() const noexcept
 {
     const ScopedLock sl (lock);
@@ -235,6 +296,40 @@ bool ThreadPool::waitForJobToFinish (const ThreadPoolJob* job, int timeOutMs) co
     return true;
 }
 
+bool ThreadPool::waitForGroup (int groupID, int timeOutMs) const
+{
+    auto start = Time::getMillisecondCounter();
+
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (std::none_of (jobs.begin(), jobs.end(), [groupID] (auto* j) { return j->options.groupID == groupID; }))
+                return true;
+        }
+
+        if (timeOutMs >= 0 && Time::getMillisecondCounter() >= start + (uint32) timeOutMs)
+            return false;
+
+        jobFinishedSignal.wait (2);
+    }
+}
+
+bool ThreadPool::removeGroup (int groupID, bool interruptRunningJobs, int timeOutMs)
+{
+    struct GroupSelector final : public JobSelector
+    {
+        explicit GroupSelector (int g) : group (g) {}
+        bool isJobSuitable (ThreadPoolJob* job) override    { return job->getJobOptions().groupID == group; }
+
+        int group;
+    };
+
+    GroupSelector selector (groupID);
+    return removeAllJobs (interruptRunningJobs, timeOutMs, &selector);
+}
+
 bool ThreadPool::removeJob (ThreadPoolJob* job, bool interruptIfRunning, int timeOutMs)
 {
     bool dontWait = true;
@@ -347,7 +442,7 @@ ThreadPoolJob* ThreadPool::pickNextJobToRun()
             {
                 if (! job->isActive)
                 {
-                    if (job->shouldStop)
+                    if (job->shouldExit())
                     {
                         jobs.remove (i);
                         addToDeleteList (deletionList, job);
@@ -374,6 +469,7 @@ bool ThreadPool::runNextJob (ThreadPoolThread& thread)
 
         try
         {
+            JUCE_TRACE_SCOPE ("threads", "ThreadPoolJob::runJob");
             result = job->runJob();
         }
         catch (...)
@@ -401,8 +497,9 @@ bool ThreadPool::runNextJob (ThreadPoolThread& thread)
                 }
                 else
                 {
-                    // move the job to the end of the queue if it wants another go
-                    jobs.move (jobs.indexOf (job), -1);
+                    // put the job back behind the others of the same rank if it wants another go
+                    jobs.removeFirstMatchingValue (job);
+                    insertJobInQueue (job);
                 }
             }
         }
@@ -422,4 +519,154 @@ void ThreadPool::addToDeleteList (OwnedArray<ThreadPoolJob>& deletionList, Threa
         deletionList.add (job);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ThreadPoolTests final : public UnitTest
+{
+public:
+    ThreadPoolTests()
+        : UnitTest ("ThreadPool", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Jobs run in order of priority, then deadline, then the order they were added");
+        {
+            ThreadPool pool (1);
+            Order order;
+            blockPool (pool);
+
+            auto now = Time::getCurrentTime();
+            order.add (pool, "bulk", ThreadPoolJobOptions().withPriority (-1));
+            order.add (pool, "first", {});
+            order.add (pool, "late", ThreadPoolJobOptions().withDeadline (now + RelativeTime::seconds (10)));
+            order.add (pool, "urgent", ThreadPoolJobOptions().withPriority (2));
+            order.add (pool, "second", {});
+            order.add (pool, "soon", ThreadPoolJobOptions().withDeadline (now + RelativeTime::seconds (1)));
+            order.add (pool, "visible", ThreadPoolJobOptions().withPriority (1));
+
+            releasePool();
+            expect (pool.waitForGroup (0, 5000));
+            expectEquals (order.get(), String ("urgent visible soon late first second bulk"));
+        }
+
+        beginTest ("Priorities can be changed while jobs are queued");
+        {
+            ThreadPool pool (1);
+            Order order;
+            blockPool (pool);
+
+            order.add (pool, "a", {});
+            order.add (pool, "b", {});
+            pool.setJobPriority (pool.getJob (2), 1);
+
+            releasePool();
+            expect (pool.waitForGroup (0, 5000));
+            expectEquals (order.get(), String ("b a"));
+        }
+
+        beginTest ("Cancelled jobs don't run, and running ones are told to exit");
+        {
+            ThreadPool pool (1);
+            CancellationToken token;
+            std::atomic<bool> sawCancellation { false }, started { false }, queuedJobRan { false };
+
+            pool.addJob ([&]
+            {
+                started = true;
+
+                while (! ThreadPoolJob::getCurrentThreadPoolJob()->shouldExit())
+                    Thread::sleep (1);
+
+                sawCancellation = true;
+            }, ThreadPoolJobOptions().withCancellationToken (token));
+
+            pool.addJob ([&] { queuedJobRan = true; }, ThreadPoolJobOptions().withCancellationToken (token));
+
+            while (! started)
+                Thread::sleep (1);
+
+            token.cancel();
+            expect (pool.removeAllJobs (false, 5000));
+            expect (sawCancellation);
+            expect (! queuedJobRan);
+        }
+
+        beginTest ("Groups can be waited for and removed");
+        {
+            ThreadPool pool (2);
+            std::atomic<int> numFinished { 0 };
+            std::atomic<bool> otherGroupRan { false };
+
+            for (int i = 0; i < 10; ++i)
+                pool.addJob ([&] { Thread::sleep (1); ++numFinished; }, ThreadPoolJobOptions().withGroup (1));
+
+            expect (pool.waitForGroup (1, 5000));
+            expectEquals (numFinished.load(), 10);
+
+            blockPool (pool);
+            blockPool (pool);
+            pool.addJob ([&] { otherGroupRan = true; }, ThreadPoolJobOptions().withGroup (2));
+            expect (! pool.waitForGroup (2, 0));
+            expect (pool.removeGroup (2, true, 5000));
+            expect (pool.waitForGroup (2, 0));
+
+            releasePool();
+            expect (pool.removeAllJobs (false, 5000));
+            expect (! otherGroupRan);
+        }
+    }
+
+private:
+    struct Order
+    {
+        void add (ThreadPool& pool, const String& name, const ThreadPoolJobOptions& options)
+        {
+            pool.addJob ([this, name]
+            {
+                const ScopedLock sl (lock);
+                names.add (name);
+            }, options);
+        }
+
+        String get() const
+        {
+            const ScopedLock sl (lock);
+            return names.joinIntoString (" ");
+        }
+
+        CriticalSection lock;
+        StringArray names;
+    };
+
+    // Adds a job that keeps a thread busy until releasePool() is called
+    void blockPool (ThreadPool& pool)
+    {
+        release.reset();
+        std::atomic<bool> started { false };
+
+        pool.addJob ([this, &started]
+        {
+            started = true;
+            release.wait();
+        }, ThreadPoolJobOptions().withPriority (100));
+
+        while (! started)
+            Thread::sleep (1);
+    }
+
+    void releasePool()
+    {
+        release.signal();
+    }
+
+    WaitableEvent release { true };
+};
+
+static ThreadPoolTests threadPoolTests;
+
+#endif
+
 } // namespace juce
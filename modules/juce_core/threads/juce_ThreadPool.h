@@ -25,6 +25,89 @@ namespace juce
 
 class ThreadPool;
 
+//==============================================================================
+/**
+    A flag that can be shared between any number of jobs, to cancel all of them at once.
+
+    Copies of a CancellationToken all refer to the same flag, so once cancel() has been
+    called on any of them, isCancelled() returns true for all of them.
+
+    @see ThreadPoolJobOptions
+
+    @tags{Core}
+*/
+class JUCE_API  CancellationToken
+{
+public:
+    /** Creates a new token, which hasn't been cancelled. */
+    CancellationToken()  : cancelled (std::make_shared<std::atomic<bool>> (false)) {}
+
+    /** Cancels this token and all of its copies. */
+    void cancel() noexcept                      { cancelled->store (true); }
+
+    /** Returns true if cancel() has been called on this token or any of its copies. */
+    bool isCancelled() const noexcept           { return cancelled->load(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled;
+};
+
+//==============================================================================
+/**
+    Controls when a ThreadPool runs a job.
+
+    Queued jobs are run in order of priority, then deadline, and jobs with the same
+    priority and deadline are run in the order they were added.
+
+    @see ThreadPoolJob::setJobOptions, ThreadPool::addJob
+
+    @tags{Core}
+*/
+struct ThreadPoolJobOptions
+{
+    /** Jobs with higher priorities are run before ones with lower priorities. The
+        default is 0, and negative values can be used for bulk work that should wait
+        for everything else.
+    */
+    [[nodiscard]] ThreadPoolJobOptions withPriority (int newPriority) const
+    {
+        return withMember (*this, &ThreadPoolJobOptions::priority, newPriority);
+    }
+
+    /** Among jobs with the same priority, ones with earlier deadlines are run first,
+        and jobs without a deadline are run after the ones that have one. Missing the
+        deadline doesn't stop a job from running.
+    */
+    [[nodiscard]] ThreadPoolJobOptions withDeadline (Time newDeadline) const
+    {
+        return withMember (*this, &ThreadPoolJobOptions::deadline, std::optional<Time> (newDeadline));
+    }
+
+    /** Puts the job into a group, so that it can be waited for or removed along with
+        the other jobs in the group. Zero means that the job isn't in a group.
+
+        @see ThreadPool::waitForGroup, ThreadPool::removeGroup
+    */
+    [[nodiscard]] ThreadPoolJobOptions withGroup (int newGroupID) const
+    {
+        return withMember (*this, &ThreadPoolJobOptions::groupID, newGroupID);
+    }
+
+    /** Gives the job a token that can be used to cancel it. Once the token has been
+        cancelled, the job's shouldExit() method returns true, and if it hasn't started
+        yet, it's removed from the pool without being run.
+    */
+    [[nodiscard]] ThreadPoolJobOptions withCancellationToken (CancellationToken newToken) const
+    {
+        return withMember (*this, &ThreadPoolJobOptions::cancellationToken, std::optional<CancellationToken> (std::move (newToken)));
+    }
+
+    int priority = 0;
+    std::optional<Time> deadline;
+    int groupID = 0;
+    std::optional<CancellationToken> cancellationToken;
+};
+
 //==============================================================================
 /**
     A task that is executed by a ThreadPool object.
@@ -64,6 +147,16 @@ public:
     */
     void setJobName (const String& newName);
 
+    //==============================================================================
+    /** Sets the job's priority, deadline, group and cancellation token.
+        This must be called before the job is added to a pool.
+        @see ThreadPool::setJobPriority
+    */
+    void setJobOptions (const ThreadPoolJobOptions& newOptions);
+
+    /** Returns the job's priority, deadline, group and cancellation token. */
+    const ThreadPoolJobOptions& getJobOptions() const noexcept     { return options; }
+
     //==============================================================================
     /** These are the values that can be returned by the runJob() method.
     */
@@ -104,7 +197,10 @@ public:
 
         @see signalJobShouldExit()
     */
-    bool shouldExit() const noexcept                    { return shouldStop; }
+    bool shouldExit() const noexcept
+    {
+        return shouldStop || (options.cancellationToken.has_value() && options.cancellationToken->isCancelled());
+    }
 
     /** Calling this will cause the shouldExit() method to return true, and the job
         should (if it's been implemented correctly) stop as soon as possible.
@@ -133,6 +229,7 @@ public:
 private:
     friend class ThreadPool;
     String jobName;
+    ThreadPoolJobOptions options;
     ThreadPool* pool = nullptr;
     std::atomic<bool> shouldStop { false }, isActive { false }, shouldBeDeleted { false };
     ListenerList<Thread::Listener, Array<Thread::Listener*, CriticalSection>> listeners;
@@ -262,10 +359,11 @@ public:
     //==============================================================================
     /** Adds a job to the queue.
 
-        Once a job has been added, then the next time a thread is free, it will run
-        the job's ThreadPoolJob::runJob() method. Depending on the return value of the
-        runJob() method, the pool will either remove the job from the pool or add it to
-        the back of the queue to be run again.
+        Once a job has been added, then the next time a thread is free that isn't needed
+        for a job with a higher priority or an earlier deadline, it will run the job's
+        ThreadPoolJob::runJob() method. Depending on the return value of the runJob()
+        method, the pool will either remove the job from the pool or put it back in the
+        queue, behind any others with the same priority and deadline, to be run again.
 
         If deleteJobWhenFinished is true, then the job object will be owned and deleted by
         the pool when not needed - if you do this, make sure that your object's destructor
@@ -288,6 +386,17 @@ public:
     */
     void addJob (std::function<void()> job);
 
+    /** Adds a lambda function to be called as a job, with the given priority, deadline,
+        group and cancellation token.
+        This will create an internal ThreadPoolJob object to encapsulate and call the lambda.
+    */
+    void addJob (std::function<void()> job, const ThreadPoolJobOptions& options);
+
+    /** Changes the priority of a job. If it's waiting in the queue, it will be moved to
+        the appropriate position.
+    */
+    void setJobPriority (ThreadPoolJob* job, int newPriority) noexcept;
+
     /** Tries to remove a job from the pool.
 
         If the job isn't yet running, this will simply remove it. If it is running, it
@@ -357,8 +466,25 @@ public:
     bool waitForJobToFinish (const ThreadPoolJob* job,
                              int timeOutMilliseconds) const;
 
+    /** Waits until all the jobs in a group have finished and been removed from the pool.
+
+        If the timeout period expires first, this will return false; it returns true if
+        the group's jobs have all finished.
+
+        @see ThreadPoolJobOptions::withGroup
+    */
+    bool waitForGroup (int groupID, int timeOutMilliseconds) const;
+
+    /** Tries to remove all the jobs in a group from the pool.
+
+        This works like removeAllJobs(), but only for the jobs in the given group.
+
+        @see ThreadPoolJobOptions::withGroup
+    */
+    bool removeGroup (int groupID, bool interruptRunningJobs, int timeOutMilliseconds);
+
     /** If the given job is in the queue, this will move it to the front so that it
-        is the next one to be executed.
+        is the next one to be executed, regardless of its priority.
     */
     void moveJobToFront (const ThreadPoolJob* jobToMove) noexcept;
 
@@ -379,6 +505,7 @@ private:
     WaitableEvent jobFinishedSignal;
 
     bool runNextJob (ThreadPoolThread&);
+    void insertJobInQueue (ThreadPoolJob*);
     ThreadPoolJob* pickNextJobToRun();
     void addToDeleteList (OwnedArray<ThreadPoolJob>&, ThreadPoolJob*) const;
     void stopThreads();
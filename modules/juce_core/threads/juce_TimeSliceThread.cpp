@@ -83,6 +83,10 @@ void TimeSliceThread::moveToFrontOfQueue (TimeSliceClient* client)
     if (clients.contains (client))
     {
         client->nextCallTime = Time::getCurrentTime();
+
+        if (client == clientBeingCalled)
+            clientBeingCalledWasMovedToFront = true;
+
         notify();
     }
 }
@@ -172,12 +176,13 @@ void TimeSliceThread::run()
 
                         const ScopedLock sl2 (listLock);
 
-                        if (msUntilNextCall >= 0)
-                            clientBeingCalled->nextCallTime = now + RelativeTime::milliseconds (msUntilNextCall);
-                        else
+                        if (msUntilNextCall < 0)
                             clients.removeFirstMatchingValue (clientBeingCalled);
+                        else if (! clientBeingCalledWasMovedToFront)
+                            clientBeingCalled->nextCallTime = now + RelativeTime::milliseconds (msUntilNextCall);
 
                         clientBeingCalled = nullptr;
+                        clientBeingCalledWasMovedToFront = false;
                     }
                 }
             }
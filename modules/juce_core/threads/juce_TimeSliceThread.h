@@ -109,6 +109,8 @@ public:
 
     /** If the given client is waiting in the queue, it will be moved to the front
         and given a time-slice as soon as possible.
+        If this is called while the client's useTimeSlice() method is running, the client
+        will be called again straight afterwards, whatever useTimeSlice() returns.
         If the specified client has not been added, nothing will happen.
     */
     void moveToFrontOfQueue (TimeSliceClient* clientToMove);
@@ -144,6 +146,7 @@ private:
     CriticalSection callbackLock, listLock;
     Array<TimeSliceClient*> clients;
     TimeSliceClient* clientBeingCalled = nullptr;
+    bool clientBeingCalledWasMovedToFront = false;
 
     TimeSliceClient* getNextClient (int index) const;
 
@@ -30,6 +30,8 @@ WaitableEvent::WaitableEvent (bool manualReset) noexcept
 
 bool WaitableEvent::wait (double timeOutMilliseconds) const
 {
+    JUCE_CHECK_REALTIME_SAFETY (blockingCall, "WaitableEvent::wait");
+
     std::unique_lock<std::mutex> lock (mutex);
 
     if (! triggered)
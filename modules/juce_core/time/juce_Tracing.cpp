@@ -0,0 +1,446 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct Tracing::Buffers
+{
+    enum class Type : uint8  { complete, instant, counter };
+
+    struct Event
+    {
+        int64 startTicks, endTicks;
+        const char* category;
+        const char* name;
+        double value;
+        Type type;
+    };
+
+    struct alignas (hardwareDestructiveInterferenceSize) ThreadBuffer
+    {
+        std::atomic<Thread::ThreadID> owner { nullptr };
+        std::atomic<bool> inUse { false };
+        std::atomic<const char*> threadName { nullptr };
+        std::atomic<uint64> numWritten { 0 };
+        HeapBlock<Event> events;
+    };
+
+    explicit Buffers (const Options& o)
+        : eventsPerThread ((uint64) nextPowerOfTwo (jmax (16, o.getEventsPerThread()))),
+          numThreads ((size_t) nextPowerOfTwo (jmax (1, o.getMaxNumThreads()))),
+          threads (new ThreadBuffer[numThreads])
+    {
+        for (size_t i = 0; i < numThreads; ++i)
+            threads[i].events.calloc (eventsPerThread);
+    }
+
+    ThreadBuffer* getBufferForThisThread() noexcept
+    {
+        auto thread = Thread::getCurrentThreadId();
+        auto mask = numThreads - 1;
+        auto start = (size_t) (((pointer_sized_uint) thread >> 4) * 0x9e3779b9u);
+
+        for (size_t i = 0; i < numThreads; ++i)
+        {
+            auto& t = threads[(start + i) & mask];
+            auto owner = t.owner.load (std::memory_order_acquire);
+
+            if (owner == thread)
+                return &t;
+
+            if (owner == nullptr && t.owner.compare_exchange_strong (owner, thread))
+                return &t;
+        }
+
+        return nullptr;
+    }
+
+    // Whoever stops recording waits for this, so a thread that saw the flag still set
+    // is guaranteed to have finished writing before the events are read or cleared.
+    template <typename FillEvent>
+    void add (FillEvent&& fill) noexcept
+    {
+        auto* t = getBufferForThisThread();
+
+        if (t == nullptr)
+        {
+            numDropped.fetch_add (1, std::memory_order_relaxed);
+            return;
+        }
+
+        t->inUse.store (true);
+
+        if (recording.load())
+        {
+            auto n = t->numWritten.load (std::memory_order_relaxed);
+            fill (t->events[n & (eventsPerThread - 1)]);
+            t->numWritten.store (n + 1, std::memory_order_release);
+        }
+
+        t->inUse.store (false, std::memory_order_release);
+    }
+
+    void waitUntilIdle() const
+    {
+        for (size_t i = 0; i < numThreads; ++i)
+            while (threads[i].inUse.load())
+                Thread::yield();
+    }
+
+    void clear() noexcept
+    {
+        for (size_t i = 0; i < numThreads; ++i)
+        {
+            threads[i].numWritten = 0;
+            threads[i].threadName = nullptr;
+        }
+
+        numDropped = 0;
+    }
+
+    bool matches (const Options& o) const noexcept
+    {
+        return eventsPerThread == (uint64) nextPowerOfTwo (jmax (16, o.getEventsPerThread()))
+            && numThreads == (size_t) nextPowerOfTwo (jmax (1, o.getMaxNumThreads()));
+    }
+
+    const uint64 eventsPerThread;
+    const size_t numThreads;
+    std::unique_ptr<ThreadBuffer[]> threads;
+    std::atomic<int64> numDropped { 0 };
+
+    //==============================================================================
+    // Buffers are never deleted while the app is running, because a thread might have
+    // loaded the pointer just before start() replaced it.
+    static std::atomic<Buffers*> current;
+
+    struct Storage
+    {
+        CriticalSection lock;
+        std::vector<std::unique_ptr<Buffers>> allBuffers;
+    };
+
+    static Storage& getStorage()
+    {
+        static Storage storage;
+        return storage;
+    }
+
+    template <typename FillEvent>
+    static void addToCurrent (FillEvent&& fill) noexcept
+    {
+        if (auto* b = current.load (std::memory_order_acquire))
+            b->add (std::forward<FillEvent> (fill));
+    }
+};
+
+std::atomic<bool> Tracing::recording { false };
+std::atomic<Tracing::Buffers*> Tracing::Buffers::current { nullptr };
+
+//==============================================================================
+void Tracing::start()
+{
+    start (Options{});
+}
+
+void Tracing::start (const Options& options)
+{
+    auto& storage = Buffers::getStorage();
+    const ScopedLock sl (storage.lock);
+
+    recording = false;
+
+    if (auto* b = Buffers::current.load())
+    {
+        b->waitUntilIdle();
+
+        if (b->matches (options))
+        {
+            b->clear();
+            recording = true;
+            return;
+        }
+    }
+
+    storage.allBuffers.push_back (std::make_unique<Buffers> (options));
+    Buffers::current = storage.allBuffers.back().get();
+    recording = true;
+}
+
+void Tracing::stop()
+{
+    const ScopedLock sl (Buffers::getStorage().lock);
+    recording = false;
+
+    if (auto* b = Buffers::current.load())
+        b->waitUntilIdle();
+}
+
+void Tracing::clear()
+{
+    const ScopedLock sl (Buffers::getStorage().lock);
+    auto wasRecording = recording.exchange (false);
+
+    if (auto* b = Buffers::current.load())
+    {
+        b->waitUntilIdle();
+        b->clear();
+    }
+
+    recording = wasRecording;
+}
+
+int64 Tracing::getNumDroppedEvents() noexcept
+{
+    if (auto* b = Buffers::current.load())
+        return b->numDropped.load();
+
+    return 0;
+}
+
+//==============================================================================
+void Tracing::addEvent (const char* category, const char* name, int64 startTicks, int64 endTicks) noexcept
+{
+    Buffers::addToCurrent ([=] (Buffers::Event& e)
+    {
+        e = { startTicks, endTicks, category, name, 0.0, Buffers::Type::complete };
+    });
+}
+
+void Tracing::addInstantEvent (const char* category, const char* name) noexcept
+{
+    auto time = Time::getHighResolutionTicks();
+
+    Buffers::addToCurrent ([=] (Buffers::Event& e)
+    {
+        e = { time, time, category, name, 0.0, Buffers::Type::instant };
+    });
+}
+
+void Tracing::addCounter (const char* name, double value) noexcept
+{
+    auto time = Time::getHighResolutionTicks();
+
+    Buffers::addToCurrent ([=] (Buffers::Event& e)
+    {
+        e = { time, time, "counter", name, value, Buffers::Type::counter };
+    });
+}
+
+void Tracing::setCurrentThreadName (const char* name) noexcept
+{
+    if (auto* b = Buffers::current.load (std::memory_order_acquire))
+        if (auto* t = b->getBufferForThisThread())
+            t->threadName.store (name, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void Tracing::writeChromeJson (OutputStream& out)
+{
+    const ScopedLock sl (Buffers::getStorage().lock);
+    auto wasRecording = recording.exchange (false);
+    auto* b = Buffers::current.load();
+
+    if (b != nullptr)
+        b->waitUntilIdle();
+
+    const ScopeGuard restoreRecording { [wasRecording] { recording = wasRecording; } };
+
+    auto firstTicks = std::numeric_limits<int64>::max();
+
+    for (size_t i = 0; b != nullptr && i < b->numThreads; ++i)
+    {
+        auto& t = b->threads[i];
+        auto n = t.numWritten.load();
+
+        for (auto j = n - jmin (n, b->eventsPerThread); j < n; ++j)
+            firstTicks = jmin (firstTicks, t.events[j & (b->eventsPerThread - 1)].startTicks);
+    }
+
+    auto toMicroseconds = [firstTicks] (int64 ticks)
+    {
+        return String (Time::highResolutionTicksToSeconds (ticks - firstTicks) * 1.0e6, 3);
+    };
+
+    auto quoted = [] (const char* text)
+    {
+        return "\"" + JSON::escapeString (text != nullptr ? text : "") + "\"";
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << newLine;
+    bool isFirst = true;
+
+    auto writeEvent = [&out, &isFirst] (const String& json)
+    {
+        if (! std::exchange (isFirst, false))
+            out << "," << newLine;
+
+        out << json;
+    };
+
+    for (size_t i = 0; b != nullptr && i < b->numThreads; ++i)
+    {
+        auto& t = b->threads[i];
+        auto n = t.numWritten.load();
+
+        if (n == 0)
+            continue;
+
+        auto tid = "\"pid\":1,\"tid\":" + String ((int) i + 1);
+        auto* threadName = t.threadName.load();
+
+        writeEvent ("{\"name\":\"thread_name\",\"ph\":\"M\"," + tid + ",\"args\":{\"name\":"
+                      + (threadName != nullptr ? quoted (threadName) : "\"Thread " + String ((int) i + 1) + "\"") + "}}");
+
+        for (auto j = n - jmin (n, b->eventsPerThread); j < n; ++j)
+        {
+            auto& e = t.events[j & (b->eventsPerThread - 1)];
+            String json;
+            json << "{\"name\":" << quoted (e.name) << ",\"cat\":" << quoted (e.category)
+                 << "," << tid << ",\"ts\":" << toMicroseconds (e.startTicks);
+
+            switch (e.type)
+            {
+                case Buffers::Type::complete:
+                    json << ",\"ph\":\"X\",\"dur\":" << String (Time::highResolutionTicksToSeconds (e.endTicks - e.startTicks) * 1.0e6, 3);
+                    break;
+
+                case Buffers::Type::instant:
+                    json << ",\"ph\":\"i\",\"s\":\"t\"";
+                    break;
+
+                case Buffers::Type::counter:
+                    json << ",\"ph\":\"C\",\"args\":{\"value\":" << String (e.value) << "}";
+                    break;
+            }
+
+            writeEvent (json + "}");
+        }
+    }
+
+    out << newLine << "]}" << newLine;
+    out.flush();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && JUCE_ENABLE_TRACING
+
+class TracingTests  : public UnitTest
+{
+public:
+    TracingTests()  : UnitTest ("Tracing", UnitTestCategories::threads) {}
+
+    void runTest() override
+    {
+        beginTest ("Events are only recorded while recording");
+        {
+            Tracing::start();
+            Tracing::stop();
+            Tracing::addInstantEvent ("test", "ignored");
+            expectEquals (getEvents().size(), 0);
+        }
+
+        beginTest ("Events from several threads are exported");
+        {
+            Tracing::start();
+
+            {
+                JUCE_TRACE_SCOPE ("test", "outer");
+                JUCE_TRACE_THREAD_NAME ("Test thread");
+                JUCE_TRACE_COUNTER ("level", 0.5);
+
+                std::thread other ([]
+                {
+                    JUCE_TRACE_SCOPE ("test", "other \"thread\"");
+                    JUCE_TRACE_INSTANT ("test", "instant");
+                });
+
+                other.join();
+            }
+
+            Tracing::stop();
+            auto events = getEvents();
+
+            auto outer = findEvent (events, "outer", "X");
+            expect (std::any_of (events.begin(), events.end(), [&] (const var& e)
+            {
+                return e["ph"] == var ("M") && e["tid"] == outer["tid"] && e["args"]["name"] == var ("Test thread");
+            }));
+
+            expect (outer.getProperty ("dur", {}).isDouble());
+            expect (findEvent (events, "level", "C").getProperty ("args", {})["value"] == var (0.5));
+
+            auto otherEvent = findEvent (events, "other \"thread\"", "X");
+            auto instant = findEvent (events, "instant", "i");
+            expect (otherEvent.isObject() && instant.isObject());
+            expect (otherEvent["tid"] == instant["tid"]);
+            expect (otherEvent["tid"] != outer["tid"]);
+        }
+
+        beginTest ("The most recent events are kept");
+        {
+            Tracing::start (Tracing::Options{}.withEventsPerThread (16));
+
+            for (int i = 0; i < 100; ++i)
+                Tracing::addCounter ("count", i);
+
+            auto events = getEvents();
+            expectEquals (events.size(), 17);
+            expect (events.getReference (1)["args"]["value"] == var (84.0));
+            expect (events.getReference (16)["args"]["value"] == var (99.0));
+            expect (Tracing::isRecording());
+
+            Tracing::clear();
+            expectEquals (getEvents().size(), 0);
+            Tracing::stop();
+        }
+    }
+
+    static Array<var> getEvents()
+    {
+        MemoryOutputStream out;
+        Tracing::writeChromeJson (out);
+        auto parsed = JSON::parse (out.toString());
+
+        if (auto* events = parsed["traceEvents"].getArray())
+            return *events;
+
+        return {};
+    }
+
+    static var findEvent (const Array<var>& events, const String& name, const String& phase)
+    {
+        for (auto& e : events)
+            if (e["name"] == var (name) && e["ph"] == var (phase))
+                return e;
+
+        return {};
+    }
+};
+
+static TracingTests tracingTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Records timed events from any thread, to be viewed on a timeline.
+
+    Each thread writes its events into a buffer of its own, without locking or
+    allocating, so events can be recorded on realtime threads. The buffers are
+    circular, so that when recording is left running they always hold the most
+    recent events - after a glitch, call writeChromeJson() and load the file into
+    ui.perfetto.dev or chrome://tracing to see what every thread was doing.
+
+    Events are normally added with the macros below, which do nothing but check a
+    flag while recording is stopped, and compile to nothing if JUCE_ENABLE_TRACING
+    is 0:
+    @code
+    void process()
+    {
+        JUCE_TRACE_SCOPE ("dsp", "process");
+        JUCE_TRACE_COUNTER ("voices", numActiveVoices);
+        ...
+    }
+    @endcode
+
+    The category, name and thread name strings aren't copied, so they must stay
+    valid until the trace has been written - normally they'll be string literals.
+
+    @tags{Core}
+*/
+class JUCE_API  Tracing
+{
+public:
+    //==============================================================================
+    /** Settings used by start(). */
+    class JUCE_API  Options
+    {
+    public:
+        /** The number of events to keep for each thread. The default is 16384. */
+        [[nodiscard]] Options withEventsPerThread (int numEvents) const         { return withMember (*this, &Options::eventsPerThread, numEvents); }
+
+        /** The most threads that can record events. Events from any others are dropped.
+            The default is 64.
+        */
+        [[nodiscard]] Options withMaxNumThreads (int numThreads) const          { return withMember (*this, &Options::maxNumThreads, numThreads); }
+
+        int getEventsPerThread() const noexcept     { return eventsPerThread; }
+        int getMaxNumThreads() const noexcept       { return maxNumThreads; }
+
+    private:
+        int eventsPerThread = 16384;
+        int maxNumThreads = 64;
+    };
+
+    //==============================================================================
+    /** Allocates the buffers and starts recording, using the default options. */
+    static void start();
+
+    /** Allocates the buffers and starts recording. Any previously recorded events
+        are discarded.
+    */
+    static void start (const Options&);
+
+    /** Stops recording. The recorded events are kept until start() or clear() is called. */
+    static void stop();
+
+    /** Returns true if events are being recorded. */
+    static bool isRecording() noexcept              { return recording.load (std::memory_order_relaxed); }
+
+    /** Discards any recorded events. */
+    static void clear();
+
+    /** Writes the recorded events in the Chrome trace event JSON format, which can be
+        opened by Perfetto, chrome://tracing and various other tools.
+
+        If recording is running, it's paused while the events are written.
+    */
+    static void writeChromeJson (OutputStream&);
+
+    //==============================================================================
+    /** Adds an event covering a range of high-resolution ticks on this thread.
+        @see Time::getHighResolutionTicks, ScopedEvent
+    */
+    static void addEvent (const char* category, const char* name, int64 startTicks, int64 endTicks) noexcept;
+
+    /** Adds a single point in time on this thread. */
+    static void addInstantEvent (const char* category, const char* name) noexcept;
+
+    /** Adds a sample of a value that will be drawn as a graph. */
+    static void addCounter (const char* name, double value) noexcept;
+
+    /** Sets the name that will be shown for this thread. This only has an effect while
+        recording, but it's cheap enough to call every time a thread starts some work.
+    */
+    static void setCurrentThreadName (const char* name) noexcept;
+
+    /** Returns the number of events that were dropped because too many threads were
+        recording at once.
+    */
+    static int64 getNumDroppedEvents() noexcept;
+
+    //==============================================================================
+    /** Records an event lasting from its construction to its destruction.
+        @see JUCE_TRACE_SCOPE
+    */
+    class JUCE_API  ScopedEvent
+    {
+    public:
+        ScopedEvent (const char* categoryName, const char* eventName) noexcept
+            : category (categoryName), name (eventName),
+              startTicks (isRecording() ? Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedEvent() noexcept
+        {
+            if (startTicks != 0 && isRecording())
+                addEvent (category, name, startTicks, Time::getHighResolutionTicks());
+        }
+
+    private:
+        const char* category;
+        const char* name;
+        int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedEvent)
+    };
+
+private:
+    struct Buffers;
+    static std::atomic<bool> recording;
+
+    Tracing() = delete;
+};
+
+//==============================================================================
+#if JUCE_ENABLE_TRACING || DOXYGEN
+ /** Records an event on the current thread that lasts until the end of the enclosing scope.
+     @see Tracing
+ */
+ #define JUCE_TRACE_SCOPE(category, name) \
+    const juce::Tracing::ScopedEvent JUCE_JOIN_MACRO (juceTraceScope, __LINE__) (category, name)
+
+ /** Records a point in time on the current thread.
+     @see Tracing
+ */
+ #define JUCE_TRACE_INSTANT(category, name) \
+    JUCE_BLOCK_WITH_FORCED_SEMICOLON (if (juce::Tracing::isRecording()) juce::Tracing::addInstantEvent (category, name);)
+
+ /** Records the value of a counter.
+     @see Tracing
+ */
+ #define JUCE_TRACE_COUNTER(name, value) \
+    JUCE_BLOCK_WITH_FORCED_SEMICOLON (if (juce::Tracing::isRecording()) juce::Tracing::addCounter (name, (double) (value));)
+
+ /** Sets the name shown for the current thread in a trace.
+     @see Tracing
+ */
+ #define JUCE_TRACE_THREAD_NAME(name) \
+    JUCE_BLOCK_WITH_FORCED_SEMICOLON (if (juce::Tracing::isRecording()) juce::Tracing::setCurrentThreadName (name);)
+#else
+ #define JUCE_TRACE_SCOPE(category, name)
+ #define JUCE_TRACE_INSTANT(category, name)
+ #define JUCE_TRACE_COUNTER(name, value)
+ #define JUCE_TRACE_THREAD_NAME(name)
+#endif
+
+} // namespace juce
@@ -0,0 +1,366 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+String BenchmarkResult::toString() const
+{
+    auto formatTime = [] (double ns)
+    {
+        if (ns >= 1.0e6)  return String (ns * 1.0e-6, 3) + " ms";
+        if (ns >= 1.0e3)  return String (ns * 1.0e-3, 3) + " us";
+        return String (ns, 2) + " ns";
+    };
+
+    String s;
+    s << getFullName() << ": median " << formatTime (medianNanoseconds)
+      << " +/- " << formatTime (medianAbsoluteDeviation)
+      << " (min " << formatTime (minNanoseconds) << ", p95 " << formatTime (percentile95Nanoseconds) << ")";
+
+    if (cyclesPerIteration >= 0)
+        s << ", " << String (cyclesPerIteration, 1) << " cycles";
+
+    if (allocationsPerIteration >= 0)
+        s << ", " << String (allocationsPerIteration, 2) << " allocations";
+
+    return s << ", " << numSamples << " x " << iterationsPerSample << " iterations";
+}
+
+var BenchmarkResult::toVar() const
+{
+    auto* o = new DynamicObject();
+    o->setProperty ("benchmark", benchmarkName);
+    o->setProperty ("case", caseName);
+    o->setProperty ("iterationsPerSample", iterationsPerSample);
+    o->setProperty ("numSamples", numSamples);
+    o->setProperty ("medianNs", medianNanoseconds);
+    o->setProperty ("madNs", medianAbsoluteDeviation);
+    o->setProperty ("minNs", minNanoseconds);
+    o->setProperty ("maxNs", maxNanoseconds);
+    o->setProperty ("meanNs", meanNanoseconds);
+    o->setProperty ("p5Ns", percentile5Nanoseconds);
+    o->setProperty ("p95Ns", percentile95Nanoseconds);
+    o->setProperty ("cycles", cyclesPerIteration);
+    o->setProperty ("allocations", allocationsPerIteration);
+    return o;
+}
+
+BenchmarkResult BenchmarkResult::fromVar (const var& v)
+{
+    BenchmarkResult r;
+    r.benchmarkName             = v["benchmark"].toString();
+    r.caseName                  = v["case"].toString();
+    r.iterationsPerSample       = (int64) v["iterationsPerSample"];
+    r.numSamples                = (int) v["numSamples"];
+    r.medianNanoseconds         = (double) v["medianNs"];
+    r.medianAbsoluteDeviation   = (double) v["madNs"];
+    r.minNanoseconds            = (double) v["minNs"];
+    r.maxNanoseconds            = (double) v["maxNs"];
+    r.meanNanoseconds           = (double) v["meanNs"];
+    r.percentile5Nanoseconds    = (double) v["p5Ns"];
+    r.percentile95Nanoseconds   = (double) v["p95Ns"];
+    r.cyclesPerIteration        = v.hasProperty ("cycles") ? (double) v["cycles"] : -1.0;
+    r.allocationsPerIteration   = v.hasProperty ("allocations") ? (double) v["allocations"] : -1.0;
+    return r;
+}
+
+//==============================================================================
+namespace BenchmarkHelpers
+{
+    static bool canReadCycleCounter() noexcept
+    {
+       #if JUCE_INTEL && (JUCE_MSVC || JUCE_GCC || JUCE_CLANG)
+        return true;
+       #else
+        return false;
+       #endif
+    }
+
+    static int64 readCycleCounter() noexcept
+    {
+       #if JUCE_INTEL && JUCE_MSVC
+        return (int64) __rdtsc();
+       #elif JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+        return (int64) __builtin_ia32_rdtsc();
+       #else
+        return 0;
+       #endif
+    }
+
+    // Linear interpolation between the closest ranks of a sorted array
+    static double getPercentile (const std::vector<double>& sorted, double percentile)
+    {
+        jassert (! sorted.empty());
+        auto position = percentile * 0.01 * (double) (sorted.size() - 1);
+        auto index = (size_t) position;
+        auto next = jmin (index + 1, sorted.size() - 1);
+        return jmap (position - (double) index, sorted[index], sorted[next]);
+    }
+
+    static const void* volatile sink = nullptr;
+}
+
+//==============================================================================
+Benchmark::Benchmark (const String& benchmarkName)
+    : Benchmark (benchmarkName, "Benchmarks")
+{
+}
+
+Benchmark::Benchmark (const String& benchmarkName, const String& benchmarkCategory)
+    : UnitTest (benchmarkName, benchmarkCategory)
+{
+}
+
+void Benchmark::escapePointer (const void* p) noexcept
+{
+    BenchmarkHelpers::sink = p;
+}
+
+BenchmarkResult Benchmark::measureIterations (const String& caseName, const std::function<void (int64)>& run)
+{
+    using namespace BenchmarkHelpers;
+
+    // This method's only valid while the test is being run!
+    jassert (runner != nullptr);
+
+    if (runner == nullptr || ! runner->areBenchmarksEnabled())
+    {
+        run (1);
+        expect (true);
+        return {};
+    }
+
+    auto elapsedMilliseconds = [] (double startTime) { return Time::getMillisecondCounterHiRes() - startTime; };
+
+    // Warm up, and double the number of iterations until a batch takes long enough to time accurately
+    int64 numIterations = 1;
+    double batchMilliseconds = 0;
+    auto warmUpStart = Time::getMillisecondCounterHiRes();
+
+    for (;;)
+    {
+        auto start = Time::getMillisecondCounterHiRes();
+        run (numIterations);
+        batchMilliseconds = elapsedMilliseconds (start);
+
+        if (batchMilliseconds >= options.getMinSampleMilliseconds())
+        {
+            if (elapsedMilliseconds (warmUpStart) >= options.getWarmUpMilliseconds())
+                break;
+        }
+        else
+        {
+            numIterations *= 2;
+        }
+    }
+
+    std::vector<double> times, cycles;
+
+   #if JUCE_ENABLE_ALLOCATION_HOOKS
+    auto totalAllocations = (int64) 0;
+   #endif
+
+    auto samplingStart = Time::getMillisecondCounterHiRes();
+
+    for (int i = 0; i < jmax (1, options.getNumSamples()); ++i)
+    {
+        if (i > 0 && elapsedMilliseconds (samplingStart) >= options.getMaxMilliseconds())
+            break;
+
+       #if JUCE_ENABLE_ALLOCATION_HOOKS
+        ScopedAllocationCounter allocations;
+       #endif
+
+        auto startCycles = readCycleCounter();
+        auto startTicks = Time::getHighResolutionTicks();
+        run (numIterations);
+        auto endTicks = Time::getHighResolutionTicks();
+        auto endCycles = readCycleCounter();
+
+       #if JUCE_ENABLE_ALLOCATION_HOOKS
+        totalAllocations += (int64) allocations.getNumCalls();
+       #endif
+
+        times.push_back (Time::highResolutionTicksToSeconds (endTicks - startTicks) * 1.0e9 / (double) numIterations);
+        cycles.push_back ((double) (endCycles - startCycles) / (double) numIterations);
+    }
+
+    std::sort (times.begin(), times.end());
+    std::sort (cycles.begin(), cycles.end());
+
+    BenchmarkResult r;
+    r.benchmarkName = getName();
+    r.caseName = caseName;
+    r.iterationsPerSample = numIterations;
+    r.numSamples = (int) times.size();
+    r.medianNanoseconds = getPercentile (times, 50.0);
+    r.minNanoseconds = times.front();
+    r.maxNanoseconds = times.back();
+    r.meanNanoseconds = std::accumulate (times.begin(), times.end(), 0.0) / (double) times.size();
+    r.percentile5Nanoseconds = getPercentile (times, 5.0);
+    r.percentile95Nanoseconds = getPercentile (times, 95.0);
+
+    std::vector<double> deviations;
+
+    for (auto t : times)
+        deviations.push_back (std::abs (t - r.medianNanoseconds));
+
+    std::sort (deviations.begin(), deviations.end());
+    r.medianAbsoluteDeviation = getPercentile (deviations, 50.0);
+
+    if (canReadCycleCounter())
+        r.cyclesPerIteration = getPercentile (cycles, 50.0);
+
+   #if JUCE_ENABLE_ALLOCATION_HOOKS
+    r.allocationsPerIteration = (double) totalAllocations / (double) (numIterations * (int64) times.size());
+   #endif
+
+    runner->benchmarkResults.push_back (r);
+    logMessage (r.toString());
+
+    if (auto* baseline = runner->benchmarkBaseline["results"].getArray())
+    {
+        for (auto& b : *baseline)
+        {
+            auto previous = BenchmarkResult::fromVar (b);
+
+            if (previous.getFullName() == r.getFullName() && previous.medianNanoseconds > 0)
+            {
+                auto limit = previous.medianNanoseconds * (1.0 + runner->allowedBenchmarkSlowdown);
+
+                expect (r.medianNanoseconds <= limit,
+                        "Slower than the baseline: median " + String (r.medianNanoseconds, 2)
+                          + " ns, baseline " + String (previous.medianNanoseconds, 2) + " ns");
+                return r;
+            }
+        }
+    }
+
+    expect (true);
+    return r;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SummingBenchmark  : public Benchmark
+{
+public:
+    SummingBenchmark()  : Benchmark ("Summing")
+    {
+        setOptions (Options{}.withWarmUpMilliseconds (1.0)
+                             .withMinSampleMilliseconds (0.5)
+                             .withNumSamples (5));
+    }
+
+    void runTest() override
+    {
+        beginTest ("Sum");
+
+        measure ("sum 1000 ints", []
+        {
+            int64 total = 0;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                total += i;
+                doNotOptimise (total);
+            }
+        });
+    }
+};
+
+static SummingBenchmark summingBenchmark;
+
+class BenchmarkTests  : public UnitTest
+{
+public:
+    BenchmarkTests()  : UnitTest ("Benchmark", UnitTestCategories::benchmarks) {}
+
+    void runTest() override
+    {
+        beginTest ("Nothing is measured unless benchmarks are enabled");
+        {
+            UnitTestRunner testRunner;
+            testRunner.runTests (Array<UnitTest*> { &summingBenchmark });
+
+            expect (testRunner.getBenchmarkResults().empty());
+            expectEquals (testRunner.getResult (0)->passes, 1);
+        }
+
+        beginTest ("Results are measured and can be saved");
+        {
+            UnitTestRunner testRunner;
+            testRunner.setBenchmarksEnabled (true);
+            testRunner.runTests (Array<UnitTest*> { &summingBenchmark });
+
+            expectEquals ((int) testRunner.getBenchmarkResults().size(), 1);
+            auto result = testRunner.getBenchmarkResults().front();
+
+            expectEquals (result.getFullName(), String ("Summing / sum 1000 ints"));
+            expectEquals (result.numSamples, 5);
+            expect (result.minNanoseconds > 0.0);
+            expect (result.minNanoseconds <= result.percentile5Nanoseconds);
+            expect (result.percentile5Nanoseconds <= result.medianNanoseconds);
+            expect (result.medianNanoseconds <= result.percentile95Nanoseconds);
+            expect (result.percentile95Nanoseconds <= result.maxNanoseconds);
+            expect (result.iterationsPerSample > 0);
+
+            auto json = JSON::parse (JSON::toString (testRunner.getBenchmarkResultsAsJson()));
+            auto restored = BenchmarkResult::fromVar (json["results"][0]);
+
+            expectEquals (restored.getFullName(), result.getFullName());
+            expectEquals (restored.medianNanoseconds, result.medianNanoseconds);
+            expectEquals (restored.iterationsPerSample, result.iterationsPerSample);
+        }
+
+        beginTest ("Results that are slower than the baseline fail");
+        {
+            auto runWithBaseline = [] (double baselineScale)
+            {
+                UnitTestRunner testRunner;
+                testRunner.setBenchmarksEnabled (true);
+                testRunner.runTests (Array<UnitTest*> { &summingBenchmark });
+
+                auto baseline = testRunner.getBenchmarkResultsAsJson();
+                auto* first = baseline["results"][0].getDynamicObject();
+                first->setProperty ("medianNs", (double) first->getProperty ("medianNs") * baselineScale);
+
+                testRunner.setAssertOnFailure (false);
+                testRunner.setBenchmarkBaseline (baseline, 0.5);
+                testRunner.runTests (Array<UnitTest*> { &summingBenchmark });
+                return testRunner.getResult (0)->failures;
+            };
+
+            expectEquals (runWithBaseline (100.0), 0);
+            expectEquals (runWithBaseline (0.01), 1);
+        }
+    }
+};
+
+static BenchmarkTests benchmarkTests;
+
+#endif
+
+} // namespace juce
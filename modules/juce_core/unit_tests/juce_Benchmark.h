@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    The measurements taken by Benchmark::measure().
+
+    Times are in nanoseconds per iteration of the code being measured.
+
+    @see Benchmark
+
+    @tags{Core}
+*/
+struct JUCE_API  BenchmarkResult
+{
+    /** The name of the Benchmark object that took the measurement. */
+    String benchmarkName;
+    /** The name that was passed to Benchmark::measure(). */
+    String caseName;
+
+    /** The number of times the code was run for each sample. */
+    int64 iterationsPerSample = 0;
+    /** The number of samples that were timed. */
+    int numSamples = 0;
+
+    double medianNanoseconds = 0, medianAbsoluteDeviation = 0,
+           minNanoseconds = 0, maxNanoseconds = 0, meanNanoseconds = 0,
+           percentile5Nanoseconds = 0, percentile95Nanoseconds = 0;
+
+    /** The median number of CPU timestamp-counter ticks per iteration, or -1 if the
+        counter isn't available on this platform.
+    */
+    double cyclesPerIteration = -1;
+
+    /** The number of calls to new and delete per iteration, or -1 if they weren't
+        counted because JUCE_ENABLE_ALLOCATION_HOOKS is disabled.
+    */
+    double allocationsPerIteration = -1;
+
+    /** Returns "benchmarkName / caseName", which is used to match results against a baseline. */
+    String getFullName() const                      { return benchmarkName + " / " + caseName; }
+
+    /** Returns a description of the result that fits on one line. */
+    String toString() const;
+
+    /** Converts the result to a JSON object. */
+    var toVar() const;
+
+    /** Creates a result from an object created by toVar(). */
+    static BenchmarkResult fromVar (const var&);
+};
+
+//==============================================================================
+/**
+    A UnitTest that measures how long some code takes to run.
+
+    Write a benchmark in the same way as a normal UnitTest, but call measure() with
+    the code to be timed:
+
+    @code
+    class MyBenchmark  : public Benchmark
+    {
+    public:
+        MyBenchmark()  : Benchmark ("My benchmark") {}
+
+        void runTest() override
+        {
+            beginTest ("Sorting");
+
+            std::vector<int> data (10000);
+
+            measure ("sort 10000 ints", [&]
+            {
+                std::iota (data.rbegin(), data.rend(), 0);
+                std::sort (data.begin(), data.end());
+                doNotOptimise (data.data());
+            });
+        }
+    };
+
+    static MyBenchmark myBenchmark;
+    @endcode
+
+    Benchmarks are found and run by a UnitTestRunner along with all the other tests.
+    Unless UnitTestRunner::setBenchmarksEnabled() has been called, measure() just runs
+    the code once, so that a normal test run stays quick but still checks that each
+    benchmark works. When benchmarks are enabled, measure() runs the code for a
+    warm-up period, works out how many iterations are needed for each sample to be long
+    enough to time accurately, then times a series of samples and records a
+    BenchmarkResult with the runner. If the runner has a baseline, a result that's
+    slower than its baseline by more than the allowed amount counts as a failed test.
+
+    @see UnitTestRunner::setBenchmarksEnabled, BenchmarkResult
+
+    @tags{Core}
+*/
+class JUCE_API  Benchmark  : public UnitTest
+{
+public:
+    //==============================================================================
+    /** Controls how long a benchmark spends on each measurement. */
+    class JUCE_API  Options
+    {
+    public:
+        /** How long to run the code before starting to take samples. The default is 50ms. */
+        [[nodiscard]] Options withWarmUpMilliseconds (double ms) const          { return withMember (*this, &Options::warmUpMilliseconds, ms); }
+
+        /** The shortest time that each sample should take. The number of iterations per
+            sample is chosen to make each one at least this long. The default is 2ms.
+        */
+        [[nodiscard]] Options withMinSampleMilliseconds (double ms) const       { return withMember (*this, &Options::minSampleMilliseconds, ms); }
+
+        /** The number of samples to take. The default is 30. */
+        [[nodiscard]] Options withNumSamples (int num) const                    { return withMember (*this, &Options::numSamples, num); }
+
+        /** An upper limit on the total time spent taking samples. If it's reached, fewer
+            samples are taken. The default is 2 seconds.
+        */
+        [[nodiscard]] Options withMaxMilliseconds (double ms) const             { return withMember (*this, &Options::maxMilliseconds, ms); }
+
+        double getWarmUpMilliseconds() const noexcept       { return warmUpMilliseconds; }
+        double getMinSampleMilliseconds() const noexcept    { return minSampleMilliseconds; }
+        int getNumSamples() const noexcept                  { return numSamples; }
+        double getMaxMilliseconds() const noexcept          { return maxMilliseconds; }
+
+    private:
+        double warmUpMilliseconds = 50.0;
+        double minSampleMilliseconds = 2.0;
+        int numSamples = 30;
+        double maxMilliseconds = 2000.0;
+    };
+
+    //==============================================================================
+    /** Creates a benchmark with the given name, in the "Benchmarks" category. */
+    explicit Benchmark (const String& name);
+
+    /** Creates a benchmark with the given name and category. */
+    Benchmark (const String& name, const String& category);
+
+    /** Changes the options used by subsequent calls to measure(). */
+    void setOptions (const Options& newOptions)             { options = newOptions; }
+
+    /** Returns the options used by measure(). */
+    const Options& getOptions() const noexcept              { return options; }
+
+protected:
+    //==============================================================================
+    /** Times a function, and records the result with the runner.
+
+        This must be called after beginTest(). The function is called many times, so it
+        should do the same amount of work on each call. Use doNotOptimise() on any result
+        that isn't otherwise used, so that the compiler can't remove the code.
+
+        Returns the result, or an empty result if benchmarks aren't enabled.
+    */
+    template <typename FunctionToMeasure>
+    BenchmarkResult measure (const String& caseName, FunctionToMeasure&& function)
+    {
+        return measureIterations (caseName, [&function] (int64 numIterations)
+        {
+            for (int64 i = 0; i < numIterations; ++i)
+                function();
+        });
+    }
+
+    /** Stops the compiler from optimising away the calculation of a value. */
+    template <typename Type>
+    static void doNotOptimise (const Type& value) noexcept
+    {
+       #if JUCE_GCC || JUCE_CLANG
+        asm volatile ("" : : "r,m" (value) : "memory");
+       #else
+        escapePointer (&value);
+       #endif
+    }
+
+private:
+    //==============================================================================
+    Options options;
+
+    BenchmarkResult measureIterations (const String&, const std::function<void (int64)>&);
+    static void escapePointer (const void*) noexcept;
+};
+
+} // namespace juce
@@ -127,6 +127,43 @@ void UnitTestRunner::setPassesAreLogged (bool shouldDisplayPasses) noexcept
     logPasses = shouldDisplayPasses;
 }
 
+void UnitTestRunner::setBenchmarksEnabled (bool shouldMeasure) noexcept
+{
+    benchmarksEnabled = shouldMeasure;
+}
+
+void UnitTestRunner::setBenchmarkBaseline (const var& baselineResults, double allowedSlowdown)
+{
+    benchmarkBaseline = baselineResults;
+    allowedBenchmarkSlowdown = allowedSlowdown;
+}
+
+const std::vector<BenchmarkResult>& UnitTestRunner::getBenchmarkResults() const noexcept
+{
+    return benchmarkResults;
+}
+
+var UnitTestRunner::getBenchmarkResultsAsJson() const
+{
+    Array<var> list;
+
+    for (auto& r : benchmarkResults)
+        list.add (r.toVar());
+
+    auto* system = new DynamicObject();
+    system->setProperty ("os", SystemStats::getOperatingSystemName());
+    system->setProperty ("cpu", SystemStats::getCpuModel());
+    system->setProperty ("numCpus", SystemStats::getNumCpus());
+    system->setProperty ("cpuSpeedMHz", SystemStats::getCpuSpeedInMegahertz());
+    system->setProperty ("juceVersion", SystemStats::getJUCEVersion());
+
+    auto* result = new DynamicObject();
+    result->setProperty ("time", Time::getCurrentTime().toISO8601 (true));
+    result->setProperty ("system", system);
+    result->setProperty ("results", list);
+    return result;
+}
+
 int UnitTestRunner::getNumResults() const noexcept
 {
     return results.size();
@@ -144,6 +181,7 @@ void UnitTestRunner::resultsUpdated()
 void UnitTestRunner::runTests (const Array<UnitTest*>& tests, int64 randomSeed)
 {
     results.clear();
+    benchmarkResults.clear();
     resultsUpdated();
 
     if (randomSeed == 0)
@@ -24,6 +24,7 @@ namespace juce
 {
 
 class UnitTestRunner;
+struct BenchmarkResult;
 
 
 //==============================================================================
@@ -300,6 +301,8 @@ private:
     }
 
     //==============================================================================
+    friend class Benchmark;
+
     const String name, category;
     UnitTestRunner* runner = nullptr;
 
@@ -367,6 +370,30 @@ public:
     */
     void setPassesAreLogged (bool shouldDisplayPasses) noexcept;
 
+    //==============================================================================
+    /** Sets whether Benchmark tests should take measurements.
+        By default, this is false, and each benchmark just runs the code it measures once.
+        @see Benchmark
+    */
+    void setBenchmarksEnabled (bool shouldMeasure) noexcept;
+
+    /** Returns true if Benchmark tests will take measurements. */
+    bool areBenchmarksEnabled() const noexcept                  { return benchmarksEnabled; }
+
+    /** Sets some earlier results to compare the benchmarks against, in the format returned
+        by getBenchmarkResultsAsJson(). A benchmark whose median time is more than
+        allowedSlowdown slower than its baseline (e.g. 0.1 for 10% slower) fails.
+    */
+    void setBenchmarkBaseline (const var& baselineResults, double allowedSlowdown);
+
+    /** Returns the benchmark results measured by the last call to runTests(). */
+    const std::vector<BenchmarkResult>& getBenchmarkResults() const noexcept;
+
+    /** Returns the benchmark results measured by the last call to runTests(), with some
+        details about the system they were measured on, as a JSON object.
+    */
+    var getBenchmarkResultsAsJson() const;
+
     //==============================================================================
     /** Contains the results of a test.
 
@@ -433,12 +460,16 @@ protected:
 private:
     //==============================================================================
     friend class UnitTest;
+    friend class Benchmark;
 
     UnitTest* currentTest = nullptr;
     String currentSubCategory;
     OwnedArray<TestResult, CriticalSection> results;
-    bool assertOnFailure = true, logPasses = false;
+    bool assertOnFailure = true, logPasses = false, benchmarksEnabled = false;
     Random randomForTest;
+    std::vector<BenchmarkResult> benchmarkResults;
+    var benchmarkBaseline;
+    double allowedBenchmarkSlowdown = 0.1;
 
     void beginNewTest (UnitTest* test, const String& subCategory);
     void endTest();
@@ -0,0 +1,974 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+XmlReader::XmlReader (InputStream& source, size_t bufferSizeToUse)
+    : stream (&source),
+      buffer (jmax ((size_t) 16, bufferSizeToUse)),
+      bufferSize (jmax ((size_t) 16, bufferSizeToUse))
+{
+    bufferStart = position = bufferEnd = buffer.get();
+}
+
+XmlReader::XmlReader (const void* data, size_t numBytes)
+{
+    bufferStart = position = static_cast<const char*> (data);
+    bufferEnd = position + numBytes;
+}
+
+XmlReader::~XmlReader() = default;
+
+//==============================================================================
+bool XmlReader::refill()
+{
+    if (stream == nullptr)
+        return false;
+
+    bytesBeforeBuffer += bufferEnd - bufferStart;
+    auto numRead = stream->read (buffer.get(), bufferSize);
+
+    bufferStart = position = buffer.get();
+    bufferEnd = bufferStart + jmax ((ssize_t) 0, numRead);
+    return numRead > 0;
+}
+
+int XmlReader::peekByte()
+{
+    if (position == bufferEnd && ! refill())
+        return -1;
+
+    return (uint8) *position;
+}
+
+void XmlReader::startNewLine()
+{
+    ++line;
+    startOfLine = getLocation().offset;
+}
+
+void XmlReader::skipWhitespace()
+{
+    for (;;)
+    {
+        if (position == bufferEnd && ! refill())
+            return;
+
+        auto c = *position;
+
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+            return;
+
+        ++position;
+
+        if (c == '\n')
+            startNewLine();
+    }
+}
+
+bool XmlReader::matchLiteral (const char* text)
+{
+    for (; *text != 0; ++text)
+    {
+        if (peekByte() != (uint8) *text)
+            return false;
+
+        ++position;
+    }
+
+    return true;
+}
+
+bool XmlReader::skipPast (char repeatedChar, int numRepeats, MemoryOutputStream* dest)
+{
+    // The terminators that we look for are all a run of one character followed by a '>',
+    // e.g. "-->", so by counting the length of the current run we never need to look back
+    // into a part of the input that may already have been dropped from the buffer.
+    int runLength = 0;
+
+    for (;;)
+    {
+        auto c = peekByte();
+
+        if (c < 0)
+            return false;
+
+        ++position;
+
+        if (c == (uint8) repeatedChar)
+        {
+            ++runLength;
+            continue;
+        }
+
+        if (c == '>' && runLength >= numRepeats)
+        {
+            if (dest != nullptr)
+                for (int i = numRepeats; i < runLength; ++i)
+                    dest->writeByte (repeatedChar);
+
+            return true;
+        }
+
+        if (dest != nullptr)
+        {
+            for (int i = 0; i < runLength; ++i)
+                dest->writeByte (repeatedChar);
+
+            dest->writeByte ((char) c);
+        }
+
+        runLength = 0;
+
+        if (c == '\n')
+            startNewLine();
+    }
+}
+
+bool XmlReader::checkUTF8 (const MemoryOutputStream& data, size_t startOffset, Location location)
+{
+    auto* text = static_cast<const char*> (data.getData()) + startOffset;
+    auto numBytes = data.getDataSize() - startOffset;
+
+    if (JSONScanning::isAscii (text, numBytes) || CharPointer_UTF8::isValidString (text, (int) numBytes))
+        return true;
+
+    setError ("invalid UTF-8", location);
+    return false;
+}
+
+XmlReader::Token XmlReader::setError (const String& message, Location location)
+{
+    errorMessage = String (location.line) + ":" + String (location.offset - location.startOfLine + 1)
+                     + ": error: " + message;
+    return token = Token::error;
+}
+
+Result XmlReader::getResult() const
+{
+    return errorMessage.isEmpty() ? Result::ok() : Result::fail (errorMessage);
+}
+
+//==============================================================================
+XmlReader::Token XmlReader::next()
+{
+    if (token == Token::error)
+        return token;
+
+    if (token == Token::none)
+        return readProlog();
+
+    if (std::exchange (pendingEndElement, false))
+        return closeElement();
+
+    if (openElementOffsets.empty())
+        return token = Token::endOfInput;
+
+    return readContent();
+}
+
+XmlReader::Token XmlReader::readProlog()
+{
+    if (peekByte() == 0xef && ! matchLiteral ("\xef\xbb\xbf"))
+        return setError ("syntax error");
+
+    for (;;)
+    {
+        skipWhitespace();
+        auto location = getLocation();
+        auto c = peekByte();
+
+        if (c < 0)
+            return setError ("not enough input");
+
+        if (c != '<')
+            return setError ("expected the document element");
+
+        ++position;
+
+        switch (readMarkupType (location))
+        {
+            case Markup::startTag:
+                return readStartTag();
+
+            case Markup::endTag:
+            case Markup::cdata:
+                return setError ("expected the document element", location);
+
+            case Markup::none:
+                if (token == Token::error)
+                    return token;
+
+                break;
+        }
+    }
+}
+
+XmlReader::Markup XmlReader::readMarkupType (Location location)
+{
+    auto c = peekByte();
+
+    if (c == '/')
+    {
+        ++position;
+        return Markup::endTag;
+    }
+
+    if (c == '?')
+    {
+        ++position;
+
+        if (! skipPast ('?', 1, nullptr))
+            setError ("unterminated processing instruction", location);
+
+        return Markup::none;
+    }
+
+    if (c != '!')
+        return Markup::startTag;
+
+    ++position;
+
+    if (matchLiteral ("--"))
+    {
+        if (! skipPast ('-', 2, nullptr))
+            setError ("unterminated comment", location);
+
+        return Markup::none;
+    }
+
+    if (matchLiteral ("[CDATA["))
+        return Markup::cdata;
+
+    if (matchLiteral ("DOCTYPE"))
+    {
+        for (int depth = 1; depth > 0;)
+        {
+            auto b = peekByte();
+
+            if (b < 0)
+            {
+                setError ("malformed DTD", location);
+                break;
+            }
+
+            ++position;
+
+            if (b == '<')       ++depth;
+            else if (b == '>')  --depth;
+            else if (b == '\n') startNewLine();
+        }
+
+        return Markup::none;
+    }
+
+    setError ("syntax error", location);
+    return Markup::none;
+}
+
+XmlReader::Token XmlReader::readContent()
+{
+    if (pendingMarkup == Markup::none)
+    {
+        auto textLocation = getLocation();
+        auto isSignificant = ! ignoreEmptyText;
+        textData.reset();
+
+        for (;;)
+        {
+            if (position == bufferEnd && ! refill())
+                return setError ("unmatched tags");
+
+            // copy runs of ordinary characters straight out of the buffer
+            auto* runStart = position;
+
+            while (position != bufferEnd)
+            {
+                auto c = *position;
+
+                if (c == '<' || c == '&' || c == '\r')
+                    break;
+
+                isSignificant = isSignificant || (c != ' ' && c != '\t' && c != '\n');
+                ++position;
+
+                if (c == '\n')
+                    startNewLine();
+            }
+
+            textData.write (runStart, (size_t) (position - runStart));
+
+            if (position == bufferEnd)
+                continue;
+
+            auto c = *position;
+
+            if (c == '\r')
+            {
+                ++position;
+
+                if (peekByte() == '\n')
+                {
+                    ++position;
+                    startNewLine();
+                }
+
+                textData.writeByte ('\n');
+                continue;
+            }
+
+            if (c == '&')
+            {
+                if (! readEntity (textData))
+                    return token;
+
+                isSignificant = true;
+                continue;
+            }
+
+            auto markupLocation = getLocation();
+            ++position;
+            pendingMarkup = readMarkupType (markupLocation);
+
+            if (token == Token::error)
+                return token;
+
+            // comments and processing instructions don't interrupt the text
+            if (pendingMarkup != Markup::none)
+                break;
+        }
+
+        if (isSignificant && textData.getDataSize() > 0)
+        {
+            textData.writeByte (0);
+            return checkUTF8 (textData, 0, textLocation) ? token = Token::text : token;
+        }
+    }
+
+    switch (std::exchange (pendingMarkup, Markup::none))
+    {
+        case Markup::startTag:  return readStartTag();
+        case Markup::endTag:    return readEndTag();
+        case Markup::cdata:     return readCData();
+        case Markup::none:      break;
+    }
+
+    jassertfalse;
+    return setError ("syntax error");
+}
+
+static bool isXmlNameByte (uint8 c, bool isFirstByte) noexcept
+{
+    if (c >= 0x80)
+        return true;
+
+    // these are allowed in a name, but not at the start of one
+    if (isFirstByte && (CharacterFunctions::isDigit ((char) c) || c == '-' || c == '.'))
+        return false;
+
+    return XmlIdentifierChars::isIdentifierChar ((juce_wchar) c);
+}
+
+bool XmlReader::readName (MemoryOutputStream& dest)
+{
+    auto start = dest.getDataSize();
+
+    while (position != bufferEnd || refill())
+    {
+        auto* runStart = position;
+
+        while (position != bufferEnd && isXmlNameByte ((uint8) *position, dest.getDataSize() == start && position == runStart))
+            ++position;
+
+        dest.write (runStart, (size_t) (position - runStart));
+
+        if (position != bufferEnd)
+            break;
+    }
+
+    if (dest.getDataSize() == start)
+        return false;
+
+    dest.writeByte (0);
+    return true;
+}
+
+bool XmlReader::readEntity (MemoryOutputStream& dest)
+{
+    auto location = getLocation();
+    ++position;
+
+    char name[16];
+    size_t length = 0;
+
+    while (length < sizeof (name) - 1)
+    {
+        auto c = peekByte();
+
+        if (! (c == '#' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')))
+            break;
+
+        name[length++] = (char) c;
+        ++position;
+    }
+
+    name[length] = 0;
+
+    if (peekByte() != ';')
+    {
+        // this isn't an entity reference, so the ampersand is just an ordinary character
+        dest.writeByte ('&');
+        dest.write (name, length);
+        return true;
+    }
+
+    ++position;
+
+    if (name[0] == '#')
+    {
+        const auto isHex = (name[1] == 'x' || name[1] == 'X');
+        auto* digits = name + (isHex ? 2 : 1);
+        uint32 charCode = 0;
+
+        for (auto* d = digits; *d != 0 && charCode <= 0x10ffff; ++d)
+        {
+            auto digitValue = isHex ? CharacterFunctions::getHexDigitValue ((juce_wchar) *d)
+                                    : (CharacterFunctions::isDigit (*d) ? *d - '0' : -1);
+
+            if (digitValue < 0)
+            {
+                charCode = 0;
+                break;
+            }
+
+            charCode = charCode * (isHex ? 16 : 10) + (uint32) digitValue;
+        }
+
+        if (charCode == 0 || charCode > 0x10ffff || (charCode >= 0xd800 && charCode < 0xe000))
+        {
+            setError ("illegal escape sequence", location);
+            return false;
+        }
+
+        dest.appendUTF8Char ((juce_wchar) charCode);
+        return true;
+    }
+
+    struct NamedEntity
+    {
+        const char* name;
+        char character;
+    };
+
+    static constexpr NamedEntity namedEntities[] { { "amp", '&' }, { "quot", '"' }, { "apos", '\'' }, { "lt", '<' }, { "gt", '>' } };
+
+    for (auto& entity : namedEntities)
+    {
+        if (CharacterFunctions::compareIgnoreCase (CharPointer_ASCII (name), CharPointer_ASCII (entity.name)) == 0)
+        {
+            dest.writeByte (entity.character);
+            return true;
+        }
+    }
+
+    // entities that are declared in a DTD aren't expanded, so leave the reference as it was
+    dest.writeByte ('&');
+    dest.write (name, length);
+    dest.writeByte (';');
+    return true;
+}
+
+bool XmlReader::readAttributeValue (char quote)
+{
+    for (;;)
+    {
+        if (position == bufferEnd && ! refill())
+        {
+            setError ("unmatched quotes");
+            return false;
+        }
+
+        auto* runStart = position;
+
+        while (position != bufferEnd && *position != quote && *position != '&')
+            if (*position++ == '\n')
+                startNewLine();
+
+        attributeData.write (runStart, (size_t) (position - runStart));
+
+        if (position == bufferEnd)
+            continue;
+
+        if (*position == quote)
+        {
+            ++position;
+            attributeData.writeByte (0);
+            return true;
+        }
+
+        if (! readEntity (attributeData))
+            return false;
+    }
+}
+
+XmlReader::Token XmlReader::readStartTag()
+{
+    auto location = getLocation();
+    nameData.reset();
+    attributeData.reset();
+    attributes.clear();
+
+    if (! readName (nameData))
+        return setError ("tag name missing", location);
+
+    if (! checkUTF8 (nameData, 0, location))
+        return token;
+
+    for (;;)
+    {
+        skipWhitespace();
+        auto c = peekByte();
+
+        if (c == '>')
+        {
+            ++position;
+            break;
+        }
+
+        if (c == '/')
+        {
+            ++position;
+
+            if (peekByte() != '>')
+                return setError ("expected '>'");
+
+            ++position;
+            pendingEndElement = true;
+            break;
+        }
+
+        if (c < 0)
+            return setError ("unmatched tags");
+
+        auto attributeLocation = getLocation();
+        AttributeOffsets offsets { attributeData.getDataSize(), 0 };
+
+        if (! readName (attributeData))
+            return setError ("illegal character found in " + String (CharPointer_UTF8 (static_cast<const char*> (nameData.getData())))
+                               + ": '" + String::charToString ((juce_wchar) c) + "'");
+
+        if (! checkUTF8 (attributeData, offsets.name, attributeLocation))
+            return token;
+
+        skipWhitespace();
+
+        if (peekByte() != '=')
+            return setError ("expected '=' after attribute '" + String (CharPointer_UTF8 (getAttributeData (offsets.name))) + "'");
+
+        ++position;
+        skipWhitespace();
+        auto quote = peekByte();
+
+        if (quote != '"' && quote != '\'')
+            return setError ("expected a quoted value for attribute '" + String (CharPointer_UTF8 (getAttributeData (offsets.name))) + "'");
+
+        ++position;
+        offsets.value = attributeData.getDataSize();
+        auto valueLocation = getLocation();
+
+        if (! (readAttributeValue ((char) quote) && checkUTF8 (attributeData, offsets.value, valueLocation)))
+            return token;
+
+        attributes.push_back (offsets);
+    }
+
+    openElementOffsets.push_back (openElementNames.size());
+    openElementNames.append (static_cast<const char*> (nameData.getData()), nameData.getDataSize() - 1);
+    return token = Token::startElement;
+}
+
+XmlReader::Token XmlReader::readEndTag()
+{
+    auto location = getLocation();
+    nameData.reset();
+
+    if (! readName (nameData))
+        return setError ("tag name missing", location);
+
+    skipWhitespace();
+
+    if (peekByte() != '>')
+        return setError ("expected '>'");
+
+    ++position;
+
+    auto* openName = openElementNames.c_str() + openElementOffsets.back();
+
+    if (strcmp (openName, static_cast<const char*> (nameData.getData())) != 0)
+        return setError ("mismatched end tag: expected </" + String (CharPointer_UTF8 (openName)) + ">", location);
+
+    return closeElement();
+}
+
+XmlReader::Token XmlReader::readCData()
+{
+    auto location = getLocation();
+    textData.reset();
+
+    if (! skipPast (']', 2, &textData))
+        return setError ("unterminated CDATA section", location);
+
+    textData.writeByte (0);
+    return checkUTF8 (textData, 0, location) ? token = Token::text : token;
+}
+
+XmlReader::Token XmlReader::closeElement()
+{
+    openElementNames.resize (openElementOffsets.back());
+    openElementOffsets.pop_back();
+    return token = Token::endElement;
+}
+
+//==============================================================================
+StringRef XmlReader::getName() const noexcept
+{
+    if (token != Token::startElement && token != Token::endElement)
+        return {};
+
+    return CharPointer_UTF8 (static_cast<const char*> (nameData.getData()));
+}
+
+StringRef XmlReader::getText() const noexcept
+{
+    if (token != Token::text)
+        return {};
+
+    return CharPointer_UTF8 (static_cast<const char*> (textData.getData()));
+}
+
+const char* XmlReader::getAttributeData (size_t offset) const noexcept
+{
+    return static_cast<const char*> (attributeData.getData()) + offset;
+}
+
+int XmlReader::getNumAttributes() const noexcept
+{
+    return token == Token::startElement ? (int) attributes.size() : 0;
+}
+
+StringRef XmlReader::getAttributeName (int attributeIndex) const noexcept
+{
+    if (! isPositiveAndBelow (attributeIndex, getNumAttributes()))
+        return {};
+
+    return CharPointer_UTF8 (getAttributeData (attributes[(size_t) attributeIndex].name));
+}
+
+StringRef XmlReader::getAttributeValue (int attributeIndex) const noexcept
+{
+    if (! isPositiveAndBelow (attributeIndex, getNumAttributes()))
+        return {};
+
+    return CharPointer_UTF8 (getAttributeData (attributes[(size_t) attributeIndex].value));
+}
+
+StringRef XmlReader::getAttribute (StringRef attributeName) const noexcept
+{
+    for (int i = 0; i < getNumAttributes(); ++i)
+        if (getAttributeName (i) == attributeName)
+            return getAttributeValue (i);
+
+    return {};
+}
+
+bool XmlReader::hasAttribute (StringRef attributeName) const noexcept
+{
+    for (int i = 0; i < getNumAttributes(); ++i)
+        if (getAttributeName (i) == attributeName)
+            return true;
+
+    return false;
+}
+
+bool XmlReader::skipElement()
+{
+    if (token == Token::startElement)
+        for (auto depth = getDepth(); getDepth() >= depth;)
+            if (next() == Token::error)
+                return false;
+
+    return token != Token::error;
+}
+
+std::unique_ptr<XmlElement> XmlReader::readElement()
+{
+    if (token != Token::startElement)
+        return {};
+
+    auto* name = static_cast<const char*> (nameData.getData());
+    auto element = std::make_unique<XmlElement> (CharPointer_UTF8 (name), CharPointer_UTF8 (name + nameData.getDataSize() - 1));
+
+    {
+        LinkedListPointer<XmlElement::XmlAttributeNode>::Appender attributeAppender (element->attributes);
+
+        for (auto& offsets : attributes)
+        {
+            auto* attributeName = getAttributeData (offsets.name);
+            auto* value = getAttributeData (offsets.value);
+            auto* attribute = new XmlElement::XmlAttributeNode (CharPointer_UTF8 (attributeName), CharPointer_UTF8 (value - 1));
+            attribute->value = String (CharPointer_UTF8 (value));
+            attributeAppender.append (attribute);
+        }
+    }
+
+    LinkedListPointer<XmlElement>::Appender childAppender (element->firstChildElement);
+
+    while (next() != Token::endElement)
+    {
+        if (token == Token::startElement)
+        {
+            auto child = readElement();
+
+            if (child == nullptr)
+                return {};
+
+            childAppender.append (child.release());
+        }
+        else if (token == Token::text)
+        {
+            childAppender.append (XmlElement::createTextElement (String (CharPointer_UTF8 (static_cast<const char*> (textData.getData())))));
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    return element;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XmlReaderTests final : public UnitTest
+{
+public:
+    XmlReaderTests()
+        : UnitTest ("XmlReader", UnitTestCategories::xml)
+    {}
+
+    void runTest() override
+    {
+        using Token = XmlReader::Token;
+
+        beginTest ("Tokens");
+        {
+            const String text ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                               "<!DOCTYPE doc [ <!ENTITY e \"x\"> ]>\n"
+                               "<!-- comment -->\n"
+                               "<doc a=\"1 &amp; 2\" b='&#x41;&#66;'>\n"
+                               "  text &lt;&gt;<!-- comment -->more\r\ntext &e;\n"
+                               "  <empty/>\n"
+                               "  <![CDATA[<raw> ]]]]>\n"
+                               "</doc >\n"
+                               "<ignored>");
+
+            XmlReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+
+            expect (reader.next() == Token::startElement);
+            expect (reader.getName() == StringRef ("doc"));
+            expectEquals (reader.getDepth(), 1);
+            expectEquals (reader.getNumAttributes(), 2);
+            expect (reader.getAttributeName (1) == StringRef ("b"));
+            expect (reader.getAttribute ("a") == StringRef ("1 & 2"));
+            expect (reader.getAttribute ("b") == StringRef ("AB"));
+            expect (reader.hasAttribute ("b"));
+            expect (! reader.hasAttribute ("c"));
+            expect (reader.getAttribute ("c").isEmpty());
+
+            expect (reader.next() == Token::text);
+            expectEquals (String (reader.getText()), String ("\n  text <>more\ntext &e;\n  "));
+            expectEquals (reader.getNumAttributes(), 0);
+
+            expect (reader.next() == Token::startElement);
+            expect (reader.getName() == StringRef ("empty"));
+            expectEquals (reader.getDepth(), 2);
+            expect (reader.next() == Token::endElement);
+            expect (reader.getName() == StringRef ("empty"));
+            expectEquals (reader.getDepth(), 1);
+
+            expect (reader.next() == Token::text);
+            expectEquals (String (reader.getText()), String ("<raw> ]]"));
+
+            expect (reader.next() == Token::endElement);
+            expect (reader.getName() == StringRef ("doc"));
+            expectEquals (reader.getDepth(), 0);
+            expect (reader.next() == Token::endOfInput);
+            expect (reader.next() == Token::endOfInput);
+            expect (reader.getResult().wasOk());
+        }
+
+        beginTest ("Empty text");
+        {
+            const String text ("<a> <b/>\n</a>");
+
+            XmlReader ignoring (text.toRawUTF8(), text.getNumBytesAsUTF8());
+            expect (ignoring.next() == Token::startElement);
+            expect (ignoring.next() == Token::startElement);
+            expect (ignoring.next() == Token::endElement);
+            expect (ignoring.next() == Token::endElement);
+
+            XmlReader keeping (text.toRawUTF8(), text.getNumBytesAsUTF8());
+            keeping.setEmptyTextIgnored (false);
+            expect (keeping.next() == Token::startElement);
+            expect (keeping.next() == Token::text);
+            expect (keeping.getText() == StringRef (" "));
+            expect (keeping.next() == Token::startElement);
+            expect (keeping.next() == Token::endElement);
+            expect (keeping.next() == Token::text);
+            expect (keeping.getText() == StringRef ("\n"));
+            expect (keeping.next() == Token::endElement);
+        }
+
+        beginTest ("Elements match XmlDocument");
+        {
+            auto r = getRandom();
+
+            for (int i = 50; --i >= 0;)
+            {
+                XmlElement original ("ROOT");
+                addRandomContent (r, original, 0);
+                const auto text = original.toString();
+
+                MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+                XmlReader reader (stream, (size_t) (16 + r.nextInt (64)));
+
+                expect (reader.next() == Token::startElement);
+                auto element = reader.readElement();
+                expect (element != nullptr);
+                expect (reader.next() == Token::endOfInput);
+                expect (reader.getResult().wasOk());
+
+                if (element != nullptr)
+                    expectEquals (element->toString(), parseXML (text)->toString());
+            }
+        }
+
+        beginTest ("Skipping elements");
+        {
+            const String text ("<a><b><c x='>'/><c>text</c></b><d/></a>");
+            XmlReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+
+            expect (reader.next() == Token::startElement);
+            expect (reader.next() == Token::startElement);
+            expect (reader.skipElement());
+            expect (reader.getToken() == Token::endElement);
+            expect (reader.getName() == StringRef ("b"));
+            expect (reader.next() == Token::startElement);
+            expect (reader.getName() == StringRef ("d"));
+            expect (reader.skipElement());
+            expect (reader.getName() == StringRef ("d"));
+            expect (reader.next() == Token::endElement);
+            expect (reader.getName() == StringRef ("a"));
+        }
+
+        beginTest ("Errors");
+        {
+            expectError ("<a><b></a>", "1:9: error: mismatched end tag: expected </b>");
+            expectError ("<a>\n<b x=1/></a>", "2:6: error: expected a quoted value for attribute 'x'");
+            expectError ("<a x></a>", "1:5: error: expected '=' after attribute 'x'");
+            expectError ("<a 1='2'/>", "1:4: error: illegal character found in a: '1'");
+            expectError ("<a>text", "1:8: error: unmatched tags");
+            expectError ("<a x='1", "1:8: error: unmatched quotes");
+            expectError ("<a><!-- x </a>", "1:4: error: unterminated comment");
+            expectError ("<a>&#xd800;</a>", "1:4: error: illegal escape sequence");
+            expectError ("<a>\xff</a>", "1:4: error: invalid UTF-8");
+            expectError ("<a></>", "1:6: error: tag name missing");
+            expectError ("text", "1:1: error: expected the document element");
+            expectError ("  ", "1:3: error: not enough input");
+            expectError ("<a>&unknown; & &amp</a>", {});
+        }
+    }
+
+private:
+    static String createRandomName (Random& r)
+    {
+        static const char* const names[] = { "a", "B", "name", "x:y", "_under", "with-dash", "dotted.name" };
+        return names[r.nextInt (numElementsInArray (names))];
+    }
+
+    static String createRandomText (Random& r)
+    {
+        String s;
+
+        for (int i = r.nextInt (10); --i >= 0;)
+        {
+            static const char* const fragments[] = { " ", "abc", "&", "<", ">", "\"", "'", "\n", "\t", "]]>", "\xc3\xa9", "\xf0\x9f\x98\x80" };
+            s << String (CharPointer_UTF8 (fragments[r.nextInt (numElementsInArray (fragments))]));
+        }
+
+        return s;
+    }
+
+    static void addRandomContent (Random& r, XmlElement& element, int depth)
+    {
+        for (int i = r.nextInt (4); --i >= 0;)
+            element.setAttribute (createRandomName (r) + String (i), createRandomText (r));
+
+        if (depth > 4)
+            return;
+
+        for (int i = r.nextInt (5); --i >= 0;)
+        {
+            if (r.nextBool())
+            {
+                // text that's only whitespace would be ignored by the parsers
+                element.addTextElement (createRandomText (r) + "x");
+            }
+            else
+            {
+                auto* child = element.createNewChildElement (createRandomName (r));
+                addRandomContent (r, *child, depth + 1);
+            }
+        }
+    }
+
+    void expectError (const char* text, const String& expectedError)
+    {
+        XmlReader reader (text, strlen (text));
+
+        while (reader.next() != XmlReader::Token::endOfInput && reader.getToken() != XmlReader::Token::error)
+        {}
+
+        expectEquals (reader.getResult().getErrorMessage(), expectedError);
+        expect (reader.next() == (expectedError.isEmpty() ? XmlReader::Token::endOfInput : XmlReader::Token::error));
+    }
+};
+
+static XmlReaderTests xmlReaderTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads an XML document one token at a time, without building a tree of XmlElements.
+
+    XmlDocument::getDocumentElement() always creates a complete XmlElement tree for the
+    whole document, which for a large file can take many times more memory than the text
+    itself. An XmlReader instead reports each start tag, end tag and block of text in
+    turn, so only the token that is currently being looked at needs to be held in memory.
+    When part of the document is needed as a tree, readElement() can build one for just
+    that element.
+
+    The text can be read either from an InputStream, in which case it's pulled into a
+    fixed-size buffer as needed, or from a block of memory (e.g. a MemoryMappedFile),
+    which is read in place.
+
+    @code
+    XmlReader reader (stream);
+
+    while (reader.next() != XmlReader::Token::endOfInput)
+    {
+        if (reader.getToken() == XmlReader::Token::error)
+        {
+            DBG (reader.getResult().getErrorMessage());
+            break;
+        }
+
+        if (reader.getToken() == XmlReader::Token::startElement && reader.getName() == StringRef ("TRACK"))
+            addTrack (reader.getAttribute ("name"), reader.readElement());
+    }
+    @endcode
+
+    The input text must be encoded as UTF-8. Comments, processing instructions and the
+    DOCTYPE are skipped, and the standard entities and numeric character references are
+    expanded, but entities declared in a DTD are left in the text unexpanded. Unlike
+    XmlDocument, the reader checks that each end tag matches its start tag. Reading stops
+    when the document element has been closed, so anything that follows it is ignored.
+
+    @see XmlDocument, XmlElement
+
+    @tags{Core}
+*/
+class JUCE_API  XmlReader
+{
+public:
+    //==============================================================================
+    /** Creates a reader that pulls its text from a stream.
+
+        The stream must remain valid for the lifetime of the reader, and is read in
+        chunks of the given size.
+    */
+    explicit XmlReader (InputStream& source, size_t bufferSizeToUse = 65536);
+
+    /** Creates a reader that parses a block of UTF-8 text in memory.
+
+        The data isn't copied, so it must remain valid for the lifetime of the reader.
+    */
+    XmlReader (const void* data, size_t numBytes);
+
+    /** Destructor. */
+    ~XmlReader();
+
+    //==============================================================================
+    /** Sets a flag to change the treatment of text that only contains whitespace.
+
+        As with XmlDocument, this is true by default, which means that text tokens are
+        only produced for text that contains some non-whitespace characters.
+    */
+    void setEmptyTextIgnored (bool shouldBeIgnored) noexcept    { ignoreEmptyText = shouldBeIgnored; }
+
+    //==============================================================================
+    /** The kinds of token that the reader can produce. */
+    enum class Token
+    {
+        none,           ///< next() hasn't been called yet
+        startElement,   ///< A start tag, whose name and attributes are available from getName() and getAttribute()
+        endElement,     ///< An end tag, whose name is available from getName(). An empty-element tag produces a startElement followed by an endElement.
+        text,           ///< A block of text or a CDATA section, which is available from getText()
+        endOfInput,     ///< The document element has been closed
+        error           ///< The text was malformed; getResult() describes the problem
+    };
+
+    /** Moves on to the next token, and returns its type.
+
+        Once an error has been encountered, this will keep returning Token::error.
+    */
+    Token next();
+
+    /** Returns the type of the current token. */
+    Token getToken() const noexcept                 { return token; }
+
+    /** Returns the tag name of the current startElement or endElement token.
+
+        The text is only valid until next() is called again.
+    */
+    StringRef getName() const noexcept;
+
+    /** Returns the content of the current text token, with any entities expanded.
+
+        The text is only valid until next() is called again.
+    */
+    StringRef getText() const noexcept;
+
+    /** Returns the number of elements that enclose the current position.
+        After a startElement token, this includes the new element.
+    */
+    int getDepth() const noexcept                   { return (int) openElementOffsets.size(); }
+
+    /** Returns an error describing the problem if the text was malformed, or
+        Result::ok() if everything read so far was valid.
+    */
+    Result getResult() const;
+
+    //==============================================================================
+    /** Returns the number of attributes of the current startElement token. */
+    int getNumAttributes() const noexcept;
+
+    /** Returns the name of one of the current element's attributes.
+        The text is only valid until next() is called again.
+    */
+    StringRef getAttributeName (int attributeIndex) const noexcept;
+
+    /** Returns the value of one of the current element's attributes.
+        The text is only valid until next() is called again.
+    */
+    StringRef getAttributeValue (int attributeIndex) const noexcept;
+
+    /** Returns the value of the current element's attribute with the given name, or
+        an empty string if there's no such attribute.
+        The text is only valid until next() is called again.
+    */
+    StringRef getAttribute (StringRef attributeName) const noexcept;
+
+    /** Returns true if the current element has an attribute with the given name. */
+    bool hasAttribute (StringRef attributeName) const noexcept;
+
+    //==============================================================================
+    /** Skips over the current element.
+
+        If the current token is a startElement, the reader will move on to its matching
+        endElement. For any other token, this does nothing.
+
+        Returns false if an error was encountered.
+    */
+    bool skipElement();
+
+    /** Reads the current element into an XmlElement.
+
+        This is handy for pulling out small parts of a large document. If the current token
+        is a startElement, this builds the same tree that XmlDocument would have created for
+        it, and leaves the reader positioned at the matching endElement. For any other
+        token, or if an error is encountered, this returns nullptr.
+    */
+    std::unique_ptr<XmlElement> readElement();
+
+private:
+    //==============================================================================
+    enum class Markup : uint8
+    {
+        none,
+        startTag,
+        endTag,
+        cdata
+    };
+
+    struct AttributeOffsets
+    {
+        size_t name, value;
+    };
+
+    InputStream* stream = nullptr;
+    HeapBlock<char> buffer;
+    size_t bufferSize = 0;
+    const char* bufferStart = nullptr;
+    const char* position = nullptr;
+    const char* bufferEnd = nullptr;
+    int64 bytesBeforeBuffer = 0, startOfLine = 0;
+    int line = 1;
+
+    std::string openElementNames;
+    std::vector<size_t> openElementOffsets;
+    Token token = Token::none;
+    Markup pendingMarkup = Markup::none;
+    bool pendingEndElement = false, ignoreEmptyText = true;
+
+    MemoryOutputStream nameData, textData, attributeData;
+    std::vector<AttributeOffsets> attributes;
+    String errorMessage;
+
+    bool refill();
+    int peekByte();
+    struct Location
+    {
+        int64 offset, startOfLine;
+        int line;
+    };
+
+    Location getLocation() const noexcept   { return { bytesBeforeBuffer + (position - bufferStart), startOfLine, line }; }
+    Token setError (const String& message, Location);
+    Token setError (const String& message)  { return setError (message, getLocation()); }
+
+    void skipWhitespace();
+    void startNewLine();
+    bool matchLiteral (const char* text);
+    bool skipPast (char repeatedChar, int numRepeats, MemoryOutputStream* dest);
+    Token readProlog();
+    Token readContent();
+    Markup readMarkupType (Location);
+    bool readName (MemoryOutputStream&);
+    bool readEntity (MemoryOutputStream&);
+    bool readAttributeValue (char quote);
+    bool checkUTF8 (const MemoryOutputStream&, size_t startOffset, Location);
+    Token readStartTag();
+    Token readEndTag();
+    Token readCData();
+    Token closeElement();
+    const char* getAttributeData (size_t offset) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (XmlReader)
+};
+
+} // namespace juce
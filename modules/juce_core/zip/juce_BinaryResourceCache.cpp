@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+BinaryResourceCache::~BinaryResourceCache() = default;
+
+const void* BinaryResourceCache::getData (const void* storedData, size_t storedSize, size_t originalSize, int codecId)
+{
+    if (codecId == CompressionCodec::storedCodecId)
+    {
+        jassert (storedSize == originalSize);
+        return storedData;
+    }
+
+    const ScopedLock sl (lock);
+
+    auto existing = cache.find (storedData);
+
+    if (existing != cache.end())
+    {
+        // The same stored data can't be describing two different resources!
+        jassert (existing->second.getSize() == originalSize);
+        return existing->second.getData();
+    }
+
+    auto* codec = CompressionCodec::findCodec (codecId);
+
+    // The resource was compressed with a codec that hasn't been registered
+    jassert (codec != nullptr);
+
+    if (codec == nullptr)
+        return nullptr;
+
+    MemoryBlock result (originalSize);
+
+    if (! codec->decompressBlock (storedData, storedSize, result.getData(), originalSize))
+    {
+        jassertfalse; // the stored data is corrupt
+        return nullptr;
+    }
+
+    return cache.emplace (storedData, std::move (result)).first->second.getData();
+}
+
+void BinaryResourceCache::clear()
+{
+    const ScopedLock sl (lock);
+    cache.clear();
+}
+
+int BinaryResourceCache::getNumCachedResources() const
+{
+    const ScopedLock sl (lock);
+    return (int) cache.size();
+}
+
+size_t BinaryResourceCache::getTotalCachedSize() const
+{
+    const ScopedLock sl (lock);
+    size_t total = 0;
+
+    for (const auto& item : cache)
+        total += item.second.getSize();
+
+    return total;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct BinaryResourceCacheTests final : public UnitTest
+{
+    BinaryResourceCacheTests()
+        : UnitTest ("BinaryResourceCache", UnitTestCategories::compression)
+    {}
+
+    void runTest() override
+    {
+        MemoryOutputStream text;
+
+        for (int i = 0; i < 2000; ++i)
+            text << "Resource line " << (i % 37) << newLine;
+
+        const auto original = text.getMemoryBlock();
+
+        beginTest ("Uncompressed resources are returned as they are");
+        {
+            BinaryResourceCache cache;
+            expect (cache.getData (original.getData(), original.getSize(), original.getSize(),
+                                   CompressionCodec::storedCodecId) == original.getData());
+            expectEquals (cache.getNumCachedResources(), 0);
+        }
+
+        beginTest ("Compressed resources are decompressed once");
+        {
+            for (auto* codec : { &CompressionCodec::getLZ4Codec(), &CompressionCodec::getDeflateCodec() })
+            {
+                MemoryBlock stored (codec->getMaxCompressedSize (original.getSize()));
+                const auto storedSize = codec->compressBlock (original.getData(), original.getSize(),
+                                                              stored.getData(), stored.getSize(), -1);
+                expect (storedSize > 0 && storedSize < original.getSize());
+
+                BinaryResourceCache cache;
+                auto* data = cache.getData (stored.getData(), storedSize, original.getSize(), codec->getCodecId());
+
+                expect (data != nullptr && memcmp (data, original.getData(), original.getSize()) == 0);
+                expect (cache.getData (stored.getData(), storedSize, original.getSize(), codec->getCodecId()) == data);
+                expectEquals (cache.getNumCachedResources(), 1);
+                expectEquals (cache.getTotalCachedSize(), original.getSize());
+
+                cache.clear();
+                expectEquals (cache.getNumCachedResources(), 0);
+            }
+        }
+    }
+};
+
+static BinaryResourceCacheTests binaryResourceCacheTests;
+
+#endif
+
+} // namespace juce
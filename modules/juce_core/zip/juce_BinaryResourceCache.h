@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds the decompressed contents of embedded resources that were stored compressed.
+
+    The BinaryData files that juce_add_binary_data() creates with its COMPRESSION option
+    hold each resource compressed with a CompressionCodec, unless compressing it didn't
+    make it smaller. A BinaryResourceCache decompresses each resource the first time it
+    is asked for and keeps the result, so only the resources that are actually used take
+    up any memory.
+
+    @code
+    int storedSize, originalSize, codecId;
+    auto* stored = BinaryData::getNamedResourceStorage ("background_png", storedSize, originalSize, codecId);
+
+    static BinaryResourceCache cache;
+    auto* data = cache.getData (stored, (size_t) storedSize, (size_t) originalSize, codecId);
+    @endcode
+
+    All the methods are thread-safe.
+
+    @see CompressionCodec
+
+    @tags{Core}
+*/
+class JUCE_API  BinaryResourceCache
+{
+public:
+    /** Creates an empty cache. */
+    BinaryResourceCache() = default;
+
+    /** Destructor. Any data returned by getData() is no longer valid after this. */
+    ~BinaryResourceCache();
+
+    //==============================================================================
+    /** Returns the original contents of a resource.
+
+        If the codec ID is CompressionCodec::storedCodecId, the stored data is returned as it
+        is. Otherwise the data is decompressed on the first call for that resource, and later
+        calls return the same block. The data stays valid until clear() is called or the
+        cache is deleted.
+
+        @param storedData       the resource's data as it is stored
+        @param storedSize       the number of bytes of stored data
+        @param originalSize     the size of the resource before it was compressed
+        @param codecId          the ID of the CompressionCodec that compressed the data
+        @returns the originalSize bytes of the resource, or nullptr if no codec with that ID
+                 is registered, or the data couldn't be decompressed
+    */
+    const void* getData (const void* storedData, size_t storedSize, size_t originalSize, int codecId);
+
+    /** Frees all the decompressed resources. */
+    void clear();
+
+    /** Returns the number of resources that are currently held in decompressed form. */
+    int getNumCachedResources() const;
+
+    /** Returns the total size of the decompressed resources that are currently held. */
+    size_t getTotalCachedSize() const;
+
+private:
+    //==============================================================================
+    CriticalSection lock;
+    std::map<const void*, MemoryBlock> cache;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BinaryResourceCache)
+};
+
+} // namespace juce
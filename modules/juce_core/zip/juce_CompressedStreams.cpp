@@ -0,0 +1,595 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+namespace CompressedStreamHelpers
+{
+    // Each stream starts with this magic number, and is followed by a series of blocks. A block
+    // is a codec ID byte and two little-endian 32-bit sizes (the original size and the size
+    // that follows), and the data ends with a block whose original size is zero.
+    static constexpr uint8 streamHeader[] = { 'J', 'C', 'Z', 1 };
+    static constexpr int blockHeaderSize = 9;
+    static constexpr size_t maxBlockSize = 64 * 1024 * 1024;
+}
+
+//==============================================================================
+CompressedOutputStream::CompressedOutputStream (OutputStream& dest, const CompressionCodec& c,
+                                                int level, size_t size)
+    : destStream (dest),
+      codec (c),
+      compressionLevel (level),
+      blockSize (jlimit ((size_t) 1024, CompressedStreamHelpers::maxBlockSize, size))
+{
+    // To be able to read the data back, CompressedInputStream has to be able to find the codec!
+    jassert (CompressionCodec::findCodec (codec.getCodecId()) == &codec);
+}
+
+CompressedOutputStream::~CompressedOutputStream()
+{
+    flush();
+
+    if (! failed)
+    {
+        uint8 endMarker[CompressedStreamHelpers::blockHeaderSize] = {};
+        destStream.write (endMarker, sizeof (endMarker));
+        destStream.flush();
+    }
+}
+
+void CompressedOutputStream::writeHeaderIfNeeded()
+{
+    if (! headerWritten)
+    {
+        headerWritten = true;
+        failed = ! destStream.write (CompressedStreamHelpers::streamHeader, sizeof (CompressedStreamHelpers::streamHeader));
+    }
+}
+
+bool CompressedOutputStream::writeBlock (const void* data, size_t numBytes)
+{
+    writeHeaderIfNeeded();
+
+    if (failed)
+        return false;
+
+    auto maxSize = codec.getMaxCompressedSize (numBytes);
+
+    if (compressedCapacity < maxSize)
+    {
+        compressed.malloc (maxSize);
+        compressedCapacity = maxSize;
+    }
+
+    // only accept a compressed block if it's smaller, so that the reader never needs more than
+    // one block's worth of memory for the stored data
+    auto numCompressed = codec.compressBlock (data, numBytes, compressed, jmin (compressedCapacity, numBytes - 1), compressionLevel);
+    auto stored = numCompressed > 0;
+    auto* payload = stored ? static_cast<const void*> (compressed.get()) : data;
+    auto payloadSize = stored ? numCompressed : numBytes;
+
+    uint8 header[CompressedStreamHelpers::blockHeaderSize];
+    header[0] = (uint8) (stored ? codec.getCodecId() : (int) CompressionCodec::storedCodecId);
+    auto putInt = [] (uint8* p, uint32 v) { for (int i = 0; i < 4; ++i) p[i] = (uint8) (v >> (8 * i)); };
+    putInt (header + 1, (uint32) numBytes);
+    putInt (header + 5, (uint32) payloadSize);
+
+    failed = ! (destStream.write (header, sizeof (header)) && destStream.write (payload, payloadSize));
+    return ! failed;
+}
+
+void CompressedOutputStream::flush()
+{
+    if (numPending > 0)
+    {
+        writeBlock (pending, numPending);
+        numPending = 0;
+    }
+
+    destStream.flush();
+}
+
+int64 CompressedOutputStream::getPosition()
+{
+    return totalWritten;
+}
+
+bool CompressedOutputStream::setPosition (int64)
+{
+    jassertfalse; // can't do it!
+    return false;
+}
+
+bool CompressedOutputStream::write (const void* data, size_t numBytes)
+{
+    jassert (data != nullptr || numBytes == 0);
+
+    if (failed)
+        return false;
+
+    auto* src = static_cast<const char*> (data);
+    totalWritten += (int64) numBytes;
+
+    while (numBytes > 0)
+    {
+        // whole blocks can be compressed straight from the caller's data
+        if (numPending == 0 && numBytes >= blockSize)
+        {
+            if (! writeBlock (src, blockSize))
+                return false;
+
+            src += blockSize;
+            numBytes -= blockSize;
+            continue;
+        }
+
+        if (pending == nullptr)
+            pending.malloc (blockSize);
+
+        auto numToCopy = jmin (numBytes, blockSize - numPending);
+        memcpy (pending + numPending, src, numToCopy);
+        numPending += numToCopy;
+        src += numToCopy;
+        numBytes -= numToCopy;
+
+        if (numPending == blockSize)
+        {
+            numPending = 0;
+
+            if (! writeBlock (pending, blockSize))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+MemoryBlock CompressedOutputStream::compressData (const void* data, size_t numBytes,
+                                              const CompressionCodec& codec, int compressionLevel)
+{
+    MemoryOutputStream out;
+
+    {
+        CompressedOutputStream compressor (out, codec, compressionLevel);
+        compressor.write (data, numBytes);
+    }
+
+    return out.getMemoryBlock();
+}
+
+//==============================================================================
+CompressedInputStream::CompressedInputStream (InputStream* source, bool deleteSourceWhenDestroyed)
+    : sourceStream (source, deleteSourceWhenDestroyed),
+      originalSourcePos (source->getPosition())
+{
+}
+
+CompressedInputStream::CompressedInputStream (InputStream& source)
+    : CompressedInputStream (&source, false)
+{
+}
+
+CompressedInputStream::~CompressedInputStream() = default;
+
+bool CompressedInputStream::checkStreamHeader()
+{
+    if (! headerChecked)
+    {
+        headerChecked = true;
+        uint8 magic[sizeof (CompressedStreamHelpers::streamHeader)];
+
+        if (sourceStream->read (magic, (int) sizeof (magic)) != (int) sizeof (magic)
+             || ! isCompressedData (magic, sizeof (magic)))
+            failed = finished = true;
+    }
+
+    return ! failed;
+}
+
+bool CompressedInputStream::readBlockHeader()
+{
+    if (! checkStreamHeader())
+        return false;
+
+    uint8 header[CompressedStreamHelpers::blockHeaderSize];
+
+    if (sourceStream->read (header, (int) sizeof (header)) != (int) sizeof (header))
+    {
+        // a stream with no end marker was probably cut short
+        failed = finished = true;
+        return false;
+    }
+
+    currentCodecId = header[0];
+    currentRawSize = ByteOrder::littleEndianInt (header + 1);
+    currentStoredSize = ByteOrder::littleEndianInt (header + 5);
+
+    if (currentRawSize == 0)
+    {
+        finished = true;
+        return false;
+    }
+
+    if (currentRawSize > CompressedStreamHelpers::maxBlockSize
+         || currentStoredSize > currentRawSize
+         || (currentCodecId == CompressionCodec::storedCodecId && currentStoredSize != currentRawSize)
+         || CompressionCodec::findCodec (currentCodecId) == nullptr)
+    {
+        failed = finished = true;
+        return false;
+    }
+
+    return true;
+}
+
+bool CompressedInputStream::decodeBlock (void* dest)
+{
+    auto* codec = CompressionCodec::findCodec (currentCodecId);
+
+    if (currentCodecId == CompressionCodec::storedCodecId)
+    {
+        if (sourceStream->read (dest, (int) currentRawSize) == (int) currentRawSize)
+            return true;
+    }
+    else
+    {
+        compressedBlock.ensureSize (currentStoredSize, false);
+
+        if (sourceStream->read (compressedBlock.getData(), (int) currentStoredSize) == (int) currentStoredSize
+             && codec->decompressBlock (compressedBlock.getData(), currentStoredSize, dest, currentRawSize))
+            return true;
+    }
+
+    failed = finished = true;
+    return false;
+}
+
+int CompressedInputStream::read (void* destBuffer, int maxBytesToRead)
+{
+    jassert (destBuffer != nullptr && maxBytesToRead >= 0);
+
+    auto* dest = static_cast<char*> (destBuffer);
+    int numRead = 0;
+
+    while (numRead < maxBytesToRead)
+    {
+        if (bufferPos < bufferSize)
+        {
+            auto numToCopy = jmin ((size_t) (maxBytesToRead - numRead), bufferSize - bufferPos);
+            memcpy (dest + numRead, buffer + bufferPos, numToCopy);
+            bufferPos += numToCopy;
+            numRead += (int) numToCopy;
+            continue;
+        }
+
+        if (finished || ! readBlockHeader())
+            break;
+
+        // if the caller wants the whole block, it can be decoded straight into their buffer
+        if ((size_t) (maxBytesToRead - numRead) >= currentRawSize)
+        {
+            if (! decodeBlock (dest + numRead))
+                break;
+
+            numRead += (int) currentRawSize;
+            continue;
+        }
+
+        if (bufferCapacity < currentRawSize)
+        {
+            buffer.malloc (currentRawSize);
+            bufferCapacity = currentRawSize;
+        }
+
+        bufferPos = bufferSize = 0;
+
+        if (! decodeBlock (buffer))
+            break;
+
+        bufferSize = currentRawSize;
+    }
+
+    currentPos += numRead;
+    return numRead;
+}
+
+void CompressedInputStream::restart()
+{
+    sourceStream->setPosition (originalSourcePos);
+    bufferPos = bufferSize = 0;
+    currentPos = 0;
+    headerChecked = finished = failed = false;
+}
+
+bool CompressedInputStream::setPosition (int64 newPos)
+{
+    if (newPos < currentPos)
+        restart();
+
+    auto numToSkip = newPos - currentPos;
+
+    // skip what's left of the current block, and then any whole blocks without decoding them
+    auto numBuffered = (int64) (bufferSize - bufferPos);
+
+    if (numToSkip > numBuffered && numBuffered > 0)
+    {
+        bufferPos = bufferSize;
+        currentPos += numBuffered;
+        numToSkip -= numBuffered;
+    }
+
+    while (numToSkip > 0 && bufferPos == bufferSize && ! finished && checkStreamHeader())
+    {
+        auto headerPos = sourceStream->getPosition();
+
+        if (! readBlockHeader())
+            break;
+
+        if (numToSkip < (int64) currentRawSize)
+        {
+            // the new position is in this block, so it needs decoding after all
+            sourceStream->setPosition (headerPos);
+            break;
+        }
+
+        sourceStream->skipNextBytes (currentStoredSize);
+        currentPos += currentRawSize;
+        numToSkip -= currentRawSize;
+    }
+
+    skipNextBytes (numToSkip);
+    return currentPos == newPos;
+}
+
+int64 CompressedInputStream::getPosition()
+{
+    return currentPos;
+}
+
+int64 CompressedInputStream::getTotalLength()
+{
+    return -1;
+}
+
+bool CompressedInputStream::isExhausted()
+{
+    return bufferPos >= bufferSize && finished;
+}
+
+bool CompressedInputStream::isCompressedData (const void* data, size_t numBytes) noexcept
+{
+    return numBytes >= sizeof (CompressedStreamHelpers::streamHeader)
+            && memcmp (data, CompressedStreamHelpers::streamHeader, sizeof (CompressedStreamHelpers::streamHeader)) == 0;
+}
+
+bool CompressedInputStream::decompressData (const void* data, size_t numBytes, MemoryBlock& result)
+{
+    MemoryInputStream in (data, numBytes, false);
+    CompressedInputStream decompressor (in);
+    MemoryOutputStream out (result, false);
+    out.writeFromInputStream (decompressor, -1);
+    return decompressor.isValid();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct CompressedStreamTests final : public UnitTest
+{
+    CompressedStreamTests()
+        : UnitTest ("CompressedStreams", UnitTestCategories::compression)
+    {}
+
+    static MemoryBlock createTestData (Random& rng, int size)
+    {
+        // a mixture of repetitive text, runs and noise, so that every kind of sequence gets used
+        MemoryOutputStream out;
+
+        while ((int) out.getDataSize() < size)
+        {
+            switch (rng.nextInt (4))
+            {
+                case 0:   out << "<PARAM id=\"gain" << rng.nextInt (40) << "\" value=\"" << rng.nextFloat() << "\"/>\n"; break;
+                case 1:   for (int i = rng.nextInt (300); --i >= 0;) out.writeByte ('a'); break;
+                case 2:   for (int i = rng.nextInt (100); --i >= 0;) out.writeByte ((char) rng.nextInt (256)); break;
+                default:  out << "abcabcabcabcd"; break;
+            }
+        }
+
+        out.setPosition (size);
+        auto block = out.getMemoryBlock();
+        block.setSize ((size_t) size);
+        return block;
+    }
+
+    void testCodec (const CompressionCodec& codec, Random& rng)
+    {
+        for (auto size : { 0, 1, 5, 12, 13, 14, 100, 5000, 70000, 300000 })
+        {
+            auto original = createTestData (rng, size);
+
+            for (auto level : { -1, 1, 9 })
+            {
+                HeapBlock<char> compressed (codec.getMaxCompressedSize (original.getSize()) + 1);
+                auto numCompressed = codec.compressBlock (original.getData(), original.getSize(),
+                                                     compressed, codec.getMaxCompressedSize (original.getSize()), level);
+                expect (numCompressed > 0 || size == 0);
+
+                MemoryBlock decompressed ((size_t) size);
+                expect (codec.decompressBlock (compressed, numCompressed, decompressed.getData(), decompressed.getSize()));
+                expect (decompressed == original);
+
+                if (numCompressed > 1)
+                {
+                    // damaged data must be rejected without reading or writing out of bounds
+                    expect (! codec.decompressBlock (compressed, numCompressed / 2, decompressed.getData(), decompressed.getSize())
+                             || codec.getCodecId() == CompressionCodec::storedCodecId);
+                }
+            }
+        }
+    }
+
+    void runTest() override
+    {
+        auto rng = getRandom();
+
+        beginTest ("Codecs");
+        {
+            testCodec (CompressionCodec::getStoredCodec(), rng);
+            testCodec (CompressionCodec::getDeflateCodec(), rng);
+            testCodec (CompressionCodec::getLZ4Codec(), rng);
+
+            // "abc", then a 21-byte match at offset 3, then "xyz12"
+            const uint8 lz4Block[] = { 0x3f, 'a', 'b', 'c', 0x03, 0x00, 0x02, 0x50, 'x', 'y', 'z', '1', '2' };
+            char decoded[29] = {};
+            expect (CompressionCodec::getLZ4Codec().decompressBlock (lz4Block, sizeof (lz4Block), decoded, sizeof (decoded)));
+            expectEquals (String (decoded, sizeof (decoded)), String ("abcabcabcabcabcabcabcabcxyz12"));
+            expect (! CompressionCodec::getLZ4Codec().decompressBlock (lz4Block, sizeof (lz4Block), decoded, sizeof (decoded) - 1));
+        }
+
+        beginTest ("Round trip through streams");
+        {
+            for (auto* codec : { &CompressionCodec::getLZ4Codec(), &CompressionCodec::getDeflateCodec() })
+            {
+                auto original = createTestData (rng, 200000);
+                MemoryOutputStream compressed;
+
+                {
+                    CompressedOutputStream out (compressed, *codec, -1, 4096);
+
+                    for (size_t pos = 0; pos < original.getSize();)
+                    {
+                        auto num = jmin ((size_t) rng.nextInt (10000), original.getSize() - pos);
+                        expect (out.write (static_cast<const char*> (original.getData()) + pos, num));
+                        pos += num;
+
+                        if (rng.nextInt (10) == 0)
+                            out.flush();
+                    }
+
+                    expectEquals (out.getPosition(), (int64) original.getSize());
+                }
+
+                expect (compressed.getDataSize() < original.getSize());
+                expect (CompressedInputStream::isCompressedData (compressed.getData(), compressed.getDataSize()));
+
+                MemoryBlock result;
+                expect (CompressedInputStream::decompressData (compressed.getData(), compressed.getDataSize(), result));
+                expect (result == original);
+
+                MemoryInputStream source (compressed.getData(), compressed.getDataSize(), false);
+                CompressedInputStream in (source);
+
+                for (int i = 0; i < 50; ++i)
+                {
+                    auto pos = rng.nextInt ((int) original.getSize());
+                    char buffer[600];
+                    expect (in.setPosition (pos));
+                    auto numRead = in.read (buffer, (int) sizeof (buffer));
+                    expectEquals (numRead, jmin ((int) sizeof (buffer), (int) original.getSize() - pos));
+                    expect (memcmp (buffer, static_cast<const char*> (original.getData()) + pos, (size_t) numRead) == 0);
+                }
+
+                expect (in.setPosition ((int64) original.getSize()));
+                char c;
+                expectEquals (in.read (&c, 1), 0);
+                expect (in.isExhausted());
+                expect (in.isValid());
+            }
+        }
+
+        beginTest ("Incompressible and truncated data");
+        {
+            MemoryBlock noise (100000);
+
+            for (size_t i = 0; i < noise.getSize(); ++i)
+                noise[i] = (char) rng.nextInt (256);
+
+            auto compressed = CompressedOutputStream::compressData (noise.getData(), noise.getSize());
+            expect (compressed.getSize() < noise.getSize() + 200);
+
+            MemoryBlock result;
+            expect (CompressedInputStream::decompressData (compressed.getData(), compressed.getSize(), result));
+            expect (result == noise);
+
+            expect (! CompressedInputStream::decompressData (compressed.getData(), compressed.getSize() / 2, result));
+            expect (! CompressedInputStream::decompressData (noise.getData(), noise.getSize(), result));
+        }
+
+        beginTest ("User codecs");
+        {
+            struct InvertingCodec final : public CompressionCodec
+            {
+                int getCodecId() const override                             { return firstUserCodecId + 3; }
+                String getName() const override                             { return "Invert"; }
+                size_t getMaxCompressedSize (size_t size) const override    { return size; }
+
+                size_t compressBlock (const void* s, size_t n, void* d, size_t capacity, int) const override
+                {
+                    if (n - 1 > capacity || n < 2)
+                        return 0;
+
+                    for (size_t i = 0; i < n - 1; ++i)
+                        static_cast<uint8*> (d)[i] = (uint8) ~static_cast<const uint8*> (s)[i];
+
+                    return n - 1; // pretend that it got a bit smaller, dropping the last byte
+                }
+
+                bool decompressBlock (const void* s, size_t n, void* d, size_t size) const override
+                {
+                    if (n + 1 != size)
+                        return false;
+
+                    for (size_t i = 0; i < n; ++i)
+                        static_cast<uint8*> (d)[i] = (uint8) ~static_cast<const uint8*> (s)[i];
+
+                    static_cast<uint8*> (d)[n] = 'z';
+                    return true;
+                }
+            };
+
+            InvertingCodec codec;
+            expect (CompressionCodec::registerCodec (codec));
+            expect (CompressionCodec::findCodec (codec.getCodecId()) == &codec);
+
+            const MemoryBlock original (String (String::repeatedString ("hello", 1000) + "z").toRawUTF8(), 5001);
+            auto compressed = CompressedOutputStream::compressData (original.getData(), original.getSize(), codec);
+
+            MemoryBlock result;
+            expect (CompressedInputStream::decompressData (compressed.getData(), compressed.getSize(), result));
+            expect (result == original);
+
+            CompressionCodec::unregisterCodec (codec);
+            expect (CompressionCodec::findCodec (codec.getCodecId()) == nullptr);
+            expect (! CompressedInputStream::decompressData (compressed.getData(), compressed.getSize(), result));
+        }
+    }
+};
+
+static CompressedStreamTests compressedStreamTests;
+
+#endif
+
+} // namespace juce
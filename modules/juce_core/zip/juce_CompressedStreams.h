@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A stream which splits the data written into it into blocks, and compresses each
+    block with a CompressionCodec.
+
+    The codec and compression level can be chosen for each stream, so that a call site
+    which saves large amounts of data often can use a fast codec such as LZ4, while one
+    that needs the smallest result can use deflate. Blocks which don't get any smaller
+    are stored as they are. The data can be read back with CompressedInputStream, which
+    doesn't need to be told which codec was used.
+
+    Unlike GZIPCompressorOutputStream, calling flush() doesn't close the stream: it just
+    writes out any data that is waiting to be compressed, so more data can follow. The end
+    of the data is marked when the stream is deleted.
+
+    @see CompressedInputStream, CompressionCodec
+
+    @tags{Core}
+*/
+class JUCE_API  CompressedOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates a compression stream.
+
+        @param destStream           the stream into which the compressed data will be written
+        @param codec                the codec to compress each block with. This must stay alive
+                                    for as long as the stream does
+        @param compressionLevel     the codec-specific level, or a negative number to use the
+                                    codec's default
+        @param blockSize            the number of bytes that are compressed at a time. Bigger
+                                    blocks may compress better, but need more memory to read back
+    */
+    CompressedOutputStream (OutputStream& destStream,
+                            const CompressionCodec& codec = CompressionCodec::getLZ4Codec(),
+                            int compressionLevel = -1,
+                            size_t blockSize = defaultBlockSize);
+
+    /** Destructor.
+        This writes out any remaining data, followed by the end-of-data marker.
+    */
+    ~CompressedOutputStream() override;
+
+    //==============================================================================
+    /** Compresses any data that has been written since the last block was written, and
+        flushes the destination stream. More data can still be written afterwards.
+    */
+    void flush() override;
+
+    /** Returns the number of uncompressed bytes that have been written to the stream. */
+    int64 getPosition() override;
+
+    /** This stream can't be repositioned, so this always returns false. */
+    bool setPosition (int64) override;
+
+    bool write (const void*, size_t) override;
+
+    //==============================================================================
+    /** The block size used if none is given to the constructor. */
+    static constexpr size_t defaultBlockSize = 256 * 1024;
+
+    /** Compresses a block of memory in one go, returning data that can be read back with
+        CompressedInputStream or CompressedInputStream::decompressData().
+    */
+    static MemoryBlock compressData (const void* data, size_t numBytes,
+                                 const CompressionCodec& codec = CompressionCodec::getLZ4Codec(),
+                                 int compressionLevel = -1);
+
+private:
+    //==============================================================================
+    bool writeBlock (const void* data, size_t numBytes);
+    void writeHeaderIfNeeded();
+
+    OutputStream& destStream;
+    const CompressionCodec& codec;
+    const int compressionLevel;
+    const size_t blockSize;
+    HeapBlock<char> pending, compressed;
+    size_t numPending = 0, compressedCapacity = 0;
+    int64 totalWritten = 0;
+    bool headerWritten = false, failed = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompressedOutputStream)
+};
+
+//==============================================================================
+/**
+    A stream which reads back the data that was written by a CompressedOutputStream.
+
+    Any of the built-in codecs, or a codec that has been added with
+    CompressionCodec::registerCodec(), can be decoded. If the data is damaged, or uses a
+    codec that isn't registered, the stream stops at the last good block.
+
+    @see CompressedOutputStream, CompressionCodec
+
+    @tags{Core}
+*/
+class JUCE_API  CompressedInputStream  : public InputStream
+{
+public:
+    //==============================================================================
+    /** Creates a decompressor stream.
+
+        @param sourceStream                 the stream to read from
+        @param deleteSourceWhenDestroyed    whether or not to delete the source stream
+                                            when this object is destroyed
+    */
+    CompressedInputStream (InputStream* sourceStream, bool deleteSourceWhenDestroyed);
+
+    /** Creates a decompressor stream.
+
+        @param sourceStream     the stream to read from - the source stream must not be
+                                deleted until this object has been destroyed
+    */
+    CompressedInputStream (InputStream& sourceStream);
+
+    /** Destructor. */
+    ~CompressedInputStream() override;
+
+    //==============================================================================
+    /** Returns true if the last block was read with no errors. */
+    bool isValid() const noexcept                       { return ! failed; }
+
+    //==============================================================================
+    int64 getPosition() override;
+    bool setPosition (int64 pos) override;
+    int64 getTotalLength() override;
+    bool isExhausted() override;
+    int read (void* destBuffer, int maxBytesToRead) override;
+
+    //==============================================================================
+    /** Returns true if a block of memory starts with the header written by CompressedOutputStream. */
+    static bool isCompressedData (const void* data, size_t numBytes) noexcept;
+
+    /** Decompresses a whole block of memory that was written by CompressedOutputStream.
+
+        @returns true if all of the data was valid
+    */
+    static bool decompressData (const void* data, size_t numBytes, MemoryBlock& result);
+
+private:
+    //==============================================================================
+    bool checkStreamHeader();
+    bool readBlockHeader();
+    bool decodeBlock (void* dest);
+    void restart();
+
+    OptionalScopedPointer<InputStream> sourceStream;
+    const int64 originalSourcePos;
+    MemoryBlock compressedBlock;
+    HeapBlock<char> buffer;
+    size_t bufferCapacity = 0, bufferSize = 0, bufferPos = 0;
+    int currentCodecId = 0;
+    uint32 currentRawSize = 0, currentStoredSize = 0;
+    int64 currentPos = 0;
+    bool headerChecked = false, finished = false, failed = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompressedInputStream)
+};
+
+} // namespace juce
@@ -0,0 +1,403 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+namespace CompressionCodecHelpers
+{
+    //==============================================================================
+    struct StoredCodec final : public CompressionCodec
+    {
+        int getCodecId() const override                     { return storedCodecId; }
+        String getName() const override                     { return "Stored"; }
+        size_t getMaxCompressedSize (size_t size) const override  { return size; }
+
+        size_t compressBlock (const void* source, size_t sourceSize, void* dest, size_t destCapacity, int) const override
+        {
+            if (sourceSize > destCapacity)
+                return 0;
+
+            memcpy (dest, source, sourceSize);
+            return sourceSize;
+        }
+
+        bool decompressBlock (const void* source, size_t sourceSize, void* dest, size_t destSize) const override
+        {
+            if (sourceSize != destSize)
+                return false;
+
+            memcpy (dest, source, sourceSize);
+            return true;
+        }
+    };
+
+    //==============================================================================
+    struct DeflateCodec final : public CompressionCodec
+    {
+        int getCodecId() const override     { return deflateCodecId; }
+        String getName() const override     { return "Deflate"; }
+
+        size_t getMaxCompressedSize (size_t size) const override
+        {
+            // the same bound that zlib's deflateBound() gives for a raw stream
+            return size + (size >> 12) + (size >> 14) + (size >> 25) + 13;
+        }
+
+        size_t compressBlock (const void* source, size_t sourceSize, void* dest, size_t destCapacity, int level) const override
+        {
+            using namespace zlibNamespace;
+
+            if (sourceSize > std::numeric_limits<uInt>::max() || destCapacity == 0)
+                return 0;
+
+            z_stream stream;
+            zerostruct (stream);
+
+            if (deflateInit2 (&stream, (level < 0 || level > 9) ? Z_DEFAULT_COMPRESSION : level,
+                              Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                return 0;
+
+            stream.next_in   = static_cast<Bytef*> (const_cast<void*> (source));
+            stream.avail_in  = (uInt) sourceSize;
+            stream.next_out  = static_cast<Bytef*> (dest);
+            stream.avail_out = (uInt) jmin (destCapacity, (size_t) std::numeric_limits<uInt>::max());
+
+            auto result = deflate (&stream, Z_FINISH);
+            auto numWritten = (size_t) stream.total_out;
+            deflateEnd (&stream);
+
+            return result == Z_STREAM_END ? numWritten : 0;
+        }
+
+        bool decompressBlock (const void* source, size_t sourceSize, void* dest, size_t destSize) const override
+        {
+            using namespace zlibNamespace;
+
+            if (sourceSize > std::numeric_limits<uInt>::max() || destSize > std::numeric_limits<uInt>::max())
+                return false;
+
+            z_stream stream;
+            zerostruct (stream);
+
+            if (inflateInit2 (&stream, -MAX_WBITS) != Z_OK)
+                return false;
+
+            stream.next_in   = static_cast<Bytef*> (const_cast<void*> (source));
+            stream.avail_in  = (uInt) sourceSize;
+            // zlib won't finish a stream without somewhere to write to, even if the output is empty
+            Bytef unused;
+            stream.next_out  = destSize > 0 ? static_cast<Bytef*> (dest) : &unused;
+            stream.avail_out = destSize > 0 ? (uInt) destSize : 1;
+
+            auto result = inflate (&stream, Z_FINISH);
+            auto numWritten = (size_t) stream.total_out;
+            inflateEnd (&stream);
+
+            return result == Z_STREAM_END && numWritten == destSize;
+        }
+    };
+
+    //==============================================================================
+    /*  An implementation of the LZ4 block format, as described at
+        https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+
+        Each sequence is a token byte holding a literal length and a match length,
+        followed by the literals and a 16-bit offset back to the match.
+    */
+    struct LZ4Codec final : public CompressionCodec
+    {
+        int getCodecId() const override     { return lz4CodecId; }
+        String getName() const override     { return "LZ4"; }
+
+        size_t getMaxCompressedSize (size_t size) const override
+        {
+            return size + size / 255 + 16;
+        }
+
+        size_t compressBlock (const void* source, size_t sourceSize, void* dest, size_t destCapacity, int level) const override
+        {
+            auto* const src = static_cast<const uint8*> (source);
+            auto* const srcEnd = src + sourceSize;
+            auto* const dst = static_cast<uint8*> (dest);
+            auto* const dstEnd = dst + destCapacity;
+
+            auto* ip = src;
+            auto* anchor = src;
+            auto* op = dst;
+
+            if (sourceSize >= minInputForMatches)
+            {
+                // how quickly to start skipping ahead when no matches are being found
+                const int skipShift = level < 0 ? 6 : (level < 3 ? 4 : (level < 6 ? 6 : 12));
+
+                HeapBlock<uint32> table (hashTableSize, true);
+                auto* const matchStartLimit = srcEnd - minInputForMatches + 1;
+                auto* const matchEndLimit = srcEnd - numLastLiterals;
+
+                while (ip < matchStartLimit)
+                {
+                    auto sequence = read32 (ip);
+                    auto& entry = table[hash (sequence)];
+                    auto* ref = src + entry;
+                    entry = (uint32) (ip - src);
+
+                    if (ref >= ip || ip - ref > maxOffset || read32 (ref) != sequence)
+                    {
+                        ip += 1 + ((ip - anchor) >> skipShift);
+                        continue;
+                    }
+
+                    while (ip > anchor && ref > src && ip[-1] == ref[-1])
+                    {
+                        --ip;
+                        --ref;
+                    }
+
+                    auto matchLength = (size_t) minMatch;
+
+                    while (ip + matchLength < matchEndLimit && ip[matchLength] == ref[matchLength])
+                        ++matchLength;
+
+                    if (! writeSequence (op, dstEnd, anchor, (size_t) (ip - anchor), (int) (ip - ref), matchLength))
+                        return 0;
+
+                    ip += matchLength;
+                    anchor = ip;
+
+                    if (ip - 2 > src && ip < matchStartLimit)
+                        table[hash (read32 (ip - 2))] = (uint32) (ip - 2 - src);
+                }
+            }
+
+            if (! writeSequence (op, dstEnd, anchor, (size_t) (srcEnd - anchor), 0, 0))
+                return 0;
+
+            return (size_t) (op - dst);
+        }
+
+        bool decompressBlock (const void* source, size_t sourceSize, void* dest, size_t destSize) const override
+        {
+            auto* ip = static_cast<const uint8*> (source);
+            auto* const ipEnd = ip + sourceSize;
+            auto* const dst = static_cast<uint8*> (dest);
+            auto* op = dst;
+            auto* const opEnd = dst + destSize;
+
+            while (ip < ipEnd)
+            {
+                auto token = *ip++;
+                size_t literalLength = token >> 4;
+
+                if (! readLength (ip, ipEnd, literalLength))
+                    return false;
+
+                if (literalLength > (size_t) (ipEnd - ip) || literalLength > (size_t) (opEnd - op))
+                    return false;
+
+                memcpy (op, ip, literalLength);
+                op += literalLength;
+                ip += literalLength;
+
+                if (ip == ipEnd)
+                    break;
+
+                if (ipEnd - ip < 2)
+                    return false;
+
+                auto offset = (size_t) (ip[0] | (ip[1] << 8));
+                ip += 2;
+
+                if (offset == 0 || offset > (size_t) (op - dst))
+                    return false;
+
+                size_t matchLength = token & 15;
+
+                if (! readLength (ip, ipEnd, matchLength))
+                    return false;
+
+                matchLength += minMatch;
+
+                if (matchLength > (size_t) (opEnd - op))
+                    return false;
+
+                auto* match = op - offset;
+
+                if (offset >= matchLength)
+                {
+                    memcpy (op, match, matchLength);
+                    op += matchLength;
+                }
+                else
+                {
+                    // an overlapping match repeats the last few bytes, so has to be copied forwards
+                    for (auto* end = op + matchLength; op < end;)
+                        *op++ = *match++;
+                }
+            }
+
+            return op == opEnd;
+        }
+
+    private:
+        enum
+        {
+            minMatch            = 4,
+            numLastLiterals     = 5,
+            minInputForMatches  = 13,
+            maxOffset           = 65535,
+            hashBits            = 14,
+            hashTableSize       = 1 << hashBits
+        };
+
+        static uint32 read32 (const uint8* p) noexcept
+        {
+            uint32 v;
+            memcpy (&v, p, sizeof (v));
+            return v;
+        }
+
+        static uint32 hash (uint32 sequence) noexcept
+        {
+            return (sequence * 2654435761u) >> (32 - hashBits);
+        }
+
+        static bool readLength (const uint8*& ip, const uint8* ipEnd, size_t& length) noexcept
+        {
+            if (length != 15)
+                return true;
+
+            for (;;)
+            {
+                if (ip >= ipEnd)
+                    return false;
+
+                auto b = *ip++;
+                length += b;
+
+                if (b != 255)
+                    return true;
+            }
+        }
+
+        static void writeLength (uint8*& op, size_t length) noexcept
+        {
+            for (; length >= 255; length -= 255)
+                *op++ = 255;
+
+            *op++ = (uint8) length;
+        }
+
+        static bool writeSequence (uint8*& op, uint8* opEnd, const uint8* literals, size_t literalLength,
+                                   int offset, size_t matchLength) noexcept
+        {
+            auto needed = 1 + literalLength + literalLength / 255 + 1 + (offset != 0 ? 2 + matchLength / 255 + 1 : 0);
+
+            if (needed > (size_t) (opEnd - op))
+                return false;
+
+            auto* token = op++;
+            *token = (uint8) (jmin (literalLength, (size_t) 15) << 4);
+
+            if (literalLength >= 15)
+                writeLength (op, literalLength - 15);
+
+            memcpy (op, literals, literalLength);
+            op += literalLength;
+
+            if (offset != 0)
+            {
+                *op++ = (uint8) offset;
+                *op++ = (uint8) (offset >> 8);
+
+                auto extraLength = matchLength - minMatch;
+                *token |= (uint8) jmin (extraLength, (size_t) 15);
+
+                if (extraLength >= 15)
+                    writeLength (op, extraLength - 15);
+            }
+
+            return true;
+        }
+    };
+
+    //==============================================================================
+    static const StoredCodec storedCodec;
+    static const DeflateCodec deflateCodec;
+    static const LZ4Codec lz4Codec;
+
+    static std::atomic<const CompressionCodec*>* getRegisteredCodecs()
+    {
+        static std::atomic<const CompressionCodec*> codecs[256] {};
+        return codecs;
+    }
+}
+
+//==============================================================================
+const CompressionCodec& CompressionCodec::getStoredCodec()    { return CompressionCodecHelpers::storedCodec; }
+const CompressionCodec& CompressionCodec::getDeflateCodec()   { return CompressionCodecHelpers::deflateCodec; }
+const CompressionCodec& CompressionCodec::getLZ4Codec()       { return CompressionCodecHelpers::lz4Codec; }
+
+bool CompressionCodec::registerCodec (const CompressionCodec& codec)
+{
+    auto codecId = codec.getCodecId();
+
+    if (! isPositiveAndBelow (codecId, 256) || codecId < firstUserCodecId)
+    {
+        jassertfalse; // IDs below firstUserCodecId are reserved for the built-in codecs
+        return false;
+    }
+
+    const CompressionCodec* expected = nullptr;
+    auto& slot = CompressionCodecHelpers::getRegisteredCodecs()[codecId];
+    return slot.compare_exchange_strong (expected, &codec) || expected == &codec;
+}
+
+void CompressionCodec::unregisterCodec (const CompressionCodec& codec)
+{
+    auto codecId = codec.getCodecId();
+
+    if (isPositiveAndBelow (codecId, 256))
+    {
+        auto* expected = &codec;
+        CompressionCodecHelpers::getRegisteredCodecs()[codecId].compare_exchange_strong (expected, nullptr);
+    }
+}
+
+const CompressionCodec* CompressionCodec::findCodec (int codecId)
+{
+    switch (codecId)
+    {
+        case storedCodecId:     return &getStoredCodec();
+        case deflateCodecId:    return &getDeflateCodec();
+        case lz4CodecId:        return &getLZ4Codec();
+        default:                break;
+    }
+
+    if (isPositiveAndBelow (codecId, 256))
+        return CompressionCodecHelpers::getRegisteredCodecs()[codecId].load();
+
+    return nullptr;
+}
+
+} // namespace juce
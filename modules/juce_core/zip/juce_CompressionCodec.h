@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A block compression algorithm that can be used by CompressedOutputStream and
+    CompressedInputStream.
+
+    A codec compresses and decompresses whole blocks of memory in a single call, which
+    lets the framed streams pick a different trade-off between speed and size for each
+    call site. Three codecs are built in:
+
+    - getStoredCodec() copies the data unchanged.
+    - getDeflateCodec() uses the bundled zlib, and so compresses well but slowly.
+    - getLZ4Codec() writes the LZ4 block format. It compresses less than deflate, but is
+      many times quicker in both directions, which makes it a good choice for large
+      plugin states, thumbnails or undo data that is saved and loaded often.
+
+    Other algorithms such as zstd can be added by subclassing CompressionCodec, giving the
+    subclass an ID of firstUserCodecId or higher, and passing an instance of it to
+    registerCodec(). CompressedInputStream uses the ID stored with each block to find the
+    codec that can decode it.
+
+    Codecs must be stateless, because a single instance may be used by several threads at
+    once.
+
+    @see CompressedOutputStream, CompressedInputStream
+
+    @tags{Core}
+*/
+class JUCE_API  CompressionCodec
+{
+public:
+    /** Destructor. */
+    virtual ~CompressionCodec() = default;
+
+    //==============================================================================
+    /** The IDs of the built-in codecs. */
+    enum BuiltInCodecIds
+    {
+        storedCodecId       = 0,
+        deflateCodecId      = 1,
+        lz4CodecId          = 2,
+
+        /** IDs from here upwards are free for codecs supplied by an application. */
+        firstUserCodecId    = 16
+    };
+
+    /** Returns the ID that is stored with each block that this codec compresses. */
+    virtual int getCodecId() const = 0;
+
+    /** Returns a short human-readable name, e.g. "LZ4". */
+    virtual String getName() const = 0;
+
+    /** Returns the largest number of bytes that compressBlock() could produce for a block of the given size. */
+    virtual size_t getMaxCompressedSize (size_t sourceSize) const = 0;
+
+    /** Compresses a block of data.
+
+        @param source           the data to compress
+        @param sourceSize       the number of bytes in the source
+        @param dest             the buffer to write into
+        @param destCapacity     the size of the buffer. If this is at least getMaxCompressedSize(),
+                                the call will always succeed
+        @param compressionLevel a codec-specific level, where a higher value means a smaller result
+                                and a slower call. A negative value selects the codec's default level
+        @returns the number of bytes written to dest, or 0 if the data didn't fit
+    */
+    virtual size_t compressBlock (const void* source, size_t sourceSize,
+                             void* dest, size_t destCapacity,
+                             int compressionLevel) const = 0;
+
+    /** Decompresses a block of data.
+
+        @param source       the compressed data
+        @param sourceSize   the number of bytes of compressed data
+        @param dest         the buffer to write into
+        @param destSize     the exact size of the original, uncompressed data
+        @returns true if the data was valid and decompressed to exactly destSize bytes
+    */
+    virtual bool decompressBlock (const void* source, size_t sourceSize,
+                             void* dest, size_t destSize) const = 0;
+
+    //==============================================================================
+    /** Returns a codec that stores data without compressing it. */
+    static const CompressionCodec& getStoredCodec();
+
+    /** Returns a codec that uses zlib's deflate, with compression levels from 1 to 9. */
+    static const CompressionCodec& getDeflateCodec();
+
+    /** Returns a codec that writes the LZ4 block format.
+
+        Levels below 3 trade some compression for extra speed when the data doesn't compress
+        well, while higher levels try harder to find matches.
+    */
+    static const CompressionCodec& getLZ4Codec();
+
+    /** Makes a codec available to CompressedInputStream.
+
+        The codec object must stay alive until it has been unregistered. The built-in codecs
+        are always registered.
+
+        @returns false if the ID was out of range or was already taken by another codec
+    */
+    static bool registerCodec (const CompressionCodec& codec);
+
+    /** Removes a codec that was added with registerCodec(). */
+    static void unregisterCodec (const CompressionCodec& codec);
+
+    /** Returns the codec with the given ID, or nullptr if none is registered. */
+    static const CompressionCodec* findCodec (int codecId);
+};
+
+} // namespace juce
@@ -35,9 +35,18 @@ inline uint32 readUnalignedLittleEndianInt (const void* buffer)
     return ByteOrder::littleEndianInt (&data);
 }
 
+inline uint64 readUnalignedLittleEndianInt64 (const void* buffer)
+{
+    auto data = readUnaligned<uint64> (buffer);
+    return ByteOrder::littleEndianInt64 (&data);
+}
+
+// A 32-bit size or offset with this value means that the real value is in a Zip64 field
+static constexpr uint32 zip64Marker = 0xffffffff;
+
 struct ZipFile::ZipEntryHolder
 {
-    ZipEntryHolder (const char* buffer, int fileNameLen)
+    ZipEntryHolder (const char* buffer, int fileNameLen, int extraFieldLen)
     {
         isCompressed           = readUnalignedLittleEndianShort (buffer + 10) != 0;
         entry.fileTime         = parseFileTime (readUnalignedLittleEndianShort (buffer + 12),
@@ -51,6 +60,37 @@ struct ZipFile::ZipEntryHolder
         entry.isSymbolicLink = (fileType == 0xA);
 
         entry.filename = String::fromUTF8 (buffer + 46, fileNameLen);
+
+        readZip64ExtraField (buffer + 46 + fileNameLen, extraFieldLen);
+    }
+
+    void readZip64ExtraField (const char* extraField, int extraFieldLen)
+    {
+        for (auto* end = extraField + extraFieldLen; end - extraField >= 4;)
+        {
+            auto* data = extraField + 4;
+            auto* dataEnd = data + readUnalignedLittleEndianShort (extraField + 2);
+
+            if (dataEnd > end)
+                return;
+
+            if (readUnalignedLittleEndianShort (extraField) == 0x0001)
+            {
+                // Only the values that didn't fit into the 32-bit fields are present, in this order
+                for (auto* value : { &entry.uncompressedSize, &compressedSize, &streamOffset })
+                {
+                    if (*value == (int64) zip64Marker && dataEnd - data >= 8)
+                    {
+                        *value = (int64) readUnalignedLittleEndianInt64 (data);
+                        data += 8;
+                    }
+                }
+
+                return;
+            }
+
+            extraField = dataEnd;
+        }
     }
 
     static Time parseFileTime (uint32 time, uint32 date) noexcept
@@ -71,6 +111,25 @@ struct ZipFile::ZipEntryHolder
 };
 
 //==============================================================================
+static int64 findZip64CentralDirectory (InputStream& in, int64 endOfCentralDirectoryPos, int& numEntries)
+{
+    char buffer[56];
+
+    if (endOfCentralDirectoryPos < 20
+         || ! in.setPosition (endOfCentralDirectoryPos - 20)
+         || in.read (buffer, 20) != 20
+         || readUnalignedLittleEndianInt (buffer) != 0x07064b50)
+        return -1;
+
+    if (! in.setPosition ((int64) readUnalignedLittleEndianInt64 (buffer + 8))
+         || in.read (buffer, 56) != 56
+         || readUnalignedLittleEndianInt (buffer) != 0x06064b50)
+        return -1;
+
+    numEntries = (int) jmin ((uint64) std::numeric_limits<int>::max(), readUnalignedLittleEndianInt64 (buffer + 32));
+    return (int64) readUnalignedLittleEndianInt64 (buffer + 48);
+}
+
 static int64 findCentralDirectoryFileHeader (InputStream& input, int& numEntries)
 {
     BufferedInputStream in (input, 8192);
@@ -98,6 +157,14 @@ static int64 findCentralDirectoryFileHeader (InputStream& input, int& numEntries
                 numEntries = readUnalignedLittleEndianShort (buffer + 10);
                 auto offset = (int64) readUnalignedLittleEndianInt (buffer + 16);
 
+                if (numEntries == 0xffff || offset == (int64) zip64Marker)
+                {
+                    auto zip64Offset = findZip64CentralDirectory (in, pos + i, numEntries);
+
+                    if (zip64Offset >= 0)
+                        offset = zip64Offset;
+                }
+
                 if (offset >= 4)
                 {
                     in.setPosition (offset);
@@ -143,6 +210,24 @@ struct ZipFile::ZipInputStream final : public InputStream
           zipEntryHolder (zei),
           inputStream (zf.inputStream)
     {
+        if (zf.mappedFile != nullptr)
+        {
+            // The entry is read straight out of the mapped file, so no stream is needed
+            mappedData = static_cast<const char*> (zf.mappedFile->getData());
+            mappedSize = (int64) zf.mappedFile->getSize();
+            inputStream = nullptr;
+
+            if (isPositiveAndBelow (zei.streamOffset, mappedSize - 30)
+                 && ByteOrder::littleEndianInt (mappedData + zei.streamOffset) == 0x04034b50)
+            {
+                auto* header = mappedData + zei.streamOffset;
+                headerSize = 30 + ByteOrder::littleEndianShort (header + 26)
+                                + ByteOrder::littleEndianShort (header + 28);
+            }
+
+            return;
+        }
+
         if (zf.inputSource != nullptr)
         {
             streamToDelete.reset (file.inputSource->createInputStream());
@@ -187,6 +272,15 @@ struct ZipFile::ZipInputStream final : public InputStream
 
         howMany = (int) jmin ((int64) howMany, zipEntryHolder.compressedSize - pos);
 
+        if (mappedData != nullptr)
+        {
+            auto start = zipEntryHolder.streamOffset + headerSize + pos;
+            howMany = (int) jlimit ((int64) 0, (int64) howMany, mappedSize - start);
+            memcpy (buffer, mappedData + start, (size_t) howMany);
+            pos += howMany;
+            return howMany;
+        }
+
         if (inputStream == nullptr)
             return 0;
 
@@ -231,6 +325,8 @@ private:
     int headerSize = 0;
     InputStream* inputStream;
     std::unique_ptr<InputStream> streamToDelete;
+    const char* mappedData = nullptr;
+    int64 mappedSize = 0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZipInputStream)
 };
@@ -253,6 +349,12 @@ ZipFile::ZipFile (InputStream& stream)  : inputStream (&stream)
 
 ZipFile::ZipFile (const File& file)  : inputSource (new FileInputSource (file))
 {
+    mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+
+    // (this can fail for files too large for the address space, which will be read normally)
+    if (mappedFile->getData() == nullptr || mappedFile->getSize() == 0)
+        mappedFile.reset();
+
     init();
 }
 
@@ -354,7 +456,12 @@ void ZipFile::init()
     std::unique_ptr<InputStream> toDelete;
     InputStream* in = inputStream;
 
-    if (inputSource != nullptr)
+    if (mappedFile != nullptr)
+    {
+        in = new MemoryInputStream (mappedFile->getData(), mappedFile->getSize(), false);
+        toDelete.reset (in);
+    }
+    else if (inputSource != nullptr)
     {
         in = inputSource->createInputStream();
         toDelete.reset (in);
@@ -368,11 +475,22 @@ void ZipFile::init()
         if (centralDirectoryPos >= 0 && centralDirectoryPos < in->getTotalLength())
         {
             auto size = (size_t) (in->getTotalLength() - centralDirectoryPos);
+            const char* headerData = nullptr;
+            MemoryBlock headerDataBlock;
 
-            in->setPosition (centralDirectoryPos);
-            MemoryBlock headerData;
+            if (mappedFile != nullptr)
+            {
+                headerData = static_cast<const char*> (mappedFile->getData()) + centralDirectoryPos;
+            }
+            else
+            {
+                in->setPosition (centralDirectoryPos);
 
-            if (in->readIntoMemoryBlock (headerData, (ssize_t) size) == size)
+                if (in->readIntoMemoryBlock (headerDataBlock, (ssize_t) size) == size)
+                    headerData = static_cast<const char*> (headerDataBlock.getData());
+            }
+
+            if (headerData != nullptr)
             {
                 size_t pos = 0;
 
@@ -381,16 +499,16 @@ void ZipFile::init()
                     if (pos + 46 > size)
                         break;
 
-                    auto* buffer = static_cast<const char*> (headerData.getData()) + pos;
+                    auto* buffer = headerData + pos;
                     auto fileNameLen = readUnalignedLittleEndianShort (buffer + 28u);
+                    auto extraFieldLen = readUnalignedLittleEndianShort (buffer + 30u);
 
-                    if (pos + 46 + fileNameLen > size)
+                    if (pos + 46 + fileNameLen + extraFieldLen > size)
                         break;
 
-                    entries.add (new ZipEntryHolder (buffer, fileNameLen));
+                    entries.add (new ZipEntryHolder (buffer, fileNameLen, extraFieldLen));
 
-                    pos += 46u + fileNameLen
-                            + readUnalignedLittleEndianShort (buffer + 30u)
+                    pos += 46u + fileNameLen + extraFieldLen
                             + readUnalignedLittleEndianShort (buffer + 32u);
                 }
             }
@@ -412,6 +530,73 @@ Result ZipFile::uncompressTo (const File& targetDirectory,
     return Result::ok();
 }
 
+Result ZipFile::uncompressTo (const File& targetDirectory,
+                              const bool shouldOverwriteFiles,
+                              ThreadPool& pool)
+{
+    // Symbolic links and repeated paths can make the result depend on the order in which
+    // the entries are written, so they have to be written in order. (Paths differing only
+    // in case count as repeats, as they're the same file on some file systems)
+    std::set<String> targetPaths;
+
+    for (auto* zei : entries)
+        if (zei->entry.isSymbolicLink || ! targetPaths.insert (zei->entry.filename.replaceCharacter ('\\', '/').toLowerCase()).second)
+            return uncompressTo (targetDirectory, shouldOverwriteFiles);
+
+    // Directories are created up-front, so that the threads won't race to create them
+    Array<int> fileIndices;
+
+    for (int i = 0; i < entries.size(); ++i)
+    {
+        auto& entryPath = entries.getUnchecked (i)->entry.filename;
+
+        if (entryPath.isEmpty() || entryPath.endsWithChar ('/') || entryPath.endsWithChar ('\\'))
+        {
+            auto result = uncompressEntry (i, targetDirectory, shouldOverwriteFiles);
+
+            if (result.failed())
+                return result;
+
+            continue;
+        }
+
+        auto targetFile = targetDirectory.getChildFile (entryPath.replaceCharacter ('\\', '/'));
+        auto parentDirectory = targetFile.getParentDirectory();
+
+        if (targetFile.isAChildOf (targetDirectory) && ! hasSymbolicPart (targetDirectory, parentDirectory))
+            parentDirectory.createDirectory();
+
+        fileIndices.add (i);
+    }
+
+    // Starting with the largest entries stops one big file from being left until the end
+    std::sort (fileIndices.begin(), fileIndices.end(), [this] (int a, int b)
+    {
+        return entries.getUnchecked (a)->compressedSize > entries.getUnchecked (b)->compressedSize;
+    });
+
+    std::vector<Result> results ((size_t) fileIndices.size(), Result::ok());
+
+    parallelFor (0, fileIndices.size(), [&] (int i)
+    {
+        results[(size_t) i] = uncompressEntry (fileIndices.getUnchecked (i), targetDirectory, shouldOverwriteFiles);
+    }, 1, pool);
+
+    auto firstFailure = std::numeric_limits<int>::max();
+    auto result = Result::ok();
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        if (results[i].failed() && fileIndices.getUnchecked ((int) i) < firstFailure)
+        {
+            firstFailure = fileIndices.getUnchecked ((int) i);
+            result = results[i];
+        }
+    }
+
+    return result;
+}
+
 Result ZipFile::uncompressEntry (int index, const File& targetDirectory, bool shouldOverwriteFiles)
 {
     return uncompressEntry (index,
@@ -496,9 +681,10 @@ struct ZipFile::Builder::Item
         symbolicLink = (file.exists() && file.isSymbolicLink());
     }
 
-    bool writeData (OutputStream& target, const int64 overallStartPosition)
+    // This can be called on any thread, before writeData() is called on the writing thread
+    void compress()
     {
-        MemoryOutputStream compressedData ((size_t) file.getSize());
+        compressedData = std::make_unique<MemoryOutputStream> ((size_t) file.getSize());
 
         if (symbolicLink)
         {
@@ -507,44 +693,81 @@ struct ZipFile::Builder::Item
             uncompressedSize = relativePath.length();
 
             checksum = zlibNamespace::crc32 (0, (uint8_t*) relativePath.toRawUTF8(), (unsigned int) uncompressedSize);
-            compressedData << relativePath;
+            *compressedData << relativePath;
+            compressedOk = true;
         }
         else if (compressionLevel > 0)
         {
-            GZIPCompressorOutputStream compressor (compressedData, compressionLevel,
+            GZIPCompressorOutputStream compressor (*compressedData, compressionLevel,
                                                    GZIPCompressorOutputStream::windowBitsRaw);
-            if (! writeSource (compressor))
-                return false;
+            compressedOk = writeSource (compressor);
         }
         else
         {
-            if (! writeSource (compressedData))
-                return false;
+            compressedOk = writeSource (*compressedData);
         }
 
-        compressedSize = (int64) compressedData.getDataSize();
+        compressedSize = (int64) compressedData->getDataSize();
+    }
+
+    bool writeData (OutputStream& target, const int64 overallStartPosition)
+    {
+        if (compressedData == nullptr)
+            compress();
+
+        const std::unique_ptr<MemoryOutputStream> data (std::move (compressedData));
+
+        if (! compressedOk)
+            return false;
+
         headerStart = target.getPosition() - overallStartPosition;
 
+        const auto zip64 = needsZip64Sizes();
+
         target.writeInt (0x04034b50);
-        writeFlagsAndSizes (target);
-        target << storedPathname
-               << compressedData;
+        writeFlagsAndSizes (target, zip64 ? 20 : 0, zip64);
+        target << storedPathname;
+
+        if (zip64)
+        {
+            // The local header must contain both sizes if either of them is in the extra field
+            target.writeShort (0x0001);
+            target.writeShort (16);
+            target.writeInt64 (uncompressedSize);
+            target.writeInt64 (compressedSize);
+        }
 
+        target << *data;
         return true;
     }
 
     bool writeDirectoryEntry (OutputStream& target)
     {
+        Array<int64> zip64Values;
+
+        for (auto value : { uncompressedSize, compressedSize, headerStart })
+            if (value >= (int64) zip64Marker)
+                zip64Values.add (value);
+
         target.writeInt (0x02014b50);
         target.writeShort (symbolicLink ? 0x0314 : 0x0014);
-        writeFlagsAndSizes (target);
+        writeFlagsAndSizes (target, zip64Values.isEmpty() ? 0 : 4 + 8 * zip64Values.size(), ! zip64Values.isEmpty());
         target.writeShort (0); // comment length
         target.writeShort (0); // start disk num
         target.writeShort (0); // internal attributes
         target.writeInt ((int) (symbolicLink ? 0xA1ED0000 : 0)); // external attributes
-        target.writeInt ((int) (uint32) headerStart);
+        target.writeInt ((int) getZip32Value (headerStart));
         target << storedPathname;
 
+        if (! zip64Values.isEmpty())
+        {
+            target.writeShort (0x0001);
+            target.writeShort ((short) (8 * zip64Values.size()));
+
+            for (auto value : zip64Values)
+                target.writeInt64 (value);
+        }
+
         return true;
     }
 
@@ -556,7 +779,18 @@ private:
     int64 compressedSize = 0, uncompressedSize = 0, headerStart = 0;
     int compressionLevel = 0;
     unsigned long checksum = 0;
-    bool symbolicLink = false;
+    bool symbolicLink = false, compressedOk = false;
+    std::unique_ptr<MemoryOutputStream> compressedData;
+
+    bool needsZip64Sizes() const noexcept
+    {
+        return uncompressedSize >= (int64) zip64Marker || compressedSize >= (int64) zip64Marker;
+    }
+
+    static uint32 getZip32Value (int64 value) noexcept
+    {
+        return value >= (int64) zip64Marker ? zip64Marker : (uint32) value;
+    }
 
     static void writeTimeAndDate (OutputStream& target, Time t)
     {
@@ -595,17 +829,17 @@ private:
         return true;
     }
 
-    void writeFlagsAndSizes (OutputStream& target) const
+    void writeFlagsAndSizes (OutputStream& target, int extraFieldLength, bool usesZip64) const
     {
-        target.writeShort (10); // version needed
+        target.writeShort (usesZip64 ? 45 : 10); // version needed
         target.writeShort ((short) (1 << 11)); // this flag indicates UTF-8 filename encoding
         target.writeShort ((! symbolicLink && compressionLevel > 0) ? (short) 8 : (short) 0); //symlink target path is not compressed
         writeTimeAndDate (target, fileTime);
         target.writeInt ((int) checksum);
-        target.writeInt ((int) (uint32) compressedSize);
-        target.writeInt ((int) (uint32) uncompressedSize);
+        target.writeInt ((int) (usesZip64 && needsZip64Sizes() ? zip64Marker : (uint32) compressedSize));
+        target.writeInt ((int) (usesZip64 && needsZip64Sizes() ? zip64Marker : (uint32) uncompressedSize));
         target.writeShort (static_cast<short> (storedPathname.toUTF8().sizeInBytes() - 1));
-        target.writeShort (0); // extra field length
+        target.writeShort ((short) extraFieldLength);
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Item)
@@ -630,16 +864,37 @@ void ZipFile::Builder::addEntry (InputStream* stream, int compression, const Str
 }
 
 bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progress) const
+{
+    return writeArchive (target, progress, nullptr);
+}
+
+bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progress, ThreadPool& pool) const
+{
+    return writeArchive (target, progress, &pool);
+}
+
+bool ZipFile::Builder::writeArchive (OutputStream& target, double* const progress, ThreadPool* pool) const
 {
     auto fileStart = target.getPosition();
 
-    for (int i = 0; i < items.size(); ++i)
+    // Each group of items is compressed in parallel, then written in order
+    const auto groupSize = pool != nullptr ? (pool->getNumThreads() + 1) * 2 : 1;
+
+    for (int groupStart = 0; groupStart < items.size(); groupStart += groupSize)
     {
-        if (progress != nullptr)
-            *progress = (i + 0.5) / items.size();
+        const auto groupEnd = jmin (items.size(), groupStart + groupSize);
 
-        if (! items.getUnchecked (i)->writeData (target, fileStart))
-            return false;
+        if (pool != nullptr)
+            parallelFor (groupStart, groupEnd, [this] (int i) { items.getUnchecked (i)->compress(); }, 1, *pool);
+
+        for (int i = groupStart; i < groupEnd; ++i)
+        {
+            if (progress != nullptr)
+                *progress = (i + 0.5) / items.size();
+
+            if (! items.getUnchecked (i)->writeData (target, fileStart))
+                return false;
+        }
     }
 
     auto directoryStart = target.getPosition();
@@ -649,14 +904,36 @@ bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progre
             return false;
 
     auto directoryEnd = target.getPosition();
+    auto directorySize = directoryEnd - directoryStart;
+    auto directoryOffset = directoryStart - fileStart;
+    auto numItems = (int64) items.size();
+
+    if (numItems >= 0xffff || directorySize >= (int64) zip64Marker || directoryOffset >= (int64) zip64Marker)
+    {
+        target.writeInt (0x06064b50); // Zip64 end of central directory record
+        target.writeInt64 (44);
+        target.writeShort (45);
+        target.writeShort (45);
+        target.writeInt (0);
+        target.writeInt (0);
+        target.writeInt64 (numItems);
+        target.writeInt64 (numItems);
+        target.writeInt64 (directorySize);
+        target.writeInt64 (directoryOffset);
+
+        target.writeInt (0x07064b50); // Zip64 end of central directory locator
+        target.writeInt (0);
+        target.writeInt64 (directoryEnd - fileStart);
+        target.writeInt (1);
+    }
 
     target.writeInt (0x06054b50);
     target.writeShort (0);
     target.writeShort (0);
-    target.writeShort ((short) items.size());
-    target.writeShort ((short) items.size());
-    target.writeInt ((int) (directoryEnd - directoryStart));
-    target.writeInt ((int) (directoryStart - fileStart));
+    target.writeShort ((short) jmin (numItems, (int64) 0xffff));
+    target.writeShort ((short) jmin (numItems, (int64) 0xffff));
+    target.writeInt ((int) jmin (directorySize, (int64) zip64Marker));
+    target.writeInt ((int) jmin (directoryOffset, (int64) zip64Marker));
     target.writeShort (0);
 
     if (progress != nullptr)
@@ -676,27 +953,195 @@ struct ZIPTests final : public UnitTest
         : UnitTest ("ZIP", UnitTestCategories::compression)
     {}
 
-    static MemoryBlock createZipMemoryBlock (const StringArray& entryNames)
+    static MemoryBlock createZipMemoryBlock (const StringArray& entryNames, ThreadPool* pool = nullptr, bool varySizes = false)
     {
         ZipFile::Builder builder;
         HashMap<String, MemoryBlock> blocks;
+        const Time time (2024, 1, 2, 3, 4, 6);
 
         for (auto& entryName : entryNames)
         {
             auto& block = blocks.getReference (entryName);
             MemoryOutputStream mo (block, false);
-            mo << entryName;
+
+            mo << getExpectedContent (entryName, varySizes);
             mo.flush();
-            builder.addEntry (new MemoryInputStream (block, false), 9, entryName, Time::getCurrentTime());
+            builder.addEntry (new MemoryInputStream (block, false), 9, entryName, time);
         }
 
         MemoryBlock data;
         MemoryOutputStream mo (data, false);
-        builder.writeToStream (mo, nullptr);
+
+        if (pool != nullptr)
+            builder.writeToStream (mo, nullptr, *pool);
+        else
+            builder.writeToStream (mo, nullptr);
 
         return data;
     }
 
+    // (the parallel tests give the entries a range of different sizes)
+    static String getExpectedContent (const String& entryName, bool varySizes = true)
+    {
+        return varySizes ? String::repeatedString (entryName, (entryName.hashCode() & 255) + 1)
+                              : entryName;
+    }
+
+    // A single stored entry, with its sizes and offset in a Zip64 extra field, and
+    // a Zip64 end of central directory record
+    static MemoryBlock createZip64MemoryBlock (const String& entryName, const String& content)
+    {
+        MemoryBlock data;
+        MemoryOutputStream mo (data, false);
+        const auto crc = zlibNamespace::crc32 (0, (const uint8_t*) content.toRawUTF8(), (unsigned int) content.length());
+
+        mo.writeInt (0x04034b50);
+        mo.writeShort (45);
+        mo.writeShort (0);
+        mo.writeShort (0);
+        mo.writeInt (0);
+        mo.writeInt ((int) crc);
+        mo.writeInt (-1);
+        mo.writeInt (-1);
+        mo.writeShort ((short) entryName.length());
+        mo.writeShort (20);
+        mo << entryName;
+        mo.writeShort (1);
+        mo.writeShort (16);
+        mo.writeInt64 (content.length());
+        mo.writeInt64 (content.length());
+        mo << content;
+
+        auto directoryStart = mo.getPosition();
+        mo.writeInt (0x02014b50);
+        mo.writeShort (45);
+        mo.writeShort (45);
+        mo.writeShort (0);
+        mo.writeShort (0);
+        mo.writeInt (0);
+        mo.writeInt ((int) crc);
+        mo.writeInt (-1);
+        mo.writeInt (-1);
+        mo.writeShort ((short) entryName.length());
+        mo.writeShort (28);
+        mo.writeShort (0);
+        mo.writeShort (0);
+        mo.writeShort (0);
+        mo.writeInt (0);
+        mo.writeInt (-1);
+        mo << entryName;
+        mo.writeShort (1);
+        mo.writeShort (24);
+        mo.writeInt64 (content.length());
+        mo.writeInt64 (content.length());
+        mo.writeInt64 (0);
+
+        auto directoryEnd = mo.getPosition();
+        mo.writeInt (0x06064b50);
+        mo.writeInt64 (44);
+        mo.writeShort (45);
+        mo.writeShort (45);
+        mo.writeInt (0);
+        mo.writeInt (0);
+        mo.writeInt64 (1);
+        mo.writeInt64 (1);
+        mo.writeInt64 (directoryEnd - directoryStart);
+        mo.writeInt64 (directoryStart);
+
+        mo.writeInt (0x07064b50);
+        mo.writeInt (0);
+        mo.writeInt64 (directoryEnd);
+        mo.writeInt (1);
+
+        mo.writeInt (0x06054b50);
+        mo.writeShort (0);
+        mo.writeShort (0);
+        mo.writeShort (-1);
+        mo.writeShort (-1);
+        mo.writeInt (-1);
+        mo.writeInt (-1);
+        mo.writeShort (0);
+        mo.flush();
+
+        return data;
+    }
+
+    void runParallelTests()
+    {
+        StringArray entryNames;
+
+        for (int i = 0; i < 40; ++i)
+            entryNames.add ("folder" + String (i % 4) + "/sub" + String (i % 3) + "/entry" + String (i));
+
+        ThreadPool pool (ThreadPoolOptions{}.withNumberOfThreads (3));
+
+        beginTest ("Parallel compression");
+        {
+            auto serialData = createZipMemoryBlock (entryNames, nullptr, true);
+            auto parallelData = createZipMemoryBlock (entryNames, &pool, true);
+            expect (serialData == parallelData);
+        }
+
+        beginTest ("Parallel extraction");
+        {
+            auto data = createZipMemoryBlock (entryNames, nullptr, true);
+            MemoryInputStream mi (data, false);
+            ZipFile zip (mi);
+
+            TemporaryFile tmpDir;
+            expect (zip.uncompressTo (tmpDir.getFile(), true, pool).wasOk());
+
+            for (auto& entryName : entryNames)
+                expectEquals (tmpDir.getFile().getChildFile (entryName).loadFileAsString(), getExpectedContent (entryName));
+
+            // entries outside the target still fail, without stopping the others
+            auto badData = createZipMemoryBlock ({ "fine/a", "../escaped", "fine/b" });
+            MemoryInputStream badInput (badData, false);
+            ZipFile badZip (badInput);
+
+            TemporaryFile badDir;
+            expect (badZip.uncompressTo (badDir.getFile(), true, pool).failed());
+            expect (badDir.getFile().getChildFile ("fine/a").existsAsFile());
+            expect (badDir.getFile().getChildFile ("fine/b").existsAsFile());
+
+            tmpDir.getFile().deleteRecursively();
+            badDir.getFile().deleteRecursively();
+        }
+
+        beginTest ("Reading from a file");
+        {
+            TemporaryFile tmpFile;
+            auto data = createZipMemoryBlock (entryNames, nullptr, true);
+            expect (tmpFile.getFile().replaceWithData (data.getData(), data.getSize()));
+
+            ZipFile zip (tmpFile.getFile());
+            expectEquals (zip.getNumEntries(), entryNames.size());
+
+            for (auto& entryName : entryNames)
+            {
+                std::unique_ptr<InputStream> input (zip.createStreamForEntry (*zip.getEntry (entryName)));
+                expectEquals (input->readEntireStreamAsString(), getExpectedContent (entryName));
+            }
+        }
+
+        beginTest ("Zip64");
+        {
+            auto data = createZip64MemoryBlock ("big", "zip64 content");
+            MemoryInputStream mi (data, false);
+            ZipFile zip (mi);
+
+            expectEquals (zip.getNumEntries(), 1);
+
+            if (auto* entry = zip.getEntry (0))
+            {
+                expectEquals (entry->uncompressedSize, (int64) 13);
+
+                std::unique_ptr<InputStream> input (zip.createStreamForEntry (*entry));
+                expectEquals (input->readEntireStreamAsString(), String ("zip64 content"));
+            }
+        }
+    }
+
     void runZipSlipTest()
     {
         const std::map<String, bool> testCases = { { "a",                    true  },
@@ -761,6 +1206,8 @@ struct ZIPTests final : public UnitTest
 
         beginTest ("ZipSlip");
         runZipSlipTest();
+
+        runParallelTests();
     }
 };
 
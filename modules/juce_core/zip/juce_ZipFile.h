@@ -28,14 +28,20 @@ namespace juce
     Decodes a ZIP file from a stream.
 
     This can enumerate the items in a ZIP file and can create suitable stream objects
-    to read each one.
+    to read each one. Archives larger than 4GB, or with more than 65535 entries, are
+    supported using the Zip64 extensions.
 
     @tags{Core}
 */
 class JUCE_API  ZipFile
 {
 public:
-    /** Creates a ZipFile to read a specific file. */
+    /** Creates a ZipFile to read a specific file.
+
+        Where possible, the file is memory-mapped, so that the central directory can be
+        parsed and the entries read without any file I/O calls, and without having to
+        open a new file handle for each entry.
+    */
     explicit ZipFile (const File& file);
 
     //==============================================================================
@@ -164,6 +170,31 @@ public:
     Result uncompressTo (const File& targetDirectory,
                          bool shouldOverwriteFiles = true);
 
+    /** Uncompresses all of the files in the zip file, using several threads.
+
+        This does the same as the other version of uncompressTo(), but the entries are
+        decompressed and written in parallel, on the calling thread and the pool's threads.
+        The largest entries are started first.
+
+        Any directories are created before the files are written. If the archive contains
+        symbolic links, or more than one entry with the same path, the entries are
+        extracted one at a time and in order instead, as the order could then affect
+        the result.
+
+        If any entries fail, the other entries will still be extracted, and the result
+        will be the failure of the first one in the archive.
+
+        @param targetDirectory      the root folder to uncompress to
+        @param shouldOverwriteFiles whether to overwrite existing files with similarly-named ones
+        @param pool                 the pool whose threads should help with the work, e.g.
+                                    getDefaultParallelThreadPool()
+        @returns success if the file is successfully unzipped
+        @see parallelFor
+    */
+    Result uncompressTo (const File& targetDirectory,
+                         bool shouldOverwriteFiles,
+                         ThreadPool& pool);
+
     /** Uncompresses one of the entries from the zip file.
 
         This will expand the entry and write it in a target directory. The entry's path is used to
@@ -246,11 +277,27 @@ public:
         */
         bool writeToStream (OutputStream& target, double* progress) const;
 
+        /** Generates the zip file, compressing several entries at once on the calling thread
+            and the pool's threads.
+
+            The result is identical to the one produced by the other version of writeToStream().
+            The entries are compressed in small groups, each of which is written out before the
+            next group is started, so memory use is bounded by the size of a group rather than
+            the whole archive. Any streams passed to addEntry() must be safe to read from
+            different threads.
+
+            If the progress parameter is non-null, it will be updated with an approximate
+            progress status between 0 and 1.0
+        */
+        bool writeToStream (OutputStream& target, double* progress, ThreadPool& pool) const;
+
         //==============================================================================
     private:
         struct Item;
         OwnedArray<Item> items;
 
+        bool writeArchive (OutputStream&, double*, ThreadPool*) const;
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
     };
 
@@ -264,6 +311,7 @@ private:
     InputStream* inputStream = nullptr;
     std::unique_ptr<InputStream> streamToDelete;
     std::unique_ptr<InputSource> inputSource;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
 
    #if JUCE_DEBUG
     struct OpenStreamCounter
@@ -271,7 +319,7 @@ private:
         OpenStreamCounter() = default;
         ~OpenStreamCounter();
 
-        int numOpenStreams = 0;
+        std::atomic<int> numOpenStreams { 0 };
     };
 
     OpenStreamCounter streamCounter;
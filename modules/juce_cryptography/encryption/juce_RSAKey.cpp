@@ -34,8 +34,18 @@ RSAKey::RSAKey (const String& s)
 {
     if (s.containsChar (','))
     {
-        part1.parseString (s.upToFirstOccurrenceOf (",", false, false), 16);
-        part2.parseString (s.fromFirstOccurrenceOf (",", false, false), 16);
+        const auto tokens = StringArray::fromTokens (s, ",", {});
+
+        part1.parseString (tokens[0], 16);
+        part2.parseString (tokens[1], 16);
+
+        if (tokens.size() == 4)
+        {
+            BigInteger p, q;
+            p.parseString (tokens[2], 16);
+            q.parseString (tokens[3], 16);
+            setPrimeFactors (p, q);
+        }
     }
     else
     {
@@ -59,9 +69,66 @@ bool RSAKey::isValid() const noexcept
     return operator!= (RSAKey());
 }
 
-String RSAKey::toString() const
+String RSAKey::toString (bool includePrimeFactors) const
 {
-    return part1.toString (16) + "," + part2.toString (16);
+    auto s = part1.toString (16) + "," + part2.toString (16);
+
+    if (includePrimeFactors && primeFactors.has_value()
+         && primeFactors->exponent == part1 && primeFactors->modulus == part2)
+        s << "," << primeFactors->p.toString (16) << "," << primeFactors->q.toString (16);
+
+    return s;
+}
+
+void RSAKey::setPrimeFactors (const BigInteger& p, const BigInteger& q)
+{
+    primeFactors.reset();
+
+    if (p.isZero() || q.isZero() || p * q != part2)
+    {
+        jassertfalse;   // these aren't the factors of this key's modulus
+        return;
+    }
+
+    PrimeFactors factors;
+    factors.exponent = part1;
+    factors.modulus = part2;
+    factors.p = p;
+    factors.q = q;
+    factors.exponentModP = part1 % (p - 1);
+    factors.exponentModQ = part1 % (q - 1);
+    factors.inverseOfQModP = q;
+    factors.inverseOfQModP.inverseModulo (p);
+
+    primeFactors = std::move (factors);
+}
+
+void RSAKey::applyToChunk (BigInteger& value) const
+{
+    // A subclass may have changed the key since the factors were stored, so check that they still apply
+    if (! primeFactors.has_value() || primeFactors->exponent != part1 || primeFactors->modulus != part2)
+    {
+        value.exponentModulo (part1, part2);
+        return;
+    }
+
+    // Chinese remainder theorem: work out the result modulo each prime, then recombine them
+    const auto& f = *primeFactors;
+
+    auto resultModP = value;
+    resultModP.exponentModulo (f.exponentModP, f.p);
+
+    auto resultModQ = value;
+    resultModQ.exponentModulo (f.exponentModQ, f.q);
+
+    auto h = resultModP - resultModQ;
+    h *= f.inverseOfQModP;
+    h %= f.p;
+
+    if (h.isNegative())
+        h += f.p;
+
+    value = resultModQ + h * f.q;
 }
 
 bool RSAKey::applyToValue (BigInteger& value) const
@@ -82,7 +149,7 @@ bool RSAKey::applyToValue (BigInteger& value) const
         BigInteger remainder;
         value.divideBy (part2, remainder);
 
-        remainder.exponentModulo (part1, part2);
+        applyToChunk (remainder);
 
         result += remainder;
     }
@@ -120,6 +187,7 @@ void RSAKey::createKeyPair (RSAKey& publicKey, RSAKey& privateKey,
     BigInteger p (Primes::createProbablePrime (numBits / 2, 30, randomSeeds, numRandomSeeds / 2));
     BigInteger q (Primes::createProbablePrime (numBits - numBits / 2, 30, randomSeeds == nullptr ? nullptr : (randomSeeds + numRandomSeeds / 2), numRandomSeeds - numRandomSeeds / 2));
 
+    const BigInteger primeP (p), primeQ (q);
     const BigInteger n (p * q);
     const BigInteger m (--p * --q);
     const BigInteger e (findBestCommonDivisor (p, q));
@@ -132,6 +200,77 @@ void RSAKey::createKeyPair (RSAKey& publicKey, RSAKey& privateKey,
 
     privateKey.part1 = d;
     privateKey.part2 = n;
+
+    publicKey.primeFactors.reset();
+
+    if (primeP != primeQ)
+        privateKey.setPrimeFactors (primeP, primeQ);
+    else
+        privateKey.primeFactors.reset();
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class RSAKeyTests final : public UnitTest
+{
+public:
+    RSAKeyTests()
+        : UnitTest ("RSAKey", UnitTestCategories::cryptography)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Encoding and decoding");
+
+        Random r = getRandom();
+        const int seeds[] = { r.nextInt(), r.nextInt(), r.nextInt(), r.nextInt() };
+
+        RSAKey publicKey, privateKey;
+        RSAKey::createKeyPair (publicKey, privateKey, 1024, seeds, numElementsInArray (seeds));
+
+        expect (publicKey.isValid() && privateKey.isValid());
+        expect (RSAKey (publicKey.toString()) == publicKey);
+        expect (RSAKey (privateKey.toString()) == privateKey);
+        expect (RSAKey (privateKey.toString (true)) == privateKey);
+        expect (privateKey.toString (true).startsWith (privateKey.toString() + ","));
+        expect (publicKey.toString (true) == publicKey.toString());
+
+        // This key doesn't know the prime factors, so it'll take the slower route
+        const RSAKey privateKeyWithoutFactors (privateKey.toString());
+        const RSAKey reloadedPrivateKey (privateKey.toString (true));
+
+        for (int i = 0; i < 10; ++i)
+        {
+            BigInteger message;
+            r.fillBitsRandomly (message, 0, r.nextInt (2000) + 8);
+            message.setBit (0);
+
+            auto encoded = message;
+            expect (publicKey.applyToValue (encoded));
+
+            auto decoded = encoded;
+            expect (privateKey.applyToValue (decoded));
+            expect (decoded == message);
+
+            auto decodedWithoutFactors = encoded;
+            expect (privateKeyWithoutFactors.applyToValue (decodedWithoutFactors));
+            expect (decodedWithoutFactors == message);
+
+            auto decodedAfterReloading = encoded;
+            expect (reloadedPrivateKey.applyToValue (decodedAfterReloading));
+            expect (decodedAfterReloading == message);
+
+            auto signature = message;
+            expect (privateKey.applyToValue (signature));
+            expect (publicKey.applyToValue (signature));
+            expect (signature == message);
+        }
+    }
+};
+
+static RSAKeyTests rsaKeyTests;
+
+#endif
+
 } // namespace juce
@@ -103,7 +103,9 @@ public:
 
     /** Loads a key from an encoded string representation.
 
-        This reloads a key from a string created by the toString() method.
+        This reloads a key from a string created by the toString() method. If the string
+        also contains the key's prime factors, private key operations will use them to
+        run faster.
     */
     explicit RSAKey (const String& stringRepresentation);
 
@@ -113,8 +115,14 @@ public:
     //==============================================================================
     /** Turns the key into a string representation.
         This can be reloaded using the constructor that takes a string.
+
+        By default this is just the two comma-separated hex values that make up the key.
+        If includePrimeFactors is true and this is a private key created by createKeyPair(),
+        the modulus's two prime factors are appended, which lets applyToValue() use the
+        Chinese remainder theorem when the key is reloaded. Only do this for keys that stay
+        private, and note that other implementations may not understand the extra values.
     */
-    String toString() const;
+    String toString (bool includePrimeFactors = false) const;
 
     /** Returns true if the object is a valid key, or false if it was created by
         the default constructor.
@@ -134,6 +142,10 @@ public:
         and then try to decode it with a key that doesn't match, this method will still
         happily do its job and return true, but the result won't be what you were expecting.
         It's your responsibility to check that the result is what you wanted.
+
+        If the key knows the prime factors of its modulus (which is the case for private keys
+        made by createKeyPair()), the value is worked out using two half-size exponentiations,
+        which is around three times faster than using the whole modulus.
     */
     bool applyToValue (BigInteger& value) const;
 
@@ -164,7 +176,17 @@ protected:
 
 private:
     //==============================================================================
+    struct PrimeFactors
+    {
+        BigInteger exponent, modulus;   // the key that these values were derived from
+        BigInteger p, q, exponentModP, exponentModQ, inverseOfQModP;
+    };
+
+    std::optional<PrimeFactors> primeFactors;
+
     static BigInteger findBestCommonDivisor (const BigInteger& p, const BigInteger& q);
+    void setPrimeFactors (const BigInteger& p, const BigInteger& q);
+    void applyToChunk (BigInteger& value) const;
 
     JUCE_LEAK_DETECTOR (RSAKey)
 };
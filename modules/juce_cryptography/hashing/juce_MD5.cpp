@@ -220,6 +220,17 @@ MD5::MD5 (InputStream& input, int64 numBytesToRead)
 
 MD5::MD5 (const File& file)
 {
+    // Hashing a mapped file avoids copying its contents through a read buffer
+    const MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() != nullptr)
+    {
+        MD5Generator generator;
+        generator.processBlock (mappedFile.getData(), mappedFile.getSize());
+        generator.finish (result);
+        return;
+    }
+
     FileInputStream fin (file);
 
     if (fin.openedOk())
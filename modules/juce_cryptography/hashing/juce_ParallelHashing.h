@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::detail
+{
+
+/*  Hashes each file by constructing a HashType from it, using the calling thread and up to
+    maxNumThreads - 1 extra threads to work through the list.
+*/
+template <typename HashType>
+static Array<HashType> hashFilesInParallel (const Array<File>& files, int maxNumThreads)
+{
+    Array<HashType> results;
+    results.insertMultiple (0, HashType(), files.size());
+
+    if (maxNumThreads <= 0)
+        maxNumThreads = SystemStats::getNumCpus();
+
+    const auto numThreads = jlimit (1, jmax (1, files.size()), maxNumThreads);
+    std::atomic<int> nextIndex { 0 };
+
+    const auto hashRemainingFiles = [&]
+    {
+        for (auto i = nextIndex++; i < files.size(); i = nextIndex++)
+            results.getReference (i) = HashType (files.getReference (i));
+    };
+
+    if (numThreads == 1)
+    {
+        hashRemainingFiles();
+        return results;
+    }
+
+    WaitableEvent finished;
+    std::atomic<int> numJobsRunning { numThreads - 1 };
+    ThreadPool pool (numThreads - 1);
+
+    for (int i = 1; i < numThreads; ++i)
+    {
+        pool.addJob ([&]
+        {
+            hashRemainingFiles();
+
+            if (--numJobsRunning == 0)
+                finished.signal();
+        });
+    }
+
+    hashRemainingFiles();
+    finished.wait();
+    return results;
+}
+
+} // namespace juce::detail
@@ -26,51 +26,174 @@
 namespace juce
 {
 
-struct SHA256Processor
+//==============================================================================
+#if JUCE_SHA256_INTEL
+ #if JUCE_GCC || JUCE_CLANG
+  #define JUCE_SHA256_TARGET __attribute__ ((target ("sha,sse4.1")))
+ #else
+  #define JUCE_SHA256_TARGET
+ #endif
+
+/*  This is compiled for the SHA extensions regardless of the flags used for the rest of the
+    module, and is only called when the CPU reports that it supports them.
+*/
+namespace SHA256Hardware
 {
-    // expects 64 bytes of data
-    void processFullBlock (const void* data) noexcept
+    static bool isAvailable() noexcept
     {
-        const uint32_t constants[] =
+        static const bool available = []
         {
-            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-        };
+           #if JUCE_MSVC
+            int info[4] = {};
+            __cpuid (info, 0);
 
-        uint32_t block[16], s[8];
-        memcpy (s, state, sizeof (s));
+            if (info[0] < 7)
+                return false;
 
-        auto d = static_cast<const uint8_t*> (data);
+            __cpuid (info, 1);
+            const auto hasSSE41 = (info[2] & (1 << 19)) != 0;
 
-        for (auto& b : block)
+            __cpuidex (info, 7, 0);
+            return hasSSE41 && (info[1] & (1 << 29)) != 0;
+           #else
+            unsigned int a = 0, b = 0, c = 0, d = 0;
+
+            if (! __get_cpuid (1, &a, &b, &c, &d))
+                return false;
+
+            const auto hasSSE41 = (c & (1u << 19)) != 0;
+
+            if (! __get_cpuid_count (7, 0, &a, &b, &c, &d))
+                return false;
+
+            return hasSSE41 && (b & (1u << 29)) != 0;
+           #endif
+        }();
+
+        return available;
+    }
+
+    JUCE_SHA256_TARGET static void processBlocks (uint32_t* state, const uint8_t* data, size_t numBlocks, const uint32_t* constants) noexcept
+    {
+        const auto byteSwap = _mm_set_epi64x (0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+        // The instructions work on the state words arranged as ABEF and CDGH
+        const auto dcba = _mm_shuffle_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (state)), 0xb1);
+        const auto efgh = _mm_shuffle_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (state + 4)), 0x1b);
+        auto abef = _mm_alignr_epi8 (dcba, efgh, 8);
+        auto cdgh = _mm_blend_epi16 (efgh, dcba, 0xf0);
+
+        for (; numBlocks > 0; --numBlocks, data += 64)
         {
-            b = (uint32_t (d[0]) << 24) | (uint32_t (d[1]) << 16) | (uint32_t (d[2]) << 8) | d[3];
-            d += 4;
+            const auto previousAbef = abef;
+            const auto previousCdgh = cdgh;
+
+            __m128i w[4];
+
+            for (int i = 0; i < 4; ++i)
+                w[i] = _mm_shuffle_epi8 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (data + 16 * i)), byteSwap);
+
+            for (int i = 0; i < 16; ++i)
+            {
+                auto& words = w[i & 3];
+                const auto wk = _mm_add_epi32 (words, _mm_loadu_si128 (reinterpret_cast<const __m128i*> (constants + 4 * i)));
+                cdgh = _mm_sha256rnds2_epu32 (cdgh, abef, wk);
+                abef = _mm_sha256rnds2_epu32 (abef, cdgh, _mm_shuffle_epi32 (wk, 0x0e));
+
+                if (i < 12)
+                    words = _mm_sha256msg2_epu32 (_mm_add_epi32 (_mm_sha256msg1_epu32 (words, w[(i + 1) & 3]),
+                                                                 _mm_alignr_epi8 (w[(i + 3) & 3], w[(i + 2) & 3], 4)),
+                                                  w[(i + 3) & 3]);
+            }
+
+            abef = _mm_add_epi32 (abef, previousAbef);
+            cdgh = _mm_add_epi32 (cdgh, previousCdgh);
         }
 
-        auto convolve = [&] (uint32_t i, uint32_t j)
+        const auto feba = _mm_shuffle_epi32 (abef, 0x1b);
+        const auto dchg = _mm_shuffle_epi32 (cdgh, 0xb1);
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (state),     _mm_blend_epi16 (feba, dchg, 0xf0));
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (state + 4), _mm_alignr_epi8 (dchg, feba, 8));
+    }
+}
+
+ #undef JUCE_SHA256_TARGET
+
+#elif JUCE_SHA256_ARM
+
+/*  The ARMv8 cryptography extensions are only used when the compiler has been told that they're
+    available, so there's no need for a runtime check.
+*/
+namespace SHA256Hardware
+{
+    static bool isAvailable() noexcept  { return true; }
+
+    static void processBlocks (uint32_t* state, const uint8_t* data, size_t numBlocks, const uint32_t* constants) noexcept
+    {
+        auto abcd = vld1q_u32 (state);
+        auto efgh = vld1q_u32 (state + 4);
+
+        for (; numBlocks > 0; --numBlocks, data += 64)
         {
-            s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j]
-                                 + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15]))
-                                           : block[i]);
-            s[(3 - i) & 7] += s[(7 - i) & 7];
-            s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7]);
-        };
+            const auto previousAbcd = abcd;
+            const auto previousEfgh = efgh;
 
-        for (uint32_t j = 0; j < 64; j += 16)
-            for (uint32_t i = 0; i < 16; ++i)
-                convolve (i, j);
+            uint32x4_t w[4];
 
-        for (int i = 0; i < 8; ++i)
-            state[i] += s[i];
+            for (int i = 0; i < 4; ++i)
+                w[i] = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 16 * i)));
+
+            for (int i = 0; i < 16; ++i)
+            {
+                auto& words = w[i & 3];
+                const auto wk = vaddq_u32 (words, vld1q_u32 (constants + 4 * i));
+                const auto abcdBeforeRounds = abcd;
+                abcd = vsha256hq_u32 (abcd, efgh, wk);
+                efgh = vsha256h2q_u32 (efgh, abcdBeforeRounds, wk);
+
+                if (i < 12)
+                    words = vsha256su1q_u32 (vsha256su0q_u32 (words, w[(i + 1) & 3]), w[(i + 2) & 3], w[(i + 3) & 3]);
+            }
 
-        length += 64;
+            abcd = vaddq_u32 (abcd, previousAbcd);
+            efgh = vaddq_u32 (efgh, previousEfgh);
+        }
+
+        vst1q_u32 (state, abcd);
+        vst1q_u32 (state + 4, efgh);
+    }
+}
+
+#endif
+
+//==============================================================================
+struct SHA256Processor
+{
+    SHA256Processor() = default;
+
+    /*  Allows the hardware-accelerated code to be bypassed, so that its results can be
+        compared against the portable version.
+    */
+    explicit SHA256Processor (bool allowHardwareAcceleration) noexcept
+        : useHardware (allowHardwareAcceleration)
+    {
+    }
+
+    // expects a multiple of 64 bytes of data
+    void processBlocks (const uint8_t* data, size_t numBlocks) noexcept
+    {
+        length += (uint64_t) numBlocks * 64;
+
+       #if JUCE_SHA256_INTEL || JUCE_SHA256_ARM
+        if (useHardware && SHA256Hardware::isAvailable())
+        {
+            SHA256Hardware::processBlocks (state, data, numBlocks, constants);
+            return;
+        }
+       #endif
+
+        for (; numBlocks > 0; --numBlocks, data += 64)
+            processBlockPortably (data);
     }
 
     void processFinalBlock (const void* data, uint32_t numBytes) noexcept
@@ -93,10 +216,7 @@ struct SHA256Processor
 
         jassert (numBytes == 64 || numBytes == 128);
 
-        processFullBlock (finalBlocks);
-
-        if (numBytes > 64)
-            processFullBlock (finalBlocks + 64);
+        processBlocks (finalBlocks, numBytes / 64);
     }
 
     void copyResult (uint8_t* result) const noexcept
@@ -110,33 +230,86 @@ struct SHA256Processor
         }
     }
 
+    void processMemory (const void* data, size_t numBytes, uint8_t* result) noexcept
+    {
+        const auto numBlocks = numBytes / 64;
+        processBlocks (static_cast<const uint8_t*> (data), numBlocks);
+        processFinalBlock (static_cast<const uint8_t*> (data) + numBlocks * 64, (uint32_t) (numBytes % 64));
+        copyResult (result);
+    }
+
     void processStream (InputStream& input, int64_t numBytesToRead, uint8_t* result)
     {
         if (numBytesToRead < 0)
             numBytesToRead = std::numeric_limits<int64_t>::max();
 
+        constexpr int bufferSize = 64 * 256;
+        HeapBlock<uint8_t> buffer (bufferSize);
+
         for (;;)
         {
-            uint8_t buffer[64];
-            auto bytesRead = input.read (buffer, (int) jmin (numBytesToRead, (int64_t) sizeof (buffer)));
+            const auto bytesRead = jmax (0, input.read (buffer, (int) jmin (numBytesToRead, (int64_t) bufferSize)));
+            const auto numBlocks = (size_t) bytesRead / 64;
+            processBlocks (buffer, numBlocks);
 
-            if (bytesRead < (int) sizeof (buffer))
+            if (bytesRead < bufferSize)
             {
-                processFinalBlock (buffer, (unsigned int) bytesRead);
+                processFinalBlock (buffer + numBlocks * 64, (uint32_t) bytesRead % 64);
                 break;
             }
 
-            numBytesToRead -= (int64_t) sizeof (buffer);
-            processFullBlock (buffer);
+            numBytesToRead -= bufferSize;
         }
 
         copyResult (result);
     }
 
 private:
+    static constexpr uint32_t constants[] =
+    {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    // expects 64 bytes of data
+    void processBlockPortably (const uint8_t* d) noexcept
+    {
+        uint32_t block[16], s[8];
+        memcpy (s, state, sizeof (s));
+
+        for (auto& b : block)
+        {
+            b = (uint32_t (d[0]) << 24) | (uint32_t (d[1]) << 16) | (uint32_t (d[2]) << 8) | d[3];
+            d += 4;
+        }
+
+        auto convolve = [&] (uint32_t i, uint32_t j)
+        {
+            s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j]
+                                 + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15]))
+                                           : block[i]);
+            s[(3 - i) & 7] += s[(7 - i) & 7];
+            s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7]);
+        };
+
+        for (uint32_t j = 0; j < 64; j += 16)
+            for (uint32_t i = 0; i < 16; ++i)
+                convolve (i, j);
+
+        for (int i = 0; i < 8; ++i)
+            state[i] += s[i];
+    }
+
     uint32_t state[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
                           0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
     uint64_t length = 0;
+    bool useHardware = true;
 
     static uint32_t rotate (uint32_t x, uint32_t y) noexcept            { return (x >> y) | (x << (32 - y)); }
     static uint32_t ch  (uint32_t x, uint32_t y, uint32_t z) noexcept   { return z ^ ((y ^ z) & x); }
@@ -172,6 +345,16 @@ SHA256::SHA256 (InputStream& input, int64 numBytesToRead)
 
 SHA256::SHA256 (const File& file)
 {
+    // Hashing a mapped file avoids copying its contents through a read buffer
+    const MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() != nullptr)
+    {
+        SHA256Processor processor;
+        processor.processMemory (mappedFile.getData(), mappedFile.getSize(), result);
+        return;
+    }
+
     FileInputStream fin (file);
 
     if (fin.getStatus().wasOk())
@@ -193,9 +376,13 @@ SHA256::SHA256 (CharPointer_UTF8 utf8) noexcept
 
 void SHA256::process (const void* data, size_t numBytes)
 {
-    MemoryInputStream m (data, numBytes, false);
     SHA256Processor processor;
-    processor.processStream (m, -1, result);
+    processor.processMemory (data, numBytes, result);
+}
+
+Array<SHA256> SHA256::hashFilesInParallel (const Array<File>& files, int maxNumThreads)
+{
+    return detail::hashFilesInParallel<SHA256> (files, maxNumThreads);
 }
 
 MemoryBlock SHA256::getRawData() const
@@ -249,6 +436,72 @@ public:
         test ("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
         test ("The quick brown fox jumps over the lazy dog",  "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
         test ("The quick brown fox jumps over the lazy dog.", "ef537f25c895bfa782526529a9b63d97aa631564d5d789c2b765448c8635fb6c");
+        test ("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+        beginTest ("Hardware acceleration gives the same results as the portable version");
+        {
+            auto random = getRandom();
+            MemoryBlock data (2000);
+            random.fillBitsRandomly (data.getData(), data.getSize());
+
+            for (size_t size = 0; size <= data.getSize(); size += size < 200 ? 1 : 199)
+            {
+                uint8_t accelerated[32], portable[32];
+                SHA256Processor().processMemory (data.getData(), size, accelerated);
+                SHA256Processor (false).processMemory (data.getData(), size, portable);
+                expect (memcmp (accelerated, portable, sizeof (accelerated)) == 0);
+
+                MemoryInputStream m (data.getData(), size, false);
+                expect (SHA256 (m) == SHA256 (data.getData(), size));
+            }
+        }
+
+        beginTest ("Files can be hashed in parallel");
+        {
+            auto random = getRandom();
+            TemporaryFile temporaryDirectory;
+            const auto directory = temporaryDirectory.getFile();
+            expect (directory.createDirectory().wasOk());
+
+            Array<File> files;
+
+            for (int i = 0; i < 10; ++i)
+            {
+                MemoryBlock data ((size_t) random.nextInt (100000));
+                random.fillBitsRandomly (data.getData(), data.getSize());
+
+                const auto file = directory.getChildFile (String (i));
+                expect (file.replaceWithData (data.getData(), data.getSize()));
+                files.add (file);
+            }
+
+            files.add (directory.getChildFile ("missing"));
+
+            const auto hashes = SHA256::hashFilesInParallel (files, 4);
+            const auto xxHashes = XXHash64::hashFilesInParallel (files, 4);
+            expectEquals (hashes.size(), files.size());
+            expectEquals (xxHashes.size(), files.size());
+
+            for (int i = 0; i < files.size(); ++i)
+            {
+                MemoryBlock data;
+                files[i].loadFileAsData (data);
+
+                expect (hashes[i] == SHA256 (files[i]));
+                expect (xxHashes[i] == XXHash64 (files[i]));
+
+                if (files[i].existsAsFile())
+                {
+                    expect (hashes[i] == SHA256 (data));
+                    expect (xxHashes[i] == XXHash64 (data));
+                    expect (MD5 (files[i]) == MD5 (data));
+                }
+            }
+
+            expect (hashes.getLast() == SHA256());
+            expect (xxHashes.getLast() == XXHash64());
+            expect (directory.deleteRecursively());
+        }
     }
 };
 
@@ -75,6 +75,8 @@ public:
     /** Reads a file and generates the hash of its contents.
         If the file can't be opened, the hash will be left uninitialised (i.e. full
         of zeros).
+
+        Where possible, the file is memory-mapped rather than read through a stream.
     */
     explicit SHA256 (const File& file);
 
@@ -85,6 +87,15 @@ public:
     */
     explicit SHA256 (CharPointer_UTF8 utf8Text) noexcept;
 
+    /** Hashes a list of files, spreading the work over several threads.
+
+        The results are returned in the same order as the files. Any file that can't be
+        opened will have a hash full of zeros, as with the constructor that takes a File.
+
+        If maxNumThreads is zero or less, one thread per CPU will be used.
+    */
+    static Array<SHA256> hashFilesInParallel (const Array<File>& files, int maxNumThreads = 0);
+
     //==============================================================================
     /** Returns the hash as a 32-byte block of data. */
     MemoryBlock getRawData() const;
@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct XXHash64Processor
+{
+    // expects a multiple of 32 bytes of data
+    void processStripes (const uint8_t* data, size_t numStripes) noexcept
+    {
+        length += (uint64_t) numStripes * 32;
+
+        for (; numStripes > 0; --numStripes, data += 32)
+        {
+            accumulators[0] = round (accumulators[0], ByteOrder::littleEndianInt64 (data));
+            accumulators[1] = round (accumulators[1], ByteOrder::littleEndianInt64 (data + 8));
+            accumulators[2] = round (accumulators[2], ByteOrder::littleEndianInt64 (data + 16));
+            accumulators[3] = round (accumulators[3], ByteOrder::littleEndianInt64 (data + 24));
+        }
+    }
+
+    uint64_t processFinalBytes (const uint8_t* data, size_t numBytes) const noexcept
+    {
+        jassert (numBytes < 32);
+
+        auto h = length >= 32 ? mergeAccumulators() : prime5;
+        h += length + numBytes;
+
+        for (; numBytes >= 8; numBytes -= 8, data += 8)
+            h = rotate (h ^ round (0, ByteOrder::littleEndianInt64 (data)), 27) * prime1 + prime4;
+
+        if (numBytes >= 4)
+        {
+            h = rotate (h ^ ((uint64_t) ByteOrder::littleEndianInt (data) * prime1), 23) * prime2 + prime3;
+            numBytes -= 4;
+            data += 4;
+        }
+
+        for (; numBytes > 0; --numBytes, ++data)
+            h = rotate (h ^ (*data * prime5), 11) * prime1;
+
+        h ^= h >> 33;
+        h *= prime2;
+        h ^= h >> 29;
+        h *= prime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    uint64_t processMemory (const void* data, size_t numBytes) noexcept
+    {
+        const auto numStripes = numBytes / 32;
+        processStripes (static_cast<const uint8_t*> (data), numStripes);
+        return processFinalBytes (static_cast<const uint8_t*> (data) + numStripes * 32, numBytes % 32);
+    }
+
+    uint64_t processStream (InputStream& input, int64_t numBytesToRead)
+    {
+        if (numBytesToRead < 0)
+            numBytesToRead = std::numeric_limits<int64_t>::max();
+
+        constexpr int bufferSize = 32 * 512;
+        HeapBlock<uint8_t> buffer (bufferSize);
+
+        for (;;)
+        {
+            const auto bytesRead = jmax (0, input.read (buffer, (int) jmin (numBytesToRead, (int64_t) bufferSize)));
+            const auto numStripes = (size_t) bytesRead / 32;
+            processStripes (buffer, numStripes);
+
+            if (bytesRead < bufferSize)
+                return processFinalBytes (buffer + numStripes * 32, (size_t) bytesRead % 32);
+
+            numBytesToRead -= bufferSize;
+        }
+    }
+
+private:
+    static constexpr uint64_t prime1 = 0x9e3779b185ebca87;
+    static constexpr uint64_t prime2 = 0xc2b2ae3d27d4eb4f;
+    static constexpr uint64_t prime3 = 0x165667b19e3779f9;
+    static constexpr uint64_t prime4 = 0x85ebca77c2b2ae63;
+    static constexpr uint64_t prime5 = 0x27d4eb2f165667c5;
+
+    uint64_t accumulators[4] = { prime1 + prime2, prime2, 0, 0 - prime1 };
+    uint64_t length = 0;
+
+    static uint64_t rotate (uint64_t x, int y) noexcept              { return (x << y) | (x >> (64 - y)); }
+    static uint64_t round (uint64_t acc, uint64_t input) noexcept    { return rotate (acc + input * prime2, 31) * prime1; }
+
+    uint64_t mergeAccumulators() const noexcept
+    {
+        auto h = rotate (accumulators[0], 1) + rotate (accumulators[1], 7)
+               + rotate (accumulators[2], 12) + rotate (accumulators[3], 18);
+
+        for (auto acc : accumulators)
+            h = (h ^ round (0, acc)) * prime1 + prime4;
+
+        return h;
+    }
+};
+
+//==============================================================================
+XXHash64::XXHash64 (const MemoryBlock& data) noexcept  : XXHash64 (data.getData(), data.getSize()) {}
+
+XXHash64::XXHash64 (const void* data, size_t numBytes) noexcept
+    : hash (XXHash64Processor().processMemory (data, numBytes))
+{
+}
+
+XXHash64::XXHash64 (InputStream& input, int64 numBytesToRead)
+    : hash (XXHash64Processor().processStream (input, numBytesToRead))
+{
+}
+
+XXHash64::XXHash64 (const File& file)
+{
+    const MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() != nullptr)
+    {
+        hash = XXHash64Processor().processMemory (mappedFile.getData(), mappedFile.getSize());
+        return;
+    }
+
+    FileInputStream fin (file);
+
+    if (fin.openedOk())
+        hash = XXHash64Processor().processStream (fin, -1);
+}
+
+XXHash64::XXHash64 (CharPointer_UTF8 utf8) noexcept
+    : XXHash64 (utf8.getAddress(), utf8.getAddress() != nullptr ? utf8.sizeInBytes() - 1 : 0)
+{
+}
+
+Array<XXHash64> XXHash64::hashFilesInParallel (const Array<File>& files, int maxNumThreads)
+{
+    return detail::hashFilesInParallel<XXHash64> (files, maxNumThreads);
+}
+
+String XXHash64::toHexString() const
+{
+    return String::toHexString ((int64) hash).paddedLeft ('0', 16);
+}
+
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XXHash64Tests final : public UnitTest
+{
+public:
+    XXHash64Tests()
+        : UnitTest ("XXHash64", UnitTestCategories::cryptography)
+    {}
+
+    void test (const char* input, uint64 expected)
+    {
+        {
+            XXHash64 hash (input, strlen (input));
+            expect (hash.getHash() == expected);
+        }
+
+        {
+            CharPointer_UTF8 utf8 (input);
+            XXHash64 hash (utf8);
+            expect (hash.getHash() == expected);
+        }
+
+        {
+            MemoryInputStream m (input, strlen (input), false);
+            XXHash64 hash (m);
+            expect (hash.getHash() == expected);
+        }
+    }
+
+    void runTest() override
+    {
+        beginTest ("XXHash64");
+
+        test ("", 0xef46db3751d8e999);
+        test ("a", 0xd24ec4f1a98c6e5b);
+        test ("abc", 0x44bc2cf5ad770999);
+        test ("Nobody inspects the spammish repetition", 0xfbcea83c8a378bf1);
+        test ("The quick brown fox jumps over the lazy dog", 0x0b242d361fda71bc);
+
+        expectEquals (XXHash64 ("abc", 3).toHexString(), String ("44bc2cf5ad770999"));
+        expectEquals (XXHash64 ("", 0).toHexString(), String ("ef46db3751d8e999"));
+
+        beginTest ("Streams and memory give the same results");
+        {
+            auto random = getRandom();
+            MemoryBlock data (100000);
+            random.fillBitsRandomly (data.getData(), data.getSize());
+
+            for (auto size : { 0, 31, 32, 33, 16383, 16384, 16385, 50000, 100000 })
+            {
+                MemoryInputStream m (data.getData(), (size_t) size, false);
+                expect (XXHash64 (m) == XXHash64 (data.getData(), (size_t) size));
+
+                MemoryInputStream limited (data, false);
+                expect (XXHash64 (limited, size) == XXHash64 (data.getData(), (size_t) size));
+            }
+        }
+    }
+};
+
+static XXHash64Tests xxHash64UnitTests;
+
+#endif
+
+} // namespace juce
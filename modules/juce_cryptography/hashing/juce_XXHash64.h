@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    xxHash64 non-cryptographic hash generator.
+
+    This is much faster to calculate than SHA256 or MD5, which makes it a good choice for
+    content-addressed caches and spotting changed files. It isn't designed to resist
+    deliberate collisions though, so don't use it for anything security-related.
+
+    The results match those of the reference xxHash implementation, using a seed of zero.
+    @see SHA256, MD5
+
+    @tags{Cryptography}
+*/
+class JUCE_API  XXHash64
+{
+public:
+    //==============================================================================
+    /** Creates an empty XXHash64 object.
+        The default constructor just creates a hash of zero. (This is not equal to the
+        hash of an empty block of data).
+    */
+    XXHash64() = default;
+
+    /** Creates a copy of another XXHash64. */
+    XXHash64 (const XXHash64&) = default;
+
+    /** Copies another XXHash64. */
+    XXHash64& operator= (const XXHash64&) = default;
+
+    //==============================================================================
+    /** Creates a hash from a block of raw data. */
+    explicit XXHash64 (const MemoryBlock& data) noexcept;
+
+    /** Creates a hash from a block of raw data. */
+    XXHash64 (const void* data, size_t numBytes) noexcept;
+
+    /** Creates a hash from the contents of a stream.
+
+        This will read from the stream until the stream is exhausted, or until
+        maxBytesToRead bytes have been read. If maxBytesToRead is negative, the entire
+        stream will be read.
+    */
+    XXHash64 (InputStream& input, int64 maxBytesToRead = -1);
+
+    /** Reads a file and generates the hash of its contents.
+        If the file can't be opened, the hash will be left as zero.
+
+        Where possible, the file is memory-mapped rather than read through a stream.
+    */
+    explicit XXHash64 (const File& file);
+
+    /** Creates a hash of the characters in a UTF-8 buffer.
+        E.g.
+        @code XXHash64 hash (myString.toUTF8());
+        @endcode
+    */
+    explicit XXHash64 (CharPointer_UTF8 utf8Text) noexcept;
+
+    /** Hashes a list of files, spreading the work over several threads.
+
+        The results are returned in the same order as the files. Any file that can't be
+        opened will have a hash of zero, as with the constructor that takes a File.
+
+        If maxNumThreads is zero or less, one thread per CPU will be used.
+    */
+    static Array<XXHash64> hashFilesInParallel (const Array<File>& files, int maxNumThreads = 0);
+
+    //==============================================================================
+    /** Returns the hash value. */
+    uint64 getHash() const noexcept                         { return hash; }
+
+    /** Returns the hash as a 16-digit hex string. */
+    String toHexString() const;
+
+    //==============================================================================
+    bool operator== (const XXHash64& other) const noexcept  { return hash == other.hash; }
+    bool operator!= (const XXHash64& other) const noexcept  { return hash != other.hash; }
+
+private:
+    //==============================================================================
+    uint64 hash = 0;
+
+    // This private constructor is declared here to prevent you accidentally passing a
+    // String and having it unexpectedly call the constructor that takes a File.
+    explicit XXHash64 (const String&) = delete;
+
+    JUCE_LEAK_DETECTOR (XXHash64)
+};
+
+} // namespace juce
@@ -34,9 +34,25 @@
 
 #include "juce_cryptography.h"
 
+#if JUCE_INTEL && ! JUCE_NO_INLINE_ASM
+ #define JUCE_SHA256_INTEL 1
+ #include <immintrin.h>
+
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#elif JUCE_ARM && (defined (__ARM_FEATURE_SHA2) || defined (__ARM_FEATURE_CRYPTO))
+ #define JUCE_SHA256_ARM 1
+ #include <arm_neon.h>
+#endif
+
 #include "encryption/juce_BlowFish.cpp"
 #include "encryption/juce_Primes.cpp"
 #include "encryption/juce_RSAKey.cpp"
+#include "hashing/juce_ParallelHashing.h"
 #include "hashing/juce_MD5.cpp"
 #include "hashing/juce_SHA256.cpp"
 #include "hashing/juce_Whirlpool.cpp"
+#include "hashing/juce_XXHash64.cpp"
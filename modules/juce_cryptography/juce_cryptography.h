@@ -61,3 +61,4 @@
 #include "hashing/juce_MD5.h"
 #include "hashing/juce_SHA256.h"
 #include "hashing/juce_Whirlpool.h"
+#include "hashing/juce_XXHash64.h"
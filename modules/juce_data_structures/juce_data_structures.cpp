@@ -35,6 +35,7 @@
 #include "juce_data_structures.h"
 
 #include "values/juce_Value.cpp"
+#include "values/juce_ValueTreeSnapshot.cpp"
 #include "values/juce_ValueTree.cpp"
 #include "values/juce_ValueTreeSynchroniser.cpp"
 #include "values/juce_CachedValue.cpp"
@@ -44,6 +44,12 @@ namespace juce
     The UndoManager is a ChangeBroadcaster, so listeners can register to be told
     when actions are performed or undone.
 
+    The amount of history that's kept is limited by the sizes that the actions report
+    from UndoableAction::getSizeInUnits(). The actions that ValueTree creates report an
+    estimate of the number of bytes they're keeping alive, including any values and
+    removed subtrees, so if you're only using it with ValueTrees, the limit you set with
+    setMaxNumberOfStoredUnits() is effectively a memory budget in bytes.
+
     @see UndoableAction
 
     @tags{DataStructures}
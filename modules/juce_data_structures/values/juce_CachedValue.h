@@ -170,8 +170,8 @@ public:
 
     /** Force an update in case the referenced property has been changed from elsewhere.
 
-        Note: The CachedValue is a ValueTree::Listener and therefore will be informed of
-        changes of the referenced property anyway (and update itself). But this may happen
+        Note: The CachedValue listens to the referenced property of its ValueTree and therefore
+        will be informed of changes to it anyway (and update itself). But this may happen
         asynchronously. forceUpdateOfCachedValue() forces an update immediately.
     */
     void forceUpdateOfCachedValue();
@@ -215,7 +215,7 @@ inline CachedValue<Type>::CachedValue (ValueTree& v, const Identifier& i, UndoMa
     : targetTree (v), targetProperty (i), undoManager (um),
       defaultValue(), cachedValue (getTypedValue())
 {
-    targetTree.addListener (this);
+    targetTree.addPropertyListener (targetProperty, this);
 }
 
 template <typename Type>
@@ -223,7 +223,7 @@ inline CachedValue<Type>::CachedValue (ValueTree& v, const Identifier& i, UndoMa
     : targetTree (v), targetProperty (i), undoManager (um),
       defaultValue (defaultToUse), cachedValue (getTypedValue())
 {
-    targetTree.addListener (this);
+    targetTree.addPropertyListener (targetProperty, this);
 }
 
 template <typename Type>
@@ -289,13 +289,13 @@ inline void CachedValue<Type>::forceUpdateOfCachedValue()
 template <typename Type>
 inline void CachedValue<Type>::referToWithDefault (ValueTree& v, const Identifier& i, UndoManager* um, const Type& defaultVal)
 {
-    targetTree.removeListener (this);
+    targetTree.removePropertyListener (targetProperty, this);
     targetTree = v;
     targetProperty = i;
     undoManager = um;
     defaultValue = defaultVal;
     cachedValue = getTypedValue();
-    targetTree.addListener (this);
+    targetTree.addPropertyListener (targetProperty, this);
 }
 
 template <typename Type>
@@ -94,26 +94,132 @@ public:
             t->callListeners (listenerToExclude, fn);
     }
 
+    //==============================================================================
+    struct PropertyListenerList
+    {
+        Identifier property;
+        ListenerList<ValueTree::Listener> listeners;
+    };
+
+    // The lists are never removed once created, as one of them may be in the middle of
+    // being called. There's only ever one for each property that has been listened to.
+    ListenerList<ValueTree::Listener>* getPropertyListeners (const Identifier& property) const noexcept
+    {
+        for (auto* l : propertyListeners)
+            if (l->property == property)
+                return &(l->listeners);
+
+        return nullptr;
+    }
+
+    void addPropertyListener (const Identifier& property, ValueTree::Listener* listener)
+    {
+        if (auto* l = getPropertyListeners (property))
+            l->add (listener);
+        else
+            propertyListeners.add (new PropertyListenerList { property, {} })->listeners.add (listener);
+    }
+
+    void removePropertyListener (const Identifier& property, ValueTree::Listener* listener)
+    {
+        if (auto* l = getPropertyListeners (property))
+            l->remove (listener);
+    }
+
+    // Called whenever this node is modified. Any snapshot of a node also holds the snapshots
+    // of its children, so if this node's snapshot has gone, so have those of its parents.
+    void invalidateSnapshots() noexcept
+    {
+        for (auto* o = this; o != nullptr && o->snapshot.isValid(); o = o->parent)
+            o->snapshot = {};
+    }
+
+    // An estimate of the memory that a value, or a node and its children, is keeping
+    // alive. This is used by the undoable actions to report their sizes.
+    static int getApproximateSizeInBytes (const var& v)
+    {
+        auto size = (int) sizeof (var);
+
+        if (v.isString())
+            size += (int) v.toString().getNumBytesAsUTF8() + 16;
+        else if (auto* array = v.getArray())
+            for (auto& element : *array)
+                size += getApproximateSizeInBytes (element);
+        else if (auto* block = v.getBinaryData())
+            size += (int) block->getSize();
+        else if (auto* dynamicObject = v.getDynamicObject())
+            for (auto& p : dynamicObject->getProperties())
+                size += (int) sizeof (Identifier) + getApproximateSizeInBytes (p.value);
+
+        return size;
+    }
+
+    int getApproximateSizeInBytes() const
+    {
+        auto size = (int) sizeof (*this);
+
+        for (auto& p : properties)
+            size += (int) sizeof (Identifier) + getApproximateSizeInBytes (p.value);
+
+        for (auto* c : children)
+            size += (int) sizeof (c) + c->getApproximateSizeInBytes();
+
+        return size;
+    }
+
+    const ValueTreeSnapshot& getSnapshot()
+    {
+        if (! snapshot.isValid())
+        {
+            auto node = std::make_shared<ValueTreeSnapshot::Node>();
+            node->type = type;
+            node->properties = properties;
+
+            // arrays and objects are shared between copies of a var, so they need to be cloned
+            for (int i = 0; i < node->properties.size(); ++i)
+                if (auto* v = node->properties.getVarPointerAt (i); v->isArray() || v->isObject())
+                    *v = v->clone();
+
+            node->children.reserve ((size_t) children.size());
+
+            for (auto* c : children)
+                node->children.push_back (c->getSnapshot());
+
+            snapshot = ValueTreeSnapshot (std::move (node));
+        }
+
+        return snapshot;
+    }
+
     void sendPropertyChangeMessage (const Identifier& property, ValueTree::Listener* listenerToExclude = nullptr)
     {
+        invalidateSnapshots();
         ValueTree tree (*this);
-        callListenersForAllParents (listenerToExclude, [&] (Listener& l) { l.valueTreePropertyChanged (tree, property); });
+        auto fn = [&] (Listener& l) { l.valueTreePropertyChanged (tree, property); };
+
+        if (auto* l = getPropertyListeners (property))
+            l->callExcluding (listenerToExclude, fn);
+
+        callListenersForAllParents (listenerToExclude, fn);
     }
 
     void sendChildAddedMessage (ValueTree child)
     {
+        invalidateSnapshots();
         ValueTree tree (*this);
         callListenersForAllParents (nullptr, [&] (Listener& l) { l.valueTreeChildAdded (tree, child); });
     }
 
     void sendChildRemovedMessage (ValueTree child, int index)
     {
+        invalidateSnapshots();
         ValueTree tree (*this);
         callListenersForAllParents (nullptr, [=, &tree, &child] (Listener& l) { l.valueTreeChildRemoved (tree, child, index); });
     }
 
     void sendChildOrderChangedMessage (int oldIndex, int newIndex)
     {
+        invalidateSnapshots();
         ValueTree tree (*this);
         callListenersForAllParents (nullptr, [=, &tree] (Listener& l) { l.valueTreeChildOrderChanged (tree, oldIndex, newIndex); });
     }
@@ -444,17 +550,30 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return (int) sizeof (*this) + getApproximateSizeInBytes (newValue) + getApproximateSizeInBytes (oldValue);
         }
 
         UndoableAction* createCoalescedAction (UndoableAction* nextAction) override
         {
-            if (! (isAddingNewProperty || isDeletingProperty))
+            if (auto* next = dynamic_cast<SetPropertyAction*> (nextAction))
             {
-                if (auto* next = dynamic_cast<SetPropertyAction*> (nextAction))
-                    if (next->target == target && next->name == name
-                          && ! (next->isAddingNewProperty || next->isDeletingProperty))
+                if (next->target == target && next->name == name)
+                {
+                    // Adding and then changing a property is the same as adding it with the final value
+                    if (isAddingNewProperty && ! (next->isAddingNewProperty || next->isDeletingProperty))
+                        return new SetPropertyAction (*target, name, next->newValue, {}, true, false);
+
+                    if (! isAddingNewProperty)
+                    {
+                        // Changing and then deleting a property is the same as just deleting it
+                        if (next->isDeletingProperty)
+                            return isDeletingProperty ? nullptr
+                                                      : new SetPropertyAction (*target, name, {}, oldValue, false, true);
+
+                        // ..and deleting and then re-adding it, or changing it twice, is the same as one change
                         return new SetPropertyAction (*target, name, next->newValue, oldValue, false, false);
+                    }
+                }
             }
 
             return nullptr;
@@ -512,11 +631,17 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            // This action can end up being the only thing keeping the child alive, so it
+            // counts the whole subtree. That's measured once, as the child may be changed later.
+            if (sizeInBytes == 0)
+                sizeInBytes = (int) sizeof (*this) + child->getApproximateSizeInBytes();
+
+            return sizeInBytes;
         }
 
     private:
         const Ptr target, child;
+        int sizeInBytes = 0;
         const int childIndex;
         const bool isDeleting;
 
@@ -545,7 +670,7 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return (int) sizeof (*this);
         }
 
         UndoableAction* createCoalescedAction (UndoableAction* nextAction) override
@@ -569,7 +694,9 @@ public:
     NamedValueSet properties;
     ReferenceCountedArray<SharedObject> children;
     SortedSet<ValueTree*> valueTreesWithListeners;
+    OwnedArray<PropertyListenerList> propertyListeners;
     SharedObject* parent = nullptr;
+    ValueTreeSnapshot snapshot;
 
     JUCE_LEAK_DETECTOR (SharedObject)
 };
@@ -606,6 +733,15 @@ ValueTree& ValueTree::operator= (const ValueTree& other)
 {
     if (object != other.object)
     {
+        for (auto& l : propertyListeners)
+        {
+            if (object != nullptr)
+                object->removePropertyListener (l.property, l.listener);
+
+            if (other.object != nullptr)
+                other.object->addPropertyListener (l.property, l.listener);
+        }
+
         if (listeners.isEmpty())
         {
             object = other.object;
@@ -628,7 +764,8 @@ ValueTree& ValueTree::operator= (const ValueTree& other)
 }
 
 ValueTree::ValueTree (ValueTree&& other) noexcept
-    : object (std::move (other.object))
+    : object (std::move (other.object)),
+      propertyListeners (std::move (other.propertyListeners))
 {
     if (object != nullptr)
         object->valueTreesWithListeners.removeValue (&other);
@@ -638,6 +775,10 @@ ValueTree::~ValueTree()
 {
     if (! listeners.isEmpty() && object != nullptr)
         object->valueTreesWithListeners.removeValue (this);
+
+    if (object != nullptr)
+        for (auto& l : propertyListeners)
+            object->removePropertyListener (l.property, l.listener);
 }
 
 bool ValueTree::operator== (const ValueTree& other) const noexcept
@@ -665,6 +806,14 @@ ValueTree ValueTree::createCopy() const
     return {};
 }
 
+ValueTreeSnapshot ValueTree::createSnapshot() const
+{
+    if (object != nullptr)
+        return object->getSnapshot();
+
+    return {};
+}
+
 void ValueTree::copyPropertiesFrom (const ValueTree& source, UndoManager* undoManager)
 {
     jassert (object != nullptr || source.object == nullptr); // Trying to add properties to a null ValueTree will fail!
@@ -985,6 +1134,29 @@ void ValueTree::removeListener (Listener* listener)
         object->valueTreesWithListeners.removeValue (this);
 }
 
+void ValueTree::addPropertyListener (const Identifier& property, Listener* listener)
+{
+    if (listener != nullptr)
+    {
+        for (auto& l : propertyListeners)
+            if (l.property == property && l.listener == listener)
+                return;
+
+        propertyListeners.add ({ property, listener });
+
+        if (object != nullptr)
+            object->addPropertyListener (property, listener);
+    }
+}
+
+void ValueTree::removePropertyListener (const Identifier& property, Listener* listener)
+{
+    propertyListeners.removeIf ([&] (const PropertyListener& l) { return l.property == property && l.listener == listener; });
+
+    if (object != nullptr)
+        object->removePropertyListener (property, listener);
+}
+
 void ValueTree::sendPropertyChangeMessage (const Identifier& property)
 {
     if (object != nullptr)
@@ -1031,18 +1203,440 @@ String ValueTree::toXmlString (const XmlElement::TextFormat& format) const
     return {};
 }
 
+//==============================================================================
+/*  The compact binary format starts with an empty type name, so that older versions of
+    readFromStream() will reject it by returning an invalid tree, followed by a marker
+    byte that can't appear at that point in the original format. After a version number
+    and the size of the rest of the data comes a table of all the distinct strings used by
+    the tree, and then the tree itself, in which each type name, property name and string
+    value is written as an index into that table. All the counts, indexes and integer
+    values are written as variable-length integers.
+*/
+struct ValueTree::CompactFormat
+{
+    static constexpr uint8 headerMarker = 0xff;
+    static constexpr uint8 currentVersion = 1;
+
+    enum ValueTag : uint8
+    {
+        voidTag,
+        undefinedTag,
+        falseTag,
+        trueTag,
+        intTag,
+        int64Tag,
+        doubleTag,
+        stringTag,
+        arrayTag,
+        binaryTag
+    };
+
+    static uint64 zigZagEncode (int64 n) noexcept    { return ((uint64) n << 1) ^ (uint64) (n >> 63); }
+    static int64 zigZagDecode (uint64 n) noexcept    { return (int64) (n >> 1) ^ -(int64) (n & 1); }
+
+    static void writeVarInt (OutputStream& output, uint64 value)
+    {
+        uint8 bytes[10];
+        size_t numBytes = 0;
+
+        for (; value >= 0x80; value >>= 7)
+            bytes[numBytes++] = (uint8) (value | 0x80);
+
+        bytes[numBytes++] = (uint8) value;
+        output.write (bytes, numBytes);
+    }
+
+    //==============================================================================
+    struct Writer
+    {
+        void writeTree (const SharedObject* object)
+        {
+            if (object == nullptr)
+            {
+                writeVarInt (treeData, 0);
+                return;
+            }
+
+            writeVarInt (treeData, (uint64) getStringIndex (object->type.toString()) + 1);
+            writeVarInt (treeData, (uint64) object->properties.size());
+
+            for (int i = 0; i < object->properties.size(); ++i)
+            {
+                writeVarInt (treeData, (uint64) getStringIndex (object->properties.getName (i).toString()));
+                writeValue (*object->properties.getVarPointerAt (i));
+            }
+
+            writeVarInt (treeData, (uint64) object->children.size());
+
+            for (auto* c : object->children)
+                writeTree (c);
+        }
+
+        void writeTo (OutputStream& output)
+        {
+            MemoryOutputStream stringTable;
+            writeVarInt (stringTable, (uint64) strings.size());
+
+            for (auto& s : strings)
+            {
+                auto numBytes = s.getNumBytesAsUTF8();
+                writeVarInt (stringTable, (uint64) numBytes);
+                stringTable.write (s.toRawUTF8(), numBytes);
+            }
+
+            output.writeByte (0);
+            output.writeByte ((char) headerMarker);
+            output.writeByte ((char) currentVersion);
+            writeVarInt (output, (uint64) (stringTable.getDataSize() + treeData.getDataSize()));
+            output << stringTable << treeData;
+        }
+
+    private:
+        MemoryOutputStream treeData;
+        FlatHashMap<String, int> stringIndexes;
+        Array<String> strings;
+
+        int getStringIndex (const String& s)
+        {
+            if (auto* index = stringIndexes.find (s))
+                return *index;
+
+            strings.add (s);
+            return stringIndexes.set (s, strings.size() - 1);
+        }
+
+        void writeTag (ValueTag tag)
+        {
+            treeData.writeByte ((char) tag);
+        }
+
+        void writeValue (const var& v)
+        {
+            if (v.isVoid())            { writeTag (voidTag); }
+            else if (v.isUndefined())  { writeTag (undefinedTag); }
+            else if (v.isBool())       { writeTag ((bool) v ? trueTag : falseTag); }
+            else if (v.isInt())        { writeTag (intTag);    writeVarInt (treeData, zigZagEncode ((int) v)); }
+            else if (v.isInt64())      { writeTag (int64Tag);  writeVarInt (treeData, zigZagEncode ((int64) v)); }
+            else if (v.isDouble())     { writeTag (doubleTag); treeData.writeDouble ((double) v); }
+            else if (v.isString())     { writeTag (stringTag); writeVarInt (treeData, (uint64) getStringIndex (v.toString())); }
+            else if (auto* array = v.getArray())
+            {
+                writeTag (arrayTag);
+                writeVarInt (treeData, (uint64) array->size());
+
+                for (auto& item : *array)
+                    writeValue (item);
+            }
+            else if (auto* block = v.getBinaryData())
+            {
+                writeTag (binaryTag);
+                writeVarInt (treeData, (uint64) block->getSize());
+                treeData << *block;
+            }
+            else
+            {
+                jassertfalse; // Can't write an object or method to a stream!
+                writeTag (voidTag);
+            }
+        }
+    };
+
+    //==============================================================================
+    struct Reader
+    {
+        Reader (const void* data, size_t numBytes) noexcept
+            : position (static_cast<const uint8*> (data)), end (position + numBytes)
+        {}
+
+        ValueTree readVersionAndPayload()
+        {
+            if (position == end || *position++ != currentVersion)
+            {
+                jassertfalse;  // this data was written in a newer version of the format!
+                return {};
+            }
+
+            auto numBytes = readCount();
+
+            if (failed)
+            {
+                jassertfalse;  // trying to read corrupted data!
+                return {};
+            }
+
+            end = position + numBytes;
+            return readPayload();
+        }
+
+        ValueTree readPayload()
+        {
+            auto numStrings = readCount();
+            strings.ensureStorageAllocated ((int) numStrings);
+
+            for (size_t i = 0; i < numStrings && ! failed; ++i)
+            {
+                auto numBytes = readCount();
+
+                if (! failed)
+                {
+                    strings.add (String::fromUTF8 (reinterpret_cast<const char*> (position), (int) numBytes));
+                    position += numBytes;
+                }
+            }
+
+            identifiers.resize ((size_t) strings.size());
+            auto root = failed ? SharedObject::Ptr() : readTree();
+
+            if (failed || position != end)
+            {
+                jassertfalse;  // trying to read corrupted data!
+                return {};
+            }
+
+            return ValueTree (root);
+        }
+
+    private:
+        const uint8* position;
+        const uint8* end;
+        bool failed = false;
+
+        Array<String> strings;
+        std::vector<Identifier> identifiers;
+
+        uint64 readVarInt() noexcept
+        {
+            uint64 result = 0;
+
+            for (int shift = 0; position < end && shift < 64; shift += 7)
+            {
+                auto byte = *position++;
+                result |= (uint64) (byte & 0x7f) << shift;
+
+                if (byte < 0x80)
+                    return result;
+            }
+
+            failed = true;
+            return 0;
+        }
+
+        // reads a number of items or bytes, which can't be more than the number of bytes left
+        size_t readCount() noexcept
+        {
+            auto count = readVarInt();
+
+            if (count > (uint64) (end - position))
+            {
+                failed = true;
+                return 0;
+            }
+
+            return (size_t) count;
+        }
+
+        const String* readString() noexcept
+        {
+            auto index = readVarInt();
+
+            if (index >= (uint64) strings.size())
+            {
+                failed = true;
+                return nullptr;
+            }
+
+            return &strings.getReference ((int) index);
+        }
+
+        const Identifier* getIdentifier (uint64 index)
+        {
+            if (index >= (uint64) strings.size() || strings.getReference ((int) index).isEmpty())
+            {
+                failed = true;
+                return nullptr;
+            }
+
+            // each distinct name only needs to be looked up in the string pool once
+            auto& identifier = identifiers[(size_t) index];
+
+            if (identifier.isNull())
+                identifier = Identifier (strings.getReference ((int) index));
+
+            return &identifier;
+        }
+
+        SharedObject::Ptr readTree()
+        {
+            auto typeIndex = readVarInt();
+
+            if (typeIndex == 0)
+                return {};
+
+            auto* type = getIdentifier (typeIndex - 1);
+
+            if (type == nullptr)
+                return {};
+
+            SharedObject::Ptr object (new SharedObject (*type));
+
+            for (auto numProperties = readCount(); numProperties > 0 && ! failed; --numProperties)
+                if (auto* name = getIdentifier (readVarInt()))
+                    object->properties.set (*name, readValue());
+
+            auto numChildren = readCount();
+            object->children.ensureStorageAllocated ((int) numChildren);
+
+            for (; numChildren > 0 && ! failed; --numChildren)
+            {
+                auto child = readTree();
+
+                if (child == nullptr)
+                {
+                    failed = true;
+                    break;
+                }
+
+                object->children.add (child);
+                child->parent = object.get();
+            }
+
+            return object;
+        }
+
+        var readValue()
+        {
+            if (position >= end)
+            {
+                failed = true;
+                return {};
+            }
+
+            switch (*position++)
+            {
+                case voidTag:       return {};
+                case undefinedTag:  return var::undefined();
+                case falseTag:      return false;
+                case trueTag:       return true;
+                case intTag:        return (int) zigZagDecode (readVarInt());
+                case int64Tag:      return zigZagDecode (readVarInt());
+
+                case doubleTag:
+                {
+                    if (end - position < 8)
+                        break;
+
+                    auto bits = ByteOrder::littleEndianInt64 (position);
+                    position += 8;
+
+                    double result;
+                    std::memcpy (&result, &bits, sizeof (result));
+                    return result;
+                }
+
+                case stringTag:
+                {
+                    if (auto* s = readString())
+                        return *s;
+
+                    return {};
+                }
+
+                case arrayTag:
+                {
+                    Array<var> array;
+                    auto numItems = readCount();
+                    array.ensureStorageAllocated ((int) numItems);
+
+                    for (; numItems > 0 && ! failed; --numItems)
+                        array.add (readValue());
+
+                    return array;
+                }
+
+                case binaryTag:
+                {
+                    auto numBytes = readCount();
+                    var result (position, numBytes);
+                    position += numBytes;
+                    return result;
+                }
+
+                default:
+                    break;
+            }
+
+            failed = true;
+            return {};
+        }
+    };
+
+    //==============================================================================
+    // reads the data that follows the header marker
+    static ValueTree read (const void* data, size_t numBytes)
+    {
+        return Reader (data, numBytes).readVersionAndPayload();
+    }
+
+    // reads the data that follows the header marker
+    static ValueTree read (InputStream& input)
+    {
+        if ((uint8) input.readByte() != currentVersion)
+        {
+            jassertfalse;  // this data was written in a newer version of the format!
+            return {};
+        }
+
+        uint64 numBytes = 0;
+
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            auto byte = (uint8) input.readByte();
+            numBytes |= (uint64) (byte & 0x7f) << shift;
+
+            if (byte < 0x80)
+                break;
+        }
+
+        MemoryBlock payload;
+
+        if (numBytes > (uint64) std::numeric_limits<ssize_t>::max()
+             || input.readIntoMemoryBlock (payload, (ssize_t) numBytes) != (size_t) numBytes)
+        {
+            jassertfalse;  // trying to read corrupted data!
+            return {};
+        }
+
+        return Reader (payload.getData(), payload.getSize()).readPayload();
+    }
+};
+
 //==============================================================================
 void ValueTree::writeToStream (OutputStream& output) const
 {
     SharedObject::writeObjectToStream (output, object.get());
 }
 
+void ValueTree::writeToCompactStream (OutputStream& output) const
+{
+    CompactFormat::Writer writer;
+    writer.writeTree (object.get());
+    writer.writeTo (output);
+}
+
 ValueTree ValueTree::readFromStream (InputStream& input)
 {
     auto type = input.readString();
 
     if (type.isEmpty())
+    {
+        // an empty type is either the start of the compact format, or a null tree, which
+        // is followed by two zero bytes
+        if ((uint8) input.readByte() == CompactFormat::headerMarker)
+            return CompactFormat::read (input);
+
+        input.readByte();
         return {};
+    }
 
     ValueTree v (type);
 
@@ -1083,6 +1677,12 @@ ValueTree ValueTree::readFromStream (InputStream& input)
 
 ValueTree ValueTree::readFromData (const void* data, size_t numBytes)
 {
+    auto* bytes = static_cast<const uint8*> (data);
+
+    // data in the compact format can be read in place, without copying it
+    if (numBytes > 2 && bytes[0] == 0 && bytes[1] == CompactFormat::headerMarker)
+        return CompactFormat::read (bytes + 2, numBytes - 2);
+
     MemoryInputStream in (data, numBytes, false);
     return readFromStream (in);
 }
@@ -1094,6 +1694,19 @@ ValueTree ValueTree::readFromGZIPData (const void* data, size_t numBytes)
     return readFromStream (gzipStream);
 }
 
+ValueTree ValueTree::readFromCompressedData (const void* data, size_t numBytes)
+{
+    if (! CompressedInputStream::isCompressedData (data, numBytes))
+        return readFromGZIPData (data, numBytes);
+
+    MemoryBlock decompressed;
+
+    if (! CompressedInputStream::decompressData (data, numBytes, decompressed))
+        return {};
+
+    return readFromData (decompressed.getData(), decompressed.getSize());
+}
+
 void ValueTree::Listener::valueTreePropertyChanged   (ValueTree&, const Identifier&) {}
 void ValueTree::Listener::valueTreeChildAdded        (ValueTree&, ValueTree&)        {}
 void ValueTree::Listener::valueTreeChildRemoved      (ValueTree&, ValueTree&, int)   {}
@@ -1205,6 +1818,14 @@ public:
                     v1.writeToStream (zippedOut);
                 }
                 expect (v1.isEquivalentTo (ValueTree::readFromGZIPData (zipped.getData(), zipped.getDataSize())));
+                expect (v1.isEquivalentTo (ValueTree::readFromCompressedData (zipped.getData(), zipped.getDataSize())));
+
+                MemoryOutputStream compressed;
+                {
+                    CompressedOutputStream compressedOut (compressed);
+                    v1.writeToCompactStream (compressedOut);
+                }
+                expect (v1.isEquivalentTo (ValueTree::readFromCompressedData (compressed.getData(), compressed.getDataSize())));
 
                 auto xml1 = v1.createXml();
                 auto xml2 = v2.createCopy().createXml();
@@ -1215,6 +1836,67 @@ public:
             }
         }
 
+        {
+            beginTest ("Compact binary format");
+
+            auto r = getRandom();
+
+            for (int i = 10; --i >= 0;)
+            {
+                auto v1 = createRandomTree (nullptr, 0, r);
+
+                MemoryOutputStream compact;
+                v1.writeToCompactStream (compact);
+                compact.writeInt (1234);
+                expect (v1.isEquivalentTo (ValueTree::readFromData (compact.getData(), compact.getDataSize() - 4)));
+
+                MemoryInputStream mi (compact.getData(), compact.getDataSize(), false);
+                expect (v1.isEquivalentTo (ValueTree::readFromStream (mi)));
+                expectEquals (mi.readInt(), 1234);
+
+                MemoryOutputStream zipped;
+                {
+                    GZIPCompressorOutputStream zippedOut (zipped);
+                    v1.writeToCompactStream (zippedOut);
+                }
+                expect (v1.isEquivalentTo (ValueTree::readFromGZIPData (zipped.getData(), zipped.getDataSize())));
+            }
+
+            ValueTree v ("root");
+            v.setProperty ("undefined", var::undefined(), nullptr);
+            v.setProperty ("int64", (int64) -1234567890123456789LL, nullptr);
+            v.setProperty ("double", -0.1, nullptr);
+            v.setProperty ("array", Array<var> { 1, "root", Array<var> { false } }, nullptr);
+            v.setProperty ("binary", var ("\x00\xff", 2), nullptr);
+
+            for (int i = 0; i < 100; ++i)
+                v.appendChild (ValueTree ("child", { { "root", i }, { "name", "child" } }), nullptr);
+
+            MemoryOutputStream compact, original;
+            v.writeToCompactStream (compact);
+            v.writeToStream (original);
+            expect (compact.getDataSize() * 3 < original.getDataSize());
+
+            auto v2 = ValueTree::readFromData (compact.getData(), compact.getDataSize());
+            expect (v.isEquivalentTo (v2));
+            expect (v2["int64"].isInt64());
+            expect (v2["double"].isDouble());
+            expect (v2["undefined"].isUndefined());
+
+            for (auto& tree : { ValueTree(), ValueTree ("empty") })
+            {
+                MemoryOutputStream mo;
+                tree.writeToCompactStream (mo);
+                tree.writeToStream (mo);
+                mo.writeInt (5678);
+
+                MemoryInputStream mi (mo.getData(), mo.getDataSize(), false);
+                expect (tree.isEquivalentTo (ValueTree::readFromStream (mi)));
+                expect (tree.isEquivalentTo (ValueTree::readFromStream (mi)));
+                expectEquals (mi.readInt(), 5678);
+            }
+        }
+
         {
             beginTest ("Float formatting");
 
@@ -1247,6 +1929,89 @@ public:
                 expectEquals (lines[numLines - 1], "<Test number=\"" + test.second + "\"/>");
             }
         }
+
+        {
+            beginTest ("Undo history");
+
+            UndoManager undoManager;
+            ValueTree tree ("root", { { "existing", 1 } });
+
+            tree.setProperty ("added", 1, &undoManager);
+            tree.setProperty ("added", 2, &undoManager);
+            tree.setProperty ("existing", 2, &undoManager);
+            tree.setProperty ("existing", 3, &undoManager);
+            tree.removeProperty ("existing", &undoManager);
+            expectEquals (undoManager.getNumActionsInCurrentTransaction(), 2);
+
+            undoManager.undo();
+            expect (! tree.hasProperty ("added"));
+            expectEquals ((int) tree["existing"], 1);
+
+            undoManager.redo();
+            expectEquals ((int) tree["added"], 2);
+            expect (! tree.hasProperty ("existing"));
+
+            undoManager.clearUndoHistory();
+            tree.setProperty ("text", String::repeatedString ("x", 10000), &undoManager);
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() > 10000);
+
+            undoManager.beginNewTransaction();
+            ValueTree child ("child", { { "data", String::repeatedString ("y", 5000) } });
+            tree.appendChild (child, &undoManager);
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() > 15000);
+        }
+
+        {
+            beginTest ("Property listeners");
+
+            struct Counter final : public ValueTree::Listener
+            {
+                void valueTreePropertyChanged (ValueTree&, const Identifier& property) override
+                {
+                    changes.add (property.toString());
+                }
+
+                void valueTreeChildAdded (ValueTree&, ValueTree&) override   { changes.add ("child"); }
+
+                StringArray changes;
+            };
+
+            ValueTree root ("root"), child ("child");
+            root.addChild (child, -1, nullptr);
+
+            Counter counter;
+
+            {
+                ValueTree handle (child);
+                handle.addPropertyListener ("a", &counter);
+
+                child.setProperty ("a", 1, nullptr);
+                child.setProperty ("b", 2, nullptr);
+                root.setProperty ("a", 3, nullptr);
+                child.addChild (ValueTree ("grandchild"), -1, nullptr);
+                child.removeProperty ("a", nullptr);
+                child.setPropertyExcludingListener (&counter, "a", 4, nullptr);
+                expectEquals (counter.changes.joinIntoString (","), String ("a,a"));
+
+                ValueTree moved (std::move (handle));
+                child.setProperty ("a", 5, nullptr);
+                expectEquals (counter.changes.size(), 3);
+
+                moved = root;
+                child.setProperty ("a", 6, nullptr);
+                root.setProperty ("a", 7, nullptr);
+                expectEquals (counter.changes.size(), 4);
+            }
+
+            root.setProperty ("a", 8, nullptr);
+            expectEquals (counter.changes.size(), 4);
+
+            ValueTree handle (root);
+            handle.addPropertyListener ("a", &counter);
+            handle.removePropertyListener ("a", &counter);
+            root.setProperty ("a", 9, nullptr);
+            expectEquals (counter.changes.size(), 4);
+        }
     }
 };
 
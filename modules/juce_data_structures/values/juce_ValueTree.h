@@ -26,6 +26,8 @@
 namespace juce
 {
 
+class ValueTreeSnapshot;
+
 //==============================================================================
 /**
     A powerful tree structure that can be used to hold free-form data, and which can
@@ -178,6 +180,17 @@ public:
     /** Returns a deep copy of this tree and all its sub-trees. */
     ValueTree createCopy() const;
 
+    /** Returns an immutable copy of this tree and all its sub-trees, which can be read
+        from any thread.
+
+        This must be called on the thread that's making changes to the tree. Parts of
+        the tree that haven't changed since the last snapshot was made are shared with
+        that snapshot rather than being copied again.
+
+        @see ValueTreeSnapshot
+    */
+    ValueTreeSnapshot createSnapshot() const;
+
     /** Overwrites all the properties in this tree with the properties of the source tree.
         Any properties that already exist will be updated; and new ones will be added, and
         any that are not present in the source tree will be removed.
@@ -460,17 +473,43 @@ public:
     */
     void writeToStream (OutputStream& output) const;
 
-    /** Reloads a tree from a stream that was written with writeToStream(). */
+    /** Stores this tree (and all its children) in a compact binary format.
+
+        Each distinct type name, property name and string value is only written once, in a
+        table at the start of the data, and numbers are written as variable-length integers.
+        For a large tree in which the same names appear over and over again, this makes the
+        data much smaller than the format used by writeToStream(), and much quicker to load,
+        because each name only has to be turned into an Identifier once.
+
+        The data can be read back with readFromStream(), readFromData() or readFromGZIPData(),
+        which can all tell the two formats apart. Versions of JUCE from before this format was
+        added will fail to read it, and return an invalid tree.
+    */
+    void writeToCompactStream (OutputStream& output) const;
+
+    /** Reloads a tree from a stream that was written with writeToStream() or writeToCompactStream(). */
     static ValueTree readFromStream (InputStream& input);
 
-    /** Reloads a tree from a data block that was written with writeToStream(). */
+    /** Reloads a tree from a data block that was written with writeToStream() or writeToCompactStream().
+
+        Data in the compact format is read straight from the block, so this is the quickest way
+        to load a large tree, e.g. from a MemoryMappedFile.
+    */
     static ValueTree readFromData (const void* data, size_t numBytes);
 
-    /** Reloads a tree from a data block that was written with writeToStream() and
-        then zipped using GZIPCompressorOutputStream.
+    /** Reloads a tree from a data block that was written with writeToStream() or writeToCompactStream(),
+        and then zipped using GZIPCompressorOutputStream.
     */
     static ValueTree readFromGZIPData (const void* data, size_t numBytes);
 
+    /** Reloads a tree from a data block that was written with writeToStream() or writeToCompactStream(),
+        and then compressed using either a CompressedOutputStream or a GZIPCompressorOutputStream.
+
+        Writing the tree through a CompressedOutputStream that uses the LZ4 codec is much quicker to
+        save and load than gzip, which makes it a good fit for large states that are stored often.
+    */
+    static ValueTree readFromCompressedData (const void* data, size_t numBytes);
+
     //==============================================================================
     /** Listener class for events that happen to a ValueTree.
 
@@ -556,6 +595,25 @@ public:
     /** Removes a listener that was previously added with addListener(). */
     void removeListener (Listener* listener);
 
+    /** Adds a listener that is only told about changes to one particular property of this tree.
+
+        Every change to a tree, or to any of its children, is passed to all the listeners that
+        were added with addListener() to that tree and all its parents. When there are lots of
+        them, e.g. a CachedValue for each property of a large tree, that gets slow. A listener
+        added with this method is instead looked up by the name of the property that changed,
+        and will only have its Listener::valueTreePropertyChanged() method called, for changes
+        to that property of this tree - not of its children.
+
+        As with addListener(), the listener belongs to this specific ValueTree object, and will
+        start listening to the new tree if operator= is used to make it refer to a different one.
+
+        @see removePropertyListener
+    */
+    void addPropertyListener (const Identifier& property, Listener* listener);
+
+    /** Removes a listener that was previously added with addPropertyListener(). */
+    void removePropertyListener (const Identifier& property, Listener* listener);
+
     /** Changes a named property of the tree, but will not notify a specified listener of the change.
         @see setProperty
     */
@@ -618,8 +676,17 @@ private:
     //==============================================================================
     friend class SharedObject;
 
+    struct CompactFormat;
+
+    struct PropertyListener
+    {
+        Identifier property;
+        Listener* listener;
+    };
+
     ReferenceCountedObjectPtr<SharedObject> object;
     ListenerList<Listener> listeners;
+    Array<PropertyListener> propertyListeners;
 
     template <typename ElementComparator>
     struct ComparatorAdapter
@@ -0,0 +1,302 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ValueTreeSnapshot::Node
+{
+    Identifier type;
+    NamedValueSet properties;
+    std::vector<ValueTreeSnapshot> children;
+};
+
+static const ValueTreeSnapshot& getInvalidValueTreeSnapshot() noexcept
+{
+    static const ValueTreeSnapshot invalid;
+    return invalid;
+}
+
+//==============================================================================
+bool ValueTreeSnapshot::isEquivalentTo (const ValueTreeSnapshot& other) const
+{
+    if (node == other.node)
+        return true;
+
+    if (node == nullptr || other.node == nullptr
+         || node->type != other.node->type
+         || node->properties != other.node->properties
+         || node->children.size() != other.node->children.size())
+        return false;
+
+    for (size_t i = 0; i < node->children.size(); ++i)
+        if (! node->children[i].isEquivalentTo (other.node->children[i]))
+            return false;
+
+    return true;
+}
+
+Identifier ValueTreeSnapshot::getType() const noexcept
+{
+    return node != nullptr ? node->type : Identifier();
+}
+
+bool ValueTreeSnapshot::hasType (const Identifier& typeName) const noexcept
+{
+    return node != nullptr && node->type == typeName;
+}
+
+int ValueTreeSnapshot::getNumProperties() const noexcept
+{
+    return node != nullptr ? node->properties.size() : 0;
+}
+
+Identifier ValueTreeSnapshot::getPropertyName (int index) const noexcept
+{
+    return node != nullptr ? node->properties.getName (index) : Identifier();
+}
+
+bool ValueTreeSnapshot::hasProperty (const Identifier& name) const noexcept
+{
+    return node != nullptr && node->properties.contains (name);
+}
+
+const var& ValueTreeSnapshot::getProperty (const Identifier& name) const noexcept
+{
+    return operator[] (name);
+}
+
+var ValueTreeSnapshot::getProperty (const Identifier& name, const var& defaultReturnValue) const
+{
+    if (auto* value = getPropertyPointer (name))
+        return *value;
+
+    return defaultReturnValue;
+}
+
+const var* ValueTreeSnapshot::getPropertyPointer (const Identifier& name) const noexcept
+{
+    return node != nullptr ? node->properties.getVarPointer (name) : nullptr;
+}
+
+const var& ValueTreeSnapshot::operator[] (const Identifier& name) const noexcept
+{
+    if (node != nullptr)
+        return node->properties[name];
+
+    static const var nullVar;
+    return nullVar;
+}
+
+int ValueTreeSnapshot::getNumChildren() const noexcept
+{
+    return node != nullptr ? (int) node->children.size() : 0;
+}
+
+const ValueTreeSnapshot& ValueTreeSnapshot::getChild (int index) const noexcept
+{
+    if (isPositiveAndBelow (index, getNumChildren()))
+        return node->children[(size_t) index];
+
+    return getInvalidValueTreeSnapshot();
+}
+
+const ValueTreeSnapshot& ValueTreeSnapshot::getChildWithName (const Identifier& typeToMatch) const noexcept
+{
+    for (auto& child : *this)
+        if (child.hasType (typeToMatch))
+            return child;
+
+    return getInvalidValueTreeSnapshot();
+}
+
+const ValueTreeSnapshot& ValueTreeSnapshot::getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const
+{
+    for (auto& child : *this)
+        if (child[propertyName] == propertyValue)
+            return child;
+
+    return getInvalidValueTreeSnapshot();
+}
+
+const ValueTreeSnapshot* ValueTreeSnapshot::begin() const noexcept
+{
+    return node != nullptr ? node->children.data() : nullptr;
+}
+
+const ValueTreeSnapshot* ValueTreeSnapshot::end() const noexcept
+{
+    return node != nullptr ? node->children.data() + node->children.size() : nullptr;
+}
+
+ValueTree ValueTreeSnapshot::createValueTree() const
+{
+    if (node == nullptr)
+        return {};
+
+    ValueTree tree (node->type);
+
+    for (int i = 0; i < node->properties.size(); ++i)
+        tree.setProperty (node->properties.getName (i), node->properties.getValueAt (i), nullptr);
+
+    for (auto& child : node->children)
+        tree.appendChild (child.createValueTree(), nullptr);
+
+    return tree;
+}
+
+//==============================================================================
+void ValueTreeSnapshot::Publisher::publish (ValueTreeSnapshot newSnapshot)
+{
+    {
+        const SpinLock::ScopedLockType sl (lock);
+        std::swap (latest, newSnapshot);
+    }
+
+    // (the old snapshot is released here, outside the lock)
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::Publisher::getLatest() const
+{
+    const SpinLock::ScopedLockType sl (lock);
+    return latest;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeSnapshotTests final : public UnitTest
+{
+public:
+    ValueTreeSnapshotTests()
+        : UnitTest ("ValueTreeSnapshot", UnitTestCategories::values)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Snapshot contents");
+        {
+            ValueTree tree { "root", { { "a", 1 }, { "list", Array<var> { 1, 2 } } },
+                             { { "child", { { "name", "x" } } },
+                               { "other", { { "name", "y" } }, { { "grandchild", {} } } } } };
+
+            auto snapshot = tree.createSnapshot();
+            expect (snapshot.isValid());
+            expect (snapshot.hasType ("root"));
+            expectEquals (snapshot.getNumProperties(), 2);
+            expectEquals ((int) snapshot["a"], 1);
+            expect (snapshot["missing"].isVoid());
+            expectEquals ((int) snapshot.getProperty ("missing", 5), 5);
+            expectEquals (snapshot.getNumChildren(), 2);
+            expect (snapshot.getChildWithName ("other").getChild (0).hasType ("grandchild"));
+            expect (snapshot.getChildWithProperty ("name", "x") == snapshot.getChild (0));
+            expect (! snapshot.getChild (2).isValid());
+            expect (snapshot.createValueTree().isEquivalentTo (tree));
+
+            // arrays are shared between copies of a var, so changing one in place mustn't affect the snapshot
+            tree["list"].getArray()->add (3);
+            expectEquals (snapshot["list"].size(), 2);
+
+            expect (! ValueTree().createSnapshot().isValid());
+        }
+
+        beginTest ("Unchanged nodes are shared");
+        {
+            ValueTree tree ("root");
+            auto first = tree.getOrCreateChildWithName ("first", nullptr);
+            auto second = tree.getOrCreateChildWithName ("second", nullptr);
+            auto leaf = second.getOrCreateChildWithName ("leaf", nullptr);
+
+            auto s1 = tree.createSnapshot();
+            expect (tree.createSnapshot() == s1);
+
+            leaf.setProperty ("value", 1, nullptr);
+            auto s2 = tree.createSnapshot();
+            expect (s2 != s1);
+            expect (s2.getChild (0) == s1.getChild (0));
+            expect (s2.getChild (1) != s1.getChild (1));
+            expect (! s1.getChild (1).getChild (0).hasProperty ("value"));
+            expectEquals ((int) s2.getChild (1).getChild (0)["value"], 1);
+
+            UndoManager undoManager;
+            tree.removeChild (first, &undoManager);
+            auto s3 = tree.createSnapshot();
+            expectEquals (s3.getNumChildren(), 1);
+            expect (s3.getChild (0) == s2.getChild (1));
+
+            undoManager.undo();
+            expect (tree.createSnapshot().isEquivalentTo (s2));
+            expect (tree.createSnapshot() != s2);
+
+            tree.moveChild (0, 1, nullptr);
+            expect (tree.createSnapshot().getChild (0).hasType ("second"));
+
+            first.setProperty ("x", 1, nullptr);
+            first.removeProperty ("x", nullptr);
+            expect (tree.createSnapshot().isEquivalentTo (tree.createCopy().createSnapshot()));
+        }
+
+        beginTest ("Publishing to another thread");
+        {
+            ValueTree tree ("root");
+            ValueTreeSnapshot::Publisher publisher;
+            publisher.publish (tree.createSnapshot());
+
+            std::atomic<bool> finished { false }, consistent { true };
+
+            std::thread reader ([&]
+            {
+                while (! finished)
+                {
+                    auto snapshot = publisher.getLatest();
+
+                    if (snapshot["a"] != snapshot["b"] || snapshot.getNumChildren() != (int) snapshot["a"])
+                        consistent = false;
+                }
+            });
+
+            for (int i = 1; i <= 200; ++i)
+            {
+                tree.setProperty ("a", i, nullptr);
+                tree.appendChild (ValueTree ("child"), nullptr);
+                tree.setProperty ("b", i, nullptr);
+                publisher.publish (tree.createSnapshot());
+            }
+
+            finished = true;
+            reader.join();
+            expect (consistent);
+            expectEquals ((int) publisher.getLatest()["b"], 200);
+        }
+    }
+};
+
+static ValueTreeSnapshotTests valueTreeSnapshotTests;
+
+#endif
+
+} // namespace juce
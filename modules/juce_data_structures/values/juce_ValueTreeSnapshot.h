@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An immutable copy of a ValueTree, which can safely be read from any thread.
+
+    A ValueTree can only be used by one thread at a time, so handing its contents to
+    another thread, e.g. the audio thread, normally means making a complete copy of it.
+    A snapshot is created with ValueTree::createSnapshot(), and never changes after that,
+    so any number of threads can read it at once without any locking.
+
+    Snapshots share their structure: each node of a ValueTree keeps hold of the last
+    snapshot that was made of it, and only throws it away when the node or one of its
+    descendants is changed. So the first snapshot of a tree copies the whole thing, but
+    after that, creating a new one only copies the nodes that have changed since the last
+    one, along with their parents. Comparing two snapshots with operator== is a quick way
+    to find out whether anything in a sub-tree has changed.
+
+    To pass snapshots to other threads, use a ValueTreeSnapshot::Publisher, e.g.
+
+    @code
+    // on the message thread, whenever the tree has changed..
+    publisher.publish (state.createSnapshot());
+
+    // on the audio thread..
+    auto snapshot = publisher.getLatest();
+    auto gain = (float) snapshot.getChildWithName ("Mixer")["gain"];
+    @endcode
+
+    Copying a snapshot is just a matter of incrementing a reference count. Note though that
+    whichever thread releases the last reference to a node will delete it, so a realtime
+    thread should avoid being the last holder of a snapshot that has been replaced.
+
+    A snapshot doesn't know its parent, because the same node may be shared by
+    several snapshots of different versions of the tree.
+
+    @see ValueTree
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSnapshot  final
+{
+public:
+    //==============================================================================
+    /** Creates an invalid snapshot. */
+    ValueTreeSnapshot() noexcept = default;
+
+    /** Returns true if this snapshot refers to a tree. */
+    bool isValid() const noexcept                       { return node != nullptr; }
+
+    /** Returns true if both snapshots refer to the same node, which means that
+        nothing in that part of the tree had changed between the two snapshots being made.
+    */
+    bool operator== (const ValueTreeSnapshot& other) const noexcept     { return node == other.node; }
+
+    /** Returns true if the snapshots refer to different nodes. */
+    bool operator!= (const ValueTreeSnapshot& other) const noexcept     { return node != other.node; }
+
+    /** Performs a deep comparison of the two snapshots' types, properties and children. */
+    bool isEquivalentTo (const ValueTreeSnapshot& other) const;
+
+    //==============================================================================
+    /** Returns the type of the tree. */
+    Identifier getType() const noexcept;
+
+    /** Returns true if the tree has the given type. */
+    bool hasType (const Identifier& typeName) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of properties. */
+    int getNumProperties() const noexcept;
+
+    /** Returns the name of the property at the given index. */
+    Identifier getPropertyName (int index) const noexcept;
+
+    /** Returns true if the tree contains a named property. */
+    bool hasProperty (const Identifier& name) const noexcept;
+
+    /** Returns the value of a named property, or a void var if it doesn't exist. */
+    const var& getProperty (const Identifier& name) const noexcept;
+
+    /** Returns the value of a named property, or the given default if it doesn't exist. */
+    var getProperty (const Identifier& name, const var& defaultReturnValue) const;
+
+    /** Returns a pointer to the value of a named property, or nullptr if it doesn't exist. */
+    const var* getPropertyPointer (const Identifier& name) const noexcept;
+
+    /** Returns the value of a named property, or a void var if it doesn't exist. */
+    const var& operator[] (const Identifier& name) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of child trees. */
+    int getNumChildren() const noexcept;
+
+    /** Returns one of the child trees, or an invalid snapshot if the index is out of range. */
+    const ValueTreeSnapshot& getChild (int index) const noexcept;
+
+    /** Returns the first child with the given type, or an invalid snapshot if there isn't one. */
+    const ValueTreeSnapshot& getChildWithName (const Identifier& type) const noexcept;
+
+    /** Returns the first child with a property that has the given value, or an invalid
+        snapshot if there isn't one.
+    */
+    const ValueTreeSnapshot& getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const;
+
+    /** Iterates the child trees. */
+    const ValueTreeSnapshot* begin() const noexcept;
+
+    /** Iterates the child trees. */
+    const ValueTreeSnapshot* end() const noexcept;
+
+    //==============================================================================
+    /** Creates a new ValueTree containing a deep copy of this snapshot. */
+    ValueTree createValueTree() const;
+
+    //==============================================================================
+    class Publisher;
+
+private:
+    //==============================================================================
+    struct Node;
+    friend class ValueTree;
+
+    std::shared_ptr<const Node> node;
+
+    explicit ValueTreeSnapshot (std::shared_ptr<const Node> n) noexcept  : node (std::move (n)) {}
+};
+
+//==============================================================================
+/**
+    Holds the most recent snapshot of a tree, so that it can be handed from the thread
+    that edits the tree to any number of reader threads.
+
+    The publisher only takes a lock for the time it takes to swap or copy a pointer, so
+    getLatest() can safely be called from a realtime thread.
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSnapshot::Publisher
+{
+public:
+    /** Creates a publisher that holds an invalid snapshot. */
+    Publisher() = default;
+
+    /** Replaces the snapshot that getLatest() returns. */
+    void publish (ValueTreeSnapshot newSnapshot);
+
+    /** Returns the snapshot that was most recently published. */
+    ValueTreeSnapshot getLatest() const;
+
+private:
+    mutable SpinLock lock;
+    ValueTreeSnapshot latest;
+
+    JUCE_DECLARE_NON_COPYABLE (Publisher)
+};
+
+} // namespace juce
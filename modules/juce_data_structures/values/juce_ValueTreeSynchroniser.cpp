@@ -35,7 +35,8 @@ namespace ValueTreeSynchroniserHelpers
         childAdded       = 3,
         childRemoved     = 4,
         childMoved       = 5,
-        propertyRemoved  = 6
+        propertyRemoved  = 6,
+        batch            = 7
     };
 
     static void getValueTreePath (ValueTree v, const ValueTree& topLevelTree, Array<int>& path)
@@ -57,20 +58,24 @@ namespace ValueTreeSynchroniserHelpers
         stream.writeByte ((char) type);
     }
 
-    static void writeHeader (ValueTreeSynchroniser& target, MemoryOutputStream& stream,
-                             ChangeType type, ValueTree v)
+    static void writeHeader (MemoryOutputStream& stream, ChangeType type, const Array<int>& path)
     {
         writeHeader (stream, type);
 
-        Array<int> path;
-        getValueTreePath (v, target.getRoot(), path);
-
         stream.writeCompressedInt (path.size());
 
         for (int i = path.size(); --i >= 0;)
             stream.writeCompressedInt (path.getUnchecked (i));
     }
 
+    static void writeHeader (ValueTreeSynchroniser& target, MemoryOutputStream& stream,
+                             ChangeType type, ValueTree v)
+    {
+        Array<int> path;
+        getValueTreePath (v, target.getRoot(), path);
+        writeHeader (stream, type, path);
+    }
+
     static ValueTree readSubTreeLocation (MemoryInputStream& input, ValueTree v)
     {
         const int numLevels = input.readCompressedInt();
@@ -90,6 +95,95 @@ namespace ValueTreeSynchroniserHelpers
 
         return v;
     }
+
+    static bool applySingleChange (ValueTree& root, MemoryInputStream& input, ChangeType type,
+                                   const Array<Identifier>* propertyNames, UndoManager* undoManager)
+    {
+        ValueTree v (readSubTreeLocation (input, root));
+
+        if (! v.isValid())
+            return false;
+
+        auto readPropertyName = [&]() -> Identifier
+        {
+            if (propertyNames == nullptr)
+                return Identifier (input.readString());
+
+            return (*propertyNames)[input.readCompressedInt()];
+        };
+
+        switch (type)
+        {
+            case propertyChanged:
+            {
+                auto property = readPropertyName();
+
+                if (! property.isValid())
+                    break;
+
+                v.setProperty (property, var::readFromStream (input), undoManager);
+                return true;
+            }
+
+            case propertyRemoved:
+            {
+                auto property = readPropertyName();
+
+                if (! property.isValid())
+                    break;
+
+                v.removeProperty (property, undoManager);
+                return true;
+            }
+
+            case childAdded:
+            {
+                const int index = input.readCompressedInt();
+                v.addChild (ValueTree::readFromStream (input), index, undoManager);
+                return true;
+            }
+
+            case childRemoved:
+            {
+                const int index = input.readCompressedInt();
+
+                if (isPositiveAndBelow (index, v.getNumChildren()))
+                {
+                    v.removeChild (index, undoManager);
+                    return true;
+                }
+
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                break;
+            }
+
+            case childMoved:
+            {
+                const int oldIndex = input.readCompressedInt();
+                const int newIndex = input.readCompressedInt();
+
+                if (isPositiveAndBelow (oldIndex, v.getNumChildren())
+                     && isPositiveAndBelow (newIndex, v.getNumChildren()))
+                {
+                    v.moveChild (oldIndex, newIndex, undoManager);
+                    return true;
+                }
+
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                break;
+            }
+
+            case fullSync:
+            case batch:
+                break;
+
+            default:
+                jassertfalse; // Seem to have received some corrupt data?
+                break;
+        }
+
+        return false;
+    }
 }
 
 ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTree (tree)
@@ -102,8 +196,96 @@ ValueTreeSynchroniser::~ValueTreeSynchroniser()
     valueTree.removeListener (this);
 }
 
+void ValueTreeSynchroniser::setBatchingEnabled (bool shouldBatchChanges)
+{
+    if (batchingEnabled != shouldBatchChanges)
+    {
+        flushPendingChanges();
+        batchingEnabled = shouldBatchChanges;
+    }
+}
+
+void ValueTreeSynchroniser::flushPendingChanges()
+{
+    cancelPendingUpdate();
+
+    if (pendingChanges.isEmpty())
+        return;
+
+    MemoryOutputStream m;
+    writeHeader (m, ValueTreeSynchroniserHelpers::batch);
+
+    m.writeCompressedInt (pendingPropertyNames.size());
+
+    for (auto& name : pendingPropertyNames)
+        m.writeString (name.toString());
+
+    m.writeCompressedInt (pendingChanges.size());
+
+    for (auto& change : pendingChanges)
+        m << change;
+
+    pendingChanges.clearQuick();
+    pendingPropertyNames.clearQuick();
+    pendingPropertyNameIndexes.clear();
+    pendingPropertyChangeIndexes.clear();
+
+    stateChanged (m.getData(), m.getDataSize());
+}
+
+void ValueTreeSynchroniser::handleAsyncUpdate()
+{
+    if (isReadyToSendChanges())
+        flushPendingChanges();
+}
+
+void ValueTreeSynchroniser::sendChange (const MemoryOutputStream& m)
+{
+    if (! batchingEnabled)
+    {
+        stateChanged (m.getData(), m.getDataSize());
+        return;
+    }
+
+    // Once the tree's structure has changed, the paths of any earlier property changes
+    // may no longer refer to the same subtrees, so they mustn't be merged with later ones.
+    pendingPropertyChangeIndexes.clear();
+
+    pendingChanges.add (m.getMemoryBlock());
+    triggerAsyncUpdate();
+}
+
+void ValueTreeSynchroniser::sendPropertyChange (const MemoryOutputStream& m, const String& key)
+{
+    if (auto* existingIndex = pendingPropertyChangeIndexes.find (key))
+    {
+        pendingChanges.getReference (*existingIndex) = m.getMemoryBlock();
+        return;
+    }
+
+    pendingPropertyChangeIndexes.set (key, pendingChanges.size());
+    pendingChanges.add (m.getMemoryBlock());
+    triggerAsyncUpdate();
+}
+
+int ValueTreeSynchroniser::getPendingPropertyNameIndex (const Identifier& name)
+{
+    if (auto* index = pendingPropertyNameIndexes.find (name.toString()))
+        return *index;
+
+    pendingPropertyNameIndexes.set (name.toString(), pendingPropertyNames.size());
+    pendingPropertyNames.add (name);
+    return pendingPropertyNames.size() - 1;
+}
+
 void ValueTreeSynchroniser::sendFullSyncCallback()
 {
+    pendingChanges.clearQuick();
+    pendingPropertyNames.clearQuick();
+    pendingPropertyNameIndexes.clear();
+    pendingPropertyChangeIndexes.clear();
+    cancelPendingUpdate();
+
     MemoryOutputStream m;
     writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
     valueTree.writeToStream (m);
@@ -112,21 +294,35 @@ void ValueTreeSynchroniser::sendFullSyncCallback()
 
 void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
 {
+    auto* value = vt.getPropertyPointer (property);
+
+    Array<int> path;
+    ValueTreeSynchroniserHelpers::getValueTreePath (vt, valueTree, path);
+
     MemoryOutputStream m;
+    ValueTreeSynchroniserHelpers::writeHeader (m, value != nullptr ? ValueTreeSynchroniserHelpers::propertyChanged
+                                                                    : ValueTreeSynchroniserHelpers::propertyRemoved, path);
 
-    if (auto* value = vt.getPropertyPointer (property))
-    {
-        ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::propertyChanged, vt);
+    if (batchingEnabled)
+        m.writeCompressedInt (getPendingPropertyNameIndex (property));
+    else
         m.writeString (property.toString());
+
+    if (value != nullptr)
         value->writeToStream (m);
-    }
-    else
+
+    if (! batchingEnabled)
     {
-        ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::propertyRemoved, vt);
-        m.writeString (property.toString());
+        stateChanged (m.getData(), m.getDataSize());
+        return;
     }
 
-    stateChanged (m.getData(), m.getDataSize());
+    String key (property.toString());
+
+    for (auto index : path)
+        key << '/' << index;
+
+    sendPropertyChange (m, key);
 }
 
 void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTree& childTree)
@@ -137,8 +333,13 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childAdded, parentTree);
     m.writeCompressedInt (index);
-    childTree.writeToStream (m);
-    stateChanged (m.getData(), m.getDataSize());
+
+    if (batchingEnabled)
+        childTree.writeToCompactStream (m);
+    else
+        childTree.writeToStream (m);
+
+    sendChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
@@ -146,7 +347,7 @@ void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueT
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childRemoved, parentTree);
     m.writeCompressedInt (oldIndex);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
@@ -155,7 +356,7 @@ void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int o
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childMoved, parent);
     m.writeCompressedInt (oldIndex);
     m.writeCompressedInt (newIndex);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size_t dataSize, UndoManager* undoManager)
@@ -170,73 +371,173 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         return true;
     }
 
-    ValueTree v (ValueTreeSynchroniserHelpers::readSubTreeLocation (input, root));
+    if (type != ValueTreeSynchroniserHelpers::batch)
+        return ValueTreeSynchroniserHelpers::applySingleChange (root, input, type, nullptr, undoManager);
+
+    const int numNames = input.readCompressedInt();
+
+    if (! isPositiveAndBelow (numNames, 65536)) // sanity-check
+        return false;
+
+    Array<Identifier> propertyNames;
+    propertyNames.ensureStorageAllocated (numNames);
+
+    for (int i = 0; i < numNames; ++i)
+    {
+        auto name = input.readString();
+
+        if (name.isEmpty())
+            return false;
+
+        propertyNames.add (name);
+    }
+
+    const int numChanges = input.readCompressedInt();
 
-    if (! v.isValid())
+    if (numChanges < 0)
         return false;
 
-    switch (type)
+    for (int i = 0; i < numChanges; ++i)
+    {
+        const auto changeType = (ValueTreeSynchroniserHelpers::ChangeType) input.readByte();
+
+        if (! ValueTreeSynchroniserHelpers::applySingleChange (root, input, changeType, &propertyNames, undoManager))
+            return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeSynchroniserTests final : public UnitTest
+{
+public:
+    ValueTreeSynchroniserTests()
+        : UnitTest ("ValueTreeSynchroniser", UnitTestCategories::values)
+    {}
+
+    struct Recorder final : public ValueTreeSynchroniser
     {
-        case ValueTreeSynchroniserHelpers::propertyChanged:
+        using ValueTreeSynchroniser::ValueTreeSynchroniser;
+
+        void stateChanged (const void* data, size_t dataSize) override
         {
-            Identifier property (input.readString());
-            v.setProperty (property, var::readFromStream (input), undoManager);
-            return true;
+            messages.add (MemoryBlock (data, dataSize));
         }
 
-        case ValueTreeSynchroniserHelpers::propertyRemoved:
+        Array<MemoryBlock> messages;
+    };
+
+    static ValueTree makeTree()
+    {
+        return { "root", {}, { { "child", {} }, { "child", {} } } };
+    }
+
+    static size_t applyAll (ValueTree& target, const Array<MemoryBlock>& messages)
+    {
+        size_t totalSize = 0;
+
+        for (auto& m : messages)
         {
-            Identifier property (input.readString());
-            v.removeProperty (property, undoManager);
-            return true;
+            ValueTreeSynchroniser::applyChange (target, m.getData(), m.getSize(), nullptr);
+            totalSize += m.getSize();
         }
 
-        case ValueTreeSynchroniserHelpers::childAdded:
+        return totalSize;
+    }
+
+    static void makeEdits (ValueTree& source)
+    {
+        for (int i = 0; i < 10; ++i)
         {
-            const int index = input.readCompressedInt();
-            v.addChild (ValueTree::readFromStream (input), index, undoManager);
-            return true;
+            source.getChild (0).setProperty ("gain", i, nullptr);
+            source.getChild (1).setProperty ("pan", -i, nullptr);
         }
 
-        case ValueTreeSynchroniserHelpers::childRemoved:
+        source.getChild (1).removeProperty ("pan", nullptr);
+        source.addChild ({ "added", { { "name", "new" } } }, 0, nullptr);
+        source.getChild (1).setProperty ("gain", 123, nullptr);
+        source.moveChild (0, 2, nullptr);
+        source.removeChild (1, nullptr);
+        source.setProperty ("done", true, nullptr);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Unbatched changes");
         {
-            const int index = input.readCompressedInt();
+            auto source = makeTree();
+            auto target = makeTree();
+            Recorder sync (source);
 
-            if (isPositiveAndBelow (index, v.getNumChildren()))
-            {
-                v.removeChild (index, undoManager);
-                return true;
-            }
+            makeEdits (source);
+            expectEquals (sync.messages.size(), 26);
 
-            jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
-            break;
+            applyAll (target, sync.messages);
+            expect (target.isEquivalentTo (source));
         }
 
-        case ValueTreeSynchroniserHelpers::childMoved:
+        beginTest ("Batched changes");
         {
-            const int oldIndex = input.readCompressedInt();
-            const int newIndex = input.readCompressedInt();
+            size_t unbatchedSize = 0;
 
-            if (isPositiveAndBelow (oldIndex, v.getNumChildren())
-                 && isPositiveAndBelow (newIndex, v.getNumChildren()))
             {
-                v.moveChild (oldIndex, newIndex, undoManager);
-                return true;
+                auto source = makeTree();
+                auto target = makeTree();
+                Recorder sync (source);
+                makeEdits (source);
+                unbatchedSize = applyAll (target, sync.messages);
             }
 
-            jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
-            break;
-        }
+            auto source = makeTree();
+            auto target = makeTree();
+            Recorder sync (source);
+            sync.setBatchingEnabled (true);
+
+            makeEdits (source);
+            expect (sync.messages.isEmpty());
+            expect (sync.hasPendingChanges());
+
+            sync.flushPendingChanges();
+            expect (! sync.hasPendingChanges());
+            expectEquals (sync.messages.size(), 1);
+
+            auto batchedSize = applyAll (target, sync.messages);
+            expect (target.isEquivalentTo (source));
+            expect (batchedSize * 4 < unbatchedSize);
+
+            sync.messages.clear();
+            source.setProperty ("late", 1, nullptr);
+            sync.setBatchingEnabled (false);
+            expectEquals (sync.messages.size(), 1);
 
-        case ValueTreeSynchroniserHelpers::fullSync:
-            break;
+            applyAll (target, sync.messages);
+            expect (target.isEquivalentTo (source));
+        }
 
-        default:
-            jassertfalse; // Seem to have received some corrupt data?
-            break;
+        beginTest ("Full sync discards pending changes");
+        {
+            auto source = makeTree();
+            ValueTree target;
+            Recorder sync (source);
+            sync.setBatchingEnabled (true);
+
+            makeEdits (source);
+            sync.sendFullSyncCallback();
+            expect (! sync.hasPendingChanges());
+            expectEquals (sync.messages.size(), 1);
+
+            applyAll (target, sync.messages);
+            expect (target.isEquivalentTo (source));
+        }
     }
+};
 
-    return false;
-}
+static ValueTreeSynchroniserTests valueTreeSynchroniserTests;
+
+#endif
 
 } // namespace juce
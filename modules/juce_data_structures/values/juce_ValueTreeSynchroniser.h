@@ -40,9 +40,14 @@ namespace juce
     via a network or other means) to a remote destination, where it can be
     applied to a target tree.
 
+    By default, each change to the tree is sent as a separate message. For trees that
+    are edited in bulk, call setBatchingEnabled() to have the changes collected up and
+    sent together instead.
+
     @tags{DataStructures}
 */
-class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener
+class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener,
+                                         private AsyncUpdater
 {
 public:
     /** Creates a ValueTreeSynchroniser that watches the given tree.
@@ -67,9 +72,47 @@ public:
         encodes the entire ValueTree.
 
         This will internally invoke stateChanged() with the encoded version of the state.
+        Any batched changes that haven't been sent yet are discarded, as the full state
+        already includes them.
     */
     void sendFullSyncCallback();
 
+    //==============================================================================
+    /** Turns the batching of changes on or off.
+
+        Normally, stateChanged() is called as soon as each change is made to the tree.
+        When batching is enabled, changes are instead collected up and sent together in
+        a single message on the next message loop callback. Repeated changes to the same
+        property are combined, as long as no children are added, removed or moved in
+        between, and each property name is only sent once per batch. So a bulk edit of
+        the tree results in a single message that's much smaller than the sum of the
+        individual ones.
+
+        Turning batching off sends any changes that are still pending.
+
+        @see flushPendingChanges, isReadyToSendChanges
+    */
+    void setBatchingEnabled (bool shouldBatchChanges);
+
+    /** Returns true if batching has been enabled with setBatchingEnabled(). */
+    bool isBatchingEnabled() const noexcept         { return batchingEnabled; }
+
+    /** Returns true if there are batched changes that haven't been sent yet. */
+    bool hasPendingChanges() const noexcept         { return ! pendingChanges.isEmpty(); }
+
+    /** Immediately sends any batched changes that haven't been sent yet, whether or
+        not isReadyToSendChanges() returns true.
+    */
+    void flushPendingChanges();
+
+    /** When batching is enabled, this is called before each batch of changes is sent.
+
+        If the transport is still busy sending earlier messages, you can override this to
+        return false. The changes will then continue to be collected (and combined) until
+        you call flushPendingChanges(), e.g. when the transport's queue has drained.
+    */
+    virtual bool isReadyToSendChanges()             { return true; }
+
     /** Applies an encoded change to the given destination tree.
 
         When you implement a receiver for changes that were sent by the stateChanged()
@@ -86,6 +129,16 @@ public:
 private:
     ValueTree valueTree;
 
+    bool batchingEnabled = false;
+    Array<MemoryBlock> pendingChanges;
+    Array<Identifier> pendingPropertyNames;
+    FlatHashMap<String, int> pendingPropertyNameIndexes, pendingPropertyChangeIndexes;
+
+    void sendChange (const MemoryOutputStream&);
+    void sendPropertyChange (const MemoryOutputStream&, const String& key);
+    int getPendingPropertyNameIndex (const Identifier&);
+    void handleAsyncUpdate() override;
+
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
     void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
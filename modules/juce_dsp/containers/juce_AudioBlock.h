@@ -484,6 +484,14 @@ public:
     template <typename Src1SampleType, typename Src2SampleType>
     const AudioBlock& addProductOf (AudioBlock<Src1SampleType> src1, AudioBlock<Src2SampleType> src2) const noexcept   { addProductOfInternal (src1, src2); return *this; }
 
+    /** Multiplies each value in src by a gain that ramps linearly from startGain towards endGain over the length of
+        the block, and adds the result to this block in a single pass.
+    */
+    template <typename OtherSampleType>
+    AudioBlock&       JUCE_VECTOR_CALLTYPE addProductOf (AudioBlock<OtherSampleType> src, NumericType startGain, NumericType endGain)       noexcept   { addProductOfInternal (src, startGain, endGain); return *this; }
+    template <typename OtherSampleType>
+    const AudioBlock& JUCE_VECTOR_CALLTYPE addProductOf (AudioBlock<OtherSampleType> src, NumericType startGain, NumericType endGain) const noexcept   { addProductOfInternal (src, startGain, endGain); return *this; }
+
     //==============================================================================
     /** Negates each value of this block. */
     AudioBlock&       negate()       noexcept   { negateInternal(); return *this; }
@@ -766,13 +774,23 @@ private:
         }
         else
         {
-            for (size_t i = 0; i < numSamples; ++i)
+            forEachRampChunk (value, numSamples, [this] (const OtherSampleType* ramp, size_t offset, size_t num)
             {
-                const auto scaler = (NumericType) value.getNextValue();
-
                 for (size_t ch = 0; ch < numChannels; ++ch)
-                    getDataPointer (ch)[i] *= scaler;
-            }
+                {
+                    auto* dst = getChannelPointer (ch) + offset;
+
+                    if constexpr (std::is_same_v<SampleType, OtherSampleType>)
+                    {
+                        FloatVectorOperations::multiply (dst, ramp, (int) num);
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < num; ++i)
+                            dst[i] *= (NumericType) ramp[i];
+                    }
+                }
+            });
         }
     }
 
@@ -787,15 +805,40 @@ private:
         }
         else
         {
-            auto n = jmin (numSamples, src.numSamples) * sizeFactor;
-
-            for (size_t i = 0; i < n; ++i)
+            forEachRampChunk (value, jmin (numSamples, src.numSamples), [this, &src] (const SmootherSampleType* ramp, size_t offset, size_t num)
             {
-                const auto scaler = (NumericType) value.getNextValue();
-
                 for (size_t ch = 0; ch < numChannels; ++ch)
-                    getDataPointer (ch)[i] = scaler * src.getChannelPointer (ch)[i];
-            }
+                {
+                    auto* dst = getChannelPointer (ch) + offset;
+                    auto* srcSamples = src.getChannelPointer (ch) + offset;
+
+                    if constexpr (std::is_same_v<SampleType, SmootherSampleType> && std::is_same_v<SampleType, BlockSampleType>)
+                    {
+                        FloatVectorOperations::multiply (dst, srcSamples, ramp, (int) num);
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < num; ++i)
+                            dst[i] = srcSamples[i] * (NumericType) ramp[i];
+                    }
+                }
+            });
+        }
+    }
+
+    // Generates the smoothed values in short runs, so that they can be applied to
+    // every channel with vectorised operations
+    template <typename SmootherSampleType, typename SmoothingType, typename Callback>
+    static void forEachRampChunk (SmoothedValue<SmootherSampleType, SmoothingType>& value, size_t num, Callback&& callback) noexcept
+    {
+        constexpr size_t chunkSize = 64;
+        SmootherSampleType ramp[chunkSize];
+
+        for (size_t offset = 0; offset < num; offset += chunkSize)
+        {
+            const auto numInChunk = jmin (chunkSize, num - offset);
+            value.fillRamp (ramp, (int) numInChunk);
+            callback (ramp, offset, numInChunk);
         }
     }
 
@@ -810,6 +853,32 @@ private:
             FloatVectorOperations::addWithMultiply (getDataPointer (ch), src.getDataPointer (ch), factor, n);
     }
 
+    template <typename OtherSampleType>
+    void JUCE_VECTOR_CALLTYPE addProductOfInternal (AudioBlock<OtherSampleType> src, NumericType startGain, NumericType endGain) const noexcept
+    {
+        jassert (numChannels == src.numChannels);
+        auto n = jmin (numSamples, src.numSamples);
+
+        if constexpr (sizeFactor == 1)
+        {
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                FloatVectorOperations::addWithMultiplyRamp (getDataPointer (ch), src.getDataPointer (ch), startGain, endGain, n);
+        }
+        else
+        {
+            // Each SIMD sample holds several consecutive values, which all need the same gain
+            const auto increment = (endGain - startGain) / (NumericType) jmax ((size_t) 1, n);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto gain = startGain + (NumericType) i * increment;
+
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                    FloatVectorOperations::addWithMultiply (getDataPointer (ch) + i * sizeFactor, src.getDataPointer (ch) + i * sizeFactor, gain, sizeFactor);
+            }
+        }
+    }
+
     template <typename Src1SampleType, typename Src2SampleType>
     void addProductOfInternal (AudioBlock<Src1SampleType> src1, AudioBlock<Src2SampleType> src2) const noexcept
     {
@@ -235,6 +235,13 @@ public:
             block.addProductOf (otherBlock, otherBlock);
             expectEquals (block.getSample (0, 4), SampleType (35.0));
             expectEquals (block.getSample (1, 4), SampleType (143.0));
+
+            resetBlocks();
+
+            block.addProductOf (otherBlock, (NumericType) 0.0, (NumericType) 3.0);
+            expectEquals (block.getSample (0, 0), SampleType (1.0));
+            expectEquals (block.getSample (0, 4), SampleType (-5.0));
+            expectEquals (block.getSample (1, 4), SampleType (-11.0));
         }
 
         beginTest ("Negative abs min max");
@@ -43,7 +43,7 @@ typename FIR::Coefficients<FloatType>::Ptr
 
     for (size_t i = 0; i <= order; ++i)
     {
-        if (i == order / 2)
+        if (2 * i == order)
         {
             c[i] = static_cast<FloatType> (normalisedFrequency * 2);
         }
@@ -542,33 +542,8 @@ ReferenceCountedArray<IIR::Coefficients<FloatType>>
     FilterDesign<FloatType>::designIIRLowpassHighOrderButterworthMethod (FloatType frequency,
                                                                          double sampleRate, int order)
 {
-    jassert (sampleRate > 0);
-    jassert (frequency > 0 && frequency <= sampleRate * 0.5);
-    jassert (order > 0);
-
     ReferenceCountedArray<IIR::Coefficients<FloatType>> arrayFilters;
-
-    if (order % 2 == 1)
-    {
-        arrayFilters.add (*IIR::Coefficients<FloatType>::makeFirstOrderLowPass (sampleRate, frequency));
-
-        for (int i = 0; i < order / 2; ++i)
-        {
-            auto Q = 1.0 / (2.0 * std::cos ((i + 1.0) * MathConstants<double>::pi / order));
-            arrayFilters.add (*IIR::Coefficients<FloatType>::makeLowPass (sampleRate, frequency,
-                                                                          static_cast<FloatType> (Q)));
-        }
-    }
-    else
-    {
-        for (int i = 0; i < order / 2; ++i)
-        {
-            auto Q = 1.0 / (2.0 * std::cos ((2.0 * i + 1.0) * MathConstants<double>::pi / (order * 2.0)));
-            arrayFilters.add (*IIR::Coefficients<FloatType>::makeLowPass (sampleRate, frequency,
-                                                                          static_cast<FloatType> (Q)));
-        }
-    }
-
+    designIIRHighOrderButterworthMethod (arrayFilters, false, frequency, sampleRate, order);
     return arrayFilters;
 }
 
@@ -576,35 +551,75 @@ template <typename FloatType>
 ReferenceCountedArray<IIR::Coefficients<FloatType>>
     FilterDesign<FloatType>::designIIRHighpassHighOrderButterworthMethod (FloatType frequency,
                                                                           double sampleRate, int order)
+{
+    ReferenceCountedArray<IIR::Coefficients<FloatType>> arrayFilters;
+    designIIRHighOrderButterworthMethod (arrayFilters, true, frequency, sampleRate, order);
+    return arrayFilters;
+}
+
+template <typename FloatType>
+void FilterDesign<FloatType>::designIIRLowpassHighOrderButterworthMethod (ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate,
+                                                                          FloatType frequency, double sampleRate, int order)
+{
+    designIIRHighOrderButterworthMethod (coefficientsToUpdate, false, frequency, sampleRate, order);
+}
+
+template <typename FloatType>
+void FilterDesign<FloatType>::designIIRHighpassHighOrderButterworthMethod (ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate,
+                                                                           FloatType frequency, double sampleRate, int order)
+{
+    designIIRHighOrderButterworthMethod (coefficientsToUpdate, true, frequency, sampleRate, order);
+}
+
+template <typename FloatType>
+void FilterDesign<FloatType>::designIIRHighOrderButterworthMethod (ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate,
+                                                                   bool isHighPass, FloatType frequency,
+                                                                   double sampleRate, int order)
 {
     jassert (sampleRate > 0);
     jassert (frequency > 0 && frequency <= sampleRate * 0.5);
     jassert (order > 0);
 
-    ReferenceCountedArray<IIR::Coefficients<FloatType>> arrayFilters;
+    using ArrayCoeffs = IIR::ArrayCoefficients<FloatType>;
+
+    int numSections = 0;
+
+    // Overwrites the existing sections where possible, so that no memory is allocated
+    const auto setNextSection = [&] (const auto& values)
+    {
+        if (numSections < coefficientsToUpdate.size())
+            *coefficientsToUpdate.getObjectPointerUnchecked (numSections) = values;
+        else
+            coefficientsToUpdate.add (new IIRCoefficients (values));
+
+        ++numSections;
+    };
 
     if (order % 2 == 1)
     {
-        arrayFilters.add (*IIR::Coefficients<FloatType>::makeFirstOrderHighPass (sampleRate, frequency));
+        setNextSection (isHighPass ? ArrayCoeffs::makeFirstOrderHighPass (sampleRate, frequency)
+                                   : ArrayCoeffs::makeFirstOrderLowPass  (sampleRate, frequency));
 
         for (int i = 0; i < order / 2; ++i)
         {
-            auto Q = 1.0 / (2.0 * std::cos ((i + 1.0) * MathConstants<double>::pi / order));
-            arrayFilters.add (*IIR::Coefficients<FloatType>::makeHighPass (sampleRate, frequency,
-                                                                           static_cast<FloatType> (Q)));
+            auto Q = static_cast<FloatType> (1.0 / (2.0 * std::cos ((i + 1.0) * MathConstants<double>::pi / order)));
+
+            setNextSection (isHighPass ? ArrayCoeffs::makeHighPass (sampleRate, frequency, Q)
+                                       : ArrayCoeffs::makeLowPass  (sampleRate, frequency, Q));
         }
     }
     else
     {
         for (int i = 0; i < order / 2; ++i)
         {
-            auto Q = 1.0 / (2.0 * std::cos ((2.0 * i + 1.0) * MathConstants<double>::pi / (order * 2.0)));
-            arrayFilters.add (*IIR::Coefficients<FloatType>::makeHighPass (sampleRate, frequency,
-                                                                           static_cast<FloatType> (Q)));
+            auto Q = static_cast<FloatType> (1.0 / (2.0 * std::cos ((2.0 * i + 1.0) * MathConstants<double>::pi / (order * 2.0))));
+
+            setNextSection (isHighPass ? ArrayCoeffs::makeHighPass (sampleRate, frequency, Q)
+                                       : ArrayCoeffs::makeLowPass  (sampleRate, frequency, Q));
         }
     }
 
-    return arrayFilters;
+    coefficientsToUpdate.removeRange (numSections, coefficientsToUpdate.size() - numSections);
 }
 
 template <typename FloatType>
@@ -692,7 +707,117 @@ typename FilterDesign<FloatType>::IIRPolyphaseAllpassStructure
 }
 
 
+//==============================================================================
+template <typename FloatType>
+void IIRFilterDesignCache<FloatType>::prepare (const DesignFunction& design, FloatType minFrequency,
+                                               FloatType maxFrequency, int numFrequenciesToUse)
+{
+    jassert (design != nullptr);
+    jassert (0 < minFrequency && minFrequency <= maxFrequency);
+    jassert (numFrequenciesToUse > 0);
+
+    numFrequencies = jmax (1, numFrequenciesToUse);
+    logMinFrequency = std::log ((double) minFrequency);
+    logFrequencyStep = numFrequencies > 1 ? (std::log ((double) maxFrequency) - logMinFrequency) / (numFrequencies - 1)
+                                          : 0.0;
+
+    std::vector<ReferenceCountedArray<IIRCoefficients>> designs;
+    designs.reserve ((size_t) numFrequencies);
+    numSections = 0;
+
+    for (int i = 0; i < numFrequencies; ++i)
+    {
+        designs.push_back (design (static_cast<FloatType> (std::exp (logMinFrequency + i * logFrequencyStep))));
+        numSections = jmax (numSections, designs.back().size());
+    }
+
+    table.assign ((size_t) (numFrequencies * numSections * coefficientsPerSection), FloatType());
+
+    for (int i = 0; i < numFrequencies; ++i)
+    {
+        auto* dest = table.data() + i * numSections * coefficientsPerSection;
+
+        for (int section = 0; section < numSections; ++section, dest += coefficientsPerSection)
+        {
+            if (section >= designs[(size_t) i].size())
+            {
+                dest[0] = 1;
+                continue;
+            }
+
+            const auto& coefficients = *designs[(size_t) i].getObjectPointerUnchecked (section);
+            const auto* src = coefficients.getRawCoefficients();
+            const auto order = coefficients.getFilterOrder();
+
+            // Only first and second order sections can be stored in the table
+            jassert (order == 1 || order == 2);
+
+            if (order == 1)
+            {
+                dest[0] = src[0];
+                dest[1] = src[1];
+                dest[3] = src[2];
+            }
+            else if (order == 2)
+            {
+                std::copy (src, src + coefficientsPerSection, dest);
+            }
+        }
+    }
+}
+
+template <typename FloatType>
+int IIRFilterDesignCache<FloatType>::getIndexForFrequency (FloatType frequency) const noexcept
+{
+    if (numFrequencies < 2 || ! (frequency > 0))
+        return 0;
+
+    return jlimit (0, numFrequencies - 1,
+                   roundToInt ((std::log ((double) frequency) - logMinFrequency) / logFrequencyStep));
+}
+
+template <typename FloatType>
+FloatType IIRFilterDesignCache<FloatType>::getQuantisedFrequency (FloatType frequency) const noexcept
+{
+    return static_cast<FloatType> (std::exp (logMinFrequency + getIndexForFrequency (frequency) * logFrequencyStep));
+}
+
+template <typename FloatType>
+ReferenceCountedArray<IIR::Coefficients<FloatType>> IIRFilterDesignCache<FloatType>::createCoefficients() const
+{
+    ReferenceCountedArray<IIRCoefficients> result;
+
+    for (int i = 0; i < numSections; ++i)
+        result.add (new IIRCoefficients (1, 0, 0, 1, 0, 0));
+
+    return result;
+}
+
+template <typename FloatType>
+bool IIRFilterDesignCache<FloatType>::getCoefficients (FloatType frequency,
+                                                       ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate) const noexcept
+{
+    if (! isPrepared() || coefficientsToUpdate.size() != numSections)
+        return false;
+
+    for (auto* c : coefficientsToUpdate)
+        if (c->getFilterOrder() != 2)
+            return false;
+
+    const auto* src = table.data() + getIndexForFrequency (frequency) * numSections * coefficientsPerSection;
+
+    for (auto* c : coefficientsToUpdate)
+    {
+        std::copy (src, src + coefficientsPerSection, c->getRawCoefficients());
+        src += coefficientsPerSection;
+    }
+
+    return true;
+}
+
 template struct FilterDesign<float>;
 template struct FilterDesign<double>;
+template class IIRFilterDesignCache<float>;
+template class IIRFilterDesignCache<double>;
 
 } // namespace juce::dsp
@@ -187,6 +187,31 @@ struct FilterDesign
     static ReferenceCountedArray<IIRCoefficients> designIIRHighpassHighOrderButterworthMethod (FloatType frequency, double sampleRate,
                                                                                                int order);
 
+    /** This is a variant of designIIRLowpassHighOrderButterworthMethod which writes the
+        coefficients into an existing array, rather than returning a new one.
+
+        If the array already contains the right number of IIR::Coefficients objects, they
+        are updated in place, so no memory is allocated and any IIR::Filters that share
+        these objects will pick up the new coefficients straight away. This makes it
+        suitable for modulating the cutoff frequency of a cascade from the audio thread,
+        as long as the order doesn't change.
+
+        @param coefficientsToUpdate         the array to write the coefficients to
+        @param frequency                    the cutoff frequency of the low-pass filter
+        @param sampleRate                   the sample rate being used in the filter design
+        @param order                        the order of the resulting IIR filter
+    */
+    static void designIIRLowpassHighOrderButterworthMethod (ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate,
+                                                            FloatType frequency, double sampleRate, int order);
+
+    /** This is a variant of designIIRHighpassHighOrderButterworthMethod which writes the
+        coefficients into an existing array, rather than returning a new one.
+
+        @see designIIRLowpassHighOrderButterworthMethod
+    */
+    static void designIIRHighpassHighOrderButterworthMethod (ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate,
+                                                             FloatType frequency, double sampleRate, int order);
+
     /** This method returns an array of IIR::Coefficients, made to be used in
         cascaded IIRFilters, providing a minimum phase low-pass filter without any
         ripple in the stop band only.
@@ -286,6 +311,9 @@ private:
     //==============================================================================
     static Array<double> getPartialImpulseResponseHn (int n, double kp);
 
+    static void designIIRHighOrderButterworthMethod (ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate,
+                                                     bool isHighPass, FloatType frequency, double sampleRate, int order);
+
     static ReferenceCountedArray<IIRCoefficients> designIIRLowpassHighOrderGeneralMethod (int type, FloatType frequency, double sampleRate,
                                                                                           FloatType normalisedTransitionWidth,
                                                                                           FloatType passbandAmplitudedB,
@@ -293,4 +321,100 @@ private:
     FilterDesign() = delete;
 };
 
+//==============================================================================
+/**
+    A table of precomputed IIR filter designs, spaced logarithmically over a range of
+    cutoff frequencies.
+
+    Some of the designs in FilterDesign, such as the elliptic and Chebyshev methods,
+    are too expensive (and allocate too much memory) to be called from the audio
+    thread. This class runs the design for a set of quantised frequencies in prepare(),
+    so that a modulated filter can then look up the closest design without any
+    allocation or locking.
+
+    Each design is stored as a fixed number of second order sections. First order
+    sections are stored as second order sections with zero b2 and a2 coefficients,
+    and designs with fewer sections are padded with sections that pass the signal
+    through unchanged. This means that the order of the filters in the cascade never
+    changes, so the IIR::Filters using them never need to reallocate their state.
+
+    @code
+    cache.prepare ([sampleRate] (float frequency)
+                   {
+                       return FilterDesign<float>::designIIRLowpassHighOrderEllipticMethod (frequency, sampleRate, 0.05f, -0.1f, -60.0f);
+                   },
+                   100.0f, 10000.0f, 256);
+
+    coefficients = cache.createCoefficients();
+
+    // ...and then on the audio thread:
+    cache.getCoefficients (cutoff, coefficients);
+    @endcode
+
+    @see FilterDesign
+
+    @tags{DSP}
+*/
+template <typename FloatType>
+class IIRFilterDesignCache
+{
+public:
+    using IIRCoefficients = IIR::Coefficients<FloatType>;
+
+    /** The type of function used to design the filters at each frequency. */
+    using DesignFunction = std::function<ReferenceCountedArray<IIRCoefficients> (FloatType frequency)>;
+
+    //==============================================================================
+    /** Creates an empty cache. Call prepare() before using it. */
+    IIRFilterDesignCache() = default;
+
+    /** Runs the design function for numFrequencies frequencies, spaced logarithmically
+        between minFrequency and maxFrequency inclusive, and stores the results.
+
+        This allocates memory, so don't call it from the audio thread.
+    */
+    void prepare (const DesignFunction& design, FloatType minFrequency, FloatType maxFrequency, int numFrequencies);
+
+    /** Returns true if prepare() has been called. */
+    bool isPrepared() const noexcept                { return numFrequencies > 0; }
+
+    /** Returns the number of second order sections in each of the cached designs. */
+    int getNumSections() const noexcept             { return numSections; }
+
+    /** Returns the number of frequencies that designs have been stored for. */
+    int getNumFrequencies() const noexcept          { return numFrequencies; }
+
+    /** Returns the cached frequency closest to the given one. */
+    FloatType getQuantisedFrequency (FloatType frequency) const noexcept;
+
+    //==============================================================================
+    /** Returns a new array of second order coefficient objects, with the right number of
+        sections to hold any of the cached designs.
+
+        This allocates memory, so call it when preparing your filters, and then pass the
+        result to getCoefficients() on the audio thread.
+    */
+    ReferenceCountedArray<IIRCoefficients> createCoefficients() const;
+
+    /** Copies the cached design closest to the given frequency into an array created by
+        createCoefficients(). This doesn't allocate any memory or take any locks.
+
+        Returns false, and leaves the array unchanged, if the cache hasn't been prepared
+        or the array doesn't have the expected number of second order sections.
+    */
+    bool getCoefficients (FloatType frequency, ReferenceCountedArray<IIRCoefficients>& coefficientsToUpdate) const noexcept;
+
+private:
+    //==============================================================================
+    static constexpr int coefficientsPerSection = 5;
+
+    int getIndexForFrequency (FloatType frequency) const noexcept;
+
+    std::vector<FloatType> table;
+    double logMinFrequency = 0, logFrequencyStep = 0;
+    int numFrequencies = 0, numSections = 0;
+
+    JUCE_LEAK_DETECTOR (IIRFilterDesignCache)
+};
+
 } // namespace juce::dsp
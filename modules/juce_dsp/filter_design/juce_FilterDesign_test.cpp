@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct FilterDesignTests final : public UnitTest
+{
+    FilterDesignTests()
+        : UnitTest ("FilterDesign", UnitTestCategories::dsp)
+    {}
+
+    static bool coefficientsMatch (const IIR::Coefficients<float>& a, const IIR::Coefficients<float>& b)
+    {
+        if (a.coefficients.size() != b.coefficients.size())
+            return false;
+
+        for (int i = 0; i < a.coefficients.size(); ++i)
+            if (! approximatelyEqual (a.coefficients[i], b.coefficients[i]))
+                return false;
+
+        return true;
+    }
+
+    static double getCascadeMagnitude (const ReferenceCountedArray<IIR::Coefficients<float>>& cascade,
+                                       double frequency, double sampleRate)
+    {
+        double magnitude = 1.0;
+
+        for (auto* c : cascade)
+            magnitude *= c->getMagnitudeForFrequency (frequency, sampleRate);
+
+        return magnitude;
+    }
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+
+        beginTest ("In-place Butterworth designs match the returned designs");
+        {
+            for (auto order : { 1, 4, 7 })
+            {
+                ReferenceCountedArray<IIR::Coefficients<float>> inPlace;
+
+                for (auto isHighPass : { false, true })
+                {
+                    for (auto frequency : { 100.0f, 1000.0f, 15000.0f })
+                    {
+                        const auto expected = isHighPass ? FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod (frequency, sampleRate, order)
+                                                         : FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (frequency, sampleRate, order);
+
+                        if (isHighPass)
+                            FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod (inPlace, frequency, sampleRate, order);
+                        else
+                            FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (inPlace, frequency, sampleRate, order);
+
+                        expectEquals (inPlace.size(), expected.size());
+
+                        for (int i = 0; i < expected.size(); ++i)
+                            expect (coefficientsMatch (*inPlace[i], *expected[i]));
+                    }
+                }
+            }
+        }
+
+        beginTest ("In-place Butterworth designs reuse the existing coefficient objects");
+        {
+            auto cascade = FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (1000.0f, sampleRate, 5);
+            const auto* firstSection = cascade.getObjectPointerUnchecked (0);
+            const auto* lastSection  = cascade.getObjectPointerUnchecked (2);
+
+            FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (cascade, 2000.0f, sampleRate, 5);
+
+            expectEquals (cascade.size(), 3);
+            expect (cascade.getObjectPointerUnchecked (0) == firstSection);
+            expect (cascade.getObjectPointerUnchecked (2) == lastSection);
+
+            FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (cascade, 2000.0f, sampleRate, 2);
+            expectEquals (cascade.size(), 1);
+        }
+
+        const auto ellipticDesign = [] (float frequency)
+        {
+            return FilterDesign<float>::designIIRLowpassHighOrderEllipticMethod (frequency, sampleRate, 0.005f, -0.5f, -60.0f);
+        };
+
+        IIRFilterDesignCache<float> cache;
+        cache.prepare (ellipticDesign, 300.0f, 12000.0f, 64);
+
+        beginTest ("Cached designs match the direct designs at the quantised frequencies");
+        {
+            expect (cache.isPrepared());
+            expectEquals (cache.getNumFrequencies(), 64);
+            expectWithinAbsoluteError (cache.getQuantisedFrequency (1.0f), 300.0f, 1.0e-2f);
+            expectWithinAbsoluteError (cache.getQuantisedFrequency (20000.0f), 12000.0f, 1.0e-1f);
+
+            auto coefficients = cache.createCoefficients();
+            expectEquals (coefficients.size(), cache.getNumSections());
+
+            for (auto frequency : { 320.0f, 1234.0f, 5000.0f, 11000.0f })
+            {
+                expect (cache.getCoefficients (frequency, coefficients));
+
+                const auto quantised = cache.getQuantisedFrequency (frequency);
+                const auto expected = ellipticDesign (quantised);
+
+                expect (expected.size() <= coefficients.size());
+
+                for (auto* c : coefficients)
+                    expectEquals ((int) c->getFilterOrder(), 2);
+
+                for (auto testFrequency : { 0.5 * quantised, (double) quantised, 2.0 * quantised })
+                {
+                    const auto expectedMagnitude = getCascadeMagnitude (expected, testFrequency, sampleRate);
+                    expectWithinAbsoluteError (getCascadeMagnitude (coefficients, testFrequency, sampleRate),
+                                               expectedMagnitude, 1.0e-3 + 1.0e-3 * expectedMagnitude);
+                }
+            }
+        }
+
+        beginTest ("Cached designs reject mismatched coefficient arrays");
+        {
+            IIRFilterDesignCache<float> unprepared;
+            auto coefficients = cache.createCoefficients();
+
+            expect (! unprepared.getCoefficients (1000.0f, coefficients));
+
+            coefficients.remove (0);
+            expect (! cache.getCoefficients (1000.0f, coefficients));
+
+            auto firstOrder = ReferenceCountedArray<IIR::Coefficients<float>>();
+
+            for (int i = 0; i < cache.getNumSections(); ++i)
+                firstOrder.add (IIR::Coefficients<float>::makeFirstOrderLowPass (sampleRate, 1000.0f));
+
+            expect (! cache.getCoefficients (1000.0f, firstOrder));
+        }
+    }
+};
+
+static FilterDesignTests filterDesignTests;
+
+} // namespace juce::dsp
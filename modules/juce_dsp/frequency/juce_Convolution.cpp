@@ -143,6 +143,57 @@ ConvolutionMessageQueue::~ConvolutionMessageQueue() noexcept
 ConvolutionMessageQueue::ConvolutionMessageQueue (ConvolutionMessageQueue&&) noexcept = default;
 ConvolutionMessageQueue& ConvolutionMessageQueue::operator= (ConvolutionMessageQueue&&) noexcept = default;
 
+//==============================================================================
+// After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls.
+static void prepareForConvolution (float* samples, size_t fftSize) noexcept
+{
+    auto FFTSizeDiv2 = fftSize / 2;
+
+    for (size_t i = 0; i < FFTSizeDiv2; i++)
+        samples[i] = samples[i << 1];
+
+    samples[FFTSizeDiv2] = 0;
+
+    for (size_t i = 1; i < FFTSizeDiv2; i++)
+        samples[i + FFTSizeDiv2] = -samples[((fftSize - i) << 1) + 1];
+}
+
+// Does the convolution operation itself only on half of the frequency domain samples.
+static void convolutionProcessingAndAccumulate (const float* input, const float* impulse, float* output, size_t fftSize) noexcept
+{
+    auto FFTSizeDiv2 = fftSize / 2;
+
+    FloatVectorOperations::addWithMultiply      (output, input, impulse, static_cast<int> (FFTSizeDiv2));
+    FloatVectorOperations::subtractWithMultiply (output, &(input[FFTSizeDiv2]), &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+
+    FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), input, &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+    FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), &(input[FFTSizeDiv2]), impulse, static_cast<int> (FFTSizeDiv2));
+
+    output[fftSize] += input[fftSize] * impulse[fftSize];
+}
+
+// Undoes the re-organization of samples from the function prepareForConvolution.
+// Then takes the conjugate of the frequency domain first half of samples to fill the
+// second half, so that the inverse transform will return real samples in the time domain.
+static void updateSymmetricFrequencyDomainData (float* samples, size_t fftSize) noexcept
+{
+    auto FFTSizeDiv2 = fftSize / 2;
+
+    for (size_t i = 1; i < FFTSizeDiv2; i++)
+    {
+        samples[(fftSize - i) << 1] = samples[i];
+        samples[((fftSize - i) << 1) + 1] = -samples[FFTSizeDiv2 + i];
+    }
+
+    samples[1] = 0.f;
+
+    for (size_t i = 1; i < FFTSizeDiv2; i++)
+    {
+        samples[i << 1] = samples[(fftSize - i) << 1];
+        samples[(i << 1) + 1] = -samples[((fftSize - i) << 1) + 1];
+    }
+}
+
 //==============================================================================
 struct ConvolutionEngine
 {
@@ -195,7 +246,7 @@ struct ConvolutionEngine
                                          static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
 
             FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
-            prepareForConvolution (impulseResponse);
+            prepareForConvolution (impulseResponse, fftSize);
 
             currentPtr += (fftSize - blockSize);
         }
@@ -240,7 +291,7 @@ struct ConvolutionEngine
             FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
 
             fftObject->performRealOnlyForwardTransform (inputSegmentData);
-            prepareForConvolution (inputSegmentData);
+            prepareForConvolution (inputSegmentData, fftSize);
 
             // Complex multiplication
             if (inputDataWasEmpty)
@@ -258,7 +309,8 @@ struct ConvolutionEngine
 
                     convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
                                                         buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
+                                                        outputTempData,
+                                                        fftSize);
                 }
             }
 
@@ -266,9 +318,10 @@ struct ConvolutionEngine
 
             convolutionProcessingAndAccumulate (inputSegmentData,
                                                 buffersImpulseSegments.front().getWritePointer (0),
-                                                outputData);
+                                                outputData,
+                                                fftSize);
 
-            updateSymmetricFrequencyDomainData (outputData);
+            updateSymmetricFrequencyDomainData (outputData, fftSize);
             fftObject->performRealOnlyInverseTransform (outputData);
 
             // Add overlap
@@ -328,7 +381,7 @@ struct ConvolutionEngine
                 FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
 
                 fftObject->performRealOnlyForwardTransform (inputSegmentData);
-                prepareForConvolution (inputSegmentData);
+                prepareForConvolution (inputSegmentData, fftSize);
 
                 // Complex multiplication
                 FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
@@ -344,16 +397,18 @@ struct ConvolutionEngine
 
                     convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
                                                         buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
+                                                        outputTempData,
+                                                        fftSize);
                 }
 
                 FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
 
                 convolutionProcessingAndAccumulate (inputSegmentData,
                                                     buffersImpulseSegments.front().getWritePointer (0),
-                                                    outputData);
+                                                    outputData,
+                                                    fftSize);
 
-                updateSymmetricFrequencyDomainData (outputData);
+                updateSymmetricFrequencyDomainData (outputData, fftSize);
                 fftObject->performRealOnlyInverseTransform (outputData);
 
                 // Add overlap
@@ -375,66 +430,532 @@ struct ConvolutionEngine
         }
     }
 
-    // After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls.
-    void prepareForConvolution (float *samples) noexcept
+    //==============================================================================
+    const size_t blockSize;
+    const size_t fftSize;
+    const std::unique_ptr<FFT> fftObject;
+    const size_t numSegments;
+    const size_t numInputSegments;
+    size_t currentSegment = 0, inputDataPos = 0;
+
+    AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
+    std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
+};
+
+//==============================================================================
+/*  Convolves a set of input channels with a matrix of impulse responses, using
+    uniform partitioning. Each output channel is the sum of every input channel
+    convolved with the IR for that input/output pair.
+
+    Each input channel is only transformed once per block, however many outputs it
+    feeds. The spectra are stored contiguously, with the IR spectra ordered by
+    partition, then output, then input, so that the multiply-accumulate loop for an
+    output channel reads through memory in order.
+*/
+class MatrixConvolutionEngine
+{
+public:
+    MatrixConvolutionEngine (const AudioBuffer<float>& buf,
+                             int numInputsIn,
+                             int numOutputsIn,
+                             size_t maxBlockSize)
+        : numInputs ((size_t) numInputsIn),
+          numOutputs ((size_t) numOutputsIn),
+          blockSize ((size_t) nextPowerOfTwo ((int) maxBlockSize)),
+          fftSize (blockSize > 128 ? 2 * blockSize : 4 * blockSize),
+          spectrumStride (fftSize + 4),
+          fftObject (std::make_unique<FFT> (roundToInt (std::log2 (fftSize)))),
+          numSegments ((size_t) buf.getNumSamples() / (fftSize - blockSize) + 1u),
+          numInputSegments ((blockSize > 128 ? numSegments : 3 * numSegments)),
+          bufferInput      ((int) numInputs,  static_cast<int> (fftSize)),
+          bufferOutput     ((int) numOutputs, static_cast<int> (fftSize * 2)),
+          bufferTempOutput ((int) numOutputs, static_cast<int> (fftSize + 1)),
+          bufferOverlap    ((int) numOutputs, static_cast<int> (fftSize)),
+          bufferTransform  (1, static_cast<int> (fftSize * 2)),
+          inputSpectra   (numInputSegments * numInputs * spectrumStride),
+          impulseSpectra (numSegments * numOutputs * numInputs * spectrumStride)
     {
-        auto FFTSizeDiv2 = fftSize / 2;
+        const auto segmentLength = fftSize - blockSize;
+        const auto numSamples = (size_t) buf.getNumSamples();
+        auto* transformData = bufferTransform.getWritePointer (0);
 
-        for (size_t i = 0; i < FFTSizeDiv2; i++)
-            samples[i] = samples[i << 1];
+        for (size_t segment = 0; segment < numSegments; ++segment)
+        {
+            const auto offset = segment * segmentLength;
+
+            for (size_t output = 0; output < numOutputs; ++output)
+            {
+                for (size_t input = 0; input < numInputs; ++input)
+                {
+                    FloatVectorOperations::clear (transformData, static_cast<int> (fftSize * 2));
+
+                    const auto channel = (int) (output * numInputs + input);
+
+                    if (channel < buf.getNumChannels() && offset < numSamples)
+                        FloatVectorOperations::copy (transformData,
+                                                     buf.getReadPointer (channel, (int) offset),
+                                                     static_cast<int> (jmin (segmentLength, numSamples - offset)));
 
-        samples[FFTSizeDiv2] = 0;
+                    fftObject->performRealOnlyForwardTransform (transformData);
+                    prepareForConvolution (transformData, fftSize);
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
-            samples[i + FFTSizeDiv2] = -samples[((fftSize - i) << 1) + 1];
+                    FloatVectorOperations::copy (getImpulseSpectrum (segment, output, input),
+                                                 transformData,
+                                                 static_cast<int> (fftSize + 1));
+                }
+            }
+        }
+
+        reset();
+    }
+
+    void reset()
+    {
+        bufferInput.clear();
+        bufferOutput.clear();
+        bufferTempOutput.clear();
+        bufferOverlap.clear();
+        std::fill (inputSpectra.begin(), inputSpectra.end(), 0.0f);
+
+        currentSegment = 0;
+        inputDataPos = 0;
     }
 
-    // Does the convolution operation itself only on half of the frequency domain samples.
-    void convolutionProcessingAndAccumulate (const float *input, const float *impulse, float *output)
+    // Input channels that aren't present are treated as silent, and the outputs are
+    // only written once all of the inputs have been read, so the input and output may
+    // refer to the same data.
+    void processSamples (const AudioBlock<const float>& input, const AudioBlock<float>& output)
     {
-        auto FFTSizeDiv2 = fftSize / 2;
+        const auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+        const auto outputsToWrite = jmin (numOutputs, output.getNumChannels());
+
+        for (size_t numSamplesProcessed = 0; numSamplesProcessed < numSamples;)
+        {
+            const bool inputDataWasEmpty = (inputDataPos == 0);
+            const auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputDataPos);
 
-        FloatVectorOperations::addWithMultiply      (output, input, impulse, static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::subtractWithMultiply (output, &(input[FFTSizeDiv2]), &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+            copyInput (input, numSamplesProcessed, numSamplesToProcess);
+            transformInput();
 
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), input, &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), &(input[FFTSizeDiv2]), impulse, static_cast<int> (FFTSizeDiv2));
+            if (inputDataWasEmpty)
+                accumulateOlderSegments();
 
-        output[fftSize] += input[fftSize] * impulse[fftSize];
+            for (size_t channel = 0; channel < numOutputs; ++channel)
+            {
+                auto* outputData = transformOutput (channel);
+                auto* overlapData = bufferOverlap.getReadPointer ((int) channel);
+
+                if (channel < outputsToWrite)
+                    FloatVectorOperations::add (output.getChannelPointer (channel) + numSamplesProcessed,
+                                                outputData + inputDataPos,
+                                                overlapData + inputDataPos,
+                                                (int) numSamplesToProcess);
+            }
+
+            inputDataPos += numSamplesToProcess;
+
+            if (inputDataPos == blockSize)
+                finishBlock();
+
+            numSamplesProcessed += numSamplesToProcess;
+        }
+
+        for (auto channel = outputsToWrite; channel < output.getNumChannels(); ++channel)
+            output.getSingleChannelBlock (channel).clear();
     }
 
-    // Undoes the re-organization of samples from the function prepareForConvolution.
-    // Then takes the conjugate of the frequency domain first half of samples to fill the
-    // second half, so that the inverse transform will return real samples in the time domain.
-    void updateSymmetricFrequencyDomainData (float* samples) noexcept
+    void processSamplesWithAddedLatency (const AudioBlock<const float>& input, const AudioBlock<float>& output)
     {
-        auto FFTSizeDiv2 = fftSize / 2;
+        const auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+        const auto outputsToWrite = jmin (numOutputs, output.getNumChannels());
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
+        for (size_t numSamplesProcessed = 0; numSamplesProcessed < numSamples;)
         {
-            samples[(fftSize - i) << 1] = samples[i];
-            samples[((fftSize - i) << 1) + 1] = -samples[FFTSizeDiv2 + i];
+            const auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputDataPos);
+
+            copyInput (input, numSamplesProcessed, numSamplesToProcess);
+
+            for (size_t channel = 0; channel < outputsToWrite; ++channel)
+                FloatVectorOperations::copy (output.getChannelPointer (channel) + numSamplesProcessed,
+                                             bufferOutput.getReadPointer ((int) channel, (int) inputDataPos),
+                                             (int) numSamplesToProcess);
+
+            numSamplesProcessed += numSamplesToProcess;
+            inputDataPos += numSamplesToProcess;
+
+            if (inputDataPos == blockSize)
+            {
+                transformInput();
+                accumulateOlderSegments();
+
+                for (size_t channel = 0; channel < numOutputs; ++channel)
+                    FloatVectorOperations::add (transformOutput (channel),
+                                                bufferOverlap.getReadPointer ((int) channel),
+                                                static_cast<int> (blockSize));
+
+                finishBlock();
+            }
+        }
+
+        for (auto channel = outputsToWrite; channel < output.getNumChannels(); ++channel)
+            output.getSingleChannelBlock (channel).clear();
+    }
+
+private:
+    float* getInputSpectrum (size_t segment, size_t input) noexcept
+    {
+        return inputSpectra.data() + (segment * numInputs + input) * spectrumStride;
+    }
+
+    float* getImpulseSpectrum (size_t segment, size_t output, size_t input) noexcept
+    {
+        return impulseSpectra.data() + ((segment * numOutputs + output) * numInputs + input) * spectrumStride;
+    }
+
+    void copyInput (const AudioBlock<const float>& input, size_t offset, size_t numSamplesToCopy)
+    {
+        const auto inputsToRead = jmin (numInputs, input.getNumChannels());
+
+        for (size_t channel = 0; channel < inputsToRead; ++channel)
+            FloatVectorOperations::copy (bufferInput.getWritePointer ((int) channel, (int) inputDataPos),
+                                         input.getChannelPointer (channel) + offset,
+                                         static_cast<int> (numSamplesToCopy));
+    }
+
+    // Transforms the current input block of each channel, and stores it in the current segment.
+    void transformInput()
+    {
+        auto* transformData = bufferTransform.getWritePointer (0);
+
+        for (size_t channel = 0; channel < numInputs; ++channel)
+        {
+            FloatVectorOperations::copy (transformData, bufferInput.getReadPointer ((int) channel), static_cast<int> (fftSize));
+
+            fftObject->performRealOnlyForwardTransform (transformData);
+            prepareForConvolution (transformData, fftSize);
+
+            FloatVectorOperations::copy (getInputSpectrum (currentSegment, channel), transformData, static_cast<int> (fftSize + 1));
         }
+    }
 
-        samples[1] = 0.f;
+    // Sums the contributions of every segment apart from the current one, which only
+    // change once per block.
+    void accumulateOlderSegments()
+    {
+        const auto indexStep = numInputSegments / numSegments;
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
+        for (size_t output = 0; output < numOutputs; ++output)
         {
-            samples[i << 1] = samples[(fftSize - i) << 1];
-            samples[(i << 1) + 1] = -samples[((fftSize - i) << 1) + 1];
+            auto* outputTempData = bufferTempOutput.getWritePointer ((int) output);
+            FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
+
+            auto index = currentSegment;
+
+            for (size_t segment = 1; segment < numSegments; ++segment)
+            {
+                index += indexStep;
+
+                if (index >= numInputSegments)
+                    index -= numInputSegments;
+
+                for (size_t input = 0; input < numInputs; ++input)
+                    convolutionProcessingAndAccumulate (getInputSpectrum (index, input),
+                                                        getImpulseSpectrum (segment, output, input),
+                                                        outputTempData,
+                                                        fftSize);
+            }
         }
     }
 
+    // Adds the contribution of the current segment for one output, and returns the
+    // result in the time domain.
+    float* transformOutput (size_t output)
+    {
+        auto* outputData = bufferOutput.getWritePointer ((int) output);
+        FloatVectorOperations::copy (outputData, bufferTempOutput.getReadPointer ((int) output), static_cast<int> (fftSize + 1));
+
+        for (size_t input = 0; input < numInputs; ++input)
+            convolutionProcessingAndAccumulate (getInputSpectrum (currentSegment, input),
+                                                getImpulseSpectrum (0, output, input),
+                                                outputData,
+                                                fftSize);
+
+        updateSymmetricFrequencyDomainData (outputData, fftSize);
+        fftObject->performRealOnlyInverseTransform (outputData);
+        return outputData;
+    }
+
+    void finishBlock()
+    {
+        bufferInput.clear();
+        inputDataPos = 0;
+
+        for (size_t channel = 0; channel < numOutputs; ++channel)
+        {
+            auto* outputData = bufferOutput.getWritePointer ((int) channel);
+            auto* overlapData = bufferOverlap.getWritePointer ((int) channel);
+
+            // Extra step for segSize > blockSize
+            FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
+
+            // Save the overlap
+            FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+        }
+
+        currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+    }
+
     //==============================================================================
+    const size_t numInputs, numOutputs;
     const size_t blockSize;
     const size_t fftSize;
+    const size_t spectrumStride;
     const std::unique_ptr<FFT> fftObject;
     const size_t numSegments;
     const size_t numInputSegments;
     size_t currentSegment = 0, inputDataPos = 0;
 
-    AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
-    std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
+    AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap, bufferTransform;
+    std::vector<float> inputSpectra, impulseSpectra;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MatrixConvolutionEngine)
+};
+
+//==============================================================================
+/*  Convolves a signal with the tail of an impulse response, using a series of
+    uniformly-partitioned stages whose block sizes double from one stage to the next.
+
+    A stage with a block size of L convolves with the part of the IR that starts 2L
+    samples in. Each time the audio thread has collected L new input samples for a
+    stage, it hands them to a worker thread, and the result isn't needed until another
+    L samples have been processed. The worker always runs the pending stage with the
+    earliest deadline. If the worker hasn't started a stage by the time its result is
+    needed, the audio thread will process it instead, so the output is exactly the same
+    as if every stage were processed on the audio thread.
+*/
+class BackgroundTailEngine : private Thread
+{
+public:
+    BackgroundTailEngine (const AudioBuffer<float>& buf, int numChannelsIn, int tailStart)
+        : Thread ("Convolution tail"), numChannels (numChannelsIn)
+    {
+        jassert (isPowerOfTwo (tailStart));
+
+        const auto irSize = buf.getNumSamples();
+
+        for (auto stageBlockSize = tailStart / 2, start = tailStart; start < irSize; stageBlockSize *= 2)
+        {
+            const auto end = stageBlockSize >= maxStageBlockSize ? irSize : jmin (irSize, 2 * start);
+            stages.push_back (std::make_unique<Stage> (buf, numChannels, start, end - start, stageBlockSize));
+            start = end;
+        }
+
+        if (! startRealtimeThread (RealtimeOptions{}))
+            startThread (Priority::highest);
+    }
+
+    ~BackgroundTailEngine() override
+    {
+        stopThread (-1);
+    }
+
+    void reset()
+    {
+        for (auto& stage : stages)
+        {
+            auto expected = Stage::pending;
+
+            if (! stage->state.compare_exchange_strong (expected, Stage::idle))
+                waitUntilIdle (*stage);
+
+            stage->reset();
+        }
+
+        samplesProcessed = 0;
+    }
+
+    // Writes the tail's output for the next block of input to the output block.
+    // The input is read before the output is written, so the two may refer to the same data.
+    void processSamples (const AudioBlock<const float>& input, const AudioBlock<float>& output)
+    {
+        const auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+        const auto channelsToProcess = jmin ((size_t) numChannels, input.getNumChannels(), output.getNumChannels());
+
+        output.clear();
+
+        for (auto& stage : stages)
+        {
+            for (size_t done = 0; done < numSamples;)
+            {
+                const auto numToProcess = jmin (numSamples - done, (size_t) (stage->blockSize - stage->position));
+
+                for (size_t channel = 0; channel < channelsToProcess; ++channel)
+                {
+                    FloatVectorOperations::copy (stage->inputs[(size_t) stage->current].getWritePointer ((int) channel, stage->position),
+                                                 input.getChannelPointer (channel) + done,
+                                                 (int) numToProcess);
+
+                    FloatVectorOperations::add (output.getChannelPointer (channel) + done,
+                                                stage->outputs[(size_t) stage->current].getReadPointer ((int) channel, stage->position),
+                                                (int) numToProcess);
+                }
+
+                stage->position += (int) numToProcess;
+                done += numToProcess;
+
+                if (stage->position == stage->blockSize)
+                    startNextJob (*stage, samplesProcessed + (int64) done);
+            }
+        }
+
+        samplesProcessed += (int64) numSamples;
+    }
+
+private:
+    //==============================================================================
+    struct Stage
+    {
+        enum State { idle, pending, running };
+
+        Stage (const AudioBuffer<float>& buf, int numChannels, int offset, int length, int blockSizeIn)
+            : blockSize (blockSizeIn)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                engines.push_back (std::make_unique<ConvolutionEngine> (buf.getReadPointer (jmin (buf.getNumChannels() - 1, channel), offset),
+                                                                        static_cast<size_t> (length),
+                                                                        static_cast<size_t> (blockSize)));
+
+            for (auto* buffers : { &inputs, &outputs })
+                for (auto& b : *buffers)
+                    b.setSize (numChannels, blockSize);
+
+            reset();
+        }
+
+        void reset()
+        {
+            for (auto& engine : engines)
+                engine->reset();
+
+            for (auto* buffers : { &inputs, &outputs })
+                for (auto& b : *buffers)
+                    b.clear();
+
+            position = current = jobIndex = 0;
+        }
+
+        void process()
+        {
+            auto& input = inputs[(size_t) jobIndex];
+            auto& output = outputs[(size_t) jobIndex];
+
+            for (size_t channel = 0; channel < engines.size(); ++channel)
+                engines[channel]->processSamples (input.getReadPointer ((int) channel),
+                                                  output.getWritePointer ((int) channel),
+                                                  static_cast<size_t> (blockSize));
+        }
+
+        std::vector<std::unique_ptr<ConvolutionEngine>> engines;
+
+        // While the audio thread is filling inputs[current] and playing outputs[current],
+        // the job reads the other input and writes the other output.
+        std::array<AudioBuffer<float>, 2> inputs, outputs;
+
+        const int blockSize;
+        int position = 0, current = 0, jobIndex = 0;
+
+        std::atomic<int64> deadline { 0 };
+        std::atomic<State> state { idle };
+    };
+
+    //==============================================================================
+    void startNextJob (Stage& stage, int64 now)
+    {
+        finishJob (stage);
+
+        stage.jobIndex = stage.current;
+        stage.current ^= 1;
+        stage.position = 0;
+        stage.deadline.store (now + stage.blockSize, std::memory_order_relaxed);
+        stage.state.store (Stage::pending, std::memory_order_release);
+
+        notify();
+    }
+
+    // Called on the audio thread when the result of a stage's job is needed.
+    void finishJob (Stage& stage)
+    {
+        auto expected = Stage::pending;
+
+        if (stage.state.compare_exchange_strong (expected, Stage::running, std::memory_order_acq_rel))
+        {
+            stage.process();
+            stage.state.store (Stage::idle, std::memory_order_release);
+            return;
+        }
+
+        waitUntilIdle (stage);
+    }
+
+    static void waitUntilIdle (const Stage& stage)
+    {
+        while (stage.state.load (std::memory_order_acquire) != Stage::idle)
+            Thread::yield();
+    }
+
+    Stage* claimEarliestJob()
+    {
+        for (;;)
+        {
+            Stage* earliest = nullptr;
+            int64 earliestDeadline = 0;
+
+            for (auto& stage : stages)
+            {
+                if (stage->state.load (std::memory_order_acquire) != Stage::pending)
+                    continue;
+
+                const auto deadline = stage->deadline.load (std::memory_order_relaxed);
+
+                if (earliest == nullptr || deadline < earliestDeadline)
+                {
+                    earliest = stage.get();
+                    earliestDeadline = deadline;
+                }
+            }
+
+            if (earliest == nullptr)
+                return nullptr;
+
+            auto expected = Stage::pending;
+
+            if (earliest->state.compare_exchange_strong (expected, Stage::running, std::memory_order_acq_rel))
+                return earliest;
+        }
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            while (auto* stage = claimEarliestJob())
+            {
+                stage->process();
+                stage->state.store (Stage::idle, std::memory_order_release);
+            }
+
+            wait (-1);
+        }
+    }
+
+    //==============================================================================
+    static constexpr int maxStageBlockSize = 16384;
+
+    std::vector<std::unique_ptr<Stage>> stages;
+    const int numChannels;
+    int64 samplesProcessed = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundTailEngine)
 };
 
 //==============================================================================
@@ -445,8 +966,9 @@ public:
                         int maxBlockSize,
                         int maxBufferSize,
                         Convolution::NonUniform headSizeIn,
-                        bool isZeroDelayIn)
-        : tailBuffer (1, maxBlockSize),
+                        bool isZeroDelayIn,
+                        Convolution::Matrix matrix)
+        : tailBuffer (2, maxBlockSize),
           latency (isZeroDelayIn ? 0 : maxBufferSize),
           irSize (buf.getNumSamples()),
           blockSize (maxBlockSize),
@@ -461,11 +983,31 @@ public:
                                                         static_cast<size_t> (thisBlockSize));
         };
 
-        if (headSizeIn.headSizeInSamples == 0)
+        if (matrix.numInputChannels > 0 && matrix.numOutputChannels > 0)
+        {
+            matrixEngine = std::make_unique<MatrixConvolutionEngine> (buf,
+                                                                      matrix.numInputChannels,
+                                                                      matrix.numOutputChannels,
+                                                                      static_cast<size_t> (maxBufferSize));
+        }
+        else if (headSizeIn.headSizeInSamples == 0)
         {
             for (int i = 0; i < numChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, buf.getNumSamples(), static_cast<uint32> (maxBufferSize)));
         }
+        else if (headSizeIn.processTailInBackground && isZeroDelay)
+        {
+            // The first stage of the tail has a block size of half the head size,
+            // and this must be at least as large as the blocks being processed.
+            const auto backgroundHeadSize = nextPowerOfTwo (jmax (headSizeIn.headSizeInSamples, 2 * maxBufferSize));
+            const auto size = jmin (buf.getNumSamples(), backgroundHeadSize);
+
+            for (int i = 0; i < numChannels; ++i)
+                head.emplace_back (makeEngine (i, 0, size, static_cast<uint32> (maxBufferSize)));
+
+            if (size != buf.getNumSamples())
+                backgroundTail = std::make_unique<BackgroundTailEngine> (buf, numChannels, size);
+        }
         else
         {
             const auto size = jmin (buf.getNumSamples(), headSizeIn.headSizeInSamples);
@@ -488,10 +1030,26 @@ public:
 
         for (const auto& e : tail)
             e->reset();
+
+        if (backgroundTail != nullptr)
+            backgroundTail->reset();
+
+        if (matrixEngine != nullptr)
+            matrixEngine->reset();
     }
 
     void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
     {
+        if (matrixEngine != nullptr)
+        {
+            if (isZeroDelay)
+                matrixEngine->processSamples (input, output);
+            else
+                matrixEngine->processSamplesWithAddedLatency (input, output);
+
+            return;
+        }
+
         const auto numChannels = jmin (head.size(), input.getNumChannels(), output.getNumChannels());
         const auto numSamples  = jmin (input.getNumSamples(), output.getNumSamples());
 
@@ -500,6 +1058,12 @@ public:
 
         const auto isUniform = tail.empty();
 
+        const AudioBlock<float> backgroundTailBlock = tailBlock.getSubsetChannelBlock (0, numChannels);
+
+        if (backgroundTail != nullptr)
+            backgroundTail->processSamples (input.getSubsetChannelBlock (0, numChannels).getSubBlock (0, numSamples),
+                                            backgroundTailBlock);
+
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
             if (! isUniform)
@@ -517,7 +1081,10 @@ public:
                                                                numSamples);
 
             if (! isUniform)
-                output.getSingleChannelBlock (channel) += tailBlock;
+                output.getSingleChannelBlock (channel) += tailBlock.getSingleChannelBlock (0);
+
+            if (backgroundTail != nullptr)
+                output.getSingleChannelBlock (channel).add (backgroundTailBlock.getSingleChannelBlock (channel));
         }
 
         const auto numOutputChannels = output.getNumChannels();
@@ -532,6 +1099,8 @@ public:
 
 private:
     std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
+    std::unique_ptr<BackgroundTailEngine> backgroundTail;
+    std::unique_ptr<MatrixConvolutionEngine> matrixEngine;
     AudioBuffer<float> tailBuffer;
 
     const int latency;
@@ -559,6 +1128,20 @@ static AudioBuffer<float> fixNumChannels (const AudioBuffer<float>& buf, Convolu
     return result;
 }
 
+static AudioBuffer<float> fixNumChannels (const AudioBuffer<float>& buf, Convolution::Matrix matrix)
+{
+    const auto numChannels = jmax (1, matrix.numInputChannels * matrix.numOutputChannels);
+    const auto numSamples = jmax (1, buf.getNumSamples());
+
+    AudioBuffer<float> result (numChannels, numSamples);
+    result.clear();
+
+    for (auto channel = 0; channel != jmin (numChannels, buf.getNumChannels()); ++channel)
+        result.copyFrom (channel, 0, buf.getReadPointer (channel), buf.getNumSamples());
+
+    return result;
+}
+
 static AudioBuffer<float> trimImpulseResponse (const AudioBuffer<float>& buf)
 {
     const auto thresholdTrim = Decibels::decibelsToGain (-80.0f);
@@ -731,7 +1314,8 @@ public:
     ConvolutionEngineFactory (Convolution::Latency requiredLatency,
                               Convolution::NonUniform requiredHeadSize)
         : latency  { (requiredLatency.latencyInSamples   <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredLatency.latencyInSamples)) },
-          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)) },
+          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)),
+                     requiredHeadSize.processTailInBackground },
           shouldBeZeroLatency (requiredLatency.latencyInSamples == 0)
     {}
 
@@ -755,6 +1339,7 @@ public:
         const std::lock_guard<std::mutex> lock (mutex);
         wantsNormalise = normalise;
         originalSampleRate = buf.sampleRate;
+        matrix = {};
 
         impulseResponse = [&]
         {
@@ -765,6 +1350,27 @@ public:
         engine.set (makeEngine());
     }
 
+    // It is safe to call this method simultaneously with other public
+    // member functions.
+    void setImpulseResponse (BufferWithSampleRate&& buf,
+                             Convolution::Matrix newMatrix,
+                             Convolution::Trim trim,
+                             Convolution::Normalise normalise)
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        wantsNormalise = normalise;
+        originalSampleRate = buf.sampleRate;
+        matrix = newMatrix;
+
+        impulseResponse = [&]
+        {
+            auto corrected = fixNumChannels (buf.buffer, newMatrix);
+            return trim == Convolution::Trim::yes ? trimImpulseResponse (corrected) : corrected;
+        }();
+
+        engine.set (makeEngine());
+    }
+
     // Returns the most recently-created engine, or nullptr
     // if there is no pending engine, or if the engine is currently
     // being updated by one of the setter methods.
@@ -790,7 +1396,8 @@ private:
                                                      processSpec.maximumBlockSize,
                                                      maxBufferSize,
                                                      headSize,
-                                                     shouldBeZeroLatency);
+                                                     shouldBeZeroLatency,
+                                                     matrix);
     }
 
     static AudioBuffer<float> makeImpulseBuffer()
@@ -804,6 +1411,7 @@ private:
     AudioBuffer<float> impulseResponse = makeImpulseBuffer();
     double originalSampleRate = processSpec.sampleRate;
     Convolution::Normalise wantsNormalise = Convolution::Normalise::no;
+    Convolution::Matrix matrix {};
     const Convolution::Latency latency;
     const Convolution::NonUniform headSize;
     const bool shouldBeZeroLatency;
@@ -863,6 +1471,18 @@ public:
         });
     }
 
+    void loadImpulseResponse (AudioBuffer<float>&& buffer,
+                              double sr,
+                              Convolution::Matrix matrix,
+                              Convolution::Trim trim,
+                              Convolution::Normalise normalise)
+    {
+        callLater ([b = std::move (buffer), sr, matrix, trim, normalise] (ConvolutionEngineFactory& f) mutable
+        {
+            f.setImpulseResponse ({ std::move (b), sr }, matrix, trim, normalise);
+        });
+    }
+
     void loadImpulseResponse (const void* sourceData,
                               size_t sourceDataSize,
                               Convolution::Stereo stereo,
@@ -1079,6 +1699,15 @@ public:
         engineQueue->loadImpulseResponse (std::move (buffer), originalSampleRate, stereo, trim, normalise);
     }
 
+    void loadImpulseResponse (AudioBuffer<float>&& buffer,
+                              double originalSampleRate,
+                              Matrix matrix,
+                              Trim trim,
+                              Normalise normalise)
+    {
+        engineQueue->loadImpulseResponse (std::move (buffer), originalSampleRate, matrix, trim, normalise);
+    }
+
     void loadImpulseResponse (const void* sourceData,
                               size_t sourceDataSize,
                               Stereo stereo,
@@ -1129,6 +1758,11 @@ private:
 //==============================================================================
 void Convolution::Mixer::prepare (const ProcessSpec& spec)
 {
+    const auto numChannels = jmax (1u, spec.numChannels);
+
+    volumeDry.resize (numChannels);
+    volumeWet.resize (numChannels);
+
     for (auto& dry : volumeDry)
         dry.reset (spec.sampleRate, 0.05);
 
@@ -1138,7 +1772,7 @@ void Convolution::Mixer::prepare (const ProcessSpec& spec)
     sampleRate = spec.sampleRate;
 
     dryBlock = AudioBlock<float> (dryBlockStorage,
-                                  jmin (spec.numChannels, 2u),
+                                  numChannels,
                                   spec.maximumBlockSize);
 
 }
@@ -1258,6 +1892,15 @@ void Convolution::loadImpulseResponse (AudioBuffer<float>&& buffer,
     pimpl->loadImpulseResponse (std::move (buffer), originalSampleRate, stereo, trim, normalise);
 }
 
+void Convolution::loadImpulseResponse (AudioBuffer<float>&& buffer,
+                                       double originalSampleRate,
+                                       Matrix matrix,
+                                       Trim trim,
+                                       Normalise normalise)
+{
+    pimpl->loadImpulseResponse (std::move (buffer), originalSampleRate, matrix, trim, normalise);
+}
+
 void Convolution::prepare (const ProcessSpec& spec)
 {
     mixer.prepare (spec);
@@ -1278,8 +1921,8 @@ void Convolution::processSamples (const AudioBlock<const float>& input,
     if (! isActive)
         return;
 
+    // Channels beyond the first two will only be processed if a matrix IR has been loaded
     jassert (input.getNumChannels() == output.getNumChannels());
-    jassert (isPositiveAndBelow (input.getNumChannels(), static_cast<size_t> (3))); // only mono and stereo is supported
 
     mixer.processSamples (input, output, isBypassed, [this] (const auto& in, auto& out)
     {
@@ -1291,4 +1934,37 @@ int Convolution::getCurrentIRSize() const { return pimpl->getCurrentIRSize(); }
 
 int Convolution::getLatency() const { return pimpl->getLatency(); }
 
+//==============================================================================
+// FIR::Filter's FFT mode is implemented here so that it can share the ConvolutionEngine
+struct FIR::PartitionedConvolver::Impl
+{
+    Impl (const float* coefficients, size_t numCoefficients, size_t partitionSize)
+        : engine (coefficients, numCoefficients, partitionSize)
+    {}
+
+    ConvolutionEngine engine;
+};
+
+FIR::PartitionedConvolver::PartitionedConvolver (const float* coefficients, size_t numCoefficients, size_t partitionSize)
+    : impl (std::make_unique<Impl> (coefficients, numCoefficients, partitionSize))
+{
+}
+
+FIR::PartitionedConvolver::~PartitionedConvolver() = default;
+
+void FIR::PartitionedConvolver::reset()
+{
+    impl->engine.reset();
+}
+
+void FIR::PartitionedConvolver::process (const float* input, float* output, size_t numSamples) noexcept
+{
+    impl->engine.processSamplesWithAddedLatency (input, output, numSamples);
+}
+
+size_t FIR::PartitionedConvolver::getLatencyInSamples() const noexcept
+{
+    return impl->engine.blockSize;
+}
+
 } // namespace juce::dsp
@@ -70,6 +70,8 @@ private:
 /**
     Performs stereo partitioned convolution of an input signal with an
     impulse response in the frequency domain, using the JUCE FFT class.
+    It can also convolve several input channels with a matrix of impulse
+    responses, for true-stereo or ambisonic reverbs.
 
     This class provides some thread-safe functions to load impulse responses
     from audio files or memory on-the-fly without noticeable artefacts,
@@ -128,8 +130,21 @@ public:
     */
     explicit Convolution (const Latency& requiredLatency);
 
-    /** Contains configuration information for a non-uniform convolution. */
-    struct NonUniform { int headSizeInSamples; };
+    /** Contains configuration information for a non-uniform convolution.
+
+        If processTailInBackground is true, the part of the impulse response after
+        the head is split into partitions that double in size, and these are
+        processed on a separate worker thread, some time before their output is
+        needed. Only the head is processed on the audio thread, so this greatly
+        reduces the peak CPU load of the audio thread for very long IRs (several
+        seconds or more). The output is still produced with zero latency. In this
+        mode, the head will be at least twice the maximum block size.
+    */
+    struct NonUniform
+    {
+        int headSizeInSamples;
+        bool processTailInBackground = false;
+    };
 
     /** Initialises an object for performing convolution in the frequency domain
         using a non-uniform partitioned algorithm.
@@ -138,6 +153,8 @@ public:
         efficiency of the processing for IR sizes of 4096 samples or greater
         (recommended for reverberation IRs).
 
+        For very long IRs, consider setting processTailInBackground to true.
+
         @param requiredHeadSize       the head IR size for two stage non-uniform
                                       partitioned convolution
      */
@@ -193,6 +210,12 @@ public:
     enum class Trim      { no, yes };
     enum class Normalise { no, yes };
 
+    /** Describes the shape of a matrix of impulse responses.
+
+        @see loadImpulseResponse
+    */
+    struct Matrix { int numInputChannels, numOutputChannels; };
+
     //==============================================================================
     /** This function loads an impulse response audio file from memory, added in a
         JUCE project with the Projucer as binary data. It can load any of the audio
@@ -252,6 +275,36 @@ public:
     void loadImpulseResponse (AudioBuffer<float>&& buffer, double bufferSampleRate,
                               Stereo isStereo, Trim requiresTrimming, Normalise requiresNormalisation);
 
+    /** This function loads a matrix of impulse responses from an audio buffer.
+
+        Each output channel will be the sum of every input channel convolved with the
+        impulse response for that pair of channels. The buffer should contain
+        numInputChannels * numOutputChannels channels, where channel
+        (output * numInputChannels + input) holds the impulse response from that input
+        to that output. Any missing channels will be treated as silent. For example, a
+        true-stereo reverb would use a 2x2 matrix, and a first-order ambisonic reverb
+        would use a 4x4 matrix.
+
+        Each input channel is only transformed once per block, however many outputs it
+        feeds, so this is much cheaper than using a separate Convolution for each pair
+        of channels. Matrix impulse responses are always processed with a uniform
+        partitioned algorithm, even if this Convolution was created with a NonUniform
+        configuration. The input and output blocks passed to process() should have the
+        same number of channels, which should be at least as large as the larger side
+        of the matrix.
+
+        The same rules about ownership and threading apply as for the other overload
+        taking an AudioBuffer.
+
+        @param buffer                   the AudioBuffer to use
+        @param bufferSampleRate         the sampleRate of the data in the AudioBuffer
+        @param matrix                   the number of input and output channels
+        @param requiresTrimming         optionally trim the start and the end of the impulse response
+        @param requiresNormalisation    optionally normalise the impulse response amplitude
+    */
+    void loadImpulseResponse (AudioBuffer<float>&& buffer, double bufferSampleRate,
+                              Matrix matrix, Trim requiresTrimming, Normalise requiresNormalisation);
+
     /** This function returns the size of the current IR in samples. */
     int getCurrentIRSize() const;
 
@@ -285,7 +338,7 @@ private:
         void reset();
 
     private:
-        std::array<SmoothedValue<float>, 2> volumeDry, volumeWet;
+        std::vector<SmoothedValue<float>> volumeDry, volumeWet;
         AudioBlock<float> dryBlock;
         HeapBlock<char> dryBlockStorage;
         double sampleRate = 0;
@@ -546,6 +546,137 @@ public:
             }
         }
 
+        beginTest ("Non-uniform convolutions with a background tail work");
+        {
+            const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 80);
+
+            for (auto headSize : { spec.maximumBlockSize / 2, spec.maximumBlockSize * 4 })
+            {
+                testConvolution (spec,
+                                 Convolution::NonUniform { static_cast<int> (headSize), true },
+                                 ramp,
+                                 spec.sampleRate,
+                                 Convolution::Stereo::yes,
+                                 Convolution::Trim::yes,
+                                 Convolution::Normalise::no,
+                                 ramp);
+            }
+        }
+
+        beginTest ("Background tails match the foreground engine for head sizes that aren't powers of two");
+        {
+            constexpr auto irLength = 6000;
+            constexpr auto signalLength = 16384;
+            const ProcessSpec stereoSpec { 44100.0, 256, 2 };
+
+            Random random;
+            AudioBuffer<float> ir (2, irLength), signal (2, signalLength);
+
+            for (auto* buf : { &ir, &signal })
+                for (auto channel = 0; channel != buf->getNumChannels(); ++channel)
+                    for (auto sample = 0; sample != buf->getNumSamples(); ++sample)
+                        buf->setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+            const auto render = [&] (Convolution::NonUniform headSize)
+            {
+                Convolution convolution (headSize);
+
+                auto copiedIr = ir;
+                convolution.loadImpulseResponse (std::move (copiedIr),
+                                                 stereoSpec.sampleRate,
+                                                 Convolution::Stereo::yes,
+                                                 Convolution::Trim::no,
+                                                 Convolution::Normalise::no);
+                convolution.prepare (stereoSpec);
+
+                auto processed = signal;
+
+                for (auto start = 0; start < signalLength; start += (int) stereoSpec.maximumBlockSize)
+                {
+                    auto processBlock = AudioBlock<float> (processed).getSubBlock ((size_t) start, stereoSpec.maximumBlockSize);
+                    convolution.process (ProcessContextReplacing<float> (processBlock));
+                }
+
+                return processed;
+            };
+
+            for (const auto headSize : { 300, 1000 })
+            {
+                const auto foreground = render (Convolution::NonUniform { headSize, false });
+                const auto background = render (Convolution::NonUniform { headSize, true });
+
+                auto maxError = 0.0f;
+
+                for (auto channel = 0; channel != 2; ++channel)
+                    for (auto n = 0; n != signalLength; ++n)
+                        maxError = jmax (maxError, std::abs (background.getSample (channel, n) - foreground.getSample (channel, n)));
+
+                expect (maxError < 1.0e-3f, "Maximum error was " + String (maxError));
+                expect (foreground.getMagnitude (0, signalLength) > 1.0f);
+            }
+        }
+
+        beginTest ("Matrix convolutions match direct convolution");
+        {
+            constexpr auto numChannels = 4;
+            constexpr auto irLength = 700;
+            constexpr auto signalLength = 4096;
+
+            Random random;
+
+            AudioBuffer<float> irs (numChannels * numChannels, irLength);
+            AudioBuffer<float> signal (numChannels, signalLength);
+
+            for (auto* buf : { &irs, &signal })
+                for (auto channel = 0; channel != buf->getNumChannels(); ++channel)
+                    for (auto sample = 0; sample != buf->getNumSamples(); ++sample)
+                        buf->setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+            AudioBuffer<float> expected (numChannels, signalLength);
+            expected.clear();
+
+            for (auto output = 0; output != numChannels; ++output)
+                for (auto input = 0; input != numChannels; ++input)
+                    for (auto n = 0; n != signalLength; ++n)
+                        for (auto k = 0; k <= jmin (n, irLength - 1); ++k)
+                            expected.addSample (output, n, irs.getSample (output * numChannels + input, k) * signal.getSample (input, n - k));
+
+            const ProcessSpec matrixSpec { 44100.0, 256, (uint32) numChannels };
+
+            for (const auto latency : { 0, 256 })
+            {
+                Convolution convolution (Convolution::Latency { latency });
+
+                auto copiedIrs = irs;
+                convolution.loadImpulseResponse (std::move (copiedIrs),
+                                                 matrixSpec.sampleRate,
+                                                 Convolution::Matrix { numChannels, numChannels },
+                                                 Convolution::Trim::no,
+                                                 Convolution::Normalise::no);
+                convolution.prepare (matrixSpec);
+
+                const auto actualLatency = convolution.getLatency();
+                expect (actualLatency >= latency);
+
+                auto processed = signal;
+
+                for (auto start = 0, blockLength = 1; start < signalLength; start += blockLength, blockLength = (blockLength * 7) % 256 + 1)
+                {
+                    const auto length = jmin (blockLength, signalLength - start);
+                    auto processBlock = AudioBlock<float> (processed).getSubBlock ((size_t) start, (size_t) length);
+                    convolution.process (ProcessContextReplacing<float> (processBlock));
+                }
+
+                auto maxError = 0.0f;
+
+                for (auto channel = 0; channel != numChannels; ++channel)
+                    for (auto n = actualLatency; n != signalLength; ++n)
+                        maxError = jmax (maxError, std::abs (processed.getSample (channel, n) - expected.getSample (channel, n - actualLatency)));
+
+                expect (maxError < 1.0e-3f, "Maximum error was " + String (maxError));
+            }
+        }
+
         beginTest ("Convolutions with latency work");
         {
             const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 8);
@@ -572,6 +703,63 @@ public:
 
 ConvolutionTest convolutionUnitTest;
 
+//==============================================================================
+class ConvolutionBenchmark final : public Benchmark
+{
+public:
+    ConvolutionBenchmark()
+        : Benchmark ("Convolution", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        constexpr auto sampleRate = 48000.0;
+        constexpr auto blockSize = 512;
+        const ProcessSpec spec { sampleRate, (uint32) blockSize, 2 };
+
+        AudioBuffer<float> ir (2, (int) sampleRate);
+        AudioBuffer<float> buffer (2, blockSize);
+        auto random = getRandom();
+
+        for (auto* b : { &ir, &buffer })
+            for (int ch = 0; ch < b->getNumChannels(); ++ch)
+                for (int i = 0; i < b->getNumSamples(); ++i)
+                    b->setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        ir.applyGainRamp (0, ir.getNumSamples(), 1.0f, 0.0f);
+
+        auto measureConvolution = [&] (const String& caseName, Convolution& convolution)
+        {
+            auto copy = ir;
+            convolution.loadImpulseResponse (std::move (copy), sampleRate,
+                                             Convolution::Stereo::yes, Convolution::Trim::no, Convolution::Normalise::no);
+            convolution.prepare (spec);
+
+            AudioBlock<float> block (buffer);
+
+            measure (caseName, [&]
+            {
+                convolution.process (ProcessContextReplacing<float> (block));
+                doNotOptimise (buffer.getSample (0, 0));
+            });
+        };
+
+        beginTest ("Stereo, one second impulse response");
+
+        {
+            Convolution uniform;
+            measureConvolution ("uniform, 512 sample blocks", uniform);
+        }
+
+        {
+            Convolution nonUniform (Convolution::NonUniform { 256 });
+            measureConvolution ("non-uniform, 256 sample head, 512 sample blocks", nonUniform);
+        }
+    }
+};
+
+ConvolutionBenchmark convolutionBenchmark;
+
 }
 } // namespace juce::dsp
 
@@ -32,6 +32,26 @@ struct FFT::Instance
     virtual void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept = 0;
     virtual void performRealOnlyForwardTransform (float*, bool) const noexcept = 0;
     virtual void performRealOnlyInverseTransform (float*) const noexcept = 0;
+
+    // Engines that can transform several frames in one call should override these
+    virtual void performBatch (const Complex<float>* input, Complex<float>* output,
+                               int numFrames, int frameStride, bool inverse) const noexcept
+    {
+        for (int i = 0; i < numFrames; ++i)
+            perform (input + i * frameStride, output + i * frameStride, inverse);
+    }
+
+    virtual void performRealOnlyForwardTransformBatch (float* d, int numFrames, int frameStride, bool ignoreNegativeFreqs) const noexcept
+    {
+        for (int i = 0; i < numFrames; ++i)
+            performRealOnlyForwardTransform (d + i * frameStride, ignoreNegativeFreqs);
+    }
+
+    virtual void performRealOnlyInverseTransformBatch (float* d, int numFrames, int frameStride) const noexcept
+    {
+        for (int i = 0; i < numFrames; ++i)
+            performRealOnlyInverseTransform (d + i * frameStride);
+    }
 };
 
 struct FFT::Engine
@@ -429,6 +449,303 @@ struct FFTFallback final : public FFT::Instance
 
 FFT::EngineImpl<FFTFallback> fftFallback;
 
+//==============================================================================
+//==============================================================================
+#if JUCE_USE_SIMD
+struct SIMDFFT final : public FFT::Instance
+{
+    // faster than the fallback, but not as fast as any of the platform-specific engines
+    static constexpr int priority = 0;
+
+    static SIMDFFT* create (int order)
+    {
+        return new SIMDFFT (order);
+    }
+
+    SIMDFFT (int order)
+        : size (1 << order),
+          complexPlan (size),
+          halfSizePlan (jmax (1, size / 2)),
+          realTwiddles ((size_t) (size / 2 + 1))
+    {
+        // These are used to combine (or split) the spectra of the even and odd samples
+        // of a real signal, which are transformed together as one complex signal.
+        for (int i = 0; i <= size / 2; ++i)
+        {
+            const auto phase = -2.0 * MathConstants<double>::pi * (double) i / (double) size;
+            realTwiddles[i] = { (float) std::cos (phase), (float) std::sin (phase) };
+        }
+    }
+
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
+    {
+        withScratch (size, [&] (float* re, float* im)
+        {
+            // The inverse transform is the conjugate of the forward transform of the conjugate
+            const auto sign = inverse ? -1.0f : 1.0f;
+            const auto scale = inverse ? 1.0f / (float) size : 1.0f;
+
+            for (int i = 0; i < size; ++i)
+            {
+                const auto index = complexPlan.bitReversed[i];
+                re[index] = input[i].real();
+                im[index] = input[i].imag() * sign;
+            }
+
+            complexPlan.perform (re, im);
+
+            for (int i = 0; i < size; ++i)
+                output[i] = { re[i] * scale, im[i] * sign * scale };
+        });
+    }
+
+    void performRealOnlyForwardTransform (float* d, bool ignoreNegativeFreqs) const noexcept override
+    {
+        if (size == 1)
+        {
+            d[1] = 0.0f;
+            return;
+        }
+
+        const auto halfSize = size / 2;
+
+        withScratch (halfSize, [&] (float* re, float* im)
+        {
+            // The even samples are treated as the real part of a signal of half the
+            // length, and the odd samples as the imaginary part.
+            for (int i = 0; i < halfSize; ++i)
+            {
+                const auto index = halfSizePlan.bitReversed[i];
+                re[index] = d[2 * i];
+                im[index] = d[2 * i + 1];
+            }
+
+            halfSizePlan.perform (re, im);
+
+            auto* out = reinterpret_cast<Complex<float>*> (d);
+
+            for (int i = 0; i <= halfSize; ++i)
+            {
+                const auto a = i % halfSize;
+                const auto b = (halfSize - i) % halfSize;
+
+                const Complex<float> z  { re[a],  im[a] };
+                const Complex<float> zc { re[b], -im[b] };
+
+                const auto even = (z + zc) * 0.5f;
+                const auto odd  = Complex<float> { 0.0f, -0.5f } * (z - zc);
+
+                out[i] = even + realTwiddles[i] * odd;
+            }
+
+            out[0].imag (0.0f);
+            out[halfSize].imag (0.0f);
+
+            if (! ignoreNegativeFreqs)
+                for (int i = halfSize + 1; i < size; ++i)
+                    out[i] = std::conj (out[size - i]);
+        });
+    }
+
+    void performRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        if (size == 1)
+        {
+            d[1] = 0.0f;
+            return;
+        }
+
+        const auto halfSize = size / 2;
+
+        withScratch (halfSize, [&] (float* re, float* im)
+        {
+            const auto* in = reinterpret_cast<const Complex<float>*> (d);
+
+            // Rebuilds the spectrum of the half-length complex signal, conjugated
+            // so that the forward plan can be used to perform the inverse transform.
+            for (int i = 0; i < halfSize; ++i)
+            {
+                const auto x  = in[i];
+                const auto xc = std::conj (in[halfSize - i]);
+
+                const auto even = (x + xc) * 0.5f;
+                const auto odd  = std::conj (realTwiddles[i]) * (x - xc) * 0.5f;
+                const auto z    = even + Complex<float> { 0.0f, 1.0f } * odd;
+
+                const auto index = halfSizePlan.bitReversed[i];
+                re[index] =  z.real();
+                im[index] = -z.imag();
+            }
+
+            halfSizePlan.perform (re, im);
+
+            const auto scale = 1.0f / (float) halfSize;
+
+            for (int i = 0; i < halfSize; ++i)
+            {
+                d[2 * i]     =  re[i] * scale;
+                d[2 * i + 1] = -im[i] * scale;
+            }
+
+            std::fill (d + size, d + 2 * size, 0.0f);
+        });
+    }
+
+private:
+    using Vector = SIMDRegister<float>;
+    static constexpr auto vectorSize = (int) Vector::size();
+
+    static int roundUpToVectorSize (int n) noexcept
+    {
+        return (n + vectorSize - 1) / vectorSize * vectorSize;
+    }
+
+    // Calls fn with two aligned scratch arrays that can each hold n floats, one for the real
+    // parts and one for the imaginary parts of the data being transformed.
+    template <typename Fn>
+    static void withScratch (int n, Fn&& fn) noexcept
+    {
+        const auto stride = roundUpToVectorSize (n);
+        const auto scratchSize = (size_t) (2 * stride + vectorSize) * sizeof (float);
+
+        if (scratchSize < maxFFTScratchSpaceToAlloca)
+        {
+            JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6255)
+            auto* re = Vector::getNextSIMDAlignedPtr (static_cast<float*> (alloca (scratchSize)));
+            JUCE_END_IGNORE_WARNINGS_MSVC
+            fn (re, re + stride);
+        }
+        else
+        {
+            HeapBlock<float> heapSpace (scratchSize / sizeof (float));
+            auto* re = Vector::getNextSIMDAlignedPtr (heapSpace.getData());
+            fn (re, re + stride);
+        }
+    }
+
+    //==============================================================================
+    // An iterative radix-2 complex transform, working on separate arrays of real and
+    // imaginary parts. Every stage apart from the first few processes a whole SIMD
+    // register of butterflies at a time.
+    struct Plan
+    {
+        explicit Plan (int sizeIn)
+            : planSize (sizeIn),
+              bitReversed ((size_t) sizeIn),
+              twiddleStorage ((size_t) (2 * roundUpToVectorSize (sizeIn) + vectorSize))
+        {
+            const auto numBits = roundToInt (std::log2 (planSize));
+
+            for (int i = 0; i < planSize; ++i)
+            {
+                int reversed = 0;
+
+                for (int bit = 0; bit < numBits; ++bit)
+                    reversed |= ((i >> bit) & 1) << (numBits - 1 - bit);
+
+                bitReversed[i] = reversed;
+            }
+
+            // The twiddles for the stage that combines transforms of length n into
+            // transforms of length 2n are stored contiguously, starting at index n.
+            twiddleReal = Vector::getNextSIMDAlignedPtr (twiddleStorage.getData());
+            twiddleImag = twiddleReal + roundUpToVectorSize (planSize);
+
+            for (int n = 1; n < planSize; n *= 2)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    const auto phase = -MathConstants<double>::pi * (double) i / (double) n;
+                    twiddleReal[n + i] = (float) std::cos (phase);
+                    twiddleImag[n + i] = (float) std::sin (phase);
+                }
+            }
+        }
+
+        // Expects the input to be in bit-reversed order already.
+        void perform (float* re, float* im) const noexcept
+        {
+            for (int n = 1; n < planSize; n *= 2)
+            {
+                if (n < vectorSize)
+                    performScalarStage (re, im, n);
+                else
+                    performVectorStage (re, im, n);
+            }
+        }
+
+        void performScalarStage (float* re, float* im, int n) const noexcept
+        {
+            for (int start = 0; start < planSize; start += 2 * n)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    const auto a = start + i;
+                    const auto b = a + n;
+
+                    const auto wr = twiddleReal[n + i];
+                    const auto wi = twiddleImag[n + i];
+
+                    const auto tr = re[b] * wr - im[b] * wi;
+                    const auto ti = re[b] * wi + im[b] * wr;
+
+                    re[b] = re[a] - tr;
+                    im[b] = im[a] - ti;
+                    re[a] += tr;
+                    im[a] += ti;
+                }
+            }
+        }
+
+        void performVectorStage (float* re, float* im, int n) const noexcept
+        {
+            for (int start = 0; start < planSize; start += 2 * n)
+            {
+                for (int i = 0; i < n; i += vectorSize)
+                {
+                    const auto a = start + i;
+                    const auto b = a + n;
+
+                    const auto wr = Vector::fromRawArray (twiddleReal + n + i);
+                    const auto wi = Vector::fromRawArray (twiddleImag + n + i);
+
+                    const auto br = Vector::fromRawArray (re + b);
+                    const auto bi = Vector::fromRawArray (im + b);
+
+                    const auto tr = br * wr - bi * wi;
+                    const auto ti = br * wi + bi * wr;
+
+                    const auto ar = Vector::fromRawArray (re + a);
+                    const auto ai = Vector::fromRawArray (im + a);
+
+                    (ar - tr).copyToRawArray (re + b);
+                    (ai - ti).copyToRawArray (im + b);
+                    (ar + tr).copyToRawArray (re + a);
+                    (ai + ti).copyToRawArray (im + a);
+                }
+            }
+        }
+
+        const int planSize;
+        HeapBlock<int> bitReversed;
+        HeapBlock<float> twiddleStorage;
+        float* twiddleReal = nullptr;
+        float* twiddleImag = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Plan)
+    };
+
+    //==============================================================================
+    static constexpr size_t maxFFTScratchSpaceToAlloca = 256 * 1024;
+
+    const int size;
+    const Plan complexPlan, halfSizePlan;
+    HeapBlock<Complex<float>> realTwiddles;
+};
+
+FFT::EngineImpl<SIMDFFT> simdFFT;
+#endif
+
 //==============================================================================
 //==============================================================================
 #if (JUCE_MAC || JUCE_IOS) && JUCE_USE_VDSP_FRAMEWORK
@@ -550,6 +867,9 @@ extern "C"
     void fftwf_execute_dft      (void*, void*, void*);
     void fftwf_execute_dft_r2c  (void*, void*, void*);
     void fftwf_execute_dft_c2r  (void*, void*, void*);
+    void* fftwf_plan_many_dft     (int, const int*, int, void*, const int*, int, int, void*, const int*, int, int, int, unsigned);
+    void* fftwf_plan_many_dft_r2c (int, const int*, int, void*, const int*, int, int, void*, const int*, int, int, unsigned);
+    void* fftwf_plan_many_dft_c2r (int, const int*, int, void*, const int*, int, int, void*, const int*, int, int, unsigned);
 }
 #endif
 
@@ -584,6 +904,14 @@ struct FFTWImpl  : public FFT::Instance
         void (*execute_r2c_fftw) (FFTWPlanRef, float*, Complex<float>*);
         void (*execute_c2r_fftw) (FFTWPlanRef, Complex<float>*, float*);
 
+        // These are optional: if they're missing, batches are transformed one frame at a time
+        FFTWPlanRef (*plan_many_dft_fftw) (int, const int*, int, Complex<float>*, const int*, int, int,
+                                           Complex<float>*, const int*, int, int, int, unsigned) = nullptr;
+        FFTWPlanRef (*plan_many_r2c_fftw) (int, const int*, int, float*, const int*, int, int,
+                                           Complex<float>*, const int*, int, int, unsigned) = nullptr;
+        FFTWPlanRef (*plan_many_c2r_fftw) (int, const int*, int, Complex<float>*, const int*, int, int,
+                                           float*, const int*, int, int, unsigned) = nullptr;
+
        #if JUCE_DSP_USE_STATIC_FFTW
         template <typename FuncPtr, typename ActualSymbolType>
         static bool symbol (FuncPtr& dst, ActualSymbolType sym)
@@ -628,6 +956,10 @@ struct FFTWImpl  : public FFT::Instance
             if (! Symbols::symbol (symbols.execute_dft_fftw, fftwf_execute_dft))     return nullptr;
             if (! Symbols::symbol (symbols.execute_r2c_fftw, fftwf_execute_dft_r2c)) return nullptr;
             if (! Symbols::symbol (symbols.execute_c2r_fftw, fftwf_execute_dft_c2r)) return nullptr;
+
+            Symbols::symbol (symbols.plan_many_dft_fftw, fftwf_plan_many_dft);
+            Symbols::symbol (symbols.plan_many_r2c_fftw, fftwf_plan_many_dft_r2c);
+            Symbols::symbol (symbols.plan_many_c2r_fftw, fftwf_plan_many_dft_c2r);
            #else
             if (! Symbols::symbol (lib, symbols.plan_dft_fftw, "fftwf_plan_dft_1d"))     return nullptr;
             if (! Symbols::symbol (lib, symbols.plan_r2c_fftw, "fftwf_plan_dft_r2c_1d")) return nullptr;
@@ -637,6 +969,10 @@ struct FFTWImpl  : public FFT::Instance
             if (! Symbols::symbol (lib, symbols.execute_dft_fftw, "fftwf_execute_dft"))     return nullptr;
             if (! Symbols::symbol (lib, symbols.execute_r2c_fftw, "fftwf_execute_dft_r2c")) return nullptr;
             if (! Symbols::symbol (lib, symbols.execute_c2r_fftw, "fftwf_execute_dft_c2r")) return nullptr;
+
+            Symbols::symbol (lib, symbols.plan_many_dft_fftw, "fftwf_plan_many_dft");
+            Symbols::symbol (lib, symbols.plan_many_r2c_fftw, "fftwf_plan_many_dft_r2c");
+            Symbols::symbol (lib, symbols.plan_many_c2r_fftw, "fftwf_plan_many_dft_c2r");
            #endif
 
             return new FFTWImpl (static_cast<size_t> (order), std::move (lib), symbols);
@@ -668,6 +1004,9 @@ struct FFTWImpl  : public FFT::Instance
         fftw.destroy_fftw (c2cInverse);
         fftw.destroy_fftw (r2c);
         fftw.destroy_fftw (c2r);
+
+        for (auto& batchPlan : batchPlans)
+            fftw.destroy_fftw (batchPlan.plan);
     }
 
     void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
@@ -708,6 +1047,145 @@ struct FFTWImpl  : public FFT::Instance
         FloatVectorOperations::multiply ((float*) inputOutputData, 1.0f / static_cast<float> (n), (int) n);
     }
 
+    void performBatch (const Complex<float>* input, Complex<float>* output,
+                       int numFrames, int frameStride, bool inverse) const noexcept override
+    {
+        const auto kind = inverse ? BatchPlan::c2cInverse : BatchPlan::c2cForward;
+
+        if (auto plan = getBatchPlan (kind, numFrames, frameStride, const_cast<Complex<float>*> (input), output))
+        {
+            fftw.execute_dft_fftw (plan, input, output);
+
+            if (inverse)
+            {
+                auto n = (1u << order);
+
+                for (int i = 0; i < numFrames; ++i)
+                    FloatVectorOperations::multiply ((float*) (output + i * frameStride), 1.0f / static_cast<float> (n), (int) n << 1);
+            }
+
+            return;
+        }
+
+        FFT::Instance::performBatch (input, output, numFrames, frameStride, inverse);
+    }
+
+    void performRealOnlyForwardTransformBatch (float* d, int numFrames, int frameStride, bool ignoreNegativeFreqs) const noexcept override
+    {
+        if (order == 0)
+            return;
+
+        if (auto plan = getBatchPlan (BatchPlan::r2c, numFrames, frameStride, d, d))
+        {
+            fftw.execute_r2c_fftw (plan, d, reinterpret_cast<Complex<float>*> (d));
+
+            if (! ignoreNegativeFreqs)
+            {
+                auto size = (1 << order);
+
+                for (int frame = 0; frame < numFrames; ++frame)
+                {
+                    auto* out = reinterpret_cast<Complex<float>*> (d + frame * frameStride);
+
+                    for (int i = size >> 1; i < size; ++i)
+                        out[i] = std::conj (out[size - i]);
+                }
+            }
+
+            return;
+        }
+
+        FFT::Instance::performRealOnlyForwardTransformBatch (d, numFrames, frameStride, ignoreNegativeFreqs);
+    }
+
+    void performRealOnlyInverseTransformBatch (float* d, int numFrames, int frameStride) const noexcept override
+    {
+        if (auto plan = getBatchPlan (BatchPlan::c2r, numFrames, frameStride, d, d))
+        {
+            auto n = (1u << order);
+
+            fftw.execute_c2r_fftw (plan, reinterpret_cast<Complex<float>*> (d), d);
+
+            for (int i = 0; i < numFrames; ++i)
+                FloatVectorOperations::multiply (d + i * frameStride, 1.0f / static_cast<float> (n), (int) n);
+
+            return;
+        }
+
+        FFT::Instance::performRealOnlyInverseTransformBatch (d, numFrames, frameStride);
+    }
+
+    //==============================================================================
+    // Plans for transforming many frames at once are only valid for one particular
+    // number of frames and stride, so they're created on demand and kept until the
+    // engine is destroyed.
+    struct BatchPlan
+    {
+        enum Kind { c2cForward, c2cInverse, r2c, c2r };
+
+        Kind kind;
+        int numFrames, frameStride;
+        bool inPlace;
+        FFTWPlanRef plan;
+    };
+
+    template <typename InputType, typename OutputType>
+    FFTWPlanRef getBatchPlan (BatchPlan::Kind kind, int numFrames, int frameStride,
+                              InputType* input, OutputType* output) const noexcept
+    {
+        const auto inPlace = ((const void*) input == (const void*) output);
+        const auto isReal = (kind == BatchPlan::r2c || kind == BatchPlan::c2r);
+
+        // An in-place real transform reads and writes each frame with a stride measured in
+        // floats, so the same stride must also be a whole number of complex numbers.
+        if (numFrames < 2 || (isReal && (frameStride & 1) != 0))
+            return nullptr;
+
+        ScopedLock lock (getFFTWPlanLock());
+
+        for (auto& batchPlan : batchPlans)
+            if (batchPlan.kind == kind && batchPlan.numFrames == numFrames
+                 && batchPlan.frameStride == frameStride && batchPlan.inPlace == inPlace)
+                return batchPlan.plan;
+
+        const int n = 1 << order;
+        FFTWPlanRef plan = nullptr;
+
+        // With the estimate flag, fftw doesn't touch the arrays while planning
+        switch (kind)
+        {
+            case BatchPlan::c2cForward:
+            case BatchPlan::c2cInverse:
+                if (fftw.plan_many_dft_fftw != nullptr)
+                    plan = fftw.plan_many_dft_fftw (1, &n, numFrames,
+                                                    reinterpret_cast<Complex<float>*> (input),  nullptr, 1, frameStride,
+                                                    reinterpret_cast<Complex<float>*> (output), nullptr, 1, frameStride,
+                                                    kind == BatchPlan::c2cInverse ? +1 : -1, unaligned | estimate);
+                break;
+
+            case BatchPlan::r2c:
+                if (fftw.plan_many_r2c_fftw != nullptr)
+                    plan = fftw.plan_many_r2c_fftw (1, &n, numFrames,
+                                                    reinterpret_cast<float*> (input), nullptr, 1, frameStride,
+                                                    reinterpret_cast<Complex<float>*> (output), nullptr, 1, frameStride / 2,
+                                                    unaligned | estimate);
+                break;
+
+            case BatchPlan::c2r:
+                if (fftw.plan_many_c2r_fftw != nullptr)
+                    plan = fftw.plan_many_c2r_fftw (1, &n, numFrames,
+                                                    reinterpret_cast<Complex<float>*> (input), nullptr, 1, frameStride / 2,
+                                                    reinterpret_cast<float*> (output), nullptr, 1, frameStride,
+                                                    unaligned | estimate);
+                break;
+        }
+
+        if (plan != nullptr)
+            batchPlans.push_back ({ kind, numFrames, frameStride, inPlace, plan });
+
+        return plan;
+    }
+
     //==============================================================================
     // fftw's plan_* and destroy_* methods are NOT thread safe. So we need to share
     // a lock between all instances of FFTWImpl
@@ -723,6 +1201,7 @@ struct FFTWImpl  : public FFT::Instance
     size_t order;
 
     FFTWPlanRef c2cForward, c2cInverse, r2c, c2r;
+    mutable std::vector<BatchPlan> batchPlans;
 };
 
 FFT::EngineImpl<FFTWImpl> fftwEngine;
@@ -979,12 +1458,8 @@ void FFT::performRealOnlyInverseTransform (float* inputOutputData) const noexcep
         engine->performRealOnlyInverseTransform (inputOutputData);
 }
 
-void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData, bool ignoreNegativeFreqs) const noexcept
+static void convertToMagnitudes (float* inputOutputData, int size, bool ignoreNegativeFreqs) noexcept
 {
-    if (size == 1)
-        return;
-
-    performRealOnlyForwardTransform (inputOutputData, ignoreNegativeFreqs);
     auto* out = reinterpret_cast<Complex<float>*> (inputOutputData);
 
     const auto limit = ignoreNegativeFreqs ? (size / 2) + 1 : size;
@@ -995,4 +1470,104 @@ void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData, bool ign
     zeromem (inputOutputData + limit, static_cast<size_t> (size * 2 - limit) * sizeof (float));
 }
 
+void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData, bool ignoreNegativeFreqs) const noexcept
+{
+    if (size == 1)
+        return;
+
+    performRealOnlyForwardTransform (inputOutputData, ignoreNegativeFreqs);
+    convertToMagnitudes (inputOutputData, size, ignoreNegativeFreqs);
+}
+
+//==============================================================================
+// Splits the frames into contiguous chunks, one per thread in the pool (including the
+// calling thread), and calls fn (firstFrame, numFramesInChunk) for each chunk.
+template <typename Fn>
+static void performInChunks (RealtimeThreadPool* threadPool, int numFrames, Fn&& fn) noexcept
+{
+    const auto numChunks = (threadPool != nullptr && threadPool->isPrepared())
+                         ? jmin (numFrames, threadPool->getNumThreads() + 1)
+                         : 1;
+
+    if (numChunks < 2)
+    {
+        fn (0, numFrames);
+        return;
+    }
+
+    const auto performChunk = [&] (int chunk)
+    {
+        const auto start = (int) ((int64) numFrames * chunk / numChunks);
+        const auto end   = (int) ((int64) numFrames * (chunk + 1) / numChunks);
+        fn (start, end - start);
+    };
+
+    // If a job can't be queued, addJob() runs it straight away, so there's nothing to retry
+    for (int chunk = 0; chunk < numChunks; ++chunk)
+        threadPool->addJob ([&performChunk, chunk] { performChunk (chunk); });
+
+    threadPool->runJobsAndWait();
+}
+
+void FFT::performBatch (const Complex<float>* input, Complex<float>* output,
+                        int numFrames, int frameStride, bool inverse,
+                        RealtimeThreadPool* threadPool) const noexcept
+{
+    jassert (frameStride >= size);
+
+    if (numFrames <= 0 || engine == nullptr)
+        return;
+
+    performInChunks (threadPool, numFrames, [&] (int start, int num)
+    {
+        engine->performBatch (input + start * frameStride, output + start * frameStride, num, frameStride, inverse);
+    });
+}
+
+void FFT::performRealOnlyForwardTransformBatch (float* inputOutputData, int numFrames, int frameStride,
+                                                bool ignoreNegativeFreqs, RealtimeThreadPool* threadPool) const noexcept
+{
+    jassert (frameStride >= 2 * size);
+
+    if (numFrames <= 0 || engine == nullptr)
+        return;
+
+    performInChunks (threadPool, numFrames, [&] (int start, int num)
+    {
+        engine->performRealOnlyForwardTransformBatch (inputOutputData + start * frameStride, num, frameStride, ignoreNegativeFreqs);
+    });
+}
+
+void FFT::performRealOnlyInverseTransformBatch (float* inputOutputData, int numFrames, int frameStride,
+                                                RealtimeThreadPool* threadPool) const noexcept
+{
+    jassert (frameStride >= 2 * size);
+
+    if (numFrames <= 0 || engine == nullptr)
+        return;
+
+    performInChunks (threadPool, numFrames, [&] (int start, int num)
+    {
+        engine->performRealOnlyInverseTransformBatch (inputOutputData + start * frameStride, num, frameStride);
+    });
+}
+
+void FFT::performFrequencyOnlyForwardTransformBatch (float* inputOutputData, int numFrames, int frameStride,
+                                                     bool ignoreNegativeFreqs, RealtimeThreadPool* threadPool) const noexcept
+{
+    jassert (frameStride >= 2 * size);
+
+    if (numFrames <= 0 || engine == nullptr || size == 1)
+        return;
+
+    performInChunks (threadPool, numFrames, [&] (int start, int num)
+    {
+        auto* chunk = inputOutputData + start * frameStride;
+        engine->performRealOnlyForwardTransformBatch (chunk, num, frameStride, ignoreNegativeFreqs);
+
+        for (int i = 0; i < num; ++i)
+            convertToMagnitudes (chunk + i * frameStride, size, ignoreNegativeFreqs);
+    });
+}
+
 } // namespace juce::dsp
@@ -105,6 +105,58 @@ public:
     void performFrequencyOnlyForwardTransform (float* inputOutputData,
                                                bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
 
+    //==============================================================================
+    /** Performs out-of-place FFTs on a number of frames at once, either forward or inverse.
+
+        Frame i of the input starts at input + i * frameStride, and the result will
+        be written to output + i * frameStride. The frameStride is measured in complex
+        numbers, and must be at least getSize().
+
+        Engines that can transform many frames in one go (such as FFTW) will do so. If
+        a prepared thread pool is supplied, the frames will also be split between its
+        threads. Only the thread that calls this method may add jobs to the pool while
+        it is running.
+
+        @see perform
+    */
+    void performBatch (const Complex<float>* input, Complex<float>* output,
+                       int numFrames, int frameStride, bool inverse,
+                       RealtimeThreadPool* threadPool = nullptr) const noexcept;
+
+    /** Performs in-place forward transforms on a number of frames of real data at once.
+
+        Each frame has the same layout as the data passed to performRealOnlyForwardTransform(),
+        and frame i starts at inputOutputData + i * frameStride. The frameStride is measured in
+        floats, and must be at least 2 * getSize().
+
+        If a prepared thread pool is supplied, the frames will be split between its threads.
+
+        @see performRealOnlyForwardTransform, performBatch
+    */
+    void performRealOnlyForwardTransformBatch (float* inputOutputData, int numFrames, int frameStride,
+                                               bool onlyCalculateNonNegativeFrequencies = false,
+                                               RealtimeThreadPool* threadPool = nullptr) const noexcept;
+
+    /** Performs the reverse operation of performRealOnlyForwardTransformBatch() on a
+        number of frames at once.
+
+        @see performRealOnlyInverseTransform, performBatch
+    */
+    void performRealOnlyInverseTransformBatch (float* inputOutputData, int numFrames, int frameStride,
+                                               RealtimeThreadPool* threadPool = nullptr) const noexcept;
+
+    /** Transforms a number of frames of real data to their magnitude spectra at once.
+
+        Each frame has the same layout as the data passed to performFrequencyOnlyForwardTransform(),
+        and frame i starts at inputOutputData + i * frameStride. The frameStride is measured in
+        floats, and must be at least 2 * getSize().
+
+        @see performFrequencyOnlyForwardTransform, performBatch
+    */
+    void performFrequencyOnlyForwardTransformBatch (float* inputOutputData, int numFrames, int frameStride,
+                                                    bool onlyCalculateNonNegativeFrequencies = false,
+                                                    RealtimeThreadPool* threadPool = nullptr) const noexcept;
+
     /** Returns the number of data points that this FFT was created to work with. */
     int getSize() const noexcept            { return size; }
 
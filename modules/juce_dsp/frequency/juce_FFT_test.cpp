@@ -194,6 +194,86 @@ struct FFTUnitTest final : public UnitTest
         }
     };
 
+    struct BatchTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+            RealtimeThreadPool pool (RealtimeThreadPool::Options{}.withNumberOfThreads (3));
+
+            // An unprepared pool, and one that runs most of the chunks on the calling thread
+            // because it has no room to queue them, must give the same results as the serial path
+            RealtimeThreadPool unpreparedPool;
+            RealtimeThreadPool fullPool (RealtimeThreadPool::Options{}.withNumberOfThreads (3)
+                                                                     .withMaxNumJobs (1));
+
+            for (auto* threadPool : { (RealtimeThreadPool*) nullptr, &pool, &unpreparedPool, &fullPool })
+            {
+                for (size_t order = 0; order <= 8; ++order)
+                {
+                    auto n = (1u << order);
+                    constexpr int numFrames = 7;
+                    const auto stride = (int) (2 * n + 2);
+
+                    FFT fft ((int) order);
+
+                    std::vector<float> input ((size_t) (numFrames * stride));
+                    fillRandom (random, input.data(), input.size());
+
+                    for (auto ignoreNegative : { false, true })
+                    {
+                        auto reference = input;
+                        auto batch = input;
+
+                        for (int i = 0; i < numFrames; ++i)
+                            fft.performRealOnlyForwardTransform (reference.data() + i * stride, ignoreNegative);
+
+                        fft.performRealOnlyForwardTransformBatch (batch.data(), numFrames, stride, ignoreNegative, threadPool);
+
+                        const auto numValues = ignoreNegative ? n + 2 : 2 * n;
+
+                        for (int i = 0; i < numFrames; ++i)
+                            u.expect (checkArrayIsSimilar (reference.data() + i * stride, batch.data() + i * stride, numValues));
+
+                        for (int i = 0; i < numFrames; ++i)
+                            fft.performRealOnlyInverseTransform (reference.data() + i * stride);
+
+                        fft.performRealOnlyInverseTransformBatch (batch.data(), numFrames, stride, threadPool);
+
+                        for (int i = 0; i < numFrames; ++i)
+                            u.expect (checkArrayIsSimilar (reference.data() + i * stride, batch.data() + i * stride, n));
+
+                        reference = input;
+                        batch = input;
+
+                        for (int i = 0; i < numFrames; ++i)
+                            fft.performFrequencyOnlyForwardTransform (reference.data() + i * stride, ignoreNegative);
+
+                        fft.performFrequencyOnlyForwardTransformBatch (batch.data(), numFrames, stride, ignoreNegative, threadPool);
+
+                        for (int i = 0; i < numFrames; ++i)
+                            u.expect (checkArrayIsSimilar (reference.data() + i * stride, batch.data() + i * stride, n));
+                    }
+
+                    for (auto inverse : { false, true })
+                    {
+                        const auto complexStride = stride / 2;
+                        const auto* complexInput = reinterpret_cast<const Complex<float>*> (input.data());
+                        std::vector<Complex<float>> reference ((size_t) (numFrames * complexStride)), batch (reference.size());
+
+                        for (int i = 0; i < numFrames; ++i)
+                            fft.perform (complexInput + i * complexStride, reference.data() + i * complexStride, inverse);
+
+                        fft.performBatch (complexInput, batch.data(), numFrames, complexStride, inverse, threadPool);
+
+                        for (int i = 0; i < numFrames; ++i)
+                            u.expect (checkArrayIsSimilar (reference.data() + i * complexStride, batch.data() + i * complexStride, n));
+                    }
+                }
+            }
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -207,9 +287,51 @@ struct FFTUnitTest final : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<BatchTest> ("Batch Test");
     }
 };
 
 static FFTUnitTest fftUnitTest;
 
+//==============================================================================
+struct FFTBenchmark final : public Benchmark
+{
+    FFTBenchmark()
+        : Benchmark ("FFT", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        for (auto order : { 8, 10, 12 })
+        {
+            const auto size = (size_t) 1 << order;
+            beginTest ("Size " + String (size));
+
+            FFT fft (order);
+            HeapBlock<float> input (2 * size), work (2 * size);
+            HeapBlock<Complex<float>> complexInput (size), complexOutput (size);
+
+            FFTUnitTest::fillRandom (random, input.getData(), size);
+            FFTUnitTest::fillRandom (random, complexInput.getData(), size);
+
+            measure ("real forward " + String (size), [&]
+            {
+                std::copy (input.getData(), input.getData() + size, work.getData());
+                fft.performRealOnlyForwardTransform (work.getData(), true);
+                doNotOptimise (work[0]);
+            });
+
+            measure ("complex forward " + String (size), [&]
+            {
+                fft.perform (complexInput.getData(), complexOutput.getData(), false);
+                doNotOptimise (complexOutput[0]);
+            });
+        }
+    }
+};
+
+static FFTBenchmark fftBenchmark;
+
 } // namespace juce::dsp
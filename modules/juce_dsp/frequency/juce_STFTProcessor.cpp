@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+STFTProcessor::STFTProcessor (int fftOrder, int hop, WindowingFunction<float>::WindowingMethod windowType)
+    : fft (fftOrder),
+      fftSize (1 << fftOrder),
+      hopSize (hop)
+{
+    jassert (0 < hopSize && hopSize <= fftSize);
+
+    // Using one more point than the frame and then dropping the last one gives the
+    // periodic version of the window, which overlaps more evenly.
+    window.resize ((size_t) fftSize + 1);
+    WindowingFunction<float>::fillWindowingTables (window.data(), window.size(), windowType, false);
+    window.resize ((size_t) fftSize);
+
+    // Each output sample is the sum of the overlapping frames, each weighted by the
+    // square of the window, so this is used to bring the result back to unity gain.
+    double overlapSum = 0.0;
+
+    for (const auto w : window)
+        overlapSum += (double) w * (double) w;
+
+    const auto averageGain = overlapSum / (double) hopSize;
+    windowGain = averageGain > 0.0 ? (float) (1.0 / averageGain) : 0.0f;
+
+    frame.resize ((size_t) fftSize * 2);
+}
+
+void STFTProcessor::setSpectralCallback (SpectralCallback newCallback)
+{
+    callback = std::move (newCallback);
+}
+
+//==============================================================================
+void STFTProcessor::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+
+    inputFifo .setSize ((int) spec.numChannels, fftSize);
+    outputFifo.setSize ((int) spec.numChannels, fftSize);
+
+    reset();
+}
+
+void STFTProcessor::reset() noexcept
+{
+    inputFifo.clear();
+    outputFifo.clear();
+    std::fill (frame.begin(), frame.end(), 0.0f);
+
+    fifoPosition = 0;
+    samplesUntilNextFrame = hopSize;
+}
+
+//==============================================================================
+void STFTProcessor::processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output, bool isBypassed) noexcept
+{
+    jassert (input.getNumChannels() == output.getNumChannels());
+    jassert (input.getNumSamples() == output.getNumSamples());
+    jassert ((int) output.getNumChannels() <= inputFifo.getNumChannels());
+
+    const auto numChannels = jmin ((int) output.getNumChannels(), inputFifo.getNumChannels());
+    const auto numSamples = (int) output.getNumSamples();
+
+    for (int done = 0; done < numSamples;)
+    {
+        const auto num = jmin (numSamples - done, samplesUntilNextFrame);
+
+        // num is never larger than the hop size, so each of these copies wraps around
+        // the end of the fifo at most once
+        const auto firstPart = jmin (num, fftSize - fifoPosition);
+        const auto secondPart = num - firstPart;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto* in = input.getChannelPointer ((size_t) ch) + done;
+            auto* fifo = inputFifo.getWritePointer (ch);
+
+            FloatVectorOperations::copy (fifo + fifoPosition, in, firstPart);
+            FloatVectorOperations::copy (fifo, in + firstPart, secondPart);
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* out = output.getChannelPointer ((size_t) ch) + done;
+            auto* fifo = outputFifo.getWritePointer (ch);
+
+            FloatVectorOperations::copy (out, fifo + fifoPosition, firstPart);
+            FloatVectorOperations::copy (out + firstPart, fifo, secondPart);
+
+            FloatVectorOperations::clear (fifo + fifoPosition, firstPart);
+            FloatVectorOperations::clear (fifo, secondPart);
+        }
+
+        const auto nextPosition = (fifoPosition + num) % fftSize;
+        samplesUntilNextFrame -= num;
+
+        if (samplesUntilNextFrame == 0)
+        {
+            processFrame (output, (size_t) (done + num - 1), nextPosition, numChannels, isBypassed);
+            samplesUntilNextFrame = hopSize;
+        }
+
+        fifoPosition = nextPosition;
+        done += num;
+    }
+}
+
+void STFTProcessor::processFrame (AudioBlock<float>& output, size_t outputIndex,
+                                  int oldestPosition, int numChannels, bool isBypassed) noexcept
+{
+    const auto transform = callback != nullptr && ! isBypassed;
+    auto* data = frame.data();
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* in = inputFifo.getReadPointer (ch);
+        FloatVectorOperations::copy (data, in + oldestPosition, fftSize - oldestPosition);
+        FloatVectorOperations::copy (data + fftSize - oldestPosition, in, oldestPosition);
+
+        FloatVectorOperations::multiply (data, window.data(), fftSize);
+
+        if (transform)
+        {
+            FloatVectorOperations::clear (data + fftSize, fftSize);
+            fft.performRealOnlyForwardTransform (data, true);
+
+            callback (ch, reinterpret_cast<Complex<float>*> (data), getNumBins());
+
+            fft.performRealOnlyInverseTransform (data);
+        }
+
+        FloatVectorOperations::multiply (data, window.data(), fftSize);
+        FloatVectorOperations::multiply (data, windowGain, fftSize);
+
+        // The first sample of the frame completes the newest output sample, and the rest
+        // of the frame is accumulated into the following fftSize - 1 slots of the fifo.
+        output.getChannelPointer ((size_t) ch)[outputIndex] += data[0];
+
+        const auto firstPart = jmin (fftSize - 1, fftSize - oldestPosition);
+        auto* out = outputFifo.getWritePointer (ch);
+
+        FloatVectorOperations::add (out + oldestPosition, data + 1, firstPart);
+        FloatVectorOperations::add (out, data + 1 + firstPart, fftSize - 1 - firstPart);
+    }
+}
+
+} // namespace juce::dsp
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    Performs a short-time Fourier transform of a stream of audio, allowing the
+    spectrum of each frame to be modified before it is resynthesised using
+    overlap-add.
+
+    The incoming samples are collected into frames of getFFTSize() samples, with a
+    new frame starting every getHopSize() samples. Each frame is windowed and
+    transformed, then handed to the spectral callback, which may modify the
+    getNumBins() non-negative frequency bins in place. The frames are then
+    transformed back, windowed again, and summed into the output.
+
+    Blocks of any size may be passed to process(), regardless of the hop size. All
+    of the storage is allocated in prepare(), so process() will never allocate
+    (as long as your callback doesn't). The output is delayed by
+    getLatencyInSamples() samples; if the callback leaves the spectra unchanged, the
+    output is just a delayed copy of the input.
+
+    For the resynthesised signal to have the right level, the squared window should
+    sum to a constant when overlapped at the hop size. For example, a Hann window
+    with a hop size of a quarter of the FFT size satisfies this.
+
+    @tags{DSP}
+*/
+class JUCE_API  STFTProcessor
+{
+public:
+    //==============================================================================
+    /** A function that will be called for each frame of each channel, with the
+        channel index and the non-negative frequency bins of that frame's spectrum.
+        It's called on the thread that calls process().
+    */
+    using SpectralCallback = std::function<void (int channel, Complex<float>* bins, int numBins)>;
+
+    //==============================================================================
+    /** Creates a processor that uses frames of 2 ^ fftOrder samples, starting one
+        frame every hopSize samples.
+
+        The hop size must be greater than zero and no greater than the FFT size.
+        The same window is applied before the forward transform and after the
+        inverse transform of each frame.
+    */
+    STFTProcessor (int fftOrder,
+                   int hopSize,
+                   WindowingFunction<float>::WindowingMethod window = WindowingFunction<float>::hann);
+
+    //==============================================================================
+    /** Sets the function that will be called for each frame.
+
+        This must not be called at the same time as process().
+    */
+    void setSpectralCallback (SpectralCallback newCallback);
+
+    //==============================================================================
+    /** Allocates all of the storage needed to process the given number of channels. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Clears the internal buffers, ready to start a new stream of audio. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the samples in the context.
+
+        If the context is bypassed, the spectral callback won't be called, but the
+        output will still be delayed by getLatencyInSamples() so that the latency
+        doesn't change.
+    */
+    template <typename ProcessContext,
+              std::enable_if_t<std::is_same_v<typename ProcessContext::SampleType, float>, int> = 0>
+    void process (const ProcessContext& context) noexcept
+    {
+        processSamples (context.getInputBlock(), context.getOutputBlock(), context.isBypassed);
+    }
+
+    //==============================================================================
+    /** Returns the number of samples in each frame. */
+    int getFFTSize() const noexcept             { return fftSize; }
+
+    /** Returns the number of samples between the starts of consecutive frames. */
+    int getHopSize() const noexcept             { return hopSize; }
+
+    /** Returns the number of frequency bins passed to the spectral callback. */
+    int getNumBins() const noexcept             { return fftSize / 2 + 1; }
+
+    /** Returns the delay, in samples, between the input and the output. */
+    int getLatencyInSamples() const noexcept    { return fftSize - 1; }
+
+private:
+    //==============================================================================
+    void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output, bool isBypassed) noexcept;
+    void processFrame (AudioBlock<float>&, size_t outputIndex, int oldestPosition, int numChannels, bool isBypassed) noexcept;
+
+    //==============================================================================
+    FFT fft;
+    const int fftSize, hopSize;
+
+    std::vector<float> window, frame;
+    AudioBuffer<float> inputFifo, outputFifo;
+    SpectralCallback callback;
+
+    float windowGain = 1.0f;
+    int fifoPosition = 0, samplesUntilNextFrame = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (STFTProcessor)
+};
+
+} // namespace juce::dsp
@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct STFTProcessorTests final : public UnitTest
+{
+    STFTProcessorTests()
+        : UnitTest ("STFTProcessor", UnitTestCategories::dsp)
+    {}
+
+    static AudioBuffer<float> makeNoise (Random& random, int numChannels, int numSamples)
+    {
+        AudioBuffer<float> result (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                result.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return result;
+    }
+
+    static AudioBuffer<float> processInRandomBlocks (STFTProcessor& processor, Random& random,
+                                                     const AudioBuffer<float>& input, bool bypassed = false)
+    {
+        AudioBuffer<float> output (input);
+        AudioBlock<float> block (output);
+
+        for (size_t done = 0; done < block.getNumSamples();)
+        {
+            const auto num = jmin ((size_t) random.nextInt ({ 1, 700 }), block.getNumSamples() - done);
+            auto subBlock = block.getSubBlock (done, num);
+
+            ProcessContextReplacing<float> context (subBlock);
+            context.isBypassed = bypassed;
+            processor.process (context);
+
+            done += num;
+        }
+
+        return output;
+    }
+
+    void expectDelayedCopy (const AudioBuffer<float>& input, const AudioBuffer<float>& output, int latency)
+    {
+        auto maxError = 0.0f;
+
+        for (int ch = 0; ch < input.getNumChannels(); ++ch)
+        {
+            for (int i = 0; i < input.getNumSamples(); ++i)
+            {
+                const auto expected = i < latency ? 0.0f : input.getSample (ch, i - latency);
+                maxError = jmax (maxError, std::abs (expected - output.getSample (ch, i)));
+            }
+        }
+
+        expectLessThan (maxError, 1.0e-4f);
+    }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        constexpr int numChannels = 2, numSamples = 10000;
+
+        const auto input = makeNoise (random, numChannels, numSamples);
+
+        beginTest ("Unmodified spectra reproduce the input");
+        {
+            for (auto [order, hop] : { std::tuple (9, 128), std::tuple (10, 256), std::tuple (8, 64) })
+            {
+                STFTProcessor processor (order, hop);
+                processor.prepare ({ 44100.0, 512, (uint32) numChannels });
+
+                int numFrames = 0;
+
+                processor.setSpectralCallback ([&] (int channel, Complex<float>*, int numBins)
+                {
+                    expect (isPositiveAndBelow (channel, numChannels));
+                    expectEquals (numBins, processor.getNumBins());
+                    numFrames += channel == 0 ? 1 : 0;
+                });
+
+                const auto output = processInRandomBlocks (processor, random, input);
+                expectDelayedCopy (input, output, processor.getLatencyInSamples());
+                expectEquals (numFrames, numSamples / hop);
+            }
+        }
+
+        beginTest ("Bypassed processors still delay the input");
+        {
+            STFTProcessor processor (9, 128);
+            processor.prepare ({ 44100.0, 512, (uint32) numChannels });
+            processor.setSpectralCallback ([] (int, Complex<float>* bins, int numBins)
+            {
+                std::fill (bins, bins + numBins, Complex<float>{});
+            });
+
+            const auto output = processInRandomBlocks (processor, random, input, true);
+            expectDelayedCopy (input, output, processor.getLatencyInSamples());
+        }
+
+        beginTest ("Modified spectra are resynthesised");
+        {
+            STFTProcessor processor (9, 128);
+            processor.prepare ({ 44100.0, 512, (uint32) numChannels });
+            processor.setSpectralCallback ([] (int, Complex<float>* bins, int numBins)
+            {
+                for (int i = 0; i < numBins; ++i)
+                    bins[i] *= 0.5f;
+            });
+
+            auto expected = input;
+            expected.applyGain (0.5f);
+
+            const auto output = processInRandomBlocks (processor, random, input);
+            expectDelayedCopy (expected, output, processor.getLatencyInSamples());
+
+            processor.reset();
+            processor.setSpectralCallback ([] (int, Complex<float>* bins, int numBins)
+            {
+                std::fill (bins, bins + numBins, Complex<float>{});
+            });
+
+            const auto silence = processInRandomBlocks (processor, random, input);
+            expectEquals (silence.getMagnitude (0, numSamples), 0.0f);
+        }
+    }
+};
+
+static STFTProcessorTests stftProcessorTests;
+
+} // namespace juce::dsp
@@ -56,11 +56,13 @@
 
 #include "processors/juce_FIRFilter.cpp"
 #include "processors/juce_IIRFilter.cpp"
+#include "processors/juce_IIRCascade.cpp"
 #include "processors/juce_FirstOrderTPTFilter.cpp"
 #include "processors/juce_Panner.cpp"
 #include "processors/juce_Oversampling.cpp"
 #include "processors/juce_BallisticsFilter.cpp"
 #include "processors/juce_LinkwitzRileyFilter.cpp"
+#include "processors/juce_LinkwitzRileyCrossover.cpp"
 #include "processors/juce_DelayLine.cpp"
 #include "processors/juce_DryWetMixer.cpp"
 #include "processors/juce_StateVariableTPTFilter.cpp"
@@ -70,6 +72,7 @@
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
 #include "frequency/juce_Windowing.cpp"
+#include "frequency/juce_STFTProcessor.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 #include "widgets/juce_LadderFilter.cpp"
 #include "widgets/juce_Compressor.cpp"
@@ -77,10 +80,17 @@
 #include "widgets/juce_Limiter.cpp"
 #include "widgets/juce_Phaser.cpp"
 #include "widgets/juce_Chorus.cpp"
+#include "widgets/juce_WavetableOscillator.cpp"
+
+#if JUCE_USE_SIMD
+ #include "widgets/juce_VoiceLanes.cpp"
+#endif
 
 #if JUCE_USE_SIMD
  #if JUCE_INTEL
-  #ifdef __AVX2__
+  #if defined (__AVX512F__) && defined (__AVX512BW__) && defined (__AVX512DQ__)
+   // the AVX-512 ops build all of their constants inline, so there's nothing to include here
+  #elif defined (__AVX2__)
    #include "native/juce_SIMDNativeOps_avx.cpp"
   #else
    #include "native/juce_SIMDNativeOps_sse.cpp"
@@ -95,6 +105,7 @@
 #if JUCE_UNIT_TESTS
  #include "maths/juce_Matrix_test.cpp"
  #include "maths/juce_LogRampedValue_test.cpp"
+ #include "maths/juce_LookupTable_test.cpp"
 
  #if JUCE_USE_SIMD
   #include "containers/juce_SIMDRegister_test.cpp"
@@ -103,6 +114,20 @@
  #include "containers/juce_AudioBlock_test.cpp"
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
+ #include "frequency/juce_STFTProcessor_test.cpp"
+ #include "filter_design/juce_FilterDesign_test.cpp"
+ #include "processors/juce_DelayLine_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_IIRCascade_test.cpp"
+ #include "processors/juce_LinkwitzRileyCrossover_test.cpp"
+ #include "processors/juce_Oversampling_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "processors/juce_StateVariableTPTFilter_test.cpp"
+ #include "widgets/juce_Compressor_test.cpp"
+ #include "widgets/juce_LadderFilter_test.cpp"
+ #include "widgets/juce_WavetableOscillator_test.cpp"
+
+ #if JUCE_USE_SIMD
+  #include "widgets/juce_VoiceLanes_test.cpp"
+ #endif
 #endif
@@ -226,7 +226,9 @@ namespace util
 
  // include the correct native file for this build target CPU
  #if defined (__i386__) || defined (__amd64__) || defined (_M_X64) || defined (_X86_) || defined (_M_IX86)
-  #ifdef __AVX2__
+  #if defined (__AVX512F__) && defined (__AVX512BW__) && defined (__AVX512DQ__)
+   #include "native/juce_SIMDNativeOps_avx512.h"
+  #elif defined (__AVX2__)
    #include "native/juce_SIMDNativeOps_avx.h"
   #else
    #include "native/juce_SIMDNativeOps_sse.h"
@@ -255,6 +257,7 @@ namespace util
 #include "processors/juce_ProcessorDuplicator.h"
 #include "processors/juce_IIRFilter.h"
 #include "processors/juce_IIRFilter_Impl.h"
+#include "processors/juce_IIRCascade.h"
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_FirstOrderTPTFilter.h"
@@ -263,20 +266,27 @@ namespace util
 #include "processors/juce_Oversampling.h"
 #include "processors/juce_BallisticsFilter.h"
 #include "processors/juce_LinkwitzRileyFilter.h"
+#include "processors/juce_LinkwitzRileyCrossover.h"
 #include "processors/juce_DryWetMixer.h"
 #include "processors/juce_StateVariableTPTFilter.h"
 #include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
+#include "frequency/juce_STFTProcessor.h"
 #include "filter_design/juce_FilterDesign.h"
 #include "widgets/juce_Reverb.h"
 #include "widgets/juce_Bias.h"
 #include "widgets/juce_Gain.h"
 #include "widgets/juce_WaveShaper.h"
 #include "widgets/juce_Oscillator.h"
+#include "widgets/juce_WavetableOscillator.h"
 #include "widgets/juce_LadderFilter.h"
 #include "widgets/juce_Compressor.h"
 #include "widgets/juce_NoiseGate.h"
 #include "widgets/juce_Limiter.h"
 #include "widgets/juce_Phaser.h"
 #include "widgets/juce_Chorus.h"
+
+#if JUCE_USE_SIMD
+ #include "widgets/juce_VoiceLanes.h"
+#endif
@@ -164,6 +164,41 @@ public:
     }
 
 private:
+    //==============================================================================
+    friend class SmoothedValueBase<LogRampedValue>;
+
+    // Called by fillRamp() with 0 < numSamples <= countdown
+    void generateRamp (FloatType* dest, int numSamples) noexcept
+    {
+        // Four interleaved sequences, each of which advances by four steps of
+        // temp = temp * r + d at a time, so that the steps don't depend on each other
+        constexpr int numLanes = 4;
+        FloatType lanes[numLanes];
+
+        for (auto& lane : lanes)
+            lane = (temp = temp * r + d);
+
+        const auto laneR = r * r * r * r;
+        const auto laneD = d * (1 + r + r * r + r * r * r);
+        int i = 0;
+
+        for (; i + numLanes < numSamples; i += numLanes)
+        {
+            for (int j = 0; j < numLanes; ++j)
+            {
+                dest[i + j] = jmap (lanes[j], source, this->target);
+                lanes[j] = lanes[j] * laneR + laneD;
+            }
+        }
+
+        for (int j = 0; i < numSamples; ++i, ++j)
+            dest[i] = jmap (lanes[j], source, this->target);
+
+        temp = lanes[(numSamples - 1) % numLanes];
+        this->countdown -= numSamples;
+        this->currentValue = dest[numSamples - 1];
+    }
+
     //==============================================================================
     void updateRampParameters()
     {
@@ -68,6 +68,48 @@ void LookupTable<FloatType>::prepare() noexcept
     data.getReference (guardIndex) = data.getUnchecked (guardIndex - 1);
 }
 
+template <typename FloatType>
+void LookupTable<FloatType>::getUnchecked (const FloatType* indices, FloatType* output, size_t numValues) const noexcept
+{
+    jassert (isInitialised());  // Use the non-default constructor or call initialise() before first use
+
+    size_t i = 0;
+
+   #if JUCE_USE_SIMD && defined (__AVX2__)
+    const auto* table = data.begin();
+
+    if constexpr (std::is_same_v<FloatType, float>)
+    {
+        for (; i + 8 <= numValues; i += 8)
+        {
+            const auto index = _mm256_loadu_ps (indices + i);
+            const auto whole = _mm256_cvttps_epi32 (index);
+            const auto frac  = _mm256_sub_ps (index, _mm256_cvtepi32_ps (whole));
+            const auto x0    = _mm256_i32gather_ps (table,     whole, sizeof (float));
+            const auto x1    = _mm256_i32gather_ps (table + 1, whole, sizeof (float));
+
+            _mm256_storeu_ps (output + i, _mm256_add_ps (x0, _mm256_mul_ps (frac, _mm256_sub_ps (x1, x0))));
+        }
+    }
+    else
+    {
+        for (; i + 4 <= numValues; i += 4)
+        {
+            const auto index = _mm256_loadu_pd (indices + i);
+            const auto whole = _mm256_cvttpd_epi32 (index);
+            const auto frac  = _mm256_sub_pd (index, _mm256_cvtepi32_pd (whole));
+            const auto x0    = _mm256_i32gather_pd (table,     whole, sizeof (double));
+            const auto x1    = _mm256_i32gather_pd (table + 1, whole, sizeof (double));
+
+            _mm256_storeu_pd (output + i, _mm256_add_pd (x0, _mm256_mul_pd (frac, _mm256_sub_pd (x1, x0))));
+        }
+    }
+   #endif
+
+    for (; i < numValues; ++i)
+        output[i] = getUnchecked (indices[i]);
+}
+
 template <typename FloatType>
 void LookupTableTransform<FloatType>::initialise (const std::function<FloatType (FloatType)>& functionToApproximate,
                                                   FloatType minInputValueToUse,
@@ -93,6 +135,24 @@ void LookupTableTransform<FloatType>::initialise (const std::function<FloatType
     lookupTable.initialise (initFn, numPoints);
 }
 
+//==============================================================================
+template <typename FloatType>
+void LookupTableTransform<FloatType>::processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
+{
+    // The table indices are worked out in the output buffer, and then replaced by the results
+    FloatVectorOperations::multiply (output, input, scaler, numSamples);
+    FloatVectorOperations::add (output, offset, numSamples);
+
+    lookupTable.getUnchecked (output, output, numSamples);
+}
+
+template <typename FloatType>
+void LookupTableTransform<FloatType>::process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
+{
+    FloatVectorOperations::clip (output, input, minInputValue, maxInputValue, numSamples);
+    processUnchecked (output, output, numSamples);
+}
+
 //==============================================================================
 template <typename FloatType>
 double LookupTableTransform<FloatType>::calculateMaxRelativeError (const std::function<FloatType (FloatType)>& functionToApproximate,
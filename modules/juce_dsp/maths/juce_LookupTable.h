@@ -128,6 +128,17 @@ public:
         return getUnchecked (index);
     }
 
+    //==============================================================================
+    /** Calculates the approximated values for an array of indices without range checking.
+
+        This gives the same results as calling getUnchecked() for each index, but when
+        the module is built for AVX2 it will look up several values at once. The
+        indices and output may point to the same array.
+
+        @see getUnchecked
+    */
+    void getUnchecked (const FloatType* indices, FloatType* output, size_t numValues) const noexcept;
+
     //==============================================================================
     /** @see getUnchecked */
     FloatType operator[] (FloatType index) const noexcept       { return getUnchecked (index); }
@@ -264,24 +275,22 @@ public:
     FloatType operator() (FloatType index) const noexcept       { return processSample (index); }
 
     //==============================================================================
-    /** Processes an array of input values without range checking
+    /** Processes an array of input values without range checking.
+
+        The input and output may point to the same array.
+
         @see process
     */
-    void processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
-    {
-        for (size_t i = 0; i < numSamples; ++i)
-            output[i] = processSampleUnchecked (input[i]);
-    }
+    void processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept;
 
     //==============================================================================
-    /** Processes an array of input values with range checking
+    /** Processes an array of input values with range checking.
+
+        The input and output may point to the same array.
+
         @see processUnchecked
     */
-    void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
-    {
-        for (size_t i = 0; i < numSamples; ++i)
-            output[i] = processSample (input[i]);
-    }
+    void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept;
 
     //==============================================================================
     /** Calculates the maximum relative error of the approximation for the specified
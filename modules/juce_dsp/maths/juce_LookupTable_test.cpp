@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct LookupTableTransformTests final : public UnitTest
+{
+    LookupTableTransformTests()
+        : UnitTest ("LookupTableTransform", UnitTestCategories::dsp)
+    {}
+
+    template <typename FloatType>
+    void runTestsForType()
+    {
+        auto random = getRandom();
+        constexpr int numSamples = 1000;
+
+        const auto function = [] (FloatType x) { return std::tanh (x); };
+        LookupTableTransform<FloatType> table (function, (FloatType) -5, (FloatType) 5, 1024);
+
+        // Some of the inputs are out of range, to check that process() clips them
+        AudioBuffer<FloatType> input (2, numSamples), output (2, numSamples);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (ch, i, (FloatType) (random.nextDouble() * 12.0 - 6.0));
+
+        table.process (input.getReadPointer (0), output.getWritePointer (0), (size_t) numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            expectWithinAbsoluteError (output.getSample (0, i), table.processSample (input.getSample (0, i)), (FloatType) 1.0e-6);
+
+        WaveShaper<FloatType, const LookupTableTransform<FloatType>&> shaper { table };
+
+        AudioBlock<FloatType> block (output);
+        block.copyFrom (input);
+        shaper.process (ProcessContextReplacing<FloatType> (block));
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (output.getSample (ch, i), table.processSample (input.getSample (ch, i)), (FloatType) 1.0e-6);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Float block processing matches single samples");
+        runTestsForType<float>();
+
+        beginTest ("Double block processing matches single samples");
+        runTestsForType<double>();
+    }
+};
+
+static LookupTableTransformTests lookupTableTransformTests;
+
+} // namespace juce::dsp
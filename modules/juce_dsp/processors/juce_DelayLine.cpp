@@ -122,6 +122,142 @@ SampleType DelayLine<SampleType, InterpolationType>::popSample (int channel, Sam
     return result;
 }
 
+//==============================================================================
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::pushBlock (int channel, const SampleType* samples, int numSamples)
+{
+    auto* data = bufferData.getWritePointer (channel);
+    auto& pos = writePos[(size_t) channel];
+
+    while (numSamples > 0)
+    {
+        // Samples are written backwards through the buffer, so each run ends at index 0
+        const auto numThisTime = jmin (numSamples, pos + 1);
+
+        for (int i = 0; i < numThisTime; ++i)
+            data[pos - i] = samples[i];
+
+        samples    += numThisTime;
+        numSamples -= numThisTime;
+        pos        -= numThisTime;
+
+        if (pos < 0)
+            pos += totalSize;
+    }
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::popBlock (int channel, const SampleType* delaysInSamples,
+                                                         SampleType* output, int numSamples)
+{
+    constexpr int chunkSize = 64;
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+        popChunk<chunkSize> (channel,
+                             delaysInSamples != nullptr ? delaysInSamples + start : nullptr,
+                             output + start,
+                             jmin (chunkSize, numSamples - start));
+
+    if (delaysInSamples != nullptr && numSamples > 0)
+        setDelay (delaysInSamples[numSamples - 1]);
+}
+
+template <typename SampleType, typename InterpolationType>
+template <int chunkSize>
+void DelayLine<SampleType, InterpolationType>::popChunk (int channel, const SampleType* delaysInSamples,
+                                                         SampleType* output, int numSamples)
+{
+    namespace Types = DelayLineInterpolationTypes;
+
+    constexpr size_t numTaps = std::is_same_v<InterpolationType, Types::None>        ? 1
+                             : std::is_same_v<InterpolationType, Types::Lagrange3rd> ? 4
+                                                                                     : 2;
+
+    SampleType taps[numTaps][(size_t) chunkSize], fracs[(size_t) chunkSize];
+
+    const auto* data = bufferData.getReadPointer (channel);
+    const auto upperLimit = (SampleType) getMaximumDelayInSamples();
+    auto& pos = readPos[(size_t) channel];
+
+    // Gather the samples needed for each output sample. The read position is always less
+    // than totalSize and the delay is less than totalSize - 1, so no index can wrap more
+    // than once.
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto integerPart = delayInt;
+        auto fractionalPart = delayFrac;
+
+        if (delaysInSamples != nullptr)
+        {
+            jassert (isPositiveAndNotGreaterThan (delaysInSamples[i], upperLimit));
+
+            const auto newDelay = jlimit ((SampleType) 0, upperLimit, delaysInSamples[i]);
+            integerPart = static_cast<int> (newDelay);
+            fractionalPart = newDelay - (SampleType) integerPart;
+            adjustDelayForInterpolation (integerPart, fractionalPart);
+        }
+
+        fracs[i] = fractionalPart;
+
+        for (int tap = 0; tap < (int) numTaps; ++tap)
+        {
+            const auto index = pos + integerPart + tap;
+            taps[tap][i] = data[index >= totalSize ? index - totalSize : index];
+        }
+
+        pos = (pos == 0 ? totalSize : pos) - 1;
+    }
+
+    // Now that the samples are contiguous, the interpolation loops have no branches or
+    // indirection, so they can be vectorised
+    if constexpr (std::is_same_v<InterpolationType, Types::None>)
+    {
+        std::copy (taps[0], taps[0] + numSamples, output);
+    }
+    else if constexpr (std::is_same_v<InterpolationType, Types::Linear>)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = taps[0][i] + fracs[i] * (taps[1][i] - taps[0][i]);
+    }
+    else if constexpr (std::is_same_v<InterpolationType, Types::Lagrange3rd>)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto frac = fracs[i];
+
+            const auto d1 = frac - 1.f;
+            const auto d2 = frac - 2.f;
+            const auto d3 = frac - 3.f;
+
+            const auto c1 = -d1 * d2 * d3 / 6.f;
+            const auto c2 = d2 * d3 * 0.5f;
+            const auto c3 = -d1 * d3 * 0.5f;
+            const auto c4 = d1 * d2 / 6.f;
+
+            output[i] = taps[0][i] * c1 + frac * (taps[1][i] * c2 + taps[2][i] * c3 + taps[3][i] * c4);
+        }
+    }
+    else if constexpr (std::is_same_v<InterpolationType, Types::Thiran>)
+    {
+        SampleType alphas[(size_t) chunkSize];
+
+        for (int i = 0; i < numSamples; ++i)
+            alphas[i] = (1 - fracs[i]) / (1 + fracs[i]);
+
+        // The all-pass filter is recursive, so this part has to run one sample at a time
+        auto state = v[(size_t) channel];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            state = approximatelyEqual (fracs[i], (SampleType) 0) ? taps[0][i]
+                                                                  : taps[1][i] + alphas[i] * (taps[0][i] - state);
+            output[i] = state;
+        }
+
+        v[(size_t) channel] = state;
+    }
+}
+
 //==============================================================================
 template class DelayLine<float,  DelayLineInterpolationTypes::None>;
 template class DelayLine<double, DelayLineInterpolationTypes::None>;
@@ -158,6 +158,41 @@ public:
     */
     SampleType popSample (int channel, SampleType delayInSamples = -1, bool updateReadPointer = true);
 
+    //==============================================================================
+    /** Pushes a block of samples into one channel of the delay line.
+
+        This is equivalent to calling pushSample once for each sample.
+
+        If you push a whole block before popping it with popBlock, then the delay
+        line has to be able to hold the block as well as the longest delay, so the
+        maximum delay should be set to at least the longest delay plus the block size.
+
+        @see popBlock, pushSample
+    */
+    void pushBlock (int channel, const SampleType* samples, int numSamples);
+
+    /** Pops a block of samples from one channel of the delay line, using a separate
+        delay time for each sample.
+
+        This is equivalent to calling popSample once for each sample with
+        updateReadPointer set to true, but the interpolation is done a chunk at a
+        time, so it's much faster when the delay is being modulated.
+
+        @param channel              the target channel for the delay line.
+
+        @param delaysInSamples      the fractional delay in samples to use for each output
+                                    sample, or nullptr to use the delay set with setDelay.
+                                    Afterwards, the delay will be left at the last value
+                                    in this array.
+
+        @param output               the destination for the delayed samples.
+
+        @param numSamples           the number of samples to pop.
+
+        @see pushBlock, popSample, setDelay
+    */
+    void popBlock (int channel, const SampleType* delaysInSamples, SampleType* output, int numSamples);
+
     //==============================================================================
     /** Processes the input and output samples supplied in the processing context.
 
@@ -277,28 +312,37 @@ private:
     }
 
     //==============================================================================
-    void updateInternalVariables()
+    static void adjustDelayForInterpolation (int& integerPart, SampleType& fractionalPart)
     {
         if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Lagrange3rd>)
         {
-            if (delayFrac < (SampleType) 2.0 && delayInt >= 1)
+            if (fractionalPart < (SampleType) 2.0 && integerPart >= 1)
             {
-                delayFrac++;
-                delayInt--;
+                fractionalPart++;
+                integerPart--;
             }
         }
         else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
         {
-            if (delayFrac < (SampleType) 0.618 && delayInt >= 1)
+            if (fractionalPart < (SampleType) 0.618 && integerPart >= 1)
             {
-                delayFrac++;
-                delayInt--;
+                fractionalPart++;
+                integerPart--;
             }
+        }
+    }
 
+    void updateInternalVariables()
+    {
+        adjustDelayForInterpolation (delayInt, delayFrac);
+
+        if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
             alpha = (1 - delayFrac) / (1 + delayFrac);
-        }
     }
 
+    template <int chunkSize>
+    void popChunk (int channel, const SampleType* delaysInSamples, SampleType* output, int numSamples);
+
     //==============================================================================
     double sampleRate;
 
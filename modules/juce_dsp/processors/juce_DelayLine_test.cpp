@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct DelayLineTests final : public UnitTest
+{
+    DelayLineTests()
+        : UnitTest ("DelayLine", UnitTestCategories::dsp)
+    {}
+
+    template <typename SampleType, typename InterpolationType>
+    void runBlockTest (const String& testName)
+    {
+        beginTest ("popBlock matches popSample: " + testName);
+
+        auto random = getRandom();
+        constexpr int numChannels = 2, numSamples = 1500, blockSize = 100, maxModulatedDelay = 200;
+
+        DelayLine<SampleType, InterpolationType> reference (maxModulatedDelay + blockSize), blockDelay (maxModulatedDelay + blockSize);
+
+        for (auto* d : { &reference, &blockDelay })
+        {
+            d->prepare ({ 44100.0, (uint32) blockSize, (uint32) numChannels });
+            d->setDelay ((SampleType) 17.25);
+        }
+
+        std::vector<SampleType> input (numSamples), delays (numSamples), expected (numSamples), actual (numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            input[(size_t) i] = (SampleType) (random.nextDouble() * 2.0 - 1.0);
+            delays[(size_t) i] = (SampleType) (1.0 + 0.5 * (maxModulatedDelay - 2) * (1.0 + std::sin (i * 0.01)));
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            // The second channel uses the fixed delay set with setDelay
+            const auto useDelays = channel == 0;
+
+            for (int start = 0; start < numSamples; start += blockSize)
+            {
+                for (int i = start; i < start + blockSize; ++i)
+                {
+                    reference.pushSample (channel, input[(size_t) i]);
+                    expected[(size_t) i] = reference.popSample (channel, useDelays ? delays[(size_t) i] : (SampleType) -1);
+                }
+
+                blockDelay.pushBlock (channel, input.data() + start, blockSize);
+                blockDelay.popBlock (channel, useDelays ? delays.data() + start : nullptr, actual.data() + start, blockSize);
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (actual[(size_t) i], expected[(size_t) i], (SampleType) 1.0e-5);
+
+            expectEquals ((double) blockDelay.getDelay(), (double) reference.getDelay());
+        }
+    }
+
+    template <typename SampleType>
+    void runTestsForType (const String& typeName)
+    {
+        runBlockTest<SampleType, DelayLineInterpolationTypes::None>        (typeName + " None");
+        runBlockTest<SampleType, DelayLineInterpolationTypes::Linear>      (typeName + " Linear");
+        runBlockTest<SampleType, DelayLineInterpolationTypes::Lagrange3rd> (typeName + " Lagrange3rd");
+        runBlockTest<SampleType, DelayLineInterpolationTypes::Thiran>      (typeName + " Thiran");
+    }
+
+    void runTest() override
+    {
+        runTestsForType<float>  ("float");
+        runTestsForType<double> ("double");
+    }
+};
+
+static DelayLineTests delayLineTests;
+
+} // namespace juce::dsp
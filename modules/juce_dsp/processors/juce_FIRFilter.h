@@ -31,15 +31,56 @@ namespace juce::dsp::FIR
     template <typename NumericType>
     struct Coefficients;
 
+    //==============================================================================
+    /**
+        Applies a set of FIR coefficients using uniformly partitioned FFT convolution.
+
+        The cost per sample grows with the number of coefficients divided by the partition
+        size, rather than with the number of coefficients, but the output is delayed by
+        getLatencyInSamples() samples.
+
+        This is used by Filter<float> for long filters, see Filter::setFFTConvolutionThreshold().
+
+        @see Filter, Convolution
+
+        @tags{DSP}
+    */
+    class JUCE_API  PartitionedConvolver
+    {
+    public:
+        /** Creates a convolver for a set of coefficients. The partition size is rounded
+            up to a power of two.
+        */
+        PartitionedConvolver (const float* coefficients, size_t numCoefficients, size_t partitionSize);
+
+        /** Destructor. */
+        ~PartitionedConvolver();
+
+        /** Clears the processing state. */
+        void reset();
+
+        /** Filters a block of samples. The input and output may point to the same data. */
+        void process (const float* input, float* output, size_t numSamples) noexcept;
+
+        /** Returns the number of samples by which the output is delayed. */
+        size_t getLatencyInSamples() const noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PartitionedConvolver)
+    };
+
     //==============================================================================
     /**
         A processing class that can perform FIR filtering on an audio signal, in the
         time domain.
 
         Using FIRFilter is fast enough for FIRCoefficients with a size lower than 128
-        samples. For longer filters, it might be more efficient to use the class
-        Convolution instead, which does the same processing in the frequency domain
-        thanks to FFT.
+        samples. For longer filters, a float filter can be told to switch to FFT
+        convolution with setFFTConvolutionThreshold(), or you can use the class
+        Convolution instead, which does the same processing in the frequency domain.
 
         @see FIRFilter::Coefficients, Convolution, FFT
 
@@ -100,9 +141,50 @@ namespace juce::dsp::FIR
 
                 for (size_t i = 0; i < size; ++i)
                     fifo[i] = SampleType {0};
+
+                if (updateConvolver (true))
+                    convolver->reset();
+            }
+        }
+
+        //==============================================================================
+        /** Makes the filter use FFT convolution whenever its coefficients have at least
+            the given number of taps. For long filters this is much cheaper than direct
+            convolution.
+
+            FFT convolution processes the signal in partitions of partitionSize samples
+            (rounded up to a power of two), which delays the output by that many samples,
+            see getLatencyInSamples(). Passing 0 for minimumNumTaps turns it off, which is
+            the default.
+
+            FFT convolution is only available for float filters, and has no effect on
+            other sample types. While it's in use, changes to the coefficients' values are
+            picked up by process() but not by processSample(), which only notices when the
+            coefficients object is replaced. Rebuilding the convolver allocates memory and
+            clears the filter's state.
+        */
+        void setFFTConvolutionThreshold (size_t minimumNumTaps, size_t partitionSize = 128)
+        {
+            jassert (partitionSize > 0);
+
+            if (minimumNumTaps != fftThreshold || partitionSize != fftPartitionSize)
+            {
+                fftThreshold = minimumNumTaps;
+                fftPartitionSize = partitionSize;
+                convolver.reset();
+                updateConvolver (true);
             }
         }
 
+        /** Returns the number of samples by which the filter delays its output in addition
+            to the delay of the coefficients themselves. This is only non-zero while FFT
+            convolution is in use.
+        */
+        size_t getLatencyInSamples() const noexcept
+        {
+            return convolver != nullptr ? convolver->getLatencyInSamples() : 0;
+        }
+
         //==============================================================================
         /** The coefficients of the FIR filter. It's up to the caller to ensure that
             these coefficients are modified in a thread-safe way.
@@ -133,6 +215,22 @@ namespace juce::dsp::FIR
             auto* src = inputBlock .getChannelPointer (0);
             auto* dst = outputBlock.getChannelPointer (0);
 
+            if (updateConvolver (true))
+            {
+                if (context.isBypassed)
+                {
+                    if (src != dst)
+                        std::copy (src, src + numSamples, dst);
+                }
+                else
+                {
+                    if constexpr (std::is_same_v<SampleType, float>)
+                        convolver->process (src, dst, numSamples);
+                }
+
+                return;
+            }
+
             auto* fir = coefficients->getRawCoefficients();
             size_t p = pos;
 
@@ -160,6 +258,16 @@ namespace juce::dsp::FIR
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
             check();
+
+            if constexpr (std::is_same_v<SampleType, float>)
+            {
+                if (updateConvolver (false))
+                {
+                    convolver->process (&sample, &sample, 1);
+                    return sample;
+                }
+            }
+
             return processSingleSample (sample, fifo, coefficients->getRawCoefficients(), size, pos);
         }
 
@@ -169,6 +277,43 @@ namespace juce::dsp::FIR
         SampleType* fifo = nullptr;
         size_t pos = 0, size = 0;
 
+        size_t fftThreshold = 0, fftPartitionSize = 128;
+        std::unique_ptr<PartitionedConvolver> convolver;
+        const Coefficients<NumericType>* convolverSource = nullptr;
+        Array<NumericType> convolverCoefficients;
+
+        //==============================================================================
+        // Creates, rebuilds or deletes the FFT convolver as needed, and returns true if it should be used
+        bool updateConvolver ([[maybe_unused]] bool checkCoefficientValues)
+        {
+            if constexpr (std::is_same_v<SampleType, float>)
+            {
+                if (fftThreshold == 0 || coefficients == nullptr || size < fftThreshold)
+                {
+                    convolver.reset();
+                    return false;
+                }
+
+                const auto sourceChanged = convolverSource != coefficients.get();
+
+                if (convolver == nullptr
+                     || ((sourceChanged || checkCoefficientValues) && convolverCoefficients != coefficients->coefficients))
+                {
+                    convolverCoefficients = coefficients->coefficients;
+                    convolver = std::make_unique<PartitionedConvolver> (convolverCoefficients.begin(),
+                                                                        (size_t) convolverCoefficients.size(),
+                                                                        fftPartitionSize);
+                }
+
+                convolverSource = coefficients.get();
+                return true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
         //==============================================================================
         void check()
         {
@@ -211,6 +211,46 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+
+        beginTest ("FFT convolution");
+        {
+            Random random (8392829);
+            constexpr size_t n = 4000, numTaps = 1000;
+
+            std::vector<float> input (n), ref (n), fir (numTaps);
+            fillRandom (random, input.data(), n);
+            fillRandom (random, fir.data(), numTaps);
+            reference<float, float> (fir.data(), numTaps, input.data(), ref.data(), n);
+
+            const auto checkFilter = [&] (auto&& runTest)
+            {
+                FIR::Filter<float> filter (*new FIR::Coefficients<float> (fir.data(), numTaps));
+                filter.setFFTConvolutionThreshold (numTaps, 60);
+                filter.prepare ({ 0.0, n, 1 });
+
+                const auto latency = filter.getLatencyInSamples();
+                expectEquals ((int) latency, 64);
+
+                std::vector<float> output (n);
+                runTest (filter, input.data(), output.data(), n);
+
+                float maxError = 0.0f;
+
+                for (size_t i = latency; i < n; ++i)
+                    maxError = jmax (maxError, std::abs (output[i] - ref[i - latency]));
+
+                expectLessThan (maxError, 1.0e-3f);
+
+                // A filter below the threshold goes back to direct convolution
+                filter.coefficients = *new FIR::Coefficients<float> (fir.data(), numTaps - 1);
+                filter.reset();
+                expectEquals ((int) filter.getLatencyInSamples(), 0);
+            };
+
+            checkFilter ([] (auto& f, auto* s, auto* d, size_t num) { LargeBlockTest::run (f, s, d, num); });
+            checkFilter ([] (auto& f, auto* s, auto* d, size_t num) { SampleBySampleTest::run (f, s, d, num); });
+            checkFilter ([] (auto& f, auto* s, auto* d, size_t num) { SplitBlockTest::run (f, s, d, num); });
+        }
     }
 };
 
@@ -0,0 +1,258 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+template <typename SampleType>
+MultichannelCascade<SampleType>::MultichannelCascade (int numStagesToUse)
+    : numStages (jmax (1, numStagesToUse)),
+      defaultCoefficients ((size_t) numStages, StageCoefficients { 1, 0, 0, 0, 0 })
+{
+    jassert (numStagesToUse > 0);
+}
+
+//==============================================================================
+template <typename SampleType>
+typename MultichannelCascade<SampleType>::StageCoefficients
+    MultichannelCascade<SampleType>::getStageCoefficients (const Coefficients<SampleType>& c) noexcept
+{
+    const auto* raw = c.getRawCoefficients();
+
+    switch (c.getFilterOrder())
+    {
+        case 1:     return { raw[0], raw[1], 0, raw[2], 0 };
+        case 2:     return { raw[0], raw[1], raw[2], raw[3], raw[4] };
+        default:    break;
+    }
+
+    // Only first and second order coefficients can be used in a cascade. Higher order
+    // filters should be split into several biquad stages.
+    jassertfalse;
+    return { 1, 0, 0, 0, 0 };
+}
+
+template <typename SampleType>
+void MultichannelCascade<SampleType>::setCoefficients (int stage, const Coefficients<SampleType>& newCoefficients) noexcept
+{
+    jassert (isPositiveAndBelow (stage, numStages));
+
+    if (! isPositiveAndBelow (stage, numStages))
+        return;
+
+    defaultCoefficients[(size_t) stage] = getStageCoefficients (newCoefficients);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        setLaneCoefficients (channel, stage, defaultCoefficients[(size_t) stage]);
+}
+
+template <typename SampleType>
+void MultichannelCascade<SampleType>::setCoefficients (int channel, int stage, const Coefficients<SampleType>& newCoefficients) noexcept
+{
+    // Per-channel coefficients can only be set after the cascade has been prepared
+    jassert (isPositiveAndBelow (channel, numChannels));
+    jassert (isPositiveAndBelow (stage, numStages));
+
+    if (isPositiveAndBelow (channel, numChannels) && isPositiveAndBelow (stage, numStages))
+        setLaneCoefficients (channel, stage, getStageCoefficients (newCoefficients));
+}
+
+template <typename SampleType>
+void MultichannelCascade<SampleType>::setLaneCoefficients (int channel, int stage, const StageCoefficients& c) noexcept
+{
+    auto* dest = getCoefficients (channel / numLanes, stage) + channel % numLanes;
+
+    for (int i = 0; i < numCoefficients; ++i)
+        dest[i * numLanes] = c[(size_t) i];
+}
+
+template <typename SampleType>
+SampleType* MultichannelCascade<SampleType>::getCoefficients (int group, int stage) noexcept
+{
+    return coefficientData + (group * numStages + stage) * numCoefficients * numLanes;
+}
+
+template <typename SampleType>
+SampleType* MultichannelCascade<SampleType>::getState (int group, int stage) noexcept
+{
+    return stateData + (group * numStages + stage) * numStateVariables * numLanes;
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultichannelCascade<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+    jassert (spec.maximumBlockSize > 0);
+
+    numChannels = (int) spec.numChannels;
+    numGroups = (numChannels + numLanes - 1) / numLanes;
+    maximumBlockSize = jmax (1, (int) spec.maximumBlockSize);
+
+    constexpr auto alignment = (size_t) numLanes * sizeof (SampleType);
+
+    // Each array has one extra vector of space so that its start can be aligned
+    const auto allocate = [] (HeapBlock<SampleType>& storage, int numVectors)
+    {
+        storage.calloc ((size_t) ((numVectors + 1) * numLanes));
+        return snapPointerToAlignment (storage.getData(), alignment);
+    };
+
+    coefficientData = allocate (coefficientStorage, numGroups * numStages * numCoefficients);
+    stateData       = allocate (stateStorage,       numGroups * numStages * numStateVariables);
+    scratch         = allocate (scratchStorage,     maximumBlockSize);
+
+    // Any unused lanes in the last group will be fed silence, so their
+    // coefficients are just left as a pass-through.
+    for (int group = 0; group < numGroups; ++group)
+        for (int stage = 0; stage < numStages; ++stage)
+            std::fill (getCoefficients (group, stage), getCoefficients (group, stage) + numLanes, (SampleType) 1);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        for (int stage = 0; stage < numStages; ++stage)
+            setLaneCoefficients (channel, stage, defaultCoefficients[(size_t) stage]);
+
+    reset();
+}
+
+template <typename SampleType>
+void MultichannelCascade<SampleType>::reset() noexcept
+{
+    if (stateData != nullptr)
+        std::fill (stateData, stateData + numGroups * numStages * numStateVariables * numLanes, SampleType());
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultichannelCascade<SampleType>::processSamples (const AudioBlock<const SampleType>& input,
+                                                      AudioBlock<SampleType>& output,
+                                                      bool isBypassed) noexcept
+{
+    jassert (input.getNumChannels() == output.getNumChannels());
+    jassert (input.getNumSamples() == output.getNumSamples());
+    jassert ((int) output.getNumChannels() <= numChannels);
+
+    if (isBypassed)
+    {
+        if (input != output)
+            output.copyFrom (input);
+
+        return;
+    }
+
+    const auto numChannelsToProcess = jmin ((int) output.getNumChannels(), numChannels);
+    const auto totalNumSamples = (int) output.getNumSamples();
+
+    for (int start = 0; start < totalNumSamples; start += maximumBlockSize)
+    {
+        const auto numSamples = jmin (maximumBlockSize, totalNumSamples - start);
+
+        for (int group = 0; group < numGroups; ++group)
+        {
+            const auto firstChannel = group * numLanes;
+            const auto numInGroup = jmin (numLanes, numChannelsToProcess - firstChannel);
+
+            if (numInGroup <= 0)
+                break;
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                if (lane < numInGroup)
+                {
+                    const auto* src = input.getChannelPointer ((size_t) (firstChannel + lane)) + start;
+
+                    for (int i = 0; i < numSamples; ++i)
+                        scratch[i * numLanes + lane] = src[i];
+                }
+                else
+                {
+                    for (int i = 0; i < numSamples; ++i)
+                        scratch[i * numLanes + lane] = 0;
+                }
+            }
+
+            processGroup (group, numSamples);
+
+            for (int lane = 0; lane < numInGroup; ++lane)
+            {
+                auto* dst = output.getChannelPointer ((size_t) (firstChannel + lane)) + start;
+
+                for (int i = 0; i < numSamples; ++i)
+                    dst[i] = scratch[i * numLanes + lane];
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+void MultichannelCascade<SampleType>::processGroup (int group, int numSamples) noexcept
+{
+   #if JUCE_USE_SIMD
+    const auto load  = [] (const SampleType* ptr)          { return Vector::fromRawArray (ptr); };
+    const auto store = [] (Vector value, SampleType* ptr)  { value.copyToRawArray (ptr); };
+   #else
+    const auto load  = [] (const SampleType* ptr)          { return *ptr; };
+    const auto store = [] (Vector value, SampleType* ptr)  { *ptr = value; };
+   #endif
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        const auto* c = getCoefficients (group, stage);
+        auto* state = getState (group, stage);
+
+        const auto b0 = load (c);
+        const auto b1 = load (c + numLanes);
+        const auto b2 = load (c + 2 * numLanes);
+        const auto a1 = load (c + 3 * numLanes);
+        const auto a2 = load (c + 4 * numLanes);
+
+        auto lv1 = load (state);
+        auto lv2 = load (state + numLanes);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto* sample = scratch + i * numLanes;
+
+            const auto x = load (sample);
+            const auto y = (x * b0) + lv1;
+            store (y, sample);
+
+            lv1 = (x * b1) - (y * a1) + lv2;
+            lv2 = (x * b2) - (y * a2);
+        }
+
+        store (lv1, state);
+        store (lv2, state + numLanes);
+
+        for (int i = 0; i < numStateVariables * numLanes; ++i)
+            util::snapToZero (state[i]);
+    }
+}
+
+//==============================================================================
+template class MultichannelCascade<float>;
+template class MultichannelCascade<double>;
+
+} // namespace juce::dsp::IIR
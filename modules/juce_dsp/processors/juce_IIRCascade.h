@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+/**
+    A cascade of biquad filters that processes many channels at once, using SIMD
+    instructions where they're available.
+
+    Using a ProcessorDuplicator of Filter objects processes each channel on its own.
+    This class instead interleaves groups of channels so that every instruction
+    processes as many channels as will fit into a SIMDRegister. Each channel can
+    have its own set of coefficients, so this is well suited to things like
+    multichannel EQs.
+
+    Each stage of the cascade uses the same Coefficients objects as Filter, but only
+    first and second order coefficients are supported. The stages are processed
+    with the Transposed Direct Form II structure, so the results match those of a
+    chain of Filter objects.
+
+    @see Filter, ProcessorDuplicator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MultichannelCascade
+{
+public:
+    //==============================================================================
+    /** Creates a cascade with the given number of biquad stages. Initially every
+        stage passes its input through unchanged.
+    */
+    explicit MultichannelCascade (int numStages = 1);
+
+    //==============================================================================
+    /** Returns the number of stages in the cascade. */
+    int getNumStages() const noexcept       { return numStages; }
+
+    /** Sets the coefficients used by one stage of the cascade, for every channel.
+
+        This may be called before prepare(). It's up to the caller to make sure that
+        this isn't called at the same time as process().
+    */
+    void setCoefficients (int stage, const Coefficients<SampleType>& newCoefficients) noexcept;
+
+    /** Sets the coefficients used by one stage of the cascade, for a single channel.
+
+        This can only be called after prepare(). It's up to the caller to make sure that
+        this isn't called at the same time as process().
+    */
+    void setCoefficients (int channel, int stage, const Coefficients<SampleType>& newCoefficients) noexcept;
+
+    //==============================================================================
+    /** Allocates the storage needed to process the given number of channels. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the state of every stage, ready to start a new stream of data. */
+    void reset() noexcept;
+
+    /** Processes a block of samples. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, SampleType>,
+                       "The sample-type of the cascade must match the sample-type supplied to this process callback");
+
+        processSamples (context.getInputBlock(), context.getOutputBlock(), context.isBypassed);
+    }
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vector = SIMDRegister<SampleType>;
+    static constexpr int numLanes = (int) Vector::SIMDNumElements;
+   #else
+    using Vector = SampleType;
+    static constexpr int numLanes = 1;
+   #endif
+
+    static constexpr int numCoefficients = 5, numStateVariables = 2;
+    using StageCoefficients = std::array<SampleType, numCoefficients>;
+
+    static StageCoefficients getStageCoefficients (const Coefficients<SampleType>&) noexcept;
+    void setLaneCoefficients (int channel, int stage, const StageCoefficients&) noexcept;
+
+    void processSamples (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output, bool isBypassed) noexcept;
+    void processGroup (int group, int numSamples) noexcept;
+
+    SampleType* getCoefficients (int group, int stage) noexcept;
+    SampleType* getState (int group, int stage) noexcept;
+
+    //==============================================================================
+    const int numStages;
+    std::vector<StageCoefficients> defaultCoefficients;
+
+    HeapBlock<SampleType> coefficientStorage, stateStorage, scratchStorage;
+    SampleType* coefficientData = nullptr;
+    SampleType* stateData = nullptr;
+    SampleType* scratch = nullptr;
+
+    int numChannels = 0, numGroups = 0, maximumBlockSize = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultichannelCascade)
+};
+
+} // namespace juce::dsp::IIR
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+struct MultichannelCascadeTests final : public UnitTest
+{
+    MultichannelCascadeTests()
+        : UnitTest ("IIR MultichannelCascade", UnitTestCategories::dsp)
+    {}
+
+    template <typename SampleType>
+    void runTestsForType()
+    {
+        auto random = getRandom();
+        constexpr int numChannels = 11, numStages = 3, numSamples = 2000, blockSize = 128;
+        constexpr double sampleRate = 48000.0;
+
+        const auto makeCoefficients = [&] (int stage)
+        {
+            const auto frequency = (SampleType) (100.0 + random.nextDouble() * 10000.0);
+            const auto q = (SampleType) (0.3 + random.nextDouble() * 3.0);
+            const auto gain = (SampleType) (0.25 + random.nextDouble() * 3.0);
+
+            switch (stage)
+            {
+                case 0:   return Coefficients<SampleType>::makeFirstOrderLowPass (sampleRate, frequency);
+                case 1:   return Coefficients<SampleType>::makePeakFilter (sampleRate, frequency, q, gain);
+                default:  return Coefficients<SampleType>::makeHighShelf (sampleRate, frequency, q, gain);
+            }
+        };
+
+        AudioBuffer<SampleType> input (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (ch, i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+
+        MultichannelCascade<SampleType> cascade (numStages);
+        std::vector<std::vector<Filter<SampleType>>> reference ((size_t) numChannels);
+
+        // The first stage is shared by every channel, the others are set per channel
+        auto shared = makeCoefficients (0);
+        cascade.setCoefficients (0, *shared);
+        cascade.prepare ({ sampleRate, (uint32) blockSize, (uint32) numChannels });
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            reference[(size_t) ch].emplace_back (shared);
+
+            for (int stage = 1; stage < numStages; ++stage)
+            {
+                auto c = makeCoefficients (stage);
+                cascade.setCoefficients (ch, stage, *c);
+                reference[(size_t) ch].emplace_back (c);
+            }
+        }
+
+        auto expected = input;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            AudioBlock<SampleType> block (expected.getArrayOfWritePointers() + ch, 1, (size_t) numSamples);
+
+            for (auto& filter : reference[(size_t) ch])
+                filter.process (ProcessContextReplacing<SampleType> (block));
+        }
+
+        auto output = input;
+        AudioBlock<SampleType> outputBlock (output);
+
+        for (int start = 0; start < numSamples;)
+        {
+            const auto num = jmin (random.nextInt ({ 1, blockSize * 2 }), numSamples - start);
+            auto subBlock = outputBlock.getSubBlock ((size_t) start, (size_t) num);
+            cascade.process (ProcessContextReplacing<SampleType> (subBlock));
+            start += num;
+        }
+
+        SampleType maxError = 0;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                maxError = jmax (maxError, std::abs (expected.getSample (ch, i) - output.getSample (ch, i)));
+
+        expectLessThan (maxError, (SampleType) 1.0e-4);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Float cascades match a chain of filters");
+        runTestsForType<float>();
+
+        beginTest ("Double cascades match a chain of filters");
+        runTestsForType<double>();
+    }
+};
+
+static MultichannelCascadeTests multichannelCascadeTests;
+
+} // namespace juce::dsp::IIR
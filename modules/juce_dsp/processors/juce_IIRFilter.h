@@ -147,7 +147,14 @@ namespace juce::dsp::IIR
         template <size_t Num>
         explicit Coefficients (const std::array<NumericType, Num>& values) { assignImpl<Num> (values.data()); }
 
-        /** Assigns contents from an array. */
+        /** Assigns contents from an array.
+
+            This won't allocate any memory as long as this object already has room for the
+            coefficients. Objects created by the constructors and factory functions of this
+            class always have room for up to third order filters, so this can be used with the
+            functions in ArrayCoefficients to update the coefficients of a running Filter from
+            the audio thread.
+        */
         template <size_t Num>
         Coefficients& operator= (const std::array<NumericType, Num>& values) { return assignImpl<Num> (values.data()); }
 
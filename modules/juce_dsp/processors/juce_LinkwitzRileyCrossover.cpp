@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+template <typename SampleType>
+LinkwitzRileyCrossover<SampleType>::LinkwitzRileyCrossover (int numBandsToUse)
+    : numBands (jmax (2, numBandsToUse)),
+      numSections (numBands - 1),
+      frequencies ((size_t) numSections),
+      coefficients ((size_t) numSections)
+{
+    jassert (numBandsToUse >= 2);
+
+    // Spread the initial frequencies evenly on a log scale between 100 Hz and 10 kHz
+    for (int i = 0; i < numSections; ++i)
+    {
+        frequencies[(size_t) i] = (SampleType) (100.0 * std::pow (100.0, (i + 1) / (double) numBands));
+        updateCoefficients (i);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::setCrossoverFrequency (int index, SampleType newFrequencyHz)
+{
+    jassert (isPositiveAndBelow (index, numSections));
+    jassert (isPositiveAndBelow (newFrequencyHz, static_cast<SampleType> (sampleRate * 0.5)));
+
+    if (isPositiveAndBelow (index, numSections))
+    {
+        frequencies[(size_t) index] = newFrequencyHz;
+        updateCoefficients (index);
+    }
+}
+
+template <typename SampleType>
+SampleType LinkwitzRileyCrossover<SampleType>::getCrossoverFrequency (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numSections));
+    return isPositiveAndBelow (index, numSections) ? frequencies[(size_t) index] : SampleType();
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::updateCoefficients (int index) noexcept
+{
+    // These match the ones used by LinkwitzRileyFilter
+    const auto g = std::tan (MathConstants<double>::pi * frequencies[(size_t) index] / sampleRate);
+    const auto R2 = std::sqrt (2.0);
+
+    coefficients[(size_t) index] = { (SampleType) g, (SampleType) R2, (SampleType) (1.0 / (1.0 + R2 * g + g * g)) };
+}
+
+//==============================================================================
+template <typename SampleType>
+SampleType* LinkwitzRileyCrossover<SampleType>::getMasks (int group, int section) noexcept
+{
+    return maskData + (group * numSections + section) * numMasks * numLanes;
+}
+
+template <typename SampleType>
+SampleType* LinkwitzRileyCrossover<SampleType>::getState (int group, int section) noexcept
+{
+    return stateData + (group * numSections + section) * numStateVariables * numLanes;
+}
+
+template <typename SampleType>
+SampleType* LinkwitzRileyCrossover<SampleType>::getScratch (int group) noexcept
+{
+    return scratchData + group * maximumBlockSize * numLanes;
+}
+
+//==============================================================================
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+    jassert (spec.maximumBlockSize > 0);
+
+    sampleRate = spec.sampleRate;
+    numChannels = (int) spec.numChannels;
+    maximumBlockSize = jmax (1, (int) spec.maximumBlockSize);
+
+    // Each lane holds one band of one channel
+    const auto numBandLanes = numChannels * numBands;
+    numGroups = (numBandLanes + numLanes - 1) / numLanes;
+
+    constexpr auto alignment = (size_t) numLanes * sizeof (SampleType);
+
+    // Each array has one extra vector of space so that its start can be aligned
+    const auto allocate = [] (HeapBlock<SampleType>& storage, int numVectors)
+    {
+        storage.calloc ((size_t) ((numVectors + 1) * numLanes));
+        return snapPointerToAlignment (storage.getData(), alignment);
+    };
+
+    maskData    = allocate (maskStorage,    numGroups * numSections * numMasks);
+    stateData   = allocate (stateStorage,   numGroups * numSections * numStateVariables);
+    scratchData = allocate (scratchStorage, numGroups * maximumBlockSize);
+
+    // Band b is high-passed by the sections below it, low-passed by its own upper
+    // section and all-passed by the sections above that. Any unused lanes in the
+    // last group keep all-zero masks, so they just output silence.
+    for (int lane = 0; lane < numBandLanes; ++lane)
+    {
+        const auto band = lane % numBands;
+
+        for (int section = 0; section < numSections; ++section)
+        {
+            auto* masks = getMasks (lane / numLanes, section) + lane % numLanes;
+
+            masks[0]            = section == band ? (SampleType) 1 : (SampleType) 0;   // low-pass
+            masks[numLanes]     = section <  band ? (SampleType) 1 : (SampleType) 0;   // high-pass
+            masks[2 * numLanes] = section >  band ? (SampleType) 1 : (SampleType) 0;   // all-pass
+        }
+    }
+
+    for (int i = 0; i < numSections; ++i)
+        updateCoefficients (i);
+
+    reset();
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::reset() noexcept
+{
+    if (stateData != nullptr)
+        std::fill (stateData, stateData + numGroups * numSections * numStateVariables * numLanes, SampleType());
+}
+
+//==============================================================================
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::process (const AudioBlock<const SampleType>& input,
+                                                  Span<const AudioBlock<SampleType>> bandOutputs) noexcept
+{
+    jassert ((int) bandOutputs.size() == numBands);
+    jassert ((int) input.getNumChannels() <= numChannels);
+
+    if ((int) bandOutputs.size() != numBands)
+        return;
+
+    const auto numChannelsToProcess = jmin ((int) input.getNumChannels(), numChannels);
+    const auto numBandLanes = numChannelsToProcess * numBands;
+    const auto totalNumSamples = (int) input.getNumSamples();
+
+    for ([[maybe_unused]] auto& band : bandOutputs)
+    {
+        jassert (band.getNumSamples() == input.getNumSamples());
+        jassert (band.getNumChannels() >= (size_t) numChannelsToProcess);
+    }
+
+    for (int start = 0; start < totalNumSamples; start += maximumBlockSize)
+    {
+        const auto numSamples = jmin (maximumBlockSize, totalNumSamples - start);
+
+        // All the input is read before any output is written, in case they share memory
+        for (int lane = 0; lane < numGroups * numLanes; ++lane)
+        {
+            auto* dst = getScratch (lane / numLanes) + lane % numLanes;
+
+            if (lane < numBandLanes)
+            {
+                const auto* src = input.getChannelPointer ((size_t) (lane / numBands)) + start;
+
+                for (int i = 0; i < numSamples; ++i)
+                    dst[i * numLanes] = src[i];
+            }
+            else
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    dst[i * numLanes] = 0;
+            }
+        }
+
+        for (int group = 0; group < numGroups; ++group)
+            processGroup (group, numSamples);
+
+        for (int lane = 0; lane < numBandLanes; ++lane)
+        {
+            const auto* src = getScratch (lane / numLanes) + lane % numLanes;
+            auto* dst = bandOutputs[(size_t) (lane % numBands)].getChannelPointer ((size_t) (lane / numBands)) + start;
+
+            for (int i = 0; i < numSamples; ++i)
+                dst[i] = src[i * numLanes];
+        }
+    }
+}
+
+template <typename SampleType>
+void LinkwitzRileyCrossover<SampleType>::processGroup (int group, int numSamples) noexcept
+{
+   #if JUCE_USE_SIMD
+    const auto load   = [] (const SampleType* ptr)          { return Vector::fromRawArray (ptr); };
+    const auto store  = [] (Vector value, SampleType* ptr)  { value.copyToRawArray (ptr); };
+    const auto expand = [] (SampleType value)               { return Vector::expand (value); };
+   #else
+    const auto load   = [] (const SampleType* ptr)          { return *ptr; };
+    const auto store  = [] (Vector value, SampleType* ptr)  { *ptr = value; };
+    const auto expand = [] (SampleType value)               { return value; };
+   #endif
+
+    auto* scratch = getScratch (group);
+
+    for (int section = 0; section < numSections; ++section)
+    {
+        const auto& c = coefficients[(size_t) section];
+        const auto g = expand (c.g);
+        const auto R2 = expand (c.R2);
+        const auto h = expand (c.h);
+        const auto R2plusG = expand (c.R2 + c.g);
+
+        const auto* masks = getMasks (group, section);
+        const auto lowMask  = load (masks);
+        const auto highMask = load (masks + numLanes);
+        const auto allMask  = load (masks + 2 * numLanes);
+
+        auto* state = getState (group, section);
+        auto s1 = load (state);
+        auto s2 = load (state + numLanes);
+        auto s3 = load (state + 2 * numLanes);
+        auto s4 = load (state + 3 * numLanes);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto* sample = scratch + i * numLanes;
+
+            // The same TPT structure as LinkwitzRileyFilter::processSample()
+            const auto yH = (load (sample) - R2plusG * s1 - s2) * h;
+
+            const auto yB = g * yH + s1;
+            s1 = g * yH + yB;
+
+            const auto yL = g * yB + s2;
+            s2 = g * yB + yL;
+
+            const auto yH2 = (lowMask * yL + highMask * yH - R2plusG * s3 - s4) * h;
+
+            const auto yB2 = g * yH2 + s3;
+            s3 = g * yH2 + yB2;
+
+            const auto yL2 = g * yB2 + s4;
+            s4 = g * yB2 + yL2;
+
+            store (lowMask * yL2 + highMask * yH2 + allMask * (yL - R2 * yB + yH), sample);
+        }
+
+        store (s1, state);
+        store (s2, state + numLanes);
+        store (s3, state + 2 * numLanes);
+        store (s4, state + 3 * numLanes);
+
+        for (int i = 0; i < numStateVariables * numLanes; ++i)
+            util::snapToZero (state[i]);
+    }
+}
+
+//==============================================================================
+template class LinkwitzRileyCrossover<float>;
+template class LinkwitzRileyCrossover<double>;
+
+} // namespace juce::dsp
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    Splits a signal into any number of frequency bands using Linkwitz-Riley filters,
+    such that the bands sum back together with a flat magnitude response.
+
+    The bands are the same as those of the usual tree of LinkwitzRileyFilter objects,
+    where the high output of each crossover is split again by the next one, and every
+    lower band is passed through an all-pass filter at each of the higher crossover
+    frequencies so that the bands stay in phase with each other. Instead of running
+    that chain of filters for one band and channel at a time, this class computes the
+    bands in parallel: each band of each channel goes through one filter section per
+    crossover frequency, acting as a low-pass, high-pass or all-pass as needed, and
+    the sections are processed as the lanes of SIMDRegisters where they're available.
+
+    The results match those of a tree of LinkwitzRileyFilter objects, and like those
+    filters, each crossover has a -24 dB/octave slope.
+
+    @see LinkwitzRileyFilter
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class LinkwitzRileyCrossover
+{
+public:
+    //==============================================================================
+    /** Creates a crossover that splits its input into the given number of bands. */
+    explicit LinkwitzRileyCrossover (int numBands = 2);
+
+    //==============================================================================
+    /** Returns the number of bands that the input is split into. */
+    int getNumBands() const noexcept                { return numBands; }
+
+    /** Sets the frequency that separates band (index) from band (index + 1). The
+        frequencies should be in increasing order.
+    */
+    void setCrossoverFrequency (int index, SampleType newFrequencyHz);
+
+    /** Returns the frequency that separates band (index) from band (index + 1). */
+    SampleType getCrossoverFrequency (int index) const noexcept;
+
+    //==============================================================================
+    /** Initialises the crossover. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the filters. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Splits a block of samples into bands.
+
+        There must be one output block for each band, starting with the lowest, and each
+        must have the same size as the input. The outputs can be views into any existing
+        buffers, and the input may share its memory with one of them.
+    */
+    void process (const AudioBlock<const SampleType>& input,
+                  Span<const AudioBlock<SampleType>> bandOutputs) noexcept;
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vector = SIMDRegister<SampleType>;
+    static constexpr int numLanes = (int) Vector::SIMDNumElements;
+   #else
+    using Vector = SampleType;
+    static constexpr int numLanes = 1;
+   #endif
+
+    // The multipliers that choose the output of a section for each lane
+    static constexpr int numMasks = 3, numStateVariables = 4;
+
+    struct SectionCoefficients
+    {
+        SampleType g, R2, h;
+    };
+
+    void updateCoefficients (int index) noexcept;
+    void processGroup (int group, int numSamples) noexcept;
+
+    SampleType* getMasks (int group, int section) noexcept;
+    SampleType* getState (int group, int section) noexcept;
+    SampleType* getScratch (int group) noexcept;
+
+    //==============================================================================
+    const int numBands, numSections;
+    std::vector<SampleType> frequencies;
+    std::vector<SectionCoefficients> coefficients;
+
+    HeapBlock<SampleType> maskStorage, stateStorage, scratchStorage;
+    SampleType* maskData = nullptr;
+    SampleType* stateData = nullptr;
+    SampleType* scratchData = nullptr;
+
+    double sampleRate = 44100.0;
+    int numChannels = 0, numGroups = 0, maximumBlockSize = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LinkwitzRileyCrossover)
+};
+
+} // namespace juce::dsp
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct LinkwitzRileyCrossoverTests final : public UnitTest
+{
+    LinkwitzRileyCrossoverTests()
+        : UnitTest ("LinkwitzRileyCrossover", UnitTestCategories::dsp)
+    {}
+
+    template <typename SampleType>
+    void runTestsForType (SampleType tolerance)
+    {
+        auto random = getRandom();
+        constexpr int numChannels = 3, numBands = 5, numSamples = 3000, blockSize = 256;
+        constexpr double sampleRate = 48000.0;
+        const SampleType frequencies[] = { 120, 500, 2000, 8000 };
+
+        AudioBuffer<SampleType> input (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (ch, i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+
+        const auto applyFilter = [&] (AudioBuffer<SampleType>& buffer, int section, LinkwitzRileyFilterType type)
+        {
+            LinkwitzRileyFilter<SampleType> filter;
+            filter.prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+            filter.setType (type);
+            filter.setCutoffFrequency (frequencies[section]);
+
+            AudioBlock<SampleType> block (buffer);
+            filter.process (ProcessContextReplacing<SampleType> (block));
+        };
+
+        // Each band of a tree of crossovers has been through every section, as a
+        // high-pass below the band, a low-pass at its top and an all-pass above that
+        std::vector<AudioBuffer<SampleType>> expected;
+
+        for (int band = 0; band < numBands; ++band)
+        {
+            expected.push_back (input);
+
+            for (int section = 0; section < numBands - 1; ++section)
+                applyFilter (expected.back(), section, section < band  ? LinkwitzRileyFilterType::highpass
+                                                     : section == band ? LinkwitzRileyFilterType::lowpass
+                                                                       : LinkwitzRileyFilterType::allpass);
+        }
+
+        auto expectedSum = input;
+
+        for (int section = 0; section < numBands - 1; ++section)
+            applyFilter (expectedSum, section, LinkwitzRileyFilterType::allpass);
+
+        LinkwitzRileyCrossover<SampleType> crossover (numBands);
+        crossover.prepare ({ sampleRate, (uint32) blockSize, (uint32) numChannels });
+
+        for (int section = 0; section < numBands - 1; ++section)
+            crossover.setCrossoverFrequency (section, frequencies[section]);
+
+        // The lowest band is written over the input
+        std::vector<AudioBuffer<SampleType>> bands { input };
+
+        for (int band = 1; band < numBands; ++band)
+            bands.emplace_back (numChannels, numSamples);
+
+        for (int start = 0; start < numSamples;)
+        {
+            const auto num = jmin (random.nextInt ({ 1, blockSize * 2 }), numSamples - start);
+
+            std::vector<AudioBlock<SampleType>> bandBlocks;
+
+            for (auto& band : bands)
+                bandBlocks.push_back (AudioBlock<SampleType> (band).getSubBlock ((size_t) start, (size_t) num));
+
+            crossover.process (bandBlocks.front(), bandBlocks);
+            start += num;
+        }
+
+        const auto getMaxError = [] (const AudioBuffer<SampleType>& a, const AudioBuffer<SampleType>& b)
+        {
+            SampleType maxError = 0;
+
+            for (int ch = 0; ch < a.getNumChannels(); ++ch)
+                for (int i = 0; i < a.getNumSamples(); ++i)
+                    maxError = jmax (maxError, std::abs (a.getSample (ch, i) - b.getSample (ch, i)));
+
+            return maxError;
+        };
+
+        for (int band = 0; band < numBands; ++band)
+            expectLessThan (getMaxError (bands[(size_t) band], expected[(size_t) band]), tolerance);
+
+        auto sum = bands.front();
+
+        for (int band = 1; band < numBands; ++band)
+            for (int ch = 0; ch < numChannels; ++ch)
+                sum.addFrom (ch, 0, bands[(size_t) band], ch, 0, numSamples);
+
+        expectLessThan (getMaxError (sum, expectedSum), tolerance * 10);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Float bands match a tree of filters and sum to an all-pass");
+        runTestsForType<float> (1.0e-5f);
+
+        beginTest ("Double bands match a tree of filters and sum to an all-pass");
+        runTestsForType<double> (1.0e-12);
+    }
+};
+
+static LinkwitzRileyCrossoverTests linkwitzRileyCrossoverTests;
+
+} // namespace juce::dsp
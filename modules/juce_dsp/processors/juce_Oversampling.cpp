@@ -526,6 +526,277 @@ private:
 };
 
 
+//==============================================================================
+/** Oversampling stage class performing oversampling by any integer factor in a
+    single step, using polyphase FIR filters designed with the Kaiser method. The
+    filters can be either linear phase, or converted to minimum phase to reduce
+    the latency.
+*/
+template <typename SampleType>
+struct OversamplingPolyphaseFIR final : public Oversampling<SampleType>::OversamplingStage
+{
+    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+
+    OversamplingPolyphaseFIR (size_t numChans, size_t newFactor,
+                              SampleType normalisedTransitionWidthUp,
+                              SampleType stopbandAmplitudedBUp,
+                              SampleType normalisedTransitionWidthDown,
+                              SampleType stopbandAmplitudedBDown,
+                              bool useMinimumPhase)
+        : ParentType (numChans, newFactor),
+          numPhases ((int) newFactor),
+          paddedNumPhases ((numPhases + numLanes - 1) / numLanes * numLanes)
+    {
+        jassert (newFactor > 1);
+
+        auto kernelUp   = designKernel (normalisedTransitionWidthUp,   stopbandAmplitudedBUp,   useMinimumPhase);
+        auto kernelDown = designKernel (normalisedTransitionWidthDown, stopbandAmplitudedBDown, useMinimumPhase);
+
+        latency = getKernelLatency (kernelUp, useMinimumPhase)
+                + getKernelLatency (kernelDown, useMinimumPhase)
+                - static_cast<SampleType> (numPhases - 1);
+
+        // The upsampled signal is zero apart from one in every numPhases samples, so
+        // the interpolation filter needs extra gain to keep the level the same.
+        for (auto& c : kernelUp)
+            c *= static_cast<SampleType> (numPhases);
+
+        numTapsUp   = (int) (kernelUp.size()   + (size_t) numPhases - 1) / numPhases;
+        numTapsDown = (int) (kernelDown.size() + (size_t) numPhases - 1) / numPhases;
+
+        coefficientsUp   = allocateAligned (coefficientsUpStorage,   numTapsUp   * paddedNumPhases);
+        coefficientsDown = allocateAligned (coefficientsDownStorage, numTapsDown * paddedNumPhases);
+
+        // Each tap holds the coefficients for every phase, with the taps in reverse
+        // order so that they line up with the oldest-first history buffers.
+        for (size_t i = 0; i < kernelUp.size(); ++i)
+            coefficientsUp[(numTapsUp - 1 - (int) i / numPhases) * paddedNumPhases + (int) i % numPhases] = kernelUp[i];
+
+        for (size_t i = 0; i < kernelDown.size(); ++i)
+            coefficientsDown[(numTapsDown - 1 - (int) i / numPhases) * paddedNumPhases + (int) i % numPhases] = kernelDown[i];
+
+        historyUp   = allocateAligned (historyUpStorage,   (int) this->numChannels * 2 * numTapsUp);
+        historyDown = allocateAligned (historyDownStorage, (int) this->numChannels * 2 * numTapsDown * paddedNumPhases);
+        scratch     = allocateAligned (scratchStorage,     paddedNumPhases);
+
+        positions.resize (static_cast<int> (this->numChannels) * 2);
+        reset();
+    }
+
+    //==============================================================================
+    SampleType getLatencyInSamples() const override
+    {
+        return latency;
+    }
+
+    void reset() override
+    {
+        ParentType::reset();
+
+        std::fill (historyUp,   historyUp   + (int) this->numChannels * 2 * numTapsUp, SampleType());
+        std::fill (historyDown, historyDown + (int) this->numChannels * 2 * numTapsDown * paddedNumPhases, SampleType());
+
+        positions.fill (0);
+    }
+
+    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    {
+        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        const auto numSamples = inputBlock.getNumSamples();
+
+        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        {
+            auto* bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
+            auto* history = historyUp + (int) channel * 2 * numTapsUp;
+            auto* samples = inputBlock.getChannelPointer (channel);
+            auto pos = positions.getUnchecked (static_cast<int> (channel) * 2);
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                // The history is written twice, so that the most recent numTapsUp
+                // samples can always be read contiguously.
+                history[pos] = history[pos + numTapsUp] = samples[i];
+                pos = (pos + 1 == numTapsUp ? 0 : pos + 1);
+
+                const auto* recent = history + pos;
+
+                for (int p = 0; p < paddedNumPhases; p += numLanes)
+                {
+                    auto out = Vector();
+
+                    for (int k = 0; k < numTapsUp; ++k)
+                        out = out + load (coefficientsUp + k * paddedNumPhases + p) * expand (recent[k]);
+
+                    store (out, scratch + p);
+                }
+
+                std::copy (scratch, scratch + numPhases, bufferSamples + i * (size_t) numPhases);
+            }
+
+            positions.setUnchecked (static_cast<int> (channel) * 2, pos);
+        }
+    }
+
+    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    {
+        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        const auto numSamples = outputBlock.getNumSamples();
+        const auto frameSize = paddedNumPhases;
+
+        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        {
+            auto* bufferSamples = ParentType::buffer.getReadPointer (static_cast<int> (channel));
+            auto* history = historyDown + (int) channel * 2 * numTapsDown * frameSize;
+            auto* samples = outputBlock.getChannelPointer (channel);
+            auto pos = positions.getUnchecked (static_cast<int> (channel) * 2 + 1);
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                // Each frame holds one block of numPhases oversampled samples, newest
+                // first, so that the filter can be applied one frame at a time.
+                auto* frame = history + pos * frameSize;
+                auto* copy  = history + (pos + numTapsDown) * frameSize;
+                const auto* in = bufferSamples + i * (size_t) numPhases;
+
+                for (int p = 0; p < numPhases; ++p)
+                    frame[p] = copy[p] = in[numPhases - 1 - p];
+
+                pos = (pos + 1 == numTapsDown ? 0 : pos + 1);
+
+                const auto* recent = history + pos * frameSize;
+                auto out = Vector();
+
+                for (int k = 0; k < numTapsDown; ++k)
+                    for (int p = 0; p < frameSize; p += numLanes)
+                        out = out + load (coefficientsDown + k * frameSize + p) * load (recent + k * frameSize + p);
+
+                samples[i] = sum (out);
+            }
+
+            positions.setUnchecked (static_cast<int> (channel) * 2 + 1, pos);
+        }
+    }
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vector = SIMDRegister<SampleType>;
+    static constexpr int numLanes = (int) Vector::SIMDNumElements;
+
+    static Vector load (const SampleType* ptr) noexcept         { return Vector::fromRawArray (ptr); }
+    static void store (Vector value, SampleType* ptr) noexcept  { value.copyToRawArray (ptr); }
+    static Vector expand (SampleType value) noexcept            { return Vector::expand (value); }
+    static SampleType sum (Vector value) noexcept               { return value.sum(); }
+   #else
+    using Vector = SampleType;
+    static constexpr int numLanes = 1;
+
+    static Vector load (const SampleType* ptr) noexcept         { return *ptr; }
+    static void store (Vector value, SampleType* ptr) noexcept  { *ptr = value; }
+    static Vector expand (SampleType value) noexcept            { return value; }
+    static SampleType sum (Vector value) noexcept               { return value; }
+   #endif
+
+    static SampleType* allocateAligned (HeapBlock<SampleType>& storage, int numElements)
+    {
+        storage.calloc ((size_t) (numElements + numLanes));
+        return snapPointerToAlignment (storage.getData(), (size_t) numLanes * sizeof (SampleType));
+    }
+
+    //==============================================================================
+    /** Designs a low-pass filter at the oversampled rate, with its transition band
+        centred on the Nyquist frequency of the original sample rate.
+    */
+    std::vector<SampleType> designKernel (SampleType normalisedTransitionWidth, SampleType stopbandAmplitudedB,
+                                          bool useMinimumPhase) const
+    {
+        auto coefficients = FilterDesign<SampleType>::designFIRLowpassKaiserMethod (static_cast<SampleType> (0.5),
+                                                                                  static_cast<double> (numPhases),
+                                                                                  normalisedTransitionWidth / static_cast<SampleType> (numPhases),
+                                                                                  stopbandAmplitudedB);
+
+        const auto* raw = coefficients->getRawCoefficients();
+        std::vector<SampleType> kernel (raw, raw + coefficients->getFilterOrder() + 1);
+
+        if (useMinimumPhase)
+            convertToMinimumPhase (kernel);
+
+        return kernel;
+    }
+
+    /** Replaces a linear phase kernel with the minimum phase kernel that has the same
+        magnitude response, using the real cepstrum.
+    */
+    static void convertToMinimumPhase (std::vector<SampleType>& kernel)
+    {
+        const auto order = jmax (4, roundToInt (std::ceil (std::log2 ((double) kernel.size()))) + 4);
+        const auto size = 1 << order;
+
+        FFT fft (order);
+        std::vector<Complex<float>> data ((size_t) size), spectrum ((size_t) size);
+
+        std::transform (kernel.begin(), kernel.end(), data.begin(), [] (auto c) { return Complex<float> ((float) c); });
+        fft.perform (data.data(), spectrum.data(), false);
+
+        for (auto& bin : spectrum)
+            bin = std::log (jmax (std::abs (bin), 1.0e-9f));
+
+        fft.perform (spectrum.data(), data.data(), true);
+
+        // Folding the real cepstrum onto positive time gives a causal, minimum phase
+        // response with the same magnitude.
+        for (int i = 1; i < size / 2; ++i)
+            data[(size_t) i] = 2.0f * data[(size_t) i].real();
+
+        data[0] = data[0].real();
+        data[(size_t) size / 2] = data[(size_t) size / 2].real();
+        std::fill (data.begin() + size / 2 + 1, data.end(), Complex<float>());
+
+        fft.perform (data.data(), spectrum.data(), false);
+
+        for (auto& bin : spectrum)
+            bin = std::exp (bin);
+
+        fft.perform (spectrum.data(), data.data(), true);
+
+        for (size_t i = 0; i < kernel.size(); ++i)
+            kernel[i] = static_cast<SampleType> (data[i].real());
+    }
+
+    /** Returns the delay of a kernel at low frequencies, in oversampled samples. */
+    static SampleType getKernelLatency (const std::vector<SampleType>& kernel, bool isMinimumPhase)
+    {
+        if (! isMinimumPhase)
+            return static_cast<SampleType> (kernel.size() - 1) * static_cast<SampleType> (0.5);
+
+        FIR::Coefficients<SampleType> coefficients (kernel.data(), kernel.size());
+        return static_cast<SampleType> (-(coefficients.getPhaseForFrequency (0.0001, 1.0)) / (0.0001 * MathConstants<double>::twoPi));
+    }
+
+    //==============================================================================
+    const int numPhases, paddedNumPhases;
+    int numTapsUp = 0, numTapsDown = 0;
+    SampleType latency = 0;
+
+    HeapBlock<SampleType> coefficientsUpStorage, coefficientsDownStorage,
+                          historyUpStorage, historyDownStorage, scratchStorage;
+    SampleType* coefficientsUp = nullptr;
+    SampleType* coefficientsDown = nullptr;
+    SampleType* historyUp = nullptr;
+    SampleType* historyDown = nullptr;
+    SampleType* scratch = nullptr;
+
+    Array<int> positions;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingPolyphaseFIR)
+};
+
+
 //==============================================================================
 template <typename SampleType>
 Oversampling<SampleType>::Oversampling (size_t newNumChannels)
@@ -548,6 +819,12 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
     {
         addDummyOversamplingStage();
     }
+    else if (newType == FilterType::filterPolyphaseFIR)
+    {
+        addPolyphaseOversamplingStage ((size_t) 1 << newFactor,
+                                       isMaximumQuality ? 0.10f : 0.12f, isMaximumQuality ? -90.0f : -70.0f,
+                                       isMaximumQuality ? 0.12f : 0.15f, isMaximumQuality ? -75.0f : -60.0f);
+    }
     else if (newType == FilterType::filterHalfBandPolyphaseIIR)
     {
         for (size_t n = 0; n < newFactor; ++n)
@@ -610,6 +887,14 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
                                                                     normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
                                                                     normalisedTransitionWidthDown, stopbandAmplitudedBDown));
     }
+    else if (type == FilterType::filterPolyphaseFIR)
+    {
+        // The transition widths of the half-band stages are relative to the oversampled rate
+        stages.add (new OversamplingPolyphaseFIR<SampleType> (numChannels, 2,
+                                                              normalisedTransitionWidthUp * 2.0f,   stopbandAmplitudedBUp,
+                                                              normalisedTransitionWidthDown * 2.0f, stopbandAmplitudedBDown,
+                                                              false));
+    }
     else
     {
         stages.add (new Oversampling2TimesEquirippleFIR<SampleType> (numChannels,
@@ -620,6 +905,30 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
     factorOversampling *= 2;
 }
 
+template <typename SampleType>
+void Oversampling<SampleType>::addPolyphaseOversamplingStage (size_t factor,
+                                                              float normalisedTransitionWidthUp,
+                                                              float stopbandAmplitudedBUp,
+                                                              float normalisedTransitionWidthDown,
+                                                              float stopbandAmplitudedBDown,
+                                                              bool useMinimumPhase)
+{
+    jassert (factor > 0);
+
+    if (factor <= 1)
+    {
+        addDummyOversamplingStage();
+        return;
+    }
+
+    stages.add (new OversamplingPolyphaseFIR<SampleType> (numChannels, factor,
+                                                          normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                          normalisedTransitionWidthDown, stopbandAmplitudedBDown,
+                                                          useMinimumPhase));
+
+    factorOversampling *= factor;
+}
+
 template <typename SampleType>
 void Oversampling<SampleType>::clearOversamplingStages()
 {
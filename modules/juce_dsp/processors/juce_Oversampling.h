@@ -32,7 +32,8 @@ namespace juce::dsp
 
     This class can be configured to do a factor of 2, 4, 8 or 16 times
     oversampling, using multiple stages, with polyphase allpass IIR filters or FIR
-    filters, and latency compensation.
+    filters, and latency compensation. Polyphase FIR stages can also oversample
+    by any integer factor in a single step.
 
     The principle of oversampling is to increase the sample rate of a given
     non-linear process to prevent it from creating aliasing. Oversampling works
@@ -45,6 +46,10 @@ namespace juce::dsp
     latency is maximised. With IIR filtering the phase is compromised around the
     Nyquist frequency but the latency is minimised.
 
+    A single polyphase FIR stage avoids the intermediate buffers and the latency
+    that builds up over a cascade of 2x stages. The polyphase FIR filters may also
+    be minimum phase, which lowers their latency further at the cost of linear phase.
+
     @see FilterDesign.
 
     @tags{DSP}
@@ -58,6 +63,7 @@ public:
     {
         filterHalfBandFIREquiripple = 0,
         filterHalfBandPolyphaseIIR,
+        filterPolyphaseFIR,
         numFilterTypes
     };
 
@@ -78,7 +84,8 @@ public:
         @param numChannels          the number of channels to process with this object
         @param factor               the processing will perform 2 ^ factor times oversampling
         @param type                 the type of filter design employed for filtering during
-                                    oversampling
+                                    oversampling. With filterPolyphaseFIR, a single stage
+                                    performs all of the oversampling
         @param isMaxQuality         if the oversampling is done using the maximum quality, where
                                     the filters will be more efficient but the CPU load will
                                     increase as well
@@ -169,6 +176,37 @@ public:
                                float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
                                float normalisedTransitionWidthDown, float stopbandAmplitudedBDown);
 
+    /** Adds a new oversampling stage that multiplies the current oversampling factor by
+        any integer, using a single polyphase FIR filter in each direction.
+
+        The filters are designed using the Kaiser method, with each transition band
+        centred on the Nyquist frequency of the sample rate before this stage.
+        Processing all of the oversampling in a single stage uses less CPU and has
+        less latency than a cascade of 2x stages.
+
+        @param factor                          the oversampling factor of this stage, for
+                                               example 3, 6 or 8
+        @param normalisedTransitionWidthUp     a value between 0 and 0.5 which specifies the width
+                                               of the transition band of the upsampling filter,
+                                               relative to the sample rate before oversampling
+        @param stopbandAmplitudedBUp           the amplitude in dB in the stopband for upsampling
+                                               filtering, between -100 and 0
+        @param normalisedTransitionWidthDown   a value between 0 and 0.5 which specifies the width
+                                               of the transition band of the downsampling filter,
+                                               relative to the sample rate before oversampling
+        @param stopbandAmplitudedBDown         the amplitude in dB in the stopband for downsampling
+                                               filtering, between -100 and 0
+        @param useMinimumPhase                 if true, the filters are converted to minimum phase,
+                                               which greatly reduces the latency, but means that
+                                               the phase response is no longer linear
+
+        @see addOversamplingStage, clearOversamplingStages
+    */
+    void addPolyphaseOversamplingStage (size_t factor,
+                                        float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
+                                        float normalisedTransitionWidthDown, float stopbandAmplitudedBDown,
+                                        bool useMinimumPhase = false);
+
     /** Adds a new "dummy" oversampling stage, which does nothing to the signal. Using
         one can be useful if your application features a customisable oversampling factor
         and if you want to select the current one from an OwnedArray without changing
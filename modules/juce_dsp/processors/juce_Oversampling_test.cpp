@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct OversamplingTests final : public UnitTest
+{
+    OversamplingTests()
+        : UnitTest ("Oversampling", UnitTestCategories::dsp)
+    {}
+
+    // Passes a sine through the oversampler and back, returning the result
+    static std::vector<float> processSine (Oversampling<float>& oversampling, double frequency, int numSamples)
+    {
+        constexpr int blockSize = 100;
+        oversampling.initProcessing (blockSize);
+
+        std::vector<float> samples ((size_t) numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            samples[(size_t) i] = (float) std::sin (MathConstants<double>::twoPi * frequency * i);
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            auto* channel = samples.data() + start;
+            AudioBlock<float> block (&channel, 1, (size_t) jmin (blockSize, numSamples - start));
+
+            oversampling.processSamplesUp (block);
+            oversampling.processSamplesDown (block);
+        }
+
+        return samples;
+    }
+
+    void expectDelayedSine (const std::vector<float>& samples, double frequency, double latency)
+    {
+        auto maxError = 0.0;
+
+        for (size_t i = samples.size() / 2; i < samples.size(); ++i)
+        {
+            const auto expected = std::sin (MathConstants<double>::twoPi * frequency * ((double) i - latency));
+            maxError = jmax (maxError, std::abs (expected - (double) samples[i]));
+        }
+
+        expectLessThan (maxError, 1.0e-3);
+    }
+
+    void runTest() override
+    {
+        constexpr auto frequency = 0.02;
+        constexpr int numSamples = 4000;
+
+        beginTest ("Polyphase stages reproduce a delayed copy of the input");
+        {
+            for (size_t factor : { 2u, 3u, 6u, 8u })
+            {
+                Oversampling<float> oversampling (1);
+                oversampling.clearOversamplingStages();
+                oversampling.addPolyphaseOversamplingStage (factor, 0.1f, -90.0f, 0.12f, -75.0f);
+
+                expectEquals ((int) oversampling.getOversamplingFactor(), (int) factor);
+
+                const auto output = processSine (oversampling, frequency, numSamples);
+                expectDelayedSine (output, frequency, oversampling.getLatencyInSamples());
+            }
+        }
+
+        beginTest ("Polyphase stages can be combined with other stages");
+        {
+            Oversampling<float> oversampling (1);
+            oversampling.clearOversamplingStages();
+            oversampling.addPolyphaseOversamplingStage (3, 0.1f, -90.0f, 0.12f, -75.0f);
+            oversampling.addOversamplingStage (Oversampling<float>::filterHalfBandFIREquiripple, 0.1f, -80.0f, 0.1f, -80.0f);
+
+            expectEquals ((int) oversampling.getOversamplingFactor(), 6);
+
+            const auto output = processSine (oversampling, frequency, numSamples);
+            expectDelayedSine (output, frequency, oversampling.getLatencyInSamples());
+        }
+
+        beginTest ("Single stage oversampling has less latency than a cascade");
+        {
+            Oversampling<float> cascade (1, 3, Oversampling<float>::filterHalfBandFIREquiripple, true, true);
+            Oversampling<float> polyphase (1, 3, Oversampling<float>::filterPolyphaseFIR, true, true);
+
+            expectEquals ((int) polyphase.getOversamplingFactor(), 8);
+
+            const auto output = processSine (polyphase, frequency, numSamples);
+            expectDelayedSine (output, frequency, polyphase.getLatencyInSamples());
+
+            cascade.initProcessing (100);
+            expectLessThan (polyphase.getLatencyInSamples(), cascade.getLatencyInSamples());
+        }
+
+        beginTest ("Minimum phase stages have less latency");
+        {
+            Oversampling<float> linear (1), minimum (1);
+            linear.clearOversamplingStages();
+            minimum.clearOversamplingStages();
+
+            linear .addPolyphaseOversamplingStage (4, 0.1f, -90.0f, 0.12f, -75.0f, false);
+            minimum.addPolyphaseOversamplingStage (4, 0.1f, -90.0f, 0.12f, -75.0f, true);
+
+            expectLessThan (minimum.getLatencyInSamples(), linear.getLatencyInSamples() * 0.5f);
+
+            // The phase delay of a minimum phase filter varies with frequency, so only
+            // the level of the output is checked here
+            const auto output = processSine (minimum, frequency, numSamples);
+            const auto peak = std::accumulate (output.begin() + numSamples / 2, output.end(), 0.0f,
+                                               [] (auto a, auto b) { return jmax (a, std::abs (b)); });
+
+            expectWithinAbsoluteError (peak, 1.0f, 1.0e-2f);
+        }
+    }
+};
+
+static OversamplingTests oversamplingTests;
+
+} // namespace juce::dsp
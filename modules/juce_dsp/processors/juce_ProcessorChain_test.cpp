@@ -156,6 +156,47 @@ public:
                 expectEquals (outBuf.getSample (0, 0), 4.0f);
             }
         }
+
+        beginTest ("Processing in sub-blocks matches processing whole blocks");
+        {
+            using Chain = ProcessorChain<Gain<float>, Bias<float>, FirstOrderTPTFilter<float>, WaveShaper<float>>;
+
+            constexpr int numChannels = 2, numSamples = 500;
+            const ProcessSpec spec { 44100.0, (uint32) numSamples, (uint32) numChannels };
+
+            Chain wholeBlocks, subBlocks;
+
+            for (auto* chain : { &wholeBlocks, &subBlocks })
+            {
+                get<0> (*chain).setRampDurationSeconds (0.005);
+                get<1> (*chain).setRampDurationSeconds (0.005);
+                get<2> (*chain).setCutoffFrequency (2000.0f);
+                get<3> (*chain).functionToUse = [] (float x) { return std::tanh (x); };
+
+                chain->prepare (spec);
+
+                get<0> (*chain).setGainLinear (3.0f);
+                get<1> (*chain).setBias (0.25f);
+            }
+
+            auto random = getRandom();
+            AudioBuffer<float> input (numChannels, numSamples), expected (numChannels, numSamples), actual (numChannels, numSamples);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    input.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+            AudioBlock<const float> inputBlock (input);
+            AudioBlock<float> expectedBlock (expected), actualBlock (actual);
+
+            wholeBlocks.process (ProcessContextNonReplacing<float> (inputBlock, expectedBlock));
+            subBlocks.processInSubBlocks<32> (ProcessContextNonReplacing<float> (inputBlock, actualBlock));
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (actual.getSample (ch, i), expected.getSample (ch, i), 1.0e-6f);
+
+        }
     }
 };
 
@@ -118,6 +118,61 @@ SampleType StateVariableTPTFilter<SampleType>::processSample (int channel, Sampl
     }
 }
 
+template <typename SampleType>
+void StateVariableTPTFilter<SampleType>::processWithModulatedCutoff (size_t channel,
+                                                                     const SampleType* input,
+                                                                     SampleType* output,
+                                                                     const SampleType* cutoffFrequenciesHz,
+                                                                     size_t numSamples) noexcept
+{
+    // The coefficients are calculated in short runs, which the compiler can vectorise
+    constexpr size_t maxRunLength = 32;
+    SampleType gs[maxRunLength], hs[maxRunLength];
+
+    const auto omegaScale = static_cast<SampleType> (MathConstants<double>::pi / sampleRate);
+    const auto maxOmega   = static_cast<SampleType> (MathConstants<double>::pi * 0.49);
+
+    auto ls1 = s1[channel];
+    auto ls2 = s2[channel];
+
+    for (size_t start = 0; start < numSamples; start += maxRunLength)
+    {
+        const auto runLength = jmin (maxRunLength, numSamples - start);
+
+        for (size_t i = 0; i < runLength; ++i)
+            gs[i] = jlimit (SampleType(), maxOmega, omegaScale * cutoffFrequenciesHz[start + i]);
+
+        FastMathApproximations::tan (gs, runLength);
+
+        for (size_t i = 0; i < runLength; ++i)
+            hs[i] = static_cast<SampleType> (1) / (static_cast<SampleType> (1) + R2 * gs[i] + gs[i] * gs[i]);
+
+        for (size_t i = 0; i < runLength; ++i)
+        {
+            const auto lg = gs[i];
+
+            auto yHP = hs[i] * (input[start + i] - ls1 * (lg + R2) - ls2);
+
+            auto yBP = yHP * lg + ls1;
+            ls1      = yHP * lg + yBP;
+
+            auto yLP = yBP * lg + ls2;
+            ls2      = yBP * lg + yLP;
+
+            switch (filterType)
+            {
+                case Type::lowpass:   output[start + i] = yLP; break;
+                case Type::bandpass:  output[start + i] = yBP; break;
+                case Type::highpass:  output[start + i] = yHP; break;
+                default:              output[start + i] = yLP; break;
+            }
+        }
+    }
+
+    s1[channel] = ls1;
+    s2[channel] = ls2;
+}
+
 //==============================================================================
 template <typename SampleType>
 void StateVariableTPTFilter<SampleType>::update()
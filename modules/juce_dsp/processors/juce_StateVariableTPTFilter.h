@@ -142,6 +142,55 @@ public:
        #endif
     }
 
+    /** Processes the input and output samples supplied in the processing context,
+        using a different cutoff frequency for every sample.
+
+        This is intended for modulating the cutoff frequency at audio rate, and is much
+        faster than calling setCutoffFrequency() before every sample. The coefficients
+        are calculated for short runs of samples at a time, using the approximation in
+        FastMathApproximations::tan, and the cutoff frequency and coefficients set with
+        setCutoffFrequency() are left unchanged.
+
+        The block of cutoff frequencies must have the same number of samples as the
+        context, and either a single channel that is used for all the channels of the
+        context, or one channel for each channel of the context, so that each channel
+        (for example each voice of a synthesiser) can be modulated independently.
+        Frequencies are limited to the range between 0 and just below the Nyquist
+        frequency.
+    */
+    template <typename ProcessContext>
+    void processWithModulatedCutoff (const ProcessContext& context,
+                                     const AudioBlock<const SampleType>& cutoffFrequenciesHz) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() <= s1.size());
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+        jassert (cutoffFrequenciesHz.getNumChannels() == 1 || cutoffFrequenciesHz.getNumChannels() == numChannels);
+        jassert (cutoffFrequenciesHz.getNumSamples() == numSamples);
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            processWithModulatedCutoff (channel,
+                                        inputBlock.getChannelPointer (channel),
+                                        outputBlock.getChannelPointer (channel),
+                                        cutoffFrequenciesHz.getChannelPointer (cutoffFrequenciesHz.getNumChannels() == 1 ? 0 : channel),
+                                        numSamples);
+
+       #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        snapToZero();
+       #endif
+    }
+
     //==============================================================================
     /** Processes one sample at a time on a given channel. */
     SampleType processSample (int channel, SampleType inputValue);
@@ -149,6 +198,8 @@ public:
 private:
     //==============================================================================
     void update();
+    void processWithModulatedCutoff (size_t channel, const SampleType* input, SampleType* output,
+                                     const SampleType* cutoffFrequenciesHz, size_t numSamples) noexcept;
 
     //==============================================================================
     SampleType g, h, R2;
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct StateVariableTPTFilterTests final : public UnitTest
+{
+    StateVariableTPTFilterTests()
+        : UnitTest ("StateVariableTPTFilter", UnitTestCategories::dsp)
+    {}
+
+    template <typename SampleType>
+    void runModulationTest (StateVariableTPTFilterType type, size_t numCutoffChannels, const String& testName)
+    {
+        beginTest ("Modulated cutoff matches setCutoffFrequency: " + testName);
+
+        auto random = getRandom();
+        constexpr size_t numChannels = 2, numSamples = 1000;
+        constexpr double sampleRate = 44100.0;
+
+        StateVariableTPTFilter<SampleType> reference, modulated;
+
+        for (auto* f : { &reference, &modulated })
+        {
+            f->prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+            f->setType (type);
+            f->setResonance ((SampleType) 2.0);
+        }
+
+        AudioBuffer<SampleType> input ((int) numChannels, (int) numSamples), output ((int) numChannels, (int) numSamples),
+                                cutoffs ((int) numCutoffChannels, (int) numSamples);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t i = 0; i < numSamples; ++i)
+                input.setSample ((int) ch, (int) i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+
+        // Sweeps up to close to the Nyquist frequency, at different rates in each channel
+        for (size_t ch = 0; ch < numCutoffChannels; ++ch)
+            for (size_t i = 0; i < numSamples; ++i)
+                cutoffs.setSample ((int) ch, (int) i, (SampleType) (20.0 + 10000.0 * (1.0 + std::sin ((double) i * 0.01 * (double) (ch + 1)))));
+
+        AudioBlock<const SampleType> inputBlock (input), cutoffBlock (cutoffs);
+        AudioBlock<SampleType> outputBlock (output);
+        modulated.processWithModulatedCutoff (ProcessContextNonReplacing<SampleType> (inputBlock, outputBlock), cutoffBlock);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                reference.setCutoffFrequency (cutoffs.getSample (numCutoffChannels == 1 ? 0 : (int) ch, (int) i));
+                const auto expected = reference.processSample ((int) ch, input.getSample ((int) ch, (int) i));
+                expectWithinAbsoluteError (output.getSample ((int) ch, (int) i), expected, (SampleType) 1.0e-3);
+            }
+        }
+
+        expectEquals ((double) modulated.getCutoffFrequency(), 1000.0);
+    }
+
+    template <typename SampleType>
+    void runModulationTests (const String& typeName)
+    {
+        runModulationTest<SampleType> (StateVariableTPTFilterType::lowpass,  1, typeName + " lowpass, shared cutoff");
+        runModulationTest<SampleType> (StateVariableTPTFilterType::bandpass, 2, typeName + " bandpass, cutoff per channel");
+        runModulationTest<SampleType> (StateVariableTPTFilterType::highpass, 2, typeName + " highpass, cutoff per channel");
+    }
+
+    void runTest() override
+    {
+        runModulationTests<float>  ("float");
+        runModulationTests<double> ("double");
+    }
+};
+
+static StateVariableTPTFilterTests stateVariableTPTFilterTests;
+
+} // namespace juce::dsp
@@ -64,6 +64,21 @@ void Compressor<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void Compressor<SampleType>::setLookahead (SampleType newLookaheadMs)
+{
+    jassert (isPositiveAndNotGreaterThan (newLookaheadMs, maximumLookaheadMs));
+
+    lookaheadTime = jlimit ((SampleType) 0, maximumLookaheadMs, newLookaheadMs);
+    update();
+}
+
+template <typename SampleType>
+void Compressor<SampleType>::setChannelLinking (bool shouldLinkChannels) noexcept
+{
+    channelsLinked = shouldLinkChannels;
+}
+
 //==============================================================================
 template <typename SampleType>
 void Compressor<SampleType>::prepare (const ProcessSpec& spec)
@@ -72,9 +87,23 @@ void Compressor<SampleType>::prepare (const ProcessSpec& spec)
     jassert (spec.numChannels > 0);
 
     sampleRate = spec.sampleRate;
+    maximumBlockSize = (int) spec.maximumBlockSize;
 
     envelopeFilter.prepare (spec);
 
+    // The whole block is pushed into the delay line before any of it is read back
+    const auto maximumLookaheadSamples = (int) std::ceil (maximumLookaheadMs * sampleRate / 1000.0);
+
+    lookaheadDelay.setMaximumDelayInSamples (maximumLookaheadSamples + maximumBlockSize);
+    lookaheadDelay.prepare (spec);
+
+    detectorWindows.resize (spec.numChannels);
+
+    for (auto& window : detectorWindows)
+        window.prepare (maximumLookaheadSamples + 1);
+
+    gainBuffer.setSize ((int) spec.numChannels, maximumBlockSize);
+
     update();
     reset();
 }
@@ -83,6 +112,10 @@ template <typename SampleType>
 void Compressor<SampleType>::reset()
 {
     envelopeFilter.reset();
+    lookaheadDelay.reset();
+
+    for (auto& window : detectorWindows)
+        window.reset();
 }
 
 //==============================================================================
@@ -93,13 +126,114 @@ SampleType Compressor<SampleType>::processSample (int channel, SampleType inputV
     auto env = envelopeFilter.processSample (channel, inputValue);
 
     // VCA
-    auto gain = (env < threshold) ? static_cast<SampleType> (1.0)
-                                  : std::pow (env * thresholdInverse, ratioInverse - static_cast<SampleType> (1.0));
+    auto gain = getGain (env);
 
     // Output
     return gain * inputValue;
 }
 
+template <typename SampleType>
+SampleType Compressor<SampleType>::getGain (SampleType envelope) const noexcept
+{
+    return (envelope < threshold) ? static_cast<SampleType> (1.0)
+                                  : std::pow (envelope * thresholdInverse, ratioInverse - static_cast<SampleType> (1.0));
+}
+
+template <typename SampleType>
+void Compressor<SampleType>::processBlock (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output) noexcept
+{
+    const auto numChannels = output.getNumChannels();
+    const auto numSamples  = (int) output.getNumSamples();
+    const auto numDetectors = channelsLinked ? (size_t) 1 : numChannels;
+
+    // The detector input is rectified in the gain buffer, which is then replaced by the gains
+    for (size_t detector = 0; detector < numDetectors; ++detector)
+    {
+        auto* gains = gainBuffer.getWritePointer ((int) detector);
+
+        FloatVectorOperations::abs (gains, input.getChannelPointer (detector), numSamples);
+
+        if (channelsLinked)
+        {
+            auto* scratch = gainBuffer.getWritePointer (gainBuffer.getNumChannels() - 1);
+
+            for (size_t channel = 1; channel < numChannels; ++channel)
+            {
+                FloatVectorOperations::abs (scratch, input.getChannelPointer (channel), numSamples);
+                FloatVectorOperations::max (gains, gains, scratch, numSamples);
+            }
+        }
+
+        if (lookaheadSamples > 0)
+        {
+            auto& window = detectorWindows[detector];
+
+            for (int i = 0; i < numSamples; ++i)
+                gains[i] = window.processSample (gains[i], lookaheadSamples + 1);
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            gains[i] = getGain (envelopeFilter.processSample ((int) detector, gains[i]));
+    }
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        const auto* source = input.getChannelPointer (channel);
+        auto* dest = output.getChannelPointer (channel);
+
+        if (lookaheadSamples > 0)
+        {
+            lookaheadDelay.pushBlock ((int) channel, source, numSamples);
+            lookaheadDelay.popBlock ((int) channel, nullptr, dest, numSamples);
+            source = dest;
+        }
+
+        FloatVectorOperations::multiply (dest, source, gainBuffer.getReadPointer (channelsLinked ? 0 : (int) channel), numSamples);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void Compressor<SampleType>::SlidingWindowMaximum::prepare (int maximumWindowSize)
+{
+    values.resize ((size_t) maximumWindowSize);
+    times.resize ((size_t) maximumWindowSize);
+    reset();
+}
+
+template <typename SampleType>
+void Compressor<SampleType>::SlidingWindowMaximum::reset() noexcept
+{
+    time = 0;
+    front = 0;
+    size = 0;
+}
+
+template <typename SampleType>
+SampleType Compressor<SampleType>::SlidingWindowMaximum::processSample (SampleType value, int windowSize) noexcept
+{
+    jassert (isPositiveAndNotGreaterThan (windowSize, (int) values.size()));
+
+    const auto capacity = values.size();
+    const auto indexOf = [&] (size_t position) { return (front + position) % capacity; };
+
+    // Anything older than the window, or smaller than the new value, can never be the maximum again
+    while (size > 0 && times[front] <= time - windowSize)
+    {
+        front = indexOf (1);
+        --size;
+    }
+
+    while (size > 0 && values[indexOf (size - 1)] <= value)
+        --size;
+
+    values[indexOf (size)] = value;
+    times[indexOf (size)] = time++;
+    ++size;
+
+    return values[front];
+}
+
 template <typename SampleType>
 void Compressor<SampleType>::update()
 {
@@ -109,6 +243,9 @@ void Compressor<SampleType>::update()
 
     envelopeFilter.setAttackTime (attackTime);
     envelopeFilter.setReleaseTime (releaseTime);
+
+    lookaheadSamples = roundToInt (lookaheadTime * sampleRate / 1000.0);
+    lookaheadDelay.setDelay ((SampleType) jmin (lookaheadSamples, lookaheadDelay.getMaximumDelayInSamples()));
 }
 
 //==============================================================================
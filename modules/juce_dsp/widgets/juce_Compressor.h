@@ -30,6 +30,11 @@ namespace juce::dsp
     A simple compressor with standard threshold, ratio, attack time and release time
     controls.
 
+    The compressor can optionally look ahead, in which case the audio is delayed
+    and the detector reacts to the loudest peak inside the lookahead window, and it
+    can link its channels, in which case every channel is compressed by the same
+    gain, based on the loudest channel.
+
     @tags{DSP}
 */
 template <typename SampleType>
@@ -53,6 +58,26 @@ public:
     /** Sets the release time in milliseconds of the compressor.*/
     void setRelease (SampleType newRelease);
 
+    /** The longest lookahead time in milliseconds that can be used. */
+    static constexpr SampleType maximumLookaheadMs = 20;
+
+    /** Sets the lookahead time in milliseconds, between 0 and maximumLookaheadMs.
+
+        The audio is delayed by the lookahead time, so you should report the value
+        of getLatencyInSamples() to the host. Changing the lookahead while audio is
+        playing will cause a discontinuity.
+    */
+    void setLookahead (SampleType newLookaheadMs);
+
+    /** Returns the delay introduced by the lookahead, in samples. */
+    int getLatencyInSamples() const noexcept        { return lookaheadSamples; }
+
+    /** If this is true, the envelope is calculated from the loudest channel and the
+        same gain is applied to all of the channels. By default, each channel is
+        compressed separately.
+    */
+    void setChannelLinking (bool shouldLinkChannels) noexcept;
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
@@ -67,7 +92,7 @@ public:
     {
         const auto& inputBlock = context.getInputBlock();
         auto& outputBlock      = context.getOutputBlock();
-        const auto numChannels = outputBlock.getNumChannels();
+        [[maybe_unused]] const auto numChannels = outputBlock.getNumChannels();
         const auto numSamples  = outputBlock.getNumSamples();
 
         jassert (inputBlock.getNumChannels() == numChannels);
@@ -79,29 +104,58 @@ public:
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
+        jassert (numChannels <= (size_t) gainBuffer.getNumChannels());
+
+        for (size_t start = 0; start < numSamples; start += (size_t) maximumBlockSize)
         {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
+            const auto numThisTime = jmin ((size_t) maximumBlockSize, numSamples - start);
 
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
+            auto output = outputBlock.getSubBlock (start, numThisTime);
+            processBlock (inputBlock.getSubBlock (start, numThisTime), output);
         }
+
+       #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        envelopeFilter.snapToZero();
+       #endif
     }
 
-    /** Performs the processing operation on a single sample at a time. */
+    /** Performs the processing operation on a single sample at a time.
+
+        This doesn't apply any lookahead or channel linking.
+    */
     SampleType processSample (int channel, SampleType inputValue);
 
 private:
+    //==============================================================================
+    /** A running maximum over the last few samples, using a monotonic queue. */
+    struct SlidingWindowMaximum
+    {
+        void prepare (int maximumWindowSize);
+        void reset() noexcept;
+        SampleType processSample (SampleType value, int windowSize) noexcept;
+
+        std::vector<SampleType> values;
+        std::vector<int64> times;
+        int64 time = 0;
+        size_t front = 0, size = 0;
+    };
+
     //==============================================================================
     void update();
+    void processBlock (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output) noexcept;
+    SampleType getGain (SampleType envelope) const noexcept;
 
     //==============================================================================
     SampleType threshold, thresholdInverse, ratioInverse;
     BallisticsFilter<SampleType> envelopeFilter;
+    DelayLine<SampleType, DelayLineInterpolationTypes::None> lookaheadDelay;
+    std::vector<SlidingWindowMaximum> detectorWindows;
+    AudioBuffer<SampleType> gainBuffer;
 
     double sampleRate = 44100.0;
-    SampleType thresholddB = 0.0, ratio = 1.0, attackTime = 1.0, releaseTime = 100.0;
+    SampleType thresholddB = 0.0, ratio = 1.0, attackTime = 1.0, releaseTime = 100.0, lookaheadTime = 0.0;
+    int lookaheadSamples = 0, maximumBlockSize = 0;
+    bool channelsLinked = false;
 };
 
 } // namespace juce::dsp
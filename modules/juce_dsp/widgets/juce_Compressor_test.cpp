@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct CompressorTests final : public UnitTest
+{
+    CompressorTests()
+        : UnitTest ("Compressor", UnitTestCategories::dsp)
+    {}
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+
+    static void prepareCompressor (Compressor<float>& compressor, int numChannels)
+    {
+        compressor.setThreshold (-6.0f);
+        compressor.setRatio (1000.0f);
+        compressor.setAttack (1.0f);
+        compressor.setRelease (100.0f);
+        compressor.prepare ({ sampleRate, (uint32) blockSize, (uint32) numChannels });
+    }
+
+    static float getFirstPeakOfStep (Compressor<float>& compressor)
+    {
+        // Silence followed by a full-scale step, starting half way through a block
+        AudioBuffer<float> buffer (1, blockSize * 2);
+        buffer.clear();
+
+        for (int i = blockSize / 2; i < blockSize * 2; ++i)
+            buffer.setSample (0, i, 1.0f);
+
+        AudioBlock<float> block (buffer);
+
+        for (size_t start = 0; start < block.getNumSamples(); start += blockSize)
+        {
+            auto subBlock = block.getSubBlock (start, blockSize);
+            compressor.process (ProcessContextReplacing<float> (subBlock));
+        }
+
+        return buffer.getSample (0, blockSize / 2 + compressor.getLatencyInSamples());
+    }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Block processing matches sample processing");
+        {
+            Compressor<float> blockCompressor, sampleCompressor;
+
+            for (auto* c : { &blockCompressor, &sampleCompressor })
+            {
+                prepareCompressor (*c, 2);
+                c->setRatio (4.0f);
+            }
+
+            AudioBuffer<float> input (2, blockSize), output (2, blockSize);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    input.setSample (ch, i, (float) (random.nextDouble() * 2.0 - 1.0));
+
+            AudioBlock<const float> inBlock (input);
+            AudioBlock<float> outBlock (output);
+            blockCompressor.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    expectWithinAbsoluteError (output.getSample (ch, i), sampleCompressor.processSample (ch, input.getSample (ch, i)), 1.0e-6f);
+        }
+
+        beginTest ("Lookahead delays the signal and reduces the gain before a peak");
+        {
+            Compressor<float> withoutLookahead, withLookahead;
+            prepareCompressor (withoutLookahead, 1);
+            prepareCompressor (withLookahead, 1);
+
+            withLookahead.setLookahead (5.0f);
+            expectEquals (withoutLookahead.getLatencyInSamples(), 0);
+            expectEquals (withLookahead.getLatencyInSamples(), 240);
+
+            expectGreaterThan (getFirstPeakOfStep (withoutLookahead), 0.9f);
+            expectLessThan (getFirstPeakOfStep (withLookahead), 0.6f);
+        }
+
+        beginTest ("Linked channels are compressed by the same gain");
+        {
+            Compressor<float> compressor;
+            prepareCompressor (compressor, 2);
+            compressor.setRatio (4.0f);
+            compressor.setChannelLinking (true);
+
+            AudioBuffer<float> buffer (2, blockSize), input (2, blockSize);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                input.setSample (0, i, (float) (random.nextDouble() * 2.0 - 1.0));
+                input.setSample (1, i, 0.01f);
+            }
+
+            buffer.makeCopyOf (input);
+            AudioBlock<float> block (buffer);
+            compressor.process (ProcessContextReplacing<float> (block));
+
+            expectLessThan (buffer.getSample (1, blockSize - 1), 0.01f);
+
+            for (int i = 0; i < blockSize; ++i)
+                if (std::abs (input.getSample (0, i)) > 1.0e-3f)
+                    expectWithinAbsoluteError (buffer.getSample (0, i) / input.getSample (0, i),
+                                               buffer.getSample (1, i) / input.getSample (1, i),
+                                               1.0e-4f);
+        }
+    }
+};
+
+static CompressorTests compressorTests;
+
+} // namespace juce::dsp
@@ -112,28 +112,25 @@ public:
             return;
         }
 
-        if (numChannels == 1)
+        if (! gain.isSmoothing())
         {
-            auto* src = inBlock.getChannelPointer (0);
-            auto* dst = outBlock.getChannelPointer (0);
-
-            for (size_t i = 0; i < len; ++i)
-                dst[i] = src[i] * gain.getNextValue();
-        }
-        else
-        {
-            JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6255 6386)
-            auto* gains = static_cast<FloatType*> (alloca (sizeof (FloatType) * len));
-
-            for (size_t i = 0; i < len; ++i)
-                gains[i] = gain.getNextValue();
-            JUCE_END_IGNORE_WARNINGS_MSVC
-
             for (size_t chan = 0; chan < numChannels; ++chan)
                 FloatVectorOperations::multiply (outBlock.getChannelPointer (chan),
                                                  inBlock.getChannelPointer (chan),
-                                                 gains, static_cast<int> (len));
+                                                 gain.getTargetValue(), static_cast<int> (len));
+
+            return;
         }
+
+        JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6255 6386)
+        auto* gains = static_cast<FloatType*> (alloca (sizeof (FloatType) * len));
+        gain.fillRamp (gains, static_cast<int> (len));
+        JUCE_END_IGNORE_WARNINGS_MSVC
+
+        for (size_t chan = 0; chan < numChannels; ++chan)
+            FloatVectorOperations::multiply (outBlock.getChannelPointer (chan),
+                                             inBlock.getChannelPointer (chan),
+                                             gains, static_cast<int> (len));
     }
 
 private:
@@ -119,16 +119,22 @@ void LadderFilter<SampleType>::setDrive (SampleType newDrive) noexcept
 //==============================================================================
 template <typename SampleType>
 SampleType LadderFilter<SampleType>::processSample (SampleType inputValue, size_t channelToUse) noexcept
+{
+    return processSample (inputValue, channelToUse, cutoffTransformValue, scaledResonanceValue);
+}
+
+template <typename SampleType>
+SampleType LadderFilter<SampleType>::processSample (SampleType inputValue, size_t channelToUse,
+                                                    SampleType a1, SampleType scaledResonance) noexcept
 {
     auto& s = state[channelToUse];
 
-    const auto a1 = cutoffTransformValue;
     const auto g = a1 * SampleType (-1) + SampleType (1);
     const auto b0 = g * SampleType (0.76923076923);
     const auto b1 = g * SampleType (0.23076923076);
 
     const auto dx = gain * saturationLUT (drive * inputValue);
-    const auto a  = dx + scaledResonanceValue * SampleType (-4) * (gain2 * saturationLUT (drive2 * s[4]) - dx * comp);
+    const auto a  = dx + scaledResonance * SampleType (-4) * (gain2 * saturationLUT (drive2 * s[4]) - dx * comp);
 
     const auto b = b1 * s[0] + a1 * s[1] + b0 * a;
     const auto c = b1 * s[1] + a1 * s[2] + b0 * b;
@@ -144,6 +150,31 @@ SampleType LadderFilter<SampleType>::processSample (SampleType inputValue, size_
     return a * A[0] + b * A[1] + c * A[2] + d * A[3] + e * A[4];
 }
 
+//==============================================================================
+template <typename SampleType>
+void LadderFilter<SampleType>::processWithModulatedCutoff (size_t channelToUse,
+                                                           const SampleType* input,
+                                                           SampleType* output,
+                                                           const SampleType* cutoffFrequenciesHz,
+                                                           const SampleType* scaledResonances,
+                                                           size_t numSamples) noexcept
+{
+    jassert (numSamples <= maxModulationRunLength);
+
+    SampleType a1s[maxModulationRunLength];
+
+    // cutoffFreqScaler is -2 pi / sampleRate, so this limits the frequency to the Nyquist frequency
+    const auto minExponent = SampleType (-MathConstants<double>::pi);
+
+    for (size_t i = 0; i < numSamples; ++i)
+        a1s[i] = jlimit (minExponent, SampleType(), cutoffFreqScaler * cutoffFrequenciesHz[i]);
+
+    FastMathApproximations::exp (a1s, numSamples);
+
+    for (size_t i = 0; i < numSamples; ++i)
+        output[i] = processSample (input[i], channelToUse, a1s[i], scaledResonances[i]);
+}
+
 //==============================================================================
 template <typename SampleType>
 void LadderFilter<SampleType>::updateSmoothers() noexcept
@@ -113,6 +113,63 @@ public:
         }
     }
 
+    /** Processes the input and output samples supplied in the processing context,
+        using a different cutoff frequency for every sample.
+
+        This is intended for modulating the cutoff frequency at audio rate. The cutoff
+        frequency set with setCutoffFrequencyHz() is ignored while processing, and the
+        coefficients are instead calculated from the supplied frequencies for short runs
+        of samples at a time, using the approximation in FastMathApproximations::exp.
+
+        The block of cutoff frequencies must have the same number of samples as the
+        context, and either a single channel that is used for all the channels of the
+        context, or one channel for each channel of the context, so that each channel
+        (for example each voice of a synthesiser) can be modulated independently.
+        Frequencies are limited to the range between 0 and the Nyquist frequency.
+    */
+    template <typename ProcessContext>
+    void processWithModulatedCutoff (const ProcessContext& context,
+                                     const AudioBlock<const SampleType>& cutoffFrequenciesHz) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() <= getNumChannels());
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+        jassert (cutoffFrequenciesHz.getNumChannels() == 1 || cutoffFrequenciesHz.getNumChannels() == numChannels);
+        jassert (cutoffFrequenciesHz.getNumSamples() == numSamples);
+
+        if (! enabled || context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        SampleType resonances[maxModulationRunLength];
+
+        for (size_t start = 0; start < numSamples; start += maxModulationRunLength)
+        {
+            const auto runLength = jmin (maxModulationRunLength, numSamples - start);
+
+            for (size_t i = 0; i < runLength; ++i)
+            {
+                updateSmoothers();
+                resonances[i] = scaledResonanceValue;
+            }
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                processWithModulatedCutoff (ch,
+                                            inputBlock.getChannelPointer (ch) + start,
+                                            outputBlock.getChannelPointer (ch) + start,
+                                            cutoffFrequenciesHz.getChannelPointer (cutoffFrequenciesHz.getNumChannels() == 1 ? 0 : ch) + start,
+                                            resonances,
+                                            runLength);
+        }
+    }
+
 protected:
     //==============================================================================
     SampleType processSample (SampleType inputValue, size_t channelToUse) noexcept;
@@ -120,6 +177,13 @@ protected:
 
 private:
     //==============================================================================
+    static constexpr size_t maxModulationRunLength = 32;
+
+    SampleType processSample (SampleType inputValue, size_t channelToUse,
+                              SampleType a1, SampleType scaledResonance) noexcept;
+    void processWithModulatedCutoff (size_t channelToUse, const SampleType* input, SampleType* output,
+                                     const SampleType* cutoffFrequenciesHz, const SampleType* scaledResonances,
+                                     size_t numSamples) noexcept;
     void setSampleRate (SampleType newValue) noexcept;
     void setNumChannels (size_t newValue)   { state.resize (newValue); }
     void updateCutoffFreq() noexcept        { cutoffTransformSmoother.setTargetValue (std::exp (cutoffFreqHz * cutoffFreqScaler)); }
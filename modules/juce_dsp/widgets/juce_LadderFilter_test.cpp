@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct LadderFilterTests final : public UnitTest
+{
+    LadderFilterTests()
+        : UnitTest ("LadderFilter", UnitTestCategories::dsp)
+    {}
+
+    template <typename SampleType>
+    void runModulationTest (LadderFilterMode mode, const String& testName)
+    {
+        beginTest ("Modulated cutoff matches fixed cutoff: " + testName);
+
+        auto random = getRandom();
+        constexpr size_t numChannels = 2, numSamples = 1000;
+        constexpr double sampleRate = 44100.0;
+        const SampleType cutoffsHz[] { (SampleType) 500, (SampleType) 5000 };
+
+        // Each reference filter uses the cutoff of one channel of the modulated filter
+        LadderFilter<SampleType> references[numChannels], modulated;
+
+        for (size_t ch = 0; ch < numChannels + 1; ++ch)
+        {
+            auto& f = ch < numChannels ? references[ch] : modulated;
+            f.setMode (mode);
+            f.setResonance ((SampleType) 0.7);
+            f.setDrive ((SampleType) 2);
+            f.setCutoffFrequencyHz (ch < numChannels ? cutoffsHz[ch] : (SampleType) 100);
+            f.prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+        }
+
+        AudioBuffer<SampleType> input ((int) numChannels, (int) numSamples), expected ((int) numChannels, (int) numSamples),
+                                output ((int) numChannels, (int) numSamples), cutoffs ((int) numChannels, (int) numSamples);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+                input.setSample ((int) ch, (int) i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+
+            cutoffs.clear ((int) ch, 0, (int) numSamples);
+            FloatVectorOperations::add (cutoffs.getWritePointer ((int) ch), cutoffsHz[ch], (int) numSamples);
+
+            auto expectedBlock = AudioBlock<SampleType> (expected).getSingleChannelBlock (ch);
+            auto inputBlock    = AudioBlock<const SampleType> (input).getSingleChannelBlock (ch);
+            references[ch].process (ProcessContextNonReplacing<SampleType> (inputBlock, expectedBlock));
+        }
+
+        AudioBlock<const SampleType> inputBlock (input), cutoffBlock (cutoffs);
+        AudioBlock<SampleType> outputBlock (output);
+        modulated.processWithModulatedCutoff (ProcessContextNonReplacing<SampleType> (inputBlock, outputBlock), cutoffBlock);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            for (size_t i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (output.getSample ((int) ch, (int) i), expected.getSample ((int) ch, (int) i), (SampleType) 1.0e-3);
+    }
+
+    void runTest() override
+    {
+        runModulationTest<float>  (LadderFilterMode::LPF24, "float LPF24");
+        runModulationTest<float>  (LadderFilterMode::HPF12, "float HPF12");
+        runModulationTest<double> (LadderFilterMode::BPF24, "double BPF24");
+    }
+};
+
+static LadderFilterTests ladderFilterTests;
+
+} // namespace juce::dsp
@@ -30,6 +30,10 @@ namespace juce::dsp
     A simple limiter with standard threshold and release time controls, featuring
     two compressors and a hard clipper at 0 dB.
 
+    If a lookahead time is set, the second compressor reacts to the loudest peak
+    in the lookahead window before it reaches the output, so less of the signal
+    has to be clipped.
+
     @tags{DSP}
 */
 template <typename SampleType>
@@ -47,6 +51,21 @@ public:
     /** Sets the release time in milliseconds of the limiter.*/
     void setRelease (SampleType newRelease);
 
+    /** Sets the lookahead time in milliseconds of the limiter.
+
+        @see Compressor::setLookahead
+    */
+    void setLookahead (SampleType newLookaheadMs);
+
+    /** Returns the delay introduced by the lookahead, in samples. */
+    int getLatencyInSamples() const noexcept        { return secondStageCompressor.getLatencyInSamples(); }
+
+    /** If this is true, the same gain is applied to all of the channels.
+
+        @see Compressor::setChannelLinking
+    */
+    void setChannelLinking (bool shouldLinkChannels) noexcept;
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
@@ -0,0 +1,612 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+VoiceLaneAllocator::VoiceLaneAllocator (size_t numVoices, size_t numLanesToUse)
+    : voicesInUse (numVoices),
+      numVoicesInGroup ((numVoices + numLanesToUse - 1) / numLanesToUse),
+      numLanes (numLanesToUse)
+{
+    jassert (numLanes > 0);
+}
+
+int VoiceLaneAllocator::allocateVoice() noexcept
+{
+    // Fill the busiest group that still has a free voice, so that the voices in use
+    // stay packed into as few groups as possible
+    auto bestGroup = numVoicesInGroup.size();
+
+    for (size_t group = 0; group < numVoicesInGroup.size(); ++group)
+    {
+        const auto groupSize = jmin (numLanes, voicesInUse.size() - group * numLanes);
+
+        if (numVoicesInGroup[group] < groupSize
+            && (bestGroup == numVoicesInGroup.size() || numVoicesInGroup[group] > numVoicesInGroup[bestGroup]))
+        {
+            bestGroup = group;
+        }
+    }
+
+    if (bestGroup == numVoicesInGroup.size())
+        return -1;
+
+    for (auto voice = bestGroup * numLanes;; ++voice)
+    {
+        if (! voicesInUse[voice])
+        {
+            voicesInUse[voice] = true;
+            ++numVoicesInGroup[bestGroup];
+            return (int) voice;
+        }
+    }
+}
+
+void VoiceLaneAllocator::releaseVoice (int voice) noexcept
+{
+    if (! isVoiceInUse (voice))
+        return;
+
+    voicesInUse[(size_t) voice] = false;
+    --numVoicesInGroup[(size_t) voice / numLanes];
+}
+
+void VoiceLaneAllocator::releaseAllVoices() noexcept
+{
+    std::fill (voicesInUse.begin(), voicesInUse.end(), false);
+    std::fill (numVoicesInGroup.begin(), numVoicesInGroup.end(), 0);
+}
+
+bool VoiceLaneAllocator::isVoiceInUse (int voice) const noexcept
+{
+    return isPositiveAndBelow (voice, voicesInUse.size()) && voicesInUse[(size_t) voice];
+}
+
+size_t VoiceLaneAllocator::getNumVoicesInUseInGroup (size_t group) const noexcept
+{
+    return group < numVoicesInGroup.size() ? numVoicesInGroup[group] : 0;
+}
+
+//==============================================================================
+template <typename SampleType>
+void VoiceLaneOscillator<SampleType>::setFrequency (size_t voice, SampleType newFrequencyHz) noexcept
+{
+    jassert (voice < frequencies.size());
+    jassert (newFrequencyHz >= SampleType (0));
+
+    frequencies[voice] = newFrequencyHz;
+    increments[voice / VoiceLanes<SampleType>::numLanes].set (voice % VoiceLanes<SampleType>::numLanes,
+                                                             static_cast<SampleType> (newFrequencyHz / sampleRate));
+}
+
+template <typename SampleType>
+SampleType VoiceLaneOscillator<SampleType>::getFrequency (size_t voice) const noexcept
+{
+    return frequencies[voice];
+}
+
+template <typename SampleType>
+void VoiceLaneOscillator<SampleType>::resetPhase (size_t voice, SampleType newPhase) noexcept
+{
+    jassert (isPositiveAndBelow (newPhase, SampleType (1)) || exactlyEqual (newPhase, SampleType (0)));
+    phases[voice / VoiceLanes<SampleType>::numLanes].set (voice % VoiceLanes<SampleType>::numLanes, newPhase);
+}
+
+template <typename SampleType>
+void VoiceLaneOscillator<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+
+    sampleRate = spec.sampleRate;
+    phases    .assign (spec.numChannels, LaneType::expand ({}));
+    increments.assign (spec.numChannels, LaneType::expand ({}));
+    frequencies.resize (spec.numChannels * VoiceLanes<SampleType>::numLanes);
+
+    for (size_t voice = 0; voice < frequencies.size(); ++voice)
+        setFrequency (voice, frequencies[voice]);
+}
+
+template <typename SampleType>
+void VoiceLaneOscillator<SampleType>::reset() noexcept
+{
+    std::fill (phases.begin(), phases.end(), LaneType::expand ({}));
+}
+
+template <typename SampleType>
+void VoiceLaneOscillator<SampleType>::processGroup (size_t group, const LaneType* input, LaneType* output, size_t numSamples) noexcept
+{
+    using Lanes = VoiceLanes<SampleType>;
+
+    const auto zero = LaneType::expand (SampleType (0));
+    const auto one  = LaneType::expand (SampleType (1));
+    const auto half = LaneType::expand (SampleType (0.5));
+
+    const auto generate = [&] (LaneType phase) noexcept
+    {
+        switch (waveform)
+        {
+            case Waveform::saw:       return phase * SampleType (2) - SampleType (1);
+            case Waveform::square:    return Lanes::select (LaneType::lessThan (phase, half), one, zero - one);
+            case Waveform::triangle:  return LaneType::abs (phase - half) * SampleType (4) - SampleType (1);
+            case Waveform::sine:
+            default:
+            {
+                // sin (2 pi phase) == -sin (2 pi t), and sin (2 pi |t|) is symmetrical about |t| == 0.25,
+                // so the polynomial only has to cover the first quarter of a cycle
+                const auto t = phase - half;
+                const auto absT = LaneType::abs (t);
+                const auto x = LaneType::min (absT, half - absT) * MathConstants<SampleType>::twoPi;
+                const auto x2 = x * x;
+
+                auto s = LaneType::expand (SampleType (-1.0 / 39916800.0));
+                s = s * x2 + SampleType (1.0 / 362880.0);
+                s = s * x2 + SampleType (-1.0 / 5040.0);
+                s = s * x2 + SampleType (1.0 / 120.0);
+                s = s * x2 + SampleType (-1.0 / 6.0);
+                s = (s * x2 + SampleType (1)) * x;
+
+                return Lanes::select (LaneType::lessThan (t, zero), s, zero - s);
+            }
+        }
+    };
+
+    auto phase = phases[group];
+    const auto increment = increments[group];
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        output[i] = input[i] + generate (phase);
+        phase += increment;
+        phase -= LaneType::truncate (phase);
+    }
+
+    phases[group] = phase;
+}
+
+template <typename SampleType>
+void VoiceLaneOscillator<SampleType>::advancePhase (size_t group, size_t numSamples) noexcept
+{
+    auto phase = phases[group] + increments[group] * static_cast<SampleType> (numSamples);
+    phases[group] = phase - LaneType::truncate (phase);
+}
+
+//==============================================================================
+template <typename SampleType>
+void VoiceLaneStateVariableTPTFilter<SampleType>::setCutoffFrequency (size_t voice, SampleType newFrequencyHz)
+{
+    jassert (isPositiveAndBelow (newFrequencyHz, static_cast<SampleType> (sampleRate * 0.5)));
+
+    cutoffFrequencies[voice] = newFrequencyHz;
+    update (voice);
+}
+
+template <typename SampleType>
+void VoiceLaneStateVariableTPTFilter<SampleType>::setResonance (size_t voice, SampleType newResonance)
+{
+    jassert (newResonance > static_cast<SampleType> (0));
+
+    resonances[voice] = newResonance;
+    update (voice);
+}
+
+template <typename SampleType>
+SampleType VoiceLaneStateVariableTPTFilter<SampleType>::getCutoffFrequency (size_t voice) const noexcept
+{
+    return cutoffFrequencies[voice];
+}
+
+template <typename SampleType>
+SampleType VoiceLaneStateVariableTPTFilter<SampleType>::getResonance (size_t voice) const noexcept
+{
+    return resonances[voice];
+}
+
+//==============================================================================
+template <typename SampleType>
+void VoiceLaneStateVariableTPTFilter<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+
+    for (auto* v : { &g, &h, &R2, &s1, &s2 })
+        v->assign (spec.numChannels, LaneType::expand ({}));
+
+    const auto numVoices = spec.numChannels * VoiceLanes<SampleType>::numLanes;
+    cutoffFrequencies.resize (numVoices, static_cast<SampleType> (1000.0));
+    resonances       .resize (numVoices, static_cast<SampleType> (1.0 / std::sqrt (2.0)));
+
+    for (size_t voice = 0; voice < numVoices; ++voice)
+        update (voice);
+}
+
+template <typename SampleType>
+void VoiceLaneStateVariableTPTFilter<SampleType>::reset() noexcept
+{
+    for (auto* v : { &s1, &s2 })
+        std::fill (v->begin(), v->end(), LaneType::expand ({}));
+}
+
+template <typename SampleType>
+void VoiceLaneStateVariableTPTFilter<SampleType>::resetVoice (size_t voice) noexcept
+{
+    for (auto* v : { &s1, &s2 })
+        (*v)[voice / VoiceLanes<SampleType>::numLanes].set (voice % VoiceLanes<SampleType>::numLanes, {});
+}
+
+//==============================================================================
+template <typename SampleType>
+void VoiceLaneStateVariableTPTFilter<SampleType>::processGroup (size_t group, const LaneType* input, LaneType* output, size_t numSamples) noexcept
+{
+    const auto lg  = g[group];
+    const auto lh  = h[group];
+    const auto gR2 = lg + R2[group];
+    auto ls1 = s1[group];
+    auto ls2 = s2[group];
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto yHP = lh * (input[i] - ls1 * gR2 - ls2);
+
+        auto yBP = yHP * lg + ls1;
+        ls1      = yHP * lg + yBP;
+
+        auto yLP = yBP * lg + ls2;
+        ls2      = yBP * lg + yLP;
+
+        switch (filterType)
+        {
+            case Type::lowpass:   output[i] = yLP; break;
+            case Type::bandpass:  output[i] = yBP; break;
+            case Type::highpass:  output[i] = yHP; break;
+            default:              output[i] = yLP; break;
+        }
+    }
+
+    s1[group] = ls1;
+    s2[group] = ls2;
+}
+
+template <typename SampleType>
+void VoiceLaneStateVariableTPTFilter<SampleType>::update (size_t voice)
+{
+    const auto group = voice / VoiceLanes<SampleType>::numLanes;
+    const auto lane  = voice % VoiceLanes<SampleType>::numLanes;
+
+    const auto lg  = static_cast<SampleType> (std::tan (juce::MathConstants<double>::pi * cutoffFrequencies[voice] / sampleRate));
+    const auto lR2 = static_cast<SampleType> (1.0 / resonances[voice]);
+
+    g [group].set (lane, lg);
+    R2[group].set (lane, lR2);
+    h [group].set (lane, static_cast<SampleType> (1.0 / (1.0 + lR2 * lg + lg * lg)));
+}
+
+//==============================================================================
+template <typename SampleType>
+VoiceLaneLadderFilter<SampleType>::VoiceLaneLadderFilter()
+{
+    setNumGroups (1);
+    cutoffFreqScaler = SampleType (-2.0 * juce::MathConstants<double>::pi) / SampleType (1000);  // intentionally setting unrealistic default
+                                                                                                   // sample rate to catch missing initialisation bugs
+    setDrive (SampleType (1.2));
+
+    mode = Mode::LPF24;
+    setMode (Mode::LPF12);
+}
+
+template <typename SampleType>
+void VoiceLaneLadderFilter<SampleType>::setMode (Mode newMode) noexcept
+{
+    if (newMode == mode)
+        return;
+
+    switch (newMode)
+    {
+        case Mode::LPF12:   A = {{ SampleType (0), SampleType (0),  SampleType (1), SampleType (0),  SampleType (0) }}; comp = SampleType (0.5);  break;
+        case Mode::HPF12:   A = {{ SampleType (1), SampleType (-2), SampleType (1), SampleType (0),  SampleType (0) }}; comp = SampleType (0);    break;
+        case Mode::BPF12:   A = {{ SampleType (0), SampleType (0), SampleType (-1), SampleType (1),  SampleType (0) }}; comp = SampleType (0.5);  break;
+        case Mode::LPF24:   A = {{ SampleType (0), SampleType (0),  SampleType (0), SampleType (0),  SampleType (1) }}; comp = SampleType (0.5);  break;
+        case Mode::HPF24:   A = {{ SampleType (1), SampleType (-4), SampleType (6), SampleType (-4), SampleType (1) }}; comp = SampleType (0);    break;
+        case Mode::BPF24:   A = {{ SampleType (0), SampleType (0),  SampleType (1), SampleType (-2), SampleType (1) }}; comp = SampleType (0.5);  break;
+        default:            jassertfalse;                                                                                                         break;
+    }
+
+    static constexpr auto outputGain = SampleType (1.2);
+
+    for (auto& a : A)
+        a *= outputGain;
+
+    mode = newMode;
+    reset();
+}
+
+template <typename SampleType>
+void VoiceLaneLadderFilter<SampleType>::setDrive (SampleType newDrive) noexcept
+{
+    jassert (newDrive >= SampleType (1));
+
+    drive = newDrive;
+    gain = std::pow (drive, SampleType (-2.642))   * SampleType (0.6103) + SampleType (0.3903);
+    drive2 = drive                                 * SampleType (0.04)   + SampleType (0.96);
+    gain2 = std::pow (drive2, SampleType (-2.642)) * SampleType (0.6103) + SampleType (0.3903);
+}
+
+template <typename SampleType>
+void VoiceLaneLadderFilter<SampleType>::setCutoffFrequencyHz (size_t voice, SampleType newCutoff) noexcept
+{
+    jassert (newCutoff > SampleType (0));
+
+    cutoffFrequencies[voice] = newCutoff;
+    updateCutoffFreq (voice);
+}
+
+template <typename SampleType>
+void VoiceLaneLadderFilter<SampleType>::setResonance (size_t voice, SampleType newResonance) noexcept
+{
+    jassert (newResonance >= SampleType (0) && newResonance <= SampleType (1));
+
+    scaledResonanceValues[voice / VoiceLanes<SampleType>::numLanes].set (voice % VoiceLanes<SampleType>::numLanes,
+                                                                        jmap (newResonance, SampleType (0.1), SampleType (1.0)));
+}
+
+//==============================================================================
+template <typename SampleType>
+void VoiceLaneLadderFilter<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+
+    cutoffFreqScaler = SampleType (-2.0 * juce::MathConstants<double>::pi) / static_cast<SampleType> (spec.sampleRate);
+    setNumGroups (spec.numChannels);
+
+    for (size_t voice = 0; voice < cutoffFrequencies.size(); ++voice)
+        updateCutoffFreq (voice);
+
+    reset();
+}
+
+template <typename SampleType>
+void VoiceLaneLadderFilter<SampleType>::reset() noexcept
+{
+    for (auto& s : state)
+        s.fill (LaneType::expand ({}));
+}
+
+template <typename SampleType>
+void VoiceLaneLadderFilter<SampleType>::resetVoice (size_t voice) noexcept
+{
+    for (auto& s : state[voice / VoiceLanes<SampleType>::numLanes])
+        s.set (voice % VoiceLanes<SampleType>::numLanes, {});
+}
+
+template <typename SampleType>
+void VoiceLaneLadderFilter<SampleType>::setNumGroups (size_t numGroups)
+{
+    const auto numVoices = numGroups * VoiceLanes<SampleType>::numLanes;
+
+    state.resize (numGroups);
+    cutoffTransformValues.resize (numGroups);
+    scaledResonanceValues.resize (numGroups, LaneType::expand (SampleType (0.1)));
+    cutoffFrequencies.resize (numVoices, SampleType (200));
+}
+
+template <typename SampleType>
+void VoiceLaneLadderFilter<SampleType>::updateCutoffFreq (size_t voice) noexcept
+{
+    cutoffTransformValues[voice / VoiceLanes<SampleType>::numLanes].set (voice % VoiceLanes<SampleType>::numLanes,
+                                                                        std::exp (cutoffFrequencies[voice] * cutoffFreqScaler));
+}
+
+//==============================================================================
+template <typename SampleType>
+void VoiceLaneLadderFilter<SampleType>::processGroup (size_t group, const LaneType* input, LaneType* output, size_t numSamples) noexcept
+{
+    using Lanes = VoiceLanes<SampleType>;
+
+    // The same approximation as FastMathApproximations::tanh, limited to the range
+    // where it's accurate
+    const auto saturate = [] (LaneType x) noexcept
+    {
+        x = LaneType::min (LaneType::max (x, LaneType::expand (SampleType (-5))), LaneType::expand (SampleType (5)));
+        const auto x2 = x * x;
+        const auto numerator   = x * ((x2 * (x2 + SampleType (378)) + SampleType (17325)) * x2 + SampleType (135135));
+        const auto denominator = (x2 * (x2 * SampleType (28) + SampleType (3150)) + SampleType (62370)) * x2 + SampleType (135135);
+        return Lanes::divide (numerator, denominator);
+    };
+
+    auto s = state[group];
+
+    const auto a1 = cutoffTransformValues[group];
+    const auto g  = LaneType::expand (SampleType (1)) - a1;
+    const auto b0 = g * SampleType (0.76923076923);
+    const auto b1 = g * SampleType (0.23076923076);
+    const auto feedback = scaledResonanceValues[group] * SampleType (-4);
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const auto dx = saturate (input[i] * drive) * gain;
+        const auto a  = dx + feedback * (saturate (s[4] * drive2) * gain2 - dx * comp);
+
+        const auto b = b1 * s[0] + a1 * s[1] + b0 * a;
+        const auto c = b1 * s[1] + a1 * s[2] + b0 * b;
+        const auto d = b1 * s[2] + a1 * s[3] + b0 * c;
+        const auto e = b1 * s[3] + a1 * s[4] + b0 * d;
+
+        s[0] = a;
+        s[1] = b;
+        s[2] = c;
+        s[3] = d;
+        s[4] = e;
+
+        output[i] = a * A[0] + b * A[1] + c * A[2] + d * A[3] + e * A[4];
+    }
+
+    state[group] = s;
+}
+
+//==============================================================================
+template <typename SampleType>
+void VoiceLaneADSR<SampleType>::setParameters (const Parameters& newParameters) noexcept
+{
+    parameters = newParameters;
+}
+
+template <typename SampleType>
+void VoiceLaneADSR<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+
+    sampleRate = spec.sampleRate;
+    ramps.setNumGroups (spec.numChannels);
+    stages.assign (spec.numChannels * VoiceLanes<SampleType>::numLanes, Stage::idle);
+}
+
+template <typename SampleType>
+void VoiceLaneADSR<SampleType>::reset() noexcept
+{
+    for (size_t voice = 0; voice < stages.size(); ++voice)
+    {
+        ramps.hold (voice, {});
+        stages[voice] = Stage::idle;
+    }
+}
+
+template <typename SampleType>
+void VoiceLaneADSR<SampleType>::noteOn (size_t voice) noexcept
+{
+    if (parameters.attack > 0.0f)
+    {
+        // As with ADSR, the attack continues from the current level at the usual rate
+        const auto attackSamples = parameters.attack * sampleRate;
+        const auto remaining = (1.0 - (double) ramps.getValue (voice)) * attackSamples;
+
+        ramps.startRamp (voice, SampleType (1), (size_t) jmax (1.0, std::ceil (remaining)));
+        stages[voice] = Stage::attack;
+        return;
+    }
+
+    ramps.hold (voice, SampleType (1));
+    startDecayOrSustain (voice);
+}
+
+template <typename SampleType>
+void VoiceLaneADSR<SampleType>::noteOff (size_t voice) noexcept
+{
+    if (stages[voice] == Stage::idle)
+        return;
+
+    if (parameters.release > 0.0f)
+    {
+        ramps.startRamp (voice, SampleType (0), (size_t) jmax (1.0, std::ceil (parameters.release * sampleRate)));
+        stages[voice] = Stage::release;
+        return;
+    }
+
+    ramps.hold (voice, {});
+    stages[voice] = Stage::idle;
+}
+
+template <typename SampleType>
+void VoiceLaneADSR<SampleType>::renderEnvelope (size_t group, LaneType* dest, size_t numSamples) noexcept
+{
+    ramps.render (group, dest, numSamples, [this] (size_t voice) { stageFinished (voice); });
+}
+
+template <typename SampleType>
+void VoiceLaneADSR<SampleType>::startDecayOrSustain (size_t voice) noexcept
+{
+    const auto sustain = (double) parameters.sustain;
+
+    if (parameters.decay > 0.0f && sustain < 1.0)
+    {
+        ramps.startRamp (voice, SampleType (sustain), (size_t) jmax (1.0, std::ceil (parameters.decay * sampleRate)));
+        stages[voice] = Stage::decay;
+        return;
+    }
+
+    ramps.hold (voice, SampleType (sustain));
+    stages[voice] = Stage::sustain;
+}
+
+template <typename SampleType>
+void VoiceLaneADSR<SampleType>::stageFinished (size_t voice) noexcept
+{
+    switch (stages[voice])
+    {
+        case Stage::attack:   startDecayOrSustain (voice); break;
+        case Stage::decay:    stages[voice] = Stage::sustain; break;
+        case Stage::release:  stages[voice] = Stage::idle; break;
+        case Stage::idle:
+        case Stage::sustain:
+        default:              break;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void VoiceLaneGain<SampleType>::setGainLinear (size_t voice, SampleType newGain) noexcept
+{
+    jassert (voice < targetGains.size());
+
+    if (approximatelyEqual (targetGains[voice], newGain))
+        return;
+
+    targetGains[voice] = newGain;
+    ramps.startRamp (voice, newGain, (size_t) std::floor (rampDurationSeconds * sampleRate));
+}
+
+template <typename SampleType>
+void VoiceLaneGain<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+
+    sampleRate = spec.sampleRate;
+    ramps.setNumGroups (spec.numChannels);
+    targetGains.resize (spec.numChannels * VoiceLanes<SampleType>::numLanes, SampleType (1));
+    reset();
+}
+
+template <typename SampleType>
+void VoiceLaneGain<SampleType>::reset() noexcept
+{
+    for (size_t voice = 0; voice < targetGains.size(); ++voice)
+        ramps.hold (voice, targetGains[voice]);
+}
+
+//==============================================================================
+template class VoiceLaneOscillator<float>;
+template class VoiceLaneOscillator<double>;
+template class VoiceLaneStateVariableTPTFilter<float>;
+template class VoiceLaneStateVariableTPTFilter<double>;
+template class VoiceLaneLadderFilter<float>;
+template class VoiceLaneLadderFilter<double>;
+template class VoiceLaneADSR<float>;
+template class VoiceLaneADSR<double>;
+template class VoiceLaneGain<float>;
+template class VoiceLaneGain<double>;
+
+} // namespace juce::dsp
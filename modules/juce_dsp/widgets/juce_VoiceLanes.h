@@ -0,0 +1,773 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+/**
+    Helpers for processing many mono voices at once by packing them into the lanes
+    of SIMDRegisters.
+
+    A block of packed voices is an AudioBlock<SIMDRegister<SampleType>> in which each
+    channel holds a group of numLanes voices: voice v is lane (v % numLanes) of channel
+    (v / numLanes). The VoiceLane processors process blocks like this with separate
+    parameters for every voice, so that a synthesiser can run all of its voices through
+    a single oscillator, filter or envelope object, using the full width of the SIMD
+    registers, rather than processing one mono voice at a time.
+
+    Memory for a packed block can be allocated with the AudioBlock constructor that
+    takes a HeapBlock, which aligns the samples correctly. The processors find out how
+    many voices there are when prepare() is called with the number of groups as the
+    number of channels, so the parameters of the voices should be set after that.
+
+    @see VoiceLaneAllocator, VoiceLaneOscillator, VoiceLaneStateVariableTPTFilter,
+         VoiceLaneLadderFilter, VoiceLaneADSR, VoiceLaneGain
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+struct VoiceLanes
+{
+    using LaneType = SIMDRegister<SampleType>;
+    using MaskType = typename LaneType::vMaskType;
+
+    /** The number of voices in each group. */
+    static constexpr size_t numLanes = LaneType::size();
+
+    /** Returns the number of groups needed to hold a number of voices. */
+    static constexpr size_t getNumGroups (size_t numVoices) noexcept   { return (numVoices + numLanes - 1) / numLanes; }
+
+    //==============================================================================
+    /** Copies the samples of a mono voice into its lane of a packed block. */
+    static void pack (const SampleType* source, size_t voice, const AudioBlock<LaneType>& dest) noexcept
+    {
+        auto* laneSamples = getLanePointer (dest.getChannelPointer (voice / numLanes), voice);
+
+        for (size_t i = 0; i < dest.getNumSamples(); ++i)
+            laneSamples[i * numLanes] = source[i];
+    }
+
+    /** Copies the samples of a voice out of its lane of a packed block. */
+    static void unpack (const AudioBlock<const LaneType>& source, size_t voice, SampleType* dest) noexcept
+    {
+        auto* laneSamples = getLanePointer (source.getChannelPointer (voice / numLanes), voice);
+
+        for (size_t i = 0; i < source.getNumSamples(); ++i)
+            dest[i] = laneSamples[i * numLanes];
+    }
+
+    /** Adds every voice of a packed block to a mono buffer. */
+    static void addAllVoices (const AudioBlock<const LaneType>& source, SampleType* dest) noexcept
+    {
+        for (size_t group = 0; group < source.getNumChannels(); ++group)
+        {
+            auto* samples = source.getChannelPointer (group);
+
+            for (size_t i = 0; i < source.getNumSamples(); ++i)
+                dest[i] += samples[i].sum();
+        }
+    }
+
+    //==============================================================================
+    /** Returns the lanes of a where the mask is set, and the lanes of b elsewhere. */
+    static LaneType JUCE_VECTOR_CALLTYPE select (MaskType mask, LaneType a, LaneType b) noexcept
+    {
+        return (a & mask) + (b & ~mask);
+    }
+
+    /** Divides each lane of a by the same lane of b. */
+    static LaneType JUCE_VECTOR_CALLTYPE divide (LaneType a, LaneType b) noexcept
+    {
+        alignas (sizeof (LaneType)) SampleType as[numLanes], bs[numLanes];
+        a.copyToRawArray (as);
+        b.copyToRawArray (bs);
+
+        // The compiler can turn this into a single vector division
+        for (size_t i = 0; i < numLanes; ++i)
+            as[i] /= bs[i];
+
+        return LaneType::fromRawArray (as);
+    }
+
+private:
+    template <typename Lane>
+    static auto* getLanePointer (Lane* samples, size_t voice) noexcept
+    {
+        using Element = std::conditional_t<std::is_const_v<Lane>, const SampleType, SampleType>;
+        return reinterpret_cast<Element*> (samples) + (voice % numLanes);
+    }
+};
+
+//==============================================================================
+/**
+    Keeps track of which voices of a packed block are in use.
+
+    New voices are placed in the group that already has the most voices playing, so
+    that the voices in use stay packed into as few groups as possible, and groups that
+    have no voices in use can be skipped when processing.
+
+    A SynthesiserVoice can share one of these with the other voices of a Synthesiser,
+    allocating a lane when a note starts and releasing it once its envelope finishes.
+
+    @see VoiceLanes
+
+    @tags{DSP}
+*/
+class VoiceLaneAllocator
+{
+public:
+    //==============================================================================
+    /** Creates an allocator for the given number of voices, packed into groups of
+        numLanes voices.
+    */
+    VoiceLaneAllocator (size_t numVoices, size_t numLanes);
+
+    //==============================================================================
+    /** Returns the index of a free voice and marks it as in use, or -1 if all of the
+        voices are in use.
+    */
+    int allocateVoice() noexcept;
+
+    /** Marks a voice as no longer in use. */
+    void releaseVoice (int voice) noexcept;
+
+    /** Marks all of the voices as no longer in use. */
+    void releaseAllVoices() noexcept;
+
+    //==============================================================================
+    /** Returns the number of voices that can be allocated. */
+    size_t getNumVoices() const noexcept                        { return voicesInUse.size(); }
+
+    /** Returns the number of groups that the voices are packed into. */
+    size_t getNumGroups() const noexcept                        { return numVoicesInGroup.size(); }
+
+    /** Returns true if the voice is in use. */
+    bool isVoiceInUse (int voice) const noexcept;
+
+    /** Returns the number of voices in use in a group. */
+    size_t getNumVoicesInUseInGroup (size_t group) const noexcept;
+
+private:
+    //==============================================================================
+    std::vector<bool> voicesInUse;
+    std::vector<size_t> numVoicesInGroup;
+    size_t numLanes;
+};
+
+//==============================================================================
+/**
+    An oscillator that generates a separate waveform in every voice of a packed block,
+    each with its own frequency.
+
+    Like Oscillator, the output of the oscillator is added to the input.
+
+    @see VoiceLanes, Oscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class VoiceLaneOscillator
+{
+public:
+    //==============================================================================
+    using LaneType = SIMDRegister<SampleType>;
+
+    /** The waveforms that the oscillator can generate. The sawtooth, square and
+        triangle waves are not band-limited.
+    */
+    enum class Waveform
+    {
+        sine,
+        saw,
+        square,
+        triangle
+    };
+
+    //==============================================================================
+    /** Sets the waveform that is generated in all of the voices. */
+    void setWaveform (Waveform newWaveform) noexcept     { waveform = newWaveform; }
+
+    /** Returns the waveform that is generated. */
+    Waveform getWaveform() const noexcept                { return waveform; }
+
+    /** Sets the frequency of a voice, in Hz. */
+    void setFrequency (size_t voice, SampleType newFrequencyHz) noexcept;
+
+    /** Returns the frequency of a voice, in Hz. */
+    SampleType getFrequency (size_t voice) const noexcept;
+
+    /** Sets the phase of a voice, as a proportion of a cycle between 0 and 1. This is
+        usually called when a voice starts a new note.
+    */
+    void resetPhase (size_t voice, SampleType newPhase = {}) noexcept;
+
+    //==============================================================================
+    /** Initialises the oscillator. The number of channels in the spec is the number of
+        groups of voices.
+    */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the phases of all the voices. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the input and output blocks supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numGroups   = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (numGroups <= phases.size());
+        jassert (inputBlock.getNumChannels() == numGroups);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        if (context.isBypassed)
+        {
+            outputBlock.clear();
+
+            for (size_t group = 0; group < numGroups; ++group)
+                advancePhase (group, numSamples);
+
+            return;
+        }
+
+        for (size_t group = 0; group < numGroups; ++group)
+            processGroup (group, inputBlock.getChannelPointer (group), outputBlock.getChannelPointer (group), numSamples);
+    }
+
+private:
+    //==============================================================================
+    void processGroup (size_t group, const LaneType* input, LaneType* output, size_t numSamples) noexcept;
+    void advancePhase (size_t group, size_t numSamples) noexcept;
+
+    //==============================================================================
+    std::vector<LaneType> phases, increments;
+    std::vector<SampleType> frequencies;
+    double sampleRate = 44100.0;
+    Waveform waveform = Waveform::sine;
+};
+
+//==============================================================================
+/**
+    A version of StateVariableTPTFilter that filters every voice of a packed block,
+    each with its own cutoff frequency and resonance.
+
+    @see VoiceLanes, StateVariableTPTFilter
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class VoiceLaneStateVariableTPTFilter
+{
+public:
+    //==============================================================================
+    using LaneType = SIMDRegister<SampleType>;
+    using Type = StateVariableTPTFilterType;
+
+    //==============================================================================
+    /** Sets the filter type of all the voices. */
+    void setType (Type newType) noexcept                 { filterType = newType; }
+
+    /** Returns the filter type. */
+    Type getType() const noexcept                        { return filterType; }
+
+    /** Sets the cutoff frequency of a voice, in Hz. */
+    void setCutoffFrequency (size_t voice, SampleType newFrequencyHz);
+
+    /** Sets the resonance of a voice. See StateVariableTPTFilter::setResonance(). */
+    void setResonance (size_t voice, SampleType newResonance);
+
+    /** Returns the cutoff frequency of a voice. */
+    SampleType getCutoffFrequency (size_t voice) const noexcept;
+
+    /** Returns the resonance of a voice. */
+    SampleType getResonance (size_t voice) const noexcept;
+
+    //==============================================================================
+    /** Initialises the filter. The number of channels in the spec is the number of
+        groups of voices.
+    */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of all the voices. */
+    void reset() noexcept;
+
+    /** Resets the internal state variables of a voice. This is usually called when a
+        voice starts a new note.
+    */
+    void resetVoice (size_t voice) noexcept;
+
+    //==============================================================================
+    /** Processes the input and output blocks supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numGroups   = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (numGroups <= s1.size());
+        jassert (inputBlock.getNumChannels() == numGroups);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        for (size_t group = 0; group < numGroups; ++group)
+            processGroup (group, inputBlock.getChannelPointer (group), outputBlock.getChannelPointer (group), numSamples);
+    }
+
+private:
+    //==============================================================================
+    void update (size_t voice);
+    void processGroup (size_t group, const LaneType* input, LaneType* output, size_t numSamples) noexcept;
+
+    //==============================================================================
+    std::vector<LaneType> g, h, R2, s1, s2;
+    std::vector<SampleType> cutoffFrequencies, resonances;
+    double sampleRate = 44100.0;
+    Type filterType = Type::lowpass;
+};
+
+//==============================================================================
+/**
+    A version of LadderFilter that filters every voice of a packed block, each with its
+    own cutoff frequency and resonance.
+
+    Unlike LadderFilter, changes to the cutoff frequency and resonance take effect
+    immediately rather than being smoothed, and the saturation uses the approximation
+    in FastMathApproximations::tanh.
+
+    @see VoiceLanes, LadderFilter
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class VoiceLaneLadderFilter
+{
+public:
+    //==============================================================================
+    using LaneType = SIMDRegister<SampleType>;
+    using Mode = LadderFilterMode;
+
+    //==============================================================================
+    /** Creates an uninitialised filter. Call prepare() before first use. */
+    VoiceLaneLadderFilter();
+
+    /** Sets the filter mode of all the voices. */
+    void setMode (Mode newMode) noexcept;
+
+    /** Sets the amount of saturation of all the voices. See LadderFilter::setDrive(). */
+    void setDrive (SampleType newDrive) noexcept;
+
+    /** Sets the cutoff frequency of a voice, in Hz. */
+    void setCutoffFrequencyHz (size_t voice, SampleType newCutoff) noexcept;
+
+    /** Sets the resonance of a voice, between 0 and 1. See LadderFilter::setResonance(). */
+    void setResonance (size_t voice, SampleType newResonance) noexcept;
+
+    //==============================================================================
+    /** Initialises the filter. The number of channels in the spec is the number of
+        groups of voices.
+    */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of all the voices. */
+    void reset() noexcept;
+
+    /** Resets the internal state variables of a voice. This is usually called when a
+        voice starts a new note.
+    */
+    void resetVoice (size_t voice) noexcept;
+
+    //==============================================================================
+    /** Processes the input and output blocks supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numGroups   = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (numGroups <= state.size());
+        jassert (inputBlock.getNumChannels() == numGroups);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        for (size_t group = 0; group < numGroups; ++group)
+            processGroup (group, inputBlock.getChannelPointer (group), outputBlock.getChannelPointer (group), numSamples);
+    }
+
+private:
+    //==============================================================================
+    static constexpr size_t numStates = 5;
+
+    void setNumGroups (size_t numGroups);
+    void updateCutoffFreq (size_t voice) noexcept;
+    void processGroup (size_t group, const LaneType* input, LaneType* output, size_t numSamples) noexcept;
+
+    //==============================================================================
+    SampleType drive, drive2, gain, gain2, comp;
+    std::array<SampleType, numStates> A;
+
+    std::vector<std::array<LaneType, numStates>> state;
+    std::vector<LaneType> cutoffTransformValues, scaledResonanceValues;
+    std::vector<SampleType> cutoffFrequencies;
+
+    SampleType cutoffFreqScaler;
+    Mode mode;
+};
+
+namespace detail
+{
+    /** Linear ramps for the voices of a packed block, used by VoiceLaneADSR and
+        VoiceLaneGain. Every ramp ends at an exact number of samples, after which the
+        voice holds the target value until another ramp starts.
+    */
+    template <typename SampleType>
+    class VoiceLaneRamps
+    {
+    public:
+        using LaneType = SIMDRegister<SampleType>;
+        static constexpr size_t numLanes = LaneType::size();
+
+        void setNumGroups (size_t numGroups)
+        {
+            values    .assign (numGroups, LaneType::expand ({}));
+            increments.assign (numGroups, LaneType::expand ({}));
+            targets             .assign (numGroups * numLanes, {});
+            numRemainingSamples .assign (numGroups * numLanes, 0);
+        }
+
+        SampleType getValue (size_t voice) const noexcept       { return values[voice / numLanes].get (voice % numLanes); }
+        bool isRamping (size_t voice) const noexcept            { return numRemainingSamples[voice] > 0; }
+
+        void hold (size_t voice, SampleType value) noexcept
+        {
+            values[voice / numLanes].set (voice % numLanes, value);
+            increments[voice / numLanes].set (voice % numLanes, {});
+            targets[voice] = value;
+            numRemainingSamples[voice] = 0;
+        }
+
+        void startRamp (size_t voice, SampleType target, size_t numSamples) noexcept
+        {
+            if (numSamples == 0)
+            {
+                hold (voice, target);
+                return;
+            }
+
+            const auto step = (target - getValue (voice)) / (SampleType) numSamples;
+            increments[voice / numLanes].set (voice % numLanes, step);
+            targets[voice] = target;
+            numRemainingSamples[voice] = numSamples;
+        }
+
+        /** Writes the next values of a group of voices, calling rampFinished (voice) when
+            the ramp of a voice reaches its target.
+        */
+        template <typename Callback>
+        void render (size_t group, LaneType* dest, size_t numSamples, Callback&& rampFinished) noexcept
+        {
+            auto* remaining = numRemainingSamples.data() + group * numLanes;
+
+            while (numSamples > 0)
+            {
+                auto runLength = numSamples;
+                auto anyRamping = false;
+
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                {
+                    if (remaining[lane] > 0)
+                    {
+                        runLength = jmin (runLength, remaining[lane]);
+                        anyRamping = true;
+                    }
+                }
+
+                auto value = values[group];
+
+                if (! anyRamping)
+                {
+                    std::fill (dest, dest + numSamples, value);
+                    return;
+                }
+
+                const auto increment = increments[group];
+
+                for (size_t i = 0; i < runLength; ++i)
+                {
+                    value += increment;
+                    dest[i] = value;
+                }
+
+                values[group] = value;
+
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                {
+                    if (remaining[lane] == 0)
+                        continue;
+
+                    remaining[lane] -= runLength;
+
+                    if (remaining[lane] == 0)
+                    {
+                        // Snap to the exact target so that rounding errors don't accumulate
+                        const auto voice = group * numLanes + lane;
+                        hold (voice, targets[voice]);
+                        dest[runLength - 1].set (lane, targets[voice]);
+                        rampFinished (voice);
+                    }
+                }
+
+                dest += runLength;
+                numSamples -= runLength;
+            }
+        }
+
+    private:
+        std::vector<LaneType> values, increments;
+        std::vector<SampleType> targets;
+        std::vector<size_t> numRemainingSamples;
+    };
+} // namespace detail
+
+//==============================================================================
+/**
+    A version of ADSR that generates a separate envelope for every voice of a packed
+    block. All of the voices share the same parameters.
+
+    Each stage of an envelope lasts for a whole number of samples, so a stage may end
+    one sample away from where ADSR would end it.
+
+    @see VoiceLanes, ADSR
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class VoiceLaneADSR
+{
+public:
+    //==============================================================================
+    using LaneType = SIMDRegister<SampleType>;
+    using Parameters = ADSR::Parameters;
+
+    //==============================================================================
+    /** Sets the parameters of the envelopes. As with ADSR, voices that are already
+        playing should be reset if the parameters change.
+    */
+    void setParameters (const Parameters& newParameters) noexcept;
+
+    /** Returns the parameters of the envelopes. */
+    const Parameters& getParameters() const noexcept     { return parameters; }
+
+    //==============================================================================
+    /** Initialises the envelopes. The number of channels in the spec is the number of
+        groups of voices.
+    */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets all of the envelopes to an idle state. */
+    void reset() noexcept;
+
+    /** Starts the attack stage of the envelope of a voice. */
+    void noteOn (size_t voice) noexcept;
+
+    /** Starts the release stage of the envelope of a voice. */
+    void noteOff (size_t voice) noexcept;
+
+    /** Returns true if the envelope of a voice is in its attack, decay, sustain or
+        release stage.
+    */
+    bool isActive (size_t voice) const noexcept          { return stages[voice] != Stage::idle; }
+
+    //==============================================================================
+    /** Writes the next envelope values of a group of voices. */
+    void renderEnvelope (size_t group, LaneType* dest, size_t numSamples) noexcept;
+
+    /** Applies the envelopes to the input and output blocks supplied in the processing
+        context.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numGroups   = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (numGroups * VoiceLanes<SampleType>::numLanes <= stages.size());
+        jassert (inputBlock.getNumChannels() == numGroups);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        constexpr size_t chunkSize = 64;
+        LaneType envelope[chunkSize];
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            auto* input  = inputBlock .getChannelPointer (group);
+            auto* output = outputBlock.getChannelPointer (group);
+
+            for (size_t offset = 0; offset < numSamples; offset += chunkSize)
+            {
+                const auto numInChunk = jmin (chunkSize, numSamples - offset);
+                renderEnvelope (group, envelope, numInChunk);
+
+                if (context.isBypassed)
+                    continue;
+
+                for (size_t i = 0; i < numInChunk; ++i)
+                    output[offset + i] = input[offset + i] * envelope[i];
+            }
+        }
+
+        if (context.isBypassed)
+            outputBlock.copyFrom (inputBlock);
+    }
+
+private:
+    //==============================================================================
+    enum class Stage
+    {
+        idle,
+        attack,
+        decay,
+        sustain,
+        release
+    };
+
+    void startDecayOrSustain (size_t voice) noexcept;
+    void stageFinished (size_t voice) noexcept;
+
+    //==============================================================================
+    Parameters parameters;
+    double sampleRate = 44100.0;
+    detail::VoiceLaneRamps<SampleType> ramps;
+    std::vector<Stage> stages;
+};
+
+//==============================================================================
+/**
+    A version of Gain that applies a separate, smoothed gain to every voice of a packed
+    block. The gain of every voice starts at 1.
+
+    @see VoiceLanes, Gain
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class VoiceLaneGain
+{
+public:
+    //==============================================================================
+    using LaneType = SIMDRegister<SampleType>;
+
+    //==============================================================================
+    /** Sets the gain of a voice as a linear value. */
+    void setGainLinear (size_t voice, SampleType newGain) noexcept;
+
+    /** Sets the gain of a voice in decibels. */
+    void setGainDecibels (size_t voice, SampleType newGainDecibels) noexcept   { setGainLinear (voice, Decibels::decibelsToGain (newGainDecibels)); }
+
+    /** Returns the gain of a voice as a linear value. */
+    SampleType getGainLinear (size_t voice) const noexcept                     { return targetGains[voice]; }
+
+    /** Sets the length of the ramp used for smoothing gain changes. */
+    void setRampDurationSeconds (double newDurationSeconds) noexcept           { rampDurationSeconds = newDurationSeconds; }
+
+    /** Returns the ramp duration in seconds. */
+    double getRampDurationSeconds() const noexcept                             { return rampDurationSeconds; }
+
+    //==============================================================================
+    /** Initialises the gain. The number of channels in the spec is the number of
+        groups of voices.
+    */
+    void prepare (const ProcessSpec& spec);
+
+    /** Stops any gain changes that are being smoothed, jumping straight to the new gains. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the input and output blocks supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numGroups   = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (numGroups * VoiceLanes<SampleType>::numLanes <= targetGains.size());
+        jassert (inputBlock.getNumChannels() == numGroups);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        constexpr size_t chunkSize = 64;
+        LaneType gains[chunkSize];
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            auto* input  = inputBlock .getChannelPointer (group);
+            auto* output = outputBlock.getChannelPointer (group);
+
+            for (size_t offset = 0; offset < numSamples; offset += chunkSize)
+            {
+                const auto numInChunk = jmin (chunkSize, numSamples - offset);
+                ramps.render (group, gains, numInChunk, [] (size_t) {});
+
+                if (context.isBypassed)
+                    continue;
+
+                for (size_t i = 0; i < numInChunk; ++i)
+                    output[offset + i] = input[offset + i] * gains[i];
+            }
+        }
+
+        if (context.isBypassed)
+            outputBlock.copyFrom (inputBlock);
+    }
+
+private:
+    //==============================================================================
+    detail::VoiceLaneRamps<SampleType> ramps;
+    std::vector<SampleType> targetGains;
+    double sampleRate = 0, rampDurationSeconds = 0;
+};
+
+} // namespace juce::dsp
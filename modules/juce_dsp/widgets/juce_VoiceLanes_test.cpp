@@ -0,0 +1,276 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct VoiceLanesTests final : public UnitTest
+{
+    VoiceLanesTests()
+        : UnitTest ("VoiceLanes", UnitTestCategories::dsp)
+    {}
+
+    using Lanes = VoiceLanes<float>;
+    using LaneType = Lanes::LaneType;
+
+    static constexpr size_t numGroups = 2, numVoices = numGroups * Lanes::numLanes, numSamples = 500;
+
+    // Processes a packed block of noise, then checks each voice against a reference
+    // processor that is given the same voice's input
+    template <typename Processor, typename Reference>
+    void checkAgainstReference (Processor& processor, Reference&& processReference, float tolerance)
+    {
+        auto random = getRandom();
+        HeapBlock<char> inputMemory, outputMemory;
+        AudioBlock<LaneType> input (inputMemory, numGroups, numSamples), output (outputMemory, numGroups, numSamples);
+        std::vector<std::vector<float>> voices (numVoices, std::vector<float> (numSamples));
+
+        for (size_t voice = 0; voice < numVoices; ++voice)
+        {
+            for (auto& sample : voices[voice])
+                sample = random.nextFloat() * 2.0f - 1.0f;
+
+            Lanes::pack (voices[voice].data(), voice, input);
+        }
+
+        processor.process (ProcessContextNonReplacing<LaneType> (input, output));
+
+        std::vector<float> actual (numSamples);
+
+        for (size_t voice = 0; voice < numVoices; ++voice)
+        {
+            Lanes::unpack (output, voice, actual.data());
+
+            for (size_t i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (actual[i], processReference (voice, voices[voice][i]), tolerance);
+        }
+    }
+
+    void runTest() override
+    {
+        const ProcessSpec spec { 44100.0, (uint32) numSamples, (uint32) numGroups };
+
+        beginTest ("Packing and unpacking");
+        {
+            HeapBlock<char> memory;
+            AudioBlock<LaneType> block (memory, numGroups, numSamples);
+            std::vector<float> voice (numSamples), unpacked (numSamples), sum (numSamples);
+
+            for (size_t v = 0; v < numVoices; ++v)
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                    voice[i] = (float) (v * numSamples + i);
+
+                Lanes::pack (voice.data(), v, block);
+            }
+
+            for (size_t v = 0; v < numVoices; ++v)
+            {
+                Lanes::unpack (block, v, unpacked.data());
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    expectEquals (unpacked[i], (float) (v * numSamples + i));
+            }
+
+            Lanes::addAllVoices (block, sum.data());
+
+            for (size_t i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (sum[i], (float) (numVoices * i + numSamples * numVoices * (numVoices - 1) / 2), 1.0f);
+        }
+
+        beginTest ("Allocator keeps voices packed");
+        {
+            VoiceLaneAllocator allocator (numVoices, Lanes::numLanes);
+
+            for (size_t v = 0; v < Lanes::numLanes + 1; ++v)
+                expectEquals (allocator.allocateVoice(), (int) v);
+
+            expectEquals ((int) allocator.getNumVoicesInUseInGroup (0), (int) Lanes::numLanes);
+            expectEquals ((int) allocator.getNumVoicesInUseInGroup (1), 1);
+
+            // A free lane in the busier group is used before the emptier group
+            allocator.releaseVoice (1);
+            expectEquals (allocator.allocateVoice(), 1);
+            expectEquals (allocator.allocateVoice(), (int) Lanes::numLanes + 1);
+
+            while (allocator.allocateVoice() >= 0) {}
+
+            for (size_t v = 0; v < numVoices; ++v)
+                expect (allocator.isVoiceInUse ((int) v));
+
+            allocator.releaseAllVoices();
+            expectEquals ((int) allocator.getNumVoicesInUseInGroup (1), 0);
+        }
+
+        beginTest ("Oscillator");
+        {
+            VoiceLaneOscillator<float> oscillator;
+            oscillator.prepare (spec);
+
+            for (size_t v = 0; v < numVoices; ++v)
+                oscillator.setFrequency (v, 100.0f + 573.0f * (float) v);
+
+            std::vector<double> phases (numVoices);
+
+            checkAgainstReference (oscillator, [&] (size_t v, float in)
+            {
+                const auto expected = in + std::sin (MathConstants<double>::twoPi * phases[v]);
+                phases[v] = std::fmod (phases[v] + (100.0 + 573.0 * (double) v) / spec.sampleRate, 1.0);
+                return (float) expected;
+            }, 1.0e-4f);
+        }
+
+        beginTest ("State variable filter matches StateVariableTPTFilter");
+        {
+            VoiceLaneStateVariableTPTFilter<float> filter;
+            std::vector<StateVariableTPTFilter<float>> references (numVoices);
+            filter.prepare (spec);
+            filter.setType (StateVariableTPTFilterType::bandpass);
+
+            for (size_t v = 0; v < numVoices; ++v)
+            {
+                const auto cutoff = 200.0f + 1000.0f * (float) v, resonance = 0.5f + 0.25f * (float) v;
+                filter.setCutoffFrequency (v, cutoff);
+                filter.setResonance (v, resonance);
+
+                references[v].prepare ({ spec.sampleRate, spec.maximumBlockSize, 1 });
+                references[v].setType (StateVariableTPTFilterType::bandpass);
+                references[v].setCutoffFrequency (cutoff);
+                references[v].setResonance (resonance);
+            }
+
+            checkAgainstReference (filter, [&] (size_t v, float in) { return references[v].processSample (0, in); }, 1.0e-5f);
+        }
+
+        beginTest ("Ladder filter matches LadderFilter");
+        {
+            VoiceLaneLadderFilter<float> filter;
+            std::vector<LadderFilter<float>> references (numVoices);
+            filter.prepare (spec);
+            filter.setMode (LadderFilterMode::LPF24);
+            filter.setDrive (2.0f);
+
+            for (size_t v = 0; v < numVoices; ++v)
+            {
+                const auto cutoff = 300.0f + 500.0f * (float) v, resonance = 0.08f * (float) (v % 8);
+                filter.setCutoffFrequencyHz (v, cutoff);
+                filter.setResonance (v, resonance);
+
+                references[v].setMode (LadderFilterMode::LPF24);
+                references[v].setDrive (2.0f);
+                references[v].setCutoffFrequencyHz (cutoff);
+                references[v].setResonance (resonance);
+                references[v].prepare ({ spec.sampleRate, spec.maximumBlockSize, 1 });
+            }
+
+            // LadderFilter looks up its saturation in a table, so the results differ slightly
+            checkAgainstReference (filter, [&] (size_t v, float in)
+            {
+                auto sample = in;
+                auto* channels = &sample;
+                AudioBlock<float> block (&channels, 1, 1);
+                references[v].process (ProcessContextReplacing<float> (block));
+                return sample;
+            }, 1.0e-2f);
+        }
+
+        beginTest ("ADSR matches ADSR");
+        {
+            const ADSR::Parameters parameters { 0.001f, 0.002f, 0.5f, 0.003f };
+
+            VoiceLaneADSR<float> envelope;
+            std::vector<ADSR> references (numVoices);
+            envelope.prepare (spec);
+            envelope.setParameters (parameters);
+
+            for (auto& reference : references)
+            {
+                reference.setSampleRate (spec.sampleRate);
+                reference.setParameters (parameters);
+            }
+
+            HeapBlock<char> memory;
+            AudioBlock<LaneType> block (memory, numGroups, numSamples);
+            std::vector<float> actual (numSamples);
+
+            // Each voice starts and stops at different times
+            const auto getNoteOnTime  = [] (size_t v) { return 50 * (v % 4); };
+            const auto getNoteOffTime = [] (size_t v) { return 50 * (v % 4) + 200; };
+
+            for (size_t start = 0; start < numSamples; start += 50)
+            {
+                for (size_t v = 0; v < numVoices; ++v)
+                {
+                    if (start == getNoteOnTime (v))     envelope.noteOn (v);
+                    if (start == getNoteOffTime (v))    envelope.noteOff (v);
+                }
+
+                for (size_t group = 0; group < numGroups; ++group)
+                    envelope.renderEnvelope (group, block.getChannelPointer (group) + start, 50);
+            }
+
+            for (size_t v = 0; v < numVoices; ++v)
+            {
+                Lanes::unpack (block, v, actual.data());
+
+                // Stages may end a sample away from where ADSR ends them
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    if (i == getNoteOnTime (v))     references[v].noteOn();
+                    if (i == getNoteOffTime (v))    references[v].noteOff();
+
+                    expectWithinAbsoluteError (actual[i], references[v].getNextSample(), 1.0f / (0.001f * (float) spec.sampleRate) + 1.0e-4f);
+                }
+
+                expect (! envelope.isActive (v));
+            }
+        }
+
+        beginTest ("Gain matches Gain");
+        {
+            VoiceLaneGain<float> gain;
+            std::vector<Gain<float>> references (numVoices);
+            gain.setRampDurationSeconds (0.005);
+            gain.prepare (spec);
+
+            for (size_t v = 0; v < numVoices; ++v)
+            {
+                references[v].setRampDurationSeconds (0.005);
+                references[v].prepare ({ spec.sampleRate, spec.maximumBlockSize, 1 });
+                references[v].setGainLinear (1.0f);
+                references[v].reset();
+
+                gain.setGainLinear (v, 0.1f * (float) v);
+                references[v].setGainLinear (0.1f * (float) v);
+            }
+
+            checkAgainstReference (gain, [&] (size_t v, float in) { return references[v].processSample (in); }, 1.0e-5f);
+        }
+    }
+};
+
+static VoiceLanesTests voiceLanesTests;
+
+} // namespace juce::dsp
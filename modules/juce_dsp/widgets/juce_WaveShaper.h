@@ -29,6 +29,15 @@ namespace juce::dsp
 /**
     Applies waveshaping to audio samples as single samples or AudioBlocks.
 
+    If the function is a LookupTableTransform (or a reference to one), whole blocks
+    are passed to LookupTableTransform::process() instead of being shaped one
+    sample at a time:
+
+    @code
+    LookupTableTransform<float> table ([] (float x) { return std::tanh (x); }, -5.0f, 5.0f, 1024);
+    WaveShaper<float, const LookupTableTransform<float>&> shaper { table };
+    @endcode
+
     @tags{DSP}
 */
 template <typename FloatType, typename Function = FloatType (*) (FloatType)>
@@ -57,6 +66,19 @@ struct WaveShaper
             if (context.usesSeparateInputAndOutputBlocks())
                 context.getOutputBlock().copyFrom (context.getInputBlock());
         }
+        else if constexpr (std::is_same_v<std::decay_t<Function>, LookupTableTransform<FloatType>>)
+        {
+            auto&& inBlock  = context.getInputBlock();
+            auto&& outBlock = context.getOutputBlock();
+
+            jassert (inBlock.getNumChannels() == outBlock.getNumChannels());
+            jassert (inBlock.getNumSamples() == outBlock.getNumSamples());
+
+            for (size_t ch = 0; ch < outBlock.getNumChannels(); ++ch)
+                functionToUse.process (inBlock.getChannelPointer (ch),
+                                       outBlock.getChannelPointer (ch),
+                                       outBlock.getNumSamples());
+        }
         else
         {
             AudioBlock<FloatType>::process (context.getInputBlock(),
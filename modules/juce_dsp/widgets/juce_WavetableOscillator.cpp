@@ -0,0 +1,244 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+template <typename SampleType>
+BandLimitedWavetable<SampleType>::BandLimitedWavetable (const std::function<SampleType (SampleType)>& function, int tableSizeOrder)
+{
+    jassert (tableSizeOrder >= 2 && tableSizeOrder <= 16);
+
+    std::vector<SampleType> cycle ((size_t) 1 << tableSizeOrder);
+
+    for (size_t i = 0; i < cycle.size(); ++i)
+        cycle[i] = function (MathConstants<SampleType>::twoPi * (SampleType) i / (SampleType) cycle.size()
+                               - MathConstants<SampleType>::pi);
+
+    createTables (cycle.data(), (int) cycle.size());
+}
+
+template <typename SampleType>
+BandLimitedWavetable<SampleType>::BandLimitedWavetable (const SampleType* singleCycle, int numSamples)
+{
+    createTables (singleCycle, numSamples);
+}
+
+template <typename SampleType>
+void BandLimitedWavetable<SampleType>::createTables (const SampleType* singleCycle, int numSamples)
+{
+    jassert (isPowerOfTwo (numSamples) && numSamples >= 4);
+
+    const auto order = findHighestSetBit ((uint32) numSamples);
+    tableSize = numSamples;
+
+    FFT fft (order);
+    std::vector<float> spectrum ((size_t) (2 * numSamples)), data (spectrum.size());
+
+    for (int i = 0; i < numSamples; ++i)
+        spectrum[(size_t) i] = (float) singleCycle[i];
+
+    fft.performRealOnlyForwardTransform (spectrum.data(), true);
+
+    // The Nyquist bin is always left out, so the last table is a single sine wave
+    tables.setSize (order - 1, tableSize + 1);
+
+    for (int table = 0; table < getNumTables(); ++table)
+    {
+        const auto numBinsToKeep = 2 * (size_t) (getMaxHarmonic (table) + 1);
+
+        std::fill (data.begin(), data.end(), 0.0f);
+        std::copy (spectrum.begin(), spectrum.begin() + (ptrdiff_t) numBinsToKeep, data.begin());
+
+        fft.performRealOnlyInverseTransform (data.data());
+
+        auto* dest = tables.getWritePointer (table);
+
+        for (int i = 0; i < tableSize; ++i)
+            dest[i] = (SampleType) data[(size_t) i];
+
+        dest[tableSize] = dest[0];
+    }
+}
+
+template <typename SampleType>
+int BandLimitedWavetable<SampleType>::getTableIndexForIncrement (SampleType increment) const noexcept
+{
+    const auto highestHarmonic = (SampleType) 0.5 / jmax (std::abs (increment), std::numeric_limits<SampleType>::min());
+
+    for (int table = 0; table < getNumTables() - 1; ++table)
+        if ((SampleType) getMaxHarmonic (table) <= highestHarmonic)
+            return table;
+
+    return getNumTables() - 1;
+}
+
+//==============================================================================
+template <typename SampleType>
+WavetableOscillator<SampleType>::WavetableOscillator()
+{
+    updateVoiceRatios();
+    reset();
+}
+
+template <typename SampleType>
+WavetableOscillator<SampleType>::WavetableOscillator (std::shared_ptr<const Wavetable> wavetableToUse)
+    : WavetableOscillator()
+{
+    setWavetable (std::move (wavetableToUse));
+}
+
+template <typename SampleType>
+void WavetableOscillator<SampleType>::setWavetable (std::shared_ptr<const Wavetable> newWavetable) noexcept
+{
+    wavetable = std::move (newWavetable);
+}
+
+template <typename SampleType>
+void WavetableOscillator<SampleType>::setFrequency (SampleType newFrequency, bool force) noexcept
+{
+    if (force)
+    {
+        frequency.setCurrentAndTargetValue (newFrequency);
+        return;
+    }
+
+    frequency.setTargetValue (newFrequency);
+}
+
+template <typename SampleType>
+void WavetableOscillator<SampleType>::setNumVoices (int newNumVoices) noexcept
+{
+    jassert (newNumVoices >= 1 && newNumVoices <= maxNumVoices);
+
+    numVoices = jlimit (1, maxNumVoices, newNumVoices);
+    updateVoiceRatios();
+}
+
+template <typename SampleType>
+void WavetableOscillator<SampleType>::setDetune (SampleType newDetuneCents) noexcept
+{
+    detuneCents = newDetuneCents;
+    updateVoiceRatios();
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillator<SampleType>::prepare (const ProcessSpec& spec)
+{
+    sampleRate = static_cast<SampleType> (spec.sampleRate);
+    renderBuffer.resize ((size_t) spec.maximumBlockSize);
+
+    reset();
+}
+
+template <typename SampleType>
+void WavetableOscillator<SampleType>::reset() noexcept
+{
+    for (int voice = 0; voice < maxNumVoices; ++voice)
+        phases[(size_t) voice] = (SampleType) voice / (SampleType) numVoices;
+
+    for (auto& phase : phases)
+        phase -= std::floor (phase);
+
+    if (sampleRate > 0)
+        frequency.reset (sampleRate, 0.05);
+}
+
+template <typename SampleType>
+void WavetableOscillator<SampleType>::updateVoiceRatios() noexcept
+{
+    for (int voice = 0; voice < numVoices; ++voice)
+    {
+        const auto position = numVoices == 1 ? (SampleType) 0
+                                             : (SampleType) voice / (SampleType) (numVoices - 1) - (SampleType) 0.5;
+
+        ratios[(size_t) voice] = std::pow ((SampleType) 2, position * detuneCents / (SampleType) 1200);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillator<SampleType>::renderNextBlock (SampleType* destination, int numSamples) noexcept
+{
+    jassert (isInitialised());
+
+    constexpr int chunkSize = 64;
+
+    const auto gain = (SampleType) 1 / std::sqrt ((SampleType) numVoices);
+    const auto size = (SampleType) wavetable->getTableSize();
+    const auto lastIndex = wavetable->getTableSize() - 1;
+
+    SampleType increments[chunkSize], voicePhases[chunkSize];
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const auto num = jmin (chunkSize, numSamples - start);
+        auto* dest = destination + start;
+
+        for (int i = 0; i < num; ++i)
+            increments[i] = frequency.getNextValue() / sampleRate;
+
+        // The frequency ramps linearly, so the fastest sample is at one end of the chunk
+        const auto maxIncrement = jmax (std::abs (increments[0]), std::abs (increments[num - 1]));
+
+        std::fill (dest, dest + num, (SampleType) 0);
+
+        for (size_t voice = 0; voice < (size_t) numVoices; ++voice)
+        {
+            const auto ratio = ratios[voice];
+            const auto* table = wavetable->getTable (wavetable->getTableIndexForIncrement (maxIncrement * ratio));
+
+            auto phase = phases[voice];
+
+            for (int i = 0; i < num; ++i)
+            {
+                voicePhases[i] = phase;
+                phase += increments[i] * ratio;
+                phase -= std::floor (phase);
+            }
+
+            phases[voice] = phase;
+
+            for (int i = 0; i < num; ++i)
+            {
+                const auto position = voicePhases[i] * size;
+                const auto index = jmin ((int) position, lastIndex);
+                const auto frac = position - (SampleType) index;
+
+                dest[i] += gain * (table[index] + frac * (table[index + 1] - table[index]));
+            }
+        }
+    }
+}
+
+//==============================================================================
+template class BandLimitedWavetable<float>;
+template class BandLimitedWavetable<double>;
+template class WavetableOscillator<float>;
+template class WavetableOscillator<double>;
+
+} // namespace juce::dsp
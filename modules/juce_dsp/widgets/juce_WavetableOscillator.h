@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    A set of band-limited versions of a single-cycle waveform, one for each octave.
+
+    Each table contains half as many harmonics as the one before it, so a
+    WavetableOscillator can pick a table that won't alias at the frequency it's
+    playing. The tables are built with an FFT when the object is created, so you
+    should create them before playback starts and share them between oscillators.
+
+    @see WavetableOscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class BandLimitedWavetable
+{
+public:
+    //==============================================================================
+    /** Creates a set of tables from a periodic function over the range -pi..pi.
+
+        The function is sampled at 2^tableSizeOrder points to build the table with
+        the most harmonics.
+    */
+    BandLimitedWavetable (const std::function<SampleType (SampleType)>& function, int tableSizeOrder = 11);
+
+    /** Creates a set of tables from one cycle of a waveform.
+
+        The number of samples must be a power of two.
+    */
+    BandLimitedWavetable (const SampleType* singleCycle, int numSamples);
+
+    //==============================================================================
+    /** Returns the number of samples in each table. */
+    int getTableSize() const noexcept                   { return tableSize; }
+
+    /** Returns the number of tables. */
+    int getNumTables() const noexcept                   { return tables.getNumChannels(); }
+
+    /** Returns the highest harmonic contained in one of the tables. */
+    int getMaxHarmonic (int tableIndex) const noexcept  { return (tableSize / 2 - 1) >> tableIndex; }
+
+    /** Returns the index of the table with the most harmonics that can be played
+        without aliasing, for a phase increment given in cycles per sample.
+    */
+    int getTableIndexForIncrement (SampleType increment) const noexcept;
+
+    /** Returns a pointer to one of the tables.
+
+        Each table has one extra sample at the end, which is a copy of the first, so
+        that the tables can be interpolated without wrapping the index.
+    */
+    const SampleType* getTable (int tableIndex) const noexcept   { return tables.getReadPointer (tableIndex); }
+
+private:
+    //==============================================================================
+    void createTables (const SampleType* singleCycle, int numSamples);
+
+    int tableSize = 0;
+    AudioBuffer<SampleType> tables;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BandLimitedWavetable)
+};
+
+//==============================================================================
+/**
+    An oscillator that plays a BandLimitedWavetable, with optional unison voices.
+
+    Unlike Oscillator, this doesn't call a function for each sample. It renders
+    a block at a time by interpolating the table that has the most harmonics that
+    won't alias at the current frequency.
+
+    When more than one voice is used, the voices are detuned evenly across the
+    detune range and start at evenly spaced phases, and the output is scaled by
+    1 / sqrt (numVoices) to keep the level roughly constant.
+
+    @see BandLimitedWavetable, Oscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class WavetableOscillator
+{
+public:
+    /** The type of the shared tables played by the oscillator. */
+    using Wavetable = BandLimitedWavetable<SampleType>;
+
+    /** The maximum number of unison voices. */
+    static constexpr int maxNumVoices = 16;
+
+    //==============================================================================
+    /** Creates an oscillator with no wavetable. Call setWavetable before first use. */
+    WavetableOscillator();
+
+    /** Creates an oscillator that plays the given tables. */
+    explicit WavetableOscillator (std::shared_ptr<const Wavetable> wavetableToUse);
+
+    //==============================================================================
+    /** Sets the tables to play. This doesn't reset the phase of the voices. */
+    void setWavetable (std::shared_ptr<const Wavetable> newWavetable) noexcept;
+
+    /** Returns true if the oscillator has a wavetable to play. */
+    bool isInitialised() const noexcept                     { return wavetable != nullptr; }
+
+    /** Sets the frequency of the oscillator. */
+    void setFrequency (SampleType newFrequency, bool force = false) noexcept;
+
+    /** Returns the current frequency of the oscillator. */
+    SampleType getFrequency() const noexcept                { return frequency.getTargetValue(); }
+
+    /** Sets the number of unison voices, between 1 and maxNumVoices. */
+    void setNumVoices (int newNumVoices) noexcept;
+
+    /** Returns the number of unison voices. */
+    int getNumVoices() const noexcept                       { return numVoices; }
+
+    /** Sets the total detune range of the unison voices in cents. */
+    void setDetune (SampleType newDetuneCents) noexcept;
+
+    //==============================================================================
+    /** Called before processing starts. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the phases of the voices. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Replaces the contents of a buffer with the next block of samples. */
+    void renderNextBlock (SampleType* destination, int numSamples) noexcept;
+
+    /** Adds the output of the oscillator to the input buffers supplied in the
+        processing context, in the same way that Oscillator does.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        auto&& outBlock = context.getOutputBlock();
+        auto&& inBlock  = context.getInputBlock();
+
+        const auto numSamples = outBlock.getNumSamples();
+        const auto numChannels = outBlock.getNumChannels();
+
+        jassert (isInitialised());
+        jassert (numSamples <= renderBuffer.size());
+
+        renderNextBlock (renderBuffer.data(), (int) numSamples);
+
+        if (context.isBypassed)
+        {
+            outBlock.clear();
+            return;
+        }
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto* dst = outBlock.getChannelPointer (ch);
+
+            if (ch >= inBlock.getNumChannels())
+                FloatVectorOperations::copy (dst, renderBuffer.data(), (int) numSamples);
+            else if (context.usesSeparateInputAndOutputBlocks())
+                FloatVectorOperations::add (dst, inBlock.getChannelPointer (ch), renderBuffer.data(), (int) numSamples);
+            else
+                FloatVectorOperations::add (dst, renderBuffer.data(), (int) numSamples);
+        }
+    }
+
+private:
+    //==============================================================================
+    void updateVoiceRatios() noexcept;
+
+    std::shared_ptr<const Wavetable> wavetable;
+    std::vector<SampleType> renderBuffer;
+    SmoothedValue<SampleType> frequency { static_cast<SampleType> (440.0) };
+    SampleType sampleRate = 48000.0, detuneCents = 0;
+    int numVoices = 1;
+    std::array<SampleType, maxNumVoices> phases {}, ratios {};
+};
+
+} // namespace juce::dsp
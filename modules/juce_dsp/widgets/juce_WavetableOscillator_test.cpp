@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+struct WavetableOscillatorTests final : public UnitTest
+{
+    WavetableOscillatorTests()
+        : UnitTest ("WavetableOscillator", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 256;
+
+        beginTest ("A sine table renders a sine wave");
+        {
+            auto table = std::make_shared<BandLimitedWavetable<double>> ([] (double x) { return std::sin (x); });
+
+            WavetableOscillator<double> osc (table);
+            osc.prepare ({ sampleRate, (uint32) blockSize, 1 });
+            osc.setFrequency (1000.0, true);
+
+            std::vector<double> output (blockSize);
+            osc.renderNextBlock (output.data(), blockSize);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const auto expected = std::sin (MathConstants<double>::twoPi * 1000.0 * i / sampleRate - MathConstants<double>::pi);
+                expectWithinAbsoluteError (output[(size_t) i], expected, 1.0e-4);
+            }
+        }
+
+        beginTest ("Tables are band-limited");
+        {
+            const auto saw = [] (float x) { return x / MathConstants<float>::pi; };
+            BandLimitedWavetable<float> table (saw, 10);
+
+            expectEquals (table.getTableSize(), 1024);
+            expectEquals (table.getNumTables(), 9);
+            expectEquals (table.getMaxHarmonic (0), 511);
+            expectEquals (table.getMaxHarmonic (table.getNumTables() - 1), 1);
+
+            FFT fft (10);
+            std::vector<float> spectrum (2048);
+
+            for (int index = 0; index < table.getNumTables(); ++index)
+            {
+                std::copy (table.getTable (index), table.getTable (index) + 1024, spectrum.begin());
+                expectEquals (table.getTable (index)[1024], table.getTable (index)[0]);
+
+                fft.performFrequencyOnlyForwardTransform (spectrum.data(), true);
+
+                for (int bin = table.getMaxHarmonic (index) + 1; bin < 512; ++bin)
+                    expectLessThan (spectrum[(size_t) bin], 1.0e-2f);
+
+                expectGreaterThan (spectrum[(size_t) table.getMaxHarmonic (index)], 0.1f);
+            }
+
+            for (const auto frequency : { 20.0f, 440.0f, 5000.0f, 15000.0f })
+            {
+                const auto increment = frequency / (float) sampleRate;
+                const auto index = table.getTableIndexForIncrement (increment);
+
+                expectLessOrEqual ((float) table.getMaxHarmonic (index) * increment, 0.5f);
+
+                if (index > 0)
+                    expectGreaterThan ((float) table.getMaxHarmonic (index - 1) * increment, 0.5f);
+            }
+        }
+
+        beginTest ("Unison voices start at evenly spaced phases");
+        {
+            auto table = std::make_shared<BandLimitedWavetable<float>> ([] (float x) { return std::sin (x); });
+
+            WavetableOscillator<float> single (table), unison (table);
+
+            for (auto* osc : { &single, &unison })
+            {
+                osc->prepare ({ sampleRate, (uint32) blockSize, 2 });
+                osc->setFrequency (200.0f, true);
+            }
+
+            unison.setNumVoices (2);
+            unison.setDetune (0.0f);
+            unison.reset();
+
+            // Two voices half a cycle apart with no detune cancel out completely
+            AudioBuffer<float> buffer (2, blockSize);
+            buffer.clear();
+            AudioBlock<float> block (buffer);
+            ProcessContextReplacing<float> context (block);
+
+            unison.process (context);
+            expectLessThan (buffer.getMagnitude (0, blockSize), 1.0e-4f);
+
+            single.process (context);
+            expectWithinAbsoluteError (buffer.getMagnitude (0, 0, blockSize), 1.0f, 1.0e-3f);
+            expectEquals (buffer.getMagnitude (1, 0, blockSize), buffer.getMagnitude (0, 0, blockSize));
+        }
+    }
+};
+
+static WavetableOscillatorTests wavetableOscillatorTests;
+
+} // namespace juce::dsp
@@ -63,30 +63,26 @@ ActionBroadcaster::~ActionBroadcaster()
 
 void ActionBroadcaster::addActionListener (ActionListener* const listener)
 {
-    const ScopedLock sl (actionListenerLock);
-
     if (listener != nullptr)
         actionListeners.add (listener);
 }
 
 void ActionBroadcaster::removeActionListener (ActionListener* const listener)
 {
-    const ScopedLock sl (actionListenerLock);
-    actionListeners.removeValue (listener);
+    actionListeners.remove (listener);
 }
 
 void ActionBroadcaster::removeAllActionListeners()
 {
-    const ScopedLock sl (actionListenerLock);
     actionListeners.clear();
 }
 
 void ActionBroadcaster::sendActionMessage (const String& message) const
 {
-    const ScopedLock sl (actionListenerLock);
-
-    for (int i = actionListeners.size(); --i >= 0;)
-        (new ActionMessage (this, message, actionListeners.getUnchecked (i)))->post();
+    actionListeners.call ([this, &message] (ActionListener& l)
+    {
+        (new ActionMessage (this, message, &l))->post();
+    });
 }
 
 } // namespace juce
@@ -69,8 +69,7 @@ private:
     class ActionMessage;
     friend class ActionMessage;
 
-    SortedSet<ActionListener*> actionListeners;
-    CriticalSection actionListenerLock;
+    mutable SnapshotListenerList<ActionListener> actionListeners;
 
     JUCE_DECLARE_WEAK_REFERENCEABLE (ActionBroadcaster)
     JUCE_DECLARE_NON_COPYABLE (ActionBroadcaster)
@@ -26,7 +26,7 @@ namespace juce
 class AsyncUpdater::AsyncUpdaterMessage final : public CallbackMessage
 {
 public:
-    AsyncUpdaterMessage (AsyncUpdater& au)  : owner (au) {}
+    AsyncUpdaterMessage (AsyncUpdater& au, bool coalesce)  : owner (au), isCoalesced (coalesce) {}
 
     void messageCallback() override
     {
@@ -36,14 +36,113 @@ public:
 
     AsyncUpdater& owner;
     Atomic<int> shouldDeliver;
+    const bool isCoalesced;
+
+    // Used by CoalescedUpdateMessage while this message is in the set of pending updaters
+    std::atomic<bool> isQueued { false };
+    AsyncUpdaterMessage* nextQueued = nullptr;
 
     JUCE_DECLARE_NON_COPYABLE (AsyncUpdaterMessage)
 };
 
+//==============================================================================
+/*  Delivers all the coalesced updates that have been triggered since the last one of
+    these messages arrived.
+
+    The pending updaters are kept in a lock-free intrusive stack. Only the thread that
+    finds the stack empty when pushing posts a new message, and the message takes the
+    whole stack in one go, so no matter how many updaters are triggered there's at most
+    one of these messages in the queue.
+*/
+class AsyncUpdater::CoalescedUpdateMessage final : public CallbackMessage
+{
+public:
+    CoalescedUpdateMessage() = default;
+
+    ~CoalescedUpdateMessage() override
+    {
+        // If the message queue was cleared without delivering this message, drop
+        // the updates that were waiting for it
+        if (! delivered)
+            for (auto* m : takePendingMessages())
+                release (*m, false);
+    }
+
+    static bool add (AsyncUpdaterMessage& m)
+    {
+        if (m.isQueued.exchange (true, std::memory_order_acq_rel))
+            return true;
+
+        m.incReferenceCount();
+
+        auto& head = getHead();
+        auto* oldHead = head.load (std::memory_order_relaxed);
+
+        do
+        {
+            m.nextQueued = oldHead;
+        }
+        while (! head.compare_exchange_weak (oldHead, &m, std::memory_order_release, std::memory_order_relaxed));
+
+        // If the message can't be posted, its destructor drops all the pending updates
+        return oldHead != nullptr || (new CoalescedUpdateMessage())->post();
+    }
+
+    void messageCallback() override
+    {
+        delivered = true;
+
+        for (auto* m : takePendingMessages())
+            release (*m, true);
+    }
+
+private:
+    static std::atomic<AsyncUpdaterMessage*>& getHead() noexcept
+    {
+        static std::atomic<AsyncUpdaterMessage*> head { nullptr };
+        return head;
+    }
+
+    static std::vector<AsyncUpdaterMessage*> takePendingMessages()
+    {
+        std::vector<AsyncUpdaterMessage*> result;
+
+        for (auto* m = getHead().exchange (nullptr, std::memory_order_acquire); m != nullptr; m = m->nextQueued)
+            result.push_back (m);
+
+        // The stack holds the most recently triggered updater first
+        std::reverse (result.begin(), result.end());
+        return result;
+    }
+
+    static void release (AsyncUpdaterMessage& m, bool deliver)
+    {
+        // Once this flag is cleared the updater may be pushed again, so it has to
+        // happen before the update is delivered, or a new trigger could be missed
+        m.isQueued.store (false, std::memory_order_release);
+
+        if (deliver)
+            m.messageCallback();
+        else
+            m.shouldDeliver.set (0);
+
+        m.decReferenceCount();
+    }
+
+    bool delivered = false;
+
+    JUCE_DECLARE_NON_COPYABLE (CoalescedUpdateMessage)
+};
+
 //==============================================================================
 AsyncUpdater::AsyncUpdater()
+    : AsyncUpdater (false)
 {
-    activeMessage = *new AsyncUpdaterMessage (*this);
+}
+
+AsyncUpdater::AsyncUpdater (bool coalesceWithOtherUpdaters)
+{
+    activeMessage = *new AsyncUpdaterMessage (*this, coalesceWithOtherUpdaters);
 }
 
 AsyncUpdater::~AsyncUpdater()
@@ -66,7 +165,8 @@ void AsyncUpdater::triggerAsyncUpdate()
     JUCE_ASSERT_MESSAGE_MANAGER_EXISTS
 
     if (activeMessage->shouldDeliver.compareAndSetBool (1, 0))
-        if (! activeMessage->post())
+        if (! (activeMessage->isCoalesced ? CoalescedUpdateMessage::add (*activeMessage)
+                                          : activeMessage->post()))
             cancelPendingUpdate(); // if the message queue fails, this avoids getting
                                    // trapped waiting for the message to arrive
 }
@@ -90,4 +190,137 @@ bool AsyncUpdater::isUpdatePending() const noexcept
     return activeMessage->shouldDeliver.value != 0;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && JUCE_MODAL_LOOPS_PERMITTED
+
+/*  These tests run the dispatch loop, so they need to be run on the message thread. */
+class AsyncUpdaterTests final : public UnitTest
+{
+public:
+    AsyncUpdaterTests()  : UnitTest ("AsyncUpdater", UnitTestCategories::threads) {}
+
+    void runTest() override
+    {
+        beginTest ("Coalesced updates are delivered once per updater");
+        {
+            std::vector<int> calls;
+            TestUpdater a (calls, 0), b (calls, 1), c (calls, 2);
+
+            for (int i = 0; i < 100; ++i)
+                for (auto* updater : { &a, &b, &c })
+                    updater->triggerAsyncUpdate();
+
+            dispatchMessages();
+
+            expect (calls == std::vector<int> { 0, 1, 2 });
+            expect (! a.isUpdatePending() && ! b.isUpdatePending() && ! c.isUpdatePending());
+
+            // Once an update has been delivered, the next trigger posts a new one
+            b.triggerAsyncUpdate();
+            dispatchMessages();
+
+            expect (calls == std::vector<int> { 0, 1, 2, 1 });
+        }
+
+        beginTest ("Coalesced updates are delivered in the order they were triggered");
+        {
+            std::vector<int> calls;
+            OwnedArray<TestUpdater> updaters;
+
+            for (int i = 0; i < 8; ++i)
+                updaters.add (new TestUpdater (calls, i));
+
+            const std::vector<int> order { 5, 2, 7, 0, 3, 6, 1, 4 };
+
+            for (auto index : order)
+                updaters[index]->triggerAsyncUpdate();
+
+            // Triggering again doesn't move an updater to the back
+            updaters[5]->triggerAsyncUpdate();
+
+            dispatchMessages();
+
+            expect (calls == order);
+        }
+
+        beginTest ("Queued updates can be cancelled or handled synchronously");
+        {
+            std::vector<int> calls;
+            TestUpdater a (calls, 0), b (calls, 1), c (calls, 2);
+
+            for (auto* updater : { &a, &b, &c })
+                updater->triggerAsyncUpdate();
+
+            a.cancelPendingUpdate();
+            expect (! a.isUpdatePending());
+
+            b.handleUpdateNowIfNeeded();
+            expect (calls == std::vector<int> { 1 });
+            expect (! b.isUpdatePending());
+
+            // Handling an update that isn't pending does nothing
+            b.handleUpdateNowIfNeeded();
+            expect (calls == std::vector<int> { 1 });
+
+            dispatchMessages();
+            expect (calls == std::vector<int> { 1, 2 });
+
+            // A cancelled updater that's still queued is delivered if it's triggered again
+            // before the message arrives
+            calls.clear();
+            a.triggerAsyncUpdate();
+            b.triggerAsyncUpdate();
+            a.cancelPendingUpdate();
+            a.triggerAsyncUpdate();
+
+            dispatchMessages();
+            expect (calls == std::vector<int> { 0, 1 });
+        }
+
+        beginTest ("Deleting an updater with a queued update doesn't call it back");
+        {
+            std::vector<int> calls;
+            TestUpdater a (calls, 0);
+            auto b = std::make_unique<TestUpdater> (calls, 1);
+            TestUpdater c (calls, 2);
+
+            for (auto* updater : { &a, b.get(), &c })
+                updater->triggerAsyncUpdate();
+
+            b.reset();
+
+            // Reuse the memory, so that a call to the deleted updater would be noticed
+            auto d = std::make_unique<TestUpdater> (calls, 3);
+
+            dispatchMessages();
+
+            expect (calls == std::vector<int> { 0, 2 });
+        }
+    }
+
+private:
+    struct TestUpdater final : public AsyncUpdater
+    {
+        TestUpdater (std::vector<int>& callsToAppendTo, int idToUse)
+            : AsyncUpdater (true), calls (callsToAppendTo), id (idToUse) {}
+
+        ~TestUpdater() override  { cancelPendingUpdate(); }
+
+        void handleAsyncUpdate() override   { calls.push_back (id); }
+
+        std::vector<int>& calls;
+        const int id;
+    };
+
+    static void dispatchMessages()
+    {
+        MessageManager::getInstance()->runDispatchLoopUntil (50);
+    }
+};
+
+static AsyncUpdaterTests asyncUpdaterTests;
+
+#endif
+
 } // namespace juce
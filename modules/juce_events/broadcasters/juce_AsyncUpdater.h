@@ -42,6 +42,16 @@ public:
     /** Creates an AsyncUpdater object. */
     AsyncUpdater();
 
+    /** Creates an AsyncUpdater object, optionally coalescing its updates with others.
+
+        If coalesceWithOtherUpdaters is true, rather than posting a message of its own,
+        triggerAsyncUpdate() adds this object to a shared set of pending updaters, and all
+        the updaters in that set are called back one after another from a single message.
+        This greatly reduces the load on the message queue when large numbers of objects
+        trigger updates at around the same time.
+    */
+    explicit AsyncUpdater (bool coalesceWithOtherUpdaters);
+
     /** Destructor.
         If there are any pending callbacks when the object is deleted, these are lost.
     */
@@ -101,6 +111,7 @@ public:
 private:
     //==============================================================================
     class AsyncUpdaterMessage;
+    class CoalescedUpdateMessage;
     friend class ReferenceCountedObjectPtr<AsyncUpdaterMessage>;
     ReferenceCountedObjectPtr<AsyncUpdaterMessage> activeMessage;
 
@@ -49,7 +49,7 @@ void ChangeBroadcaster::removeChangeListener (ChangeListener* const listener)
     JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
 
     changeListeners.remove (listener);
-    anyListeners = changeListeners.size() > 0;
+    anyListeners = ! changeListeners.isEmpty();
 }
 
 void ChangeBroadcaster::removeAllChangeListeners()
@@ -89,7 +89,7 @@ void ChangeBroadcaster::callListeners()
 
 //==============================================================================
 ChangeBroadcaster::ChangeBroadcasterCallback::ChangeBroadcasterCallback()
-    : owner (nullptr)
+    : AsyncUpdater (true), owner (nullptr)
 {
 }
 
@@ -94,7 +94,7 @@ private:
 
     friend class ChangeBroadcasterCallback;
     ChangeBroadcasterCallback broadcastCallback;
-    ListenerList <ChangeListener> changeListeners;
+    SnapshotListenerList<ChangeListener> changeListeners;
 
     std::atomic<bool> anyListeners { false };
 
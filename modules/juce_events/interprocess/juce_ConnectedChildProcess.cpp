@@ -40,6 +40,12 @@ static String getCommandLinePrefix (const String& commandLineUniqueID)
     return "--" + commandLineUniqueID + ":";
 }
 
+// The connection name passed to the worker starts with 'p' for a pipe, or 's' for shared memory
+static bool isSharedMemoryConnectionName (const String& name)
+{
+    return name.startsWithChar ('s');
+}
+
 //==============================================================================
 // This thread sends and receives ping messages every second, so that it
 // can find out if the other process has stopped running.
@@ -89,12 +95,15 @@ private:
 struct ChildProcessCoordinator::Connection final : public InterprocessConnection,
                                                    private ChildProcessPingThread
 {
-    Connection (ChildProcessCoordinator& m, const String& pipeName, int timeout)
+    Connection (ChildProcessCoordinator& m, const String& connectionName, size_t sharedMemoryBufferSize, int timeout)
         : InterprocessConnection (false, magicCoordWorkerConnectionHeader),
           ChildProcessPingThread (timeout),
           owner (m)
     {
-        createPipe (pipeName, timeoutMs);
+        if (sharedMemoryBufferSize > 0)
+            createSharedMemory (connectionName, sharedMemoryBufferSize, timeoutMs);
+        else
+            createPipe (connectionName, timeoutMs);
     }
 
     ~Connection() override
@@ -158,11 +167,25 @@ bool ChildProcessCoordinator::launchWorkerProcess (const File& executable, const
 {
     killWorkerProcess();
 
-    auto pipeName = "p" + String::toHexString (Random().nextInt64());
+    const auto useSharedMemory = sharedMemoryBufferSize > 0;
+    auto connectionName = (useSharedMemory ? "s" : "p") + String::toHexString (Random().nextInt64());
 
     StringArray args;
     args.add (executable.getFullPathName());
-    args.add (getCommandLinePrefix (commandLineUniqueID) + pipeName);
+    args.add (getCommandLinePrefix (commandLineUniqueID) + connectionName);
+
+    if (useSharedMemory)
+    {
+        // The worker can only open the shared memory once it exists
+        connection.reset (new Connection (*this, connectionName, sharedMemoryBufferSize,
+                                          timeoutMs <= 0 ? defaultTimeoutMs : timeoutMs));
+
+        if (! connection->isConnected())
+        {
+            connection.reset();
+            return false;
+        }
+    }
 
     childProcess = [&]() -> std::shared_ptr<ChildProcess>
     {
@@ -179,7 +202,8 @@ bool ChildProcessCoordinator::launchWorkerProcess (const File& executable, const
 
     if (childProcess != nullptr)
     {
-        connection.reset (new Connection (*this, pipeName, timeoutMs <= 0 ? defaultTimeoutMs : timeoutMs));
+        if (! useSharedMemory)
+            connection.reset (new Connection (*this, connectionName, 0, timeoutMs <= 0 ? defaultTimeoutMs : timeoutMs));
 
         if (connection->isConnected())
         {
@@ -187,13 +211,22 @@ bool ChildProcessCoordinator::launchWorkerProcess (const File& executable, const
             sendMessageToWorker ({ startMessage, specialMessageSize });
             return true;
         }
+    }
 
+    if (connection != nullptr)
+    {
+        connection->disconnect (-1, InterprocessConnection::Notify::no);
         connection.reset();
     }
 
     return false;
 }
 
+void ChildProcessCoordinator::setSharedMemoryBufferSize (size_t bufferSizeBytes)
+{
+    sharedMemoryBufferSize = bufferSizeBytes;
+}
+
 void ChildProcessCoordinator::killWorkerProcess()
 {
     if (connection != nullptr)
@@ -210,12 +243,15 @@ void ChildProcessCoordinator::killWorkerProcess()
 struct ChildProcessWorker::Connection final : public InterprocessConnection,
                                               private ChildProcessPingThread
 {
-    Connection (ChildProcessWorker& p, const String& pipeName, int timeout)
+    Connection (ChildProcessWorker& p, const String& connectionName, int timeout)
         : InterprocessConnection (false, magicCoordWorkerConnectionHeader),
           ChildProcessPingThread (timeout),
           owner (p)
     {
-        connectToPipe (pipeName, timeoutMs);
+        if (isSharedMemoryConnectionName (connectionName))
+            connectToSharedMemory (connectionName, timeoutMs);
+        else
+            connectToPipe (connectionName, timeoutMs);
     }
 
     ~Connection() override
@@ -183,6 +183,21 @@ public:
         return launchWorkerProcess (executableToLaunch, commandLineUniqueID, timeoutMs, streamFlags);
     }
 
+    /** Makes launchWorkerProcess() connect to the worker using shared memory instead of
+        a named pipe.
+
+        This is much quicker for frequent messages, such as blocks of audio going to and
+        from a sandboxed plugin. The buffer size is the size of the ring in each
+        direction, which limits the size of a message. The worker will use whichever kind
+        of connection the coordinator chose, so it doesn't need to be told about this.
+
+        Pass 0 to go back to using a named pipe. This affects the next call to
+        launchWorkerProcess().
+
+        @see InterprocessConnection::createSharedMemory
+    */
+    void setSharedMemoryBufferSize (size_t bufferSizeBytes);
+
     /** Sends a kill message to the worker, and disconnects from it.
         Note that this won't wait for it to terminate.
     */
@@ -216,6 +231,7 @@ public:
 
 private:
     std::shared_ptr<ChildProcess> childProcess;
+    size_t sharedMemoryBufferSize = 0;
 
     struct Connection;
     std::unique_ptr<Connection> connection;
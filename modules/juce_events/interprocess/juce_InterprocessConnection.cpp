@@ -145,14 +145,63 @@ bool InterprocessConnection::createPipe (const String& pipeName, int timeoutMs,
     return false;
 }
 
+bool InterprocessConnection::createSharedMemory (const String& name, size_t bufferSizeBytes, int timeoutMs)
+{
+    disconnect();
+
+    auto newSendRing = std::make_unique<SharedMemoryRing>();
+    auto newReceiveRing = std::make_unique<SharedMemoryRing>();
+
+    if (newSendRing->create (name + "_a", bufferSizeBytes)
+         && newReceiveRing->create (name + "_b", bufferSizeBytes))
+    {
+        const ScopedWriteLock sl (pipeAndSocketLock);
+        pipeReceiveMessageTimeout = timeoutMs;
+        initialiseWithSharedMemory (std::move (newSendRing), std::move (newReceiveRing));
+        return true;
+    }
+
+    return false;
+}
+
+bool InterprocessConnection::connectToSharedMemory (const String& name, int timeoutMs)
+{
+    disconnect();
+
+    auto newSendRing = std::make_unique<SharedMemoryRing>();
+    auto newReceiveRing = std::make_unique<SharedMemoryRing>();
+
+    if (newReceiveRing->openExisting (name + "_a")
+         && newSendRing->openExisting (name + "_b"))
+    {
+        const ScopedWriteLock sl (pipeAndSocketLock);
+        pipeReceiveMessageTimeout = timeoutMs;
+        initialiseWithSharedMemory (std::move (newSendRing), std::move (newReceiveRing));
+        return true;
+    }
+
+    return false;
+}
+
+void InterprocessConnection::setSocketReactor (SocketReactor* reactorToUse)
+{
+    // This needs to be set before the connection is made
+    jassert (socket == nullptr && pipe == nullptr);
+
+    socketReactor = reactorToUse;
+}
+
 void InterprocessConnection::disconnect (int timeoutMs, Notify notify)
 {
     thread->signalThreadShouldExit();
+    stopReactorCallbacks();
 
     {
         const ScopedReadLock sl (pipeAndSocketLock);
-        if (socket != nullptr)  socket->close();
-        if (pipe != nullptr)    pipe->close();
+        if (socket != nullptr)       socket->close();
+        if (pipe != nullptr)         pipe->close();
+        if (sendRing != nullptr)     sendRing->shutdown();
+        if (receiveRing != nullptr)  receiveRing->shutdown();
     }
 
     thread->stopThread (timeoutMs);
@@ -170,6 +219,8 @@ void InterprocessConnection::deletePipeAndSocket()
     const ScopedWriteLock sl (pipeAndSocketLock);
     socket.reset();
     pipe.reset();
+    sendRing.reset();
+    receiveRing.reset();
 }
 
 bool InterprocessConnection::isConnected() const
@@ -177,7 +228,8 @@ bool InterprocessConnection::isConnected() const
     const ScopedReadLock sl (pipeAndSocketLock);
 
     return ((socket != nullptr && socket->isConnected())
-              || (pipe != nullptr && pipe->isOpen()))
+              || (pipe != nullptr && pipe->isOpen())
+              || (sendRing != nullptr && ! sendRing->isShutDown()))
             && threadIsRunning;
 }
 
@@ -186,7 +238,7 @@ String InterprocessConnection::getConnectedHostName() const
     {
         const ScopedReadLock sl (pipeAndSocketLock);
 
-        if (pipe == nullptr && socket == nullptr)
+        if (pipe == nullptr && socket == nullptr && sendRing == nullptr)
             return {};
 
         if (socket != nullptr && ! socket->isLocal())
@@ -199,6 +251,17 @@ String InterprocessConnection::getConnectedHostName() const
 //==============================================================================
 bool InterprocessConnection::sendMessage (const MemoryBlock& message)
 {
+    {
+        // Shared memory keeps messages separate, so they don't need a header
+        const ScopedReadLock sl (pipeAndSocketLock);
+
+        if (sendRing != nullptr)
+        {
+            const ScopedLock ol (outgoingLock);
+            return sendRing->write (message.getData(), message.getSize(), pipeReceiveMessageTimeout);
+        }
+    }
+
     uint32 messageHeader[2] = { ByteOrder::swapIfBigEndian (magicMessageHeader),
                                 ByteOrder::swapIfBigEndian ((uint32) message.getSize()) };
 
@@ -214,7 +277,8 @@ int InterprocessConnection::writeData (void* data, int dataSize)
     const ScopedReadLock sl (pipeAndSocketLock);
 
     if (socket != nullptr)
-        return socket->write (data, dataSize);
+        return reactorSocketHandle >= 0 ? queueOutgoingData (data, dataSize)
+                                        : socket->write (data, dataSize);
 
     if (pipe != nullptr)
         return pipe->write (data, dataSize, pipeReceiveMessageTimeout);
@@ -228,7 +292,9 @@ void InterprocessConnection::initialise()
     safeAction->setSafe (true);
     threadIsRunning = true;
     connectionMadeInt();
-    thread->startThread();
+
+    if (! startReactorCallbacks())
+        thread->startThread();
 }
 
 void InterprocessConnection::initialiseWithSocket (std::unique_ptr<StreamingSocket> newSocket)
@@ -245,6 +311,15 @@ void InterprocessConnection::initialiseWithPipe (std::unique_ptr<NamedPipe> newP
     initialise();
 }
 
+void InterprocessConnection::initialiseWithSharedMemory (std::unique_ptr<SharedMemoryRing> newSendRing,
+                                                         std::unique_ptr<SharedMemoryRing> newReceiveRing)
+{
+    jassert (socket == nullptr && pipe == nullptr && sendRing == nullptr);
+    sendRing = std::move (newSendRing);
+    receiveRing = std::move (newReceiveRing);
+    initialise();
+}
+
 //==============================================================================
 struct ConnectionStateMessage final : public MessageManager::MessageBase
 {
@@ -386,10 +461,44 @@ bool InterprocessConnection::readNextMessage()
     return false;
 }
 
+bool InterprocessConnection::readNextSharedMemoryMessage()
+{
+    size_t size = 0;
+
+    if (auto* data = receiveRing->waitForNextMessage (size, 100))
+    {
+        MemoryBlock message (data, size);
+        receiveRing->finishedReading();
+
+        if (size > 0)
+            deliverDataInt (message);
+
+        return true;
+    }
+
+    return ! receiveRing->isShutDown();
+}
+
 void InterprocessConnection::runThread()
 {
     while (! thread->threadShouldExit())
     {
+        if (receiveRing != nullptr)
+        {
+            if (! readNextSharedMemoryMessage())
+            {
+                if (! thread->threadShouldExit())
+                {
+                    deletePipeAndSocket();
+                    connectionLostInt();
+                }
+
+                break;
+            }
+
+            continue;
+        }
+
         if (socket != nullptr)
         {
             auto ready = socket->waitUntilReady (true, 100);
@@ -428,4 +537,150 @@ void InterprocessConnection::runThread()
     threadIsRunning = false;
 }
 
+//==============================================================================
+bool InterprocessConnection::startReactorCallbacks()
+{
+    if (socketReactor == nullptr || socket == nullptr)
+        return false;
+
+    incomingData.reset();
+    outgoingData.reset();
+
+    const auto handle = socket->getRawSocketHandle();
+    reactorSocketHandle = handle;
+
+    if (socketReactor->addSocket (handle, [this] (int eventFlags) { handleReactorEvent (eventFlags); }))
+        return true;
+
+    reactorSocketHandle = -1;
+    return false;
+}
+
+void InterprocessConnection::stopReactorCallbacks()
+{
+    const auto handle = reactorSocketHandle.exchange (-1);
+
+    if (handle >= 0)
+    {
+        socketReactor->removeSocket (handle);
+        threadIsRunning = false;
+    }
+}
+
+void InterprocessConnection::reactorConnectionLost()
+{
+    stopReactorCallbacks();
+    deletePipeAndSocket();
+    connectionLostInt();
+}
+
+int InterprocessConnection::queueOutgoingData (const void* data, int dataSize)
+{
+    const ScopedLock sl (outgoingLock);
+    auto numWritten = 0;
+
+    // If there's already data waiting, this has to go after it
+    if (outgoingData.isEmpty())
+    {
+        numWritten = socket->writeWithoutBlocking (data, dataSize);
+
+        if (numWritten < 0)
+            return -1;
+
+        if (numWritten == dataSize)
+            return dataSize;
+    }
+
+    outgoingData.append (addBytesToPointer (data, numWritten), (size_t) (dataSize - numWritten));
+    socketReactor->setWantsWriteEvents (reactorSocketHandle, true);
+    return dataSize;
+}
+
+bool InterprocessConnection::flushOutgoingData()
+{
+    const ScopedReadLock sl (pipeAndSocketLock);
+    const ScopedLock ol (outgoingLock);
+
+    if (socket == nullptr)
+        return false;
+
+    if (! outgoingData.isEmpty())
+    {
+        auto numWritten = socket->writeWithoutBlocking (outgoingData.getData(), (int) outgoingData.getSize());
+
+        if (numWritten < 0)
+            return false;
+
+        outgoingData.removeSection (0, (size_t) numWritten);
+    }
+
+    if (outgoingData.isEmpty())
+        socketReactor->setWantsWriteEvents (reactorSocketHandle, false);
+
+    return true;
+}
+
+void InterprocessConnection::handleReactorEvent (int eventFlags)
+{
+    if ((eventFlags & SocketReactor::writable) != 0 && ! flushOutgoingData())
+    {
+        reactorConnectionLost();
+        return;
+    }
+
+    if ((eventFlags & SocketReactor::readable) == 0)
+        return;
+
+    char buffer[16384];
+    int numRead = -1;
+
+    {
+        const ScopedReadLock sl (pipeAndSocketLock);
+
+        if (socket != nullptr)
+            numRead = socket->read (buffer, (int) sizeof (buffer), false);
+    }
+
+    // A readable socket with nothing to read has been closed at the other end
+    if (numRead <= 0)
+    {
+        reactorConnectionLost();
+        return;
+    }
+
+    incomingData.append (buffer, (size_t) numRead);
+
+    uint32 messageHeader[2];
+    size_t position = 0;
+
+    while (incomingData.getSize() - position >= sizeof (messageHeader))
+    {
+        incomingData.copyTo (messageHeader, (int) position, sizeof (messageHeader));
+
+        if (ByteOrder::swapIfBigEndian (messageHeader[0]) != magicMessageHeader)
+        {
+            reactorConnectionLost();
+            return;
+        }
+
+        const auto bytesInMessage = (size_t) ByteOrder::swapIfBigEndian (messageHeader[1]);
+
+        if (incomingData.getSize() - position - sizeof (messageHeader) < bytesInMessage)
+            break;
+
+        position += sizeof (messageHeader);
+
+        if (bytesInMessage > 0)
+            deliverDataInt (MemoryBlock (addBytesToPointer (incomingData.getData(), position), bytesInMessage));
+
+        position += bytesInMessage;
+
+        // The connection may have been closed by the callback
+        if (reactorSocketHandle < 0)
+            return;
+    }
+
+    incomingData.removeSection (0, position);
+}
+
 } // namespace juce
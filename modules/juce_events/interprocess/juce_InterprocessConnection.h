@@ -120,6 +120,47 @@ public:
     */
     bool createPipe (const String& pipeName, int pipeReceiveMessageTimeoutMs, bool mustNotExist = false);
 
+    /** Tries to create a pair of shared-memory rings for another process to connect to.
+
+        Messages sent this way don't pass through the kernel, so it's much quicker than a
+        pipe for frequent messages such as blocks of audio. The other process must be on
+        the same computer, and uses connectToSharedMemory() to connect to the other end.
+
+        @param name             a name for the rings, which should be unique to your app
+        @param bufferSizeBytes  the size of each ring, which limits the size of a message
+        @param timeoutMs        how long sendMessage() waits for space in the ring, or -1
+                                to wait indefinitely
+        @returns true if the rings were created
+        @see SharedMemoryRing
+    */
+    bool createSharedMemory (const String& name, size_t bufferSizeBytes, int timeoutMs);
+
+    /** Tries to connect to a pair of shared-memory rings that another process has made
+        using createSharedMemory().
+
+        @param name         the name that was passed to createSharedMemory()
+        @param timeoutMs    how long sendMessage() waits for space in the ring, or -1
+                            to wait indefinitely
+        @returns true if it connects successfully
+    */
+    bool connectToSharedMemory (const String& name, int timeoutMs);
+
+    /** Makes socket connections use a SocketReactor to receive and send data, instead of
+        starting a thread of their own.
+
+        This lets a process have many open connections without needing a thread for each
+        one. When it's used, sendMessage() doesn't block: anything the socket can't take
+        straight away is queued and sent when the socket becomes writable. If the callbacks
+        aren't made on the message thread, they'll be made on one of the reactor's threads.
+
+        Call this before connecting. It doesn't affect connections that use a pipe. The
+        reactor must outlive this connection, and you can pass nullptr to go back to using
+        a thread.
+
+        @see SocketReactor, InterprocessConnectionServer::setSocketReactor
+    */
+    void setSocketReactor (SocketReactor* reactorToUse);
+
     /** Whether the disconnect call should trigger callbacks. */
     enum class Notify { no, yes };
 
@@ -194,6 +235,7 @@ private:
     ReadWriteLock pipeAndSocketLock;
     std::unique_ptr<StreamingSocket> socket;
     std::unique_ptr<NamedPipe> pipe;
+    std::unique_ptr<SharedMemoryRing> sendRing, receiveRing;
     bool callbackConnectionState = false;
     const bool useMessageThread;
     const uint32 magicMessageHeader;
@@ -203,11 +245,13 @@ private:
     void initialise();
     void initialiseWithSocket (std::unique_ptr<StreamingSocket>);
     void initialiseWithPipe (std::unique_ptr<NamedPipe>);
+    void initialiseWithSharedMemory (std::unique_ptr<SharedMemoryRing>, std::unique_ptr<SharedMemoryRing>);
     void deletePipeAndSocket();
     void connectionMadeInt();
     void connectionLostInt();
     void deliverDataInt (const MemoryBlock&);
     bool readNextMessage();
+    bool readNextSharedMemoryMessage();
     int readData (void*, int);
 
     struct ConnectionThread;
@@ -220,6 +264,18 @@ private:
     void runThread();
     int writeData (void*, int);
 
+    SocketReactor* socketReactor = nullptr;
+    std::atomic<int> reactorSocketHandle { -1 };
+    MemoryBlock incomingData, outgoingData;
+    CriticalSection outgoingLock;
+
+    bool startReactorCallbacks();
+    void stopReactorCallbacks();
+    void handleReactorEvent (int);
+    bool flushOutgoingData();
+    int queueOutgoingData (const void*, int);
+    void reactorConnectionLost();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InterprocessConnection)
 };
 
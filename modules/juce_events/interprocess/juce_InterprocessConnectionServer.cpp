@@ -41,6 +41,13 @@ bool InterprocessConnectionServer::beginWaitingForSocket (const int portNumber,
 
     if (socket->createListener (portNumber, bindAddress))
     {
+        if (socketReactor != nullptr
+             && socketReactor->addSocket (socket->getRawSocketHandle(), [this] (int) { acceptNextConnection(); }))
+        {
+            listenerHandle = socket->getRawSocketHandle();
+            return true;
+        }
+
         startThread();
         return true;
     }
@@ -49,10 +56,24 @@ bool InterprocessConnectionServer::beginWaitingForSocket (const int portNumber,
     return false;
 }
 
+void InterprocessConnectionServer::setSocketReactor (SocketReactor* reactorToUse)
+{
+    // This needs to be set before the server starts
+    jassert (socket == nullptr);
+
+    socketReactor = reactorToUse;
+}
+
 void InterprocessConnectionServer::stop()
 {
     signalThreadShouldExit();
 
+    if (listenerHandle >= 0)
+    {
+        socketReactor->removeSocket (listenerHandle);
+        listenerHandle = -1;
+    }
+
     if (socket != nullptr)
         socket->close();
 
@@ -68,12 +89,22 @@ int InterprocessConnectionServer::getBoundPort() const noexcept
 void InterprocessConnectionServer::run()
 {
     while ((! threadShouldExit()) && socket != nullptr)
+        acceptNextConnection();
+}
+
+void InterprocessConnectionServer::acceptNextConnection()
+{
+    std::unique_ptr<StreamingSocket> clientSocket (socket->waitForNextConnection());
+
+    if (clientSocket != nullptr)
     {
-        std::unique_ptr<StreamingSocket> clientSocket (socket->waitForNextConnection());
+        if (auto* newConnection = createConnectionObject())
+        {
+            if (newConnection->socketReactor == nullptr)
+                newConnection->socketReactor = socketReactor;
 
-        if (clientSocket != nullptr)
-            if (auto* newConnection = createConnectionObject())
-                newConnection->initialiseWithSocket (std::move (clientSocket));
+            newConnection->initialiseWithSocket (std::move (clientSocket));
+        }
     }
 }
 
@@ -67,6 +67,18 @@ public:
     */
     bool beginWaitingForSocket (int portNumber, const String& bindAddress = String());
 
+    /** Makes the server use a SocketReactor to wait for clients, rather than its own thread.
+
+        The connections that get created will also use the reactor, unless they've been
+        given one of their own, so that the whole server only needs the reactor's threads.
+        createConnectionObject() will then be called on one of the reactor's threads.
+
+        Call this before beginWaitingForSocket(). The reactor must outlive this server.
+
+        @see InterprocessConnection::setSocketReactor
+    */
+    void setSocketReactor (SocketReactor* reactorToUse);
+
     /** Terminates the listener thread, if it's active.
 
         @see beginWaitingForSocket
@@ -97,8 +109,11 @@ protected:
 private:
     //==============================================================================
     std::unique_ptr<StreamingSocket> socket;
+    SocketReactor* socketReactor = nullptr;
+    int listenerHandle = -1;
 
     void run() override;
+    void acceptNextConnection();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InterprocessConnectionServer)
 };
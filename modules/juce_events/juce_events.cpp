@@ -53,6 +53,11 @@
  #include <unistd.h>
 #endif
 
+#if JUCE_LINUX || JUCE_ANDROID
+ #include <sys/inotify.h>
+ #include <poll.h>
+#endif
+
 //==============================================================================
 #include "messages/juce_ApplicationBase.cpp"
 #include "messages/juce_DeletedAtShutdown.cpp"
@@ -70,6 +75,7 @@
 #include "interprocess/juce_ConnectedChildProcess.cpp"
 #include "interprocess/juce_NetworkServiceDiscovery.cpp"
 #include "native/juce_ScopedLowPowerModeDisabler.cpp"
+#include "messages/juce_FileSystemWatcher.cpp"
 
 //==============================================================================
 #if JUCE_MAC || JUCE_IOS
@@ -78,6 +84,7 @@
 
  #if JUCE_MAC
   #include "native/juce_MessageManager_mac.mm"
+  #include "native/juce_FileSystemWatcher_mac.mm"
  #else
   #include "native/juce_MessageManager_ios.mm"
  #endif
@@ -85,6 +92,7 @@
 #elif JUCE_WINDOWS
  #include "native/juce_RunningInUnity.h"
  #include "native/juce_Messaging_windows.cpp"
+ #include "native/juce_FileSystemWatcher_windows.cpp"
  #if JUCE_EVENTS_INCLUDE_WINRT_WRAPPER
   #include "native/juce_WinRTWrapper_windows.cpp"
  #endif
@@ -93,7 +101,12 @@
  #include "native/juce_EventLoopInternal_linux.h"
  #include "native/juce_Messaging_linux.cpp"
 
+ #if JUCE_LINUX
+  #include "native/juce_FileSystemWatcher_linux.cpp"
+ #endif
+
 #elif JUCE_ANDROID
  #include "native/juce_Messaging_android.cpp"
+ #include "native/juce_FileSystemWatcher_linux.cpp"
 
 #endif
@@ -40,6 +40,7 @@
   minimumCppStandard: 17
 
   dependencies:       juce_core
+  OSXFrameworks:      CoreServices
 
  END_JUCE_MODULE_DECLARATION
 
@@ -79,6 +80,7 @@
 #include "messages/juce_ApplicationBase.h"
 #include "messages/juce_Initialisation.h"
 #include "messages/juce_MountedVolumeListChangeDetector.h"
+#include "messages/juce_FileSystemWatcher.h"
 #include "broadcasters/juce_ActionBroadcaster.h"
 #include "broadcasters/juce_ActionListener.h"
 #include "broadcasters/juce_AsyncUpdater.h"
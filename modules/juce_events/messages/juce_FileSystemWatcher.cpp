@@ -0,0 +1,275 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct FileSystemWatcher::Impl  : private Timer,
+                                  private AsyncUpdater
+{
+    // Each watched folder has a native watch, which sends its changes to addEvent() from a
+    // background thread. They're defined by the platform-specific code.
+    struct NativeWatch
+    {
+        virtual ~NativeWatch() = default;
+    };
+
+    struct PlatformWatch;
+
+    static std::unique_ptr<NativeWatch> createNativeWatch (Impl&, const File& folder, bool recursive);
+
+    //==============================================================================
+    Impl() = default;
+
+    ~Impl() override
+    {
+        // the native threads must be stopped before anything they might call is destroyed
+        removeAllFolders();
+        cancelPendingUpdate();
+        stopTimer();
+    }
+
+    //==============================================================================
+    bool addFolder (const File& folder, bool recursive)
+    {
+        if (! folder.isDirectory())
+            return false;
+
+        removeFolder (folder);
+
+        auto native = createNativeWatch (*this, folder, recursive);
+
+        if (native == nullptr)
+            return false;
+
+        const ScopedLock sl (watchLock);
+        watches.push_back ({ folder, std::move (native) });
+        return true;
+    }
+
+    void removeFolder (const File& folder)
+    {
+        std::unique_ptr<NativeWatch> toDelete;
+
+        {
+            const ScopedLock sl (watchLock);
+            auto it = std::find_if (watches.begin(), watches.end(), [&] (const Watch& w) { return w.folder == folder; });
+
+            if (it == watches.end())
+                return;
+
+            toDelete = std::move (it->native);
+            watches.erase (it);
+        }
+    }
+
+    void removeAllFolders()
+    {
+        std::vector<Watch> toDelete;
+
+        {
+            const ScopedLock sl (watchLock);
+            std::swap (toDelete, watches);
+        }
+    }
+
+    Array<File> getWatchedFolders() const
+    {
+        const ScopedLock sl (watchLock);
+        Array<File> result;
+
+        for (auto& w : watches)
+            result.add (w.folder);
+
+        return result;
+    }
+
+    //==============================================================================
+    // These are called by the native watches, on their own threads
+    void addEvent (const File& watchedFolder, const File& file, EventType type)
+    {
+        const ScopedLock sl (pendingLock);
+        const auto wasEmpty = isEmpty();
+        const auto path = file.getFullPathName();
+
+        if (type == EventType::fileRenamedOldName || type == EventType::fileRenamedNewName)
+        {
+            // a rename ends a run of changes that can be merged, because the name now means a different file
+            lastEventForPath.erase (path);
+            pending.push_back ({ watchedFolder, file, type });
+        }
+        else if (auto it = lastEventForPath.find (path); it != lastEventForPath.end())
+        {
+            auto& previous = pending[it->second];
+
+            if (auto merged = merge (previous.type, type))
+            {
+                previous.type = *merged;
+            }
+            else
+            {
+                previous.cancelled = true;
+                lastEventForPath.erase (it);
+            }
+        }
+        else
+        {
+            lastEventForPath[path] = pending.size();
+            pending.push_back ({ watchedFolder, file, type });
+        }
+
+        if (wasEmpty)
+            triggerAsyncUpdate();
+    }
+
+    void addLostEvents (const File& watchedFolder)
+    {
+        const ScopedLock sl (pendingLock);
+        const auto wasEmpty = isEmpty();
+        foldersWithLostEvents.addIfNotAlreadyThere (watchedFolder);
+
+        if (wasEmpty)
+            triggerAsyncUpdate();
+    }
+
+    //==============================================================================
+    ListenerList<Listener> listeners;
+    std::atomic<int> coalescingInterval { 100 };
+
+private:
+    struct Watch
+    {
+        File folder;
+        std::unique_ptr<NativeWatch> native;
+    };
+
+    struct PendingEvent
+    {
+        File watchedFolder, file;
+        EventType type;
+        bool cancelled = false;
+    };
+
+    // Combines two changes to the same file, returning nullopt if they cancel each other out
+    static std::optional<EventType> merge (EventType previous, EventType next)
+    {
+        switch (previous)
+        {
+            case EventType::fileCreated:
+                if (next == EventType::fileDeleted)
+                    return {};
+
+                return EventType::fileCreated;
+
+            case EventType::fileDeleted:
+                return next == EventType::fileDeleted ? EventType::fileDeleted : EventType::fileUpdated;
+
+            case EventType::fileUpdated:
+            case EventType::fileRenamedOldName:
+            case EventType::fileRenamedNewName:
+                break;
+        }
+
+        return next == EventType::fileDeleted ? EventType::fileDeleted : EventType::fileUpdated;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return pending.empty() && foldersWithLostEvents.isEmpty();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        if (coalescingInterval <= 0)
+            deliverEvents();
+        else if (! isTimerRunning())
+            startTimer (coalescingInterval);
+    }
+
+    void timerCallback() override
+    {
+        stopTimer();
+        deliverEvents();
+    }
+
+    void deliverEvents()
+    {
+        std::vector<PendingEvent> events;
+        Array<File> lostFolders, changedFolders;
+
+        {
+            const ScopedLock sl (pendingLock);
+            std::swap (events, pending);
+            std::swap (lostFolders, foldersWithLostEvents);
+            lastEventForPath.clear();
+        }
+
+        for (auto& e : events)
+        {
+            if (! e.cancelled)
+            {
+                listeners.call ([&] (Listener& l) { l.fileChanged (e.file, e.type); });
+                changedFolders.addIfNotAlreadyThere (e.watchedFolder);
+            }
+        }
+
+        for (auto& folder : lostFolders)
+        {
+            listeners.call ([&] (Listener& l) { l.changesWereLost (folder); });
+            changedFolders.addIfNotAlreadyThere (folder);
+        }
+
+        for (auto& folder : changedFolders)
+            listeners.call ([&] (Listener& l) { l.folderChanged (folder); });
+    }
+
+    CriticalSection watchLock, pendingLock;
+    std::vector<Watch> watches;
+    std::vector<PendingEvent> pending;
+    std::map<String, size_t> lastEventForPath;
+    Array<File> foldersWithLostEvents;
+
+    JUCE_DECLARE_NON_COPYABLE (Impl)
+};
+
+#if ! (JUCE_LINUX || JUCE_ANDROID || JUCE_MAC || JUCE_WINDOWS)
+std::unique_ptr<FileSystemWatcher::Impl::NativeWatch> FileSystemWatcher::Impl::createNativeWatch (Impl&, const File&, bool)
+{
+    return nullptr;
+}
+#endif
+
+//==============================================================================
+FileSystemWatcher::FileSystemWatcher()  : impl (std::make_unique<Impl>()) {}
+FileSystemWatcher::~FileSystemWatcher() = default;
+
+void FileSystemWatcher::addListener (Listener* listener)                { impl->listeners.add (listener); }
+void FileSystemWatcher::removeListener (Listener* listener)             { impl->listeners.remove (listener); }
+
+bool FileSystemWatcher::addFolder (const File& folder, bool recursive)  { return impl->addFolder (folder, recursive); }
+void FileSystemWatcher::removeFolder (const File& folder)               { impl->removeFolder (folder); }
+void FileSystemWatcher::removeAllFolders()                              { impl->removeAllFolders(); }
+Array<File> FileSystemWatcher::getWatchedFolders() const                { return impl->getWatchedFolders(); }
+
+void FileSystemWatcher::setCoalescingInterval (int milliseconds)        { impl->coalescingInterval = jmax (0, milliseconds); }
+
+} // namespace juce
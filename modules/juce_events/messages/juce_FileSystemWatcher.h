@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Watches folders for changes to the files inside them.
+
+    This uses the operating system's change notifications (inotify on Linux and
+    Android, FSEvents on macOS and ReadDirectoryChangesW on Windows), so there's no
+    need to keep rescanning a folder on a timer to find out whether anything in it
+    has changed. On other platforms, addFolder() will fail.
+
+    The changes are collected on a background thread, and delivered to the listeners
+    on the message thread. Changes to the same file that arrive within the coalescing
+    interval are merged, so saving a file will usually produce a single fileUpdated
+    event, and a temporary file that's created and deleted again won't be reported.
+
+    @code
+    struct LibraryCache  : private FileSystemWatcher::Listener
+    {
+        LibraryCache (const File& folder)
+        {
+            watcher.addFolder (folder);
+            watcher.addListener (this);
+        }
+
+        void fileChanged (const File& file, FileSystemWatcher::EventType) override
+        {
+            invalidate (file);
+        }
+
+        FileSystemWatcher watcher;
+    };
+    @endcode
+
+    @tags{Events}
+*/
+class JUCE_API  FileSystemWatcher
+{
+public:
+    //==============================================================================
+    /** Creates a watcher that isn't watching any folders yet. */
+    FileSystemWatcher();
+
+    /** Destructor. */
+    ~FileSystemWatcher();
+
+    //==============================================================================
+    /** The kinds of change that can be reported. */
+    enum class EventType
+    {
+        fileCreated,
+        fileDeleted,
+        fileUpdated,
+        fileRenamedOldName,
+        fileRenamedNewName
+    };
+
+    //==============================================================================
+    /** Receives the changes found by a FileSystemWatcher.
+        All of these methods are called on the message thread.
+    */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener() = default;
+
+        /** Called for each file or folder that has changed. */
+        virtual void fileChanged (const File& file, EventType type)     { ignoreUnused (file, type); }
+
+        /** Called once for each watched folder in which something has changed, after
+            fileChanged() has been called for all of its changes.
+        */
+        virtual void folderChanged (const File& watchedFolder)         { ignoreUnused (watchedFolder); }
+
+        /** Called if the operating system couldn't keep up and some changes in a watched
+            folder were lost. Anything that depends on the folder's contents should rescan it.
+        */
+        virtual void changesWereLost (const File& watchedFolder)        { ignoreUnused (watchedFolder); }
+    };
+
+    /** Registers a listener. */
+    void addListener (Listener* listener);
+
+    /** Unregisters a listener. */
+    void removeListener (Listener* listener);
+
+    //==============================================================================
+    /** Starts watching a folder.
+
+        @param folder       the folder to watch
+        @param recursive    whether changes in its subfolders should also be reported
+        @returns false if the folder doesn't exist, or can't be watched on this system
+    */
+    bool addFolder (const File& folder, bool recursive = true);
+
+    /** Stops watching a folder. */
+    void removeFolder (const File& folder);
+
+    /** Stops watching all folders. */
+    void removeAllFolders();
+
+    /** Returns the folders that are being watched. */
+    Array<File> getWatchedFolders() const;
+
+    /** Sets how long to wait after a change before delivering it to the listeners, so that
+        any further changes to the same files can be merged with it. The default is 100ms.
+    */
+    void setCoalescingInterval (int milliseconds);
+
+private:
+    //==============================================================================
+    JUCE_PUBLIC_IN_DLL_BUILD (struct Impl)
+    std::unique_ptr<Impl> impl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileSystemWatcher)
+};
+
+} // namespace juce
@@ -204,6 +204,46 @@ bool MessageManager::callAsync (std::function<void()> fn)
     return (new AsyncCallInvoker (std::move (fn)))->post();
 }
 
+bool MessageManager::postSmallCallback (SmallCallback&& fn)
+{
+    // These are allocated from a lock-free pool, so that background threads can post
+    // lots of them without contending for the system allocator
+    struct SmallCallbackInvoker final : public MessageBase
+    {
+        SmallCallbackInvoker (SmallCallback&& f) : callback (std::move (f)) {}
+        void messageCallback() override  { callback(); }
+
+        static void* operator new (size_t size)
+        {
+            if (auto* block = getPool().allocate (size))
+                return block;
+
+            return ::operator new (size);
+        }
+
+        static void operator delete (void* block)
+        {
+            auto& pool = getPool();
+
+            if (pool.owns (block))
+                pool.deallocate (block);
+            else
+                ::operator delete (block);
+        }
+
+        static RealtimeMemoryPool& getPool()
+        {
+            // Deliberately never deleted, as messages can outlive the static objects
+            static auto* pool = new RealtimeMemoryPool (sizeof (SmallCallbackInvoker), 512);
+            return *pool;
+        }
+
+        SmallCallback callback;
+    };
+
+    return (new SmallCallbackInvoker (std::move (fn)))->post();
+}
+
 //==============================================================================
 void MessageManager::deliverBroadcastMessage (const String& value)
 {
@@ -96,6 +96,29 @@ public:
     */
     static bool callAsync (std::function<void()> functionToCall);
 
+    /** Asynchronously invokes a function or C++11 lambda on the message thread.
+
+        Lambdas that capture no more than a few pointers are stored inside the message
+        itself, and the messages are recycled from a pool, so posting them doesn't
+        usually involve any heap allocation. Larger callables are wrapped in a
+        std::function.
+
+        @returns  true if the message was successfully posted to the message queue,
+                  or false otherwise.
+    */
+    template <typename Callback,
+              std::enable_if_t<std::is_invocable_v<std::decay_t<Callback>&>
+                                 && ! std::is_same_v<std::decay_t<Callback>, std::function<void()>>, int> = 0>
+    static bool callAsync (Callback&& functionToCall)
+    {
+        using Fn = std::decay_t<Callback>;
+
+        if constexpr (sizeof (Fn) <= smallCallbackSize && alignof (Fn) <= alignof (std::aligned_storage_t<smallCallbackSize>))
+            return postSmallCallback (SmallCallback (std::forward<Callback> (functionToCall)));
+        else
+            return callAsync (std::function<void()> (std::forward<Callback> (functionToCall)));
+    }
+
     /** Calls a function using the message-thread.
 
         This can be used by any thread to cause this function to be called-back
@@ -340,7 +363,11 @@ private:
     Atomic<Thread::ThreadID> threadWithLock;
     mutable std::mutex messageThreadIdMutex;
 
+    static constexpr size_t smallCallbackSize = 32;
+    using SmallCallback = FixedSizeFunction<smallCallbackSize, void()>;
+
     static bool postMessageToSystemQueue (MessageBase*);
+    static bool postSmallCallback (SmallCallback&&);
     static void* exitModalLoopCallback (void*);
     static void doPlatformSpecificInitialisation();
     static void doPlatformSpecificShutdown();
@@ -467,6 +494,32 @@ private:
     JUCE_DECLARE_NON_COPYABLE (MessageManagerLock)
 };
 
+#if JUCE_COROUTINES_AVAILABLE || DOXYGEN
+//==============================================================================
+/** Returns an object that can be awaited in a coroutine to make the rest of the
+    coroutine run on the message thread.
+
+    If the coroutine is already on the message thread, it carries straight on.
+    Otherwise it's resumed by a message posted with MessageManager::callAsync(), so if
+    the app is quitting and the message can't be posted, it will never be resumed.
+
+    e.g. @code co_await resumeOnMessageThread(); @endcode
+
+    @see Task
+*/
+inline auto resumeOnMessageThread() noexcept
+{
+    struct Awaiter
+    {
+        bool await_ready() const noexcept                       { return MessageManager::existsAndIsCurrentThread(); }
+        void await_suspend (std::coroutine_handle<> h) const    { MessageManager::callAsync ([h] { h.resume(); }); }
+        void await_resume() const noexcept                      {}
+    };
+
+    return Awaiter {};
+}
+#endif
+
 //==============================================================================
 /** This macro is used to catch unsafe use of functions which expect to only be called
     on the message thread, or when a MessageManagerLock is in place.
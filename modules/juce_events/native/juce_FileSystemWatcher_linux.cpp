@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct FileSystemWatcher::Impl::PlatformWatch final : public NativeWatch,
+                                                      private Thread
+{
+    PlatformWatch (Impl& o, const File& f, bool r)
+        : Thread ("FileSystemWatcher"), owner (o), folder (f), recursive (r),
+          fd (inotify_init1 (IN_NONBLOCK | IN_CLOEXEC))
+    {
+        if (fd < 0)
+            return;
+
+        addWatch (folder);
+
+        if (recursive)
+            for (const auto& entry : RangedDirectoryIterator (folder, true, "*", File::findDirectories, File::FollowSymlinks::noCycles))
+                addWatch (entry.getFile());
+
+        if (isValid())
+            startThread();
+    }
+
+    ~PlatformWatch() override
+    {
+        stopThread (-1);
+
+        if (fd >= 0)
+            close (fd);
+    }
+
+    bool isValid() const noexcept
+    {
+        return fd >= 0 && ! directories.empty();
+    }
+
+private:
+    Impl& owner;
+    const File folder;
+    const bool recursive;
+    const int fd;
+    std::map<int, File> directories;
+
+    void addWatch (const File& dir)
+    {
+        constexpr uint32_t mask = IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MODIFY | IN_ATTRIB
+                                | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+        const auto wd = inotify_add_watch (fd, dir.getFullPathName().toRawUTF8(), mask);
+
+        if (wd >= 0)
+            directories[wd] = dir;
+    }
+
+    // A folder that appears inside a recursive watch may already have had things put into it
+    // before its own watch was added, so anything already in it is reported as new
+    void watchNewDirectory (const File& dir)
+    {
+        addWatch (dir);
+
+        for (const auto& entry : RangedDirectoryIterator (dir, true, "*", File::findFilesAndDirectories, File::FollowSymlinks::noCycles))
+        {
+            if (entry.isDirectory())
+                addWatch (entry.getFile());
+
+            owner.addEvent (folder, entry.getFile(), EventType::fileCreated);
+        }
+    }
+
+    void removeWatchesInside (const File& dir)
+    {
+        for (auto it = directories.begin(); it != directories.end();)
+        {
+            if (it->second == dir || it->second.isAChildOf (dir))
+            {
+                inotify_rm_watch (fd, it->first);
+                it = directories.erase (it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void handleEvent (const inotify_event& e)
+    {
+        if ((e.mask & IN_Q_OVERFLOW) != 0)
+        {
+            owner.addLostEvents (folder);
+            return;
+        }
+
+        const auto dirIter = directories.find (e.wd);
+
+        if (dirIter == directories.end())
+            return;
+
+        const auto dir = dirIter->second;
+
+        if ((e.mask & IN_IGNORED) != 0)
+        {
+            directories.erase (dirIter);
+            return;
+        }
+
+        // the deletion of a subfolder is reported by its parent, so only the top level matters here
+        if ((e.mask & IN_DELETE_SELF) != 0)
+        {
+            if (dir == folder)
+                owner.addEvent (folder, folder, EventType::fileDeleted);
+
+            return;
+        }
+
+        if (e.len == 0)
+            return;
+
+        const auto file = dir.getChildFile (String::fromUTF8 (e.name));
+        const auto isDirectory = (e.mask & IN_ISDIR) != 0;
+
+        if ((e.mask & IN_CREATE) != 0)
+        {
+            owner.addEvent (folder, file, EventType::fileCreated);
+
+            if (isDirectory && recursive)
+                watchNewDirectory (file);
+        }
+        else if ((e.mask & IN_DELETE) != 0)
+        {
+            owner.addEvent (folder, file, EventType::fileDeleted);
+        }
+        else if ((e.mask & IN_MOVED_FROM) != 0)
+        {
+            owner.addEvent (folder, file, EventType::fileRenamedOldName);
+
+            if (isDirectory && recursive)
+                removeWatchesInside (file);
+        }
+        else if ((e.mask & IN_MOVED_TO) != 0)
+        {
+            owner.addEvent (folder, file, EventType::fileRenamedNewName);
+
+            if (isDirectory && recursive)
+                watchNewDirectory (file);
+        }
+        else if ((e.mask & (IN_MODIFY | IN_ATTRIB)) != 0)
+        {
+            owner.addEvent (folder, file, EventType::fileUpdated);
+        }
+    }
+
+    void run() override
+    {
+        alignas (inotify_event) char buffer[16384];
+
+        while (! threadShouldExit())
+        {
+            pollfd pfd { fd, POLLIN, 0 };
+
+            if (poll (&pfd, 1, 100) <= 0)
+                continue;
+
+            const auto numRead = read (fd, buffer, sizeof (buffer));
+
+            for (ssize_t pos = 0; pos < numRead;)
+            {
+                const auto* e = reinterpret_cast<const inotify_event*> (buffer + pos);
+                handleEvent (*e);
+                pos += (ssize_t) (sizeof (inotify_event) + e->len);
+            }
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (PlatformWatch)
+};
+
+std::unique_ptr<FileSystemWatcher::Impl::NativeWatch> FileSystemWatcher::Impl::createNativeWatch (Impl& owner, const File& folder, bool recursive)
+{
+    auto watch = std::make_unique<PlatformWatch> (owner, folder, recursive);
+
+    if (watch->isValid())
+        return watch;
+
+    return nullptr;
+}
+
+} // namespace juce
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct FileSystemWatcher::Impl::PlatformWatch final : public NativeWatch
+{
+    PlatformWatch (Impl& o, const File& f, bool r)
+        : owner (o), folder (f), recursive (r)
+    {
+        // FSEvents reports paths with any symlinks resolved (e.g. /var -> /private/var), so they're
+        // matched against the real path, and then translated back to the folder that was asked for
+        char resolved[PATH_MAX];
+
+        if (realpath (folder.getFullPathName().toRawUTF8(), resolved) != nullptr)
+            realFolderPath = String::fromUTF8 (resolved);
+        else
+            realFolderPath = folder.getFullPathName();
+
+        const CFUniquePtr<CFStringRef> path (realFolderPath.toCFString());
+        const void* paths[] = { path.get() };
+        const CFUniquePtr<CFArrayRef> pathArray (CFArrayCreate (nullptr, paths, 1, &kCFTypeArrayCallBacks));
+
+        FSEventStreamContext context { 0, this, nullptr, nullptr, nullptr };
+
+        stream = FSEventStreamCreate (nullptr, &eventCallback, &context, pathArray.get(),
+                                      kFSEventStreamEventIdSinceNow, 0.05,
+                                      kFSEventStreamCreateFlagFileEvents | kFSEventStreamCreateFlagNoDefer
+                                        | kFSEventStreamCreateFlagWatchRoot);
+
+        if (stream == nullptr)
+            return;
+
+        queue = dispatch_queue_create ("com.juce.filesystemwatcher", DISPATCH_QUEUE_SERIAL);
+        FSEventStreamSetDispatchQueue (stream, queue);
+
+        if (! FSEventStreamStart (stream))
+            releaseStream();
+    }
+
+    ~PlatformWatch() override
+    {
+        releaseStream();
+    }
+
+    bool isValid() const noexcept
+    {
+        return stream != nullptr;
+    }
+
+private:
+    Impl& owner;
+    const File folder;
+    const bool recursive;
+    String realFolderPath;
+    FSEventStreamRef stream = nullptr;
+    dispatch_queue_t queue = nullptr;
+
+    void releaseStream()
+    {
+        if (stream != nullptr)
+        {
+            FSEventStreamStop (stream);
+            FSEventStreamInvalidate (stream);
+
+            // wait for any callback that's already running to finish
+            dispatch_sync (queue, ^{});
+
+            FSEventStreamRelease (stream);
+            stream = nullptr;
+        }
+
+        if (queue != nullptr)
+        {
+            dispatch_release (queue);
+            queue = nullptr;
+        }
+    }
+
+    void handleEvent (const String& path, FSEventStreamEventFlags flags)
+    {
+        if ((flags & (kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagUserDropped
+                        | kFSEventStreamEventFlagKernelDropped)) != 0)
+        {
+            owner.addLostEvents (folder);
+            return;
+        }
+
+        if (! path.startsWith (realFolderPath))
+            return;
+
+        const auto relativePath = path.substring (realFolderPath.length()).trimCharactersAtStart ("/");
+        const auto file = relativePath.isEmpty() ? folder : folder.getChildFile (relativePath);
+
+        if ((flags & kFSEventStreamEventFlagRootChanged) != 0)
+        {
+            if (! folder.isDirectory())
+                owner.addEvent (folder, folder, EventType::fileDeleted);
+
+            return;
+        }
+
+        if (! recursive && relativePath.containsChar ('/'))
+            return;
+
+        // Events that happen close together can be combined into one, so the file's current
+        // state is used to tell which of the flags came last
+        const auto exists = file.exists();
+
+        if ((flags & kFSEventStreamEventFlagItemRenamed) != 0)
+            owner.addEvent (folder, file, exists ? EventType::fileRenamedNewName : EventType::fileRenamedOldName);
+        else if ((flags & kFSEventStreamEventFlagItemRemoved) != 0 && ! exists)
+            owner.addEvent (folder, file, EventType::fileDeleted);
+        else if ((flags & kFSEventStreamEventFlagItemCreated) != 0 && exists)
+            owner.addEvent (folder, file, EventType::fileCreated);
+        else if ((flags & (kFSEventStreamEventFlagItemModified | kFSEventStreamEventFlagItemInodeMetaMod
+                             | kFSEventStreamEventFlagItemChangeOwner | kFSEventStreamEventFlagItemXattrMod)) != 0)
+            owner.addEvent (folder, file, EventType::fileUpdated);
+    }
+
+    static void eventCallback (ConstFSEventStreamRef, void* info, size_t numEvents, void* eventPaths,
+                               const FSEventStreamEventFlags flags[], const FSEventStreamEventId[])
+    {
+        auto& watch = *static_cast<PlatformWatch*> (info);
+        auto** paths = static_cast<char**> (eventPaths);
+
+        for (size_t i = 0; i < numEvents; ++i)
+            watch.handleEvent (String::fromUTF8 (paths[i]), flags[i]);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (PlatformWatch)
+};
+
+std::unique_ptr<FileSystemWatcher::Impl::NativeWatch> FileSystemWatcher::Impl::createNativeWatch (Impl& owner, const File& folder, bool recursive)
+{
+    auto watch = std::make_unique<PlatformWatch> (owner, folder, recursive);
+
+    if (watch->isValid())
+        return watch;
+
+    return nullptr;
+}
+
+} // namespace juce
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct FileSystemWatcher::Impl::PlatformWatch final : public NativeWatch,
+                                                      private Thread
+{
+    PlatformWatch (Impl& o, const File& f, bool r)
+        : Thread ("FileSystemWatcher"), owner (o), folder (f), recursive (r)
+    {
+        directoryHandle = CreateFile (folder.getFullPathName().toWideCharPointer(),
+                                      FILE_LIST_DIRECTORY,
+                                      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                      nullptr, OPEN_EXISTING,
+                                      FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+
+        if (isValid())
+            startThread();
+    }
+
+    ~PlatformWatch() override
+    {
+        signalThreadShouldExit();
+        SetEvent (stopEvent);
+        stopThread (-1);
+
+        if (isValid())
+            CloseHandle (directoryHandle);
+
+        CloseHandle (stopEvent);
+        CloseHandle (readEvent);
+    }
+
+    bool isValid() const noexcept
+    {
+        return directoryHandle != INVALID_HANDLE_VALUE;
+    }
+
+private:
+    Impl& owner;
+    const File folder;
+    const bool recursive;
+    HANDLE directoryHandle = INVALID_HANDLE_VALUE;
+    HANDLE stopEvent = CreateEvent (nullptr, TRUE, FALSE, nullptr);
+    HANDLE readEvent = CreateEvent (nullptr, TRUE, FALSE, nullptr);
+
+    void handleChange (const FILE_NOTIFY_INFORMATION& info)
+    {
+        const auto name = String (info.FileName, (size_t) info.FileNameLength / sizeof (WCHAR));
+        const auto file = folder.getChildFile (name);
+
+        switch (info.Action)
+        {
+            case FILE_ACTION_ADDED:             owner.addEvent (folder, file, EventType::fileCreated);          break;
+            case FILE_ACTION_REMOVED:           owner.addEvent (folder, file, EventType::fileDeleted);          break;
+            case FILE_ACTION_MODIFIED:          owner.addEvent (folder, file, EventType::fileUpdated);          break;
+            case FILE_ACTION_RENAMED_OLD_NAME:  owner.addEvent (folder, file, EventType::fileRenamedOldName);   break;
+            case FILE_ACTION_RENAMED_NEW_NAME:  owner.addEvent (folder, file, EventType::fileRenamedNewName);   break;
+            default:                            break;
+        }
+    }
+
+    void run() override
+    {
+        constexpr DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_ATTRIBUTES
+                               | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION;
+
+        // the buffer has to be DWORD-aligned, and a network drive can't return more than 64K at a time
+        alignas (DWORD) char buffer[65536];
+
+        while (! threadShouldExit())
+        {
+            OVERLAPPED overlapped {};
+            overlapped.hEvent = readEvent;
+            ResetEvent (readEvent);
+
+            if (! ReadDirectoryChangesW (directoryHandle, buffer, (DWORD) sizeof (buffer), recursive ? TRUE : FALSE,
+                                         filter, nullptr, &overlapped, nullptr))
+            {
+                // the folder has probably been deleted
+                owner.addEvent (folder, folder, EventType::fileDeleted);
+                return;
+            }
+
+            const HANDLE handles[] = { readEvent, stopEvent };
+
+            if (WaitForMultipleObjects (2, handles, FALSE, INFINITE) != WAIT_OBJECT_0)
+            {
+                CancelIo (directoryHandle);
+                DWORD ignored = 0;
+                GetOverlappedResult (directoryHandle, &overlapped, &ignored, TRUE);
+                return;
+            }
+
+            DWORD numBytes = 0;
+
+            if (! GetOverlappedResult (directoryHandle, &overlapped, &numBytes, FALSE))
+            {
+                if (GetLastError() == ERROR_NOTIFY_ENUM_DIR)
+                {
+                    owner.addLostEvents (folder);
+                    continue;
+                }
+
+                owner.addEvent (folder, folder, EventType::fileDeleted);
+                return;
+            }
+
+            // no data means that the buffer overflowed, and the changes have been lost
+            if (numBytes == 0)
+            {
+                owner.addLostEvents (folder);
+                continue;
+            }
+
+            for (DWORD offset = 0;;)
+            {
+                const auto& info = *reinterpret_cast<const FILE_NOTIFY_INFORMATION*> (buffer + offset);
+                handleChange (info);
+
+                if (info.NextEntryOffset == 0)
+                    break;
+
+                offset += info.NextEntryOffset;
+            }
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (PlatformWatch)
+};
+
+std::unique_ptr<FileSystemWatcher::Impl::NativeWatch> FileSystemWatcher::Impl::createNativeWatch (Impl& owner, const File& folder, bool recursive)
+{
+    auto watch = std::make_unique<PlatformWatch> (owner, folder, recursive);
+
+    if (watch->isValid())
+        return watch;
+
+    return nullptr;
+}
+
+} // namespace juce
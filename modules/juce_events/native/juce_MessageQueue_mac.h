@@ -74,6 +74,9 @@ private:
         if (nextMessage == nullptr)
             return false;
 
+        JUCE_TRACE_THREAD_NAME ("Message Thread");
+        JUCE_TRACE_SCOPE ("events", "dispatchMessage");
+
         JUCE_AUTORELEASEPOOL
         {
             JUCE_TRY
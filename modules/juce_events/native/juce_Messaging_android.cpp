@@ -101,6 +101,8 @@ private:
             if (message == nullptr)
                 break;
 
+            JUCE_TRACE_THREAD_NAME ("Message Thread");
+            JUCE_TRACE_SCOPE ("events", "dispatchMessage");
             message->messageCallback();
         }
     }
@@ -24,6 +24,20 @@ namespace juce
 {
 
 //==============================================================================
+/*
+    Messages are passed to the message thread through a lock-free queue, and the thread
+    is woken by writing a byte to a socket that the event loop polls.
+
+    Only the first message posted after the message thread has started handling a batch
+    writes to the socket, so a burst of messages costs a single wake-up. Each batch
+    handles the messages that were waiting when it started, so that a thread that posts
+    messages continuously can't stop the event loop from servicing its other file
+    descriptors.
+
+    If the queue fills up, messages go into an overflow list protected by a lock, and
+    carry on going there until the message thread has emptied it, so that the messages
+    from each thread are still delivered in order.
+*/
 class InternalMessageQueue
 {
 public:
@@ -35,14 +49,7 @@ public:
         LinuxEventLoop::registerFdCallback (getReadHandle(),
                                             [this] (int fd)
                                             {
-                                                while (auto msg = popNextMessage (fd))
-                                                {
-                                                    JUCE_TRY
-                                                    {
-                                                        msg->messageCallback();
-                                                    }
-                                                    JUCE_CATCH_EXCEPTION
-                                                }
+                                                dispatchMessages (fd);
                                             });
     }
 
@@ -53,20 +60,29 @@ public:
         close (getReadHandle());
         close (getWriteHandle());
 
+        for (MessageManager::MessageBase* msg = nullptr; queue.pop (msg);)
+            msg->decReferenceCount();
+
+        for (auto* msg : overflow)
+            msg->decReferenceCount();
+
         clearSingletonInstance();
     }
 
     //==============================================================================
     void postMessage (MessageManager::MessageBase* const msg) noexcept
     {
-        ScopedLock sl (lock);
-        queue.add (msg);
+        msg->incReferenceCount();
 
-        if (bytesInSocket < maxBytesInSocketQueue)
+        if (numOverflowing.load (std::memory_order_acquire) != 0 || ! queue.push (msg))
         {
-            bytesInSocket++;
+            const ScopedLock sl (overflowLock);
+            overflow.push_back (msg);
+            numOverflowing.store ((int) overflow.size(), std::memory_order_release);
+        }
 
-            ScopedUnlock ul (lock);
+        if (! wakeUpPending.exchange (true, std::memory_order_acq_rel))
+        {
             unsigned char x = 0xff;
             [[maybe_unused]] auto numBytes = write (getWriteHandle(), &x, 1);
         }
@@ -76,30 +92,66 @@ public:
     JUCE_DECLARE_SINGLETON (InternalMessageQueue, false)
 
 private:
-    CriticalSection lock;
-    ReferenceCountedArray <MessageManager::MessageBase> queue;
+    MpmcRingBuffer<MessageManager::MessageBase*> queue { 4096 };
+    std::atomic<bool> wakeUpPending { false };
+
+    CriticalSection overflowLock;
+    std::vector<MessageManager::MessageBase*> overflow;
+    std::atomic<int> numOverflowing { 0 };
 
     int msgpipe[2];
-    int bytesInSocket = 0;
-    static constexpr int maxBytesInSocketQueue = 128;
 
     int getWriteHandle() const noexcept  { return msgpipe[0]; }
     int getReadHandle() const noexcept   { return msgpipe[1]; }
 
-    MessageManager::MessageBase::Ptr popNextMessage (int fd) noexcept
+    static void dispatch (MessageManager::MessageBase* msg)
     {
-        const ScopedLock sl (lock);
+        const MessageManager::MessageBase::Ptr ptr (msg);
+        msg->decReferenceCountWithoutDeleting();
 
-        if (bytesInSocket > 0)
+        JUCE_TRACE_THREAD_NAME ("Message Thread");
+        JUCE_TRACE_SCOPE ("events", "dispatchMessage");
+
+        JUCE_TRY
         {
-            --bytesInSocket;
+            ptr->messageCallback();
+        }
+        JUCE_CATCH_EXCEPTION
+    }
 
-            ScopedUnlock ul (lock);
-            unsigned char x;
-            [[maybe_unused]] auto numBytes = read (fd, &x, 1);
+    void dispatchMessages (int fd)
+    {
+        // Any messages posted after the flag is cleared will wake us up again
+        unsigned char buffer[16];
+
+        while (recv (fd, buffer, sizeof (buffer), MSG_DONTWAIT) == (ssize_t) sizeof (buffer))
+        {}
+
+        wakeUpPending.exchange (false, std::memory_order_acq_rel);
+
+        MessageManager::MessageBase* msg = nullptr;
+
+        for (auto numToDispatch = queue.getNumReady(); numToDispatch > 0 && queue.pop (msg); --numToDispatch)
+            dispatch (msg);
+
+        if (numOverflowing.load (std::memory_order_acquire) == 0)
+            return;
+
+        // While there are messages in the overflow list, nothing new is added to the queue,
+        // so the queue has to be emptied before the overflow messages are delivered
+        while (queue.pop (msg))
+            dispatch (msg);
+
+        std::vector<MessageManager::MessageBase*> overflowMessages;
+
+        {
+            const ScopedLock sl (overflowLock);
+            overflowMessages.swap (overflow);
+            numOverflowing.store (0, std::memory_order_release);
         }
 
-        return queue.removeAndReturn (0);
+        for (auto* m : overflowMessages)
+            dispatch (m);
     }
 };
 
@@ -186,6 +186,9 @@ private:
 
     static void dispatchMessage (MessageManager::MessageBase* message)
     {
+        JUCE_TRACE_THREAD_NAME ("Message Thread");
+        JUCE_TRACE_SCOPE ("events", "dispatchMessage");
+
         JUCE_TRY
         {
             message->messageCallback();
@@ -23,6 +23,16 @@
 namespace juce
 {
 
+/*  The timers are kept in a hierarchical timing wheel, so that starting, stopping or
+    resetting one takes constant time however many are running.
+
+    Time is measured in ticks of one millisecond. Each level of the wheel has 64 slots,
+    and each slot of level n holds the timers that are due within one 64^n tick period,
+    in a doubly-linked list that runs through the Timer objects themselves. As time
+    passes, the timers in each slot of a higher level get moved down to the level below,
+    and the ones in level 0 get moved onto a list of timers that are due. All of the
+    timers that fall due together are then called by a single message.
+*/
 class Timer::TimerThread final : private Thread
 {
 public:
@@ -30,7 +40,6 @@ public:
 
     TimerThread()  : Thread ("JUCE Timer")
     {
-        timers.reserve (32);
     }
 
     ~TimerThread() override
@@ -42,17 +51,11 @@ public:
 
     void run() override
     {
-        auto lastTime = Time::getMillisecondCounter();
         ReferenceCountedObjectPtr<CallTimersMessage> messageToSend (new CallTimersMessage());
 
         while (! threadShouldExit())
         {
-            auto now = Time::getMillisecondCounter();
-            auto elapsed = (int) (now >= lastTime ? (now - lastTime)
-                                                  : (std::numeric_limits<uint32>::max() - (lastTime - now)));
-            lastTime = now;
-
-            auto timeUntilFirstTimer = getTimeUntilFirstTimer (elapsed);
+            auto timeUntilFirstTimer = getTimeUntilFirstTimer();
 
             if (timeUntilFirstTimer <= 0)
             {
@@ -85,20 +88,21 @@ public:
     void callTimers()
     {
         auto timeout = Time::getMillisecondCounter() + 100;
+        auto batchStartTime = Time::getMillisecondCounterHiRes();
+        int64 numCalled = 0;
 
         const LockType::ScopedLockType sl (lock);
 
-        while (! timers.empty())
-        {
-            auto& first = timers.front();
+        advance();
 
-            if (first.countdownMs > 0)
-                break;
+        while (auto* timer = slots[dueSlot].first)
+        {
+            statistics.maxLatenessMs = jmax (statistics.maxLatenessMs, (int) (currentTime - timer->dueTime));
 
-            auto* timer = first.timer;
-            first.countdownMs = timer->timerPeriodMs;
-            shuffleTimerBackInQueue (0);
-            notify();
+            unlink (timer);
+            timer->dueTime = currentTime + timer->timerPeriodMs;
+            insert (timer);
+            ++numCalled;
 
             const LockType::ScopedUnlockType ul (lock);
 
@@ -113,6 +117,17 @@ public:
                 break;
         }
 
+        if (numCalled > 0)
+        {
+            auto batchDuration = Time::getMillisecondCounterHiRes() - batchStartTime;
+
+            statistics.numCallbacks += numCalled;
+            ++statistics.numBatches;
+            statistics.totalCallbackTimeMs += batchDuration;
+            statistics.maxBatchTimeMs = jmax (statistics.maxBatchTimeMs, batchDuration);
+            notify();
+        }
+
         callbackArrived.signal();
     }
 
@@ -130,14 +145,12 @@ public:
 
         // Trying to add a timer that's already here - shouldn't get to this point,
         // so if you get this assertion, let me know!
-        jassert (std::none_of (timers.begin(), timers.end(),
-                               [t] (TimerCountdown i) { return i.timer == t; }));
-
-        auto pos = timers.size();
+        jassert (t->slotIndex < 0);
 
-        timers.push_back ({ t, t->timerPeriodMs });
-        t->positionInQueue = pos;
-        shuffleTimerForwardInQueue (pos);
+        advance();
+        t->dueTime = currentTime + t->timerPeriodMs;
+        insert (t);
+        ++numTimers;
         notify();
     }
 
@@ -145,56 +158,65 @@ public:
     {
         const LockType::ScopedLockType sl (lock);
 
-        auto pos = t->positionInQueue;
-        auto lastIndex = timers.size() - 1;
-
-        jassert (pos <= lastIndex);
-        jassert (timers[pos].timer == t);
-
-        for (auto i = pos; i < lastIndex; ++i)
-        {
-            timers[i] = timers[i + 1];
-            timers[i].timer->positionInQueue = i;
-        }
+        jassert (t->slotIndex >= 0);
 
-        timers.pop_back();
+        unlink (t);
+        --numTimers;
     }
 
     void resetTimerCounter (Timer* t) noexcept
     {
         const LockType::ScopedLockType sl (lock);
 
-        auto pos = t->positionInQueue;
-
-        jassert (pos < timers.size());
-        jassert (timers[pos].timer == t);
+        jassert (t->slotIndex >= 0);
 
-        auto lastCountdown = timers[pos].countdownMs;
-        auto newCountdown = t->timerPeriodMs;
+        advance();
+        auto newDueTime = currentTime + t->timerPeriodMs;
 
-        if (newCountdown != lastCountdown)
+        if (newDueTime != t->dueTime)
         {
-            timers[pos].countdownMs = newCountdown;
-
-            if (newCountdown > lastCountdown)
-                shuffleTimerBackInQueue (pos);
-            else
-                shuffleTimerForwardInQueue (pos);
-
+            unlink (t);
+            t->dueTime = newDueTime;
+            insert (t);
             notify();
         }
     }
 
+    Timer::TimerStatistics getTimerStatistics()
+    {
+        const LockType::ScopedLockType sl (lock);
+
+        auto result = statistics;
+        result.numRunningTimers = numTimers;
+        return result;
+    }
+
+    void resetTimerStatistics()
+    {
+        const LockType::ScopedLockType sl (lock);
+        statistics = {};
+    }
+
 private:
-    LockType lock;
+    //==============================================================================
+    static constexpr int numLevels = 4, slotBits = 6, slotsPerLevel = 1 << slotBits;
+    static constexpr int64 slotMask = slotsPerLevel - 1, maxDelay = ((int64) 1 << (numLevels * slotBits)) - 1;
+    static constexpr int dueSlot = numLevels * slotsPerLevel;
 
-    struct TimerCountdown
+    struct Slot
     {
-        Timer* timer;
-        int countdownMs;
+        Timer* first = nullptr;
+        Timer* last = nullptr;
     };
 
-    std::vector<TimerCountdown> timers;
+    LockType lock;
+
+    // slots[dueSlot] holds the timers whose callbacks are due
+    std::array<Slot, (size_t) dueSlot + 1> slots;
+    int64 currentTime = 0, wheelTime = 0;
+    uint32 lastMillisecondCounter = Time::getMillisecondCounter();
+    int numTimers = 0, numTimersInWheel = 0;
+    Timer::TimerStatistics statistics;
 
     WaitableEvent callbackArrived;
 
@@ -210,67 +232,142 @@ private:
     };
 
     //==============================================================================
-    void shuffleTimerBackInQueue (size_t pos)
+    void append (int slotIndex, Timer* t) noexcept
     {
-        auto numTimers = timers.size();
+        auto& slot = slots[(size_t) slotIndex];
 
-        if (pos < numTimers - 1)
-        {
-            auto t = timers[pos];
+        t->slotIndex = slotIndex;
+        t->previousInSlot = slot.last;
+        t->nextInSlot = nullptr;
 
-            for (;;)
-            {
-                auto next = pos + 1;
+        if (slot.last != nullptr)
+            slot.last->nextInSlot = t;
+        else
+            slot.first = t;
 
-                if (next == numTimers || timers[next].countdownMs >= t.countdownMs)
-                    break;
+        slot.last = t;
 
-                timers[pos] = timers[next];
-                timers[pos].timer->positionInQueue = pos;
+        if (slotIndex != dueSlot)
+            ++numTimersInWheel;
+    }
 
-                ++pos;
-            }
+    void unlink (Timer* t) noexcept
+    {
+        auto& slot = slots[(size_t) t->slotIndex];
+
+        if (t->previousInSlot != nullptr)
+            t->previousInSlot->nextInSlot = t->nextInSlot;
+        else
+            slot.first = t->nextInSlot;
+
+        if (t->nextInSlot != nullptr)
+            t->nextInSlot->previousInSlot = t->previousInSlot;
+        else
+            slot.last = t->previousInSlot;
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
+        if (t->slotIndex != dueSlot)
+            --numTimersInWheel;
+
+        t->slotIndex = -1;
+        t->previousInSlot = nullptr;
+        t->nextInSlot = nullptr;
+    }
+
+    void insert (Timer* t) noexcept
+    {
+        auto delay = t->dueTime - wheelTime;
+
+        if (delay < 0)
+        {
+            append (dueSlot, t);
+            return;
         }
+
+        // Timers that are further away than the wheel can hold go into the last slot
+        // that it can reach, and get placed again when that slot comes round
+        auto slotTime = wheelTime + jmin (delay, maxDelay);
+        int level = 0;
+
+        while (level < numLevels - 1 && delay >= ((int64) 1 << ((level + 1) * slotBits)))
+            ++level;
+
+        append (level * slotsPerLevel + (int) ((slotTime >> (level * slotBits)) & slotMask), t);
     }
 
-    void shuffleTimerForwardInQueue (size_t pos)
+    // Re-inserts the timers from a slot of a higher level, which will put them in lower levels
+    int cascade (int level) noexcept
     {
-        if (pos > 0)
+        auto index = (int) ((wheelTime >> (level * slotBits)) & slotMask);
+        auto& slot = slots[(size_t) (level * slotsPerLevel + index)];
+
+        while (auto* t = slot.first)
         {
-            auto t = timers[pos];
+            unlink (t);
+            insert (t);
+        }
+
+        return index;
+    }
+
+    // Moves the wheel on to the current time, moving any timers that have become due onto the due list
+    void advance() noexcept
+    {
+        auto now = Time::getMillisecondCounter();
+        currentTime += (int64) (now >= lastMillisecondCounter ? (now - lastMillisecondCounter)
+                                                              : (std::numeric_limits<uint32>::max() - (lastMillisecondCounter - now)));
+        lastMillisecondCounter = now;
 
-            while (pos > 0)
+        while (wheelTime <= currentTime)
+        {
+            if (numTimersInWheel == 0)
             {
-                auto& prev = timers[(size_t) pos - 1];
+                wheelTime = currentTime + 1;
+                break;
+            }
 
-                if (prev.countdownMs <= t.countdownMs)
-                    break;
+            auto index = (int) (wheelTime & slotMask);
 
-                timers[pos] = prev;
-                timers[pos].timer->positionInQueue = pos;
+            if (index == 0)
+                for (int level = 1; level < numLevels && cascade (level) == 0; ++level)
+                {}
 
-                --pos;
+            while (auto* t = slots[(size_t) index].first)
+            {
+                unlink (t);
+                append (dueSlot, t);
             }
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
+            ++wheelTime;
         }
     }
 
-    int getTimeUntilFirstTimer (int numMillisecsElapsed)
+    int getTimeUntilFirstTimer()
     {
         const LockType::ScopedLockType sl (lock);
 
-        if (timers.empty())
+        advance();
+
+        if (slots[dueSlot].first != nullptr)
+            return 0;
+
+        if (numTimersInWheel == 0)
             return 1000;
 
-        for (auto& t : timers)
-            t.countdownMs -= numMillisecsElapsed;
+        // Look for the next occupied slot in level 0, or wake up when the higher levels
+        // next need to be cascaded
+        auto index = (int) (wheelTime & slotMask);
+        int64 nextTime = wheelTime + (slotsPerLevel - index);
+
+        for (auto i = index; i < slotsPerLevel; ++i)
+        {
+            if (slots[(size_t) i].first != nullptr)
+            {
+                nextTime = wheelTime + (i - index);
+                break;
+            }
+        }
 
-        return timers.front().countdownMs;
+        return (int) (nextTime - currentTime);
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimerThread)
@@ -331,6 +428,20 @@ void JUCE_CALLTYPE Timer::callPendingTimersSynchronously()
         (*instance)->callTimersSynchronously();
 }
 
+Timer::TimerStatistics JUCE_CALLTYPE Timer::getTimerStatistics()
+{
+    if (auto instance = SharedResourcePointer<TimerThread>::getSharedObjectWithoutCreating())
+        return (*instance)->getTimerStatistics();
+
+    return {};
+}
+
+void JUCE_CALLTYPE Timer::resetTimerStatistics()
+{
+    if (auto instance = SharedResourcePointer<TimerThread>::getSharedObjectWithoutCreating())
+        (*instance)->resetTimerStatistics();
+}
+
 struct LambdaInvoker final : private Timer,
                              private DeletedAtShutdown
 {
@@ -361,4 +472,196 @@ void JUCE_CALLTYPE Timer::callAfterDelay (int milliseconds, std::function<void()
     new LambdaInvoker (milliseconds, std::move (f));
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+/*  These tests call the timers synchronously rather than running a dispatch loop, so they
+    need to be run on the message thread, and nothing else should be dispatching messages.
+*/
+class TimerTests final : public UnitTest
+{
+public:
+    TimerTests()  : UnitTest ("Timer", UnitTestCategories::time) {}
+
+    void runTest() override
+    {
+        beginTest ("Timers whose intervals cross the levels of the wheel fire on time");
+        {
+            std::vector<std::unique_ptr<TestTimer>> timers;
+
+            for (auto interval : { 1, 10, 63, 64, 65, 200, 4095, 4096, 4200 })
+                timers.push_back (std::make_unique<TestTimer> (interval));
+
+            const auto startTime = Time::getMillisecondCounterHiRes();
+
+            for (auto& timer : timers)
+                timer->startTimer (timer->interval);
+
+            callTimersUntil ([&] { return std::all_of (timers.begin(), timers.end(), [] (auto& t) { return ! t->callbackTimes.empty(); }); },
+                             6000);
+
+            for (auto& timer : timers)
+            {
+                timer->stopTimer();
+
+                expect (! timer->callbackTimes.empty(), "Timer with an interval of " + String (timer->interval) + " wasn't called");
+
+                if (timer->callbackTimes.empty())
+                    continue;
+
+                const auto elapsed = timer->callbackTimes.front() - startTime;
+
+                // The millisecond counter may tick just after the start time was measured
+                expectGreaterOrEqual (elapsed, (double) timer->interval - 1.0);
+                expectLessOrEqual (elapsed, (double) timer->interval + latenessTolerance);
+            }
+        }
+
+        beginTest ("Timers that are already due can be stopped and restarted");
+        {
+            TestTimer first (10), second (10), third (10);
+
+            first.startTimer (10);
+            second.startTimer (10);
+            third.startTimer (10);
+
+            // Stopping the second timer from inside the first one's callback, or before the
+            // callbacks are made, mustn't leave it on the list of timers that are due
+            first.onCallback = [&] { second.stopTimer(); };
+
+            Thread::sleep (30);
+            third.stopTimer();
+            Timer::callPendingTimersSynchronously();
+
+            expectEquals ((int) first.callbackTimes.size(), 1);
+            expect (second.callbackTimes.empty());
+            expect (third.callbackTimes.empty());
+            first.stopTimer();
+
+            // Restarting a timer that's due puts it back to the start of its interval
+            third.startTimer (10);
+            Thread::sleep (30);
+            const auto restartTime = Time::getMillisecondCounterHiRes();
+            third.startTimer (100);
+            Timer::callPendingTimersSynchronously();
+            expect (third.callbackTimes.empty());
+
+            callTimersUntil ([&] { return ! third.callbackTimes.empty(); }, 1000);
+            third.stopTimer();
+
+            expectEquals ((int) third.callbackTimes.size(), 1);
+
+            if (! third.callbackTimes.empty())
+                expectGreaterOrEqual (third.callbackTimes.front() - restartTime, 99.0);
+        }
+
+        beginTest ("The interval can be changed from inside a timer callback");
+        {
+            TestTimer timer (10);
+            timer.onCallback = [&]
+            {
+                if (timer.callbackTimes.size() == 1)
+                    timer.startTimer (150);
+                else if (timer.callbackTimes.size() == 3)
+                    timer.stopTimer();
+            };
+
+            timer.startTimer (10);
+            callTimersUntil ([&] { return ! timer.isTimerRunning(); }, 2000);
+
+            expectEquals ((int) timer.callbackTimes.size(), 3);
+
+            if (timer.callbackTimes.size() == 3)
+            {
+                for (size_t i = 1; i < 3; ++i)
+                {
+                    const auto gap = timer.callbackTimes[i] - timer.callbackTimes[i - 1];
+                    expectGreaterOrEqual (gap, 149.0);
+                    expectLessOrEqual (gap, 150.0 + latenessTolerance);
+                }
+            }
+
+            // No more callbacks are made once a timer has stopped itself
+            callTimersUntil ([] { return false; }, 50);
+            expectEquals ((int) timer.callbackTimes.size(), 3);
+        }
+
+        beginTest ("Timer statistics count the callbacks");
+        {
+            const auto numRunningBefore = Timer::getTimerStatistics().numRunningTimers;
+
+            TestTimer first (20), second (20), slow (20);
+            slow.onCallback = [] { Thread::sleep (10); };
+
+            for (auto* timer : { &first, &second, &slow })
+                timer->startTimer (timer->interval);
+
+            expectEquals (Timer::getTimerStatistics().numRunningTimers, numRunningBefore + 3);
+
+            Timer::resetTimerStatistics();
+
+            {
+                const auto stats = Timer::getTimerStatistics();
+                expectEquals (stats.numCallbacks, (int64) 0);
+                expectEquals (stats.numBatches, (int64) 0);
+                expectEquals (stats.maxLatenessMs, 0);
+            }
+
+            callTimersUntil ([&] { return slow.callbackTimes.size() >= 3 && first.callbackTimes.size() >= 3 && second.callbackTimes.size() >= 3; },
+                             2000);
+
+            for (auto* timer : { &first, &second, &slow })
+                timer->stopTimer();
+
+            const auto numCalled = (int64) (first.callbackTimes.size() + second.callbackTimes.size() + slow.callbackTimes.size());
+            const auto stats = Timer::getTimerStatistics();
+
+            expectEquals (stats.numRunningTimers, numRunningBefore);
+            // (Any other timers in the process could only have been called by callTimersUntil() too)
+            expectGreaterOrEqual (stats.numCallbacks, numCalled);
+            expectGreaterThan (stats.numBatches, (int64) 0);
+            expectLessOrEqual (stats.numBatches, stats.numCallbacks);
+            expectGreaterOrEqual (stats.maxBatchTimeMs, 9.0);
+            expectGreaterOrEqual (stats.totalCallbackTimeMs, stats.maxBatchTimeMs);
+            expectGreaterOrEqual (stats.maxLatenessMs, 0);
+        }
+    }
+
+private:
+    static constexpr double latenessTolerance = 50.0;
+
+    struct TestTimer final : public Timer
+    {
+        explicit TestTimer (int intervalToUse)  : interval (intervalToUse) {}
+        ~TestTimer() override  { stopTimer(); }
+
+        void timerCallback() override
+        {
+            callbackTimes.push_back (Time::getMillisecondCounterHiRes());
+            NullCheckedInvocation::invoke (onCallback);
+        }
+
+        const int interval;
+        std::vector<double> callbackTimes;
+        std::function<void()> onCallback;
+    };
+
+    template <typename Predicate>
+    static void callTimersUntil (Predicate&& done, int timeoutMs)
+    {
+        const auto endTime = Time::getMillisecondCounter() + (uint32) timeoutMs;
+
+        while (! done() && Time::getMillisecondCounter() < endTime)
+        {
+            Timer::callPendingTimersSynchronously();
+            Thread::sleep (1);
+        }
+    }
+};
+
+static TimerTests timerTests;
+
+#endif
+
 } // namespace juce
@@ -125,9 +125,44 @@ public:
     */
     static void JUCE_CALLTYPE callPendingTimersSynchronously();
 
+    //==============================================================================
+    /** Some measurements of the load that the running timers put on the message thread. */
+    struct TimerStatistics
+    {
+        /** The number of timers that are currently running. */
+        int numRunningTimers = 0;
+
+        /** The number of timer callbacks that have been made. */
+        int64 numCallbacks = 0;
+
+        /** The number of messages that have been used to make the callbacks. All of the
+            timers that are due at the same time are called by a single message.
+        */
+        int64 numBatches = 0;
+
+        /** The total time spent in timer callbacks, and the longest time spent
+            handling a single message, in milliseconds.
+        */
+        double totalCallbackTimeMs = 0.0, maxBatchTimeMs = 0.0;
+
+        /** The longest time that a callback has been made after it was due, in milliseconds. */
+        int maxLatenessMs = 0;
+    };
+
+    /** Returns some measurements of the timers, gathered since the first timer was
+        started or resetTimerStatistics() was last called.
+    */
+    static TimerStatistics JUCE_CALLTYPE getTimerStatistics();
+
+    /** Resets the counts and times returned by getTimerStatistics(). */
+    static void JUCE_CALLTYPE resetTimerStatistics();
+
 private:
     class TimerThread;
-    size_t positionInQueue = (size_t) -1;
+    Timer* previousInSlot = nullptr;
+    Timer* nextInSlot = nullptr;
+    int64 dueTime = 0;
+    int slotIndex = -1;
     int timerPeriodMs = 0;
     SharedResourcePointer<TimerThread> timerThread;
 
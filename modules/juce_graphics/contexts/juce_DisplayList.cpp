@@ -0,0 +1,472 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct DisplayList::Operation
+{
+    struct SaveState                { void perform (LowLevelGraphicsContext& c) const { c.saveState(); } };
+    struct RestoreState             { void perform (LowLevelGraphicsContext& c) const { c.restoreState(); } };
+    struct EndTransparencyLayer     { void perform (LowLevelGraphicsContext& c) const { c.endTransparencyLayer(); } };
+    struct FillAll                  { void perform (LowLevelGraphicsContext& c) const { c.fillAll(); } };
+
+    struct BeginTransparencyLayer   { float opacity;                        void perform (LowLevelGraphicsContext& c) const { c.beginTransparencyLayer (opacity); } };
+    struct SetOrigin                { Point<int> origin;                    void perform (LowLevelGraphicsContext& c) const { c.setOrigin (origin); } };
+    struct AddTransform             { AffineTransform transform;            void perform (LowLevelGraphicsContext& c) const { c.addTransform (transform); } };
+    struct ClipToRectangle          { Rectangle<int> area;                  void perform (LowLevelGraphicsContext& c) const { c.clipToRectangle (area); } };
+    struct ClipToRectangleList      { RectangleList<int> area;              void perform (LowLevelGraphicsContext& c) const { c.clipToRectangleList (area); } };
+    struct ExcludeClipRectangle     { Rectangle<int> area;                  void perform (LowLevelGraphicsContext& c) const { c.excludeClipRectangle (area); } };
+    struct ClipToPath               { Path path; AffineTransform transform; void perform (LowLevelGraphicsContext& c) const { c.clipToPath (path, transform); } };
+    struct ClipToImageAlpha         { Image image; AffineTransform transform; void perform (LowLevelGraphicsContext& c) const { c.clipToImageAlpha (image, transform); } };
+    struct SetFill                  { FillType fill;                        void perform (LowLevelGraphicsContext& c) const { c.setFill (fill); } };
+    struct SetOpacity               { float opacity;                        void perform (LowLevelGraphicsContext& c) const { c.setOpacity (opacity); } };
+    struct SetInterpolationQuality  { Graphics::ResamplingQuality quality;  void perform (LowLevelGraphicsContext& c) const { c.setInterpolationQuality (quality); } };
+    struct FillIntRect              { Rectangle<int> area; bool replace;    void perform (LowLevelGraphicsContext& c) const { c.fillRect (area, replace); } };
+    struct FillRect                 { Rectangle<float> area;                void perform (LowLevelGraphicsContext& c) const { c.fillRect (area); } };
+    struct FillRectList             { RectangleList<float> area;            void perform (LowLevelGraphicsContext& c) const { c.fillRectList (area); } };
+    struct FillPath                 { Path path; AffineTransform transform; void perform (LowLevelGraphicsContext& c) const { c.fillPath (path, transform); } };
+    struct DrawImage                { Image image; AffineTransform transform; void perform (LowLevelGraphicsContext& c) const { c.drawImage (image, transform); } };
+    struct DrawLine                 { Line<float> line;                     void perform (LowLevelGraphicsContext& c) const { c.drawLine (line); } };
+    struct SetFont                  { Font font;                            void perform (LowLevelGraphicsContext& c) const { c.setFont (font); } };
+    struct DrawGlyph                { int glyphNumber; AffineTransform transform; void perform (LowLevelGraphicsContext& c) const { c.drawGlyph (glyphNumber, transform); } };
+
+    std::variant<SaveState, RestoreState, BeginTransparencyLayer, EndTransparencyLayer,
+                 SetOrigin, AddTransform, ClipToRectangle, ClipToRectangleList, ExcludeClipRectangle,
+                 ClipToPath, ClipToImageAlpha, SetFill, SetOpacity, SetInterpolationQuality,
+                 FillAll, FillIntRect, FillRect, FillRectList, FillPath, DrawImage, DrawLine,
+                 SetFont, DrawGlyph> value;
+};
+
+//==============================================================================
+DisplayList::DisplayList() = default;
+DisplayList::~DisplayList() = default;
+
+DisplayList::DisplayList (DisplayList&&) noexcept = default;
+DisplayList& DisplayList::operator= (DisplayList&&) noexcept = default;
+
+void DisplayList::clear() noexcept              { operations.clear(); }
+bool DisplayList::isEmpty() const noexcept      { return operations.empty(); }
+int DisplayList::getNumOperations() const noexcept { return (int) operations.size(); }
+
+void DisplayList::replay (LowLevelGraphicsContext& target) const
+{
+    if (operations.empty())
+        return;
+
+    target.saveState();
+
+    for (auto& op : operations)
+        std::visit ([&target] (const auto& o) { o.perform (target); }, op.value);
+
+    target.restoreState();
+}
+
+//==============================================================================
+DisplayList::Recorder::Recorder (DisplayList& listToAppendTo, Rectangle<int> clipBounds, float physicalPixelScaleFactor)
+    : list (listToAppendTo), scaleFactor (physicalPixelScaleFactor)
+{
+    stack.push_back ({});
+    getState().clip = clipBounds;
+}
+
+DisplayList::Recorder::~Recorder()
+{
+    // Close anything left open, so that the list always leaves a target as it found it
+    while (stack.size() > 1)
+        popState (getState().isTransparencyLayer);
+}
+
+bool DisplayList::Recorder::isVectorDevice() const                  { return false; }
+
+float DisplayList::Recorder::getPhysicalPixelScaleFactor()
+{
+    const auto& t = getState().transform;
+    return scaleFactor * (t.isOnlyTranslation() ? 1.0f : std::sqrt (std::abs (t.getDeterminant())));
+}
+
+void DisplayList::Recorder::setOrigin (Point<int> o)
+{
+    getState().transform = AffineTransform::translation (o).followedBy (getState().transform);
+    list.operations.push_back ({ Operation::SetOrigin { o } });
+}
+
+void DisplayList::Recorder::addTransform (const AffineTransform& t)
+{
+    getState().transform = t.followedBy (getState().transform);
+    list.operations.push_back ({ Operation::AddTransform { t } });
+}
+
+//==============================================================================
+void DisplayList::Recorder::intersectClip (Rectangle<float> areaInUserSpace, const AffineTransform& extraTransform)
+{
+    auto& s = getState();
+    s.clip = s.clip.getIntersection (areaInUserSpace.transformedBy (extraTransform.followedBy (s.transform))
+                                                    .getSmallestIntegerContainer());
+}
+
+bool DisplayList::Recorder::clipToRectangle (const Rectangle<int>& r)
+{
+    intersectClip (r.toFloat());
+    list.operations.push_back ({ Operation::ClipToRectangle { r } });
+    return ! isClipEmpty();
+}
+
+bool DisplayList::Recorder::clipToRectangleList (const RectangleList<int>& r)
+{
+    intersectClip (r.getBounds().toFloat());
+    list.operations.push_back ({ Operation::ClipToRectangleList { r } });
+    return ! isClipEmpty();
+}
+
+void DisplayList::Recorder::excludeClipRectangle (const Rectangle<int>& r)
+{
+    // The tracked clip is a bounding box, so it can only shrink if the whole of it is excluded
+    auto& s = getState();
+
+    if (s.transform.isOnlyTranslation() && r.toFloat().transformedBy (s.transform).contains (s.clip.toFloat()))
+        s.clip = {};
+
+    list.operations.push_back ({ Operation::ExcludeClipRectangle { r } });
+}
+
+void DisplayList::Recorder::clipToPath (const Path& path, const AffineTransform& t)
+{
+    intersectClip (path.getBounds(), t);
+    list.operations.push_back ({ Operation::ClipToPath { path, t } });
+}
+
+void DisplayList::Recorder::clipToImageAlpha (const Image& image, const AffineTransform& t)
+{
+    intersectClip (image.getBounds().toFloat(), t);
+    list.operations.push_back ({ Operation::ClipToImageAlpha { image, t } });
+}
+
+bool DisplayList::Recorder::clipRegionIntersects (const Rectangle<int>& r)
+{
+    auto& s = getState();
+    return r.toFloat().transformedBy (s.transform).getSmallestIntegerContainer().intersects (s.clip);
+}
+
+Rectangle<int> DisplayList::Recorder::getClipBounds() const
+{
+    auto& s = getState();
+    return s.clip.toFloat().transformedBy (s.transform.inverted()).getSmallestIntegerContainer();
+}
+
+bool DisplayList::Recorder::isClipEmpty() const
+{
+    return getState().clip.isEmpty();
+}
+
+//==============================================================================
+void DisplayList::Recorder::pushState (bool isTransparencyLayer)
+{
+    auto copy = getState();
+    copy.isTransparencyLayer = isTransparencyLayer;
+    stack.push_back (std::move (copy));
+}
+
+bool DisplayList::Recorder::popState (bool isTransparencyLayer)
+{
+    if (stack.size() <= 1 || getState().isTransparencyLayer != isTransparencyLayer)
+    {
+        jassertfalse; // trying to pop with an empty stack, or a mismatched saveState/beginTransparencyLayer
+        return false;
+    }
+
+    stack.pop_back();
+
+    if (isTransparencyLayer)
+        list.operations.push_back ({ Operation::EndTransparencyLayer{} });
+    else
+        list.operations.push_back ({ Operation::RestoreState{} });
+
+    return true;
+}
+
+void DisplayList::Recorder::saveState()
+{
+    pushState (false);
+    list.operations.push_back ({ Operation::SaveState{} });
+}
+
+void DisplayList::Recorder::restoreState()
+{
+    popState (false);
+}
+
+void DisplayList::Recorder::beginTransparencyLayer (float opacity)
+{
+    pushState (true);
+    list.operations.push_back ({ Operation::BeginTransparencyLayer { opacity } });
+}
+
+void DisplayList::Recorder::endTransparencyLayer()
+{
+    popState (true);
+}
+
+//==============================================================================
+void DisplayList::Recorder::setFill (const FillType& fill)
+{
+    list.operations.push_back ({ Operation::SetFill { fill } });
+}
+
+void DisplayList::Recorder::setOpacity (float opacity)
+{
+    list.operations.push_back ({ Operation::SetOpacity { opacity } });
+}
+
+void DisplayList::Recorder::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    list.operations.push_back ({ Operation::SetInterpolationQuality { quality } });
+}
+
+//==============================================================================
+void DisplayList::Recorder::fillAll()
+{
+    if (! isClipEmpty())
+        list.operations.push_back ({ Operation::FillAll{} });
+}
+
+void DisplayList::Recorder::fillRect (const Rectangle<int>& r, bool replaceExistingContents)
+{
+    if (clipRegionIntersects (r))
+        list.operations.push_back ({ Operation::FillIntRect { r, replaceExistingContents } });
+}
+
+void DisplayList::Recorder::fillRect (const Rectangle<float>& r)
+{
+    if (clipRegionIntersects (r.getSmallestIntegerContainer()))
+        list.operations.push_back ({ Operation::FillRect { r } });
+}
+
+void DisplayList::Recorder::fillRectList (const RectangleList<float>& r)
+{
+    if (clipRegionIntersects (r.getBounds().getSmallestIntegerContainer()))
+        list.operations.push_back ({ Operation::FillRectList { r } });
+}
+
+void DisplayList::Recorder::fillPath (const Path& path, const AffineTransform& t)
+{
+    if (! isClipEmpty())
+        list.operations.push_back ({ Operation::FillPath { path, t } });
+}
+
+void DisplayList::Recorder::drawImage (const Image& image, const AffineTransform& t)
+{
+    if (! isClipEmpty())
+        list.operations.push_back ({ Operation::DrawImage { image, t } });
+}
+
+void DisplayList::Recorder::drawLine (const Line<float>& line)
+{
+    if (! isClipEmpty())
+        list.operations.push_back ({ Operation::DrawLine { line } });
+}
+
+//==============================================================================
+void DisplayList::Recorder::setFont (const Font& newFont)
+{
+    auto& s = getState();
+    s.font = newFont;
+    s.fontIsRecorded = true;
+    list.operations.push_back ({ Operation::SetFont { newFont } });
+}
+
+const Font& DisplayList::Recorder::getFont()
+{
+    return getState().font;
+}
+
+void DisplayList::Recorder::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    if (isClipEmpty())
+        return;
+
+    auto& s = getState();
+
+    // The glyph number only makes sense for the font that was current when it was recorded,
+    // which might not be the target's font when the list is replayed
+    if (! s.fontIsRecorded)
+    {
+        list.operations.push_back ({ Operation::SetFont { s.font } });
+        s.fontIsRecorded = true;
+    }
+
+    list.operations.push_back ({ Operation::DrawGlyph { glyphNumber, t } });
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class DisplayListTests  : public UnitTest
+{
+public:
+    DisplayListTests()
+        : UnitTest ("DisplayList", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Replaying a list matches drawing directly");
+        {
+            for (auto origin : { Point<int>(), Point<int> (13, -7) })
+            {
+                const auto direct = render ([&] (Graphics& g) { g.setOrigin (origin); drawScene (g); });
+
+                DisplayList list;
+
+                {
+                    DisplayList::Recorder recorder (list, { 200, 150 });
+                    Graphics g (recorder);
+                    drawScene (g);
+                }
+
+                expect (! list.isEmpty());
+
+                const auto replayed = render ([&] (Graphics& g) { g.setOrigin (origin); list.replay (g.getInternalContext()); });
+                expect (imagesAreEqual (direct, replayed));
+            }
+        }
+
+        beginTest ("The recorder tracks the transform and clip bounds");
+        {
+            DisplayList list;
+            DisplayList::Recorder recorder (list, { 100, 100 });
+
+            recorder.setOrigin ({ 10, 20 });
+            expect (recorder.getClipBounds() == Rectangle<int> (-10, -20, 100, 100));
+
+            recorder.saveState();
+            expect (recorder.clipToRectangle ({ 5, 5, 20, 20 }));
+            expect (recorder.getClipBounds() == Rectangle<int> (5, 5, 20, 20));
+            expect (! recorder.clipRegionIntersects ({ 30, 0, 10, 10 }));
+
+            recorder.excludeClipRectangle ({ 0, 0, 50, 50 });
+            expect (recorder.isClipEmpty());
+
+            recorder.restoreState();
+            expect (! recorder.isClipEmpty());
+
+            recorder.addTransform (AffineTransform::scale (2.0f));
+            expectEquals (recorder.getPhysicalPixelScaleFactor(), 2.0f);
+            expect (recorder.getClipBounds() == Rectangle<int> (-5, -10, 50, 50));
+        }
+
+        beginTest ("Drawing outside the clip region isn't recorded");
+        {
+            DisplayList list;
+            DisplayList::Recorder recorder (list, { 100, 100 });
+
+            recorder.setFill (Colours::red);
+            const auto numOperations = list.getNumOperations();
+
+            recorder.fillRect (Rectangle<int> (150, 0, 10, 10), false);
+            recorder.fillRect (Rectangle<float> (0.0f, -20.0f, 10.0f, 10.0f));
+            expectEquals (list.getNumOperations(), numOperations);
+
+            recorder.fillRect (Rectangle<float> (90.0f, 90.0f, 20.0f, 20.0f));
+            expectEquals (list.getNumOperations(), numOperations + 1);
+        }
+
+        beginTest ("States left open are closed when recording finishes");
+        {
+            DisplayList list;
+
+            {
+                DisplayList::Recorder recorder (list, { 100, 100 });
+                Graphics g (recorder);
+                g.saveState();
+                g.reduceClipRegion (10, 10, 20, 20);
+                g.beginTransparencyLayer (0.5f);
+                g.setOrigin ({ 5, 5 });
+                g.fillAll (Colours::blue);
+            }
+
+            Image image (Image::ARGB, 100, 100, true, SoftwareImageType());
+            Graphics g (image);
+            list.replay (g.getInternalContext());
+
+            expect (g.getClipBounds() == image.getBounds());
+            expect (std::abs ((int) image.getPixelAt (15, 15).getAlpha() - 0x80) <= 1);
+            expect (image.getPixelAt (5, 5).isTransparent());
+        }
+    }
+
+private:
+    static void drawScene (Graphics& g)
+    {
+        g.fillAll (Colours::white);
+
+        g.setGradientFill (ColourGradient (Colours::red, 0.0f, 0.0f, Colours::blue, 200.0f, 150.0f, false));
+        g.fillEllipse (10.0f, 10.0f, 120.0f, 80.0f);
+
+        {
+            Graphics::ScopedSaveState ss (g);
+            g.reduceClipRegion (50, 40, 100, 60);
+            g.addTransform (AffineTransform::rotation (0.3f, 100.0f, 75.0f));
+            g.setColour (Colours::green.withAlpha (0.6f));
+            g.fillRect (60.0f, 50.0f, 80.0f, 30.0f);
+        }
+
+        g.beginTransparencyLayer (0.5f);
+        g.setColour (Colours::black);
+        g.drawLine (0.0f, 150.0f, 200.0f, 0.0f, 3.0f);
+        g.endTransparencyLayer();
+
+        Image image (Image::ARGB, 16, 16, true, SoftwareImageType());
+        image.clear ({ 4, 4, 8, 8 }, Colours::orange);
+        g.setOpacity (0.75f);
+        g.drawImageTransformed (image, AffineTransform::scale (3.0f).translated (140.0f, 90.0f));
+    }
+
+    template <typename DrawFn>
+    static Image render (DrawFn&& draw)
+    {
+        Image image (Image::ARGB, 200, 150, true, SoftwareImageType());
+        Graphics g (image);
+        draw (g);
+        return image;
+    }
+
+    static bool imagesAreEqual (const Image& a, const Image& b)
+    {
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                if (a.getPixelAt (x, y) != b.getPixelAt (x, y))
+                    return false;
+
+        return true;
+    }
+};
+
+static DisplayListTests displayListTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A recorded sequence of drawing operations that can be replayed into any
+    LowLevelGraphicsContext.
+
+    To fill a DisplayList, create a DisplayList::Recorder for it and draw into that
+    with a Graphics object. Replaying the list later performs the same operations on the
+    target context, relative to the target's current origin, transform and clip region,
+    so a list can be drawn in a different place or at a different scale without calling
+    the code that produced it again.
+
+    The list keeps its own copies of any paths, fills and fonts that are used, and a
+    reference to any images that are drawn.
+
+    @code
+    DisplayList list;
+
+    {
+        DisplayList::Recorder recorder (list, { 200, 100 });
+        Graphics g (recorder);
+        g.setColour (Colours::red);
+        g.fillEllipse (10.0f, 10.0f, 50.0f, 50.0f);
+    }
+
+    list.replay (myGraphics.getInternalContext());
+    @endcode
+
+    @see Component::setBufferedToDisplayList
+
+    @tags{Graphics}
+*/
+class JUCE_API  DisplayList
+{
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    DisplayList();
+
+    /** Destructor. */
+    ~DisplayList();
+
+    DisplayList (DisplayList&&) noexcept;
+    DisplayList& operator= (DisplayList&&) noexcept;
+
+    //==============================================================================
+    /** Removes all the recorded operations. */
+    void clear() noexcept;
+
+    /** Returns true if nothing has been recorded. */
+    bool isEmpty() const noexcept;
+
+    /** Returns the number of recorded operations. */
+    int getNumOperations() const noexcept;
+
+    /** Performs all the recorded operations on a context.
+
+        The context's state is saved beforehand and restored afterwards, so this has
+        no lasting effect on its transform, clip region, fill or font.
+    */
+    void replay (LowLevelGraphicsContext& target) const;
+
+    //==============================================================================
+    /**
+        A LowLevelGraphicsContext that appends everything drawn into it to a DisplayList.
+
+        Nothing is rasterised. The recorder keeps track of the transform and an
+        approximation of the clip region, so that drawing code which skips
+        invisible areas by checking Graphics::getClipBounds() or Graphics::clipRegionIntersects()
+        still works. The approximation only ever errs on the side of keeping more, so the
+        replayed result is the same as drawing directly into the target.
+
+        Any states saved or transparency layers begun and not closed are closed when the
+        recorder is deleted.
+
+        @tags{Graphics}
+    */
+    class JUCE_API  Recorder  : public LowLevelGraphicsContext
+    {
+    public:
+        /** Creates a recorder that appends to the given list.
+
+            The clip bounds describe the area that the list will be replayed into, in the
+            recorder's initial coordinate space. The scale factor is the value to return
+            from getPhysicalPixelScaleFactor(), which should be the scale of the context
+            that the list will be replayed into.
+        */
+        Recorder (DisplayList& listToAppendTo, Rectangle<int> clipBounds, float physicalPixelScaleFactor = 1.0f);
+
+        /** Destructor. */
+        ~Recorder() override;
+
+        //==============================================================================
+        bool isVectorDevice() const override;
+        void setOrigin (Point<int>) override;
+        void addTransform (const AffineTransform&) override;
+        float getPhysicalPixelScaleFactor() override;
+
+        bool clipToRectangle (const Rectangle<int>&) override;
+        bool clipToRectangleList (const RectangleList<int>&) override;
+        void excludeClipRectangle (const Rectangle<int>&) override;
+        void clipToPath (const Path&, const AffineTransform&) override;
+        void clipToImageAlpha (const Image&, const AffineTransform&) override;
+
+        bool clipRegionIntersects (const Rectangle<int>&) override;
+        Rectangle<int> getClipBounds() const override;
+        bool isClipEmpty() const override;
+
+        void saveState() override;
+        void restoreState() override;
+
+        void beginTransparencyLayer (float opacity) override;
+        void endTransparencyLayer() override;
+
+        //==============================================================================
+        void setFill (const FillType&) override;
+        void setOpacity (float) override;
+        void setInterpolationQuality (Graphics::ResamplingQuality) override;
+
+        //==============================================================================
+        void fillAll() override;
+        void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+        void fillRect (const Rectangle<float>&) override;
+        void fillRectList (const RectangleList<float>&) override;
+        void fillPath (const Path&, const AffineTransform&) override;
+        void drawImage (const Image&, const AffineTransform&) override;
+        void drawLine (const Line<float>&) override;
+
+        //==============================================================================
+        void setFont (const Font&) override;
+        const Font& getFont() override;
+        void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+    private:
+        //==============================================================================
+        struct State
+        {
+            AffineTransform transform;
+            Rectangle<int> clip;
+            Font font;
+            bool fontIsRecorded = false, isTransparencyLayer = false;
+        };
+
+        DisplayList& list;
+        std::vector<State> stack;
+        const float scaleFactor;
+
+        State& getState() noexcept              { return stack.back(); }
+        const State& getState() const noexcept  { return stack.back(); }
+
+        void intersectClip (Rectangle<float> areaInUserSpace, const AffineTransform& extraTransform = {});
+        void pushState (bool isTransparencyLayer);
+        bool popState (bool isTransparencyLayer);
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Recorder)
+    };
+
+private:
+    //==============================================================================
+    struct Operation;
+    std::vector<Operation> operations;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DisplayList)
+};
+
+} // namespace juce
@@ -26,23 +26,11 @@
 namespace juce
 {
 
-struct GraphicsFontHelpers
-{
-    static auto compareFont (const Font& a, const Font& b) { return Font::compare (a, b); }
-};
-
 static auto operator< (const Font& a, const Font& b)
 {
     return GraphicsFontHelpers::compareFont (a, b);
 }
 
-template <typename T>
-static auto operator< (const Rectangle<T>& a, const Rectangle<T>& b)
-{
-    const auto tie = [] (auto& t) { return std::make_tuple (t.getX(), t.getY(), t.getWidth(), t.getHeight()); };
-    return tie (a) < tie (b);
-}
-
 static auto operator< (const Justification& a, const Justification& b)
 {
     return a.getFlags() < b.getFlags();
@@ -51,81 +39,29 @@ static auto operator< (const Justification& a, const Justification& b)
 //==============================================================================
 namespace
 {
+    /*  Text is laid out at the origin so that the same arrangement can be reused wherever
+        it's drawn, and then moved into place when drawing.
+    */
     struct ConfiguredArrangement
     {
-        void draw (const Graphics& g) const { arrangement.draw (g, transform); }
+        void draw (const Graphics& g, Point<float> position) const
+        {
+            arrangement.draw (g, transform.translated (position));
+        }
 
         GlyphArrangement arrangement;
         AffineTransform transform;
     };
 
-    template <typename ArrangementArgs>
-    class GlyphArrangementCache final : public DeletedAtShutdown
+    template <typename ArrangementArgs, typename ConfigureArrangement>
+    void drawCachedArrangement (const Graphics& g, ArrangementArgs&& args, Point<float> position,
+                                ConfigureArrangement&& configureArrangement)
     {
-    public:
-        GlyphArrangementCache() = default;
-
-        ~GlyphArrangementCache() override
-        {
-            clearSingletonInstance();
-        }
-
-        template <typename ConfigureArrangement>
-        void draw (const Graphics& g, ArrangementArgs&& args, ConfigureArrangement&& configureArrangement)
-        {
-            const ScopedTryLock stl (lock);
-
-            if (! stl.isLocked())
-            {
-                configureArrangement (args).draw (g);
-                return;
-            }
-
-            const auto cached = [&]
-            {
-                const auto iter = cache.find (args);
-
-                if (iter != cache.end())
-                {
-                    if (iter->second.cachePosition != cacheOrder.begin())
-                        cacheOrder.splice (cacheOrder.begin(), cacheOrder, iter->second.cachePosition);
-
-                    return iter;
-                }
-
-                auto result = cache.emplace (std::move (args), CachedGlyphArrangement { configureArrangement (args), {} }).first;
-                cacheOrder.push_front (result);
-                return result;
-            }();
-
-            cached->second.cachePosition = cacheOrder.begin();
-            cached->second.configured.draw (g);
-
-            while (cache.size() > cacheSize)
-            {
-                cache.erase (cacheOrder.back());
-                cacheOrder.pop_back();
-            }
-        }
-
-        JUCE_DECLARE_SINGLETON (GlyphArrangementCache<ArrangementArgs>, false)
-
-    private:
-        struct CachedGlyphArrangement
-        {
-            using CachePtr = typename std::map<ArrangementArgs, CachedGlyphArrangement>::const_iterator;
-            ConfiguredArrangement configured;
-            typename std::list<CachePtr>::const_iterator cachePosition;
-        };
-
-        static constexpr size_t cacheSize = 128;
-        std::map<ArrangementArgs, CachedGlyphArrangement> cache;
-        std::list<typename CachedGlyphArrangement::CachePtr> cacheOrder;
-        CriticalSection lock;
-    };
-
-    template <typename ArrangementArgs>
-    juce::SingletonHolder<GlyphArrangementCache<ArrangementArgs>, juce::CriticalSection, false> GlyphArrangementCache<ArrangementArgs>::singletonHolder;
+        detail::ShapedTextCache<ArrangementArgs, ConfiguredArrangement>::getInstance()
+            ->use (std::move (args),
+                   std::forward<ConfigureArrangement> (configureArrangement),
+                   [&] (const ConfiguredArrangement& configured) { configured.draw (g, position); });
+    }
 
     //==============================================================================
     template <typename Type>
@@ -347,19 +283,19 @@ void Graphics::drawSingleLineText (const String& text, const int startX, const i
 
     struct ArrangementArgs
     {
-        auto tie() const noexcept { return std::tie (font, text, startX, baselineY); }
+        auto tie() const noexcept { return std::tie (font, text, flags); }
         bool operator< (const ArrangementArgs& other) const { return tie() < other.tie(); }
 
         const Font font;
         const String text;
-        const int startX, baselineY, flags;
+        const int flags;
     };
 
     auto configureArrangement = [] (const ArrangementArgs& args)
     {
         AffineTransform transform;
         GlyphArrangement arrangement;
-        arrangement.addLineOfText (args.font, args.text, (float) args.startX, (float) args.baselineY);
+        arrangement.addLineOfText (args.font, args.text, 0.0f, 0.0f);
 
         if (args.flags != Justification::left)
         {
@@ -374,9 +310,8 @@ void Graphics::drawSingleLineText (const String& text, const int startX, const i
         return ConfiguredArrangement { std::move (arrangement), std::move (transform) };
     };
 
-    GlyphArrangementCache<ArrangementArgs>::getInstance()->draw (*this,
-                                                                 { context.getFont(), text, startX, baselineY, flags },
-                                                                 std::move (configureArrangement));
+    drawCachedArrangement (*this, ArrangementArgs { context.getFont(), text, flags },
+                           Point<int> (startX, baselineY).toFloat(), std::move (configureArrangement));
 }
 
 void Graphics::drawMultiLineText (const String& text, const int startX,
@@ -388,12 +323,12 @@ void Graphics::drawMultiLineText (const String& text, const int startX,
 
     struct ArrangementArgs
     {
-        auto tie() const noexcept { return std::tie (font, text, startX, baselineY, maximumLineWidth, justification, leading); }
+        auto tie() const noexcept { return std::tie (font, text, maximumLineWidth, justification, leading); }
         bool operator< (const ArrangementArgs& other) const { return tie() < other.tie(); }
 
         const Font font;
         const String text;
-        const int startX, baselineY, maximumLineWidth;
+        const int maximumLineWidth;
         const Justification justification;
         const float leading;
     };
@@ -401,15 +336,13 @@ void Graphics::drawMultiLineText (const String& text, const int startX,
     auto configureArrangement = [] (const ArrangementArgs& args)
     {
         GlyphArrangement arrangement;
-        arrangement.addJustifiedText (args.font, args.text,
-                                      (float) args.startX, (float) args.baselineY, (float) args.maximumLineWidth,
+        arrangement.addJustifiedText (args.font, args.text, 0.0f, 0.0f, (float) args.maximumLineWidth,
                                       args.justification, args.leading);
         return ConfiguredArrangement { std::move (arrangement), {} };
     };
 
-    GlyphArrangementCache<ArrangementArgs>::getInstance()->draw (*this,
-                                                                 { context.getFont(), text, startX, baselineY, maximumLineWidth, justification, leading },
-                                                                 std::move (configureArrangement));
+    drawCachedArrangement (*this, ArrangementArgs { context.getFont(), text, maximumLineWidth, justification, leading },
+                           Point<int> (startX, baselineY).toFloat(), std::move (configureArrangement));
 }
 
 void Graphics::drawText (const String& text, Rectangle<float> area,
@@ -420,12 +353,12 @@ void Graphics::drawText (const String& text, Rectangle<float> area,
 
     struct ArrangementArgs
     {
-        auto tie() const noexcept { return std::tie (font, text, area, justificationType, useEllipsesIfTooBig); }
+        auto tie() const noexcept { return std::tie (font, text, width, height, justificationType, useEllipsesIfTooBig); }
         bool operator< (const ArrangementArgs& other) const { return tie() < other.tie(); }
 
         const Font font;
         const String text;
-        const Rectangle<float> area;
+        const float width, height;
         const Justification justificationType;
         const bool useEllipsesIfTooBig;
     };
@@ -434,17 +367,16 @@ void Graphics::drawText (const String& text, Rectangle<float> area,
     {
         GlyphArrangement arrangement;
         arrangement.addCurtailedLineOfText (args.font, args.text, 0.0f, 0.0f,
-                                            args.area.getWidth(), args.useEllipsesIfTooBig);
+                                            args.width, args.useEllipsesIfTooBig);
 
         arrangement.justifyGlyphs (0, arrangement.getNumGlyphs(),
-                                   args.area.getX(), args.area.getY(), args.area.getWidth(), args.area.getHeight(),
+                                   0.0f, 0.0f, args.width, args.height,
                                    args.justificationType);
         return ConfiguredArrangement { std::move (arrangement), {} };
     };
 
-    GlyphArrangementCache<ArrangementArgs>::getInstance()->draw (*this,
-                                                                 { context.getFont(), text, area, justificationType, useEllipsesIfTooBig },
-                                                                 std::move (configureArrangement));
+    drawCachedArrangement (*this, ArrangementArgs { context.getFont(), text, area.getWidth(), area.getHeight(), justificationType, useEllipsesIfTooBig },
+                           area.getPosition(), std::move (configureArrangement));
 }
 
 void Graphics::drawText (const String& text, Rectangle<int> area,
@@ -469,12 +401,12 @@ void Graphics::drawFittedText (const String& text, Rectangle<int> area,
 
     struct ArrangementArgs
     {
-        auto tie() const noexcept { return std::tie (font, text, area, justification, maximumNumberOfLines, minimumHorizontalScale); }
+        auto tie() const noexcept { return std::tie (font, text, width, height, justification, maximumNumberOfLines, minimumHorizontalScale); }
         bool operator< (const ArrangementArgs& other) const noexcept { return tie() < other.tie(); }
 
         const Font font;
         const String text;
-        const Rectangle<float> area;
+        const float width, height;
         const Justification justification;
         const int maximumNumberOfLines;
         const float minimumHorizontalScale;
@@ -484,17 +416,16 @@ void Graphics::drawFittedText (const String& text, Rectangle<int> area,
     {
         GlyphArrangement arrangement;
         arrangement.addFittedText (args.font, args.text,
-                                   args.area.getX(), args.area.getY(),
-                                   args.area.getWidth(), args.area.getHeight(),
+                                   0.0f, 0.0f, args.width, args.height,
                                    args.justification,
                                    args.maximumNumberOfLines,
                                    args.minimumHorizontalScale);
         return ConfiguredArrangement { std::move (arrangement), {} };
     };
 
-    GlyphArrangementCache<ArrangementArgs>::getInstance()->draw (*this,
-                                                                 { context.getFont(), text, area.toFloat(), justification, maximumNumberOfLines, minimumHorizontalScale },
-                                                                 std::move (configureArrangement));
+    drawCachedArrangement (*this, ArrangementArgs { context.getFont(), text, (float) area.getWidth(), (float) area.getHeight(),
+                                                    justification, maximumNumberOfLines, minimumHorizontalScale },
+                           area.getPosition().toFloat(), std::move (configureArrangement));
 }
 
 void Graphics::drawFittedText (const String& text, int x, int y, int width, int height,
@@ -573,7 +504,8 @@ void Graphics::strokePath (const Path& path,
                            const AffineTransform& transform) const
 {
     Path stroke;
-    strokeType.createStrokedPath (stroke, path, transform, context.getPhysicalPixelScaleFactor());
+    RenderingHelpers::PathCache::getInstance()->createStrokedPath (stroke, path, strokeType, transform,
+                                                                   context.getPhysicalPixelScaleFactor());
     fillPath (stroke);
 }
 
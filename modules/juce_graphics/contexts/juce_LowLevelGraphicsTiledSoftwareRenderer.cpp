@@ -0,0 +1,655 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  Refers to the pixels of the target image without owning them.
+
+    Each tile gets its own one of these, because creating a writable BitmapData
+    notifies the image's listeners, and that isn't safe to do from several threads
+    at once.
+*/
+class LowLevelGraphicsTiledSoftwareRenderer::TilePixelData final  : public ImagePixelData
+{
+public:
+    explicit TilePixelData (const Image::BitmapData& d)
+        : ImagePixelData (d.pixelFormat, d.width, d.height),
+          data (d)
+    {
+    }
+
+    std::unique_ptr<LowLevelGraphicsContext> createLowLevelContext() override
+    {
+        return std::make_unique<LowLevelGraphicsSoftwareRenderer> (Image (this));
+    }
+
+    void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode) override
+    {
+        const auto offset = (size_t) (x * data.pixelStride + y * data.lineStride);
+        bitmap.data = data.data + offset;
+        bitmap.size = data.size - offset;
+        bitmap.pixelFormat = data.pixelFormat;
+        bitmap.lineStride = data.lineStride;
+        bitmap.pixelStride = data.pixelStride;
+    }
+
+    ImagePixelData::Ptr clone() override
+    {
+        auto newImage = SoftwareImageType().create (pixelFormat, width, height, false);
+        Image::BitmapData dest (Image (newImage), Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+            memcpy (dest.getLinePointer (y), data.getLinePointer (y), (size_t) (width * data.pixelStride));
+
+        return newImage;
+    }
+
+    std::unique_ptr<ImageType> createType() const override      { return std::make_unique<SoftwareImageType>(); }
+
+private:
+    const Image::BitmapData& data;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TilePixelData)
+};
+
+//==============================================================================
+struct TiledSoftwareRendererThreadPool
+{
+    ThreadPool pool { ThreadPoolOptions{}.withThreadName ("Tiled Renderer")
+                                         .withNumberOfThreads (jmax (1, SystemStats::getNumCpus() - 1)) };
+};
+
+//==============================================================================
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto,
+                                                                              Point<int> origin,
+                                                                              const RectangleList<int>& clip,
+                                                                              ThreadPool* threadPool)
+    : image (imageToRenderOnto),
+      initialOrigin (origin),
+      initialClip (clip),
+      pool (threadPool),
+      stateTracker (imageToRenderOnto, origin, clip),
+      transform (AffineTransform::translation (origin))
+{
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto)
+    : LowLevelGraphicsTiledSoftwareRenderer (imageToRenderOnto, {}, imageToRenderOnto.getBounds())
+{
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::~LowLevelGraphicsTiledSoftwareRenderer()
+{
+    flush();
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::flush()
+{
+    const auto hasDrawing = std::any_of (commands.begin(), commands.end(), [] (const auto& c) { return c.rows.has_value(); });
+
+    if (! hasDrawing)
+        return;
+
+    // If the state was saved inside a transparency layer, the layer won't have been
+    // composited yet
+    jassert (layerDepth == 0);
+
+    const auto area = initialClip.getBounds().getIntersection (image.getBounds());
+
+    SharedResourcePointer<TiledSoftwareRendererThreadPool> sharedPool;
+    auto& threads = pool != nullptr ? *pool : sharedPool->pool;
+
+    // Having a few more tiles than threads evens out the work when some tiles are
+    // busier than others
+    constexpr auto minTileHeight = 32;
+    const auto numTiles = jlimit (1, jmax (1, area.getHeight() / minTileHeight), (threads.getNumThreads() + 1) * 2);
+
+    const auto getTileRows = [&] (int index)
+    {
+        return Range<int> (area.getY() + area.getHeight() * index / numTiles,
+                           area.getY() + area.getHeight() * (index + 1) / numTiles);
+    };
+
+    if (numTiles == 1)
+    {
+        renderTile (image, getTileRows (0));
+    }
+    else
+    {
+        // Make sure that the glyph cache exists before several threads try to use it
+        RenderingHelpers::SoftwareRendererSavedState::GlyphCacheType::getInstance();
+
+        const Image::BitmapData data (image, Image::BitmapData::readWrite);
+
+        std::vector<Image> tileImages;
+        tileImages.reserve ((size_t) numTiles);
+
+        for (int i = 0; i < numTiles; ++i)
+            tileImages.emplace_back (new TilePixelData (data));
+
+        std::atomic<int> nextTile { 0 };
+
+        const auto renderTiles = [&]
+        {
+            for (int i; (i = nextTile.fetch_add (1)) < numTiles;)
+                renderTile (tileImages[(size_t) i], getTileRows (i));
+        };
+
+        const auto numHelpers = jmin (threads.getNumThreads(), numTiles - 1);
+        std::atomic<int> numHelpersRunning { numHelpers };
+        WaitableEvent helpersFinished;
+
+        for (int i = 0; i < numHelpers; ++i)
+        {
+            threads.addJob ([&]
+            {
+                renderTiles();
+
+                if (numHelpersRunning.fetch_sub (1) == 1)
+                    helpersFinished.signal();
+            });
+        }
+
+        renderTiles();
+
+        if (numHelpers > 0)
+            helpersFinished.wait();
+    }
+
+    // The state changes are kept, so that anything drawn later is rendered in the
+    // same state
+    commands.erase (std::remove_if (commands.begin(), commands.end(), [] (const auto& c) { return c.rows.has_value(); }),
+                    commands.end());
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::renderTile (const Image& target, Range<int> rows) const
+{
+    auto clip = initialClip;
+    clip.clipTo (Rectangle<int> (image.getWidth(), rows.getLength()).withY (rows.getStart()));
+
+    if (clip.isEmpty())
+        return;
+
+    LowLevelGraphicsSoftwareRenderer renderer (target, initialOrigin, clip);
+
+    for (auto& command : commands)
+        if (! command.rows.has_value() || command.rows->intersects (rows))
+            command.perform (renderer);
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::addStateChange (std::function<void (LowLevelGraphicsContext&)> fn)
+{
+    fn (stateTracker);
+    commands.push_back ({ std::move (fn), std::nullopt });
+}
+
+Range<int> LowLevelGraphicsTiledSoftwareRenderer::getClipRows() const
+{
+    if (stateTracker.isClipEmpty())
+        return {};
+
+    const auto bounds = stateTracker.getClipBounds().toFloat().transformedBy (transform);
+    return { (int) std::floor (bounds.getY()) - 1, (int) std::ceil (bounds.getBottom()) + 1 };
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addDrawing (Range<int> rows, std::function<void (LowLevelGraphicsContext&)> fn)
+{
+    const auto clippedRows = rows.getIntersectionWith (getClipRows());
+
+    // Anything that's completely clipped away doesn't need to be recorded at all
+    if (! clippedRows.isEmpty())
+        commands.push_back ({ std::move (fn), clippedRows });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addDrawing (Rectangle<float> userSpaceBounds, std::function<void (LowLevelGraphicsContext&)> fn)
+{
+    const auto bounds = userSpaceBounds.transformedBy (transform);
+
+    // Leave a margin for antialiasing and rounding
+    if (bounds.isFinite())
+        addDrawing (Range<int> ((int) std::floor (bounds.getY()) - 2, (int) std::ceil (bounds.getBottom()) + 2), std::move (fn));
+    else
+        addDrawing (getClipRows(), std::move (fn));
+}
+
+//==============================================================================
+bool LowLevelGraphicsTiledSoftwareRenderer::isVectorDevice() const                    { return false; }
+float LowLevelGraphicsTiledSoftwareRenderer::getPhysicalPixelScaleFactor()            { return stateTracker.getPhysicalPixelScaleFactor(); }
+bool LowLevelGraphicsTiledSoftwareRenderer::clipRegionIntersects (const Rectangle<int>& r) { return stateTracker.clipRegionIntersects (r); }
+Rectangle<int> LowLevelGraphicsTiledSoftwareRenderer::getClipBounds() const           { return stateTracker.getClipBounds(); }
+bool LowLevelGraphicsTiledSoftwareRenderer::isClipEmpty() const                       { return stateTracker.isClipEmpty(); }
+const Font& LowLevelGraphicsTiledSoftwareRenderer::getFont()                          { return stateTracker.getFont(); }
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOrigin (Point<int> o)
+{
+    transform = AffineTransform::translation (o).followedBy (transform);
+    addStateChange ([o] (auto& g) { g.setOrigin (o); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addTransform (const AffineTransform& t)
+{
+    transform = t.followedBy (transform);
+    addStateChange ([t] (auto& g) { g.addTransform (t); });
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangle (const Rectangle<int>& r)
+{
+    addStateChange ([r] (auto& g) { g.clipToRectangle (r); });
+    return ! stateTracker.isClipEmpty();
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangleList (const RectangleList<int>& r)
+{
+    addStateChange ([r] (auto& g) { g.clipToRectangleList (r); });
+    return ! stateTracker.isClipEmpty();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::excludeClipRectangle (const Rectangle<int>& r)
+{
+    addStateChange ([r] (auto& g) { g.excludeClipRectangle (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToPath (const Path& path, const AffineTransform& t)
+{
+    addStateChange ([path, t] (auto& g) { g.clipToPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToImageAlpha (const Image& im, const AffineTransform& t)
+{
+    addStateChange ([im, t] (auto& g) { g.clipToImageAlpha (im, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::saveState()
+{
+    savedTransforms.push_back (transform);
+    addStateChange ([] (auto& g) { g.saveState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::restoreState()
+{
+    if (! savedTransforms.empty())
+    {
+        transform = savedTransforms.back();
+        savedTransforms.pop_back();
+    }
+
+    addStateChange ([] (auto& g) { g.restoreState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::beginTransparencyLayer (float opacity)
+{
+    ++layerDepth;
+    savedTransforms.push_back (transform);
+
+    // The tracker only needs the clip region, so it doesn't need a real layer
+    stateTracker.saveState();
+    commands.push_back ({ [opacity] (auto& g) { g.beginTransparencyLayer (opacity); }, std::nullopt });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::endTransparencyLayer()
+{
+    if (layerDepth > 0)
+        --layerDepth;
+
+    if (! savedTransforms.empty())
+    {
+        transform = savedTransforms.back();
+        savedTransforms.pop_back();
+    }
+
+    stateTracker.restoreState();
+    commands.push_back ({ [] (auto& g) { g.endTransparencyLayer(); }, std::nullopt });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFill (const FillType& fill)
+{
+    addStateChange ([fill] (auto& g) { g.setFill (fill); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOpacity (float opacity)
+{
+    addStateChange ([opacity] (auto& g) { g.setOpacity (opacity); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    addStateChange ([quality] (auto& g) { g.setInterpolationQuality (quality); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFont (const Font& font)
+{
+    addStateChange ([font] (auto& g) { g.setFont (font); });
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<int>& r, bool replaceExistingContents)
+{
+    addDrawing (r.toFloat(), [r, replaceExistingContents] (auto& g) { g.fillRect (r, replaceExistingContents); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<float>& r)
+{
+    addDrawing (r, [r] (auto& g) { g.fillRect (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRectList (const RectangleList<float>& list)
+{
+    addDrawing (list.getBounds(), [list] (auto& g) { g.fillRectList (list); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillPath (const Path& path, const AffineTransform& t)
+{
+    addDrawing (path.getBoundsTransformed (t), [path, t] (auto& g) { g.fillPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawImage (const Image& im, const AffineTransform& t)
+{
+    addDrawing (im.getBounds().toFloat().transformedBy (t), [im, t] (auto& g) { g.drawImage (im, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawLine (const Line<float>& line)
+{
+    addDrawing (Rectangle<float> (line.getStart(), line.getEnd()).expanded (1.0f), [line] (auto& g) { g.drawLine (line); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    auto perform = [glyphNumber, t] (auto& g) { g.drawGlyph (glyphNumber, t); };
+    const auto glyphTransform = t.followedBy (transform);
+
+    // Glyphs are drawn relative to the baseline, so without knowing their exact
+    // shapes, this assumes that they stay within a couple of line heights of it.
+    // That only works if they aren't rotated.
+    if (approximatelyEqual (glyphTransform.mat10, 0.0f) && approximatelyEqual (glyphTransform.mat01, 0.0f))
+    {
+        const auto extent = 2.0f * getFont().getHeight() * std::abs (glyphTransform.mat11);
+        const auto baseline = glyphTransform.getTranslationY();
+
+        addDrawing (Range<int> ((int) std::floor (baseline - extent) - 2, (int) std::ceil (baseline + extent) + 2), std::move (perform));
+    }
+    else
+    {
+        addDrawing (getClipRows(), std::move (perform));
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class LowLevelGraphicsTiledSoftwareRendererTests final : public UnitTest
+{
+public:
+    LowLevelGraphicsTiledSoftwareRendererTests()
+        : UnitTest ("LowLevelGraphicsTiledSoftwareRenderer", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (3) };
+
+        beginTest ("Rendering matches the single-threaded renderer");
+        {
+            for (auto format : { Image::ARGB, Image::RGB })
+            {
+                Image expected (format, 300, 400, true, SoftwareImageType());
+                Image actual (format, 300, 400, true, SoftwareImageType());
+
+                {
+                    LowLevelGraphicsSoftwareRenderer context (expected);
+                    Graphics g (context);
+                    drawScene (g);
+                }
+
+                {
+                    LowLevelGraphicsTiledSoftwareRenderer context (actual, {}, actual.getBounds(), &pool);
+                    Graphics g (context);
+                    drawScene (g);
+                }
+
+                expect (imagesMatch (expected, actual, 0));
+            }
+        }
+
+        beginTest ("The origin and initial clip region are respected");
+        {
+            Image expected (Image::ARGB, 200, 300, true, SoftwareImageType());
+            Image actual (Image::ARGB, 200, 300, true, SoftwareImageType());
+
+            RectangleList<int> clip;
+            clip.add ({ 10, 10, 150, 100 });
+            clip.add ({ 40, 150, 100, 140 });
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (expected, { 5, -20 }, clip);
+                Graphics g (context);
+                drawScene (g);
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (actual, { 5, -20 }, clip, &pool);
+                Graphics g (context);
+                drawScene (g);
+            }
+
+            // Each tile's clip region has different bounds, which changes the rounding
+            // where antialiased edges meet the edges of the clip
+            expect (imagesMatch (expected, actual, 2));
+        }
+
+        beginTest ("Flushing keeps the current state");
+        {
+            Image image (Image::ARGB, 100, 200, true, SoftwareImageType());
+            LowLevelGraphicsTiledSoftwareRenderer context (image, {}, image.getBounds(), &pool);
+
+            context.setFill (Colours::red);
+            context.setOrigin ({ 10, 100 });
+            context.fillRect (Rectangle<int> (0, 0, 5, 5), false);
+            context.flush();
+
+            expect (image.getPixelAt (12, 102) == Colours::red);
+
+            context.fillRect (Rectangle<int> (0, 50, 5, 5), false);
+            expect (image.getPixelAt (12, 152).isTransparent());
+
+            context.flush();
+            expect (image.getPixelAt (12, 152) == Colours::red);
+        }
+
+        beginTest ("Queries reflect the recorded state");
+        {
+            Image image (Image::ARGB, 100, 200, true, SoftwareImageType());
+            LowLevelGraphicsTiledSoftwareRenderer context (image, {}, image.getBounds(), &pool);
+
+            context.setOrigin ({ 10, 20 });
+            expect (context.clipToRectangle ({ 0, 0, 50, 50 }));
+            expect (context.getClipBounds() == Rectangle<int> (0, 0, 50, 50));
+            expect (context.clipRegionIntersects ({ 40, 40, 20, 20 }));
+            expect (! context.clipRegionIntersects ({ 60, 60, 20, 20 }));
+
+            context.saveState();
+            expect (! context.clipToRectangle ({ 100, 100, 10, 10 }));
+            expect (context.isClipEmpty());
+            context.restoreState();
+
+            expect (! context.isClipEmpty());
+        }
+    }
+
+private:
+    static void drawScene (Graphics& g)
+    {
+        g.fillAll (Colours::white.withAlpha (0.5f));
+
+        g.setGradientFill (ColourGradient (Colours::red, 0.0f, 0.0f, Colours::blue, 300.0f, 400.0f, false));
+        g.fillEllipse (20.5f, 30.25f, 250.0f, 300.0f);
+
+        g.setColour (Colours::green.withAlpha (0.7f));
+        g.drawLine (0.0f, 399.0f, 299.0f, 3.0f, 3.5f);
+
+        Path star;
+        star.addStar ({ 150.0f, 200.0f }, 7, 40.0f, 130.0f, 0.3f);
+        g.setColour (Colours::orange);
+        g.fillPath (star, AffineTransform::rotation (0.4f, 150.0f, 200.0f));
+
+        {
+            Graphics::ScopedSaveState state (g);
+            g.reduceClipRegion (star);
+            g.setColour (Colours::black);
+
+            for (int y = 0; y < 400; y += 7)
+                g.fillRect (Rectangle<float> (0.0f, (float) y + 0.3f, 300.0f, 2.4f));
+        }
+
+        g.beginTransparencyLayer (0.4f);
+        g.setColour (Colours::purple);
+        g.fillRoundedRectangle (60.0f, 100.0f, 180.0f, 220.0f, 15.0f);
+        g.endTransparencyLayer();
+
+        Image sprite (Image::ARGB, 32, 32, true, SoftwareImageType());
+
+        for (int y = 0; y < 32; ++y)
+            for (int x = 0; x < 32; ++x)
+                sprite.setPixelAt (x, y, Colour ((uint8) (x * 8), (uint8) (y * 8), 128, (uint8) ((x + y) * 4)));
+
+        g.setOpacity (0.8f);
+        g.drawImageTransformed (sprite, AffineTransform::scale (3.3f).rotated (0.2f).translated (100.0f, 180.0f));
+        g.drawImageAt (sprite, 7, 350);
+
+        g.setColour (Colours::darkblue);
+        g.setFont (23.0f);
+        g.drawText ("Tiled rendering", 10, 60, 280, 40, Justification::centred);
+        g.addTransform (AffineTransform::rotation (0.7f, 150.0f, 200.0f));
+        g.drawText ("Rotated text", 50, 180, 200, 40, Justification::centred);
+    }
+
+    static bool imagesMatch (const Image& a, const Image& b, int tolerance)
+    {
+        const auto differ = [tolerance] (uint8 x, uint8 y) { return std::abs ((int) x - (int) y) > tolerance; };
+
+        for (int y = 0; y < a.getHeight(); ++y)
+        {
+            for (int x = 0; x < a.getWidth(); ++x)
+            {
+                const auto pa = a.getPixelAt (x, y), pb = b.getPixelAt (x, y);
+
+                if (differ (pa.getAlpha(), pb.getAlpha()) || differ (pa.getRed(), pb.getRed())
+                    || differ (pa.getGreen(), pb.getGreen()) || differ (pa.getBlue(), pb.getBlue()))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+static LowLevelGraphicsTiledSoftwareRendererTests lowLevelGraphicsTiledSoftwareRendererTests;
+
+//==============================================================================
+class SoftwareRendererBenchmark final : public Benchmark
+{
+public:
+    SoftwareRendererBenchmark()
+        : Benchmark ("Software renderer", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        Image target (Image::ARGB, 800, 600, true, SoftwareImageType());
+        Image sprite (Image::ARGB, 64, 64, true, SoftwareImageType());
+
+        {
+            Graphics g (sprite);
+            g.setGradientFill ({ Colours::red, 0.0f, 0.0f, Colours::transparentBlack, 64.0f, 64.0f, true });
+            g.fillEllipse (sprite.getBounds().toFloat());
+        }
+
+        Path star;
+        star.addStar ({ 400.0f, 300.0f }, 12, 80.0f, 250.0f, 0.3f);
+
+        beginTest ("LowLevelGraphicsSoftwareRenderer");
+
+        measure ("solid rectangles", [&]
+        {
+            Graphics g (target);
+
+            for (int i = 0; i < 50; ++i)
+            {
+                g.setColour (Colour ((uint32) (0x80000000 | (uint32) i * 0x050301)));
+                g.fillRect (Rectangle<float> ((float) i * 7.5f, (float) i * 5.5f, 400.0f, 300.0f));
+            }
+        });
+
+        measure ("gradient fill", [&]
+        {
+            Graphics g (target);
+            g.setGradientFill ({ Colours::white, 0.0f, 0.0f, Colours::blue.withAlpha (0.5f), 800.0f, 600.0f, false });
+            g.fillAll();
+        });
+
+        measure ("anti-aliased paths", [&]
+        {
+            Graphics g (target);
+            g.setColour (Colours::green.withAlpha (0.7f));
+            g.fillPath (star);
+            g.setColour (Colours::black);
+            g.strokePath (star, PathStrokeType (3.0f));
+        });
+
+        measure ("transformed images", [&]
+        {
+            Graphics g (target);
+
+            for (int i = 0; i < 20; ++i)
+                g.drawImageTransformed (sprite, AffineTransform::rotation ((float) i * 0.3f, 32.0f, 32.0f)
+                                                                .scaled (2.0f)
+                                                                .translated ((float) i * 30.0f, (float) i * 20.0f));
+        });
+
+        beginTest ("LowLevelGraphicsTiledSoftwareRenderer");
+
+        ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (jmax (1, SystemStats::getNumCpus() - 1)) };
+
+        measure ("anti-aliased paths", [&]
+        {
+            LowLevelGraphicsTiledSoftwareRenderer context (target, {}, target.getBounds(), &pool);
+            Graphics g (context);
+            g.setColour (Colours::green.withAlpha (0.7f));
+            g.fillPath (star);
+            g.setColour (Colours::black);
+            g.strokePath (star, PathStrokeType (3.0f));
+        });
+    }
+};
+
+static SoftwareRendererBenchmark softwareRendererBenchmark;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A LowLevelGraphicsContext that renders into an image in memory, like the
+    LowLevelGraphicsSoftwareRenderer, but spreads the work across several threads.
+
+    Drawing operations aren't performed straight away. Instead, they're recorded along
+    with the area of the image that each one can affect. When the context is deleted
+    (or flush() is called), the target area is split into horizontal tiles. Each tile
+    is rasterised on a thread pool by its own LowLevelGraphicsSoftwareRenderer, which
+    replays only the operations that touch that tile. For large repaints, the time
+    taken should scale with the number of cores.
+
+    The results are the same as the LowLevelGraphicsSoftwareRenderer's, except that
+    antialiased pixels at the edges of an irregular initial clip region may differ by
+    a rounding error. As the rendering happens later, the image mustn't be read or changed in any other way
+    until this context has been deleted or flushed. Any images and paths that are drawn
+    are copied, so they don't need to stay alive.
+
+    To use this for a component's peer, override LookAndFeel::createGraphicsContext():
+    @code
+    std::unique_ptr<LowLevelGraphicsContext> createGraphicsContext (const Image& imageToRenderOn,
+                                                                    Point<int> origin,
+                                                                    const RectangleList<int>& initialClip) override
+    {
+        return std::make_unique<LowLevelGraphicsTiledSoftwareRenderer> (imageToRenderOn, origin, initialClip);
+    }
+    @endcode
+
+    This only has an effect on platforms where windows are painted via
+    LookAndFeel::createGraphicsContext(), such as Linux.
+
+    @tags{Graphics}
+*/
+class JUCE_API  LowLevelGraphicsTiledSoftwareRenderer  : public LowLevelGraphicsContext
+{
+public:
+    //==============================================================================
+    /** Creates a context to render into a clipped subsection of an image.
+
+        If no thread pool is given, a pool shared by all instances of this class is
+        used. The calling thread also renders tiles while it waits for the pool.
+    */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto,
+                                           Point<int> origin,
+                                           const RectangleList<int>& initialClip,
+                                           ThreadPool* threadPool = nullptr);
+
+    /** Creates a context to render into an image. */
+    explicit LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto);
+
+    /** Destructor. This renders anything that hasn't been flushed yet. */
+    ~LowLevelGraphicsTiledSoftwareRenderer() override;
+
+    //==============================================================================
+    /** Renders all of the operations recorded so far into the image, and waits for
+        that to finish.
+
+        The context's state, such as its clip region and transform, isn't changed.
+    */
+    void flush();
+
+    //==============================================================================
+    bool isVectorDevice() const override;
+    void setOrigin (Point<int>) override;
+    void addTransform (const AffineTransform&) override;
+    float getPhysicalPixelScaleFactor() override;
+    bool clipToRectangle (const Rectangle<int>&) override;
+    bool clipToRectangleList (const RectangleList<int>&) override;
+    void excludeClipRectangle (const Rectangle<int>&) override;
+    void clipToPath (const Path&, const AffineTransform&) override;
+    void clipToImageAlpha (const Image&, const AffineTransform&) override;
+    bool clipRegionIntersects (const Rectangle<int>&) override;
+    Rectangle<int> getClipBounds() const override;
+    bool isClipEmpty() const override;
+    void saveState() override;
+    void restoreState() override;
+    void beginTransparencyLayer (float opacity) override;
+    void endTransparencyLayer() override;
+    void setFill (const FillType&) override;
+    void setOpacity (float) override;
+    void setInterpolationQuality (Graphics::ResamplingQuality) override;
+    void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+    void fillRect (const Rectangle<float>&) override;
+    void fillRectList (const RectangleList<float>&) override;
+    void fillPath (const Path&, const AffineTransform&) override;
+    void drawImage (const Image&, const AffineTransform&) override;
+    void drawLine (const Line<float>&) override;
+    void setFont (const Font&) override;
+    const Font& getFont() override;
+    void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+private:
+    //==============================================================================
+    struct Command
+    {
+        std::function<void (LowLevelGraphicsContext&)> perform;
+
+        // The rows of the image that a drawing operation can touch. State changes
+        // have no rows, and are performed in every tile.
+        std::optional<Range<int>> rows;
+    };
+
+    class TilePixelData;
+
+    void addStateChange (std::function<void (LowLevelGraphicsContext&)>);
+    void addDrawing (Rectangle<float> userSpaceBounds, std::function<void (LowLevelGraphicsContext&)>);
+    void addDrawing (Range<int> rows, std::function<void (LowLevelGraphicsContext&)>);
+    Range<int> getClipRows() const;
+    void renderTile (const Image& tileImage, Range<int> rows) const;
+
+    Image image;
+    const Point<int> initialOrigin;
+    const RectangleList<int> initialClip;
+    ThreadPool* pool;
+
+    // This receives all of the state changes, so that it can answer queries about the
+    // clip region without needing to render anything
+    LowLevelGraphicsSoftwareRenderer stateTracker;
+    AffineTransform transform;
+    std::vector<AffineTransform> savedTransforms;
+    int layerDepth = 0;
+
+    std::vector<Command> commands;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsTiledSoftwareRenderer)
+};
+
+} // namespace juce
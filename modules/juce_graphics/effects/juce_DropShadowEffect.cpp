@@ -26,46 +26,199 @@
 namespace juce
 {
 
-static void blurDataTriplets (uint8* d, int num, const int delta) noexcept
+// Applies a box filter of width (2 * halfWidth + 1) along a line, treating values beyond the ends as zero
+static void boxBlurLine (const uint8* src, uint8* dest, const int num, const int halfWidth) noexcept
 {
-    uint32 last = d[0];
-    d[0] = (uint8) ((d[0] + d[delta] + 1) / 3);
-    d += delta;
+    const auto width = (uint32) (2 * halfWidth + 1);
+    uint32 sum = 0;
 
-    num -= 2;
+    for (int i = 0; i < jmin (halfWidth, num); ++i)
+        sum += src[i];
 
-    do
+    for (int i = 0; i < num; ++i)
     {
-        const uint32 newLast = d[0];
-        d[0] = (uint8) ((last + d[0] + d[delta] + 1) / 3);
-        d += delta;
-        last = newLast;
+        if (i + halfWidth < num)      sum += src[i + halfWidth];
+        if (i - halfWidth - 1 >= 0)   sum -= src[i - halfWidth - 1];
+
+        dest[i] = (uint8) ((sum + width / 2) / width);
     }
-    while (--num > 0);
+}
 
-    d[0] = (uint8) ((last + d[0] + 1) / 3);
+// The vertical version of boxBlurLine, which works along the rows to keep the memory access sequential
+static void boxBlurColumns (const uint8* src, uint8* dest, const int width, const int height,
+                            const int lineStride, const int halfWidth, uint32* sums) noexcept
+{
+    const auto boxWidth = (uint32) (2 * halfWidth + 1);
+    std::fill (sums, sums + width, 0u);
+
+    const auto addRow = [&] (int y, bool add)
+    {
+        const auto* line = src + (size_t) y * (size_t) width;
+
+        if (add)
+            for (int x = 0; x < width; ++x)
+                sums[x] += line[x];
+        else
+            for (int x = 0; x < width; ++x)
+                sums[x] -= line[x];
+    };
+
+    for (int y = 0; y < jmin (halfWidth, height); ++y)
+        addRow (y, true);
+
+    for (int y = 0; y < height; ++y)
+    {
+        if (y + halfWidth < height)      addRow (y + halfWidth, true);
+        if (y - halfWidth - 1 >= 0)      addRow (y - halfWidth - 1, false);
+
+        auto* line = dest + (size_t) y * (size_t) lineStride;
+
+        for (int x = 0; x < width; ++x)
+            line[x] = (uint8) ((sums[x] + boxWidth / 2) / boxWidth);
+    }
 }
 
+/*  Approximates a gaussian blur with three box blurs, each of which costs the same no
+    matter how wide it is. The widths are chosen to give the same spread as the (2 * radius)
+    passes of a 3-tap filter that this effect has always used.
+*/
 static void blurSingleChannelImage (uint8* const data, const int width, const int height,
-                                    const int lineStride, const int repetitions) noexcept
+                                    const int lineStride, const int radius)
 {
-    jassert (width > 2 && height > 2);
+    constexpr int numPasses = 3;
 
-    for (int y = 0; y < height; ++y)
-        for (int i = repetitions; --i >= 0;)
-            blurDataTriplets (data + lineStride * y, width, 1);
+    if (radius <= 0)
+        return;
+
+    const auto variance = (double) radius * 4.0 / 3.0;
+    auto lowerWidth = (int) std::sqrt (12.0 * variance / numPasses + 1.0);
+
+    if ((lowerWidth & 1) == 0)
+        --lowerWidth;
 
-    for (int x = 0; x < width; ++x)
-        for (int i = repetitions; --i >= 0;)
-            blurDataTriplets (data + x, height, lineStride);
+    const auto numLowerPasses = roundToInt ((12.0 * variance - numPasses * lowerWidth * lowerWidth
+                                              - 4.0 * numPasses * lowerWidth - 3.0 * numPasses)
+                                            / (-4.0 * lowerWidth - 4.0));
+
+    HeapBlock<uint8> copy ((size_t) width * (size_t) height);
+    HeapBlock<uint8> line ((size_t) width);
+    HeapBlock<uint32> sums ((size_t) width);
+
+    for (int pass = 0; pass < numPasses; ++pass)
+    {
+        const auto halfWidth = (pass < numLowerPasses ? lowerWidth : lowerWidth + 2) / 2;
+
+        if (halfWidth <= 0)
+            continue;
+
+        for (int y = 0; y < height; ++y)
+        {
+            auto* d = data + (size_t) y * (size_t) lineStride;
+            std::copy (d, d + width, line.get());
+            boxBlurLine (line, d, width, halfWidth);
+            std::copy (d, d + width, copy + (size_t) y * (size_t) width);
+        }
+
+        boxBlurColumns (copy, data, width, height, lineStride, halfWidth, sums);
+    }
 }
 
 static void blurSingleChannelImage (Image& image, int radius)
 {
     const Image::BitmapData bm (image, Image::BitmapData::readWrite);
-    blurSingleChannelImage (bm.data, bm.width, bm.height, bm.lineStride, 2 * radius);
+    blurSingleChannelImage (bm.data, bm.width, bm.height, bm.lineStride, radius);
+}
+
+static bool haveSameContent (const Image& a, const Image& b)
+{
+    if (! a.isValid() || ! b.isValid()
+         || a.getBounds() != b.getBounds() || a.getFormat() != b.getFormat())
+        return false;
+
+    const Image::BitmapData dataA (a, Image::BitmapData::readOnly);
+    const Image::BitmapData dataB (b, Image::BitmapData::readOnly);
+    const auto numBytes = (size_t) (dataA.width * dataA.pixelStride);
+
+    for (int y = 0; y < dataA.height; ++y)
+        if (memcmp (dataA.getLinePointer (y), dataB.getLinePointer (y), numBytes) != 0)
+            return false;
+
+    return true;
+}
+
+static Image createShadowImage (const Image& srcImage, int radius)
+{
+    Image shadowImage (srcImage.convertedToFormat (Image::SingleChannel));
+    shadowImage.duplicateIfShared();
+    blurSingleChannelImage (shadowImage, radius);
+    return shadowImage;
 }
 
+//==============================================================================
+/*  Keeps the most recently drawn path shadows, so that a shadow that's repainted without
+    changing doesn't need blurring again.
+*/
+class PathShadowCache
+{
+public:
+    static Image get (const Path& path, int radius, Point<int> offset, Rectangle<int> area)
+    {
+        auto& cache = getInstance();
+        const ScopedLock sl (cache.lock);
+
+        for (auto i = cache.entries.begin(); i != cache.entries.end(); ++i)
+        {
+            if (i->radius == radius && i->offset == offset && i->area == area && i->path == path)
+            {
+                // Move the entry to the front, so that the least recently used one is last
+                cache.entries.splice (cache.entries.begin(), cache.entries, i);
+                return i->image;
+            }
+        }
+
+        return {};
+    }
+
+    static void add (const Path& path, int radius, Point<int> offset, Rectangle<int> area, const Image& image)
+    {
+        auto& cache = getInstance();
+        const ScopedLock sl (cache.lock);
+
+        cache.entries.push_front ({ path, radius, offset, area, image });
+        cache.numPixels += getNumPixels (area);
+
+        while (cache.entries.size() > 1 && cache.numPixels > maxNumPixels)
+        {
+            cache.numPixels -= getNumPixels (cache.entries.back().area);
+            cache.entries.pop_back();
+        }
+    }
+
+private:
+    struct Entry
+    {
+        Path path;
+        int radius;
+        Point<int> offset;
+        Rectangle<int> area;
+        Image image;
+    };
+
+    static PathShadowCache& getInstance()
+    {
+        static PathShadowCache cache;
+        return cache;
+    }
+
+    static size_t getNumPixels (Rectangle<int> area) noexcept   { return (size_t) area.getWidth() * (size_t) area.getHeight(); }
+
+    static constexpr size_t maxNumPixels = 4 * 1024 * 1024;
+
+    CriticalSection lock;
+    std::list<Entry> entries;
+    size_t numPixels = 0;
+};
+
 //==============================================================================
 DropShadow::DropShadow (Colour shadowColour, const int r, Point<int> o) noexcept
     : colour (shadowColour), radius (r), offset (o)
@@ -79,13 +232,8 @@ void DropShadow::drawForImage (Graphics& g, const Image& srcImage) const
 
     if (srcImage.isValid())
     {
-        Image shadowImage (srcImage.convertedToFormat (Image::SingleChannel));
-        shadowImage.duplicateIfShared();
-
-        blurSingleChannelImage (shadowImage, radius);
-
         g.setColour (colour);
-        g.drawImageAt (shadowImage, offset.x, offset.y, true);
+        g.drawImageAt (createShadowImage (srcImage, radius), offset.x, offset.y, true);
     }
 }
 
@@ -99,16 +247,22 @@ void DropShadow::drawForPath (Graphics& g, const Path& path) const
 
     if (area.getWidth() > 2 && area.getHeight() > 2)
     {
-        Image renderedPath (Image::SingleChannel, area.getWidth(), area.getHeight(), true);
+        auto renderedPath = PathShadowCache::get (path, radius, offset, area);
 
+        if (! renderedPath.isValid())
         {
-            Graphics g2 (renderedPath);
-            g2.setColour (Colours::white);
-            g2.fillPath (path, AffineTransform::translation ((float) (offset.x - area.getX()),
-                                                             (float) (offset.y - area.getY())));
-        }
+            renderedPath = Image (Image::SingleChannel, area.getWidth(), area.getHeight(), true);
 
-        blurSingleChannelImage (renderedPath, radius);
+            {
+                Graphics g2 (renderedPath);
+                g2.setColour (Colours::white);
+                g2.fillPath (path, AffineTransform::translation ((float) (offset.x - area.getX()),
+                                                                 (float) (offset.y - area.getY())));
+            }
+
+            blurSingleChannelImage (renderedPath, radius);
+            PathShadowCache::add (path, radius, offset, area, renderedPath);
+        }
 
         g.setColour (colour);
         g.drawImageAt (renderedPath, area.getX(), area.getY(), true);
@@ -174,7 +328,19 @@ void DropShadowEffect::applyEffect (Image& image, Graphics& g, float scaleFactor
     s.offset.x = roundToInt ((float) s.offset.x * scaleFactor);
     s.offset.y = roundToInt ((float) s.offset.y * scaleFactor);
 
-    s.drawForImage (g, image);
+    // Components are often repainted without their content changing, in which case
+    // the shadow from the last repaint can be drawn again
+    auto alphaImage = image.convertedToFormat (Image::SingleChannel);
+
+    if (s.radius != lastShadowRadius || ! haveSameContent (alphaImage, lastShadowSource))
+    {
+        lastShadowSource = alphaImage.createCopy();
+        lastShadowRadius = s.radius;
+        lastShadow = createShadowImage (alphaImage, s.radius);
+    }
+
+    g.setColour (s.colour);
+    g.drawImageAt (lastShadow, s.offset.x, s.offset.y, true);
 
     g.setOpacity (alpha);
     g.drawImageAt (image, 0, 0);
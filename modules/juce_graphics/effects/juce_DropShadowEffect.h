@@ -74,9 +74,12 @@ struct JUCE_API  DropShadow
     shadow based on what gets drawn inside it. The shadow will also
     be applied to the component's children.
 
-    For speed, this doesn't use a proper gaussian blur, but cheats by
-    using a simple bilinear filter. If you need a really high-quality
-    shadow, check out ImageConvolutionKernel::createGaussianBlur()
+    For speed, this doesn't use a proper gaussian blur, but approximates
+    one with a few box filters. If you need a really high-quality shadow,
+    check out ImageConvolutionKernel::createGaussianBlur()
+
+    The shadow from the previous repaint is reused if the component's
+    content hasn't changed.
 
     @see Component::setComponentEffect
 
@@ -106,6 +109,8 @@ public:
 private:
     //==============================================================================
     DropShadow shadow;
+    Image lastShadowSource, lastShadow;
+    int lastShadowRadius = 0;
 
     JUCE_LEAK_DETECTOR (DropShadowEffect)
 };
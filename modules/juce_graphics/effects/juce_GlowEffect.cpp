@@ -38,17 +38,27 @@ void GlowEffect::setGlowProperties (float newRadius, Colour newColour, Point<int
 
 void GlowEffect::applyEffect (Image& image, Graphics& g, float scaleFactor, float alpha)
 {
-    Image temp (image.getFormat(), image.getWidth(), image.getHeight(), true);
+    const auto kernelSize = roundToInt (radius * scaleFactor * 2.0f);
 
-    ImageConvolutionKernel blurKernel (roundToInt (radius * scaleFactor * 2.0f));
+    // Reuse the previous blur if the component has been repainted without changing
+    if (kernelSize != lastKernelSize || ! exactlyEqual (radius, lastRadius) || ! haveSameContent (image, lastSource))
+    {
+        lastBlurred = Image (image.getFormat(), image.getWidth(), image.getHeight(), true);
 
-    blurKernel.createGaussianBlur (radius);
-    blurKernel.rescaleAllValues (radius);
+        ImageConvolutionKernel blurKernel (kernelSize);
 
-    blurKernel.applyToImage (temp, image, image.getBounds());
+        blurKernel.createGaussianBlur (radius);
+        blurKernel.rescaleAllValues (radius);
+
+        blurKernel.applyToImage (lastBlurred, image, image.getBounds());
+
+        lastSource = image.createCopy();
+        lastKernelSize = kernelSize;
+        lastRadius = radius;
+    }
 
     g.setColour (colour.withMultipliedAlpha (alpha));
-    g.drawImageAt (temp, offset.x, offset.y, true);
+    g.drawImageAt (lastBlurred, offset.x, offset.y, true);
 
     g.setOpacity (alpha);
     g.drawImageAt (image, offset.x, offset.y, false);
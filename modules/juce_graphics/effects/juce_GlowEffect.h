@@ -70,6 +70,10 @@ private:
     Colour colour { Colours::white };
     Point<int> offset;
 
+    Image lastSource, lastBlurred;
+    int lastKernelSize = 0;
+    float lastRadius = 0.0f;
+
     JUCE_LEAK_DETECTOR (GlowEffect)
 };
 
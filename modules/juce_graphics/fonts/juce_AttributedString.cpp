@@ -264,6 +264,52 @@ void AttributedString::setFont (const Font& font)
     jassert (areInvariantsMaintained (text, attributes));
 }
 
+namespace
+{
+    struct TextLayoutArgs
+    {
+        bool operator< (const TextLayoutArgs& other) const
+        {
+            const auto tie = [] (const TextLayoutArgs& args)
+            {
+                const auto& s = args.string;
+                return std::make_tuple (args.width, s.getText(), s.getNumAttributes(), s.getJustification().getFlags(),
+                                        (int) s.getWordWrap(), (int) s.getReadingDirection(), s.getLineSpacing());
+            };
+
+            const auto a = tie (*this), b = tie (other);
+
+            if (a != b)
+                return a < b;
+
+            for (int i = 0; i < string.getNumAttributes(); ++i)
+            {
+                const auto& attA = string.getAttribute (i);
+                const auto& attB = other.string.getAttribute (i);
+
+                const auto tieAttribute = [] (const AttributedString::Attribute& att)
+                {
+                    return std::make_tuple (att.range.getStart(), att.range.getEnd(), att.colour.getARGB());
+                };
+
+                if (tieAttribute (attA) != tieAttribute (attB))
+                    return tieAttribute (attA) < tieAttribute (attB);
+
+                if (GraphicsFontHelpers::compareFont (attA.font, attB.font))
+                    return true;
+
+                if (GraphicsFontHelpers::compareFont (attB.font, attA.font))
+                    return false;
+            }
+
+            return false;
+        }
+
+        AttributedString string;
+        float width;
+    };
+}
+
 void AttributedString::draw (Graphics& g, const Rectangle<float>& area) const
 {
     if (text.isNotEmpty() && g.clipRegionIntersects (area.getSmallestIntegerContainer()))
@@ -272,9 +318,16 @@ void AttributedString::draw (Graphics& g, const Rectangle<float>& area) const
 
         if (! g.getInternalContext().drawTextLayout (*this, area))
         {
-            TextLayout layout;
-            layout.createLayout (*this, area.getWidth());
-            layout.draw (g, area);
+            auto createLayout = [] (const TextLayoutArgs& args)
+            {
+                TextLayout layout;
+                layout.createLayout (args.string, args.width);
+                return layout;
+            };
+
+            detail::ShapedTextCache<TextLayoutArgs, TextLayout>::getInstance()
+                ->use ({ *this, area.getWidth() }, createLayout,
+                       [&] (const TextLayout& layout) { layout.draw (g, area); });
         }
     }
 }
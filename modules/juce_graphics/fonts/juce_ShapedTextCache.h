@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct GraphicsFontHelpers
+{
+    static auto compareFont (const Font& a, const Font& b) { return Font::compare (a, b); }
+};
+
+namespace detail
+{
+
+//==============================================================================
+/*  A process-wide cache of shaped text, used so that strings which are drawn in
+    every frame don't need to be laid out again each time.
+
+    Each Key type gets its own cache, holding at most cacheSize of the most recently
+    used entries. Keys shouldn't include the position at which the text is drawn, so
+    that the same text can be reused wherever it appears.
+*/
+template <typename Key, typename Value>
+class ShapedTextCache final : public DeletedAtShutdown
+{
+public:
+    ShapedTextCache() = default;
+
+    ~ShapedTextCache() override
+    {
+        clearSingletonInstance();
+    }
+
+    /*  Finds or creates the Value for a key, and passes it to useValue.
+        If another thread is using the cache, the value is just created without being cached.
+    */
+    template <typename CreateValue, typename UseValue>
+    void use (Key&& key, CreateValue&& createValue, UseValue&& useValue)
+    {
+        const ScopedTryLock stl (lock);
+
+        if (! stl.isLocked())
+        {
+            useValue (createValue (key));
+            return;
+        }
+
+        const auto cached = [&]
+        {
+            const auto iter = cache.find (key);
+
+            if (iter != cache.end())
+            {
+                if (iter->second.cachePosition != cacheOrder.begin())
+                    cacheOrder.splice (cacheOrder.begin(), cacheOrder, iter->second.cachePosition);
+
+                return iter;
+            }
+
+            auto result = cache.emplace (std::move (key), CachedValue { createValue (key), {} }).first;
+            cacheOrder.push_front (result);
+            return result;
+        }();
+
+        cached->second.cachePosition = cacheOrder.begin();
+        useValue (cached->second.value);
+
+        while (cache.size() > cacheSize)
+        {
+            cache.erase (cacheOrder.back());
+            cacheOrder.pop_back();
+        }
+    }
+
+    JUCE_DECLARE_SINGLETON (ShapedTextCache, false)
+
+private:
+    struct CachedValue
+    {
+        using CachePtr = typename std::map<Key, CachedValue>::const_iterator;
+        Value value;
+        typename std::list<CachePtr>::const_iterator cachePosition;
+    };
+
+    static constexpr size_t cacheSize = 512;
+    std::map<Key, CachedValue> cache;
+    std::list<typename CachedValue::CachePtr> cacheOrder;
+    CriticalSection lock;
+};
+
+template <typename Key, typename Value>
+SingletonHolder<ShapedTextCache<Key, Value>, CriticalSection, false> ShapedTextCache<Key, Value>::singletonHolder;
+
+} // namespace detail
+} // namespace juce
@@ -26,6 +26,8 @@
 namespace juce
 {
 
+namespace RenderingHelpers { class PathCache; }
+
 //==============================================================================
 /**
     A path is a sequence of lines and curves that may either form a closed shape
@@ -803,6 +805,7 @@ private:
     friend class PathFlatteningIterator;
     friend class Path::Iterator;
     friend class EdgeTable;
+    friend class RenderingHelpers::PathCache;
 
     Array<float> data;
 
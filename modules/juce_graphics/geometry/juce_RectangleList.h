@@ -670,7 +670,7 @@ public:
         Calling this before adding a large number of rectangles means that
         the array won't have to keep dynamically resizing itself as the elements
         are added, and it'll therefore be more efficient.
-        @see Array::ensureStorageAllocated
+        @see SmallArray::ensureStorageAllocated
     */
     void ensureStorageAllocated (int minNumRectangles)
     {
@@ -679,7 +679,9 @@ public:
 
 private:
     //==============================================================================
-    Array<RectangleType> rects;
+    // Most lists only ever hold a few rectangles, so these are kept inline to avoid
+    // allocating when lists are created and thrown away during painting.
+    SmallArray<RectangleType, 4> rects;
 };
 
 } // namespace juce
@@ -221,6 +221,12 @@ void JPEGImageFormat::setQuality (const float newQuality)
     quality = newQuality;
 }
 
+void JPEGImageFormat::setDownscaleFactor (int factor)
+{
+    jassert (factor == 1 || factor == 2 || factor == 4 || factor == 8);
+    downscaleFactor = jlimit (1, 8, nextPowerOfTwo (factor));
+}
+
 String JPEGImageFormat::getFormatName()                   { return "JPEG"; }
 bool JPEGImageFormat::usesFileExtension (const File& f)   { return f.hasFileExtension ("jpeg;jpg"); }
 
@@ -252,7 +258,13 @@ bool JPEGImageFormat::canUnderstand (InputStream& in)
 Image JPEGImageFormat::decodeImage (InputStream& in)
 {
    #if JUCE_USING_COREIMAGE_LOADER
-    return juce_loadWithCoreImage (in);
+    auto image = juce_loadWithCoreImage (in);
+
+    if (downscaleFactor > 1 && image.isValid())
+        return image.rescaled (jmax (1, image.getWidth()  / downscaleFactor),
+                               jmax (1, image.getHeight() / downscaleFactor));
+
+    return image;
    #else
     using namespace jpeglibNamespace;
     using namespace JPEGHelpers;
@@ -291,6 +303,10 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 
         if (! hasFailed)
         {
+            // libjpeg does the scaling in its inverse DCT, so it never produces the full-sized pixels
+            jpegDecompStruct.scale_num = 1;
+            jpegDecompStruct.scale_denom = (unsigned int) downscaleFactor;
+
             jpeg_calc_output_dimensions (&jpegDecompStruct);
 
             if (! hasFailed)
@@ -300,46 +316,53 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 
                 jpegDecompStruct.out_color_space = JCS_RGB;
 
-                JSAMPARRAY buffer
-                    = (*jpegDecompStruct.mem->alloc_sarray) ((j_common_ptr) &jpegDecompStruct,
-                                                             JPOOL_IMAGE,
-                                                             (JDIMENSION) width * 3, 1);
-
                 if (jpeg_start_decompress (&jpegDecompStruct) && ! hasFailed)
                 {
+                    // asking for as many rows as the upsampler produces at once lets libjpeg
+                    // write them straight into our buffer instead of going via its own
+                    const auto rowsPerRead = jmax (1, jpegDecompStruct.rec_outbuf_height);
+
+                    JSAMPARRAY buffer
+                        = (*jpegDecompStruct.mem->alloc_sarray) ((j_common_ptr) &jpegDecompStruct,
+                                                                 JPOOL_IMAGE,
+                                                                 (JDIMENSION) width * 3, (JDIMENSION) rowsPerRead);
+
                     image = Image (Image::RGB, width, height, false);
                     image.getProperties()->set ("originalImageHadAlpha", false);
                     const bool hasAlphaChan = image.hasAlphaChannel(); // (the native image creator may not give back what we expect)
 
                     const Image::BitmapData destData (image, Image::BitmapData::writeOnly);
 
-                    for (int y = 0; y < height; ++y)
+                    for (int y = 0; y < height;)
                     {
-                        jpeg_read_scanlines (&jpegDecompStruct, buffer, 1);
+                        const auto numRows = (int) jpeg_read_scanlines (&jpegDecompStruct, buffer, (JDIMENSION) rowsPerRead);
 
-                        if (hasFailed)
+                        if (hasFailed || numRows <= 0)
                             break;
 
-                        const uint8* src = *buffer;
-                        uint8* dest = destData.getLinePointer (y);
-
-                        if (hasAlphaChan)
+                        for (int row = 0; row < numRows && y < height; ++row, ++y)
                         {
-                            for (int i = width; --i >= 0;)
+                            const uint8* src = buffer[row];
+                            uint8* dest = destData.getLinePointer (y);
+
+                            // the pixels are all opaque, so there's nothing to premultiply
+                            if (hasAlphaChan)
                             {
-                                ((PixelARGB*) dest)->setARGB (0xff, src[0], src[1], src[2]);
-                                ((PixelARGB*) dest)->premultiply();
-                                dest += destData.pixelStride;
-                                src += 3;
+                                for (int i = width; --i >= 0;)
+                                {
+                                    ((PixelARGB*) dest)->setARGB (0xff, src[0], src[1], src[2]);
+                                    dest += destData.pixelStride;
+                                    src += 3;
+                                }
                             }
-                        }
-                        else
-                        {
-                            for (int i = width; --i >= 0;)
+                            else
                             {
-                                ((PixelRGB*) dest)->setARGB (0xff, src[0], src[1], src[2]);
-                                dest += destData.pixelStride;
-                                src += 3;
+                                for (int i = width; --i >= 0;)
+                                {
+                                    ((PixelRGB*) dest)->setARGB (0xff, src[0], src[1], src[2]);
+                                    dest += destData.pixelStride;
+                                    src += 3;
+                                }
                             }
                         }
                     }
@@ -398,14 +398,19 @@ namespace PNGHelpers
         return false;
     }
 
-    static bool readImageData (png_structp pngReadStruct, png_infop pngInfoStruct, jmp_buf& errorJumpBuf, png_bytepp rows) noexcept
+    static bool readImageData (png_structp pngReadStruct, png_infop pngInfoStruct, jmp_buf& errorJumpBuf, png_bytepp rows,
+                               bool addFiller, bool swapRedAndBlue) noexcept
     {
         if (setjmp (errorJumpBuf) == 0)
         {
             if (png_get_valid (pngReadStruct, pngInfoStruct, PNG_INFO_tRNS))
                 png_set_expand (pngReadStruct);
 
-            png_set_add_alpha (pngReadStruct, 0xff, PNG_FILLER_AFTER);
+            if (swapRedAndBlue)
+                png_set_bgr (pngReadStruct);
+
+            if (addFiller)
+                png_set_add_alpha (pngReadStruct, 0xff, PNG_FILLER_AFTER);
 
             png_read_image (pngReadStruct, rows);
             png_read_end (pngReadStruct, pngInfoStruct);
@@ -417,16 +422,59 @@ namespace PNGHelpers
 
     JUCE_END_IGNORE_WARNINGS_MSVC
 
-    static Image createImageFromData (bool hasAlphaChan, int width, int height, png_bytepp rows)
+    /*  libpng can write BGR or BGRA rows straight into the image if its pixels are laid out
+        that way in memory, which saves a temporary copy of the whole image and a pass over it.
+    */
+    static bool canDecodeDirectly (const Image::BitmapData& destData, bool hasAlphaChan) noexcept
     {
-        // now convert the data to a juce image format..
-        Image image (hasAlphaChan ? Image::ARGB : Image::RGB, width, height, hasAlphaChan);
+        constexpr auto isBGRA = PixelARGB::indexB == 0 && PixelARGB::indexG == 1 && PixelARGB::indexR == 2 && PixelARGB::indexA == 3
+                             && PixelRGB::indexB == 0 && PixelRGB::indexG == 1 && PixelRGB::indexR == 2;
+
+        if constexpr (! isBGRA)
+            return false;
+
+        if (hasAlphaChan)
+            return destData.pixelFormat == Image::ARGB && destData.pixelStride == 4;
+
+        return destData.pixelFormat == Image::RGB && (destData.pixelStride == 3 || destData.pixelStride == 4);
+    }
+
+    static bool decodeDirectly (png_structp pngReadStruct, png_infop pngInfoStruct, jmp_buf& errorJumpBuf,
+                                const Image::BitmapData& destData, bool hasAlphaChan)
+    {
+        HeapBlock<png_bytep> rows (destData.height);
+
+        for (int y = 0; y < destData.height; ++y)
+            rows[y] = destData.getLinePointer (y);
+
+        if (! readImageData (pngReadStruct, pngInfoStruct, errorJumpBuf, rows, destData.pixelStride == 4, true))
+            return false;
+
+        if (hasAlphaChan)
+            for (int y = 0; y < destData.height; ++y)
+                RenderingHelpers::SpanBlending::premultiply (reinterpret_cast<PixelARGB*> (rows[y]), destData.width);
 
-        image.getProperties()->set ("originalImageHadAlpha", image.hasAlphaChannel());
-        hasAlphaChan = image.hasAlphaChannel(); // (the native image creator may not give back what we expect)
+        return true;
+    }
+
+    static bool decodeViaTempBuffer (png_structp pngReadStruct, png_infop pngInfoStruct, jmp_buf& errorJumpBuf,
+                                     const Image::BitmapData& destData, bool hasAlphaChan)
+    {
+        const auto width = (size_t) destData.width;
+        const auto height = (size_t) destData.height;
 
-        const Image::BitmapData destData (image, Image::BitmapData::writeOnly);
+        // Load the image into a temp buffer..
+        const size_t lineStride = width * 4;
+        HeapBlock<uint8> tempBuffer (height * lineStride);
+        HeapBlock<png_bytep> rows (height);
 
+        for (size_t y = 0; y < height; ++y)
+            rows[y] = (png_bytep) (tempBuffer + lineStride * y);
+
+        if (! readImageData (pngReadStruct, pngInfoStruct, errorJumpBuf, rows, true, false))
+            return false;
+
+        // now convert the data to a juce image format..
         for (int y = 0; y < (int) height; ++y)
         {
             const uint8* src = rows[y];
@@ -453,7 +501,7 @@ namespace PNGHelpers
             }
         }
 
-        return image;
+        return true;
     }
 
     static Image readImage (InputStream& in, png_structp pngReadStruct, png_infop pngInfoStruct)
@@ -467,22 +515,29 @@ namespace PNGHelpers
         if (readHeader (in, pngReadStruct, pngInfoStruct, errorJumpBuf,
                         width, height, bitDepth, colorType, interlaceType))
         {
-            // Load the image into a temp buffer..
-            const size_t lineStride = width * 4;
-            HeapBlock<uint8> tempBuffer (height * lineStride);
-            HeapBlock<png_bytep> rows (height);
-
-            for (size_t y = 0; y < height; ++y)
-                rows[y] = (png_bytep) (tempBuffer + lineStride * y);
-
             png_bytep trans_alpha = nullptr;
             png_color_16p trans_color = nullptr;
             int num_trans = 0;
             png_get_tRNS (pngReadStruct, pngInfoStruct, &trans_alpha, &num_trans, &trans_color);
 
-            if (readImageData (pngReadStruct, pngInfoStruct, errorJumpBuf, rows))
-                return createImageFromData ((colorType & PNG_COLOR_MASK_ALPHA) != 0 || num_trans != 0,
-                                            (int) width, (int) height, rows);
+            auto hasAlphaChan = (colorType & PNG_COLOR_MASK_ALPHA) != 0 || num_trans != 0;
+            Image image (hasAlphaChan ? Image::ARGB : Image::RGB, (int) width, (int) height, hasAlphaChan);
+
+            image.getProperties()->set ("originalImageHadAlpha", image.hasAlphaChannel());
+            hasAlphaChan = image.hasAlphaChannel(); // (the native image creator may not give back what we expect)
+
+            bool succeeded = false;
+
+            {
+                const Image::BitmapData destData (image, Image::BitmapData::writeOnly);
+
+                succeeded = canDecodeDirectly (destData, hasAlphaChan)
+                              ? decodeDirectly (pngReadStruct, pngInfoStruct, errorJumpBuf, destData, hasAlphaChan)
+                              : decodeViaTempBuffer (pngReadStruct, pngInfoStruct, errorJumpBuf, destData, hasAlphaChan);
+            }
+
+            if (succeeded)
+                return image;
         }
 
         return Image();
@@ -40,7 +40,80 @@ ImagePixelData::~ImagePixelData()
 
 void ImagePixelData::sendDataChangeMessage()
 {
-    listeners.call ([this] (Listener& l) { l.imageDataChanged (this); });
+    sendDataChangeMessage ({ width, height });
+}
+
+void ImagePixelData::sendDataChangeMessage (Rectangle<int> changedArea)
+{
+    {
+        const ScopedLock sl (mipMapLock);
+        mipMaps.clear();
+    }
+
+    listeners.call ([this, changedArea] (Listener& l) { l.imageAreaChanged (this, changedArea); });
+}
+
+void ImagePixelData::setMipMapsEnabled (bool shouldBeEnabled)
+{
+    mipMapsEnabled = shouldBeEnabled;
+
+    if (! shouldBeEnabled)
+    {
+        const ScopedLock sl (mipMapLock);
+        mipMaps.clear();
+    }
+}
+
+static Image createHalfSizeImage (const Image& image)
+{
+    // this averages each 2x2 block of bytes, which works for any of the pixel formats as long
+    // as both images lay out their pixels the same way, hence the conversion to a software image
+    const auto source = SoftwareImageType().convert (image);
+    Image result (SoftwareImageType().create (image.getFormat(), jmax (1, image.getWidth() / 2), jmax (1, image.getHeight() / 2), false));
+
+    const Image::BitmapData src (source, Image::BitmapData::readOnly);
+    const Image::BitmapData dest (result, Image::BitmapData::writeOnly);
+    const auto stride = src.pixelStride;
+
+    for (int y = 0; y < dest.height; ++y)
+    {
+        const auto* row0 = src.getLinePointer (jmin (y * 2,     src.height - 1));
+        const auto* row1 = src.getLinePointer (jmin (y * 2 + 1, src.height - 1));
+        auto* d = dest.getLinePointer (y);
+
+        for (int x = 0; x < dest.width; ++x)
+        {
+            const auto x0 = x * 2 * stride;
+            const auto x1 = jmin (x * 2 + 1, src.width - 1) * stride;
+
+            for (int i = 0; i < stride; ++i)
+                *d++ = (uint8) ((row0[x0 + i] + row0[x1 + i] + row1[x0 + i] + row1[x1 + i] + 2) >> 2);
+        }
+    }
+
+    return result;
+}
+
+Image ImagePixelData::getMipMap (int level)
+{
+    jassert (level >= 0);
+
+    if (level <= 0)
+        return Image (this);
+
+    const ScopedLock sl (mipMapLock);
+
+    while ((int) mipMaps.size() < level)
+    {
+        const auto previous = mipMaps.empty() ? Image (this) : mipMaps.back();
+
+        if (previous.getWidth() == 1 && previous.getHeight() == 1)
+            return previous;
+
+        mipMaps.push_back (createHalfSizeImage (previous));
+    }
+
+    return mipMaps[(size_t) level - 1];
 }
 
 int ImagePixelData::getSharedCount() const noexcept
@@ -105,7 +178,7 @@ public:
         bitmap.pixelStride = pixelStride;
 
         if (mode != Image::BitmapData::readOnly)
-            sendDataChangeMessage();
+            sendDataChangeMessage ({ x, y, bitmap.width, bitmap.height });
     }
 
     ImagePixelData::Ptr clone() override
@@ -176,7 +249,7 @@ public:
         sourceImage->initialiseBitmapData (bitmap, x + area.getX(), y + area.getY(), mode);
 
         if (mode != Image::BitmapData::readOnly)
-            sendDataChangeMessage();
+            sendDataChangeMessage ({ x, y, bitmap.width, bitmap.height });
     }
 
     ImagePixelData::Ptr clone() override
@@ -684,6 +757,81 @@ void Image::moveImageSection (int dx, int dy,
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ImageMipMapTests final : public UnitTest
+{
+public:
+    ImageMipMapTests()
+        : UnitTest ("Image mip-maps", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Each level halves the size of the one before it");
+        {
+            Image image (Image::ARGB, 9, 5, true, SoftwareImageType());
+            auto* data = image.getPixelData();
+
+            expect (data->getMipMap (0).getPixelData() == data);
+            expect (data->getMipMap (1).getBounds() == Rectangle<int> (4, 2));
+            expect (data->getMipMap (2).getBounds() == Rectangle<int> (2, 1));
+            expect (data->getMipMap (3).getBounds() == Rectangle<int> (1, 1));
+            expect (data->getMipMap (10).getBounds() == Rectangle<int> (1, 1));
+        }
+
+        beginTest ("Each pixel is the average of a block of four");
+        {
+            Image image (Image::ARGB, 2, 2, true, SoftwareImageType());
+            image.setPixelAt (0, 0, Colour (0xff000000));
+            image.setPixelAt (1, 0, Colour (0xffffffff));
+            image.setPixelAt (0, 1, Colour (0xff404040));
+            image.setPixelAt (1, 1, Colour (0xff808080));
+
+            expect (image.getPixelData()->getMipMap (1).getPixelAt (0, 0) == Colour (0xff707070));
+        }
+
+        beginTest ("The levels are regenerated after the image is modified");
+        {
+            Image image (Image::RGB, 8, 8, true, SoftwareImageType());
+            auto* data = image.getPixelData();
+            expect (data->getMipMap (2).getPixelAt (0, 0) == Colours::black);
+
+            image.clear (image.getBounds(), Colours::white);
+            expect (data->getMipMap (2).getPixelAt (0, 0) == Colours::white);
+        }
+
+        beginTest ("Drawing an image at a small scale uses its mip-maps");
+        {
+            // without mip-maps, every sample would land on the black gaps between the stripes
+            Image stripes (Image::RGB, 64, 64, false, SoftwareImageType());
+
+            for (int y = 0; y < stripes.getHeight(); ++y)
+                for (int x = 0; x < stripes.getWidth(); ++x)
+                    stripes.setPixelAt (x, y, x % 4 == 0 ? Colours::white : Colours::black);
+
+            stripes.getPixelData()->setMipMapsEnabled (true);
+
+            Image dest (Image::RGB, 16, 16, true, SoftwareImageType());
+
+            {
+                Graphics g (dest);
+                g.setImageResamplingQuality (Graphics::highResamplingQuality);
+                g.drawImageTransformed (stripes, AffineTransform::scale (0.25f));
+            }
+
+            for (int y = 0; y < dest.getHeight(); ++y)
+                for (int x = 0; x < dest.getWidth(); ++x)
+                    expectWithinAbsoluteError ((int) dest.getPixelAt (x, y).getRed(), 64, 2);
+        }
+    }
+};
+
+static ImageMipMapTests imageMipMapTests;
+
+#endif
+
 //==============================================================================
 #if JUCE_ALLOW_STATIC_NULL_VARIABLES
 
@@ -481,13 +481,53 @@ public:
 
         virtual void imageDataChanged (ImagePixelData*) = 0;
         virtual void imageDataBeingDeleted (ImagePixelData*) = 0;
+
+        /** Called when only part of the image may have changed.
+
+            Listeners which keep a copy of the pixels, e.g. as a GPU texture, can override
+            this to update just that area. By default it calls imageDataChanged().
+        */
+        virtual void imageAreaChanged (ImagePixelData* data, Rectangle<int> /*changedArea*/)   { imageDataChanged (data); }
     };
 
     ListenerList<Listener> listeners;
 
+    /** Tells the listeners that the whole image may have changed. */
     void sendDataChangeMessage();
 
+    /** Tells the listeners that the given area of the image may have changed. */
+    void sendDataChangeMessage (Rectangle<int> changedArea);
+
+    //==============================================================================
+    /** Enables or disables mip-mapping for this image.
+
+        When it's enabled, the software renderer draws the image from a copy that has been
+        halved in size one or more times whenever it's drawn at less than half its size using
+        medium or high resampling quality. This reads far fewer pixels and avoids aliasing when
+        large images are shown at a small scale, e.g. on a display with a scale factor below 1.
+
+        The smaller copies are made when they're first needed and are thrown away whenever the
+        image is modified. Mip-mapping is disabled by default, as the copies can use up to a
+        third as much memory again as the image itself.
+    */
+    void setMipMapsEnabled (bool shouldBeEnabled);
+
+    /** Returns true if mip-mapping has been turned on with setMipMapsEnabled(). */
+    bool areMipMapsEnabled() const noexcept             { return mipMapsEnabled; }
+
+    /** Returns a copy of this image which has been halved in size the given number of times.
+
+        Level 0 is this image itself. Each level is at least one pixel wide and high, so asking
+        for a level beyond that just returns the smallest one. The levels are kept until the
+        image is next modified, whether or not mip-mapping is enabled.
+    */
+    Image getMipMap (int level);
+
 private:
+    std::atomic<bool> mipMapsEnabled { false };
+    CriticalSection mipMapLock;
+    std::vector<Image> mipMaps;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImagePixelData)
 };
 
@@ -34,6 +34,10 @@ struct ImageCache::Pimpl     : private Timer,
     ~Pimpl() override
     {
         stopTimer();
+
+        if (loaderPool != nullptr)
+            loaderPool->removeAllJobs (false, 10000);
+
         clearSingletonInstance();
     }
 
@@ -48,10 +52,13 @@ struct ImageCache::Pimpl     : private Timer,
             if (item.hashCode == hashCode)
             {
                 item.lastUseTime = Time::getApproximateMillisecondCounter();
+                item.lastUseOrder = ++useCounter;
+                ++numHits;
                 return item.image;
             }
         }
 
+        ++numMisses;
         return {};
      }
 
@@ -63,7 +70,9 @@ struct ImageCache::Pimpl     : private Timer,
                 startTimer (2000);
 
             const ScopedLock sl (lock);
-            images.add ({ image, hashCode, Time::getApproximateMillisecondCounter() });
+            images.add ({ image, hashCode, Time::getApproximateMillisecondCounter(), ++useCounter });
+            totalBytes += getSizeInBytes (image);
+            applySizeLimit();
         }
     }
 
@@ -80,7 +89,7 @@ struct ImageCache::Pimpl     : private Timer,
             if (item.image.getReferenceCount() <= 1)
             {
                 if (now > item.lastUseTime + cacheTimeout || now < item.lastUseTime - 1000)
-                    images.remove (i);
+                    removeItem (i);
             }
             else
             {
@@ -98,19 +107,138 @@ struct ImageCache::Pimpl     : private Timer,
 
         for (int i = images.size(); --i >= 0;)
             if (images.getReference (i).image.getReferenceCount() <= 1)
-                images.remove (i);
+                removeItem (i);
+    }
+
+    void setMaximumSizeInBytes (size_t newMaximum)
+    {
+        const ScopedLock sl (lock);
+        maximumBytes = newMaximum;
+        applySizeLimit();
+    }
+
+    ImageCache::Statistics getStatistics() const
+    {
+        const ScopedLock sl (lock);
+        return { images.size(), totalBytes, numHits, numMisses };
+    }
+
+    //==============================================================================
+    Image getAsync (int64 hashCode, std::function<Image()> load, std::function<void (const Image&)> onLoaded)
+    {
+        auto image = getFromHashCode (hashCode);
+
+        if (image.isValid())
+            return image;
+
+        const ScopedLock sl (lock);
+        auto& callbacks = pendingLoads[hashCode];
+        const auto isAlreadyLoading = ! callbacks.empty();
+        callbacks.push_back (std::move (onLoaded));
+
+        if (! isAlreadyLoading)
+        {
+            if (loaderPool == nullptr)
+                loaderPool = std::make_unique<ThreadPool> (ThreadPoolOptions{}.withThreadName ("ImageCache loader")
+                                                                              .withNumberOfThreads (2));
+
+            loaderPool->addJob ([hashCode, load = std::move (load)]
+            {
+                auto loaded = load();
+
+                MessageManager::callAsync ([hashCode, loaded]
+                {
+                    if (auto* instance = getInstanceWithoutCreating())
+                        instance->finishLoading (hashCode, loaded);
+                });
+            });
+        }
+
+        return {};
     }
 
+    void finishLoading (int64 hashCode, const Image& image)
+    {
+        std::vector<std::function<void (const Image&)>> callbacks;
+
+        {
+            const ScopedLock sl (lock);
+            const auto iter = pendingLoads.find (hashCode);
+
+            if (iter == pendingLoads.end())
+                return;
+
+            callbacks = std::move (iter->second);
+            pendingLoads.erase (iter);
+        }
+
+        addImageToCache (image, hashCode);
+
+        for (auto& callback : callbacks)
+            NullCheckedInvocation::invoke (callback, image);
+    }
+
+    //==============================================================================
     struct Item
     {
         Image image;
         int64 hashCode;
         uint32 lastUseTime;
+        uint64 lastUseOrder;
     };
 
+    static size_t getSizeInBytes (const Image& image)
+    {
+        const auto bytesPerPixel = image.getFormat() == Image::ARGB ? 4
+                                 : image.getFormat() == Image::RGB  ? 3 : 1;
+
+        return (size_t) image.getWidth() * (size_t) image.getHeight() * (size_t) bytesPerPixel;
+    }
+
+    void removeItem (int index)
+    {
+        totalBytes -= getSizeInBytes (images.getReference (index).image);
+        images.remove (index);
+    }
+
+    void applySizeLimit()
+    {
+        if (maximumBytes == 0 || totalBytes <= maximumBytes)
+            return;
+
+        // Releases the least recently used images that nothing else is holding onto
+        std::vector<std::pair<uint64, int64>> candidates;
+
+        for (auto& item : images)
+            if (item.image.getReferenceCount() <= 1)
+                candidates.emplace_back (item.lastUseOrder, item.hashCode);
+
+        std::sort (candidates.begin(), candidates.end());
+
+        for (const auto& candidate : candidates)
+        {
+            if (totalBytes <= maximumBytes)
+                break;
+
+            for (int i = images.size(); --i >= 0;)
+            {
+                if (images.getReference (i).lastUseOrder == candidate.first)
+                {
+                    removeItem (i);
+                    break;
+                }
+            }
+        }
+    }
+
     Array<Item> images;
+    std::map<int64, std::vector<std::function<void (const Image&)>>> pendingLoads;
+    std::unique_ptr<ThreadPool> loaderPool;
     CriticalSection lock;
     unsigned int cacheTimeout = 5000;
+    size_t totalBytes = 0, maximumBytes = 0;
+    uint64 useCounter = 0;
+    int64 numHits = 0, numMisses = 0;
 
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
@@ -121,10 +249,7 @@ JUCE_IMPLEMENT_SINGLETON (ImageCache::Pimpl)
 //==============================================================================
 Image ImageCache::getFromHashCode (const int64 hashCode)
 {
-    if (Pimpl::getInstanceWithoutCreating() != nullptr)
-        return Pimpl::getInstanceWithoutCreating()->getFromHashCode (hashCode);
-
-    return {};
+    return Pimpl::getInstance()->getFromHashCode (hashCode);
 }
 
 void ImageCache::addImageToCache (const Image& image, const int64 hashCode)
@@ -160,6 +285,21 @@ Image ImageCache::getFromMemory (const void* imageData, const int dataSize)
     return image;
 }
 
+Image ImageCache::getFromFileAsync (const File& file, std::function<void (const Image&)> onLoaded)
+{
+    return Pimpl::getInstance()->getAsync (file.hashCode64(),
+                                           [file] { return ImageFileFormat::loadFrom (file); },
+                                           std::move (onLoaded));
+}
+
+Image ImageCache::getFromMemoryAsync (const void* imageData, const int dataSize,
+                                      std::function<void (const Image&)> onLoaded)
+{
+    return Pimpl::getInstance()->getAsync ((int64) (pointer_sized_int) imageData,
+                                           [imageData, dataSize] { return ImageFileFormat::loadFrom (imageData, (size_t) dataSize); },
+                                           std::move (onLoaded));
+}
+
 void ImageCache::setCacheTimeout (const int millisecs)
 {
     jassert (millisecs >= 0);
@@ -171,4 +311,66 @@ void ImageCache::releaseUnusedImages()
     Pimpl::getInstance()->releaseUnusedImages();
 }
 
+void ImageCache::setMaximumCacheSizeInBytes (size_t maxNumBytes)
+{
+    Pimpl::getInstance()->setMaximumSizeInBytes (maxNumBytes);
+}
+
+ImageCache::Statistics ImageCache::getStatistics()
+{
+    return Pimpl::getInstance()->getStatistics();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ImageCacheTests final : public UnitTest
+{
+public:
+    ImageCacheTests()
+        : UnitTest ("ImageCache", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Unused images are released when the cache is over its size limit");
+        {
+            ImageCache::releaseUnusedImages();
+            const auto initial = ImageCache::getStatistics();
+
+            const int64 firstHash = 0x1234567800;
+            const auto imageBytes = (size_t) 16 * 16 * 4;
+
+            Image inUse (Image::ARGB, 16, 16, true);
+            ImageCache::addImageToCache (inUse, firstHash);
+
+            for (int64 i = 1; i < 4; ++i)
+                ImageCache::addImageToCache (Image (Image::ARGB, 16, 16, true), firstHash + i);
+
+            expectEquals ((int) ImageCache::getStatistics().sizeInBytes, (int) (initial.sizeInBytes + 4 * imageBytes));
+
+            expect (ImageCache::getFromHashCode (firstHash + 1).isValid());
+            expect (! ImageCache::getFromHashCode (firstHash + 100).isValid());
+
+            ImageCache::setMaximumCacheSizeInBytes (initial.sizeInBytes + 2 * imageBytes);
+
+            expect (ImageCache::getFromHashCode (firstHash).isValid(), "Images in use are kept");
+            expect (ImageCache::getFromHashCode (firstHash + 1).isValid(), "Recently used images are kept");
+            expect (! ImageCache::getFromHashCode (firstHash + 2).isValid());
+            expect (! ImageCache::getFromHashCode (firstHash + 3).isValid());
+
+            const auto stats = ImageCache::getStatistics();
+            expectEquals (stats.numHits - initial.numHits, (int64) 3);
+            expectEquals (stats.numMisses - initial.numMisses, (int64) 3);
+
+            ImageCache::setMaximumCacheSizeInBytes (0);
+            ImageCache::releaseUnusedImages();
+        }
+    }
+};
+
+static ImageCacheTests imageCacheTests;
+
+#endif
+
 } // namespace juce
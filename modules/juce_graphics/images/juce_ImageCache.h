@@ -39,6 +39,10 @@ namespace juce
     loading/deleting the same image, it'll reduce the chances of having to reload it
     each time.
 
+    Images can also be decoded on a background thread with getFromFileAsync() and
+    getFromMemoryAsync(), and the amount of memory used by images that nothing else
+    is using can be limited with setMaximumCacheSizeInBytes().
+
     @see Image, ImageFileFormat
 
     @tags{Graphics}
@@ -80,6 +84,34 @@ public:
     */
     static Image getFromMemory (const void* imageData, int dataSize);
 
+    //==============================================================================
+    /** Returns a cached image for a file, or starts loading it on a background thread.
+
+        If the image is already in the cache, it's returned straight away and the callback
+        won't be called. Otherwise, this returns an invalid image which can be treated as a
+        placeholder. The file is then decoded on a background thread and added to the cache,
+        after which the callback is called on the message thread with the result, which will
+        be an invalid image if the file couldn't be loaded.
+
+        If the same file is requested again while it's still loading, it'll only be decoded
+        once, and all of the callbacks will be called when it's ready.
+
+        @see getFromFile, getFromMemoryAsync
+    */
+    static Image getFromFileAsync (const File& file, std::function<void (const Image&)> onLoaded);
+
+    /** Returns a cached image for a block of image file data, or starts loading it on a
+        background thread.
+
+        This works in the same way as getFromFileAsync(). The data must remain valid until
+        the callback has been called, so it's best suited to images that are embedded in
+        the binary.
+
+        @see getFromMemory, getFromFileAsync
+    */
+    static Image getFromMemoryAsync (const void* imageData, int dataSize,
+                                     std::function<void (const Image&)> onLoaded);
+
     //==============================================================================
     /** Checks the cache for an image with a particular hashcode.
 
@@ -113,6 +145,32 @@ public:
     */
     static void releaseUnusedImages();
 
+    /** Limits the amount of memory used by the images in the cache.
+
+        Whenever an image is added and the total size of the cached images is above this
+        limit, the least recently used images that aren't being referenced by any other Image
+        objects are released until it's within the limit again. Images that are still in use
+        are never released, so the limit may be exceeded if they alone are larger than it.
+
+        A value of 0, which is the default, means that there's no limit, and images are only
+        released after the cache timeout.
+
+        @see setCacheTimeout
+    */
+    static void setMaximumCacheSizeInBytes (size_t maxNumBytes);
+
+    /** Some statistics about the use of the cache. */
+    struct Statistics
+    {
+        int numImages = 0;          /**< The number of images currently in the cache. */
+        size_t sizeInBytes = 0;     /**< The approximate size of the pixel data of these images. */
+        int64 numHits = 0;          /**< The number of look-ups that found an image in the cache. */
+        int64 numMisses = 0;        /**< The number of look-ups that didn't find an image in the cache. */
+    };
+
+    /** Returns the current statistics for the cache. */
+    static Statistics getStatistics();
+
 private:
     //==============================================================================
     struct Pimpl;
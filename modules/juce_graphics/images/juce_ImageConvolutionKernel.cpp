@@ -101,6 +101,116 @@ void ImageConvolutionKernel::createGaussianBlur (const float radius)
     setOverallSum (1.0f);
 }
 
+//==============================================================================
+/*  If the kernel is the outer product of a column and a row vector, as gaussian and box
+    blurs are, finds those vectors so that the kernel can be applied as two 1D passes.
+*/
+static bool findSeparableFactors (const float* values, int size,
+                                  std::vector<float>& rowFactors, std::vector<float>& columnFactors)
+{
+    int pivot = 0;
+
+    for (int i = 1; i < size * size; ++i)
+        if (std::abs (values[i]) > std::abs (values[pivot]))
+            pivot = i;
+
+    const auto pivotValue = values[pivot];
+
+    if (exactlyEqual (pivotValue, 0.0f))
+        return false;
+
+    const auto pivotX = pivot % size;
+    const auto pivotY = pivot / size;
+
+    rowFactors.resize ((size_t) size);
+    columnFactors.resize ((size_t) size);
+
+    for (int i = 0; i < size; ++i)
+    {
+        rowFactors[(size_t) i] = values[i + pivotY * size];
+        columnFactors[(size_t) i] = values[pivotX + i * size] / pivotValue;
+    }
+
+    const auto tolerance = std::abs (pivotValue) * 1.0e-5f;
+
+    for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x)
+            if (std::abs (values[x + y * size] - columnFactors[(size_t) y] * rowFactors[(size_t) x]) > tolerance)
+                return false;
+
+    return true;
+}
+
+/*  Applies a separable kernel with a horizontal pass into a float buffer, followed by a
+    vertical pass. Pixels outside the source image are treated as zero, as they are in the
+    2D convolution, and the inner loops run over contiguous channel values so that they
+    can be vectorised.
+*/
+static void applySeparableKernel (const Image::BitmapData& destData, const Image::BitmapData& srcData,
+                                  Rectangle<int> area, const std::vector<float>& rowFactors,
+                                  const std::vector<float>& columnFactors)
+{
+    const auto size = (int) rowFactors.size();
+    const auto half = size >> 1;
+    const auto pixelStride = destData.pixelStride;
+    const auto rowLength = area.getWidth() * pixelStride;
+
+    const auto firstSourceRow = jmax (0, area.getY() - half);
+    const auto endSourceRow = jmin (srcData.height, area.getBottom() - half + size - 1);
+    const auto numSourceRows = jmax (0, endSourceRow - firstSourceRow);
+
+    std::vector<float> horizontal ((size_t) (numSourceRows * rowLength));
+
+    for (int row = 0; row < numSourceRows; ++row)
+    {
+        const auto* srcLine = srcData.getLinePointer (firstSourceRow + row);
+        auto* out = horizontal.data() + row * rowLength;
+
+        for (int xx = 0; xx < size; ++xx)
+        {
+            const auto k = rowFactors[(size_t) xx];
+            const auto offset = area.getX() + xx - half;
+            const auto start = jmax (0, -offset);
+            const auto end = jmin (area.getWidth(), srcData.width - offset);
+
+            if (exactlyEqual (k, 0.0f) || start >= end)
+                continue;
+
+            const auto* src = srcLine + (offset + start) * pixelStride;
+            auto* dest = out + start * pixelStride;
+
+            for (int i = 0; i < (end - start) * pixelStride; ++i)
+                dest[i] += k * (float) src[i];
+        }
+    }
+
+    std::vector<float> sum ((size_t) rowLength);
+
+    for (int y = area.getY(); y < area.getBottom(); ++y)
+    {
+        std::fill (sum.begin(), sum.end(), 0.0f);
+
+        for (int yy = 0; yy < size; ++yy)
+        {
+            const auto k = columnFactors[(size_t) yy];
+            const auto row = y + yy - half - firstSourceRow;
+
+            if (exactlyEqual (k, 0.0f) || ! isPositiveAndBelow (row, numSourceRows))
+                continue;
+
+            const auto* src = horizontal.data() + row * rowLength;
+
+            for (int i = 0; i < rowLength; ++i)
+                sum[(size_t) i] += k * src[i];
+        }
+
+        auto* dest = destData.getLinePointer (y - area.getY());
+
+        for (int i = 0; i < rowLength; ++i)
+            dest[i] = (uint8) jlimit (0, 0xff, roundToInt (sum[(size_t) i]));
+    }
+}
+
 //==============================================================================
 void ImageConvolutionKernel::applyToImage (Image& destImage,
                                            const Image& sourceImage,
@@ -135,6 +245,14 @@ void ImageConvolutionKernel::applyToImage (Image& destImage,
 
     const Image::BitmapData srcData (sourceImage, Image::BitmapData::readOnly);
 
+    std::vector<float> rowFactors, columnFactors;
+
+    if (findSeparableFactors (values, size, rowFactors, columnFactors))
+    {
+        applySeparableKernel (destData, srcData, area, rowFactors, columnFactors);
+        return;
+    }
+
     if (destData.pixelStride == 4)
     {
         for (int y = area.getY(); y < bottom; ++y)
@@ -279,7 +397,7 @@ void ImageConvolutionKernel::applyToImage (Image& destImage,
                             }
                             else
                             {
-                                src += 3;
+                                ++src;
                             }
 
                             ++sx;
@@ -293,4 +411,104 @@ void ImageConvolutionKernel::applyToImage (Image& destImage,
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ImageConvolutionKernelTests final : public UnitTest
+{
+public:
+    ImageConvolutionKernelTests()
+        : UnitTest ("ImageConvolutionKernel", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Separable kernels give the same result as a 2D convolution");
+        {
+            ImageConvolutionKernel kernel (7);
+            kernel.createGaussianBlur (2.5f);
+            kernel.rescaleAllValues (1.5f);
+
+            for (auto format : { Image::ARGB, Image::RGB, Image::SingleChannel })
+                expectMatchesReference (kernel, createRandomImage (format, 37, 23, random),
+                                        { -3, 4, 30, 30 });
+        }
+
+        beginTest ("Other kernels give the same result as a 2D convolution");
+        {
+            ImageConvolutionKernel kernel (3);
+
+            for (int y = 0; y < 3; ++y)
+                for (int x = 0; x < 3; ++x)
+                    kernel.setKernelValue (x, y, (x + y) % 2 == 0 ? 0.15f : 0.05f);
+
+            for (auto format : { Image::ARGB, Image::RGB, Image::SingleChannel })
+                expectMatchesReference (kernel, createRandomImage (format, 19, 17, random),
+                                        { 0, 0, 19, 17 });
+        }
+    }
+
+private:
+    static Image createRandomImage (Image::PixelFormat format, int width, int height, Random& random)
+    {
+        Image image (format, width, height, false);
+        const Image::BitmapData data (image, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+            for (int i = 0; i < width * data.pixelStride; ++i)
+                data.getLinePointer (y)[i] = (uint8) random.nextInt (256);
+
+        return image;
+    }
+
+    void expectMatchesReference (const ImageConvolutionKernel& kernel, const Image& source, Rectangle<int> area)
+    {
+        Image dest (source.getFormat(), source.getWidth(), source.getHeight(), true);
+        kernel.applyToImage (dest, source, area);
+
+        const Image::BitmapData srcData (source, Image::BitmapData::readOnly);
+        const Image::BitmapData destData (dest, Image::BitmapData::readOnly);
+        const auto size = kernel.getKernelSize();
+        const auto clipped = area.getIntersection (source.getBounds());
+        int maxError = 0;
+
+        for (int y = 0; y < source.getHeight(); ++y)
+        {
+            for (int x = 0; x < source.getWidth(); ++x)
+            {
+                for (int c = 0; c < srcData.pixelStride; ++c)
+                {
+                    double expected = 0.0;
+
+                    if (clipped.contains (x, y))
+                    {
+                        for (int yy = 0; yy < size; ++yy)
+                        {
+                            for (int xx = 0; xx < size; ++xx)
+                            {
+                                const auto sx = x + xx - size / 2;
+                                const auto sy = y + yy - size / 2;
+
+                                if (isPositiveAndBelow (sx, source.getWidth()) && isPositiveAndBelow (sy, source.getHeight()))
+                                    expected += kernel.getKernelValue (xx, yy) * srcData.getPixelPointer (sx, sy)[c];
+                            }
+                        }
+                    }
+
+                    const auto actual = (int) destData.getPixelPointer (x, y)[c];
+                    maxError = jmax (maxError, std::abs (actual - jlimit (0, 255, roundToInt (expected))));
+                }
+            }
+        }
+
+        expectLessOrEqual (maxError, 1);
+    }
+};
+
+static ImageConvolutionKernelTests imageConvolutionKernelTests;
+
+#endif
+
 } // namespace juce
@@ -186,6 +186,15 @@ public:
     */
     void setQuality (float newQuality);
 
+    /** Makes decodeImage() return an image that is smaller than the original by the given factor.
+
+        The factor must be 1, 2, 4 or 8. The image is scaled down while it's being decoded,
+        which is much quicker and uses far less memory than decoding it at full size and
+        then rescaling it. On platforms that use CoreImage to load JPEGs, the image is
+        decoded at full size and rescaled afterwards.
+    */
+    void setDownscaleFactor (int factor);
+
     //==============================================================================
     String getFormatName() override;
     bool usesFileExtension (const File&) override;
@@ -195,6 +204,7 @@ public:
 
 private:
     float quality;
+    int downscaleFactor = 1;
 };
 
 //==============================================================================
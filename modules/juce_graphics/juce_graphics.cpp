@@ -98,6 +98,13 @@
 
 #undef SIZEOF
 
+#if JUCE_SPAN_BLENDING_SSE2
+ #include <emmintrin.h>
+ #include <immintrin.h>
+#elif JUCE_SPAN_BLENDING_NEON
+ #include <arm_neon.h>
+#endif
+
 #if (JUCE_MAC || JUCE_IOS) && USE_COREGRAPHICS_RENDERING && JUCE_USE_COREIMAGE_LOADER
  #define JUCE_USING_COREIMAGE_LOADER 1
 #else
@@ -115,9 +122,15 @@
 #include "geometry/juce_PathIterator.cpp"
 #include "geometry/juce_PathStrokeType.cpp"
 #include "placement/juce_RectanglePlacement.cpp"
+#include "native/juce_SpanBlending.cpp"
+#include "native/juce_GlyphAtlas.cpp"
+#include "native/juce_PathCache.cpp"
+#include "fonts/juce_ShapedTextCache.h"
 #include "contexts/juce_GraphicsContext.cpp"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.cpp"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.cpp"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.cpp"
+#include "contexts/juce_DisplayList.cpp"
 #include "images/juce_Image.cpp"
 #include "images/juce_ImageCache.cpp"
 #include "images/juce_ImageConvolutionKernel.cpp"
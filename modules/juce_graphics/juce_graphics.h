@@ -87,6 +87,15 @@
  #define JUCE_DISABLE_COREGRAPHICS_FONT_SMOOTHING 0
 #endif
 
+/** Config: JUCE_USE_SIMD_SPAN_BLENDING
+
+    Enables SSE2/AVX2 or NEON code paths in the software renderer for blending runs of
+    pixels in solid colour, gradient and image fills. The output is identical either way.
+*/
+#ifndef JUCE_USE_SIMD_SPAN_BLENDING
+ #define JUCE_USE_SIMD_SPAN_BLENDING 1
+#endif
+
 #ifndef JUCE_INCLUDE_PNGLIB_CODE
  #define JUCE_INCLUDE_PNGLIB_CODE 1
 #endif
@@ -142,9 +151,14 @@ namespace juce
 #include "images/juce_Image.h"
 #include "images/juce_ScaledImage.h"
 #include "colour/juce_FillType.h"
+#include "native/juce_SpanBlending.h"
+#include "native/juce_GlyphAtlas.h"
+#include "native/juce_PathCache.h"
 #include "native/juce_RenderingHelpers.h"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.h"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.h"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.h"
+#include "contexts/juce_DisplayList.h"
 #include "effects/juce_ImageEffectFilter.h"
 #include "effects/juce_DropShadowEffect.h"
 #include "effects/juce_GlowEffect.h"
@@ -65,6 +65,12 @@ StringArray FTTypefaceList::getDefaultFontDirectories()
     return StringArray ("/system/fonts");
 }
 
+File FTTypefaceList::getFontIndexFile()
+{
+    // The system fonts are few enough to be scanned directly
+    return {};
+}
+
 Typeface::Ptr Typeface::createSystemTypefaceFor (const Font& font)
 {
     return new FreeTypeTypeface (font);
@@ -83,11 +83,151 @@ struct FTFaceWrapper final : public ReferenceCountedObject
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FTFaceWrapper)
 };
 
+//==============================================================================
+/*  An on-disk record of the faces in each font file, which allows the font directories
+    to be enumerated without opening every file with FreeType.
+
+    Entries are keyed by the font file's path, and are only used while the file's size
+    and modification time still match the ones that were recorded.
+*/
+class FontIndex
+{
+public:
+    struct Face
+    {
+        int faceIndex = 0;
+        String family, style;
+        bool isMonospaced = false;
+    };
+
+    explicit FontIndex (const File& fileToUse)
+        : indexFile (fileToUse)
+    {
+        load();
+    }
+
+    /** Returns the faces recorded for this font file, or nullptr if it needs to be scanned. */
+    const std::vector<Face>* findFaces (const File& fontFile)
+    {
+        const auto path = fontFile.getFullPathName();
+        const auto iter = savedEntries.find (path);
+
+        if (iter == savedEntries.end()
+             || iter->second.modificationTime != fontFile.getLastModificationTime().toMilliseconds()
+             || iter->second.size != fontFile.getSize())
+            return nullptr;
+
+        return &(currentEntries[path] = iter->second).faces;
+    }
+
+    void addFaces (const File& fontFile, std::vector<Face> faces)
+    {
+        auto& entry = currentEntries[fontFile.getFullPathName()];
+        entry.modificationTime = fontFile.getLastModificationTime().toMilliseconds();
+        entry.size = fontFile.getSize();
+        entry.faces = std::move (faces);
+        needsSaving = true;
+    }
+
+    /** Writes the entries for all the files that have been looked up, if anything has changed. */
+    void save()
+    {
+        if (indexFile == File() || ! (needsSaving || currentEntries.size() != savedEntries.size()))
+            return;
+
+        MemoryOutputStream out;
+        out.write (magic, sizeof (magic));
+        out.writeCompressedInt ((int) currentEntries.size());
+
+        for (const auto& [path, entry] : currentEntries)
+        {
+            out.writeString (path);
+            out.writeInt64 (entry.modificationTime);
+            out.writeInt64 (entry.size);
+            out.writeCompressedInt ((int) entry.faces.size());
+
+            for (const auto& face : entry.faces)
+            {
+                out.writeCompressedInt (face.faceIndex);
+                out.writeString (face.family);
+                out.writeString (face.style);
+                out.writeBool (face.isMonospaced);
+            }
+        }
+
+        // Another process may be reading the index, so it's replaced rather than rewritten
+        if (indexFile.getParentDirectory().createDirectory())
+        {
+            TemporaryFile temp (indexFile);
+
+            if (temp.getFile().replaceWithData (out.getData(), out.getDataSize()))
+                temp.overwriteTargetFileWithTemporary();
+        }
+
+        savedEntries = currentEntries;
+        needsSaving = false;
+    }
+
+private:
+    struct Entry
+    {
+        int64 modificationTime = 0, size = 0;
+        std::vector<Face> faces;
+    };
+
+    static constexpr char magic[] = { 'J', 'F', 'I', 1 };
+
+    void load()
+    {
+        if (! indexFile.existsAsFile())
+            return;
+
+        MemoryMappedFile mappedFile (indexFile, MemoryMappedFile::readOnly);
+
+        if (mappedFile.getData() == nullptr || mappedFile.getSize() < sizeof (magic)
+             || memcmp (mappedFile.getData(), magic, sizeof (magic)) != 0)
+            return;
+
+        MemoryInputStream in (addBytesToPointer (mappedFile.getData(), sizeof (magic)),
+                              mappedFile.getSize() - sizeof (magic), false);
+
+        for (auto numEntries = in.readCompressedInt(); --numEntries >= 0 && ! in.isExhausted();)
+        {
+            const auto path = in.readString();
+            Entry entry;
+            entry.modificationTime = in.readInt64();
+            entry.size = in.readInt64();
+
+            for (auto numFaces = in.readCompressedInt(); --numFaces >= 0 && ! in.isExhausted();)
+            {
+                Face face;
+                face.faceIndex = in.readCompressedInt();
+                face.family = in.readString();
+                face.style = in.readString();
+                face.isMonospaced = in.readBool();
+                entry.faces.push_back (std::move (face));
+            }
+
+            savedEntries[path] = std::move (entry);
+        }
+
+        // A truncated index can't be trusted
+        if (in.getPosition() != in.getTotalLength())
+            savedEntries.clear();
+    }
+
+    const File indexFile;
+    std::map<String, Entry> savedEntries, currentEntries;
+    bool needsSaving = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FontIndex)
+};
+
 //==============================================================================
 class FTTypefaceList final : private DeletedAtShutdown
 {
 public:
-    FTTypefaceList()  : library (new FTLibWrapper())
+    FTTypefaceList()  : library (new FTLibWrapper()), fontIndex (getFontIndexFile())
     {
         scanFontPaths (getDefaultFontDirectories());
     }
@@ -100,12 +240,12 @@ public:
     //==============================================================================
     struct KnownTypeface
     {
-        KnownTypeface (const File& f, int index, const FTFaceWrapper& face)
+        KnownTypeface (const File& f, const FontIndex::Face& face)
            : file (f),
-             family (face.face->family_name),
-             style (face.face->style_name),
-             faceIndex (index),
-             isMonospaced ((face.face->face_flags & FT_FACE_FLAG_FIXED_WIDTH) != 0),
+             family (face.family),
+             style (face.style),
+             faceIndex (face.faceIndex),
+             isMonospaced (face.isMonospaced),
              isSansSerif (isFaceSansSerif (family))
         {
         }
@@ -190,6 +330,8 @@ public:
             }
         }
 
+        fontIndex.save();
+
         std::sort (faces.begin(), faces.end(), [] (const auto* a, const auto* b)
         {
             const auto tie = [] (const KnownTypeface& t)
@@ -254,11 +396,22 @@ public:
 private:
     FTLibWrapper::Ptr library;
     OwnedArray<KnownTypeface> faces;
+    FontIndex fontIndex;
 
     static StringArray getDefaultFontDirectories();
+    static File getFontIndexFile();
 
     void scanFont (const File& file)
     {
+        if (auto* indexedFaces = fontIndex.findFaces (file))
+        {
+            for (const auto& face : *indexedFaces)
+                faces.add (new KnownTypeface (file, face));
+
+            return;
+        }
+
+        std::vector<FontIndex::Face> newFaces;
         int faceIndex = 0;
         int numFaces = 0;
 
@@ -272,12 +425,23 @@ private:
                     numFaces = (int) face.face->num_faces;
 
                 if ((face.face->face_flags & FT_FACE_FLAG_SCALABLE) != 0)
-                    faces.add (new KnownTypeface (file, faceIndex, face));
+                {
+                    FontIndex::Face newFace;
+                    newFace.faceIndex = faceIndex;
+                    newFace.family = face.face->family_name;
+                    newFace.style = face.face->style_name;
+                    newFace.isMonospaced = (face.face->face_flags & FT_FACE_FLAG_FIXED_WIDTH) != 0;
+
+                    faces.add (new KnownTypeface (file, newFace));
+                    newFaces.push_back (std::move (newFace));
+                }
             }
 
             ++faceIndex;
         }
         while (faceIndex < numFaces);
+
+        fontIndex.addFaces (file, std::move (newFaces));
     }
 
     const KnownTypeface* matchTypeface (const String& familyName, const String& style) const noexcept
@@ -80,6 +80,16 @@ StringArray FTTypefaceList::getDefaultFontDirectories()
     return fontDirs;
 }
 
+File FTTypefaceList::getFontIndexFile()
+{
+    auto cacheHome = SystemStats::getEnvironmentVariable ("XDG_CACHE_HOME", {});
+
+    if (cacheHome.trimStart().isEmpty())
+        cacheHome = "~/.cache";
+
+    return File (cacheHome).getChildFile ("JUCE").getChildFile ("FontIndex");
+}
+
 Typeface::Ptr Typeface::createSystemTypefaceFor (const Font& font)
 {
     return new FreeTypeTypeface (font);
@@ -0,0 +1,436 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::RenderingHelpers
+{
+
+GlyphAtlas::Page::Page()
+{
+    data.calloc ((size_t) (pageSize * pageSize));
+}
+
+std::optional<Rectangle<int>> GlyphAtlas::Page::allocate (int width, int height) noexcept
+{
+    // Glyphs are packed onto shelves, with a pixel of space around each one so that
+    // neighbouring glyphs can't bleed into each other when they're scaled
+    const auto paddedWidth = width + 1, paddedHeight = height + 1;
+
+    if (shelfX + paddedWidth > pageSize)
+    {
+        shelfY += shelfHeight;
+        shelfX = shelfHeight = 0;
+    }
+
+    if (shelfY + paddedHeight > pageSize || paddedWidth > pageSize)
+        return {};
+
+    const Rectangle<int> area (shelfX, shelfY, width, height);
+    shelfX += paddedWidth;
+    shelfHeight = jmax (shelfHeight, paddedHeight);
+    return area;
+}
+
+//==============================================================================
+GlyphAtlas::GlyphAtlas() = default;
+
+GlyphAtlas::~GlyphAtlas()
+{
+    clearSingletonInstance();
+}
+
+JUCE_IMPLEMENT_SINGLETON (GlyphAtlas)
+
+size_t GlyphAtlas::KeyHash::operator() (const Key& key) const noexcept
+{
+    auto hash = std::hash<const void*>() (key.typeface.get());
+
+    for (auto h : { std::hash<float>() (key.height),
+                    std::hash<float>() (key.horizontalScale),
+                    std::hash<int>() (key.glyphNumber),
+                    std::hash<int>() (key.subpixelPosition),
+                    std::hash<int>() (key.levelMultiplier) })
+        hash = hash * 31 + h;
+
+    return hash;
+}
+
+std::optional<GlyphAtlas::Glyph> GlyphAtlas::getGlyph (const Font& font, int glyphNumber, Point<float> position,
+                                                       float levelMultiplier)
+{
+    // large glyphs would only waste space, so don't bother trying
+    if (font.getHeight() > (float) (pageSize / 4))
+        return {};
+
+    auto typeface = font.getTypefacePtr();
+
+    if (typeface == nullptr)
+        return {};
+
+    const auto subpixelPositions = typeface->isHinted() ? 1 : numSubpixelPositions;
+    const auto scaledX = std::floor (position.x * (float) subpixelPositions + 0.5f);
+    const auto x = (int) std::floor (scaledX / (float) subpixelPositions);
+    const auto subpixelPosition = (int) scaledX - x * subpixelPositions;
+
+    // EdgeTable::multiplyLevels() works in 1/256ths, so quantising the multiplier here doesn't change the result
+    Key key { typeface, font.getHeight(), font.getHorizontalScale(), glyphNumber,
+              subpixelPosition * (numSubpixelPositions / subpixelPositions), (int) (levelMultiplier * 256.0f) };
+
+    const ScopedLock sl (lock);
+
+    auto iter = glyphs.find (key);
+
+    if (iter == glyphs.end())
+        iter = glyphs.emplace (key, renderGlyph (key)).first;
+
+    const auto& cached = iter->second;
+
+    if (cached.isTooLarge)
+        return {};
+
+    if (cached.page != nullptr)
+        cached.page->lastUseCount = ++useCounter;
+
+    return Glyph { cached.page, cached.sourceArea, cached.offset + Point<int> (x, roundToInt (position.y)) };
+}
+
+GlyphAtlas::CachedGlyph GlyphAtlas::renderGlyph (const Key& key)
+{
+    const auto fontHeight = key.height;
+    const std::unique_ptr<EdgeTable> et (key.typeface->getEdgeTableForGlyph (key.glyphNumber,
+                                                                             AffineTransform::scale (fontHeight * key.horizontalScale, fontHeight),
+                                                                             fontHeight));
+
+    if (et == nullptr || et->isEmpty())
+        return {};
+
+    et->translate ((float) key.subpixelPosition / (float) numSubpixelPositions, 0);
+
+    if (key.levelMultiplier != 256)
+        et->multiplyLevels ((float) key.levelMultiplier / 256.0f);
+
+    // the sub-pixel offset may push coverage into the column to the right of the original bounds
+    const auto bounds = et->getMaximumBounds().withTrimmedRight (-1);
+
+    if (bounds.getWidth() > pageSize / 4 || bounds.getHeight() > pageSize / 4)
+        return { nullptr, {}, {}, true };
+
+    std::optional<Rectangle<int>> area;
+    Page::Ptr page;
+
+    if (! pages.isEmpty())
+    {
+        page = pages.getLast();
+        area = page->allocate (bounds.getWidth(), bounds.getHeight());
+    }
+
+    if (! area.has_value())
+    {
+        page = allocatePage();
+        area = page->allocate (bounds.getWidth(), bounds.getHeight());
+        jassert (area.has_value());
+    }
+
+    struct CoverageWriter
+    {
+        uint8* line = nullptr;
+        Page& page;
+        const Rectangle<int> area;
+        const Point<int> offset;
+
+        void setEdgeTableYPos (int y) noexcept
+        {
+            line = page.getWritableLinePointer (y + offset.y) + offset.x;
+        }
+
+        void handleEdgeTablePixel (int x, int alphaLevel) const noexcept
+        {
+            if (isPositiveAndBelow (x + offset.x - area.getX(), area.getWidth()))
+                line[x] = (uint8) alphaLevel;
+        }
+
+        void handleEdgeTablePixelFull (int x) const noexcept         { handleEdgeTablePixel (x, 255); }
+        void handleEdgeTableLineFull (int x, int width) const noexcept { handleEdgeTableLine (x, width, 255); }
+
+        void handleEdgeTableLine (int x, int width, int alphaLevel) const noexcept
+        {
+            while (--width >= 0)
+                handleEdgeTablePixel (x++, alphaLevel);
+        }
+    };
+
+    const auto offset = area->getPosition() - bounds.getPosition();
+    CoverageWriter writer { nullptr, *page, *area, offset };
+    et->iterate (writer);
+
+    return { page, *area, bounds.getPosition() };
+}
+
+GlyphAtlas::Page::Ptr GlyphAtlas::allocatePage()
+{
+    if (pages.size() >= maxNumPages)
+    {
+        auto* oldest = pages.getFirst().get();
+
+        for (auto* p : pages)
+            if (p->lastUseCount < oldest->lastUseCount)
+                oldest = p;
+
+        // anything that's still drawing from this page holds a reference to it, so it's
+        // safe to forget about it here
+        removePage (oldest);
+    }
+
+    return pages.add (new Page());
+}
+
+void GlyphAtlas::removePage (Page* page)
+{
+    for (auto i = glyphs.begin(); i != glyphs.end();)
+    {
+        if (i->second.page.get() == page)
+            i = glyphs.erase (i);
+        else
+            ++i;
+    }
+
+    pages.removeObject (page);
+}
+
+void GlyphAtlas::reset()
+{
+    const ScopedLock sl (lock);
+    glyphs.clear();
+    pages.clear();
+}
+
+void GlyphAtlas::setMaximumNumPages (int newMaximum)
+{
+    const ScopedLock sl (lock);
+    maxNumPages = jmax (1, newMaximum);
+
+    while (pages.size() > maxNumPages)
+        removePage (pages.getFirst());
+}
+
+int GlyphAtlas::getNumPages() const
+{
+    const ScopedLock sl (lock);
+    return pages.size();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class GlyphAtlasTests  : public UnitTest
+{
+public:
+    GlyphAtlasTests()
+        : UnitTest ("GlyphAtlas", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        auto& atlas = *GlyphAtlas::getInstance();
+        const Font font (createTypeface());
+
+        beginTest ("Cached coverage matches the glyph's edge table");
+        {
+            for (int i = 0; i < GlyphAtlas::numSubpixelPositions; ++i)
+            {
+                const auto x = 10.0f + (float) i / (float) GlyphAtlas::numSubpixelPositions;
+                const auto glyph = atlas.getGlyph (font.withHeight (20.0f), 'a', { x, 30.0f });
+
+                expect (glyph.has_value() && glyph->page != nullptr && ! glyph->sourceArea.isEmpty());
+
+                if (glyph.has_value())
+                    expect (coverageMatchesEdgeTable (*glyph, font.withHeight (20.0f), 'a', { x, 30.0f }));
+            }
+        }
+
+        beginTest ("Glyphs are shared between positions with the same sub-pixel offset");
+        {
+            const auto a = atlas.getGlyph (font.withHeight (20.0f), 'a', { 10.25f, 30.0f });
+            const auto b = atlas.getGlyph (font.withHeight (20.0f), 'a', { 47.25f, 12.0f });
+
+            expect (a->page == b->page && a->sourceArea == b->sourceArea);
+            expect (b->destPosition - a->destPosition == Point<int> (37, -18));
+        }
+
+        beginTest ("Glyphs without an outline have no coverage");
+        {
+            const auto glyph = atlas.getGlyph (font.withHeight (20.0f), ' ', { 10.0f, 30.0f });
+            expect (glyph.has_value() && glyph->sourceArea.isEmpty());
+        }
+
+        beginTest ("Large glyphs aren't cached");
+        {
+            expect (! atlas.getGlyph (font.withHeight ((float) GlyphAtlas::pageSize), 'a', {}).has_value());
+        }
+
+        beginTest ("The number of pages is limited");
+        {
+            atlas.reset();
+            atlas.setMaximumNumPages (2);
+
+            const auto first = atlas.getGlyph (font.withHeight (100.0f), 'a', { 10.0f, 110.0f });
+
+            for (int height = 60; height < 120; ++height)
+                for (auto c : { 'a', 'b' })
+                    atlas.getGlyph (font.withHeight ((float) height), c, {});
+
+            expectEquals (atlas.getNumPages(), 2);
+
+            // glyphs that have been evicted remain usable for as long as they're held
+            expect (first->page->getReferenceCount() == 1);
+            expect (coverageMatchesEdgeTable (*first, font.withHeight (100.0f), 'a', { 10.0f, 110.0f }));
+
+            atlas.setMaximumNumPages (4);
+            atlas.reset();
+        }
+
+        beginTest ("Text drawn through the atlas matches text drawn from edge tables");
+        {
+            const auto drawText = [&] (bool useEdgeTableClip)
+            {
+                Image image (Image::ARGB, 120, 60, true, SoftwareImageType());
+                Graphics g (image);
+
+                if (useEdgeTableClip)
+                {
+                    Path clip;
+                    clip.addRectangle (image.getBounds().toFloat());
+                    g.reduceClipRegion (clip);
+                }
+
+                g.setFont (font.withHeight (20.0f));
+
+                for (auto colour : { Colours::black, Colours::white.withAlpha (0.7f) })
+                {
+                    g.setColour (colour);
+                    g.drawSingleLineText ("abab", 5, 25);
+                    g.drawSingleLineText ("baba", 30, 50);
+                }
+
+                return image;
+            };
+
+            // intersecting the glyph with an edge table clip can round some levels differently
+            expect (imagesMatch (drawText (false), drawText (true), 2));
+        }
+    }
+
+private:
+    static Typeface::Ptr createTypeface()
+    {
+        auto* typeface = new CustomTypeface();
+        typeface->setCharacteristics ("GlyphAtlasTests", 0.8f, false, false, ' ');
+
+        Path a;
+        a.addEllipse (0.05f, -0.55f, 0.5f, 0.55f);
+        a.addRectangle (0.45f, -0.55f, 0.1f, 0.55f);
+        a.setUsingNonZeroWinding (false);
+        typeface->addGlyph ('a', a, 0.6f);
+
+        Path b;
+        b.addTriangle (0.05f, 0.0f, 0.3f, -0.8f, 0.55f, 0.0f);
+        typeface->addGlyph ('b', b, 0.6f);
+
+        typeface->addGlyph (' ', {}, 0.3f);
+        return typeface;
+    }
+
+    static bool coverageMatchesEdgeTable (const GlyphAtlas::Glyph& glyph, const Font& font, int glyphNumber, Point<float> position)
+    {
+        const auto height = font.getHeight();
+        std::unique_ptr<EdgeTable> et (font.getTypefacePtr()->getEdgeTableForGlyph (glyphNumber, AffineTransform::scale (height, height), height));
+        et->translate (position.x, roundToInt (position.y));
+
+        Image expected (Image::SingleChannel, glyph.destPosition.x + glyph.sourceArea.getWidth() + 2,
+                        glyph.destPosition.y + glyph.sourceArea.getHeight() + 2, true, SoftwareImageType());
+
+        const Image::BitmapData data (expected, Image::BitmapData::readWrite);
+        CoverageReader reader { data };
+        et->iterate (reader);
+
+        for (int y = 0; y < data.height; ++y)
+        {
+            for (int x = 0; x < data.width; ++x)
+            {
+                const auto inGlyph = glyph.sourceArea.withPosition (glyph.destPosition).contains (x, y);
+                const auto cached = inGlyph ? (int) glyph.page->getLinePointer (y - glyph.destPosition.y + glyph.sourceArea.getY())
+                                                                [x - glyph.destPosition.x + glyph.sourceArea.getX()]
+                                            : 0;
+
+                if (cached != (int) *data.getPixelPointer (x, y))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    struct CoverageReader
+    {
+        const Image::BitmapData& data;
+        int y = 0;
+
+        void setEdgeTableYPos (int newY) noexcept                        { y = newY; }
+        void handleEdgeTablePixel (int x, int level) const noexcept     { *data.getPixelPointer (x, y) = (uint8) level; }
+        void handleEdgeTablePixelFull (int x) const noexcept            { handleEdgeTablePixel (x, 255); }
+        void handleEdgeTableLineFull (int x, int width) const noexcept  { handleEdgeTableLine (x, width, 255); }
+
+        void handleEdgeTableLine (int x, int width, int level) const noexcept
+        {
+            while (--width >= 0)
+                handleEdgeTablePixel (x++, level);
+        }
+    };
+
+    static bool imagesMatch (const Image& a, const Image& b, int tolerance)
+    {
+        for (int y = 0; y < a.getHeight(); ++y)
+        {
+            for (int x = 0; x < a.getWidth(); ++x)
+            {
+                const auto pa = a.getPixelAt (x, y), pb = b.getPixelAt (x, y);
+
+                if (std::abs ((int) pa.getAlpha() - (int) pb.getAlpha()) > tolerance
+                     || std::abs ((int) pa.getRed()   - (int) pb.getRed())   > tolerance
+                     || std::abs ((int) pa.getGreen() - (int) pb.getGreen()) > tolerance
+                     || std::abs ((int) pa.getBlue()  - (int) pb.getBlue())  > tolerance)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+static GlyphAtlasTests glyphAtlasTests;
+
+#endif
+
+} // namespace juce::RenderingHelpers
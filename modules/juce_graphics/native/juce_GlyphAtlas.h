@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::RenderingHelpers
+{
+
+//==============================================================================
+/**
+    A shared, size-bounded cache of rasterised glyph coverage.
+
+    Each glyph is rendered once for every combination of typeface, height, horizontal
+    scale and sub-pixel horizontal offset that it's drawn with, and the resulting 8-bit
+    coverage masks are packed into fixed-size pages. When the maximum number of pages
+    is in use, the least recently used page and all the glyphs on it are discarded.
+
+    The software renderer uses this to draw text with a solid colour by blending the
+    coverage directly, rather than copying, translating and clipping an EdgeTable for
+    every glyph.
+
+    This class is thread-safe.
+
+    @tags{Graphics}
+*/
+class JUCE_API  GlyphAtlas  : private DeletedAtShutdown
+{
+public:
+    //==============================================================================
+    GlyphAtlas();
+    ~GlyphAtlas() override;
+
+    JUCE_DECLARE_SINGLETON (GlyphAtlas, false)
+
+    //==============================================================================
+    /** The width and height of each page, in pixels. */
+    static constexpr int pageSize = 512;
+
+    /** The number of horizontal positions at which unhinted glyphs are rendered within each pixel. */
+    static constexpr int numSubpixelPositions = 4;
+
+    /** A page of glyph coverage masks, with one byte per pixel. */
+    class Page  : public ReferenceCountedObject
+    {
+    public:
+        using Ptr = ReferenceCountedObjectPtr<Page>;
+
+        Page();
+
+        /** Returns a pointer to the start of a row of the page. */
+        const uint8* getLinePointer (int y) const noexcept   { return data + y * pageSize; }
+
+    private:
+        friend class GlyphAtlas;
+
+        HeapBlock<uint8> data;
+        int shelfX = 0, shelfY = 0, shelfHeight = 0;
+        uint32 lastUseCount = 0;
+
+        uint8* getWritableLinePointer (int y) noexcept       { return data + y * pageSize; }
+        std::optional<Rectangle<int>> allocate (int width, int height) noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (Page)
+    };
+
+    /** Describes where a glyph's coverage is held, and where it should be drawn. */
+    struct Glyph
+    {
+        /** The page holding the coverage, which is kept alive by this object. */
+        Page::Ptr page;
+
+        /** The area of the page that holds the coverage. This is empty for glyphs with no outline. */
+        Rectangle<int> sourceArea;
+
+        /** The device position at which the top-left of the source area should be drawn. */
+        Point<int> destPosition;
+    };
+
+    /** Finds or renders the glyph for drawing with its origin at the given position.
+
+        The levelMultiplier is applied to the glyph's EdgeTable with EdgeTable::multiplyLevels()
+        before its coverage is stored, where 1.0 leaves it unchanged.
+
+        Returns nullopt if the glyph is too large to be cached, in which case it should be
+        drawn some other way.
+    */
+    std::optional<Glyph> getGlyph (const Font& font, int glyphNumber, Point<float> position,
+                                   float levelMultiplier = 1.0f);
+
+    //==============================================================================
+    /** Discards all of the cached glyphs. */
+    void reset();
+
+    /** Sets the maximum number of pages that the atlas may use. The default is 4. */
+    void setMaximumNumPages (int newMaximum);
+
+    /** Returns the number of pages that are currently in use. */
+    int getNumPages() const;
+
+private:
+    //==============================================================================
+    struct Key
+    {
+        Typeface::Ptr typeface;
+        float height, horizontalScale;
+        int glyphNumber, subpixelPosition, levelMultiplier;
+
+        bool operator== (const Key& other) const noexcept
+        {
+            return typeface == other.typeface && exactlyEqual (height, other.height) && exactlyEqual (horizontalScale, other.horizontalScale)
+                     && glyphNumber == other.glyphNumber && subpixelPosition == other.subpixelPosition
+                     && levelMultiplier == other.levelMultiplier;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator() (const Key& key) const noexcept;
+    };
+
+    struct CachedGlyph
+    {
+        Page::Ptr page;
+        Rectangle<int> sourceArea;
+        Point<int> offset;
+        bool isTooLarge = false;
+    };
+
+    CachedGlyph renderGlyph (const Key&);
+    Page::Ptr allocatePage();
+    void removePage (Page*);
+
+    CriticalSection lock;
+    std::unordered_map<Key, CachedGlyph, KeyHash> glyphs;
+    ReferenceCountedArray<Page> pages;
+    int maxNumPages = 4;
+    uint32 useCounter = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphAtlas)
+};
+
+} // namespace juce::RenderingHelpers
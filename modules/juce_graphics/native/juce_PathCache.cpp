@@ -0,0 +1,394 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::RenderingHelpers
+{
+
+PathCache::PathCache() = default;
+
+PathCache::~PathCache()
+{
+    clearSingletonInstance();
+}
+
+JUCE_IMPLEMENT_SINGLETON (PathCache)
+
+//==============================================================================
+bool PathCache::Entry::matches (bool stroke, const Path& path, const AffineTransform& t,
+                                const PathStrokeType& st, float accuracy) const noexcept
+{
+    return isStroke == stroke
+            && transform == t
+            && (! stroke || (strokeType == st && exactlyEqual (extraAccuracy, accuracy)))
+            && source == path;
+}
+
+size_t PathCache::getPathHash (const Path& path, bool isStroke, const AffineTransform& t,
+                               const PathStrokeType& strokeType, float extraAccuracy) noexcept
+{
+    uint64 hash = 14695981039346656037ull;
+
+    const auto add = [&hash] (uint64 value)
+    {
+        hash = (hash ^ value) * 1099511628211ull;
+    };
+
+    const auto addFloat = [&add] (float value)
+    {
+        uint32 bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+        add (bits);
+    };
+
+    add ((isStroke ? 1u : 0u) | (path.useNonZeroWinding ? 2u : 0u));
+
+    for (auto value : { t.mat00, t.mat01, t.mat02, t.mat10, t.mat11, t.mat12 })
+        addFloat (value);
+
+    if (isStroke)
+    {
+        addFloat (strokeType.getStrokeThickness());
+        add ((uint64) strokeType.getJointStyle() | ((uint64) strokeType.getEndStyle() << 8));
+        addFloat (extraAccuracy);
+    }
+
+    for (auto value : path.data)
+        addFloat (value);
+
+    return (size_t) hash;
+}
+
+bool PathCache::isWorthCaching (const Path& path) noexcept
+{
+    // Rectangles and other shapes made of a few lines are quicker to rasterise than to look up
+    return path.data.size() >= 24;
+}
+
+const PathCache::Entry* PathCache::find (size_t hash, bool isStroke, const Path& path, const AffineTransform& t,
+                                         const PathStrokeType& strokeType, float extraAccuracy)
+{
+    const auto range = entries.equal_range (hash);
+
+    for (auto i = range.first; i != range.second; ++i)
+    {
+        if (i->second.matches (isStroke, path, t, strokeType, extraAccuracy))
+        {
+            i->second.lastUseCount = ++useCounter;
+            return &i->second;
+        }
+    }
+
+    return nullptr;
+}
+
+bool PathCache::shouldAdd (size_t hash)
+{
+    // Only shapes that are drawn more than once are worth keeping
+    if (seenOnce.erase (hash) > 0)
+        return true;
+
+    if (seenOnce.size() >= 4096)
+        seenOnce.clear();
+
+    seenOnce.insert (hash);
+    return false;
+}
+
+void PathCache::add (size_t hash, Entry entry)
+{
+    if (entry.sizeInBytes > maxSizeInBytes / 4
+         || find (hash, entry.isStroke, entry.source, entry.transform, entry.strokeType, entry.extraAccuracy) != nullptr)
+        return;
+
+    entry.lastUseCount = ++useCounter;
+    sizeInBytes += entry.sizeInBytes;
+    entries.emplace (hash, std::move (entry));
+
+    while (sizeInBytes > maxSizeInBytes)
+        removeLeastRecentlyUsed();
+}
+
+void PathCache::removeLeastRecentlyUsed()
+{
+    auto oldest = entries.begin();
+
+    for (auto i = entries.begin(); i != entries.end(); ++i)
+        if (i->second.lastUseCount < oldest->second.lastUseCount)
+            oldest = i;
+
+    if (oldest != entries.end())
+    {
+        sizeInBytes -= oldest->second.sizeInBytes;
+        entries.erase (oldest);
+    }
+}
+
+//==============================================================================
+void PathCache::createStrokedPath (Path& destPath, const Path& sourcePath, const PathStrokeType& strokeType,
+                                   const AffineTransform& transform, float extraAccuracy)
+{
+    std::shared_ptr<const Path> stroke;
+    size_t hash = 0;
+    bool shouldCache = false;
+
+    if (isWorthCaching (sourcePath))
+    {
+        hash = getPathHash (sourcePath, true, transform, strokeType, extraAccuracy);
+
+        const ScopedLock sl (lock);
+
+        if (maxSizeInBytes > 0)
+        {
+            if (auto* entry = find (hash, true, sourcePath, transform, strokeType, extraAccuracy))
+                stroke = entry->strokedPath;
+            else
+                shouldCache = shouldAdd (hash);
+        }
+    }
+
+    if (stroke == nullptr)
+    {
+        if (! shouldCache)
+        {
+            strokeType.createStrokedPath (destPath, sourcePath, transform, extraAccuracy);
+            return;
+        }
+
+        auto newStroke = std::make_shared<Path>();
+        strokeType.createStrokedPath (*newStroke, sourcePath, transform, extraAccuracy);
+        stroke = newStroke;
+
+        const auto bytes = (size_t) (stroke->data.size() + sourcePath.data.size()) * sizeof (float);
+
+        const ScopedLock sl (lock);
+        add (hash, { true, sourcePath, transform, strokeType, extraAccuracy, stroke, nullptr, bytes, 0 });
+    }
+
+    destPath = *stroke;
+}
+
+std::shared_ptr<const EdgeTable> PathCache::getEdgeTable (const Path& path, const AffineTransform& transform)
+{
+    if (! isWorthCaching (path))
+        return {};
+
+    const auto hash = getPathHash (path, false, transform, PathStrokeType (0.0f), 0.0f);
+
+    {
+        const ScopedLock sl (lock);
+
+        if (maxSizeInBytes == 0)
+            return {};
+
+        if (auto* entry = find (hash, false, path, transform, PathStrokeType (0.0f), 0.0f))
+            return entry->edgeTable;
+
+        if (! shouldAdd (hash))
+            return {};
+    }
+
+    const auto bounds = path.getBoundsTransformed (transform).getSmallestIntegerContainer().expanded (1);
+    constexpr int maxSize = 2048;
+
+    if (bounds.isEmpty() || bounds.getWidth() > maxSize || bounds.getHeight() > maxSize)
+        return {};
+
+    auto edgeTable = std::make_shared<const EdgeTable> (bounds, path, transform);
+
+    // Each line of an EdgeTable initially has room for 32 edges, of two ints each
+    const auto bytes = (size_t) bounds.getHeight() * (32 * 2 + 1) * sizeof (int)
+                        + (size_t) path.data.size() * sizeof (float);
+
+    const ScopedLock sl (lock);
+    add (hash, { false, path, transform, PathStrokeType (0.0f), 0.0f, nullptr, edgeTable, bytes, 0 });
+
+    return edgeTable;
+}
+
+//==============================================================================
+void PathCache::reset()
+{
+    const ScopedLock sl (lock);
+    entries.clear();
+    seenOnce.clear();
+    sizeInBytes = 0;
+}
+
+void PathCache::setMaximumSizeInBytes (size_t newMaximum)
+{
+    const ScopedLock sl (lock);
+    maxSizeInBytes = newMaximum;
+
+    while (sizeInBytes > maxSizeInBytes)
+        removeLeastRecentlyUsed();
+}
+
+size_t PathCache::getSizeInBytes() const
+{
+    const ScopedLock sl (lock);
+    return sizeInBytes;
+}
+
+int PathCache::getNumEntries() const
+{
+    const ScopedLock sl (lock);
+    return (int) entries.size();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PathCacheTests  : public UnitTest
+{
+public:
+    PathCacheTests()
+        : UnitTest ("PathCache", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        auto& cache = *PathCache::getInstance();
+        const auto arc = createArc();
+        const PathStrokeType strokeType (3.0f, PathStrokeType::curved, PathStrokeType::rounded);
+
+        beginTest ("Strokes are cached once they've been seen twice");
+        {
+            cache.reset();
+
+            Path expected;
+            strokeType.createStrokedPath (expected, arc, AffineTransform::scale (1.5f), 1.0f);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                Path stroke;
+                cache.createStrokedPath (stroke, arc, strokeType, AffineTransform::scale (1.5f), 1.0f);
+                expect (stroke == expected);
+                expectEquals (cache.getNumEntries(), i == 0 ? 0 : 1);
+            }
+        }
+
+        beginTest ("Strokes with a different transform or stroke type aren't shared");
+        {
+            for (int i = 0; i < 2; ++i)
+            {
+                Path stroke;
+                cache.createStrokedPath (stroke, arc, strokeType, AffineTransform::scale (1.5f).translated (40.0f, 25.0f), 1.0f);
+                cache.createStrokedPath (stroke, arc, PathStrokeType (2.0f), AffineTransform::scale (1.5f), 1.0f);
+            }
+
+            expectEquals (cache.getNumEntries(), 3);
+        }
+
+        beginTest ("Paths filled from cached EdgeTables match paths filled directly");
+        {
+            cache.reset();
+            Path shape;
+            strokeType.createStrokedPath (shape, arc);
+
+            const auto draw = [&shape] (Point<float> offset)
+            {
+                Image image (Image::ARGB, 160, 120, true, SoftwareImageType());
+                Graphics g (image);
+                g.reduceClipRegion (20, 10, 100, 90);
+                g.setColour (Colours::white);
+                g.fillPath (shape, AffineTransform::rotation (0.4f).translated (offset));
+                return image;
+            };
+
+            const Point<float> offsets[] { { 30.0f, 20.0f }, { 30.0f, 20.0f }, { 50.0f, 25.0f },
+                                           { -10.0f, 60.0f }, { 50.25f, 25.5f }, { 50.25f, 25.5f } };
+
+            cache.setMaximumSizeInBytes (0);
+            std::vector<Image> direct;
+
+            for (auto offset : offsets)
+                direct.push_back (draw (offset));
+
+            cache.setMaximumSizeInBytes (4 * 1024 * 1024);
+
+            for (size_t i = 0; i < std::size (offsets); ++i)
+                expect (imagesAreEqual (draw (offsets[i]), direct[i]));
+
+            expectEquals (cache.getNumEntries(), 2);
+        }
+
+        beginTest ("Simple paths aren't cached");
+        {
+            cache.reset();
+
+            Path rectangle;
+            rectangle.addRectangle (10.0f, 10.0f, 50.0f, 20.0f);
+
+            for (int i = 0; i < 3; ++i)
+                expect (cache.getEdgeTable (rectangle, {}) == nullptr);
+
+            expectEquals (cache.getNumEntries(), 0);
+        }
+
+        beginTest ("The cache stays within its size limit");
+        {
+            cache.reset();
+            cache.setMaximumSizeInBytes (256 * 1024);
+
+            for (int i = 0; i < 50; ++i)
+            {
+                const auto transform = AffineTransform::scale (1.0f + (float) i * 0.01f);
+                cache.getEdgeTable (arc, transform);
+                cache.getEdgeTable (arc, transform);
+            }
+
+            expect (cache.getSizeInBytes() <= 256 * 1024);
+            expect (cache.getNumEntries() > 0);
+
+            cache.setMaximumSizeInBytes (4 * 1024 * 1024);
+            cache.reset();
+        }
+    }
+
+private:
+    static Path createArc()
+    {
+        Path p;
+        p.addCentredArc (50.0f, 50.0f, 40.0f, 40.0f, 0.0f, -2.4f, 2.4f, true);
+        return p;
+    }
+
+    static bool imagesAreEqual (const Image& a, const Image& b)
+    {
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                if (a.getPixelAt (x, y) != b.getPixelAt (x, y))
+                    return false;
+
+        return true;
+    }
+};
+
+static PathCacheTests pathCacheTests;
+
+#endif
+
+} // namespace juce::RenderingHelpers
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::RenderingHelpers
+{
+
+//==============================================================================
+/**
+    A shared, size-bounded cache of stroked paths and of the EdgeTables used to fill paths.
+
+    UIs tend to draw the same shapes in every frame, e.g. the arcs of a rotary slider or
+    an outline that hasn't changed. The first time a shape is seen, only a hash of it is
+    remembered. If it's drawn again, the result is stored and reused until the least
+    recently used results are discarded to keep the cache within its size limit.
+
+    Results are only reused for exactly the same path and transform, so that drawing from
+    the cache gives identical pixels to drawing without it.
+
+    Simple paths, which are cheap to rasterise anyway, and shapes that would cover very large
+    areas aren't cached.
+
+    This class is thread-safe.
+
+    @tags{Graphics}
+*/
+class JUCE_API  PathCache  : private DeletedAtShutdown
+{
+public:
+    //==============================================================================
+    PathCache();
+    ~PathCache() override;
+
+    JUCE_DECLARE_SINGLETON (PathCache, false)
+
+    //==============================================================================
+    /** Creates the outline of a stroke, in the same way as PathStrokeType::createStrokedPath(). */
+    void createStrokedPath (Path& destPath, const Path& sourcePath, const PathStrokeType& strokeType,
+                            const AffineTransform& transform, float extraAccuracy);
+
+    /** Returns the EdgeTable for filling a path with the given transform, if it's been cached.
+
+        The table covers the whole of the transformed path, so it'll need clipping before
+        it's drawn. If this returns nullptr, the path should be rasterised in the normal way.
+    */
+    std::shared_ptr<const EdgeTable> getEdgeTable (const Path& path, const AffineTransform& transform);
+
+    //==============================================================================
+    /** Discards everything in the cache. */
+    void reset();
+
+    /** Sets the approximate number of bytes that the cache may use. The default is 4MB, and 0
+        turns caching off.
+    */
+    void setMaximumSizeInBytes (size_t newMaximum);
+
+    /** Returns the approximate number of bytes that the cache is using. */
+    size_t getSizeInBytes() const;
+
+    /** Returns the number of cached paths and EdgeTables. */
+    int getNumEntries() const;
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        bool isStroke;
+        Path source;
+        AffineTransform transform;
+        PathStrokeType strokeType;
+        float extraAccuracy;
+
+        std::shared_ptr<const Path> strokedPath;
+        std::shared_ptr<const EdgeTable> edgeTable;
+        size_t sizeInBytes;
+        uint32 lastUseCount;
+
+        bool matches (bool stroke, const Path&, const AffineTransform&, const PathStrokeType&, float) const noexcept;
+    };
+
+    static size_t getPathHash (const Path&, bool isStroke, const AffineTransform&,
+                               const PathStrokeType&, float extraAccuracy) noexcept;
+    static bool isWorthCaching (const Path&) noexcept;
+
+    const Entry* find (size_t hash, bool isStroke, const Path&, const AffineTransform&,
+                       const PathStrokeType&, float extraAccuracy);
+    bool shouldAdd (size_t hash);
+    void add (size_t hash, Entry);
+    void removeLeastRecentlyUsed();
+
+    CriticalSection lock;
+    std::unordered_multimap<size_t, Entry> entries;
+    std::unordered_set<size_t> seenOnce;
+    size_t sizeInBytes = 0, maxSizeInBytes = 4 * 1024 * 1024;
+    uint32 useCounter = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PathCache)
+};
+
+} // namespace juce::RenderingHelpers
@@ -306,6 +306,74 @@ public:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedGlyphEdgeTable)
 };
 
+//==============================================================================
+/** Iterates the coverage of a glyph from the GlyphAtlas, clipped to a list of rectangles.
+
+    Runs of pixels with the same coverage are passed on as lines, in the same way that
+    an EdgeTable would.
+
+    @tags{Graphics}
+*/
+struct GlyphCoverageIterator
+{
+    GlyphCoverageIterator (const RectangleList<int>& clipList, const GlyphAtlas::Glyph& g) noexcept
+        : clip (clipList), glyph (g)
+    {}
+
+    template <class Renderer>
+    void iterate (Renderer& r) const noexcept
+    {
+        const auto destArea = glyph.sourceArea.withPosition (glyph.destPosition);
+        const auto sourceOffset = glyph.sourceArea.getPosition() - glyph.destPosition;
+
+        for (auto& rect : clip)
+        {
+            const auto area = rect.getIntersection (destArea);
+
+            for (int y = area.getY(); y < area.getBottom(); ++y)
+            {
+                const auto* line = glyph.page->getLinePointer (y + sourceOffset.y) + sourceOffset.x;
+                r.setEdgeTableYPos (y);
+
+                for (int x = area.getX(); x < area.getRight();)
+                {
+                    const int level = line[x];
+                    auto end = x + 1;
+
+                    while (end < area.getRight() && line[end] == level)
+                        ++end;
+
+                    if (level > 0)
+                    {
+                        if (end - x == 1)
+                        {
+                            if (level >= 255)
+                                r.handleEdgeTablePixelFull (x);
+                            else
+                                r.handleEdgeTablePixel (x, level);
+                        }
+                        else
+                        {
+                            if (level >= 255)
+                                r.handleEdgeTableLineFull (x, end - x);
+                            else
+                                r.handleEdgeTableLine (x, end - x, level);
+                        }
+                    }
+
+                    x = end;
+                }
+            }
+        }
+    }
+
+private:
+    const RectangleList<int>& clip;
+    const GlyphAtlas::Glyph& glyph;
+
+    JUCE_DECLARE_NON_COPYABLE (GlyphCoverageIterator)
+};
+
 //==============================================================================
 /** Calculates the alpha values and positions for rendering the edges of a
     non-pixel-aligned rectangle.
@@ -569,7 +637,8 @@ namespace EdgeTableFillers
     struct SolidColour
     {
         SolidColour (const Image::BitmapData& image, PixelARGB colour)
-            : destData (image), sourceColour (colour)
+            : destData (image), sourceColour (colour),
+              canBlendSpans (SpanBlending::canBlendColour<PixelType> (image))
         {
             if (sizeof (PixelType) == 3 && (size_t) destData.pixelStride == sizeof (PixelType))
                 areRGBComponentsEqual = sourceColour.getRed() == sourceColour.getGreen()
@@ -658,6 +727,7 @@ namespace EdgeTableFillers
         PixelType* linePixels;
         PixelARGB sourceColour;
         bool areRGBComponentsEqual;
+        const bool canBlendSpans;
 
         forcedinline PixelType* getPixel (int x) const noexcept
         {
@@ -666,7 +736,10 @@ namespace EdgeTableFillers
 
         inline void blendLine (PixelType* dest, PixelARGB colour, int width) const noexcept
         {
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
+            if (canBlendSpans && width >= SpanBlending::minimumSpanLength)
+                SpanBlending::blendColourSpan (dest, destData.pixelStride, colour, width);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
         }
 
         forcedinline void replaceLine (PixelRGB* dest, PixelARGB colour, int width) const noexcept
@@ -701,7 +774,8 @@ namespace EdgeTableFillers
         Gradient (const Image::BitmapData& dest, const ColourGradient& gradient, const AffineTransform& transform,
                   const PixelARGB* colours, int numColours)
             : GradientType (gradient, transform, colours, numColours - 1),
-              destData (dest)
+              destData (dest),
+              canBlendSpans (SpanBlending::canBlendPixels<PixelType> (dest))
         {
         }
 
@@ -725,7 +799,9 @@ namespace EdgeTableFillers
         {
             auto* dest = getPixel (x);
 
-            if (alphaLevel < 0xff)
+            if (canBlendSpans && width >= SpanBlending::minimumSpanLength)
+                blendSpan (dest, x, width, alphaLevel < 0xff ? (uint32) alphaLevel : 256);
+            else if (alphaLevel < 0xff)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
             else
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
@@ -734,7 +810,11 @@ namespace EdgeTableFillers
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
             auto* dest = getPixel (x);
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+
+            if (canBlendSpans && width >= SpanBlending::minimumSpanLength)
+                blendSpan (dest, x, width, 256);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
         }
 
         void handleEdgeTableRectangle (int x, int y, int width, int height, int alphaLevel) noexcept
@@ -758,12 +838,31 @@ namespace EdgeTableFillers
     private:
         const Image::BitmapData& destData;
         PixelType* linePixels;
+        const bool canBlendSpans;
 
         forcedinline PixelType* getPixel (int x) const noexcept
         {
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
+        void blendSpan (PixelType* dest, int x, int width, uint32 alphaLevel) const noexcept
+        {
+            PixelARGB colours[128];
+
+            while (width > 0)
+            {
+                const auto num = jmin (width, (int) numElementsInArray (colours));
+
+                for (int i = 0; i < num; ++i)
+                    colours[i] = GradientType::getPixel (x + i);
+
+                SpanBlending::blendPixelSpan (dest, colours, num, alphaLevel);
+                dest = addBytesToPointer (dest, num * destData.pixelStride);
+                x += num;
+                width -= num;
+            }
+        }
+
         JUCE_DECLARE_NON_COPYABLE (Gradient)
     };
 
@@ -777,7 +876,9 @@ namespace EdgeTableFillers
               srcData (src),
               extraAlpha (alpha + 1),
               xOffset (repeatPattern ? negativeAwareModulo (x, src.width)  - src.width  : x),
-              yOffset (repeatPattern ? negativeAwareModulo (y, src.height) - src.height : y)
+              yOffset (repeatPattern ? negativeAwareModulo (y, src.height) - src.height : y),
+              canBlendSpans (std::is_same_v<SrcPixelType, PixelARGB> && src.pixelStride == 4
+                              && SpanBlending::canBlendPixels<DestPixelType> (dest))
         {
         }
 
@@ -813,7 +914,9 @@ namespace EdgeTableFillers
             alphaLevel = (alphaLevel * extraAlpha) >> 8;
             x -= xOffset;
 
-            if (repeatPattern)
+            if (canBlendSpans && width >= SpanBlending::minimumSpanLength)
+                blendSpans (dest, x, width, alphaLevel < 0xfe ? (uint32) alphaLevel : 256);
+            else if (repeatPattern)
             {
                 if (alphaLevel < 0xfe)
                     JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++ % srcData.width), (uint32) alphaLevel))
@@ -836,7 +939,9 @@ namespace EdgeTableFillers
             auto* dest = getDestPixel (x);
             x -= xOffset;
 
-            if (repeatPattern)
+            if (canBlendSpans && width >= SpanBlending::minimumSpanLength)
+                blendSpans (dest, x, width, extraAlpha < 0xfe ? (uint32) extraAlpha : 256);
+            else if (repeatPattern)
             {
                 if (extraAlpha < 0xfe)
                     JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++ % srcData.width), (uint32) extraAlpha))
@@ -888,6 +993,7 @@ namespace EdgeTableFillers
         const Image::BitmapData& destData;
         const Image::BitmapData& srcData;
         const int extraAlpha, xOffset, yOffset;
+        const bool canBlendSpans;
         DestPixelType* linePixels;
         SrcPixelType* sourceLineStart;
 
@@ -901,6 +1007,24 @@ namespace EdgeTableFillers
             return addBytesToPointer (sourceLineStart, x * srcData.pixelStride);
         }
 
+        void blendSpans (DestPixelType* dest, int srcX, int width, uint32 alphaLevel) const noexcept
+        {
+            jassert (repeatPattern || (srcX >= 0 && srcX + width <= srcData.width));
+
+            while (width > 0)
+            {
+                if (repeatPattern)
+                    srcX %= srcData.width;
+
+                const auto num = repeatPattern ? jmin (width, srcData.width - srcX) : width;
+
+                SpanBlending::blendPixelSpan (dest, reinterpret_cast<const PixelARGB*> (getSrcPixel (srcX)), num, alphaLevel);
+                dest = addBytesToPointer (dest, num * destData.pixelStride);
+                srcX += num;
+                width -= num;
+            }
+        }
+
         forcedinline void copyRow (DestPixelType* dest, SrcPixelType const* src, int width) const noexcept
         {
             auto destStride = destData.pixelStride;
@@ -941,7 +1065,8 @@ namespace EdgeTableFillers
               extraAlpha (alpha + 1),
               quality (q),
               maxX (src.width  - 1),
-              maxY (src.height - 1)
+              maxY (src.height - 1),
+              canBlendSpans (std::is_same_v<SrcPixelType, PixelARGB> && SpanBlending::canBlendPixels<DestPixelType> (dest))
         {
             scratchBuffer.malloc (scratchSize);
         }
@@ -983,7 +1108,10 @@ namespace EdgeTableFillers
             alphaLevel *= extraAlpha;
             alphaLevel >>= 8;
 
-            if (alphaLevel < 0xfe)
+            if (canBlendSpans && width >= SpanBlending::minimumSpanLength)
+                SpanBlending::blendPixelSpan (dest, reinterpret_cast<const PixelARGB*> (span), width,
+                                              alphaLevel < 0xfe ? (uint32) alphaLevel : 256);
+            else if (alphaLevel < 0xfe)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++, (uint32) alphaLevel))
             else
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++))
@@ -1394,6 +1522,7 @@ namespace EdgeTableFillers
         const int extraAlpha;
         const Graphics::ResamplingQuality quality;
         const int maxX, maxY;
+        const bool canBlendSpans;
         int currentY;
         DestPixelType* linePixels;
         HeapBlock<SrcPixelType> scratchBuffer;
@@ -2327,7 +2456,18 @@ public:
             auto clipRect = clip->getClipBounds();
 
             if (path.getBoundsTransformed (trans).getSmallestIntegerContainer().intersects (clipRect))
-                fillShape (*new EdgeTableRegionType (clipRect, path, trans), false);
+            {
+                if (auto cached = PathCache::getInstance()->getEdgeTable (path, trans))
+                {
+                    auto* shape = new EdgeTableRegionType (*cached);
+                    shape->edgeTable.clipToRectangle (clipRect);
+                    fillShape (*shape, false);
+                }
+                else
+                {
+                    fillShape (*new EdgeTableRegionType (clipRect, path, trans), false);
+                }
+            }
         }
     }
 
@@ -2371,11 +2511,41 @@ public:
             && std::abs (t.mat11 - 1.0f) < tolerance;
     }
 
+    /*  Returns the number of times an image can be halved in size before drawing it with this
+        transform, while still being drawn at no less than half the size of the halved copy.
+    */
+    static int getMipMapLevel (const AffineTransform& t) noexcept
+    {
+        const auto scale = jmax (std::hypot (t.mat00, t.mat10), std::hypot (t.mat01, t.mat11));
+
+        if (scale <= 0.0f || scale >= 0.5f)
+            return 0;
+
+        return jmin (30, (int) std::floor (std::log2 (1.0f / scale)));
+    }
+
     void renderImage (const Image& sourceImage, const AffineTransform& trans, const BaseRegionType* tiledFillClipRegion)
     {
         auto t = transform.getTransformWith (trans);
         auto alpha = fillType.colour.getAlpha();
 
+        if (interpolationQuality != Graphics::lowResamplingQuality)
+        {
+            if (auto* pixelData = sourceImage.getPixelData(); pixelData != nullptr && pixelData->areMipMapsEnabled())
+            {
+                if (const auto level = getMipMapLevel (t); level > 0)
+                {
+                    const auto mipMap = pixelData->getMipMap (level);
+                    const auto mipMapScale = AffineTransform::scale ((float) sourceImage.getWidth()  / (float) mipMap.getWidth(),
+                                                                     (float) sourceImage.getHeight() / (float) mipMap.getHeight());
+
+                    // the mip-map levels don't have mip-maps of their own, so this won't recurse again
+                    renderImage (mipMap, mipMapScale.followedBy (trans), tiledFillClipRegion);
+                    return;
+                }
+            }
+        }
+
         if (isOnlyTranslationAllowingError (t, 0.002f))
         {
             // If our translation doesn't involve any distortion, just use a simple blit..
@@ -2528,6 +2698,7 @@ public:
     static void clearGlyphCache()
     {
         GlyphCacheType::getInstance().reset();
+        GlyphAtlas::getInstance()->reset();
     }
 
     //==============================================================================
@@ -2537,12 +2708,11 @@ public:
         {
             if (trans.isOnlyTranslation() && ! transform.isRotated)
             {
-                auto& cache = GlyphCacheType::getInstance();
                 Point<float> pos (trans.getTranslationX(), trans.getTranslationY());
 
                 if (transform.isOnlyTranslated)
                 {
-                    cache.drawGlyph (*this, font, glyphNumber, pos + transform.offset.toFloat());
+                    drawCachedGlyph (font, glyphNumber, pos + transform.offset.toFloat());
                 }
                 else
                 {
@@ -2556,7 +2726,7 @@ public:
                     if (std::abs (xScale - 1.0f) > 0.01f)
                         f.setHorizontalScale (xScale);
 
-                    cache.drawGlyph (*this, f, glyphNumber, pos);
+                    drawCachedGlyph (f, glyphNumber, pos);
                 }
             }
             else
@@ -2632,6 +2802,35 @@ public:
     Font font;
 
 private:
+    /** Draws a glyph from the GlyphAtlas when filling with a colour through a rectangular clip
+        region, or from the glyph cache otherwise.
+    */
+    void drawCachedGlyph (const Font& f, int glyphNumber, Point<float> pos)
+    {
+        if (fillType.isColour())
+        {
+            if (auto* rectangles = dynamic_cast<const RectangleListRegionType*> (clip.get()))
+            {
+                // match the brightening applied by fillEdgeTable()
+                auto brightness = fillType.colour.getBrightness() - 0.5f;
+                auto levelMultiplier = brightness > 0.0f ? 1.0f + 1.6f * brightness : 1.0f;
+
+                if (auto glyph = GlyphAtlas::getInstance()->getGlyph (f, glyphNumber, pos, levelMultiplier))
+                {
+                    if (! glyph->sourceArea.isEmpty())
+                    {
+                        GlyphCoverageIterator iter (rectangles->clip, *glyph);
+                        fillWithSolidColour (iter, fillType.colour.getPixelARGB(), false);
+                    }
+
+                    return;
+                }
+            }
+        }
+
+        GlyphCacheType::getInstance().drawGlyph (*this, f, glyphNumber, pos);
+    }
+
     SoftwareRendererSavedState& operator= (const SoftwareRendererSavedState&) = delete;
 };
 
@@ -0,0 +1,600 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::RenderingHelpers::SpanBlending
+{
+
+/*  All of the kernels work on 16-bit lanes holding one 8-bit component each, and compute
+    (src * extraAlpha >> 8) + (dest * (256 - srcAlpha) >> 8) with unsigned saturation, which
+    is exactly what the scalar PixelARGB::blend() and PixelRGB::blend() functions do.
+
+    Each kernel processes as many whole vectors as will fit, and returns the number of pixels
+    it has dealt with so that the caller can finish the remainder one pixel at a time.
+    The keepMask selects bytes of the destination which must be left untouched, i.e. the
+    padding bytes of a 4-byte PixelRGB.
+*/
+static constexpr uint32 alphaByteMask = (uint32) 0xff << (8 * PixelARGB::indexA);
+
+#if JUCE_SPAN_BLENDING_SSE2
+namespace SSE2
+{
+    static constexpr int alphaShuffle = _MM_SHUFFLE (PixelARGB::indexA, PixelARGB::indexA, PixelARGB::indexA, PixelARGB::indexA);
+
+    static forcedinline __m128i blendComponents (__m128i src, __m128i dest, __m128i inverseAlpha) noexcept
+    {
+        return _mm_add_epi16 (src, _mm_srli_epi16 (_mm_mullo_epi16 (dest, inverseAlpha), 8));
+    }
+
+    static forcedinline __m128i blendPixelComponents (__m128i src, __m128i dest, __m128i extraAlpha) noexcept
+    {
+        src = _mm_srli_epi16 (_mm_mullo_epi16 (src, extraAlpha), 8);
+        const auto alpha = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (src, alphaShuffle), alphaShuffle);
+        return blendComponents (src, dest, _mm_sub_epi16 (_mm_set1_epi16 (0x100), alpha));
+    }
+
+    static int blendColour (uint8* dest, PixelARGB colour, int numPixels, uint32 keepMask) noexcept
+    {
+        const auto zero = _mm_setzero_si128();
+        const auto src = _mm_unpacklo_epi8 (_mm_set1_epi32 ((int) colour.getNativeARGB()), zero);
+        const auto inverseAlpha = _mm_set1_epi16 ((short) (0x100 - colour.getAlpha()));
+        const auto keep = _mm_set1_epi32 ((int) keepMask);
+
+        int i = 0;
+
+        for (; i + 4 <= numPixels; i += 4)
+        {
+            auto* p = reinterpret_cast<__m128i*> (dest + i * 4);
+            const auto d = _mm_loadu_si128 (p);
+            const auto result = _mm_packus_epi16 (blendComponents (src, _mm_unpacklo_epi8 (d, zero), inverseAlpha),
+                                                  blendComponents (src, _mm_unpackhi_epi8 (d, zero), inverseAlpha));
+
+            _mm_storeu_si128 (p, _mm_or_si128 (_mm_andnot_si128 (keep, result), _mm_and_si128 (keep, d)));
+        }
+
+        return i;
+    }
+
+    static int blendColourPacked (uint8* dest, PixelARGB colour, int numPixels) noexcept
+    {
+        // 16 three-byte pixels fill exactly three registers, so the source colour
+        // can be laid out as a repeating pattern of bytes
+        uint8 pattern[48];
+
+        for (int i = 0; i < 16; ++i)
+            reinterpret_cast<PixelRGB*> (pattern + i * 3)->set (colour);
+
+        const auto zero = _mm_setzero_si128();
+        const auto inverseAlpha = _mm_set1_epi16 ((short) (0x100 - colour.getAlpha()));
+        __m128i srcLo[3], srcHi[3];
+
+        for (int j = 0; j < 3; ++j)
+        {
+            const auto s = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (pattern + j * 16));
+            srcLo[j] = _mm_unpacklo_epi8 (s, zero);
+            srcHi[j] = _mm_unpackhi_epi8 (s, zero);
+        }
+
+        int i = 0;
+
+        for (; i + 16 <= numPixels; i += 16)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                auto* p = reinterpret_cast<__m128i*> (dest + i * 3 + j * 16);
+                const auto d = _mm_loadu_si128 (p);
+
+                _mm_storeu_si128 (p, _mm_packus_epi16 (blendComponents (srcLo[j], _mm_unpacklo_epi8 (d, zero), inverseAlpha),
+                                                       blendComponents (srcHi[j], _mm_unpackhi_epi8 (d, zero), inverseAlpha)));
+            }
+        }
+
+        return i;
+    }
+
+    static int blendPixels (uint8* dest, const uint8* source, int numPixels, uint32 extraAlpha, uint32 keepMask) noexcept
+    {
+        const auto zero = _mm_setzero_si128();
+        const auto extra = _mm_set1_epi16 ((short) extraAlpha);
+        const auto keep = _mm_set1_epi32 ((int) keepMask);
+
+        int i = 0;
+
+        for (; i + 4 <= numPixels; i += 4)
+        {
+            auto* p = reinterpret_cast<__m128i*> (dest + i * 4);
+            const auto d = _mm_loadu_si128 (p);
+            const auto s = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i * 4));
+            const auto result = _mm_packus_epi16 (blendPixelComponents (_mm_unpacklo_epi8 (s, zero), _mm_unpacklo_epi8 (d, zero), extra),
+                                                  blendPixelComponents (_mm_unpackhi_epi8 (s, zero), _mm_unpackhi_epi8 (d, zero), extra));
+
+            _mm_storeu_si128 (p, _mm_or_si128 (_mm_andnot_si128 (keep, result), _mm_and_si128 (keep, d)));
+        }
+
+        return i;
+    }
+
+    static forcedinline __m128i premultiplyComponents (__m128i pixels) noexcept
+    {
+        const auto alpha = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (pixels, alphaShuffle), alphaShuffle);
+        const auto opaque = _mm_cmpeq_epi16 (alpha, _mm_set1_epi16 (0xff));
+        const auto result = _mm_srli_epi16 (_mm_add_epi16 (_mm_mullo_epi16 (pixels, alpha), _mm_set1_epi16 (0x7f)), 8);
+
+        return _mm_or_si128 (_mm_and_si128 (opaque, pixels), _mm_andnot_si128 (opaque, result));
+    }
+
+    static int premultiply (uint8* pixels, int numPixels) noexcept
+    {
+        const auto zero = _mm_setzero_si128();
+        const auto alphaMask = _mm_set1_epi32 ((int) alphaByteMask);
+
+        int i = 0;
+
+        for (; i + 4 <= numPixels; i += 4)
+        {
+            auto* p = reinterpret_cast<__m128i*> (pixels + i * 4);
+            const auto d = _mm_loadu_si128 (p);
+
+            // most decoded images are largely opaque, and opaque pixels are left alone
+            if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_and_si128 (d, alphaMask), alphaMask)) == 0xffff)
+                continue;
+
+            const auto result = _mm_packus_epi16 (premultiplyComponents (_mm_unpacklo_epi8 (d, zero)),
+                                                  premultiplyComponents (_mm_unpackhi_epi8 (d, zero)));
+
+            _mm_storeu_si128 (p, _mm_or_si128 (_mm_andnot_si128 (alphaMask, result), _mm_and_si128 (alphaMask, d)));
+        }
+
+        return i;
+    }
+}
+
+//==============================================================================
+#if JUCE_GCC || JUCE_CLANG
+ #define JUCE_SPAN_BLENDING_AVX2_TARGET __attribute__ ((target ("avx2")))
+#else
+ #define JUCE_SPAN_BLENDING_AVX2_TARGET
+#endif
+
+/*  These are compiled for AVX2 regardless of the flags used for the rest of the module,
+    and are only called when SystemStats reports that the CPU supports AVX2.
+*/
+namespace AVX2
+{
+    static bool isAvailable() noexcept
+    {
+        static const bool available = SystemStats::hasAVX2();
+        return available;
+    }
+
+    JUCE_SPAN_BLENDING_AVX2_TARGET static forcedinline __m256i blendComponents (__m256i src, __m256i dest, __m256i inverseAlpha) noexcept
+    {
+        return _mm256_add_epi16 (src, _mm256_srli_epi16 (_mm256_mullo_epi16 (dest, inverseAlpha), 8));
+    }
+
+    JUCE_SPAN_BLENDING_AVX2_TARGET static forcedinline __m256i blendPixelComponents (__m256i src, __m256i dest, __m256i extraAlpha) noexcept
+    {
+        src = _mm256_srli_epi16 (_mm256_mullo_epi16 (src, extraAlpha), 8);
+        const auto alpha = _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (src, SSE2::alphaShuffle), SSE2::alphaShuffle);
+        return blendComponents (src, dest, _mm256_sub_epi16 (_mm256_set1_epi16 (0x100), alpha));
+    }
+
+    JUCE_SPAN_BLENDING_AVX2_TARGET static int blendColour (uint8* dest, PixelARGB colour, int numPixels, uint32 keepMask) noexcept
+    {
+        const auto zero = _mm256_setzero_si256();
+        const auto src = _mm256_unpacklo_epi8 (_mm256_set1_epi32 ((int) colour.getNativeARGB()), zero);
+        const auto inverseAlpha = _mm256_set1_epi16 ((short) (0x100 - colour.getAlpha()));
+        const auto keep = _mm256_set1_epi32 ((int) keepMask);
+
+        int i = 0;
+
+        for (; i + 8 <= numPixels; i += 8)
+        {
+            auto* p = reinterpret_cast<__m256i*> (dest + i * 4);
+            const auto d = _mm256_loadu_si256 (p);
+            const auto result = _mm256_packus_epi16 (blendComponents (src, _mm256_unpacklo_epi8 (d, zero), inverseAlpha),
+                                                     blendComponents (src, _mm256_unpackhi_epi8 (d, zero), inverseAlpha));
+
+            _mm256_storeu_si256 (p, _mm256_or_si256 (_mm256_andnot_si256 (keep, result), _mm256_and_si256 (keep, d)));
+        }
+
+        return i;
+    }
+
+    JUCE_SPAN_BLENDING_AVX2_TARGET static int blendPixels (uint8* dest, const uint8* source, int numPixels, uint32 extraAlpha, uint32 keepMask) noexcept
+    {
+        const auto zero = _mm256_setzero_si256();
+        const auto extra = _mm256_set1_epi16 ((short) extraAlpha);
+        const auto keep = _mm256_set1_epi32 ((int) keepMask);
+
+        int i = 0;
+
+        for (; i + 8 <= numPixels; i += 8)
+        {
+            auto* p = reinterpret_cast<__m256i*> (dest + i * 4);
+            const auto d = _mm256_loadu_si256 (p);
+            const auto s = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (source + i * 4));
+            const auto result = _mm256_packus_epi16 (blendPixelComponents (_mm256_unpacklo_epi8 (s, zero), _mm256_unpacklo_epi8 (d, zero), extra),
+                                                     blendPixelComponents (_mm256_unpackhi_epi8 (s, zero), _mm256_unpackhi_epi8 (d, zero), extra));
+
+            _mm256_storeu_si256 (p, _mm256_or_si256 (_mm256_andnot_si256 (keep, result), _mm256_and_si256 (keep, d)));
+        }
+
+        return i;
+    }
+}
+
+#undef JUCE_SPAN_BLENDING_AVX2_TARGET
+
+static int blendColourKernel (uint8* dest, PixelARGB colour, int numPixels, uint32 keepMask) noexcept
+{
+    const auto done = AVX2::isAvailable() ? AVX2::blendColour (dest, colour, numPixels, keepMask) : 0;
+    return done + SSE2::blendColour (dest + done * 4, colour, numPixels - done, keepMask);
+}
+
+static int blendColourPackedKernel (uint8* dest, PixelARGB colour, int numPixels) noexcept
+{
+    return SSE2::blendColourPacked (dest, colour, numPixels);
+}
+
+static int blendPixelsKernel (uint8* dest, const uint8* source, int numPixels, uint32 extraAlpha, uint32 keepMask) noexcept
+{
+    const auto done = AVX2::isAvailable() ? AVX2::blendPixels (dest, source, numPixels, extraAlpha, keepMask) : 0;
+    return done + SSE2::blendPixels (dest + done * 4, source + done * 4, numPixels - done, extraAlpha, keepMask);
+}
+
+static int premultiplyKernel (uint8* pixels, int numPixels) noexcept
+{
+    return SSE2::premultiply (pixels, numPixels);
+}
+
+//==============================================================================
+#elif JUCE_SPAN_BLENDING_NEON
+namespace NEON
+{
+    static forcedinline uint16x8_t blendComponents (uint16x8_t src, uint16x8_t dest, uint16x8_t inverseAlpha) noexcept
+    {
+        return vaddq_u16 (src, vshrq_n_u16 (vmulq_u16 (dest, inverseAlpha), 8));
+    }
+
+    static forcedinline uint8x8_t blendPixelComponents (uint8x8_t src, uint8x8_t dest, uint16x8_t extraAlpha, uint8x8_t alphaIndexes) noexcept
+    {
+        const auto s = vshrq_n_u16 (vmulq_u16 (vmovl_u8 (src), extraAlpha), 8);
+        const auto alpha = vmovl_u8 (vtbl1_u8 (vmovn_u16 (s), alphaIndexes));
+        return vqmovn_u16 (blendComponents (s, vmovl_u8 (dest), vsubq_u16 (vdupq_n_u16 (0x100), alpha)));
+    }
+
+    static int blendColour (uint8* dest, PixelARGB colour, int numPixels, uint32 keepMask) noexcept
+    {
+        const auto src = vmovl_u8 (vreinterpret_u8_u32 (vdup_n_u32 (colour.getNativeARGB())));
+        const auto inverseAlpha = vdupq_n_u16 ((uint16) (0x100 - colour.getAlpha()));
+        const auto keep = vreinterpretq_u8_u32 (vdupq_n_u32 (keepMask));
+
+        int i = 0;
+
+        for (; i + 4 <= numPixels; i += 4)
+        {
+            auto* p = dest + i * 4;
+            const auto d = vld1q_u8 (p);
+            const auto result = vcombine_u8 (vqmovn_u16 (blendComponents (src, vmovl_u8 (vget_low_u8 (d)), inverseAlpha)),
+                                             vqmovn_u16 (blendComponents (src, vmovl_u8 (vget_high_u8 (d)), inverseAlpha)));
+
+            vst1q_u8 (p, vbslq_u8 (keep, d, result));
+        }
+
+        return i;
+    }
+
+    static int blendColourPacked (uint8* dest, PixelARGB colour, int numPixels) noexcept
+    {
+        // 16 three-byte pixels fill exactly three registers, so the source colour
+        // can be laid out as a repeating pattern of bytes
+        uint8 pattern[48];
+
+        for (int i = 0; i < 16; ++i)
+            reinterpret_cast<PixelRGB*> (pattern + i * 3)->set (colour);
+
+        const auto inverseAlpha = vdupq_n_u16 ((uint16) (0x100 - colour.getAlpha()));
+        uint16x8_t srcLo[3], srcHi[3];
+
+        for (int j = 0; j < 3; ++j)
+        {
+            const auto s = vld1q_u8 (pattern + j * 16);
+            srcLo[j] = vmovl_u8 (vget_low_u8 (s));
+            srcHi[j] = vmovl_u8 (vget_high_u8 (s));
+        }
+
+        int i = 0;
+
+        for (; i + 16 <= numPixels; i += 16)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                auto* p = dest + i * 3 + j * 16;
+                const auto d = vld1q_u8 (p);
+
+                vst1q_u8 (p, vcombine_u8 (vqmovn_u16 (blendComponents (srcLo[j], vmovl_u8 (vget_low_u8 (d)), inverseAlpha)),
+                                          vqmovn_u16 (blendComponents (srcHi[j], vmovl_u8 (vget_high_u8 (d)), inverseAlpha))));
+            }
+        }
+
+        return i;
+    }
+
+    static int blendPixels (uint8* dest, const uint8* source, int numPixels, uint32 extraAlpha, uint32 keepMask) noexcept
+    {
+        const uint8 indexes[] = { PixelARGB::indexA, PixelARGB::indexA, PixelARGB::indexA, PixelARGB::indexA,
+                                  PixelARGB::indexA + 4, PixelARGB::indexA + 4, PixelARGB::indexA + 4, PixelARGB::indexA + 4 };
+        const auto alphaIndexes = vld1_u8 (indexes);
+        const auto extra = vdupq_n_u16 ((uint16) extraAlpha);
+        const auto keep = vreinterpretq_u8_u32 (vdupq_n_u32 (keepMask));
+
+        int i = 0;
+
+        for (; i + 4 <= numPixels; i += 4)
+        {
+            auto* p = dest + i * 4;
+            const auto d = vld1q_u8 (p);
+            const auto s = vld1q_u8 (source + i * 4);
+            const auto result = vcombine_u8 (blendPixelComponents (vget_low_u8 (s),  vget_low_u8 (d),  extra, alphaIndexes),
+                                             blendPixelComponents (vget_high_u8 (s), vget_high_u8 (d), extra, alphaIndexes));
+
+            vst1q_u8 (p, vbslq_u8 (keep, d, result));
+        }
+
+        return i;
+    }
+
+    static forcedinline uint8x8_t premultiplyComponents (uint8x8_t pixels, uint8x8_t alphaIndexes) noexcept
+    {
+        const auto alpha = vtbl1_u8 (pixels, alphaIndexes);
+        const auto result = vshrn_n_u16 (vaddq_u16 (vmull_u8 (pixels, alpha), vdupq_n_u16 (0x7f)), 8);
+        return vbsl_u8 (vceq_u8 (alpha, vdup_n_u8 (0xff)), pixels, result);
+    }
+
+    static int premultiply (uint8* pixels, int numPixels) noexcept
+    {
+        const uint8 indexes[] = { PixelARGB::indexA, PixelARGB::indexA, PixelARGB::indexA, PixelARGB::indexA,
+                                  PixelARGB::indexA + 4, PixelARGB::indexA + 4, PixelARGB::indexA + 4, PixelARGB::indexA + 4 };
+        const auto alphaIndexes = vld1_u8 (indexes);
+        const auto keep = vreinterpretq_u8_u32 (vdupq_n_u32 (alphaByteMask));
+
+        int i = 0;
+
+        for (; i + 4 <= numPixels; i += 4)
+        {
+            auto* p = pixels + i * 4;
+            const auto d = vld1q_u8 (p);
+            const auto result = vcombine_u8 (premultiplyComponents (vget_low_u8 (d),  alphaIndexes),
+                                             premultiplyComponents (vget_high_u8 (d), alphaIndexes));
+
+            vst1q_u8 (p, vbslq_u8 (keep, d, result));
+        }
+
+        return i;
+    }
+}
+
+static int blendColourKernel (uint8* dest, PixelARGB colour, int numPixels, uint32 keepMask) noexcept
+{
+    return NEON::blendColour (dest, colour, numPixels, keepMask);
+}
+
+static int blendColourPackedKernel (uint8* dest, PixelARGB colour, int numPixels) noexcept
+{
+    return NEON::blendColourPacked (dest, colour, numPixels);
+}
+
+static int blendPixelsKernel (uint8* dest, const uint8* source, int numPixels, uint32 extraAlpha, uint32 keepMask) noexcept
+{
+    return NEON::blendPixels (dest, source, numPixels, extraAlpha, keepMask);
+}
+
+static int premultiplyKernel (uint8* pixels, int numPixels) noexcept
+{
+    return NEON::premultiply (pixels, numPixels);
+}
+
+//==============================================================================
+#else
+static int blendColourKernel (uint8*, PixelARGB, int, uint32) noexcept              { return 0; }
+static int blendColourPackedKernel (uint8*, PixelARGB, int) noexcept                { return 0; }
+static int blendPixelsKernel (uint8*, const uint8*, int, uint32, uint32) noexcept   { return 0; }
+static int premultiplyKernel (uint8*, int) noexcept                                 { return 0; }
+#endif
+
+//==============================================================================
+void blendColour (PixelARGB* dest, PixelARGB colour, int numPixels) noexcept
+{
+    for (int i = blendColourKernel (reinterpret_cast<uint8*> (dest), colour, numPixels, 0); i < numPixels; ++i)
+        dest[i].blend (colour);
+}
+
+void blendColour (PixelRGB* dest, int pixelStride, PixelARGB colour, int numPixels) noexcept
+{
+    jassert (pixelStride == 3 || (pixelStride == 4 && paddedRGBMatchesARGB));
+
+    auto* d = reinterpret_cast<uint8*> (dest);
+    const auto done = pixelStride == 3 ? blendColourPackedKernel (d, colour, numPixels)
+                                       : blendColourKernel (d, colour, numPixels, alphaByteMask);
+
+    for (int i = done; i < numPixels; ++i)
+        reinterpret_cast<PixelRGB*> (d + i * pixelStride)->blend (colour);
+}
+
+void blendPixels (PixelARGB* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha) noexcept
+{
+    jassert (extraAlpha <= 256);
+
+    const auto done = blendPixelsKernel (reinterpret_cast<uint8*> (dest), reinterpret_cast<const uint8*> (src),
+                                         numPixels, extraAlpha, 0);
+
+    for (int i = done; i < numPixels; ++i)
+        dest[i].blend (src[i], extraAlpha);
+}
+
+void blendPixels (PixelRGB* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha) noexcept
+{
+    jassert (extraAlpha <= 256 && paddedRGBMatchesARGB);
+
+    auto* d = reinterpret_cast<uint8*> (dest);
+    const auto done = blendPixelsKernel (d, reinterpret_cast<const uint8*> (src), numPixels, extraAlpha, alphaByteMask);
+
+    for (int i = done; i < numPixels; ++i)
+        reinterpret_cast<PixelRGB*> (d + i * 4)->blend (src[i], extraAlpha);
+}
+
+void premultiply (PixelARGB* pixels, int numPixels) noexcept
+{
+    for (int i = premultiplyKernel (reinterpret_cast<uint8*> (pixels), numPixels); i < numPixels; ++i)
+        pixels[i].premultiply();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SpanBlendingTests  : public UnitTest
+{
+public:
+    SpanBlendingTests()
+        : UnitTest ("SpanBlending", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Blending a colour matches blending each pixel");
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto colour = randomPremultipliedPixel (random);
+                const auto numPixels = random.nextInt (70);
+
+                expect (blendsMatch<PixelARGB> (random, 4, numPixels, [&] (auto* d)      { blendColour (d, colour, numPixels); },
+                                                                      [&] (auto& p, int) { p.blend (colour); }));
+
+                expect (blendsMatch<PixelRGB> (random, 3, numPixels, [&] (auto* d)      { blendColour (d, 3, colour, numPixels); },
+                                                                     [&] (auto& p, int) { p.blend (colour); }));
+
+                if (paddedRGBMatchesARGB)
+                    expect (blendsMatch<PixelRGB> (random, 4, numPixels, [&] (auto* d)      { blendColour (d, 4, colour, numPixels); },
+                                                                         [&] (auto& p, int) { p.blend (colour); }));
+            }
+        }
+
+        beginTest ("Blending pixels matches blending each pixel");
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto numPixels = random.nextInt (70);
+                const auto extraAlpha = (uint32) (random.nextBool() ? 256 : random.nextInt (257));
+
+                std::vector<PixelARGB> src ((size_t) numPixels);
+
+                for (auto& p : src)
+                    p = randomPremultipliedPixel (random);
+
+                expect (blendsMatch<PixelARGB> (random, 4, numPixels, [&] (auto* d)        { blendPixels (d, src.data(), numPixels, extraAlpha); },
+                                                                      [&] (auto& p, int x) { p.blend (src[(size_t) x], extraAlpha); }));
+
+                if (paddedRGBMatchesARGB)
+                    expect (blendsMatch<PixelRGB> (random, 4, numPixels, [&] (auto* d)        { blendPixels (d, src.data(), numPixels, extraAlpha); },
+                                                                         [&] (auto& p, int x) { p.blend (src[(size_t) x], extraAlpha); }));
+            }
+        }
+
+        beginTest ("Premultiplying a run matches premultiplying each pixel");
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto numPixels = random.nextInt (70);
+                std::vector<PixelARGB> expected ((size_t) numPixels);
+
+                for (auto& p : expected)
+                    p = randomStraightPixel (random);
+
+                auto actual = expected;
+
+                for (auto& p : expected)
+                    p.premultiply();
+
+                premultiply (actual.data(), numPixels);
+
+                expect (std::equal (expected.begin(), expected.end(), actual.begin(),
+                                    [] (auto a, auto b) { return a.getNativeARGB() == b.getNativeARGB(); }));
+            }
+        }
+    }
+
+private:
+    static PixelARGB randomPremultipliedPixel (Random& random)
+    {
+        auto p = randomStraightPixel (random);
+        p.premultiply();
+        return p;
+    }
+
+    static PixelARGB randomStraightPixel (Random& random)
+    {
+        PixelARGB p;
+        p.setARGB ((uint8) random.nextInt (256), (uint8) random.nextInt (256),
+                   (uint8) random.nextInt (256), (uint8) random.nextInt (256));
+
+        // a mixture of opaque, transparent and in-between pixels covers all the edge cases
+        switch (random.nextInt (4))
+        {
+            case 0:  p.setAlpha (0xff); break;
+            case 1:  p.setAlpha (0); break;
+            default: break;
+        }
+
+        return p;
+    }
+
+    template <class PixelType, typename SpanFn, typename PixelFn>
+    static bool blendsMatch (Random& random, int pixelStride, int numPixels, SpanFn&& blendSpan, PixelFn&& blendPixel)
+    {
+        // an extra pixel at each end checks that nothing outside the span is touched
+        HeapBlock<uint8> expected ((size_t) ((numPixels + 2) * pixelStride));
+        HeapBlock<uint8> actual   ((size_t) ((numPixels + 2) * pixelStride));
+
+        for (int i = 0; i < (numPixels + 2) * pixelStride; ++i)
+            expected[i] = actual[i] = (uint8) random.nextInt (256);
+
+        for (int x = 0; x < numPixels; ++x)
+            blendPixel (*reinterpret_cast<PixelType*> (expected + (x + 1) * pixelStride), x);
+
+        blendSpan (reinterpret_cast<PixelType*> (actual + pixelStride));
+
+        return std::equal (expected.get(), expected + (numPixels + 2) * pixelStride, actual.get());
+    }
+};
+
+static SpanBlendingTests spanBlendingTests;
+
+#endif
+
+} // namespace juce::RenderingHelpers::SpanBlending
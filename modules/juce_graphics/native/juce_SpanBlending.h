@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_USE_SIMD_SPAN_BLENDING && JUCE_INTEL && ! (JUCE_MINGW && ! defined (__SSE2__))
+ #define JUCE_SPAN_BLENDING_SSE2 1
+#elif JUCE_USE_SIMD_SPAN_BLENDING && (defined (__ARM_NEON__) || defined (__ARM_NEON))
+ #define JUCE_SPAN_BLENDING_NEON 1
+#endif
+
+namespace juce::RenderingHelpers::SpanBlending
+{
+
+//==============================================================================
+/*  These functions blend runs of premultiplied PixelARGB values onto contiguous rows of
+    destination pixels using SSE2 (and AVX2 when the CPU supports it) or NEON. The results
+    are bit-for-bit identical to calling PixelARGB::blend() or PixelRGB::blend() on each
+    pixel in turn.
+
+    The destination may be PixelARGB with a stride of 4, or PixelRGB with a stride of 3 or 4.
+    Use canBlendColour() and canBlendPixels() to find out whether a bitmap is suitable before
+    calling them - the edge table fillers fall back to their per-pixel loops otherwise.
+*/
+
+/** Returns true if the vectorised kernels were compiled in for this target. */
+constexpr bool isEnabled() noexcept
+{
+   #if JUCE_SPAN_BLENDING_SSE2 || JUCE_SPAN_BLENDING_NEON
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+/** True if a PixelRGB padded to 4 bytes has its components at the same offsets as a PixelARGB. */
+constexpr bool paddedRGBMatchesARGB = (int) PixelRGB::indexR == (int) PixelARGB::indexR
+                                   && (int) PixelRGB::indexG == (int) PixelARGB::indexG
+                                   && (int) PixelRGB::indexB == (int) PixelARGB::indexB;
+
+/** Returns true if blendColour() can be used on the given destination bitmap. */
+template <class PixelType>
+bool canBlendColour (const Image::BitmapData& dest) noexcept
+{
+    if constexpr (! isEnabled())
+        return false;
+    else if constexpr (std::is_same_v<PixelType, PixelARGB>)
+        return dest.pixelStride == 4;
+    else if constexpr (std::is_same_v<PixelType, PixelRGB>)
+        return dest.pixelStride == 3 || (dest.pixelStride == 4 && paddedRGBMatchesARGB);
+    else
+        return false;
+}
+
+/** Returns true if blendPixels() can be used on the given destination bitmap. */
+template <class PixelType>
+bool canBlendPixels (const Image::BitmapData& dest) noexcept
+{
+    if constexpr (! isEnabled())
+        return false;
+    else if constexpr (std::is_same_v<PixelType, PixelARGB>)
+        return dest.pixelStride == 4;
+    else if constexpr (std::is_same_v<PixelType, PixelRGB>)
+        return dest.pixelStride == 4 && paddedRGBMatchesARGB;
+    else
+        return false;
+}
+
+/** Blends a single colour over a run of pixels. */
+JUCE_API void blendColour (PixelARGB* dest, PixelARGB colour, int numPixels) noexcept;
+
+/** Blends a single colour over a run of RGB pixels, which may be 3 or 4 bytes apart. */
+JUCE_API void blendColour (PixelRGB* dest, int pixelStride, PixelARGB colour, int numPixels) noexcept;
+
+/** Blends a run of source pixels over a run of destination pixels.
+
+    The source's opacity is scaled by extraAlpha, which ranges from 0 to 256, where 256
+    leaves it unchanged.
+*/
+JUCE_API void blendPixels (PixelARGB* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha = 256) noexcept;
+
+/** Blends a run of source pixels over a run of RGB pixels which are padded to 4 bytes.
+
+    The source's opacity is scaled by extraAlpha, which ranges from 0 to 256, where 256
+    leaves it unchanged.
+*/
+JUCE_API void blendPixels (PixelRGB* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha = 256) noexcept;
+
+/** Premultiplies a run of pixels which hold straight (non-premultiplied) alpha.
+
+    This is what the image decoders use to convert each decoded row, and the result is
+    identical to calling PixelARGB::premultiply() on each pixel. Unlike the blending
+    functions it can be used whether or not the vectorised kernels are enabled.
+*/
+JUCE_API void premultiply (PixelARGB* pixels, int numPixels) noexcept;
+
+/** Spans shorter than this are quicker to blend one pixel at a time. */
+constexpr int minimumSpanLength = 8;
+
+/** Calls the blendColour() overload for a type of destination pixel which has passed canBlendColour(). */
+template <class PixelType>
+void blendColourSpan (PixelType* dest, int pixelStride, PixelARGB colour, int numPixels) noexcept
+{
+    if constexpr (std::is_same_v<PixelType, PixelARGB>)
+    {
+        blendColour (dest, colour, numPixels);
+    }
+    else if constexpr (std::is_same_v<PixelType, PixelRGB>)
+    {
+        blendColour (dest, pixelStride, colour, numPixels);
+    }
+    else
+    {
+        ignoreUnused (dest, pixelStride, colour, numPixels);
+        jassertfalse;
+    }
+}
+
+/** Calls the blendPixels() overload for a type of destination pixel which has passed canBlendPixels(). */
+template <class PixelType>
+void blendPixelSpan (PixelType* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha) noexcept
+{
+    if constexpr (std::is_same_v<PixelType, PixelARGB> || std::is_same_v<PixelType, PixelRGB>)
+    {
+        blendPixels (dest, src, numPixels, extraAlpha);
+    }
+    else
+    {
+        ignoreUnused (dest, src, numPixels, extraAlpha);
+        jassertfalse;
+    }
+}
+
+} // namespace juce::RenderingHelpers::SpanBlending
@@ -557,6 +557,59 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StandardCachedComponentImage)
 };
 
+//==============================================================================
+struct DisplayListCachedComponentImage final : public CachedComponentImage
+{
+    DisplayListCachedComponentImage (Component& c) noexcept : owner (c)  {}
+
+    void paint (Graphics& g) override
+    {
+        auto& context = g.getInternalContext();
+        const auto newScale = context.getPhysicalPixelScaleFactor();
+
+        // Anything that the component caches at the physical scale (e.g. images) would be
+        // wrong if the list were replayed at a different one
+        if (! isValid || ! approximatelyEqual (scale, newScale))
+        {
+            displayList.clear();
+
+            {
+                DisplayList::Recorder recorder (displayList, owner.getLocalBounds(), newScale);
+                Graphics rg (recorder);
+                owner.paintEntireComponent (rg, true);
+            }
+
+            scale = newScale;
+            isValid = true;
+        }
+
+        const auto alpha = owner.getAlpha();
+
+        if (alpha >= 1.0f)
+        {
+            displayList.replay (context);
+        }
+        else if (alpha > 0.0f)
+        {
+            context.beginTransparencyLayer (alpha);
+            displayList.replay (context);
+            context.endTransparencyLayer();
+        }
+    }
+
+    bool invalidateAll() override                    { isValid = false; return true; }
+    bool invalidate (const Rectangle<int>&) override { isValid = false; return true; }
+    void releaseResources() override                 { displayList.clear(); isValid = false; }
+
+private:
+    DisplayList displayList;
+    Component& owner;
+    float scale = 1.0f;
+    bool isValid = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DisplayListCachedComponentImage)
+};
+
 void Component::setCachedComponentImage (CachedComponentImage* newCachedImage)
 {
     if (cachedImage.get() != newCachedImage)
@@ -585,6 +638,22 @@ void Component::setBufferedToImage (bool shouldBeBuffered)
     }
 }
 
+void Component::setBufferedToDisplayList (bool shouldBeBuffered)
+{
+    // As with setBufferedToImage(), this would delete a custom CachedComponentImage that's in use.
+    jassert (cachedImage == nullptr || dynamic_cast<DisplayListCachedComponentImage*> (cachedImage.get()) != nullptr);
+
+    if (shouldBeBuffered)
+    {
+        if (cachedImage == nullptr)
+            cachedImage.reset (new DisplayListCachedComponentImage (*this));
+    }
+    else
+    {
+        cachedImage.reset();
+    }
+}
+
 //==============================================================================
 void Component::reorderChildInternal (int sourceIndex, int destIndex)
 {
@@ -813,6 +882,12 @@ void Component::setBounds (int x, int y, int w, int h)
 
     if (wasMoved || wasResized)
     {
+        if (auto* batch = flags.hasHeavyweightPeerFlag ? nullptr : BatchedBoundsUpdate::getActive())
+        {
+            setBoundsInBatch (*batch, { x, y, w, h }, wasMoved, wasResized);
+            return;
+        }
+
         const bool showing = isShowing();
 
         if (showing)
@@ -849,6 +924,113 @@ void Component::setBounds (int x, int y, int w, int h)
     }
 }
 
+//==============================================================================
+struct Component::BatchedBoundsUpdate::Pending
+{
+    void addRepaint (Component& parent, Rectangle<int> area)
+    {
+        auto& entry = repaints[&parent];
+
+        if (entry.first == nullptr)
+            entry = { &parent, area };
+        else
+            entry.second = entry.second.getUnion (area);
+    }
+
+    void addComponent (Component& c)
+    {
+        if (! c.flags.isInBoundsUpdateBatch)
+        {
+            c.flags.isInBoundsUpdateBatch = true;
+            components.emplace_back (&c);
+        }
+    }
+
+    void flush()
+    {
+        while (! (components.empty() && repaints.empty()))
+        {
+            const auto repaintsToMake = std::exchange (repaints, {});
+            const auto componentsToUpdate = std::exchange (components, {});
+
+            for (const auto& entry : repaintsToMake)
+                if (auto* parent = entry.second.first.getComponent())
+                    parent->internalRepaint (entry.second.second);
+
+            if (std::exchange (needsFakeMouseMove, false))
+            {
+                auto mainMouse = Desktop::getInstance().getMainMouseSource();
+
+                if (! mainMouse.isDragging())
+                    mainMouse.triggerFakeMove();
+            }
+
+            for (const auto& c : componentsToUpdate)
+                if (c != nullptr)
+                    c->flags.isInBoundsUpdateBatch = false;
+
+            for (const auto& c : componentsToUpdate)
+                if (auto* comp = c.getComponent())
+                    comp->sendMovedResizedMessagesIfPending();
+        }
+    }
+
+    std::unordered_map<Component*, std::pair<SafePointer<Component>, Rectangle<int>>> repaints;
+    std::vector<SafePointer<Component>> components;
+    bool needsFakeMouseMove = false;
+};
+
+Component::BatchedBoundsUpdate::Pending* Component::BatchedBoundsUpdate::active = nullptr;
+
+Component::BatchedBoundsUpdate::BatchedBoundsUpdate()
+{
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    if (active == nullptr)
+    {
+        pending = std::make_unique<Pending>();
+        active = pending.get();
+    }
+}
+
+Component::BatchedBoundsUpdate::~BatchedBoundsUpdate()
+{
+    if (pending != nullptr)
+    {
+        pending->flush();
+        active = nullptr;
+    }
+}
+
+void Component::setBoundsInBatch (BatchedBoundsUpdate::Pending& batch, Rectangle<int> newBounds,
+                                  bool wasMoved, bool wasResized)
+{
+    if (isShowing() && parentComponent != nullptr)
+    {
+        if (! (flags.ignoresMouseClicksFlag && ! flags.allowChildMouseClicksFlag))
+            batch.needsFakeMouseMove = true;
+
+        batch.addRepaint (*parentComponent, detail::ComponentHelpers::convertToParentSpace (*this, getLocalBounds()));
+        boundsRelativeToParent = newBounds;
+        batch.addRepaint (*parentComponent, detail::ComponentHelpers::convertToParentSpace (*this, getLocalBounds()));
+
+        if (wasResized && cachedImage != nullptr)
+            cachedImage->invalidateAll();
+    }
+    else
+    {
+        boundsRelativeToParent = newBounds;
+
+        if (cachedImage != nullptr)
+            cachedImage->invalidateAll();
+    }
+
+    flags.isMoveCallbackPending = flags.isMoveCallbackPending || wasMoved;
+    flags.isResizeCallbackPending = flags.isResizeCallbackPending || wasResized;
+
+    batch.addComponent (*this);
+}
+
 void Component::sendMovedResizedMessagesIfPending()
 {
     const bool wasMoved   = flags.isMoveCallbackPending;
@@ -1664,6 +1846,8 @@ void Component::paintWithinParentContext (Graphics& g)
 
 void Component::paintComponentAndChildren (Graphics& g)
 {
+    JUCE_TRACE_SCOPE ("gui", "Component::paint");
+
     auto clipBounds = g.getClipBounds();
 
     if (flags.dontClipGraphicsFlag && getNumChildComponents() == 0)
@@ -2987,4 +3171,95 @@ AccessibilityHandler* Component::getAccessibilityHandler()
     return accessibilityHandler.get();
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class BatchedBoundsUpdateTests final : public UnitTest
+{
+public:
+    BatchedBoundsUpdateTests()
+        : UnitTest ("Component::BatchedBoundsUpdate", UnitTestCategories::gui)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Callbacks are postponed until the outermost batch ends");
+        {
+            Component parent;
+            CountingComponent a, b;
+            parent.setBounds (0, 0, 100, 100);
+            parent.addAndMakeVisible (a);
+            parent.addAndMakeVisible (b);
+
+            {
+                const Component::BatchedBoundsUpdate batch;
+
+                a.setBounds (0, 0, 10, 10);
+                a.setBounds (0, 0, 20, 20);
+                b.setTopLeftPosition (5, 5);
+
+                {
+                    const Component::BatchedBoundsUpdate nestedBatch;
+                    b.setSize (30, 30);
+                }
+
+                expect (a.getBounds() == Rectangle<int> (0, 0, 20, 20));
+                expect (b.getBounds() == Rectangle<int> (5, 5, 30, 30));
+                expectEquals (a.numResizes + b.numResizes + b.numMoves, 0);
+            }
+
+            expectEquals (a.numResizes, 1);
+            expectEquals (a.numMoves, 0);
+            expectEquals (b.numResizes, 1);
+            expectEquals (b.numMoves, 1);
+        }
+
+        beginTest ("Bounds changed by postponed callbacks are handled in the same batch");
+        {
+            CountingComponent parent, child;
+            parent.addAndMakeVisible (child);
+            parent.onResized = [&] { child.setBounds (parent.getLocalBounds().reduced (10)); };
+
+            {
+                const Component::BatchedBoundsUpdate batch;
+                parent.setBounds (0, 0, 100, 50);
+            }
+
+            expectEquals (parent.numResizes, 1);
+            expectEquals (child.numResizes, 1);
+            expect (child.getBounds() == Rectangle<int> (10, 10, 80, 30));
+        }
+
+        beginTest ("Components can be deleted during a batch");
+        {
+            Component parent;
+            auto child = std::make_unique<CountingComponent>();
+            parent.addAndMakeVisible (*child);
+
+            const Component::BatchedBoundsUpdate batch;
+            child->setBounds (0, 0, 10, 10);
+            child.reset();
+        }
+    }
+
+private:
+    struct CountingComponent final : public Component
+    {
+        void resized() override
+        {
+            ++numResizes;
+            NullCheckedInvocation::invoke (onResized);
+        }
+
+        void moved() override   { ++numMoves; }
+
+        std::function<void()> onResized;
+        int numResizes = 0, numMoves = 0;
+    };
+};
+
+static BatchedBoundsUpdateTests batchedBoundsUpdateTests;
+
+#endif
+
 } // namespace juce
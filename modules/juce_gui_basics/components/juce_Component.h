@@ -472,12 +472,14 @@ public:
 
         If this method changes the component's top-left position, it will make a synchronous
         call to moved(). If it changes the size, it will also make a call to resized().
+        These calls are postponed while a BatchedBoundsUpdate object exists.
 
         Note that if you've used setTransform() to apply a transform, then the component's
         bounds will no longer be a direct reflection of the position at which it appears within
         its parent, as the transform will be applied to whatever bounds you set for it.
 
-        @see setTopLeftPosition, setSize, ComponentListener::componentMovedOrResized
+        @see setTopLeftPosition, setSize, ComponentListener::componentMovedOrResized,
+             BatchedBoundsUpdate
     */
     void setBounds (int x, int y, int width, int height);
 
@@ -1068,6 +1070,27 @@ public:
     */
     void setBufferedToImage (bool shouldBeBuffered);
 
+    /** Makes the component record its painting into a DisplayList, and replay that
+        instead of calling paint() again.
+
+        This is a lighter-weight alternative to setBufferedToImage(). The list holds the
+        drawing operations performed by this component and its children rather than their
+        pixels, so it costs very little memory and can be redrawn at any scale or position.
+        When the component moves or is scrolled, it's drawn by replaying the same list at
+        the new position.
+
+        The list is recorded again at the next paint after repaint() is called on this
+        component or any of its children. Children that are also buffered to a display list
+        replay their own lists while the parent is being recorded, so only the components
+        that have actually changed need to paint.
+
+        Painting that depends on anything other than the component's state, such as the
+        current time, won't be updated until repaint() is called.
+
+        @see setBufferedToImage, DisplayList
+    */
+    void setBufferedToDisplayList (bool shouldBeBuffered);
+
     /** Generates a snapshot of part of this component.
 
         This will return a new Image, the size of the rectangle specified,
@@ -2363,6 +2386,55 @@ public:
         JUCE_DECLARE_NON_COPYABLE (BailOutChecker)
     };
 
+    //==============================================================================
+    /**
+        Postpones the callbacks and repaints caused by moving or resizing components.
+
+        While one of these objects exists, setBounds() and the methods that use it still
+        change a component's bounds straight away. However, the calls to moved(), resized(),
+        parentSizeChanged(), childBoundsChanged() and ComponentListener::componentMovedOrResized()
+        are held back until the outermost BatchedBoundsUpdate is deleted. The areas that need
+        repainting are merged too, so that each parent gets a single repaint, rather than
+        one for every child that moved.
+
+        This makes it cheaper to lay out a large number of components at once, e.g.
+        @code
+        void resized() override
+        {
+            const BatchedBoundsUpdate batch;
+
+            for (auto* cell : cells)
+                cell->setBounds (getBoundsForCell (*cell));
+        }
+        @endcode
+
+        Any components whose bounds change while the postponed callbacks are being made
+        are handled as part of the same batch.
+
+        Bear in mind that inside the scope, the components that have been resized won't
+        have laid out their own children yet. Components that are on the desktop aren't
+        batched. These objects may be nested, and must only be used on the message thread.
+    */
+    class JUCE_API  BatchedBoundsUpdate
+    {
+    public:
+        /** Starts postponing bounds-change callbacks, if they're not already being postponed. */
+        BatchedBoundsUpdate();
+
+        /** Makes any postponed callbacks and repaints, if this is the outermost batch. */
+        ~BatchedBoundsUpdate();
+
+    private:
+        struct Pending;
+        std::unique_ptr<Pending> pending;
+
+        friend class Component;
+        static Pending* active;
+        static Pending* getActive() noexcept    { return active; }
+
+        JUCE_DECLARE_NON_COPYABLE (BatchedBoundsUpdate)
+    };
+
     //==============================================================================
     /**
         Base class for objects that can be used to automatically position a component according to
@@ -2609,6 +2681,7 @@ private:
         bool viewportIgnoreDragFlag       : 1;
         bool accessibilityIgnoredFlag     : 1;
         bool cachedMouseInsideComponent   : 1;
+        bool isInBoundsUpdateBatch        : 1;
        #if JUCE_DEBUG
         bool isInsidePaintCall            : 1;
        #endif
@@ -2648,6 +2721,7 @@ private:
     void paintWithinParentContext (Graphics&);
     void sendMovedResizedMessages (bool wasMoved, bool wasResized);
     void sendMovedResizedMessagesIfPending();
+    void setBoundsInBatch (BatchedBoundsUpdate::Pending&, Rectangle<int>, bool wasMoved, bool wasResized);
     void repaintParent();
     void sendFakeMouseMove() const;
     void takeKeyboardFocus (FocusChangeType, FocusChangeDirection);
@@ -48,6 +48,76 @@ struct WindowingHelpers
         return Process::isForegroundProcess() || isEmbeddedInForegroundProcess (viewComponent);
     }
 
+    /*  Simplifies a region of a window that needs repainting, before it's painted once per frame.
+
+        Painting and presenting a few larger rectangles is usually cheaper than many small ones,
+        so rectangles are joined wherever that adds little area that doesn't need painting. If
+        the rectangles already cover most of their bounding box, or there are very many of them,
+        the whole bounding box is used instead. The result always covers the original region.
+    */
+    template <typename Value>
+    static void coalesceRepaintRegion (RectangleList<Value>& region, int maxNumRectangles = 8)
+    {
+        const auto numRectangles = region.getNumRectangles();
+
+        if (numRectangles <= 1)
+            return;
+
+        const auto getArea = [] (Rectangle<Value> r) { return (double) r.getWidth() * (double) r.getHeight(); };
+        const auto bounds = region.getBounds();
+
+        double coveredArea = 0.0;
+
+        for (auto& r : region)
+            coveredArea += getArea (r);
+
+        if (numRectangles > maxNumRectangles * 4 || coveredArea >= getArea (bounds) * 0.75)
+        {
+            region = RectangleList<Value> (bounds);
+            return;
+        }
+
+        std::vector<Rectangle<Value>> rects (region.begin(), region.end());
+
+        for (;;)
+        {
+            // Find the pair of rectangles whose union adds the least unneeded area
+            size_t bestA = 0, bestB = 0;
+            auto bestWaste = std::numeric_limits<double>::max();
+
+            for (size_t a = 0; a < rects.size(); ++a)
+            {
+                for (size_t b = a + 1; b < rects.size(); ++b)
+                {
+                    const auto waste = getArea (rects[a].getUnion (rects[b])) - getArea (rects[a]) - getArea (rects[b]);
+
+                    if (waste < bestWaste)
+                    {
+                        bestWaste = waste;
+                        bestA = a;
+                        bestB = b;
+                    }
+                }
+            }
+
+            if (bestA == bestB)
+                break;
+
+            const auto joined = rects[bestA].getUnion (rects[bestB]);
+
+            if ((int) rects.size() <= maxNumRectangles && bestWaste > getArea (joined) * 0.25)
+                break;
+
+            rects[bestA] = joined;
+            rects.erase (rects.begin() + (std::ptrdiff_t) bestB);
+        }
+
+        region.clear();
+
+        for (auto& r : rects)
+            region.add (r);
+    }
+
     template <typename Value>
     static BorderSize<int> roundToInt (BorderSize<Value> border)
     {
@@ -138,6 +138,7 @@
 
 #if JUCE_MAC || JUCE_IOS
  #include "native/accessibility/juce_AccessibilitySharedCode_mac.mm"
+ #include "native/juce_MetalGraphicsContext_mac.h"
  #include "native/juce_CGMetalLayerRenderer_mac.h"
 
  #if JUCE_IOS
@@ -342,6 +343,7 @@
 #include "widgets/juce_ToolbarItemComponent.cpp"
 #include "widgets/juce_ToolbarItemPalette.cpp"
 #include "widgets/juce_TreeView.cpp"
+#include "widgets/juce_TreeListBox.cpp"
 #include "windows/juce_NativeMessageBox.cpp"
 #include "windows/juce_AlertWindow.cpp"
 #include "windows/juce_CallOutBox.cpp"
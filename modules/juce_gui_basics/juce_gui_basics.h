@@ -278,6 +278,7 @@ namespace juce
 #include "misc/juce_FocusOutline.h"
 #include "misc/juce_JUCESplashScreen.h"
 #include "widgets/juce_TreeView.h"
+#include "widgets/juce_TreeListBox.h"
 #include "windows/juce_TopLevelWindow.h"
 #include "windows/juce_MessageBoxOptions.h"
 #include "windows/juce_ScopedMessageBox.h"
@@ -753,23 +753,66 @@ FlexBox::FlexBox (Direction d, Wrap w, AlignContent ac, AlignItems ai, JustifyCo
 {
 }
 
+static bool haveSameLayoutProperties (const FlexItem& a, const FlexItem& b) noexcept
+{
+    const auto tie = [] (const FlexItem& i)
+    {
+        return std::tie (i.order, i.flexGrow, i.flexShrink, i.flexBasis, i.alignSelf,
+                         i.width, i.minWidth, i.maxWidth, i.height, i.minHeight, i.maxHeight,
+                         i.margin.left, i.margin.right, i.margin.top, i.margin.bottom);
+    };
+
+    return tie (a) == tie (b);
+}
+
+bool FlexBox::canReuseLastLayout (Rectangle<float> targetArea) const
+{
+    if (! lastLayout.has_value()
+         || lastLayout->flexDirection != flexDirection
+         || lastLayout->flexWrap != flexWrap
+         || lastLayout->alignContent != alignContent
+         || lastLayout->alignItems != alignItems
+         || lastLayout->justifyContent != justifyContent
+         || ! exactlyEqual (lastLayout->width, targetArea.getWidth())
+         || ! exactlyEqual (lastLayout->height, targetArea.getHeight())
+         || lastLayout->items.size() != items.size())
+        return false;
+
+    for (int i = 0; i < items.size(); ++i)
+        if (! haveSameLayoutProperties (items.getReference (i), lastLayout->items.getReference (i)))
+            return false;
+
+    return true;
+}
+
 void FlexBox::performLayout (Rectangle<float> targetArea)
 {
     if (! items.isEmpty())
     {
-        FlexBoxLayoutCalculation layout (*this, targetArea.getWidth(), targetArea.getHeight());
-
-        layout.createStates();
-        layout.initialiseItems();
-        layout.resolveFlexibleLengths();
-        layout.resolveAutoMarginsOnMainAxis();
-        layout.calculateCrossSizesByLine();
-        layout.calculateCrossSizeOfAllItems();
-        layout.alignLinesPerAlignContent();
-        layout.resolveAutoMarginsOnCrossAxis();
-        layout.alignItemsInCrossAxisInLinesPerAlignSelf();
-        layout.alignItemsByJustifyContent();
-        layout.layoutAllItems();
+        if (canReuseLastLayout (targetArea))
+        {
+            for (int i = 0; i < items.size(); ++i)
+                items.getReference (i).currentBounds = lastLayout->items.getReference (i).currentBounds;
+        }
+        else
+        {
+            FlexBoxLayoutCalculation layout (*this, targetArea.getWidth(), targetArea.getHeight());
+
+            layout.createStates();
+            layout.initialiseItems();
+            layout.resolveFlexibleLengths();
+            layout.resolveAutoMarginsOnMainAxis();
+            layout.calculateCrossSizesByLine();
+            layout.calculateCrossSizeOfAllItems();
+            layout.alignLinesPerAlignContent();
+            layout.resolveAutoMarginsOnCrossAxis();
+            layout.alignItemsInCrossAxisInLinesPerAlignSelf();
+            layout.alignItemsByJustifyContent();
+            layout.layoutAllItems();
+
+            lastLayout = LastLayout { flexDirection, flexWrap, alignContent, alignItems, justifyContent,
+                                      targetArea.getWidth(), targetArea.getHeight(), items };
+        }
 
         for (auto& item : items)
         {
@@ -1139,6 +1182,30 @@ public:
                 expect (flex.items[2].currentBounds == Rectangle<float> (rect.getX(), rect.getBottom() + spacer, 10.0f, 10.0f));
             }
         }
+
+        beginTest ("repeating a layout gives the same results, and changes to the items are picked up");
+        {
+            juce::FlexBox inner;
+            inner.flexDirection = Direction::column;
+            inner.items = { FlexItem().withFlex (1.0f), FlexItem().withFlex (1.0f) };
+
+            juce::FlexBox flex;
+            flex.items = { FlexItem().withWidth (100.0f), FlexItem (inner).withFlex (1.0f) };
+
+            flex.performLayout (rect);
+            expect (inner.items[1].currentBounds == Rectangle<float> (rect.getX() + 100.0f, rect.getCentreY(), 200.0f, 100.0f));
+
+            const auto moved = rect.translated (5.0f, 5.0f);
+            flex.performLayout (moved);
+            expect (flex.items[0].currentBounds == Rectangle<float> (moved.getX(), moved.getY(), 100.0f, moved.getHeight()));
+            expect (inner.items[1].currentBounds == Rectangle<float> (moved.getX() + 100.0f, moved.getCentreY(), 200.0f, 100.0f));
+
+            flex.items.getReference (0).width = 50.0f;
+            inner.items.getReference (0).flexGrow = 3.0f;
+            flex.performLayout (moved);
+            expect (flex.items[0].currentBounds == Rectangle<float> (moved.getX(), moved.getY(), 50.0f, moved.getHeight()));
+            expect (inner.items[1].currentBounds == Rectangle<float> (moved.getX() + 50.0f, moved.getY() + 150.0f, 250.0f, 50.0f));
+        }
     }
 };
 
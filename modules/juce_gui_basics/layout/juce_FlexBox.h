@@ -100,7 +100,13 @@ public:
     FlexBox (JustifyContent) noexcept;
 
     //==============================================================================
-    /** Lays-out the box's items within the given rectangle. */
+    /** Lays-out the box's items within the given rectangle.
+
+        If neither the box's properties, its items, nor the size of the target area have
+        changed since the last call, the previous layout is reused and just moved to the
+        new position. Nested boxes each do the same, so only the parts of a layout that
+        have changed get recalculated.
+    */
     void performLayout (Rectangle<float> targetArea);
 
     /** Lays-out the box's items within the given rectangle. */
@@ -137,6 +143,21 @@ public:
     Array<FlexItem> items;
 
 private:
+    struct LastLayout
+    {
+        Direction flexDirection;
+        Wrap flexWrap;
+        AlignContent alignContent;
+        AlignItems alignItems;
+        JustifyContent justifyContent;
+        float width, height;
+        Array<FlexItem> items;
+    };
+
+    std::optional<LastLayout> lastLayout;
+
+    bool canReuseLastLayout (Rectangle<float>) const;
+
     JUCE_LEAK_DETECTOR (FlexBox)
 };
 
@@ -1101,8 +1101,87 @@ float Grid::TrackInfo::getAbsoluteSize (float relativeFractionalUnit) const
 }
 
 //==============================================================================
+static bool haveSameLayoutProperties (const Grid::TrackInfo& a, const Grid::TrackInfo& b) noexcept
+{
+    const auto tie = [] (const Grid::TrackInfo& t)
+    {
+        return std::make_tuple (t.getSize(), t.isFractional(), t.isAuto(), t.getStartLineName(), t.getEndLineName());
+    };
+
+    return tie (a) == tie (b);
+}
+
+static bool haveSameLayoutProperties (const Array<Grid::TrackInfo>& a, const Array<Grid::TrackInfo>& b) noexcept
+{
+    return std::equal (a.begin(), a.end(), b.begin(), b.end(),
+                       [] (const auto& x, const auto& y) { return haveSameLayoutProperties (x, y); });
+}
+
+static bool haveSameLayoutProperties (const GridItem& a, const GridItem& b) noexcept
+{
+    const auto tieProperty = [] (const GridItem::Property& p)
+    {
+        return std::make_tuple (p.hasSpan(), p.hasAbsolute(), p.hasAuto(), p.getName(), p.getNumber());
+    };
+
+    const auto tie = [&] (const GridItem& i)
+    {
+        return std::make_tuple (i.order, i.justifySelf, i.alignSelf,
+                                tieProperty (i.column.start), tieProperty (i.column.end),
+                                tieProperty (i.row.start), tieProperty (i.row.end), i.area,
+                                i.width, i.minWidth, i.maxWidth, i.height, i.minHeight, i.maxHeight,
+                                i.margin.left, i.margin.right, i.margin.top, i.margin.bottom);
+    };
+
+    return tie (a) == tie (b);
+}
+
+bool Grid::canReuseLastLayout (Rectangle<int> targetArea) const
+{
+    if (! lastLayout.has_value()
+         || lastLayout->justifyItems != justifyItems
+         || lastLayout->alignItems != alignItems
+         || lastLayout->justifyContent != justifyContent
+         || lastLayout->alignContent != alignContent
+         || lastLayout->autoFlow != autoFlow
+         || lastLayout->templateAreas != templateAreas
+         || ! exactlyEqual (lastLayout->columnGap.pixels, columnGap.pixels)
+         || ! exactlyEqual (lastLayout->rowGap.pixels, rowGap.pixels)
+         || lastLayout->width != targetArea.getWidth()
+         || lastLayout->height != targetArea.getHeight()
+         || ! haveSameLayoutProperties (lastLayout->autoRows, autoRows)
+         || ! haveSameLayoutProperties (lastLayout->autoColumns, autoColumns)
+         || ! haveSameLayoutProperties (lastLayout->templateColumns, templateColumns)
+         || ! haveSameLayoutProperties (lastLayout->templateRows, templateRows))
+        return false;
+
+    return std::equal (items.begin(), items.end(), lastLayout->items.begin(), lastLayout->items.end(),
+                       [] (const auto& x, const auto& y) { return haveSameLayoutProperties (x, y); });
+}
+
 void Grid::performLayout (Rectangle<int> targetArea)
 {
+    if (! canReuseLastLayout (targetArea))
+    {
+        lastLayout = LastLayout { justifyItems, alignItems, justifyContent, alignContent, autoFlow,
+                                  templateColumns, templateRows, templateAreas, autoRows, autoColumns,
+                                  columnGap, rowGap, targetArea.getWidth(), targetArea.getHeight(),
+                                  items, calculateLayout (targetArea.getWidth(), targetArea.getHeight()) };
+    }
+
+    for (const auto& result : lastLayout->results)
+    {
+        auto& item = items.getReference (result.index);
+        item.currentBounds = result.bounds + targetArea.toFloat().getPosition();
+
+        if (auto* c = item.associatedComponent)
+            c->setBounds (result.componentBounds + targetArea.getPosition());
+    }
+}
+
+std::vector<Grid::LaidOutItem> Grid::calculateLayout (int width, int height)
+{
+    const Rectangle<int> targetArea { width, height };
     const auto itemsAndAreas = Helpers::AutoPlacement().deduceAllItems (*this);
 
     auto implicitTracks = Helpers::AutoPlacement::createImplicitTracks (*this, itemsAndAreas);
@@ -1124,6 +1203,9 @@ void Grid::performLayout (Rectangle<int> targetArea)
     doComputeSizes (calculation);
     doComputeSizes (roundedCalculation);
 
+    std::vector<LaidOutItem> results;
+    results.reserve ((size_t) itemsAndAreas.size());
+
     for (auto& itemAndArea : itemsAndAreas)
     {
         auto* item = itemAndArea.first;
@@ -1150,11 +1232,12 @@ void Grid::performLayout (Rectangle<int> targetArea)
             return rounded (Helpers::BoxAlignment::alignItem (*item, *this, areaBounds));
         };
 
-        item->currentBounds = getBounds (calculation) + targetArea.toFloat().getPosition();
-
-        if (auto* c = item->associatedComponent)
-            c->setBounds (getBounds (roundedCalculation).toNearestIntEdges() + targetArea.getPosition());
+        results.push_back ({ (int) (item - items.begin()),
+                             getBounds (calculation),
+                             getBounds (roundedCalculation).toNearestIntEdges() });
     }
+
+    return results;
 }
 
 //==============================================================================
@@ -1179,6 +1262,30 @@ struct GridTests final : public UnitTest
             grid.performLayout (bounds);
         }
 
+        beginTest ("Repeating a layout gives the same results, and changes to the grid are picked up");
+        {
+            Grid grid;
+
+            grid.templateColumns.add (Tr (1_fr));
+            grid.templateRows.addArray ({ Tr (20_px), Tr (1_fr) });
+
+            grid.items.addArray ({ GridItem().withArea (1, 1),
+                                   GridItem().withArea (2, 1) });
+
+            grid.performLayout (Rectangle<int> (200, 400));
+            grid.performLayout (Rectangle<int> (10, 20, 200, 400));
+
+            expect (grid.items[0].currentBounds == Rect (10.0f, 20.0f, 200.f, 20.0f));
+            expect (grid.items[1].currentBounds == Rect (10.0f, 40.0f, 200.f, 380.0f));
+
+            grid.templateRows.getReference (0) = Tr (50_px);
+            grid.items.getReference (1).margin = GridItem::Margin (5.0f);
+            grid.performLayout (Rectangle<int> (10, 20, 200, 400));
+
+            expect (grid.items[0].currentBounds == Rect (10.0f, 20.0f, 200.f, 50.0f));
+            expect (grid.items[1].currentBounds == Rect (15.0f, 75.0f, 190.f, 340.0f));
+        }
+
         {
             Grid grid;
 
@@ -202,7 +202,12 @@ public:
     Array<GridItem> items;
 
     //==============================================================================
-    /** Lays-out the grid's items within the given rectangle. */
+    /** Lays-out the grid's items within the given rectangle.
+
+        If neither the grid's properties, its items, nor the size of the target area have
+        changed since the last call, the previous layout is reused and just moved to the
+        new position.
+    */
     void performLayout (Rectangle<int>);
 
     //==============================================================================
@@ -214,6 +219,34 @@ public:
 private:
     //==============================================================================
     struct Helpers;
+
+    struct LaidOutItem
+    {
+        int index;
+        Rectangle<float> bounds;
+        Rectangle<int> componentBounds;
+    };
+
+    struct LastLayout
+    {
+        JustifyItems justifyItems;
+        AlignItems alignItems;
+        JustifyContent justifyContent;
+        AlignContent alignContent;
+        AutoFlow autoFlow;
+        Array<TrackInfo> templateColumns, templateRows;
+        StringArray templateAreas;
+        TrackInfo autoRows, autoColumns;
+        Px columnGap, rowGap;
+        int width, height;
+        Array<GridItem> items;
+        std::vector<LaidOutItem> results;
+    };
+
+    std::optional<LastLayout> lastLayout;
+
+    bool canReuseLastLayout (Rectangle<int>) const;
+    std::vector<LaidOutItem> calculateLayout (int width, int height);
 };
 
 constexpr Grid::Px operator""_px (long double px)          { return Grid::Px { px }; }
@@ -119,23 +119,6 @@ public:
 
         auto sharedTexture = resources->getSharedTexture();
 
-        auto encodeBlit = [] (id<MTLCommandBuffer> commandBuffer,
-                              id<MTLTexture> source,
-                              id<MTLTexture> destination)
-        {
-            auto blitCommandEncoder = [commandBuffer blitCommandEncoder];
-            [blitCommandEncoder copyFromTexture: source
-                                    sourceSlice: 0
-                                    sourceLevel: 0
-                                   sourceOrigin: MTLOrigin{}
-                                     sourceSize: MTLSize { source.width, source.height, 1 }
-                                      toTexture: destination
-                               destinationSlice: 0
-                               destinationLevel: 0
-                              destinationOrigin: MTLOrigin{}];
-            [blitCommandEncoder endEncoding];
-        };
-
         if (renderSync)
         {
             @autoreleasepool
@@ -192,6 +175,96 @@ public:
         return dirtyRegions;
     }
 
+    /*  Like drawRectangleList(), but the callback paints into a MetalGraphicsContext, so that the
+        rendering is done on the GPU rather than by CoreGraphics.
+
+        Returns any regions that weren't redrawn, and which should be retried next frame.
+    */
+    template <typename Callback>
+    [[nodiscard]] RectangleList<float> drawRectangleListWithMetal (CAMetalLayer* layer,
+                                                                   float scaleFactor,
+                                                                   Callback&& paint,
+                                                                   RectangleList<float> dirtyRegions,
+                                                                   const bool renderSync)
+    {
+        layer.presentsWithTransaction = renderSync;
+        layer.contentsScale = scaleFactor;
+
+        const auto drawableSizeTransform = CGAffineTransformMakeScale (layer.contentsScale, layer.contentsScale);
+        const auto transformedFrameSize = CGSizeApplyAffineTransform (layer.bounds.size, drawableSizeTransform);
+
+        if (CGSizeEqualToSize (transformedFrameSize, CGSizeZero))
+            return dirtyRegions;
+
+        if (resources == nullptr || ! CGSizeEqualToSize (layer.drawableSize, transformedFrameSize))
+        {
+            layer.drawableSize = transformedFrameSize;
+            resources = std::make_unique<Resources> (device.get(), layer);
+            dirtyRegions.clear();
+            dirtyRegions.add (convertToRectFloat (layer.bounds));
+        }
+
+        if (programs == nullptr)
+            programs = std::make_unique<MetalRendering::Programs> (device.get());
+
+        if (! programs->isValid())
+        {
+            jassertfalse;
+            return dirtyRegions;
+        }
+
+        auto renderTarget = resources->getRenderTarget (device.get(), layer);
+
+        if (renderTarget.texture == nullptr)
+        {
+            jassertfalse;
+            return dirtyRegions;
+        }
+
+        @autoreleasepool
+        {
+            id<MTLCommandBuffer> commandBuffer = [commandQueue.get() commandBuffer];
+
+            RectangleList<int> clip;
+
+            for (auto rect : dirtyRegions)
+                clip.add ((rect * scaleFactor).getSmallestIntegerContainer());
+
+            clip.clipTo (Rectangle<int> ((int) renderTarget.texture.width, (int) renderTarget.texture.height));
+
+            {
+                MetalGraphicsContext context (*programs, commandBuffer, renderTarget.view, clip);
+                context.addTransform (AffineTransform::scale (scaleFactor));
+                paint (context);
+            }
+
+            if (id<CAMetalDrawable> drawable = [layer nextDrawable])
+            {
+                encodeBlit (commandBuffer, renderTarget.texture, drawable.texture);
+
+                if (renderSync)
+                {
+                    [commandBuffer commit];
+                    [commandBuffer waitUntilScheduled];
+                    [drawable present];
+                }
+                else
+                {
+                    [commandBuffer presentDrawable: drawable];
+                    [commandBuffer commit];
+                }
+            }
+            else
+            {
+                // The render target keeps its contents, so they'll be presented next time
+                [commandBuffer commit];
+            }
+        }
+
+        dirtyRegions.clear();
+        return dirtyRegions;
+    }
+
 private:
     //==============================================================================
     explicit CoreGraphicsMetalLayerRenderer (ObjCObjectHandle<id<MTLDevice>> mtlDevice)
@@ -200,6 +273,23 @@ private:
     {
     }
 
+    static void encodeBlit (id<MTLCommandBuffer> commandBuffer,
+                            id<MTLTexture> source,
+                            id<MTLTexture> destination)
+    {
+        auto blitCommandEncoder = [commandBuffer blitCommandEncoder];
+        [blitCommandEncoder copyFromTexture: source
+                                sourceSlice: 0
+                                sourceLevel: 0
+                               sourceOrigin: MTLOrigin{}
+                                 sourceSize: MTLSize { source.width, source.height, 1 }
+                                  toTexture: destination
+                           destinationSlice: 0
+                           destinationLevel: 0
+                          destinationOrigin: MTLOrigin{}];
+        [blitCommandEncoder endEncoding];
+    }
+
     //==============================================================================
     static auto alignTo (size_t n, size_t alignment)
     {
@@ -282,6 +372,34 @@ private:
             gpuTexturePool = std::make_unique<GpuTexturePool> (metalDevice, textureDesc);
         }
 
+        /*  A texture for the MetalGraphicsContext to render into, which keeps its contents between
+            frames. The view has the renderer's non-sRGB pixel format, so that blending isn't done
+            in linear space, and the texture itself matches the layer so that it can be copied to
+            the drawable.
+        */
+        struct RenderTarget
+        {
+            id<MTLTexture> texture = nullptr, view = nullptr;
+        };
+
+        RenderTarget getRenderTarget (id<MTLDevice> metalDevice, CAMetalLayer* layer)
+        {
+            if (renderTarget.get() == nullptr)
+            {
+                auto* textureDesc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat: layer.pixelFormat
+                                                                                       width: (NSUInteger) layer.drawableSize.width
+                                                                                      height: (NSUInteger) layer.drawableSize.height
+                                                                                   mipmapped: NO];
+                textureDesc.storageMode = MTLStorageModePrivate;
+                textureDesc.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead | MTLTextureUsagePixelFormatView;
+
+                renderTarget.reset ([metalDevice newTextureWithDescriptor: textureDesc]);
+                renderTargetView.reset ([renderTarget.get() newTextureViewWithPixelFormat: MetalRendering::Programs::pixelFormat]);
+            }
+
+            return { renderTarget.get(), renderTargetView.get() };
+        }
+
         CGContextRef getCGContext() const noexcept       { return cgContext.get(); }
         id<MTLTexture> getSharedTexture() const noexcept { return sharedTexture.get(); }
         id<MTLTexture> getGpuTexture() noexcept          { return gpuTexturePool == nullptr ? nullptr : gpuTexturePool->take(); }
@@ -352,6 +470,7 @@ private:
         ObjCObjectHandle<id<MTLBuffer>> buffer;
         ObjCObjectHandle<id<MTLTexture>> sharedTexture;
         std::unique_ptr<GpuTexturePool> gpuTexturePool;
+        ObjCObjectHandle<id<MTLTexture>> renderTarget, renderTargetView;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Resources)
         JUCE_DECLARE_NON_MOVEABLE (Resources)
@@ -359,6 +478,7 @@ private:
 
     //==============================================================================
     std::unique_ptr<Resources> resources;
+    std::unique_ptr<MetalRendering::Programs> programs;
 
     ObjCObjectHandle<id<MTLDevice>> device;
     ObjCObjectHandle<id<MTLCommandQueue>> commandQueue;
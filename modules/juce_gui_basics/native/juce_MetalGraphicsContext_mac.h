@@ -0,0 +1,759 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+// The MetalGraphicsContext requires macOS 10.14 and iOS 12.
+JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wunguarded-availability", "-Wunguarded-availability-new")
+
+namespace juce
+{
+
+namespace MetalRendering
+{
+
+//==============================================================================
+/*  The render pipelines used by the MetalGraphicsContext. Creating these involves compiling
+    shaders, so a single instance should be kept for each device and reused for every frame.
+*/
+class Programs
+{
+public:
+    explicit Programs (id<MTLDevice> metalDevice)
+        : device ([metalDevice retain])
+    {
+        NSError* error = nil;
+        library.reset ([metalDevice newLibraryWithSource: juceStringToNS (shaderSource)
+                                                 options: nil
+                                                   error: &error]);
+
+        if (library.get() == nil)
+        {
+            DBG ("Failed to compile the Metal renderer's shaders: " << nsStringToJuce ([error localizedDescription]));
+            jassertfalse;
+            return;
+        }
+
+        solidColour        = createPipeline (@"solidColourFragment", true);
+        solidColourReplace = createPipeline (@"solidColourFragment", false);
+        image              = createPipeline (@"imageFragment", true);
+        gradient           = createPipeline (@"gradientFragment", true);
+    }
+
+    bool isValid() const noexcept
+    {
+        return solidColour.get() != nil && solidColourReplace.get() != nil
+                && image.get() != nil && gradient.get() != nil;
+    }
+
+    /*  All rendering happens in a non-sRGB format, so that colours are blended in the same
+        way as they are by the software renderer and CoreGraphics.
+    */
+    static constexpr MTLPixelFormat pixelFormat = MTLPixelFormatBGRA8Unorm;
+
+    ObjCObjectHandle<id<MTLDevice>> device;
+    ObjCObjectHandle<id<MTLRenderPipelineState>> solidColour, solidColourReplace, image, gradient;
+
+private:
+    ObjCObjectHandle<id<MTLLibrary>> library;
+
+    ObjCObjectHandle<id<MTLRenderPipelineState>> createPipeline (NSString* fragmentFunctionName, bool blend) const
+    {
+        const NSUniquePtr<MTLRenderPipelineDescriptor> descriptor { [MTLRenderPipelineDescriptor new] };
+        const ObjCObjectHandle<id<MTLFunction>> vertexFunction { [library.get() newFunctionWithName: @"vertexMain"] };
+        const ObjCObjectHandle<id<MTLFunction>> fragmentFunction { [library.get() newFunctionWithName: fragmentFunctionName] };
+
+        descriptor.get().vertexFunction = vertexFunction.get();
+        descriptor.get().fragmentFunction = fragmentFunction.get();
+
+        auto* attachment = descriptor.get().colorAttachments[0];
+        attachment.pixelFormat = pixelFormat;
+
+        if (blend)
+        {
+            // All of the shaders produce premultiplied colours
+            attachment.blendingEnabled = YES;
+            attachment.sourceRGBBlendFactor = MTLBlendFactorOne;
+            attachment.sourceAlphaBlendFactor = MTLBlendFactorOne;
+            attachment.destinationRGBBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+            attachment.destinationAlphaBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+        }
+
+        NSError* error = nil;
+        ObjCObjectHandle<id<MTLRenderPipelineState>> result { [device.get() newRenderPipelineStateWithDescriptor: descriptor.get()
+                                                                                                           error: &error] };
+        jassert (result.get() != nil);
+        return result;
+    }
+
+    static constexpr const char* shaderSource = R"(
+        #include <metal_stdlib>
+        using namespace metal;
+
+        struct Vertex
+        {
+            short2 position;
+            uchar4 colour;
+        };
+
+        struct Varyings
+        {
+            float4 position [[position]];
+            float4 colour;
+        };
+
+        struct ImageParams
+        {
+            float4 row0, row1;
+            float2 imageSize;
+            int tiled, nearest;
+        };
+
+        struct GradientParams
+        {
+            float4 row0, row1;
+            int isRadial;
+        };
+
+        vertex Varyings vertexMain (uint vertexID [[vertex_id]],
+                                    const device Vertex* vertices [[buffer (0)]],
+                                    constant float4& targetBounds [[buffer (1)]])
+        {
+            const Vertex v = vertices[vertexID];
+            const float2 pos = (float2 (v.position) - targetBounds.xy) / targetBounds.zw;
+
+            Varyings out;
+            out.position = float4 (pos.x * 2.0f - 1.0f, 1.0f - pos.y * 2.0f, 0.0f, 1.0f);
+            out.colour = float4 (v.colour) / 255.0f;
+            return out;
+        }
+
+        fragment float4 solidColourFragment (Varyings in [[stage_in]])
+        {
+            return in.colour;
+        }
+
+        fragment float4 imageFragment (Varyings in [[stage_in]],
+                                       constant ImageParams& params [[buffer (0)]],
+                                       texture2d<float> image [[texture (0)]])
+        {
+            constexpr sampler linearClamp   (filter::linear,  address::clamp_to_edge);
+            constexpr sampler linearRepeat  (filter::linear,  address::repeat);
+            constexpr sampler nearestClamp  (filter::nearest, address::clamp_to_edge);
+            constexpr sampler nearestRepeat (filter::nearest, address::repeat);
+
+            const float3 pos = float3 (in.position.xy, 1.0f);
+            const float2 source = float2 (dot (params.row0.xyz, pos), dot (params.row1.xyz, pos)) / params.imageSize;
+
+            float4 colour;
+
+            if (params.tiled != 0)
+                colour = params.nearest != 0 ? image.sample (nearestRepeat, source) : image.sample (linearRepeat, source);
+            else
+                colour = params.nearest != 0 ? image.sample (nearestClamp, source) : image.sample (linearClamp, source);
+
+            return colour * in.colour.a;
+        }
+
+        fragment float4 gradientFragment (Varyings in [[stage_in]],
+                                          constant GradientParams& params [[buffer (0)]],
+                                          texture2d<float> lookup [[texture (0)]])
+        {
+            constexpr sampler lookupSampler (filter::linear, address::clamp_to_edge);
+
+            const float3 pos = float3 (in.position.xy, 1.0f);
+            const float2 g = float2 (dot (params.row0.xyz, pos), dot (params.row1.xyz, pos));
+            const float proportion = clamp (params.isRadial != 0 ? length (g) : g.x, 0.0f, 1.0f);
+
+            return lookup.sample (lookupSampler, float2 ((proportion * 255.0f + 0.5f) / 256.0f, 0.5f)) * in.colour.a;
+        }
+    )";
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Programs)
+};
+
+//==============================================================================
+/*  A texture that's being rendered into, and the area of the device that it covers. */
+struct Target
+{
+    ObjCObjectHandle<id<MTLTexture>> texture;
+    Rectangle<int> bounds;
+};
+
+//==============================================================================
+/*  Owns the render command encoder for the current target, and batches up the quads that
+    make up each fill.
+
+    Quads are written straight into shared, persistently-mapped vertex buffers, and each run
+    of quads that uses the same pipeline and parameters becomes a single draw call.
+*/
+class GPUState  : private ImagePixelData::Listener
+{
+public:
+    GPUState (Programs& p, id<MTLCommandBuffer> buffer, Target initialTarget)
+        : programs (p), commandBuffer ([buffer retain]), target (std::move (initialTarget))
+    {
+        beginEncoding (false);
+    }
+
+    ~GPUState() override
+    {
+        endEncoding();
+
+        for (auto& item : textureCache)
+            item.first->listeners.remove (this);
+    }
+
+    //==============================================================================
+    const Target& getTarget() const noexcept        { return target; }
+
+    void setTarget (Target newTarget, bool clearTarget)
+    {
+        endEncoding();
+        target = std::move (newTarget);
+        beginEncoding (clearTarget);
+    }
+
+    ObjCObjectHandle<id<MTLTexture>> createRenderTarget (int width, int height) const
+    {
+        auto* descriptor = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat: Programs::pixelFormat
+                                                                              width: (NSUInteger) jmax (1, width)
+                                                                             height: (NSUInteger) jmax (1, height)
+                                                                          mipmapped: NO];
+        descriptor.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead;
+        descriptor.storageMode = MTLStorageModePrivate;
+
+        return ObjCObjectHandle<id<MTLTexture>> { [programs.device.get() newTextureWithDescriptor: descriptor] };
+    }
+
+    //==============================================================================
+    void setSolidColourPipeline (bool replaceContents)
+    {
+        setPipeline (replaceContents ? Pipeline::solidColourReplace : Pipeline::solidColour);
+    }
+
+    void setImagePipeline (id<MTLTexture> texture, const AffineTransform& imageToDevice, bool isTiledFill, bool useNearestSampling)
+    {
+        // Any quads that are already queued need the previous parameters
+        flush();
+        setPipeline (Pipeline::image);
+
+        const auto t = getFrameBufferToDeviceTransform (0.0f).followedBy (imageToDevice.inverted());
+
+        const ImageParams params { { t.mat00, t.mat01, t.mat02, 0.0f },
+                                   { t.mat10, t.mat11, t.mat12, 0.0f },
+                                   { (float) texture.width, (float) texture.height },
+                                   isTiledFill ? 1 : 0,
+                                   useNearestSampling ? 1 : 0 };
+
+        [encoder.get() setFragmentBytes: &params length: sizeof (params) atIndex: 0];
+        [encoder.get() setFragmentTexture: texture atIndex: 0];
+    }
+
+    void setGradientPipeline (const ColourGradient& gradient, const AffineTransform& gradientToDevice)
+    {
+        flush();
+        setPipeline (Pipeline::gradient);
+
+        // This maps each pixel into a space where the gradient starts at the origin, and where
+        // the proportion along it is either the x coordinate or the distance from the origin
+        auto t = getFrameBufferToDeviceTransform (-0.5f).followedBy (gradientToDevice.inverted())
+                                                         .translated (-gradient.point1.x, -gradient.point1.y);
+
+        const auto delta = gradient.point2 - gradient.point1;
+
+        if (gradient.isRadial)
+        {
+            t = t.scaled (1.0f / jmax (1.0e-4f, delta.getDistanceFromOrigin()));
+        }
+        else
+        {
+            const auto lengthSquared = jmax (1.0e-8f, delta.x * delta.x + delta.y * delta.y);
+            t = t.followedBy (AffineTransform (delta.x / lengthSquared, delta.y / lengthSquared, 0.0f,
+                                               0.0f, 0.0f, 0.0f));
+        }
+
+        const GradientParams params { { t.mat00, t.mat01, t.mat02, 0.0f },
+                                      { t.mat10, t.mat11, t.mat12, 0.0f },
+                                      gradient.isRadial ? 1 : 0, {} };
+
+        [encoder.get() setFragmentBytes: &params length: sizeof (params) atIndex: 0];
+        [encoder.get() setFragmentTexture: getGradientLookupTexture (gradient) atIndex: 0];
+    }
+
+    //==============================================================================
+    void addQuad (int x, int y, int w, int h, PixelARGB colour)
+    {
+        jassert (w > 0 && h > 0);
+
+        if (vertexBuffer.get() == nil || batchStart + numBatchVertices + verticesPerQuad > verticesPerBuffer)
+        {
+            flush();
+            vertexBuffer.reset ([programs.device.get() newBufferWithLength: verticesPerBuffer * sizeof (Vertex)
+                                                                   options: MTLResourceStorageModeShared]);
+            vertices = static_cast<Vertex*> (vertexBuffer.get().contents);
+            batchStart = 0;
+        }
+
+        const auto r = colour.getRed(), g = colour.getGreen(), b = colour.getBlue(), a = colour.getAlpha();
+        const auto left = (int16) x, top = (int16) y, right = (int16) (x + w), bottom = (int16) (y + h);
+
+        auto* v = vertices + batchStart + numBatchVertices;
+        v[0] = { left,  top,    r, g, b, a };
+        v[1] = { right, top,    r, g, b, a };
+        v[2] = { left,  bottom, r, g, b, a };
+        v[3] = { right, top,    r, g, b, a };
+        v[4] = { right, bottom, r, g, b, a };
+        v[5] = { left,  bottom, r, g, b, a };
+
+        numBatchVertices += verticesPerQuad;
+    }
+
+    template <typename IteratorType>
+    void addQuads (const IteratorType& iter, PixelARGB colour)
+    {
+        QuadRenderer renderer { *this, colour };
+        iter.iterate (renderer);
+    }
+
+    void flush()
+    {
+        if (numBatchVertices == 0)
+            return;
+
+        const float bounds[] = { (float) target.bounds.getX(),     (float) target.bounds.getY(),
+                                 (float) target.bounds.getWidth(), (float) target.bounds.getHeight() };
+
+        [encoder.get() setVertexBuffer: vertexBuffer.get() offset: (NSUInteger) batchStart * sizeof (Vertex) atIndex: 0];
+        [encoder.get() setVertexBytes: bounds length: sizeof (bounds) atIndex: 1];
+        [encoder.get() drawPrimitives: MTLPrimitiveTypeTriangle vertexStart: 0 vertexCount: (NSUInteger) numBatchVertices];
+
+        batchStart += numBatchVertices;
+        numBatchVertices = 0;
+    }
+
+    //==============================================================================
+    id<MTLTexture> getTextureFor (const Image& image)
+    {
+        auto* pixelData = image.getPixelData();
+        const auto iter = textureCache.find (pixelData);
+
+        if (iter != textureCache.end())
+            return iter->second.texture.get();
+
+        auto texture = createTexture (image);
+        auto* result = texture.get();
+
+        pixelData->listeners.add (this);
+        textureCache.emplace (pixelData, CachedTexture { image, std::move (texture) });
+        return result;
+    }
+
+private:
+    //==============================================================================
+    struct Vertex
+    {
+        int16 x, y;
+        uint8 red, green, blue, alpha;
+    };
+
+    struct ImageParams
+    {
+        float row0[4], row1[4];
+        float imageSize[2];
+        int32 tiled, nearest;
+    };
+
+    struct GradientParams
+    {
+        float row0[4], row1[4];
+        int32 isRadial, padding[3];
+    };
+
+    struct QuadRenderer
+    {
+        GPUState& state;
+        const PixelARGB colour;
+        int currentY = 0;
+
+        void setEdgeTableYPos (int y) noexcept                      { currentY = y; }
+        void handleEdgeTablePixelFull (int x) noexcept              { state.addQuad (x, currentY, 1, 1, colour); }
+        void handleEdgeTableLineFull (int x, int width) noexcept    { state.addQuad (x, currentY, width, 1, colour); }
+        void handleEdgeTablePixel (int x, int alphaLevel) noexcept  { state.addQuad (x, currentY, 1, 1, withAlpha (alphaLevel)); }
+
+        void handleEdgeTableLine (int x, int width, int alphaLevel) noexcept
+        {
+            state.addQuad (x, currentY, width, 1, withAlpha (alphaLevel));
+        }
+
+        void handleEdgeTableRectangle (int x, int y, int width, int height, int alphaLevel) noexcept
+        {
+            state.addQuad (x, y, width, height, withAlpha (alphaLevel));
+        }
+
+        void handleEdgeTableRectangleFull (int x, int y, int width, int height) noexcept
+        {
+            state.addQuad (x, y, width, height, colour);
+        }
+
+        PixelARGB withAlpha (int alphaLevel) const noexcept
+        {
+            auto c = colour;
+            c.multiplyAlpha (alphaLevel);
+            return c;
+        }
+    };
+
+    struct CachedTexture
+    {
+        Image image;
+        ObjCObjectHandle<id<MTLTexture>> texture;
+    };
+
+    enum class Pipeline
+    {
+        none,
+        solidColour,
+        solidColourReplace,
+        image,
+        gradient
+    };
+
+    static constexpr int verticesPerQuad = 6;
+    static constexpr int verticesPerBuffer = 32768 * verticesPerQuad;
+
+    Programs& programs;
+    ObjCObjectHandle<id<MTLCommandBuffer>> commandBuffer;
+    ObjCObjectHandle<id<MTLRenderCommandEncoder>> encoder;
+    Target target;
+    Pipeline currentPipeline = Pipeline::none;
+
+    ObjCObjectHandle<id<MTLBuffer>> vertexBuffer;
+    Vertex* vertices = nullptr;
+    int batchStart = 0, numBatchVertices = 0;
+
+    std::map<ImagePixelData*, CachedTexture> textureCache;
+
+    ObjCObjectHandle<id<MTLTexture>> gradientTexture;
+    std::array<PixelARGB, 256> gradientLookup;
+
+    //==============================================================================
+    AffineTransform getFrameBufferToDeviceTransform (float pixelOffset) const noexcept
+    {
+        return AffineTransform::translation ((float) target.bounds.getX() + pixelOffset,
+                                             (float) target.bounds.getY() + pixelOffset);
+    }
+
+    void setPipeline (Pipeline newPipeline)
+    {
+        if (currentPipeline == newPipeline)
+            return;
+
+        flush();
+        currentPipeline = newPipeline;
+
+        auto* pipelineState = [&]() -> id<MTLRenderPipelineState>
+        {
+            switch (newPipeline)
+            {
+                case Pipeline::solidColour:         return programs.solidColour.get();
+                case Pipeline::solidColourReplace:  return programs.solidColourReplace.get();
+                case Pipeline::image:               return programs.image.get();
+                case Pipeline::gradient:            return programs.gradient.get();
+                case Pipeline::none:                break;
+            }
+
+            return nil;
+        }();
+
+        [encoder.get() setRenderPipelineState: pipelineState];
+    }
+
+    void beginEncoding (bool clearTarget)
+    {
+        auto* pass = [MTLRenderPassDescriptor renderPassDescriptor];
+        pass.colorAttachments[0].texture = target.texture.get();
+        pass.colorAttachments[0].loadAction = clearTarget ? MTLLoadActionClear : MTLLoadActionLoad;
+        pass.colorAttachments[0].clearColor = MTLClearColorMake (0, 0, 0, 0);
+        pass.colorAttachments[0].storeAction = MTLStoreActionStore;
+
+        encoder.reset ([[commandBuffer.get() renderCommandEncoderWithDescriptor: pass] retain]);
+        currentPipeline = Pipeline::none;
+    }
+
+    void endEncoding()
+    {
+        if (encoder.get() == nil)
+            return;
+
+        flush();
+        [encoder.get() endEncoding];
+        encoder.reset();
+    }
+
+    ObjCObjectHandle<id<MTLTexture>> createTexture (const Image& image) const
+    {
+        const auto argbImage = image.getFormat() == Image::ARGB ? image : image.convertedToFormat (Image::ARGB);
+        const Image::BitmapData data (argbImage, Image::BitmapData::readOnly);
+
+        auto* descriptor = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat: Programs::pixelFormat
+                                                                              width: (NSUInteger) data.width
+                                                                             height: (NSUInteger) data.height
+                                                                          mipmapped: NO];
+        descriptor.usage = MTLTextureUsageShaderRead;
+
+        ObjCObjectHandle<id<MTLTexture>> texture { [programs.device.get() newTextureWithDescriptor: descriptor] };
+
+        // PixelARGB is laid out in memory in the same order as MTLPixelFormatBGRA8Unorm
+        [texture.get() replaceRegion: MTLRegionMake2D (0, 0, (NSUInteger) data.width, (NSUInteger) data.height)
+                         mipmapLevel: 0
+                           withBytes: data.data
+                         bytesPerRow: (NSUInteger) data.lineStride];
+
+        return texture;
+    }
+
+    id<MTLTexture> getGradientLookupTexture (const ColourGradient& gradient)
+    {
+        std::array<PixelARGB, 256> lookup;
+        gradient.createLookupTable (lookup.data(), (int) lookup.size());
+
+        // A texture that's been used by an earlier draw call in this frame can't be updated
+        // without affecting that call, so a new one is needed whenever the colours change
+        if (gradientTexture.get() == nil || std::memcmp (lookup.data(), gradientLookup.data(), sizeof (lookup)) != 0)
+        {
+            gradientLookup = lookup;
+
+            auto* descriptor = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat: Programs::pixelFormat
+                                                                                  width: lookup.size()
+                                                                                 height: 1
+                                                                              mipmapped: NO];
+            descriptor.usage = MTLTextureUsageShaderRead;
+
+            gradientTexture.reset ([programs.device.get() newTextureWithDescriptor: descriptor]);
+            [gradientTexture.get() replaceRegion: MTLRegionMake2D (0, 0, lookup.size(), 1)
+                                     mipmapLevel: 0
+                                       withBytes: lookup.data()
+                                     bytesPerRow: sizeof (lookup)];
+        }
+
+        return gradientTexture.get();
+    }
+
+    void forgetImage (ImagePixelData* pixelData)
+    {
+        // Textures that are referenced by earlier draw calls are retained by the command buffer,
+        // so it's safe to let go of them here
+        pixelData->listeners.remove (this);
+        textureCache.erase (pixelData);
+    }
+
+    void imageDataChanged (ImagePixelData* pixelData) override        { forgetImage (pixelData); }
+    void imageDataBeingDeleted (ImagePixelData* pixelData) override   { forgetImage (pixelData); }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GPUState)
+};
+
+//==============================================================================
+struct SavedState final : public RenderingHelpers::SavedStateBase<SavedState>
+{
+    using BaseClass = RenderingHelpers::SavedStateBase<SavedState>;
+
+    SavedState (GPUState* s, const RectangleList<int>& initialClip)
+        : BaseClass (initialClip, {}), state (s)
+    {}
+
+    SavedState (const SavedState& other)
+        : BaseClass (other), font (other.font), state (other.state),
+          transparencyLayer (other.transparencyLayer),
+          previousTarget (other.previousTarget)
+    {}
+
+    SavedState* beginTransparencyLayer (float opacity)
+    {
+        auto* s = new SavedState (*this);
+
+        if (clip != nullptr)
+        {
+            auto clipBounds = clip->getClipBounds();
+
+            s->previousTarget = state->getTarget();
+            s->transparencyLayer = Target { state->createRenderTarget (clipBounds.getWidth(), clipBounds.getHeight()), clipBounds };
+            s->transparencyLayerAlpha = opacity;
+            s->cloneClipIfMultiplyReferenced();
+
+            state->setTarget (s->transparencyLayer, true);
+        }
+
+        return s;
+    }
+
+    void endTransparencyLayer (SavedState& finishedLayerState)
+    {
+        if (clip != nullptr)
+        {
+            jassert (finishedLayerState.previousTarget.has_value());
+
+            state->setTarget (*finishedLayerState.previousTarget, false);
+            finishedLayerState.previousTarget.reset();
+
+            auto clipBounds = clip->getClipBounds();
+
+            // The layer isn't an Image, so it's passed to renderImageTransformed() this way instead
+            layerToComposite = &finishedLayerState.transparencyLayer;
+            clip->renderImageUntransformed (*this, {}, (int) (finishedLayerState.transparencyLayerAlpha * 255.0f),
+                                            clipBounds.getX(), clipBounds.getY(), false);
+            layerToComposite = nullptr;
+        }
+    }
+
+    using GlyphCacheType = RenderingHelpers::GlyphCache<RenderingHelpers::CachedGlyphEdgeTable<SavedState>, SavedState>;
+
+    void drawGlyph (int glyphNumber, const AffineTransform& trans)
+    {
+        if (clip != nullptr)
+        {
+            if (trans.isOnlyTranslation() && ! transform.isRotated)
+            {
+                auto& cache = GlyphCacheType::getInstance();
+                Point<float> pos (trans.getTranslationX(), trans.getTranslationY());
+
+                if (transform.isOnlyTranslated)
+                {
+                    cache.drawGlyph (*this, font, glyphNumber, pos + transform.offset.toFloat());
+                }
+                else
+                {
+                    pos = transform.transformed (pos);
+
+                    Font f (font);
+                    f.setHeight (font.getHeight() * transform.complexTransform.mat11);
+
+                    auto xScale = transform.complexTransform.mat00 / transform.complexTransform.mat11;
+
+                    if (std::abs (xScale - 1.0f) > 0.01f)
+                        f.setHorizontalScale (xScale);
+
+                    cache.drawGlyph (*this, f, glyphNumber, pos);
+                }
+            }
+            else
+            {
+                auto fontHeight = font.getHeight();
+
+                auto t = transform.getTransformWith (AffineTransform::scale (fontHeight * font.getHorizontalScale(), fontHeight)
+                                                                     .followedBy (trans));
+
+                const std::unique_ptr<EdgeTable> et (font.getTypefacePtr()->getEdgeTableForGlyph (glyphNumber, t, fontHeight));
+
+                if (et != nullptr)
+                    fillShape (*new EdgeTableRegionType (*et), false);
+            }
+        }
+    }
+
+    Rectangle<int> getMaximumBounds() const     { return state->getTarget().bounds; }
+
+    //==============================================================================
+    template <typename IteratorType>
+    void renderImageTransformed (IteratorType& iter, const Image& src, int alpha,
+                                 const AffineTransform& trans, Graphics::ResamplingQuality quality, bool tiledFill) const
+    {
+        auto* texture = layerToComposite != nullptr ? layerToComposite->texture.get()
+                                                    : state->getTextureFor (src);
+
+        state->setImagePipeline (texture, trans, tiledFill, quality == Graphics::lowResamplingQuality);
+        state->addQuads (iter, PixelARGB ((uint8) alpha, (uint8) alpha, (uint8) alpha, (uint8) alpha));
+    }
+
+    template <typename IteratorType>
+    void renderImageUntransformed (IteratorType& iter, const Image& src, int alpha, int x, int y, bool tiledFill) const
+    {
+        renderImageTransformed (iter, src, alpha, AffineTransform::translation ((float) x, (float) y),
+                                Graphics::lowResamplingQuality, tiledFill);
+    }
+
+    template <typename IteratorType>
+    void fillWithSolidColour (IteratorType& iter, PixelARGB colour, bool replaceContents) const
+    {
+        state->setSolidColourPipeline (replaceContents);
+        state->addQuads (iter, colour);
+    }
+
+    template <typename IteratorType>
+    void fillWithGradient (IteratorType& iter, ColourGradient& gradient, const AffineTransform& trans, bool /*isIdentity*/) const
+    {
+        // The gradient's colours have already had the fill's opacity applied to them
+        state->setGradientPipeline (gradient, trans);
+        state->addQuads (iter, PixelARGB (255, 255, 255, 255));
+    }
+
+    //==============================================================================
+    Font font;
+    GPUState* state;
+
+private:
+    Target transparencyLayer;
+    std::optional<Target> previousTarget;
+    const Target* layerToComposite = nullptr;
+
+    SavedState& operator= (const SavedState&) = delete;
+};
+
+} // namespace MetalRendering
+
+//==============================================================================
+/*  A LowLevelGraphicsContext that renders into a Metal texture.
+
+    As with the OpenGL renderer, coverage is calculated on the CPU from the clip region, edge
+    tables and glyph cache, and the resulting spans are filled by the GPU, which does all of the
+    blending, image sampling and gradient evaluation. The context encodes its commands into the
+    command buffer that it's given, and everything is drawn when that buffer is committed after
+    the context has been deleted.
+
+    The target texture must use MetalRendering::Programs::pixelFormat, and be usable as a
+    render target.
+*/
+class MetalGraphicsContext final : public RenderingHelpers::StackBasedLowLevelGraphicsContext<MetalRendering::SavedState>
+{
+public:
+    MetalGraphicsContext (MetalRendering::Programs& programs,
+                          id<MTLCommandBuffer> commandBuffer,
+                          id<MTLTexture> target,
+                          const RectangleList<int>& clipRegion)
+        : gpuState (programs, commandBuffer,
+                    { ObjCObjectHandle<id<MTLTexture>> { [target retain] },
+                      { (int) target.width, (int) target.height } })
+    {
+        stack.initialise (new MetalRendering::SavedState (&gpuState, clipRegion));
+    }
+
+private:
+    MetalRendering::GPUState gpuState;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MetalGraphicsContext)
+};
+
+} // namespace juce
+
+JUCE_END_IGNORE_WARNINGS_GCC_LIKE
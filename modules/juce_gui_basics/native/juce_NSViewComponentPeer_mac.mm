@@ -691,6 +691,11 @@ public:
 
        #if USE_COREGRAPHICS_RENDERING
         s.add ("CoreGraphics Renderer");
+
+        #if JUCE_COREGRAPHICS_RENDER_WITH_MULTIPLE_PAINT_CALLS
+         if (metalRenderer != nullptr)
+             s.add ("Metal Renderer");
+        #endif
        #endif
 
         return s;
@@ -698,15 +703,30 @@ public:
 
     int getCurrentRenderingEngine() const override
     {
+        if (usingMetal)
+            return 2;
+
         return usingCoreGraphics ? 1 : 0;
     }
 
     void setCurrentRenderingEngine ([[maybe_unused]] int index) override
     {
        #if USE_COREGRAPHICS_RENDERING
-        if (usingCoreGraphics != (index > 0))
+        const auto newUsingMetal = [&]
+        {
+           #if JUCE_COREGRAPHICS_RENDER_WITH_MULTIPLE_PAINT_CALLS
+            return index == 2 && metalRenderer != nullptr;
+           #else
+            return false;
+           #endif
+        }();
+
+        const auto newUsingCoreGraphics = index == 1;
+
+        if (usingCoreGraphics != newUsingCoreGraphics || usingMetal != newUsingMetal)
         {
-            usingCoreGraphics = index > 0;
+            usingCoreGraphics = newUsingCoreGraphics;
+            usingMetal = newUsingMetal;
             [view setNeedsDisplay: true];
         }
        #endif
@@ -1106,6 +1126,8 @@ public:
         const auto frameSize = view.frame.size;
         const Rectangle currentBounds { (float) frameSize.width, (float) frameSize.height };
 
+        detail::WindowingHelpers::coalesceRepaintRegion (deferredRepaints);
+
         for (auto& i : deferredRepaints)
             [view setNeedsDisplayInRect: makeNSRect (i)];
 
@@ -1718,6 +1740,7 @@ public:
    #else
     bool usingCoreGraphics = false;
    #endif
+    bool usingMetal = false;
     NSUniquePtr<NSEvent> keyEventBeingHandled;
     bool isFirstLiveResize = false, viewCannotHandleEvent = false;
     bool isStretchingTop = false, isStretchingLeft = false, isStretchingBottom = false, isStretchingRight = false;
@@ -1990,6 +2013,25 @@ private:
             return 1.0f;
         }();
 
+        if (usingMetal)
+        {
+            deferredRepaints = metalRenderer->drawRectangleListWithMetal (static_cast<CAMetalLayer*> (layer),
+                                                                          scale,
+                                                                          [this] (LowLevelGraphicsContext& context)
+                                                                          {
+                                                                              if (! component.isOpaque())
+                                                                              {
+                                                                                  context.setFill (Colours::transparentBlack);
+                                                                                  context.fillRect (context.getClipBounds(), true);
+                                                                              }
+
+                                                                              handlePaint (context);
+                                                                          },
+                                                                          std::move (deferredRepaints),
+                                                                          [view inLiveResize]);
+            return;
+        }
+
         deferredRepaints = metalRenderer->drawRectangleList (static_cast<CAMetalLayer*> (layer),
                                                              scale,
                                                              [this] (auto&&... args) { drawRectWithContext (args...); },
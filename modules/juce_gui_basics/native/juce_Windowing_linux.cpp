@@ -26,6 +26,14 @@
 namespace juce
 {
 
+//==============================================================================
+/*  These are assigned by juce_opengl when it's linked into the app, so that peers can offer
+    an OpenGL rendering engine without this module having to depend on it. The returned object
+    keeps a GL context attached to the component until it's released.
+*/
+std::shared_ptr<void> (*createLinuxOpenGLPeerRenderer) (Component&) = nullptr;
+bool linuxOpenGLPeerRendererIsDefault = false;
+
 //==============================================================================
 class LinuxComponentPeer final : public ComponentPeer,
                                  private XWindowSystemUtilities::XSettings::Listener
@@ -59,6 +67,13 @@ public:
         getNativeRealtimeModifiers = []() -> ModifierKeys { return XWindowSystem::getInstance()->getNativeRealtimeModifiers(); };
 
         updateVBlankTimer();
+
+        // Semi-transparent and temporary windows (menus, tooltips, etc.) stay on the software
+        // renderer, as each GL context needs its own child window and render thread.
+        if (linuxOpenGLPeerRendererIsDefault
+             && comp.isOpaque()
+             && (windowStyleFlags & (windowIsTemporary | windowIsSemiTransparent)) == 0)
+            setCurrentRenderingEngine (1);
     }
 
     ~LinuxComponentPeer() override
@@ -68,6 +83,7 @@ public:
 
         auto* instance = XWindowSystem::getInstance();
 
+        openGLRenderer = nullptr;
         repainter = nullptr;
         instance->destroyWindow (windowH);
 
@@ -169,7 +185,28 @@ public:
     //==============================================================================
     StringArray getAvailableRenderingEngines() override
     {
-        return { "Software Renderer" };
+        StringArray engines { "Software Renderer" };
+
+        if (createLinuxOpenGLPeerRenderer != nullptr)
+            engines.add ("OpenGL Renderer");
+
+        return engines;
+    }
+
+    int getCurrentRenderingEngine() const override
+    {
+        return openGLRenderer != nullptr ? 1 : 0;
+    }
+
+    void setCurrentRenderingEngine (int index) override
+    {
+        const auto useOpenGL = index == 1 && createLinuxOpenGLPeerRenderer != nullptr;
+
+        if (useOpenGL == (openGLRenderer != nullptr))
+            return;
+
+        openGLRenderer = useOpenGL ? createLinuxOpenGLPeerRenderer (component) : nullptr;
+        component.repaint();
     }
 
     void setVisible (bool shouldBeVisible) override
@@ -295,7 +332,9 @@ public:
     //==============================================================================
     void repaint (const Rectangle<int>& area) override
     {
-        if (repainter != nullptr)
+        // When the GL renderer is active, it tracks the damaged regions itself and only
+        // repaints those into its framebuffer, so there's nothing to do here.
+        if (repainter != nullptr && openGLRenderer == nullptr)
             repainter->repaint (area.getIntersection (bounds.withZeroOrigin()));
     }
 
@@ -444,6 +483,7 @@ private:
 
             auto originalRepaintRegion = regionsNeedingRepaint;
             regionsNeedingRepaint.clear();
+            detail::WindowingHelpers::coalesceRepaintRegion (originalRepaintRegion);
             auto totalArea = originalRepaintRegion.getBounds();
 
             if (! totalArea.isEmpty())
@@ -574,6 +614,7 @@ private:
 
     //==============================================================================
     std::unique_ptr<LinuxRepaintManager> repainter;
+    std::shared_ptr<void> openGLRenderer;
     TimedCallback vBlankManager { [this]() { onVBlank(); } };
 
     ::Window windowH = {}, parentWindow = {};
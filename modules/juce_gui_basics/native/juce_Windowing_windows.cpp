@@ -2089,6 +2089,8 @@ public:
 
     void dispatchDeferredRepaints()
     {
+        detail::WindowingHelpers::coalesceRepaintRegion (deferredRepaints);
+
         for (auto deferredRect : deferredRepaints)
         {
             auto r = RECTFromRectangle (deferredRect);
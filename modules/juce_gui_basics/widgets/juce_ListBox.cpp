@@ -296,6 +296,98 @@ private:
 };
 
 
+//==============================================================================
+/*  Holds the heights of the rows in a Fenwick tree, so that both the position of a
+    row and the row at a position can be found in logarithmic time.
+*/
+class ListBox::VariableRowHeights
+{
+public:
+    void reset (ListBoxModel* model, int numRows, int defaultHeight)
+    {
+        heights.resize ((size_t) numRows);
+
+        for (int i = 0; i < numRows; ++i)
+            heights[(size_t) i] = getHeightFromModel (model, i, defaultHeight);
+
+        tree.assign ((size_t) numRows + 1, 0);
+
+        for (int i = 1; i <= numRows; ++i)
+        {
+            tree[(size_t) i] += heights[(size_t) i - 1];
+
+            if (const auto parent = i + (i & -i); parent <= numRows)
+                tree[(size_t) parent] += tree[(size_t) i];
+        }
+
+        highestBit = 1;
+
+        while (highestBit * 2 <= numRows)
+            highestBit *= 2;
+    }
+
+    void setHeight (ListBoxModel* model, int row, int defaultHeight)
+    {
+        if (! isPositiveAndBelow (row, getNumRows()))
+            return;
+
+        const auto newHeight = getHeightFromModel (model, row, defaultHeight);
+        const auto delta = newHeight - std::exchange (heights[(size_t) row], newHeight);
+
+        for (auto i = row + 1; i <= getNumRows(); i += (i & -i))
+            tree[(size_t) i] += delta;
+    }
+
+    int getNumRows() const noexcept      { return (int) heights.size(); }
+
+    int getHeight (int row, int defaultHeight) const noexcept
+    {
+        return isPositiveAndBelow (row, getNumRows()) ? heights[(size_t) row] : defaultHeight;
+    }
+
+    /* Returns the total height of the rows before this one. */
+    int getY (int row, int defaultHeight) const noexcept
+    {
+        const auto numRows = getNumRows();
+        int y = row > numRows ? (row - numRows) * defaultHeight : 0;
+
+        for (auto i = jlimit (0, numRows, row); i > 0; i -= (i & -i))
+            y += tree[(size_t) i];
+
+        return y;
+    }
+
+    /* Returns the index of the row containing a position, or the number of rows if it's below the last one. */
+    int getRowAtY (int y) const noexcept
+    {
+        if (y < 0)
+            return -1;
+
+        int row = 0;
+
+        for (auto step = highestBit; step > 0; step /= 2)
+        {
+            if (row + step <= getNumRows() && tree[(size_t) (row + step)] <= y)
+            {
+                row += step;
+                y -= tree[(size_t) row];
+            }
+        }
+
+        return row;
+    }
+
+private:
+    static int getHeightFromModel (ListBoxModel* model, int row, int defaultHeight)
+    {
+        const auto h = model != nullptr ? model->getHeightForRow (row) : 0;
+        return h > 0 ? h : defaultHeight;
+    }
+
+    std::vector<int> heights, tree;
+    int highestBit = 1;
+};
+
 //==============================================================================
 class ListBox::ListViewport final : public Viewport,
                                     private Timer
@@ -346,7 +438,9 @@ public:
 
     void visibleAreaChanged (const Rectangle<int>&) override
     {
-        updateVisibleArea (true);
+        // When the list has just been scrolled, rather than resized by updateVisibleArea(),
+        // the rows that are still showing the same row numbers don't need to be refreshed
+        updateVisibleArea (true, ! isUpdatingVisibleArea);
 
         if (auto* m = owner.getListBoxModel())
             m->listWasScrolled();
@@ -354,7 +448,7 @@ public:
         startTimer (50);
     }
 
-    void updateVisibleArea (const bool makeSureItUpdatesContent)
+    void updateVisibleArea (const bool makeSureItUpdatesContent, const bool onlyUpdateChangedRows = false)
     {
         hasUpdated = false;
 
@@ -362,20 +456,23 @@ public:
         auto newX = content.getX();
         auto newY = content.getY();
         auto newW = jmax (owner.minimumRowWidth, getMaximumVisibleWidth());
-        auto newH = owner.totalItems * owner.getRowHeight();
+        auto newH = owner.getContentHeight();
 
         if (newY + newH < getMaximumVisibleHeight() && newH > getMaximumVisibleHeight())
             newY = getMaximumVisibleHeight() - newH;
 
-        content.setBounds (newX, newY, newW, newH);
+        {
+            const ScopedValueSetter<bool> svs (isUpdatingVisibleArea, true);
+            content.setBounds (newX, newY, newW, newH);
+        }
 
         if (makeSureItUpdatesContent && ! hasUpdated)
-            updateContents();
+            updateContents (onlyUpdateChangedRows);
     }
 
-    void updateContents()
+    void updateContents (bool onlyUpdateChangedRows = false)
     {
-        hasUpdated = true;
+        hasUpdated = hasUpdated || ! onlyUpdateChangedRows;
         auto rowH = owner.getRowHeight();
         auto& content = *getViewedComponent();
 
@@ -384,18 +481,37 @@ public:
             auto y = getViewPositionY();
             auto w = content.getWidth();
 
-            const auto numNeeded = (size_t) (4 + getMaximumVisibleHeight() / rowH);
-            rows.resize (jmin (numNeeded, rows.size()));
-
-            while (numNeeded > rows.size())
+            if (owner.variableRowHeights != nullptr)
             {
-                rows.emplace_back (new RowComponent (owner));
-                content.addAndMakeVisible (*rows.back());
+                firstIndex = jmax (0, owner.getRowAtY (y));
+                firstWholeIndex = owner.getRowY (firstIndex) < y ? firstIndex + 1 : firstIndex;
+                lastWholeIndex = owner.getRowAtY (y + getMaximumVisibleHeight() - 1);
+
+                // The number of rows needed changes as rows of different heights scroll
+                // past, so only ever add more of them to avoid re-assigning all the rows
+                const auto numNeeded = (size_t) (4 + lastWholeIndex - firstIndex);
+
+                while (numNeeded > rows.size())
+                {
+                    rows.emplace_back (new RowComponent (owner));
+                    content.addAndMakeVisible (*rows.back());
+                }
             }
+            else
+            {
+                const auto numNeeded = (size_t) (4 + getMaximumVisibleHeight() / rowH);
+                rows.resize (jmin (numNeeded, rows.size()));
 
-            firstIndex = y / rowH;
-            firstWholeIndex = (y + rowH - 1) / rowH;
-            lastWholeIndex = (y + getMaximumVisibleHeight() - 1) / rowH;
+                while (numNeeded > rows.size())
+                {
+                    rows.emplace_back (new RowComponent (owner));
+                    content.addAndMakeVisible (*rows.back());
+                }
+
+                firstIndex = y / rowH;
+                firstWholeIndex = (y + rowH - 1) / rowH;
+                lastWholeIndex = (y + getMaximumVisibleHeight() - 1) / rowH;
+            }
 
             const auto startIndex = getIndexOfFirstVisibleRow();
             const auto lastIndex = startIndex + (int) rows.size();
@@ -404,8 +520,12 @@ public:
             {
                 if (auto* rowComp = getComponentForRowIfOnscreen (row))
                 {
-                    rowComp->setBounds (0, row * rowH, w, rowH);
-                    rowComp->update (row, owner.isRowSelected (row));
+                    rowComp->setBounds (0, owner.getRowY (row), w, owner.getHeightOfRow (row));
+
+                    const auto isSelected = owner.isRowSelected (row);
+
+                    if (! onlyUpdateChangedRows || rowComp->getRow() != row || rowComp->isSelected() != isSelected)
+                        rowComp->update (row, isSelected);
                 }
                 else
                 {
@@ -422,14 +542,14 @@ public:
                                               owner.headerComponent->getHeight());
     }
 
-    void selectRow (const int row, const int rowH, const bool dontScroll,
+    void selectRow (const int row, const bool dontScroll,
                     const int lastSelectedRow, const int totalRows, const bool isMouseClick)
     {
         hasUpdated = false;
 
         if (row < firstWholeIndex && ! dontScroll)
         {
-            setViewPosition (getViewPositionX(), row * rowH);
+            setViewPosition (getViewPositionX(), owner.getRowY (row));
         }
         else if (row >= lastWholeIndex && ! dontScroll)
         {
@@ -440,12 +560,12 @@ public:
                  && ! isMouseClick)
             {
                 setViewPosition (getViewPositionX(),
-                                 jlimit (0, jmax (0, totalRows - rowsOnScreen), row) * rowH);
+                                 owner.getRowY (jlimit (0, jmax (0, totalRows - rowsOnScreen), row)));
             }
             else
             {
                 setViewPosition (getViewPositionX(),
-                                 jmax (0, (row  + 1) * rowH - getMaximumVisibleHeight()));
+                                 jmax (0, owner.getRowY (row + 1) - getMaximumVisibleHeight()));
             }
         }
 
@@ -453,16 +573,16 @@ public:
             updateContents();
     }
 
-    void scrollToEnsureRowIsOnscreen (const int row, const int rowH)
+    void scrollToEnsureRowIsOnscreen (const int row)
     {
         if (row < firstWholeIndex)
         {
-            setViewPosition (getViewPositionX(), row * rowH);
+            setViewPosition (getViewPositionX(), owner.getRowY (row));
         }
         else if (row >= lastWholeIndex)
         {
             setViewPosition (getViewPositionX(),
-                             jmax (0, (row  + 1) * rowH - getMaximumVisibleHeight()));
+                             jmax (0, owner.getRowY (row + 1) - getMaximumVisibleHeight()));
         }
     }
 
@@ -506,7 +626,7 @@ private:
     ListBox& owner;
     std::vector<std::unique_ptr<RowComponent>> rows;
     int firstIndex = 0, firstWholeIndex = 0, lastWholeIndex = 0;
-    bool hasUpdated = false;
+    bool hasUpdated = false, isUpdatingVisibleArea = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ListViewport)
 };
@@ -640,6 +760,7 @@ void ListBox::updateContent()
     checkModelPtrIsValid();
     hasDoneInitialUpdate = true;
     totalItems = (model != nullptr) ? model->getNumRows() : 0;
+    updateVariableRowHeights();
 
     bool selectionChanged = false;
 
@@ -692,7 +813,7 @@ void ListBox::selectRowInternal (const int row,
             if (getHeight() == 0 || getWidth() == 0)
                 dontScroll = true;
 
-            viewport->selectRow (row, getRowHeight(), dontScroll,
+            viewport->selectRow (row, dontScroll,
                                  lastRowSelected, totalItems, isMouseClick);
 
             lastRowSelected = row;
@@ -841,7 +962,7 @@ int ListBox::getRowContainingPosition (const int x, const int y) const noexcept
 {
     if (isPositiveAndBelow (x, getWidth()))
     {
-        const int row = (viewport->getViewPositionY() + y - viewport->getY()) / rowHeight;
+        const int row = getRowAtY (viewport->getViewPositionY() + y - viewport->getY());
 
         if (isPositiveAndBelow (row, totalItems))
             return row;
@@ -853,7 +974,18 @@ int ListBox::getRowContainingPosition (const int x, const int y) const noexcept
 int ListBox::getInsertionIndexForPosition (const int x, const int y) const noexcept
 {
     if (isPositiveAndBelow (x, getWidth()))
-        return jlimit (0, totalItems, (viewport->getViewPositionY() + y + rowHeight / 2 - viewport->getY()) / rowHeight);
+    {
+        const auto contentY = viewport->getViewPositionY() + y - viewport->getY();
+
+        if (variableRowHeights != nullptr)
+        {
+            const auto row = jmax (0, getRowAtY (contentY));
+            const auto isInLowerHalf = contentY >= getRowY (row) + getHeightOfRow (row) / 2;
+            return jlimit (0, totalItems, isInLowerHalf ? row + 1 : row);
+        }
+
+        return jlimit (0, totalItems, (contentY + rowHeight / 2) / rowHeight);
+    }
 
     return -1;
 }
@@ -873,13 +1005,13 @@ int ListBox::getRowNumberOfComponent (const Component* const rowComponent) const
 
 Rectangle<int> ListBox::getRowPosition (int rowNumber, bool relativeToComponentTopLeft) const noexcept
 {
-    auto y = viewport->getY() + rowHeight * rowNumber;
+    auto y = viewport->getY() + getRowY (rowNumber);
 
     if (relativeToComponentTopLeft)
         y -= viewport->getViewPositionY();
 
     return { viewport->getX(), y,
-             viewport->getViewedComponent()->getWidth(), rowHeight };
+             viewport->getViewedComponent()->getWidth(), getHeightOfRow (rowNumber) };
 }
 
 void ListBox::setVerticalPosition (const double proportion)
@@ -905,7 +1037,7 @@ int ListBox::getVisibleRowWidth() const noexcept
 
 void ListBox::scrollToEnsureRowIsOnscreen (const int row)
 {
-    viewport->scrollToEnsureRowIsOnscreen (row, getRowHeight());
+    viewport->scrollToEnsureRowIsOnscreen (row);
 }
 
 //==============================================================================
@@ -913,7 +1045,8 @@ bool ListBox::keyPressed (const KeyPress& key)
 {
     checkModelPtrIsValid();
 
-    const int numVisibleRows = viewport->getHeight() / getRowHeight();
+    const int numVisibleRows = variableRowHeights != nullptr ? jmax (1, getNumRowsOnScreen())
+                                                             : viewport->getHeight() / getRowHeight();
 
     const bool multiple = multipleSelection
                             && lastRowSelected >= 0
@@ -1032,11 +1165,68 @@ void ListBox::setRowHeight (const int newHeight)
     updateContent();
 }
 
+void ListBox::setVariableRowHeightsEnabled (bool shouldBeEnabled)
+{
+    if (areVariableRowHeightsEnabled() != shouldBeEnabled)
+    {
+        variableRowHeights = shouldBeEnabled ? std::make_unique<VariableRowHeights>() : nullptr;
+        updateContent();
+    }
+}
+
+void ListBox::rowHeightChanged (int rowNumber)
+{
+    checkModelPtrIsValid();
+
+    if (variableRowHeights != nullptr && isPositiveAndBelow (rowNumber, variableRowHeights->getNumRows()))
+    {
+        variableRowHeights->setHeight (model, rowNumber, rowHeight);
+        viewport->updateVisibleArea (isVisible());
+        repaint();
+    }
+}
+
+int ListBox::getHeightOfRow (int rowNumber) const noexcept
+{
+    return variableRowHeights != nullptr ? variableRowHeights->getHeight (rowNumber, rowHeight)
+                                         : rowHeight;
+}
+
 int ListBox::getNumRowsOnScreen() const noexcept
 {
+    if (variableRowHeights != nullptr)
+    {
+        const auto y = viewport->getViewPositionY();
+        return getRowAtY (y + viewport->getMaximumVisibleHeight()) - getRowAtY (y);
+    }
+
     return viewport->getMaximumVisibleHeight() / rowHeight;
 }
 
+void ListBox::updateVariableRowHeights()
+{
+    if (variableRowHeights != nullptr)
+        variableRowHeights->reset (model, totalItems, rowHeight);
+}
+
+int ListBox::getRowY (int rowNumber) const noexcept
+{
+    return variableRowHeights != nullptr ? variableRowHeights->getY (rowNumber, rowHeight)
+                                         : rowNumber * rowHeight;
+}
+
+int ListBox::getRowAtY (int y) const noexcept
+{
+    return variableRowHeights != nullptr ? variableRowHeights->getRowAtY (y)
+                                         : y / rowHeight;
+}
+
+int ListBox::getContentHeight() const noexcept
+{
+    return variableRowHeights != nullptr ? variableRowHeights->getY (totalItems, rowHeight)
+                                         : totalItems * rowHeight;
+}
+
 void ListBox::setMinimumContentWidth (const int newMinimumWidth)
 {
     minimumRowWidth = newMinimumWidth;
@@ -1250,5 +1440,106 @@ void ListBoxModel::listWasScrolled() {}
 var ListBoxModel::getDragSourceDescription (const SparseSet<int>&)      { return {}; }
 String ListBoxModel::getTooltipForRow (int)                             { return {}; }
 MouseCursor ListBoxModel::getMouseCursorForRow (int)                    { return MouseCursor::NormalCursor; }
+int ListBoxModel::getHeightForRow (int)                                 { return 0; }
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ListBoxTests final : public UnitTest
+{
+public:
+    ListBoxTests() : UnitTest ("ListBox", UnitTestCategories::gui) {}
+
+    void runTest() override
+    {
+        beginTest ("Variable row heights");
+        {
+            VariableHeightModel model;
+            ListBox list ({}, &model);
+            list.setVariableRowHeightsEnabled (true);
+            list.setSize (200, 300);
+            list.updateContent();
+
+            const auto checkLayout = [&]
+            {
+                int y = 0;
+
+                for (int row = 0; row < model.numRows; ++row)
+                {
+                    const auto pos = list.getRowPosition (row, false);
+
+                    if (pos.getY() != y || pos.getHeight() != model.getHeightForRow (row))
+                        return false;
+
+                    y += pos.getHeight();
+                }
+
+                return list.getRowPosition (model.numRows, false).getY() == y;
+            };
+
+            expect (checkLayout());
+            expectEquals (list.getRowContainingPosition (10, 0), 0);
+            expectEquals (list.getRowContainingPosition (10, model.getHeightForRow (0)), 1);
+            expectEquals (list.getRowContainingPosition (10, model.getHeightForRow (0) - 1), 0);
+            expectEquals (list.getInsertionIndexForPosition (10, model.getHeightForRow (0) - 1), 1);
+
+            model.heights[3] = 100;
+            list.rowHeightChanged (3);
+            expect (checkLayout());
+
+            list.scrollToEnsureRowIsOnscreen (5000);
+            const auto pos = list.getRowPosition (5000, true);
+            expect (pos.getY() >= 0 && pos.getBottom() <= list.getHeight());
+            expectEquals (list.getRowContainingPosition (10, pos.getCentreY()), 5000);
+        }
+
+        beginTest ("Scrolling only refreshes rows that have changed");
+        {
+            VariableHeightModel model;
+            ListBox list ({}, &model);
+            list.setRowHeight (20);
+            list.setSize (200, 200);
+            list.setVisible (true);
+            list.updateContent();
+
+            model.numRefreshes = 0;
+            list.getViewport()->setViewPosition (0, 40);
+            expect (model.numRefreshes > 0 && model.numRefreshes <= 2);
+
+            model.numRefreshes = 0;
+            list.updateContent();
+            expect (model.numRefreshes > 2);
+        }
+    }
+
+private:
+    struct VariableHeightModel final : public ListBoxModel
+    {
+        VariableHeightModel()
+        {
+            for (int i = 0; i < numRows; ++i)
+                heights.push_back (10 + (i % 7) * 5);
+        }
+
+        int getNumRows() override                                     { return numRows; }
+        void paintListBoxItem (int, Graphics&, int, int, bool) override {}
+        int getHeightForRow (int row) override                        { return heights[(size_t) row]; }
+
+        Component* refreshComponentForRow (int, bool, Component* existing) override
+        {
+            ++numRefreshes;
+            return existing;
+        }
+
+        const int numRows = 10000;
+        std::vector<int> heights;
+        int numRefreshes = 0;
+    };
+};
+
+static ListBoxTests listBoxTests;
+
+#endif
 
 } // namespace juce
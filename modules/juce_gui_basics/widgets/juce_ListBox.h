@@ -169,6 +169,14 @@ public:
     /** You can override this to return a custom mouse cursor for each row. */
     virtual MouseCursor getMouseCursorForRow (int row);
 
+    /** If the ListBox has variable row heights enabled, this is used to find the
+        height of each row. Returning 0 or less will give the row the ListBox's
+        default height, which is what the default implementation does.
+
+        @see ListBox::setVariableRowHeightsEnabled, ListBox::rowHeightChanged
+    */
+    virtual int getHeightForRow (int row);
+
 private:
    #if ! JUCE_DISABLE_ASSERTIONS
     friend class ListBox;
@@ -480,10 +488,45 @@ public:
     void setRowHeight (int newHeight);
 
     /** Returns the height of a row in the list.
+
+        If variable row heights are enabled, this is the default height that's used for
+        rows whose height the model doesn't specify.
+
         @see setRowHeight
     */
     int getRowHeight() const noexcept                   { return rowHeight; }
 
+    /** Lets each row have its own height.
+
+        When this is enabled, ListBoxModel::getHeightForRow() is called for every row
+        whenever updateContent() is called, and the positions of the rows are kept in
+        a structure that can find the row at any position in logarithmic time. If a
+        single row changes height, you can call rowHeightChanged() rather than
+        updateContent().
+
+        It's disabled by default.
+
+        @see ListBoxModel::getHeightForRow, rowHeightChanged
+    */
+    void setVariableRowHeightsEnabled (bool shouldBeEnabled);
+
+    /** Returns true if variable row heights are enabled.
+        @see setVariableRowHeightsEnabled
+    */
+    bool areVariableRowHeightsEnabled() const noexcept  { return variableRowHeights != nullptr; }
+
+    /** Asks the model for a new height for one of the rows, and moves the rows below it
+        to fit. This does nothing unless variable row heights are enabled.
+
+        @see setVariableRowHeightsEnabled
+    */
+    void rowHeightChanged (int rowNumber);
+
+    /** Returns the height of one of the rows. Unless variable row heights are enabled,
+        this will be the same for all rows.
+    */
+    int getHeightOfRow (int rowNumber) const noexcept;
+
     /** Returns the number of rows actually visible.
 
         This is the number of whole rows which will fit on-screen, so the value might
@@ -619,12 +662,15 @@ private:
     //==============================================================================
     JUCE_PUBLIC_IN_DLL_BUILD (class ListViewport)
     JUCE_PUBLIC_IN_DLL_BUILD (class RowComponent)
+    JUCE_PUBLIC_IN_DLL_BUILD (class VariableRowHeights)
     friend class ListViewport;
     friend class TableListBox;
+    friend class TreeListBox;
     ListBoxModel* model = nullptr;
     std::unique_ptr<ListViewport> viewport;
     std::unique_ptr<Component> headerComponent;
     std::unique_ptr<MouseListener> mouseMoveSelector;
+    std::unique_ptr<VariableRowHeights> variableRowHeights;
     SparseSet<int> selected;
     int totalItems = 0, rowHeight = 22, minimumRowWidth = 0;
     int outlineThickness = 0;
@@ -640,6 +686,10 @@ private:
     bool hasAccessibleHeaderComponent() const;
     void selectRowInternal (int rowNumber, bool dontScrollToShowThisRow,
                             bool deselectOthersFirst, bool isMouseClick);
+    void updateVariableRowHeights();
+    int getRowY (int rowNumber) const noexcept;
+    int getRowAtY (int y) const noexcept;
+    int getContentHeight() const noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ListBox)
 };
@@ -264,6 +264,29 @@ Rectangle<int> TableHeaderComponent::getColumnPosition (const int index) const
     return { x, 0, width, getHeight() };
 }
 
+std::vector<TableHeaderComponent::VisibleColumnInfo> TableHeaderComponent::getVisibleColumnsInRange (Range<int> xRange) const
+{
+    std::vector<VisibleColumnInfo> result;
+    int x = 0, index = 0;
+
+    for (auto* c : columns)
+    {
+        if (! c->isVisible())
+            continue;
+
+        if (x >= xRange.getEnd())
+            break;
+
+        if (x + c->width > xRange.getStart())
+            result.push_back ({ index, c->id, { x, 0, c->width, getHeight() } });
+
+        x += c->width;
+        ++index;
+    }
+
+    return result;
+}
+
 int TableHeaderComponent::getColumnIdAtX (const int xToFind) const
 {
     if (xToFind >= 0)
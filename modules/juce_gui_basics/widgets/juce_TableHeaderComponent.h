@@ -232,6 +232,24 @@ public:
     */
     Rectangle<int> getColumnPosition (int index) const;
 
+    /** Describes one of the visible columns.
+        @see getVisibleColumnsInRange
+    */
+    struct VisibleColumnInfo
+    {
+        int index = 0;              /**< The index of the column among the visible columns. */
+        int columnId = 0;           /**< The column's ID. */
+        Rectangle<int> position;    /**< The column's position, as returned by getColumnPosition(). */
+    };
+
+    /** Returns the visible columns that overlap a range of x positions, from left to right.
+
+        This finds them all in a single pass, so it's much quicker than calling
+        getColumnPosition() and getColumnIdOfIndex() for each column when there are a
+        lot of columns.
+    */
+    std::vector<VisibleColumnInfo> getVisibleColumnsInRange (Range<int> xRange) const;
+
     /** Finds the column ID at a given x-position in the component.
         If there is a column at this point this returns its ID, or if not, it will return 0.
     */
@@ -45,29 +45,23 @@ public:
         {
             tableModel->paintRowBackground (g, getRow(), getWidth(), getHeight(), isSelected());
 
-            auto& headerComp = owner.getHeader();
-            const auto numColumns = jmin ((int) columnComponents.size(), headerComp.getNumColumns (true));
             const auto clipBounds = g.getClipBounds();
 
-            for (int i = 0; i < numColumns; ++i)
+            for (auto& column : owner.getHeader().getVisibleColumnsInRange (clipBounds.getHorizontalRange()))
             {
-                if (columnComponents[(size_t) i]->getProperties().contains (tableAccessiblePlaceholderProperty))
-                {
-                    auto columnRect = headerComp.getColumnPosition (i).withHeight (getHeight());
+                if (! isPositiveAndBelow (column.index, (int) columnComponents.size()))
+                    break;
 
-                    if (columnRect.getX() >= clipBounds.getRight())
-                        break;
+                if (columnComponents[(size_t) column.index]->getProperties().contains (tableAccessiblePlaceholderProperty))
+                {
+                    auto columnRect = column.position.withHeight (getHeight());
+                    Graphics::ScopedSaveState ss (g);
 
-                    if (columnRect.getRight() > clipBounds.getX())
+                    if (g.reduceClipRegion (columnRect))
                     {
-                        Graphics::ScopedSaveState ss (g);
-
-                        if (g.reduceClipRegion (columnRect))
-                        {
-                            g.setOrigin (columnRect.getX(), 0);
-                            tableModel->paintCell (g, getRow(), headerComp.getColumnIdOfIndex (i, true),
-                                                   columnRect.getWidth(), columnRect.getHeight(), isSelected());
-                        }
+                        g.setOrigin (columnRect.getX(), 0);
+                        tableModel->paintCell (g, getRow(), column.columnId,
+                                               columnRect.getWidth(), columnRect.getHeight(), isSelected());
                     }
                 }
             }
@@ -93,74 +87,53 @@ public:
             while ((int) columnComponents.size() < numColumns)
                 columnComponents.emplace_back (nullptr, deleter);
 
+            // Only the columns that are scrolled into view are refreshed here. Any custom
+            // components in the other columns are hidden until they're needed.
+            columnIsUpToDate.assign ((size_t) numColumns, false);
+
+            for (auto& comp : columnComponents)
+                if (comp != nullptr && ! comp->getProperties().contains (tableAccessiblePlaceholderProperty))
+                    comp->setVisible (false);
+
+            updateColumnsInRange (owner.getVisibleColumnRange());
+
             for (int i = 0; i < numColumns; ++i)
-            {
-                auto columnId = owner.getHeader().getColumnIdOfIndex (i, true);
-                auto originalComp = std::move (columnComponents[(size_t) i]);
-                auto oldCustomComp = originalComp != nullptr && ! originalComp->getProperties().contains (tableAccessiblePlaceholderProperty)
-                                   ? std::move (originalComp)
-                                   : std::unique_ptr<Component, ComponentDeleter> { nullptr, deleter };
-                auto compToRefresh = oldCustomComp != nullptr && columnId == static_cast<int> (oldCustomComp->getProperties()[tableColumnProperty])
-                                   ? std::move (oldCustomComp)
-                                   : std::unique_ptr<Component, ComponentDeleter> { nullptr, deleter };
-
-                columnForComponent.erase (compToRefresh.get());
-                std::unique_ptr<Component, ComponentDeleter> newCustomComp { tableModel->refreshComponentForCell (getRow(),
-                                                                                                                  columnId,
-                                                                                                                  isSelected(),
-                                                                                                                  compToRefresh.release()),
-                                                                             deleter };
-
-                auto columnComp = [&]
-                {
-                    // We got a result from refreshComponentForCell, so use that
-                    if (newCustomComp != nullptr)
-                        return std::move (newCustomComp);
-
-                    // There was already a placeholder component for this column
-                    if (originalComp != nullptr)
-                        return std::move (originalComp);
-
-                    // Create a new placeholder component to use
-                    std::unique_ptr<Component, ComponentDeleter> comp { new Component, deleter };
-                    comp->setInterceptsMouseClicks (false, false);
-                    comp->getProperties().set (tableAccessiblePlaceholderProperty, true);
-                    return comp;
-                }();
-
-                columnForComponent.emplace (columnComp.get(), i);
-
-                // In order for navigation to work correctly on macOS, the number of child
-                // accessibility elements on each row must match the number of header accessibility
-                // elements.
-                columnComp->setFocusContainerType (FocusContainerType::focusContainer);
-                columnComp->getProperties().set (tableColumnProperty, columnId);
-                addAndMakeVisible (*columnComp);
-
-                columnComponents[(size_t) i] = std::move (columnComp);
-                resizeCustomComp (i);
-            }
+                if (columnComponents[(size_t) i] == nullptr)
+                    setColumnComponent (i, owner.getHeader().getColumnIdOfIndex (i, true), createPlaceholder());
+
+            resized();
         }
         else
         {
             columnComponents.clear();
+            columnIsUpToDate.clear();
         }
     }
 
-    void resized() override
+    void updateColumnsInRange (Range<int> xRange)
     {
-        for (auto i = (int) columnComponents.size(); --i >= 0;)
-            resizeCustomComp (i);
+        if (owner.getTableListBoxModel() == nullptr || getRow() >= owner.getNumRows())
+            return;
+
+        for (auto& column : owner.getHeader().getVisibleColumnsInRange (xRange))
+        {
+            if (! isPositiveAndBelow (column.index, (int) columnIsUpToDate.size()))
+                break;
+
+            if (! columnIsUpToDate[(size_t) column.index])
+                refreshColumn (column.index, column.columnId, column.position);
+        }
     }
 
-    void resizeCustomComp (int index)
+    void resized() override
     {
-        if (auto& c = columnComponents[(size_t) index])
+        for (auto& column : owner.getHeader().getVisibleColumnsInRange ({ 0, std::numeric_limits<int>::max() }))
         {
-            c->setBounds (owner.getHeader()
-                               .getColumnPosition (index)
-                               .withY (0)
-                               .withHeight (getHeight()));
+            if (! isPositiveAndBelow (column.index, (int) columnComponents.size()))
+                break;
+
+            if (auto& c = columnComponents[(size_t) column.index])
+                c->setBounds (column.position.withY (0).withHeight (getHeight()));
         }
     }
 
@@ -198,14 +171,17 @@ public:
         return {};
     }
 
-    Component* findChildComponentForColumn (int columnId) const
+    Component* findChildComponentForColumn (int columnId)
     {
-        const auto index = (size_t) owner.getHeader().getIndexOfColumnId (columnId, true);
+        const auto index = owner.getHeader().getIndexOfColumnId (columnId, true);
 
-        if (isPositiveAndBelow (index, columnComponents.size()))
-            return columnComponents[index].get();
+        if (! isPositiveAndBelow (index, (int) columnComponents.size()))
+            return nullptr;
 
-        return nullptr;
+        if (! columnIsUpToDate[(size_t) index] && getRow() < owner.getNumRows())
+            refreshColumn (index, columnId, owner.getHeader().getColumnPosition (index));
+
+        return columnComponents[(size_t) index].get();
     }
 
     int getColumnNumberOfComponent (const Component* comp) const
@@ -304,9 +280,71 @@ private:
         std::map<const Component*, int>* columnForComponent;
     };
 
+    using ColumnComponentPtr = std::unique_ptr<Component, ComponentDeleter>;
+
+    ColumnComponentPtr createPlaceholder()
+    {
+        ColumnComponentPtr comp { new Component, ComponentDeleter { columnForComponent } };
+        comp->setInterceptsMouseClicks (false, false);
+        comp->getProperties().set (tableAccessiblePlaceholderProperty, true);
+        return comp;
+    }
+
+    void refreshColumn (int index, int columnId, Rectangle<int> position)
+    {
+        const ComponentDeleter deleter { columnForComponent };
+        auto originalComp = std::move (columnComponents[(size_t) index]);
+        auto oldCustomComp = originalComp != nullptr && ! originalComp->getProperties().contains (tableAccessiblePlaceholderProperty)
+                           ? std::move (originalComp)
+                           : ColumnComponentPtr { nullptr, deleter };
+        auto compToRefresh = oldCustomComp != nullptr && columnId == static_cast<int> (oldCustomComp->getProperties()[tableColumnProperty])
+                           ? std::move (oldCustomComp)
+                           : ColumnComponentPtr { nullptr, deleter };
+
+        columnForComponent.erase (compToRefresh.get());
+        ColumnComponentPtr newCustomComp { owner.getTableListBoxModel()->refreshComponentForCell (getRow(),
+                                                                                                 columnId,
+                                                                                                 isSelected(),
+                                                                                                 compToRefresh.release()),
+                                           deleter };
+
+        auto columnComp = [&]
+        {
+            // We got a result from refreshComponentForCell, so use that
+            if (newCustomComp != nullptr)
+                return std::move (newCustomComp);
+
+            // There was already a placeholder component for this column
+            if (originalComp != nullptr)
+                return std::move (originalComp);
+
+            // Create a new placeholder component to use
+            return createPlaceholder();
+        }();
+
+        setColumnComponent (index, columnId, std::move (columnComp));
+        columnIsUpToDate[(size_t) index] = true;
+        columnComponents[(size_t) index]->setBounds (position.withY (0).withHeight (getHeight()));
+    }
+
+    void setColumnComponent (int index, int columnId, ColumnComponentPtr columnComp)
+    {
+        columnForComponent.emplace (columnComp.get(), index);
+
+        // In order for navigation to work correctly on macOS, the number of child
+        // accessibility elements on each row must match the number of header accessibility
+        // elements.
+        columnComp->setFocusContainerType (FocusContainerType::focusContainer);
+        columnComp->getProperties().set (tableColumnProperty, columnId);
+        addAndMakeVisible (*columnComp);
+
+        columnComponents[(size_t) index] = std::move (columnComp);
+    }
+
     TableListBox& owner;
     std::map<const Component*, int> columnForComponent;
-    std::vector<std::unique_ptr<Component, ComponentDeleter>> columnComponents;
+    std::vector<ColumnComponentPtr> columnComponents;
+    std::vector<bool> columnIsUpToDate;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RowComp)
 };
@@ -462,6 +500,11 @@ int TableListBox::getNumRows()
     return model != nullptr ? model->getNumRows() : 0;
 }
 
+int TableListBox::getHeightForRow (int rowNumber)
+{
+    return model != nullptr ? model->getHeightForRow (rowNumber) : 0;
+}
+
 void TableListBox::paintListBoxItem (int, Graphics&, int, int, bool)
 {
 }
@@ -502,6 +545,10 @@ void TableListBox::backgroundClicked (const MouseEvent& e)
 
 void TableListBox::listWasScrolled()
 {
+    const auto visibleColumns = getVisibleColumnRange();
+
+    forEachRowComp ([&] (RowComp& rowComp) { rowComp.updateColumnsInRange (visibleColumns); });
+
     if (model != nullptr)
         model->listWasScrolled();
 }
@@ -542,12 +589,30 @@ void TableListBox::resized()
 }
 
 void TableListBox::updateColumnComponents() const
+{
+    const auto visibleColumns = getVisibleColumnRange();
+
+    forEachRowComp ([&] (RowComp& rowComp)
+    {
+        rowComp.resized();
+        rowComp.updateColumnsInRange (visibleColumns);
+    });
+}
+
+template <typename Callback>
+void TableListBox::forEachRowComp (Callback&& callback) const
 {
     auto firstRow = getRowContainingPosition (0, 0);
 
     for (int i = firstRow + getNumRowsOnScreen() + 2; --i >= firstRow;)
         if (auto* rowComp = dynamic_cast<RowComp*> (getComponentForRowNumber (i)))
-            rowComp->resized();
+            callback (*rowComp);
+}
+
+Range<int> TableListBox::getVisibleColumnRange() const
+{
+    auto* vp = getViewport();
+    return Range<int>::withStartAndLength (vp->getViewPositionX(), vp->getViewWidth());
 }
 
 template <typename FindIndex>
@@ -662,6 +727,7 @@ void TableListBoxModel::cellDoubleClicked (int, int, const MouseEvent&) {}
 void TableListBoxModel::backgroundClicked (const MouseEvent&)           {}
 void TableListBoxModel::sortOrderChanged (int, bool)                    {}
 int TableListBoxModel::getColumnAutoSizeWidth (int)                     { return 0; }
+int TableListBoxModel::getHeightForRow (int)                            { return 0; }
 void TableListBoxModel::selectedRowsChanged (int)                       {}
 void TableListBoxModel::deleteKeyPressed (int)                          {}
 void TableListBoxModel::returnKeyPressed (int)                          {}
@@ -676,4 +742,71 @@ Component* TableListBoxModel::refreshComponentForCell (int, int, bool, [[maybe_u
     return nullptr;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TableListBoxTests final : public UnitTest
+{
+public:
+    TableListBoxTests() : UnitTest ("TableListBox", UnitTestCategories::gui) {}
+
+    void runTest() override
+    {
+        beginTest ("Only the columns that are scrolled into view are refreshed");
+        {
+            WideTableModel model;
+            TableListBox table ({}, &model);
+
+            for (int i = 1; i <= WideTableModel::numColumns; ++i)
+                table.getHeader().addColumn (String (i), i, WideTableModel::columnWidth);
+
+            table.setSize (400, 300);
+            table.updateContent();
+
+            const auto numVisibleColumns = 400 / WideTableModel::columnWidth + 1;
+            expect (! model.refreshedCells.empty());
+
+            for (auto& cell : model.refreshedCells)
+                expect (cell.second <= numVisibleColumns);
+
+            model.refreshedCells.clear();
+            table.getViewport()->setViewPosition (100 * WideTableModel::columnWidth, 0);
+
+            expect (! model.refreshedCells.empty());
+
+            for (auto& cell : model.refreshedCells)
+                expect (cell.second > 100 && cell.second <= 100 + numVisibleColumns);
+
+            model.refreshedCells.clear();
+            auto* cell = table.getCellComponent (WideTableModel::numColumns, 0);
+            expect (cell != nullptr);
+            expect (model.refreshedCells.size() == 1
+                    && model.refreshedCells.front() == std::make_pair (0, (int) WideTableModel::numColumns));
+        }
+    }
+
+private:
+    struct WideTableModel final : public TableListBoxModel
+    {
+        static constexpr int numColumns = 200, columnWidth = 50;
+
+        int getNumRows() override                                                { return 1000; }
+        void paintRowBackground (Graphics&, int, int, int, bool) override        {}
+        void paintCell (Graphics&, int, int, int, int, bool) override            {}
+
+        Component* refreshComponentForCell (int row, int columnId, bool, Component*) override
+        {
+            refreshedCells.emplace_back (row, columnId);
+            return nullptr;
+        }
+
+        std::vector<std::pair<int, int>> refreshedCells;
+    };
+};
+
+static TableListBoxTests tableListBoxTests;
+
+#endif
+
 } // namespace juce
@@ -153,6 +153,13 @@ public:
     /** Returns a tooltip for a particular cell in the table. */
     virtual String getCellTooltip (int rowNumber, int columnId);
 
+    /** If variable row heights are enabled for the table, this is used to find the
+        height of each row. Returning 0 or less gives the row the table's default height.
+
+        @see ListBox::setVariableRowHeightsEnabled, ListBoxModel::getHeightForRow
+    */
+    virtual int getHeightForRow (int rowNumber);
+
     //==============================================================================
     /** Override this to be informed when rows are selected or deselected.
         @see ListBox::selectedRowsChanged()
@@ -308,6 +315,8 @@ public:
     /** @internal */
     int getNumRows() override;
     /** @internal */
+    int getHeightForRow (int) override;
+    /** @internal */
     void paintListBoxItem (int, Graphics&, int, int, bool) override;
     /** @internal */
     Component* refreshComponentForRow (int rowNumber, bool isRowSelected, Component* existingComponentToUpdate) override;
@@ -349,6 +358,10 @@ private:
     bool autoSizeOptionsShown = true;
 
     void updateColumnComponents() const;
+    Range<int> getVisibleColumnRange() const;
+
+    template <typename Callback>
+    void forEachRowComp (Callback&&) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TableListBox)
 };
@@ -0,0 +1,725 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class TreeListBox::ItemComponentHolder final : public Component
+{
+public:
+    ItemComponentHolder()
+    {
+        setInterceptsMouseClicks (false, true);
+    }
+
+    Component* releaseContent()
+    {
+        return content.release();
+    }
+
+    void setContent (Component* newContent, int newIndent)
+    {
+        content.reset (newContent);
+        addAndMakeVisible (content.get());
+        indent = newIndent;
+        resized();
+    }
+
+    void resized() override
+    {
+        if (content != nullptr)
+            content->setBounds (getLocalBounds().withTrimmedLeft (indent));
+    }
+
+private:
+    std::unique_ptr<Component> content;
+    int indent = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (ItemComponentHolder)
+};
+
+//==============================================================================
+TreeListBox::TreeListBox (const String& name, TreeListBoxModel* const m)
+    : ListBox (name, nullptr), model (m)
+{
+    ListBox::assignModelPtr (this);
+    resetRoot();
+}
+
+TreeListBox::~TreeListBox()
+{
+}
+
+void TreeListBox::setModel (TreeListBoxModel* newModel)
+{
+    if (model != newModel)
+    {
+        model = newModel;
+        resetRoot();
+        selectRowAfterStructureChange (-1);
+    }
+}
+
+void TreeListBox::modelChanged()
+{
+    std::set<int64> previouslyOpenItems;
+
+    for (auto& item : openItems)
+        if (item.first != rootID)
+            previouslyOpenItems.insert (item.first);
+
+    const auto previouslySelectedItem = getSelectedItem();
+    std::optional<std::pair<int64, int>> selectedItemPosition;
+
+    resetRoot();
+
+    if (model != nullptr && (! previouslyOpenItems.empty() || previouslySelectedItem.has_value()))
+        reopenItems (rootID, previouslyOpenItems, previouslySelectedItem, selectedItemPosition);
+
+    selectRowAfterStructureChange (selectedItemPosition.has_value() ? getRowOfChild (selectedItemPosition->first,
+                                                                                     selectedItemPosition->second)
+                                                                    : -1);
+}
+
+//==============================================================================
+std::optional<int64> TreeListBox::getItemForRow (int row) const
+{
+    if (auto info = findRow (row))
+        return info->itemID;
+
+    return {};
+}
+
+int TreeListBox::getDepthOfRow (int row) const
+{
+    if (auto info = findRow (row))
+        return info->depth;
+
+    return -1;
+}
+
+int TreeListBox::getRowForItem (int64 itemID) const
+{
+    if (model == nullptr || itemID == rootID)
+        return -1;
+
+    const auto open = openItems.find (itemID);
+
+    if (open != openItems.end())
+        return getRowOfChild (open->second.parent, open->second.indexInParent);
+
+    for (auto& item : openItems)
+        for (int i = 0; i < item.second.numChildren; ++i)
+            if (model->getChild (item.first, i) == itemID)
+                return getRowOfChild (item.first, i);
+
+    return -1;
+}
+
+bool TreeListBox::isRowOpen (int row) const
+{
+    if (auto info = findRow (row))
+        return isItemOpen (info->itemID);
+
+    return false;
+}
+
+void TreeListBox::setRowOpen (int row, bool shouldBeOpen)
+{
+    const auto info = findRow (row);
+
+    if (! info.has_value() || isItemOpen (info->itemID) == shouldBeOpen)
+        return;
+
+    auto selectedRow = getSelectedRow();
+
+    if (shouldBeOpen)
+    {
+        openItem (*info);
+
+        if (selectedRow > row)
+            selectedRow += openItems.at (info->itemID).numRows;
+    }
+    else
+    {
+        const auto numRowsRemoved = openItems.at (info->itemID).numRows;
+        closeItem (info->itemID);
+
+        if (selectedRow > row + numRowsRemoved)
+            selectedRow -= numRowsRemoved;
+        else if (selectedRow > row)
+            selectedRow = row;
+    }
+
+    selectRowAfterStructureChange (selectedRow);
+    model->itemOpennessChanged (info->itemID, shouldBeOpen);
+}
+
+bool TreeListBox::isItemOpen (int64 itemID) const
+{
+    return itemID != rootID && openItems.find (itemID) != openItems.end();
+}
+
+std::optional<int64> TreeListBox::getSelectedItem() const
+{
+    return getItemForRow (getSelectedRow());
+}
+
+//==============================================================================
+void TreeListBox::setIndentSize (int newIndentSize)
+{
+    if (indentSize != newIndentSize)
+    {
+        indentSize = newIndentSize;
+        updateContent();
+        repaint();
+    }
+}
+
+int TreeListBox::getIndentSize() const noexcept
+{
+    return indentSize >= 0 ? indentSize : getRowHeight();
+}
+
+//==============================================================================
+/*  Only the open items are stored. Each one keeps its open children sorted by index,
+    along with the number of rows taken up by the open children that come before
+    them, so the item on a row can be found with a binary search at each level.
+*/
+std::optional<TreeListBox::RowInfo> TreeListBox::findRow (int row) const
+{
+    if (model == nullptr || row < 0 || row >= openItems.at (rootID).numRows)
+        return {};
+
+    auto parentID = rootID;
+    auto* parent = &openItems.at (rootID);
+
+    for (;;)
+    {
+        auto& children = parent->openChildren;
+        const auto next = std::upper_bound (children.begin(), children.end(), row,
+                                            [] (int r, const OpenChild& c) { return r < c.index + c.rowsBefore; });
+
+        if (next == children.begin())
+            return RowInfo { model->getChild (parentID, row), parentID, row, parent->depth + 1 };
+
+        auto& child = *std::prev (next);
+        const auto childRow = child.index + child.rowsBefore;
+
+        if (row == childRow)
+            return RowInfo { child.itemID, parentID, child.index, parent->depth + 1 };
+
+        auto& childItem = openItems.at (child.itemID);
+        const auto rowWithinChild = row - childRow - 1;
+
+        if (rowWithinChild < childItem.numRows)
+        {
+            parentID = child.itemID;
+            parent = &childItem;
+            row = rowWithinChild;
+            continue;
+        }
+
+        const auto index = child.index + 1 + (rowWithinChild - childItem.numRows);
+        return RowInfo { model->getChild (parentID, index), parentID, index, parent->depth + 1 };
+    }
+}
+
+int TreeListBox::getRowOfChild (int64 parentID, int index) const
+{
+    int row = -1;
+
+    for (;;)
+    {
+        auto& parent = openItems.at (parentID);
+        auto& children = parent.openChildren;
+        const auto next = std::lower_bound (children.begin(), children.end(), index,
+                                            [] (const OpenChild& c, int i) { return c.index < i; });
+
+        row += 1 + index;
+
+        if (next != children.begin())
+        {
+            auto& previous = *std::prev (next);
+            row += previous.rowsBefore + openItems.at (previous.itemID).numRows;
+        }
+
+        if (parentID == rootID)
+            return row;
+
+        index = parent.indexInParent;
+        parentID = parent.parent;
+    }
+}
+
+void TreeListBox::openItem (const RowInfo& info)
+{
+    const auto numChildren = jmax (0, model->getNumChildren (info.itemID));
+    auto& children = openItems.at (info.parent).openChildren;
+    auto next = std::lower_bound (children.begin(), children.end(), info.indexInParent,
+                                  [] (const OpenChild& c, int i) { return c.index < i; });
+
+    int rowsBefore = 0;
+
+    if (next != children.begin())
+    {
+        auto& previous = *std::prev (next);
+        rowsBefore = previous.rowsBefore + openItems.at (previous.itemID).numRows;
+    }
+
+    children.insert (next, { info.indexInParent, info.itemID, rowsBefore });
+    openItems[info.itemID] = { info.parent, info.indexInParent, info.depth, numChildren, numChildren, {} };
+    addRowsToAncestors (info.itemID, numChildren);
+}
+
+void TreeListBox::closeItem (int64 itemID)
+{
+    auto& item = openItems.at (itemID);
+    addRowsToAncestors (itemID, -item.numRows);
+
+    auto& siblings = openItems.at (item.parent).openChildren;
+    siblings.erase (std::lower_bound (siblings.begin(), siblings.end(), item.indexInParent,
+                                      [] (const OpenChild& c, int i) { return c.index < i; }));
+
+    removeOpenItem (itemID);
+}
+
+void TreeListBox::removeOpenItem (int64 itemID)
+{
+    const auto item = openItems.find (itemID);
+
+    for (auto& child : item->second.openChildren)
+        removeOpenItem (child.itemID);
+
+    openItems.erase (item);
+}
+
+void TreeListBox::addRowsToAncestors (int64 itemID, int delta)
+{
+    while (itemID != rootID)
+    {
+        auto& item = openItems.at (itemID);
+        auto& parent = openItems.at (item.parent);
+        auto& siblings = parent.openChildren;
+
+        for (auto i = std::upper_bound (siblings.begin(), siblings.end(), item.indexInParent,
+                                        [] (int index, const OpenChild& c) { return index < c.index; });
+             i != siblings.end(); ++i)
+            i->rowsBefore += delta;
+
+        parent.numRows += delta;
+        itemID = item.parent;
+    }
+}
+
+void TreeListBox::resetRoot()
+{
+    openItems.clear();
+
+    if (model != nullptr)
+    {
+        rootID = model->getRootItemID();
+        const auto numChildren = jmax (0, model->getNumChildren (rootID));
+        openItems[rootID] = { rootID, -1, -1, numChildren, numChildren, {} };
+    }
+}
+
+void TreeListBox::reopenItems (int64 parentID, const std::set<int64>& itemsToOpen,
+                               std::optional<int64> itemToFind, std::optional<std::pair<int64, int>>& foundItem)
+{
+    const auto numChildren = openItems.at (parentID).numChildren;
+    const auto depth = openItems.at (parentID).depth + 1;
+
+    for (int i = 0; i < numChildren; ++i)
+    {
+        const auto childID = model->getChild (parentID, i);
+
+        if (childID == itemToFind)
+            foundItem = std::make_pair (parentID, i);
+
+        if (itemsToOpen.count (childID) != 0 && openItems.find (childID) == openItems.end())
+        {
+            openItem ({ childID, parentID, i, depth });
+            reopenItems (childID, itemsToOpen, itemToFind, foundItem);
+        }
+    }
+}
+
+void TreeListBox::selectRowAfterStructureChange (int row)
+{
+    {
+        const ScopedValueSetter<bool> svs (ignoreSelectionChanges, true);
+
+        updateContent();
+
+        if (row >= 0)
+            selectRow (row, true, true);
+        else
+            deselectAllRows();
+    }
+
+    repaint();
+    selectedRowsChanged (row);
+}
+
+bool TreeListBox::isInExpanderArea (int row, int x) const
+{
+    if (auto info = findRow (row))
+    {
+        const auto indent = getIndentSize();
+        const auto left = info->depth * indent;
+
+        return left <= x && x < left + indent && model->mightHaveChildren (info->itemID);
+    }
+
+    return false;
+}
+
+//==============================================================================
+int TreeListBox::getNumRows()
+{
+    if (model == nullptr)
+        return 0;
+
+    return openItems.at (rootID).numRows;
+}
+
+void TreeListBox::paintListBoxItem (int row, Graphics& g, int width, int height, bool rowIsSelected)
+{
+    const auto info = findRow (row);
+
+    if (! info.has_value())
+        return;
+
+    if (rowIsSelected)
+        g.fillAll (findColour (TreeView::selectedItemBackgroundColourId));
+
+    const auto indent = getIndentSize();
+    const auto left = info->depth * indent;
+
+    if (model->mightHaveChildren (info->itemID))
+        getLookAndFeel().drawTreeviewPlusMinusBox (g, Rectangle<int> (left, 0, indent, height).toFloat(),
+                                                   findColour (TreeView::backgroundColourId),
+                                                   isItemOpen (info->itemID), false);
+
+    const Graphics::ScopedSaveState ss (g);
+    g.setOrigin (left + indent, 0);
+
+    const auto itemWidth = width - (left + indent);
+
+    if (g.reduceClipRegion (0, 0, itemWidth, height))
+        model->paintItem (info->itemID, g, itemWidth, height, rowIsSelected);
+}
+
+Component* TreeListBox::refreshComponentForRow (int row, bool isRowSelected, Component* existingComponentToUpdate)
+{
+    std::unique_ptr<ItemComponentHolder> holder (static_cast<ItemComponentHolder*> (existingComponentToUpdate));
+    const auto info = findRow (row);
+
+    if (! info.has_value())
+        return nullptr;
+
+    auto* content = model->refreshComponentForItem (info->itemID, isRowSelected,
+                                                    holder != nullptr ? holder->releaseContent() : nullptr);
+
+    if (content == nullptr)
+        return nullptr;
+
+    if (holder == nullptr)
+        holder = std::make_unique<ItemComponentHolder>();
+
+    holder->setContent (content, (info->depth + 1) * getIndentSize());
+    return holder.release();
+}
+
+String TreeListBox::getNameForRow (int row)
+{
+    if (auto info = findRow (row))
+        return model->getNameForItem (info->itemID);
+
+    return {};
+}
+
+void TreeListBox::listBoxItemClicked (int row, const MouseEvent& e)
+{
+    if (isInExpanderArea (row, e.x))
+        setRowOpen (row, ! isRowOpen (row));
+    else if (auto info = findRow (row))
+        model->itemClicked (info->itemID, e);
+}
+
+void TreeListBox::listBoxItemDoubleClicked (int row, const MouseEvent& e)
+{
+    if (! isInExpanderArea (row, e.x))
+        if (auto info = findRow (row))
+            model->itemDoubleClicked (info->itemID, e);
+}
+
+void TreeListBox::selectedRowsChanged (int)
+{
+    if (ignoreSelectionChanges)
+        return;
+
+    const auto selectedItem = getSelectedItem();
+
+    if (std::exchange (lastSelectedItem, selectedItem) != selectedItem && model != nullptr)
+        model->selectedItemChanged (selectedItem);
+}
+
+bool TreeListBox::keyPressed (const KeyPress& key)
+{
+    const auto isLeft  = key == KeyPress (KeyPress::leftKey);
+    const auto isRight = key == KeyPress (KeyPress::rightKey);
+
+    if (isLeft || isRight)
+    {
+        const auto row = getSelectedRow();
+
+        if (auto info = findRow (row))
+        {
+            const auto isOpen = isItemOpen (info->itemID);
+
+            if (isRight && isOpen)
+            {
+                if (openItems.at (info->itemID).numChildren > 0)
+                    selectRow (row + 1);
+            }
+            else if (isRight)
+            {
+                if (model->mightHaveChildren (info->itemID))
+                    setRowOpen (row, true);
+            }
+            else if (isOpen)
+            {
+                setRowOpen (row, false);
+            }
+            else if (info->parent != rootID)
+            {
+                auto& parent = openItems.at (info->parent);
+                selectRow (getRowOfChild (parent.parent, parent.indexInParent));
+            }
+
+            return true;
+        }
+    }
+
+    return ListBox::keyPressed (key);
+}
+
+//==============================================================================
+bool TreeListBoxModel::mightHaveChildren (int64 itemID)                 { return getNumChildren (itemID) > 0; }
+String TreeListBoxModel::getNameForItem (int64 itemID)                  { return "Item " + String (itemID); }
+void TreeListBoxModel::itemClicked (int64, const MouseEvent&)          {}
+void TreeListBoxModel::itemDoubleClicked (int64, const MouseEvent&)    {}
+void TreeListBoxModel::selectedItemChanged (std::optional<int64>)      {}
+void TreeListBoxModel::itemOpennessChanged (int64, bool)               {}
+
+Component* TreeListBoxModel::refreshComponentForItem (int64, bool, [[maybe_unused]] Component* existingComponentToUpdate)
+{
+    jassert (existingComponentToUpdate == nullptr); // indicates a failure in the code that recycles the components
+    return nullptr;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TreeListBoxTests final : public UnitTest
+{
+public:
+    TreeListBoxTests() : UnitTest ("TreeListBox", UnitTestCategories::gui) {}
+
+    void runTest() override
+    {
+        beginTest ("Rows match a flattened copy of the tree");
+        {
+            SmallTreeModel model;
+            TreeListBox tree ({}, &model);
+            auto r = getRandom();
+
+            expect (checkAgainstFlattenedTree (tree, model));
+
+            for (int i = 0; i < 300; ++i)
+            {
+                const auto row = r.nextInt (tree.getNumRows());
+                tree.setRowOpen (row, ! tree.isRowOpen (row));
+
+                if (i % 10 == 0)
+                    expect (checkAgainstFlattenedTree (tree, model));
+            }
+
+            expect (checkAgainstFlattenedTree (tree, model));
+        }
+
+        beginTest ("The selected item stays selected when rows are opened or closed");
+        {
+            SmallTreeModel model;
+            TreeListBox tree ({}, &model);
+            tree.updateContent();
+
+            tree.selectRow (5);
+            const auto selected = tree.getSelectedItem();
+            expect (selected.has_value());
+            expect (model.lastSelectedItem == selected);
+
+            tree.setRowOpen (0, true);
+            tree.setRowOpen (1, true);
+            expect (tree.getSelectedItem() == selected);
+            expect (model.lastSelectedItem == selected);
+
+            int parentRow = 0;
+
+            while (model.getNumChildren (*tree.getItemForRow (parentRow)) == 0 || tree.isRowOpen (parentRow))
+                ++parentRow;
+
+            tree.setRowOpen (parentRow, true);
+            tree.selectRow (parentRow + 1);
+            expect (model.lastSelectedItem == model.getChild (*tree.getItemForRow (parentRow), 0));
+
+            tree.setRowOpen (parentRow, false);
+            expect (tree.getSelectedItem() == tree.getItemForRow (parentRow));
+            expect (model.lastSelectedItem == tree.getItemForRow (parentRow));
+        }
+
+        beginTest ("Open items are kept when the model changes");
+        {
+            SmallTreeModel model;
+            TreeListBox tree ({}, &model);
+
+            for (int row = 0; row < tree.getNumRows(); row += 2)
+                tree.setRowOpen (row, true);
+
+            tree.selectRow (tree.getNumRows() - 1);
+            const auto selected = tree.getSelectedItem();
+            const auto numRows = tree.getNumRows();
+
+            tree.modelChanged();
+            expectEquals (tree.getNumRows(), numRows);
+            expect (tree.getSelectedItem() == selected);
+            expect (checkAgainstFlattenedTree (tree, model));
+        }
+
+        beginTest ("Huge trees");
+        {
+            HugeTreeModel model;
+            TreeListBox tree ({}, &model);
+            expectEquals (tree.getNumRows(), HugeTreeModel::numTopLevelItems);
+
+            tree.setRowOpen (HugeTreeModel::numTopLevelItems - 1, true);
+            tree.setRowOpen (500000, true);
+            tree.setRowOpen (0, true);
+
+            expectEquals (tree.getNumRows(), HugeTreeModel::numTopLevelItems + 3 * HugeTreeModel::numChildren);
+            expect (tree.getItemForRow (0) == HugeTreeModel::topLevelItem (0));
+            expect (tree.getItemForRow (HugeTreeModel::numChildren) == HugeTreeModel::childItem (0, HugeTreeModel::numChildren - 1));
+            expect (tree.getItemForRow (500000 + HugeTreeModel::numChildren) == HugeTreeModel::topLevelItem (500000));
+            expect (tree.getItemForRow (500001 + HugeTreeModel::numChildren) == HugeTreeModel::childItem (500000, 0));
+            expect (tree.getItemForRow (tree.getNumRows() - 1) == HugeTreeModel::childItem (HugeTreeModel::numTopLevelItems - 1,
+                                                                                             HugeTreeModel::numChildren - 1));
+            expectEquals (tree.getDepthOfRow (500001 + HugeTreeModel::numChildren), 1);
+            expectEquals (tree.getRowForItem (HugeTreeModel::topLevelItem (500000)), 500000 + HugeTreeModel::numChildren);
+            expect (model.numChildrenRequested < 100);
+        }
+    }
+
+private:
+    // Items with IDs up to 8^4 have a pseudo-random number of children (at most 7),
+    // and an item's children have the IDs (id * 8 + 1) to (id * 8 + 7).
+    struct SmallTreeModel final : public TreeListBoxModel
+    {
+        int getNumChildren (int64 item) override
+        {
+            if (item == 0)
+                return 6;
+
+            return item < 4096 ? (int) (((uint64) item * 2654435761u) >> 7) % 5 : 0;
+        }
+
+        int64 getChild (int64 parent, int index) override                { return parent * 8 + index + 1; }
+        void paintItem (int64, Graphics&, int, int, bool) override        {}
+        void selectedItemChanged (std::optional<int64> item) override     { lastSelectedItem = item; }
+
+        std::optional<int64> lastSelectedItem;
+    };
+
+    struct HugeTreeModel final : public TreeListBoxModel
+    {
+        static constexpr int numTopLevelItems = 1000000, numChildren = 1000;
+
+        static int64 topLevelItem (int index)                  { return index + 1; }
+        static int64 childItem (int parentIndex, int index)    { return numTopLevelItems + 1 + (int64) parentIndex * numChildren + index; }
+
+        int getNumChildren (int64 item) override
+        {
+            return item == 0 ? numTopLevelItems : (item <= numTopLevelItems ? numChildren : 0);
+        }
+
+        int64 getChild (int64 parent, int index) override
+        {
+            ++numChildrenRequested;
+            return parent == 0 ? topLevelItem (index) : childItem ((int) parent - 1, index);
+        }
+
+        void paintItem (int64, Graphics&, int, int, bool) override {}
+
+        int numChildrenRequested = 0;
+    };
+
+    static void flatten (TreeListBox& tree, SmallTreeModel& model, int64 item, int depth,
+                         std::vector<std::pair<int64, int>>& result)
+    {
+        for (int i = 0; i < model.getNumChildren (item); ++i)
+        {
+            const auto child = model.getChild (item, i);
+            result.emplace_back (child, depth);
+
+            if (tree.isItemOpen (child))
+                flatten (tree, model, child, depth + 1, result);
+        }
+    }
+
+    static bool checkAgainstFlattenedTree (TreeListBox& tree, SmallTreeModel& model)
+    {
+        std::vector<std::pair<int64, int>> rows;
+        flatten (tree, model, 0, 0, rows);
+
+        if ((int) rows.size() != tree.getNumRows() || tree.getItemForRow ((int) rows.size()).has_value())
+            return false;
+
+        for (int row = 0; row < (int) rows.size(); ++row)
+            if (tree.getItemForRow (row) != rows[(size_t) row].first
+                 || tree.getDepthOfRow (row) != rows[(size_t) row].second
+                 || tree.getRowForItem (rows[(size_t) row].first) != row)
+                return false;
+
+        return true;
+    }
+};
+
+static TreeListBoxTests treeListBoxTests;
+
+#endif
+
+} // namespace juce
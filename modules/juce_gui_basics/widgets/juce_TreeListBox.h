@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    The data source for a TreeListBox.
+
+    Items are identified by 64-bit IDs which must be unique within the tree. The
+    TreeListBox only asks for the children of items that the user has opened, and
+    only for those children that are currently scrolled into view, so the model is
+    free to produce its items lazily.
+
+    @see TreeListBox
+
+    @tags{GUI}
+*/
+class JUCE_API  TreeListBoxModel
+{
+public:
+    //==============================================================================
+    TreeListBoxModel() = default;
+
+    /** Destructor. */
+    virtual ~TreeListBoxModel() = default;
+
+    //==============================================================================
+    /** Returns the ID of the (invisible) root item, whose children form the top
+        level of the tree. By default this is 0.
+    */
+    virtual int64 getRootItemID()                                   { return 0; }
+
+    /** Returns the number of children that an item has.
+
+        This is only called when an item is opened, or when TreeListBox::modelChanged()
+        is called, so it's fine for it to do some work.
+    */
+    virtual int getNumChildren (int64 itemID) = 0;
+
+    /** Returns the ID of one of an item's children. */
+    virtual int64 getChild (int64 parentItemID, int childIndex) = 0;
+
+    /** Returns true if the item should be drawn with an open/close button.
+
+        The default implementation calls getNumChildren(), so if counting an item's
+        children is expensive you should override this to give a quicker guess.
+    */
+    virtual bool mightHaveChildren (int64 itemID);
+
+    /** This must draw an item.
+
+        The graphics context's origin will be the top-left of the area to the right
+        of the item's indentation and open/close button, and the width passed in is
+        the width of this area.
+    */
+    virtual void paintItem (int64 itemID, Graphics&, int width, int height, bool isSelected) = 0;
+
+    /** This is used to create or update a custom component to represent an item.
+
+        This works in the same way as ListBoxModel::refreshComponentForRow(), except
+        that the component is placed to the right of the item's indentation.
+
+        @see ListBoxModel::refreshComponentForRow
+    */
+    virtual Component* refreshComponentForItem (int64 itemID, bool isSelected,
+                                                Component* existingComponentToUpdate);
+
+    /** Returns a name for an item, which is used for accessibility. */
+    virtual String getNameForItem (int64 itemID);
+
+    //==============================================================================
+    /** Called when the user clicks on an item, other than on its open/close button.
+        The mouse event's coordinates are relative to the entire row.
+    */
+    virtual void itemClicked (int64 itemID, const MouseEvent&);
+
+    /** Called when the user double-clicks on an item.
+        The mouse event's coordinates are relative to the entire row.
+    */
+    virtual void itemDoubleClicked (int64 itemID, const MouseEvent&);
+
+    /** Called when the selected item changes.
+        The argument will be empty if no item is now selected.
+    */
+    virtual void selectedItemChanged (std::optional<int64> newSelectedItemID);
+
+    /** Called when an item is opened or closed. */
+    virtual void itemOpennessChanged (int64 itemID, bool isNowOpen);
+};
+
+
+//==============================================================================
+/**
+    A tree which can display very large hierarchies of items.
+
+    Unlike TreeView, which needs a TreeViewItem object for every item, this class
+    asks a TreeListBoxModel for its items on demand. It only keeps some bookkeeping
+    for the items that are open, from which the item on any row can be found in
+    logarithmic time, and like a ListBox it only creates components for the rows
+    that are on-screen. This makes it suitable for trees with millions of items,
+    as long as the items all have the same height.
+
+    The root item isn't displayed, and is always open.
+
+    @see TreeListBoxModel, TreeView, ListBox
+
+    @tags{GUI}
+*/
+class JUCE_API  TreeListBox   : public ListBox,
+                                private ListBoxModel
+{
+public:
+    //==============================================================================
+    /** Creates a TreeListBox.
+
+        The model pointer passed-in can be null, in which case you can set it later
+        with setModel(). The TreeListBox does not take ownership of the model - it's
+        the caller's responsibility to manage its lifetime and make sure it
+        doesn't get deleted while still being used.
+    */
+    TreeListBox (const String& componentName = String(),
+                 TreeListBoxModel* model = nullptr);
+
+    /** Destructor. */
+    ~TreeListBox() override;
+
+    //==============================================================================
+    /** Changes the model that is being used for this tree.
+        This closes all of the items in the tree.
+    */
+    void setModel (TreeListBoxModel* newModel);
+
+    /** Returns the model currently in use. */
+    TreeListBoxModel* getTreeListBoxModel() const noexcept          { return model; }
+
+    /** Rebuilds the tree after the model's data has changed.
+
+        Items that were open before, and which can still be found among the children
+        of other open items, will stay open, and the selected item will remain
+        selected if it's still visible. This has to look at all the children of all
+        the open items, so it's not something you'd want to call on every change to
+        a huge tree.
+    */
+    void modelChanged();
+
+    //==============================================================================
+    /** Returns the ID of the item shown on a row, or an empty optional if the row
+        is out of range.
+    */
+    std::optional<int64> getItemForRow (int row) const;
+
+    /** Returns the depth of the item on a row, where the top-level items have a
+        depth of 0. Returns -1 if the row is out of range.
+    */
+    int getDepthOfRow (int row) const;
+
+    /** Returns the row on which an item is shown, or -1 if it isn't visible.
+
+        Finding an arbitrary item means searching through its parent's children, so
+        this can be slow for items with many siblings. Items that are open can be
+        found quickly.
+    */
+    int getRowForItem (int64 itemID) const;
+
+    /** Returns true if the item on the given row is open. */
+    bool isRowOpen (int row) const;
+
+    /** Opens or closes the item on the given row. */
+    void setRowOpen (int row, bool shouldBeOpen);
+
+    /** Returns true if the item with this ID is open. */
+    bool isItemOpen (int64 itemID) const;
+
+    /** Returns the ID of the selected item, if there is one. */
+    std::optional<int64> getSelectedItem() const;
+
+    //==============================================================================
+    /** Changes the distance by which each level of the tree is indented.
+        By default, this is the same as the row height.
+    */
+    void setIndentSize (int newIndentSize);
+
+    /** Returns the indentation used for each level of the tree. */
+    int getIndentSize() const noexcept;
+
+    //==============================================================================
+    /** @internal */
+    int getNumRows() override;
+    /** @internal */
+    void paintListBoxItem (int, Graphics&, int, int, bool) override;
+    /** @internal */
+    Component* refreshComponentForRow (int, bool, Component*) override;
+    /** @internal */
+    String getNameForRow (int) override;
+    /** @internal */
+    void listBoxItemClicked (int, const MouseEvent&) override;
+    /** @internal */
+    void listBoxItemDoubleClicked (int, const MouseEvent&) override;
+    /** @internal */
+    void selectedRowsChanged (int) override;
+    /** @internal */
+    bool keyPressed (const KeyPress&) override;
+
+    /** Returns the model currently in use. */
+    [[deprecated ("This function hides the non-virtual ListBox::getModel, use getTreeListBoxModel instead")]]
+    TreeListBoxModel* getModel() const noexcept  { return getTreeListBoxModel(); }
+
+private:
+    //==============================================================================
+    class ItemComponentHolder;
+
+    struct OpenChild
+    {
+        int index;
+        int64 itemID;
+        int rowsBefore;    // the total number of rows below open siblings that come before this one
+    };
+
+    struct OpenItem
+    {
+        int64 parent;
+        int indexInParent, depth, numChildren, numRows;
+        std::vector<OpenChild> openChildren;    // sorted by index
+    };
+
+    struct RowInfo
+    {
+        int64 itemID, parent;
+        int indexInParent, depth;
+    };
+
+    TreeListBoxModel* model;
+    std::unordered_map<int64, OpenItem> openItems;
+    int64 rootID = 0;
+    int indentSize = -1;
+    std::optional<int64> lastSelectedItem;
+    bool ignoreSelectionChanges = false;
+
+    std::optional<RowInfo> findRow (int row) const;
+    int getRowOfChild (int64 parent, int index) const;
+    void openItem (const RowInfo&);
+    void closeItem (int64 itemID);
+    void removeOpenItem (int64 itemID);
+    void addRowsToAncestors (int64 itemID, int delta);
+    void resetRoot();
+    void reopenItems (int64 parent, const std::set<int64>& itemsToOpen,
+                      std::optional<int64> itemToFind, std::optional<std::pair<int64, int>>& foundItem);
+    void selectRowAfterStructureChange (int row);
+    bool isInExpanderArea (int row, int x) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TreeListBox)
+};
+
+} // namespace juce
@@ -105,6 +105,7 @@ void ComponentPeer::handleMagnifyGesture (MouseInputSource::InputSourceType type
 //==============================================================================
 void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
 {
+    const auto paintStartTicks = Time::getHighResolutionTicks();
     Graphics g (contextToPaintTo);
 
     if (component.isTransformed())
@@ -159,6 +160,40 @@ void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
         mess up a lot of the calculations that the library needs to do.
     */
     jassert (roundToInt (10.1f) == 10);
+
+    updateFrameStatistics (paintStartTicks);
+}
+
+void ComponentPeer::updateFrameStatistics (int64 paintStartTicks) noexcept
+{
+    auto& stats = frameStatistics;
+    const auto paintSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - paintStartTicks);
+
+    ++stats.numFramesPainted;
+    stats.lastPaintSeconds = paintSeconds;
+    stats.averagePaintSeconds += (paintSeconds - stats.averagePaintSeconds) / stats.numFramesPainted;
+    stats.maxPaintSeconds = jmax (stats.maxPaintSeconds, paintSeconds);
+
+    if (lastPaintStartTicks != 0)
+    {
+        const auto interval = Time::highResolutionTicksToSeconds (paintStartTicks - lastPaintStartTicks);
+
+        if (interval < 0.25)
+        {
+            ++numFrameIntervals;
+            stats.averageFrameIntervalSeconds += (interval - stats.averageFrameIntervalSeconds) / numFrameIntervals;
+            stats.maxFrameIntervalSeconds = jmax (stats.maxFrameIntervalSeconds, interval);
+        }
+    }
+
+    lastPaintStartTicks = paintStartTicks;
+}
+
+void ComponentPeer::resetFrameStatistics() noexcept
+{
+    frameStatistics = {};
+    numFrameIntervals = 0;
+    lastPaintStartTicks = 0;
 }
 
 Component* ComponentPeer::getTargetForKeyPress()
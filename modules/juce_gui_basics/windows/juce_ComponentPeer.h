@@ -511,6 +511,42 @@ public:
     /** Removes a VBlankListener. */
     void removeVBlankListener (VBlankListener* listenerToRemove) { vBlankListeners.remove (listenerToRemove); }
 
+    //==============================================================================
+    /** Timing information about the frames that a peer has painted.
+
+        @see getFrameStatistics
+    */
+    struct JUCE_API  FrameStatistics
+    {
+        /** The number of times the peer has been painted. */
+        int numFramesPainted = 0;
+
+        /** The time taken by the most recent paint, in seconds. */
+        double lastPaintSeconds = 0.0;
+
+        /** The mean and longest times taken to paint a frame, in seconds. */
+        double averagePaintSeconds = 0.0, maxPaintSeconds = 0.0;
+
+        /** The mean and longest times between the starts of consecutive frames, in seconds.
+            Gaps of more than a quarter of a second are treated as the window having been
+            idle, and aren't included.
+        */
+        double averageFrameIntervalSeconds = 0.0, maxFrameIntervalSeconds = 0.0;
+    };
+
+    /** Returns timing statistics for the frames painted since the peer was created, or
+        since resetFrameStatistics() was last called.
+
+        Repaint requests are collected and issued once per vertical blank, so the average
+        frame interval of a window that's being continuously repainted should be close to
+        the display's refresh period. Paint times approaching that period mean that frames
+        are being dropped.
+    */
+    FrameStatistics getFrameStatistics() const noexcept          { return frameStatistics; }
+
+    /** Clears the values returned by getFrameStatistics(). */
+    void resetFrameStatistics() noexcept;
+
     //==============================================================================
     /** On Windows and Linux this will return the OS scaling factor currently being applied
         to the native window. This is used to convert between physical and logical pixels
@@ -590,11 +626,16 @@ private:
     void globalFocusChanged (Component*) override;
     Component* getTargetForKeyPress();
 
+    void updateFrameStatistics (int64 paintStartTicks) noexcept;
+
     WeakReference<Component> lastFocusedComponent, dragAndDropTargetComponent;
     Component* lastDragAndDropCompUnderMouse = nullptr;
     TextInputTarget* textInputTarget = nullptr;
     const uint32 uniqueID;
     bool isWindowMinimised = false;
+    FrameStatistics frameStatistics;
+    int numFrameIntervals = 0;
+    int64 lastPaintStartTicks = 0;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentPeer)
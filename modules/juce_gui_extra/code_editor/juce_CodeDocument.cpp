@@ -414,7 +414,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
 
             auto& l = *owner->lines.getUnchecked (line);
             indexInLine = l.lineLengthWithoutNewLines;
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
         else
         {
@@ -427,7 +427,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
             else
                 indexInLine = 0;
 
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
     }
 }
@@ -452,13 +452,14 @@ void CodeDocument::Position::setPosition (const int newPosition)
                 for (int i = lineStart; i < lineEnd; ++i)
                 {
                     auto& l = *owner->lines.getUnchecked (i);
-                    auto index = newPosition - l.lineStartInFile;
+                    auto lineStartInFile = owner->getLineStart (i);
+                    auto index = newPosition - lineStartInFile;
 
                     if (index >= 0 && (index < l.lineLength || i == lineEnd - 1))
                     {
                         line = i;
                         indexInLine = jmin (l.lineLengthWithoutNewLines, index);
-                        characterPos = l.lineStartInFile + indexInLine;
+                        characterPos = lineStartInFile + indexInLine;
                     }
                 }
 
@@ -468,7 +469,7 @@ void CodeDocument::Position::setPosition (const int newPosition)
             {
                 auto midIndex = (lineStart + lineEnd + 1) / 2;
 
-                if (newPosition >= owner->lines.getUnchecked (midIndex)->lineStartInFile)
+                if (newPosition >= owner->getLineStart (midIndex))
                     lineStart = midIndex;
                 else
                     lineEnd = midIndex;
@@ -615,7 +616,7 @@ String CodeDocument::getTextBetween (const Position& start, const Position& end)
 int CodeDocument::getNumCharacters() const noexcept
 {
     if (auto* lastLine = lines.getLast())
-        return lastLine->lineStartInFile + lastLine->lineLength;
+        return getLineStart (lines.size() - 1) + lastLine->lineLength;
 
     return 0;
 }
@@ -641,6 +642,54 @@ int CodeDocument::getMaximumLineLength() noexcept
     return maximumLineLength;
 }
 
+void CodeDocument::updateMaximumLineLength (int longestRemovedLine, int longestAddedLine) noexcept
+{
+    // The cached maximum only needs rescanning if the longest line got shorter
+    if (maximumLineLength >= 0)
+    {
+        if (longestRemovedLine < maximumLineLength || longestAddedLine >= longestRemovedLine)
+            maximumLineLength = jmax (maximumLineLength, longestAddedLine);
+        else
+            maximumLineLength = -1;
+    }
+}
+
+//==============================================================================
+/*  Rather than rewriting the start of every following line after each edit, the
+    lines from firstLineWithPendingOffset onwards all share a pending offset that
+    has yet to be added to their stored start. Moving that boundary only touches the
+    lines between the old and new boundary, so consecutive edits in the same region
+    of a large document stay cheap.
+*/
+int CodeDocument::getLineStart (int lineIndex) const noexcept
+{
+    auto start = lines.getUnchecked (lineIndex)->lineStartInFile;
+    return lineIndex >= firstLineWithPendingOffset ? start + pendingLineStartOffset : start;
+}
+
+void CodeDocument::setLineStart (int lineIndex, int newStart) noexcept
+{
+    lines.getUnchecked (lineIndex)->lineStartInFile = lineIndex >= firstLineWithPendingOffset
+                                                        ? newStart - pendingLineStartOffset
+                                                        : newStart;
+}
+
+void CodeDocument::movePendingOffsetTo (int lineIndex) noexcept
+{
+    lineIndex = jlimit (0, lines.size(), lineIndex);
+
+    if (pendingLineStartOffset != 0)
+    {
+        for (int i = firstLineWithPendingOffset; i < lineIndex; ++i)
+            lines.getUnchecked (i)->lineStartInFile += pendingLineStartOffset;
+
+        for (int i = lineIndex; i < firstLineWithPendingOffset; ++i)
+            lines.getUnchecked (i)->lineStartInFile -= pendingLineStartOffset;
+    }
+
+    firstLineWithPendingOffset = lineIndex;
+}
+
 void CodeDocument::deleteSection (const Position& startPosition, const Position& endPosition)
 {
     deleteSection (startPosition.getPosition(), endPosition.getPosition());
@@ -864,13 +913,16 @@ void CodeDocument::checkLastLineStatus()
         lines.removeLast();
     }
 
+    firstLineWithPendingOffset = jmin (firstLineWithPendingOffset, lines.size());
+
     const CodeDocumentLine* const lastLine = lines.getLast();
 
     if (lastLine != nullptr && lastLine->endsWithLineBreak())
     {
         // check that there's an empty line at the end if the preceding one ends in a newline..
-        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0,
-                                         lastLine->lineStartInFile + lastLine->lineLength));
+        auto endOfLastLine = getLineStart (lines.size() - 1) + lastLine->lineLength;
+        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0, 0));
+        setLineStart (lines.size() - 1, endOfLastLine);
     }
 }
 
@@ -933,27 +985,34 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
                                          + firstLine->line.substring (index);
             }
 
-            maximumLineLength = -1;
             Array<CodeDocumentLine*> newLines;
             CodeDocumentLine::createLines (newLines, textInsideOriginalLine);
             jassert (newLines.size() > 0);
 
-            auto* newFirstLine = newLines.getUnchecked (0);
-            newFirstLine->lineStartInFile = firstLine != nullptr ? firstLine->lineStartInFile : 0;
-            lines.set (firstAffectedLine, newFirstLine);
+            int longestNewLine = 0;
+
+            for (auto* l : newLines)
+                longestNewLine = jmax (longestNewLine, l->lineLength);
+
+            updateMaximumLineLength (firstLine != nullptr ? firstLine->lineLength : 0, longestNewLine);
+
+            auto lineStart = firstLine != nullptr ? getLineStart (firstAffectedLine) : 0;
+            movePendingOffsetTo (firstAffectedLine + 1);
+
+            lines.set (firstAffectedLine, newLines.getUnchecked (0));
 
             if (newLines.size() > 1)
                 lines.insertArray (firstAffectedLine + 1, newLines.getRawDataPointer() + 1, newLines.size() - 1);
 
-            int lineStart = newFirstLine->lineStartInFile;
+            firstLineWithPendingOffset = firstAffectedLine + newLines.size();
 
-            for (int i = firstAffectedLine; i < lines.size(); ++i)
+            for (auto* l : newLines)
             {
-                auto& l = *lines.getUnchecked (i);
-                l.lineStartInFile = lineStart;
-                lineStart += l.lineLength;
+                l->lineStartInFile = lineStart;
+                lineStart += l->lineLength;
             }
 
+            pendingLineStartOffset += text.length();
             checkLastLineStatus();
             auto newTextLength = text.length();
 
@@ -1013,11 +1072,17 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
         Position startPosition (*this, startPos);
         Position endPosition (*this, endPos);
 
-        maximumLineLength = -1;
         auto firstAffectedLine = startPosition.getLineNumber();
         auto endLine = endPosition.getLineNumber();
         auto& firstLine = *lines.getUnchecked (firstAffectedLine);
 
+        int longestRemovedLine = 0;
+
+        for (int i = firstAffectedLine; i <= endLine; ++i)
+            longestRemovedLine = jmax (longestRemovedLine, lines.getUnchecked (i)->lineLength);
+
+        movePendingOffsetTo (endLine + 1);
+
         if (firstAffectedLine == endLine)
         {
             firstLine.line = firstLine.line.substring (0, startPosition.getIndexInLine())
@@ -1034,15 +1099,11 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
 
             int numLinesToRemove = endLine - firstAffectedLine;
             lines.removeRange (firstAffectedLine + 1, numLinesToRemove);
+            firstLineWithPendingOffset -= numLinesToRemove;
         }
 
-        for (int i = firstAffectedLine + 1; i < lines.size(); ++i)
-        {
-            auto& l = *lines.getUnchecked (i);
-            auto& previousLine = *lines.getUnchecked (i - 1);
-            l.lineStartInFile = previousLine.lineStartInFile + previousLine.lineLength;
-        }
-
+        updateMaximumLineLength (longestRemovedLine, firstLine.lineLength);
+        pendingLineStartOffset -= endPos - startPos;
         checkLastLineStatus();
         auto totalChars = getNumCharacters();
 
@@ -1287,6 +1348,65 @@ struct CodeDocumentTest final : public UnitTest
                 expectEquals (p3.getIndexInLine(), d.getLine (d.getNumLines() - 1).length(), comment3);
             }
         }
+
+        {
+            beginTest ("Line starts and lengths stay consistent after many edits");
+
+            auto r = getRandom();
+            CodeDocument d;
+            String expected;
+
+            for (int i = 0; i < 500; ++i)
+            {
+                if (expected.isEmpty() || r.nextInt (3) != 0)
+                {
+                    const char* const snippets[] = { "x", "abc", "\n", "line\nbreak", "\r\n", "\n\n" };
+                    const String text (snippets[r.nextInt (numElementsInArray (snippets))]);
+                    const auto pos = r.nextInt (expected.length() + 1);
+
+                    if (pos > 0 && expected[pos - 1] == '\r')
+                        continue;
+
+                    d.insertText (pos, text);
+                    expected = expected.substring (0, pos) + text + expected.substring (pos);
+                }
+                else
+                {
+                    const auto start = r.nextInt (expected.length());
+                    const auto end = jmin (expected.length(), start + 1 + r.nextInt (8));
+
+                    // Avoid splitting a CRLF pair, as the document treats it as a single break
+                    if (expected[start] == '\n' && start > 0 && expected[start - 1] == '\r')
+                        continue;
+
+                    if (expected[end - 1] == '\r' && expected[end] == '\n')
+                        continue;
+
+                    d.deleteSection (start, end);
+                    expected = expected.substring (0, start) + expected.substring (end);
+                }
+
+                expectEquals (d.getNumCharacters(), expected.length());
+
+                int lineStart = 0, longestLine = 0;
+
+                for (int line = 0; line < d.getNumLines(); ++line)
+                {
+                    expectEquals (CodeDocument::Position (d, line, 0).getPosition(), lineStart);
+
+                    if (d.getLine (line).isNotEmpty())
+                        expectEquals (CodeDocument::Position (d, lineStart).getLineNumber(), line);
+
+                    lineStart += d.getLine (line).length();
+                    longestLine = jmax (longestLine, d.getLine (line).length());
+                }
+
+                expectEquals (lineStart, expected.length());
+                expectEquals (d.getMaximumLineLength(), longestLine);
+            }
+
+            expectEquals (d.getAllContent(), expected);
+        }
     }
 };
 
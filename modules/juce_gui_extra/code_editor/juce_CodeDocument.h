@@ -437,12 +437,17 @@ private:
     UndoManager undoManager;
     int currentActionIndex = 0, indexOfSavedState = -1;
     int maximumLineLength = -1;
+    int firstLineWithPendingOffset = 0, pendingLineStartOffset = 0;
     ListenerList<Listener> listeners;
     String newLineChars { "\r\n" };
 
     void insert (const String& text, int insertPos, bool undoable);
     void remove (int startPos, int endPos, bool undoable);
     void checkLastLineStatus();
+    int getLineStart (int lineIndex) const noexcept;
+    void setLineStart (int lineIndex, int newStart) noexcept;
+    void movePendingOffsetTo (int lineIndex) noexcept;
+    void updateMaximumLineLength (int longestRemovedLine, int longestAddedLine) noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CodeDocument)
 };
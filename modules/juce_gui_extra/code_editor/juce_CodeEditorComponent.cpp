@@ -60,7 +60,7 @@ private:
 
         int getTotalNumCharacters() const override
         {
-            return codeEditorComponent.document.getAllContent().length();
+            return codeEditorComponent.document.getNumCharacters();
         }
 
         Range<int> getSelection() const override
@@ -192,8 +192,29 @@ public:
         if (iter == discovered.end() || ! Features { iter->second.discovery.capabilities }.isPropertyExchangeSupported())
             return {};
 
+        auto onResultWithCache = [this, m, header, onResult = std::move (onResult)] (const PropertyExchangeResult& result)
+        {
+            if (! result.getError().has_value()
+                && ! header.pagination.has_value()
+                && result.getHeaderAsReplyHeader().status == 200)
+            {
+                for (auto& [key, cached] : subscriptionCache)
+                {
+                    if (key.getMuid() == m
+                        && cached.header.resource == header.resource
+                        && cached.header.resId == header.resId
+                        && cached.header.mediaType == header.mediaType)
+                    {
+                        cached.data.emplace (result.getBody().begin(), result.getBody().end());
+                    }
+                }
+            }
+
+            NullCheckedInvocation::invoke (onResult, result);
+        };
+
         const auto primed = iter->second.initiatorPropertyCaches.primeCache (propertyDelegate.getNumSimultaneousRequestsSupported(),
-                                                                             std::move (onResult));
+                                                                             std::move (onResultWithCache));
 
         if (! primed.has_value())
             return {};
@@ -297,14 +318,23 @@ public:
 
     SubscriptionKey beginSubscription (MUID m, const PropertySubscriptionHeader& header)
     {
-        return subscriptionManager.beginSubscription (m, header);
+        const auto key = subscriptionManager.beginSubscription (m, header);
+        subscriptionCache[key].header = header;
+        return key;
     }
 
     void endSubscription (SubscriptionKey key)
     {
+        subscriptionCache.erase (key);
         subscriptionManager.endSubscription (key);
     }
 
+    std::optional<std::vector<std::byte>> getCachedSubscriptionData (SubscriptionKey key) const
+    {
+        const auto iter = subscriptionCache.find (key);
+        return iter != subscriptionCache.end() ? iter->second.data : std::nullopt;
+    }
+
     std::vector<SubscriptionKey> getOngoingSubscriptions() const
     {
         return subscriptionManager.getOngoingSubscriptions();
@@ -902,6 +932,8 @@ private:
                     data.header = result.getHeaderAsSubscriptionHeader();
                     data.body = result.getBody();
 
+                    device->updateSubscriptionCache (source, subscribeId, data);
+
                     if (data.header.command == PropertySubscriptionCommand::end)
                         device->subscriptionManager.endSubscriptionFromResponder (source, subscribeId);
 
@@ -1153,6 +1185,9 @@ private:
 
     void propertySubscriptionChanged (SubscriptionKey key, const std::optional<String>& subscribeId) override
     {
+        if (! subscribeId.has_value())
+            subscriptionCache.erase (key);
+
         listeners.call ([&] (auto& l) { l.propertySubscriptionChanged (key, subscribeId); });
     }
 
@@ -1178,6 +1213,23 @@ private:
         return opt;
     }
 
+    /*  A full update replaces the cached copy of the resource. We don't try to apply partial
+        updates, so those (and notifications that the resource has changed) just invalidate it.
+    */
+    void updateSubscriptionCache (MUID source, const String& subscribeId, const PropertySubscriptionData& data)
+    {
+        for (auto& [key, cached] : subscriptionCache)
+        {
+            if (key.getMuid() != source || subscriptionManager.getSubscribeIdForKey (key) != subscribeId)
+                continue;
+
+            if (data.header.command == PropertySubscriptionCommand::full)
+                cached.data.emplace (data.body.begin(), data.body.end());
+            else
+                cached.data.reset();
+        }
+    }
+
     template <typename Member>
     bool supportsFlag (MUID m, Member member) const
     {
@@ -1199,6 +1251,14 @@ private:
     MUID muid;
     std::vector<std::byte> outgoing;
     std::map<MUID, Discovered> discovered;
+
+    struct CachedSubscription
+    {
+        PropertySubscriptionHeader header;
+        std::optional<std::vector<std::byte>> data;
+    };
+
+    std::map<SubscriptionKey, CachedSubscription> subscriptionCache;
     SubscriptionManager subscriptionManager { *this };
     ListenerList<Listener> listeners;
     ConcreteBufferOutput concreteBufferOutput { *this };
@@ -1258,6 +1318,7 @@ SubscriptionKey Device::beginSubscription (MUID m, const PropertySubscriptionHea
 void Device::endSubscription (SubscriptionKey key) { pimpl->endSubscription (key); }
 std::vector<SubscriptionKey> Device::getOngoingSubscriptions() const { return pimpl->getOngoingSubscriptions(); }
 std::optional<String> Device::getSubscribeIdForKey (SubscriptionKey key) const { return pimpl->getSubscribeIdForKey (key); }
+std::optional<std::vector<std::byte>> Device::getCachedSubscriptionData (SubscriptionKey key) const { return pimpl->getCachedSubscriptionData (key); }
 std::optional<String> Device::getResourceForKey (SubscriptionKey key) const { return pimpl->getResourceForKey (key); }
 bool Device::sendPendingMessages() { return pimpl->sendPendingMessages(); }
 
@@ -2780,6 +2841,116 @@ public:
                 }
             }
 
+            beginTest ("Subscribed resource data is cached");
+            {
+                PropertySubscriptionHeader header;
+                header.command = PropertySubscriptionCommand::start;
+                header.resource = "X-CustomProp";
+
+                const auto a = device.beginSubscription (inquiryMUID, header);
+
+                device.processMessage ({ 0, getMessageBytes ({ ChannelInGroup::wholeBlock,
+                                                               detail::MessageMeta::Meta<Message::PropertySubscribeResponse>::subID2,
+                                                               detail::MessageMeta::implementationVersion,
+                                                               inquiryMUID,
+                                                               device.getMuid() },
+                                                             Message::PropertySubscribeResponse { { device.getIdForRequestKey (device.getOngoingRequests().back())->asByte(),
+                                                                                                    startResponseHeader,
+                                                                                                    1,
+                                                                                                    1,
+                                                                                                    {} } }) });
+
+                expect (device.getSubscribeIdForKey (a) == "newId");
+                expect (! device.getCachedSubscriptionData (a).has_value());
+
+                const auto makeUpdateHeader = [] (const char* command)
+                {
+                    auto ptr = std::make_unique<DynamicObject>();
+                    ptr->setProperty ("command", command);
+                    ptr->setProperty ("subscribeId", "newId");
+                    ptr->setProperty ("mutualEncoding", "Mcoded7");
+                    return Encodings::jsonTo7BitText (ptr.release());
+                };
+
+                const auto sendUpdate = [&] (const char* command, Span<const std::byte> body)
+                {
+                    // Split the body into two chunks, the first of which doesn't hold a whole number of Mcoded7 groups
+                    const auto updateHeader = makeUpdateHeader (command);
+                    const auto encoded = Encodings::toMcoded7 (body);
+                    const auto split = std::min ((size_t) 13, encoded.size());
+
+                    device.processMessage ({ 0, getMessageBytes ({ ChannelInGroup::wholeBlock,
+                                                                   detail::MessageMeta::Meta<Message::PropertySubscribe>::subID2,
+                                                                   detail::MessageMeta::implementationVersion,
+                                                                   inquiryMUID,
+                                                                   device.getMuid() },
+                                                                 Message::PropertySubscribe { { std::byte { 0x42 }, updateHeader, 2, 1, Span (encoded.data(), split) } }) });
+                    device.processMessage ({ 0, getMessageBytes ({ ChannelInGroup::wholeBlock,
+                                                                   detail::MessageMeta::Meta<Message::PropertySubscribe>::subID2,
+                                                                   detail::MessageMeta::implementationVersion,
+                                                                   inquiryMUID,
+                                                                   device.getMuid() },
+                                                                 Message::PropertySubscribe { { std::byte { 0x42 }, {}, 2, 2, Span (encoded.data() + split, encoded.size() - split) } }) });
+                };
+
+                const auto fullBody = makeByteArray (0x81, 0x02, 0x83, 0x04, 0x85, 0x06, 0x87, 0x08, 0x89, 0x0a, 0x8b, 0x0c, 0x8d, 0x0e, 0x8f);
+                sendUpdate ("full", fullBody);
+
+                {
+                    const auto cached = device.getCachedSubscriptionData (a);
+                    expect (cached.has_value() && std::equal (cached->begin(), cached->end(), fullBody.begin(), fullBody.end()));
+                }
+
+                // We can't apply partial updates, so the cached copy is no longer up-to-date
+                sendUpdate ("partial", makeByteArray (0x7b, 0x7d));
+                expect (! device.getCachedSubscriptionData (a).has_value());
+
+                // Getting the subscribed resource refreshes the cached copy
+                PropertyRequestHeader requestHeader;
+                requestHeader.resource = "X-CustomProp";
+                const auto request = device.sendPropertyGetInquiry (inquiryMUID, requestHeader, [] (const PropertyExchangeResult&) {});
+                expect (request.has_value());
+
+                const auto replyHeader = []
+                {
+                    auto ptr = std::make_unique<DynamicObject>();
+                    ptr->setProperty ("status", 200);
+                    return Encodings::jsonTo7BitText (ptr.release());
+                }();
+                const auto replyBody = makeByteArray (0x7b, 0x22, 0x78, 0x22, 0x3a, 0x31, 0x7d);
+
+                device.processMessage ({ 0, getMessageBytes ({ ChannelInGroup::wholeBlock,
+                                                               detail::MessageMeta::Meta<Message::PropertyGetDataResponse>::subID2,
+                                                               detail::MessageMeta::implementationVersion,
+                                                               inquiryMUID,
+                                                               device.getMuid() },
+                                                             Message::PropertyGetDataResponse { { device.getIdForRequestKey (*request)->asByte(), replyHeader, 1, 1, replyBody } }) });
+
+                {
+                    const auto cached = device.getCachedSubscriptionData (a);
+                    expect (cached.has_value() && std::equal (cached->begin(), cached->end(), replyBody.begin(), replyBody.end()));
+                }
+
+                device.endSubscription (a);
+                expect (! device.getCachedSubscriptionData (a).has_value());
+
+                device.sendPendingMessages();
+                device.processMessage ({ 0, getMessageBytes ({ ChannelInGroup::wholeBlock,
+                                                               detail::MessageMeta::Meta<Message::PropertySubscribeResponse>::subID2,
+                                                               detail::MessageMeta::implementationVersion,
+                                                               inquiryMUID,
+                                                               device.getMuid() },
+                                                             Message::PropertySubscribeResponse { { device.getIdForRequestKey (device.getOngoingRequests().back())->asByte(),
+                                                                                                    replyHeader,
+                                                                                                    1,
+                                                                                                    1,
+                                                                                                    {} } }) });
+
+                expect (device.getOngoingRequests().empty());
+                expect (device.getOngoingSubscriptions().empty());
+                output.messages.clear();
+            }
+
             beginTest ("Invalidating a MUID clears subscriptions to that MUID");
             {
                 PropertySubscriptionHeader header;
@@ -2878,6 +3049,13 @@ private:
         detail::Marshalling::Writer { bytes } (header, body);
         return bytes;
     }
+
+    template <typename... Ts>
+    static std::array<std::byte, sizeof... (Ts)> makeByteArray (Ts&&... ts)
+    {
+        jassert (((0 <= (int) ts && (int) ts <= std::numeric_limits<uint8_t>::max()) && ...));
+        return { std::byte (ts)... };
+    }
 };
 
 static DeviceTests deviceTests;
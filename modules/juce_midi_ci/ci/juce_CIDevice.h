@@ -202,6 +202,17 @@ public:
     */
     std::optional<String> getSubscribeIdForKey (SubscriptionKey key) const;
 
+    /** Returns the most recent copy of the subscribed resource that this device has received,
+        or nullopt if there isn't an up-to-date copy.
+
+        The copy is updated whenever the remote device sends a full update for the subscription,
+        or replies to a non-paginated sendPropertyGetInquiry() for the same resource, resId and
+        mediaType. Partial updates and notifications invalidate the copy, as does ending the
+        subscription. Check this before requesting the resource again, to avoid transferring
+        data that is already available.
+    */
+    std::optional<std::vector<std::byte>> getCachedSubscriptionData (SubscriptionKey key) const;
+
     /** If the provided subscription has not been cancelled, this returns the name of the
         subscribed resource.
     */
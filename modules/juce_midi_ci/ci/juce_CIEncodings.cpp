@@ -142,7 +142,7 @@ std::vector<std::byte> Encodings::stringTo7BitText (const String& text)
 std::vector<std::byte> Encodings::toMcoded7 (Span<const std::byte> bytes)
 {
     std::vector<std::byte> result;
-    result.reserve ((bytes.size() * 8) + 6 / 7);
+    result.reserve ((bytes.size() * 8 + 6) / 7);
 
     for (size_t index = 0; index < bytes.size(); index += 7)
     {
@@ -169,20 +169,74 @@ std::vector<std::byte> Encodings::toMcoded7 (Span<const std::byte> bytes)
 std::vector<std::byte> Encodings::fromMcoded7 (Span<const std::byte> bytes)
 {
     std::vector<std::byte> result;
-    result.reserve ((bytes.size() * 7) + 7 / 8);
+    appendFromMcoded7 (bytes, result);
+    return result;
+}
 
-    for (size_t index = 0; index < bytes.size(); index += 8)
+void Encodings::appendFromMcoded7 (Span<const std::byte> bytes, std::vector<std::byte>& result)
+{
+    const auto numGroups = bytes.size() / 8;
+    const auto remainder = bytes.size() % 8;
+    const auto oldSize = result.size();
+    result.resize (oldSize + numGroups * 7 + (remainder != 0 ? remainder - 1 : 0));
+
+    const auto* in = reinterpret_cast<const uint8*> (bytes.data());
+    auto* out = reinterpret_cast<uint8*> (result.data() + oldSize);
+
+    // Decodes a whole group at a time: the header byte is broadcast to every lane, each lane
+    // picks out its own sign bit, and adding 0x7f carries that bit up into the lane's msb.
+    constexpr uint64 laneOnes  = 0x0001010101010101;
+    constexpr uint64 laneBits  = 0x0001020408102040;
+    constexpr uint64 laneMask7 = 0x007f7f7f7f7f7f7f;
+    constexpr uint64 laneMsbs  = 0x0080808080808080;
+
+    for (size_t group = 0; group < numGroups; ++group, in += 8, out += 7)
     {
-        const auto sliceSize = std::min ((size_t) 7, bytes.size() - index - 1);
+        const auto word = ByteOrder::littleEndianInt64 (in);
+        const auto header = word & 0xff;
+        const auto data = word >> 8;
+        const auto highBits = (((header * laneOnes) & laneBits) + laneMask7) & laneMsbs;
+        const auto decoded = ByteOrder::swapIfBigEndian (data | highBits);
+        std::memcpy (out, &decoded, 7);
+    }
+
+    if (remainder > 1)
+    {
+        const auto header = in[0];
+
+        for (size_t i = 0; i < remainder - 1; ++i)
+            out[i] = (uint8) (((header << (i + 1)) & 0x80) | in[i + 1]);
+    }
+}
+
+std::vector<std::byte> Encodings::fromZlib (Span<const std::byte> bytes)
+{
+    MemoryInputStream memoryStream (bytes.data(), bytes.size(), false);
+
+    GZIPDecompressorInputStream zipStream (memoryStream);
+
+    const size_t chunkSize = 1 << 8;
 
-        for (size_t i = 0; i < sliceSize; ++i)
+    std::vector<std::byte> result;
+
+    for (;;)
+    {
+        const auto previousSize = result.size();
+        result.resize (previousSize + chunkSize);
+        const auto read = zipStream.read (result.data() + previousSize, chunkSize);
+
+        if (read < 0)
         {
-            const auto highBit = (bytes[index] & std::byte { (uint8_t) (1 << (6 - i)) }) << (i + 1);
-            result.push_back (highBit | bytes[index + 1 + i]);
+            // Decompression failed!
+            jassertfalse;
+            return {};
         }
-    }
 
-    return result;
+        result.resize ((size_t) read + previousSize);
+
+        if (read == 0)
+            return result;
+    }
 }
 
 std::optional<std::vector<std::byte>> Encodings::tryEncode (Span<const std::byte> bytes, Encoding mutualEncoding)
@@ -227,35 +281,7 @@ std::vector<std::byte> Encodings::decode (Span<const std::byte> bytes, Encoding
         return fromMcoded7 (bytes);
 
     if (mutualEncoding == Encoding::zlibAndMcoded7)
-    {
-        const auto mcoded = fromMcoded7 (bytes);
-        MemoryInputStream memoryStream (mcoded.data(), mcoded.size(), false);
-
-        GZIPDecompressorInputStream zipStream (memoryStream);
-
-        const size_t chunkSize = 1 << 8;
-
-        std::vector<std::byte> result;
-
-        for (;;)
-        {
-            const auto previousSize = result.size();
-            result.resize (previousSize + chunkSize);
-            const auto read = zipStream.read (result.data() + previousSize, chunkSize);
-
-            if (read < 0)
-            {
-                // Decompression failed!
-                jassertfalse;
-                return {};
-            }
-
-            result.resize ((size_t) read + previousSize);
-
-            if (read == 0)
-                return result;
-        }
-    }
+        return fromZlib (fromMcoded7 (bytes));
 
     // Unknown encoding!
     jassertfalse;
@@ -346,6 +372,37 @@ public:
                 expect (rangesEqual (converted, expected));
             }
         }
+
+        beginTest ("Mcoded7 round trip");
+        {
+            Random random { 1 };
+
+            for (auto size = 0; size < 100; ++size)
+            {
+                std::vector<std::byte> input ((size_t) size);
+                std::generate (input.begin(), input.end(), [&] { return (std::byte) random.nextInt (256); });
+
+                const auto encoded = Encodings::toMcoded7 (input);
+                expect (encoded.size() == (size_t) (size + (size + 6) / 7));
+                expect (std::none_of (encoded.begin(), encoded.end(), [] (auto b) { return (b & std::byte { 0x80 }) != std::byte{}; }));
+                expect (rangesEqual (Encodings::fromMcoded7 (encoded), input));
+            }
+        }
+
+        beginTest ("Mcoded7 decoding may be split across whole groups");
+        {
+            Random random { 2 };
+            std::vector<std::byte> input (1000);
+            std::generate (input.begin(), input.end(), [&] { return (std::byte) random.nextInt (256); });
+
+            const auto encoded = Encodings::toMcoded7 (input);
+            std::vector<std::byte> decoded;
+
+            for (size_t index = 0; index < encoded.size(); index += 64)
+                Encodings::appendFromMcoded7 (Span (encoded.data() + index, std::min ((size_t) 64, encoded.size() - index)), decoded);
+
+            expect (rangesEqual (decoded, input));
+        }
     }
 
 private:
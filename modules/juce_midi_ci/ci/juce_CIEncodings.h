@@ -66,6 +66,18 @@ struct Encodings
     */
     static std::vector<std::byte> fromMcoded7 (Span<const std::byte> bytes);
 
+    /** Decodes Mcoded7 data, appending the result to an existing vector.
+
+        This allows a long message to be decoded piece by piece as it arrives, as long as
+        each piece apart from the last contains a whole number of eight-byte groups.
+    */
+    static void appendFromMcoded7 (Span<const std::byte> bytes, std::vector<std::byte>& result);
+
+    /** Decompresses zlib-compressed data that has already been decoded from Mcoded7.
+        Returns an empty vector if decompression fails.
+    */
+    static std::vector<std::byte> fromZlib (Span<const std::byte> bytes);
+
     /** Attempts to encode the provided byte span using the specified encoding.
 
         The ASCII encoding does not make any changes to the input stream, but
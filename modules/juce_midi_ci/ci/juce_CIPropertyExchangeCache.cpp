@@ -53,32 +53,48 @@ public:
     {
         jassert (chunk.thisChunkNum == lastChunk + 1 || chunk.thisChunkNum == 0);
         lastChunk = chunk.thisChunkNum;
-        headerStorage.reserve (headerStorage.size() + chunk.header.size());
-        std::transform (chunk.header.begin(),
-                        chunk.header.end(),
-                        std::back_inserter (headerStorage),
-                        [] (std::byte b) { return char (b); });
-        bodyStorage.insert (bodyStorage.end(), chunk.data.begin(), chunk.data.end());
+
+        if (! chunk.header.empty() && ! parsedHeader.has_value())
+        {
+            headerStorage.reserve (headerStorage.size() + chunk.header.size());
+            std::transform (chunk.header.begin(),
+                            chunk.header.end(),
+                            std::back_inserter (headerStorage),
+                            [] (std::byte b) { return char (b); });
+
+            // The header normally arrives in full with the first chunk, so it only needs to be
+            // parsed once. Knowing the encoding up-front lets us decode each chunk as it arrives.
+            var parsed;
+
+            if (JSON::parse (String (headerStorage.data(), headerStorage.size()), parsed).wasOk() && parsed.isObject())
+                parsedHeader = parsed;
+        }
+
+        pendingBody.insert (pendingBody.end(), chunk.data.begin(), chunk.data.end());
+        decodePendingBody (false);
 
         if (chunk.thisChunkNum != 0 && chunk.thisChunkNum != chunk.totalNumChunks)
             return {};
 
-        const auto headerJson = JSON::parse (String (headerStorage.data(), headerStorage.size()));
+        if (! parsedHeader.has_value())
+            parsedHeader = JSON::parse (String (headerStorage.data(), headerStorage.size()));
 
         terminate();
-        const auto encodingString = headerJson.getProperty ("mutualEncoding", "ASCII").toString();
 
         if (chunk.thisChunkNum != chunk.totalNumChunks)
             return std::optional<OwningResult> { std::in_place, PropertyExchangeResult::Error::partial };
 
-        const int status = headerJson.getProperty ("status", 200);
+        const int status = parsedHeader->getProperty ("status", 200);
 
         if (status == 343)
             return std::optional<OwningResult> { std::in_place, PropertyExchangeResult::Error::tooManyTransactions };
 
-        return std::optional<OwningResult> { std::in_place,
-                                             headerJson,
-                                             Encodings::decode (bodyStorage, EncodingUtils::toEncoding (encodingString.toRawUTF8()).value_or (Encoding::ascii)) };
+        decodePendingBody (true);
+
+        if (getEncoding() == Encoding::zlibAndMcoded7)
+            bodyStorage = Encodings::fromZlib (bodyStorage);
+
+        return std::optional<OwningResult> { std::in_place, *parsedHeader, std::move (bodyStorage) };
     }
 
     std::optional<OwningResult> notify (Span<const std::byte> header)
@@ -103,8 +119,38 @@ public:
     }
 
 private:
+    Encoding getEncoding() const
+    {
+        const auto encodingString = parsedHeader->getProperty ("mutualEncoding", "ASCII").toString();
+        return EncodingUtils::toEncoding (encodingString.toRawUTF8()).value_or (Encoding::ascii);
+    }
+
+    /*  Moves as much of the pending body as possible into the decoded body storage.
+        Mcoded7 data is decoded a whole number of groups at a time, unless this is the final
+        chunk. Nothing can be decoded until the header has told us which encoding is in use.
+    */
+    void decodePendingBody (bool isFinalChunk)
+    {
+        if (! parsedHeader.has_value() || pendingBody.empty())
+            return;
+
+        if (getEncoding() == Encoding::ascii)
+        {
+            // All values must be 7-bit!
+            jassert (std::none_of (pendingBody.begin(), pendingBody.end(), [] (const auto& b) { return (b & std::byte { 0x80 }) != std::byte{}; }));
+            bodyStorage.insert (bodyStorage.end(), pendingBody.begin(), pendingBody.end());
+            pendingBody.clear();
+            return;
+        }
+
+        const auto numToDecode = isFinalChunk ? pendingBody.size() : pendingBody.size() - (pendingBody.size() % 8);
+        Encodings::appendFromMcoded7 (Span (pendingBody.data(), numToDecode), bodyStorage);
+        pendingBody.erase (pendingBody.begin(), pendingBody.begin() + (ptrdiff_t) numToDecode);
+    }
+
     std::vector<char> headerStorage;
-    std::vector<std::byte> bodyStorage;
+    std::optional<var> parsedHeader;
+    std::vector<std::byte> pendingBody, bodyStorage;
     uint16_t lastChunk = 0;
     bool ongoing = true;
 };
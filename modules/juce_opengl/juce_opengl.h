@@ -70,6 +70,17 @@
 
 #include <juce_gui_extra/juce_gui_extra.h>
 
+//==============================================================================
+/** Config: JUCE_OPENGL_RENDER_LINUX_WINDOWS
+
+    On Linux, enabling this makes opaque, non-temporary windows use the "OpenGL Renderer"
+    engine by default instead of the software renderer. Either way, the engine can be
+    chosen per-window with ComponentPeer::setCurrentRenderingEngine().
+*/
+#ifndef JUCE_OPENGL_RENDER_LINUX_WINDOWS
+ #define JUCE_OPENGL_RENDER_LINUX_WINDOWS 0
+#endif
+
 //==============================================================================
 #if JUCE_OPENGL_ES || DOXYGEN
  /** This macro is a helper for use in GLSL shader code which needs to compile on both GLES and desktop GL.
@@ -454,4 +454,26 @@ bool OpenGLHelpers::isContextActive()
     return glXGetCurrentContext() != nullptr;
 }
 
+//==============================================================================
+extern std::shared_ptr<void> (*createLinuxOpenGLPeerRenderer) (Component&); // declared in juce_gui_basics
+extern bool linuxOpenGLPeerRendererIsDefault;
+
+static std::shared_ptr<void> createOpenGLPeerRenderer (Component& c)
+{
+    // The context's cached image only repaints the regions that the component has
+    // invalidated, and draws them using the batched OpenGL graphics context.
+    auto context = std::make_shared<OpenGLContext>();
+    context->setComponentPaintingEnabled (true);
+    context->setContinuousRepainting (false);
+    context->attachTo (c);
+    return context;
+}
+
+static const bool openGLPeerRendererRegistered = []
+{
+    createLinuxOpenGLPeerRenderer = createOpenGLPeerRenderer;
+    linuxOpenGLPeerRendererIsDefault = JUCE_OPENGL_RENDER_LINUX_WINDOWS != 0;
+    return true;
+}();
+
 } // namespace juce
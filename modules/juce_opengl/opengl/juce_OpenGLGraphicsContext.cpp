@@ -45,7 +45,7 @@ struct CachedImageList final : public ReferenceCountedObject,
                                private ImagePixelData::Listener
 {
     CachedImageList (OpenGLContext& c) noexcept
-        : context (c), maxCacheSize (c.getImageCacheSize()) {}
+        : context (c) {}
 
     static CachedImageList* get (OpenGLContext& c)
     {
@@ -83,7 +83,7 @@ struct CachedImageList final : public ReferenceCountedObject,
             c = images.add (new CachedImage (*this, pixelData));
             totalSize += c->imageSize;
 
-            while (totalSize > maxCacheSize && images.size() > 1 && totalSize > 0)
+            while (totalSize > context.getImageCacheSize() && images.size() > 1 && totalSize > 0)
                 removeOldestItem();
         }
 
@@ -95,7 +95,7 @@ struct CachedImageList final : public ReferenceCountedObject,
         CachedImage (CachedImageList& list, ImagePixelData* im)
             : owner (list), pixelData (im),
               lastUsed (Time::getCurrentTime()),
-              imageSize ((size_t) (im->width * im->height))
+              imageSize ((size_t) im->width * (size_t) im->height * sizeof (PixelARGB))
         {
             pixelData->listeners.add (&owner);
         }
@@ -116,8 +116,16 @@ struct CachedImageList final : public ReferenceCountedObject,
             if (textureNeedsReloading)
             {
                 textureNeedsReloading = false;
+                dirtyArea = {};
                 texture.loadImage (Image (*pixelData));
             }
+            else if (! dirtyArea.isEmpty())
+            {
+                // only the parts that have been written to since the last upload are sent again,
+                // so an image that's partly redrawn on each frame doesn't cost a full upload
+                texture.updateImageArea (Image (*pixelData), dirtyArea);
+                dirtyArea = {};
+            }
 
             t.textureID = texture.getTextureID();
             t.imageWidth = pixelData->width;
@@ -134,6 +142,7 @@ struct CachedImageList final : public ReferenceCountedObject,
         OpenGLTexture texture;
         Time lastUsed;
         const size_t imageSize;
+        Rectangle<int> dirtyArea;
         bool textureNeedsReloading = true;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedImage)
@@ -145,7 +154,6 @@ private:
     OpenGLContext& context;
     OwnedArray<CachedImage> images;
     size_t totalSize = 0;
-    const size_t maxCacheSize;
 
     bool canUseContext() const noexcept
     {
@@ -158,6 +166,13 @@ private:
             c->textureNeedsReloading = true;
     }
 
+    void imageAreaChanged (ImagePixelData* im, Rectangle<int> area) override
+    {
+        if (auto* c = findCachedImage (im))
+            if (! c->textureNeedsReloading)
+                c->dirtyArea = c->dirtyArea.isEmpty() ? area : c->dirtyArea.getUnion (area);
+    }
+
     void imageDataBeingDeleted (ImagePixelData* im) override
     {
         for (int i = images.size(); --i >= 0;)
@@ -1298,10 +1313,10 @@ struct StateHelpers
             }
 
             savedElementArrayBuffer.bind();
-            context.extensions.glBufferData (GL_ELEMENT_ARRAY_BUFFER, sizeof (indexData), indexData, GL_STATIC_DRAW);
+            context.extensions.glBufferData (GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr) ((size_t) numQuads * 6 * sizeof (GLushort)), indexData, GL_STATIC_DRAW);
 
             savedArrayBuffer.bind();
-            context.extensions.glBufferData (GL_ARRAY_BUFFER, sizeof (vertexData), vertexData, GL_STREAM_DRAW);
+            context.extensions.glBufferData (GL_ARRAY_BUFFER, sizeof (vertexData), nullptr, GL_STREAM_DRAW);
             JUCE_CHECK_OPENGL_ERROR
         }
 
@@ -1382,7 +1397,9 @@ struct StateHelpers
             GLuint colour;
         };
 
-        enum { maxNumQuads = 256 };
+        // Each line of an edge table becomes at least one quad, so text and paths need a lot of them.
+        // The limit keeps every vertex index within the range of a GLushort.
+        enum { maxNumQuads = 4096 };
 
         SavedBinding<TraitsArrayBuffer> savedArrayBuffer;
         SavedBinding<TraitsElementArrayBuffer> savedElementArrayBuffer;
@@ -1399,6 +1416,9 @@ struct StateHelpers
 
         void draw() noexcept
         {
+            // Re-specifying the buffer's storage before filling it lets the driver hand us a fresh block
+            // of memory, rather than stalling until the previous batch has finished reading from it
+            context.extensions.glBufferData (GL_ARRAY_BUFFER, sizeof (vertexData), nullptr, GL_STREAM_DRAW);
             context.extensions.glBufferSubData (GL_ARRAY_BUFFER, 0, (GLsizeiptr) ((size_t) numVertices * sizeof (VertexInfo)), vertexData);
             // NB: If you get a random crash in here and are running in a Parallels VM, it seems to be a bug in
             // their driver.. Can't find a workaround unfortunately.
@@ -1527,6 +1547,9 @@ struct GLState
     void setShaderForGradientFill (const ColourGradient& g, const AffineTransform& transform,
                                    int maskTextureID, const Rectangle<int>* maskArea)
     {
+        // Any quads queued by a previous gradient fill must be drawn before its uniforms and texture change
+        shaderQuadQueue.flush();
+
         JUCE_CHECK_OPENGL_ERROR
         activeTextures.disableTextures (shaderQuadQueue);
         blendMode.setPremultipliedBlendingMode (shaderQuadQueue);
@@ -1806,9 +1829,10 @@ struct SavedState final : public RenderingHelpers::SavedStateBase<SavedState>
         state->setShaderForTiledImageFill (state->cachedImageList->getTextureFor (src), trans, 0, nullptr, tiledFill);
 
         state->shaderQuadQueue.add (iter, PixelARGB ((uint8) alpha, (uint8) alpha, (uint8) alpha, (uint8) alpha));
-        state->shaderQuadQueue.flush();
 
-        state->currentShader.clearShader (state->shaderQuadQueue);
+        // The source image's texture may not outlive this call, so the quads have to be drawn now. The
+        // program is left bound though, so that a following image fill doesn't need to set it up again.
+        state->shaderQuadQueue.flush();
     }
 
     template <typename IteratorType>
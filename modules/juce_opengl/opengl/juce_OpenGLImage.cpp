@@ -83,7 +83,7 @@ public:
         }
 
         if (mode != Image::BitmapData::readOnly)
-            sendDataChangeMessage();
+            sendDataChangeMessage ({ x, y, bitmapData.width, bitmapData.height });
     }
 
     OpenGLContext& context;
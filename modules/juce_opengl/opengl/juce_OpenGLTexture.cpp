@@ -141,6 +141,37 @@ void OpenGLTexture::loadImage (const Image& image)
     create (imageW, imageH, dataCopy, JUCE_RGBA_FORMAT, true);
 }
 
+void OpenGLTexture::updateImageArea (const Image& image, Rectangle<int> area)
+{
+    // The texture must already have been created from an image of this size with loadImage()
+    jassert (textureID != 0 && image.getWidth() <= width && image.getHeight() <= height);
+    jassert (ownerContext == OpenGLContext::getCurrentContext());
+
+    area = area.getIntersection (image.getBounds());
+
+    if (area.isEmpty())
+        return;
+
+    HeapBlock<PixelARGB> dataCopy;
+    const Image::BitmapData srcData (image, area.getX(), area.getY(), area.getWidth(), area.getHeight());
+
+    switch (srcData.pixelFormat)
+    {
+        case Image::ARGB:           Flipper<PixelARGB> ::flip (dataCopy, srcData.data, srcData.lineStride, area.getWidth(), area.getHeight()); break;
+        case Image::RGB:            Flipper<PixelRGB>  ::flip (dataCopy, srcData.data, srcData.lineStride, area.getWidth(), area.getHeight()); break;
+        case Image::SingleChannel:  Flipper<PixelAlpha>::flip (dataCopy, srcData.data, srcData.lineStride, area.getWidth(), area.getHeight()); break;
+        case Image::UnknownFormat:
+        default: return;
+    }
+
+    // loadImage() puts the image's top row at the top of the texture, so the rows are flipped
+    glBindTexture (GL_TEXTURE_2D, textureID);
+    glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D (GL_TEXTURE_2D, 0, area.getX(), height - area.getBottom(), area.getWidth(), area.getHeight(),
+                     JUCE_RGBA_FORMAT, GL_UNSIGNED_BYTE, dataCopy);
+    JUCE_CHECK_OPENGL_ERROR
+}
+
 void OpenGLTexture::loadARGB (const PixelARGB* pixels, const int w, const int h)
 {
     create (w, h, pixels, JUCE_RGBA_FORMAT, false);
@@ -48,6 +48,13 @@ public:
     */
     void loadImage (const Image& image);
 
+    /** Re-uploads part of an image to a texture that was created from it with loadImage().
+
+        The image must be the same size as the one that was originally loaded. This is
+        much quicker than calling loadImage() again when only a small area has changed.
+    */
+    void updateImageArea (const Image& image, Rectangle<int> area);
+
     /** Creates a texture from a raw array of pixels.
         If width and height are not powers-of-two, the texture will be created with a
         larger size, and only the subsection (0, 0, width, height) will be initialised.
@@ -40,5 +40,7 @@
 #include "osc/juce_OSCAddress.cpp"
 #include "osc/juce_OSCMessage.cpp"
 #include "osc/juce_OSCBundle.cpp"
+#include "osc/juce_OSCMessageView.cpp"
 #include "osc/juce_OSCReceiver.cpp"
+#include "osc/juce_OSCMessageQueue.cpp"
 #include "osc/juce_OSCSender.cpp"
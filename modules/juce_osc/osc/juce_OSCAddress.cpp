@@ -91,55 +91,44 @@ namespace
         }
 
         //==============================================================================
+        // The sets are matched where they lie in the pattern, so that matching never
+        // needs to allocate any memory.
         static bool matchInsideStringSet (CharPtr pattern, CharPtr patternEnd, CharPtr target, CharPtr targetEnd)
         {
-            if (pattern == patternEnd)
+            auto setEnd = pattern;
+
+            while (setEnd != patternEnd && *setEnd != '}')
+                ++setEnd;
+
+            if (setEnd == patternEnd)
                 return false;
 
-            // Note: In case this code is ever moved into the more generic CharPointerFunctions,
-            // the next two lines probably will not compile as soon as this class is used with a
-            // Char template type parameter that is not the same type as String::Char.
-            StringArray set;
-            String currentElement;
+            const auto rest = setEnd + 1;
 
-            while (pattern != patternEnd)
+            for (auto element = pattern;;)
             {
-                auto c = pattern.getAndAdvance();
+                auto elementEnd = element;
 
-                switch (c)
-                {
-                    case '}':
-                        set.add (currentElement);
-                        currentElement.clear();
-                        return matchStringSet (set, pattern, patternEnd, target, targetEnd);
-
-                    case ',':
-                        set.add (currentElement);
-                        currentElement.clear();
-                        continue;
+                while (elementEnd != setEnd && *elementEnd != ',')
+                    ++elementEnd;
 
-                    default:
-                        currentElement += c;
-                        continue;
-                }
-            }
+                auto e = element;
+                auto t = target;
 
-            return false;
-        }
+                while (e != elementEnd && t != targetEnd && *e == *t)
+                {
+                    ++e;
+                    ++t;
+                }
 
-        //==============================================================================
-        static bool matchStringSet (const StringArray& set, CharPtr pattern,
-                                    CharPtr patternEnd, CharPtr target, CharPtr targetEnd)
-        {
-            if (set.size() == 0)
-                return match (pattern, patternEnd, target, targetEnd);
+                if (e == elementEnd && match (rest, patternEnd, t, targetEnd))
+                    return true;
 
-            for (auto& str : set)
-                if (str.getCharPointer().compareUpTo (target, str.length()) == 0)
-                    if (match (pattern, patternEnd, target + str.length(), targetEnd))
-                        return true;
+                if (elementEnd == setEnd)
+                    return false;
 
-            return false;
+                element = elementEnd + 1;
+            }
         }
 
         //==============================================================================
@@ -149,102 +138,62 @@ namespace
             if (pattern == patternEnd)
                 return false;
 
-            Array<juce_wchar> set;
-            bool setIsNegated = false;
+            auto setStart = pattern;
+            const auto setIsNegated = (*setStart == '!');
 
-            while (pattern != patternEnd)
-            {
-                auto c = pattern.getAndAdvance();
+            if (setIsNegated)
+                ++setStart;
 
-                switch (c)
-                {
-                    case ']':
-                        return matchCharSet (set, setIsNegated, pattern, patternEnd, target, targetEnd);
-
-                    case '-':
-                        if (! addCharRangeToSet (set, pattern, patternEnd, target, targetEnd))
-                            return false;
-
-                        break;
-
-                    case '!':
-                        if (set.size() == 0 && setIsNegated == false)
-                        {
-                            setIsNegated = true;
-                            break;
-                        }
-                        // else = special case: fall through to default and treat '!' as a non-special character.
-                        JUCE_FALLTHROUGH
-
-                    default:
-                        set.add (c);
-                        break;
-                }
-            }
+            auto setEnd = setStart;
 
-            return false;
-        }
+            while (setEnd != patternEnd && *setEnd != ']')
+                ++setEnd;
 
-        //==============================================================================
-        static bool matchCharSet (const Array<juce_wchar>& set, bool setIsNegated,
-                                  CharPtr pattern, CharPtr patternEnd, CharPtr target, CharPtr targetEnd)
-        {
-            if (set.size() == 0)
-                return match (pattern, patternEnd, target, targetEnd);
+            if (setEnd == patternEnd)
+                return false;
+
+            const auto rest = setEnd + 1;
+
+            if (setStart == setEnd)
+                return match (rest, patternEnd, target, targetEnd);
 
             if (target == targetEnd)
                 return false;
 
-            return setIsNegated ? matchCharSetNegated (set, pattern, patternEnd, target, targetEnd)
-                                : matchCharSetNotNegated (set, pattern, patternEnd, target, targetEnd);
-        }
+            const auto c = *target;
+            juce_wchar previous = 0;
+            bool isInSet = false;
 
-        //==============================================================================
-        static bool matchCharSetNegated (const Array<juce_wchar>& set, CharPtr pattern,
-                                         CharPtr patternEnd, CharPtr target, CharPtr targetEnd)
-        {
-            for (auto c : set)
-                if (*target == c)
-                    return false;
-
-            return match (pattern, patternEnd, target + 1, targetEnd);
-        }
+            for (auto p = setStart; p != setEnd; ++p)
+            {
+                if (*p == '-')
+                {
+                    const auto next = p + 1;
 
-        //==============================================================================
-        static bool matchCharSetNotNegated (const Array<juce_wchar>& set, CharPtr pattern,
-                                            CharPtr patternEnd, CharPtr target, CharPtr targetEnd)
-        {
-            for (auto c : set)
-                if (*target == c)
-                    if (match (pattern, patternEnd, target + 1, targetEnd))
-                        return true;
+                    // special case: '-' has no special meaning at the end.
+                    if (next == setEnd)
+                    {
+                        isInSet = isInSet || c == '-';
+                        continue;
+                    }
 
-            return false;
-        }
+                    const auto rangeEnd = *next;
 
-        //==============================================================================
-        static bool addCharRangeToSet (Array<juce_wchar>& set, CharPtr pattern,
-                                       CharPtr /*patternEnd*/, CharPtr target, CharPtr targetEnd)
-        {
-            if (target == targetEnd)
-                return false;
+                    if (rangeEnd == ',' || rangeEnd == '{' || rangeEnd == '}' || p == setStart)
+                        return false;
 
-            auto rangeStart = set.getLast();
-            auto rangeEnd = pattern.getAndAdvance();
+                    isInSet = isInSet || (c > previous && c <= rangeEnd);
+                    continue;
+                }
 
-            if (rangeEnd == ']')
-            {
-                set.add ('-');  // special case: '-' has no special meaning at the end.
-                return true;
+                isInSet = isInSet || *p == c;
+                previous = *p;
             }
 
-            if (rangeEnd == ',' || rangeEnd == '{' || rangeEnd == '}' || set.size() == 0)
+            if (isInSet == setIsNegated)
                 return false;
 
-            while (rangeEnd > rangeStart)
-                set.add (++rangeStart);
-
-            return true;
+            return match (rest, patternEnd, target + 1, targetEnd);
         }
     };
 
@@ -257,6 +206,13 @@ namespace
                                                                       target.getCharPointer().findTerminatingNull());
     }
 
+    static bool matchOscPattern (const char* pattern, const char* patternEnd,
+                                 const char* target, const char* targetEnd)
+    {
+        return OSCPatternMatcherImpl<CharPointer_UTF8>::match (CharPointer_UTF8 (pattern), CharPointer_UTF8 (patternEnd),
+                                                               CharPointer_UTF8 (target), CharPointer_UTF8 (targetEnd));
+    }
+
     //==============================================================================
     template <typename OSCAddressType> struct OSCAddressTokeniserTraits;
     template <> struct OSCAddressTokeniserTraits<OSCAddress>        { static const char* getDisallowedChars() { return " #*,?/[]{}"; } };
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// One more slot than requested is allocated, because the AbstractFifo always
+// keeps one of its slots free.
+OSCMessageQueue::OSCMessageQueue (int maxNumMessages, int maxMessageSizeInBytes)
+    : slotSize ((size_t) jmax (4, maxMessageSizeInBytes)),
+      fifo (jmax (1, maxNumMessages) + 1),
+      storage ((size_t) fifo.getTotalSize() * slotSize),
+      sizes ((size_t) fifo.getTotalSize(), true),
+      timeTags ((size_t) fifo.getTotalSize(), true)
+{
+}
+
+OSCMessageQueue::~OSCMessageQueue() = default;
+
+//==============================================================================
+bool OSCMessageQueue::push (const OSCMessageView& message) noexcept
+{
+    if (message.getRawDataSize() > slotSize)
+    {
+        ++numDropped;
+        return false;
+    }
+
+    const auto scope = fifo.write (1);
+
+    if (scope.blockSize1 + scope.blockSize2 == 0)
+    {
+        ++numDropped;
+        return false;
+    }
+
+    const auto index = (size_t) (scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2);
+
+    std::memcpy (storage + index * slotSize, message.getRawData(), message.getRawDataSize());
+    sizes[index] = message.getRawDataSize();
+    timeTags[index] = message.getTimeTag().getRawTimeTag();
+    return true;
+}
+
+bool OSCMessageQueue::readNext (OSCMessageView& message) noexcept
+{
+    if (isHoldingSlot)
+    {
+        fifo.finishedRead (1);
+        isHoldingSlot = false;
+    }
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0)
+        return false;
+
+    const auto index = (size_t) (size1 > 0 ? start1 : start2);
+    isHoldingSlot = true;
+
+    // the data was already validated before it was pushed, so this can't fail
+    const auto parsed = message.parse (storage + index * slotSize, sizes[index], OSCTimeTag (timeTags[index]));
+    jassertquiet (parsed);
+    return true;
+}
+
+int OSCMessageQueue::getNumReady() const noexcept
+{
+    return fifo.getNumReady() - (isHoldingSlot ? 1 : 0);
+}
+
+void OSCMessageQueue::oscMessageReceived (const OSCMessageView& message)
+{
+    push (message);
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OSCMessageQueueTests final : public UnitTest
+{
+public:
+    OSCMessageQueueTests()
+        : UnitTest ("OSCMessageQueue class", UnitTestCategories::osc)
+    {}
+
+    void runTest() override
+    {
+        uint8 message[] = {
+            '/', 'q', '\0', '\0',
+            ',', 'i', '\0', '\0',
+            0x00, 0x00, 0x00, 0x00
+        };
+
+        auto makeView = [&] (uint8 value)
+        {
+            message[11] = value;
+
+            OSCMessageView view;
+            expect (view.parse (message, sizeof (message), OSCTimeTag (value)));
+            return view;
+        };
+
+        beginTest ("messages are copied and read in order");
+        {
+            OSCMessageQueue queue (4, 64);
+
+            for (uint8 i = 1; i <= 3; ++i)
+                expect (queue.push (makeView (i)));
+
+            expectEquals (queue.getNumReady(), 3);
+
+            OSCMessageView view;
+
+            for (int i = 1; i <= 3; ++i)
+            {
+                expect (queue.readNext (view));
+                expect (view.getRawData() != reinterpret_cast<const char*> (message));
+                expectEquals (view.getInt32 (0), i);
+                expectEquals ((int) view.getTimeTag().getRawTimeTag(), i);
+                expectEquals (queue.getNumReady(), 3 - i);
+            }
+
+            expect (! queue.readNext (view));
+            expectEquals (queue.getNumDropped(), 0);
+        }
+
+        beginTest ("messages are dropped when the queue is full or they're too large");
+        {
+            OSCMessageQueue queue (2, 64);
+
+            expect (queue.push (makeView (1)));
+            expect (queue.push (makeView (2)));
+            expect (! queue.push (makeView (3)));
+            expectEquals (queue.getNumDropped(), 1);
+
+            OSCMessageQueue smallQueue (2, 8);
+            expect (! smallQueue.push (makeView (1)));
+            expectEquals (smallQueue.getNumDropped(), 1);
+        }
+
+        beginTest ("the slot being read isn't overwritten");
+        {
+            OSCMessageQueue queue (1, 64);
+            OSCMessageView view;
+
+            expect (queue.push (makeView (1)));
+            expect (queue.readNext (view));
+            expect (! queue.push (makeView (2)));
+            expectEquals (view.getInt32 (0), 1);
+
+            expect (! queue.readNext (view));
+            expect (queue.push (makeView (3)));
+            expect (queue.readNext (view));
+            expectEquals (view.getInt32 (0), 3);
+        }
+    }
+};
+
+static OSCMessageQueueTests OSCMessageQueueUnitTests;
+
+#endif
+
+} // namespace juce
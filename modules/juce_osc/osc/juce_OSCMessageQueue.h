@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A lock-free, single-producer/single-consumer queue of OSC messages, which
+    passes messages from an OSCReceiver's network thread to another thread
+    (typically an audio thread) without allocating any memory.
+
+    All the storage is allocated up-front by the constructor, as a fixed number of
+    slots of a fixed size. Add the queue to an OSCReceiver as a MessageViewListener
+    and it will copy the raw bytes of each incoming message into the next free
+    slot. On the reading thread, call readNext() to get a view of the oldest
+    message.
+
+    If the queue is full, or a message is too large to fit into a slot, the
+    message is dropped, and the number of dropped messages can be retrieved
+    with getNumDropped().
+
+    @code
+    OSCMessageQueue queue (128, 1024);
+    receiver.addListener (&queue, "/synth/cutoff");
+
+    // on the audio thread:
+    OSCMessageView message;
+
+    while (queue.readNext (message))
+        if (message.size() == 1 && message.getType (0) == OSCTypes::float32)
+            cutoff = message.getFloat32 (0);
+    @endcode
+
+    @see OSCReceiver::MessageViewListener, OSCMessageView
+
+    @tags{OSC}
+*/
+class JUCE_API  OSCMessageQueue  : public OSCReceiver::MessageViewListener
+{
+public:
+    //==============================================================================
+    /** Creates a queue that can hold a number of messages of up to a given size. */
+    OSCMessageQueue (int maxNumMessages, int maxMessageSizeInBytes);
+
+    /** Destructor. */
+    ~OSCMessageQueue() override;
+
+    //==============================================================================
+    /** Copies a message into the queue.
+        This must only be called from a single thread at a time.
+        @returns false if the message had to be dropped.
+    */
+    bool push (const OSCMessageView& message) noexcept;
+
+    /** Makes a view refer to the oldest message in the queue, and removes it.
+
+        The view will remain valid until the next call to readNext(). This must
+        only be called from a single thread at a time.
+
+        @returns false if the queue was empty.
+    */
+    bool readNext (OSCMessageView& message) noexcept;
+
+    /** Returns the number of messages waiting to be read.
+        This should be called on the reading thread.
+    */
+    int getNumReady() const noexcept;
+
+    /** Returns the number of messages that have been dropped so far because the queue
+        was full or the message was larger than maxMessageSizeInBytes.
+    */
+    int getNumDropped() const noexcept              { return numDropped.load(); }
+
+    //==============================================================================
+    /** @internal */
+    void oscMessageReceived (const OSCMessageView&) override;
+
+private:
+    //==============================================================================
+    const size_t slotSize;
+    AbstractFifo fifo;
+    HeapBlock<char> storage;
+    HeapBlock<size_t> sizes;
+    HeapBlock<uint64> timeTags;
+    bool isHoldingSlot = false;
+    std::atomic<int> numDropped { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OSCMessageQueue)
+};
+
+} // namespace juce
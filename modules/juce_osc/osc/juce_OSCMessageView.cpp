@@ -0,0 +1,447 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace
+{
+    //==============================================================================
+    // A tiny cursor over a block of OSC data, which follows the same rules as the
+    // OSCInputStream used by OSCReceiver, but reports errors by returning false
+    // rather than by throwing, so that it can be used on realtime threads.
+    struct OSCViewReader
+    {
+        const char* data;
+        size_t size;
+        size_t pos = 0;
+
+        size_t getNumBytesRemaining() const noexcept    { return size - pos; }
+
+        bool read32 (uint32& result) noexcept
+        {
+            if (getNumBytesRemaining() < 4)
+                return false;
+
+            result = ByteOrder::bigEndianInt (data + pos);
+            pos += 4;
+            return true;
+        }
+
+        bool read64 (uint64& result) noexcept
+        {
+            if (getNumBytesRemaining() < 8)
+                return false;
+
+            result = ByteOrder::bigEndianInt64 (data + pos);
+            pos += 8;
+            return true;
+        }
+
+        bool skipPaddingZeros (size_t bytesRead) noexcept
+        {
+            for (auto numZeros = ~(bytesRead - 1) & 0x03; numZeros > 0; --numZeros)
+            {
+                if (pos >= size || data[pos] != 0)
+                    return false;
+
+                ++pos;
+            }
+
+            return true;
+        }
+
+        bool skipString() noexcept
+        {
+            if (getNumBytesRemaining() < 4)
+                return false;
+
+            auto* start = data + pos;
+            auto* terminator = static_cast<const char*> (std::memchr (start, 0, getNumBytesRemaining()));
+
+            if (terminator == nullptr)
+                return false;
+
+            auto bytesRead = (size_t) (terminator - start) + 1;
+            pos += bytesRead;
+            return skipPaddingZeros (bytesRead);
+        }
+
+        bool skipBlob() noexcept
+        {
+            uint32 blobSize = 0;
+
+            if (! read32 (blobSize) || (int32) blobSize < 0 || getNumBytesRemaining() < blobSize)
+                return false;
+
+            pos += blobSize;
+            return skipPaddingZeros (blobSize);
+        }
+    };
+
+    static bool isValidOSCAddressPattern (const char* address) noexcept
+    {
+        if (*address != '/')
+            return false;
+
+        for (auto* c = address; *c != 0; ++c)
+            if (*c < ' ' || *c > '~' || *c == ' ' || *c == '#')
+                return false;
+
+        return true;
+    }
+}
+
+//==============================================================================
+bool OSCMessageView::parse (const void* sourceData, size_t sourceDataSize, OSCTimeTag timeTagToUse) noexcept
+{
+    clear();
+
+    OSCViewReader reader { static_cast<const char*> (sourceData), sourceDataSize };
+
+    if (! reader.skipString() || ! isValidOSCAddressPattern (reader.data))
+        return false;
+
+    auto* types = reader.data + reader.pos;
+
+    if (reader.getNumBytesRemaining() < 4 || *types != ',' || ! reader.skipString())
+        return false;
+
+    int count = 0;
+
+    for (auto* type = types + 1; *type != 0; ++type)
+    {
+        if (count == maxNumArguments)
+            return false;
+
+        argumentOffsets[count++] = (uint32) reader.pos;
+
+        switch (*type)
+        {
+            case OSCTypes::int32:
+            case OSCTypes::float32:
+            case OSCTypes::colour:
+            {
+                uint32 ignored = 0;
+
+                if (! reader.read32 (ignored))
+                    return false;
+
+                break;
+            }
+
+            case OSCTypes::string:
+                if (! reader.skipString())
+                    return false;
+
+                break;
+
+            case OSCTypes::blob:
+                if (! reader.skipBlob())
+                    return false;
+
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    if (reader.getNumBytesRemaining() != 0)
+        return false;
+
+    data = reader.data;
+    dataSize = reader.size;
+    typeTags = types + 1;
+    numArguments = count;
+    timeTag = timeTagToUse;
+    return true;
+}
+
+void OSCMessageView::clear() noexcept
+{
+    data = nullptr;
+    dataSize = 0;
+    typeTags = nullptr;
+    numArguments = 0;
+    timeTag = OSCTimeTag::immediately;
+}
+
+//==============================================================================
+OSCType OSCMessageView::getType (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numArguments));
+    return typeTags[index];
+}
+
+int32 OSCMessageView::getInt32 (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::int32);
+    return (int32) ByteOrder::bigEndianInt (data + argumentOffsets[index]);
+}
+
+float OSCMessageView::getFloat32 (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::float32);
+
+    union { uint32 asInt; float asFloat; } n;
+    n.asInt = ByteOrder::bigEndianInt (data + argumentOffsets[index]);
+    return n.asFloat;
+}
+
+StringRef OSCMessageView::getString (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::string);
+    return StringRef (data + argumentOffsets[index]);
+}
+
+const void* OSCMessageView::getBlobData (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::blob);
+    return data + argumentOffsets[index] + 4;
+}
+
+size_t OSCMessageView::getBlobSize (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::blob);
+    return (size_t) ByteOrder::bigEndianInt (data + argumentOffsets[index]);
+}
+
+OSCColour OSCMessageView::getColour (int index) const noexcept
+{
+    jassert (getType (index) == OSCTypes::colour);
+    return OSCColour::fromInt32 (ByteOrder::bigEndianInt (data + argumentOffsets[index]));
+}
+
+//==============================================================================
+OSCMessage OSCMessageView::toMessage() const
+{
+    jassert (isValid());
+
+    OSCMessage message { OSCAddressPattern (String (CharPointer_UTF8 (data))) };
+
+    for (int i = 0; i < numArguments; ++i)
+    {
+        switch (getType (i))
+        {
+            case OSCTypes::int32:       message.addInt32 (getInt32 (i)); break;
+            case OSCTypes::float32:     message.addFloat32 (getFloat32 (i)); break;
+            case OSCTypes::string:      message.addString (String::fromUTF8 (getString (i).text)); break;
+            case OSCTypes::blob:        message.addBlob (MemoryBlock (getBlobData (i), getBlobSize (i))); break;
+            case OSCTypes::colour:      message.addColour (getColour (i)); break;
+            default:                    jassertfalse; break;
+        }
+    }
+
+    return message;
+}
+
+//==============================================================================
+bool OSCMessageView::walkPacket (const void* packetData, size_t packetSize, Visitor visitor, void* context) noexcept
+{
+    return walkElement (static_cast<const char*> (packetData), packetSize, OSCTimeTag::immediately, visitor, context);
+}
+
+bool OSCMessageView::walkElement (const char* elementData, size_t elementSize, OSCTimeTag bundleTimeTag,
+                                  Visitor visitor, void* context) noexcept
+{
+    if (elementSize < 4)
+        return false;
+
+    if (elementData[0] == '/')
+    {
+        OSCMessageView view;
+
+        if (! view.parse (elementData, elementSize, bundleTimeTag))
+            return false;
+
+        if (visitor != nullptr)
+            visitor (context, view);
+
+        return true;
+    }
+
+    if (elementData[0] != '#')
+        return false;
+
+    OSCViewReader reader { elementData, elementSize };
+    uint64 rawTimeTag = 0;
+
+    if (elementSize < 16 || std::memcmp (elementData, "#bundle", 8) != 0)
+        return false;
+
+    reader.pos = 8;
+
+    if (! reader.read64 (rawTimeTag))
+        return false;
+
+    while (reader.getNumBytesRemaining() > 0)
+    {
+        uint32 size = 0;
+
+        if (! reader.read32 (size) || size < 4 || size > reader.getNumBytesRemaining())
+            return false;
+
+        if (! walkElement (elementData + reader.pos, size, OSCTimeTag (rawTimeTag), visitor, context))
+            return false;
+
+        reader.pos += size;
+    }
+
+    return true;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OSCMessageViewTests final : public UnitTest
+{
+public:
+    OSCMessageViewTests()
+        : UnitTest ("OSCMessageView class", UnitTestCategories::osc)
+    {}
+
+    void runTest() override
+    {
+        const uint8 message[] = {
+            '/', 't', 'e', 's', 't', '\0', '\0', '\0',
+            ',', 'i', 'f', 's', 'b', 'r', '\0', '\0',
+            0xff, 0xff, 0xff, 0xfe,                         // int32 -2
+            0x3f, 0xc0, 0x00, 0x00,                         // float32 1.5
+            'h', 'e', 'l', 'l', 'o', '\0', '\0', '\0',
+            0x00, 0x00, 0x00, 0x03, 0x01, 0x02, 0x03, 0x00, // blob of three bytes
+            0x10, 0x20, 0x30, 0x40                          // colour
+        };
+
+        beginTest ("parsing a message");
+        {
+            OSCMessageView view;
+            expect (view.parse (message, sizeof (message)));
+            expect (view.isValid());
+            expect (view.getAddressPattern() == StringRef ("/test"));
+            expect (view.getTimeTag().isImmediately());
+            expectEquals (view.size(), 5);
+
+            expectEquals (view.getInt32 (0), -2);
+            expectEquals (view.getFloat32 (1), 1.5f);
+            expect (view.getString (2) == StringRef ("hello"));
+            expectEquals ((int) view.getBlobSize (3), 3);
+            expectEquals ((int) static_cast<const uint8*> (view.getBlobData (3))[2], 3);
+            expectEquals ((int) view.getColour (4).green, 0x20);
+
+            // the view refers to the original data rather than a copy:
+            expect (view.getRawData() == reinterpret_cast<const char*> (message));
+            expect (view.getString (2).text.getAddress() == reinterpret_cast<const char*> (message + 24));
+        }
+
+        beginTest ("converting to OSCMessage");
+        {
+            OSCMessageView view;
+            expect (view.parse (message, sizeof (message)));
+
+            auto copy = view.toMessage();
+            expectEquals (copy.getAddressPattern().toString(), String ("/test"));
+            expectEquals (copy.size(), 5);
+            expectEquals (copy[0].getInt32(), -2);
+            expectEquals (copy[2].getString(), String ("hello"));
+            expect (copy[3].getBlob() == MemoryBlock (message + 36, 3));
+        }
+
+        beginTest ("rejecting corrupt messages");
+        {
+            OSCMessageView view;
+
+            for (size_t size = 0; size < sizeof (message); ++size)
+                expect (! view.parse (message, size));
+
+            expect (! view.isValid());
+
+            uint8 corrupt[sizeof (message)];
+
+            std::memcpy (corrupt, message, sizeof (message));
+            corrupt[9] = 'x';   // unsupported type tag
+            expect (! view.parse (corrupt, sizeof (corrupt)));
+
+            std::memcpy (corrupt, message, sizeof (message));
+            corrupt[6] = 'x';   // missing padding zeros
+            expect (! view.parse (corrupt, sizeof (corrupt)));
+
+            std::memcpy (corrupt, message, sizeof (message));
+            corrupt[8] = 'x';   // no type tag string
+            expect (! view.parse (corrupt, sizeof (corrupt)));
+
+            std::memcpy (corrupt, message, sizeof (message));
+            corrupt[35] = 0x20; // blob larger than the message
+            expect (! view.parse (corrupt, sizeof (corrupt)));
+        }
+
+        beginTest ("walking bundles");
+        {
+            const uint8 bundle[] = {
+                '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0',
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05,
+
+                0x00, 0x00, 0x00, 0x08,
+                '/', 'a', '\0', '\0', ',', '\0', '\0', '\0',
+
+                0x00, 0x00, 0x00, 0x1c,
+                '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0',
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07,
+                0x00, 0x00, 0x00, 0x08,
+                '/', 'b', '\0', '\0', ',', '\0', '\0', '\0'
+            };
+
+            StringArray addresses;
+            Array<uint64> timeTags;
+
+            auto collect = [&] (const OSCMessageView& view)
+            {
+                addresses.add (String (view.getAddressPattern().text));
+                timeTags.add (view.getTimeTag().getRawTimeTag());
+            };
+
+            expect (OSCMessageView::forEachMessageInPacket (bundle, sizeof (bundle), collect));
+            expect (addresses == StringArray ("/a", "/b"));
+            expect (timeTags == Array<uint64> ((uint64) 5, (uint64) 7));
+
+            addresses.clear();
+            expect (OSCMessageView::forEachMessageInPacket (message, sizeof (message), collect));
+            expect (addresses == StringArray ("/test"));
+
+            // a packet that's corrupt at the end must not deliver any of its messages:
+            addresses.clear();
+            expect (! OSCMessageView::forEachMessageInPacket (bundle, sizeof (bundle) - 4, collect));
+            expect (addresses.isEmpty());
+        }
+    }
+};
+
+static OSCMessageViewTests OSCMessageViewUnitTests;
+
+#endif
+
+} // namespace juce
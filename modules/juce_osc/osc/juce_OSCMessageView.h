@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A read-only view of an OSC message that lives in somebody else's memory.
+
+    Unlike OSCMessage, an OSCMessageView doesn't copy or own anything: the address
+    pattern, string arguments and blobs are all accessed directly inside the buffer
+    that the view was parsed from, and parsing a view never allocates. This makes it
+    suitable for use on realtime threads, but it also means that the view is only
+    valid for as long as the underlying data is, so you mustn't keep hold of one.
+    If you need to keep the content, call toMessage() to make an OSCMessage from it.
+
+    A view can refer to at most maxNumArguments arguments. Messages with more
+    arguments than that will fail to parse.
+
+    @see OSCReceiver::MessageViewListener, OSCMessageQueue
+
+    @tags{OSC}
+*/
+class JUCE_API  OSCMessageView
+{
+public:
+    //==============================================================================
+    /** The largest number of arguments that a view is able to refer to. */
+    static constexpr int maxNumArguments = 64;
+
+    /** Creates an empty view that doesn't refer to any message. */
+    OSCMessageView() = default;
+
+    /** Makes this view refer to the OSC message contained in a block of data.
+
+        The data must hold exactly one complete OSC message (not a bundle), and is
+        neither copied nor owned by the view.
+
+        @returns true if the data could be parsed, or false if it was not a valid
+                 OSC message, in which case the view will be left empty.
+    */
+    bool parse (const void* sourceData, size_t sourceDataSize,
+                OSCTimeTag timeTagToUse = OSCTimeTag::immediately) noexcept;
+
+    /** Returns true if the view refers to a message. */
+    bool isValid() const noexcept                       { return data != nullptr; }
+
+    //==============================================================================
+    /** Returns the message's address pattern. */
+    StringRef getAddressPattern() const noexcept        { return StringRef (data); }
+
+    /** Returns the time tag of the bundle that contained the message, or
+        OSCTimeTag::immediately if the message wasn't part of a bundle.
+    */
+    OSCTimeTag getTimeTag() const noexcept              { return timeTag; }
+
+    /** Returns the number of arguments in the message. */
+    int size() const noexcept                           { return numArguments; }
+
+    /** Returns true if the message has no arguments. */
+    bool isEmpty() const noexcept                       { return numArguments == 0; }
+
+    /** Returns the type of an argument. */
+    OSCType getType (int index) const noexcept;
+
+    //==============================================================================
+    /** Returns the value of an int32 argument.
+        If the argument is not an int32, the behaviour is undefined.
+    */
+    int32 getInt32 (int index) const noexcept;
+
+    /** Returns the value of a float32 argument.
+        If the argument is not a float32, the behaviour is undefined.
+    */
+    float getFloat32 (int index) const noexcept;
+
+    /** Returns the value of a string argument, which points into the source data.
+        If the argument is not a string, the behaviour is undefined.
+    */
+    StringRef getString (int index) const noexcept;
+
+    /** Returns a pointer to the data of a blob argument inside the source data.
+        If the argument is not a blob, the behaviour is undefined.
+    */
+    const void* getBlobData (int index) const noexcept;
+
+    /** Returns the size in bytes of a blob argument.
+        If the argument is not a blob, the behaviour is undefined.
+    */
+    size_t getBlobSize (int index) const noexcept;
+
+    /** Returns the value of a colour argument.
+        If the argument is not a colour, the behaviour is undefined.
+    */
+    OSCColour getColour (int index) const noexcept;
+
+    //==============================================================================
+    /** Creates an OSCMessage holding a copy of this message's content. */
+    OSCMessage toMessage() const;
+
+    /** Returns the raw OSC data of the message. */
+    const char* getRawData() const noexcept             { return data; }
+
+    /** Returns the size of the raw OSC data of the message. */
+    size_t getRawDataSize() const noexcept              { return dataSize; }
+
+    //==============================================================================
+    /** Parses an OSC packet containing either a message or a (possibly nested)
+        bundle, and calls a function with a view of each message that it contains.
+
+        The callback's signature should be void (const OSCMessageView&). Messages
+        contained in bundles will have the time tag of their innermost bundle.
+
+        The whole packet is checked before the callback is called for any of its
+        messages, so a corrupt packet never results in a partial delivery.
+
+        @returns true if the packet was valid, or false if it could not be parsed.
+    */
+    template <typename Callback>
+    static bool forEachMessageInPacket (const void* packetData, size_t packetSize, Callback&& callback)
+    {
+        if (! walkPacket (packetData, packetSize, nullptr, nullptr))
+            return false;
+
+        return walkPacket (packetData, packetSize, [] (void* context, const OSCMessageView& view)
+        {
+            (*static_cast<std::remove_reference_t<Callback>*> (context)) (view);
+        }, std::addressof (callback));
+    }
+
+private:
+    //==============================================================================
+    using Visitor = void (*) (void*, const OSCMessageView&);
+
+    static bool walkPacket (const void*, size_t, Visitor, void*) noexcept;
+    static bool walkElement (const char*, size_t, OSCTimeTag, Visitor, void*) noexcept;
+
+    void clear() noexcept;
+
+    const char* data = nullptr;
+    size_t dataSize = 0;
+    const char* typeTags = nullptr;
+    int numArguments = 0;
+    OSCTimeTag timeTag;
+    uint32 argumentOffsets[maxNumArguments] = {};
+};
+
+} // namespace juce
@@ -311,6 +311,151 @@ namespace
 
 } // namespace
 
+//==============================================================================
+/** Finds the listeners whose OSC addresses are matched by an OSC address pattern.
+
+    The addresses are stored as a tree of address segments, so that an incoming
+    pattern only gets compared with the branches it could possibly reach. Plain
+    segments are looked up with a binary search, and segments containing wildcards
+    are matched against each child in turn. Looking up a pattern doesn't allocate
+    any memory, so it can be done on the network thread.
+*/
+template <typename ListenerType>
+class OSCAddressTrie
+{
+public:
+    void add (const OSCAddress& address, ListenerType* listener)
+    {
+        auto* node = &root;
+
+        for (auto& segment : StringArray::fromTokens (address.toString(), "/", {}))
+        {
+            if (segment.isEmpty())
+                continue;
+
+            auto* begin = segment.toRawUTF8();
+            auto* end = begin + segment.getNumBytesAsUTF8();
+            auto& children = node->children;
+            auto child = findChild (children, begin, end);
+
+            if (child == children.end() || compareSegment ((*child)->name, begin, end) != 0)
+            {
+                child = children.insert (child, std::make_unique<Node>());
+                (*child)->name = segment;
+            }
+
+            node = child->get();
+        }
+
+        node->listeners.emplace_back (address.toString(), listener);
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return root.children.empty() && root.listeners.empty();
+    }
+
+    template <typename Callback>
+    void forEachMatch (StringRef pattern, Callback&& callback) const
+    {
+        const auto* begin = pattern.text.getAddress();
+        const auto* end = begin + std::strlen (begin);
+
+        Lookup lookup;
+        lookup.hasWildcards = std::strpbrk (begin, wildcardChars) != nullptr;
+        lookup.trimmedPattern = begin;
+        lookup.trimmedPatternEnd = end;
+
+        while (lookup.trimmedPatternEnd != begin && *(lookup.trimmedPatternEnd - 1) == '/')
+            --lookup.trimmedPatternEnd;
+
+        visit (root, begin, end, lookup, callback);
+    }
+
+private:
+    //==============================================================================
+    struct Node
+    {
+        String name;
+        std::vector<std::unique_ptr<Node>> children;
+        std::vector<std::pair<String, ListenerType*>> listeners;
+    };
+
+    struct Lookup
+    {
+        bool hasWildcards;
+        const char* trimmedPattern;
+        const char* trimmedPatternEnd;
+    };
+
+    static constexpr const char* wildcardChars = "*?{}[]";
+
+    static int compareSegment (const String& name, const char* begin, const char* end) noexcept
+    {
+        const auto nameSize = name.getNumBytesAsUTF8();
+        const auto segmentSize = (size_t) (end - begin);
+
+        if (auto diff = std::memcmp (name.toRawUTF8(), begin, jmin (nameSize, segmentSize)))
+            return diff;
+
+        return nameSize < segmentSize ? -1 : (nameSize > segmentSize ? 1 : 0);
+    }
+
+    template <typename Children>
+    static auto findChild (Children& children, const char* begin, const char* end) noexcept
+    {
+        return std::lower_bound (children.begin(), children.end(), begin, [end] (const auto& child, const char* segment)
+        {
+            return compareSegment (child->name, segment, end) < 0;
+        });
+    }
+
+    // A pattern without wildcards has to be identical to the address, as in OSCAddressPattern::matches().
+    static bool isExactMatch (const String& address, const Lookup& lookup) noexcept
+    {
+        return compareSegment (address, lookup.trimmedPattern, lookup.trimmedPatternEnd) == 0;
+    }
+
+    template <typename Callback>
+    static void visit (const Node& node, const char* pos, const char* end, const Lookup& lookup, Callback& callback)
+    {
+        while (pos != end && *pos == '/')
+            ++pos;
+
+        if (pos == end)
+        {
+            for (auto& entry : node.listeners)
+                if (lookup.hasWildcards || isExactMatch (entry.first, lookup))
+                    callback (*entry.second);
+
+            return;
+        }
+
+        auto* segmentEnd = std::find (pos, end, '/');
+
+        if (std::find_first_of (pos, segmentEnd, wildcardChars, wildcardChars + std::strlen (wildcardChars)) != segmentEnd)
+        {
+            for (auto& child : node.children)
+            {
+                auto* name = child->name.toRawUTF8();
+
+                if (matchOscPattern (pos, segmentEnd, name, name + child->name.getNumBytesAsUTF8()))
+                    visit (*child, segmentEnd, end, lookup, callback);
+            }
+
+            return;
+        }
+
+        auto child = findChild (node.children, pos, segmentEnd);
+
+        if (child != node.children.end() && compareSegment ((*child)->name, pos, segmentEnd) == 0)
+            visit (**child, segmentEnd, end, lookup, callback);
+    }
+
+    Node root;
+};
+
+
 
 //==============================================================================
 struct OSCReceiver::Pimpl   : private Thread,
@@ -388,6 +533,16 @@ struct OSCReceiver::Pimpl   : private Thread,
         addListenerWithAddress (listenerToAdd, addressToMatch, realtimeListenersWithAddress);
     }
 
+    void addListener (MessageViewListener* listenerToAdd)
+    {
+        viewListeners.add (listenerToAdd);
+    }
+
+    void addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch)
+    {
+        addListenerWithAddress (listenerToAdd, addressToMatch, viewListenersWithAddress);
+    }
+
     void removeListener (OSCReceiver::Listener<MessageLoopCallback>* listenerToRemove)
     {
         listeners.remove (listenerToRemove);
@@ -408,6 +563,12 @@ struct OSCReceiver::Pimpl   : private Thread,
         removeListenerWithAddress (listenerToRemove, realtimeListenersWithAddress);
     }
 
+    void removeListener (MessageViewListener* listenerToRemove)
+    {
+        viewListeners.remove (listenerToRemove);
+        removeListenerWithAddress (listenerToRemove, viewListenersWithAddress);
+    }
+
     //==============================================================================
     struct CallbackMessage final : public Message
     {
@@ -420,6 +581,29 @@ struct OSCReceiver::Pimpl   : private Thread,
     //==============================================================================
     void handleBuffer (const char* data, size_t dataSize)
     {
+        const auto tries = getAddressTries();
+
+        // the view listeners get the messages first, straight from the receive buffer.
+        // Only if there's nobody else listening can we skip building OSCMessage objects.
+        if (viewListeners.size() > 0 || ! tries->views.isEmpty())
+        {
+            const auto parsed = OSCMessageView::forEachMessageInPacket (data, dataSize, [&] (const OSCMessageView& view)
+            {
+                viewListeners.call ([&] (MessageViewListener& l) { l.oscMessageReceived (view); });
+                tries->views.forEachMatch (view.getAddressPattern(), [&] (MessageViewListener& l) { l.oscMessageReceived (view); });
+            });
+
+            if (! parsed)
+            {
+                NullCheckedInvocation::invoke (formatErrorHandler, data, (int) dataSize);
+                return;
+            }
+
+            if (listeners.size() == 0 && realtimeListeners.size() == 0
+                 && tries->messageLoop.isEmpty() && tries->realtime.isEmpty())
+                return;
+        }
+
         OSCInputStream inStream (data, dataSize);
 
         try
@@ -431,11 +615,11 @@ struct OSCReceiver::Pimpl   : private Thread,
             callRealtimeListeners (content);
 
             if (content.isMessage())
-                callRealtimeListenersWithAddress (content.getMessage());
+                callRealtimeListenersWithAddress (content.getMessage(), *tries);
 
             // now post the message that will trigger the handleMessage callback
             // dealing with the non-realtime listeners.
-            if (listeners.size() > 0 || listenersWithAddress.size() > 0)
+            if (listeners.size() > 0 || ! tries->messageLoop.isEmpty())
                 postMessage (new CallbackMessage (content));
         }
         catch (const OSCFormatError&)
@@ -486,6 +670,7 @@ private:
                 return;
 
         array.add (std::make_pair (address, listenerToAdd));
+        rebuildAddressTries();
     }
 
     //==============================================================================
@@ -502,11 +687,42 @@ private:
                 // luckily, we don't care about methods preserving element order:
                 array.swap (i, array.size() - 1);
                 array.removeLast();
+                rebuildAddressTries();
                 break;
             }
         }
     }
 
+    //==============================================================================
+    struct AddressTries
+    {
+        OSCAddressTrie<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>> messageLoop;
+        OSCAddressTrie<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>>    realtime;
+        OSCAddressTrie<OSCReceiver::MessageViewListener>                                      views;
+    };
+
+    // The tries are rebuilt whenever a listener with an address is added or removed,
+    // and swapped in, so that the network thread never has to wait for a rebuild.
+    void rebuildAddressTries()
+    {
+        auto newTries = std::make_shared<AddressTries>();
+
+        for (auto& i : listenersWithAddress)            if (i.second != nullptr)  newTries->messageLoop.add (i.first, i.second);
+        for (auto& i : realtimeListenersWithAddress)    if (i.second != nullptr)  newTries->realtime.add (i.first, i.second);
+        for (auto& i : viewListenersWithAddress)        if (i.second != nullptr)  newTries->views.add (i.first, i.second);
+
+        std::shared_ptr<const AddressTries> oldTries (std::move (newTries));
+
+        const SpinLock::ScopedLockType sl (addressTriesLock);
+        std::swap (addressTries, oldTries);
+    }
+
+    std::shared_ptr<const AddressTries> getAddressTries() const
+    {
+        const SpinLock::ScopedLockType sl (addressTriesLock);
+        return addressTries;
+    }
+
     //==============================================================================
     void handleMessage (const Message& msg) override
     {
@@ -557,18 +773,18 @@ private:
     //==============================================================================
     void callListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : listenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        using OSCListener = OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>;
+
+        const auto pattern = message.getAddressPattern().toString();
+        getAddressTries()->messageLoop.forEachMatch (pattern, [&] (OSCListener& l) { l.oscMessageReceived (message); });
     }
 
-    void callRealtimeListenersWithAddress (const OSCMessage& message)
+    void callRealtimeListenersWithAddress (const OSCMessage& message, const AddressTries& tries)
     {
-        for (auto& entry : realtimeListenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        using OSCListener = OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>;
+
+        const auto pattern = message.getAddressPattern().toString();
+        tries.realtime.forEachMatch (pattern, [&] (OSCListener& l) { l.oscMessageReceived (message); });
     }
 
     //==============================================================================
@@ -578,6 +794,12 @@ private:
     Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>*>> listenersWithAddress;
     Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>*>>    realtimeListenersWithAddress;
 
+    ListenerList<OSCReceiver::MessageViewListener> viewListeners;
+    Array<std::pair<OSCAddress, OSCReceiver::MessageViewListener*>> viewListenersWithAddress;
+
+    std::shared_ptr<const AddressTries> addressTries = std::make_shared<AddressTries>();
+    mutable SpinLock addressTriesLock;
+
     OptionalScopedPointer<DatagramSocket> socket;
     OSCReceiver::FormatErrorHandler formatErrorHandler { nullptr };
 
@@ -633,6 +855,16 @@ void OSCReceiver::addListener (ListenerWithOSCAddress<RealtimeCallback>* listene
     pimpl->addListener (listenerToAdd, addressToMatch);
 }
 
+void OSCReceiver::addListener (MessageViewListener* listenerToAdd)
+{
+    pimpl->addListener (listenerToAdd);
+}
+
+void OSCReceiver::addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch)
+{
+    pimpl->addListener (listenerToAdd, addressToMatch);
+}
+
 void OSCReceiver::removeListener (Listener<MessageLoopCallback>* listenerToRemove)
 {
     pimpl->removeListener (listenerToRemove);
@@ -653,6 +885,11 @@ void OSCReceiver::removeListener (ListenerWithOSCAddress<RealtimeCallback>* list
     pimpl->removeListener (listenerToRemove);
 }
 
+void OSCReceiver::removeListener (MessageViewListener* listenerToRemove)
+{
+    pimpl->removeListener (listenerToRemove);
+}
+
 void OSCReceiver::registerFormatErrorHandler (FormatErrorHandler handler)
 {
     pimpl->registerFormatErrorHandler (handler);
@@ -1190,4 +1427,86 @@ static OSCInputStreamTests OSCInputStreamUnitTests;
 
 #endif
 
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OSCAddressTrieTests final : public UnitTest
+{
+public:
+    OSCAddressTrieTests()
+        : UnitTest ("OSCReceiver address routing", UnitTestCategories::osc)
+    {}
+
+    struct Target { String name; };
+
+    void runTest() override
+    {
+        Target fader1 { "fader1" }, fader2 { "fader2" }, knob { "knob" }, other { "other" }, root { "root" };
+
+        OSCAddressTrie<Target> trie;
+        expect (trie.isEmpty());
+
+        trie.add (OSCAddress ("/mixer/fader1"), &fader1);
+        trie.add (OSCAddress ("/mixer/fader2"), &fader2);
+        trie.add (OSCAddress ("/mixer/knob/"), &knob);
+        trie.add (OSCAddress ("/other"), &other);
+        trie.add (OSCAddress ("/"), &root);
+        expect (! trie.isEmpty());
+
+        auto findMatches = [&] (const char* pattern)
+        {
+            StringArray names;
+            trie.forEachMatch (pattern, [&] (Target& t) { names.add (t.name); });
+            names.sort (false);
+            return names.joinIntoString (" ");
+        };
+
+        beginTest ("plain addresses");
+        {
+            expectEquals (findMatches ("/mixer/fader1"), String ("fader1"));
+            expectEquals (findMatches ("/mixer/knob"), String ("knob"));
+            expectEquals (findMatches ("/mixer/knob/"), String ("knob"));
+            expectEquals (findMatches ("/other"), String ("other"));
+            expectEquals (findMatches ("/"), String ("root"));
+            expectEquals (findMatches ("/mixer"), String());
+            expectEquals (findMatches ("/mixer/fader3"), String());
+            expectEquals (findMatches ("/mixer/fader1/x"), String());
+        }
+
+        beginTest ("patterns with wildcards");
+        {
+            expectEquals (findMatches ("/mixer/*"), String ("fader1 fader2 knob"));
+            expectEquals (findMatches ("/mixer/fader?"), String ("fader1 fader2"));
+            expectEquals (findMatches ("/mixer/fader[!1]"), String ("fader2"));
+            expectEquals (findMatches ("/mixer/{knob,fader1}"), String ("fader1 knob"));
+            expectEquals (findMatches ("/*"), String ("other"));
+            expectEquals (findMatches ("/*/fader[0-9]"), String ("fader1 fader2"));
+        }
+
+        beginTest ("results are the same as OSCAddressPattern::matches");
+        {
+            const char* addresses[] = { "/mixer/fader1", "/mixer/fader2", "/mixer/knob", "/other", "/" };
+            const char* patterns[]  = { "/mixer/fader1", "/mixer//fader1", "/mixer/*", "/*/*", "/*", "/?ther",
+                                        "/mixer/{fader1,fader2,kn}", "/mixer/[a-k]nob", "/mixer/fader[1-]", "/" };
+
+            for (auto* pattern : patterns)
+            {
+                StringArray expected;
+
+                for (auto* address : addresses)
+                    if (OSCAddressPattern (pattern).matches (OSCAddress (address)))
+                        expected.add (String (address) == "/" ? "root" : String (address).fromLastOccurrenceOf ("/", false, false));
+
+                expected.sort (false);
+                expectEquals (findMatches (pattern), expected.joinIntoString (" "), pattern);
+            }
+        }
+    }
+};
+
+static OSCAddressTrieTests OSCAddressTrieUnitTests;
+
+#endif
+
 } // namespace juce
@@ -157,6 +157,31 @@ public:
         virtual void oscMessageReceived (const OSCMessage& message) = 0;
     };
 
+    //==============================================================================
+    /** A class for receiving OSC messages from an OSCReceiver without any of them
+        being copied into OSCMessage objects.
+
+        The callback is made directly on the network thread as soon as a packet
+        arrives, with an OSCMessageView that refers to the receiver's own buffer.
+        Receiving messages this way doesn't allocate any memory, so it's the best
+        choice for passing OSC data to realtime code, e.g. via an OSCMessageQueue.
+
+        The messages contained in bundles are passed to the listener one by one.
+
+        @see OSCReceiver::addListener, OSCMessageView, OSCMessageQueue
+    */
+    class JUCE_API  MessageViewListener
+    {
+    public:
+        /** Destructor. */
+        virtual ~MessageViewListener() = default;
+
+        /** Called when the OSCReceiver receives a new OSC message.
+            The view is only valid for the duration of this callback.
+        */
+        virtual void oscMessageReceived (const OSCMessageView& message) = 0;
+    };
+
     //==============================================================================
     /** Adds a listener that listens to OSC messages and bundles.
         This listener will be called on the application's message loop.
@@ -183,6 +208,19 @@ public:
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd,
                       OSCAddress addressToMatch);
 
+    /** Adds a listener that receives views of all incoming OSC messages.
+        This listener will be called in real-time directly on the network thread
+        that receives OSC data.
+    */
+    void addListener (MessageViewListener* listenerToAdd);
+
+    /** Adds a listener that receives views of the incoming OSC messages matching the
+        address used to register the listener here.
+        This listener will be called in real-time directly on the network thread
+        that receives OSC data.
+    */
+    void addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch);
+
     /** Removes a previously-registered listener. */
     void removeListener (Listener<MessageLoopCallback>* listenerToRemove);
 
@@ -195,6 +233,9 @@ public:
     /** Removes a previously-registered listener. */
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove);
 
+    /** Removes a previously-registered listener. */
+    void removeListener (MessageViewListener* listenerToRemove);
+
     //==============================================================================
     /** An error handler function for OSC format errors that can be called by the
         OSCReceiver.
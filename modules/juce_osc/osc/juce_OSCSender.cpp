@@ -26,193 +26,242 @@
 namespace juce
 {
 
-namespace
+//==============================================================================
+/** Writes OSC data to an internal memory buffer, which grows as required.
+
+    The data that was written into the stream can then be accessed later as
+    a contiguous block of memory.
+
+    This class implements the Open Sound Control 1.0 Specification for
+    the format in which the OSC data will be written into the buffer.
+*/
+struct OSCOutputStream
 {
+    OSCOutputStream() noexcept {}
+
+    /** Returns a pointer to the data that has been written to the stream. */
+    const void* getData() const noexcept    { return output.getData(); }
+
+    /** Returns the number of bytes of data that have been written to the stream. */
+    size_t getDataSize() const noexcept     { return output.getDataSize(); }
+
+    /** Clears the stream, keeping its memory so it can be reused without reallocating. */
+    void reset() noexcept                   { output.reset(); }
+
     //==============================================================================
-    /** Writes OSC data to an internal memory buffer, which grows as required.
+    bool writeInt32 (int32 value)
+    {
+        return output.writeIntBigEndian (value);
+    }
 
-        The data that was written into the stream can then be accessed later as
-        a contiguous block of memory.
+    bool writeUint64 (uint64 value)
+    {
+        return output.writeInt64BigEndian (int64 (value));
+    }
 
-        This class implements the Open Sound Control 1.0 Specification for
-        the format in which the OSC data will be written into the buffer.
-    */
-    struct OSCOutputStream
+    bool writeFloat32 (float value)
     {
-        OSCOutputStream() noexcept {}
+        return output.writeFloatBigEndian (value);
+    }
 
-        /** Returns a pointer to the data that has been written to the stream. */
-        const void* getData() const noexcept    { return output.getData(); }
+    bool writeString (const String& value)
+    {
+        if (! output.writeString (value))
+            return false;
 
-        /** Returns the number of bytes of data that have been written to the stream. */
-        size_t getDataSize() const noexcept     { return output.getDataSize(); }
+        const size_t numPaddingZeros = ~value.getNumBytesAsUTF8() & 3;
 
-        //==============================================================================
-        bool writeInt32 (int32 value)
-        {
-            return output.writeIntBigEndian (value);
-        }
+        return output.writeRepeatedByte ('\0', numPaddingZeros);
+    }
 
-        bool writeUint64 (uint64 value)
-        {
-            return output.writeInt64BigEndian (int64 (value));
-        }
+    bool writeBlob (const MemoryBlock& blob)
+    {
+        if (! (output.writeIntBigEndian ((int) blob.getSize())
+                && output.write (blob.getData(), blob.getSize())))
+            return false;
 
-        bool writeFloat32 (float value)
-        {
-            return output.writeFloatBigEndian (value);
-        }
+        const size_t numPaddingZeros = ~(blob.getSize() - 1) & 3;
 
-        bool writeString (const String& value)
-        {
-            if (! output.writeString (value))
-                return false;
+        return output.writeRepeatedByte (0, numPaddingZeros);
+    }
 
-            const size_t numPaddingZeros = ~value.getNumBytesAsUTF8() & 3;
+    bool writeColour (OSCColour colour)
+    {
+        return output.writeIntBigEndian ((int32) colour.toInt32());
+    }
 
-            return output.writeRepeatedByte ('\0', numPaddingZeros);
-        }
+    bool writeTimeTag (OSCTimeTag timeTag)
+    {
+        return output.writeInt64BigEndian (int64 (timeTag.getRawTimeTag()));
+    }
 
-        bool writeBlob (const MemoryBlock& blob)
-        {
-            if (! (output.writeIntBigEndian ((int) blob.getSize())
-                    && output.write (blob.getData(), blob.getSize())))
-                return false;
+    bool writeAddress (const OSCAddress& address)
+    {
+        return writeString (address.toString());
+    }
 
-            const size_t numPaddingZeros = ~(blob.getSize() - 1) & 3;
+    bool writeAddressPattern (const OSCAddressPattern& ap)
+    {
+        return writeString (ap.toString());
+    }
 
-            return output.writeRepeatedByte (0, numPaddingZeros);
-        }
+    bool writeTypeTagString (const OSCTypeList& typeList)
+    {
+        output.writeByte (',');
 
-        bool writeColour (OSCColour colour)
-        {
-            return output.writeIntBigEndian ((int32) colour.toInt32());
-        }
+        if (typeList.size() > 0)
+            output.write (typeList.begin(), (size_t) typeList.size());
 
-        bool writeTimeTag (OSCTimeTag timeTag)
-        {
-            return output.writeInt64BigEndian (int64 (timeTag.getRawTimeTag()));
-        }
+        output.writeByte ('\0');
 
-        bool writeAddress (const OSCAddress& address)
-        {
-            return writeString (address.toString());
-        }
+        size_t bytesWritten = (size_t) typeList.size() + 1;
+        size_t numPaddingZeros = ~bytesWritten & 0x03;
 
-        bool writeAddressPattern (const OSCAddressPattern& ap)
-        {
-            return writeString (ap.toString());
-        }
+        return output.writeRepeatedByte ('\0', numPaddingZeros);
+    }
 
-        bool writeTypeTagString (const OSCTypeList& typeList)
+    bool writeArgument (const OSCArgument& arg)
+    {
+        switch (arg.getType())
         {
-            output.writeByte (',');
-
-            if (typeList.size() > 0)
-                output.write (typeList.begin(), (size_t) typeList.size());
+            case OSCTypes::int32:       return writeInt32 (arg.getInt32());
+            case OSCTypes::float32:     return writeFloat32 (arg.getFloat32());
+            case OSCTypes::string:      return writeString (arg.getString());
+            case OSCTypes::blob:        return writeBlob (arg.getBlob());
+            case OSCTypes::colour:      return writeColour (arg.getColour());
+
+            default:
+                // In this very unlikely case you supplied an invalid OSCType!
+                jassertfalse;
+                return false;
+        }
+    }
 
-            output.writeByte ('\0');
+    //==============================================================================
+    bool writeMessage (const OSCMessage& msg)
+    {
+        if (! writeAddressPattern (msg.getAddressPattern()))
+            return false;
 
-            size_t bytesWritten = (size_t) typeList.size() + 1;
-            size_t numPaddingZeros = ~bytesWritten & 0x03;
+        OSCTypeList typeList;
 
-            return output.writeRepeatedByte ('\0', numPaddingZeros);
-        }
+        for (auto& arg : msg)
+            typeList.add (arg.getType());
 
-        bool writeArgument (const OSCArgument& arg)
-        {
-            switch (arg.getType())
-            {
-                case OSCTypes::int32:       return writeInt32 (arg.getInt32());
-                case OSCTypes::float32:     return writeFloat32 (arg.getFloat32());
-                case OSCTypes::string:      return writeString (arg.getString());
-                case OSCTypes::blob:        return writeBlob (arg.getBlob());
-                case OSCTypes::colour:      return writeColour (arg.getColour());
-
-                default:
-                    // In this very unlikely case you supplied an invalid OSCType!
-                    jassertfalse;
-                    return false;
-            }
-        }
+        if (! writeTypeTagString (typeList))
+            return false;
 
-        //==============================================================================
-        bool writeMessage (const OSCMessage& msg)
-        {
-            if (! writeAddressPattern (msg.getAddressPattern()))
+        for (auto& arg : msg)
+            if (! writeArgument (arg))
                 return false;
 
-            OSCTypeList typeList;
+        return true;
+    }
 
-            for (auto& arg : msg)
-                typeList.add (arg.getType());
+    bool writeBundle (const OSCBundle& bundle)
+    {
+        if (! writeString ("#bundle"))
+            return false;
 
-            if (! writeTypeTagString (typeList))
+        if (! writeTimeTag (bundle.getTimeTag()))
+            return false;
+
+        for (auto& element : bundle)
+            if (! writeBundleElement (element))
                 return false;
 
-            for (auto& arg : msg)
-                if (! writeArgument (arg))
-                    return false;
+        return true;
+    }
 
-            return true;
-        }
+    //==============================================================================
+    bool writeBundleElement (const OSCBundle::Element& element)
+    {
+        const int64 startPos = output.getPosition();
+
+        if (! writeInt32 (0))   // writing dummy value for element size
+            return false;
 
-        bool writeBundle (const OSCBundle& bundle)
+        if (element.isBundle())
         {
-            if (! writeString ("#bundle"))
+            if (! writeBundle (element.getBundle()))
                 return false;
-
-            if (! writeTimeTag (bundle.getTimeTag()))
+        }
+        else
+        {
+            if (! writeMessage (element.getMessage()))
                 return false;
+        }
 
-            for (auto& element : bundle)
-                if (! writeBundleElement (element))
-                    return false;
+        const int64 endPos = output.getPosition();
+        const int64 elementSize = endPos - (startPos + 4);
 
-            return true;
-        }
+        return output.setPosition (startPos)
+                 && writeInt32 ((int32) elementSize)
+                 && output.setPosition (endPos);
+    }
 
-        //==============================================================================
-        bool writeBundleElement (const OSCBundle::Element& element)
+    bool writeBundleElement (const void* encodedElement, size_t elementSize)
+    {
+        return writeInt32 ((int32) elementSize)
+            && output.write (encodedElement, elementSize);
+    }
+
+private:
+    MemoryOutputStream output;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OSCOutputStream)
+};
+
+namespace
+{
+    //==============================================================================
+    /** Frames an OSC packet for a stream-based transport using SLIP (RFC 1055), with
+        an END byte at both ends, as described by the OSC 1.1 specification.
+    */
+    static bool writeSLIPEncodedPacket (MemoryOutputStream& output, const void* data, size_t size)
+    {
+        constexpr uint8 end = 0xc0, esc = 0xdb, escEnd = 0xdc, escEsc = 0xdd;
+
+        auto* bytes = static_cast<const uint8*> (data);
+        auto* bytesEnd = bytes + size;
+
+        if (! output.writeByte ((char) end))
+            return false;
+
+        while (bytes != bytesEnd)
         {
-            const int64 startPos = output.getPosition();
+            auto* special = std::find_if (bytes, bytesEnd, [] (uint8 b) { return b == end || b == esc; });
 
-            if (! writeInt32 (0))   // writing dummy value for element size
+            if (! output.write (bytes, (size_t) (special - bytes)))
                 return false;
 
-            if (element.isBundle())
-            {
-                if (! writeBundle (element.getBundle()))
-                    return false;
-            }
-            else
-            {
-                if (! writeMessage (element.getMessage()))
-                    return false;
-            }
+            if (special == bytesEnd)
+                break;
 
-            const int64 endPos = output.getPosition();
-            const int64 elementSize = endPos - (startPos + 4);
+            const char escaped[] = { (char) esc, (char) (*special == end ? escEnd : escEsc) };
 
-            return output.setPosition (startPos)
-                     && writeInt32 ((int32) elementSize)
-                     && output.setPosition (endPos);
-        }
+            if (! output.write (escaped, sizeof (escaped)))
+                return false;
 
-    private:
-        MemoryOutputStream output;
+            bytes = special + 1;
+        }
 
-        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OSCOutputStream)
-    };
+        return output.writeByte ((char) end);
+    }
 
 } // namespace
 
 
 //==============================================================================
-struct OSCSender::Pimpl
+struct OSCSender::Pimpl  : private HighResolutionTimer
 {
     Pimpl() noexcept  {}
-    ~Pimpl() noexcept { disconnect(); }
+
+    ~Pimpl() override
+    {
+        stopTimer();
+        disconnect();
+    }
 
     //==============================================================================
     bool connect (const String& newTargetHost, int newTargetPort)
@@ -220,6 +269,8 @@ struct OSCSender::Pimpl
         if (! disconnect())
             return false;
 
+        const ScopedLock sl (lock);
+
         socket.setOwned (new DatagramSocket (true));
         targetHostName = newTargetHost;
         targetPortNumber = newTargetPort;
@@ -236,51 +287,232 @@ struct OSCSender::Pimpl
         if (! disconnect())
             return false;
 
+        const ScopedLock sl (lock);
+
         socket.setNonOwned (&newSocket);
         targetHostName = newTargetHost;
         targetPortNumber = newTargetPort;
         return true;
     }
 
+    bool connectToTCPHost (const String& newTargetHost, int newTargetPort, int timeOutMillisecs)
+    {
+        if (! disconnect())
+            return false;
+
+        auto newSocket = std::make_unique<StreamingSocket>();
+
+        if (! newSocket->connect (newTargetHost, newTargetPort, timeOutMillisecs))
+            return false;
+
+        const ScopedLock sl (lock);
+        streamSocket = std::move (newSocket);
+        return true;
+    }
+
     bool disconnect()
     {
+        const ScopedLock sl (lock);
+
+        if (isConnected())
+            flushBatch();
+
+        numBatchedMessages = 0;
         socket.reset();
+        streamSocket.reset();
+        extraTargets.clear();
+        return true;
+    }
+
+    //==============================================================================
+    bool addTarget (const String& hostName, int portNumber)
+    {
+        const ScopedLock sl (lock);
+
+        for (auto& target : extraTargets)
+            if (target.hostName == hostName && target.portNumber == portNumber)
+                return true;
+
+        auto newSocket = std::make_unique<DatagramSocket> (true);
+
+        if (! newSocket->bindToPort (0))
+            return false;
+
+        extraTargets.push_back ({ hostName, portNumber, std::move (newSocket) });
         return true;
     }
 
+    void removeTarget (const String& hostName, int portNumber)
+    {
+        const ScopedLock sl (lock);
+
+        extraTargets.erase (std::remove_if (extraTargets.begin(), extraTargets.end(), [&] (const Target& target)
+                                            {
+                                                return target.hostName == hostName && target.portNumber == portNumber;
+                                            }),
+                            extraTargets.end());
+    }
+
+    //==============================================================================
+    void setBatchingInterval (int intervalMilliseconds, int maxPacketSizeInBytes)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (isConnected())
+                flushBatch();
+
+            batchingInterval = jmax (0, intervalMilliseconds);
+            maxPacketSize = (size_t) jmax (64, maxPacketSizeInBytes);
+        }
+
+        // This mustn't be called with the lock held, as it waits for the timer callback.
+        startTimer (batchingInterval);
+    }
+
+    bool flush()
+    {
+        const ScopedLock sl (lock);
+        return flushBatch();
+    }
+
     //==============================================================================
     bool send (const OSCMessage& message, const String& hostName, int portNumber)
     {
-        OSCOutputStream outStream;
+        const ScopedLock sl (lock);
+        scratch.reset();
 
-        return outStream.writeMessage (message)
-            && sendOutputStream (outStream, hostName, portNumber);
+        return scratch.writeMessage (message)
+            && sendDatagram (scratch, hostName, portNumber);
     }
 
     bool send (const OSCBundle& bundle, const String& hostName, int portNumber)
     {
-        OSCOutputStream outStream;
+        const ScopedLock sl (lock);
+        scratch.reset();
+
+        return scratch.writeBundle (bundle)
+            && sendDatagram (scratch, hostName, portNumber);
+    }
+
+    bool send (const OSCMessage& message)
+    {
+        const ScopedLock sl (lock);
+        scratch.reset();
 
-        return outStream.writeBundle (bundle)
-            && sendOutputStream (outStream, hostName, portNumber);
+        if (! scratch.writeMessage (message))
+            return false;
+
+        if (batchingInterval > 0 && isConnected())
+            return addToBatch (scratch);
+
+        return sendToTargets (scratch.getData(), scratch.getDataSize());
     }
 
-    bool send (const OSCMessage& message)   { return send (message, targetHostName, targetPortNumber); }
-    bool send (const OSCBundle& bundle)     { return send (bundle,  targetHostName, targetPortNumber); }
+    bool send (const OSCBundle& bundle)
+    {
+        const ScopedLock sl (lock);
+        auto result = flushBatch();
+        scratch.reset();
+
+        return scratch.writeBundle (bundle)
+            && sendToTargets (scratch.getData(), scratch.getDataSize())
+            && result;
+    }
 
 private:
     //==============================================================================
-    bool sendOutputStream (OSCOutputStream& outStream, const String& hostName, int portNumber)
+    struct Target
     {
-        if (socket != nullptr)
+        String hostName;
+        int portNumber;
+        std::unique_ptr<DatagramSocket> socket;
+    };
+
+    static constexpr size_t bundleHeaderSize = 16; // "#bundle" and the time tag
+
+    bool isConnected() const noexcept
+    {
+        return socket != nullptr || streamSocket != nullptr || ! extraTargets.empty();
+    }
+
+    //==============================================================================
+    bool addToBatch (const OSCOutputStream& encodedMessage)
+    {
+        const auto messageSize = encodedMessage.getDataSize();
+        auto result = true;
+
+        if (numBatchedMessages > 0 && batch.getDataSize() + 4 + messageSize > maxPacketSize)
+            result = flushBatch();
+
+        // too big to share a packet with anything else..
+        if (bundleHeaderSize + 4 + messageSize > maxPacketSize)
+            return sendToTargets (encodedMessage.getData(), messageSize) && result;
+
+        if (numBatchedMessages == 0)
         {
-            const int streamSize = (int) outStream.getDataSize();
+            batch.reset();
+            batch.writeString ("#bundle");
+            batch.writeTimeTag (OSCTimeTag::immediately);
+        }
+
+        ++numBatchedMessages;
+        return batch.writeBundleElement (encodedMessage.getData(), messageSize) && result;
+    }
+
+    bool flushBatch()
+    {
+        const auto numMessages = std::exchange (numBatchedMessages, 0);
+
+        if (numMessages == 0)
+            return true;
 
-            const int bytesWritten = socket->write (hostName, portNumber,
-                                                    outStream.getData(), streamSize);
-            return bytesWritten == streamSize;
+        if (numMessages == 1)
+        {
+            constexpr auto offset = bundleHeaderSize + 4;
+            return sendToTargets (addBytesToPointer (batch.getData(), offset), batch.getDataSize() - offset);
         }
 
+        return sendToTargets (batch.getData(), batch.getDataSize());
+    }
+
+    void hiResTimerCallback() override
+    {
+        const ScopedLock sl (lock);
+        flushBatch();
+    }
+
+    //==============================================================================
+    bool sendToTargets (const void* data, size_t dataSize)
+    {
+        if (! isConnected())
+        {
+            // if you hit this, you tried to send some OSC data without being
+            // connected to a port! You should call OSCSender::connect() first.
+            jassertfalse;
+
+            return false;
+        }
+
+        auto result = true;
+
+        if (socket != nullptr)
+            result = writeDatagram (*socket, targetHostName, targetPortNumber, data, dataSize) && result;
+
+        if (streamSocket != nullptr)
+            result = writeToStream (data, dataSize) && result;
+
+        for (auto& target : extraTargets)
+            result = writeDatagram (*target.socket, target.hostName, target.portNumber, data, dataSize) && result;
+
+        return result;
+    }
+
+    bool sendDatagram (const OSCOutputStream& outStream, const String& hostName, int portNumber)
+    {
+        if (socket != nullptr)
+            return writeDatagram (*socket, hostName, portNumber, outStream.getData(), outStream.getDataSize());
+
         // if you hit this, you tried to send some OSC data without being
         // connected to a port! You should call OSCSender::connect() first.
         jassertfalse;
@@ -288,11 +520,43 @@ private:
         return false;
     }
 
+    static bool writeDatagram (DatagramSocket& datagramSocket, const String& hostName, int portNumber,
+                               const void* data, size_t dataSize)
+    {
+        const int bytesWritten = datagramSocket.write (hostName, portNumber, data, (int) dataSize);
+        return bytesWritten == (int) dataSize;
+    }
+
+    bool writeToStream (const void* data, size_t dataSize)
+    {
+        slipBuffer.reset();
+
+        if (! writeSLIPEncodedPacket (slipBuffer, data, dataSize))
+            return false;
+
+        const auto numBytes = (int) slipBuffer.getDataSize();
+        return streamSocket->write (slipBuffer.getData(), numBytes) == numBytes;
+    }
+
     //==============================================================================
+    CriticalSection lock;
+
     OptionalScopedPointer<DatagramSocket> socket;
     String targetHostName;
     int targetPortNumber = 0;
 
+    std::unique_ptr<StreamingSocket> streamSocket;
+    std::vector<Target> extraTargets;
+
+    // These are reused for every packet, so that sending doesn't need to allocate
+    // once they've grown large enough.
+    OSCOutputStream scratch, batch;
+    MemoryOutputStream slipBuffer;
+
+    int batchingInterval = 0;
+    size_t maxPacketSize = (size_t) OSCSender::defaultMaxPacketSize;
+    int numBatchedMessages = 0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
 };
 
@@ -319,11 +583,38 @@ bool OSCSender::connectToSocket (DatagramSocket& socket, const String& targetHos
     return pimpl->connectToSocket (socket, targetHostName, targetPortNumber);
 }
 
+bool OSCSender::connectToTCPHost (const String& targetHostName, int targetPortNumber, int timeOutMillisecs)
+{
+    return pimpl->connectToTCPHost (targetHostName, targetPortNumber, timeOutMillisecs);
+}
+
 bool OSCSender::disconnect()
 {
     return pimpl->disconnect();
 }
 
+//==============================================================================
+bool OSCSender::addTarget (const String& targetHostName, int targetPortNumber)
+{
+    return pimpl->addTarget (targetHostName, targetPortNumber);
+}
+
+void OSCSender::removeTarget (const String& targetHostName, int targetPortNumber)
+{
+    pimpl->removeTarget (targetHostName, targetPortNumber);
+}
+
+//==============================================================================
+void OSCSender::setBatchingInterval (int intervalMilliseconds, int maxPacketSizeInBytes)
+{
+    pimpl->setBatchingInterval (intervalMilliseconds, maxPacketSizeInBytes);
+}
+
+bool OSCSender::flush()
+{
+    return pimpl->flush();
+}
+
 //==============================================================================
 bool OSCSender::send (const OSCMessage& message)    { return pimpl->send (message); }
 bool OSCSender::send (const OSCBundle& bundle)      { return pimpl->send (bundle); }
@@ -871,6 +1162,178 @@ public:
 
 static OSCRoundTripTests OSCRoundTripUnitTests;
 
+//==============================================================================
+class OSCSenderTransportTests final : public UnitTest
+{
+public:
+    OSCSenderTransportTests()
+        : UnitTest ("OSCSender transports", UnitTestCategories::osc)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("SLIP encoding");
+        {
+            const uint8 packet[] = { 0x01, 0xc0, 0x02, 0xdb, 0x03 };
+            const uint8 expected[] = { 0xc0, 0x01, 0xdb, 0xdc, 0x02, 0xdb, 0xdd, 0x03, 0xc0 };
+
+            MemoryOutputStream output;
+            expect (writeSLIPEncodedPacket (output, packet, sizeof (packet)));
+            expect (output.getMemoryBlock() == MemoryBlock (expected, sizeof (expected)));
+        }
+
+        beginTest ("batching messages into bundles");
+        {
+            DatagramSocket receiver;
+            expect (receiver.bindToPort (0, "127.0.0.1"));
+
+            OSCSender sender;
+            expect (sender.connect ("127.0.0.1", receiver.getBoundPort()));
+            sender.setBatchingInterval (60000, 128);
+
+            for (int i = 0; i < 3; ++i)
+                expect (sender.send ("/batch", i));
+
+            expectEquals (receiver.waitUntilReady (true, 50), 0);
+            expect (sender.flush());
+
+            auto packet = readPacket (receiver);
+            expect (packet.isBundle());
+
+            if (packet.isBundle())
+            {
+                auto& bundle = packet.getBundle();
+                expectEquals (bundle.size(), 3);
+                expect (bundle.getTimeTag().isImmediately());
+
+                for (int i = 0; i < bundle.size(); ++i)
+                    expectEquals (bundle[i].getMessage()[0].getInt32(), i);
+            }
+
+            // a batch holding a single message is sent as a plain message:
+            expect (sender.send ("/batch", 3));
+            expect (sender.flush());
+            expect (readPacket (receiver).isMessage());
+
+            // bundles never grow larger than the packet size:
+            for (int i = 0; i < 10; ++i)
+                expect (sender.send ("/batch/size", i));
+
+            expect (sender.flush());
+
+            int numMessages = 0;
+
+            while (receiver.waitUntilReady (true, 100) > 0)
+            {
+                char buffer[512];
+                auto size = receiver.read (buffer, (int) sizeof (buffer), false);
+                expect (size <= 128);
+
+                OSCInputStream inStream (buffer, (size_t) size);
+                auto element = inStream.readElementWithKnownSize ((size_t) size);
+                numMessages += element.isBundle() ? element.getBundle().size() : 1;
+            }
+
+            expectEquals (numMessages, 10);
+        }
+
+        beginTest ("sending to several targets");
+        {
+            DatagramSocket receiver1, receiver2;
+            expect (receiver1.bindToPort (0, "127.0.0.1"));
+            expect (receiver2.bindToPort (0, "127.0.0.1"));
+
+            OSCSender sender;
+            expect (sender.connect ("127.0.0.1", receiver1.getBoundPort()));
+            expect (sender.addTarget ("127.0.0.1", receiver2.getBoundPort()));
+            expect (sender.send ("/fan/out", 1.0f));
+
+            expect (readPacket (receiver1).isMessage());
+            expect (readPacket (receiver2).isMessage());
+
+            sender.removeTarget ("127.0.0.1", receiver2.getBoundPort());
+            expect (sender.send ("/fan/out", 2.0f));
+
+            expect (readPacket (receiver1).isMessage());
+            expectEquals (receiver2.waitUntilReady (true, 50), 0);
+        }
+
+        beginTest ("sending over TCP");
+        {
+            StreamingSocket listener;
+            expect (listener.createListener (0, "127.0.0.1"));
+
+            OSCSender sender;
+            expect (sender.connectToTCPHost ("127.0.0.1", listener.getBoundPort()));
+
+            std::unique_ptr<StreamingSocket> connection (listener.waitForNextConnection());
+            expect (connection != nullptr);
+
+            const uint8 blobData[] = { 0xc0, 0xdb, 0x00 };
+            OSCMessage message ("/tcp", MemoryBlock (blobData, sizeof (blobData)));
+            expect (sender.send (message));
+            expect (sender.send (message));
+
+            if (connection != nullptr)
+            {
+                OSCOutputStream expected;
+                expect (expected.writeMessage (message));
+
+                for (int i = 0; i < 2; ++i)
+                {
+                    auto decoded = readSLIPPacket (*connection);
+                    expect (decoded == MemoryBlock (expected.getData(), expected.getDataSize()));
+                }
+            }
+        }
+    }
+
+private:
+    OSCBundle::Element readPacket (DatagramSocket& socket)
+    {
+        char buffer[2048];
+
+        if (socket.waitUntilReady (true, 1000) <= 0)
+            return OSCBundle::Element (OSCBundle());
+
+        auto size = socket.read (buffer, (int) sizeof (buffer), false);
+        OSCInputStream inStream (buffer, (size_t) size);
+        return inStream.readElementWithKnownSize ((size_t) size);
+    }
+
+    static MemoryBlock readSLIPPacket (StreamingSocket& socket)
+    {
+        MemoryOutputStream packet;
+        bool escaped = false;
+
+        for (;;)
+        {
+            uint8 byte = 0;
+
+            if (socket.waitUntilReady (true, 1000) <= 0 || socket.read (&byte, 1, true) != 1)
+                return {};
+
+            if (byte == 0xc0)
+            {
+                if (packet.getDataSize() > 0)
+                    return packet.getMemoryBlock();
+
+                continue;
+            }
+
+            if (escaped)
+                byte = (byte == 0xdc ? 0xc0 : 0xdb);
+
+            escaped = (byte == 0xdb && ! escaped);
+
+            if (! escaped)
+                packet.writeByte ((char) byte);
+        }
+    }
+};
+
+static OSCSenderTransportTests OSCSenderTransportUnitTests;
+
 #endif
 
 } // namespace juce
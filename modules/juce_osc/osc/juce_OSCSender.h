@@ -31,7 +31,12 @@ namespace juce
     An OSC message sender.
 
     An OSCSender object can connect to a network port. It then can send OSC
-    messages and bundles to a specified host over an UDP socket.
+    messages and bundles to a specified host over an UDP socket, or over a TCP
+    connection.
+
+    Messages can optionally be collected into bundles and sent in batches (see
+    setBatchingInterval()), and every packet can be sent to several hosts at
+    once (see addTarget()).
 
     @tags{OSC}
 */
@@ -74,13 +79,79 @@ public:
     */
     bool connectToSocket (DatagramSocket& socket, const String& targetHostName, int targetPortNumber);
 
+    /** Opens a TCP connection to a host, and prepares it for sending OSC packets.
+
+        Unlike UDP, TCP delivers every packet, in order, and doesn't limit their size.
+        The packets are framed using SLIP (RFC 1055), as described by the OSC 1.1
+        specification for stream-based transports.
+
+        @param  targetHostName   The remote host to which messages will be sent.
+        @param  targetPortNumber The remote TCP port number on which the host is
+                                 listening for connections.
+        @param  timeOutMillisecs The time to wait for the connection to be made.
+
+        @returns true if the connection was successful; false otherwise.
+        @see connect, send, disconnect.
+    */
+    bool connectToTCPHost (const String& targetHostName, int targetPortNumber, int timeOutMillisecs = 3000);
+
     //==============================================================================
-    /** Disconnects from the currently used UDP port.
+    /** Disconnects from the currently used UDP port or TCP connection, and removes
+        any targets that were added with addTarget().
+
+        If there are any batched messages waiting to be sent, they will be sent first.
+
         @returns true if the disconnection was successful; false otherwise.
         @see connect.
     */
     bool disconnect();
 
+    //==============================================================================
+    /** Adds another host to which all the messages and bundles passed to send()
+        will be delivered over UDP, as well as to the connected target.
+
+        Each packet is only encoded once, however many targets it gets sent to.
+
+        @returns true if the target was added successfully; false otherwise.
+        @see removeTarget
+    */
+    bool addTarget (const String& targetHostName, int targetPortNumber);
+
+    /** Removes a target that was previously added with addTarget(). */
+    void removeTarget (const String& targetHostName, int targetPortNumber);
+
+    //==============================================================================
+    /** The largest UDP payload that can be sent over an ethernet network without
+        being fragmented.
+    */
+    static constexpr int defaultMaxPacketSize = 1472;
+
+    /** Makes the sender collect the messages passed to send() into bundles, which
+        are then sent in batches rather than one packet per message.
+
+        The pending bundle is sent when the interval has elapsed, or earlier if adding
+        another message would make it larger than maxPacketSizeInBytes. If only one
+        message is waiting when the bundle is sent, it is sent as a plain message.
+        The bundles have the time tag OSCTimeTag::immediately.
+
+        While batching, send() will return true as soon as the message has been
+        added to the batch. Bundles passed to send() cause any pending messages to
+        be sent first, and then go out immediately.
+
+        @param  intervalMilliseconds    the longest time a message can be held back,
+                                        or 0 to turn batching off again
+        @param  maxPacketSizeInBytes    the largest packet that will be sent, unless a
+                                        single message is larger than this
+        @see flush
+    */
+    void setBatchingInterval (int intervalMilliseconds, int maxPacketSizeInBytes = defaultMaxPacketSize);
+
+    /** Immediately sends any messages that are waiting to be sent in a batch.
+        @returns true if the operation was successful.
+        @see setBatchingInterval
+    */
+    bool flush();
+
     //==============================================================================
     /** Sends an OSC message to the target.
         @param  message   The OSC message to send.
@@ -96,6 +167,7 @@ public:
 
     /** Sends an OSC message to a specific IP address and port.
         This overrides the address and port that was originally set for this sender.
+        The message is sent immediately over UDP, even when batching is turned on.
         @param  targetIPAddress   The IP address to send to
         @param  targetPortNumber  The target port number
         @param  message           The OSC message to send.
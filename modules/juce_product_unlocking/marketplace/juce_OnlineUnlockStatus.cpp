@@ -215,6 +215,56 @@ static var machineNumberAllowed (StringArray numbersFromKeyFile,
     return result;
 }
 
+//==============================================================================
+class OnlineUnlockStatus::AsyncLoader final : private Thread,
+                                              private AsyncUpdater
+{
+public:
+    AsyncLoader (OnlineUnlockStatus& o, std::function<void()> callback)
+        : Thread ("Unlock status loader"),
+          owner (o),
+          keyFileText (o.status[keyfileDataProp].toString()),
+          publicKey (o.getPublicKey()),
+          onLoadComplete (std::move (callback))
+    {
+        startThread();
+    }
+
+    ~AsyncLoader() override
+    {
+        cancelPendingUpdate();
+        waitForThreadToExit (-1);
+    }
+
+private:
+    void run() override
+    {
+        keyFileXml = KeyFileUtils::getXmlFromKeyFile (keyFileText, publicKey);
+        localMachineIDs = owner.getLocalMachineIDs();
+        triggerAsyncUpdate();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        // The callback may start another load, which would delete this object
+        auto callback = std::move (onLoadComplete);
+        owner.updateStatus (keyFileXml, localMachineIDs);
+
+        if (callback != nullptr)
+            callback();
+    }
+
+    OnlineUnlockStatus& owner;
+    const String keyFileText;
+    const RSAKey publicKey;
+    std::function<void()> onLoadComplete;
+
+    XmlElement keyFileXml { "key" };
+    StringArray localMachineIDs;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncLoader)
+};
+
 //==============================================================================
 OnlineUnlockStatus::OnlineUnlockStatus()  : status (stateTagName)
 {
@@ -222,9 +272,31 @@ OnlineUnlockStatus::OnlineUnlockStatus()  : status (stateTagName)
 
 OnlineUnlockStatus::~OnlineUnlockStatus()
 {
+    cancelPendingLoad();
 }
 
 void OnlineUnlockStatus::load()
+{
+    cancelPendingLoad();
+    restoreSavedState();
+    updateStatus (KeyFileUtils::getXmlFromKeyFile (status[keyfileDataProp], getPublicKey()), getLocalMachineIDs());
+}
+
+void OnlineUnlockStatus::loadAsync (std::function<void()> onLoadComplete)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    cancelPendingLoad();
+    restoreSavedState();
+    asyncLoader = std::make_unique<AsyncLoader> (*this, std::move (onLoadComplete));
+}
+
+void OnlineUnlockStatus::cancelPendingLoad()
+{
+    asyncLoader.reset();
+}
+
+void OnlineUnlockStatus::restoreSavedState()
 {
     MemoryBlock mb;
     mb.fromBase64Encoding (getState());
@@ -233,14 +305,15 @@ void OnlineUnlockStatus::load()
         status = ValueTree::readFromGZIPData (mb.getData(), mb.getSize());
     else
         status = ValueTree (stateTagName);
+}
 
-    StringArray localMachineNums (getLocalMachineIDs());
-
+void OnlineUnlockStatus::updateStatus (const XmlElement& keyFileXml, const StringArray& localMachineNums)
+{
     if (machineNumberAllowed (StringArray ("1234"), localMachineNums))
         status.removeProperty (unlockedProp, nullptr);
 
     KeyFileUtils::KeyFileData data;
-    data = KeyFileUtils::getDataFromKeyFile (KeyFileUtils::getXmlFromKeyFile (status[keyfileDataProp], getPublicKey()));
+    data = KeyFileUtils::getDataFromKeyFile (keyFileXml);
 
     if (data.keyFileExpires)
     {
@@ -338,7 +411,17 @@ StringArray OnlineUnlockStatus::MachineIDUtilities::getLocalMachineIDs()
 
 StringArray OnlineUnlockStatus::getLocalMachineIDs()
 {
-    return MachineIDUtilities::getLocalMachineIDs();
+    // These are slow to gather and won't change while the app is running, so only do it once.
+    // An empty list isn't kept, because the ID generator may not have been ready yet.
+    static CriticalSection lock;
+    static StringArray cachedIDs;
+
+    const ScopedLock sl (lock);
+
+    if (cachedIDs.isEmpty())
+        cachedIDs = MachineIDUtilities::getLocalMachineIDs();
+
+    return cachedIDs;
 }
 
 JUCE_END_IGNORE_WARNINGS_GCC_LIKE
@@ -112,9 +112,12 @@ public:
         machine, this list of tokens is compared to the ones that were stored
         on the webserver.
 
-        The default implementation of this method will simply call
+        The default implementation of this method will call
         MachineIDUtilities::getLocalMachineIDs(), which provides a default
-        version of this functionality.
+        version of this functionality. Because gathering these IDs can be slow,
+        the result is shared by all OnlineUnlockStatus objects in the process.
+
+        Note that this may be called on a background thread by loadAsync().
     */
     virtual StringArray getLocalMachineIDs();
 
@@ -224,9 +227,32 @@ public:
 
     /** Attempts to load the status from the state retrieved by getState().
         Call this somewhere in your app's startup code.
+
+        This blocks while the key file is checked against the machine's IDs, which
+        can take a while. To avoid holding up the message thread, use loadAsync() instead.
      */
     void load();
 
+    /** Loads the status like load(), but does the slow parts on a background thread.
+
+        The state saved by the last call to save() is restored straight away, so isUnlocked()
+        and getExpiryTime() immediately return the results that were stored then. The key file
+        is then decrypted and checked against getLocalMachineIDs() on a background thread,
+        after which the status is updated and the callback is called, both on the message thread.
+
+        Call this on the message thread. Calling load() or loadAsync() again cancels a pending load.
+
+        If your subclass overrides getLocalMachineIDs(), its destructor must call
+        cancelPendingLoad(), because the background thread may still be calling it.
+     */
+    void loadAsync (std::function<void()> onLoadComplete = nullptr);
+
+    /** Cancels a load that was started by loadAsync().
+
+        This waits for the background thread to finish, and the load's callback won't be called.
+     */
+    void cancelPendingLoad();
+
     /** Triggers a call to saveState which you can use to store the current unlock status
         in your app's settings.
      */
@@ -283,8 +309,13 @@ public:
     };
 
 private:
+    class AsyncLoader;
+
     ValueTree status;
+    std::unique_ptr<AsyncLoader> asyncLoader;
 
+    void restoreSavedState();
+    void updateStatus (const XmlElement& keyFileXml, const StringArray& localMachineIDs);
     UnlockResult handleXmlReply (XmlElement);
     UnlockResult handleFailedConnection();
 
@@ -130,6 +130,46 @@ int CameraDevice::CameraFactory::nextRequestId = 0;
 
 #endif
 
+#if ! JUCE_WINDOWS
+//==============================================================================
+// On platforms that only produce Images, frame listeners are given a Frame that
+// describes the pixels of each Image.
+struct CameraDevice::ImageFrameAdapter  : public Listener
+{
+    void imageReceived (const Image& image) override
+    {
+        const Image::BitmapData bitmap (image, Image::BitmapData::readOnly);
+
+        Frame frame;
+        frame.data = bitmap.data;
+        frame.width = bitmap.width;
+        frame.height = bitmap.height;
+        frame.lineStride = bitmap.lineStride;
+        frame.pixelFormat = getPixelFormat (image.getFormat());
+
+        const ScopedLock sl (lock);
+        frameListeners.call ([&] (FrameListener& l) { l.frameReceived (frame); });
+    }
+
+    static Frame::PixelFormat getPixelFormat (Image::PixelFormat format)
+    {
+        // Cameras should only ever produce colour images
+        jassert (format == Image::RGB || format == Image::ARGB);
+
+        if (format == Image::RGB)
+            return PixelRGB::indexR == 0 ? Frame::PixelFormat::rgb24 : Frame::PixelFormat::bgr24;
+
+        // Frame has no formats with the alpha channel first
+        jassert (PixelARGB::indexA == 3);
+
+        return PixelARGB::indexR == 0 ? Frame::PixelFormat::rgba32 : Frame::PixelFormat::bgra32;
+    }
+
+    CriticalSection lock;
+    ListenerList<FrameListener> frameListeners;
+};
+#endif
+
 //==============================================================================
 CameraDevice::CameraDevice (const String& nm, int index, int minWidth, int minHeight, int maxWidth, int maxHeight, bool useHighQuality)
    : name (nm), pimpl (new Pimpl (*this, name, index, minWidth, minHeight, maxWidth, maxHeight, useHighQuality))
@@ -182,6 +222,55 @@ void CameraDevice::removeListener (Listener* listenerToRemove)
         pimpl->removeListener (listenerToRemove);
 }
 
+void CameraDevice::addFrameListener (FrameListener* listenerToAdd)
+{
+    if (listenerToAdd == nullptr)
+        return;
+
+   #if JUCE_WINDOWS
+    pimpl->addFrameListener (listenerToAdd);
+   #else
+    if (imageFrameAdapter == nullptr)
+        imageFrameAdapter = std::make_unique<ImageFrameAdapter>();
+
+    bool isFirstListener;
+
+    {
+        const ScopedLock sl (imageFrameAdapter->lock);
+        imageFrameAdapter->frameListeners.add (listenerToAdd);
+        isFirstListener = imageFrameAdapter->frameListeners.size() == 1;
+    }
+
+    if (isFirstListener)
+        pimpl->addListener (imageFrameAdapter.get());
+   #endif
+}
+
+void CameraDevice::removeFrameListener (FrameListener* listenerToRemove)
+{
+    if (listenerToRemove == nullptr)
+        return;
+
+   #if JUCE_WINDOWS
+    pimpl->removeFrameListener (listenerToRemove);
+   #else
+    if (imageFrameAdapter == nullptr)
+        return;
+
+    bool wasLastListener;
+
+    {
+        const ScopedLock sl (imageFrameAdapter->lock);
+        const auto numBefore = imageFrameAdapter->frameListeners.size();
+        imageFrameAdapter->frameListeners.remove (listenerToRemove);
+        wasLastListener = numBefore == 1 && imageFrameAdapter->frameListeners.isEmpty();
+    }
+
+    if (wasLastListener)
+        pimpl->removeListener (imageFrameAdapter.get());
+   #endif
+}
+
 //==============================================================================
 StringArray CameraDevice::getAvailableDevices()
 {
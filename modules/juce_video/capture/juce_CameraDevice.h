@@ -214,6 +214,91 @@ public:
     /** Removes a listener that was previously added with addListener(). */
     void removeListener (Listener* listenerToRemove);
 
+    //==============================================================================
+    /**
+        Describes a frame of video in the pixel layout that the camera delivered it in.
+
+        The pixels belong to the camera, and are only valid during the call to
+        FrameListener::frameReceived(), so copy anything that you need to keep.
+
+        @see FrameListener
+    */
+    struct Frame
+    {
+        /** The order of the bytes in each pixel. */
+        enum class PixelFormat
+        {
+            rgb24,      /**< 3 bytes per pixel: red, green, blue. */
+            bgr24,      /**< 3 bytes per pixel: blue, green, red. */
+            rgba32,     /**< 4 bytes per pixel: red, green, blue, alpha. */
+            bgra32      /**< 4 bytes per pixel: blue, green, red, alpha. */
+        };
+
+        /** Returns a pointer to the first pixel in a row, where row 0 is the top of the picture. */
+        const uint8* getLinePointer (int y) const noexcept      { return data + (ptrdiff_t) y * lineStride; }
+
+        /** Returns the number of bytes used by each pixel. */
+        int getPixelStride() const noexcept
+        {
+            return pixelFormat == PixelFormat::rgb24 || pixelFormat == PixelFormat::bgr24 ? 3 : 4;
+        }
+
+        /** The first pixel of the top row. */
+        const uint8* data = nullptr;
+
+        /** The size of the frame in pixels. */
+        int width = 0, height = 0;
+
+        /** The number of bytes from the start of one row to the start of the next.
+            This is negative if the rows are stored from the bottom up.
+        */
+        int lineStride = 0;
+
+        /** The order of the bytes in each pixel. */
+        PixelFormat pixelFormat = PixelFormat::bgra32;
+    };
+
+    //==============================================================================
+    /**
+        Receives the frames from a CameraDevice without converting them to Images.
+
+        On Windows, the frames point straight into the capture driver's buffers, and
+        if a device has no Listeners or viewer components then no Image is created for
+        each frame at all. On other platforms, a Frame describes the pixels of the Image
+        that would be passed to a Listener.
+
+        A Frame can be uploaded to an OpenGL texture with glTexSubImage2D without any
+        intermediate copies, using GL_UNPACK_ROW_LENGTH for the stride. For frames that
+        are stored from the bottom up, upload from getLinePointer (height - 1) and flip
+        the texture coordinates.
+
+        @see CameraDevice::addFrameListener
+    */
+    class JUCE_API  FrameListener
+    {
+    public:
+        FrameListener() = default;
+        virtual ~FrameListener() = default;
+
+        /** This method is called when a new frame arrives.
+
+            This may be called by any thread, so be careful about thread-safety,
+            and make sure that you process the data as quickly as possible to
+            avoid dropping frames!
+        */
+        virtual void frameReceived (const Frame& frame) = 0;
+    };
+
+    /** Adds a listener to receive frames from the camera in its native pixel layout.
+
+        Be very careful not to delete the listener without first removing it by calling
+        removeFrameListener().
+    */
+    void addFrameListener (FrameListener* listenerToAdd);
+
+    /** Removes a listener that was previously added with addFrameListener(). */
+    void removeFrameListener (FrameListener* listenerToRemove);
+
 private:
     String name;
 
@@ -223,6 +308,11 @@ private:
     struct ViewerComponent;
     friend struct ViewerComponent;
 
+   #if ! JUCE_WINDOWS
+    struct ImageFrameAdapter;
+    std::unique_ptr<ImageFrameAdapter> imageFrameAdapter;
+   #endif
+
     CameraDevice (const String& name, int index,
                   int minWidth, int minHeight, int maxWidth, int maxHeight, bool highQuality);
 
@@ -210,7 +210,7 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
     {
         const ScopedLock sl (listenerLock);
 
-        if (listeners.size() == 0)
+        if (listeners.size() + frameListeners.size() == 0)
             addUser();
 
         listeners.add (listenerToAdd);
@@ -221,7 +221,26 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
         const ScopedLock sl (listenerLock);
         listeners.remove (listenerToRemove);
 
-        if (listeners.size() == 0)
+        if (listeners.size() + frameListeners.size() == 0)
+            removeUser();
+    }
+
+    void addFrameListener (CameraDevice::FrameListener* listenerToAdd)
+    {
+        const ScopedLock sl (listenerLock);
+
+        if (listeners.size() + frameListeners.size() == 0)
+            addUser();
+
+        frameListeners.add (listenerToAdd);
+    }
+
+    void removeFrameListener (CameraDevice::FrameListener* listenerToRemove)
+    {
+        const ScopedLock sl (listenerLock);
+        frameListeners.remove (listenerToRemove);
+
+        if (listeners.size() + frameListeners.size() == 0)
             removeUser();
     }
 
@@ -231,6 +250,39 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
         listeners.call ([=] (Listener& l) { l.imageReceived (image); });
     }
 
+    void callFrameListeners (const BYTE* buffer)
+    {
+        // The sample grabber delivers RGB24 rows from the bottom up
+        const int lineStride = width * 3;
+
+        CameraDevice::Frame frame;
+        frame.data = buffer + lineStride * (height - 1);
+        frame.width = width;
+        frame.height = height;
+        frame.lineStride = -lineStride;
+        frame.pixelFormat = CameraDevice::Frame::PixelFormat::bgr24;
+
+        const ScopedLock sl (listenerLock);
+        frameListeners.call ([&] (CameraDevice::FrameListener& l) { l.frameReceived (frame); });
+    }
+
+    // Converting a frame to an Image is only worth doing if something is going to use it
+    bool isImageNeeded()
+    {
+        if (numViewers > 0)
+            return true;
+
+        {
+            const ScopedLock sl (listenerLock);
+
+            if (listeners.size() > 0)
+                return true;
+        }
+
+        const ScopedLock sl (pictureTakenCallbackLock);
+        return pictureTakenCallback != nullptr;
+    }
+
     void notifyPictureTakenIfNeeded (const Image& image)
     {
         {
@@ -284,6 +336,12 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
             }
         }
 
+        if (frameListeners.size() > 0)
+            callFrameListeners (buffer);
+
+        if (! isImageNeeded())
+            return;
+
         {
             const int lineStride = width * 3;
             const ScopedLock sl (imageSwapLock);
@@ -560,6 +618,7 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
 
     CriticalSection listenerLock;
     ListenerList<Listener> listeners;
+    ListenerList<CameraDevice::FrameListener> frameListeners;
 
     CriticalSection pictureTakenCallbackLock;
     std::function<void (const Image&)> pictureTakenCallback;
@@ -569,6 +628,7 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
     Time firstRecordedTime;
 
     Array<ViewerComponent*> viewerComps;
+    std::atomic<int> numViewers { 0 };
 
     ComSmartPtr<ComTypes::ICaptureGraphBuilder2> captureGraphBuilder;
     ComSmartPtr<ComTypes::IBaseFilter> filter, smartTee, asfWriter;
@@ -772,6 +832,7 @@ struct CameraDevice::ViewerComponent  : public Component,
         owner->addChangeListener (this);
         owner->addUser();
         owner->viewerComps.add (this);
+        ++owner->numViewers;
         setSize (owner->width, owner->height);
     }
 
@@ -780,6 +841,7 @@ struct CameraDevice::ViewerComponent  : public Component,
         if (owner != nullptr)
         {
             owner->viewerComps.removeFirstMatchingValue (this);
+            --owner->numViewers;
             owner->removeUser();
             owner->removeChangeListener (this);
         }